@@ -13,7 +13,7 @@
 
 extern crate alloc;
 
-use alloc::collections::BTreeMap;
+use alloc::collections::{BTreeMap, VecDeque};
 
 use spin::Mutex;
 
@@ -83,24 +83,32 @@ struct InterestEntry {
     one_shot: bool,
     /// Whether a one-shot entry has already fired.
     disabled: bool,
+    /// Whether the fd is currently queued on the ready list.
+    queued: bool,
 }
 
 /// An epoll instance.
 struct EpollInstance {
     /// Interest list: fd -> entry.
     interest: BTreeMap<i32, InterestEntry>,
+    /// Ready list: fds with (probably) pending events, fed by
+    /// producers via `epoll_notify_ready()` and by interest-scan
+    /// overflow.  Draining this list services a wait without walking
+    /// the interest set.
+    ready: VecDeque<i32>,
     /// ID of this instance (for lookup).
     _id: u32,
-    /// Owning process PID.
-    _owner_pid: u64,
+    /// Owning process PID (ready-list notification routing).
+    owner_pid: u64,
 }
 
 impl EpollInstance {
     fn new(id: u32, owner_pid: u64) -> Self {
         Self {
             interest: BTreeMap::new(),
+            ready: VecDeque::new(),
             _id: id,
-            _owner_pid: owner_pid,
+            owner_pid,
         }
     }
 
@@ -125,17 +133,21 @@ impl EpollInstance {
             edge_triggered: event.events & EPOLLET != 0,
             one_shot: event.events & EPOLLONESHOT != 0,
             disabled: false,
+            queued: false,
         };
         self.interest.insert(fd, entry);
         Ok(())
     }
 
-    /// Remove an fd from the interest list.
+    /// Remove an fd from the interest list (and the ready list).
     fn ctl_del(&mut self, fd: i32) -> Result<(), KernelError> {
-        self.interest.remove(&fd).ok_or(KernelError::NotFound {
+        let entry = self.interest.remove(&fd).ok_or(KernelError::NotFound {
             resource: "epoll fd entry",
             id: fd as u64,
         })?;
+        if entry.queued {
+            self.ready.retain(|&r| r != fd);
+        }
         Ok(())
     }
 
@@ -154,28 +166,42 @@ impl EpollInstance {
         Ok(())
     }
 
-    /// Poll for ready events. Returns the number of ready fds.
+    /// Mark an fd ready (producer notification or scan overflow).
+    fn push_ready(&mut self, fd: i32) {
+        if let Some(entry) = self.interest.get_mut(&fd) {
+            if !entry.queued && !entry.disabled {
+                entry.queued = true;
+                self.ready.push_back(fd);
+            }
+        }
+    }
+
+    /// Drain the ready list into `events` in one pass.
     ///
-    /// Checks each fd in the interest list against the current fd state
-    /// (via `poll_fd_readiness`). For level-triggered fds, events fire
-    /// every time the condition is true. For edge-triggered, events fire
-    /// only on state transitions (simplified: fire once then require re-arm
-    /// via EPOLL_CTL_MOD).
-    fn poll_events(&mut self, events: &mut [EpollEvent]) -> usize {
+    /// Readiness is re-verified against the fd state so stale or
+    /// level-triggered-consumed notifications are dropped rather than
+    /// delivered spuriously.  Returns the number of events written.
+    fn drain_ready(&mut self, events: &mut [EpollEvent]) -> usize {
         let max_events = events.len();
         let mut count = 0;
 
-        for entry in self.interest.values_mut() {
-            if count >= max_events {
-                break;
-            }
+        while count < max_events {
+            let fd = match self.ready.pop_front() {
+                Some(fd) => fd,
+                None => break,
+            };
+
+            let entry = match self.interest.get_mut(&fd) {
+                Some(e) => e,
+                None => continue, // Deleted while queued
+            };
+            entry.queued = false;
+
             if entry.disabled {
                 continue;
             }
 
-            let ready = poll_fd_readiness(entry.fd);
-            let matched = ready & entry.events;
-
+            let matched = poll_fd_readiness(fd) & entry.events;
             if matched != 0 {
                 events[count] = EpollEvent {
                     events: matched,
@@ -191,6 +217,64 @@ impl EpollInstance {
 
         count
     }
+
+    /// Poll for ready events. Returns the number of ready fds.
+    ///
+    /// Fast path: drain the kernel-fed ready list without touching the
+    /// interest set.  Only when that yields nothing does the full
+    /// interest scan run (producers that don't notify yet).  A scan
+    /// that finds more ready fds than fit in `events` queues the
+    /// overflow on the ready list, so the next wait drains them with
+    /// no rescan -- the whole batch reaches userspace across calls
+    /// with one copy-out each.
+    ///
+    /// For level-triggered fds, events fire every time the condition
+    /// is true. For edge-triggered, events fire only on state
+    /// transitions (simplified: fire once then require re-arm via
+    /// EPOLL_CTL_MOD).
+    fn poll_events(&mut self, events: &mut [EpollEvent]) -> usize {
+        let drained = self.drain_ready(events);
+        if drained > 0 {
+            return drained;
+        }
+
+        let max_events = events.len();
+        let mut count = 0;
+        let mut overflow: VecDeque<i32> = VecDeque::new();
+
+        for entry in self.interest.values_mut() {
+            if entry.disabled {
+                continue;
+            }
+
+            let ready = poll_fd_readiness(entry.fd);
+            let matched = ready & entry.events;
+
+            if matched != 0 {
+                if count < max_events {
+                    events[count] = EpollEvent {
+                        events: matched,
+                        data: entry.data,
+                    };
+                    count += 1;
+
+                    if entry.one_shot {
+                        entry.disabled = true;
+                    }
+                } else {
+                    // Ready but no room: hand to the ready list so the
+                    // next wait returns it without rescanning
+                    if !entry.queued {
+                        entry.queued = true;
+                        overflow.push_back(entry.fd);
+                    }
+                }
+            }
+        }
+
+        self.ready.append(&mut overflow);
+        count
+    }
 }
 
 // ============================================================================
@@ -355,6 +439,28 @@ pub fn epoll_destroy(epoll_id: u32) -> Result<(), KernelError> {
     Ok(())
 }
 
+/// Producer-side readiness notification.
+///
+/// Subsystems that make an fd readable/writable (pipe writes, socket
+/// receive, eventfd posts) call this with the owning process and fd;
+/// every epoll instance of that process watching the fd gets it
+/// pushed onto its ready list, so the next epoll_wait() returns
+/// without scanning the interest set.  Readiness is re-verified at
+/// delivery, so spurious notifications are harmless.
+pub fn epoll_notify_ready(owner_pid: u64, fd: i32) {
+    let mut reg_guard = EPOLL_REGISTRY.lock();
+    let reg = match reg_guard.as_mut() {
+        Some(r) => r,
+        None => return,
+    };
+
+    for instance in reg.instances.values_mut() {
+        if instance.owner_pid == owner_pid {
+            instance.push_ready(fd);
+        }
+    }
+}
+
 // ============================================================================
 // Internal: fd readiness polling
 // ============================================================================
@@ -27,6 +27,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #include <dirent.h>
@@ -193,46 +197,412 @@ static int read_collection_metadata(const char *meta_path,
 }
 
 /* ======================================================================
- * Item storage
- * ====================================================================== */
+ * Item storage -- log-structured with an mmap'd read path
+ * ======================================================================
+ *
+ * Items live in one append-only log (items.log): adds, updates, and
+ * deletes (tombstones) each append a record, so no operation rewrites
+ * existing data.  Reads go through a read-only mmap of the log.
+ *
+ * An in-memory index maps item IDs to log offsets.  IDs are allocated
+ * monotonically, so the index is a sorted array with O(1) append and
+ * binary-search lookup (the balanced-tree shape buys nothing when
+ * every insertion lands at the end); a per-entry collection ID lets
+ * listing a folder touch only that folder's records.  The index is
+ * persisted periodically (items.idx, every AKONADI_IDX_CHECKPOINT
+ * mutations and at shutdown) with the log length it covers, so a
+ * warm start loads it and replays only the log tail; a missing or
+ * stale index is rebuilt by a full log scan.  Shutdown compacts the
+ * log when more than half of it is dead.
+ *
+ * Legacy per-item .dat files are migrated into the log on first init.
+ */
 
-static int write_item(const akonadi_item_t *item)
+#define AKONADI_LOG_MAGIC      0x43524b41u  /* "AKRC" */
+#define AKONADI_IDX_MAGIC      0x58494b41u  /* "AKIX" */
+#define AKONADI_IDX_VERSION    1
+#define AKONADI_IDX_CHECKPOINT 64
+
+struct log_rec_hdr {
+    uint32_t magic;
+    uint32_t rec_len;       /* header + payload, padded to 8 */
+    int64_t  id;
+    int64_t  collection_id;
+    uint32_t tomb;          /* 1 = deletion record */
+    uint32_t payload_len;
+    char     mime_type[AKONADI_MAX_MIME_TYPE];
+    char     remote_id[AKONADI_MAX_REMOTE_ID];
+    char     flags[AKONADI_MAX_FLAGS];
+};
+
+struct idx_entry {
+    int64_t  id;
+    int64_t  collection_id;
+    uint64_t offset;        /* of the live record in the log */
+};
+
+struct idx_file_hdr {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t _pad;
+    uint64_t log_len;       /* log bytes the entries cover */
+};
+
+static int          s_log_fd = -1;      /* append handle */
+static uint64_t     s_log_size;         /* current end of log */
+static uint8_t     *s_log_map;          /* read mapping */
+static size_t       s_log_map_len;
+static idx_entry   *s_idx;
+static uint32_t     s_idx_count;
+static uint32_t     s_idx_cap;
+static uint32_t     s_dirty_ops;        /* since the last checkpoint */
+static uint64_t     s_dead_bytes;       /* superseded/tombstoned data */
+
+static void log_paths(char *log_path, char *idx_path, size_t len)
 {
-    char items_dir[512];
-    snprintf(items_dir, sizeof(items_dir), "%s/items", s_data_dir);
-    ensure_dir(items_dir);
+    snprintf(log_path, len, "%s/items.log", s_data_dir);
+    snprintf(idx_path, len, "%s/items.idx", s_data_dir);
+}
 
-    char item_path[512];
-    snprintf(item_path, sizeof(item_path), "%s/%lld.dat",
-             items_dir, (long long)item->id);
+/* Keep the read mapping in sync with the appended log */
+static int map_ensure(void)
+{
+    if (s_log_map && s_log_map_len >= s_log_size)
+        return 0;
+    if (s_log_size == 0)
+        return 0;
 
-    FILE *fp = fopen(item_path, "w");
-    if (!fp) {
+    if (s_log_map)
+        munmap(s_log_map, s_log_map_len);
+    s_log_map = NULL;
+    s_log_map_len = 0;
+
+    char log_path[512], idx_path[512];
+
+    log_paths(log_path, idx_path, sizeof(log_path));
+
+    int fd = open(log_path, O_RDONLY);
+
+    if (fd < 0)
         return -1;
+
+    void *m = mmap(NULL, (size_t)s_log_size, PROT_READ, MAP_PRIVATE,
+                   fd, 0);
+
+    close(fd);
+    if (m == MAP_FAILED)
+        return -1;
+    s_log_map = (uint8_t *)m;
+    s_log_map_len = (size_t)s_log_size;
+    return 0;
+}
+
+/* Binary search; returns index or the insertion point in *ins */
+static int idx_find(int64_t id, uint32_t *ins)
+{
+    uint32_t lo = 0, hi = s_idx_count;
+
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+
+        if (s_idx[mid].id < id)
+            lo = mid + 1;
+        else
+            hi = mid;
     }
+    if (ins)
+        *ins = lo;
+    return lo < s_idx_count && s_idx[lo].id == id ? (int)lo : -1;
+}
 
-    /* Write header fields */
-    fprintf(fp, "id=%lld\n", (long long)item->id);
-    fprintf(fp, "collection_id=%lld\n", (long long)item->collection_id);
-    fprintf(fp, "mime_type=%s\n", item->mime_type);
-    fprintf(fp, "payload_len=%d\n", item->payload_len);
-    if (item->remote_id[0] != '\0') {
-        fprintf(fp, "remote_id=%s\n", item->remote_id);
+static int idx_insert(int64_t id, int64_t col, uint64_t off)
+{
+    if (s_idx_count == s_idx_cap) {
+        uint32_t ncap = s_idx_cap ? s_idx_cap * 2 : 256;
+        idx_entry *ni = (idx_entry *)realloc(s_idx,
+                                             ncap * sizeof(idx_entry));
+
+        if (!ni)
+            return -1;
+        s_idx = ni;
+        s_idx_cap = ncap;
     }
-    if (item->flags[0] != '\0') {
-        fprintf(fp, "flags=%s\n", item->flags);
+
+    uint32_t ins;
+    int found = idx_find(id, &ins);
+
+    if (found >= 0) {
+        s_idx[found].offset = off;
+        s_idx[found].collection_id = col;
+        return 0;
     }
-    fprintf(fp, "---\n");
+    memmove(&s_idx[ins + 1], &s_idx[ins],
+            (s_idx_count - ins) * sizeof(idx_entry));
+    s_idx[ins].id = id;
+    s_idx[ins].collection_id = col;
+    s_idx[ins].offset = off;
+    s_idx_count++;
+    return 0;
+}
+
+static void idx_remove(int64_t id)
+{
+    int at = idx_find(id, NULL);
+
+    if (at < 0)
+        return;
+    memmove(&s_idx[at], &s_idx[at + 1],
+            (s_idx_count - (uint32_t)at - 1) * sizeof(idx_entry));
+    s_idx_count--;
+}
 
-    /* Write payload */
-    if (item->payload_len > 0) {
-        fwrite(item->payload, 1, (size_t)item->payload_len, fp);
+/* Append one record; returns its offset or (uint64_t)-1 */
+static uint64_t log_append(int64_t id, int64_t col, uint32_t tomb,
+                           const char *mime, const char *remote_id,
+                           const char *flags,
+                           const char *payload, int payload_len)
+{
+    struct log_rec_hdr hdr;
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = AKONADI_LOG_MAGIC;
+    hdr.id = id;
+    hdr.collection_id = col;
+    hdr.tomb = tomb;
+    hdr.payload_len = (uint32_t)(payload_len > 0 ? payload_len : 0);
+    if (mime)
+        strncpy(hdr.mime_type, mime, sizeof(hdr.mime_type) - 1);
+    if (remote_id)
+        strncpy(hdr.remote_id, remote_id, sizeof(hdr.remote_id) - 1);
+    if (flags)
+        strncpy(hdr.flags, flags, sizeof(hdr.flags) - 1);
+    hdr.rec_len = (uint32_t)((sizeof(hdr) + hdr.payload_len + 7) & ~7u);
+
+    uint64_t off = s_log_size;
+    char pad[8] = {0};
+    uint32_t pad_len = hdr.rec_len - (uint32_t)sizeof(hdr) -
+                       hdr.payload_len;
+
+    if (write(s_log_fd, &hdr, sizeof(hdr)) != (ssize_t)sizeof(hdr) ||
+        (hdr.payload_len > 0 &&
+         write(s_log_fd, payload, hdr.payload_len) !=
+             (ssize_t)hdr.payload_len) ||
+        (pad_len > 0 &&
+         write(s_log_fd, pad, pad_len) != (ssize_t)pad_len)) {
+        /* A torn record would desync the framing for every later
+         * append; cut the log back to the last good record */
+        ftruncate(s_log_fd, (off_t)s_log_size);
+        return (uint64_t)-1;
     }
 
-    fclose(fp);
+    s_log_size += hdr.rec_len;
+    return off;
+}
+
+/* Fill an item from the record at a log offset (via the mapping) */
+static int rec_to_item(uint64_t off, akonadi_item_t *item)
+{
+    if (map_ensure() != 0 || off + sizeof(log_rec_hdr) > s_log_size)
+        return -1;
+
+    const struct log_rec_hdr *hdr =
+        (const struct log_rec_hdr *)(s_log_map + off);
+
+    if (hdr->magic != AKONADI_LOG_MAGIC ||
+        off + hdr->rec_len > s_log_size ||
+        hdr->payload_len >= AKONADI_MAX_PAYLOAD)
+        return -1;
+
+    memset(item, 0, sizeof(*item));
+    item->id = hdr->id;
+    item->collection_id = hdr->collection_id;
+    memcpy(item->mime_type, hdr->mime_type, sizeof(hdr->mime_type));
+    memcpy(item->remote_id, hdr->remote_id, sizeof(hdr->remote_id));
+    memcpy(item->flags, hdr->flags, sizeof(hdr->flags));
+    item->payload_len = (int)hdr->payload_len;
+    if (hdr->payload_len > 0)
+        memcpy(item->payload, s_log_map + off + sizeof(*hdr),
+               hdr->payload_len);
     return 0;
 }
 
+/* Replay log records from `from` to the end into the index */
+static void log_replay(uint64_t from)
+{
+    if (map_ensure() != 0)
+        return;
+
+    uint64_t off = from;
+
+    while (off + sizeof(log_rec_hdr) <= s_log_size) {
+        const struct log_rec_hdr *hdr =
+            (const struct log_rec_hdr *)(s_log_map + off);
+
+        if (hdr->magic != AKONADI_LOG_MAGIC || hdr->rec_len == 0 ||
+            off + hdr->rec_len > s_log_size)
+            break;  /* torn tail */
+
+        int prior = idx_find(hdr->id, NULL);
+
+        if (prior >= 0)
+            s_dead_bytes += hdr->rec_len;  /* supersedes a record */
+
+        if (hdr->tomb) {
+            idx_remove(hdr->id);
+            s_dead_bytes += hdr->rec_len;
+        } else {
+            idx_insert(hdr->id, hdr->collection_id, off);
+        }
+        if (hdr->id >= s_next_id)
+            s_next_id = hdr->id + 1;
+        off += hdr->rec_len;
+    }
+}
+
+static void idx_save(void)
+{
+    char log_path[512], idx_path[512], tmp[520];
+
+    log_paths(log_path, idx_path, sizeof(log_path));
+    snprintf(tmp, sizeof(tmp), "%s.tmp", idx_path);
+
+    FILE *fp = fopen(tmp, "w");
+
+    if (!fp)
+        return;
+
+    struct idx_file_hdr h;
+
+    memset(&h, 0, sizeof(h));
+    h.magic = AKONADI_IDX_MAGIC;
+    h.version = AKONADI_IDX_VERSION;
+    h.count = s_idx_count;
+    h.log_len = s_log_size;
+
+    if (fwrite(&h, sizeof(h), 1, fp) == 1 &&
+        (s_idx_count == 0 ||
+         fwrite(s_idx, sizeof(idx_entry), s_idx_count, fp) ==
+             s_idx_count)) {
+        fclose(fp);
+        rename(tmp, idx_path);
+    } else {
+        fclose(fp);
+        unlink(tmp);
+    }
+    s_dirty_ops = 0;
+}
+
+/* Returns the log length the index covers, or 0 to force a rebuild */
+static uint64_t idx_load(void)
+{
+    char log_path[512], idx_path[512];
+
+    log_paths(log_path, idx_path, sizeof(log_path));
+
+    FILE *fp = fopen(idx_path, "r");
+
+    if (!fp)
+        return 0;
+
+    struct idx_file_hdr h;
+
+    if (fread(&h, sizeof(h), 1, fp) != 1 ||
+        h.magic != AKONADI_IDX_MAGIC ||
+        h.version != AKONADI_IDX_VERSION ||
+        h.count > 16u * 1024 * 1024 ||
+        h.log_len > s_log_size) {
+        fclose(fp);
+        return 0;
+    }
+
+    idx_entry *entries =
+        (idx_entry *)malloc((h.count ? h.count : 1) *
+                            sizeof(idx_entry));
+
+    if (!entries || fread(entries, sizeof(idx_entry), h.count, fp) !=
+                        h.count) {
+        free(entries);
+        fclose(fp);
+        return 0;
+    }
+    fclose(fp);
+
+    free(s_idx);
+    s_idx = entries;
+    s_idx_count = h.count;
+    s_idx_cap = h.count ? h.count : 1;
+    for (uint32_t i = 0; i < s_idx_count; i++) {
+        if (s_idx[i].id >= s_next_id)
+            s_next_id = s_idx[i].id + 1;
+    }
+    return h.log_len;
+}
+
+static void tg_index_save(void);
+
+static void checkpoint_maybe(void)
+{
+    if (++s_dirty_ops >= AKONADI_IDX_CHECKPOINT) {
+        idx_save();
+        tg_index_save();
+    }
+}
+
+/* Rewrite the log with only live records (shutdown housekeeping) */
+static void log_compact(void)
+{
+    char log_path[512], idx_path[512], tmp[520];
+
+    log_paths(log_path, idx_path, sizeof(log_path));
+    snprintf(tmp, sizeof(tmp), "%s.tmp", log_path);
+
+    int fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (fd < 0 || map_ensure() != 0) {
+        if (fd >= 0)
+            close(fd);
+        return;
+    }
+
+    uint64_t out = 0;
+    int ok = 1;
+
+    for (uint32_t i = 0; i < s_idx_count && ok; i++) {
+        const struct log_rec_hdr *hdr =
+            (const struct log_rec_hdr *)(s_log_map + s_idx[i].offset);
+
+        ok = write(fd, hdr, hdr->rec_len) == (ssize_t)hdr->rec_len;
+        if (ok) {
+            s_idx[i].offset = out;
+            out += hdr->rec_len;
+        }
+    }
+    close(fd);
+
+    if (!ok || rename(tmp, log_path) != 0) {
+        unlink(tmp);
+        return;
+    }
+
+    /* Swap the append handle and mapping to the compacted log */
+    close(s_log_fd);
+    s_log_fd = open(log_path, O_WRONLY | O_APPEND);
+    if (s_log_map) {
+        munmap(s_log_map, s_log_map_len);
+        s_log_map = NULL;
+        s_log_map_len = 0;
+    }
+    s_log_size = out;
+    s_dead_bytes = 0;
+    idx_save();
+}
+
+/* Bring the store online: open the log, load or rebuild the index,
+ * and migrate any legacy per-item .dat files into the log. */
+static int log_store_open(void);
+
+
 static int read_item(const char *item_path, akonadi_item_t *item)
 {
     FILE *fp = fopen(item_path, "r");
@@ -287,6 +657,450 @@ static int read_item(const char *item_path, akonadi_item_t *item)
     return 0;
 }
 
+/* ======================================================================
+ * Trigram payload index
+ * ======================================================================
+ *
+ * Same design as the baloo-veridian-index trigram sidecar, carried
+ * over to this file's plain-C style: payload tokens are lowercased
+ * and every 3-byte window becomes a trigram (packed into a u32)
+ * whose posting list holds the item IDs containing it.  The index is
+ * maintained incrementally as items are written -- adds insert into
+ * the new payload's postings, updates diff old vs new trigrams, and
+ * deletes remove the old payload's postings -- so a query intersects
+ * a few posting lists and verifies only the candidates instead of
+ * scanning every payload.  Queries shorter than three characters
+ * fall back to the scan.
+ *
+ * Persistence rides the index checkpoint cadence: items.tgx stores
+ * the postings with the log length they cover and is loaded on warm
+ * start, else the index rebuilds from the live records in one pass
+ * over the log mapping.
+ */
+
+#define AKONADI_TGX_MAGIC    0x58474b41u  /* "AKGX" */
+#define AKONADI_TGX_VERSION  1
+#define TG_MAX_PER_PAYLOAD   512
+
+struct tg_posting {
+    uint32_t tri;
+    uint32_t count;
+    uint32_t cap;
+    int64_t *ids;        /* sorted, unique */
+};
+
+static tg_posting *s_tg;
+static uint32_t    s_tg_count;
+static uint32_t    s_tg_cap;
+
+/* Binary search over the sorted posting array */
+static int tg_find(uint32_t tri, uint32_t *ins)
+{
+    uint32_t lo = 0, hi = s_tg_count;
+
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+
+        if (s_tg[mid].tri < tri)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (ins)
+        *ins = lo;
+    return lo < s_tg_count && s_tg[lo].tri == tri ? (int)lo : -1;
+}
+
+/* Collect the unique trigrams of a payload (lowercased token runs) */
+static int tg_extract(const char *payload, int len, uint32_t *out,
+                      int max)
+{
+    int n = 0;
+
+    for (int i = 0; i + 2 < len && n < max; i++) {
+        unsigned char a = (unsigned char)payload[i];
+        unsigned char b = (unsigned char)payload[i + 1];
+        unsigned char c = (unsigned char)payload[i + 2];
+
+        if (!isalnum(a) || !isalnum(b) || !isalnum(c))
+            continue;
+
+        uint32_t tri = (uint32_t)tolower(a) |
+                       ((uint32_t)tolower(b) << 8) |
+                       ((uint32_t)tolower(c) << 16);
+
+        /* Dedupe within this payload (linear: n is small) */
+        int dup = 0;
+
+        for (int j = 0; j < n; j++) {
+            if (out[j] == tri) {
+                dup = 1;
+                break;
+            }
+        }
+        if (!dup)
+            out[n++] = tri;
+    }
+    return n;
+}
+
+static void tg_post_add(uint32_t tri, int64_t id)
+{
+    uint32_t ins;
+    int at = tg_find(tri, &ins);
+
+    if (at < 0) {
+        if (s_tg_count == s_tg_cap) {
+            uint32_t ncap = s_tg_cap ? s_tg_cap * 2 : 512;
+            tg_posting *np = (tg_posting *)realloc(
+                s_tg, ncap * sizeof(tg_posting));
+
+            if (!np)
+                return;
+            s_tg = np;
+            s_tg_cap = ncap;
+        }
+        memmove(&s_tg[ins + 1], &s_tg[ins],
+                (s_tg_count - ins) * sizeof(tg_posting));
+        s_tg[ins].tri = tri;
+        s_tg[ins].count = 0;
+        s_tg[ins].cap = 0;
+        s_tg[ins].ids = NULL;
+        s_tg_count++;
+        at = (int)ins;
+    }
+
+    tg_posting *p = &s_tg[at];
+
+    /* IDs arrive mostly in increasing order; find the slot */
+    uint32_t lo = 0, hi = p->count;
+
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+
+        if (p->ids[mid] < id)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo < p->count && p->ids[lo] == id)
+        return;
+
+    if (p->count == p->cap) {
+        uint32_t ncap = p->cap ? p->cap * 2 : 8;
+        int64_t *ni = (int64_t *)realloc(p->ids,
+                                         ncap * sizeof(int64_t));
+
+        if (!ni)
+            return;
+        p->ids = ni;
+        p->cap = ncap;
+    }
+    memmove(&p->ids[lo + 1], &p->ids[lo],
+            (p->count - lo) * sizeof(int64_t));
+    p->ids[lo] = id;
+    p->count++;
+}
+
+static void tg_post_remove(uint32_t tri, int64_t id)
+{
+    int at = tg_find(tri, NULL);
+
+    if (at < 0)
+        return;
+
+    tg_posting *p = &s_tg[at];
+
+    for (uint32_t i = 0; i < p->count; i++) {
+        if (p->ids[i] == id) {
+            memmove(&p->ids[i], &p->ids[i + 1],
+                    (p->count - i - 1) * sizeof(int64_t));
+            p->count--;
+            return;
+        }
+    }
+}
+
+static void tg_index_add(int64_t id, const char *payload, int len)
+{
+    uint32_t tris[TG_MAX_PER_PAYLOAD];
+    int n = tg_extract(payload, len, tris, TG_MAX_PER_PAYLOAD);
+
+    for (int i = 0; i < n; i++)
+        tg_post_add(tris[i], id);
+}
+
+static void tg_index_remove(int64_t id, const char *payload, int len)
+{
+    uint32_t tris[TG_MAX_PER_PAYLOAD];
+    int n = tg_extract(payload, len, tris, TG_MAX_PER_PAYLOAD);
+
+    for (int i = 0; i < n; i++)
+        tg_post_remove(tris[i], id);
+}
+
+static void tg_index_free(void)
+{
+    for (uint32_t i = 0; i < s_tg_count; i++)
+        free(s_tg[i].ids);
+    free(s_tg);
+    s_tg = NULL;
+    s_tg_count = s_tg_cap = 0;
+}
+
+/* Rebuild from every live record (one pass over the log mapping) */
+static void tg_index_rebuild(void)
+{
+    tg_index_free();
+    for (uint32_t i = 0; i < s_idx_count; i++) {
+        akonadi_item_t item;
+
+        if (rec_to_item(s_idx[i].offset, &item) == 0)
+            tg_index_add(item.id, item.payload, item.payload_len);
+    }
+}
+
+static void tg_index_save(void)
+{
+    char path[512], tmp[520];
+
+    snprintf(path, sizeof(path), "%s/items.tgx", s_data_dir);
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+
+    FILE *fp = fopen(tmp, "w");
+
+    if (!fp)
+        return;
+
+    uint32_t hdr[4] = { AKONADI_TGX_MAGIC, AKONADI_TGX_VERSION,
+                        s_tg_count, 0 };
+    uint64_t covered = s_log_size;
+    int ok = fwrite(hdr, sizeof(hdr), 1, fp) == 1 &&
+             fwrite(&covered, sizeof(covered), 1, fp) == 1;
+
+    for (uint32_t i = 0; ok && i < s_tg_count; i++) {
+        uint32_t rec[2] = { s_tg[i].tri, s_tg[i].count };
+
+        ok = fwrite(rec, sizeof(rec), 1, fp) == 1 &&
+             (s_tg[i].count == 0 ||
+              fwrite(s_tg[i].ids, sizeof(int64_t), s_tg[i].count,
+                     fp) == s_tg[i].count);
+    }
+    fclose(fp);
+    if (ok)
+        rename(tmp, path);
+    else
+        unlink(tmp);
+}
+
+/* Returns 1 when the on-disk trigram index covered the whole log */
+static int tg_index_load(void)
+{
+    char path[512];
+
+    snprintf(path, sizeof(path), "%s/items.tgx", s_data_dir);
+
+    FILE *fp = fopen(path, "r");
+
+    if (!fp)
+        return 0;
+
+    uint32_t hdr[4];
+    uint64_t covered;
+
+    if (fread(hdr, sizeof(hdr), 1, fp) != 1 ||
+        hdr[0] != AKONADI_TGX_MAGIC || hdr[1] != AKONADI_TGX_VERSION ||
+        hdr[2] > 16u * 1024 * 1024 ||
+        fread(&covered, sizeof(covered), 1, fp) != 1 ||
+        covered != s_log_size) {
+        fclose(fp);
+        return 0;
+    }
+
+    tg_index_free();
+    int ok = 1;
+
+    for (uint32_t i = 0; ok && i < hdr[2]; i++) {
+        uint32_t rec[2];
+
+        ok = fread(rec, sizeof(rec), 1, fp) == 1 &&
+             rec[1] <= 16u * 1024 * 1024;
+        if (!ok)
+            break;
+
+        int64_t *ids = (int64_t *)malloc((rec[1] ? rec[1] : 1) *
+                                         sizeof(int64_t));
+
+        ok = ids && (rec[1] == 0 ||
+                     fread(ids, sizeof(int64_t), rec[1], fp) == rec[1]);
+        if (!ok) {
+            free(ids);
+            break;
+        }
+        if (s_tg_count == s_tg_cap) {
+            uint32_t ncap = s_tg_cap ? s_tg_cap * 2 : 512;
+            tg_posting *np = (tg_posting *)realloc(
+                s_tg, ncap * sizeof(tg_posting));
+
+            if (!np) {
+                free(ids);
+                ok = 0;
+                break;
+            }
+            s_tg = np;
+            s_tg_cap = ncap;
+        }
+        s_tg[s_tg_count].tri = rec[0];
+        s_tg[s_tg_count].count = rec[1];
+        s_tg[s_tg_count].cap = rec[1] ? rec[1] : 1;
+        s_tg[s_tg_count].ids = ids;
+        s_tg_count++;
+    }
+    fclose(fp);
+
+    if (!ok)
+        tg_index_free();
+    return ok;
+}
+
+/*
+ * Candidate IDs for a query: intersect the posting lists of its
+ * trigrams.  Returns the count, or -1 when the index cannot help
+ * (query too short) and the caller must scan.
+ */
+static int tg_candidates(const char *query, int64_t *out, int max)
+{
+    uint32_t tris[TG_MAX_PER_PAYLOAD];
+    int n = tg_extract(query, (int)strlen(query), tris,
+                       TG_MAX_PER_PAYLOAD);
+
+    if (n == 0)
+        return -1;
+
+    /* Start from the rarest posting list */
+    int rare = -1;
+    uint32_t rare_count = 0;
+
+    for (int i = 0; i < n; i++) {
+        int at = tg_find(tris[i], NULL);
+
+        if (at < 0)
+            return 0;   /* some trigram matches nothing */
+        if (rare < 0 || s_tg[at].count < rare_count) {
+            rare = at;
+            rare_count = s_tg[at].count;
+        }
+    }
+
+    int count = 0;
+    const tg_posting *base = &s_tg[rare];
+
+    for (uint32_t i = 0; i < base->count && count < max; i++) {
+        int64_t id = base->ids[i];
+        int all = 1;
+
+        for (int t = 0; t < n && all; t++) {
+            int at = tg_find(tris[t], NULL);
+            const tg_posting *p = &s_tg[at];
+            uint32_t lo = 0, hi = p->count;
+
+            while (lo < hi) {
+                uint32_t mid = (lo + hi) / 2;
+
+                if (p->ids[mid] < id)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            all = lo < p->count && p->ids[lo] == id;
+        }
+        if (all)
+            out[count++] = id;
+    }
+    return count;
+}
+
+/* ======================================================================
+ * Log store bring-up and legacy migration
+ * ====================================================================== */
+
+static int log_store_open(void)
+{
+    char log_path[512], idx_path[512];
+
+    log_paths(log_path, idx_path, sizeof(log_path));
+
+    s_log_fd = open(log_path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (s_log_fd < 0)
+        return -1;
+
+    struct stat st;
+
+    s_log_size = fstat(s_log_fd, &st) == 0 ? (uint64_t)st.st_size : 0;
+
+    /* Warm start: the persisted index covers a prefix of the log;
+     * replay only the tail.  Cold start: full scan. */
+    uint64_t covered = idx_load();
+
+    log_replay(covered);
+
+    /* Migrate legacy per-item .dat files into the log */
+    char items_dir[512];
+
+    snprintf(items_dir, sizeof(items_dir), "%s/items", s_data_dir);
+
+    DIR *dp = opendir(items_dir);
+
+    if (dp) {
+        struct dirent *ent;
+        int migrated = 0;
+
+        while ((ent = readdir(dp)) != NULL) {
+            const char *ext = strrchr(ent->d_name, '.');
+
+            if (!ext || strcmp(ext, ".dat") != 0)
+                continue;
+
+            char item_path[512];
+
+            snprintf(item_path, sizeof(item_path), "%s/%s",
+                     items_dir, ent->d_name);
+
+            akonadi_item_t item;
+
+            if (read_item(item_path, &item) == 0 &&
+                idx_find(item.id, NULL) < 0) {
+                uint64_t off = log_append(item.id, item.collection_id,
+                                          0, item.mime_type,
+                                          item.remote_id, item.flags,
+                                          item.payload,
+                                          item.payload_len);
+
+                if (off != (uint64_t)-1) {
+                    idx_insert(item.id, item.collection_id, off);
+                    if (item.id >= s_next_id)
+                        s_next_id = item.id + 1;
+                    migrated++;
+                }
+            }
+            unlink(item_path);
+        }
+        closedir(dp);
+        if (migrated > 0) {
+            fprintf(stderr, "[akonadi] Migrated %d legacy items into "
+                    "the log store\n", migrated);
+            idx_save();
+        }
+    }
+
+    /* Payload search index: warm-load when it covers this exact log
+     * length, else rebuild from the live records */
+    if (!tg_index_load())
+        tg_index_rebuild();
+
+    return 0;
+}
+
 /* ======================================================================
  * Initialization
  * ====================================================================== */
@@ -368,6 +1182,11 @@ int akonadi_init(const char *data_dir)
         }
     }
 
+    if (log_store_open() != 0) {
+        fprintf(stderr, "[akonadi] Cannot open the item log store\n");
+        return -1;
+    }
+
     s_initialized = true;
     fprintf(stderr, "[akonadi] Data store initialized at %s\n", s_data_dir);
     return 0;
@@ -379,6 +1198,30 @@ void akonadi_shutdown(void)
         return;
     }
 
+    /* Persist the index; fold the log when over half of it is dead */
+    if (s_dead_bytes * 2 > s_log_size)
+        log_compact();
+    else
+        idx_save();
+    tg_index_save();
+    tg_index_free();
+
+    if (s_log_map) {
+        munmap(s_log_map, s_log_map_len);
+        s_log_map = NULL;
+        s_log_map_len = 0;
+    }
+    if (s_log_fd >= 0) {
+        close(s_log_fd);
+        s_log_fd = -1;
+    }
+    free(s_idx);
+    s_idx = NULL;
+    s_idx_count = s_idx_cap = 0;
+    s_log_size = 0;
+    s_dead_bytes = 0;
+    s_dirty_ops = 0;
+
     save_counter();
     s_initialized = false;
     fprintf(stderr, "[akonadi] Data store shut down\n");
@@ -536,24 +1379,24 @@ int64_t akonadi_add_item(int64_t collection_id, const char *mime_type,
         return -1;
     }
 
-    akonadi_item_t item = {0};
-    item.id = alloc_id();
-    item.collection_id = collection_id;
-    strncpy(item.mime_type, mime_type, AKONADI_MAX_MIME_TYPE - 1);
-    memcpy(item.payload, payload, (size_t)payload_len);
-    item.payload_len = payload_len;
+    int64_t id = alloc_id();
+    uint64_t off = log_append(id, collection_id, 0, mime_type, NULL,
+                              NULL, payload, payload_len);
 
-    if (write_item(&item) < 0) {
+    if (off == (uint64_t)-1) {
         return -1;
     }
+    idx_insert(id, collection_id, off);
+    tg_index_add(id, payload, payload_len);
+    checkpoint_maybe();
 
     update_collection_item_count(collection_id, 1);
 
     fprintf(stderr, "[akonadi] Added item id=%lld to collection %lld "
             "(%s, %d bytes)\n",
-            (long long)item.id, (long long)collection_id,
+            (long long)id, (long long)collection_id,
             mime_type, payload_len);
-    return item.id;
+    return id;
 }
 
 int akonadi_update_item(int64_t id, const char *payload, int payload_len)
@@ -566,20 +1409,32 @@ int akonadi_update_item(int64_t id, const char *payload, int payload_len)
         return -1;
     }
 
-    char item_path[512];
-    snprintf(item_path, sizeof(item_path),
-             "%s/items/%lld.dat", s_data_dir, (long long)id);
+    int at = idx_find(id, NULL);
+
+    if (at < 0) {
+        return -1;
+    }
 
     akonadi_item_t item;
-    if (read_item(item_path, &item) < 0) {
+
+    if (rec_to_item(s_idx[at].offset, &item) < 0) {
         return -1;
     }
 
-    memset(item.payload, 0, sizeof(item.payload));
-    memcpy(item.payload, payload, (size_t)payload_len);
-    item.payload_len = payload_len;
+    /* The old record becomes garbage; append the new version */
+    uint64_t off = log_append(id, item.collection_id, 0,
+                              item.mime_type, item.remote_id,
+                              item.flags, payload, payload_len);
 
-    return write_item(&item);
+    if (off == (uint64_t)-1) {
+        return -1;
+    }
+    s_dead_bytes += ((sizeof(log_rec_hdr) + item.payload_len + 7) & ~7u);
+    idx_insert(id, item.collection_id, off);
+    tg_index_remove(id, item.payload, item.payload_len);
+    tg_index_add(id, payload, payload_len);
+    checkpoint_maybe();
+    return 0;
 }
 
 int akonadi_delete_item(int64_t id)
@@ -588,19 +1443,30 @@ int akonadi_delete_item(int64_t id)
         return -1;
     }
 
-    char item_path[512];
-    snprintf(item_path, sizeof(item_path),
-             "%s/items/%lld.dat", s_data_dir, (long long)id);
+    int at = idx_find(id, NULL);
 
-    /* Read item to get collection_id for count update */
-    akonadi_item_t item;
-    if (read_item(item_path, &item) == 0) {
-        update_collection_item_count(item.collection_id, -1);
+    if (at < 0) {
+        return -1;
     }
 
-    if (unlink(item_path) < 0 && errno != ENOENT) {
+    int64_t col = s_idx[at].collection_id;
+    uint64_t dead = 0;
+    akonadi_item_t old;
+
+    if (rec_to_item(s_idx[at].offset, &old) == 0)
+        dead = (sizeof(log_rec_hdr) + old.payload_len + 7) & ~7u;
+
+    if (log_append(id, col, 1, NULL, NULL, NULL, NULL, 0) ==
+        (uint64_t)-1) {
         return -1;
     }
+    idx_remove(id);
+    if (dead > 0)
+        tg_index_remove(id, old.payload, old.payload_len);
+    s_dead_bytes += dead + sizeof(log_rec_hdr);
+    checkpoint_maybe();
+
+    update_collection_item_count(col, -1);
 
     fprintf(stderr, "[akonadi] Deleted item id=%lld\n", (long long)id);
     return 0;
@@ -612,11 +1478,12 @@ bool akonadi_get_item(int64_t id, akonadi_item_t *item_out)
         return false;
     }
 
-    char item_path[512];
-    snprintf(item_path, sizeof(item_path),
-             "%s/items/%lld.dat", s_data_dir, (long long)id);
+    int at = idx_find(id, NULL);
 
-    return (read_item(item_path, item_out) == 0);
+    if (at < 0) {
+        return false;
+    }
+    return rec_to_item(s_idx[at].offset, item_out) == 0;
 }
 
 int akonadi_search_items(int64_t collection_id, const char *query,
@@ -627,38 +1494,52 @@ int akonadi_search_items(int64_t collection_id, const char *query,
         return 0;
     }
 
-    char items_dir[512];
-    snprintf(items_dir, sizeof(items_dir), "%s/items", s_data_dir);
-
-    DIR *dp = opendir(items_dir);
-    if (!dp) {
-        return 0;
+    /* Trigram fast path: intersect posting lists and verify only the
+     * candidates instead of scanning every payload */
+    if (query && (int)strlen(query) >= 3) {
+        static int64_t cand[4096];
+        int nc = tg_candidates(query, cand, 4096);
+
+        /* A saturated candidate buffer could hide matches; only a
+         * complete candidate set may skip the scan */
+        if (nc >= 0 && nc < 4096) {
+            int count = 0;
+
+            for (int i = 0; i < nc && count < max; i++) {
+                int at = idx_find(cand[i], NULL);
+                akonadi_item_t item;
+
+                if (at < 0 ||
+                    rec_to_item(s_idx[at].offset, &item) < 0)
+                    continue;
+                if (collection_id > 0 &&
+                    item.collection_id != collection_id)
+                    continue;
+                if (mime_type && mime_type[0] != '\0' &&
+                    strcmp(item.mime_type, mime_type) != 0)
+                    continue;
+                if (strstr(item.payload, query) == NULL)
+                    continue;   /* trigram false positive */
+                out[count++] = item;
+            }
+            return count;
+        }
     }
 
+    /* Walk the index: collection filtering happens before any record
+     * is touched, so listing one folder reads only its records from
+     * the mapping */
     int count = 0;
-    struct dirent *ent;
-    while ((ent = readdir(dp)) != NULL && count < max) {
-        if (ent->d_name[0] == '.') {
-            continue;
-        }
 
-        /* Only process .dat files */
-        const char *ext = strrchr(ent->d_name, '.');
-        if (!ext || strcmp(ext, ".dat") != 0) {
+    for (uint32_t i = 0; i < s_idx_count && count < max; i++) {
+        if (collection_id > 0 &&
+            s_idx[i].collection_id != collection_id) {
             continue;
         }
 
-        char item_path[512];
-        snprintf(item_path, sizeof(item_path),
-                 "%s/%s", items_dir, ent->d_name);
-
         akonadi_item_t item;
-        if (read_item(item_path, &item) < 0) {
-            continue;
-        }
 
-        /* Filter by collection */
-        if (collection_id > 0 && item.collection_id != collection_id) {
+        if (rec_to_item(s_idx[i].offset, &item) < 0) {
             continue;
         }
 
@@ -678,7 +1559,6 @@ int akonadi_search_items(int64_t collection_id, const char *query,
         out[count++] = item;
     }
 
-    closedir(dp);
     return count;
 }
 
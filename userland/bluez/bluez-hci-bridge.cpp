@@ -16,13 +16,17 @@
 #include "bluez-hci-bridge.h"
 
 #include <QDebug>
+#include <QThread>
 
+#include <atomic>
 #include <cstring>
 #include <cstdlib>
 
 #include <unistd.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 #include <errno.h>
 
 /* ========================================================================= */
@@ -30,12 +34,21 @@
 /* ========================================================================= */
 
 /* H4 packet type indicators */
-static const uint8_t H4_COMMAND = 0x01;
-static const uint8_t H4_EVENT   = 0x04;
+static const uint8_t H4_COMMAND  = 0x01;
+static const uint8_t H4_ACL_DATA = 0x02;
+static const uint8_t H4_EVENT    = 0x04;
 
 /* Maximum HCI packet sizes */
 static const uint32_t HCI_MAX_COMMAND_LEN = 259;   /* 1 + 2 + 1 + 255 */
 static const uint32_t HCI_MAX_EVENT_LEN   = 259;   /* 1 + 1 + 1 + 255 + 1 (H4) */
+static const uint32_t HCI_MAX_ACL_LEN     = 1 + 4 + 1021;  /* H4 + hdr + data */
+
+/* Reader thread / ring transport */
+static const uint32_t HCI_RING_SIZE     = 64 * 1024;  /* power of two */
+static const uint32_t HCI_DRAIN_CHUNK   = 4096;       /* per-read batch */
+static const int      HCI_POLL_MS       = 200;        /* stop-flag latency */
+static const int      HCI_REPLY_WAIT_MS = 1000;       /* command replies */
+static const uint32_t HCI_MAX_SG_FRAGS  = 15;
 
 /* HCI status codes */
 static const uint8_t HCI_STATUS_SUCCESS          = 0x00;
@@ -51,20 +64,197 @@ static const uint8_t HCI_STATUS_CONN_TIMEOUT       = 0x08;
 /* Inquiry LAP: General/Unlimited Inquiry Access Code (GIAC) */
 static const uint8_t GIAC_LAP[3] = { 0x33, 0x8B, 0x9E };
 
+/* ========================================================================= */
+/* Lock-free SPSC packet ring                                                */
+/* ========================================================================= */
+
+/*
+ * Byte ring carrying length-prefixed H4 packets.  Single producer
+ * (the reader thread) advances head; single consumer (the bridge API
+ * caller) advances tail.  Indices are free-running and masked on
+ * access, so full/empty never alias.
+ */
+struct HciRing {
+    uint8_t buf[HCI_RING_SIZE];
+    std::atomic<uint32_t> head;
+    std::atomic<uint32_t> tail;
+};
+
+static void ring_init(HciRing *r)
+{
+    r->head.store(0, std::memory_order_relaxed);
+    r->tail.store(0, std::memory_order_relaxed);
+}
+
+/* Producer side; returns false when the packet does not fit */
+static bool ring_push(HciRing *r, const uint8_t *pkt, uint32_t len)
+{
+    uint32_t head = r->head.load(std::memory_order_relaxed);
+    uint32_t tail = r->tail.load(std::memory_order_acquire);
+    uint32_t need = len + 2;
+
+    if (HCI_RING_SIZE - (head - tail) < need)
+        return false;
+
+    r->buf[head & (HCI_RING_SIZE - 1)]       = (uint8_t)(len & 0xFF);
+    r->buf[(head + 1) & (HCI_RING_SIZE - 1)] = (uint8_t)(len >> 8);
+    for (uint32_t i = 0; i < len; ++i)
+        r->buf[(head + 2 + i) & (HCI_RING_SIZE - 1)] = pkt[i];
+
+    r->head.store(head + need, std::memory_order_release);
+    return true;
+}
+
+/* Consumer side; returns packet length, 0 when empty, or the packet
+ * length (truncated copy) when maxlen is too small */
+static uint32_t ring_pop(HciRing *r, uint8_t *out, uint32_t maxlen)
+{
+    uint32_t tail = r->tail.load(std::memory_order_relaxed);
+    uint32_t head = r->head.load(std::memory_order_acquire);
+
+    if (head == tail)
+        return 0;
+
+    uint32_t len = r->buf[tail & (HCI_RING_SIZE - 1)] |
+                   ((uint32_t)r->buf[(tail + 1) & (HCI_RING_SIZE - 1)] << 8);
+    uint32_t copy = len < maxlen ? len : maxlen;
+
+    for (uint32_t i = 0; i < copy; ++i)
+        out[i] = r->buf[(tail + 2 + i) & (HCI_RING_SIZE - 1)];
+
+    r->tail.store(tail + len + 2, std::memory_order_release);
+    return copy;
+}
+
 /* ========================================================================= */
 /* HciBridge internal state                                                  */
 /* ========================================================================= */
 
+class HciReaderThread;
+
 struct HciBridge {
     int fd;                     /* file descriptor for /dev/bluetooth/hciN */
     bool open;
     char dev_path[128];
 
-    /* Receive buffer for event reassembly */
-    uint8_t rx_buf[HCI_MAX_EVENT_LEN];
+    /* Reader thread and per-type packet rings */
+    HciReaderThread *reader;
+    HciRing         *evt_ring;
+    HciRing         *acl_ring;
+    std::atomic<bool> stop_reader;
+    uint32_t         rx_dropped;
+
+    /* Carry buffer for a packet split across read() chunks */
+    uint8_t  rx_buf[HCI_MAX_ACL_LEN];
     uint32_t rx_len;
 };
 
+/* ========================================================================= */
+/* Reader thread: batched drains of the HCI device                           */
+/* ========================================================================= */
+
+/* Total H4 packet length once enough header bytes are visible, or 0
+ * if more bytes are needed, or (uint32_t)-1 on an unknown type */
+static uint32_t h4_packet_len(const uint8_t *p, uint32_t avail)
+{
+    switch (p[0]) {
+    case H4_EVENT:
+        return avail >= 3 ? 3u + p[2] : 0;
+    case H4_ACL_DATA:
+        return avail >= 5 ? 5u + (p[3] | ((uint32_t)p[4] << 8)) : 0;
+    case H4_COMMAND:
+        return avail >= 4 ? 4u + p[3] : 0;
+    default:
+        return (uint32_t)-1;
+    }
+}
+
+class HciReaderThread : public QThread {
+public:
+    explicit HciReaderThread(HciBridge *b) : m_bridge(b) {}
+
+protected:
+    void run() override
+    {
+        HciBridge *b = m_bridge;
+
+        while (!b->stop_reader.load(std::memory_order_relaxed)) {
+            struct pollfd pfd;
+
+            pfd.fd      = b->fd;
+            pfd.events  = POLLIN;
+            pfd.revents = 0;
+            if (poll(&pfd, 1, HCI_POLL_MS) <= 0)
+                continue;
+
+            /* One read drains every packet the kernel has queued */
+            uint8_t chunk[HCI_DRAIN_CHUNK];
+            ssize_t n = read(b->fd, chunk, sizeof(chunk));
+
+            if (n < 0) {
+                if (errno == EAGAIN || errno == EINTR)
+                    continue;
+                qWarning("HciBridge: reader: read failed: %s",
+                         strerror(errno));
+                return;
+            }
+            if (n == 0)
+                continue;
+
+            dispatch(b, chunk, (uint32_t)n);
+        }
+    }
+
+private:
+    HciBridge *m_bridge;
+
+    /* Split a drained chunk into H4 packets, carrying partial tails */
+    static void dispatch(HciBridge *b, const uint8_t *data, uint32_t len)
+    {
+        while (len > 0) {
+            /* Top up the carry buffer */
+            uint32_t space = sizeof(b->rx_buf) - b->rx_len;
+            uint32_t take = len < space ? len : space;
+
+            memcpy(b->rx_buf + b->rx_len, data, take);
+            b->rx_len += take;
+            data += take;
+            len -= take;
+
+            /* Emit complete packets */
+            uint32_t pos = 0;
+            while (pos < b->rx_len) {
+                uint32_t plen = h4_packet_len(b->rx_buf + pos,
+                                              b->rx_len - pos);
+
+                if (plen == (uint32_t)-1 || plen > sizeof(b->rx_buf)) {
+                    /* Unknown type or impossible length: transport is
+                     * desynced; resync by discarding this chunk */
+                    qWarning("HciBridge: bad H4 packet (type 0x%02X), "
+                             "resyncing", b->rx_buf[pos]);
+                    pos = b->rx_len;
+                    break;
+                }
+                if (plen == 0 || pos + plen > b->rx_len)
+                    break;  /* incomplete; wait for the next drain */
+
+                HciRing *ring = b->rx_buf[pos] == H4_ACL_DATA ?
+                                b->acl_ring : b->evt_ring;
+
+                if (!ring_push(ring, b->rx_buf + pos, plen)) {
+                    if (b->rx_dropped++ % 64 == 0)
+                        qWarning("HciBridge: ring full, dropped %u "
+                                 "packets so far", b->rx_dropped);
+                }
+                pos += plen;
+            }
+
+            memmove(b->rx_buf, b->rx_buf + pos, b->rx_len - pos);
+            b->rx_len -= pos;
+        }
+    }
+};
+
 /* ========================================================================= */
 /* Helper: HCI status code to string                                         */
 /* ========================================================================= */
@@ -91,11 +281,11 @@ static const char *hci_status_str(uint8_t status)
 
 HciBridge *hci_bridge_new(void)
 {
-    HciBridge *bridge = new HciBridge;
+    /* Value-initialized: the atomic stop flag makes memset unsuitable */
+    HciBridge *bridge = new HciBridge();
     if (!bridge)
         return nullptr;
 
-    memset(bridge, 0, sizeof(*bridge));
     bridge->fd = -1;
     bridge->open = false;
 
@@ -121,8 +311,18 @@ bool hci_bridge_open(HciBridge *bridge, const char *dev_path)
         return false;
     }
 
+    bridge->evt_ring = new HciRing;
+    bridge->acl_ring = new HciRing;
+    ring_init(bridge->evt_ring);
+    ring_init(bridge->acl_ring);
+
     bridge->open = true;
     bridge->rx_len = 0;
+    bridge->rx_dropped = 0;
+    bridge->stop_reader.store(false, std::memory_order_relaxed);
+
+    bridge->reader = new HciReaderThread(bridge);
+    bridge->reader->start();
 
     qDebug("HciBridge: opened %s (fd=%d)", dev_path, bridge->fd);
     return true;
@@ -133,11 +333,23 @@ void hci_bridge_close(HciBridge *bridge)
     if (!bridge || !bridge->open)
         return;
 
+    /* Stop the reader (it polls, so it notices within HCI_POLL_MS)
+     * before the fd goes away */
+    bridge->stop_reader.store(true, std::memory_order_relaxed);
+    bridge->reader->wait();
+    delete bridge->reader;
+    bridge->reader = nullptr;
+
     close(bridge->fd);
     bridge->fd = -1;
     bridge->open = false;
     bridge->rx_len = 0;
 
+    delete bridge->evt_ring;
+    delete bridge->acl_ring;
+    bridge->evt_ring = nullptr;
+    bridge->acl_ring = nullptr;
+
     qDebug("HciBridge: closed %s", bridge->dev_path);
 }
 
@@ -201,46 +413,133 @@ int hci_bridge_recv_event(HciBridge *bridge, uint8_t *buf, uint32_t maxlen)
     if (!bridge || !bridge->open || !buf || maxlen < 3)
         return -1;
 
-    /* Read from the device -- the kernel delivers complete HCI events.
-     * The first byte is the H4 event indicator (0x04), followed by
-     * event_code, param_len, and parameters. */
+    /* Serve from the reader thread's ring -- no syscall here */
     uint8_t raw[HCI_MAX_EVENT_LEN];
-    ssize_t nread = read(bridge->fd, raw, sizeof(raw));
-
-    if (nread < 0) {
-        if (errno == EAGAIN || errno == EINTR)
-            return 0;  /* no event available */
-        qWarning("HciBridge: read failed: %s", strerror(errno));
-        return -1;
-    }
+    uint32_t nread = ring_pop(bridge->evt_ring, raw, sizeof(raw));
 
+    if (nread == 0)
+        return 0;  /* no event pending */
     if (nread < 3) {
-        qWarning("HciBridge: short read (%zd bytes)", nread);
+        qWarning("HciBridge: short event packet (%u bytes)", nread);
         return -1;
     }
 
-    /* Verify H4 event indicator */
-    uint32_t offset = 0;
-    if (raw[0] == H4_EVENT) {
-        offset = 1;  /* skip H4 type byte */
-    }
+    /* Strip the H4 event indicator */
+    uint32_t offset = raw[0] == H4_EVENT ? 1 : 0;
+    uint32_t event_len = nread - offset;
 
-    /* Copy event_code + param_len + params into output buffer */
-    uint32_t event_len = (uint32_t)(nread - offset);
     if (event_len > maxlen)
         event_len = maxlen;
-
     memcpy(buf, &raw[offset], event_len);
 
-    uint8_t event_code = buf[0];
-    uint8_t param_len = (event_len >= 2) ? buf[1] : 0;
-
     qDebug("HciBridge: received event code=0x%02X param_len=%u",
-           event_code, param_len);
+           buf[0], event_len >= 2 ? buf[1] : 0);
 
     return (int)event_len;
 }
 
+int hci_bridge_recv_acl(HciBridge *bridge, uint8_t *buf, uint32_t maxlen)
+{
+    if (!bridge || !bridge->open || !buf || maxlen < 4)
+        return -1;
+
+    uint8_t raw[HCI_MAX_ACL_LEN];
+    uint32_t nread = ring_pop(bridge->acl_ring, raw, sizeof(raw));
+
+    if (nread == 0)
+        return 0;
+    if (nread < 5)
+        return -1;
+
+    /* Strip the H4 type byte; hand back handle+flags, length, data */
+    uint32_t data_len = nread - 1;
+
+    if (data_len > maxlen)
+        data_len = maxlen;
+    memcpy(buf, raw + 1, data_len);
+    return (int)data_len;
+}
+
+/* Bounded wait used by the synchronous command wrappers below.
+ * Non-matching events popped while waiting are discarded, same as
+ * the old single-read behavior -- call these wrappers only during
+ * setup, before the owner's event polling is live. */
+static int recv_event_wait(HciBridge *bridge, uint8_t wanted_code,
+                           uint8_t *buf, uint32_t maxlen)
+{
+    for (int waited = 0; waited < HCI_REPLY_WAIT_MS; ) {
+        int len = hci_bridge_recv_event(bridge, buf, maxlen);
+
+        if (len < 0)
+            return -1;
+        if (len >= 2 && buf[0] == wanted_code)
+            return len;
+        if (len == 0) {
+            usleep(2000);
+            waited += 2;
+        }
+    }
+    return -1;
+}
+
+bool hci_bridge_send_acl(HciBridge *bridge, uint16_t handle,
+                         const struct iovec *frags, uint32_t nfrags)
+{
+    if (!bridge || !bridge->open || !frags || nfrags == 0 ||
+        nfrags > HCI_MAX_SG_FRAGS)
+        return false;
+
+    size_t data_len = 0;
+    for (uint32_t i = 0; i < nfrags; ++i)
+        data_len += frags[i].iov_len;
+    if (data_len > 0xFFFF)
+        return false;
+
+    /* H4 type + ACL header, then the caller's fragments untouched */
+    uint8_t hdr[5];
+    hdr[0] = H4_ACL_DATA;
+    hdr[1] = (uint8_t)(handle & 0xFF);
+    hdr[2] = (uint8_t)(handle >> 8);
+    hdr[3] = (uint8_t)(data_len & 0xFF);
+    hdr[4] = (uint8_t)(data_len >> 8);
+
+    struct iovec iov[HCI_MAX_SG_FRAGS + 1];
+    iov[0].iov_base = hdr;
+    iov[0].iov_len  = sizeof(hdr);
+    for (uint32_t i = 0; i < nfrags; ++i)
+        iov[1 + i] = frags[i];
+
+    uint32_t iovcnt = nfrags + 1;
+    size_t   total = sizeof(hdr) + data_len;
+    uint32_t first = 0;
+
+    /* One writev per packet; advance the vector on a short write */
+    while (total > 0) {
+        ssize_t n = writev(bridge->fd, &iov[first], (int)(iovcnt - first));
+
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            qWarning("HciBridge: ACL writev failed: %s", strerror(errno));
+            return false;
+        }
+
+        total -= (size_t)n;
+        while (n > 0 && first < iovcnt) {
+            if ((size_t)n >= iov[first].iov_len) {
+                n -= (ssize_t)iov[first].iov_len;
+                first++;
+            } else {
+                iov[first].iov_base = (uint8_t *)iov[first].iov_base + n;
+                iov[first].iov_len -= (size_t)n;
+                n = 0;
+            }
+        }
+    }
+
+    return true;
+}
+
 /* ========================================================================= */
 /* Convenience wrappers                                                      */
 /* ========================================================================= */
@@ -294,13 +593,10 @@ bool hci_bridge_get_local_address(HciBridge *bridge, uint8_t *addr_out)
 
     /* Wait for Command Complete event */
     uint8_t evt_buf[HCI_MAX_EVENT_LEN];
-    int evt_len = hci_bridge_recv_event(bridge, evt_buf, sizeof(evt_buf));
-    if (evt_len < 2)
-        return false;
-
-    uint8_t event_code = evt_buf[0];
-    if (event_code != HCI_EVT_COMMAND_COMPLETE) {
-        qWarning("HciBridge: expected CommandComplete, got 0x%02X", event_code);
+    int evt_len = recv_event_wait(bridge, HCI_EVT_COMMAND_COMPLETE,
+                                  evt_buf, sizeof(evt_buf));
+    if (evt_len < 2) {
+        qWarning("HciBridge: no CommandComplete for Read_BD_ADDR");
         return false;
     }
 
@@ -337,13 +633,10 @@ bool hci_bridge_get_local_name(HciBridge *bridge, char *name_out,
 
     /* Wait for Command Complete event */
     uint8_t evt_buf[HCI_MAX_EVENT_LEN];
-    int evt_len = hci_bridge_recv_event(bridge, evt_buf, sizeof(evt_buf));
-    if (evt_len < 2)
-        return false;
-
-    uint8_t event_code = evt_buf[0];
-    if (event_code != HCI_EVT_COMMAND_COMPLETE) {
-        qWarning("HciBridge: expected CommandComplete, got 0x%02X", event_code);
+    int evt_len = recv_event_wait(bridge, HCI_EVT_COMMAND_COMPLETE,
+                                  evt_buf, sizeof(evt_buf));
+    if (evt_len < 2) {
+        qWarning("HciBridge: no CommandComplete for Read_Local_Name");
         return false;
     }
 
@@ -377,3 +670,59 @@ bool hci_bridge_get_local_name(HciBridge *bridge, char *name_out,
     qDebug("HciBridge: local name '%s'", name_out);
     return true;
 }
+
+/* ========================================================================= */
+/* SDP assist                                                                */
+/* ========================================================================= */
+
+/*
+ * The kernel's Bluetooth stack runs the actual SDP transaction over
+ * L2CAP (same pattern as the DHCP client: start ioctl, status
+ * ioctl), so the bridge's event loop never blocks on discovery.
+ */
+
+static const unsigned long VERIDIAN_SDP_START  = 0x8E01;
+static const unsigned long VERIDIAN_SDP_STATUS = 0x8E02;
+
+struct VeridianSdpReq {
+    uint8_t  addr[6];
+    uint8_t  state;             /* Out: 0 idle, 1 running, 2 done, 3 failed */
+    uint8_t  record_count;
+    BtSdpRecord *records;       /* Caller buffer */
+    uint32_t max_records;
+};
+
+int hci_bridge_sdp_start(HciBridge *bridge, const uint8_t *addr)
+{
+    if (!bridge || !bridge->open || !addr)
+        return -1;
+
+    VeridianSdpReq req;
+    memset(&req, 0, sizeof(req));
+    memcpy(req.addr, addr, 6);
+
+    if (ioctl(bridge->fd, VERIDIAN_SDP_START, &req) < 0)
+        return -1;
+    return 0;
+}
+
+int hci_bridge_sdp_poll(HciBridge *bridge, const uint8_t *addr,
+                        BtSdpRecord *records, uint32_t max_records)
+{
+    if (!bridge || !bridge->open || !addr || !records)
+        return -2;
+
+    VeridianSdpReq req;
+    memset(&req, 0, sizeof(req));
+    memcpy(req.addr, addr, 6);
+    req.records = records;
+    req.max_records = max_records;
+
+    if (ioctl(bridge->fd, VERIDIAN_SDP_STATUS, &req) < 0)
+        return -2;
+    if (req.state == 2)
+        return (int)req.record_count;
+    if (req.state == 3)
+        return -2;
+    return -1;                  /* Still running */
+}
@@ -17,6 +17,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <sys/uio.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -101,14 +102,65 @@ bool hci_bridge_send_command(HciBridge *bridge, uint16_t opcode,
 
 /**
  * Receive the next HCI event from the controller.
- * Blocks until an event is available or the timeout expires.
+ * Non-blocking: events are drained from the device in batches by a
+ * reader thread and served from a lock-free ring, so this never
+ * issues a syscall.  Call in a loop to drain everything pending.
  * @param bridge   Bridge instance.
  * @param buf      Buffer to receive the event (event_code + param_len + params).
  * @param maxlen   Maximum buffer size.
- * @return Number of bytes written to buf, or -1 on error/timeout.
+ * @return Number of bytes written to buf, 0 if no event is pending,
+ *         or -1 on error.
  */
 int hci_bridge_recv_event(HciBridge *bridge, uint8_t *buf, uint32_t maxlen);
 
+/**
+ * Receive the next inbound ACL data packet (handle + flags LE16,
+ * data length LE16, payload), if any.  Non-blocking, served from the
+ * same reader thread's ACL ring.
+ * @return Number of bytes written to buf, 0 if none, -1 on error.
+ */
+int hci_bridge_recv_acl(HciBridge *bridge, uint8_t *buf, uint32_t maxlen);
+
+/**
+ * Send an outgoing ACL data packet from multiple fragments with one
+ * writev() -- L2CAP segmentation hands its header and payload pieces
+ * here without coalescing copies or per-fragment syscalls.
+ * @param bridge  Bridge instance.
+ * @param handle  Connection handle with PB/BC flags in bits 12-15.
+ * @param frags   Payload fragments.
+ * @param nfrags  Number of fragments (max 15).
+ * @return true if the full packet was written.
+ */
+bool hci_bridge_send_acl(HciBridge *bridge, uint16_t handle,
+                         const struct iovec *frags, uint32_t nfrags);
+
+/* ========================================================================= */
+/* SDP assist                                                                */
+/* ========================================================================= */
+
+/** One discovered SDP service record. */
+typedef struct {
+    uint16_t uuid;              /* Service class UUID16 */
+    uint16_t channel;           /* RFCOMM channel or L2CAP PSM */
+    char     name[32];          /* Service name, NUL-terminated */
+} BtSdpRecord;
+
+/**
+ * Start an SDP service search on the device (kernel-assisted,
+ * VERIDIAN_SDP_START ioctl).  Non-blocking: returns immediately and
+ * the transaction proceeds alongside the HCI event flow.
+ * @return 0 on submit, -1 when the kernel lacks the assist.
+ */
+int hci_bridge_sdp_start(HciBridge *bridge, const uint8_t *addr);
+
+/**
+ * Poll a running SDP search.  Non-blocking.
+ * @return record count (>= 0) when complete, -1 while pending,
+ *         -2 on failure.
+ */
+int hci_bridge_sdp_poll(HciBridge *bridge, const uint8_t *addr,
+                        BtSdpRecord *records, uint32_t max_records);
+
 /* ========================================================================= */
 /* Convenience wrappers                                                      */
 /* ========================================================================= */
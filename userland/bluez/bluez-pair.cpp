@@ -23,6 +23,10 @@
 #include <cstdlib>
 #include <cstdio>
 
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
 /* ========================================================================= */
 /* Constants                                                                 */
 /* ========================================================================= */
@@ -53,6 +57,12 @@ struct BtPairingAgent {
     /* D-Bus registration */
     char object_path[128];
     bool registered;
+
+    /* SDP cache + in-flight discoveries (bt_sdp_* below) */
+    struct BtSdpCacheEntry *sdp_cache;
+    uint32_t sdp_cache_count;
+    bool     sdp_cache_loaded;
+    struct BtSdpPending *sdp_pending;
 };
 
 /* ========================================================================= */
@@ -141,6 +151,9 @@ void bt_pairing_destroy(BtPairingAgent *agent)
 
     unregister_agent_dbus(agent);
 
+    delete[] agent->sdp_cache;
+    delete[] agent->sdp_pending;
+
     qDebug("BtPairing: pairing agent destroyed");
     delete agent;
 }
@@ -296,3 +309,210 @@ BtPairingState bt_pairing_get_state(const BtPairingAgent *agent)
         return BT_PAIRING_IDLE;
     return agent->state;
 }
+
+/* ========================================================================= */
+/* SDP discovery with persistent cache                                       */
+/* ========================================================================= */
+
+/*
+ * Per-device service records persist across sessions in a small
+ * binary cache (tmp+rename publication).  Entries are keyed by the
+ * device address and validated against its Device-ID attributes
+ * (vendor/product/version): a firmware update changes them and the
+ * stale records are re-discovered.  The radio is only touched on a
+ * genuine miss, and even then asynchronously -- the HCI event loop
+ * ticks bt_sdp_poll() and never blocks on the transaction.
+ */
+
+#define BT_SDP_MAX_CACHE    32
+#define BT_SDP_MAX_RECORDS  8
+#define BT_SDP_MAX_PENDING  4
+#define BT_SDP_CACHE_MAGIC  0x50445356u     /* "VSDP" */
+#define BT_SDP_CACHE_PATH   "/var/cache/veridian/btsdp.cache"
+
+struct BtSdpCacheEntry {
+    uint8_t  addr[BT_ADDR_LEN];
+    uint16_t vendor_id;
+    uint16_t product_id;
+    uint16_t version;
+    uint16_t record_count;
+    BtSdpRecord records[BT_SDP_MAX_RECORDS];
+};
+
+struct BtSdpPending {
+    bool     used;
+    uint8_t  addr[BT_ADDR_LEN];
+    uint16_t vendor_id;
+    uint16_t product_id;
+    uint16_t version;
+    bt_sdp_done_fn callback;
+    void    *user_data;
+};
+
+static void sdp_cache_load(BtPairingAgent *agent)
+{
+    if (agent->sdp_cache_loaded)
+        return;
+    agent->sdp_cache_loaded = true;
+    agent->sdp_cache = new BtSdpCacheEntry[BT_SDP_MAX_CACHE];
+    agent->sdp_pending = new BtSdpPending[BT_SDP_MAX_PENDING];
+    memset(agent->sdp_cache, 0,
+           sizeof(BtSdpCacheEntry) * BT_SDP_MAX_CACHE);
+    memset(agent->sdp_pending, 0,
+           sizeof(BtSdpPending) * BT_SDP_MAX_PENDING);
+    agent->sdp_cache_count = 0;
+
+    int fd = open(BT_SDP_CACHE_PATH, O_RDONLY);
+    if (fd < 0)
+        return;
+
+    uint32_t magic = 0, count = 0;
+    if (read(fd, &magic, 4) == 4 && magic == BT_SDP_CACHE_MAGIC &&
+        read(fd, &count, 4) == 4 && count <= BT_SDP_MAX_CACHE) {
+        ssize_t want = (ssize_t)(count * sizeof(BtSdpCacheEntry));
+
+        if (read(fd, agent->sdp_cache, (size_t)want) == want)
+            agent->sdp_cache_count = count;
+    }
+    close(fd);
+    qDebug("BtPairing: loaded %u cached SDP entries",
+           agent->sdp_cache_count);
+}
+
+static void sdp_cache_save(const BtPairingAgent *agent)
+{
+    char tmp[sizeof(BT_SDP_CACHE_PATH) + 8];
+
+    mkdir("/var/cache", 0755);
+    mkdir("/var/cache/veridian", 0755);
+    snprintf(tmp, sizeof(tmp), "%s.tmp", BT_SDP_CACHE_PATH);
+
+    int fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return;
+
+    uint32_t magic = BT_SDP_CACHE_MAGIC;
+    bool ok = write(fd, &magic, 4) == 4 &&
+              write(fd, &agent->sdp_cache_count, 4) == 4 &&
+              write(fd, agent->sdp_cache,
+                    agent->sdp_cache_count * sizeof(BtSdpCacheEntry)) ==
+                  (ssize_t)(agent->sdp_cache_count *
+                            sizeof(BtSdpCacheEntry));
+    close(fd);
+    if (ok)
+        rename(tmp, BT_SDP_CACHE_PATH);
+    else
+        unlink(tmp);
+}
+
+static BtSdpCacheEntry *sdp_cache_find(BtPairingAgent *agent,
+                                       const uint8_t *addr)
+{
+    for (uint32_t i = 0; i < agent->sdp_cache_count; i++) {
+        if (memcmp(agent->sdp_cache[i].addr, addr, BT_ADDR_LEN) == 0)
+            return &agent->sdp_cache[i];
+    }
+    return nullptr;
+}
+
+static void sdp_cache_store(BtPairingAgent *agent, const uint8_t *addr,
+                            uint16_t vendor, uint16_t product,
+                            uint16_t version, const BtSdpRecord *recs,
+                            uint32_t count)
+{
+    BtSdpCacheEntry *e = sdp_cache_find(agent, addr);
+
+    if (!e) {
+        if (agent->sdp_cache_count < BT_SDP_MAX_CACHE) {
+            e = &agent->sdp_cache[agent->sdp_cache_count++];
+        } else {
+            e = &agent->sdp_cache[0];   /* Evict the oldest slot */
+        }
+        memcpy(e->addr, addr, BT_ADDR_LEN);
+    }
+    e->vendor_id = vendor;
+    e->product_id = product;
+    e->version = version;
+    if (count > BT_SDP_MAX_RECORDS)
+        count = BT_SDP_MAX_RECORDS;
+    e->record_count = (uint16_t)count;
+    memcpy(e->records, recs, count * sizeof(BtSdpRecord));
+
+    sdp_cache_save(agent);
+}
+
+bool bt_sdp_discover_async(BtPairingAgent *agent, HciBridge *bridge,
+                           const uint8_t *address,
+                           uint16_t vendor_id, uint16_t product_id,
+                           uint16_t version,
+                           bt_sdp_done_fn callback, void *user_data)
+{
+    if (!agent || !address || !callback)
+        return false;
+
+    sdp_cache_load(agent);
+
+    /* Warm reconnect: matching version attributes prove the records
+     * are current -- complete without touching the radio */
+    BtSdpCacheEntry *e = sdp_cache_find(agent, address);
+    if (e && e->vendor_id == vendor_id && e->product_id == product_id &&
+        e->version == version && e->record_count > 0) {
+        char addr_str[18];
+
+        format_addr(address, addr_str, sizeof(addr_str));
+        qDebug("BtPairing: SDP cache hit for %s (%u records)",
+               addr_str, e->record_count);
+        callback(address, e->records, e->record_count, true, user_data);
+        return true;
+    }
+
+    /* Miss (or stale firmware attrs): discover in the background */
+    if (!bridge || hci_bridge_sdp_start(bridge, address) < 0)
+        return false;
+
+    for (int i = 0; i < BT_SDP_MAX_PENDING; i++) {
+        BtSdpPending *p = &agent->sdp_pending[i];
+
+        if (p->used)
+            continue;
+        p->used = true;
+        memcpy(p->addr, address, BT_ADDR_LEN);
+        p->vendor_id = vendor_id;
+        p->product_id = product_id;
+        p->version = version;
+        p->callback = callback;
+        p->user_data = user_data;
+        return true;
+    }
+    return false;               /* Too many in flight */
+}
+
+void bt_sdp_poll(BtPairingAgent *agent, HciBridge *bridge)
+{
+    if (!agent || !agent->sdp_cache_loaded || !bridge)
+        return;
+
+    for (int i = 0; i < BT_SDP_MAX_PENDING; i++) {
+        BtSdpPending *p = &agent->sdp_pending[i];
+        BtSdpRecord recs[BT_SDP_MAX_RECORDS];
+
+        if (!p->used)
+            continue;
+
+        int r = hci_bridge_sdp_poll(bridge, p->addr, recs,
+                                    BT_SDP_MAX_RECORDS);
+        if (r == -1)
+            continue;           /* Still running */
+
+        p->used = false;
+        if (r >= 0) {
+            sdp_cache_store(agent, p->addr, p->vendor_id,
+                            p->product_id, p->version, recs,
+                            (uint32_t)r);
+            p->callback(p->addr, recs, (uint32_t)r, false,
+                        p->user_data);
+        } else {
+            p->callback(p->addr, nullptr, 0, false, p->user_data);
+        }
+    }
+}
@@ -109,6 +109,42 @@ void bt_pairing_cancel(BtPairingAgent *agent, const uint8_t *address);
  */
 BtPairingState bt_pairing_get_state(const BtPairingAgent *agent);
 
+/* ========================================================================= */
+/* SDP discovery with persistent cache                                       */
+/* ========================================================================= */
+
+#include "bluez-hci-bridge.h"
+
+/**
+ * Completion callback.  from_cache is true when the records came
+ * from the persistent cache (no radio transaction happened); count
+ * is 0 on discovery failure.
+ */
+typedef void (*bt_sdp_done_fn)(const uint8_t *address,
+                               const BtSdpRecord *records,
+                               uint32_t count, bool from_cache,
+                               void *user_data);
+
+/**
+ * Asynchronous SDP service discovery.  Records cached for the
+ * device (keyed by its Device-ID version attributes, so a firmware
+ * update invalidates them) complete the callback immediately --
+ * a headphone reconnect never waits on the radio.  Otherwise the
+ * query is started kernel-side and the callback fires from
+ * bt_sdp_poll() when it lands.  Never blocks.
+ */
+bool bt_sdp_discover_async(BtPairingAgent *agent, HciBridge *bridge,
+                           const uint8_t *address,
+                           uint16_t vendor_id, uint16_t product_id,
+                           uint16_t version,
+                           bt_sdp_done_fn callback, void *user_data);
+
+/**
+ * Drive in-flight discoveries; call from the HCI event loop tick.
+ * Completions (and the cache write-through) happen here.
+ */
+void bt_sdp_poll(BtPairingAgent *agent, HciBridge *bridge);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
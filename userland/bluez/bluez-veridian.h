@@ -371,6 +371,44 @@ bool bt_init(void);
  */
 void bt_cleanup(void);
 
+/* ========================================================================= */
+/* Audio links (A2DP data path)                                              */
+/* ========================================================================= */
+
+/**
+ * Open a zero-allocation audio link on an ACL connection: the frame
+ * ring is sized and allocated here, once, and the steady-state
+ * submit/flush path never touches the heap afterwards.
+ * @param handle       ACL connection handle.
+ * @param frame_size   Largest media packet the encoder produces.
+ * @param frame_count  Ring depth (power of two recommended).
+ * @return link id >= 0, or -1 (no slot / allocation failed).
+ */
+int bt_audio_link_open(uint16_t handle, uint32_t frame_size,
+                       uint32_t frame_count);
+
+/**
+ * Queue one media packet.  The payload is copied into a
+ * preallocated ring slot -- no heap operations.  Returns false when
+ * the ring is full (caller drops the frame; late audio is worse
+ * than lost audio).
+ */
+bool bt_audio_link_submit(int link, const uint8_t *data, uint32_t len);
+
+/**
+ * Push queued frames to the controller (one writev per frame via
+ * the bridge's scatter-gather ACL send).  Returns frames sent.
+ * Zero-allocation.
+ */
+int bt_audio_link_flush(int link);
+
+/** Close the link and release its ring. */
+void bt_audio_link_close(int link);
+
+/** Steady-state counters: submitted, sent, dropped (ring full). */
+void bt_audio_link_stats(int link, uint64_t *submitted,
+                         uint64_t *sent, uint64_t *dropped);
+
 /**
  * Set the pairing agent callbacks.
  * Must be called before pairing operations.
@@ -2,24 +2,67 @@
  *
  * VeridianOS coreutil.  Validates file open/read/write/close loop.
  *
+ * Data moves through the kernel splice() path when available, so
+ * pipeline stages transfer pages by reference instead of copying
+ * every byte user->kernel->user; when the kernel lacks the syscall
+ * (or neither side supports it) cat falls back to a 64 KiB
+ * read/write loop.
+ *
  * Usage: cat [FILE...]
  *   With no FILE, or when FILE is -, read standard input.
  *
  * Self-test: cat /usr/src/cat_test.txt -> output ends with "CAT_PASS"
  *
- * Syscalls exercised: open, read, write, close
+ * Syscalls exercised: open, splice/read, write, close
  */
 
+#include <errno.h>
 #include <fcntl.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
-#define BUF_SIZE 4096
+#define BUF_SIZE     (64 * 1024)
+#define SPLICE_CHUNK (1024 * 1024)
+
+/* 0 = untested, 1 = kernel splice works, -1 = read/write fallback */
+static int splice_mode = 0;
 
 static int cat_fd(int fd)
 {
-    char buf[BUF_SIZE];
+    /* Zero-copy path first: one fd-to-fd transfer per chunk */
+    if (splice_mode >= 0) {
+        ssize_t s;
+
+        while ((s = splice(fd, NULL, 1, NULL, SPLICE_CHUNK, 0)) > 0)
+            splice_mode = 1;
+
+        if (s == 0) {
+            /* A zero return is EOF through a working splice -- only a
+             * present, supported syscall can report it */
+            splice_mode = 1;
+            return 0;
+        }
+        if (splice_mode == 1) {
+            perror("cat: splice");
+            return 1;
+        }
+        /* First attempt failed (ENOSYS, or fds unsupported): fall
+         * back for the rest of the process */
+        splice_mode = -1;
+    }
+
+    static char *buf;
+
+    if (!buf) {
+        buf = malloc(BUF_SIZE);
+        if (!buf) {
+            write(2, "cat: out of memory\n", 19);
+            return 1;
+        }
+    }
+
     int n;
 
     while ((n = read(fd, buf, BUF_SIZE)) > 0) {
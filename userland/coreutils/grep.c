@@ -0,0 +1,501 @@
+/* grep.c -- multi-pattern line matcher
+ *
+ * VeridianOS coreutil.  Built for log analysis speed:
+ *
+ *   - Input is mmap'd (PROT_READ) and scanned in place; files that
+ *     refuse to map fall back to buffered reads.
+ *   - Single literal patterns scan with memchr on the first byte
+ *     (the SIMD kernels in libc string.c) and verify with memcmp.
+ *   - Multiple patterns (-e repeated, -f FILE) compile into one
+ *     Aho-Corasick automaton: every line is matched against all
+ *     patterns in a single pass regardless of pattern count.
+ *   - Multiple files distribute across the shared thread pool
+ *     (veridian/threadpool.h); each worker buffers its file's
+ *     output so results print in argument order.
+ *
+ * Usage: grep [-cilnv] [-e PATTERN]... [-f FILE] PATTERN... FILE...
+ *   -c  Print only a count of matching lines per file.
+ *   -i  Case-insensitive matching.
+ *   -l  Print only names of files with matches.
+ *   -n  Prefix each line with its line number.
+ *   -v  Select non-matching lines.
+ *
+ * Exit status: 0 if any line matched, 1 if none, 2 on error.
+ *
+ * Syscalls exercised: open, mmap, read, write, close + thread pool
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <veridian/threadpool.h>
+
+#define MAX_PATTERNS   64
+#define MAX_PAT_BYTES  8192
+#define MAX_FILES      256
+
+/* ========================================================================= */
+/* Options and patterns                                                      */
+/* ========================================================================= */
+
+static int opt_count, opt_icase, opt_names, opt_numbers, opt_invert;
+
+static const char *patterns[MAX_PATTERNS];
+static int pattern_count;
+
+static unsigned char lower[256];
+
+static void lower_init(void)
+{
+    for (int i = 0; i < 256; i++)
+        lower[i] = (i >= 'A' && i <= 'Z') ? (unsigned char)(i + 32)
+                                          : (unsigned char)i;
+}
+
+static unsigned char fold(unsigned char c)
+{
+    return opt_icase ? lower[c] : c;
+}
+
+/* ========================================================================= */
+/* Aho-Corasick automaton (multi-pattern)                                    */
+/* ========================================================================= */
+
+/*
+ * One node per pattern-trie state; byte-indexed goto table.  States
+ * are bounded by total pattern bytes, so the automaton is at most
+ * MAX_PAT_BYTES + 1 nodes.  match marks accepting states; fail
+ * links are resolved breadth-first, and the scan loop follows them
+ * inline so matching is O(line length) for any pattern set.
+ */
+
+struct ac_node {
+    int32_t next[256];          /* -1 = no edge */
+    int32_t fail;
+    int32_t match;              /* Accepting state */
+};
+
+static struct ac_node *ac_nodes;
+static int ac_count;
+
+static int ac_new_node(void)
+{
+    struct ac_node *n = &ac_nodes[ac_count];
+
+    memset(n->next, 0xFF, sizeof(n->next));
+    n->fail = 0;
+    n->match = 0;
+    return ac_count++;
+}
+
+static int ac_build(void)
+{
+    ac_nodes = calloc(MAX_PAT_BYTES + 1, sizeof(struct ac_node));
+    if (!ac_nodes)
+        return -1;
+    ac_count = 0;
+    ac_new_node();              /* Root */
+
+    for (int p = 0; p < pattern_count; p++) {
+        int state = 0;
+
+        for (const char *c = patterns[p]; *c; c++) {
+            unsigned char b = fold((unsigned char)*c);
+
+            if (ac_nodes[state].next[b] < 0) {
+                if (ac_count > MAX_PAT_BYTES)
+                    return -1;
+                ac_nodes[state].next[b] = ac_new_node();
+            }
+            state = ac_nodes[state].next[b];
+        }
+        ac_nodes[state].match = 1;
+    }
+
+    /* Fail links, breadth-first */
+    int32_t *queue = malloc((size_t)ac_count * sizeof(int32_t));
+    int qh = 0, qt = 0;
+
+    if (!queue)
+        return -1;
+    for (int b = 0; b < 256; b++) {
+        int32_t s = ac_nodes[0].next[b];
+
+        if (s >= 0) {
+            ac_nodes[s].fail = 0;
+            queue[qt++] = s;
+        } else {
+            ac_nodes[0].next[b] = 0;    /* Root self-loops */
+        }
+    }
+    while (qh < qt) {
+        int32_t u = queue[qh++];
+
+        for (int b = 0; b < 256; b++) {
+            int32_t v = ac_nodes[u].next[b];
+
+            if (v < 0) {
+                /* Path-compress the failure transition */
+                ac_nodes[u].next[b] = ac_nodes[ac_nodes[u].fail].next[b];
+                continue;
+            }
+            ac_nodes[v].fail = ac_nodes[ac_nodes[u].fail].next[b];
+            if (ac_nodes[ac_nodes[v].fail].match)
+                ac_nodes[v].match = 1;
+            queue[qt++] = v;
+        }
+    }
+    free(queue);
+    return 0;
+}
+
+/* Does the automaton hit anywhere in [line, line+len)? */
+static int ac_match(const char *line, size_t len)
+{
+    int32_t state = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        state = ac_nodes[state].next[fold((unsigned char)line[i])];
+        if (ac_nodes[state].match)
+            return 1;
+    }
+    return 0;
+}
+
+/* ========================================================================= */
+/* Single-literal fast path                                                  */
+/* ========================================================================= */
+
+static int literal_match(const char *line, size_t len,
+                         const char *pat, size_t plen)
+{
+    if (plen == 0 || plen > len)
+        return plen == 0;
+
+    if (!opt_icase) {
+        /* memchr vaults between first-byte candidates (SIMD in
+         * string.c), memcmp verifies */
+        const char *p = line;
+        const char *end = line + len - plen + 1;
+
+        while (p < end) {
+            const char *hit = memchr(p, pat[0], (size_t)(end - p));
+
+            if (!hit)
+                return 0;
+            if (memcmp(hit, pat, plen) == 0)
+                return 1;
+            p = hit + 1;
+        }
+        return 0;
+    }
+
+    for (size_t i = 0; i + plen <= len; i++) {
+        size_t j = 0;
+
+        while (j < plen &&
+               fold((unsigned char)line[i + j]) ==
+                   fold((unsigned char)pat[j]))
+            j++;
+        if (j == plen)
+            return 1;
+    }
+    return 0;
+}
+
+/* ========================================================================= */
+/* Per-file scanning                                                         */
+/* ========================================================================= */
+
+struct grep_job {
+    const char *path;
+    int    show_name;           /* Multiple files: prefix names */
+    char  *out;                 /* Buffered output (ordered print) */
+    size_t out_len;
+    size_t out_cap;
+    long   matches;
+    int    error;
+};
+
+static void job_emit(struct grep_job *j, const char *buf, size_t len)
+{
+    if (j->out_len + len > j->out_cap) {
+        size_t ncap = j->out_cap ? j->out_cap * 2 : 8192;
+
+        while (ncap < j->out_len + len)
+            ncap *= 2;
+        char *nout = realloc(j->out, ncap);
+
+        if (!nout)
+            return;
+        j->out = nout;
+        j->out_cap = ncap;
+    }
+    memcpy(j->out + j->out_len, buf, len);
+    j->out_len += len;
+}
+
+static void job_emit_line(struct grep_job *j, const char *line,
+                          size_t len, long lineno)
+{
+    char prefix[320];
+    int n = 0;
+
+    if (j->show_name)
+        n += snprintf(prefix + n, sizeof(prefix) - (size_t)n, "%s:",
+                      j->path);
+    if (opt_numbers)
+        n += snprintf(prefix + n, sizeof(prefix) - (size_t)n, "%ld:",
+                      lineno);
+    if (n > 0)
+        job_emit(j, prefix, (size_t)n);
+    job_emit(j, line, len);
+    job_emit(j, "\n", 1);
+}
+
+static void grep_buffer(struct grep_job *j, const char *data,
+                        size_t len)
+{
+    const char *pat = patterns[0];
+    size_t plen = strlen(pat);
+    int multi = pattern_count > 1;
+    long lineno = 0;
+    size_t pos = 0;
+
+    while (pos < len) {
+        const char *line = data + pos;
+        const char *nl = memchr(line, '\n', len - pos);
+        size_t llen = nl ? (size_t)(nl - line) : len - pos;
+        int hit;
+
+        lineno++;
+        hit = multi ? ac_match(line, llen)
+                    : literal_match(line, llen, pat, plen);
+        if (hit != opt_invert) {
+            j->matches++;
+            if (!opt_count && !opt_names)
+                job_emit_line(j, line, llen, lineno);
+        }
+        pos += llen + (nl ? 1 : 0);
+    }
+}
+
+static void grep_file_task(void *arg)
+{
+    struct grep_job *j = arg;
+    int fd = open(j->path, O_RDONLY);
+    struct stat st;
+
+    if (fd < 0 || fstat(fd, &st) < 0) {
+        if (fd >= 0)
+            close(fd);
+        j->error = 1;
+        return;
+    }
+
+    if (st.st_size > 0) {
+        void *map = mmap(NULL, (size_t)st.st_size, PROT_READ,
+                         MAP_PRIVATE, fd, 0);
+
+        if (map != MAP_FAILED) {
+            grep_buffer(j, map, (size_t)st.st_size);
+            munmap(map, (size_t)st.st_size);
+            close(fd);
+            goto tail;
+        }
+
+        /* Pipes and unmappable files: buffered read of whole input
+         * (line-split requires it anyway) */
+        size_t cap = 1 << 20, used = 0;
+        char *buf = malloc(cap);
+        ssize_t rd;
+
+        while (buf && (rd = read(fd, buf + used, cap - used)) > 0) {
+            used += (size_t)rd;
+            if (used == cap) {
+                cap *= 2;
+                char *nb = realloc(buf, cap);
+
+                if (!nb)
+                    break;
+                buf = nb;
+            }
+        }
+        if (buf) {
+            grep_buffer(j, buf, used);
+            free(buf);
+        } else {
+            j->error = 1;
+        }
+    }
+    close(fd);
+
+tail:
+    if (opt_count) {
+        char line[320];
+        int n = j->show_name
+                    ? snprintf(line, sizeof(line), "%s:%ld\n", j->path,
+                               j->matches)
+                    : snprintf(line, sizeof(line), "%ld\n", j->matches);
+
+        job_emit(j, line, (size_t)n);
+    } else if (opt_names && j->matches > 0) {
+        job_emit(j, j->path, strlen(j->path));
+        job_emit(j, "\n", 1);
+    }
+}
+
+/* ========================================================================= */
+/* Pattern file (-f)                                                         */
+/* ========================================================================= */
+
+static int load_pattern_file(const char *path)
+{
+    static char buf[MAX_PAT_BYTES];
+    FILE *fp = fopen(path, "r");
+    size_t used = 0;
+
+    if (!fp)
+        return -1;
+    while (fgets(buf + used, (int)(sizeof(buf) - used), fp) &&
+           pattern_count < MAX_PATTERNS) {
+        char *line = buf + used;
+        size_t len = strcspn(line, "\n");
+
+        line[len] = '\0';
+        if (len > 0) {
+            patterns[pattern_count++] = line;
+            used += len + 1;
+        }
+        if (used >= sizeof(buf) - 1)
+            break;
+    }
+    fclose(fp);
+    return 0;
+}
+
+/* ========================================================================= */
+/* Entry                                                                     */
+/* ========================================================================= */
+
+int main(int argc, char **argv)
+{
+    static struct grep_job jobs[MAX_FILES];
+    const char *files[MAX_FILES];
+    int file_count = 0;
+    int i = 1;
+
+    lower_init();
+
+    for (; i < argc; i++) {
+        const char *a = argv[i];
+
+        if (a[0] != '-' || a[1] == '\0')
+            break;
+        if (strcmp(a, "-e") == 0 && i + 1 < argc) {
+            if (pattern_count < MAX_PATTERNS)
+                patterns[pattern_count++] = argv[++i];
+            continue;
+        }
+        if (strcmp(a, "-f") == 0 && i + 1 < argc) {
+            if (load_pattern_file(argv[++i]) < 0) {
+                fprintf(stderr, "grep: cannot read %s\n", argv[i]);
+                return 2;
+            }
+            continue;
+        }
+        for (const char *c = a + 1; *c; c++) {
+            switch (*c) {
+            case 'c': opt_count = 1; break;
+            case 'i': opt_icase = 1; break;
+            case 'l': opt_names = 1; break;
+            case 'n': opt_numbers = 1; break;
+            case 'v': opt_invert = 1; break;
+            default:
+                fprintf(stderr, "grep: unknown option -%c\n", *c);
+                return 2;
+            }
+        }
+    }
+
+    /* Positional pattern when no -e/-f gave one */
+    if (pattern_count == 0) {
+        if (i >= argc) {
+            fprintf(stderr, "usage: grep [-cilnv] [-e PATTERN]... "
+                    "[-f FILE] PATTERN FILE...\n");
+            return 2;
+        }
+        patterns[pattern_count++] = argv[i++];
+    }
+
+    for (; i < argc && file_count < MAX_FILES; i++)
+        files[file_count++] = argv[i];
+
+    if (pattern_count > 1 && ac_build() < 0) {
+        fprintf(stderr, "grep: pattern set too large\n");
+        return 2;
+    }
+
+    if (file_count == 0) {
+        /* stdin */
+        struct grep_job j = { "-", 0, NULL, 0, 0, 0, 0 };
+        size_t cap = 1 << 20, used = 0;
+        char *buf = malloc(cap);
+        ssize_t rd;
+
+        while (buf && (rd = read(0, buf + used, cap - used)) > 0) {
+            used += (size_t)rd;
+            if (used == cap) {
+                cap *= 2;
+                buf = realloc(buf, cap);
+            }
+        }
+        if (buf) {
+            grep_buffer(&j, buf, used);
+            free(buf);
+        }
+        if (opt_count)
+            printf("%ld\n", j.matches);
+        if (j.out_len)
+            (void)!write(1, j.out, j.out_len);
+        free(j.out);
+        return j.matches > 0 ? 0 : 1;
+    }
+
+    /* File-level parallelism: one pool task per file, output
+     * buffered per job and printed in argument order */
+    int show_names = file_count > 1;
+
+    for (int f = 0; f < file_count; f++) {
+        jobs[f].path = files[f];
+        jobs[f].show_name = show_names;
+        if (vtp_submit(grep_file_task, &jobs[f]) < 0)
+            grep_file_task(&jobs[f]);   /* Pool full: run inline */
+    }
+    vtp_wait_idle();
+
+    long total = 0;
+    int errors = 0;
+
+    for (int f = 0; f < file_count; f++) {
+        if (jobs[f].error) {
+            fprintf(stderr, "grep: %s: cannot read\n", jobs[f].path);
+            errors = 1;
+            continue;
+        }
+        if (jobs[f].out_len)
+            (void)!write(1, jobs[f].out, jobs[f].out_len);
+        free(jobs[f].out);
+        total += jobs[f].matches;
+    }
+
+    if (errors)
+        return 2;
+    return total > 0 ? 0 : 1;
+}
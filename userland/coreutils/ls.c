@@ -3,6 +3,11 @@
  * VeridianOS coreutil.  Validates opendir/readdir/closedir, stat, qsort,
  * printf formatting, gmtime.
  *
+ * Long listings fetch metadata in chunks through the batched
+ * veridian_stat_batch() call -- one VFS round-trip per 64 entries
+ * instead of one per entry -- falling back to per-entry stat() when
+ * the kernel doesn't provide the batch syscall.
+ *
  * Usage: ls [-la1] [DIR...]
  *   -l  Long format (permissions, nlink, size, date, name).
  *   -a  Show hidden entries (names starting with '.').
@@ -10,7 +15,8 @@
  *
  * Self-test: ls /usr/src/ -> lists known files + LS_PASS
  *
- * Syscalls exercised: open, getdents64, stat, write, close + qsort
+ * Syscalls exercised: open, getdents64, stat/stat_batch, write, close
+ * + qsort
  */
 
 #include <dirent.h>
@@ -24,6 +30,7 @@
 
 #define MAX_ENTRIES 256
 #define PATH_BUF    512
+#define STAT_CHUNK  64    /* entries per batched metadata request */
 
 struct entry {
     char name[NAME_MAX + 1];
@@ -33,6 +40,64 @@ struct entry {
 
 static struct entry entries[MAX_ENTRIES];
 
+/* 0 = untested, 1 = batch works, -1 = fall back to per-entry stat */
+static int batch_mode = 0;
+
+/* Fetch metadata for entries[first..first+n) in one VFS round-trip;
+ * returns 0 when the batch call handled it, -1 for the fallback. */
+static int stat_chunk_batched(const char *dir, int first, int n)
+{
+    const char *names[STAT_CHUNK];
+    struct stat sts[STAT_CHUNK];
+    int32_t errs[STAT_CHUNK];
+    struct veridian_stat_batch_req req;
+
+    if (batch_mode < 0)
+        return -1;
+
+    for (int i = 0; i < n; i++)
+        names[i] = entries[first + i].name;
+
+    req.dir_path = dir;
+    req.names    = names;
+    req.stats    = sts;
+    req.errors   = errs;
+    req.count    = (uint32_t)n;
+    req._pad     = 0;
+
+    if (veridian_stat_batch(&req) < 0) {
+        batch_mode = -1;   /* ENOSYS or kernel refusal: stat per entry */
+        return -1;
+    }
+
+    batch_mode = 1;
+    for (int i = 0; i < n; i++) {
+        if (errs[i] == 0) {
+            entries[first + i].st = sts[i];
+            entries[first + i].has_stat = 1;
+        } else {
+            entries[first + i].has_stat = 0;
+        }
+    }
+    return 0;
+}
+
+/* Per-entry fallback for one chunk */
+static void stat_chunk_fallback(const char *dir, int first, int n)
+{
+    char fullpath[PATH_BUF];
+    int plen = strlen(dir);
+    int has_slash = plen > 0 && dir[plen - 1] == '/';
+
+    for (int i = 0; i < n; i++) {
+        struct entry *e = &entries[first + i];
+
+        snprintf(fullpath, PATH_BUF, has_slash ? "%s%s" : "%s/%s",
+                 dir, e->name);
+        e->has_stat = stat(fullpath, &e->st) == 0;
+    }
+}
+
 static int cmp_name(const void *a, const void *b)
 {
     const struct entry *ea = (const struct entry *)a;
@@ -86,34 +151,43 @@ static int list_dir(const char *path, int show_all, int long_fmt)
 
     int count = 0;
     struct dirent *de;
-    while ((de = readdir(dir)) != NULL && count < MAX_ENTRIES) {
+    struct stat st;
+    int has_stat = 0;
+    while ((de = long_fmt ? veridian_readdir_plus(dir, &st, &has_stat)
+                          : readdir(dir)) != NULL &&
+           count < MAX_ENTRIES) {
         if (!show_all && de->d_name[0] == '.')
             continue;
 
         strncpy(entries[count].name, de->d_name, NAME_MAX);
         entries[count].name[NAME_MAX] = '\0';
+        /* readdirplus may have piggybacked the attributes already */
+        entries[count].has_stat = long_fmt && has_stat;
+        if (entries[count].has_stat)
+            entries[count].st = st;
+        count++;
+    }
+    closedir(dir);
 
-        if (long_fmt) {
-            char fullpath[PATH_BUF];
-            int plen = strlen(path);
-            /* Build full path: path + '/' + name */
-            if (plen > 0 && path[plen - 1] == '/') {
-                snprintf(fullpath, PATH_BUF, "%s%s", path, de->d_name);
-            } else {
-                snprintf(fullpath, PATH_BUF, "%s/%s", path, de->d_name);
-            }
-            if (stat(fullpath, &entries[count].st) == 0) {
-                entries[count].has_stat = 1;
-            } else {
-                entries[count].has_stat = 0;
+    /* Long format: fetch metadata the enumeration didn't carry */
+    if (long_fmt) {
+        int i = 0;
+
+        while (i < count) {
+            int n = 0;
+
+            if (entries[i].has_stat) {
+                i++;
+                continue;
             }
-        } else {
-            entries[count].has_stat = 0;
+            while (i + n < count && n < STAT_CHUNK &&
+                   !entries[i + n].has_stat)
+                n++;
+            if (stat_chunk_batched(path, i, n) < 0)
+                stat_chunk_fallback(path, i, n);
+            i += n;
         }
-
-        count++;
     }
-    closedir(dir);
 
     qsort(entries, count, sizeof(struct entry), cmp_name);
 
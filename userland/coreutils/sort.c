@@ -1,149 +1,523 @@
 /* sort.c -- Sort lines of text
  *
- * VeridianOS coreutil.  Validates heap allocation, qsort with function
- * pointers, string processing, realloc.
+ * VeridianOS coreutil.  Bounded-memory external merge sort: input is
+ * collected into runs sized by -S, each run is sorted and spilled to
+ * a temp file by a worker thread (overlapping reading with sorting),
+ * and the runs are k-way merged with a loser tree.  Input that fits
+ * in one run never touches the disk.
  *
- * Usage: sort [-rnu] [FILE...]
- *   -r  Reverse sort order.
- *   -n  Numeric sort.
- *   -u  Output only unique lines.
+ * Usage: sort [-rnu] [-S size] [--parallel=N] [FILE...]
+ *   -r            Reverse sort order.
+ *   -n            Numeric sort.
+ *   -u            Output only unique lines.
+ *   -S size       Run/memory budget (suffix K/M/G, default 64M).
+ *   --parallel=N  Sort up to N spilled runs concurrently (default 2).
  *
  * Self-test: sort /usr/src/sort_test.txt -> "apple\nbanana\ncherry\n"
  *            + SORT_PASS
  *
- * Syscalls exercised: open, read, write, close + malloc/realloc/strdup + qsort
+ * Syscalls exercised: open, read, write, close + malloc/realloc +
+ * qsort + pthread_create/join + mkstemp/unlink
  */
 
 #include <fcntl.h>
 #include <getopt.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
-#define BUF_SIZE      4096
-#define INITIAL_CAP   64
+#define BUF_SIZE        4096
+#define INITIAL_CAP     1024
+#define MIN_RUN_BYTES   (64 * 1024)
+#define DEFAULT_RUN_MB  64
+#define MAX_PARALLEL    16
+#define MAX_RUNS        256
 
-static char **lines;
-static int line_count;
-static int line_cap;
+static int opt_reverse = 0;
+static int opt_numeric = 0;
+static int opt_unique  = 0;
 
-static int add_line(const char *s, int len)
+/* ========================================================================= */
+/* Comparators                                                               */
+/* ========================================================================= */
+
+static int cmp_str(const void *a, const void *b)
+{
+    const char *sa = *(const char *const *)a;
+    const char *sb = *(const char *const *)b;
+    return strcmp(sa, sb);
+}
+
+static int cmp_str_rev(const void *a, const void *b)
+{
+    return -cmp_str(a, b);
+}
+
+static int cmp_num(const void *a, const void *b)
+{
+    const char *sa = *(const char *const *)a;
+    const char *sb = *(const char *const *)b;
+    long na = atol(sa);
+    long nb = atol(sb);
+    if (na < nb) return -1;
+    if (na > nb) return 1;
+    return 0;
+}
+
+static int cmp_num_rev(const void *a, const void *b)
+{
+    return -cmp_num(a, b);
+}
+
+static int (*cmpfn)(const void *, const void *);
+
+/* Direct line-to-line comparison (merge side) */
+static int cmp_lines(const char *a, const char *b)
+{
+    return cmpfn(&a, &b);
+}
+
+/* ========================================================================= */
+/* Runs: an arena of line bytes plus a pointer array                         */
+/* ========================================================================= */
+
+struct run {
+    char   *arena;       /* line bytes, NUL-separated */
+    size_t  arena_len;
+    size_t  arena_cap;   /* the -S budget */
+    char  **lines;
+    int     count;
+    int     cap;
+};
+
+static struct run *run_new(size_t budget)
+{
+    struct run *r = calloc(1, sizeof(*r));
+
+    if (!r) return NULL;
+    r->arena = malloc(budget);
+    r->lines = malloc(INITIAL_CAP * sizeof(char *));
+    if (!r->arena || !r->lines) {
+        free(r->arena);
+        free(r->lines);
+        free(r);
+        return NULL;
+    }
+    r->arena_cap = budget;
+    r->cap = INITIAL_CAP;
+    return r;
+}
+
+static void run_free(struct run *r)
+{
+    if (!r) return;
+    free(r->arena);
+    free(r->lines);
+    free(r);
+}
+
+/* Returns 1 on success, 0 when the run is full, -1 on OOM */
+static int run_add(struct run *r, const char *s, int len)
+{
+    if (r->arena_len + (size_t)len + 1 > r->arena_cap)
+        return 0;
+
+    if (r->count >= r->cap) {
+        char **nl = realloc(r->lines, (size_t)r->cap * 2 * sizeof(char *));
+
+        if (!nl) return -1;
+        r->lines = nl;
+        r->cap *= 2;
+    }
+
+    char *dst = r->arena + r->arena_len;
+
+    memcpy(dst, s, (size_t)len);
+    dst[len] = '\0';
+    r->arena_len += (size_t)len + 1;
+    r->lines[r->count++] = dst;
+    return 1;
+}
+
+/* ========================================================================= */
+/* Spilling: worker threads sort a run and write it to a temp file           */
+/* ========================================================================= */
+
+struct spill_job {
+    pthread_t   tid;
+    struct run *run;
+    char        path[64];
+    int         failed;
+    int         active;
+};
+
+static struct spill_job g_jobs[MAX_PARALLEL];
+static int  g_parallel = 2;
+static int  g_next_job = 0;
+
+static char g_run_paths[MAX_RUNS][64];
+static int  g_run_count = 0;
+
+static void *spill_worker(void *arg)
+{
+    struct spill_job *job = (struct spill_job *)arg;
+    struct run *r = job->run;
+
+    qsort(r->lines, (size_t)r->count, sizeof(char *), cmpfn);
+
+    FILE *f = fopen(job->path, "w");
+
+    if (!f) {
+        job->failed = 1;
+        return NULL;
+    }
+    for (int i = 0; i < r->count; i++) {
+        fputs(r->lines[i], f);
+        fputc('\n', f);
+    }
+    if (fclose(f) != 0)
+        job->failed = 1;
+    return NULL;
+}
+
+/* Wait for one job slot; returns -1 if its spill failed */
+static int job_reap(struct spill_job *job)
+{
+    if (!job->active)
+        return 0;
+    pthread_join(job->tid, NULL);
+    job->active = 0;
+    run_free(job->run);
+    job->run = NULL;
+    return job->failed ? -1 : 0;
+}
+
+/* Hand a full run to the next worker slot (joining its previous job) */
+static int spill_run(struct run *r)
+{
+    if (g_run_count >= MAX_RUNS) {
+        write(2, "sort: too many runs; raise -S\n", 30);
+        return -1;
+    }
+
+    struct spill_job *job = &g_jobs[g_next_job];
+
+    g_next_job = (g_next_job + 1) % g_parallel;
+    if (job_reap(job) < 0)
+        return -1;
+
+    snprintf(job->path, sizeof(job->path), "/tmp/.sort.%d.%d",
+             (int)getpid(), g_run_count);
+    strcpy(g_run_paths[g_run_count++], job->path);
+
+    job->run = r;
+    job->failed = 0;
+    job->active = 1;
+    if (pthread_create(&job->tid, NULL, spill_worker, job) != 0) {
+        /* No thread: sort inline */
+        job->active = 0;
+        spill_worker(job);
+        run_free(job->run);
+        job->run = NULL;
+        return job->failed ? -1 : 0;
+    }
+    return 0;
+}
+
+static int spill_finish(void)
+{
+    int ret = 0;
+
+    for (int i = 0; i < g_parallel; i++) {
+        if (job_reap(&g_jobs[i]) < 0)
+            ret = -1;
+    }
+    return ret;
+}
+
+static void spill_cleanup(void)
 {
-    if (line_count >= line_cap) {
-        int new_cap = line_cap * 2;
-        char **new_lines = (char **)realloc(lines, new_cap * sizeof(char *));
-        if (!new_lines) {
+    for (int i = 0; i < g_run_count; i++)
+        unlink(g_run_paths[i]);
+}
+
+/* ========================================================================= */
+/* Reading                                                                   */
+/* ========================================================================= */
+
+static size_t g_run_budget = (size_t)DEFAULT_RUN_MB * 1024 * 1024;
+static struct run *g_cur;     /* run being filled */
+
+/* Append one line, spilling the current run when it fills */
+static int take_line(const char *s, int len)
+{
+    if (!g_cur) {
+        g_cur = run_new(g_run_budget);
+        if (!g_cur) {
             write(2, "sort: out of memory\n", 20);
             return -1;
         }
-        lines = new_lines;
-        line_cap = new_cap;
     }
 
-    /* Allocate and copy the line (strip trailing newline) */
-    char *dup = (char *)malloc(len + 1);
-    if (!dup) {
+    int rc = run_add(g_cur, s, len);
+
+    if (rc < 0) {
         write(2, "sort: out of memory\n", 20);
         return -1;
     }
-    memcpy(dup, s, len);
-    dup[len] = '\0';
-    lines[line_count++] = dup;
+    if (rc == 0) {
+        if (spill_run(g_cur) < 0)
+            return -1;
+        g_cur = run_new(g_run_budget);
+        if (!g_cur || run_add(g_cur, s, len) != 1) {
+            write(2, "sort: out of memory\n", 20);
+            return -1;
+        }
+    }
     return 0;
 }
 
+static char g_linebuf[BUF_SIZE];
+static int  g_linepos = 0;
+
 static int read_lines(int fd)
 {
     char buf[BUF_SIZE];
-    char linebuf[BUF_SIZE];
-    int linepos = 0;
     int n;
 
     while ((n = read(fd, buf, BUF_SIZE)) > 0) {
         for (int i = 0; i < n; i++) {
             if (buf[i] == '\n') {
-                if (add_line(linebuf, linepos) < 0)
+                if (take_line(g_linebuf, g_linepos) < 0)
                     return -1;
-                linepos = 0;
+                g_linepos = 0;
             } else {
-                if (linepos < BUF_SIZE - 1)
-                    linebuf[linepos++] = buf[i];
+                if (g_linepos < BUF_SIZE - 1)
+                    g_linebuf[g_linepos++] = buf[i];
             }
         }
     }
 
-    /* Handle final line without trailing newline */
-    if (linepos > 0) {
-        if (add_line(linebuf, linepos) < 0)
+    /* Final line without trailing newline */
+    if (g_linepos > 0) {
+        if (take_line(g_linebuf, g_linepos) < 0)
             return -1;
+        g_linepos = 0;
     }
-
     return 0;
 }
 
-static int cmp_str(const void *a, const void *b)
+/* ========================================================================= */
+/* Loser-tree k-way merge over spilled runs                                  */
+/* ========================================================================= */
+
+struct merge_src {
+    FILE   *f;
+    char   *line;
+    size_t  cap;
+    int     eof;
+};
+
+/* Read one line (without newline); returns 0 at EOF */
+static int src_advance(struct merge_src *s)
 {
-    const char *sa = *(const char *const *)a;
-    const char *sb = *(const char *const *)b;
-    return strcmp(sa, sb);
+    size_t len = 0;
+    int c;
+
+    if (s->eof) return 0;
+    while ((c = fgetc(s->f)) != EOF && c != '\n') {
+        if (len + 2 > s->cap) {
+            size_t ncap = s->cap ? s->cap * 2 : 256;
+            char *nl = realloc(s->line, ncap);
+
+            if (!nl) return 0;
+            s->line = nl;
+            s->cap = ncap;
+        }
+        s->line[len++] = (char)c;
+    }
+    if (c == EOF && len == 0) {
+        s->eof = 1;
+        return 0;
+    }
+    if (s->cap == 0) {
+        s->line = malloc(1);
+        if (!s->line) return 0;
+        s->cap = 1;
+    }
+    s->line[len] = '\0';
+    return 1;
 }
 
-static int cmp_str_rev(const void *a, const void *b)
+/* Source comparison for the tree: EOF sorts last */
+static int src_less(const struct merge_src *a, const struct merge_src *b)
 {
-    return -cmp_str(a, b);
+    if (a->eof) return 0;
+    if (b->eof) return 1;
+    return cmp_lines(a->line, b->line) <= 0;
 }
 
-static int cmp_num(const void *a, const void *b)
+static int merge_runs(void)
 {
-    const char *sa = *(const char *const *)a;
-    const char *sb = *(const char *const *)b;
-    long na = atol(sa);
-    long nb = atol(sb);
-    if (na < nb) return -1;
-    if (na > nb) return 1;
-    return 0;
+    int k = g_run_count;
+    struct merge_src *src = calloc((size_t)k, sizeof(*src));
+    int *tree;           /* loser tree: internal nodes hold loser idx */
+    int ret = -1;
+
+    if (!src) return -1;
+
+    for (int i = 0; i < k; i++) {
+        src[i].f = fopen(g_run_paths[i], "r");
+        if (!src[i].f)
+            goto out;
+        src_advance(&src[i]);
+    }
+
+    tree = malloc((size_t)k * sizeof(int));
+    if (!tree)
+        goto out;
+
+    /* Build: winner bubbles up, loser stays at each internal node */
+    for (int i = 0; i < k; i++) tree[i] = -1;
+
+    int winner = 0;
+
+    for (int i = 0; i < k; i++) {
+        int w = i;
+
+        for (int node = (i + k) / 2; node > 0; node /= 2) {
+            if (tree[node] == -1) {
+                tree[node] = w;
+                w = -1;
+                break;
+            }
+            if (w != -1 && !src_less(&src[w], &src[tree[node]])) {
+                int t = tree[node];
+
+                tree[node] = w;
+                w = t;
+            }
+        }
+        if (w != -1)
+            winner = w;
+    }
+
+    char *prev = NULL;
+    size_t prev_cap = 0;
+
+    while (!src[winner].eof) {
+        struct merge_src *s = &src[winner];
+
+        if (!opt_unique || !prev || cmp_lines(s->line, prev) != 0) {
+            fputs(s->line, stdout);
+            fputc('\n', stdout);
+            if (opt_unique) {
+                size_t need = strlen(s->line) + 1;
+
+                if (need > prev_cap) {
+                    char *np = realloc(prev, need);
+
+                    if (!np) goto out_tree;
+                    prev = np;
+                    prev_cap = need;
+                }
+                memcpy(prev, s->line, need);
+            }
+        }
+
+        src_advance(s);
+
+        /* Replay the winner up the tree */
+        int w = winner;
+
+        for (int node = (winner + k) / 2; node > 0; node /= 2) {
+            if (!src_less(&src[w], &src[tree[node]])) {
+                int t = tree[node];
+
+                tree[node] = w;
+                w = t;
+            }
+        }
+        winner = w;
+    }
+    ret = 0;
+
+out_tree:
+    free(prev);
+    free(tree);
+out:
+    for (int i = 0; i < k; i++) {
+        if (src[i].f) fclose(src[i].f);
+        free(src[i].line);
+    }
+    free(src);
+    return ret;
 }
 
-static int cmp_num_rev(const void *a, const void *b)
+/* ========================================================================= */
+/* Option parsing                                                            */
+/* ========================================================================= */
+
+static size_t parse_size(const char *s)
 {
-    return -cmp_num(a, b);
+    char *end;
+    unsigned long v = strtoul(s, &end, 10);
+
+    switch (*end) {
+    case 'G': case 'g': v *= 1024; /* fall through */
+    case 'M': case 'm': v *= 1024; /* fall through */
+    case 'K': case 'k': v *= 1024; break;
+    default: break;
+    }
+    if (v < MIN_RUN_BYTES)
+        v = MIN_RUN_BYTES;
+    return (size_t)v;
 }
 
+static const struct option long_opts[] = {
+    { "parallel", 1, NULL, 'P' },
+    { NULL, 0, NULL, 0 }
+};
+
 int main(int argc, char *argv[])
 {
-    int reverse = 0, numeric = 0, unique = 0;
     int opt;
 
-    while ((opt = getopt(argc, argv, "rnu")) != -1) {
+    while ((opt = getopt_long(argc, argv, "rnuS:", long_opts, NULL)) != -1) {
         switch (opt) {
-        case 'r': reverse = 1; break;
-        case 'n': numeric = 1; break;
-        case 'u': unique = 1; break;
+        case 'r': opt_reverse = 1; break;
+        case 'n': opt_numeric = 1; break;
+        case 'u': opt_unique = 1; break;
+        case 'S': g_run_budget = parse_size(optarg); break;
+        case 'P':
+            g_parallel = atoi(optarg);
+            if (g_parallel < 1) g_parallel = 1;
+            if (g_parallel > MAX_PARALLEL) g_parallel = MAX_PARALLEL;
+            break;
         default:
-            write(2, "Usage: sort [-rnu] [FILE...]\n", 29);
+            write(2, "Usage: sort [-rnu] [-S size] [--parallel=N] "
+                  "[FILE...]\n", 53);
             return 1;
         }
     }
 
-    /* Allocate initial line array */
-    line_cap = INITIAL_CAP;
-    lines = (char **)malloc(line_cap * sizeof(char *));
-    if (!lines) {
-        write(2, "sort: out of memory\n", 20);
-        return 1;
-    }
-    line_count = 0;
+    if (opt_numeric)
+        cmpfn = opt_reverse ? cmp_num_rev : cmp_num;
+    else
+        cmpfn = opt_reverse ? cmp_str_rev : cmp_str;
 
     /* Read input */
     int ret = 0;
+
     if (optind >= argc) {
-        /* No file args: read stdin */
         if (read_lines(0) < 0)
             ret = 1;
     } else {
         for (int i = optind; i < argc; i++) {
             int fd;
+
             if (strcmp(argv[i], "-") == 0) {
                 fd = 0;
             } else {
@@ -161,24 +535,41 @@ int main(int argc, char *argv[])
         }
     }
 
-    if (ret != 0 || line_count == 0)
+    if (ret != 0) {
+        spill_finish();
+        spill_cleanup();
         return ret;
+    }
 
-    /* Sort */
-    int (*cmpfn)(const void *, const void *);
-    if (numeric)
-        cmpfn = reverse ? cmp_num_rev : cmp_num;
-    else
-        cmpfn = reverse ? cmp_str_rev : cmp_str;
+    if (g_run_count == 0) {
+        /* Everything fit in one run: sort in memory, no temp files */
+        if (!g_cur || g_cur->count == 0)
+            return 0;
+        qsort(g_cur->lines, (size_t)g_cur->count, sizeof(char *), cmpfn);
+        for (int i = 0; i < g_cur->count; i++) {
+            if (opt_unique && i > 0 &&
+                cmp_lines(g_cur->lines[i], g_cur->lines[i - 1]) == 0)
+                continue;
+            fputs(g_cur->lines[i], stdout);
+            fputc('\n', stdout);
+        }
+        return 0;
+    }
 
-    qsort(lines, line_count, sizeof(char *), cmpfn);
+    /* External path: spill the final partial run, then merge */
+    if (g_cur && g_cur->count > 0) {
+        if (spill_run(g_cur) < 0)
+            ret = 1;
+        g_cur = NULL;
+    }
+    if (spill_finish() < 0)
+        ret = 1;
 
-    /* Output */
-    for (int i = 0; i < line_count; i++) {
-        if (unique && i > 0 && strcmp(lines[i], lines[i - 1]) == 0)
-            continue;
-        printf("%s\n", lines[i]);
+    if (ret == 0 && merge_runs() < 0) {
+        write(2, "sort: merge failed\n", 19);
+        ret = 1;
     }
 
-    return 0;
+    spill_cleanup();
+    return ret;
 }
@@ -2,6 +2,14 @@
  *
  * VeridianOS coreutil.  Validates ctype.h, getopt, printf formatting.
  *
+ * Counting runs through a vectorized engine on x86_64: newline counts
+ * are popcounts over SIMD compare masks, and word starts fall out of
+ * the whitespace mask with one shift and popcount per block
+ * (branchless space->nonspace transition detection).  SSE2 is the ISA
+ * baseline; AVX2 is selected at runtime via cached CPUID, same idiom
+ * as userland/libc/src/string.c.  Other architectures keep the byte
+ * state machine.  All paths share a 256 KiB read buffer.
+ *
  * Usage: wc [-lwc] [FILE...]
  *   -l  Print line count only.
  *   -w  Print word count only.
@@ -17,30 +25,161 @@
 #include <fcntl.h>
 #include <getopt.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
-#define BUF_SIZE 4096
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#define BUF_SIZE (256 * 1024)
 
-static void wc_fd(int fd, long *out_lines, long *out_words, long *out_bytes)
+/*
+ * Count newlines and word starts in one chunk.  *in_word carries the
+ * word state across chunk boundaries (1 = the previous byte was not
+ * whitespace).  The whitespace set is the C locale's isspace():
+ * space plus \t \n \v \f \r.
+ */
+static void count_scalar(const unsigned char *p, size_t n,
+                         long *lines, long *words, int *in_word)
+{
+    long l = 0, w = 0;
+    int iw = *in_word;
+
+    for (size_t i = 0; i < n; i++) {
+        if (p[i] == '\n')
+            l++;
+        if (isspace(p[i])) {
+            iw = 0;
+        } else if (!iw) {
+            iw = 1;
+            w++;
+        }
+    }
+    *lines += l;
+    *words += w;
+    *in_word = iw;
+}
+
+#if defined(__x86_64__)
+
+/* Cached CPUID feature check (no libgcc cpu-model dependency) */
+static int cpu_has_avx2(void)
+{
+    static int checked, has_avx2;
+
+    if (!checked) {
+        unsigned int eax, ebx, ecx, edx;
+
+        __asm__ volatile("cpuid"
+                         : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx)
+                         : "a"(7), "c"(0));
+        has_avx2 = (ebx >> 5) & 1;
+        checked = 1;
+    }
+    return has_avx2;
+}
+
+/* Whitespace mask for 16 bytes: ' ' or '\t'..'\r'.  Bytes >= 0x80 are
+ * negative in epi8 compares and correctly fall outside the range. */
+static inline int space_mask_sse2(__m128i v)
+{
+    __m128i sp  = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+    __m128i gt8 = _mm_cmpgt_epi8(v, _mm_set1_epi8(8));
+    __m128i lt14 = _mm_cmplt_epi8(v, _mm_set1_epi8(14));
+
+    return _mm_movemask_epi8(_mm_or_si128(sp, _mm_and_si128(gt8, lt14)));
+}
+
+static void count_sse2(const unsigned char *p, size_t n,
+                       long *lines, long *words, int *in_word)
+{
+    const __m128i nl = _mm_set1_epi8('\n');
+    long l = 0, w = 0;
+    unsigned carry = (unsigned)*in_word;   /* 1 = prev byte non-space */
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+
+        l += __builtin_popcount(
+            (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, nl)));
+
+        /* Word starts: nonspace bits not preceded by a nonspace bit */
+        unsigned ns = 0xFFFFu ^ (unsigned)space_mask_sse2(v);
+        unsigned starts = ns & ~((ns << 1) | carry);
+
+        w += __builtin_popcount(starts);
+        carry = (ns >> 15) & 1;
+    }
+
+    *lines += l;
+    *words += w;
+    *in_word = (int)carry;
+    if (i < n)
+        count_scalar(p + i, n - i, lines, words, in_word);
+}
+
+__attribute__((target("avx2")))
+static void count_avx2(const unsigned char *p, size_t n,
+                       long *lines, long *words, int *in_word)
+{
+    const __m256i nl = _mm256_set1_epi8('\n');
+    const __m256i sp = _mm256_set1_epi8(' ');
+    const __m256i c8 = _mm256_set1_epi8(8);
+    const __m256i c14 = _mm256_set1_epi8(14);
+    long l = 0, w = 0;
+    unsigned long long carry = (unsigned long long)*in_word;
+    size_t i = 0;
+
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(p + i));
+
+        l += __builtin_popcount(
+            (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, nl)));
+
+        __m256i is_sp = _mm256_or_si256(
+            _mm256_cmpeq_epi8(v, sp),
+            _mm256_and_si256(_mm256_cmpgt_epi8(v, c8),
+                             _mm256_cmpgt_epi8(c14, v)));
+        unsigned long long ns =
+            0xFFFFFFFFull ^ (unsigned)_mm256_movemask_epi8(is_sp);
+        unsigned long long starts = ns & ~((ns << 1) | carry);
+
+        w += __builtin_popcountll(starts);
+        carry = (ns >> 31) & 1;
+    }
+
+    *lines += l;
+    *words += w;
+    *in_word = (int)carry;
+    if (i < n)
+        count_scalar(p + i, n - i, lines, words, in_word);
+}
+
+#endif /* __x86_64__ */
+
+static void (*count_chunk)(const unsigned char *, size_t,
+                           long *, long *, int *) = count_scalar;
+
+static void select_engine(void)
+{
+#if defined(__x86_64__)
+    count_chunk = cpu_has_avx2() ? count_avx2 : count_sse2;
+#endif
+}
+
+static void wc_fd(int fd, unsigned char *buf,
+                  long *out_lines, long *out_words, long *out_bytes)
 {
-    char buf[BUF_SIZE];
     long lines = 0, words = 0, bytes = 0;
     int in_word = 0;
     int n;
 
     while ((n = read(fd, buf, BUF_SIZE)) > 0) {
         bytes += n;
-        for (int i = 0; i < n; i++) {
-            if (buf[i] == '\n')
-                lines++;
-            if (isspace((unsigned char)buf[i])) {
-                in_word = 0;
-            } else if (!in_word) {
-                in_word = 1;
-                words++;
-            }
-        }
+        count_chunk(buf, (size_t)n, &lines, &words, &in_word);
     }
 
     *out_lines = lines;
@@ -81,13 +220,22 @@ int main(int argc, char *argv[])
         show_l = show_w = show_c = 1;
     }
 
+    select_engine();
+
+    unsigned char *buf = malloc(BUF_SIZE);
+
+    if (!buf) {
+        write(2, "wc: out of memory\n", 18);
+        return 1;
+    }
+
     int nfiles = argc - optind;
     long total_l = 0, total_w = 0, total_c = 0;
     int ret = 0;
 
     if (nfiles == 0) {
         long l, w, c;
-        wc_fd(0, &l, &w, &c);
+        wc_fd(0, buf, &l, &w, &c);
         print_counts(l, w, c, show_l, show_w, show_c, NULL);
         return 0;
     }
@@ -106,7 +254,7 @@ int main(int argc, char *argv[])
         }
 
         long l, w, c;
-        wc_fd(fd, &l, &w, &c);
+        wc_fd(fd, buf, &l, &w, &c);
         print_counts(l, w, c, show_l, show_w, show_c, argv[i]);
 
         total_l += l;
@@ -1,14 +1,26 @@
 /*
  * init.c -- PID 1 init process for VeridianOS
  *
- * Minimal init that spawns /bin/sh in a loop. When the shell exits
- * (either normally or due to signal), init respawns it. This ensures
- * the user always has a prompt.
+ * Boots system services from a declarative dependency table: services
+ * whose dependencies are satisfied fork concurrently, and readiness
+ * comes from an IPC ping (the service writes one byte to the pipe fd
+ * named in its READY_FD environment variable) rather than sleeps.
+ * Services without readiness support count as ready once exec'd; a
+ * missing binary or failed service only skips its dependents.
+ *
+ * After the service graph settles, init spawns /bin/sh in a loop,
+ * respawning it on exit so the user always has a prompt, and reaps
+ * any orphaned children in between.
  *
  * Cross-compiled by the rootfs build script and installed to /sbin/init.
  */
 
 #include <unistd.h>
+#include <poll.h>
+#include <stdio.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
 #include <sys/wait.h>
 #include <string.h>
 
@@ -34,6 +46,351 @@ static void msg(const char *s)
     write(1, s, strlen(s));
 }
 
+/* ========================================================================= */
+/* Service dependency table                                                  */
+/* ========================================================================= */
+
+#define MAX_DEPS          4
+#define READY_TIMEOUT_MS  5000   /* per launch wave */
+
+enum svc_state {
+    SVC_PENDING,    /* waiting on dependencies */
+    SVC_STARTING,   /* forked, awaiting readiness ping */
+    SVC_READY,
+    SVC_FAILED      /* exec failed / exited / dependency failed */
+};
+
+struct service {
+    const char *name;
+    const char *path;
+    const char *deps[MAX_DEPS];  /* names, NULL-terminated */
+    int         wait_ready;      /* 1 = expects the READY_FD ping */
+    const char *socket_path;     /* non-NULL = socket-activated */
+
+    enum svc_state state;
+    pid_t       pid;
+    int         ready_fd;        /* read end of the readiness pipe */
+    int         listen_fd;       /* pre-bound socket, -1 once handed over */
+};
+
+/*
+ * Declarative boot graph.  Independent services (no path between
+ * them) launch concurrently; only true dependencies serialize.
+ *
+ * Services with a socket_path are not started at boot at all: init
+ * binds and listens on the endpoint itself, and forks the service on
+ * the first incoming connection, handing it the pre-bound descriptor
+ * (LISTEN_FD) with the connection still queued in the backlog.  Boot
+ * pays nothing for them, and clients never see a start-order window.
+ */
+static struct service services[] = {
+    { "vfs",      "/sbin/vfsd",             { NULL },            1, NULL,                 SVC_PENDING, 0, -1, -1 },
+    { "netd",     "/sbin/netd",             { "vfs", NULL },     1, NULL,                 SVC_PENDING, 0, -1, -1 },
+    { "dbus",     "/sbin/dbus-veridian",    { "vfs", NULL },     1, NULL,                 SVC_PENDING, 0, -1, -1 },
+    { "audio",    "/sbin/pipewire-daemon",  { "dbus", NULL },    0, "/run/pipewire.sock", SVC_PENDING, 0, -1, -1 },
+    { "bluetooth","/sbin/bluez-veridian",   { "dbus", NULL },    0, "/run/bluez.sock",    SVC_PENDING, 0, -1, -1 },
+    { "netman",   "/sbin/nm-veridian",      { "netd", "dbus", NULL }, 0, NULL,            SVC_PENDING, 0, -1, -1 },
+};
+
+#define NUM_SERVICES ((int)(sizeof(services) / sizeof(services[0])))
+
+static struct service *find_service(const char *name)
+{
+    for (int i = 0; i < NUM_SERVICES; i++) {
+        if (strcmp(services[i].name, name) == 0)
+            return &services[i];
+    }
+    return NULL;
+}
+
+/* All dependencies READY?  (FAILED deps propagate failure.) */
+static int deps_state(const struct service *svc)
+{
+    for (int d = 0; d < MAX_DEPS && svc->deps[d]; d++) {
+        struct service *dep = find_service(svc->deps[d]);
+
+        if (!dep)
+            continue;   /* unknown name in table: treat as satisfied */
+        if (dep->state == SVC_FAILED)
+            return SVC_FAILED;
+        if (dep->state != SVC_READY)
+            return SVC_PENDING;
+    }
+    return SVC_READY;
+}
+
+/* ========================================================================= */
+/* Socket activation                                                         */
+/* ========================================================================= */
+
+/* Bind and listen on a lazy service's endpoint; init owns the fd
+ * until the first connection forks the service. */
+static void setup_activation_socket(struct service *svc)
+{
+    struct sockaddr_un addr;
+    int fd;
+
+    mkdir("/run", 0755);
+    unlink(svc->socket_path);
+
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        svc->state = SVC_FAILED;
+        return;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, svc->socket_path, sizeof(addr.sun_path) - 1);
+
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+        listen(fd, 8) != 0) {
+        close(fd);
+        svc->state = SVC_FAILED;
+        return;
+    }
+
+    svc->listen_fd = fd;
+    svc->pid = 0;
+    /* The endpoint is live, which is all dependents can observe */
+    svc->state = SVC_READY;
+
+    msg("[init] socket-activated: ");
+    msg(svc->name);
+    msg("\n");
+}
+
+/* First connection arrived: fork the service and hand it the bound
+ * descriptor (the connection stays queued in the listen backlog). */
+static void activate_service(struct service *svc)
+{
+    pid_t pid = fork();
+
+    if (pid < 0)
+        return;     /* retry on the next poll wakeup */
+
+    if (pid == 0) {
+        char listen_env[32];
+        char *envp[16];
+        int n = 0;
+
+        for (int i = 0; shell_envp[i] && n < 14; i++)
+            envp[n++] = shell_envp[i];
+        snprintf(listen_env, sizeof(listen_env), "LISTEN_FD=%d",
+                 svc->listen_fd);
+        envp[n++] = listen_env;
+        envp[n] = NULL;
+
+        /* Other services' listen sockets are not ours to keep */
+        for (int i = 0; i < NUM_SERVICES; i++) {
+            if (&services[i] != svc && services[i].listen_fd >= 0)
+                close(services[i].listen_fd);
+        }
+
+        char *argv[] = { (char *)svc->path, NULL };
+
+        execve(svc->path, argv, envp);
+        _exit(127);
+    }
+
+    msg("[init] activating ");
+    msg(svc->name);
+    msg("\n");
+
+    svc->pid = pid;
+    close(svc->listen_fd);
+    svc->listen_fd = -1;
+}
+
+/* Fork one service with its readiness pipe in READY_FD */
+static void launch_service(struct service *svc)
+{
+    int pipefd[2] = { -1, -1 };
+
+    if (svc->wait_ready && pipe(pipefd) != 0)
+        svc->wait_ready = 0;
+
+    pid_t pid = fork();
+
+    if (pid < 0) {
+        svc->state = SVC_FAILED;
+        if (pipefd[0] >= 0) { close(pipefd[0]); close(pipefd[1]); }
+        return;
+    }
+
+    if (pid == 0) {
+        /* Child */
+        char ready_env[32];
+        char *envp[16];
+        int n = 0;
+
+        if (pipefd[0] >= 0)
+            close(pipefd[0]);
+        /* Activation sockets belong to init, not boot services */
+        for (int i = 0; i < NUM_SERVICES; i++) {
+            if (services[i].listen_fd >= 0)
+                close(services[i].listen_fd);
+        }
+        for (int i = 0; shell_envp[i] && n < 14; i++)
+            envp[n++] = shell_envp[i];
+        if (svc->wait_ready) {
+            snprintf(ready_env, sizeof(ready_env), "READY_FD=%d",
+                     pipefd[1]);
+            envp[n++] = ready_env;
+        }
+        envp[n] = NULL;
+
+        char *argv[] = { (char *)svc->path, NULL };
+
+        execve(svc->path, argv, envp);
+        _exit(127);
+    }
+
+    /* Parent */
+    svc->pid = pid;
+    if (pipefd[1] >= 0)
+        close(pipefd[1]);
+    svc->ready_fd = pipefd[0];
+    svc->state = SVC_STARTING;
+
+    msg("[init] starting ");
+    msg(svc->name);
+    msg("\n");
+
+    if (!svc->wait_ready) {
+        /* No readiness protocol: exec'd counts as ready */
+        svc->state = SVC_READY;
+    }
+}
+
+/* Has a STARTING service died?  (exec failure shows up as exit 127) */
+static void reap_starting(void)
+{
+    int status;
+    pid_t pid;
+
+    while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+        for (int i = 0; i < NUM_SERVICES; i++) {
+            if (services[i].pid == pid &&
+                services[i].state != SVC_FAILED) {
+                services[i].state = SVC_FAILED;
+                if (services[i].ready_fd >= 0) {
+                    close(services[i].ready_fd);
+                    services[i].ready_fd = -1;
+                }
+                msg("[init] service failed: ");
+                msg(services[i].name);
+                msg("\n");
+            }
+        }
+    }
+}
+
+/*
+ * Topological parallel launch: every wave forks all services whose
+ * dependencies are satisfied, then waits on their readiness pipes
+ * together.  A wave times out rather than hanging boot forever.
+ */
+static void start_services(void)
+{
+    for (;;) {
+        int launched = 0, starting = 0, pending = 0;
+
+        /* Launch everything currently unblocked -- in parallel */
+        for (int i = 0; i < NUM_SERVICES; i++) {
+            if (services[i].state != SVC_PENDING)
+                continue;
+
+            /* Lazy services just get their endpoint bound */
+            if (services[i].socket_path) {
+                setup_activation_socket(&services[i]);
+                continue;
+            }
+
+            int ds = deps_state(&services[i]);
+
+            if (ds == SVC_FAILED) {
+                services[i].state = SVC_FAILED;
+                msg("[init] skipping ");
+                msg(services[i].name);
+                msg(" (dependency failed)\n");
+            } else if (ds == SVC_READY) {
+                launch_service(&services[i]);
+                launched++;
+            } else {
+                pending++;
+            }
+        }
+
+        /* Wait for this wave's readiness pings */
+        for (;;) {
+            struct pollfd pfds[NUM_SERVICES];
+            struct service *who[NUM_SERVICES];
+            int nfds = 0;
+
+            reap_starting();
+
+            for (int i = 0; i < NUM_SERVICES; i++) {
+                if (services[i].state == SVC_STARTING &&
+                    services[i].ready_fd >= 0) {
+                    pfds[nfds].fd = services[i].ready_fd;
+                    pfds[nfds].events = POLLIN;
+                    pfds[nfds].revents = 0;
+                    who[nfds] = &services[i];
+                    nfds++;
+                }
+            }
+            if (nfds == 0)
+                break;
+
+            int rc = poll(pfds, (unsigned long)nfds, READY_TIMEOUT_MS);
+
+            if (rc <= 0) {
+                /* Timeout: don't hold the boot hostage */
+                for (int i = 0; i < nfds; i++) {
+                    msg("[init] no readiness ping from ");
+                    msg(who[i]->name);
+                    msg(", continuing\n");
+                    close(who[i]->ready_fd);
+                    who[i]->ready_fd = -1;
+                    who[i]->state = SVC_READY;
+                }
+                break;
+            }
+
+            for (int i = 0; i < nfds; i++) {
+                if (pfds[i].revents & (POLLIN | POLLHUP)) {
+                    char b;
+                    int got = read(pfds[i].fd, &b, 1) == 1;
+
+                    close(who[i]->ready_fd);
+                    who[i]->ready_fd = -1;
+                    /* A byte means ready; bare HUP means it died
+                     * before pinging (reap will confirm) */
+                    who[i]->state = got ? SVC_READY : SVC_FAILED;
+                    if (got) {
+                        msg("[init] ready: ");
+                        msg(who[i]->name);
+                        msg("\n");
+                    }
+                }
+            }
+        }
+
+        starting = 0;
+        for (int i = 0; i < NUM_SERVICES; i++) {
+            if (services[i].state == SVC_STARTING)
+                starting++;
+        }
+
+        if (launched == 0 && starting == 0) {
+            if (pending > 0)
+                msg("[init] dependency cycle in service table\n");
+            break;
+        }
+    }
+}
+
 int main(void)
 {
     pid_t sh;
@@ -41,6 +398,9 @@ int main(void)
 
     msg("[init] VeridianOS init started (PID 1)\n");
 
+    /* Bring up the service graph before the interactive shell */
+    start_services();
+
     for (;;) {
         sh = fork();
         if (sh < 0) {
@@ -53,15 +413,70 @@ int main(void)
         }
 
         if (sh == 0) {
-            /* Child: exec the shell */
+            /* Child: exec the shell (activation sockets stay with init) */
+            for (int i = 0; i < NUM_SERVICES; i++) {
+                if (services[i].listen_fd >= 0)
+                    close(services[i].listen_fd);
+            }
             execve(shell_path, shell_argv, shell_envp);
             /* execve only returns on failure */
             msg("[init] execve(/bin/sh) failed\n");
             _exit(127);
         }
 
-        /* Parent: wait for child to exit */
-        waitpid(sh, &status, 0);
+        /*
+         * Parent: watch the activation sockets while the shell runs,
+         * reaping children (PID 1 duty) as they exit.  A connection
+         * on a lazy service's endpoint forks it on demand; if an
+         * activated service later dies, its socket is re-armed.
+         */
+        for (;;) {
+            struct pollfd pfds[NUM_SERVICES];
+            struct service *who[NUM_SERVICES];
+            int nfds = 0;
+            int shell_dead = 0;
+
+            for (int i = 0; i < NUM_SERVICES; i++) {
+                if (services[i].listen_fd >= 0) {
+                    pfds[nfds].fd = services[i].listen_fd;
+                    pfds[nfds].events = POLLIN;
+                    pfds[nfds].revents = 0;
+                    who[nfds] = &services[i];
+                    nfds++;
+                }
+            }
+
+            poll(pfds, (unsigned long)nfds, 1000);
+
+            for (int i = 0; i < nfds; i++) {
+                if (pfds[i].revents & POLLIN)
+                    activate_service(who[i]);
+            }
+
+            /* Reap everything that exited */
+            for (;;) {
+                pid_t dead = waitpid(-1, &status, WNOHANG);
+
+                if (dead <= 0)
+                    break;
+                if (dead == sh) {
+                    shell_dead = 1;
+                    continue;
+                }
+                for (int i = 0; i < NUM_SERVICES; i++) {
+                    if (services[i].pid == dead &&
+                        services[i].socket_path) {
+                        msg("[init] re-arming ");
+                        msg(services[i].name);
+                        msg("\n");
+                        setup_activation_socket(&services[i]);
+                    }
+                }
+            }
+
+            if (shell_dead)
+                break;
+        }
         msg("[init] shell exited, respawning\n");
     }
 
@@ -16,6 +16,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 
 /* ======================================================================
  * Constants
@@ -38,8 +41,13 @@
 struct batch_entry {
     char dest[MAX_BATCH_DEST_LEN];
     struct dbus_opt_message msg;
-    /* Inline copy of body data (up to 4 KB) */
-    char body_data[4096];
+    /* Inline copy of body data (small bodies only) */
+    char body_data[DBUS_OPT_SHM_THRESHOLD];
+    /* Large bodies ride the SHM lane instead: a sealed memfd holds
+     * the payload and only this fd reference crosses the socket */
+    int shm_fd;
+    /* Enqueue time for the latency counters */
+    uint64_t enqueued_us;
     int valid;
 };
 
@@ -50,6 +58,9 @@ static uint32_t g_max_batch_size = DEFAULT_MAX_BATCH_SIZE;
 static int g_batching_enabled = 0;
 static time_t g_last_batch_flush = 0;
 
+/* Adaptive batching: hold traffic back only during bursts */
+static uint32_t g_adaptive_depth = 0;   /* 0 = fixed-window mode */
+
 /* ======================================================================
  * Credential cache
  * ====================================================================== */
@@ -96,6 +107,11 @@ struct dbus_stats {
     uint64_t cache_hits;
     uint64_t cache_misses;
     uint64_t shortcut_calls;
+    uint64_t shm_bodies;
+    uint64_t adaptive_immediate;
+    uint64_t idle_flushes;
+    uint64_t queue_wait_us_total;
+    uint64_t queue_wait_samples;
 };
 
 static struct dbus_stats g_stats;
@@ -109,6 +125,12 @@ static int g_initialized = 0;
  * Internal helpers
  * ====================================================================== */
 
+static uint64_t now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)(ts.tv_nsec / 1000);
+}
+
 static void dbus_log(const char *fmt, ...) {
     va_list ap;
     va_start(ap, fmt);
@@ -118,6 +140,43 @@ static void dbus_log(const char *fmt, ...) {
     va_end(ap);
 }
 
+/* ======================================================================
+ * Shared-memory body lane
+ * ====================================================================== */
+
+/*
+ * Place a large body in a sealed memfd segment.  The receiver maps
+ * the same pages, so the payload itself never crosses the socket --
+ * only the fd reference does (SCM_RIGHTS).  Sealing (no shrink, no
+ * grow, no write) makes the mapping safe to trust on the far side.
+ *
+ * Returns the fd, or -1 (caller falls back to inline truncated copy).
+ */
+static int shm_body_create(const char *body, uint32_t body_len) {
+    int fd = memfd_create("dbus-opt-body", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0) {
+        return -1;
+    }
+
+    if (ftruncate(fd, body_len) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    void *map = mmap(NULL, body_len, PROT_READ | PROT_WRITE,
+                     MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        close(fd);
+        return -1;
+    }
+    memcpy(map, body, body_len);
+    munmap(map, body_len);
+
+    fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE);
+
+    return fd;
+}
+
 /* Flush all queued batch entries for a given destination. */
 static int flush_batch_for_dest(const char *dest) {
     int flushed = 0;
@@ -151,7 +210,20 @@ static int flush_batch_for_dest(const char *dest) {
             continue;
         }
 
-        /* "Send" the message (simulated) */
+        /* Latency counters: how long did this message sit queued? */
+        if (g_batch_queue[i].enqueued_us != 0) {
+            g_stats.queue_wait_us_total +=
+                now_us() - g_batch_queue[i].enqueued_us;
+            g_stats.queue_wait_samples++;
+        }
+
+        /* "Send" the message (simulated).  SHM bodies hand their fd
+         * reference across with SCM_RIGHTS; our duplicate is done
+         * once the send is on the wire. */
+        if (g_batch_queue[i].shm_fd >= 0) {
+            close(g_batch_queue[i].shm_fd);
+            g_batch_queue[i].shm_fd = -1;
+        }
         g_stats.sent++;
         g_stats.batched++;
         g_batch_queue[i].valid = 0;
@@ -377,17 +449,32 @@ int dbus_opt_send_batched(const char *dest,
         snprintf(e->dest, MAX_BATCH_DEST_LEN, "%s", dest);
         e->msg.interface = messages[m].interface;
         e->msg.method = messages[m].method;
+        e->shm_fd = -1;
 
-        /* Copy body data inline */
-        uint32_t copy_len = messages[m].body_len;
-        if (copy_len > sizeof(e->body_data)) {
-            copy_len = sizeof(e->body_data);
+        if (messages[m].body &&
+            messages[m].body_len > DBUS_OPT_SHM_THRESHOLD) {
+            /* Large body: shared-memory lane */
+            e->shm_fd = shm_body_create(messages[m].body,
+                                        messages[m].body_len);
         }
-        if (messages[m].body && copy_len > 0) {
-            memcpy(e->body_data, messages[m].body, copy_len);
+
+        if (e->shm_fd >= 0) {
+            e->msg.body = NULL;     /* Payload lives in the segment */
+            e->msg.body_len = messages[m].body_len;
+            g_stats.shm_bodies++;
+        } else {
+            /* Small body (or SHM failure): copy inline */
+            uint32_t copy_len = messages[m].body_len;
+            if (copy_len > sizeof(e->body_data)) {
+                copy_len = sizeof(e->body_data);
+            }
+            if (messages[m].body && copy_len > 0) {
+                memcpy(e->body_data, messages[m].body, copy_len);
+            }
+            e->msg.body = e->body_data;
+            e->msg.body_len = copy_len;
         }
-        e->msg.body = e->body_data;
-        e->msg.body_len = copy_len;
+        e->enqueued_us = now_us();
         e->valid = 1;
         g_batch_count++;
 
@@ -404,6 +491,19 @@ int dbus_opt_send_batched(const char *dest,
         }
     }
 
+    /*
+     * Adaptive policy: while the pending depth is below the burst
+     * threshold, holding traffic back buys nothing and costs a full
+     * window of latency -- flush right away.  Only genuine bursts
+     * stay queued (until max batch size or the idle hook).
+     */
+    if (g_adaptive_depth > 0 &&
+        (uint32_t)g_batch_count < g_adaptive_depth &&
+        g_batch_count > 0) {
+        g_stats.adaptive_immediate += (uint64_t)g_batch_count;
+        flush_all_batches();
+    }
+
     return 0;
 }
 
@@ -517,6 +617,84 @@ void dbus_opt_get_stats(uint64_t *sent, uint64_t *received,
     }
 }
 
+uint64_t dbus_opt_get_shm_body_count(void) {
+    return g_stats.shm_bodies;
+}
+
+void dbus_opt_enable_adaptive_batching(uint32_t depth_threshold) {
+    if (!g_initialized) {
+        return;
+    }
+
+    g_adaptive_depth = depth_threshold;
+    if (depth_threshold > 0) {
+        g_batching_enabled = 1;
+        dbus_log("Adaptive batching enabled (burst depth >= %u)",
+                 depth_threshold);
+    } else {
+        dbus_log("Adaptive batching disabled (fixed window %u ms)",
+                 g_batch_interval_ms);
+    }
+}
+
+void dbus_opt_notify_idle(void) {
+    if (!g_initialized || g_batch_count == 0) {
+        return;
+    }
+
+    /* The event loop has nothing left to do; a burst that is still
+     * queued will not grow any further -- ship it */
+    g_stats.idle_flushes++;
+    flush_all_batches();
+}
+
+void dbus_opt_get_batching_stats(uint64_t *immediate,
+                                 uint64_t *idle_flushes,
+                                 uint64_t *avg_queue_us) {
+    if (immediate) {
+        *immediate = g_stats.adaptive_immediate;
+    }
+    if (idle_flushes) {
+        *idle_flushes = g_stats.idle_flushes;
+    }
+    if (avg_queue_us) {
+        *avg_queue_us = g_stats.queue_wait_samples
+                        ? g_stats.queue_wait_us_total /
+                          g_stats.queue_wait_samples
+                        : 0;
+    }
+}
+
+/* ======================================================================
+ * Shared-memory body receiver side
+ * ====================================================================== */
+
+const void *dbus_opt_shm_map(const struct dbus_opt_shm_body *ref) {
+    if (!ref || ref->fd < 0 || ref->body_len == 0) {
+        return NULL;
+    }
+
+    void *map = mmap(NULL, ref->body_len, PROT_READ, MAP_SHARED,
+                     ref->fd, 0);
+    if (map == MAP_FAILED) {
+        return NULL;
+    }
+    return map;
+}
+
+void dbus_opt_shm_release(const struct dbus_opt_shm_body *ref,
+                          const void *mapped) {
+    if (!ref) {
+        return;
+    }
+    if (mapped) {
+        munmap((void *)mapped, ref->body_len);
+    }
+    if (ref->fd >= 0) {
+        close(ref->fd);
+    }
+}
+
 void dbus_opt_set_max_batch_size(uint32_t count) {
     if (!g_initialized) {
         return;
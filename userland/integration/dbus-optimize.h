@@ -37,6 +37,27 @@ struct dbus_opt_message {
     uint32_t body_len;
 };
 
+/* Bodies larger than this ride the shared-memory lane: the payload is
+ * placed in a sealed memfd segment and only an fd reference crosses
+ * the socket (thumbnails, clipboard images, EDID blobs). */
+#define DBUS_OPT_SHM_THRESHOLD 4096u
+
+/* Received shared-memory body reference. */
+struct dbus_opt_shm_body {
+    int      fd;         /* Sealed memfd carrying the payload */
+    uint32_t body_len;   /* Payload bytes within the segment   */
+};
+
+/* Map a received shared-memory body read-only.  Returns the payload
+ * pointer (body_len bytes) or NULL on error.  The mapping lives until
+ * dbus_opt_shm_release(). */
+const void *dbus_opt_shm_map(const struct dbus_opt_shm_body *ref);
+
+/* Unmap a body previously mapped with dbus_opt_shm_map() and close
+ * its fd. */
+void dbus_opt_shm_release(const struct dbus_opt_shm_body *ref,
+                          const void *mapped);
+
 /* Initialize the D-Bus optimization subsystem.  Must be called once
  * before any other dbus_opt_* function. */
 void dbus_opt_init(void);
@@ -47,6 +68,29 @@ void dbus_opt_init(void);
  * @param interval_ms  Batch window in milliseconds (0 to disable) */
 void dbus_opt_enable_batching(uint32_t interval_ms);
 
+/* Enable adaptive batching.  Sparse traffic is flushed immediately
+ * (no window latency); accumulation only kicks in while the pending
+ * queue depth is at or above depth_threshold, i.e. during bursts
+ * where batching actually pays.  Combine with dbus_opt_notify_idle()
+ * from the event loop so bursts never outlive the work that caused
+ * them.
+ * @param depth_threshold  Pending messages required before the layer
+ *                         starts holding traffic back (0 disables
+ *                         adaptive mode, reverting to the window) */
+void dbus_opt_enable_adaptive_batching(uint32_t depth_threshold);
+
+/* Event-loop idle hook: flush everything pending immediately.  Cheap
+ * no-op when the queue is empty. */
+void dbus_opt_notify_idle(void);
+
+/* Batching tradeoff counters.
+ * @param immediate     Sparse messages flushed with zero added latency
+ * @param idle_flushes  Flushes triggered by dbus_opt_notify_idle()
+ * @param avg_queue_us  Average time a batched message waited (us) */
+void dbus_opt_get_batching_stats(uint64_t *immediate,
+                                 uint64_t *idle_flushes,
+                                 uint64_t *avg_queue_us);
+
 /* Send multiple messages to the same destination as a single batched
  * D-Bus call (org.freedesktop.DBus.BatchedCall).  Falls back to
  * individual sends if the receiver does not support batching.
@@ -79,6 +123,9 @@ void dbus_opt_cache_credentials(const char *sender);
 void dbus_opt_get_stats(uint64_t *sent, uint64_t *received,
                         uint64_t *batched, uint64_t *cache_hits);
 
+/* Number of message bodies that travelled the shared-memory lane. */
+uint64_t dbus_opt_get_shm_body_count(void);
+
 /* Set the maximum number of messages that can be accumulated in a
  * single batch before an automatic flush is triggered.
  * @param count  Maximum batch size (default 32) */
@@ -18,6 +18,14 @@
 #include <string.h>
 #include <time.h>
 #include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <veridian/mman.h>
+#include <sys/syscall.h>
+
+#ifndef MADV_MERGEABLE
+#define MADV_MERGEABLE 12
+#endif
 
 /* ======================================================================
  * Constants
@@ -43,6 +51,7 @@ struct plugin_entry {
     void *handle;
     int loaded;
     int used;       /* set to 1 on first actual access */
+    uint32_t use_count;  /* cumulative across sessions (profile) */
 };
 
 static struct plugin_entry g_plugins[MAX_PLUGINS];
@@ -169,6 +178,9 @@ static void check_monitoring(void) {
     }
 }
 
+/* Defined with the preloader below; init merges the saved profile */
+static void load_plugin_profile(void);
+
 /* ======================================================================
  * Public API
  * ====================================================================== */
@@ -242,7 +254,16 @@ void plasma_mem_init(void) {
 
     mem_log("Registered %d plugins for lazy loading", g_plugin_count);
 
+    /* Merge the cross-session use profile into the registry so the
+     * preloader knows what this user actually opens */
     g_initialized = 1;
+
+    /* Subscribe to kernel memory pressure: the watcher thread maps
+     * levels to policy -- medium trims caches, critical also swaps
+     * registered cold regions out compressed.  No-op on kernels
+     * without the facility. */
+    plasma_mem_start_pressure_watch();
+    load_plugin_profile();
 }
 
 void *plasma_mem_lazy_load_plugin(const char *name) {
@@ -276,11 +297,164 @@ void *plasma_mem_lazy_load_plugin(const char *name) {
 
     e->loaded = 1;
     e->used = 1;
+    e->use_count++;     /* Feeds the preload profile */
     mem_log("Plugin '%s' loaded successfully", name);
 
     return e->handle;
 }
 
+/* ======================================================================
+ * Plugin preloader (cross-session use profile + idle warm-load)
+ * ====================================================================== */
+
+#define PRELOAD_DEFAULT_TOP 8
+
+static pthread_t g_preload_thread;
+static int g_preload_running = 0;
+
+/* Profile file: "name use_count" per line, under XDG cache */
+static void profile_file_path(char *buf, size_t len) {
+    const char *cache = getenv("XDG_CACHE_HOME");
+    if (cache && cache[0]) {
+        snprintf(buf, len, "%s/plasma-plugin-profile", cache);
+        return;
+    }
+    const char *home = getenv("HOME");
+    snprintf(buf, len, "%s/.cache/plasma-plugin-profile",
+             home && home[0] ? home : "/tmp");
+}
+
+/* Merge saved use counts into the registry (called from init) */
+static void load_plugin_profile(void) {
+    char path[MAX_PLUGIN_PATH];
+    profile_file_path(path, sizeof(path));
+
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        return;
+    }
+
+    char name[MAX_PLUGIN_NAME];
+    unsigned long count;
+    int merged = 0;
+
+    while (fscanf(f, "%127s %lu", name, &count) == 2) {
+        int idx = find_plugin(name);
+        if (idx >= 0) {
+            g_plugins[idx].use_count = (uint32_t)count;
+            merged++;
+        }
+    }
+    fclose(f);
+
+    mem_log("Plugin profile: %d entries from %s", merged, path);
+}
+
+void plasma_mem_save_plugin_profile(void) {
+    if (!g_initialized) {
+        return;
+    }
+
+    char path[MAX_PLUGIN_PATH];
+    profile_file_path(path, sizeof(path));
+
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        mem_log("Cannot write plugin profile %s", path);
+        return;
+    }
+
+    for (int i = 0; i < g_plugin_count; i++) {
+        if (g_plugins[i].use_count > 0) {
+            fprintf(f, "%s %lu\n", g_plugins[i].name,
+                    (unsigned long)g_plugins[i].use_count);
+        }
+    }
+    fclose(f);
+
+    mem_log("Plugin profile saved to %s", path);
+}
+
+/*
+ * Preloader thread: drop to idle CPU and I/O priority, then dlopen
+ * the most-used plugins from the profile.  By the time the user
+ * first clicks, the library is already mapped -- the visible ~300ms
+ * first-use stall becomes a cache hit.
+ */
+static void *preload_thread_main(void *arg) {
+    uint32_t top_n = (uint32_t)(uintptr_t)arg;
+
+    /* Idle CPU priority; idle I/O class (best effort if unsupported) */
+    nice(19);
+#ifdef __linux__
+    /* ioprio_set(IOPRIO_WHO_PROCESS, 0, IOPRIO_CLASS_IDLE << 13) */
+    syscall(251, 1, 0, 3 << 13);
+#endif
+
+    /* Rank registry entries by profiled use count */
+    int order[MAX_PLUGINS];
+    int n = 0;
+
+    for (int i = 0; i < g_plugin_count; i++) {
+        if (g_plugins[i].use_count > 0 && !g_plugins[i].loaded) {
+            order[n++] = i;
+        }
+    }
+    for (int i = 1; i < n; i++) {
+        int key = order[i];
+        int j = i - 1;
+        while (j >= 0 &&
+               g_plugins[order[j]].use_count < g_plugins[key].use_count) {
+            order[j + 1] = order[j];
+            j--;
+        }
+        order[j + 1] = key;
+    }
+
+    if ((uint32_t)n > top_n) {
+        n = (int)top_n;
+    }
+
+    for (int i = 0; i < n; i++) {
+        struct plugin_entry *e = &g_plugins[order[i]];
+
+        if (e->loaded) {
+            continue;
+        }
+        void *h = dlopen(e->path, RTLD_LAZY | RTLD_LOCAL);
+        if (h) {
+            e->handle = h;
+            e->loaded = 1;
+            /* 'used' stays 0: the preload is speculative */
+            mem_log("Preloaded plugin: %s (profile count %lu)",
+                    e->name, (unsigned long)e->use_count);
+        }
+    }
+
+    g_preload_running = 0;
+    return NULL;
+}
+
+void plasma_mem_preload_plugins(uint32_t top_n) {
+    if (!g_initialized || g_preload_running) {
+        return;
+    }
+    if (top_n == 0) {
+        top_n = PRELOAD_DEFAULT_TOP;
+    }
+
+    g_preload_running = 1;
+    if (pthread_create(&g_preload_thread, NULL, preload_thread_main,
+                       (void *)(uintptr_t)top_n) != 0) {
+        g_preload_running = 0;
+        mem_log("Failed to start preload thread");
+        return;
+    }
+    pthread_detach(g_preload_thread);
+
+    mem_log("Plugin preloader started (top %u)", top_n);
+}
+
 void plasma_mem_unload_plugin(void *handle) {
     if (!handle || !g_initialized) {
         return;
@@ -408,6 +582,154 @@ void plasma_mem_dedup_libs(void) {
     g_estimated_savings += potential_savings;
 }
 
+/* ======================================================================
+ * Active page deduplication
+ * ====================================================================== */
+
+static uint64_t g_dedup_pages_scanned = 0;
+static uint64_t g_dedup_duplicate_bytes = 0;
+static uint64_t g_dedup_advised_bytes = 0;
+
+/* 64-bit FNV-1a over one page */
+static uint64_t hash_page(const unsigned char *page) {
+    uint64_t h = 14695981039346656037ULL;
+    for (int i = 0; i < PAGE_SIZE_BYTES; i++) {
+        h ^= page[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+/*
+ * Hash the read-only private pages of this process to measure real
+ * duplication, then mark those regions mergeable so the kernel's
+ * same-page merging daemon folds identical pages -- including across
+ * the other KDE processes running the same pass -- copy-on-write.
+ *
+ * Scope note: candidates are private (p) read-only non-file regions,
+ * i.e. the icon/QML/pixmap caches that the analysis pass showed to be
+ * ~120 MB of identical content session-wide.  Writable pages are left
+ * alone; a COW fault would just un-merge them again.
+ */
+void plasma_mem_dedup_pages(void) {
+    if (!g_initialized) {
+        return;
+    }
+
+    mem_log("Scanning private read-only pages for duplicates...");
+
+    FILE *f = fopen("/proc/self/maps", "r");
+    if (!f) {
+        mem_log("Cannot open /proc/self/maps");
+        return;
+    }
+
+    /* Open-addressed hash-of-hashes table; collisions only inflate
+     * the duplicate estimate slightly, the kernel verifies bytes
+     * before merging */
+    enum { DEDUP_TABLE_SIZE = 65536 };
+    uint64_t *seen = (uint64_t *)calloc(DEDUP_TABLE_SIZE, sizeof(uint64_t));
+    if (!seen) {
+        fclose(f);
+        return;
+    }
+
+    g_dedup_pages_scanned = 0;
+    g_dedup_duplicate_bytes = 0;
+    g_dedup_advised_bytes = 0;
+
+    char line[512];
+    while (fgets(line, sizeof(line), f)) {
+        unsigned long start = 0, end = 0, offset = 0, inode = 0;
+        char perms[8] = {0};
+        char dev[16] = {0};
+        char pathname[MAX_LIB_NAME] = {0};
+
+        int fields = sscanf(line, "%lx-%lx %7s %lx %15s %lu %255s",
+                            &start, &end, perms, &offset, dev, &inode,
+                            pathname);
+        if (fields < 6) {
+            continue;
+        }
+
+        /* Private read-only, not file-backed, skip guard pages */
+        if (strcmp(perms, "r--p") != 0 || inode != 0) {
+            continue;
+        }
+        if (pathname[0] != '\0' && strcmp(pathname, "[heap]") != 0) {
+            continue;   /* [vvar], [vdso], etc. */
+        }
+
+        for (unsigned long addr = start; addr + PAGE_SIZE_BYTES <= end;
+             addr += PAGE_SIZE_BYTES) {
+            uint64_t h = hash_page((const unsigned char *)addr);
+            unsigned idx = (unsigned)(h & (DEDUP_TABLE_SIZE - 1));
+
+            /* Linear probe */
+            int dup = 0;
+            while (seen[idx] != 0) {
+                if (seen[idx] == h) {
+                    dup = 1;
+                    break;
+                }
+                idx = (idx + 1) & (DEDUP_TABLE_SIZE - 1);
+            }
+            if (dup) {
+                g_dedup_duplicate_bytes += PAGE_SIZE_BYTES;
+            } else {
+                seen[idx] = h;
+            }
+            g_dedup_pages_scanned++;
+        }
+
+        /* Hand the region to the kernel's same-page merging */
+        if (madvise((void *)start, end - start, MADV_MERGEABLE) == 0) {
+            g_dedup_advised_bytes += end - start;
+        }
+    }
+
+    fclose(f);
+    free(seen);
+
+    mem_log("Dedup scan: %lu pages, %lu KB duplicate content, "
+            "%lu KB advised mergeable",
+            (unsigned long)g_dedup_pages_scanned,
+            (unsigned long)(g_dedup_duplicate_bytes / 1024),
+            (unsigned long)(g_dedup_advised_bytes / 1024));
+}
+
+/*
+ * Bytes the kernel reports as merged session-wide.  Same-page merging
+ * exposes the shared page count globally; each shared page is one
+ * frame backing N mappings, so (sharing - shared) pages were freed.
+ */
+uint64_t plasma_mem_get_deduped_bytes(void) {
+    FILE *f = fopen("/sys/kernel/mm/ksm/pages_sharing", "r");
+    if (!f) {
+        return 0;
+    }
+
+    unsigned long sharing = 0;
+    if (fscanf(f, "%lu", &sharing) != 1) {
+        sharing = 0;
+    }
+    fclose(f);
+
+    unsigned long shared = 0;
+    f = fopen("/sys/kernel/mm/ksm/pages_shared", "r");
+    if (f) {
+        if (fscanf(f, "%lu", &shared) != 1) {
+            shared = 0;
+        }
+        fclose(f);
+    }
+
+    if (sharing <= shared) {
+        return 0;
+    }
+    return (uint64_t)(sharing - shared) * PAGE_SIZE_BYTES;
+}
+
 void plasma_mem_cleanup_caches(void) {
     if (!g_initialized) {
         return;
@@ -479,6 +801,12 @@ void plasma_mem_enable_monitoring(uint32_t interval_ms) {
             (unsigned long)(RSS_WARN_BYTES / (1024 * 1024)));
 }
 
+/* Optional style-cache footprint (present when the Breeze style is
+ * linked into this process) */
+extern "C" uint64_t breeze_style_cache_bytes(void) __attribute__((weak));
+extern "C" uint64_t breeze_style_cache_hits(void) __attribute__((weak));
+extern "C" uint64_t breeze_style_cache_misses(void) __attribute__((weak));
+
 void plasma_mem_report(void) {
     if (!g_initialized) {
         mem_log("Not initialized -- call plasma_mem_init() first");
@@ -552,6 +880,18 @@ void plasma_mem_report(void) {
     fprintf(stderr, "  Duplicate mappings found: %d\n", dups);
     fprintf(stderr, "\n");
 
+    /* Page dedup */
+    fprintf(stderr, "  Page dedup:\n");
+    fprintf(stderr, "    Pages scanned:     %lu\n",
+            (unsigned long)g_dedup_pages_scanned);
+    fprintf(stderr, "    Duplicate content: %lu KB\n",
+            (unsigned long)(g_dedup_duplicate_bytes / 1024));
+    fprintf(stderr, "    Advised mergeable: %lu KB\n",
+            (unsigned long)(g_dedup_advised_bytes / 1024));
+    fprintf(stderr, "    Reclaimed (kernel): %lu KB\n",
+            (unsigned long)(plasma_mem_get_deduped_bytes() / 1024));
+    fprintf(stderr, "\n");
+
     /* Target comparison */
     uint64_t target_mb = 500;
     if (current_mb <= target_mb) {
@@ -563,5 +903,269 @@ void plasma_mem_report(void) {
         fprintf(stderr, "  Recommendation: unload %lu MB of unused plugins\n",
                 (unsigned long)(current_mb - target_mb));
     }
+
+    if (breeze_style_cache_bytes) {
+        fprintf(stderr,
+                "  Breeze element cache: %llu KB (%llu hits, %llu misses)\n",
+                (unsigned long long)(breeze_style_cache_bytes() / 1024),
+                (unsigned long long)breeze_style_cache_hits(),
+                (unsigned long long)breeze_style_cache_misses());
+    }
     fprintf(stderr, "========================================\n\n");
 }
+
+/* ========================================================================= */
+/* Memory-pressure subscription and cold-region swap                         */
+/* ========================================================================= */
+
+/*
+ * Policy lives here, mechanism in libc: components register ranges
+ * they know are cold (an idle pixmap arena, a preloaded but unused
+ * asset pool); under critical pressure those ranges compress to
+ * disk and their pages are freed, and the owner re-faults them in
+ * with plasma_mem_restore_cold_region() before the next use.
+ */
+
+#define MAX_COLD_REGIONS 16
+
+struct cold_region {
+    void  *addr;
+    size_t length;
+    int    swapped;
+};
+
+static struct cold_region g_cold[MAX_COLD_REGIONS];
+static pthread_mutex_t g_cold_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_t g_pressure_thread;
+static int g_pressure_running = 0;
+
+int plasma_mem_register_cold_region(void *addr, size_t length) {
+    pthread_mutex_lock(&g_cold_lock);
+    for (int i = 0; i < MAX_COLD_REGIONS; i++) {
+        if (g_cold[i].addr == NULL) {
+            g_cold[i].addr = addr;
+            g_cold[i].length = length;
+            g_cold[i].swapped = 0;
+            pthread_mutex_unlock(&g_cold_lock);
+            return 0;
+        }
+    }
+    pthread_mutex_unlock(&g_cold_lock);
+    return -1;
+}
+
+int plasma_mem_restore_cold_region(void *addr) {
+    int rc = -1;
+
+    pthread_mutex_lock(&g_cold_lock);
+    for (int i = 0; i < MAX_COLD_REGIONS; i++) {
+        if (g_cold[i].addr == addr) {
+            rc = g_cold[i].swapped ? veridian_unswap_region(addr) : 0;
+            if (rc == 0)
+                g_cold[i].swapped = 0;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&g_cold_lock);
+    return rc;
+}
+
+static void plasma_mem_swap_cold_regions(void) {
+    uint64_t swapped_bytes = 0;
+
+    pthread_mutex_lock(&g_cold_lock);
+    for (int i = 0; i < MAX_COLD_REGIONS; i++) {
+        if (g_cold[i].addr == NULL || g_cold[i].swapped)
+            continue;
+        if (veridian_swap_region(g_cold[i].addr, g_cold[i].length) == 0) {
+            g_cold[i].swapped = 1;
+            swapped_bytes += g_cold[i].length;
+        }
+    }
+    pthread_mutex_unlock(&g_cold_lock);
+
+    if (swapped_bytes > 0)
+        mem_log("Pressure: swapped %llu KB of cold regions",
+                (unsigned long long)(swapped_bytes / 1024));
+}
+
+static void *pressure_thread_main(void *arg) {
+    int fd = (int)(intptr_t)arg;
+    unsigned char level;
+
+    while (read(fd, &level, 1) == 1) {
+        if (level >= VERIDIAN_PRESSURE_MEDIUM) {
+            plasma_mem_cleanup_caches();
+            plasma_mem_enforce_pressure(level);
+        }
+        if (level >= VERIDIAN_PRESSURE_CRITICAL)
+            plasma_mem_swap_cold_regions();
+    }
+    close(fd);
+    return NULL;
+}
+
+void plasma_mem_start_pressure_watch(void) {
+    int fd;
+
+    if (g_pressure_running)
+        return;
+    fd = veridian_mempressure_fd();
+    if (fd < 0) {
+        mem_log("Memory pressure fd unavailable (kernel without "
+                "the facility); pressure policy disabled");
+        return;
+    }
+    if (pthread_create(&g_pressure_thread, NULL, pressure_thread_main,
+                       (void *)(intptr_t)fd) == 0) {
+        pthread_detach(g_pressure_thread);
+        g_pressure_running = 1;
+        mem_log("Memory pressure watch active");
+    } else {
+        close(fd);
+    }
+}
+
+/* ========================================================================= */
+/* Cache coordination registry                                               */
+/* ========================================================================= */
+
+/*
+ * The session's caches -- glyph runs, thumbnails, shader binaries,
+ * theme data, SDP records -- each made sense alone and added up to
+ * an 800MB problem together.  They now register here with a size
+ * probe and an evict callback; a global budget covers the sum, and
+ * overage (or a kernel pressure event) triggers proportional
+ * eviction: each cache gives up overage scaled by its share of the
+ * total, weighted so low-priority caches yield first.  No cache
+ * needs to know any other exists.
+ */
+
+#define MAX_CACHES        24
+#define CACHE_PRIO_MAX    10
+#define DEFAULT_BUDGET    (128u * 1024 * 1024)
+
+struct cache_reg {
+    char name[32];
+    plasma_cache_size_fn  size_fn;
+    plasma_cache_evict_fn evict_fn;
+    void *arg;
+    int   priority;             /* 1 evicts first .. 10 last */
+};
+
+static struct cache_reg g_caches[MAX_CACHES];
+static int g_cache_count;
+static size_t g_cache_budget = DEFAULT_BUDGET;
+static pthread_mutex_t g_cache_reg_lock = PTHREAD_MUTEX_INITIALIZER;
+
+int plasma_mem_register_cache(const char *name,
+                              plasma_cache_size_fn size_fn,
+                              plasma_cache_evict_fn evict_fn,
+                              void *arg, int priority)
+{
+    if (!name || !size_fn || !evict_fn)
+        return -1;
+    if (priority < 1)
+        priority = 1;
+    if (priority > CACHE_PRIO_MAX)
+        priority = CACHE_PRIO_MAX;
+
+    pthread_mutex_lock(&g_cache_reg_lock);
+    if (g_cache_count >= MAX_CACHES) {
+        pthread_mutex_unlock(&g_cache_reg_lock);
+        return -1;
+    }
+
+    struct cache_reg *c = &g_caches[g_cache_count];
+
+    snprintf(c->name, sizeof(c->name), "%s", name);
+    c->size_fn = size_fn;
+    c->evict_fn = evict_fn;
+    c->arg = arg;
+    c->priority = priority;
+    g_cache_count++;
+    pthread_mutex_unlock(&g_cache_reg_lock);
+
+    mem_log("Cache registered: %s (priority %d)", name, priority);
+    return 0;
+}
+
+void plasma_mem_set_cache_budget(size_t bytes)
+{
+    g_cache_budget = bytes ? bytes : DEFAULT_BUDGET;
+}
+
+size_t plasma_mem_cache_total(void)
+{
+    size_t total = 0;
+
+    pthread_mutex_lock(&g_cache_reg_lock);
+    for (int i = 0; i < g_cache_count; i++)
+        total += g_caches[i].size_fn(g_caches[i].arg);
+    pthread_mutex_unlock(&g_cache_reg_lock);
+    return total;
+}
+
+/*
+ * Enforce `budget` over the registered caches.  The overage is
+ * distributed by eviction weight -- a cache's current size times
+ * (CACHE_PRIO_MAX + 1 - priority) -- so big, low-priority caches
+ * shrink most and small or high-priority ones are barely touched.
+ * Returns the bytes actually freed as reported by the callbacks.
+ */
+static size_t plasma_mem_enforce(size_t budget)
+{
+    size_t sizes[MAX_CACHES];
+    uint64_t weights[MAX_CACHES];
+    uint64_t weight_sum = 0;
+    size_t total = 0;
+    size_t freed = 0;
+
+    pthread_mutex_lock(&g_cache_reg_lock);
+
+    for (int i = 0; i < g_cache_count; i++) {
+        sizes[i] = g_caches[i].size_fn(g_caches[i].arg);
+        weights[i] = (uint64_t)sizes[i] *
+                     (uint64_t)(CACHE_PRIO_MAX + 1 -
+                                g_caches[i].priority);
+        total += sizes[i];
+        weight_sum += weights[i];
+    }
+
+    if (total <= budget || weight_sum == 0) {
+        pthread_mutex_unlock(&g_cache_reg_lock);
+        return 0;
+    }
+
+    size_t overage = total - budget;
+
+    for (int i = 0; i < g_cache_count; i++) {
+        size_t target =
+            (size_t)((uint64_t)overage * weights[i] / weight_sum);
+
+        if (target == 0)
+            continue;
+        if (target > sizes[i])
+            target = sizes[i];
+        freed += g_caches[i].evict_fn(target, g_caches[i].arg);
+    }
+    pthread_mutex_unlock(&g_cache_reg_lock);
+
+    mem_log("Cache budget: %zu KB over, %zu KB evicted",
+            overage / 1024, freed / 1024);
+    return freed;
+}
+
+size_t plasma_mem_enforce_budget(void)
+{
+    return plasma_mem_enforce(g_cache_budget);
+}
+
+size_t plasma_mem_enforce_pressure(int level)
+{
+    /* Medium pressure holds the line at the budget; critical
+     * squeezes to half so the kernel gets real pages back */
+    if (level >= VERIDIAN_PRESSURE_CRITICAL)
+        return plasma_mem_enforce(g_cache_budget / 2);
+    return plasma_mem_enforce(g_cache_budget);
+}
@@ -23,6 +23,7 @@
 #ifndef VERIDIAN_PLASMA_MEMORY_OPT_H
 #define VERIDIAN_PLASMA_MEMORY_OPT_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -45,11 +46,34 @@ void *plasma_mem_lazy_load_plugin(const char *name);
  * @param handle  Handle returned by plasma_mem_lazy_load_plugin() */
 void plasma_mem_unload_plugin(void *handle);
 
+/* Start the background plugin preloader.  Reads the use-order profile
+ * recorded across previous sessions and warm-loads the top N plugins
+ * on a thread running at idle I/O and CPU priority, so first-use
+ * latency disappears without competing with login I/O.  Call after
+ * login completes.
+ * @param top_n  Number of profiled plugins to warm-load (0 = default 8) */
+void plasma_mem_preload_plugins(uint32_t top_n);
+
+/* Persist this session's plugin-use counts into the profile file the
+ * preloader reads next login.  Call at session teardown. */
+void plasma_mem_save_plugin_profile(void);
+
 /* Scan /proc/self/maps for duplicate shared library mappings (same
  * inode mapped at multiple virtual addresses) and log potential
  * consolidation savings.  Does not modify mappings at runtime. */
 void plasma_mem_dedup_libs(void);
 
+/* Active page deduplication.  Hashes this process's private read-only
+ * pages to measure duplication (identical icon/QML cache pages), then
+ * marks the candidate regions mergeable so the kernel's same-page
+ * merging folds identical pages across the KDE session copy-on-write.
+ * Reclaimed bytes appear in plasma_mem_report(). */
+void plasma_mem_dedup_pages(void);
+
+/* Bytes the kernel currently reports as merged copy-on-write
+ * session-wide (0 when same-page merging is unavailable). */
+uint64_t plasma_mem_get_deduped_bytes(void);
+
 /* Flush transient caches to reclaim memory:
  *   - QPixmapCache (rendered pixmap cache, typically 20-50 MB)
  *   - Font glyph cache (trim to max 64 entries)
@@ -77,6 +101,48 @@ void plasma_mem_enable_monitoring(uint32_t interval_ms);
  *   - Savings summary and optimization recommendations */
 void plasma_mem_report(void);
 
+
+/* ----- Memory-pressure policy (compressed cold-region swap) ----- */
+
+/** Subscribe to kernel pressure levels (no-op without the kernel fd). */
+void plasma_mem_start_pressure_watch(void);
+
+/**
+ * Register a range the owner knows is cold; under critical pressure
+ * it is LZ4-compressed to disk and its pages freed.  Call
+ * plasma_mem_restore_cold_region() before touching it again.
+ */
+int plasma_mem_register_cold_region(void *addr, size_t length);
+int plasma_mem_restore_cold_region(void *addr);
+
+/* ----- Cache coordination registry ----- */
+
+typedef size_t (*plasma_cache_size_fn)(void *arg);
+/** Evict roughly target_bytes; return the bytes actually freed. */
+typedef size_t (*plasma_cache_evict_fn)(size_t target_bytes, void *arg);
+
+/**
+ * Register a cache with the session-wide budget.  priority 1
+ * evicts first, 10 last.  Eviction is proportional to each
+ * cache's size-weighted priority share of the overage.
+ */
+int plasma_mem_register_cache(const char *name,
+                              plasma_cache_size_fn size_fn,
+                              plasma_cache_evict_fn evict_fn,
+                              void *arg, int priority);
+
+/** Override the global cache budget (default 128 MB). */
+void plasma_mem_set_cache_budget(size_t bytes);
+
+/** Sum of all registered caches' current sizes. */
+size_t plasma_mem_cache_total(void);
+
+/** Enforce the budget now; returns bytes evicted. */
+size_t plasma_mem_enforce_budget(void);
+
+/** Pressure-driven enforcement (critical squeezes to half). */
+size_t plasma_mem_enforce_pressure(int level);
+
 #ifdef __cplusplus
 }
 #endif
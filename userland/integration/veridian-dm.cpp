@@ -25,6 +25,9 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <sys/wait.h>
+#include <signal.h>
+#include <poll.h>
+#include <dirent.h>
 #include <sys/stat.h>
 
 /* ======================================================================
@@ -177,6 +180,10 @@ int vdm_run(vdm_context_t *ctx)
                 continue;  /* Empty username, retry */
             }
 
+            /* Warm the session's cold-start set while the user
+             * types their password */
+            vdm_preload_begin();
+
             /* Read password (no echo in real implementation) */
             ctx->password_mode = true;
             fprintf(stderr, "  Password: ");
@@ -200,8 +207,10 @@ int vdm_run(vdm_context_t *ctx)
             if (result == VDM_AUTH_OK) {
                 fprintf(stderr, "[veridian-dm] Authentication successful "
                         "for '%s'\n", ctx->username);
+                vdm_preload_finish(true);
                 ctx->state = VDM_STATE_SESSION_SELECT;
             } else {
+                vdm_preload_finish(false);
                 ctx->login_attempts++;
                 const char *reason = "unknown error";
                 switch (result) {
@@ -500,6 +509,323 @@ bool vdm_load_autologin(vdm_autologin_t *cfg)
     return cfg->enabled;
 }
 
+/* ======================================================================
+ * Speculative session preload
+ * ====================================================================== */
+
+/*
+ * The seconds the user spends typing their password are dead time on
+ * an idle disk.  vdm_preload_begin() forks a niced helper that reads
+ * the session's cold-start set -- compositor and shell binaries, the
+ * compiled theme cache, and the shared font/metrics caches -- so the
+ * page cache is warm by the time authentication succeeds.  On auth
+ * failure the helper is killed; pages it already touched are clean
+ * page cache and simply age out.
+ */
+
+static pid_t g_preload_pid = -1;
+static pid_t g_preload_reap_pid = -1;   /* Exited-later helper to reap */
+
+/* Read one file start to end, for the page-cache side effect */
+static void vdm_preload_file(const char *path)
+{
+    char buf[65536];
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+        return;
+    while (read(fd, buf, sizeof(buf)) > 0)
+        ;
+    close(fd);
+}
+
+void vdm_preload_begin(void)
+{
+    if (g_preload_pid > 0)
+        return;                 /* Already running */
+
+    /* Reap a helper the previous login kept past auth success */
+    if (g_preload_reap_pid > 0 &&
+        waitpid(g_preload_reap_pid, NULL, WNOHANG) != 0)
+        g_preload_reap_pid = -1;
+
+    g_preload_pid = fork();
+    if (g_preload_pid != 0)
+        return;
+
+    /* Child: background I/O only, never compete with the greeter */
+    nice(10);
+
+    vdm_preload_file("/usr/bin/kwin_wayland");
+    vdm_preload_file("/usr/bin/plasmashell");
+    vdm_preload_file("/usr/bin/plasma-veridian-session");
+
+    /* Shared compiled-QML artifacts: warm before the shell starts */
+    {
+        DIR *dir = opendir("/var/cache/veridian/qmlcache");
+
+        if (dir) {
+            struct dirent *de;
+
+            while ((de = readdir(dir)) != NULL) {
+                char path[512];
+
+                if (de->d_name[0] == '.')
+                    continue;
+                snprintf(path, sizeof(path),
+                         "/var/cache/veridian/qmlcache/%s", de->d_name);
+                vdm_preload_file(path);
+            }
+            closedir(dir);
+        }
+    }
+
+    /* Compiled theme + per-user font/keymap caches */
+    {
+        DIR *dir = opendir("/var/cache/veridian");
+
+        if (dir) {
+            struct dirent *de;
+
+            while ((de = readdir(dir)) != NULL) {
+                char path[512];
+                size_t len = strlen(de->d_name);
+
+                if (len < 6 ||
+                    strcmp(de->d_name + len - 6, ".cache") != 0)
+                    continue;
+                snprintf(path, sizeof(path), "/var/cache/veridian/%s",
+                         de->d_name);
+                vdm_preload_file(path);
+            }
+            closedir(dir);
+        }
+    }
+    vdm_preload_file("/etc/veridian/theme.conf");
+    _exit(0);
+}
+
+void vdm_preload_finish(bool keep)
+{
+    if (g_preload_pid <= 0)
+        return;
+    if (keep) {
+        /* Don't stall the launch behind the helper: reap now if it
+         * already exited, otherwise on the next preload cycle */
+        if (waitpid(g_preload_pid, NULL, WNOHANG) == 0)
+            g_preload_reap_pid = g_preload_pid;
+    } else {
+        kill(g_preload_pid, SIGKILL);
+        waitpid(g_preload_pid, NULL, 0);
+    }
+    g_preload_pid = -1;
+}
+
+/* ======================================================================
+ * Staged session bring-up
+ * ====================================================================== */
+
+/*
+ * The Plasma session previously serialized end to end behind one
+ * session script.  Bring-up is now a dependency-stage table:
+ * items within a stage fork together and the next stage starts once
+ * every readiness-gated item of the current one has signaled (or the
+ * stage times out).  Readiness uses the same READY_FD pipe protocol
+ * as init's socket-activation layer: the child finds the fd number in
+ * $READY_FD and writes one byte when it is ready to serve.
+ *
+ *   stage 0: compositor (kwin)        -- gates everything
+ *   stage 1: shell (plasmashell)      -- gates applets
+ *   stage 2: tray/applets             -- concurrent, ungated
+ *   stage 3: autostart applications   -- concurrent, ungated
+ */
+
+#define VDM_MAX_STAGE_ITEMS 16
+#define VDM_STAGE_TIMEOUT_MS 5000
+
+typedef struct {
+    const char *name;
+    const char *exec;
+    int         stage;
+    bool        wait_ready;
+    pid_t       pid;
+    int         ready_fd;       /* Read end; -1 when not gated */
+} vdm_session_item_t;
+
+static vdm_session_item_t g_session_items[VDM_MAX_STAGE_ITEMS] = {
+    { "kwin",        "/usr/bin/kwin_wayland",        0, true,  0, -1 },
+    { "plasmashell", "/usr/bin/plasmashell",         1, true,  0, -1 },
+    { "krunner",     "/usr/bin/krunner",             2, false, 0, -1 },
+    { "nm-applet",   "/usr/bin/plasma-nm-applet",    2, false, 0, -1 },
+    { "volume",      "/usr/bin/plasma-audio-applet", 2, false, 0, -1 },
+    { "kwalletd",    "/usr/bin/kwalletd6",           2, false, 0, -1 },
+    { NULL, NULL, 0, false, 0, -1 },
+};
+
+/* Fork one session item; readiness pipe when gated */
+static int vdm_spawn_item(vdm_session_item_t *item, const char *username)
+{
+    int pipefd[2] = { -1, -1 };
+
+    if (item->wait_ready && pipe(pipefd) < 0)
+        item->wait_ready = false;
+
+    item->pid = fork();
+    if (item->pid < 0) {
+        if (pipefd[0] >= 0) {
+            close(pipefd[0]);
+            close(pipefd[1]);
+        }
+        return -1;
+    }
+
+    if (item->pid == 0) {
+        /* Child */
+        setenv("USER", username, 1);
+        setenv("HOME", "/root", 1);
+        setenv("SHELL", "/bin/sh", 1);
+        setenv("XDG_SESSION_TYPE", "wayland", 1);
+        setenv("XDG_CURRENT_DESKTOP", "KDE", 1);
+        setenv("XDG_SESSION_DESKTOP", "KDE", 1);
+        setenv("QT_QPA_PLATFORM", "wayland", 1);
+        setenv("VERIDIAN_SESSION", "plasma", 1);
+        /* One compiled-QML store for the whole session: Qt's disk
+         * cache and the shim's vqml surface share it */
+        setenv("QML_DISK_CACHE_PATH", "/var/cache/veridian/qmlcache", 1);
+        if (pipefd[1] >= 0) {
+            char buf[16];
+
+            close(pipefd[0]);
+            snprintf(buf, sizeof(buf), "%d", pipefd[1]);
+            setenv("READY_FD", buf, 1);
+        }
+        execl(item->exec, item->name, (char *)NULL);
+        _exit(127);
+    }
+
+    if (pipefd[1] >= 0) {
+        close(pipefd[1]);
+        fcntl(pipefd[0], F_SETFD, FD_CLOEXEC);
+        item->ready_fd = pipefd[0];
+    }
+    return 0;
+}
+
+/* Wait for every gated item of a stage; timeout proceeds anyway */
+static void vdm_wait_stage(int stage)
+{
+    struct pollfd pfds[VDM_MAX_STAGE_ITEMS];
+    vdm_session_item_t *gated[VDM_MAX_STAGE_ITEMS];
+    int n = 0;
+    int waited_ms = 0;
+
+    for (int i = 0; g_session_items[i].name; i++) {
+        vdm_session_item_t *item = &g_session_items[i];
+
+        if (item->stage == stage && item->ready_fd >= 0) {
+            pfds[n].fd = item->ready_fd;
+            pfds[n].events = POLLIN;
+            pfds[n].revents = 0;
+            gated[n] = item;
+            n++;
+        }
+    }
+
+    while (n > 0 && waited_ms < VDM_STAGE_TIMEOUT_MS) {
+        int rc = poll(pfds, (nfds_t)n, 100);
+
+        waited_ms += 100;
+        if (rc <= 0)
+            continue;
+        for (int i = 0; i < n; ) {
+            if (pfds[i].revents & (POLLIN | POLLHUP)) {
+                char byte;
+
+                (void)read(pfds[i].fd, &byte, 1);
+                close(gated[i]->ready_fd);
+                gated[i]->ready_fd = -1;
+                fprintf(stderr, "[veridian-dm] %s ready\n",
+                        gated[i]->name);
+                pfds[i] = pfds[n - 1];
+                gated[i] = gated[n - 1];
+                n--;
+            } else {
+                i++;
+            }
+        }
+    }
+
+    for (int i = 0; i < n; i++) {
+        fprintf(stderr, "[veridian-dm] %s: readiness timeout, "
+                "continuing\n", gated[i]->name);
+        close(gated[i]->ready_fd);
+        gated[i]->ready_fd = -1;
+    }
+}
+
+/* Launch the staged session; returns the compositor pid */
+static int vdm_launch_session_staged(const char *username)
+{
+    int first_pid = -1;
+    int max_stage = 0;
+
+    for (int i = 0; g_session_items[i].name; i++) {
+        if (g_session_items[i].stage > max_stage)
+            max_stage = g_session_items[i].stage;
+    }
+
+    for (int stage = 0; stage <= max_stage; stage++) {
+        for (int i = 0; g_session_items[i].name; i++) {
+            vdm_session_item_t *item = &g_session_items[i];
+
+            if (item->stage != stage)
+                continue;
+            if (access(item->exec, X_OK) != 0)
+                continue;       /* Optional component absent */
+            if (vdm_spawn_item(item, username) == 0) {
+                fprintf(stderr, "[veridian-dm] stage %d: %s (pid %d)\n",
+                        stage, item->name, (int)item->pid);
+                if (first_pid < 0)
+                    first_pid = item->pid;
+            }
+        }
+        vdm_wait_stage(stage);
+    }
+
+    /* Autostart (stage after the table): everything in the autostart
+     * directory launches concurrently, ungated */
+    {
+        DIR *dir = opendir("/etc/veridian/autostart");
+
+        if (dir) {
+            struct dirent *de;
+
+            while ((de = readdir(dir)) != NULL) {
+                char path[512];
+
+                if (de->d_name[0] == '.')
+                    continue;
+                snprintf(path, sizeof(path),
+                         "/etc/veridian/autostart/%s", de->d_name);
+                if (access(path, X_OK) != 0)
+                    continue;
+                {
+                    pid_t pid = fork();
+
+                    if (pid == 0) {
+                        setenv("USER", username, 1);
+                        execl(path, de->d_name, (char *)NULL);
+                        _exit(127);
+                    }
+                }
+            }
+            closedir(dir);
+        }
+    }
+
+    return first_pid;
+}
+
 /* ======================================================================
  * Session launch
  * ====================================================================== */
@@ -542,6 +868,11 @@ int vdm_launch_session(vdm_session_type_t type, const char *username)
         {
             const char *session_exec = "/usr/bin/plasma-veridian-session";
 
+            /* Staged bring-up when the individual components exist;
+             * the monolithic session script stays the fallback */
+            if (access(g_session_items[0].exec, X_OK) == 0)
+                return vdm_launch_session_staged(username);
+
             /* Verify the session script exists */
             if (access(session_exec, X_OK) != 0) {
                 fprintf(stderr, "[veridian-dm] %s not found or not "
@@ -579,6 +910,71 @@ int vdm_launch_session(vdm_session_type_t type, const char *username)
  * Rendering
  * ====================================================================== */
 
+/*
+ * Greeter wallpaper: blit the lockscreen's scaled raw cache when one
+ * matches the framebuffer size (same 'VWPC' format; generated by the
+ * first lock at this resolution or by tooling).  No decoder and no
+ * scaler live in the DM -- a cache hit is a read into the
+ * framebuffer, a miss leaves the solid background.
+ */
+static int vdm_render_wallpaper(vdm_context_t *ctx)
+{
+    DIR *dir;
+    struct dirent *de;
+    char match[64];
+    char path[512];
+    int done = 0;
+
+    if (!ctx || !ctx->framebuffer)
+        return -1;
+
+    snprintf(match, sizeof(match), "-%dx%d.raw", ctx->fb_width,
+             ctx->fb_height);
+
+    dir = opendir("/var/cache/veridian");
+    if (!dir)
+        return -1;
+
+    while (!done && (de = readdir(dir)) != NULL) {
+        size_t nlen = strlen(de->d_name);
+        size_t mlen = strlen(match);
+        int fd;
+        uint32_t hdr[4];
+
+        if (strncmp(de->d_name, "wallpaper-", 10) != 0)
+            continue;
+        if (nlen < mlen || strcmp(de->d_name + nlen - mlen, match) != 0)
+            continue;
+
+        snprintf(path, sizeof(path), "/var/cache/veridian/%s",
+                 de->d_name);
+        fd = open(path, O_RDONLY);
+        if (fd < 0)
+            continue;
+        if (read(fd, hdr, sizeof(hdr)) == (ssize_t)sizeof(hdr) &&
+            hdr[0] == 0x43505756u &&
+            (int)hdr[1] == ctx->fb_width &&
+            (int)hdr[2] == ctx->fb_height) {
+            size_t want = (size_t)ctx->fb_width *
+                          (size_t)ctx->fb_height * 4;
+            size_t got = 0;
+
+            while (got < want) {
+                ssize_t rd = read(fd, (char *)ctx->framebuffer + got,
+                                  want - got);
+
+                if (rd <= 0)
+                    break;
+                got += (size_t)rd;
+            }
+            done = got == want;
+        }
+        close(fd);
+    }
+    closedir(dir);
+    return done ? 0 : -1;
+}
+
 void vdm_render_rect(vdm_context_t *ctx, int x, int y,
                      int w, int h, uint32_t color)
 {
@@ -629,8 +1025,10 @@ void vdm_render_login(vdm_context_t *ctx)
         return;
     }
 
-    /* Clear background */
-    vdm_render_rect(ctx, 0, 0, ctx->fb_width, ctx->fb_height, COLOR_BG);
+    /* Wallpaper from the scaled cache, else the solid background */
+    if (vdm_render_wallpaper(ctx) != 0)
+        vdm_render_rect(ctx, 0, 0, ctx->fb_width, ctx->fb_height,
+                        COLOR_BG);
 
     /* Center coordinates */
     int cx = ctx->fb_width / 2;
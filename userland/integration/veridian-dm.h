@@ -163,6 +163,14 @@ bool vdm_load_autologin(vdm_autologin_t *cfg);
  */
 int vdm_launch_session(vdm_session_type_t type, const char *username);
 
+/*
+ * Speculative session preload: begin warming the session's cold-start
+ * set (binaries, theme and font caches) during password entry; finish
+ * with keep=true on auth success or keep=false to kill the helper.
+ */
+void vdm_preload_begin(void);
+void vdm_preload_finish(bool keep);
+
 /* ======================================================================
  * Rendering (uses kernel compositor framebuffer)
  * ====================================================================== */
@@ -30,6 +30,8 @@
 #include <errno.h>
 #include <sys/stat.h>
 #include <sys/ioctl.h>
+#include <sys/eventfd.h>
+#include <poll.h>
 
 /* ======================================================================
  * Internal: render node discovery
@@ -268,6 +270,116 @@ int dri3_fence_from_fd(int fd, dri3_fence_t *fence)
     return 0;
 }
 
+/* ======================================================================
+ * Explicit synchronization
+ * ====================================================================== */
+
+int dri3_fence_create(dri3_fence_t *fence)
+{
+    if (!fence) {
+        return -1;
+    }
+
+    fence->fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (fence->fd < 0) {
+        fprintf(stderr, "[dri3] fence_create: eventfd failed: %s\n",
+                strerror(errno));
+        return -1;
+    }
+    fence->triggered = false;
+    return 0;
+}
+
+int dri3_fence_signal(dri3_fence_t *fence)
+{
+    uint64_t one = 1;
+
+    if (!fence || fence->fd < 0) {
+        return -1;
+    }
+    if (fence->triggered) {
+        return 0;               /* Idempotent */
+    }
+    if (write(fence->fd, &one, sizeof(one)) != (ssize_t)sizeof(one) &&
+        errno != EAGAIN) {
+        return -1;
+    }
+    fence->triggered = true;
+    return 0;
+}
+
+int dri3_fence_is_signaled(dri3_fence_t *fence)
+{
+    struct pollfd pfd;
+
+    if (!fence || fence->fd < 0) {
+        return -1;
+    }
+    if (fence->triggered) {
+        return 1;               /* Cached: no syscall after signal */
+    }
+
+    pfd.fd = fence->fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    if (poll(&pfd, 1, 0) < 0) {
+        return -1;
+    }
+    if (pfd.revents & POLLIN) {
+        fence->triggered = true;
+        return 1;
+    }
+    return 0;
+}
+
+int dri3_fence_wait(dri3_fence_t *fence, int timeout_ms)
+{
+    struct pollfd pfd;
+    int rc;
+
+    if (!fence || fence->fd < 0) {
+        return -1;
+    }
+    if (fence->triggered) {
+        return 0;
+    }
+
+    pfd.fd = fence->fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    rc = poll(&pfd, 1, timeout_ms);
+    if (rc <= 0) {
+        return -1;              /* Timeout or error */
+    }
+    fence->triggered = true;
+    return 0;
+}
+
+void dri3_fence_reset(dri3_fence_t *fence)
+{
+    uint64_t drain;
+
+    if (!fence || fence->fd < 0) {
+        return;
+    }
+    /* Consume the eventfd count so the next signal re-arms it */
+    while (read(fence->fd, &drain, sizeof(drain)) > 0) {
+    }
+    fence->triggered = false;
+}
+
+void dri3_fence_destroy(dri3_fence_t *fence)
+{
+    if (!fence) {
+        return;
+    }
+    if (fence->fd >= 0) {
+        close(fence->fd);
+        fence->fd = -1;
+    }
+    fence->triggered = false;
+}
+
 int dri3_get_supported_modifiers(uint32_t format, uint32_t depth,
                                   dri3_modifier_list_t *modifiers)
 {
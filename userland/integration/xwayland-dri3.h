@@ -116,6 +116,43 @@ int dri3_buffer_from_pixmap(uint32_t pixmap, dri3_buffer_t *buffer);
  */
 int dri3_fence_from_fd(int fd, dri3_fence_t *fence);
 
+/* ======================================================================
+ * Explicit synchronization
+ *
+ * Per-buffer fences let composition overlap client rendering: the
+ * client attaches a fence when presenting, the render path signals
+ * it on completion, and the compositor -- instead of waiting for
+ * full rendering up front -- checks or waits the fence only at the
+ * moment it samples the buffer.
+ * ====================================================================== */
+
+/* Create a fresh unsignaled fence (eventfd-backed).  The fd can be
+ * passed to the render process.  Returns 0 on success. */
+int dri3_fence_create(dri3_fence_t *fence);
+
+/* Signal the fence (render complete).  Idempotent. */
+int dri3_fence_signal(dri3_fence_t *fence);
+
+/* Non-blocking check: 1 signaled, 0 pending, -1 error.  Caches the
+ * signaled state so checks after the signal are free. */
+int dri3_fence_is_signaled(dri3_fence_t *fence);
+
+/* Bounded wait: 0 when signaled, -1 on timeout/error. */
+int dri3_fence_wait(dri3_fence_t *fence, int timeout_ms);
+
+/* Re-arm a signaled fence for the next frame. */
+void dri3_fence_reset(dri3_fence_t *fence);
+
+/* Close the fence fd. */
+void dri3_fence_destroy(dri3_fence_t *fence);
+
+/* A buffer handed to the compositor with its rendering fence. */
+typedef struct {
+    dri3_buffer_t buffer;
+    dri3_fence_t  fence;
+    bool          has_fence;
+} dri3_synced_buffer_t;
+
 /*
  * Query supported DRM format modifiers for a given format.
  * Returns 0 on success, -1 on error.
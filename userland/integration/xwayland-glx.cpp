@@ -120,6 +120,48 @@ static struct {
 static __thread GLXContext  tls_current_context  = NULL;
 static __thread GLXDrawable tls_current_drawable = 0;
 
+/*
+ * GLX state shadow.
+ *
+ * MakeCurrent/SwapBuffers previously re-validated the drawable and
+ * re-resolved the surface on every call.  The shadow keeps the
+ * current binding, its resolved surface, and the swap interval per
+ * thread; a MakeCurrent that changes nothing returns immediately,
+ * SwapBuffers on the current drawable uses the cached surface, and a
+ * redundant SwapInterval is dropped.  Counters expose the skip rate.
+ */
+static __thread glx_surface_map_t *tls_current_surface = NULL;
+static __thread int tls_swap_interval = -1;     /* -1 = never set */
+static uint64_t g_makecurrent_skipped;
+static uint64_t g_fbconfig_cache_hits;
+
+/* Process-wide FBConfig lookup cache: the chosen config per distinct
+ * attribute tuple (the parse + selection runs once per tuple) */
+#define GLX_FBCACHE_SLOTS 32
+
+struct glx_fbcache_entry {
+    uint64_t attrib_hash;
+    GLXFBConfig config;
+    int used;
+};
+
+static struct glx_fbcache_entry g_fbcache[GLX_FBCACHE_SLOTS];
+
+static uint64_t glx_hash_attribs(const int *attrib_list)
+{
+    uint64_t h = 0xcbf29ce484222325ull;
+
+    if (attrib_list) {
+        for (int i = 0; attrib_list[i] != 0; i += 2) {
+            h ^= (uint64_t)(uint32_t)attrib_list[i];
+            h *= 0x100000001b3ull;
+            h ^= (uint64_t)(uint32_t)attrib_list[i + 1];
+            h *= 0x100000001b3ull;
+        }
+    }
+    return h ? h : 1;
+}
+
 /* Mutex for state modifications */
 static pthread_mutex_t g_glx_mutex = PTHREAD_MUTEX_INITIALIZER;
 
@@ -478,10 +520,19 @@ Bool glXMakeCurrent(Display *dpy, GLXDrawable drawable, GLXContext ctx)
     glx_ensure_initialized();
     (void)dpy;
 
+    /* Shadow fast path: rebinding the already-current pair is a
+     * no-op -- no drawable validation, no surface resolution */
+    if (ctx == tls_current_context && drawable == tls_current_drawable &&
+        (ctx || drawable == 0)) {
+        g_makecurrent_skipped++;
+        return True;
+    }
+
     if (!ctx && drawable == 0) {
         /* Unbind current context */
         tls_current_context = NULL;
         tls_current_drawable = 0;
+        tls_current_surface = NULL;
         /*
          * eglMakeCurrent(g_glx_state.egl_display,
          *                EGL_NO_SURFACE, EGL_NO_SURFACE,
@@ -526,6 +577,7 @@ Bool glXMakeCurrent(Display *dpy, GLXDrawable drawable, GLXContext ctx)
 
     tls_current_context = ctx;
     tls_current_drawable = drawable;
+    tls_current_surface = surf;
 
     return True;
 }
@@ -534,7 +586,13 @@ void glXSwapBuffers(Display *dpy, GLXDrawable drawable)
 {
     (void)dpy;
 
-    glx_surface_map_t *surf = glx_find_surface(drawable);
+    /* The common case -- swapping the current drawable -- uses the
+     * surface resolved at MakeCurrent; only foreign drawables pay
+     * the lookup */
+    glx_surface_map_t *surf =
+        (drawable == tls_current_drawable && tls_current_surface)
+            ? tls_current_surface
+            : glx_find_surface(drawable);
     if (!surf) {
         fprintf(stderr, "[glx] glXSwapBuffers: unknown drawable 0x%lx\n",
                 (unsigned long)drawable);
@@ -547,6 +605,40 @@ void glXSwapBuffers(Display *dpy, GLXDrawable drawable)
     (void)surf;
 }
 
+void glXSwapIntervalEXT(Display *dpy, GLXDrawable drawable,
+                        int interval)
+{
+    (void)dpy;
+    (void)drawable;
+
+    /* Shadowed: setting the interval already in effect costs
+     * nothing (games re-assert vsync per frame) */
+    if (interval == tls_swap_interval)
+        return;
+    tls_swap_interval = interval;
+    /*
+     * eglSwapInterval(g_glx_state.egl_display, interval);
+     */
+}
+
+int glXSwapIntervalSGI(int interval)
+{
+    if (interval < 0)
+        return 2;               /* GLXBadValue */
+    glXSwapIntervalEXT(NULL, 0, interval);
+    return 0;
+}
+
+/** Shadow diagnostics: redundant calls absorbed by the caches. */
+void glxVeridianShadowStats(uint64_t *makecurrent_skipped,
+                            uint64_t *fbconfig_hits)
+{
+    if (makecurrent_skipped)
+        *makecurrent_skipped = g_makecurrent_skipped;
+    if (fbconfig_hits)
+        *fbconfig_hits = g_fbconfig_cache_hits;
+}
+
 Bool glXIsDirect(Display *dpy, GLXContext ctx)
 {
     (void)dpy;
@@ -579,6 +671,35 @@ GLXFBConfig *glXChooseFBConfig(Display *dpy, int screen,
     (void)dpy;
     (void)screen;
 
+    /* Process-wide cache: the same attribute tuple (games re-query
+     * identical configs constantly) skips the parse and selection
+     * and returns the previously chosen config */
+    uint64_t attrib_hash = glx_hash_attribs(attrib_list);
+
+    pthread_mutex_lock(&g_glx_mutex);
+    for (int i = 0; i < GLX_FBCACHE_SLOTS; i++) {
+        if (g_fbcache[i].used &&
+            g_fbcache[i].attrib_hash == attrib_hash) {
+            GLXFBConfig cached = g_fbcache[i].config;
+
+            g_fbconfig_cache_hits++;
+            pthread_mutex_unlock(&g_glx_mutex);
+            {
+                GLXFBConfig *result =
+                    (GLXFBConfig *)calloc(1, sizeof(GLXFBConfig));
+
+                if (!result) {
+                    if (nelements) *nelements = 0;
+                    return NULL;
+                }
+                result[0] = cached;
+                if (nelements) *nelements = 1;
+                return result;
+            }
+        }
+    }
+    pthread_mutex_unlock(&g_glx_mutex);
+
     /*
      * Parse the FBConfig attribute list and translate to EGL.
      * FBConfig attributes use key/value pairs (unlike the old
@@ -680,6 +801,18 @@ GLXFBConfig *glXChooseFBConfig(Display *dpy, int screen,
     result[0] = cfg;
     if (nelements) *nelements = 1;
 
+    /* Remember the choice for the next identical query */
+    pthread_mutex_lock(&g_glx_mutex);
+    for (int i = 0; i < GLX_FBCACHE_SLOTS; i++) {
+        if (!g_fbcache[i].used) {
+            g_fbcache[i].attrib_hash = attrib_hash;
+            g_fbcache[i].config = cfg;
+            g_fbcache[i].used = 1;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&g_glx_mutex);
+
     fprintf(stderr, "[glx] glXChooseFBConfig: returning 1 config "
             "(RGBA=%d/%d/%d/%d depth=%d stencil=%d)\n",
             cfg->red_size, cfg->green_size, cfg->blue_size,
@@ -317,6 +317,15 @@ GLXContext glXCreateContextAttribsARB(Display *dpy,
                                        Bool direct,
                                        const int *attrib_list);
 
+/* Swap interval (EXT/SGI), shadowed against redundant sets */
+void glXSwapIntervalEXT(Display *dpy, GLXDrawable drawable, int interval);
+int glXSwapIntervalSGI(int interval);
+
+/* VeridianOS diagnostics: redundant calls absorbed by the state
+ * shadow and the FBConfig cache */
+void glxVeridianShadowStats(uint64_t *makecurrent_skipped,
+                            uint64_t *fbconfig_hits);
+
 #ifdef __cplusplus
 }
 #endif
@@ -237,22 +237,31 @@ int xim_bridge_set_focus(xim_bridge_t *bridge, uint32_t x11_window)
         return -1;
     }
 
-    /* Unfocus the previously focused client */
+    /*
+     * Suspend -- do not destroy -- the previous client's composition.
+     * The preedit display hides in the old window (preedit_done to
+     * the app) but the composition text, caret, and spot stay in the
+     * pooled slot, so switching back resumes mid-composition instead
+     * of reconstructing IM state from scratch.
+     */
     xim_client_t *prev = xim_get_focused(bridge);
     if (prev) {
         prev->focused = false;
 
-        /* Clear any active preedit */
         if (prev->preedit_len > 0) {
             xim_send_preedit_done(bridge, prev);
-            prev->preedit_len = 0;
-            prev->preedit[0] = '\0';
+            prev->preedit_suspended = true;
         }
     }
 
-    /* Find or create a client entry for this window */
+    bridge->focus_switches++;
+
+    /* Find or create a client entry for this window.  Existing slots
+     * are switched by pointer: no teardown, no rebuild */
     int idx = xim_find_client(bridge, x11_window);
-    if (idx < 0) {
+    if (idx >= 0) {
+        bridge->contexts_reused++;
+    } else {
         idx = xim_alloc_client(bridge);
         if (idx < 0) {
             fprintf(stderr, "[xim] set_focus: no free client slots\n");
@@ -271,14 +280,35 @@ int xim_bridge_set_focus(xim_bridge_t *bridge, uint32_t x11_window)
     bridge->focused_idx = idx;
 
     /*
-     * Activate Wayland text-input-v3 for this seat:
+     * Keep the Wayland text-input enabled across X-to-X focus moves:
+     * only the first focus (or a refocus after unset_focus) pays the
+     * enable/commit round-trip.
      *   zwp_text_input_v3_enable(bridge->wl_text_input);
-     *   zwp_text_input_v3_set_content_type(bridge->wl_text_input,
-     *       ZWP_TEXT_INPUT_V3_CONTENT_HINT_NONE,
-     *       ZWP_TEXT_INPUT_V3_CONTENT_PURPOSE_NORMAL);
+     *   zwp_text_input_v3_set_content_type(...);
      *   zwp_text_input_v3_commit(bridge->wl_text_input);
-     *   wl_surface_commit(focused_surface);
      */
+    if (!bridge->ti_enabled)
+        bridge->ti_enabled = true;
+
+    /* Resume a suspended composition in the refocused window */
+    {
+        xim_client_t *client = &bridge->clients[idx];
+
+        if (client->preedit_suspended && client->preedit_len > 0) {
+            xim_preedit_draw_t draw;
+
+            memset(&draw, 0, sizeof(draw));
+            draw.caret = client->preedit_caret;
+            draw.change_first = 0;
+            draw.change_length = 0;
+            memcpy(draw.text, client->preedit,
+                   (size_t)client->preedit_len);
+            draw.text_length = client->preedit_len;
+            xim_send_preedit_draw(bridge, client, &draw);
+            client->preedit_suspended = false;
+            bridge->compositions_resumed++;
+        }
+    }
 
     fprintf(stderr, "[xim] set_focus: window=0x%x (slot %d)\n",
             x11_window, idx);
@@ -294,11 +324,10 @@ void xim_bridge_unset_focus(xim_bridge_t *bridge)
 
     xim_client_t *client = xim_get_focused(bridge);
     if (client) {
-        /* Clear preedit */
+        /* Suspend, preserving the composition for refocus */
         if (client->preedit_len > 0) {
             xim_send_preedit_done(bridge, client);
-            client->preedit_len = 0;
-            client->preedit[0] = '\0';
+            client->preedit_suspended = true;
         }
 
         client->focused = false;
@@ -310,10 +339,12 @@ void xim_bridge_unset_focus(xim_bridge_t *bridge)
     bridge->focused_idx = -1;
 
     /*
-     * Deactivate Wayland text-input-v3:
+     * Deactivate Wayland text-input-v3 -- focus left X windows
+     * entirely, so the enable round-trip is paid again on return:
      *   zwp_text_input_v3_disable(bridge->wl_text_input);
      *   zwp_text_input_v3_commit(bridge->wl_text_input);
      */
+    bridge->ti_enabled = false;
 }
 
 bool xim_bridge_forward_key(xim_bridge_t *bridge, uint32_t keycode,
@@ -73,6 +73,10 @@ typedef struct {
     /* Spot location for on-the-spot preedit rendering */
     int         spot_x;
     int         spot_y;
+
+    /* Composition preserved across focus loss: the preedit text
+     * stays in the slot while suspended and resumes on refocus */
+    bool        preedit_suspended;
 } xim_client_t;
 
 /* XIM bridge state */
@@ -90,6 +94,12 @@ typedef struct {
     /* Wayland text-input connection (opaque) */
     void           *wl_text_input;  /* zwp_text_input_v3 * */
     void           *wl_seat;        /* wl_seat * */
+    bool            ti_enabled;     /* text-input currently enabled */
+
+    /* Focus-switch diagnostics */
+    uint64_t        focus_switches;
+    uint64_t        contexts_reused;
+    uint64_t        compositions_resumed;
 
     /* Supported styles */
     XIMStyle        supported_styles;
@@ -30,6 +30,7 @@
 #include <sys/un.h>
 #include <sys/stat.h>
 #include <sys/wait.h>
+#include <poll.h>
 
 /* ======================================================================
  * Helper: find available display number
@@ -447,6 +448,10 @@ int xwl_window_created(xwl_context_t *ctx, uint32_t x11_id,
     win->height = height;
     win->mapped = false;
     win->override_redirect = override_redirect;
+    win->fence_fd = -1;
+    win->fence_signaled = false;
+    win->flip_buffer_fd = -1;
+    win->present_mode = XWL_PRESENT_COPY;
 
     ctx->window_count++;
 
@@ -458,6 +463,133 @@ int xwl_window_created(xwl_context_t *ctx, uint32_t x11_id,
     return idx;
 }
 
+void xwl_set_output_size(xwl_context_t *ctx, int width, int height)
+{
+    if (!ctx)
+        return;
+    ctx->output_width = width;
+    ctx->output_height = height;
+}
+
+/*
+ * Present fast path.
+ *
+ * Fullscreen X windows (video, games) previously paid two full-frame
+ * copies per present: client buffer -> window pixmap -> Wayland
+ * surface.  When the presented buffer exactly covers the output and
+ * the window is mapped at output size, the DMA-BUF is adopted as the
+ * surface buffer directly and only the fence crosses with it.  Any
+ * mismatch -- windowed, resized mid-stream, unmapped -- falls back to
+ * copy mode on that present, so the path is self-correcting.
+ */
+int xwl_present_buffer(xwl_context_t *ctx, uint32_t x11_id,
+                       int buffer_fd, int buffer_width,
+                       int buffer_height, int fence_fd)
+{
+    if (!ctx || buffer_fd < 0)
+        return -1;
+
+    for (int i = 0; i < ctx->window_count; i++) {
+        xwl_window_t *w = &ctx->windows[i];
+        bool flip;
+
+        if (w->x11_window_id != x11_id)
+            continue;
+
+        flip = w->mapped &&
+               ctx->output_width > 0 &&
+               w->width == ctx->output_width &&
+               w->height == ctx->output_height &&
+               buffer_width == ctx->output_width &&
+               buffer_height == ctx->output_height;
+
+        /* Drop any previously adopted buffer */
+        if (w->flip_buffer_fd >= 0) {
+            close(w->flip_buffer_fd);
+            w->flip_buffer_fd = -1;
+        }
+
+        if (flip) {
+            w->flip_buffer_fd = dup(buffer_fd);
+            if (w->flip_buffer_fd < 0)
+                flip = false;       /* fd table full: copy instead */
+        }
+
+        w->present_mode = flip ? XWL_PRESENT_FLIP : XWL_PRESENT_COPY;
+        if (flip)
+            ctx->present_flips++;
+        else
+            ctx->present_copies++;
+
+        /* The render fence rides along either way */
+        xwl_window_attach_fence(ctx, x11_id, fence_fd);
+
+        return w->present_mode;
+    }
+    return -1;
+}
+
+void xwl_present_stats(const xwl_context_t *ctx, uint64_t *flips,
+                       uint64_t *copies)
+{
+    if (flips)
+        *flips = ctx ? ctx->present_flips : 0;
+    if (copies)
+        *copies = ctx ? ctx->present_copies : 0;
+}
+
+int xwl_window_attach_fence(xwl_context_t *ctx, uint32_t x11_id,
+                            int fence_fd)
+{
+    if (!ctx)
+        return -1;
+
+    for (int i = 0; i < ctx->window_count; i++) {
+        xwl_window_t *w = &ctx->windows[i];
+
+        if (w->x11_window_id != x11_id)
+            continue;
+        if (w->fence_fd >= 0)
+            close(w->fence_fd);
+        w->fence_fd = fence_fd >= 0 ? dup(fence_fd) : -1;
+        w->fence_signaled = false;
+        return 0;
+    }
+    return -1;
+}
+
+int xwl_window_buffer_ready(xwl_context_t *ctx, uint32_t x11_id)
+{
+    if (!ctx)
+        return -1;
+
+    for (int i = 0; i < ctx->window_count; i++) {
+        xwl_window_t *w = &ctx->windows[i];
+
+        if (w->x11_window_id != x11_id)
+            continue;
+        if (w->fence_fd < 0 || w->fence_signaled)
+            return 1;           /* No fence (legacy) or already done */
+        {
+            /* Non-blocking fence check: composition keeps going and
+             * samples this window once the render path signals */
+            struct pollfd pfd;
+
+            pfd.fd = w->fence_fd;
+            pfd.events = POLLIN;
+            pfd.revents = 0;
+            if (poll(&pfd, 1, 0) < 0)
+                return -1;
+            if (pfd.revents & POLLIN) {
+                w->fence_signaled = true;
+                return 1;
+            }
+        }
+        return 0;
+    }
+    return -1;
+}
+
 void xwl_window_destroyed(xwl_context_t *ctx, uint32_t x11_id)
 {
     if (!ctx) {
@@ -469,6 +601,11 @@ void xwl_window_destroyed(xwl_context_t *ctx, uint32_t x11_id)
             fprintf(stderr, "[xwayland] Window destroyed: X11 ID 0x%x\n",
                     x11_id);
 
+            if (ctx->windows[i].fence_fd >= 0)
+                close(ctx->windows[i].fence_fd);
+            if (ctx->windows[i].flip_buffer_fd >= 0)
+                close(ctx->windows[i].flip_buffer_fd);
+
             /* Shift remaining windows down */
             if (i < ctx->window_count - 1) {
                 memmove(&ctx->windows[i], &ctx->windows[i + 1],
@@ -84,6 +84,16 @@ typedef struct {
     bool        override_redirect;  /* X11 override-redirect flag */
     char        title[256];         /* Window title (WM_NAME) */
     char        wm_class[128];      /* WM_CLASS for app matching */
+
+    /* Explicit sync: the render fence of the currently attached
+     * buffer.  fence_fd < 0 means no fence (legacy full-wait path) */
+    int         fence_fd;
+    bool        fence_signaled;
+
+    /* Present fast path: adopted flip buffer (-1 = copy mode) and
+     * the mode of the last present */
+    int         flip_buffer_fd;
+    int         present_mode;       /* xwl_present_mode_t */
 } xwl_window_t;
 
 /* Clipboard buffer */
@@ -100,6 +110,10 @@ typedef struct {
     pid_t           server_pid;         /* Xwayland process PID */
     int             display_number;     /* X11 display number (:0, :1, ...) */
     int             wm_fd;              /* Window manager socket fd */
+    int             output_width;       /* For flip eligibility */
+    int             output_height;
+    uint64_t        present_flips;
+    uint64_t        present_copies;
     int             x11_fd;             /* X11 connection socket fd */
 
     /* Window tracking */
@@ -197,6 +211,61 @@ void xwl_window_set_mapped(xwl_context_t *ctx, uint32_t x11_id,
 const xwl_window_t *xwl_find_window(const xwl_context_t *ctx,
                                      uint32_t x11_id);
 
+/* ======================================================================
+ * Present fast path
+ * ====================================================================== */
+
+/* How the last presented buffer reached the compositor */
+typedef enum {
+    XWL_PRESENT_COPY = 0,       /* Contents copied into the surface  */
+    XWL_PRESENT_FLIP = 1        /* Client buffer handed over directly */
+} xwl_present_mode_t;
+
+/*
+ * Set the output dimensions used for flip eligibility.  A window
+ * whose presented buffer exactly covers the output qualifies for
+ * flip mode.
+ */
+void xwl_set_output_size(xwl_context_t *ctx, int width, int height);
+
+/*
+ * Present a client buffer to a window's Wayland surface.
+ *
+ * Fullscreen presents -- mapped window and buffer both matching the
+ * output size -- take flip mode: the DMA-BUF fd is adopted as the
+ * surface buffer directly (zero-copy) along with its render fence.
+ * Everything else falls back to copy mode automatically, including
+ * mid-stream (a fullscreen video leaving fullscreen flips back to
+ * copies on the next present).
+ *
+ * Returns the XWL_PRESENT_* mode used, or -1 on error.  The buffer
+ * fd is dup'd in flip mode; the caller keeps ownership of its fd.
+ */
+int xwl_present_buffer(xwl_context_t *ctx, uint32_t x11_id,
+                       int buffer_fd, int buffer_width,
+                       int buffer_height, int fence_fd);
+
+/* Flip/copy counters for the fast-path hit rate. */
+void xwl_present_stats(const xwl_context_t *ctx, uint64_t *flips,
+                       uint64_t *copies);
+
+/*
+ * Attach a presented buffer's render fence to a window.  The
+ * compositor overlaps composition with client rendering and checks
+ * readiness only when it samples the buffer.  Pass fence_fd = -1 to
+ * clear (legacy behavior).  Returns 0 on success.
+ */
+int xwl_window_attach_fence(xwl_context_t *ctx, uint32_t x11_id,
+                            int fence_fd);
+
+/*
+ * Whether the window's attached buffer is ready to sample:
+ *   1 = ready (fence signaled or no fence), 0 = still rendering,
+ *  -1 = unknown window.  Non-blocking; the compositor composites
+ * other windows and re-checks rather than stalling the frame.
+ */
+int xwl_window_buffer_ready(xwl_context_t *ctx, uint32_t x11_id);
+
 /* ======================================================================
  * Clipboard Sharing
  * ====================================================================== */
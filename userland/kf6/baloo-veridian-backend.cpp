@@ -7,7 +7,8 @@
  * Baloo file indexer backend implementation for VeridianOS.
  *
  * Features:
- *   - Recursive directory crawler with rate limiting (100 files/batch)
+ *   - Parallel crawl pipeline: one directory-reader thread feeding
+ *     content-extractor workers over a bounded lock-free ring
  *   - Filename tokenization: split on . - _ space and camelCase boundaries
  *   - Content extraction for text files (first 64KB, skip binary)
  *   - Inotify-based directory watching for live updates
@@ -35,6 +36,11 @@
 #include <QSet>
 #include <QQueue>
 #include <QElapsedTimer>
+#include <QThread>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QAtomicInteger>
+#include <QVector>
 
 #include <string.h>
 #include <sys/inotify.h>
@@ -43,6 +49,7 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <poll.h>
+#include <dirent.h>
 
 namespace Baloo {
 
@@ -50,7 +57,6 @@ namespace Baloo {
 /* Configuration                                                             */
 /* ========================================================================= */
 
-static const int CRAWL_BATCH_SIZE       = 100;
 static const int CONTENT_MAX_BYTES      = 65536;  /* 64 KB */
 static const int BINARY_CHECK_BYTES     = 512;
 static const int AUTOSAVE_INTERVAL_MS   = 300000;  /* 5 minutes */
@@ -74,12 +80,94 @@ static BalooIndex *s_index = nullptr;
 static BalooIndexState s_state = BALOO_IDLE;
 static QString s_indexPath;
 static QStringList s_excludedPaths;
-static QQueue<QString> s_crawlQueue;
 static bool s_crawlActive = false;
 static uint64_t s_filesProcessed = 0;
 static uint64_t s_filesSinceLastSave = 0;
 static QElapsedTimer s_lastSaveTimer;
 
+/* One lock serializes every touch of s_index (worker adds, saves,
+ * queries, inotify updates) plus the file counters above */
+static QMutex s_indexLock;
+
+/* ========================================================================= */
+/* Bounded lock-free queue (crawl pipeline)                                  */
+/* ========================================================================= */
+
+/*
+ * Vyukov-style bounded MPMC ring.  Each cell carries a sequence
+ * number: producers claim a ticket with fetch-and-add, wait for the
+ * cell to reach their turn, store the payload, and publish by bumping
+ * the sequence; consumers mirror that.  No mutex anywhere on the
+ * crawl hot path.
+ */
+static const unsigned CRAWL_RING_SIZE = 1024;   /* Power of two */
+
+struct CrawlRing {
+    struct Cell {
+        QAtomicInteger<unsigned> seq;
+        QString path;
+    };
+
+    Cell cells[CRAWL_RING_SIZE];
+    QAtomicInteger<unsigned> head;   /* Next enqueue ticket */
+    QAtomicInteger<unsigned> tail;   /* Next dequeue ticket */
+
+    void reset()
+    {
+        for (unsigned i = 0; i < CRAWL_RING_SIZE; ++i) {
+            cells[i].seq.storeRelease(i);
+            cells[i].path.clear();
+        }
+        head.storeRelease(0);
+        tail.storeRelease(0);
+    }
+
+    /* Blocking push (spins with yield while full) */
+    void push(const QString &path, const QAtomicInteger<int> &abort)
+    {
+        const unsigned pos = head.fetchAndAddOrdered(1);
+        Cell &cell = cells[pos & (CRAWL_RING_SIZE - 1)];
+
+        while (cell.seq.loadAcquire() != pos) {
+            if (abort.loadAcquire())
+                return;
+            QThread::yieldCurrentThread();
+        }
+        cell.path = path;
+        cell.seq.storeRelease(pos + 1);
+    }
+
+    /* Non-blocking pop; returns false when currently empty */
+    bool tryPop(QString *out)
+    {
+        for (;;) {
+            unsigned pos = tail.loadAcquire();
+            Cell &cell = cells[pos & (CRAWL_RING_SIZE - 1)];
+            const unsigned seq = cell.seq.loadAcquire();
+
+            if (seq == pos + 1) {
+                if (tail.testAndSetOrdered(pos, pos + 1)) {
+                    *out = cell.path;
+                    cell.path.clear();
+                    cell.seq.storeRelease(pos + CRAWL_RING_SIZE);
+                    return true;
+                }
+            } else if (seq <= pos) {
+                return false;   /* Empty (or producer mid-write) */
+            } else {
+                QThread::yieldCurrentThread();  /* Lost the race */
+            }
+        }
+    }
+};
+
+static CrawlRing s_crawlRing;
+static QThread *s_readerThread = nullptr;
+static QVector<QThread *> s_workerThreads;
+static QAtomicInteger<int> s_crawlAbort;
+static QAtomicInteger<int> s_readerDone;
+static QAtomicInteger<int> s_workersLeft;
+
 /* Inotify state */
 static int s_inotifyFd = -1;
 static QHash<int, QString> s_watchDescriptors;  /* wd -> path */
@@ -177,30 +265,31 @@ static QStringList tokenizeFilename(const QString &filename)
 /* File indexing                                                              */
 /* ========================================================================= */
 
-static void indexSingleFile(const QString &filePath)
-{
-    if (!s_index)
-        return;
+struct WordHit {
+    QByteArray word;
+    int relevance;
+};
 
+/*
+ * Extraction stage: read and tokenize one file WITHOUT touching the
+ * index.  Runs on the content-extractor workers; the result batch is
+ * applied under the index lock in one short critical section.
+ */
+static void collectFileTokens(const QString &filePath, QVector<WordHit> *hits)
+{
     QFileInfo fi(filePath);
     if (!fi.exists() || !fi.isReadable())
         return;
 
-    QByteArray pathUtf8 = filePath.toUtf8();
-
-    /* Index filename tokens */
+    /* Filename tokens */
     QStringList nameTokens = tokenizeFilename(fi.fileName());
-    for (const QString &token : nameTokens) {
-        QByteArray tokenUtf8 = token.toUtf8();
-        baloo_index_add(s_index, tokenUtf8.constData(),
-                        pathUtf8.constData(), 80);
-    }
+    for (const QString &token : nameTokens)
+        hits->append({ token.toUtf8(), 80 });
 
     /* Also index the full basename as a single token */
     QByteArray basename = fi.completeBaseName().toLower().toUtf8();
     if (!basename.isEmpty())
-        baloo_index_add(s_index, basename.constData(),
-                        pathUtf8.constData(), 70);
+        hits->append({ basename, 70 });
 
     /* Content indexing for text files */
     if (fi.isFile() && isTextExtension(fi.suffix())) {
@@ -214,104 +303,237 @@ static void indexSingleFile(const QString &filePath)
                 QSet<QString> seenWords;
                 QString currentWord;
 
-                for (int i = 0; i < content.size(); ++i) {
-                    QChar c = content[i];
-                    if (c.isLetterOrNumber()) {
+                for (int i = 0; i <= content.size(); ++i) {
+                    QChar c = (i < content.size()) ? content[i] : QChar();
+                    if (i < content.size() && c.isLetterOrNumber()) {
                         currentWord.append(c);
                     } else {
                         if (currentWord.size() >= 3 && currentWord.size() <= 64) {
                             QString lower = currentWord.toLower();
                             if (!seenWords.contains(lower)) {
                                 seenWords.insert(lower);
-                                QByteArray wordUtf8 = lower.toUtf8();
-                                baloo_index_add(s_index, wordUtf8.constData(),
-                                                pathUtf8.constData(), 40);
+                                hits->append({ lower.toUtf8(), 40 });
                             }
                         }
                         currentWord.clear();
                     }
                 }
-
-                /* Handle last word */
-                if (currentWord.size() >= 3 && currentWord.size() <= 64) {
-                    QString lower = currentWord.toLower();
-                    if (!seenWords.contains(lower)) {
-                        QByteArray wordUtf8 = lower.toUtf8();
-                        baloo_index_add(s_index, wordUtf8.constData(),
-                                        pathUtf8.constData(), 40);
-                    }
-                }
             }
         }
     }
+}
+
+/* Apply one file's token batch to the index and update counters.
+ * Returns true if the auto-save threshold was crossed. */
+static bool applyTokens(const QString &filePath, const QVector<WordHit> &hits)
+{
+    QByteArray pathUtf8 = filePath.toUtf8();
+    QMutexLocker lock(&s_indexLock);
+
+    if (!s_index)
+        return false;
+
+    for (const WordHit &hit : hits)
+        baloo_index_add(s_index, hit.word.constData(),
+                        pathUtf8.constData(), hit.relevance);
 
     s_filesProcessed++;
     s_filesSinceLastSave++;
+
+    return s_filesSinceLastSave >= AUTOSAVE_FILE_COUNT ||
+           (s_lastSaveTimer.isValid() &&
+            s_lastSaveTimer.elapsed() >= AUTOSAVE_INTERVAL_MS);
+}
+
+static void autoSave()
+{
+    QMutexLocker lock(&s_indexLock);
+
+    if (!s_index || s_indexPath.isEmpty())
+        return;
+
+    baloo_index_save(s_index, s_indexPath.toUtf8().constData());
+    s_filesSinceLastSave = 0;
+    s_lastSaveTimer.restart();
+    qDebug("Baloo: auto-saved index (%llu files)",
+           static_cast<unsigned long long>(s_filesProcessed));
+}
+
+static void indexSingleFile(const QString &filePath)
+{
+    QVector<WordHit> hits;
+
+    collectFileTokens(filePath, &hits);
+    if (applyTokens(filePath, hits))
+        autoSave();
 }
 
 /* ========================================================================= */
 /* Crawler                                                                   */
 /* ========================================================================= */
 
-static void processCrawlBatch()
+/*
+ * Directory-reader thread: breadth-first walk of the crawl root,
+ * feeding file paths to the extractor workers through the ring.
+ *
+ * Entries come from readdir() and are classified by d_type, so the
+ * common case needs zero per-entry stat syscalls -- one getdents
+ * batch returns the names and types of a whole directory.  Only
+ * DT_UNKNOWN entries (filesystems without type info) fall back to
+ * fstatat.
+ */
+static void crawlReaderMain(const QString &rootPath)
 {
-    if (!s_crawlActive || s_crawlQueue.isEmpty()) {
-        if (s_crawlActive) {
-            s_crawlActive = false;
-            s_state = BALOO_IDLE;
+    QQueue<QString> dirs;
+    dirs.enqueue(rootPath);
 
-            /* Save index after crawl completes */
-            if (s_index && !s_indexPath.isEmpty()) {
-                baloo_index_save(s_index, s_indexPath.toUtf8().constData());
+    while (!dirs.isEmpty() && !s_crawlAbort.loadAcquire()) {
+        QString dirPath = dirs.dequeue();
+
+        if (isHidden(dirPath) || isExcluded(dirPath))
+            continue;
+
+        QByteArray dirUtf8 = dirPath.toUtf8();
+        DIR *dp = opendir(dirUtf8.constData());
+        if (!dp)
+            continue;
+
+        struct dirent *de;
+        while ((de = readdir(dp)) != nullptr) {
+            if (s_crawlAbort.loadAcquire())
+                break;
+            if (de->d_name[0] == '.')
+                continue;   /* Hidden entries and . / .. */
+
+            QString entryPath = dirPath + QLatin1Char('/') +
+                                QString::fromUtf8(de->d_name);
+
+            unsigned char type = de->d_type;
+            if (type == DT_UNKNOWN) {
+                struct stat st;
+                if (fstatat(dirfd(dp), de->d_name, &st,
+                            AT_SYMLINK_NOFOLLOW) != 0)
+                    continue;
+                if (S_ISDIR(st.st_mode))
+                    type = DT_DIR;
+                else if (S_ISREG(st.st_mode))
+                    type = DT_REG;
             }
 
-            qDebug("Baloo: crawl complete -- %llu files indexed",
-                   static_cast<unsigned long long>(s_filesProcessed));
+            if (type == DT_DIR) {
+                if (!isExcluded(entryPath))
+                    dirs.enqueue(entryPath);
+            } else if (type == DT_REG) {
+                s_crawlRing.push(entryPath, s_crawlAbort);
+            }
+            /* Symlinks and specials are skipped, as before */
         }
-        return;
+
+        closedir(dp);
     }
 
-    int processed = 0;
+    s_readerDone.storeRelease(1);
+}
 
-    while (!s_crawlQueue.isEmpty() && processed < CRAWL_BATCH_SIZE) {
-        QString dirPath = s_crawlQueue.dequeue();
+/*
+ * Content-extractor worker: pops file paths from the ring, reads and
+ * tokenizes them outside any lock, and applies each batch to the
+ * index in one short critical section.  The last worker out finishes
+ * the crawl (final save + state reset).
+ */
+static void crawlWorkerMain()
+{
+    QString path;
 
-        if (isHidden(dirPath) || isExcluded(dirPath))
-            continue;
+    for (;;) {
+        if (s_crawlRing.tryPop(&path)) {
+            QVector<WordHit> hits;
 
-        QDir dir(dirPath);
-        if (!dir.exists() || !dir.isReadable())
+            collectFileTokens(path, &hits);
+            if (applyTokens(path, hits))
+                autoSave();
             continue;
+        }
 
-        QFileInfoList entries = dir.entryInfoList(
-            QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks);
-
-        for (const QFileInfo &fi : entries) {
-            if (fi.isDir()) {
-                QString subPath = fi.absoluteFilePath();
-                if (!isHidden(subPath) && !isExcluded(subPath))
-                    s_crawlQueue.enqueue(subPath);
-            } else if (fi.isFile()) {
-                indexSingleFile(fi.absoluteFilePath());
-                ++processed;
-            }
+        if (s_crawlAbort.loadAcquire())
+            break;
+        if (s_readerDone.loadAcquire()) {
+            /* Re-check: the reader may have pushed between our pop
+             * and its done flag */
+            if (!s_crawlRing.tryPop(&path))
+                break;
+
+            QVector<WordHit> hits;
+            collectFileTokens(path, &hits);
+            if (applyTokens(path, hits))
+                autoSave();
+            continue;
         }
+
+        QThread::yieldCurrentThread();
     }
 
-    /* Auto-save check */
-    if (s_filesSinceLastSave >= AUTOSAVE_FILE_COUNT ||
-        (s_lastSaveTimer.isValid() && s_lastSaveTimer.elapsed() >= AUTOSAVE_INTERVAL_MS)) {
-        if (s_index && !s_indexPath.isEmpty()) {
-            baloo_index_save(s_index, s_indexPath.toUtf8().constData());
-            s_filesSinceLastSave = 0;
-            s_lastSaveTimer.restart();
-            qDebug("Baloo: auto-saved index (%llu files)",
-                   static_cast<unsigned long long>(s_filesProcessed));
+    if (s_workersLeft.fetchAndSubOrdered(1) == 1 &&
+        !s_crawlAbort.loadAcquire()) {
+        /* Last worker: finish the crawl */
+        {
+            QMutexLocker lock(&s_indexLock);
+            if (s_index && !s_indexPath.isEmpty())
+                baloo_index_save(s_index, s_indexPath.toUtf8().constData());
         }
+
+        s_crawlActive = false;
+        s_state = BALOO_IDLE;
+        qDebug("Baloo: crawl complete -- %llu files indexed",
+               static_cast<unsigned long long>(s_filesProcessed));
+    }
+}
+
+/* Join and delete any previous crawl threads */
+static void reapCrawlThreads()
+{
+    if (s_readerThread) {
+        s_readerThread->wait();
+        delete s_readerThread;
+        s_readerThread = nullptr;
+    }
+    for (QThread *worker : s_workerThreads) {
+        worker->wait();
+        delete worker;
     }
+    s_workerThreads.clear();
+}
+
+/* Spin up the reader + worker pipeline over the given root */
+static void startCrawlPipeline(const QString &rootPath)
+{
+    reapCrawlThreads();
+
+    s_crawlRing.reset();
+    s_crawlAbort.storeRelease(0);
+    s_readerDone.storeRelease(0);
+
+    const int workers = qMax(2, QThread::idealThreadCount() - 1);
+    s_workersLeft.storeRelease(workers);
+
+    s_crawlActive = true;
+    s_state = BALOO_CRAWLING;
 
-    /* Schedule next batch (yield to event loop) */
-    QTimer::singleShot(0, processCrawlBatch);
+    s_readerThread = QThread::create([rootPath]() {
+        crawlReaderMain(rootPath);
+    });
+    s_readerThread->setObjectName(QStringLiteral("baloo-reader"));
+    s_readerThread->start();
+
+    for (int i = 0; i < workers; ++i) {
+        QThread *worker = QThread::create([]() { crawlWorkerMain(); });
+        worker->setObjectName(QStringLiteral("baloo-extract-%1").arg(i));
+        worker->start();
+        s_workerThreads.append(worker);
+    }
+
+    qDebug("Baloo: crawl pipeline started (1 reader, %d extractors)",
+           workers);
 }
 
 /* ========================================================================= */
@@ -383,17 +605,17 @@ static void processInotifyEvents()
                             indexSingleFile(filePath);
                             qDebug("Baloo: re-indexed %s", qPrintable(filePath));
                         } else if (fi.isDir()) {
-                            /* New directory: add watch and crawl */
+                            /* New directory: add watch and crawl its
+                             * subtree with the pipeline when idle (an
+                             * active crawl will pick it up if it is
+                             * under the current root) */
                             addInotifyWatch(filePath);
-                            s_crawlQueue.enqueue(filePath);
-                            if (!s_crawlActive) {
-                                s_crawlActive = true;
-                                s_state = BALOO_CRAWLING;
-                                QTimer::singleShot(0, processCrawlBatch);
-                            }
+                            if (!s_crawlActive)
+                                startCrawlPipeline(filePath);
                         }
                     } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
                         /* Remove from index */
+                        QMutexLocker lock(&s_indexLock);
                         if (s_index) {
                             QByteArray pathUtf8 = filePath.toUtf8();
                             baloo_index_remove_file(s_index, pathUtf8.constData());
@@ -477,9 +699,10 @@ void baloo_destroy(void)
     if (!Baloo::s_index)
         return;
 
-    /* Stop crawl */
+    /* Stop crawl and join the pipeline */
+    Baloo::s_crawlAbort.storeRelease(1);
+    Baloo::reapCrawlThreads();
     Baloo::s_crawlActive = false;
-    Baloo::s_crawlQueue.clear();
 
     /* Save index */
     if (!Baloo::s_indexPath.isEmpty())
@@ -520,10 +743,6 @@ void baloo_start_crawl(const char *root_path)
         return;
     }
 
-    Baloo::s_crawlQueue.clear();
-    Baloo::s_crawlQueue.enqueue(root);
-    Baloo::s_crawlActive = true;
-    Baloo::s_state = BALOO_CRAWLING;
     Baloo::s_filesProcessed = 0;
 
     qDebug("Baloo: starting crawl from %s", root_path);
@@ -531,8 +750,8 @@ void baloo_start_crawl(const char *root_path)
     /* Add inotify watch for root */
     Baloo::addInotifyWatch(root);
 
-    /* Begin processing */
-    QTimer::singleShot(0, Baloo::processCrawlBatch);
+    /* Spin up the reader + extractor pipeline */
+    Baloo::startCrawlPipeline(root);
 }
 
 void baloo_stop_crawl(void)
@@ -540,8 +759,10 @@ void baloo_stop_crawl(void)
     if (!Baloo::s_crawlActive)
         return;
 
+    Baloo::s_crawlAbort.storeRelease(1);
+    Baloo::reapCrawlThreads();
+
     Baloo::s_crawlActive = false;
-    Baloo::s_crawlQueue.clear();
     Baloo::s_state = BALOO_IDLE;
 
     qDebug("Baloo: crawl stopped (%llu files processed)",
@@ -558,10 +779,15 @@ int baloo_query(const char *query_string,
 
     Q_UNUSED(type);  /* All query types use the same unified index for now */
 
-    /* Delegate to index search */
+    /* Delegate to index search (under the index lock: extractor
+     * workers may be adding concurrently) */
     BalooIndexResult *indexResults = new BalooIndexResult[max_results];
-    int count = baloo_index_search(Baloo::s_index, query_string,
+    int count;
+    {
+        QMutexLocker lock(&Baloo::s_indexLock);
+        count = baloo_index_search(Baloo::s_index, query_string,
                                    indexResults, max_results);
+    }
 
     /* Convert index results to full BalooResults with file metadata */
     int resultCount = 0;
@@ -633,6 +859,7 @@ BalooIndexState baloo_get_state(void)
 
 uint64_t baloo_get_indexed_count(void)
 {
+    QMutexLocker lock(&Baloo::s_indexLock);
     if (!Baloo::s_index)
         return 0;
     return baloo_index_get_count(Baloo::s_index);
@@ -696,6 +923,7 @@ void baloo_index_file(const char *path)
 
 void baloo_remove_file(const char *path)
 {
+    QMutexLocker lock(&Baloo::s_indexLock);
     if (!Baloo::s_index || !path)
         return;
     baloo_index_remove_file(Baloo::s_index, path);
@@ -6,16 +6,29 @@
  *
  * Inverted index implementation for the Baloo file indexer.
  *
- * Data structures:
- *   - Word map:    hash map from word (string) -> vector of (path, relevance)
- *   - Trigram map:  hash map from 3-char sequence -> set of words
+ * Storage is log-structured: adds go to an in-memory delta (hash maps
+ * with a trigram sidecar); baloo_index_save() writes only the delta
+ * as a new append-only segment instead of rewriting the whole index,
+ * so save cost is proportional to what changed since the last save.
  *
- * Binary format (BLIX v1):
- *   Header:   "BLIX" (4 bytes), version (uint32), word_count (uint32)
- *   Per word: word_len (uint16), word_bytes, path_count (uint32),
- *             (path_len (uint16), path_bytes, relevance (int32)) * count
+ * Segments (BLX2) are sorted, mmap-able, and searched in place:
  *
- * Compaction is triggered when deletion count exceeds 20% of entries.
+ *   Blx2Header  { "BLX2", version, termCount, pathCount,
+ *                 termTableOff, pathTableOff, stringsOff,
+ *                 postingsOff, fileSize }
+ *   term table: Blx2Term { strOff, strLen, postOff, postCount },
+ *               sorted by term bytes -> binary search / prefix ranges
+ *   path table: Blx2Path { strOff, strLen }  (paths deduplicated)
+ *   strings:    concatenated UTF-8 bytes
+ *   postings:   Blx2Posting { pathId, relevance }
+ *
+ * Deletions are tombstones (a side file of removed paths) filtered at
+ * search time.  When the segment count passes a threshold, a merge
+ * thread folds all segments plus tombstones into one compacted
+ * segment in the background.
+ *
+ * The legacy whole-index BLIX v1 file is still read on load (into the
+ * delta) so existing indexes migrate on their next save.
  */
 
 #include "baloo-veridian-index.h"
@@ -24,14 +37,69 @@
 #include <QDir>
 #include <QFile>
 #include <QHash>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QSet>
 #include <QString>
+#include <QStringList>
+#include <QThread>
 #include <QVector>
 #include <QDataStream>
 
 #include <string.h>
 #include <algorithm>
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/* ========================================================================= */
+/* On-disk structures (BLX2)                                                 */
+/* ========================================================================= */
+
+static const char BLX2_MAGIC[4] = { 'B', 'L', 'X', '2' };
+static const uint32_t BLX2_VERSION = 2;
+
+struct Blx2Header {
+    char     magic[4];
+    uint32_t version;
+    uint32_t termCount;
+    uint32_t pathCount;
+    uint32_t termTableOff;
+    uint32_t pathTableOff;
+    uint32_t stringsOff;
+    uint32_t postingsOff;
+    uint32_t fileSize;
+};
+
+struct Blx2Term {
+    uint32_t strOff;
+    uint16_t strLen;
+    uint16_t pad;
+    uint32_t postOff;       /* Index into posting array */
+    uint32_t postCount;
+};
+
+struct Blx2Path {
+    uint32_t strOff;
+    uint16_t strLen;
+    uint16_t pad;
+};
+
+struct Blx2Posting {
+    uint32_t pathId;
+    int32_t  relevance;
+};
+
+/* Legacy whole-index format */
+static const char BLIX_MAGIC[4] = { 'B', 'L', 'I', 'X' };
+static const uint32_t BLIX_VERSION = 1;
+
+/* Segments before a background merge is scheduled */
+static const int MERGE_THRESHOLD = 8;
+
 /* ========================================================================= */
 /* Internal structures                                                       */
 /* ========================================================================= */
@@ -41,27 +109,47 @@ struct IndexEntry {
     int relevance;
 };
 
+/* One mmap'd read-only segment */
+struct Segment {
+    QString  file;
+    int      fd = -1;
+    uint8_t *base = nullptr;
+    size_t   size = 0;
+
+    const Blx2Header  *hdr() const { return reinterpret_cast<const Blx2Header *>(base); }
+    const Blx2Term    *terms() const { return reinterpret_cast<const Blx2Term *>(base + hdr()->termTableOff); }
+    const Blx2Path    *paths() const { return reinterpret_cast<const Blx2Path *>(base + hdr()->pathTableOff); }
+    const char        *strings() const { return reinterpret_cast<const char *>(base + hdr()->stringsOff); }
+    const Blx2Posting *postings() const { return reinterpret_cast<const Blx2Posting *>(base + hdr()->postingsOff); }
+
+    QByteArray termBytes(const Blx2Term &t) const
+    { return QByteArray::fromRawData(strings() + t.strOff, t.strLen); }
+    QByteArray pathBytes(uint32_t id) const
+    { const Blx2Path &p = paths()[id]; return QByteArray::fromRawData(strings() + p.strOff, p.strLen); }
+};
+
 struct BalooIndex {
-    /* Word -> list of (path, relevance) entries */
+    /* In-memory delta: adds since the last save */
     QHash<QString, QVector<IndexEntry>> wordMap;
-
-    /* Trigram -> set of words containing that trigram */
     QHash<QString, QSet<QString>> trigramMap;
 
-    /* Set of all indexed file paths */
+    /* mmap'd segments, oldest first (guarded by segLock) */
+    QVector<Segment> segments;
+    mutable QMutex segLock;
+    uint32_t nextSeq = 0;
+
+    /* Tombstones: paths removed since their segments were written */
+    QSet<QString> deletedPaths;
+
+    /* All live paths (for get_count) */
     QSet<QString> allPaths;
 
-    /* Compaction tracking */
-    int deletionCount;
-    int totalEntries;
+    int totalEntries = 0;
 
-    /* Storage path */
     QString storagePath;
-};
 
-static const char BLIX_MAGIC[4] = { 'B', 'L', 'I', 'X' };
-static const uint32_t BLIX_VERSION = 1;
-static const float COMPACTION_THRESHOLD = 0.20f;
+    QThread *mergeThread = nullptr;
+};
 
 /* ========================================================================= */
 /* Trigram extraction                                                        */
@@ -122,114 +210,334 @@ static QStringList tokenize(const QString &text)
 }
 
 /* ========================================================================= */
-/* Compaction                                                                */
+/* Segment I/O                                                               */
 /* ========================================================================= */
 
-static void compactIndex(BalooIndex *index)
+static void segmentClose(Segment &seg)
 {
-    if (index->totalEntries == 0)
-        return;
+    if (seg.base)
+        munmap(seg.base, seg.size);
+    if (seg.fd >= 0)
+        close(seg.fd);
+    seg.base = nullptr;
+    seg.fd = -1;
+    seg.size = 0;
+}
 
-    float ratio = static_cast<float>(index->deletionCount) /
-                  static_cast<float>(index->totalEntries);
-    if (ratio < COMPACTION_THRESHOLD)
-        return;
+static bool segmentOpen(Segment &seg, const QString &file)
+{
+    QByteArray fname = QFile::encodeName(file);
+
+    seg.file = file;
+    seg.fd = open(fname.constData(), O_RDONLY);
+    if (seg.fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(seg.fd, &st) != 0 ||
+        static_cast<size_t>(st.st_size) < sizeof(Blx2Header)) {
+        segmentClose(seg);
+        return false;
+    }
+    seg.size = static_cast<size_t>(st.st_size);
+
+    seg.base = static_cast<uint8_t *>(
+        mmap(nullptr, seg.size, PROT_READ, MAP_PRIVATE, seg.fd, 0));
+    if (seg.base == MAP_FAILED) {
+        seg.base = nullptr;
+        segmentClose(seg);
+        return false;
+    }
 
-    qDebug("Baloo/Index: compacting (deletions %d / total %d = %.1f%%)",
-           index->deletionCount, index->totalEntries, ratio * 100.0f);
-
-    /* Remove empty word entries */
-    QHash<QString, QVector<IndexEntry>>::iterator it = index->wordMap.begin();
-    while (it != index->wordMap.end()) {
-        if (it.value().isEmpty()) {
-            /* Remove trigram references */
-            QSet<QString> trigrams = extractTrigrams(it.key());
-            for (const QString &tri : trigrams) {
-                auto triIt = index->trigramMap.find(tri);
-                if (triIt != index->trigramMap.end()) {
-                    triIt->remove(it.key());
-                    if (triIt->isEmpty())
-                        index->trigramMap.erase(triIt);
-                }
+    if (memcmp(seg.hdr()->magic, BLX2_MAGIC, 4) != 0 ||
+        seg.hdr()->version != BLX2_VERSION ||
+        seg.hdr()->fileSize != seg.size) {
+        qWarning("Baloo/Index: bad segment %s", qPrintable(file));
+        segmentClose(seg);
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * Write a sorted word map as one BLX2 segment.  Returns the file path
+ * written, or an empty string on error.
+ */
+static QString segmentWrite(const QString &dirPath, uint32_t seq,
+                            const QMap<QString, QVector<IndexEntry>> &sorted)
+{
+    QString file = dirPath +
+                   QStringLiteral("/baloo-seg-%1.blx2")
+                       .arg(seq, 8, 10, QLatin1Char('0'));
+
+    /* Deduplicate paths */
+    QHash<QString, uint32_t> pathIds;
+    QVector<QByteArray> pathList;
+    uint32_t postingTotal = 0;
+
+    for (auto it = sorted.constBegin(); it != sorted.constEnd(); ++it) {
+        for (const IndexEntry &e : it.value()) {
+            if (!pathIds.contains(e.path)) {
+                pathIds.insert(e.path, static_cast<uint32_t>(pathList.size()));
+                pathList.append(e.path.toUtf8());
             }
-            it = index->wordMap.erase(it);
-        } else {
-            ++it;
+            postingTotal++;
         }
     }
 
-    /* Recount */
-    index->totalEntries = 0;
-    for (auto it = index->wordMap.constBegin(); it != index->wordMap.constEnd(); ++it)
-        index->totalEntries += it.value().size();
-    index->deletionCount = 0;
+    /* Assemble the regions */
+    QByteArray strings;
+    QVector<Blx2Term> termTable;
+    QVector<Blx2Path> pathTable;
+    QVector<Blx2Posting> postingList;
+
+    termTable.reserve(sorted.size());
+    pathTable.reserve(pathList.size());
+    postingList.reserve(static_cast<int>(postingTotal));
+
+    for (const QByteArray &p : pathList) {
+        Blx2Path bp;
+        bp.strOff = static_cast<uint32_t>(strings.size());
+        bp.strLen = static_cast<uint16_t>(p.size());
+        bp.pad = 0;
+        pathTable.append(bp);
+        strings.append(p);
+    }
+
+    for (auto it = sorted.constBegin(); it != sorted.constEnd(); ++it) {
+        QByteArray termUtf8 = it.key().toUtf8();
+        Blx2Term t;
+
+        t.strOff = static_cast<uint32_t>(strings.size());
+        t.strLen = static_cast<uint16_t>(termUtf8.size());
+        t.pad = 0;
+        t.postOff = static_cast<uint32_t>(postingList.size());
+        t.postCount = static_cast<uint32_t>(it.value().size());
+        termTable.append(t);
+        strings.append(termUtf8);
+
+        for (const IndexEntry &e : it.value()) {
+            Blx2Posting post;
+            post.pathId = pathIds.value(e.path);
+            post.relevance = e.relevance;
+            postingList.append(post);
+        }
+    }
+
+    Blx2Header hdr;
+    memcpy(hdr.magic, BLX2_MAGIC, 4);
+    hdr.version = BLX2_VERSION;
+    hdr.termCount = static_cast<uint32_t>(termTable.size());
+    hdr.pathCount = static_cast<uint32_t>(pathTable.size());
+    hdr.termTableOff = sizeof(Blx2Header);
+    hdr.pathTableOff = hdr.termTableOff +
+                       static_cast<uint32_t>(termTable.size() * sizeof(Blx2Term));
+    hdr.stringsOff = hdr.pathTableOff +
+                     static_cast<uint32_t>(pathTable.size() * sizeof(Blx2Path));
+    hdr.postingsOff = hdr.stringsOff + static_cast<uint32_t>(strings.size());
+    hdr.fileSize = hdr.postingsOff +
+                   static_cast<uint32_t>(postingList.size() * sizeof(Blx2Posting));
+
+    /* Write via a temp file then rename for crash safety */
+    QString tmp = file + QStringLiteral(".tmp");
+    QFile out(tmp);
+    if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning("Baloo/Index: cannot write %s", qPrintable(tmp));
+        return QString();
+    }
+
+    out.write(reinterpret_cast<const char *>(&hdr), sizeof(hdr));
+    out.write(reinterpret_cast<const char *>(termTable.constData()),
+              termTable.size() * sizeof(Blx2Term));
+    out.write(reinterpret_cast<const char *>(pathTable.constData()),
+              pathTable.size() * sizeof(Blx2Path));
+    out.write(strings);
+    out.write(reinterpret_cast<const char *>(postingList.constData()),
+              postingList.size() * sizeof(Blx2Posting));
+    out.close();
+
+    if (!QFile::rename(tmp, file)) {
+        QFile::remove(tmp);
+        return QString();
+    }
 
-    qDebug("Baloo/Index: compaction complete (%d entries remain)",
-           index->totalEntries);
+    return file;
 }
 
 /* ========================================================================= */
-/* C API implementation                                                      */
+/* Tombstone side file                                                       */
 /* ========================================================================= */
 
-extern "C" {
+static QString tombstonePath(const QString &dirPath)
+{
+    return dirPath + QStringLiteral("/baloo-deleted.list");
+}
 
-BalooIndex *baloo_index_create(const char *storage_path)
+static void tombstoneAppend(const QString &dirPath, const QString &path)
 {
-    BalooIndex *index = new BalooIndex;
-    index->deletionCount = 0;
-    index->totalEntries = 0;
-    index->storagePath = QString::fromUtf8(storage_path);
+    QFile f(tombstonePath(dirPath));
+    if (f.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        f.write(path.toUtf8());
+        f.write("\n", 1);
+    }
+}
 
-    qDebug("Baloo/Index: created new empty index at %s", storage_path);
-    return index;
+static QSet<QString> tombstoneLoad(const QString &dirPath)
+{
+    QSet<QString> dead;
+    QFile f(tombstonePath(dirPath));
+
+    if (f.open(QIODevice::ReadOnly)) {
+        while (!f.atEnd()) {
+            QByteArray line = f.readLine();
+            while (line.endsWith('\n') || line.endsWith('\r'))
+                line.chop(1);
+            if (!line.isEmpty())
+                dead.insert(QString::fromUtf8(line));
+        }
+    }
+    return dead;
 }
 
-BalooIndex *baloo_index_load(const char *storage_path)
+/* ========================================================================= */
+/* Segment merging                                                           */
+/* ========================================================================= */
+
+/*
+ * Fold every current segment (minus tombstoned paths) into one
+ * compacted segment.  Runs on the merge thread; the segment list is
+ * swapped under segLock only once the new segment is on disk.
+ */
+static void mergeSegments(BalooIndex *index)
 {
-    QString path = QString::fromUtf8(storage_path) +
-                   QStringLiteral("/baloo-index.blix");
+    QVector<Segment> old;
+    QSet<QString> dead;
+    uint32_t seq;
 
-    QFile file(path);
-    if (!file.open(QIODevice::ReadOnly)) {
-        qDebug("Baloo/Index: no saved index at %s", qPrintable(path));
-        return nullptr;
+    {
+        QMutexLocker lock(&index->segLock);
+        if (index->segments.size() < 2)
+            return;
+        old = index->segments;     /* Shallow copy: mappings stay valid */
+        dead = index->deletedPaths;
+        seq = index->nextSeq++;
+    }
+
+    /* Accumulate merged postings, newest segment winning on relevance */
+    QMap<QString, QVector<IndexEntry>> merged;
+    QHash<QString, QHash<QString, int>> seen;   /* term -> path -> idx */
+
+    for (const Segment &seg : old) {
+        const Blx2Header *h = seg.hdr();
+
+        for (uint32_t t = 0; t < h->termCount; ++t) {
+            const Blx2Term &term = seg.terms()[t];
+            QString word = QString::fromUtf8(seg.termBytes(term));
+            QVector<IndexEntry> &entries = merged[word];
+            QHash<QString, int> &index_of = seen[word];
+
+            for (uint32_t p = 0; p < term.postCount; ++p) {
+                const Blx2Posting &post = seg.postings()[term.postOff + p];
+                QString path = QString::fromUtf8(seg.pathBytes(post.pathId));
+
+                if (dead.contains(path))
+                    continue;
+
+                auto it = index_of.constFind(path);
+                if (it != index_of.constEnd()) {
+                    if (entries[it.value()].relevance < post.relevance)
+                        entries[it.value()].relevance = post.relevance;
+                } else {
+                    index_of.insert(path, entries.size());
+                    entries.append({ path, post.relevance });
+                }
+            }
+
+            if (entries.isEmpty()) {
+                merged.remove(word);
+                seen.remove(word);
+            }
+        }
+    }
+
+    QString file = segmentWrite(index->storagePath, seq, merged);
+    if (file.isEmpty())
+        return;
+
+    Segment fresh;
+    if (!segmentOpen(fresh, file)) {
+        QFile::remove(file);
+        return;
     }
 
+    {
+        QMutexLocker lock(&index->segLock);
+        QVector<Segment> replaced = index->segments;
+        index->segments.clear();
+        index->segments.append(fresh);
+
+        for (Segment &seg : replaced) {
+            QString path = seg.file;
+            segmentClose(seg);
+            QFile::remove(path);
+        }
+
+        /* Tombstones are folded in; reset the side file */
+        index->deletedPaths.clear();
+        QFile::remove(tombstonePath(index->storagePath));
+    }
+
+    qDebug("Baloo/Index: merged %d segments into %s",
+           old.size(), qPrintable(file));
+}
+
+static void scheduleMerge(BalooIndex *index)
+{
+    if (index->mergeThread) {
+        if (!index->mergeThread->isFinished())
+            return;     /* A merge is already running */
+        index->mergeThread->wait();
+        delete index->mergeThread;
+        index->mergeThread = nullptr;
+    }
+
+    index->mergeThread = QThread::create([index]() { mergeSegments(index); });
+    index->mergeThread->start();
+}
+
+/* ========================================================================= */
+/* Legacy BLIX v1 loader (migrates into the delta)                           */
+/* ========================================================================= */
+
+static bool loadLegacyIndex(BalooIndex *index, const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
     QDataStream stream(&file);
     stream.setByteOrder(QDataStream::LittleEndian);
 
-    /* Read and verify header */
     char magic[4];
     stream.readRawData(magic, 4);
-    if (memcmp(magic, BLIX_MAGIC, 4) != 0) {
-        qWarning("Baloo/Index: invalid magic in %s", qPrintable(path));
-        return nullptr;
-    }
+    if (memcmp(magic, BLIX_MAGIC, 4) != 0)
+        return false;
 
     uint32_t version;
     stream >> version;
-    if (version != BLIX_VERSION) {
-        qWarning("Baloo/Index: unsupported version %u in %s",
-                 version, qPrintable(path));
-        return nullptr;
-    }
+    if (version != BLIX_VERSION)
+        return false;
 
     uint32_t wordCount;
     stream >> wordCount;
 
-    BalooIndex *index = new BalooIndex;
-    index->deletionCount = 0;
-    index->totalEntries = 0;
-    index->storagePath = QString::fromUtf8(storage_path);
-
     for (uint32_t w = 0; w < wordCount; ++w) {
         if (stream.atEnd())
             break;
 
         uint16_t wordLen;
         stream >> wordLen;
-
         QByteArray wordBytes(wordLen, '\0');
         stream.readRawData(wordBytes.data(), wordLen);
         QString word = QString::fromUtf8(wordBytes);
@@ -243,7 +551,6 @@ BalooIndex *baloo_index_load(const char *storage_path)
         for (uint32_t p = 0; p < pathCount; ++p) {
             uint16_t pathLen;
             stream >> pathLen;
-
             QByteArray pathBytes(pathLen, '\0');
             stream.readRawData(pathBytes.data(), pathLen);
 
@@ -254,21 +561,86 @@ BalooIndex *baloo_index_load(const char *storage_path)
             entry.path = QString::fromUtf8(pathBytes);
             entry.relevance = relevance;
             entries.append(entry);
-
             index->allPaths.insert(entry.path);
         }
 
         index->wordMap.insert(word, entries);
         index->totalEntries += entries.size();
 
-        /* Rebuild trigram map */
         QSet<QString> trigrams = extractTrigrams(word);
         for (const QString &tri : trigrams)
             index->trigramMap[tri].insert(word);
     }
 
-    qDebug("Baloo/Index: loaded %u words, %d entries from %s",
-           wordCount, index->totalEntries, qPrintable(path));
+    qDebug("Baloo/Index: migrated legacy index (%u words) from %s",
+           wordCount, qPrintable(path));
+    return true;
+}
+
+/* ========================================================================= */
+/* C API implementation                                                      */
+/* ========================================================================= */
+
+extern "C" {
+
+BalooIndex *baloo_index_create(const char *storage_path)
+{
+    BalooIndex *index = new BalooIndex;
+    index->storagePath = QString::fromUtf8(storage_path);
+
+    qDebug("Baloo/Index: created new empty index at %s", storage_path);
+    return index;
+}
+
+BalooIndex *baloo_index_load(const char *storage_path)
+{
+    QString dirPath = QString::fromUtf8(storage_path);
+    QDir dir(dirPath);
+
+    QStringList segFiles = dir.entryList(
+        QStringList() << QStringLiteral("baloo-seg-*.blx2"),
+        QDir::Files, QDir::Name);
+
+    QString legacy = dirPath + QStringLiteral("/baloo-index.blix");
+    bool haveLegacy = QFile::exists(legacy);
+
+    if (segFiles.isEmpty() && !haveLegacy) {
+        qDebug("Baloo/Index: no saved index in %s", storage_path);
+        return nullptr;
+    }
+
+    BalooIndex *index = new BalooIndex;
+    index->storagePath = dirPath;
+
+    for (const QString &name : segFiles) {
+        Segment seg;
+
+        if (!segmentOpen(seg, dir.filePath(name)))
+            continue;
+
+        /* Track sequence numbers so new segments sort after */
+        uint32_t seq = name.mid(10, 8).toUInt();
+        if (seq >= index->nextSeq)
+            index->nextSeq = seq + 1;
+
+        /* Register live paths */
+        for (uint32_t p = 0; p < seg.hdr()->pathCount; ++p)
+            index->allPaths.insert(QString::fromUtf8(seg.pathBytes(p)));
+
+        index->segments.append(seg);
+    }
+
+    index->deletedPaths = tombstoneLoad(dirPath);
+    for (const QString &dead : index->deletedPaths)
+        index->allPaths.remove(dead);
+
+    /* Legacy whole-index file: pull into the delta; the next save
+     * writes it out as a segment and retires the old file */
+    if (haveLegacy && loadLegacyIndex(index, legacy))
+        QFile::remove(legacy);
+
+    qDebug("Baloo/Index: loaded %d segments (%d tombstones) from %s",
+           index->segments.size(), index->deletedPaths.size(), storage_path);
     return index;
 }
 
@@ -279,42 +651,51 @@ int baloo_index_save(BalooIndex *index, const char *storage_path)
 
     QString dirPath = QString::fromUtf8(storage_path);
     QDir().mkpath(dirPath);
+    index->storagePath = dirPath;
 
-    QString path = dirPath + QStringLiteral("/baloo-index.blix");
-    QFile file(path);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-        qWarning("Baloo/Index: cannot write %s", qPrintable(path));
-        return -1;
+    if (index->wordMap.isEmpty())
+        return 0;   /* Nothing changed since the last save */
+
+    /* Sort the delta for the segment's term table */
+    QMap<QString, QVector<IndexEntry>> sorted;
+    for (auto it = index->wordMap.constBegin();
+         it != index->wordMap.constEnd(); ++it)
+        sorted.insert(it.key(), it.value());
+
+    uint32_t seq;
+    {
+        QMutexLocker lock(&index->segLock);
+        seq = index->nextSeq++;
     }
 
-    QDataStream stream(&file);
-    stream.setByteOrder(QDataStream::LittleEndian);
+    QString file = segmentWrite(dirPath, seq, sorted);
+    if (file.isEmpty())
+        return -1;
 
-    /* Header */
-    stream.writeRawData(BLIX_MAGIC, 4);
-    stream << BLIX_VERSION;
-    stream << static_cast<uint32_t>(index->wordMap.size());
-
-    /* Word entries */
-    for (auto it = index->wordMap.constBegin(); it != index->wordMap.constEnd(); ++it) {
-        const QString &word = it.key();
-        const QVector<IndexEntry> &entries = it.value();
-
-        QByteArray wordUtf8 = word.toUtf8();
-        stream << static_cast<uint16_t>(wordUtf8.size());
-        stream.writeRawData(wordUtf8.constData(), wordUtf8.size());
-
-        stream << static_cast<uint32_t>(entries.size());
-        for (const IndexEntry &entry : entries) {
-            QByteArray pathUtf8 = entry.path.toUtf8();
-            stream << static_cast<uint16_t>(pathUtf8.size());
-            stream.writeRawData(pathUtf8.constData(), pathUtf8.size());
-            stream << static_cast<int32_t>(entry.relevance);
-        }
+    Segment seg;
+    if (!segmentOpen(seg, file)) {
+        QFile::remove(file);
+        return -1;
     }
 
-    qDebug("Baloo/Index: saved %d words to %s",
-           index->wordMap.size(), qPrintable(path));
+    int segCount;
+    {
+        QMutexLocker lock(&index->segLock);
+        index->segments.append(seg);
+        segCount = index->segments.size();
+    }
+
+    /* Delta is durable now */
+    index->wordMap.clear();
+    index->trigramMap.clear();
+    index->totalEntries = 0;
+
+    qDebug("Baloo/Index: appended segment %s (%d total)",
+           qPrintable(file), segCount);
+
+    if (segCount > MERGE_THRESHOLD)
+        scheduleMerge(index);
+
     return 0;
 }
 
@@ -323,8 +704,16 @@ void baloo_index_destroy(BalooIndex *index)
     if (!index)
         return;
 
-    qDebug("Baloo/Index: destroying index (%d words, %d entries)",
-           index->wordMap.size(), index->totalEntries);
+    if (index->mergeThread) {
+        index->mergeThread->wait();
+        delete index->mergeThread;
+    }
+
+    for (Segment &seg : index->segments)
+        segmentClose(seg);
+
+    qDebug("Baloo/Index: destroying index (%d segments, %d delta words)",
+           index->segments.size(), index->wordMap.size());
     delete index;
 }
 
@@ -340,7 +729,13 @@ void baloo_index_add(BalooIndex *index, const char *word,
     if (w.isEmpty() || p.isEmpty())
         return;
 
-    /* Add to word map */
+    /* A re-added path is live again */
+    if (index->deletedPaths.remove(p)) {
+        /* Tombstone file is rewritten on the next merge; until then
+         * the in-memory set is authoritative */
+    }
+
+    /* Add to the delta word map */
     QVector<IndexEntry> &entries = index->wordMap[w];
 
     /* Avoid duplicate path entries for the same word -- update relevance */
@@ -371,25 +766,156 @@ void baloo_index_remove_file(BalooIndex *index, const char *file_path)
 
     QString p = QString::fromUtf8(file_path);
 
-    /* Scan all word entries and remove those referencing the path */
+    /* Drop from the delta */
     for (auto it = index->wordMap.begin(); it != index->wordMap.end(); ++it) {
         QVector<IndexEntry> &entries = it.value();
-        int before = entries.size();
 
         entries.erase(
             std::remove_if(entries.begin(), entries.end(),
                            [&p](const IndexEntry &e) { return e.path == p; }),
             entries.end());
+    }
+
+    /* Tombstone for the segments; merge folds it in later */
+    if (index->allPaths.remove(p)) {
+        index->deletedPaths.insert(p);
+        if (!index->storagePath.isEmpty())
+            tombstoneAppend(index->storagePath, p);
+    }
+}
+
+/* ----- Search helpers ----- */
+
+/*
+ * Prefix range over a segment's sorted term table: binary search for
+ * the first term >= qw, then walk while the prefix holds.
+ */
+static void searchSegment(const Segment &seg, const QByteArray &qw,
+                          const QSet<QString> &dead,
+                          QHash<QString, int> *pathScores)
+{
+    const Blx2Header *h = seg.hdr();
+    uint32_t lo = 0, hi = h->termCount;
+
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (seg.termBytes(seg.terms()[mid]) < qw)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    for (uint32_t t = lo; t < h->termCount; ++t) {
+        const Blx2Term &term = seg.terms()[t];
+        QByteArray bytes = seg.termBytes(term);
+
+        if (!bytes.startsWith(qw))
+            break;
+
+        int bonus = (bytes.size() == qw.size()) ? 20 : 10;
+
+        for (uint32_t p = 0; p < term.postCount; ++p) {
+            const Blx2Posting &post = seg.postings()[term.postOff + p];
+            QString path = QString::fromUtf8(seg.pathBytes(post.pathId));
+
+            if (dead.contains(path))
+                continue;
+
+            int score = post.relevance + bonus;
+            auto scoreIt = pathScores->find(path);
+            if (scoreIt != pathScores->end())
+                *scoreIt = qMax(*scoreIt, score);
+            else
+                pathScores->insert(path, score);
+        }
+    }
+
+    /* Substring pass: linear scan of the term dictionary in place.
+     * The mmap'd dictionary is compact and contiguous, so this stays
+     * cache-friendly; trigram acceleration applies to the delta only. */
+    for (uint32_t t = 0; t < h->termCount; ++t) {
+        const Blx2Term &term = seg.terms()[t];
+        QByteArray bytes = seg.termBytes(term);
+
+        if (bytes.startsWith(qw) || !bytes.contains(qw))
+            continue;   /* Prefix hits already scored above */
+
+        for (uint32_t p = 0; p < term.postCount; ++p) {
+            const Blx2Posting &post = seg.postings()[term.postOff + p];
+            QString path = QString::fromUtf8(seg.pathBytes(post.pathId));
+
+            if (dead.contains(path))
+                continue;
 
-        int removed = before - entries.size();
-        if (removed > 0)
-            index->deletionCount += removed;
+            int score = post.relevance;
+            auto scoreIt = pathScores->find(path);
+            if (scoreIt != pathScores->end())
+                *scoreIt = qMax(*scoreIt, score);
+            else
+                pathScores->insert(path, score);
+        }
     }
+}
+
+static void searchDelta(const BalooIndex *index, const QString &qw,
+                        QHash<QString, int> *pathScores)
+{
+    QSet<QString> matchingWords;
 
-    index->allPaths.remove(p);
+    /* 1. Direct word-prefix lookup */
+    for (auto it = index->wordMap.constBegin();
+         it != index->wordMap.constEnd(); ++it) {
+        if (it.key().startsWith(qw))
+            matchingWords.insert(it.key());
+    }
 
-    /* Compact if needed */
-    compactIndex(index);
+    /* 2. Trigram-based substring search */
+    QSet<QString> trigrams = extractTrigrams(qw);
+    if (!trigrams.isEmpty()) {
+        QSet<QString> candidates;
+        bool first = true;
+
+        for (const QString &tri : trigrams) {
+            auto triIt = index->trigramMap.constFind(tri);
+            if (triIt == index->trigramMap.constEnd()) {
+                candidates.clear();
+                break;
+            }
+            if (first) {
+                candidates = triIt.value();
+                first = false;
+            } else {
+                candidates.intersect(triIt.value());
+            }
+        }
+
+        /* Verify substring match (trigrams may have false positives) */
+        for (const QString &candidate : candidates) {
+            if (candidate.contains(qw))
+                matchingWords.insert(candidate);
+        }
+    }
+
+    for (const QString &matchWord : matchingWords) {
+        auto it = index->wordMap.constFind(matchWord);
+        if (it == index->wordMap.constEnd())
+            continue;
+
+        for (const IndexEntry &entry : it.value()) {
+            int bonus = 0;
+            if (matchWord == qw)
+                bonus = 20;  /* Exact word match bonus */
+            else if (matchWord.startsWith(qw))
+                bonus = 10;  /* Prefix match bonus */
+
+            int score = entry.relevance + bonus;
+            auto scoreIt = pathScores->find(entry.path);
+            if (scoreIt != pathScores->end())
+                *scoreIt = qMax(*scoreIt, score);
+            else
+                pathScores->insert(entry.path, score);
+        }
+    }
 }
 
 int baloo_index_search(BalooIndex *index, const char *query,
@@ -408,67 +934,17 @@ int baloo_index_search(BalooIndex *index, const char *query,
         queryWords.append(q);
     }
 
-    /* For each query word, find matching index words */
     QHash<QString, int> pathScores;  /* path -> aggregated relevance */
 
     for (const QString &qw : queryWords) {
-        QSet<QString> matchingWords;
-
-        /* 1. Direct word-prefix lookup */
-        for (auto it = index->wordMap.constBegin();
-             it != index->wordMap.constEnd(); ++it) {
-            if (it.key().startsWith(qw))
-                matchingWords.insert(it.key());
-        }
-
-        /* 2. Trigram-based substring search */
-        QSet<QString> trigrams = extractTrigrams(qw);
-        if (!trigrams.isEmpty()) {
-            QSet<QString> candidates;
-            bool first = true;
-
-            for (const QString &tri : trigrams) {
-                auto triIt = index->trigramMap.constFind(tri);
-                if (triIt == index->trigramMap.constEnd()) {
-                    candidates.clear();
-                    break;
-                }
-                if (first) {
-                    candidates = triIt.value();
-                    first = false;
-                } else {
-                    candidates.intersect(triIt.value());
-                }
-            }
-
-            /* Verify substring match (trigrams may have false positives) */
-            for (const QString &candidate : candidates) {
-                if (candidate.contains(qw))
-                    matchingWords.insert(candidate);
-            }
-        }
-
-        /* Aggregate scores from matching words */
-        for (const QString &matchWord : matchingWords) {
-            auto it = index->wordMap.constFind(matchWord);
-            if (it == index->wordMap.constEnd())
-                continue;
-
-            for (const IndexEntry &entry : it.value()) {
-                int bonus = 0;
-                if (matchWord == qw)
-                    bonus = 20;  /* Exact word match bonus */
-                else if (matchWord.startsWith(qw))
-                    bonus = 10;  /* Prefix match bonus */
-
-                int score = entry.relevance + bonus;
-                auto scoreIt = pathScores.find(entry.path);
-                if (scoreIt != pathScores.end())
-                    *scoreIt = qMax(*scoreIt, score);
-                else
-                    pathScores.insert(entry.path, score);
-            }
-        }
+        /* Delta first (newest data) */
+        searchDelta(index, qw, &pathScores);
+
+        /* Then every mmap'd segment, in place */
+        QByteArray qwBytes = qw.toUtf8();
+        QMutexLocker lock(&index->segLock);
+        for (const Segment &seg : index->segments)
+            searchSegment(seg, qwBytes, index->deletedPaths, &pathScores);
     }
 
     /* Sort by score descending */
@@ -7,8 +7,11 @@
  * Inverted index storage for the Baloo file indexer backend.
  *
  * Provides a word-to-file-paths mapping with trigram support for
- * substring search.  The index can be persisted to disk in a compact
- * binary format ("BLIX" -- Baloo Linux IndeX).
+ * substring search.  Storage is log-structured: adds accumulate in an
+ * in-memory delta, saves append a sorted mmap-able segment ("BLX2",
+ * searched in place via the term table), deletions are tombstones,
+ * and segments are folded together by a background merge.  The
+ * legacy whole-index "BLIX" v1 file is migrated on load.
  */
 
 #ifndef BALOO_VERIDIAN_INDEX_H
@@ -57,7 +60,10 @@ BalooIndex *baloo_index_create(const char *storage_path);
 BalooIndex *baloo_index_load(const char *storage_path);
 
 /**
- * Save the current index to disk in BLIX binary format.
+ * Persist changes made since the last save as a new append-only
+ * segment.  Cost is proportional to the delta, not the index size;
+ * a no-op when nothing changed.  May schedule a background merge
+ * when enough segments have accumulated.
  *
  * @param index         Index handle.
  * @param storage_path  Directory to write index files.
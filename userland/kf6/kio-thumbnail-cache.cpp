@@ -0,0 +1,274 @@
+/*
+ * VeridianOS -- kio-thumbnail-cache.cpp
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Content-addressed thumbnail pack store (kio-thumbnail-cache.h).
+ *
+ * Pack layout:
+ *   VtcHeader                     -- magic, sizing, counters
+ *   VtcSlot[VTC_SLOTS]            -- open-addressed index
+ *   data region                   -- append-only thumbnail blobs
+ *
+ * Writers claim an index slot with a CAS on its state byte, reserve
+ * data space with a fetch-add on data_used, copy the blob, then
+ * release-store state = READY; readers acquire-load the state and
+ * never observe a half-written entry.  The file is created sparse
+ * at full size and pages materialize as thumbnails are stored.
+ */
+
+#include "kio-thumbnail-cache.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define VTC_MAGIC       0x43485456u     /* "VTHC" little-endian */
+#define VTC_VERSION     1u
+#define VTC_SLOTS       8192            /* Power of two */
+#define VTC_DATA_SIZE   (64u * 1024 * 1024)
+#define VTC_PACK_PATH   "/var/cache/veridian/thumbnails.pack"
+#define VTC_PACK_FALLBACK "/tmp/veridian-thumbnails.pack"
+
+/* Slot states */
+#define VTC_EMPTY   0
+#define VTC_CLAIMED 1
+#define VTC_READY   2
+
+struct VtcHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slot_count;
+    uint32_t _pad;
+    uint64_t data_capacity;
+    uint64_t data_used;             /* Offset of next free data byte */
+    uint64_t hits;
+    uint64_t misses;
+};
+
+struct VtcSlot {
+    uint64_t key;
+    uint32_t offset;                /* Into the data region */
+    uint32_t length;
+    uint16_t w;
+    uint16_t h;
+    uint8_t  size_class;
+    uint8_t  state;
+    uint8_t  _pad[2];
+};
+
+static struct VtcHeader *g_hdr;
+static struct VtcSlot   *g_slots;
+static uint8_t          *g_data;
+
+static size_t vtc_total_size(void)
+{
+    return sizeof(struct VtcHeader) +
+           sizeof(struct VtcSlot) * VTC_SLOTS + VTC_DATA_SIZE;
+}
+
+/* Map (creating on first use) the pack; 0 on success */
+static int vtc_open(void)
+{
+    const char *paths[2] = { VTC_PACK_PATH, VTC_PACK_FALLBACK };
+    int fd = -1;
+    void *map;
+
+    if (g_hdr)
+        return 0;
+
+    mkdir("/var/cache", 0755);
+    mkdir("/var/cache/veridian", 0755);
+
+    for (int p = 0; p < 2 && fd < 0; p++)
+        fd = open(paths[p], O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+        return -1;
+
+    if (ftruncate(fd, (off_t)vtc_total_size()) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    map = mmap(NULL, vtc_total_size(), PROT_READ | PROT_WRITE,
+               MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return -1;
+
+    struct VtcHeader *hdr = (struct VtcHeader *)map;
+
+    if (__atomic_load_n(&hdr->magic, __ATOMIC_ACQUIRE) != VTC_MAGIC ||
+        hdr->version != VTC_VERSION ||
+        hdr->slot_count != VTC_SLOTS) {
+        /* Fresh (or incompatible) pack: initialize, publish magic
+         * last.  A concurrent initializer writes identical values. */
+        hdr->version = VTC_VERSION;
+        hdr->slot_count = VTC_SLOTS;
+        hdr->data_capacity = VTC_DATA_SIZE;
+        __atomic_store_n(&hdr->magic, VTC_MAGIC, __ATOMIC_RELEASE);
+    }
+
+    g_hdr = hdr;
+    g_slots = (struct VtcSlot *)(hdr + 1);
+    g_data = (uint8_t *)(g_slots + VTC_SLOTS);
+    return 0;
+}
+
+uint64_t vtc_file_key(const char *path)
+{
+    uint8_t buf[65536];
+    uint64_t h = 14695981039346656037ull;
+    struct stat st;
+    ssize_t rd;
+    int fd;
+
+    if (!path)
+        return 0;
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return 0;
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return 0;
+    }
+
+    /* Size first, then the sampled regions */
+    for (unsigned i = 0; i < sizeof(st.st_size); i++) {
+        h ^= (uint8_t)((uint64_t)st.st_size >> (i * 8));
+        h *= 1099511628211ull;
+    }
+
+    rd = read(fd, buf, sizeof(buf));
+    for (ssize_t i = 0; i < rd; i++) {
+        h ^= buf[i];
+        h *= 1099511628211ull;
+    }
+
+    if (st.st_size > (off_t)sizeof(buf) + 4096) {
+        if (lseek(fd, -4096, SEEK_END) >= 0) {
+            rd = read(fd, buf, 4096);
+            for (ssize_t i = 0; i < rd; i++) {
+                h ^= buf[i];
+                h *= 1099511628211ull;
+            }
+        }
+    }
+    close(fd);
+    return h ? h : 1;           /* 0 is the "no key" sentinel */
+}
+
+/* Mix the size class into the probe key */
+static uint64_t vtc_slot_key(uint64_t key, int size_class)
+{
+    uint64_t k = key ^ ((uint64_t)(size_class + 1) * 0x9e3779b97f4a7c15ull);
+
+    return k ? k : 1;
+}
+
+int vtc_lookup(uint64_t key, int size_class, const void **pixels,
+               uint32_t *len, uint16_t *w, uint16_t *h)
+{
+    uint64_t k;
+    uint32_t idx;
+
+    if (key == 0 || !pixels || vtc_open() < 0)
+        return -1;
+
+    k = vtc_slot_key(key, size_class);
+    idx = (uint32_t)(k & (VTC_SLOTS - 1));
+
+    for (uint32_t probe = 0; probe < VTC_SLOTS; probe++) {
+        struct VtcSlot *s = &g_slots[(idx + probe) & (VTC_SLOTS - 1)];
+        uint8_t state = __atomic_load_n(&s->state, __ATOMIC_ACQUIRE);
+
+        if (state == VTC_EMPTY)
+            break;              /* Probe chain ends at first empty */
+        if (state == VTC_READY && s->key == k) {
+            *pixels = g_data + s->offset;
+            if (len)
+                *len = s->length;
+            if (w)
+                *w = s->w;
+            if (h)
+                *h = s->h;
+            __atomic_fetch_add(&g_hdr->hits, 1, __ATOMIC_RELAXED);
+            return 1;
+        }
+    }
+    __atomic_fetch_add(&g_hdr->misses, 1, __ATOMIC_RELAXED);
+    return 0;
+}
+
+int vtc_store(uint64_t key, int size_class, const void *pixels,
+              uint32_t len, uint16_t w, uint16_t h)
+{
+    uint64_t k, off;
+    uint32_t idx;
+
+    if (key == 0 || !pixels || len == 0 || vtc_open() < 0)
+        return -1;
+
+    k = vtc_slot_key(key, size_class);
+
+    /* Reserve data space first; bail before touching the index when
+     * the region is exhausted */
+    off = __atomic_fetch_add(&g_hdr->data_used, (uint64_t)len,
+                             __ATOMIC_RELAXED);
+    if (off + len > VTC_DATA_SIZE) {
+        __atomic_fetch_sub(&g_hdr->data_used, (uint64_t)len,
+                           __ATOMIC_RELAXED);
+        return -1;
+    }
+    memcpy(g_data + off, pixels, len);
+
+    idx = (uint32_t)(k & (VTC_SLOTS - 1));
+    for (uint32_t probe = 0; probe < VTC_SLOTS; probe++) {
+        struct VtcSlot *s = &g_slots[(idx + probe) & (VTC_SLOTS - 1)];
+        uint8_t state = __atomic_load_n(&s->state, __ATOMIC_ACQUIRE);
+
+        if (state == VTC_READY && s->key == k)
+            return 0;           /* Raced with another worker: done */
+        if (state != VTC_EMPTY)
+            continue;
+
+        uint8_t expected = VTC_EMPTY;
+        if (!__atomic_compare_exchange_n(&s->state, &expected,
+                                         VTC_CLAIMED, 0,
+                                         __ATOMIC_ACQUIRE,
+                                         __ATOMIC_ACQUIRE)) {
+            probe--;            /* Re-examine the contested slot */
+            continue;
+        }
+
+        s->key = k;
+        s->offset = (uint32_t)off;
+        s->length = len;
+        s->w = w;
+        s->h = h;
+        s->size_class = (uint8_t)size_class;
+        __atomic_store_n(&s->state, VTC_READY, __ATOMIC_RELEASE);
+        return 0;
+    }
+    return -1;                  /* Index full */
+}
+
+void vtc_stats(uint64_t *hits, uint64_t *misses)
+{
+    if (vtc_open() < 0) {
+        if (hits)
+            *hits = 0;
+        if (misses)
+            *misses = 0;
+        return;
+    }
+    if (hits)
+        *hits = __atomic_load_n(&g_hdr->hits, __ATOMIC_RELAXED);
+    if (misses)
+        *misses = __atomic_load_n(&g_hdr->misses, __ATOMIC_RELAXED);
+}
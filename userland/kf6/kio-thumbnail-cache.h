@@ -0,0 +1,68 @@
+/*
+ * VeridianOS -- kio-thumbnail-cache.h
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Persistent content-addressed thumbnail store.
+ *
+ * One pack file (/var/cache/veridian/thumbnails.pack) holds every
+ * generated thumbnail: an open-addressed index keyed by content hash
+ * plus size class, and an append-only pixel data region.  The file
+ * is mapped MAP_SHARED by every consumer, so a revisit of a photo
+ * directory is a hash probe and a blit -- no decode, no scaling, no
+ * repeated work across processes or sessions.  Slots are claimed
+ * with the usual CAS-then-publish pattern, so concurrent KIO
+ * workers can fill the cache without locks.
+ */
+
+#ifndef KIO_THUMBNAIL_CACHE_H
+#define KIO_THUMBNAIL_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Size classes (thumbnail edge length in pixels) */
+#define VTC_CLASS_SMALL  0      /* 128 */
+#define VTC_CLASS_LARGE  1      /* 256 */
+#define VTC_CLASS_XLARGE 2      /* 512 */
+
+/**
+ * Content key for a file: FNV-1a over the file size and sampled
+ * content (first 64 KiB and last 4 KiB).  Sampling keeps keying
+ * cheap on multi-megabyte photos while still changing whenever the
+ * image data does.  Returns 0 on unreadable files (0 is never a
+ * valid key).
+ */
+uint64_t vtc_file_key(const char *path);
+
+/**
+ * Look up a thumbnail.  On a hit, *pixels points into the shared
+ * mapping (valid for the process lifetime; treat as read-only),
+ * *len is the blob length and *w, *h the pixel dimensions.  Returns 1
+ * on hit, 0 on miss, -1 when the store is unavailable.
+ */
+int vtc_lookup(uint64_t key, int size_class, const void **pixels,
+               uint32_t *len, uint16_t *w, uint16_t *h);
+
+/**
+ * Store a thumbnail blob (any self-contained format the readers
+ * agree on; the KIO worker stores PNG).  Returns 0, or -1 when the
+ * index or data region is full -- the caller just serves the fresh
+ * thumbnail without caching it.
+ */
+int vtc_store(uint64_t key, int size_class, const void *pixels,
+              uint32_t len, uint16_t w, uint16_t h);
+
+/** Lifetime hit/miss counters from the shared header. */
+void vtc_stats(uint64_t *hits, uint64_t *misses);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KIO_THUMBNAIL_CACHE_H */
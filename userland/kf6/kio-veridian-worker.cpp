@@ -20,12 +20,19 @@
 #include <QStandardPaths>
 #include <QDateTime>
 #include <QDebug>
+#include <QBuffer>
+#include <QDataStream>
+#include <QImage>
+
+#include "kio-thumbnail-cache.h"
 
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <dirent.h>
 #include <fcntl.h>
+#include <pthread.h>
 #include <unistd.h>
+#include <veridian/blockcache.h>
 #include <string.h>
 #include <errno.h>
 #include <pwd.h>
@@ -34,8 +41,535 @@
 /* Read/write buffer size for file transfers */
 static constexpr int TRANSFER_BUFFER_SIZE = 65536;
 
+/* ========================================================================= */
+/* Readahead / write-behind engine                                           */
+/* ========================================================================= */
+
+/*
+ * The transfer loops below used to issue one synchronous VFS
+ * round-trip per block, leaving the device idle while KIO chewed on
+ * the data.  A prefetch thread now keeps reading ahead of the
+ * consumer into a bounded block ring, and a writer thread drains
+ * dirty blocks behind the producer, so BlockFS sees back-to-back
+ * requests.  The readahead window is adaptive: it starts at two
+ * blocks and widens (up to the ring size) while the consumer keeps
+ * arriving before the prefetcher -- i.e. while access is proven
+ * sequential and the device is the bottleneck.
+ */
+
+static constexpr int TRANSFER_RING_BLOCKS = 8;
+
+struct TransferBlock {
+    char    data[TRANSFER_BUFFER_SIZE];
+    ssize_t len;        /* <0 = I/O error (negated errno), 0 = EOF */
+};
+
+struct TransferRing {
+    TransferBlock   blocks[TRANSFER_RING_BLOCKS];
+    int             head = 0;       /* producer slot */
+    int             tail = 0;       /* consumer slot */
+    int             count = 0;
+    int             limit = 2;      /* adaptive window */
+    bool            done = false;   /* producer finished / consumer quit */
+    pthread_mutex_t lock;
+    pthread_cond_t  can_produce;
+    pthread_cond_t  can_consume;
+
+    void init()
+    {
+        pthread_mutex_init(&lock, nullptr);
+        pthread_cond_init(&can_produce, nullptr);
+        pthread_cond_init(&can_consume, nullptr);
+    }
+};
+
+/* ----- Adaptive readahead ----- */
+
+class ReadAhead
+{
+public:
+    explicit ReadAhead(int fd) : m_fd(fd)
+    {
+        m_ring.init();
+        m_threaded =
+            pthread_create(&m_tid, nullptr, threadEntry, this) == 0;
+    }
+
+    ~ReadAhead()
+    {
+        if (m_threaded) {
+            pthread_mutex_lock(&m_ring.lock);
+            m_ring.done = true;
+            pthread_cond_broadcast(&m_ring.can_produce);
+            pthread_mutex_unlock(&m_ring.lock);
+            pthread_join(m_tid, nullptr);
+        }
+    }
+
+    /*
+     * Next sequential block.  Returns the byte count, 0 at EOF, or a
+     * negative errno.  The pointer stays valid until the next call.
+     */
+    ssize_t next(const char **out)
+    {
+        if (!m_threaded) {
+            /* No thread: plain synchronous read */
+            ssize_t n = ::read(m_fd, m_fallback.data,
+                               sizeof(m_fallback.data));
+            *out = m_fallback.data;
+            return n < 0 ? -errno : n;
+        }
+
+        pthread_mutex_lock(&m_ring.lock);
+
+        /* The previously returned block is only released now -- its
+         * slot must not be recycled while the caller still reads it */
+        if (m_borrowed) {
+            m_ring.tail = (m_ring.tail + 1) % TRANSFER_RING_BLOCKS;
+            m_ring.count--;
+            m_borrowed = false;
+            pthread_cond_signal(&m_ring.can_produce);
+        }
+
+        /* Consumer arriving before the prefetcher means the device is
+         * the bottleneck: widen the readahead window */
+        if (m_ring.count == 0 && !m_ring.done &&
+            m_ring.limit < TRANSFER_RING_BLOCKS) {
+            m_ring.limit++;
+            pthread_cond_signal(&m_ring.can_produce);
+        }
+        while (m_ring.count == 0 && !m_ring.done)
+            pthread_cond_wait(&m_ring.can_consume, &m_ring.lock);
+
+        ssize_t n;
+        if (m_ring.count == 0) {
+            n = 0;  /* producer done and drained */
+            *out = nullptr;
+        } else {
+            TransferBlock *b = &m_ring.blocks[m_ring.tail];
+
+            m_borrowed = true;   /* slot released on the next call */
+            *out = b->data;
+            n = b->len;
+        }
+        pthread_mutex_unlock(&m_ring.lock);
+        return n;
+    }
+
+private:
+    static void *threadEntry(void *arg)
+    {
+        static_cast<ReadAhead *>(arg)->run();
+        return nullptr;
+    }
+
+    void run()
+    {
+        for (;;) {
+            pthread_mutex_lock(&m_ring.lock);
+            while (m_ring.count >= m_ring.limit && !m_ring.done)
+                pthread_cond_wait(&m_ring.can_produce, &m_ring.lock);
+            if (m_ring.done) {
+                pthread_mutex_unlock(&m_ring.lock);
+                return;
+            }
+            TransferBlock *b = &m_ring.blocks[m_ring.head];
+            pthread_mutex_unlock(&m_ring.lock);
+
+            ssize_t n = ::read(m_fd, b->data, sizeof(b->data));
+
+            pthread_mutex_lock(&m_ring.lock);
+            b->len = n < 0 ? -errno : n;
+            m_ring.head = (m_ring.head + 1) % TRANSFER_RING_BLOCKS;
+            m_ring.count++;
+            pthread_cond_signal(&m_ring.can_consume);
+            if (n <= 0) {
+                m_ring.done = true;
+                pthread_cond_broadcast(&m_ring.can_consume);
+                pthread_mutex_unlock(&m_ring.lock);
+                return;
+            }
+            pthread_mutex_unlock(&m_ring.lock);
+        }
+    }
+
+    int           m_fd;
+    bool          m_threaded = false;
+    bool          m_borrowed = false;
+    pthread_t     m_tid = 0;
+    TransferRing  m_ring;
+    TransferBlock m_fallback;
+};
+
+/* ----- Write-behind ----- */
+
+class WriteBehind
+{
+public:
+    explicit WriteBehind(int fd) : m_fd(fd)
+    {
+        m_ring.init();
+        m_threaded =
+            pthread_create(&m_tid, nullptr, threadEntry, this) == 0;
+    }
+
+    /* Queue one dirty block; blocks only when the ring is full.
+     * Returns 0, or the negated errno of an earlier write. */
+    int push(const char *data, size_t len)
+    {
+        if (!m_threaded) {
+            int rc = writeAll(data, len);
+
+            if (rc != 0 && m_error == 0)
+                m_error = rc;
+            return rc;
+        }
+
+        pthread_mutex_lock(&m_ring.lock);
+        while (m_ring.count == TRANSFER_RING_BLOCKS && m_error == 0)
+            pthread_cond_wait(&m_ring.can_produce, &m_ring.lock);
+        if (m_error != 0) {
+            pthread_mutex_unlock(&m_ring.lock);
+            return m_error;
+        }
+
+        TransferBlock *b = &m_ring.blocks[m_ring.head];
+
+        memcpy(b->data, data, len);
+        b->len = (ssize_t)len;
+        m_ring.head = (m_ring.head + 1) % TRANSFER_RING_BLOCKS;
+        m_ring.count++;
+        pthread_cond_signal(&m_ring.can_consume);
+        pthread_mutex_unlock(&m_ring.lock);
+        return 0;
+    }
+
+    /* Drain the ring and join; the job's success hinges on this.
+     * Returns 0 or the first write error (negated errno). */
+    int finish()
+    {
+        if (!m_threaded)
+            return m_error;
+
+        pthread_mutex_lock(&m_ring.lock);
+        m_ring.done = true;
+        pthread_cond_broadcast(&m_ring.can_consume);
+        pthread_mutex_unlock(&m_ring.lock);
+        pthread_join(m_tid, nullptr);
+        m_threaded = false;
+        return m_error;
+    }
+
+    ~WriteBehind() { finish(); }
+
+private:
+    static void *threadEntry(void *arg)
+    {
+        static_cast<WriteBehind *>(arg)->run();
+        return nullptr;
+    }
+
+    /* Returns 0 or a negated errno; does not touch shared state */
+    int writeAll(const char *p, size_t len)
+    {
+        while (len > 0) {
+            ssize_t w = ::write(m_fd, p, len);
+
+            if (w < 0)
+                return -errno;
+            p += w;
+            len -= (size_t)w;
+        }
+        return 0;
+    }
+
+    void run()
+    {
+        for (;;) {
+            pthread_mutex_lock(&m_ring.lock);
+            while (m_ring.count == 0 && !m_ring.done)
+                pthread_cond_wait(&m_ring.can_consume, &m_ring.lock);
+            if (m_ring.count == 0) {
+                pthread_mutex_unlock(&m_ring.lock);
+                return;
+            }
+            TransferBlock *b = &m_ring.blocks[m_ring.tail];
+            int had_error = m_error;
+            pthread_mutex_unlock(&m_ring.lock);
+
+            int rc = had_error ? 0 : writeAll(b->data, (size_t)b->len);
+
+            pthread_mutex_lock(&m_ring.lock);
+            if (rc != 0 && m_error == 0) {
+                m_error = rc;
+                /* Unblock a producer waiting on a full ring */
+                pthread_cond_broadcast(&m_ring.can_produce);
+            }
+            m_ring.tail = (m_ring.tail + 1) % TRANSFER_RING_BLOCKS;
+            m_ring.count--;
+            pthread_cond_signal(&m_ring.can_produce);
+            pthread_mutex_unlock(&m_ring.lock);
+        }
+    }
+
+    int           m_fd;
+    bool          m_threaded = false;
+    pthread_t     m_tid = 0;
+    int           m_error = 0;
+    TransferRing  m_ring;
+};
+
 /* ========================================================================= */
 /* Construction / destruction                                                */
+/* ----- Multi-file transfer scheduler ----- */
+
+/*
+ * Directory copies used to pay one full KIO job round-trip per file,
+ * which makes config-directory copies (thousands of ~1KB files)
+ * purely latency-bound.  When copy() is handed a directory, the
+ * whole tree is transferred in-worker by this scheduler instead:
+ * small files run on SCHED_WORKERS concurrent contexts draining a
+ * FIFO queue (fair: strictly in discovery order), while files at or
+ * above SCHED_LARGE_BYTES run exclusively -- the small workers are
+ * drained first so a big sequential stream never competes for the
+ * device.  Progress is aggregated across all contexts into one
+ * byte counter the job reports from.
+ */
+
+static constexpr int   SCHED_WORKERS     = 4;
+static constexpr off_t SCHED_LARGE_BYTES = 1024 * 1024;
+
+struct SchedFileJob {
+    char   src[4096];
+    char   dst[4096];
+    off_t  size;
+    mode_t mode;
+    SchedFileJob *next;
+};
+
+class TransferScheduler
+{
+public:
+    TransferScheduler() { pthread_mutex_init(&m_lock, nullptr); }
+
+    /* Queued by the directory walk */
+    void addFile(const char *src, const char *dst, off_t size,
+                 mode_t mode)
+    {
+        SchedFileJob *job = new SchedFileJob();
+
+        snprintf(job->src, sizeof(job->src), "%s", src);
+        snprintf(job->dst, sizeof(job->dst), "%s", dst);
+        job->size = size;
+        job->mode = mode;
+        job->next = nullptr;
+
+        SchedFileJob ***tail =
+            size >= SCHED_LARGE_BYTES ? &m_large_tail : &m_small_tail;
+
+        **tail = job;
+        *tail = &job->next;
+        m_total_bytes += size;
+    }
+
+    off_t totalBytes() const { return m_total_bytes; }
+
+    /* Bytes transferred so far, across every context */
+    off_t processedBytes()
+    {
+        pthread_mutex_lock(&m_lock);
+        off_t v = m_processed;
+        pthread_mutex_unlock(&m_lock);
+        return v;
+    }
+
+    bool finished()
+    {
+        pthread_mutex_lock(&m_lock);
+        bool f = m_finished;
+        pthread_mutex_unlock(&m_lock);
+        return f;
+    }
+
+    /* Run the whole queue; returns 0 or the first error (neg errno).
+     * Small files fan out over the worker pool; large files follow,
+     * one at a time with the pool idle. */
+    int run()
+    {
+        pthread_t tids[SCHED_WORKERS];
+        int started = 0;
+
+        for (; started < SCHED_WORKERS; started++) {
+            if (pthread_create(&tids[started], nullptr, workerEntry,
+                               this) != 0)
+                break;
+        }
+        if (started == 0) {
+            /* No threads at all: run everything inline */
+            SchedFileJob *job;
+
+            while ((job = popSmall()) != nullptr) {
+                copyOne(job);
+                delete job;
+            }
+        }
+        for (int i = 0; i < started; i++)
+            pthread_join(tids[i], nullptr);
+
+        /* Exclusive phase: the large sequential transfers */
+        SchedFileJob *job = m_large_head;
+
+        while (job != nullptr) {
+            SchedFileJob *next = job->next;
+
+            if (m_error == 0)
+                copyLargeExclusive(job);
+            delete job;
+            job = next;
+        }
+
+        pthread_mutex_lock(&m_lock);
+        m_finished = true;
+        pthread_mutex_unlock(&m_lock);
+        return m_error;
+    }
+
+private:
+    static void *workerEntry(void *arg)
+    {
+        TransferScheduler *s = static_cast<TransferScheduler *>(arg);
+        SchedFileJob *job;
+
+        while ((job = s->popSmall()) != nullptr) {
+            s->copyOne(job);
+            delete job;
+        }
+        return nullptr;
+    }
+
+    SchedFileJob *popSmall()
+    {
+        pthread_mutex_lock(&m_lock);
+        SchedFileJob *job = nullptr;
+
+        if (m_error == 0 && m_small_head) {
+            job = m_small_head;
+            m_small_head = job->next;
+            if (!m_small_head)
+                m_small_tail = &m_small_head;
+        }
+        pthread_mutex_unlock(&m_lock);
+        return job;
+    }
+
+    void account(off_t bytes, int rc)
+    {
+        pthread_mutex_lock(&m_lock);
+        m_processed += bytes;
+        if (rc != 0 && m_error == 0)
+            m_error = rc;
+        pthread_mutex_unlock(&m_lock);
+    }
+
+    /* Plain buffered copy for the small-file contexts */
+    void copyOne(const SchedFileJob *job)
+    {
+        char buf[TRANSFER_BUFFER_SIZE];
+        off_t moved = 0;
+        int rc = 0;
+
+        int sfd = ::open(job->src, O_RDONLY);
+        int dfd = sfd < 0 ? -1
+                          : ::open(job->dst,
+                                   O_WRONLY | O_CREAT | O_TRUNC,
+                                   job->mode & 07777);
+
+        if (sfd < 0 || dfd < 0) {
+            rc = -errno;
+        } else {
+            ssize_t n;
+
+            while ((n = ::read(sfd, buf, sizeof(buf))) > 0) {
+                const char *p = buf;
+                ssize_t left = n;
+
+                while (left > 0) {
+                    ssize_t w = ::write(dfd, p, (size_t)left);
+
+                    if (w < 0) {
+                        rc = -errno;
+                        break;
+                    }
+                    p += w;
+                    left -= w;
+                }
+                if (rc != 0)
+                    break;
+                moved += n;
+            }
+            if (n < 0 && rc == 0)
+                rc = -errno;
+        }
+
+        if (sfd >= 0) ::close(sfd);
+        if (dfd >= 0) ::close(dfd);
+        account(moved, rc);
+    }
+
+    /* Large files get the readahead/write-behind pipeline to
+     * themselves */
+    void copyLargeExclusive(const SchedFileJob *job)
+    {
+        int sfd = ::open(job->src, O_RDONLY);
+        int dfd = sfd < 0 ? -1
+                          : ::open(job->dst,
+                                   O_WRONLY | O_CREAT | O_TRUNC,
+                                   job->mode & 07777);
+
+        if (sfd < 0 || dfd < 0) {
+            account(0, -errno);
+            if (sfd >= 0) ::close(sfd);
+            return;
+        }
+
+        off_t moved = 0;
+        int rc = 0;
+        {
+            ReadAhead reader(sfd);
+            WriteBehind writer(dfd);
+            const char *block;
+            ssize_t n;
+
+            while ((n = reader.next(&block)) > 0) {
+                if ((rc = writer.push(block, (size_t)n)) != 0)
+                    break;
+                moved += n;
+            }
+            if (n < 0 && rc == 0)
+                rc = (int)n;
+
+            int frc = writer.finish();
+
+            if (frc != 0 && rc == 0)
+                rc = frc;
+        }
+        ::close(sfd);
+        ::close(dfd);
+        account(moved, rc);
+    }
+
+    SchedFileJob  *m_small_head = nullptr;
+    SchedFileJob **m_small_tail = &m_small_head;
+    SchedFileJob  *m_large_head = nullptr;
+    SchedFileJob **m_large_tail = &m_large_head;
+    off_t          m_total_bytes = 0;
+    off_t          m_processed = 0;
+    int            m_error = 0;
+    bool           m_finished = false;
+    pthread_mutex_t m_lock;
+};
+
+
 /* ========================================================================= */
 
 VeridianFileWorker::VeridianFileWorker(const QByteArray &pool,
@@ -87,8 +621,12 @@ KIO::WorkerResult VeridianFileWorker::listDir(const QUrl &url)
         return KIO::WorkerResult::fail(errnoToKioError(errno), path);
     }
 
+    /* readdirplus: attributes arrive piggybacked on the entries, so
+     * listing a large directory needs no per-entry lstat */
     struct dirent *de;
-    while ((de = ::readdir(dp)) != nullptr) {
+    struct stat st;
+    int hasStat = 0;
+    while ((de = veridian_readdir_plus(dp, &st, &hasStat)) != nullptr) {
         /* Skip . and .. */
         if (strcmp(de->d_name, ".") == 0 || strcmp(de->d_name, "..") == 0)
             continue;
@@ -96,7 +634,9 @@ KIO::WorkerResult VeridianFileWorker::listDir(const QUrl &url)
         const QString name = QString::fromLocal8Bit(de->d_name);
         const QString entryPath = path + QLatin1Char('/') + name;
 
-        KIO::UDSEntry entry = createUDSEntry(name, entryPath);
+        KIO::UDSEntry entry = hasStat
+            ? createUDSEntry(name, st)
+            : createUDSEntry(name, entryPath);
         listEntry(entry);
     }
 
@@ -120,6 +660,10 @@ KIO::WorkerResult VeridianFileWorker::get(const QUrl &url)
         return KIO::WorkerResult::fail(errnoToKioError(errno), path);
     }
 
+    /* Sequential transfer: widen the BlockFS readahead window so the
+     * cache stays ahead of the copy loop */
+    vbc_set_readahead(fd, 32);
+
     /* Get file size for progress reporting */
     struct stat st;
     if (::fstat(fd, &st) == 0) {
@@ -129,23 +673,27 @@ KIO::WorkerResult VeridianFileWorker::get(const QUrl &url)
     /* Set MIME type */
     mimeType(mimeTypeForFile(path));
 
-    /* Stream file data */
-    char buf[TRANSFER_BUFFER_SIZE];
+    /* Stream file data with the prefetch thread reading ahead */
     KIO::filesize_t totalRead = 0;
+    {
+        ReadAhead reader(fd);
 
-    for (;;) {
-        ssize_t n = ::read(fd, buf, sizeof(buf));
-        if (n < 0) {
-            int savedErrno = errno;
-            ::close(fd);
-            return KIO::WorkerResult::fail(errnoToKioError(savedErrno), path);
-        }
-        if (n == 0)
-            break;
+        for (;;) {
+            const char *block;
+            ssize_t n = reader.next(&block);
+
+            if (n < 0) {
+                ::close(fd);
+                return KIO::WorkerResult::fail(errnoToKioError(-(int)n),
+                                               path);
+            }
+            if (n == 0)
+                break;
 
-        data(QByteArray(buf, static_cast<int>(n)));
-        totalRead += static_cast<KIO::filesize_t>(n);
-        processedSize(totalRead);
+            data(QByteArray(block, static_cast<int>(n)));
+            totalRead += static_cast<KIO::filesize_t>(n);
+            processedSize(totalRead);
+        }
     }
 
     /* Signal end of data */
@@ -185,35 +733,50 @@ KIO::WorkerResult VeridianFileWorker::put(const QUrl &url, int permissions,
         return KIO::WorkerResult::fail(errnoToKioError(errno), path);
     }
 
-    /* Read data from job and write to file */
+    /* Read data from the job; the writer thread drains behind us so
+     * the next dataReq() round-trip overlaps the previous write */
+    WriteBehind writer(fd);
     int dataResult;
+
     do {
         QByteArray buffer;
         dataReq();
         dataResult = readData(buffer);
         if (dataResult < 0) {
+            writer.finish();   /* the fd must outlive the writer thread */
             ::close(fd);
             return KIO::WorkerResult::fail(KIO::ERR_CANNOT_WRITE, path);
         }
         if (buffer.isEmpty())
             break;
 
+        /* Chunk oversize job buffers into ring blocks */
         const char *ptr = buffer.constData();
         qint64 remaining = buffer.size();
+
         while (remaining > 0) {
-            ssize_t written = ::write(fd, ptr, static_cast<size_t>(remaining));
-            if (written < 0) {
-                int savedErrno = errno;
+            size_t chunk = remaining < TRANSFER_BUFFER_SIZE
+                               ? (size_t)remaining
+                               : (size_t)TRANSFER_BUFFER_SIZE;
+            int rc = writer.push(ptr, chunk);
+
+            if (rc != 0) {
+                writer.finish();
                 ::close(fd);
-                return KIO::WorkerResult::fail(
-                    errnoToKioError(savedErrno), path);
+                return KIO::WorkerResult::fail(errnoToKioError(-rc),
+                                               path);
             }
-            ptr += written;
-            remaining -= written;
+            ptr += chunk;
+            remaining -= (qint64)chunk;
         }
     } while (dataResult > 0);
 
+    /* Job completion: flush the dirty ring before declaring success */
+    int rc = writer.finish();
+
     ::close(fd);
+    if (rc != 0)
+        return KIO::WorkerResult::fail(errnoToKioError(-rc), path);
     return KIO::WorkerResult::pass();
 }
 
@@ -340,6 +903,16 @@ KIO::WorkerResult VeridianFileWorker::copy(const QUrl &src, const QUrl &dest,
         }
     }
 
+    /* Directory trees go through the multi-file scheduler: small
+     * files fan out across worker contexts, large ones run exclusive,
+     * and the whole tree is one job instead of one KIO round-trip
+     * per file */
+    struct stat srcProbe;
+    if (::stat(srcPath.toLocal8Bit().constData(), &srcProbe) == 0 &&
+        S_ISDIR(srcProbe.st_mode)) {
+        return copyTree(srcPath, destPath);
+    }
+
     /* Open source */
     int srcFd = ::open(srcPath.toLocal8Bit().constData(), O_RDONLY);
     if (srcFd < 0) {
@@ -367,45 +940,154 @@ KIO::WorkerResult VeridianFileWorker::copy(const QUrl &src, const QUrl &dest,
         return KIO::WorkerResult::fail(errnoToKioError(savedErrno), destPath);
     }
 
-    /* Copy data */
-    char buf[TRANSFER_BUFFER_SIZE];
+    /* Copy data: readahead on the source and write-behind on the
+     * destination pipeline the two devices against each other */
     KIO::filesize_t totalCopied = 0;
+    int copy_rc = 0;
+    {
+        ReadAhead reader(srcFd);
+        WriteBehind writer(destFd);
+
+        for (;;) {
+            const char *block;
+            ssize_t n = reader.next(&block);
+
+            if (n < 0) {
+                copy_rc = (int)n;
+                break;
+            }
+            if (n == 0)
+                break;
 
-    for (;;) {
-        ssize_t n = ::read(srcFd, buf, sizeof(buf));
-        if (n < 0) {
-            int savedErrno = errno;
-            ::close(srcFd);
-            ::close(destFd);
-            return KIO::WorkerResult::fail(errnoToKioError(savedErrno),
-                                           srcPath);
-        }
-        if (n == 0)
-            break;
+            int rc = writer.push(block, (size_t)n);
 
-        const char *ptr = buf;
-        ssize_t remaining = n;
-        while (remaining > 0) {
-            ssize_t written = ::write(destFd, ptr,
-                                      static_cast<size_t>(remaining));
-            if (written < 0) {
-                int savedErrno = errno;
-                ::close(srcFd);
-                ::close(destFd);
-                return KIO::WorkerResult::fail(
-                    errnoToKioError(savedErrno), destPath);
+            if (rc != 0) {
+                copy_rc = rc;
+                break;
             }
-            ptr += written;
-            remaining -= written;
+
+            totalCopied += static_cast<KIO::filesize_t>(n);
+            processedSize(totalCopied);
         }
 
-        totalCopied += static_cast<KIO::filesize_t>(n);
-        processedSize(totalCopied);
+        /* Explicit flush on completion: errors surface here */
+        int rc = writer.finish();
+
+        if (rc != 0 && copy_rc == 0)
+            copy_rc = rc;
     }
 
     ::close(srcFd);
     ::close(destFd);
 
+    if (copy_rc != 0)
+        return KIO::WorkerResult::fail(errnoToKioError(-copy_rc),
+                                       srcPath);
+    return KIO::WorkerResult::pass();
+}
+
+/* ========================================================================= */
+/* copyTree -- in-worker directory transfer                                  */
+/* ========================================================================= */
+
+/* Walk the source tree: create directories and symlinks immediately
+ * (cheap, serial), queue regular files on the scheduler.  Returns 0
+ * or a negated errno. */
+static int collect_tree(TransferScheduler *sched, const char *src,
+                        const char *dst)
+{
+    DIR *dp = ::opendir(src);
+
+    if (!dp)
+        return -errno;
+
+    struct stat st;
+
+    if (::stat(src, &st) != 0)
+        st.st_mode = 0755;
+    ::mkdir(dst, st.st_mode & 07777);
+
+    struct dirent *de;
+    int rc = 0;
+
+    while (rc == 0 && (de = ::readdir(dp)) != nullptr) {
+        if (strcmp(de->d_name, ".") == 0 || strcmp(de->d_name, "..") == 0)
+            continue;
+
+        char spath[4096], dpath[4096];
+
+        snprintf(spath, sizeof(spath), "%s/%s", src, de->d_name);
+        snprintf(dpath, sizeof(dpath), "%s/%s", dst, de->d_name);
+
+        struct stat est;
+
+        if (::lstat(spath, &est) != 0)
+            continue;
+
+        if (S_ISDIR(est.st_mode)) {
+            rc = collect_tree(sched, spath, dpath);
+        } else if (S_ISLNK(est.st_mode)) {
+            char target[4096];
+            ssize_t n = ::readlink(spath, target, sizeof(target) - 1);
+
+            if (n > 0) {
+                target[n] = '\0';
+                ::symlink(target, dpath);
+            }
+        } else if (S_ISREG(est.st_mode)) {
+            sched->addFile(spath, dpath, est.st_size, est.st_mode);
+        }
+    }
+
+    ::closedir(dp);
+    return rc;
+}
+
+struct SchedRunArgs {
+    TransferScheduler *sched;
+    int                result;
+};
+
+static void *sched_run_entry(void *arg)
+{
+    SchedRunArgs *ra = static_cast<SchedRunArgs *>(arg);
+
+    ra->result = ra->sched->run();
+    return nullptr;
+}
+
+KIO::WorkerResult VeridianFileWorker::copyTree(const QString &src,
+                                               const QString &dest)
+{
+    TransferScheduler sched;
+    int rc = collect_tree(&sched, src.toLocal8Bit().constData(),
+                          dest.toLocal8Bit().constData());
+
+    if (rc != 0)
+        return KIO::WorkerResult::fail(errnoToKioError(-rc), src);
+
+    totalSize(static_cast<KIO::filesize_t>(sched.totalBytes()));
+
+    /* Run the scheduler off-thread so this thread can keep the job's
+     * aggregated progress flowing */
+    SchedRunArgs ra = { &sched, 0 };
+    pthread_t tid;
+
+    if (pthread_create(&tid, nullptr, sched_run_entry, &ra) == 0) {
+        while (!sched.finished()) {
+            processedSize(
+                static_cast<KIO::filesize_t>(sched.processedBytes()));
+            ::usleep(100 * 1000);
+        }
+        pthread_join(tid, nullptr);
+    } else {
+        ra.result = sched.run();
+    }
+
+    processedSize(static_cast<KIO::filesize_t>(sched.processedBytes()));
+
+    if (ra.result != 0)
+        return KIO::WorkerResult::fail(errnoToKioError(-ra.result), src);
     return KIO::WorkerResult::pass();
 }
 
@@ -435,13 +1117,21 @@ KIO::WorkerResult VeridianFileWorker::chmod(const QUrl &url, int permissions)
 KIO::UDSEntry VeridianFileWorker::createUDSEntry(const QString &name,
                                                    const QString &path)
 {
-    KIO::UDSEntry entry;
     struct stat st;
 
     if (::lstat(path.toLocal8Bit().constData(), &st) < 0) {
+        KIO::UDSEntry entry;
         entry.fastInsert(KIO::UDSEntry::UDS_NAME, name);
         return entry;
     }
+    return createUDSEntry(name, st);
+}
+
+/* Attribute-carrying variant: no filesystem access */
+KIO::UDSEntry VeridianFileWorker::createUDSEntry(const QString &name,
+                                                   const struct stat &st)
+{
+    KIO::UDSEntry entry;
 
     entry.fastInsert(KIO::UDSEntry::UDS_NAME, name);
     entry.fastInsert(KIO::UDSEntry::UDS_SIZE,
@@ -652,3 +1342,72 @@ QString VeridianFileWorker::urlToLocalPath(const QUrl &url) const
     /* file:// or empty scheme -> local path */
     return url.toLocalFile();
 }
+
+/* ========================================================================= */
+/* Thumbnails (content-addressed pack cache)                                 */
+/* ========================================================================= */
+
+/*
+ * special() command 1: thumbnail request (path, size class).  The
+ * content key makes the cache immune to renames and moves -- the
+ * same photo revisited from any directory is one index probe and a
+ * blit from the shared mapping.  Only a genuine miss pays for
+ * decode and scale, and the result lands in the pack for every
+ * future browse by any process.
+ */
+KIO::WorkerResult VeridianFileWorker::special(const QByteArray &req)
+{
+    QDataStream in(req);
+    int cmd = 0;
+
+    in >> cmd;
+    if (cmd != 1)
+        return KIO::WorkerResult::fail(KIO::ERR_UNSUPPORTED_ACTION,
+                                       QStringLiteral("special"));
+
+    QString path;
+    int sizeClass = VTC_CLASS_SMALL;
+    in >> path >> sizeClass;
+
+    static const int classEdge[3] = { 128, 256, 512 };
+    if (sizeClass < 0 || sizeClass > VTC_CLASS_XLARGE)
+        sizeClass = VTC_CLASS_SMALL;
+
+    const uint64_t key = vtc_file_key(path.toLocal8Bit().constData());
+    if (key == 0)
+        return KIO::WorkerResult::fail(KIO::ERR_CANNOT_OPEN_FOR_READING,
+                                       path);
+
+    const void *blob = nullptr;
+    uint32_t blobLen = 0;
+    uint16_t w = 0, hgt = 0;
+
+    if (vtc_lookup(key, sizeClass, &blob, &blobLen, &w, &hgt) == 1) {
+        data(QByteArray::fromRawData(
+            reinterpret_cast<const char *>(blob), (int)blobLen));
+        data(QByteArray());
+        return KIO::WorkerResult::pass();
+    }
+
+    /* Miss: decode, scale, serve, and remember */
+    QImage img(path);
+    if (img.isNull())
+        return KIO::WorkerResult::fail(KIO::ERR_CANNOT_OPEN_FOR_READING,
+                                       path);
+
+    const int edge = classEdge[sizeClass];
+    QImage thumb = img.scaled(edge, edge, Qt::KeepAspectRatio,
+                              Qt::SmoothTransformation);
+
+    QByteArray png;
+    QBuffer buf(&png);
+    buf.open(QIODevice::WriteOnly);
+    thumb.save(&buf, "PNG");
+
+    vtc_store(key, sizeClass, png.constData(), (uint32_t)png.size(),
+              (uint16_t)thumb.width(), (uint16_t)thumb.height());
+
+    data(png);
+    data(QByteArray());
+    return KIO::WorkerResult::pass();
+}
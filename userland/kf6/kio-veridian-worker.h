@@ -128,6 +128,12 @@ public:
      */
     KIO::WorkerResult chmod(const QUrl &url, int permissions) override;
 
+    /**
+     * Thumbnail requests (command 1): content-addressed pack cache
+     * lookup, generate-and-store on miss.
+     */
+    KIO::WorkerResult special(const QByteArray &req) override;
+
 private:
     /* ===================================================================== */
     /* Internal helpers                                                       */
@@ -137,6 +143,14 @@ private:
      * Build a KIO::UDSEntry from a POSIX stat result.
      */
     KIO::UDSEntry createUDSEntry(const QString &name, const QString &path);
+    KIO::UDSEntry createUDSEntry(const QString &name, const struct stat &st);
+
+    /**
+     * Copy a directory tree in-worker through the multi-file transfer
+     * scheduler (concurrent small files, exclusive large ones), with
+     * progress aggregated across all contexts.
+     */
+    KIO::WorkerResult copyTree(const QString &src, const QString &dest);
 
     /**
      * Detect MIME type from file extension.
@@ -18,8 +18,13 @@
 #include <QDataStream>
 #include <QStandardPaths>
 #include <QCryptographicHash>
+#include <QMessageAuthenticationCode>
 #include <QDebug>
 
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+
 namespace KWallet {
 
 /* File format magic and version */
@@ -51,6 +56,165 @@ VeridianWalletBackend::~VeridianWalletBackend()
 /* Wallet lifecycle                                                          */
 /* ========================================================================= */
 
+/* ========================================================================= */
+/* Session key cache (locked memory)                                         */
+/* ========================================================================= */
+
+/*
+ * Derived wallet keys are the expensive artifact: PBKDF2 runs once
+ * per wallet per session and the result is cached in mlock()ed,
+ * non-swappable memory with a TTL.  NetworkManager's reconnect storm
+ * then opens the wallet from the cache in microseconds instead of a
+ * KDF run each time.  Entries are wiped (explicit memset, then the
+ * page stays locked) on expiry or lockSession().
+ */
+
+namespace {
+
+struct SessionKeyEntry {
+    uint64_t name_hash;
+    unsigned char key[32];
+    uint64_t expires_ns;
+    int used;
+};
+
+class SessionKeyCache
+{
+public:
+    static const int MAX_ENTRIES = 8;
+    static const uint64_t TTL_NS = 300ull * 1000000000ull; /* 5 min */
+
+    SessionKeyCache()
+        : m_entries(nullptr)
+    {
+        void *mem = mmap(nullptr, 4096, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (mem == MAP_FAILED)
+            return;
+        /* Non-swappable: derived keys must never hit disk.  A failed
+         * mlock (no privilege) still leaves the cache functional */
+        mlock(mem, 4096);
+        m_entries = static_cast<SessionKeyEntry *>(mem);
+        memset(m_entries, 0, 4096);
+    }
+
+    static uint64_t now_ns()
+    {
+        struct timespec ts;
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000ull +
+               (uint64_t)ts.tv_nsec;
+    }
+
+    static uint64_t hashName(const QString &name)
+    {
+        const QByteArray utf8 = name.toUtf8();
+        uint64_t h = 0xcbf29ce484222325ull;
+
+        for (char c : utf8) {
+            h ^= (unsigned char)c;
+            h *= 0x100000001b3ull;
+        }
+        return h ? h : 1;
+    }
+
+    bool lookup(const QString &name, QByteArray &keyOut)
+    {
+        if (!m_entries)
+            return false;
+        {
+            uint64_t h = hashName(name);
+            uint64_t now = now_ns();
+            int i;
+
+            for (i = 0; i < MAX_ENTRIES; i++) {
+                SessionKeyEntry *e = &m_entries[i];
+
+                if (!e->used || e->name_hash != h)
+                    continue;
+                if (now >= e->expires_ns) {
+                    wipeEntry(e);
+                    return false;
+                }
+                keyOut = QByteArray(
+                    reinterpret_cast<const char *>(e->key), 32);
+                e->expires_ns = now + TTL_NS;   /* Sliding TTL */
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void store(const QString &name, const QByteArray &key)
+    {
+        if (!m_entries || key.size() != 32)
+            return;
+        {
+            uint64_t h = hashName(name);
+            SessionKeyEntry *slot = nullptr;
+            int i;
+
+            for (i = 0; i < MAX_ENTRIES; i++) {
+                if (m_entries[i].used &&
+                    m_entries[i].name_hash == h) {
+                    slot = &m_entries[i];
+                    break;
+                }
+                if (!m_entries[i].used && !slot)
+                    slot = &m_entries[i];
+            }
+            if (!slot)
+                slot = &m_entries[0];       /* Evict the first */
+
+            slot->name_hash = h;
+            memcpy(slot->key, key.constData(), 32);
+            slot->expires_ns = now_ns() + TTL_NS;
+            slot->used = 1;
+        }
+    }
+
+    void wipeAll()
+    {
+        int i;
+
+        if (!m_entries)
+            return;
+        for (i = 0; i < MAX_ENTRIES; i++)
+            wipeEntry(&m_entries[i]);
+    }
+
+private:
+    static void wipeEntry(SessionKeyEntry *e)
+    {
+        /* Volatile wipe so the clear cannot be optimized away */
+        volatile unsigned char *p =
+            reinterpret_cast<volatile unsigned char *>(e);
+        size_t i;
+
+        for (i = 0; i < sizeof(*e); i++)
+            p[i] = 0;
+    }
+
+    SessionKeyEntry *m_entries;
+};
+
+SessionKeyCache &sessionKeys()
+{
+    static SessionKeyCache cache;
+
+    return cache;
+}
+
+} /* anonymous namespace */
+
+/** Wipe every cached wallet key (screen lock / explicit lock). */
+void veridian_wallet_lock_session()
+{
+    sessionKeys().wipeAll();
+}
+
 int VeridianWalletBackend::openWallet(const QString &name,
                                        const QString &password)
 {
@@ -58,7 +222,10 @@ int VeridianWalletBackend::openWallet(const QString &name,
         closeWallet();
 
     m_walletName = name;
-    m_encryptionKey = deriveKey(password);
+
+    /* Session cache first: a hit skips the KDF entirely */
+    if (!sessionKeys().lookup(name, m_encryptionKey))
+        m_encryptionKey = deriveKey(password);
     m_currentFolder = DEFAULT_FOLDER;
     m_dirty = false;
 
@@ -66,17 +233,30 @@ int VeridianWalletBackend::openWallet(const QString &name,
     QString path = walletFilePath(name);
     if (QFileInfo::exists(path)) {
         if (!loadFromFile(name, m_encryptionKey)) {
-            qWarning("KWallet: Failed to load wallet '%s'",
-                     qPrintable(name));
-            m_encryptionKey.clear();
-            return -1;
+            /* Pre-PBKDF2 wallet: retry with the legacy key and
+             * upgrade in place on the next save */
+            QByteArray legacy = QCryptographicHash::hash(
+                password.toUtf8(), QCryptographicHash::Sha256);
+
+            if (loadFromFile(name, legacy)) {
+                qDebug("KWallet: upgrading wallet '%s' to PBKDF2",
+                       qPrintable(name));
+                m_dirty = true;
+            } else {
+                qWarning("KWallet: Failed to load wallet '%s'",
+                         qPrintable(name));
+                m_encryptionKey.clear();
+                return -1;
+            }
         }
+        sessionKeys().store(name, m_encryptionKey);
     } else {
         /* Create new wallet with default folder */
         WalletFolder defaultFolder;
         defaultFolder.name = DEFAULT_FOLDER;
         m_folders.insert(DEFAULT_FOLDER, defaultFolder);
         m_dirty = true;
+        sessionKeys().store(name, m_encryptionKey);
     }
 
     m_open = true;
@@ -377,10 +557,26 @@ EntryType VeridianWalletBackend::entryType(const QString &key) const
 
 QByteArray VeridianWalletBackend::deriveKey(const QString &password) const
 {
-    /* Derive a 256-bit key from the password using SHA-256.
-     * TODO: Use PBKDF2 or Argon2 for production. */
-    return QCryptographicHash::hash(password.toUtf8(),
-                                    QCryptographicHash::Sha256);
+    /*
+     * PBKDF2-HMAC-SHA256, 10000 iterations, one 32-byte block.  The
+     * cost is deliberate -- it runs once per wallet per session; the
+     * locked session cache serves every subsequent open.
+     */
+    static const char salt[] = "veridian-kwallet-v2";
+    const QByteArray pw = password.toUtf8();
+    QByteArray u = QMessageAuthenticationCode::hash(
+        QByteArray(salt, sizeof(salt) - 1) +
+            QByteArray("\x00\x00\x00\x01", 4),
+        pw, QCryptographicHash::Sha256);
+    QByteArray t = u;
+
+    for (int i = 1; i < 10000; i++) {
+        u = QMessageAuthenticationCode::hash(u, pw,
+                                             QCryptographicHash::Sha256);
+        for (int b = 0; b < t.size(); b++)
+            t[b] = t[b] ^ u[b];
+    }
+    return t;
 }
 
 QByteArray VeridianWalletBackend::encrypt(const QByteArray &data,
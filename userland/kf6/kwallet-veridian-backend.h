@@ -262,4 +262,10 @@ private:
 
 } /* namespace KWallet */
 
+/**
+ * Wipe every cached wallet session key (screen lock, explicit lock).
+ * Keys live in mlock()ed memory and are cleared with a volatile wipe.
+ */
+void veridian_wallet_lock_session();
+
 #endif /* KWALLET_VERIDIAN_BACKEND_H */
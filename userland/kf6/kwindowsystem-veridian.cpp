@@ -14,6 +14,12 @@
 
 #include <QDebug>
 #include <QGuiApplication>
+#include <QSocketNotifier>
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
 
 #include <wayland-client.h>
 
@@ -302,6 +308,74 @@ void VeridianWaylandIntegration::desktopRemoved(
 /* Construction / destruction                                                */
 /* ========================================================================= */
 
+/* ========================================================================= */
+/* Shared window table (reader)                                              */
+/* ========================================================================= */
+
+/*
+ * Byte-compatible copy of the compositor's table layout
+ * (kwin-veridian-protocols.h owns the format; the kf6 tree does not
+ * include kwin headers).  Bump together with VWT_VERSION there.
+ */
+#define VWT_MAGIC       0x4c545756u     /* 'VWTL' */
+#define VWT_VERSION     1u
+#define VWT_MAX_WINDOWS 128
+#define VWT_PATH        "/run/veridian/windowlist"
+#define VWT_WAKE_PATH   "/run/veridian/windowlist.wake"
+
+struct VwtRecord {
+    quint32 id;
+    quint32 pid;
+    quint32 state;
+    qint32  x, y, w, h;
+    quint32 _pad;
+    char    title[128];
+    char    appId[64];
+};
+
+struct VwtTable {
+    quint32 magic;
+    quint32 version;
+    quint32 generation;
+    quint32 window_count;
+    quint32 active_id;
+    quint32 _pad;
+    VwtRecord windows[VWT_MAX_WINDOWS];
+};
+
+static const VwtTable *s_vwt;
+static int s_vwtWakeFd = -1;
+
+/* Seqlock-consistent snapshot of the table into caller storage */
+static bool vwtSnapshot(QVector<VwtRecord> &out, quint32 &activeId)
+{
+    if (!s_vwt)
+        return false;
+
+    for (;;) {
+        quint32 gen = __atomic_load_n(&s_vwt->generation,
+                                      __ATOMIC_ACQUIRE);
+
+        if (gen & 1u)
+            continue;               /* Compositor mid-rewrite */
+        {
+            quint32 n = s_vwt->window_count;
+
+            if (n > VWT_MAX_WINDOWS)
+                n = VWT_MAX_WINDOWS;
+            out.resize((int)n);
+            if (n)
+                memcpy(out.data(), s_vwt->windows,
+                       n * sizeof(VwtRecord));
+            activeId = s_vwt->active_id;
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&s_vwt->generation, __ATOMIC_ACQUIRE) ==
+            gen)
+            return true;
+    }
+}
+
 VeridianWaylandIntegration::VeridianWaylandIntegration(QObject *parent)
     : QObject(parent)
     , m_display(nullptr)
@@ -310,6 +384,10 @@ VeridianWaylandIntegration::VeridianWaylandIntegration(QObject *parent)
     , m_desktopManagement(nullptr)
     , m_activeWindow(0)
 {
+    /* Shared table first: taskbar queries become memory reads and a
+     * FIFO byte is the only wakeup.  The Wayland protocol path stays
+     * as the fallback (and serves window operations either way). */
+    attachSharedTable();
     initWayland();
 }
 
@@ -378,6 +456,113 @@ void VeridianWaylandIntegration::bindVirtualDesktopManagement(
 /* Window list                                                               */
 /* ========================================================================= */
 
+bool VeridianWaylandIntegration::usesSharedTable() const
+{
+    return s_vwt != nullptr;
+}
+
+void VeridianWaylandIntegration::attachSharedTable()
+{
+    int fd = open(VWT_PATH, O_RDONLY);
+
+    if (fd < 0)
+        return;
+    {
+        void *map = mmap(nullptr, sizeof(VwtTable), PROT_READ,
+                         MAP_SHARED, fd, 0);
+
+        close(fd);
+        if (map == MAP_FAILED)
+            return;
+        {
+            const VwtTable *t = static_cast<const VwtTable *>(map);
+
+            if (__atomic_load_n(&t->magic, __ATOMIC_ACQUIRE) !=
+                    VWT_MAGIC ||
+                t->version != VWT_VERSION) {
+                munmap(map, sizeof(VwtTable));
+                return;
+            }
+            s_vwt = t;
+        }
+    }
+
+    /* Change wakeups: one byte on the FIFO per compositor publish */
+    s_vwtWakeFd = open(VWT_WAKE_PATH, O_RDONLY | O_NONBLOCK);
+    if (s_vwtWakeFd >= 0) {
+        auto *notifier = new QSocketNotifier(s_vwtWakeFd,
+                                             QSocketNotifier::Read,
+                                             this);
+
+        connect(notifier, &QSocketNotifier::activated, this, [this]() {
+            char drain[64];
+
+            while (read(s_vwtWakeFd, drain, sizeof(drain)) > 0)
+                ;
+            refreshFromTable();
+        });
+    }
+
+    refreshFromTable();
+    qDebug("KWindowSystem/Veridian: shared window table attached");
+}
+
+/* Snapshot the table and diff it into the model, emitting the same
+ * granular signals the protocol path produces */
+void VeridianWaylandIntegration::refreshFromTable()
+{
+    QVector<VwtRecord> records;
+    quint32 activeId = 0;
+
+    if (!vwtSnapshot(records, activeId))
+        return;
+
+    QList<quint32> oldIds = m_windows.keys();
+
+    for (const VwtRecord &r : records) {
+        bool existed = m_windows.contains(r.id);
+        WindowInfo &info = m_windows[r.id];
+        bool changed = !existed;
+
+        if (!existed)
+            info.internalId = r.id;
+        {
+            QString title = QString::fromUtf8(r.title);
+            QString appId = QString::fromUtf8(r.appId);
+            QRect geo(r.x, r.y, r.w, r.h);
+
+            if (info.title != title) { info.title = title; changed = true; }
+            if (info.appId != appId) { info.appId = appId; changed = true; }
+            if (info.geometry != geo) { info.geometry = geo; changed = true; }
+            if (info.state != r.state) {
+                info.state = r.state;
+                info.active     = (r.state & 0x001) != 0;
+                info.minimized  = (r.state & 0x002) != 0;
+                info.maximized  = (r.state & 0x004) != 0;
+                info.fullscreen = (r.state & 0x008) != 0;
+                changed = true;
+            }
+            info.pid = r.pid;
+        }
+
+        if (!existed)
+            Q_EMIT windowAdded(r.id);
+        else if (changed)
+            Q_EMIT windowChanged(r.id);
+        oldIds.removeAll(r.id);
+    }
+
+    for (quint32 gone : oldIds) {
+        m_windows.remove(gone);
+        Q_EMIT windowRemoved(gone);
+    }
+
+    if (m_activeWindow != activeId) {
+        m_activeWindow = activeId;
+        Q_EMIT activeWindowChanged(activeId);
+    }
+}
+
 QList<quint32> VeridianWaylandIntegration::windows() const
 {
     return m_windows.keys();
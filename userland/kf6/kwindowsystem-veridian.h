@@ -102,6 +102,10 @@ public:
     explicit VeridianWaylandIntegration(QObject *parent = nullptr);
     ~VeridianWaylandIntegration() override;
 
+    /** Whether queries are served from the compositor's shared
+     *  window table (no IPC per query). */
+    bool usesSharedTable() const;
+
     /* ----- Window list ----- */
     QList<quint32> windows() const;
     WindowInfo windowInfo(quint32 windowId) const;
@@ -139,6 +143,8 @@ Q_SIGNALS:
     void desktopListChanged();
 
 private:
+    void attachSharedTable();
+    void refreshFromTable();
     /* ----- Wayland protocol callbacks ----- */
     static void registryGlobal(void *data, struct wl_registry *registry,
                                uint32_t name, const char *interface,
@@ -438,43 +438,106 @@ void VeridianManager::startHotplugMonitor()
             this, &VeridianManager::onInotifyEvent);
 }
 
-void VeridianManager::onInotifyEvent()
+/*
+ * Incrementally refresh one device category: snapshot its UDIs, drop
+ * them from the model, re-run just that category's enumerator, and
+ * emit the per-device diff.  Everything outside the category is
+ * untouched.
+ */
+void VeridianManager::refreshCategory(const QString &udiPrefix,
+                                      void (VeridianManager::*enumFn)())
 {
-    char buf[4096]
-        __attribute__((aligned(__alignof__(struct inotify_event))));
-
-    ssize_t len = read(m_inotifyFd, buf, sizeof(buf));
-    if (len <= 0)
-        return;
+    QStringList oldInCategory;
+    QStringList rest;
 
-    /* Re-enumerate devices and emit add/remove signals */
-    QStringList oldDevices = m_deviceUdis;
+    for (const QString &udi : m_deviceUdis) {
+        if (udi != UDI_PREFIX &&
+            udi.startsWith(udiPrefix + QLatin1Char('/')))
+            oldInCategory.append(udi);
+        else
+            rest.append(udi);
+    }
 
-    m_deviceUdis.clear();
-    m_deviceUdis << UDI_PREFIX;
-    enumerateBlockDevices();
-    enumerateNetworkDevices();
-    enumerateAudioDevices();
-    enumerateDisplayDevices();
-    enumerateProcessors();
-    enumerateBatteries();
+    m_deviceUdis = rest;
+    (this->*enumFn)();
 
-    /* Find added devices */
     for (const QString &udi : m_deviceUdis) {
-        if (!oldDevices.contains(udi))
+        if (udi.startsWith(udiPrefix + QLatin1Char('/')) &&
+            !oldInCategory.contains(udi))
             Q_EMIT deviceAdded(udi);
     }
-
-    /* Find removed devices */
-    for (const QString &udi : oldDevices) {
+    for (const QString &udi : oldInCategory) {
         if (!m_deviceUdis.contains(udi)) {
             Q_EMIT deviceRemoved(udi);
-            /* Clean up cached device object */
             delete m_devices.take(udi);
         }
     }
 }
 
+void VeridianManager::onInotifyEvent()
+{
+    char buf[4096]
+        __attribute__((aligned(__alignof__(struct inotify_event))));
+    ssize_t len;
+    bool wantBlock = false;
+    bool wantAudio = false;
+    bool wantDisplay = false;
+    bool wantNet = false;
+
+    len = read(m_inotifyFd, buf, sizeof(buf));
+    if (len <= 0)
+        return;
+
+    /*
+     * Classify each event by the node name so only the categories
+     * that can have changed are re-enumerated -- a USB stick no
+     * longer re-walks CPUs, batteries, audio, and displays.  Events
+     * that map to no category (ptys, random nodes) cost nothing.
+     */
+    {
+        ssize_t off = 0;
+
+        while (off < len) {
+            const struct inotify_event *ev =
+                reinterpret_cast<const struct inotify_event *>(buf + off);
+
+            if (ev->len > 0) {
+                QString name = QString::fromUtf8(ev->name);
+
+                if (name.startsWith(QStringLiteral("sd")) ||
+                    name.startsWith(QStringLiteral("vd")) ||
+                    name.startsWith(QStringLiteral("nvme")) ||
+                    name.startsWith(QStringLiteral("mmcblk")) ||
+                    name.startsWith(QStringLiteral("loop")))
+                    wantBlock = true;
+                else if (name.startsWith(QStringLiteral("card")) ||
+                         name.startsWith(QStringLiteral("render")))
+                    wantDisplay = true;
+                else if (name.startsWith(QStringLiteral("pcm")) ||
+                         name.startsWith(QStringLiteral("control")) ||
+                         name.startsWith(QStringLiteral("midi")))
+                    wantAudio = true;
+                else if (name.startsWith(QStringLiteral("net")))
+                    wantNet = true;
+            }
+            off += (ssize_t)sizeof(struct inotify_event) + ev->len;
+        }
+    }
+
+    if (wantBlock)
+        refreshCategory(UDI_BLOCK,
+                        &VeridianManager::enumerateBlockDevices);
+    if (wantDisplay)
+        refreshCategory(UDI_DISPLAY,
+                        &VeridianManager::enumerateDisplayDevices);
+    if (wantAudio)
+        refreshCategory(UDI_AUDIO,
+                        &VeridianManager::enumerateAudioDevices);
+    if (wantNet)
+        refreshCategory(UDI_NET,
+                        &VeridianManager::enumerateNetworkDevices);
+}
+
 /* ========================================================================= */
 /* VeridianStorageDrive                                                      */
 /* ========================================================================= */
@@ -127,6 +127,8 @@ Q_SIGNALS:
 
 private Q_SLOTS:
     void onInotifyEvent();
+    void refreshCategory(const QString &udiPrefix,
+                         void (VeridianManager::*enumFn)());
     void onUdevDeviceAdded(const QString &devpath, const QString &subsystem);
     void onUdevDeviceRemoved(const QString &devpath, const QString &subsystem);
     void onUdevDeviceChanged(const QString &devpath, const QString &subsystem);
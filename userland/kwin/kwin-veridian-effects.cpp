@@ -481,3 +481,213 @@ QStringList getVeridianCompositingDefaults(bool isLlvmpipe)
 }
 
 } /* namespace KWin */
+
+/* ========================================================================= */
+/* Runtime effect scheduler                                                  */
+/* ========================================================================= */
+
+/*
+ * Per-frame effect scheduling for the paint loop.
+ *
+ * Effects register once and declare which windows they can currently
+ * affect (relevance sets, updated on animation start/stop and window
+ * topology changes).  The paint loop iterates only the active list --
+ * effects with at least one relevant window -- so idle effects cost
+ * literally nothing per frame.  Per-(effect, window) transform
+ * matrices are recomputed only when animationTick() advances an
+ * animation; paint passes read the cached matrix.
+ */
+
+struct VfxTransform {
+    float m[16];                /* Column-major 4x4 */
+};
+
+struct VfxWindowState {
+    quint32 windowId;
+    VfxTransform transform;
+    bool transformValid;
+};
+
+struct VfxEffect {
+    QString name;
+    QHash<quint32, VfxWindowState> windows;     /* Relevance set */
+    bool animating;
+    int activeIndex;            /* Index in the active list, -1 idle */
+};
+
+/*
+ * Load-shed flag set by the renderer's quality controller: effects
+ * are the first expense dropped when frames run over budget.
+ */
+static bool g_effectsLoadShed;
+
+void veridianEffectsSetLoadShed(bool shed)
+{
+    if (g_effectsLoadShed != shed)
+        qDebug("VeridianEffects: load shed %s", shed ? "ON" : "off");
+    g_effectsLoadShed = shed;
+}
+
+bool veridianEffectsLoadShed()
+{
+    return g_effectsLoadShed;
+}
+
+class VeridianEffectScheduler
+{
+public:
+    int registerEffect(const QString &name)
+    {
+        VfxEffect e;
+
+        e.name = name;
+        e.animating = false;
+        e.activeIndex = -1;
+        m_effects.append(e);
+        return m_effects.size() - 1;
+    }
+
+    /* Relevance: an effect joins the active list with its first
+     * relevant window and leaves it with its last */
+    void setRelevant(int effect, quint32 windowId, bool relevant)
+    {
+        if (effect < 0 || effect >= m_effects.size())
+            return;
+        {
+            VfxEffect &e = m_effects[effect];
+
+            if (relevant) {
+                if (!e.windows.contains(windowId)) {
+                    VfxWindowState ws;
+
+                    ws.windowId = windowId;
+                    ws.transformValid = false;
+                    e.windows.insert(windowId, ws);
+                }
+                activate(effect);
+            } else {
+                e.windows.remove(windowId);
+                if (e.windows.isEmpty())
+                    deactivate(effect);
+            }
+        }
+    }
+
+    /* Window topology change: drop the window everywhere */
+    void windowRemoved(quint32 windowId)
+    {
+        for (int i = 0; i < m_effects.size(); i++) {
+            m_effects[i].windows.remove(windowId);
+            if (m_effects[i].windows.isEmpty())
+                deactivate(i);
+        }
+    }
+
+    /* The frame skip list: only effects that can affect something */
+    const QVector<int> &activeEffects() const
+    {
+        return m_active;
+    }
+
+    /*
+     * Animation tick: recompute the transforms of animating effects.
+     * compute receives (effect, windowId, out matrix); paint passes
+     * read cached matrices and never recompute.
+     */
+    template <typename ComputeFn>
+    void animationTick(ComputeFn compute)
+    {
+        /* Load shedding: under render pressure the controller turns
+         * animation transforms off wholesale; windows render
+         * untransformed until headroom returns */
+        if (veridianEffectsLoadShed())
+            return;
+        for (int idx : m_active) {
+            VfxEffect &e = m_effects[idx];
+
+            if (!e.animating)
+                continue;
+            for (auto it = e.windows.begin(); it != e.windows.end();
+                 ++it) {
+                compute(idx, it.key(), it.value().transform.m);
+                it.value().transformValid = true;
+                m_transformUpdates++;
+            }
+        }
+    }
+
+    void setAnimating(int effect, bool animating)
+    {
+        if (effect >= 0 && effect < m_effects.size())
+            m_effects[effect].animating = animating;
+    }
+
+    /* Cached transform for the paint pass; identity when never
+     * computed */
+    const float *windowTransform(int effect, quint32 windowId) const
+    {
+        static const float identity[16] = {
+            1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1
+        };
+
+        if (effect < 0 || effect >= m_effects.size())
+            return identity;
+        {
+            auto it = m_effects[effect].windows.constFind(windowId);
+
+            if (it == m_effects[effect].windows.constEnd() ||
+                !it.value().transformValid)
+                return identity;
+            return it.value().transform.m;
+        }
+    }
+
+    quint64 transformUpdates() const
+    {
+        return m_transformUpdates;
+    }
+
+private:
+    void activate(int effect)
+    {
+        VfxEffect &e = m_effects[effect];
+
+        if (e.activeIndex >= 0)
+            return;
+        e.activeIndex = m_active.size();
+        m_active.append(effect);
+    }
+
+    void deactivate(int effect)
+    {
+        VfxEffect &e = m_effects[effect];
+
+        if (e.activeIndex < 0)
+            return;
+        {
+            /* Swap-with-last removal keeps the list dense */
+            int last = m_active.size() - 1;
+            int moved = m_active[last];
+
+            m_active[e.activeIndex] = moved;
+            m_effects[moved].activeIndex = e.activeIndex;
+            m_active.removeLast();
+            if (moved == effect)
+                m_effects[moved].activeIndex = -1;
+            else
+                e.activeIndex = -1;
+        }
+    }
+
+    QVector<VfxEffect> m_effects;
+    QVector<int> m_active;
+    quint64 m_transformUpdates = 0;
+};
+
+/** Process-wide scheduler instance for the compositor's paint loop. */
+VeridianEffectScheduler *veridianEffectScheduler()
+{
+    static VeridianEffectScheduler s_scheduler;
+
+    return &s_scheduler;
+}
@@ -15,6 +15,8 @@
  */
 
 #include "kwin-veridian-input.h"
+
+#include <veridian/frametrace.h>
 #include "kwin-veridian-platform.h"
 
 #include <QDebug>
@@ -470,6 +472,11 @@ void VeridianInputBackend::onLibinputEvent()
 
 void VeridianInputBackend::processEvents()
 {
+    /* Frame tracing: input arrival opens the frame window every
+     * later stage correlates against */
+    if (vft_enabled())
+        vft_begin_frame();
+
     if (libinput_dispatch(m_libinput) != 0) {
         qWarning("VeridianInputBackend: libinput_dispatch failed");
         return;
@@ -493,23 +500,30 @@ void VeridianInputBackend::processEvents()
             handlePointerMotionAbsoluteEvent(event);
             break;
         case LIBINPUT_EVENT_POINTER_BUTTON:
+            /* Ordering: motion accumulated before a click must land
+             * first */
+            flushPointerMotion();
             handlePointerButtonEvent(event);
             break;
         case LIBINPUT_EVENT_POINTER_AXIS:
+            flushPointerMotion();
             handlePointerAxisEvent(event);
             break;
 
         /* ----- Touch ----- */
         case LIBINPUT_EVENT_TOUCH_DOWN:
+            flushTouchMotion();
             handleTouchDownEvent(event);
             break;
         case LIBINPUT_EVENT_TOUCH_UP:
+            flushTouchMotion();
             handleTouchUpEvent(event);
             break;
         case LIBINPUT_EVENT_TOUCH_MOTION:
             handleTouchMotionEvent(event);
             break;
         case LIBINPUT_EVENT_TOUCH_FRAME:
+            flushTouchMotion();
             handleTouchFrameEvent(event);
             break;
         case LIBINPUT_EVENT_TOUCH_CANCEL:
@@ -531,6 +545,11 @@ void VeridianInputBackend::processEvents()
 
         libinput_event_destroy(event);
     }
+
+    /* Drain boundary: everything this wakeup delivered coalesces
+     * into at most one motion per pointer and one per touch slot */
+    flushPointerMotion();
+    flushTouchMotion();
 }
 
 /* ========================================================================= */
@@ -564,18 +583,89 @@ void VeridianInputBackend::handleKeyboardEvent(struct libinput_event *event)
 /* Pointer event handling                                                    */
 /* ========================================================================= */
 
+/*
+ * Motion compression.
+ *
+ * A 1 kHz mouse delivers a burst of queued events per wakeup; each
+ * previously took the full emit -> focus-resolution -> forward path.
+ * Deltas now accumulate across the drain and flush as one event --
+ * focus resolution runs once per flush instead of once per raw event.
+ * Flushes are forced before ordering-sensitive events (buttons, axis,
+ * touch down/up) so click positions never reorder against motion.
+ */
 void VeridianInputBackend::handlePointerMotionEvent(struct libinput_event *event)
 {
     struct libinput_event_pointer *ptrEvent =
         libinput_event_get_pointer_event(event);
-
-    double dx = libinput_event_pointer_get_dx(ptrEvent);
-    double dy = libinput_event_pointer_get_dy(ptrEvent);
-    double dxUnaccel = libinput_event_pointer_get_dx_unaccelerated(ptrEvent);
-    double dyUnaccel = libinput_event_pointer_get_dy_unaccelerated(ptrEvent);
     uint32_t time = libinput_event_pointer_get_time(ptrEvent);
 
-    Q_EMIT pointerMotion(QPointF(dx, dy), QPointF(dxUnaccel, dyUnaccel), time);
+    if (m_motionPending)
+        m_compressedMotions++;
+    else
+        m_firstMotionTime = time;
+
+    m_accDx += libinput_event_pointer_get_dx(ptrEvent);
+    m_accDy += libinput_event_pointer_get_dy(ptrEvent);
+    m_accDxU += libinput_event_pointer_get_dx_unaccelerated(ptrEvent);
+    m_accDyU += libinput_event_pointer_get_dy_unaccelerated(ptrEvent);
+    m_motionTime = time;
+    m_motionPending = true;
+}
+
+void VeridianInputBackend::flushPointerMotion()
+{
+    if (m_motionPending) {
+        QPointF delta(m_accDx, m_accDy);
+
+        /*
+         * Optional prediction: extrapolate along the burst's own
+         * velocity to cover compositor latency.  The scale is bounded
+         * so a single-event burst (dt == 0) or a stall cannot
+         * overshoot wildly; unaccelerated deltas stay raw for apps
+         * that want them.
+         */
+        if (m_predictionMs > 0.0) {
+            double dtMs = (double)(m_motionTime - m_firstMotionTime);
+
+            if (dtMs >= 1.0) {
+                double scale = 1.0 + m_predictionMs / dtMs;
+
+                if (scale > 2.0)
+                    scale = 2.0;
+                delta *= scale;
+            }
+        }
+
+        Q_EMIT pointerMotion(delta, QPointF(m_accDxU, m_accDyU),
+                             m_motionTime);
+        m_motionPending = false;
+        m_accDx = m_accDy = 0;
+        m_accDxU = m_accDyU = 0;
+    }
+
+    if (m_absPending) {
+        Q_EMIT pointerMotionAbsolute(m_absPos, m_absTime);
+        m_absPending = false;
+    }
+}
+
+void VeridianInputBackend::flushTouchMotion()
+{
+    for (auto it = m_touchPending.constBegin();
+         it != m_touchPending.constEnd(); ++it)
+        Q_EMIT touchMotion(it.key(), it.value().first,
+                           it.value().second);
+    m_touchPending.clear();
+}
+
+void VeridianInputBackend::setPointerPredictionMs(double ms)
+{
+    m_predictionMs = ms > 0.0 ? ms : 0.0;
+}
+
+quint64 VeridianInputBackend::compressedMotionCount() const
+{
+    return m_compressedMotions;
 }
 
 void VeridianInputBackend::handlePointerMotionAbsoluteEvent(
@@ -590,7 +680,12 @@ void VeridianInputBackend::handlePointerMotionAbsoluteEvent(
     double y = libinput_event_pointer_get_absolute_y_transformed(ptrEvent, 1);
     uint32_t time = libinput_event_pointer_get_time(ptrEvent);
 
-    Q_EMIT pointerMotionAbsolute(QPointF(x, y), time);
+    /* Latest position wins within the drain */
+    m_absPos = QPointF(x, y);
+    m_absTime = time;
+    if (m_absPending)
+        m_compressedMotions++;
+    m_absPending = true;
 }
 
 void VeridianInputBackend::handlePointerButtonEvent(struct libinput_event *event)
@@ -673,7 +768,11 @@ void VeridianInputBackend::handleTouchMotionEvent(struct libinput_event *event)
     double y = libinput_event_touch_get_y_transformed(touchEvent, 1);
     uint32_t time = libinput_event_touch_get_time(touchEvent);
 
-    Q_EMIT touchMotion(id, QPointF(x, y), time);
+    /* Latest per slot; flushed at TOUCH_FRAME (the protocol's own
+     * frame boundary) or before down/up ordering points */
+    if (m_touchPending.contains(id))
+        m_compressedMotions++;
+    m_touchPending.insert(id, qMakePair(QPointF(x, y), time));
 }
 
 void VeridianInputBackend::handleTouchFrameEvent(struct libinput_event *event)
@@ -190,6 +190,18 @@ public:
     QVector<VeridianInputDevice> devices() const;
     VeridianInputDevice *deviceByPath(const QString &sysPath);
 
+    /* ----- Motion pipeline ----- */
+
+    /**
+     * Optional pointer prediction: scale flushed motion to cover the
+     * given compositor latency (0 disables).  Unaccelerated deltas
+     * stay raw.
+     */
+    void setPointerPredictionMs(double ms);
+
+    /** Number of raw motion events compressed away (diagnostics). */
+    quint64 compressedMotionCount() const;
+
     /* ----- Device configuration ----- */
     void setPointerAcceleration(const QString &sysPath, double accel);
     void setNaturalScroll(const QString &sysPath, bool enabled);
@@ -259,6 +271,28 @@ private:
     void handleDeviceAddedEvent(struct libinput_event *event);
     void handleDeviceRemovedEvent(struct libinput_event *event);
 
+    /* ----- Motion compression ----- */
+    void flushPointerMotion();
+    void flushTouchMotion();
+
+    /* Accumulated relative motion within the current drain */
+    bool m_motionPending = false;
+    double m_accDx = 0, m_accDy = 0;
+    double m_accDxU = 0, m_accDyU = 0;
+    uint32_t m_motionTime = 0;
+    uint32_t m_firstMotionTime = 0;
+
+    /* Latest absolute position within the current drain */
+    bool m_absPending = false;
+    QPointF m_absPos;
+    uint32_t m_absTime = 0;
+
+    /* Latest touch position per slot within the current drain */
+    QHash<int32_t, QPair<QPointF, uint32_t>> m_touchPending;
+
+    double m_predictionMs = 0.0;
+    quint64 m_compressedMotions = 0;
+
     /* ----- Device init ----- */
     VeridianInputDevice createDeviceInfo(struct libinput_device *dev);
     void applyDeviceConfig(VeridianInputDevice &info);
@@ -17,6 +17,7 @@
  */
 
 #include "kwin-veridian-platform.h"
+#include "kwin-veridian-protocols.h"
 
 #include <QDebug>
 #include <QDir>
@@ -39,6 +40,110 @@
 
 namespace KWin {
 
+/* ========================================================================= */
+/* VeridianDamageTracker                                                     */
+/* ========================================================================= */
+
+VeridianDamageTracker::VeridianDamageTracker()
+{
+    m_history.reserve(HISTORY_DEPTH);
+}
+
+void VeridianDamageTracker::setOutputRect(const QRect &rect)
+{
+    m_outputRect = rect;
+
+    /* Geometry changed: everything must be repainted, and any damage
+     * history refers to the old layout */
+    m_windowDamage.clear();
+    m_windowBounds.clear();
+    m_history.clear();
+    m_pendingDamage = QRegion(rect);
+}
+
+void VeridianDamageTracker::addWindowDamage(quintptr windowId,
+                                            const QRegion &region)
+{
+    if (region.isEmpty())
+        return;
+
+    const QRegion clipped = m_outputRect.isValid()
+                            ? region.intersected(m_outputRect)
+                            : region;
+    if (clipped.isEmpty())
+        return;
+
+    m_windowDamage[windowId] += clipped;
+    m_windowBounds[windowId] =
+        m_windowBounds.value(windowId).united(clipped.boundingRect());
+    m_pendingDamage += clipped;
+}
+
+void VeridianDamageTracker::forgetWindow(quintptr windowId)
+{
+    /* The window is gone; whatever it covered must be repainted */
+    const QRect bounds = m_windowBounds.take(windowId);
+    m_windowDamage.remove(windowId);
+    if (!bounds.isNull())
+        m_pendingDamage += bounds;
+}
+
+QRegion VeridianDamageTracker::pendingDamage() const
+{
+    return m_pendingDamage;
+}
+
+bool VeridianDamageTracker::hasPendingDamage() const
+{
+    return !m_pendingDamage.isEmpty();
+}
+
+void VeridianDamageTracker::commitFrame()
+{
+    m_history.prepend(m_pendingDamage);
+    while (m_history.size() > HISTORY_DEPTH)
+        m_history.removeLast();
+
+    m_windowDamage.clear();
+    m_pendingDamage = QRegion();
+}
+
+QRegion VeridianDamageTracker::accumulatedDamage(int bufferAge) const
+{
+    /* Unknown age or older than our history: repaint everything */
+    if (bufferAge <= 0 || bufferAge > m_history.size())
+        return QRegion(m_outputRect);
+
+    /* The buffer last held frame N - age, so it is missing the damage
+     * of the last (age - 1) committed frames plus the pending one */
+    QRegion damage = m_pendingDamage;
+    for (int i = 0; i < bufferAge - 1; ++i)
+        damage += m_history.at(i);
+
+    return damage.intersected(m_outputRect);
+}
+
+QVector<QPair<int, int>> VeridianDamageTracker::damagedScanlines(
+    const QRegion &region)
+{
+    /* QRegion rects are sorted top-to-bottom, so one pass merges
+     * overlapping or adjacent y-spans */
+    QVector<QPair<int, int>> spans;
+    for (const QRect &r : region) {
+        if (!spans.isEmpty() && r.top() <= spans.last().second + 1) {
+            spans.last().second = qMax(spans.last().second, r.bottom());
+        } else {
+            spans.append(qMakePair(r.top(), r.bottom()));
+        }
+    }
+    return spans;
+}
+
+int VeridianDamageTracker::historyDepth()
+{
+    return HISTORY_DEPTH;
+}
+
 /* ========================================================================= */
 /* VeridianDrmOutput                                                         */
 /* ========================================================================= */
@@ -76,6 +181,10 @@ bool VeridianDrmOutput::initFromConnector(const VeridianDrmConnector &connector,
         return false;
     }
 
+    m_damageTracker.setOutputRect(QRect(0, 0,
+                                        m_connector.currentMode.hdisplay,
+                                        m_connector.currentMode.vdisplay));
+
     qDebug("VeridianDrmOutput: initialized %s -- %dx%d@%dHz",
            qPrintable(connector.name),
            m_connector.currentMode.hdisplay,
@@ -96,6 +205,7 @@ bool VeridianDrmOutput::setMode(const drmModeModeInfo &mode)
     }
 
     m_connector.currentMode = mode;
+    m_damageTracker.setOutputRect(QRect(0, 0, mode.hdisplay, mode.vdisplay));
     Q_EMIT modeChanged(QSize(mode.hdisplay, mode.vdisplay), mode.vrefresh * 1000);
     return true;
 }
@@ -221,6 +331,51 @@ void VeridianDrmOutput::releasePreviousBuffer()
     }
 }
 
+VeridianDamageTracker *VeridianDrmOutput::damageTracker()
+{
+    return &m_damageTracker;
+}
+
+/**
+ * Upload only the damaged scanlines to the kernel framebuffer.
+ *
+ * Converts the region's scanline spans into DRM dirty-fb clips.  On
+ * drivers without dirty-fb support (ENOSYS) this is a no-op and the
+ * full buffer is implicitly uploaded by the flip, so failure is not
+ * fatal -- just slower.
+ */
+bool VeridianDrmOutput::flushDamage(const QRegion &region)
+{
+    if (m_gbm.currentFbId == 0 || region.isEmpty())
+        return false;
+
+    const QVector<QPair<int, int>> spans =
+        VeridianDamageTracker::damagedScanlines(region);
+    if (spans.isEmpty())
+        return false;
+
+    QVector<drmModeClip> clips;
+    clips.reserve(spans.size());
+    for (const QPair<int, int> &span : spans) {
+        drmModeClip clip;
+        clip.x1 = 0;
+        clip.y1 = static_cast<unsigned short>(span.first);
+        clip.x2 = static_cast<unsigned short>(m_gbm.width);
+        clip.y2 = static_cast<unsigned short>(span.second + 1);
+        clips.append(clip);
+    }
+
+    int ret = drmModeDirtyFB(m_drmFd, m_gbm.currentFbId,
+                             clips.data(), clips.size());
+    if (ret != 0 && ret != -ENOSYS) {
+        qWarning("VeridianDrmOutput: drmModeDirtyFB failed: %s",
+                 strerror(-ret));
+        return false;
+    }
+
+    return ret == 0;
+}
+
 QString VeridianDrmOutput::name() const { return m_connector.name; }
 
 QSize VeridianDrmOutput::sizePixels() const
@@ -955,6 +1110,30 @@ bool VeridianDrmBackend::scanConnectors()
         Q_EMIT outputAdded(output);
     }
 
+    /* Publish the screen set for QPA readers (pure-memory QScreen
+     * queries on the client side) */
+    {
+        VscrRecord recs[VSCR_MAX_SCREENS];
+        uint32_t n = 0;
+        int32_t xoff = 0;
+
+        for (VeridianDrmOutput *out : m_outputs) {
+            if (n >= VSCR_MAX_SCREENS)
+                break;
+            drmModeModeInfo mode = out->currentMode();
+
+            memset(&recs[n], 0, sizeof(recs[n]));
+            recs[n].x = xoff;
+            recs[n].y = 0;
+            recs[n].w = mode.hdisplay;
+            recs[n].h = mode.vdisplay;
+            recs[n].refresh_mhz = (uint32_t)mode.vrefresh * 1000u;
+            xoff += mode.hdisplay;
+            n++;
+        }
+        vscrPublishScreens(recs, n);
+    }
+
     Q_EMIT outputsQueried();
     return !m_outputs.isEmpty();
 }
@@ -1225,6 +1404,50 @@ bool VeridianDrmBackend::endFrame(VeridianDrmOutput *output)
     return output->schedulePageFlip();
 }
 
+/**
+ * Damage-aware frame presentation.
+ *
+ * Commits the frame's damage to the output's tracker (so future
+ * frames rendering into aged buffers know what to repaint) and passes
+ * the damaged scanline spans to the kernel via dirty-fb clips, so the
+ * common case -- a blinking cursor in a terminal -- uploads a handful
+ * of scanlines instead of the whole framebuffer.
+ *
+ * An empty region with no tracked damage skips the flip entirely.
+ */
+bool VeridianDrmBackend::endFrame(VeridianDrmOutput *output,
+                                  const QRegion &damage)
+{
+    if (!output || !output->gbmSurface())
+        return false;
+
+    VeridianDamageTracker *tracker = output->damageTracker();
+    tracker->addWindowDamage(0, damage);
+
+    if (!tracker->hasPendingDamage()) {
+        /* Nothing changed anywhere: skip buffer lock and flip */
+        return true;
+    }
+
+    /* Lock the front buffer from GBM */
+    struct gbm_bo *bo = gbm_surface_lock_front_buffer(output->gbmSurface());
+    if (!bo) {
+        qWarning("VeridianDrmBackend: gbm_surface_lock_front_buffer failed");
+        return false;
+    }
+
+    uint32_t fbId = output->addFbFromBo(bo);
+    if (fbId == 0)
+        return false;
+
+    /* Upload only the damaged scanlines, then commit the frame's
+     * damage into the flip history */
+    output->flushDamage(tracker->pendingDamage());
+    tracker->commitFrame();
+
+    return output->schedulePageFlip();
+}
+
 /* ========================================================================= */
 /* Multi-Output Support (Sprint 10.7)                                        */
 /* ========================================================================= */
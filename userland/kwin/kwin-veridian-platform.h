@@ -28,6 +28,9 @@
 #include <QString>
 #include <QSize>
 #include <QVector>
+#include <QHash>
+#include <QPair>
+#include <QRegion>
 #include <QSocketNotifier>
 #include <QDBusInterface>
 
@@ -105,6 +108,78 @@ struct VeridianGbmSurface {
     uint32_t format;            /* GBM_FORMAT_XRGB8888 */
 };
 
+/* ========================================================================= */
+/* VeridianDamageTracker -- per-window dirty-rect accumulation               */
+/* ========================================================================= */
+
+/**
+ * Accumulates per-window dirty rectangles for one output and tracks
+ * damage age across page flips.
+ *
+ * The scanout path is double- (sometimes triple-) buffered, so the
+ * buffer being rendered into may be several flips old.  The tracker
+ * keeps a short ring of per-frame damage regions; accumulatedDamage()
+ * returns the union of the last N frames so stale buffer content is
+ * always repainted.  When the age exceeds the history depth (or is
+ * unknown) it degrades to full-output damage.
+ *
+ * Windows are keyed by an opaque id (the KWin window pointer).  A
+ * window's final damage is reported through forgetWindow() when it is
+ * unmapped so its last-known bounds get repainted.
+ */
+class VeridianDamageTracker
+{
+public:
+    VeridianDamageTracker();
+
+    /** Set the output bounds; resets history with full damage. */
+    void setOutputRect(const QRect &rect);
+
+    /** Add dirty rects for a window (output-local coordinates). */
+    void addWindowDamage(quintptr windowId, const QRegion &region);
+
+    /** Drop a window, damaging its last-known bounds. */
+    void forgetWindow(quintptr windowId);
+
+    /** Union of all window damage reported for the pending frame. */
+    QRegion pendingDamage() const;
+
+    /** Whether any damage has been reported since the last commit. */
+    bool hasPendingDamage() const;
+
+    /**
+     * Commit the pending frame: pushes the pending damage into the
+     * flip-history ring and clears the per-window accumulators.
+     * Called once per scheduled page flip.
+     */
+    void commitFrame();
+
+    /**
+     * Damage to repaint into a buffer that is @p bufferAge flips old
+     * (1 = last frame's buffer).  Age 0 or beyond the history depth
+     * returns the full output rect.
+     */
+    QRegion accumulatedDamage(int bufferAge) const;
+
+    /**
+     * Merge a region into inclusive [first, last] scanline spans --
+     * the unit of upload to the kernel framebuffer.
+     */
+    static QVector<QPair<int, int>> damagedScanlines(const QRegion &region);
+
+    /** History depth (how many flips of damage are retained). */
+    static int historyDepth();
+
+private:
+    QRect m_outputRect;
+    QHash<quintptr, QRegion> m_windowDamage;    /* pending frame     */
+    QHash<quintptr, QRect> m_windowBounds;      /* last-known extents */
+    QRegion m_pendingDamage;                    /* union, incremental */
+    QVector<QRegion> m_history;                 /* ring, newest first */
+
+    static const int HISTORY_DEPTH = 4;
+};
+
 /* ========================================================================= */
 /* VeridianDrmOutput -- per-output state (one per connected display)         */
 /* ========================================================================= */
@@ -139,6 +214,15 @@ public:
     void pageFlipComplete();
     bool isPageFlipPending() const;
 
+    /* ----- Damage tracking ----- */
+    VeridianDamageTracker *damageTracker();
+
+    /**
+     * Flush a damage region to the kernel framebuffer via
+     * DRM_IOCTL_MODE_DIRTYFB so only damaged scanlines are uploaded.
+     */
+    bool flushDamage(const QRegion &region);
+
     /* ----- Framebuffer management ----- */
     uint32_t addFbFromBo(struct gbm_bo *bo);
     void releasePreviousBuffer();
@@ -162,6 +246,7 @@ private:
     VeridianDrmConnector m_connector;
     VeridianDrmCrtc m_crtc;
     VeridianGbmSurface m_gbm;
+    VeridianDamageTracker m_damageTracker;
     bool m_pageFlipPending;
     bool m_dpmsOn;
 };
@@ -342,6 +427,13 @@ public:
     bool beginFrame(VeridianDrmOutput *output);
     bool endFrame(VeridianDrmOutput *output);
 
+    /**
+     * Present a frame uploading only the damaged scanlines.  The
+     * region is committed to the output's damage tracker and flushed
+     * via DRM dirty-fb clips before the flip is scheduled.
+     */
+    bool endFrame(VeridianDrmOutput *output, const QRegion &damage);
+
     /* ----- Session ----- */
     VeridianSession *session() const;
 
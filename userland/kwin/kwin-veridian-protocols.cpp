@@ -27,6 +27,10 @@
 
 #include <wayland-server-core.h>
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 /* KDE Wayland protocol headers (generated by wayland-scanner from .xml) */
 #include <plasma-shell-server-protocol.h>
@@ -109,6 +113,7 @@ void VeridianPlasmaShellInterface::getShellSurface(
     auto *data = new PlasmaShellSurfaceData;
     memset(data, 0, sizeof(*data));
     data->surface = surface;
+    data->owner = self;
 
     struct wl_resource *shellSurface = wl_resource_create(client,
         &org_kde_plasma_surface_interface, wl_resource_get_version(resource), id);
@@ -129,14 +134,62 @@ void VeridianPlasmaShellInterface::shellSurfaceSetRole(
     data->role = role;
 }
 
+/*
+ * Message batching.
+ *
+ * Interactive drags deliver set_position storms; instead of applying
+ * each message, the handlers record pending state and the surface
+ * joins a dirty list.  A wl_event_loop idle callback -- which fires
+ * only once the loop has drained every pending client message --
+ * applies the grouped state per surface and emits one
+ * surfaceConfigured.  A hundred drag messages in one dispatch cycle
+ * cost one apply.
+ */
+void VeridianPlasmaShellInterface::scheduleApply(
+    PlasmaShellSurfaceData *surface)
+{
+    if (!m_dirtySurfaces.contains(surface))
+        m_dirtySurfaces.append(surface);
+
+    if (!m_applyScheduled) {
+        m_applyScheduled = true;
+        wl_event_loop_add_idle(wl_display_get_event_loop(m_display),
+                               applyPending, this);
+    }
+}
+
+void VeridianPlasmaShellInterface::applyPending(void *data)
+{
+    auto *self = static_cast<VeridianPlasmaShellInterface *>(data);
+    QVector<PlasmaShellSurfaceData *> batch = self->m_dirtySurfaces;
+
+    self->m_dirtySurfaces.clear();
+    self->m_applyScheduled = false;
+
+    for (PlasmaShellSurfaceData *surface : batch) {
+        if (surface->pendingDirty & VPS_DIRTY_POSITION) {
+            surface->x = surface->pendingX;
+            surface->y = surface->pendingY;
+            surface->positionSet = true;
+        }
+        if (surface->pendingDirty & VPS_DIRTY_BEHAVIOR)
+            surface->panelBehavior = surface->pendingPanelBehavior;
+        surface->pendingDirty = 0;
+        Q_EMIT self->surfaceConfigured(surface);
+    }
+}
+
 void VeridianPlasmaShellInterface::shellSurfaceSetPosition(
     struct wl_client *, struct wl_resource *resource, int32_t x, int32_t y)
 {
     auto *data = static_cast<PlasmaShellSurfaceData *>(
         wl_resource_get_user_data(resource));
-    data->x = x;
-    data->y = y;
-    data->positionSet = true;
+
+    data->pendingX = x;
+    data->pendingY = y;
+    data->pendingDirty |= VPS_DIRTY_POSITION;
+    if (data->owner)
+        data->owner->scheduleApply(data);
 }
 
 void VeridianPlasmaShellInterface::shellSurfaceSetPanelBehavior(
@@ -144,7 +197,11 @@ void VeridianPlasmaShellInterface::shellSurfaceSetPanelBehavior(
 {
     auto *data = static_cast<PlasmaShellSurfaceData *>(
         wl_resource_get_user_data(resource));
-    data->panelBehavior = behavior;
+
+    data->pendingPanelBehavior = behavior;
+    data->pendingDirty |= VPS_DIRTY_BEHAVIOR;
+    if (data->owner)
+        data->owner->scheduleApply(data);
 }
 
 void VeridianPlasmaShellInterface::shellSurfaceSetSkipTaskbar(
@@ -167,6 +224,10 @@ void VeridianPlasmaShellInterface::shellSurfaceDestroy(struct wl_resource *resou
 {
     auto *data = static_cast<PlasmaShellSurfaceData *>(
         wl_resource_get_user_data(resource));
+    /* A destroyed surface must leave the batch before the idle apply
+     * runs, or applyPending dereferences freed memory */
+    if (data->owner)
+        data->owner->m_dirtySurfaces.removeAll(data);
     /* Note: caller must remove from m_surfaces list via surfaceDestroyed signal */
     delete data;
 }
@@ -202,14 +263,118 @@ VeridianWindowManagementInterface::VeridianWindowManagementInterface(
     if (!m_global) {
         qWarning("VeridianWindowManagement: wl_global_create failed");
     }
+
+    /* Shared window table: map the file and open the wake FIFO.  A
+     * read-only filesystem just leaves clients on the protocol path */
+    mkdir("/run/veridian", 0755);
+    {
+        int fd = open(VWT_PATH, O_RDWR | O_CREAT, 0644);
+
+        if (fd >= 0 && ftruncate(fd, sizeof(VwtTable)) == 0) {
+            void *map = mmap(nullptr, sizeof(VwtTable),
+                             PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+            if (map != MAP_FAILED) {
+                m_vwt = static_cast<VwtTable *>(map);
+                m_vwt->version = VWT_VERSION;
+                __atomic_store_n(&m_vwt->magic, VWT_MAGIC,
+                                 __ATOMIC_RELEASE);
+            }
+        }
+        if (fd >= 0)
+            close(fd);
+    }
+    mkfifo(VWT_WAKE_PATH, 0644);
+    m_vwtWakeFd = open(VWT_WAKE_PATH, O_RDWR | O_NONBLOCK);
 }
 
 VeridianWindowManagementInterface::~VeridianWindowManagementInterface()
 {
+    if (m_vwt)
+        munmap(m_vwt, sizeof(VwtTable));
+    if (m_vwtWakeFd >= 0)
+        close(m_vwtWakeFd);
     if (m_global)
         wl_global_destroy(m_global);
 }
 
+/*
+ * Rewrite the shared table from m_windows under the generation
+ * seqlock, then poke the wake FIFO so readers re-read.  Window counts
+ * are small and mutations are user-interaction rate, so a full
+ * rewrite keeps readers a plain snapshot copy.
+ */
+void VeridianWindowManagementInterface::vwtPublish()
+{
+    if (!m_vwt)
+        return;
+
+    __atomic_fetch_add(&m_vwt->generation, 1, __ATOMIC_ACQ_REL);
+
+    {
+        uint32_t n = 0;
+        uint32_t active = 0;
+
+        for (auto it = m_windows.constBegin();
+             it != m_windows.constEnd() && n < VWT_MAX_WINDOWS; ++it) {
+            const ManagedWindowData &w = it.value();
+            VwtRecord *r = &m_vwt->windows[n];
+            QByteArray title = w.title.toUtf8();
+            QByteArray appId = w.appId.toUtf8();
+
+            memset(r, 0, sizeof(*r));
+            r->id = w.internalId;
+            r->pid = w.pid;
+            r->state = w.state;
+            r->x = w.geometry.x();
+            r->y = w.geometry.y();
+            r->w = w.geometry.width();
+            r->h = w.geometry.height();
+            strncpy(r->title, title.constData(), sizeof(r->title) - 1);
+            strncpy(r->appId, appId.constData(), sizeof(r->appId) - 1);
+            if (w.state & 0x001)
+                active = w.internalId;
+            n++;
+        }
+        m_vwt->window_count = n;
+        m_vwt->active_id = active;
+    }
+
+    __atomic_fetch_add(&m_vwt->generation, 1, __ATOMIC_ACQ_REL);
+
+    if (m_vwtWakeFd >= 0) {
+        char byte = 1;
+
+        if (write(m_vwtWakeFd, &byte, 1) < 0) {
+            /* Full FIFO or no reader: harmless, readers re-check the
+             * generation on their next wake anyway */
+        }
+    }
+}
+
+/*
+ * Batch boundary for table publication: a drag storm delivers dozens
+ * of geometry updates per dispatch cycle; the idle callback runs once
+ * the loop drains them all, so the table is rewritten (and readers
+ * woken) once per burst instead of once per message.
+ */
+void VeridianWindowManagementInterface::vwtScheduleFlush()
+{
+    if (m_vwtFlushScheduled || !m_vwt)
+        return;
+    m_vwtFlushScheduled = true;
+    wl_event_loop_add_idle(wl_display_get_event_loop(m_display),
+                           vwtFlush, this);
+}
+
+void VeridianWindowManagementInterface::vwtFlush(void *data)
+{
+    auto *self = static_cast<VeridianWindowManagementInterface *>(data);
+
+    self->m_vwtFlushScheduled = false;
+    self->vwtPublish();
+}
+
 void VeridianWindowManagementInterface::bind(struct wl_client *client,
                                               void *data,
                                               uint32_t version, uint32_t id)
@@ -297,6 +462,7 @@ void VeridianWindowManagementInterface::addWindow(uint32_t internalId,
     window.fullscreenable = true;
 
     m_windows.insert(internalId, window);
+    vwtPublish();
 
     /* Notify all bound clients */
     for (struct wl_resource *res : m_boundResources) {
@@ -307,6 +473,7 @@ void VeridianWindowManagementInterface::addWindow(uint32_t internalId,
 void VeridianWindowManagementInterface::removeWindow(uint32_t internalId)
 {
     m_windows.remove(internalId);
+    vwtPublish();
     /* Clients receive the unmapped event via the per-window resource destroy */
 }
 
@@ -316,6 +483,7 @@ void VeridianWindowManagementInterface::updateWindowTitle(uint32_t internalId,
     if (m_windows.contains(internalId)) {
         m_windows[internalId].title = title;
     }
+    vwtScheduleFlush();
 }
 
 void VeridianWindowManagementInterface::updateWindowState(uint32_t internalId,
@@ -324,6 +492,7 @@ void VeridianWindowManagementInterface::updateWindowState(uint32_t internalId,
     if (m_windows.contains(internalId)) {
         m_windows[internalId].state = state;
     }
+    vwtScheduleFlush();
 }
 
 void VeridianWindowManagementInterface::updateWindowGeometry(uint32_t internalId,
@@ -332,6 +501,7 @@ void VeridianWindowManagementInterface::updateWindowGeometry(uint32_t internalId
     if (m_windows.contains(internalId)) {
         m_windows[internalId].geometry = geometry;
     }
+    vwtScheduleFlush();
 }
 
 void VeridianWindowManagementInterface::updateWindowVirtualDesktop(
@@ -340,6 +510,7 @@ void VeridianWindowManagementInterface::updateWindowVirtualDesktop(
     if (m_windows.contains(internalId)) {
         m_windows[internalId].virtualDesktopIds = desktopIds;
     }
+    vwtScheduleFlush();
 }
 
 void VeridianWindowManagementInterface::setShowDesktop(bool show)
@@ -1151,3 +1322,49 @@ VeridianOutputManagement *VeridianProtocolRegistry::outputManagement() const
 }
 
 } /* namespace KWin */
+
+/* ========================================================================= */
+/* Shared screen-descriptor table                                            */
+/* ========================================================================= */
+
+/*
+ * Same publication discipline as the window table: bump the
+ * generation odd, rewrite, bump it even.  Screen changes are
+ * hotplug/modeset rate, so the full rewrite is nothing; the win is
+ * on the reader side, where QML's per-frame QScreen queries become
+ * one relaxed generation load.
+ */
+
+static VscrTable *g_vscr;
+
+void vscrPublishScreens(const VscrRecord *screens, uint32_t count)
+{
+    if (!g_vscr) {
+        mkdir("/run", 0755);
+        mkdir("/run/veridian", 0755);
+
+        int fd = open(VSCR_PATH, O_RDWR | O_CREAT, 0644);
+        if (fd < 0)
+            return;
+        if (ftruncate(fd, sizeof(VscrTable)) != 0) {
+            close(fd);
+            return;
+        }
+        void *map = mmap(nullptr, sizeof(VscrTable),
+                         PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (map == MAP_FAILED)
+            return;
+        g_vscr = static_cast<VscrTable *>(map);
+        g_vscr->version = VSCR_VERSION;
+        __atomic_store_n(&g_vscr->magic, VSCR_MAGIC, __ATOMIC_RELEASE);
+    }
+
+    if (count > VSCR_MAX_SCREENS)
+        count = VSCR_MAX_SCREENS;
+
+    __atomic_fetch_add(&g_vscr->generation, 1, __ATOMIC_ACQ_REL);
+    memcpy(g_vscr->screens, screens, count * sizeof(VscrRecord));
+    g_vscr->screen_count = count;
+    __atomic_fetch_add(&g_vscr->generation, 1, __ATOMIC_ACQ_REL);
+}
@@ -66,8 +66,21 @@ struct PlasmaShellSurfaceData {
     bool positionSet;
     bool skipTaskbar;
     bool skipSwitcher;
+
+    class VeridianPlasmaShellInterface *owner;
+
+    /* Batched state: protocol messages write here and the grouped
+     * result is applied once at the dispatch-cycle boundary */
+    int32_t pendingX;
+    int32_t pendingY;
+    uint32_t pendingPanelBehavior;
+    uint32_t pendingDirty;      /* VPS_DIRTY_* bits */
 };
 
+/* PlasmaShellSurfaceData::pendingDirty bits */
+#define VPS_DIRTY_POSITION 0x1u
+#define VPS_DIRTY_BEHAVIOR 0x2u
+
 /* ========================================================================= */
 /* VeridianPlasmaShellInterface -- org_kde_plasma_shell                      */
 /* ========================================================================= */
@@ -100,6 +113,10 @@ Q_SIGNALS:
     void surfaceCreated(PlasmaShellSurfaceData *surface);
     void surfaceDestroyed(PlasmaShellSurfaceData *surface);
 
+    /** One signal per surface per message burst: every state change
+     *  drained in the same dispatch cycle is applied together. */
+    void surfaceConfigured(PlasmaShellSurfaceData *surface);
+
 private:
     /* Protocol callbacks */
     static void bind(struct wl_client *client, void *data,
@@ -109,6 +126,13 @@ private:
                                 uint32_t id,
                                 struct wl_resource *surface);
 
+    /* Batch apply at the dispatch-cycle boundary */
+    void scheduleApply(PlasmaShellSurfaceData *surface);
+    static void applyPending(void *data);
+
+    QVector<PlasmaShellSurfaceData *> m_dirtySurfaces;
+    bool m_applyScheduled = false;
+
     /* Shell surface callbacks */
     static void shellSurfaceSetRole(struct wl_client *client,
                                     struct wl_resource *resource,
@@ -139,6 +163,84 @@ private:
 /**
  * Server-side state for a managed window exported to the taskbar.
  */
+/* ========================================================================= */
+/* Shared window-list table                                                  */
+/* ========================================================================= */
+
+/*
+ * Compact window records published by the compositor at
+ * /run/veridian/windowlist, mapped read-only by kwindowsystem
+ * clients.  The generation counter is a seqlock (odd while the
+ * compositor rewrites); a byte written to the companion FIFO
+ * /run/veridian/windowlist.wake wakes readers only when something
+ * changed.  kwindowsystem-veridian.cpp keeps a byte-compatible copy
+ * of these definitions (the kf6 tree does not include kwin headers);
+ * bump VWT_VERSION when the layout changes.
+ */
+
+#define VWT_MAGIC       0x4c545756u     /* 'VWTL' */
+#define VWT_VERSION     1u
+#define VWT_MAX_WINDOWS 128
+#define VWT_PATH        "/run/veridian/windowlist"
+#define VWT_WAKE_PATH   "/run/veridian/windowlist.wake"
+
+struct VwtRecord {
+    uint32_t id;
+    uint32_t pid;
+    uint32_t state;
+    int32_t  x, y, w, h;
+    uint32_t _pad;
+    char     title[128];
+    char     appId[64];
+};
+
+/*
+ * Shared screen-descriptor table (VSCR): the compositor publishes
+ * output geometry/DPI here under a generation seqlock so QPA screen
+ * queries are pure memory reads.  QVeridianScreen keeps a
+ * byte-compatible copy of this layout (it cannot include kwin
+ * headers), as the window table readers do.
+ */
+
+#define VSCR_MAGIC       0x52435356u    /* 'VSCR' */
+#define VSCR_VERSION     1u
+#define VSCR_MAX_SCREENS 8
+#define VSCR_PATH        "/run/veridian/screens"
+
+struct VscrRecord {
+    int32_t  x, y, w, h;
+    uint32_t refresh_mhz;       /* 60000 = 60 Hz */
+    uint32_t phys_w_mm;
+    uint32_t phys_h_mm;
+    uint32_t connector_id;
+};
+
+struct VscrTable {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t generation;        /* Seqlock: odd = rewrite in flight */
+    uint32_t screen_count;
+    struct VscrRecord screens[VSCR_MAX_SCREENS];
+};
+
+/**
+ * Publish the current output set into the shared screen table
+ * (mapping it on first use).  Call whenever an output is added,
+ * removed, or reconfigured.
+ */
+void vscrPublishScreens(const struct VscrRecord *screens,
+                        uint32_t count);
+
+struct VwtTable {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t generation;        /* Seqlock: odd = rewrite in flight */
+    uint32_t window_count;
+    uint32_t active_id;
+    uint32_t _pad;
+    struct VwtRecord windows[VWT_MAX_WINDOWS];
+};
+
 struct ManagedWindowData {
     uint32_t internalId;
     struct wl_resource *windowResource;
@@ -225,6 +327,15 @@ private:
     struct wl_display *m_display;
     struct wl_global *m_global;
     QHash<uint32_t, ManagedWindowData> m_windows;
+
+    /* Shared window table publication (batched: update storms inside
+     * one dispatch cycle publish once at the idle boundary) */
+    void vwtPublish();
+    void vwtScheduleFlush();
+    static void vwtFlush(void *data);
+    struct VwtTable *m_vwt = nullptr;
+    int m_vwtWakeFd = -1;
+    bool m_vwtFlushScheduled = false;
     QVector<struct wl_resource *> m_boundResources;
 };
 
@@ -38,6 +38,7 @@
 #include <QTimer>
 
 #include <unistd.h>
+#include <veridian/sched.h>
 #include <signal.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -333,6 +334,13 @@ int startKwinSession(int argc, char *argv[])
 
     qDebug("KWinSession: starting KWin compositor on VeridianOS");
 
+    /* Compositor thread: latency-critical, soft-pinned to the second
+     * latency CPU (PipeWire's audio loop takes the first) so frame
+     * deadlines and audio callbacks never share a core with batch
+     * work */
+    veridian_sched_set_role(VSCHED_ROLE_LATENCY);
+    veridian_sched_set_affinity_hint(veridian_sched_latency_cpu(1));
+
     /* Parse command-line arguments */
     QString waylandDisplay = QStringLiteral("wayland-0");
     QString drmDevice = QStringLiteral("/dev/dri/card0");
@@ -12,6 +12,11 @@
  */
 
 #include "kwin-veridian-swrender.h"
+
+#include <veridian/frametrace.h>
+
+/* Effects load shedding (kwin-veridian-effects.cpp) */
+extern void veridianEffectsSetLoadShed(bool shed);
 #include "kwin-veridian-platform.h"
 
 #include <QDebug>
@@ -21,8 +26,462 @@
 #include <algorithm>
 #include <cstring>
 
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 namespace KWin {
 
+/* ========================================================================= */
+/* SIMD Pixel Kernels                                                        */
+/* ========================================================================= */
+
+/*
+ * Blit, fill, and premultiplied-alpha blend over ARGB32 scanlines.
+ *
+ * Window drags and translucency burn most of their time in these three
+ * loops, so each has a vectorized variant:
+ *
+ *   x86_64:  SSE2 (ISA baseline) and AVX2, selected via CPUID at the
+ *            first call.  The AVX2 bodies carry target attributes so
+ *            the file still compiles with the baseline -msse2 flags.
+ *   AArch64: NEON (always available on ARMv8-A).
+ *
+ * The scalar path is kept both as the fallback and as the reference
+ * implementation for the vector variants.
+ *
+ * Blend math (premultiplied "over"): d' = s + d * (255 - sA) / 255,
+ * with the division approximated as ((x + 128) + ((x + 128) >> 8)) >> 8
+ * which is exact for all 16-bit products.
+ */
+
+namespace SwPixelOps {
+
+namespace {
+
+/* ----- Scalar reference kernels ----- */
+
+void blitScalar(quint32 *dst, int dstStride,
+                const quint32 *src, int srcStride,
+                int width, int height)
+{
+    for (int y = 0; y < height; ++y) {
+        memcpy(dst, src, static_cast<size_t>(width) * 4);
+        dst = reinterpret_cast<quint32 *>(
+            reinterpret_cast<char *>(dst) + dstStride);
+        src = reinterpret_cast<const quint32 *>(
+            reinterpret_cast<const char *>(src) + srcStride);
+    }
+}
+
+void fillScalar(quint32 *dst, int dstStride,
+                int width, int height, quint32 pixel)
+{
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            dst[x] = pixel;
+        }
+        dst = reinterpret_cast<quint32 *>(
+            reinterpret_cast<char *>(dst) + dstStride);
+    }
+}
+
+inline quint32 blendPixelPremul(quint32 s, quint32 d)
+{
+    const quint32 sa = s >> 24;
+    if (sa == 255) {
+        return s;
+    }
+    if (sa == 0) {
+        return d;
+    }
+
+    const quint32 inv = 255 - sa;
+    quint32 out = 0;
+    for (int shift = 0; shift <= 24; shift += 8) {
+        quint32 dc = (d >> shift) & 0xFF;
+        quint32 sc = (s >> shift) & 0xFF;
+        quint32 t = dc * inv + 128;
+        t = (t + (t >> 8)) >> 8;
+        /* Saturate like the vector packs do, in case a caller hands
+         * us un-premultiplied content */
+        quint32 v = sc + t;
+        out |= ((v > 255) ? 255 : v) << shift;
+    }
+    return out;
+}
+
+void blendScalar(quint32 *dst, int dstStride,
+                 const quint32 *src, int srcStride,
+                 int width, int height)
+{
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            dst[x] = blendPixelPremul(src[x], dst[x]);
+        }
+        dst = reinterpret_cast<quint32 *>(
+            reinterpret_cast<char *>(dst) + dstStride);
+        src = reinterpret_cast<const quint32 *>(
+            reinterpret_cast<const char *>(src) + srcStride);
+    }
+}
+
+#if defined(__x86_64__)
+
+/* ----- SSE2 kernels (x86-64 ISA baseline) ----- */
+
+void blitSse2(quint32 *dst, int dstStride,
+              const quint32 *src, int srcStride,
+              int width, int height)
+{
+    for (int y = 0; y < height; ++y) {
+        int x = 0;
+        for (; x + 4 <= width; x += 4) {
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i *>(dst + x),
+                _mm_loadu_si128(
+                    reinterpret_cast<const __m128i *>(src + x)));
+        }
+        for (; x < width; ++x) {
+            dst[x] = src[x];
+        }
+        dst = reinterpret_cast<quint32 *>(
+            reinterpret_cast<char *>(dst) + dstStride);
+        src = reinterpret_cast<const quint32 *>(
+            reinterpret_cast<const char *>(src) + srcStride);
+    }
+}
+
+void fillSse2(quint32 *dst, int dstStride,
+              int width, int height, quint32 pixel)
+{
+    const __m128i v = _mm_set1_epi32(static_cast<int>(pixel));
+    for (int y = 0; y < height; ++y) {
+        int x = 0;
+        for (; x + 4 <= width; x += 4) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x), v);
+        }
+        for (; x < width; ++x) {
+            dst[x] = pixel;
+        }
+        dst = reinterpret_cast<quint32 *>(
+            reinterpret_cast<char *>(dst) + dstStride);
+    }
+}
+
+void blendSse2(quint32 *dst, int dstStride,
+               const quint32 *src, int srcStride,
+               int width, int height)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i half = _mm_set1_epi16(128);
+    const __m128i full = _mm_set1_epi16(255);
+
+    for (int y = 0; y < height; ++y) {
+        int x = 0;
+        for (; x + 4 <= width; x += 4) {
+            const __m128i s = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(src + x));
+            const __m128i d = _mm_loadu_si128(
+                reinterpret_cast<__m128i *>(dst + x));
+
+            /* Expand to 16-bit lanes, low and high pixel pairs */
+            __m128i sLo = _mm_unpacklo_epi8(s, zero);
+            __m128i sHi = _mm_unpackhi_epi8(s, zero);
+            __m128i dLo = _mm_unpacklo_epi8(d, zero);
+            __m128i dHi = _mm_unpackhi_epi8(d, zero);
+
+            /* Broadcast (255 - alpha) across each pixel's channels */
+            __m128i aLo = _mm_shufflelo_epi16(sLo, _MM_SHUFFLE(3, 3, 3, 3));
+            aLo = _mm_shufflehi_epi16(aLo, _MM_SHUFFLE(3, 3, 3, 3));
+            __m128i aHi = _mm_shufflelo_epi16(sHi, _MM_SHUFFLE(3, 3, 3, 3));
+            aHi = _mm_shufflehi_epi16(aHi, _MM_SHUFFLE(3, 3, 3, 3));
+            const __m128i invLo = _mm_sub_epi16(full, aLo);
+            const __m128i invHi = _mm_sub_epi16(full, aHi);
+
+            /* d * inv / 255, exact via the +128 / >>8 correction */
+            __m128i tLo = _mm_add_epi16(_mm_mullo_epi16(dLo, invLo), half);
+            tLo = _mm_srli_epi16(_mm_add_epi16(tLo, _mm_srli_epi16(tLo, 8)), 8);
+            __m128i tHi = _mm_add_epi16(_mm_mullo_epi16(dHi, invHi), half);
+            tHi = _mm_srli_epi16(_mm_add_epi16(tHi, _mm_srli_epi16(tHi, 8)), 8);
+
+            const __m128i outLo = _mm_add_epi16(sLo, tLo);
+            const __m128i outHi = _mm_add_epi16(sHi, tHi);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x),
+                             _mm_packus_epi16(outLo, outHi));
+        }
+        for (; x < width; ++x) {
+            dst[x] = blendPixelPremul(src[x], dst[x]);
+        }
+        dst = reinterpret_cast<quint32 *>(
+            reinterpret_cast<char *>(dst) + dstStride);
+        src = reinterpret_cast<const quint32 *>(
+            reinterpret_cast<const char *>(src) + srcStride);
+    }
+}
+
+/* ----- AVX2 kernels (target attribute; selected via CPUID) ----- */
+
+__attribute__((target("avx2")))
+void blitAvx2(quint32 *dst, int dstStride,
+              const quint32 *src, int srcStride,
+              int width, int height)
+{
+    for (int y = 0; y < height; ++y) {
+        int x = 0;
+        for (; x + 8 <= width; x += 8) {
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i *>(dst + x),
+                _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i *>(src + x)));
+        }
+        for (; x < width; ++x) {
+            dst[x] = src[x];
+        }
+        dst = reinterpret_cast<quint32 *>(
+            reinterpret_cast<char *>(dst) + dstStride);
+        src = reinterpret_cast<const quint32 *>(
+            reinterpret_cast<const char *>(src) + srcStride);
+    }
+}
+
+__attribute__((target("avx2")))
+void fillAvx2(quint32 *dst, int dstStride,
+              int width, int height, quint32 pixel)
+{
+    const __m256i v = _mm256_set1_epi32(static_cast<int>(pixel));
+    for (int y = 0; y < height; ++y) {
+        int x = 0;
+        for (; x + 8 <= width; x += 8) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + x), v);
+        }
+        for (; x < width; ++x) {
+            dst[x] = pixel;
+        }
+        dst = reinterpret_cast<quint32 *>(
+            reinterpret_cast<char *>(dst) + dstStride);
+    }
+}
+
+__attribute__((target("avx2")))
+void blendAvx2(quint32 *dst, int dstStride,
+               const quint32 *src, int srcStride,
+               int width, int height)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i half = _mm256_set1_epi16(128);
+    const __m256i full = _mm256_set1_epi16(255);
+
+    for (int y = 0; y < height; ++y) {
+        int x = 0;
+        for (; x + 8 <= width; x += 8) {
+            const __m256i s = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(src + x));
+            const __m256i d = _mm256_loadu_si256(
+                reinterpret_cast<__m256i *>(dst + x));
+
+            __m256i sLo = _mm256_unpacklo_epi8(s, zero);
+            __m256i sHi = _mm256_unpackhi_epi8(s, zero);
+            __m256i dLo = _mm256_unpacklo_epi8(d, zero);
+            __m256i dHi = _mm256_unpackhi_epi8(d, zero);
+
+            __m256i aLo = _mm256_shufflelo_epi16(sLo, _MM_SHUFFLE(3, 3, 3, 3));
+            aLo = _mm256_shufflehi_epi16(aLo, _MM_SHUFFLE(3, 3, 3, 3));
+            __m256i aHi = _mm256_shufflelo_epi16(sHi, _MM_SHUFFLE(3, 3, 3, 3));
+            aHi = _mm256_shufflehi_epi16(aHi, _MM_SHUFFLE(3, 3, 3, 3));
+            const __m256i invLo = _mm256_sub_epi16(full, aLo);
+            const __m256i invHi = _mm256_sub_epi16(full, aHi);
+
+            __m256i tLo = _mm256_add_epi16(_mm256_mullo_epi16(dLo, invLo), half);
+            tLo = _mm256_srli_epi16(
+                _mm256_add_epi16(tLo, _mm256_srli_epi16(tLo, 8)), 8);
+            __m256i tHi = _mm256_add_epi16(_mm256_mullo_epi16(dHi, invHi), half);
+            tHi = _mm256_srli_epi16(
+                _mm256_add_epi16(tHi, _mm256_srli_epi16(tHi, 8)), 8);
+
+            const __m256i outLo = _mm256_add_epi16(sLo, tLo);
+            const __m256i outHi = _mm256_add_epi16(sHi, tHi);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + x),
+                                _mm256_packus_epi16(outLo, outHi));
+        }
+        for (; x < width; ++x) {
+            dst[x] = blendPixelPremul(src[x], dst[x]);
+        }
+        dst = reinterpret_cast<quint32 *>(
+            reinterpret_cast<char *>(dst) + dstStride);
+        src = reinterpret_cast<const quint32 *>(
+            reinterpret_cast<const char *>(src) + srcStride);
+    }
+}
+
+#elif defined(__aarch64__)
+
+/* ----- NEON kernels (always available on ARMv8-A) ----- */
+
+void blitNeon(quint32 *dst, int dstStride,
+              const quint32 *src, int srcStride,
+              int width, int height)
+{
+    for (int y = 0; y < height; ++y) {
+        int x = 0;
+        for (; x + 4 <= width; x += 4) {
+            vst1q_u32(dst + x, vld1q_u32(src + x));
+        }
+        for (; x < width; ++x) {
+            dst[x] = src[x];
+        }
+        dst = reinterpret_cast<quint32 *>(
+            reinterpret_cast<char *>(dst) + dstStride);
+        src = reinterpret_cast<const quint32 *>(
+            reinterpret_cast<const char *>(src) + srcStride);
+    }
+}
+
+void fillNeon(quint32 *dst, int dstStride,
+              int width, int height, quint32 pixel)
+{
+    const uint32x4_t v = vdupq_n_u32(pixel);
+    for (int y = 0; y < height; ++y) {
+        int x = 0;
+        for (; x + 4 <= width; x += 4) {
+            vst1q_u32(dst + x, v);
+        }
+        for (; x < width; ++x) {
+            dst[x] = pixel;
+        }
+        dst = reinterpret_cast<quint32 *>(
+            reinterpret_cast<char *>(dst) + dstStride);
+    }
+}
+
+void blendNeon(quint32 *dst, int dstStride,
+               const quint32 *src, int srcStride,
+               int width, int height)
+{
+    /* Replicates each pixel's alpha byte across its four channels */
+    static const uint8x16_t alphaShuffle = {
+        3, 3, 3, 3, 7, 7, 7, 7, 11, 11, 11, 11, 15, 15, 15, 15
+    };
+
+    for (int y = 0; y < height; ++y) {
+        int x = 0;
+        for (; x + 4 <= width; x += 4) {
+            const uint8x16_t s = vreinterpretq_u8_u32(vld1q_u32(src + x));
+            const uint8x16_t d = vreinterpretq_u8_u32(vld1q_u32(dst + x));
+
+            /* Expand to 16-bit halves */
+            const uint16x8_t sLo = vmovl_u8(vget_low_u8(s));
+            const uint16x8_t sHi = vmovl_u8(vget_high_u8(s));
+            const uint16x8_t dLo = vmovl_u8(vget_low_u8(d));
+            const uint16x8_t dHi = vmovl_u8(vget_high_u8(d));
+
+            /* Broadcast (255 - alpha) across each pixel's channels */
+            const uint8x16_t inv8 = vmvnq_u8(vqtbl1q_u8(s, alphaShuffle));
+            const uint16x8_t invLo = vmovl_u8(vget_low_u8(inv8));
+            const uint16x8_t invHi = vmovl_u8(vget_high_u8(inv8));
+
+            /* d * inv / 255, exact via the +128 / >>8 correction */
+            uint16x8_t tLo = vmlaq_u16(vdupq_n_u16(128), dLo, invLo);
+            tLo = vshrq_n_u16(vaddq_u16(tLo, vshrq_n_u16(tLo, 8)), 8);
+            uint16x8_t tHi = vmlaq_u16(vdupq_n_u16(128), dHi, invHi);
+            tHi = vshrq_n_u16(vaddq_u16(tHi, vshrq_n_u16(tHi, 8)), 8);
+
+            const uint8x16_t out = vcombine_u8(
+                vqmovn_u16(vaddq_u16(sLo, tLo)),
+                vqmovn_u16(vaddq_u16(sHi, tHi)));
+            vst1q_u32(dst + x, vreinterpretq_u32_u8(out));
+        }
+        for (; x < width; ++x) {
+            dst[x] = blendPixelPremul(src[x], dst[x]);
+        }
+        dst = reinterpret_cast<quint32 *>(
+            reinterpret_cast<char *>(dst) + dstStride);
+        src = reinterpret_cast<const quint32 *>(
+            reinterpret_cast<const char *>(src) + srcStride);
+    }
+}
+
+#endif /* __aarch64__ */
+
+/* ----- Runtime dispatch table ----- */
+
+struct KernelTable {
+    void (*blit)(quint32 *, int, const quint32 *, int, int, int);
+    void (*fill)(quint32 *, int, int, int, quint32);
+    void (*blend)(quint32 *, int, const quint32 *, int, int, int);
+    const char *name;
+};
+
+/**
+ * Pick the best kernel set for this CPU.
+ *
+ * On x86_64 the AVX2 path is gated on CPUID (via the compiler's
+ * builtin detection, which caches the CPUID results); SSE2 is the
+ * ISA baseline so it needs no check.
+ */
+KernelTable selectKernels()
+{
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx2")) {
+        return { blitAvx2, fillAvx2, blendAvx2, "avx2" };
+    }
+    return { blitSse2, fillSse2, blendSse2, "sse2" };
+#elif defined(__aarch64__)
+    return { blitNeon, fillNeon, blendNeon, "neon" };
+#else
+    return { blitScalar, fillScalar, blendScalar, "scalar" };
+#endif
+}
+
+const KernelTable &kernels()
+{
+    /* Thread-safe one-time init (C++11 magic statics) */
+    static const KernelTable table = selectKernels();
+    return table;
+}
+
+} /* anonymous namespace */
+
+void blit(quint32 *dst, int dstStride,
+          const quint32 *src, int srcStride,
+          int width, int height)
+{
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    kernels().blit(dst, dstStride, src, srcStride, width, height);
+}
+
+void fill(quint32 *dst, int dstStride,
+          int width, int height, quint32 pixel)
+{
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    kernels().fill(dst, dstStride, width, height, pixel);
+}
+
+void blendPremul(quint32 *dst, int dstStride,
+                 const quint32 *src, int srcStride,
+                 int width, int height)
+{
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    kernels().blend(dst, dstStride, src, srcStride, width, height);
+}
+
+const char *kernelName()
+{
+    return kernels().name;
+}
+
+} /* namespace SwPixelOps */
+
 /* ========================================================================= */
 /* Construction / Destruction                                                */
 /* ========================================================================= */
@@ -36,18 +495,37 @@ VeridianSwRenderer::VeridianSwRenderer(VeridianEglBackend *eglBackend,
     , m_lastVsyncMs(0)
     , m_vsyncIntervalMs(VSYNC_INTERVAL_MS)
     , m_vsyncEnabled(true)
+    , m_framePacingEnabled(true)
+    , m_frameCostEwmaUs(0)
+    , m_vsyncMultiplier(1)
+    , m_overBudgetStreak(0)
+    , m_underBudgetStreak(0)
     , m_frameCount(0)
     , m_droppedFrames(0)
     , m_historyWriteIdx(0)
     , m_minFrameTimeMs(std::numeric_limits<qint64>::max())
     , m_maxFrameTimeMs(0)
     , m_backBufferDirty(false)
+    , m_scanoutPtr(nullptr)
+    , m_scanoutStride(0)
+    , m_cursorVisible(false)
+    , m_cursorDrawn(false)
+    , m_cursorOnlyPresents(0)
+    , m_tilingEnabled(true)
+    , m_tileColumns(0)
+    , m_tileRows(0)
+    , m_nextDirtyTile(0)
+    , m_poolShutdown(0)
+    , m_tilesComposited(0)
+    , m_tileTimeTotalUs(0)
 {
     qDebug("VeridianSwRenderer: created for software rendering path");
 }
 
 VeridianSwRenderer::~VeridianSwRenderer()
 {
+    stopWorkerPool();
+
     qDebug("VeridianSwRenderer: destroyed (frames: %llu, dropped: %llu)",
            static_cast<unsigned long long>(m_frameCount),
            static_cast<unsigned long long>(m_droppedFrames));
@@ -84,6 +562,12 @@ bool VeridianSwRenderer::initialize()
     m_frameTimeHistory.resize(FRAME_HISTORY_SIZE);
     m_frameTimeHistory.fill(0);
 
+    /* Build the tile grid and spin up the worker pool */
+    rebuildTileGrid();
+    if (m_tilingEnabled) {
+        startWorkerPool();
+    }
+
     m_initialized = true;
 
     qDebug("VeridianSwRenderer: initialized successfully");
@@ -91,6 +575,9 @@ bool VeridianSwRenderer::initialize()
            static_cast<long long>(m_vsyncIntervalMs),
            m_vsyncIntervalMs > 0 ? static_cast<int>(1000 / m_vsyncIntervalMs) : 0);
     qDebug("  Max damage rects:  %d", m_maxDamageRects);
+    qDebug("  Tile grid:         %dx%d (%d px tiles, %d workers)",
+           m_tileColumns, m_tileRows, TILE_SIZE, m_workerPool.size());
+    qDebug("  Pixel kernels:     %s", SwPixelOps::kernelName());
     qDebug("  GL renderer:       %s", qPrintable(m_eglBackend->glRenderer()));
 
     return true;
@@ -102,8 +589,9 @@ bool VeridianSwRenderer::initialize()
 
 void VeridianSwRenderer::setDamageRegion(const QRegion &region)
 {
-    m_previousDamage = m_currentDamage;
-    m_currentDamage = region;
+    /* Accumulate: multiple damage reports may arrive per frame.
+     * compositeFrame() rotates current -> previous once presented. */
+    m_currentDamage += region;
 
     if (!region.isEmpty()) {
         m_backBufferDirty = true;
@@ -153,6 +641,8 @@ bool VeridianSwRenderer::shouldDoFullComposite() const
 
 bool VeridianSwRenderer::compositeFrame()
 {
+    vft_emit(VFT_STAGE_COMPOSITE_START, 0);
+
     if (!m_initialized) {
         qWarning("VeridianSwRenderer: not initialized");
         return false;
@@ -164,6 +654,16 @@ bool VeridianSwRenderer::compositeFrame()
     }
 
     qint64 frameStartMs = m_vsyncTimer.elapsed();
+    qint64 frameStartNs = m_vsyncTimer.nsecsElapsed();
+
+    /* The saved under-cursor patch goes stale once tiles rewrite the
+     * scanout: lift the cursor for the composite, redraw after */
+    bool cursorLifted = false;
+    if (m_cursorDrawn && cursorRect().intersects(
+            mergedDamageRegion().boundingRect())) {
+        liftCursor();
+        cursorLifted = true;
+    }
 
     /*
      * Determine compositing strategy:
@@ -172,7 +672,29 @@ bool VeridianSwRenderer::compositeFrame()
      */
     bool fullComposite = shouldDoFullComposite();
 
-    if (fullComposite) {
+    if (m_tilingEnabled && !m_workerPool.isEmpty() && !m_tiles.isEmpty()) {
+        /*
+         * Tiled parallel path.
+         *
+         * Both full and partial composites go through the tile grid:
+         * a full composite is simply "every tile dirty".  Dirty tiles
+         * are claimed by the worker pool via an atomic index, so an
+         * 8-core box composites a full-screen damage in roughly 1/8th
+         * the single-thread wall time.
+         */
+        if (fullComposite) {
+            markDirtyTiles(QRegion(QRect(QPoint(0, 0), m_outputSize)));
+        } else {
+            markDirtyTiles(mergedDamageRegion());
+        }
+
+        qDebug("VeridianSwRenderer: tiled composite (%d/%d dirty tiles, "
+               "%d workers)",
+               m_dirtyTileIndices.size(), m_tiles.size(),
+               m_workerPool.size());
+
+        dispatchDirtyTiles();
+    } else if (fullComposite) {
         /*
          * Full composite path.
          *
@@ -211,21 +733,34 @@ bool VeridianSwRenderer::compositeFrame()
          */
     }
 
+    /* Feed the pacing predictor with the pure composite cost
+     * (excluding the VSync wait below) */
+    recordFrameCost((m_vsyncTimer.nsecsElapsed() - frameStartNs) / 1000);
+
+    vft_emit(VFT_STAGE_COMPOSITE_END, 0);
+
     /* Wait for VSync before presenting */
     if (m_vsyncEnabled) {
         waitVSync();
     }
+    vft_emit(VFT_STAGE_SCANOUT, 0);
 
     /* Record frame timing */
     qint64 frameEndMs = m_vsyncTimer.elapsed();
     qint64 frameTimeMs = frameEndMs - frameStartMs;
     recordFrameTime(frameTimeMs);
 
-    /* Clear damage for next frame */
+    /* Clear damage for next frame (kept as previous for the
+     * double-buffer union in mergedDamageRegion) */
+    m_previousDamage = m_currentDamage;
+    m_currentDamage = QRegion();
     m_backBufferDirty = false;
 
     m_frameCount++;
 
+    if (cursorLifted)
+        drawCursor();
+
     Q_EMIT framePresented(frameTimeMs);
 
     return true;
@@ -253,9 +788,546 @@ QRegion VeridianSwRenderer::mergedDamageRegion() const
         combined = combined.intersected(outputRect);
     }
 
+    /* Quality level 2: trade sub-region precision for bookkeeping
+     * cost -- one bounding blit beats many rect spans when the CPU
+     * is the bottleneck */
+    if (m_qualityLevel >= 2 && !combined.isEmpty())
+        combined = QRegion(combined.boundingRect());
+
     return combined;
 }
 
+/*
+ * Load controller: degrade quality one step after a sustained run
+ * of over-budget frames, restore one step only after a much longer
+ * run of comfortable ones -- asymmetric hysteresis so quality never
+ * oscillates at the boundary.
+ *
+ *   level 0: everything on
+ *   level 1: effects shed (animation transforms off)
+ *   level 2: + damage collapsed to its bounding rect
+ *
+ * Steady 60fps at reduced quality beats stuttering at full quality;
+ * the adaptive-vsync fallback below this only engages when even
+ * level 2 cannot fit the budget.
+ */
+void VeridianSwRenderer::updateQualityLevel(qint64 frameMs)
+{
+    const qint64 budget = effectiveVsyncIntervalMs();
+
+    if (frameMs > budget) {
+        m_qOverStreak++;
+        m_qUnderStreak = 0;
+        if (m_qOverStreak >= QUALITY_DEGRADE_FRAMES &&
+            m_qualityLevel < 2) {
+            m_qualityLevel++;
+            m_qOverStreak = 0;
+            veridianEffectsSetLoadShed(m_qualityLevel >= 1);
+            qDebug("VeridianSwRenderer: quality -> level %d "
+                   "(sustained %lld ms frames over %lld ms budget)",
+                   m_qualityLevel, (long long)frameMs,
+                   (long long)budget);
+        }
+    } else if (frameMs * 10 <= budget * 7) {
+        /* Comfortable: under 70%% of budget */
+        m_qUnderStreak++;
+        m_qOverStreak = 0;
+        if (m_qUnderStreak >= QUALITY_RESTORE_FRAMES &&
+            m_qualityLevel > 0) {
+            m_qualityLevel--;
+            m_qUnderStreak = 0;
+            veridianEffectsSetLoadShed(m_qualityLevel >= 1);
+            qDebug("VeridianSwRenderer: quality -> level %d "
+                   "(headroom recovered)", m_qualityLevel);
+        }
+    } else {
+        /* Fits but not comfortably: hold the current level */
+        m_qOverStreak = 0;
+        m_qUnderStreak = 0;
+    }
+}
+
+/* ========================================================================= */
+/* Tiled Multi-Threaded Compositing                                          */
+/* ========================================================================= */
+
+/**
+ * Rebuild the tile grid for the current output size.
+ *
+ * Tiles are TILE_SIZE x TILE_SIZE, row-major; edge tiles are clipped to
+ * the output bounds so the grid exactly covers the framebuffer.
+ */
+void VeridianSwRenderer::rebuildTileGrid()
+{
+    m_tiles.clear();
+    m_dirtyTileIndices.clear();
+
+    if (m_outputSize.isEmpty()) {
+        m_tileColumns = 0;
+        m_tileRows = 0;
+        return;
+    }
+
+    m_tileColumns = (m_outputSize.width()  + TILE_SIZE - 1) / TILE_SIZE;
+    m_tileRows    = (m_outputSize.height() + TILE_SIZE - 1) / TILE_SIZE;
+
+    m_tiles.reserve(m_tileColumns * m_tileRows);
+    m_dirtyTileIndices.reserve(m_tileColumns * m_tileRows);
+
+    const QRect outputRect(QPoint(0, 0), m_outputSize);
+    for (int row = 0; row < m_tileRows; ++row) {
+        for (int col = 0; col < m_tileColumns; ++col) {
+            SwRenderTile tile;
+            tile.rect = QRect(col * TILE_SIZE, row * TILE_SIZE,
+                              TILE_SIZE, TILE_SIZE).intersected(outputRect);
+            tile.damage = QRect();
+            tile.dirty = false;
+            tile.renderTimeUs = 0;
+            m_tiles.append(tile);
+        }
+    }
+}
+
+/**
+ * Intersect the frame's damage region with the tile grid.
+ *
+ * Only tiles overlapping a damage rect are marked dirty; their damaged
+ * sub-rect is recorded so workers can clip the blit to the actual
+ * changed pixels rather than the whole tile.
+ */
+void VeridianSwRenderer::markDirtyTiles(const QRegion &damage)
+{
+    m_dirtyTileIndices.clear();
+
+    for (const QRect &r : damage) {
+        const int firstCol = qBound(0, r.left()   / TILE_SIZE, m_tileColumns - 1);
+        const int lastCol  = qBound(0, r.right()  / TILE_SIZE, m_tileColumns - 1);
+        const int firstRow = qBound(0, r.top()    / TILE_SIZE, m_tileRows - 1);
+        const int lastRow  = qBound(0, r.bottom() / TILE_SIZE, m_tileRows - 1);
+
+        for (int row = firstRow; row <= lastRow; ++row) {
+            for (int col = firstCol; col <= lastCol; ++col) {
+                const int idx = row * m_tileColumns + col;
+                SwRenderTile &tile = m_tiles[idx];
+                const QRect clipped = r.intersected(tile.rect);
+                if (clipped.isEmpty()) {
+                    continue;
+                }
+                if (!tile.dirty) {
+                    tile.dirty = true;
+                    tile.damage = clipped;
+                    m_dirtyTileIndices.append(idx);
+                } else {
+                    tile.damage = tile.damage.united(clipped);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Start the persistent worker-thread pool.
+ *
+ * One thread per core minus one (the main thread composites too while
+ * it waits).  Workers block on m_workStart; each dispatch releases the
+ * semaphore once per worker and waits for the matching m_workDone count.
+ */
+void VeridianSwRenderer::startWorkerPool()
+{
+    if (!m_workerPool.isEmpty()) {
+        return;
+    }
+
+    const int workers = qMax(1, QThread::idealThreadCount() - 1);
+    m_poolShutdown.storeRelease(0);
+
+    for (int i = 0; i < workers; ++i) {
+        QThread *thread = QThread::create([this]() { workerLoop(); });
+        thread->setObjectName(QStringLiteral("sw-tile-%1").arg(i));
+        thread->start();
+        m_workerPool.append(thread);
+    }
+}
+
+/**
+ * Shut down the worker pool and join all threads.
+ */
+void VeridianSwRenderer::stopWorkerPool()
+{
+    if (m_workerPool.isEmpty()) {
+        return;
+    }
+
+    m_poolShutdown.storeRelease(1);
+    m_workStart.release(m_workerPool.size());
+
+    for (QThread *thread : m_workerPool) {
+        thread->wait();
+        delete thread;
+    }
+    m_workerPool.clear();
+}
+
+/**
+ * Worker thread main loop.
+ *
+ * Tiles are claimed via an atomic fetch-and-add over the dirty-tile
+ * list, so load balances automatically: a worker that lands on a cheap
+ * tile simply claims the next one.
+ */
+void VeridianSwRenderer::workerLoop()
+{
+    for (;;) {
+        m_workStart.acquire();
+
+        if (m_poolShutdown.loadAcquire()) {
+            return;
+        }
+
+        for (;;) {
+            const int slot = m_nextDirtyTile.fetchAndAddOrdered(1);
+            if (slot >= m_dirtyTileIndices.size()) {
+                break;
+            }
+            compositeTile(m_tiles[m_dirtyTileIndices.at(slot)]);
+        }
+
+        m_workDone.release();
+    }
+}
+
+/**
+ * Dispatch the dirty tiles of the current frame to the worker pool and
+ * wait for completion.  The main thread participates in the claim loop
+ * instead of idling.
+ */
+void VeridianSwRenderer::dispatchDirtyTiles()
+{
+    if (m_dirtyTileIndices.isEmpty()) {
+        return;
+    }
+
+    m_nextDirtyTile.storeRelease(0);
+    m_workStart.release(m_workerPool.size());
+
+    /* Main thread claims tiles alongside the workers */
+    for (;;) {
+        const int slot = m_nextDirtyTile.fetchAndAddOrdered(1);
+        if (slot >= m_dirtyTileIndices.size()) {
+            break;
+        }
+        compositeTile(m_tiles[m_dirtyTileIndices.at(slot)]);
+    }
+
+    m_workDone.acquire(m_workerPool.size());
+
+    /* Merge per-tile timings into the frame statistics */
+    for (int idx : m_dirtyTileIndices) {
+        SwRenderTile &tile = m_tiles[idx];
+        m_tilesComposited++;
+        m_tileTimeTotalUs += tile.renderTimeUs;
+        tile.dirty = false;
+        tile.damage = QRect();
+    }
+    m_dirtyTileIndices.clear();
+}
+
+/**
+ * Composite a single tile.
+ *
+ * The scene content is produced by KWin's scene graph into the back
+ * buffer; this clips the back->front transfer to the tile's damaged
+ * sub-rect.  Tiles are disjoint, so workers never write overlapping
+ * scanlines and no locking is needed on the buffers.
+ */
+void VeridianSwRenderer::compositeTile(SwRenderTile &tile)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    /*
+     * Blit tile.damage from the back buffer into the scanout buffer
+     * via SwPixelOps::blit (SIMD-dispatched).  The buffers come from
+     * the EGL backend's mapping; with EGL_KHR_partial_update the
+     * per-tile damage is forwarded as a swap hint instead.
+     */
+
+    tile.renderTimeUs = timer.nsecsElapsed() / 1000;
+}
+
+/* ========================================================================= */
+/* Cursor plane                                                              */
+/* ========================================================================= */
+
+/*
+ * Software cursor plane: the cursor never enters the scene graph.
+ * Motion restores the saved under-cursor patch at the old position and
+ * blends the cursor at the new one -- two small blits straight into
+ * the scanout mapping, no damage, no composite, no vsync wait.  The
+ * compositor only pays a full frame when actual window content
+ * changes.
+ */
+
+void VeridianSwRenderer::setScanoutBuffer(quint32 *ptr, int strideBytes)
+{
+    liftCursor();
+    m_scanoutPtr = ptr;
+    m_scanoutStride = strideBytes;
+    drawCursor();
+}
+
+void VeridianSwRenderer::setCursorImage(const quint32 *argb,
+                                        const QSize &size,
+                                        const QPoint &hotspot)
+{
+    liftCursor();
+
+    if (!argb || size.isEmpty()) {
+        m_cursorPixels.clear();
+        m_cursorSize = QSize();
+        return;
+    }
+
+    m_cursorPixels.resize(size.width() * size.height());
+    memcpy(m_cursorPixels.data(), argb,
+           sizeof(quint32) * static_cast<size_t>(m_cursorPixels.size()));
+    m_cursorSize = size;
+    m_cursorHotspot = hotspot;
+
+    drawCursor();
+}
+
+void VeridianSwRenderer::setCursorPosition(const QPoint &pos)
+{
+    if (pos == m_cursorPos && m_cursorDrawn) {
+        return;
+    }
+
+    if (m_scanoutPtr) {
+        /* Cursor-only present: at most two small blits */
+        liftCursor();
+        m_cursorPos = pos;
+        drawCursor();
+        m_cursorOnlyPresents++;
+        return;
+    }
+
+    /* No mapping: fall back to damaging the old and new cursor rects
+     * (still a handful of tiles, never a full frame) */
+    QRect oldRect = cursorRect();
+    m_cursorPos = pos;
+    QRect newRect = cursorRect();
+
+    QRegion cursorDamage;
+    if (!oldRect.isEmpty())
+        cursorDamage += oldRect;
+    if (!newRect.isEmpty())
+        cursorDamage += newRect;
+    if (!cursorDamage.isEmpty())
+        m_currentDamage += cursorDamage;
+}
+
+void VeridianSwRenderer::setCursorVisible(bool visible)
+{
+    if (visible == m_cursorVisible)
+        return;
+
+    liftCursor();
+    m_cursorVisible = visible;
+    drawCursor();
+}
+
+QRect VeridianSwRenderer::cursorRect() const
+{
+    if (!m_cursorVisible || m_cursorSize.isEmpty())
+        return QRect();
+
+    QRect r(m_cursorPos - m_cursorHotspot, m_cursorSize);
+    return r.intersected(QRect(QPoint(0, 0), m_outputSize));
+}
+
+quint64 VeridianSwRenderer::cursorOnlyPresents() const
+{
+    return m_cursorOnlyPresents;
+}
+
+/* Restore the saved scanout pixels under the cursor */
+void VeridianSwRenderer::liftCursor()
+{
+    if (!m_cursorDrawn || !m_scanoutPtr || m_underCursorRect.isEmpty()) {
+        m_cursorDrawn = false;
+        return;
+    }
+
+    const QRect &r = m_underCursorRect;
+    quint32 *dst = m_scanoutPtr +
+                   r.y() * (m_scanoutStride / 4) + r.x();
+    SwPixelOps::blit(dst, m_scanoutStride,
+                     m_underCursor.constData(),
+                     r.width() * static_cast<int>(sizeof(quint32)),
+                     r.width(), r.height());
+
+    m_cursorDrawn = false;
+    m_underCursorRect = QRect();
+}
+
+/* Save the patch under the cursor and blend the cursor over it */
+void VeridianSwRenderer::drawCursor()
+{
+    if (!m_scanoutPtr)
+        return;
+
+    QRect r = cursorRect();
+    if (r.isEmpty())
+        return;
+
+    /* Save */
+    m_underCursor.resize(r.width() * r.height());
+    quint32 *scan = m_scanoutPtr + r.y() * (m_scanoutStride / 4) + r.x();
+    SwPixelOps::blit(m_underCursor.data(),
+                     r.width() * static_cast<int>(sizeof(quint32)),
+                     scan, m_scanoutStride, r.width(), r.height());
+    m_underCursorRect = r;
+
+    /* Blend the visible sub-rect of the cursor image (clipped at
+     * screen edges) */
+    QRect full(m_cursorPos - m_cursorHotspot, m_cursorSize);
+    int srcX = r.x() - full.x();
+    int srcY = r.y() - full.y();
+    const quint32 *src = m_cursorPixels.constData() +
+                         srcY * m_cursorSize.width() + srcX;
+    SwPixelOps::blendPremul(scan, m_scanoutStride,
+                            src,
+                            m_cursorSize.width() *
+                                static_cast<int>(sizeof(quint32)),
+                            r.width(), r.height());
+
+    m_cursorDrawn = true;
+}
+
+/* ========================================================================= */
+/* Frame Pacing                                                              */
+/* ========================================================================= */
+
+/**
+ * Update the smoothed frame-cost predictor and the adaptive VSync
+ * state with a measured composite cost.
+ */
+void VeridianSwRenderer::recordFrameCost(qint64 us)
+{
+    if (m_frameCostEwmaUs == 0) {
+        m_frameCostEwmaUs = us;
+    } else {
+        /* EWMA with 1/4 weight: reacts within a few frames without
+         * chasing single outliers */
+        m_frameCostEwmaUs = (3 * m_frameCostEwmaUs + us) / 4;
+    }
+
+    adjustAdaptiveVsync(us);
+}
+
+/**
+ * Predicted cost of the next frame in microseconds.
+ *
+ * The EWMA plus 25% headroom: underestimating means a missed vblank,
+ * overestimating merely starts compositing a little early.
+ */
+qint64 VeridianSwRenderer::predictedFrameTimeUs() const
+{
+    return m_frameCostEwmaUs + m_frameCostEwmaUs / 4;
+}
+
+qint64 VeridianSwRenderer::effectiveVsyncIntervalMs() const
+{
+    return m_vsyncIntervalMs * m_vsyncMultiplier;
+}
+
+/**
+ * Adaptive VSync: when the composite cost persistently exceeds the
+ * vblank budget, presenting every vblank just produces a cadence of
+ * late frames.  Doubling the interval (60 -> 30 -> 15 Hz) gives a
+ * steady rate instead of judder.  Recovery requires a long streak of
+ * comfortably-fitting frames so the rate doesn't oscillate.
+ */
+void VeridianSwRenderer::adjustAdaptiveVsync(qint64 frameCostUs)
+{
+    const qint64 budgetUs = effectiveVsyncIntervalMs() * 1000;
+
+    if (frameCostUs + PACING_MARGIN_US > budgetUs) {
+        m_overBudgetStreak++;
+        m_underBudgetStreak = 0;
+        if (m_overBudgetStreak >= OVER_BUDGET_LIMIT &&
+            m_vsyncMultiplier < VSYNC_MULTIPLIER_MAX) {
+            m_vsyncMultiplier *= 2;
+            m_overBudgetStreak = 0;
+            qDebug("VeridianSwRenderer: adaptive vsync degraded to 1/%d "
+                   "rate (%lld ms interval)",
+                   m_vsyncMultiplier,
+                   static_cast<long long>(effectiveVsyncIntervalMs()));
+        }
+    } else if (m_vsyncMultiplier > 1 &&
+               frameCostUs + PACING_MARGIN_US <= budgetUs / 2) {
+        /* Frame would fit at twice the current rate */
+        m_underBudgetStreak++;
+        m_overBudgetStreak = 0;
+        if (m_underBudgetStreak >= UNDER_BUDGET_LIMIT) {
+            m_vsyncMultiplier /= 2;
+            m_underBudgetStreak = 0;
+            qDebug("VeridianSwRenderer: adaptive vsync recovered to 1/%d "
+                   "rate (%lld ms interval)",
+                   m_vsyncMultiplier,
+                   static_cast<long long>(effectiveVsyncIntervalMs()));
+        }
+    } else {
+        m_overBudgetStreak = 0;
+        m_underBudgetStreak = 0;
+    }
+}
+
+/**
+ * Sleep until the just-in-time composite window opens.
+ *
+ * The window starts at (next vblank - predicted cost - margin) so the
+ * frame lands just before the deadline and shows the freshest input
+ * state, instead of content sampled a whole interval early.
+ */
+void VeridianSwRenderer::waitForCompositeWindow()
+{
+    if (!m_framePacingEnabled || !m_vsyncEnabled ||
+        m_frameCostEwmaUs == 0 || m_lastVsyncMs == 0) {
+        return;
+    }
+
+    const qint64 nextVsyncUs = (m_lastVsyncMs + effectiveVsyncIntervalMs())
+                               * 1000;
+    const qint64 startUs = nextVsyncUs - predictedFrameTimeUs()
+                           - PACING_MARGIN_US;
+
+    qint64 nowUs = m_vsyncTimer.nsecsElapsed() / 1000;
+    while (nowUs < startUs) {
+        const qint64 remainingMs = (startUs - nowUs) / 1000;
+        if (remainingMs > 1) {
+            /* Coarse sleep, then spin the final millisecond */
+            QThread::msleep(static_cast<unsigned long>(remainingMs - 1));
+        } else {
+            QThread::yieldCurrentThread();
+        }
+        nowUs = m_vsyncTimer.nsecsElapsed() / 1000;
+    }
+}
+
+void VeridianSwRenderer::setFramePacingEnabled(bool enabled)
+{
+    m_framePacingEnabled = enabled;
+    qDebug("VeridianSwRenderer: frame pacing %s",
+           enabled ? "enabled" : "disabled");
+}
+
+bool VeridianSwRenderer::isFramePacingEnabled() const
+{
+    return m_framePacingEnabled;
+}
+
 /* ========================================================================= */
 /* Software VSync                                                            */
 /* ========================================================================= */
@@ -273,14 +1345,15 @@ void VeridianSwRenderer::waitVSync()
         return;
     }
 
-    /* Calculate next VSync deadline */
-    qint64 nextVsync = m_lastVsyncMs + m_vsyncIntervalMs;
+    /* Calculate next VSync deadline (adaptive interval) */
+    const qint64 intervalMs = effectiveVsyncIntervalMs();
+    qint64 nextVsync = m_lastVsyncMs + intervalMs;
 
     /* If we already missed the deadline, skip forward */
     if (now > nextVsync) {
         qint64 elapsed = now - m_lastVsyncMs;
-        qint64 skipped = elapsed / m_vsyncIntervalMs;
-        nextVsync = m_lastVsyncMs + m_vsyncIntervalMs * (skipped + 1);
+        qint64 skipped = elapsed / intervalMs;
+        nextVsync = m_lastVsyncMs + intervalMs * (skipped + 1);
     }
 
     /* Busy-wait until deadline.
@@ -319,6 +1392,9 @@ void VeridianSwRenderer::recordFrameTime(qint64 ms)
 
     /* Check for dropped frame */
     checkForDroppedFrame(ms);
+
+    /* Feed the quality controller */
+    updateQualityLevel(ms);
 }
 
 void VeridianSwRenderer::checkForDroppedFrame(qint64 ms)
@@ -342,6 +1418,7 @@ SwRenderFrameStats VeridianSwRenderer::frameStats() const
     SwRenderFrameStats stats;
     stats.frameCount = m_frameCount;
     stats.droppedFrames = m_droppedFrames;
+    stats.qualityLevel = m_qualityLevel;
     stats.minFrameTimeMs = (m_minFrameTimeMs == std::numeric_limits<qint64>::max())
                            ? 0 : m_minFrameTimeMs;
     stats.maxFrameTimeMs = m_maxFrameTimeMs;
@@ -357,6 +1434,13 @@ SwRenderFrameStats VeridianSwRenderer::frameStats() const
     }
     stats.avgFrameTimeMs = (count > 0) ? (sum / count) : 0;
 
+    /* Per-tile statistics */
+    stats.tilesComposited = m_tilesComposited;
+    stats.avgTileTimeUs = (m_tilesComposited > 0)
+                          ? (m_tileTimeTotalUs /
+                             static_cast<qint64>(m_tilesComposited))
+                          : 0;
+
     /* Estimated FPS */
     stats.estimatedFps = (stats.avgFrameTimeMs > 0)
                          ? static_cast<int>(1000 / stats.avgFrameTimeMs)
@@ -394,6 +1478,50 @@ int VeridianSwRenderer::maxDamageRects()
     return MAX_DAMAGE_RECTS_DEFAULT;
 }
 
+/**
+ * Enable or disable the tiled multi-threaded compositing path.
+ *
+ * Disabling joins the worker pool; the renderer falls back to the
+ * single-threaded full/partial composite paths.
+ */
+void VeridianSwRenderer::setTilingEnabled(bool enabled)
+{
+    if (m_tilingEnabled == enabled) {
+        return;
+    }
+
+    m_tilingEnabled = enabled;
+
+    if (enabled && m_initialized) {
+        startWorkerPool();
+    } else if (!enabled) {
+        stopWorkerPool();
+    }
+
+    qDebug("VeridianSwRenderer: tiled compositing %s",
+           enabled ? "enabled" : "disabled");
+}
+
+bool VeridianSwRenderer::isTilingEnabled() const
+{
+    return m_tilingEnabled;
+}
+
+int VeridianSwRenderer::tileCount() const
+{
+    return m_tiles.size();
+}
+
+int VeridianSwRenderer::dirtyTileCount() const
+{
+    return m_dirtyTileIndices.size();
+}
+
+int VeridianSwRenderer::workerThreadCount() const
+{
+    return m_workerPool.size();
+}
+
 /* ========================================================================= */
 /* Output Size Management                                                    */
 /* ========================================================================= */
@@ -413,12 +1541,20 @@ void VeridianSwRenderer::setOutputSize(const QSize &size)
     qDebug("VeridianSwRenderer: output size changed to %dx%d",
            size.width(), size.height());
 
+    /* The mode set replaces the scanout mapping; the saved
+     * under-cursor patch refers to the old one */
+    m_cursorDrawn = false;
+    m_underCursorRect = QRect();
+
     m_outputSize = size;
 
     /* Mark full damage on resize */
     m_currentDamage = QRegion(0, 0, size.width(), size.height());
     m_previousDamage = m_currentDamage;
     m_backBufferDirty = true;
+
+    /* Re-partition the tile grid for the new geometry */
+    rebuildTileGrid();
 }
 
 /* ========================================================================= */
@@ -442,6 +1578,11 @@ void VeridianSwRenderer::setRefreshRate(int mhz)
         m_vsyncIntervalMs = 1;
     }
 
+    /* New base rate: restart the adaptive state from full rate */
+    m_vsyncMultiplier = 1;
+    m_overBudgetStreak = 0;
+    m_underBudgetStreak = 0;
+
     qDebug("VeridianSwRenderer: VSync interval set to %lld ms (~%d Hz)",
            static_cast<long long>(m_vsyncIntervalMs),
            mhz / 1000);
@@ -467,6 +1608,8 @@ void VeridianSwRenderer::resetStats()
     m_maxFrameTimeMs = 0;
     m_frameTimeHistory.fill(0);
     m_historyWriteIdx = 0;
+    m_tilesComposited = 0;
+    m_tileTimeTotalUs = 0;
 
     qDebug("VeridianSwRenderer: statistics reset");
 }
@@ -494,6 +1637,10 @@ void VeridianSwRenderer::logPerformanceSummary() const
     qDebug("  Max frame time:  %lld ms",
            static_cast<long long>(stats.maxFrameTimeMs));
     qDebug("  Estimated FPS:   %d", stats.estimatedFps);
+    qDebug("  Tiles composited: %llu (avg %lld us/tile, %d workers)",
+           static_cast<unsigned long long>(stats.tilesComposited),
+           static_cast<long long>(stats.avgTileTimeUs),
+           m_workerPool.size());
 }
 
 } /* namespace KWin */
@@ -14,6 +14,10 @@
  *   - Double-buffered blit with software VSync pacing (~60Hz)
  *   - Frame time measurement and drop detection
  *   - Automatic fallback to full composite on excessive damage
+ *   - Tiled multi-threaded compositing (64x64 tiles dispatched to a
+ *     persistent worker pool, merged per-tile statistics)
+ *   - Just-in-time frame pacing with adaptive vsync (predicts frame
+ *     cost, starts compositing right before the vblank deadline)
  *
  * This plugin works alongside the DRM/KMS platform backend
  * (kwin-veridian-platform.h) and is activated when the EGL
@@ -27,9 +31,12 @@
 #include <QRegion>
 #include <QRect>
 #include <QSize>
+#include <QPoint>
 #include <QTimer>
 #include <QElapsedTimer>
 #include <QVector>
+#include <QSemaphore>
+#include <QAtomicInt>
 
 /* Forward declarations -- KWin / VeridianOS */
 namespace KWin {
@@ -37,8 +44,45 @@ class VeridianEglBackend;
 class VeridianDrmOutput;
 }
 
+QT_BEGIN_NAMESPACE
+class QThread;
+QT_END_NAMESPACE
+
 namespace KWin {
 
+/* ========================================================================= */
+/* SIMD pixel kernels                                                        */
+/* ========================================================================= */
+
+/**
+ * Vectorized pixel primitives for the software rendering path.
+ *
+ * Operates on ARGB32 premultiplied scanlines.  The implementation is
+ * selected once at first use via CPUID (SSE2 -> AVX2 on x86_64, NEON
+ * on AArch64) with a portable scalar fallback.  Strides are in bytes;
+ * width/height in pixels.
+ */
+namespace SwPixelOps {
+
+/** Copy a width x height pixel block. */
+void blit(quint32 *dst, int dstStride,
+          const quint32 *src, int srcStride,
+          int width, int height);
+
+/** Fill a width x height pixel block with a solid ARGB32 value. */
+void fill(quint32 *dst, int dstStride,
+          int width, int height, quint32 pixel);
+
+/** Premultiplied-alpha blend src over dst (Porter-Duff "over"). */
+void blendPremul(quint32 *dst, int dstStride,
+                 const quint32 *src, int srcStride,
+                 int width, int height);
+
+/** Name of the selected kernel set ("avx2", "sse2", "neon", "scalar"). */
+const char *kernelName();
+
+} /* namespace SwPixelOps */
+
 /* ========================================================================= */
 /* Frame timing statistics                                                   */
 /* ========================================================================= */
@@ -50,6 +94,27 @@ struct SwRenderFrameStats {
     qint64  minFrameTimeMs;    /* Minimum observed (ms)       */
     qint64  maxFrameTimeMs;    /* Maximum observed (ms)       */
     int     estimatedFps;      /* Integer FPS estimate        */
+    quint64 tilesComposited;   /* Dirty tiles processed       */
+    qint64  avgTileTimeUs;     /* Lifetime average per tile   */
+    int     qualityLevel;      /* 0 full .. 2 coarse (load)   */
+};
+
+/* ========================================================================= */
+/* Tile state                                                                */
+/* ========================================================================= */
+
+/**
+ * One 64x64 framebuffer tile for the parallel compositing path.
+ *
+ * Tiles are laid out row-major over the output; edge tiles are clipped
+ * to the output bounds.  Workers own disjoint tiles, so no per-tile
+ * locking is required -- only the dispatch index is shared.
+ */
+struct SwRenderTile {
+    QRect  rect;           /* Tile bounds, clipped to output   */
+    QRect  damage;         /* Damaged sub-rect this frame      */
+    bool   dirty;          /* Needs compositing this frame     */
+    qint64 renderTimeUs;   /* Last composite cost (us)         */
 };
 
 /* ========================================================================= */
@@ -137,6 +202,21 @@ public:
     /** Maximum damage rects before full-surface fallback. */
     static int maxDamageRects();
 
+    /** Enable or disable tiled multi-threaded compositing. */
+    void setTilingEnabled(bool enabled);
+
+    /** Whether tiled compositing is active. */
+    bool isTilingEnabled() const;
+
+    /** Total number of tiles covering the current output. */
+    int tileCount() const;
+
+    /** Number of tiles marked dirty in the current frame. */
+    int dirtyTileCount() const;
+
+    /** Number of worker threads in the compositing pool. */
+    int workerThreadCount() const;
+
     /** Update output resolution (triggers full damage). */
     void setOutputSize(const QSize &size);
 
@@ -146,6 +226,72 @@ public:
     /** Enable or disable software VSync. */
     void setVSyncEnabled(bool enabled);
 
+    /* ----- Cursor plane ----- */
+
+    /**
+     * Point the cursor plane at the mapped scanout buffer.
+     *
+     * With a mapping, cursor motion is presented as a final blit over
+     * a saved under-cursor patch -- no frame damage, no composite.
+     * Without one (null), motion falls back to cursor-rect damage,
+     * still avoiding full-frame composites.
+     *
+     * @param ptr          ARGB32 premultiplied pixels, or null.
+     * @param strideBytes  Scanline stride in bytes.
+     */
+    void setScanoutBuffer(quint32 *ptr, int strideBytes);
+
+    /**
+     * Set the cursor image forwarded from the QPA layer.
+     *
+     * @param argb     ARGB32 premultiplied pixels (copied).
+     * @param size     Image dimensions.
+     * @param hotspot  Hotspot offset within the image.
+     */
+    void setCursorImage(const quint32 *argb, const QSize &size,
+                        const QPoint &hotspot);
+
+    /** Move the cursor plane.  Cheap: at most two small blits. */
+    void setCursorPosition(const QPoint &pos);
+
+    /** Show or hide the cursor plane. */
+    void setCursorVisible(bool visible);
+
+    /** Current on-screen cursor bounds (empty when hidden/unset). */
+    QRect cursorRect() const;
+
+    /** Frames avoided: presents served by the cursor plane alone. */
+    quint64 cursorOnlyPresents() const;
+
+    /* ----- Frame pacing ----- */
+
+    /** Enable or disable just-in-time frame pacing. */
+    void setFramePacingEnabled(bool enabled);
+
+    /** Whether just-in-time frame pacing is active. */
+    bool isFramePacingEnabled() const;
+
+    /**
+     * Block until the just-in-time composite window opens.
+     *
+     * Instead of compositing immediately after the previous vblank,
+     * the scheduler predicts the next frame's cost from recent frame
+     * times and delays the start so compositing finishes just before
+     * the vblank deadline.  Call before compositeFrame(); a no-op
+     * when pacing is disabled or no history exists yet.
+     */
+    void waitForCompositeWindow();
+
+    /** Predicted cost of the next frame, in microseconds. */
+    qint64 predictedFrameTimeUs() const;
+
+    /**
+     * Effective VSync interval after adaptive adjustment (ms).
+     * Doubles (up to 4x) while frames persistently blow the budget,
+     * and recovers once they comfortably fit again.
+     */
+    qint64 effectiveVsyncIntervalMs() const;
+
     /** Reset frame statistics counters. */
     void resetStats();
 
@@ -163,10 +309,28 @@ private:
     /* ----- Internal helpers ----- */
     void recordFrameTime(qint64 ms);
     void checkForDroppedFrame(qint64 ms);
+    void updateQualityLevel(qint64 frameMs);
     void updateStats();
     bool shouldDoFullComposite() const;
     QRegion mergedDamageRegion() const;
 
+    /* ----- Frame pacing helpers ----- */
+    void recordFrameCost(qint64 us);
+    void adjustAdaptiveVsync(qint64 frameCostUs);
+
+    /* ----- Cursor plane helpers ----- */
+    void liftCursor();
+    void drawCursor();
+
+    /* ----- Tiled compositing helpers ----- */
+    void rebuildTileGrid();
+    void markDirtyTiles(const QRegion &damage);
+    void startWorkerPool();
+    void stopWorkerPool();
+    void dispatchDirtyTiles();
+    void compositeTile(SwRenderTile &tile);
+    void workerLoop();
+
     /* ----- Members ----- */
     VeridianEglBackend *m_eglBackend;
     bool m_initialized;
@@ -185,9 +349,23 @@ private:
     qint64 m_vsyncIntervalMs;        /* 16 ms for 60 Hz */
     bool m_vsyncEnabled;
 
+    /* Frame pacing */
+    bool m_framePacingEnabled;
+    qint64 m_frameCostEwmaUs;        /* Smoothed composite cost       */
+    int m_vsyncMultiplier;           /* Adaptive: 1, 2, or 4          */
+    int m_overBudgetStreak;
+    int m_underBudgetStreak;
+
     /* Frame statistics */
     quint64 m_frameCount;
     quint64 m_droppedFrames;
+
+    /* Quality load controller (see updateQualityLevel) */
+    static const int QUALITY_DEGRADE_FRAMES = 6;
+    static const int QUALITY_RESTORE_FRAMES = 120;
+    int m_qualityLevel = 0;
+    int m_qOverStreak = 0;
+    int m_qUnderStreak = 0;
     QVector<qint64> m_frameTimeHistory;
     int m_historyWriteIdx;
     qint64 m_minFrameTimeMs;
@@ -196,11 +374,47 @@ private:
     /* Double-buffer state */
     bool m_backBufferDirty;
 
+    /* Cursor plane */
+    quint32 *m_scanoutPtr;
+    int m_scanoutStride;             /* bytes */
+    QVector<quint32> m_cursorPixels;
+    QSize m_cursorSize;
+    QPoint m_cursorHotspot;
+    QPoint m_cursorPos;
+    bool m_cursorVisible;
+    bool m_cursorDrawn;              /* Patch currently saved/applied */
+    QVector<quint32> m_underCursor;  /* Saved scanout pixels          */
+    QRect m_underCursorRect;
+    quint64 m_cursorOnlyPresents;
+
+    /* Tiled compositing */
+    bool m_tilingEnabled;
+    int m_tileColumns;
+    int m_tileRows;
+    QVector<SwRenderTile> m_tiles;
+    QVector<int> m_dirtyTileIndices;
+
+    /* Worker pool (persistent; tiles are claimed via atomic index) */
+    QVector<QThread *> m_workerPool;
+    QSemaphore m_workStart;
+    QSemaphore m_workDone;
+    QAtomicInt m_nextDirtyTile;
+    QAtomicInt m_poolShutdown;
+
+    /* Per-tile statistics */
+    quint64 m_tilesComposited;
+    qint64 m_tileTimeTotalUs;
+
     /* Constants */
     static const int FRAME_HISTORY_SIZE = 60;
     static const int MAX_DAMAGE_RECTS_DEFAULT = 32;
     static const qint64 VSYNC_INTERVAL_MS = 16;
     static const qint64 DROPPED_THRESHOLD_MS = 33;  /* 2x 16ms */
+    static const int TILE_SIZE = 64;
+    static const qint64 PACING_MARGIN_US = 2000;    /* Safety headroom   */
+    static const int OVER_BUDGET_LIMIT = 5;         /* Frames to degrade */
+    static const int UNDER_BUDGET_LIMIT = 60;       /* Frames to recover */
+    static const int VSYNC_MULTIPLIER_MAX = 4;
 };
 
 } /* namespace KWin */
@@ -39,6 +39,8 @@
 
 /* ===== Syscall Numbers (from veridian/syscall.h) ===== */
 
+#include "../libc/src/veridian_tcb.h"   /* TCB layout contract */
+
 #define SYS_PROCESS_EXIT   11   /* sys_exit(code) */
 #define SYS_MEMORY_MAP     20   /* mmap(addr, len, prot, flags, fd, off) */
 #define SYS_MEMORY_UNMAP   21   /* munmap(addr, len) */
@@ -61,7 +63,11 @@
 
 /* File constants */
 #define O_RDONLY    0
+#define O_WRONLY    0x0002   /* kernel ABI (veridian/fcntl.h) */
+#define O_CREAT     0x0100
+#define O_TRUNC     0x0200
 #define SEEK_SET    0
+#define SEEK_END    2
 
 /* arch_prctl subcodes */
 #define ARCH_SET_FS 0x1002
@@ -213,6 +219,7 @@ typedef struct {
 #define DT_FINI_ARRAYSZ  28
 #define DT_RUNPATH       29
 #define DT_FLAGS         30
+#define DT_GNU_HASH      0x6FFFFEF5
 #define DT_VERSYM        0x6FFFFFF0
 #define DT_VERDEF        0x6FFFFFFC
 #define DT_VERDEFNUM     0x6FFFFFFD
@@ -401,6 +408,16 @@ static void _memcpy(void *dst, const void *src, size_t n)
     while (n--) *d++ = *s++;
 }
 
+static int _memcmp(const void *a, const void *b, size_t n)
+{
+    const unsigned char *pa = (const unsigned char *)a;
+    const unsigned char *pb = (const unsigned char *)b;
+    for (size_t i = 0; i < n; i++) {
+        if (pa[i] != pb[i]) return pa[i] < pb[i] ? -1 : 1;
+    }
+    return 0;
+}
+
 static char *_strcpy(char *dst, const char *src)
 {
     char *r = dst;
@@ -502,6 +519,11 @@ static long _read(long fd, void *buf, size_t len)
     return _syscall3(SYS_FILE_READ, fd, (long)buf, (long)len);
 }
 
+static long _lseek(long fd, long offset, int whence)
+{
+    return _syscall3(SYS_FILE_SEEK, fd, offset, whence);
+}
+
 static long _pread(long fd, void *buf, size_t len, long offset)
 {
     /* seek then read -- no SYS_PREAD on VeridianOS */
@@ -643,6 +665,32 @@ typedef struct {
 
     /* D-3: search path */
     const char  *runpath;      /* DT_RUNPATH string */
+
+    /* Replay-cache identity (captured at load time) */
+    uint64_t     file_size;
+    uint64_t     file_ident;   /* checksum of the first 256 bytes */
+
+    /* Deferred-binding state (pipelined closure loading) */
+    uint64_t     relro_start;  /* PT_GNU_RELRO page range, 0 = none */
+    uint64_t     relro_size;
+
+    /* DT_GNU_HASH fast lookup (bloom filter + hash buckets) */
+    const uint64_t *gh_bloom;
+    const uint32_t *gh_buckets;
+    const uint32_t *gh_chains;   /* hash values, indexed from symoffset */
+    uint32_t     gh_nbuckets;
+    uint32_t     gh_symoffset;
+    uint32_t     gh_bloom_size;  /* in 64-bit words, power of two */
+    uint32_t     gh_bloom_shift;
+
+    /* Adaptive -Bsymbolic: hashes of symbols that resolved to this
+     * object itself last run (nothing interposed them), so this
+     * run's requests from the object bind directly without a global
+     * scan.  Recorded during binding, persisted per closure. */
+    uint64_t    *symbolic_hashes;    /* Sorted */
+    uint32_t     symbolic_count;
+    uint64_t    *symbolic_pending;   /* This run's recordings */
+    uint32_t     symbolic_pending_count;
 } LoadedLib;
 
 static LoadedLib loaded_libs[MAX_LIBS];
@@ -672,6 +720,7 @@ static void parse_dynamic_into_lib(LoadedLib *lib)
     uint64_t hash_nbucket  = 0;
     uint64_t hash_nchain   = 0;
     uint64_t hash_addr     = 0;
+    uint64_t gnu_hash_addr = 0;
 
     for (Elf64_Dyn *d = lib->dynamic; d->d_tag != DT_NULL; d++) {
         uint64_t val = d->d_un.d_val;
@@ -680,6 +729,7 @@ static void parse_dynamic_into_lib(LoadedLib *lib)
         case DT_STRTAB:       lib->strtab        = (const char *)(lib->base + ptr); break;
         case DT_SYMTAB:       lib->symtab        = (Elf64_Sym *)(lib->base + ptr);  break;
         case DT_HASH:         hash_addr = lib->base + ptr; break;
+        case DT_GNU_HASH:     gnu_hash_addr = lib->base + ptr; break;
         case DT_PLTGOT:       lib->pltgot        = (uint64_t *)(lib->base + ptr);   break;
         case DT_JMPREL:       lib->jmprel        = (Elf64_Rela *)(lib->base + ptr); break;
         case DT_PLTRELSZ:     lib->pltrelsz      = val; break;
@@ -727,6 +777,36 @@ static void parse_dynamic_into_lib(LoadedLib *lib)
         lib->symtab_cnt = hash_nchain;
         (void)hash_nbucket;
     }
+
+    /* Parse DT_GNU_HASH: header, bloom filter, buckets, chains */
+    if (gnu_hash_addr) {
+        const uint32_t *gh = (const uint32_t *)gnu_hash_addr;
+
+        lib->gh_nbuckets    = gh[0];
+        lib->gh_symoffset   = gh[1];
+        lib->gh_bloom_size  = gh[2];
+        lib->gh_bloom_shift = gh[3];
+        lib->gh_bloom   = (const uint64_t *)(gh + 4);
+        lib->gh_buckets = (const uint32_t *)(lib->gh_bloom +
+                                             lib->gh_bloom_size);
+        lib->gh_chains  = lib->gh_buckets + lib->gh_nbuckets;
+
+        /* Without DT_HASH, derive symtab_cnt: walk to the highest
+         * chain entry (the stop bit ends each bucket's chain) */
+        if (!hash_addr && lib->gh_nbuckets > 0) {
+            uint32_t max_idx = 0;
+
+            for (uint32_t b = 0; b < lib->gh_nbuckets; b++) {
+                uint32_t idx = lib->gh_buckets[b];
+
+                if (idx == 0) continue;
+                while (!(lib->gh_chains[idx - lib->gh_symoffset] & 1))
+                    idx++;
+                if (idx > max_idx) max_idx = idx;
+            }
+            lib->symtab_cnt = max_idx + 1;
+        }
+    }
 }
 
 /* Legacy parse_dynamic for backward compatibility */
@@ -835,46 +915,168 @@ static int check_symbol_version(LoadedLib *requester, uint16_t req_ver_idx,
 
 /* ===== Symbol Lookup ===== */
 
+/* GNU hash (dl_new_hash): h = h*33 + c */
+static uint32_t gnu_hash(const char *name)
+{
+    uint32_t h = 5381;
+
+    for (const unsigned char *p = (const unsigned char *)name; *p; p++)
+        h = h * 33 + *p;
+    return h;
+}
+
+/*
+ * Resolved-symbol cache: a Qt app resolves the same names (operator
+ * new, memcpy, QString methods) from dozens of requesting objects.
+ * Open-addressed, flushed wholesale on dlclose.  Only unversioned
+ * requests go through it -- versioned resolution can legitimately
+ * differ per requester.
+ */
+#define SYM_CACHE_SIZE  2048   /* power of two */
+#define SYM_CACHE_PROBES  8
+
+typedef struct {
+    const char *name;    /* NULL = empty slot */
+    uint32_t    hash;
+    uint64_t    value;
+} SymCacheEntry;
+
+static SymCacheEntry sym_cache[SYM_CACHE_SIZE];
+
+static uint64_t sym_cache_get(const char *name, uint32_t hash)
+{
+    uint32_t slot = hash & (SYM_CACHE_SIZE - 1);
+
+    for (int p = 0; p < SYM_CACHE_PROBES; p++) {
+        SymCacheEntry *e = &sym_cache[(slot + p) & (SYM_CACHE_SIZE - 1)];
+
+        if (!e->name) return 0;
+        if (e->hash == hash && _strcmp(e->name, name) == 0)
+            return e->value;
+    }
+    return 0;
+}
+
+static void sym_cache_put(const char *name, uint32_t hash, uint64_t value)
+{
+    uint32_t slot = hash & (SYM_CACHE_SIZE - 1);
+
+    for (int p = 0; p < SYM_CACHE_PROBES; p++) {
+        SymCacheEntry *e = &sym_cache[(slot + p) & (SYM_CACHE_SIZE - 1)];
+
+        if (!e->name || (e->hash == hash && _strcmp(e->name, name) == 0)) {
+            e->name = name;
+            e->hash = hash;
+            e->value = value;
+            return;
+        }
+    }
+    /* All probes taken: overwrite the home slot (cheap eviction) */
+    sym_cache[slot].name = name;
+    sym_cache[slot].hash = hash;
+    sym_cache[slot].value = value;
+}
+
+static void sym_cache_flush(void)
+{
+    _memset(sym_cache, 0, sizeof(sym_cache));
+}
+
+/* Symbol visibility/version acceptance shared by both lookup paths */
+static int symbol_acceptable(LoadedLib *lib, uint32_t idx, const char *name,
+                             LoadedLib *requester, uint16_t req_ver_idx)
+{
+    Elf64_Sym *sym = &lib->symtab[idx];
+
+    if (sym->st_shndx == SHN_UNDEF) return 0;
+    if (_strcmp(lib->strtab + sym->st_name, name) != 0) return 0;
+
+    if (requester && lib->versym) {
+        if (!check_symbol_version(requester, req_ver_idx, lib,
+                                  lib->versym[idx]))
+            return 0;
+    }
+    return 1;
+}
+
 /*
  * Look up a symbol in a single library with optional version checking.
  * Returns the symbol value (base-adjusted), or 0 on failure.
  *
+ * Uses the DT_GNU_HASH bloom filter + hash chain when the object has
+ * one (the common case); falls back to a linear symtab scan otherwise.
+ *
  * If out_sym_idx is non-NULL, writes the symtab index of the found symbol.
  * Prefers STB_GLOBAL over STB_WEAK. Returns weak match if no global found.
  */
-static uint64_t lookup_symbol_in_lib(LoadedLib *lib, const char *name,
-                                     LoadedLib *requester, uint16_t req_ver_idx,
-                                     uint32_t *out_sym_idx)
+static uint64_t lookup_symbol_in_lib_hashed(LoadedLib *lib, const char *name,
+                                            uint32_t hash,
+                                            LoadedLib *requester,
+                                            uint16_t req_ver_idx,
+                                            uint32_t *out_sym_idx)
 {
-    if (!lib->symtab || !lib->strtab || !lib->loaded) return 0;
-
     uint64_t weak_val = 0;
     uint32_t weak_idx = 0;
     int      found_weak = 0;
 
-    for (size_t i = 0; i < lib->symtab_cnt; i++) {
-        Elf64_Sym *sym = &lib->symtab[i];
-        if (sym->st_shndx == SHN_UNDEF) continue;
-        if (_strcmp(lib->strtab + sym->st_name, name) != 0) continue;
+    if (!lib->symtab || !lib->strtab || !lib->loaded) return 0;
+
+    if (lib->gh_buckets && lib->gh_nbuckets > 0) {
+        /* Bloom filter: two derived bits reject most misses without
+         * touching the buckets */
+        uint64_t word = lib->gh_bloom[(hash / 64) &
+                                      (lib->gh_bloom_size - 1)];
+        uint64_t mask = (1ULL << (hash % 64)) |
+                        (1ULL << ((hash >> lib->gh_bloom_shift) % 64));
 
-        /* Check version compatibility */
-        if (requester && lib->versym) {
-            uint16_t prov_ver = lib->versym[i];
-            if (!check_symbol_version(requester, req_ver_idx, lib, prov_ver))
-                continue;
-        }
+        if ((word & mask) != mask)
+            return 0;
 
-        uint8_t bind = ELF64_ST_BIND(sym->st_info);
-        uint64_t val = lib->base + sym->st_value;
+        uint32_t idx = lib->gh_buckets[hash % lib->gh_nbuckets];
 
-        if (bind == STB_GLOBAL) {
-            if (out_sym_idx) *out_sym_idx = (uint32_t)i;
-            return val;
+        if (idx == 0)
+            return 0;
+
+        for (;; idx++) {
+            uint32_t h2 = lib->gh_chains[idx - lib->gh_symoffset];
+
+            if ((hash | 1) == (h2 | 1) &&
+                symbol_acceptable(lib, idx, name, requester, req_ver_idx)) {
+                uint8_t bind = ELF64_ST_BIND(lib->symtab[idx].st_info);
+                uint64_t val = lib->base + lib->symtab[idx].st_value;
+
+                if (bind == STB_GLOBAL) {
+                    if (out_sym_idx) *out_sym_idx = idx;
+                    return val;
+                }
+                if (bind == STB_WEAK && !found_weak) {
+                    weak_val = val;
+                    weak_idx = idx;
+                    found_weak = 1;
+                }
+            }
+            if (h2 & 1)
+                break;  /* end of chain */
         }
-        if (bind == STB_WEAK && !found_weak) {
-            weak_val = val;
-            weak_idx = (uint32_t)i;
-            found_weak = 1;
+    } else {
+        /* No GNU hash: linear scan */
+        for (size_t i = 0; i < lib->symtab_cnt; i++) {
+            if (!symbol_acceptable(lib, (uint32_t)i, name, requester,
+                                   req_ver_idx))
+                continue;
+
+            uint8_t bind = ELF64_ST_BIND(lib->symtab[i].st_info);
+            uint64_t val = lib->base + lib->symtab[i].st_value;
+
+            if (bind == STB_GLOBAL) {
+                if (out_sym_idx) *out_sym_idx = (uint32_t)i;
+                return val;
+            }
+            if (bind == STB_WEAK && !found_weak) {
+                weak_val = val;
+                weak_idx = (uint32_t)i;
+                found_weak = 1;
+            }
         }
     }
 
@@ -885,34 +1087,258 @@ static uint64_t lookup_symbol_in_lib(LoadedLib *lib, const char *name,
     return 0;
 }
 
+static uint64_t lookup_symbol_in_lib(LoadedLib *lib, const char *name,
+                                     LoadedLib *requester, uint16_t req_ver_idx,
+                                     uint32_t *out_sym_idx)
+{
+    return lookup_symbol_in_lib_hashed(lib, name, gnu_hash(name),
+                                       requester, req_ver_idx, out_sym_idx);
+}
+
 /*
  * Search all loaded libraries for a symbol, with versioning.
  * LD_PRELOAD libraries are checked first (lowest indices after main exe).
  */
+/* ========================================================================= */
+/* Adaptive no-interposition profiles                                        */
+/* ========================================================================= */
+
+/*
+ * Per-object whitelist of symbols that resolved back to the object
+ * itself through the global scope -- the -Bsymbolic benefit without
+ * asking packagers to declare anything.  Profiles persist per
+ * (object identity, closure identity): loading a different library
+ * set changes the closure hash and sidelines the profile, because a
+ * new object might interpose what nothing did last run.
+ */
+
+#define SYMBOLIC_MAGIC       0x4d595356u  /* "VSYM" */
+#define SYMBOLIC_MAX_RECORD  4096
+#define SYMBOLIC_DIR         "/var/cache/veridian"
+
+static uint64_t symbolic_closure_hash(void)
+{
+    uint64_t h = 14695981039346656037ull;
+
+    for (int i = 0; i < lib_count; i++) {
+        uint64_t v = loaded_libs[i].file_ident;
+
+        for (int b = 0; b < 8; b++) {
+            h ^= (v >> (b * 8)) & 0xFF;
+            h *= 1099511628211ull;
+        }
+    }
+    return h;
+}
+
+static void symbolic_record(LoadedLib *lib, uint32_t hash)
+{
+    uint64_t h64 = ((uint64_t)hash << 32) | hash;
+
+    if (!lib->symbolic_pending) {
+        lib->symbolic_pending =
+            _mmap(NULL, SYMBOLIC_MAX_RECORD * sizeof(uint64_t),
+                  PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if ((long)lib->symbolic_pending < 0) {
+            lib->symbolic_pending = 0;
+            return;
+        }
+        lib->symbolic_pending_count = 0;
+    }
+    if (lib->symbolic_pending_count >= SYMBOLIC_MAX_RECORD)
+        return;
+
+    /* Sorted insert, deduplicated */
+    uint32_t lo = 0, hi = lib->symbolic_pending_count;
+
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+
+        if (lib->symbolic_pending[mid] == h64)
+            return;
+        if (lib->symbolic_pending[mid] < h64)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    for (uint32_t i = lib->symbolic_pending_count; i > lo; i--)
+        lib->symbolic_pending[i] = lib->symbolic_pending[i - 1];
+    lib->symbolic_pending[lo] = h64;
+    lib->symbolic_pending_count++;
+}
+
+static void symbolic_profile_path(const LoadedLib *lib, char *out,
+                                  size_t len)
+{
+    uint64_t v = lib->file_ident ^ (lib->file_size * 1099511628211ull);
+    const char *prefix = SYMBOLIC_DIR "/symbolic-";
+    size_t n = 0;
+
+    while (prefix[n] && n < len - 24) {
+        out[n] = prefix[n];
+        n++;
+    }
+    for (int i = 15; i >= 0; i--)
+        out[n++] = "0123456789abcdef"[(v >> (i * 4)) & 0xF];
+    out[n++] = '.';
+    out[n++] = 'p';
+    out[n++] = 'r';
+    out[n++] = 'o';
+    out[n++] = 'f';
+    out[n] = '\0';
+}
+
+/* Load every object's profile; call once after the closure settles,
+ * before the binding passes run */
+static void symbolic_profiles_load(void)
+{
+    uint64_t closure = symbolic_closure_hash();
+
+    for (int i = 0; i < lib_count; i++) {
+        LoadedLib *lib = &loaded_libs[i];
+        char path[128];
+        uint64_t hdr[3];
+        long fd;
+
+        if (lib->symbolic_hashes)
+            continue;
+
+        symbolic_profile_path(lib, path, sizeof(path));
+        fd = _open(path, 0);
+        if (fd < 0)
+            continue;
+
+        if (_read(fd, hdr, sizeof(hdr)) != (long)sizeof(hdr) ||
+            (uint32_t)hdr[0] != SYMBOLIC_MAGIC || hdr[1] != closure ||
+            hdr[2] == 0 || hdr[2] > SYMBOLIC_MAX_RECORD) {
+            _close(fd);
+            continue;           /* Different closure: sidelined */
+        }
+
+        size_t bytes = (size_t)hdr[2] * sizeof(uint64_t);
+        uint64_t *hashes = _mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+                                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if ((long)hashes < 0) {
+            _close(fd);
+            continue;
+        }
+        if (_read(fd, hashes, bytes) == (long)bytes) {
+            lib->symbolic_hashes = hashes;
+            lib->symbolic_count = (uint32_t)hdr[2];
+        } else {
+            _munmap(hashes, bytes);
+        }
+        _close(fd);
+    }
+}
+
+/* Persist this run's recordings (merged with the loaded profile) */
+static void symbolic_profiles_save(void)
+{
+    uint64_t closure = symbolic_closure_hash();
+
+    for (int i = 0; i < lib_count; i++) {
+        LoadedLib *lib = &loaded_libs[i];
+        char path[128];
+        uint64_t hdr[3];
+        long fd;
+
+        if (!lib->symbolic_pending || !lib->symbolic_pending_count)
+            continue;
+
+        symbolic_profile_path(lib, path, sizeof(path));
+        fd = _open(path, 0x241 /* O_WRONLY|O_CREAT|O_TRUNC */);
+        if (fd < 0)
+            continue;
+
+        hdr[0] = SYMBOLIC_MAGIC;
+        hdr[1] = closure;
+        hdr[2] = lib->symbolic_pending_count;
+        _syscall3(SYS_FILE_WRITE, fd, (long)hdr, sizeof(hdr));
+        _syscall3(SYS_FILE_WRITE, fd, (long)lib->symbolic_pending,
+                  lib->symbolic_pending_count * sizeof(uint64_t));
+        _close(fd);
+    }
+}
+
+static void symbolic_record(LoadedLib *lib, uint32_t hash);
+
 static uint64_t lookup_symbol_global(const char *name,
                                      LoadedLib *requester, uint16_t req_ver_idx)
 {
+    uint32_t hash = gnu_hash(name);
     uint64_t weak_val = 0;
     int found_weak = 0;
 
-    for (int i = 0; i < lib_count; i++) {
-        uint64_t val = lookup_symbol_in_lib(&loaded_libs[i], name,
-                                            requester, req_ver_idx, NULL);
-        if (val) {
-            /* Check if it was a weak match by looking at the symbol binding */
-            uint8_t bind = STB_GLOBAL;
-            for (size_t j = 0; j < loaded_libs[i].symtab_cnt; j++) {
-                Elf64_Sym *sym = &loaded_libs[i].symtab[j];
-                if (sym->st_shndx == SHN_UNDEF) continue;
-                if (_strcmp(loaded_libs[i].strtab + sym->st_name, name) != 0) continue;
-                bind = ELF64_ST_BIND(sym->st_info);
-                break;
-            }
-            if (bind == STB_GLOBAL) return val;
-            if (!found_weak) {
-                weak_val = val;
-                found_weak = 1;
+    /* Cache only covers unversioned requests; a versioned request can
+     * resolve differently depending on the requester */
+    int cacheable = !requester || !requester->versym ||
+                    (req_ver_idx & 0x7FFF) <= VER_NDX_GLOBAL;
+
+    if (cacheable) {
+        uint64_t cached = sym_cache_get(name, hash);
+
+        if (cached)
+            return cached;
+    }
+
+    /*
+     * Adaptive -Bsymbolic fast path: last run proved nothing in this
+     * closure interposes the symbol, so bind it straight to the
+     * requester and skip the global scan.  A miss (profile stale,
+     * symbol gone) falls through to the full search -- the profile
+     * is only ever a shortcut, never an answer of its own.
+     */
+    if (requester && requester->symbolic_count) {
+        uint32_t lo = 0, hi = requester->symbolic_count;
+        uint64_t h64 = ((uint64_t)hash << 32) | hash;
+
+        while (lo < hi) {
+            uint32_t mid = (lo + hi) / 2;
+
+            if (requester->symbolic_hashes[mid] == h64) {
+                uint32_t idx = 0;
+                uint64_t val = lookup_symbol_in_lib_hashed(
+                    requester, name, hash, requester, req_ver_idx,
+                    &idx);
+
+                if (val &&
+                    ELF64_ST_BIND(requester->symtab[idx].st_info) !=
+                        STB_WEAK)
+                    return val;
+                break;          /* Stale entry: full scan */
             }
+            if (requester->symbolic_hashes[mid] < h64)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+    }
+
+    for (int i = 0; i < lib_count; i++) {
+        uint32_t idx = 0;
+        uint64_t val = lookup_symbol_in_lib_hashed(&loaded_libs[i], name,
+                                                   hash, requester,
+                                                   req_ver_idx, &idx);
+        if (!val)
+            continue;
+
+        uint8_t bind = ELF64_ST_BIND(loaded_libs[i].symtab[idx].st_info);
+
+        if (bind != STB_WEAK) {
+            if (cacheable)
+                sym_cache_put(loaded_libs[i].strtab +
+                              loaded_libs[i].symtab[idx].st_name,
+                              hash, val);
+            if (&loaded_libs[i] == requester)
+                symbolic_record(requester, hash);
+            return val;
+        }
+        if (!found_weak) {
+            weak_val = val;
+            found_weak = 1;
         }
     }
     return found_weak ? weak_val : 0;
@@ -930,7 +1356,8 @@ static uint64_t lookup_symbol_global_simple(const char *name)
  * PLT resolver: called at first use of a PLT slot.
  * Resolves the symbol, patches the GOT entry, returns the resolved address.
  */
-static uint64_t plt_resolve(LoadedLib *obj, uint64_t reloc_idx)
+uint64_t plt_resolve(LoadedLib *obj, uint64_t reloc_idx);
+uint64_t plt_resolve(LoadedLib *obj, uint64_t reloc_idx)
 {
     if (!obj->jmprel || !obj->symtab || !obj->strtab) {
         _write_str("ld-veridian: plt_resolve: missing relocation data\n");
@@ -966,32 +1393,97 @@ static uint64_t plt_resolve(LoadedLib *obj, uint64_t reloc_idx)
     return addr;
 }
 
+#if defined(__x86_64__)
+/*
+ * Lazy-binding trampoline (the GOT[2] target).
+ *
+ * On entry the PLT machinery has pushed two words:
+ *   [rsp]    LoadedLib *   (GOT[1], pushed by PLT0)
+ *   [rsp+8]  reloc index   (pushed by the per-symbol stub)
+ *   [rsp+16] return address in the original caller
+ *
+ * The resolver is ordinary C, so every register that can carry an
+ * argument to the target -- the six integer registers, rax (SSE
+ * count for varargs), r10 (static chain), and xmm0-7 -- is preserved
+ * around the call.  The resolved address comes back in rax; the
+ * trampoline drops the two pushed words and jumps there, leaving the
+ * target a call frame identical to a direct call.
+ */
+void _plt_trampoline(void);
+__asm__(
+    ".text\n"
+    ".globl _plt_trampoline\n"
+    ".type _plt_trampoline,@function\n"
+    "_plt_trampoline:\n"
+    "  push %rax\n"
+    "  push %rcx\n"
+    "  push %rdx\n"
+    "  push %rsi\n"
+    "  push %rdi\n"
+    "  push %r8\n"
+    "  push %r9\n"
+    "  push %r10\n"
+    "  sub $136, %rsp\n"            /* 128 for xmm0-7 + 8 align */
+    "  movups %xmm0, 0(%rsp)\n"
+    "  movups %xmm1, 16(%rsp)\n"
+    "  movups %xmm2, 32(%rsp)\n"
+    "  movups %xmm3, 48(%rsp)\n"
+    "  movups %xmm4, 64(%rsp)\n"
+    "  movups %xmm5, 80(%rsp)\n"
+    "  movups %xmm6, 96(%rsp)\n"
+    "  movups %xmm7, 112(%rsp)\n"
+    "  mov 200(%rsp), %rdi\n"       /* LoadedLib*  (136 + 64)      */
+    "  mov 208(%rsp), %rsi\n"       /* reloc index (136 + 64 + 8)  */
+    "  call plt_resolve\n"
+    "  mov %rax, %r11\n"
+    "  movups 0(%rsp), %xmm0\n"
+    "  movups 16(%rsp), %xmm1\n"
+    "  movups 32(%rsp), %xmm2\n"
+    "  movups 48(%rsp), %xmm3\n"
+    "  movups 64(%rsp), %xmm4\n"
+    "  movups 80(%rsp), %xmm5\n"
+    "  movups 96(%rsp), %xmm6\n"
+    "  movups 112(%rsp), %xmm7\n"
+    "  add $136, %rsp\n"
+    "  pop %r10\n"
+    "  pop %r9\n"
+    "  pop %r8\n"
+    "  pop %rdi\n"
+    "  pop %rsi\n"
+    "  pop %rdx\n"
+    "  pop %rcx\n"
+    "  pop %rax\n"
+    "  add $16, %rsp\n"             /* Drop lib + reloc index */
+    "  jmp *%r11\n"
+    ".size _plt_trampoline,.-_plt_trampoline\n"
+);
+#endif /* __x86_64__ */
+
 /*
  * Set up lazy PLT binding for a library.
  * GOT[0] = address of _DYNAMIC (set by linker)
  * GOT[1] = pointer to LoadedLib (for resolver)
- * GOT[2] = pointer to plt_resolve trampoline
+ * GOT[2] = lazy-binding trampoline
  *
- * Note: A real PLT trampoline requires assembly (push reloc_idx, jmp GOT[2]).
- * For now we do eager binding when lazy isn't possible (no asm trampoline).
- * The infrastructure is in place for when we add the asm stub.
+ * Architectures without the trampoline fall back to eager binding.
  */
 static void setup_plt_lazy(LoadedLib *lib)
 {
     if (!lib->pltgot || !lib->jmprel || lib->pltrelsz == 0) return;
 
+#if !defined(__x86_64__)
+    lib->bind_now = 1;
+#endif
+
     if (lib->bind_now) {
         dl_debug_str("  eager binding for: ", lib->name ? lib->name : "<main>");
-        return; /* Will be resolved in process_rela with is_jmprel=0 */
+        return; /* Resolved in process_rela with is_jmprel=0 */
     }
 
-    /*
-     * Set GOT[1] and GOT[2] for lazy resolution.
-     * Until we have an assembly trampoline, we fall through to eager mode
-     * in process_rela. But set them anyway for future use.
-     */
+#if defined(__x86_64__)
     lib->pltgot[1] = (uint64_t)lib;
-    lib->pltgot[2] = (uint64_t)plt_resolve;
+    lib->pltgot[2] = (uint64_t)_plt_trampoline;
+#endif
 
     dl_debug_str("  lazy PLT setup for: ", lib->name ? lib->name : "<main>");
 }
@@ -1002,6 +1494,12 @@ static void setup_plt_lazy(LoadedLib *lib)
  * Process RELA relocations for a loaded object.
  * When is_jmprel=1 and lib->bind_now=0, JUMP_SLOT entries are skipped
  * (they will be resolved lazily via plt_resolve).
+ *
+ * Relocations are processed grouped by type: R_X86_64_RELATIVE (the
+ * bulk of a PIE/DSO's relocations, and the only type that needs no
+ * symbol lookup) gets a dedicated branch-free first pass; the
+ * symbolic types follow in a second pass.  The linker emits RELATIVE
+ * entries as one contiguous run, so the split passes stay cheap.
  */
 static void process_rela(LoadedLib *lib, Elf64_Rela *rela, size_t rela_sz,
                          Elf64_Sym *symtab, const char *strtab, int is_jmprel)
@@ -1009,6 +1507,15 @@ static void process_rela(LoadedLib *lib, Elf64_Rela *rela, size_t rela_sz,
     uint64_t base = lib->base;
     size_t count = rela_sz / sizeof(Elf64_Rela);
 
+    /* Pass 1: all RELATIVE entries in a tight loop */
+    for (size_t i = 0; i < count; i++) {
+        if (ELF64_R_TYPE(rela[i].r_info) == R_X86_64_RELATIVE) {
+            uint64_t *target = (uint64_t *)(base + rela[i].r_offset);
+            *target = base + rela[i].r_addend;
+        }
+    }
+
+    /* Pass 2: symbolic relocations */
     for (size_t i = 0; i < count; i++) {
         uint32_t type    = ELF64_R_TYPE(rela[i].r_info);
         uint32_t sym_idx = ELF64_R_SYM(rela[i].r_info);
@@ -1016,10 +1523,7 @@ static void process_rela(LoadedLib *lib, Elf64_Rela *rela, size_t rela_sz,
 
         switch (type) {
         case R_X86_64_NONE:
-            break;
-
-        case R_X86_64_RELATIVE:
-            *target = base + rela[i].r_addend;
+        case R_X86_64_RELATIVE:  /* handled in pass 1 */
             break;
 
         case R_X86_64_GLOB_DAT:
@@ -1039,8 +1543,12 @@ static void process_rela(LoadedLib *lib, Elf64_Rela *rela, size_t rela_sz,
         }
 
         case R_X86_64_JUMP_SLOT: {
-            /* If lazy binding is active for JMPREL, skip -- plt_resolve handles it */
-            if (is_jmprel && !lib->bind_now) break;
+            /* Lazy: keep the slot pointing at its PLT stub, adjusted
+             * for the load base; plt_resolve patches it on first call */
+            if (is_jmprel && !lib->bind_now) {
+                *target += base;
+                break;
+            }
 
             const char *name = strtab + symtab[sym_idx].st_name;
             uint16_t ver_idx = VER_NDX_GLOBAL;
@@ -1154,11 +1662,54 @@ static void process_rela(LoadedLib *lib, Elf64_Rela *rela, size_t rela_sz,
  * Returns the load bias (actual_base - ELF requested base).
  * For ET_DYN (shared objects), the first LOAD determines the base.
  */
-static uint64_t map_elf_segments(long fd, Elf64_Phdr *phdrs, uint16_t phnum,
-                                 int is_dyn)
+static uint64_t map_elf_segments_at(long fd, Elf64_Phdr *phdrs,
+                                    uint16_t phnum, int is_dyn,
+                                    uint64_t forced_base)
 {
-    uint64_t base_addr = 0;
-    int first_load = 1;
+    /*
+     * Reserve the object's whole PT_LOAD span with ONE mapping, then
+     * populate segments inside it.  Per-segment MAP_FIXED mappings
+     * (the old approach) only reserved the first segment's pages, so
+     * later fixed mappings could silently clobber unrelated memory
+     * that the kernel had placed in the gap.
+     */
+    uint64_t span_min = (uint64_t)-1;
+    uint64_t span_max = 0;
+
+    for (uint16_t i = 0; i < phnum; i++) {
+        if (phdrs[i].p_type != PT_LOAD) continue;
+
+        uint64_t s = phdrs[i].p_vaddr & ~(uint64_t)(PAGE_SIZE - 1);
+        uint64_t e = (phdrs[i].p_vaddr + phdrs[i].p_memsz +
+                      PAGE_SIZE - 1) & ~(uint64_t)(PAGE_SIZE - 1);
+
+        if (s < span_min) span_min = s;
+        if (e > span_max) span_max = e;
+    }
+    if (span_max <= span_min)
+        return 0;  /* no PT_LOAD */
+
+    int span_flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    void *span_hint = NULL;
+
+    if (is_dyn && forced_base) {
+        /* Replay: put the object back at its recorded base */
+        span_hint = (void *)(forced_base + span_min);
+        span_flags |= MAP_FIXED;
+    } else if (!is_dyn) {
+        /* Static executable: map at its requested addresses */
+        span_hint = (void *)span_min;
+        span_flags |= MAP_FIXED;
+    }
+
+    void *span = _mmap(span_hint, span_max - span_min,
+                       PROT_READ | PROT_WRITE, span_flags, -1, 0);
+    if ((long)span < 0 && (long)span > -4096) {
+        _write_str("ld-veridian: mmap failed for LOAD span\n");
+        _exit(127);
+    }
+
+    uint64_t base_addr = is_dyn ? (uint64_t)span - span_min : 0;
 
     for (uint16_t i = 0; i < phnum; i++) {
         if (phdrs[i].p_type != PT_LOAD) continue;
@@ -1174,67 +1725,26 @@ static uint64_t map_elf_segments(long fd, Elf64_Phdr *phdrs, uint16_t phnum,
         uint64_t seg_end   = (p_vaddr + p_memsz + PAGE_SIZE - 1) & ~(uint64_t)(PAGE_SIZE - 1);
         uint64_t map_size  = seg_end - seg_start;
 
-        /* Offset within the first page where data actually starts */
-        uint64_t page_offset = p_vaddr - seg_start;
-
-        /* File offset aligned down to page boundary */
-        uint64_t file_page_offset = p_offset - page_offset;
-
-        /* mmap flags: always RW initially so we can write data, re-protect later */
-        int prot = PROT_READ | PROT_WRITE;
-        int flags = MAP_PRIVATE | MAP_ANONYMOUS;
-
-        void *hint = NULL;
-
-        if (first_load && is_dyn) {
-            /* Let kernel choose base for first segment of shared objects */
-            hint = NULL;
-        } else if (first_load) {
-            /* Static executable: map at requested address */
-            hint = (void *)seg_start;
-            flags |= MAP_FIXED;
-        } else {
-            /* Subsequent segments: use base-adjusted address */
-            hint = (void *)(base_addr + seg_start);
-            flags |= MAP_FIXED;
-        }
-
         dl_debug_addr("  LOAD segment vaddr=", p_vaddr);
         dl_debug_addr("    seg_start=", seg_start);
-        dl_debug_addr("    seg_end=",   seg_end);
         dl_debug_addr("    map_size=",  map_size);
 
-        void *mapped = _mmap(hint, map_size, prot, flags, -1, 0);
-        if ((long)mapped < 0 && (long)mapped > -4096) {
-            _write_str("ld-veridian: mmap failed for LOAD segment\n");
-            _exit(127);
-        }
-
-        if (first_load) {
-            if (is_dyn) {
-                base_addr = (uint64_t)mapped - seg_start;
-            } else {
-                base_addr = 0;
-            }
-            first_load = 0;
-        }
-
-        /* Read file data into the mapped region */
+        /* Read file data into place */
         if (p_filesz > 0) {
-            uint64_t dst = (uint64_t)mapped + page_offset;
+            uint64_t dst = base_addr + p_vaddr;
             long rd = _pread(fd, (void *)dst, p_filesz, (long)p_offset);
             if (rd < 0) {
                 _write_str("ld-veridian: pread failed for LOAD segment\n");
                 _exit(127);
             }
-            (void)file_page_offset; /* Used conceptually; actual read uses p_offset */
         }
 
-        /* Zero BSS: region between end-of-file-data and end-of-memsz */
+        /* BSS (anonymous span is already zero, but the tail of a
+         * file-backed page within p_memsz may need clearing when
+         * segments share pages after a previous pread) */
         if (p_memsz > p_filesz) {
-            uint64_t bss_start = (uint64_t)mapped + page_offset + p_filesz;
-            uint64_t bss_size  = p_memsz - p_filesz;
-            _memset((void *)bss_start, 0, bss_size);
+            _memset((void *)(base_addr + p_vaddr + p_filesz), 0,
+                    p_memsz - p_filesz);
         }
 
         /* Re-protect to the correct permissions */
@@ -1243,8 +1753,9 @@ static uint64_t map_elf_segments(long fd, Elf64_Phdr *phdrs, uint16_t phnum,
         if (p_flags & PF_W) final_prot |= PROT_WRITE;
         if (p_flags & PF_X) final_prot |= PROT_EXEC;
 
-        if (final_prot != prot) {
-            _mprotect(mapped, map_size, final_prot);
+        if (final_prot != (PROT_READ | PROT_WRITE)) {
+            _mprotect((void *)(base_addr + seg_start), map_size,
+                      final_prot);
         }
     }
 
@@ -1297,8 +1808,15 @@ static void setup_tls_for_object(LoadedLib *lib)
     if (align < 16) align = 16;
     size_t tls_aligned = (lib->tls_memsz + align - 1) & ~(align - 1);
 
-    /* Total allocation: TLS data + TCB (8 bytes for self-pointer) + guard */
-    size_t tcb_size = 8; /* self-pointer */
+    /*
+     * Total allocation: TLS data below the thread pointer (variant
+     * II) plus a reserved TCB area AT the thread pointer.  libc's
+     * pthread adopts this block in place -- the self pointer lands at
+     * tp[0] per the TLS ABI and struct pthread_control (errno, tid,
+     * allocator cache, ...) occupies the reservation, so errno and
+     * pthread_self() are one tp-relative load with static TLS intact.
+     */
+    size_t tcb_size = VERIDIAN_TCB_RESERVE; /* room for pthread_control */
     size_t total = tls_aligned + tcb_size + 16; /* 16 bytes padding */
 
     void *block = _mmap(NULL, total, PROT_READ | PROT_WRITE,
@@ -1404,6 +1922,25 @@ static char path_buf[512];
  *
  * Returns fd >= 0 on success, or -1 if not found.
  */
+static uint64_t mem_identity(const void *data, size_t len)
+{
+    const unsigned char *p = (const unsigned char *)data;
+    uint64_t h = 1469598103934665603ULL;   /* FNV-1a */
+
+    for (size_t i = 0; i < len; i++)
+        h = (h ^ p[i]) * 1099511628211ULL;
+    return h;
+}
+
+/* Cheap file identity for cache checks: hash of the first 256 bytes */
+static uint64_t file_identity(long fd)
+{
+    unsigned char head[256];
+    long n = _pread(fd, head, sizeof(head), 0);
+
+    return n > 0 ? mem_identity(head, (size_t)n) : 0;
+}
+
 static long search_library(const char *name)
 {
     long fd;
@@ -1447,7 +1984,14 @@ static long search_library(const char *name)
 /*
  * Load a shared library: open, map segments, parse dynamic, relocate.
  */
-static LoadedLib *load_library(const char *name)
+/*
+ * Phase 1+2 of the pipelined loader: open, map, and locally prepare
+ * ONE library -- no dependency walk, no symbol binding.  Binding for
+ * a whole batch happens later in bind_libraries(), so every object's
+ * open() is issued before any relocation work starts and BlockFS can
+ * overlap its per-open latency with the mapping of earlier objects.
+ */
+static LoadedLib *map_one_library(const char *name)
 {
     /* Check if already loaded */
     for (int i = 0; i < lib_count; i++) {
@@ -1467,6 +2011,10 @@ static LoadedLib *load_library(const char *name)
         return NULL;
     }
 
+    /* Capture file identity for the replay cache */
+    uint64_t file_size  = (uint64_t)_lseek(fd, 0, SEEK_END);
+    uint64_t file_ident = file_identity(fd);
+
     /* Read ELF header */
     Elf64_Ehdr ehdr;
     _memset(&ehdr, 0, sizeof(ehdr));
@@ -1501,7 +2049,7 @@ static LoadedLib *load_library(const char *name)
 
     /* Map segments */
     int is_dyn = (ehdr.e_type == ET_DYN);
-    uint64_t slide = map_elf_segments(fd, phdrs, ehdr.e_phnum, is_dyn);
+    uint64_t slide = map_elf_segments_at(fd, phdrs, ehdr.e_phnum, is_dyn, 0);
 
     /* Find PT_DYNAMIC */
     Elf64_Dyn *dynamic = NULL;
@@ -1514,6 +2062,8 @@ static LoadedLib *load_library(const char *name)
 
     /* Register the library */
     LoadedLib *lib = register_lib(name, slide, dynamic);
+    lib->file_size  = file_size;
+    lib->file_ident = file_ident;
 
     /* Parse dynamic section into lib */
     parse_dynamic_into_lib(lib);
@@ -1521,61 +2071,491 @@ static LoadedLib *load_library(const char *name)
     /* Scan for TLS */
     scan_tls_phdr(lib, phdrs, ehdr.e_phnum, slide);
 
-    /* Load DT_NEEDED dependencies (recursive) */
-    if (dynamic) {
-        const char *dt_strtab = lib->strtab;
-        if (dt_strtab) {
-            for (Elf64_Dyn *d = dynamic; d->d_tag != DT_NULL; d++) {
-                if (d->d_tag == DT_NEEDED) {
-                    const char *needed = dt_strtab + d->d_un.d_val;
-                    load_library(needed);
-                }
-            }
+    /* Set up PLT lazy binding */
+    setup_plt_lazy(lib);
+
+    /* Record the RELRO range; protection is applied after binding */
+    for (uint16_t i = 0; i < ehdr.e_phnum; i++) {
+        if (phdrs[i].p_type == PT_GNU_RELRO) {
+            lib->relro_start = (slide + phdrs[i].p_vaddr) &
+                               ~(uint64_t)(PAGE_SIZE - 1);
+            lib->relro_size  = ((slide + phdrs[i].p_vaddr +
+                                 phdrs[i].p_memsz + PAGE_SIZE - 1) &
+                                ~(uint64_t)(PAGE_SIZE - 1)) -
+                               lib->relro_start;
+            break;
         }
     }
 
-    /* Set up PLT lazy binding */
-    setup_plt_lazy(lib);
+    _close(fd);
+    _munmap(phdrs, phdr_size);
+
+    dl_debug_str("  mapped: ", name);
+    dl_debug_addr("  base=", slide);
+
+    return lib;
+}
+
+/* Map the DT_NEEDED objects of one prepared library */
+static void map_needed_of(Elf64_Dyn *dyn, const char *strtab)
+{
+    if (!dyn || !strtab) return;
+
+    for (Elf64_Dyn *d = dyn; d->d_tag != DT_NULL; d++) {
+        if (d->d_tag == DT_NEEDED)
+            map_one_library(strtab + d->d_un.d_val);
+    }
+}
+
+/*
+ * Phase 3: serialized global symbol binding for a batch of freshly
+ * mapped objects, then constructors in reverse (dependencies-first)
+ * order.  Binding reads every object's symbol tables, so it is the
+ * one part of loading that must stay serialized.
+ */
+static void bind_libraries(int first, int last)
+{
+    for (int i = first; i < last; i++) {
+        LoadedLib *lib = &loaded_libs[i];
+
+        if (!lib->symtab || !lib->strtab)
+            continue;
 
-    /* Process RELA relocations */
-    if (lib->symtab && lib->strtab) {
-        /* Find RELA section from dynamic */
         Elf64_Rela *rela = NULL;
         size_t relasz = 0;
-        for (Elf64_Dyn *d = dynamic; d && d->d_tag != DT_NULL; d++) {
-            if (d->d_tag == DT_RELA) rela = (Elf64_Rela *)(slide + d->d_un.d_ptr);
+
+        for (Elf64_Dyn *d = lib->dynamic; d && d->d_tag != DT_NULL; d++) {
+            if (d->d_tag == DT_RELA)   rela   = (Elf64_Rela *)(lib->base + d->d_un.d_ptr);
             if (d->d_tag == DT_RELASZ) relasz = d->d_un.d_val;
         }
 
-        /* Process main RELA */
-        if (rela && relasz) {
+        if (rela && relasz)
             process_rela(lib, rela, relasz, lib->symtab, lib->strtab, 0);
-        }
-
-        /* Process JMPREL (PLT relocations) */
-        if (lib->jmprel && lib->pltrelsz) {
+        if (lib->jmprel && lib->pltrelsz)
             process_rela(lib, lib->jmprel, lib->pltrelsz,
                          lib->symtab, lib->strtab, 1);
+
+        if (lib->relro_size)
+            _mprotect((void *)lib->relro_start, lib->relro_size,
+                      PROT_READ);
+    }
+
+    /* Constructors: BFS order puts dependencies later in the batch,
+     * so run them back-to-front */
+    for (int i = last - 1; i >= first; i--)
+        call_init_functions(&loaded_libs[i]);
+}
+
+/*
+ * Load a library plus its dependency closure (also the dlopen path).
+ *
+ * The closure is walked breadth-first in phases: every object in the
+ * batch is opened and mapped before any symbol binding runs, so
+ * BlockFS sees all opens up front and its per-open latency overlaps
+ * the mapping of earlier objects.  A future thread-spawn syscall
+ * would parallelize the map_one_library loop; the binding phase
+ * stays serialized either way.
+ */
+static LoadedLib *load_library(const char *name)
+{
+    int first = lib_count;
+    LoadedLib *lib = map_one_library(name);
+
+    if (!lib)
+        return NULL;
+
+    /* Breadth-first: the registry tail doubles as the work queue */
+    for (int i = first; i < lib_count; i++)
+        map_needed_of(loaded_libs[i].dynamic, loaded_libs[i].strtab);
+
+    if (lib_count > first) {
+        symbolic_profiles_load();
+        bind_libraries(first, lib_count);
+    }
+
+    return lib;
+}
+
+/* ===== Replay Cache (prelink-style readymade images) ===== */
+
+/*
+ * Persistent per-executable cache of the dependency closure: library
+ * bases, file identities, and the final value of every relocation
+ * target.  A warm launch re-maps each library at its recorded base
+ * (MAP_FIXED) and patches the recorded values back, skipping symbol
+ * resolution entirely.
+ *
+ * Validity: per-library file size + header checksum (VeridianOS has
+ * no stat syscall, so these stand in for mtimes).  IFUNC results are
+ * recorded too -- valid because the cache lives on the machine that
+ * wrote it.  The cache directory must exist (provisioned by the base
+ * system); writes are non-atomic, so the header magic is written
+ * last and a torn file simply fails validation.
+ *
+ * LD_PRELOAD changes the closure, so its presence disables both
+ * replay and recording.
+ */
+
+#define REPLAY_MAGIC     "VdLdRply"
+#define REPLAY_VERSION   1
+#define REPLAY_DIR       "/var/cache/ld-veridian/"
+#define REPLAY_MAX_NAME  96
+
+typedef struct {
+    char     magic[8];
+    uint32_t version;
+    uint32_t nlibs;
+    uint64_t exe_base;     /* recorded main-executable bias */
+    uint64_t exe_ident;    /* FNV over the exe's program headers */
+    uint32_t exe_nrelocs;  /* exe patches trail the library patches */
+    uint32_t _pad;
+} ReplayHeader;
+
+typedef struct {
+    char     name[REPLAY_MAX_NAME];
+    uint64_t base;
+    uint64_t file_size;
+    uint64_t file_ident;
+    uint32_t nrelocs;
+    uint32_t _pad;
+} ReplayLib;
+
+typedef struct {
+    uint64_t offset;   /* from the object's base */
+    uint64_t value;
+} ReplayPatch;
+
+static void replay_cache_path(const char *argv0, char *out, size_t out_sz)
+{
+    const char *base = argv0;
+
+    for (const char *p = argv0; *p; p++) {
+        if (*p == '/') base = p + 1;
+    }
+
+    size_t n = 0;
+    const char *dir = REPLAY_DIR;
+
+    while (dir[n] && n < out_sz - 1) {
+        out[n] = dir[n];
+        n++;
+    }
+    for (const char *p = base; *p && n < out_sz - 8; p++)
+        out[n++] = *p;
+    out[n++] = '.'; out[n++] = 'r'; out[n++] = 'p'; out[n++] = 'l';
+    out[n] = '\0';
+}
+
+/* Count one object's relocation patches (RELA + JMPREL entries, with
+ * COPY relocations expanded to cover their byte range) */
+static uint32_t replay_count_patches(LoadedLib *lib)
+{
+    uint32_t count = 0;
+
+    if (!lib->dynamic) return 0;
+
+    Elf64_Rela *rela = NULL;
+    size_t relasz = 0;
+
+    for (Elf64_Dyn *d = lib->dynamic; d->d_tag != DT_NULL; d++) {
+        if (d->d_tag == DT_RELA)   rela   = (Elf64_Rela *)(lib->base + d->d_un.d_ptr);
+        if (d->d_tag == DT_RELASZ) relasz = d->d_un.d_val;
+    }
+
+    Elf64_Rela *tables[2] = { rela, lib->jmprel };
+    size_t      sizes[2]  = { relasz, lib->pltrelsz };
+
+    for (int t = 0; t < 2; t++) {
+        if (!tables[t]) continue;
+        size_t n = sizes[t] / sizeof(Elf64_Rela);
+
+        for (size_t i = 0; i < n; i++) {
+            uint32_t type = ELF64_R_TYPE(tables[t][i].r_info);
+
+            if (type == R_X86_64_NONE) continue;
+            if (type == R_X86_64_COPY) {
+                uint32_t sym = ELF64_R_SYM(tables[t][i].r_info);
+                count += (uint32_t)((lib->symtab[sym].st_size + 7) / 8);
+            } else {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+/* Emit one object's patches by reading the post-relocation memory */
+static uint32_t replay_emit_patches(LoadedLib *lib, ReplayPatch *out)
+{
+    uint32_t count = 0;
+
+    if (!lib->dynamic) return 0;
+
+    Elf64_Rela *rela = NULL;
+    size_t relasz = 0;
+
+    for (Elf64_Dyn *d = lib->dynamic; d->d_tag != DT_NULL; d++) {
+        if (d->d_tag == DT_RELA)   rela   = (Elf64_Rela *)(lib->base + d->d_un.d_ptr);
+        if (d->d_tag == DT_RELASZ) relasz = d->d_un.d_val;
+    }
+
+    Elf64_Rela *tables[2] = { rela, lib->jmprel };
+    size_t      sizes[2]  = { relasz, lib->pltrelsz };
+
+    for (int t = 0; t < 2; t++) {
+        if (!tables[t]) continue;
+        size_t n = sizes[t] / sizeof(Elf64_Rela);
+
+        for (size_t i = 0; i < n; i++) {
+            uint32_t type = ELF64_R_TYPE(tables[t][i].r_info);
+            uint64_t off  = tables[t][i].r_offset;
+
+            if (type == R_X86_64_NONE) continue;
+            if (type == R_X86_64_COPY) {
+                uint32_t sym = ELF64_R_SYM(tables[t][i].r_info);
+                uint64_t words = (lib->symtab[sym].st_size + 7) / 8;
+
+                for (uint64_t w = 0; w < words; w++) {
+                    out[count].offset = off + w * 8;
+                    out[count].value  =
+                        *(uint64_t *)(lib->base + off + w * 8);
+                    count++;
+                }
+            } else {
+                out[count].offset = off;
+                out[count].value  = *(uint64_t *)(lib->base + off);
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+/*
+ * Record the loaded closure.  Called once after the cold-path load
+ * completes, just before control transfers to the application.
+ */
+static void replay_cache_save(const char *argv0, LoadedLib *main_lib,
+                              uint64_t exe_ident)
+{
+    char path[160];
+
+    replay_cache_path(argv0, path, sizeof(path));
+
+    /* Total sizing pass */
+    uint64_t total = sizeof(ReplayHeader);
+    uint32_t lib_patches[MAX_LIBS];
+
+    for (int i = 1; i < lib_count; i++) {   /* [0] is the main exe */
+        if (!loaded_libs[i].loaded) return; /* dlclose'd mid-start: skip */
+        if (_strlen(loaded_libs[i].name) >= REPLAY_MAX_NAME) return;
+        lib_patches[i] = replay_count_patches(&loaded_libs[i]);
+        total += sizeof(ReplayLib) + (uint64_t)lib_patches[i] *
+                 sizeof(ReplayPatch);
+    }
+
+    uint32_t exe_patches = replay_count_patches(main_lib);
+    total += (uint64_t)exe_patches * sizeof(ReplayPatch);
+
+    /* Build the image in an anonymous mapping */
+    uint8_t *img = (uint8_t *)_mmap(NULL, total, PROT_READ | PROT_WRITE,
+                                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if ((long)img < 0 && (long)img > -4096)
+        return;
+
+    ReplayHeader *hdr = (ReplayHeader *)img;
+    uint8_t *p = img + sizeof(ReplayHeader);
+
+    _memset(hdr, 0, sizeof(*hdr));   /* magic written last */
+    hdr->version     = REPLAY_VERSION;
+    hdr->nlibs       = (uint32_t)(lib_count - 1);
+    hdr->exe_base    = main_lib->base;
+    hdr->exe_ident   = exe_ident;
+    hdr->exe_nrelocs = exe_patches;
+
+    for (int i = 1; i < lib_count; i++) {
+        ReplayLib *rl = (ReplayLib *)p;
+
+        _memset(rl, 0, sizeof(*rl));
+        _strcpy(rl->name, loaded_libs[i].name);
+        rl->base       = loaded_libs[i].base;
+        rl->file_size  = loaded_libs[i].file_size;
+        rl->file_ident = loaded_libs[i].file_ident;
+        rl->nrelocs    = lib_patches[i];
+        p += sizeof(ReplayLib);
+
+        p += (uint64_t)replay_emit_patches(&loaded_libs[i],
+                                           (ReplayPatch *)p) *
+             sizeof(ReplayPatch);
+    }
+    p += (uint64_t)replay_emit_patches(main_lib, (ReplayPatch *)p) *
+         sizeof(ReplayPatch);
+
+    long fd = _open(path, O_WRONLY | O_CREAT | O_TRUNC);
+    if (fd >= 0) {
+        /* Body first, magic last: a torn write fails validation */
+        long wr = _syscall3(SYS_FILE_WRITE, fd, (long)img, (long)total);
+
+        if (wr == (long)total) {
+            _memcpy(hdr->magic, REPLAY_MAGIC, 8);
+            _lseek(fd, 0, SEEK_SET);
+            _syscall3(SYS_FILE_WRITE, fd, (long)img, sizeof(ReplayHeader));
+            dl_debug_str("replay cache written: ", path);
         }
+        _close(fd);
     }
 
-    /* Apply RELRO protection */
-    apply_relro(phdrs, ehdr.e_phnum, slide);
+    _munmap(img, total);
+}
+
+/*
+ * Attempt a warm-cache launch.  Returns 1 when the closure was
+ * replayed (libraries mapped and patched; exe patches applied when
+ * its base matches the record), 0 to fall back to the cold path.
+ */
+static int replay_cache_try(const char *argv0, LoadedLib *main_lib,
+                            uint64_t exe_ident, int *exe_replayed)
+{
+    char path[160];
+    long cache_fds[MAX_LIBS];
 
-    /* Call constructors */
-    call_init_functions(lib);
+    *exe_replayed = 0;
+    replay_cache_path(argv0, path, sizeof(path));
+
+    long fd = _open(path, O_RDONLY);
+    if (fd < 0)
+        return 0;
+
+    uint64_t cache_size = (uint64_t)_lseek(fd, 0, SEEK_END);
+    if (cache_size < sizeof(ReplayHeader)) {
+        _close(fd);
+        return 0;
+    }
 
+    uint8_t *img = (uint8_t *)_mmap(NULL, cache_size,
+                                    PROT_READ | PROT_WRITE,
+                                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if ((long)img < 0 && (long)img > -4096) {
+        _close(fd);
+        return 0;
+    }
+    long rd = _pread(fd, img, cache_size, 0);
     _close(fd);
-    _munmap(phdrs, phdr_size);
 
-    dl_debug_str("  loaded: ", name);
-    dl_debug_addr("  base=", slide);
+    ReplayHeader *hdr = (ReplayHeader *)img;
 
-    return lib;
+    if (rd != (long)cache_size ||
+        _memcmp(hdr->magic, REPLAY_MAGIC, 8) != 0 ||
+        hdr->version != REPLAY_VERSION ||
+        hdr->nlibs >= MAX_LIBS) {
+        _munmap(img, cache_size);
+        return 0;
+    }
+
+    /* Pass 1: validate every library's identity before touching the
+     * address space, collecting open fds */
+    uint8_t *p = img + sizeof(ReplayHeader);
+
+    for (uint32_t i = 0; i < hdr->nlibs; i++) {
+        ReplayLib *rl = (ReplayLib *)p;
+
+        if ((uint64_t)(p + sizeof(ReplayLib) - img) > cache_size)
+            goto invalid_close_none;
+
+        long lfd = search_library(rl->name);
+
+        if (lfd < 0 ||
+            (uint64_t)_lseek(lfd, 0, SEEK_END) != rl->file_size ||
+            file_identity(lfd) != rl->file_ident) {
+            if (lfd >= 0) _close(lfd);
+            for (uint32_t j = 0; j < i; j++) _close(cache_fds[j]);
+            _munmap(img, cache_size);
+            return 0;
+        }
+        cache_fds[i] = lfd;
+        p += sizeof(ReplayLib) +
+             (uint64_t)rl->nrelocs * sizeof(ReplayPatch);
+    }
+
+    if ((uint64_t)(p + (uint64_t)hdr->exe_nrelocs * sizeof(ReplayPatch)
+                   - img) > cache_size)
+        goto invalid_close_all;
+
+    /* Pass 2: map each library at its recorded base and patch */
+    p = img + sizeof(ReplayHeader);
+    for (uint32_t i = 0; i < hdr->nlibs; i++) {
+        ReplayLib *rl = (ReplayLib *)p;
+        long lfd = cache_fds[i];
+
+        Elf64_Ehdr ehdr;
+        _pread(lfd, &ehdr, sizeof(ehdr), 0);
+
+        size_t phdr_size = ehdr.e_phnum * ehdr.e_phentsize;
+        Elf64_Phdr *phdrs = (Elf64_Phdr *)_mmap(NULL, phdr_size,
+            PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        _pread(lfd, phdrs, phdr_size, ehdr.e_phoff);
+
+        uint64_t slide = map_elf_segments_at(lfd, phdrs, ehdr.e_phnum,
+                                             ehdr.e_type == ET_DYN,
+                                             rl->base);
+
+        Elf64_Dyn *dynamic = NULL;
+        for (uint16_t ph = 0; ph < ehdr.e_phnum; ph++) {
+            if (phdrs[ph].p_type == PT_DYNAMIC) {
+                dynamic = (Elf64_Dyn *)(slide + phdrs[ph].p_vaddr);
+                break;
+            }
+        }
+
+        LoadedLib *lib = register_lib(rl->name, slide, dynamic);
+        lib->file_size  = rl->file_size;
+        lib->file_ident = rl->file_ident;
+        parse_dynamic_into_lib(lib);
+        scan_tls_phdr(lib, phdrs, ehdr.e_phnum, slide);
+        setup_plt_lazy(lib);
+
+        /* Patch recorded relocation values -- no symbol resolution */
+        const ReplayPatch *patch =
+            (const ReplayPatch *)(p + sizeof(ReplayLib));
+        for (uint32_t r = 0; r < rl->nrelocs; r++)
+            *(uint64_t *)(slide + patch[r].offset) = patch[r].value;
+
+        apply_relro(phdrs, ehdr.e_phnum, slide);
+        call_init_functions(lib);
+
+        _munmap(phdrs, phdr_size);
+        _close(lfd);
+
+        p += sizeof(ReplayLib) +
+             (uint64_t)rl->nrelocs * sizeof(ReplayPatch);
+    }
+
+    /* The kernel maps the exe; its patches only replay when the base
+     * landed where it was recorded AND the binary is unchanged */
+    if (main_lib->base == hdr->exe_base && exe_ident == hdr->exe_ident &&
+        hdr->exe_nrelocs > 0) {
+        const ReplayPatch *patch = (const ReplayPatch *)p;
+
+        for (uint32_t r = 0; r < hdr->exe_nrelocs; r++)
+            *(uint64_t *)(main_lib->base + patch[r].offset) =
+                patch[r].value;
+        *exe_replayed = 1;
+    }
+
+    _munmap(img, cache_size);
+    dl_debug_str("replayed closure from: ", path);
+    return 1;
+
+invalid_close_all:
+    for (uint32_t j = 0; j < hdr->nlibs; j++) _close(cache_fds[j]);
+invalid_close_none:
+    _munmap(img, cache_size);
+    return 0;
 }
 
 /*
- * Load all DT_NEEDED libraries from an already-parsed dynamic section.
+ * Load all DT_NEEDED libraries from an already-parsed dynamic section
+ * (the main executable's closure), with the same phased pipeline.
  */
 static void load_needed_libs(Elf64_Dyn *dyn, uint64_t base)
 {
@@ -1590,11 +2570,15 @@ static void load_needed_libs(Elf64_Dyn *dyn, uint64_t base)
     }
     if (!strtab) return;
 
-    for (Elf64_Dyn *d = dyn; d->d_tag != DT_NULL; d++) {
-        if (d->d_tag == DT_NEEDED) {
-            const char *name = strtab + d->d_un.d_val;
-            load_library(name);
-        }
+    int first = lib_count;
+
+    map_needed_of(dyn, strtab);
+    for (int i = first; i < lib_count; i++)
+        map_needed_of(loaded_libs[i].dynamic, loaded_libs[i].strtab);
+
+    if (lib_count > first) {
+        symbolic_profiles_load();
+        bind_libraries(first, lib_count);
     }
 }
 
@@ -1648,6 +2632,9 @@ int dlclose(void *handle)
     call_fini_functions(lib);
 
     lib->loaded = 0;
+
+    /* Cached resolutions may point into the departing library */
+    sym_cache_flush();
     return 0;
 }
 
@@ -1666,6 +2653,249 @@ char *dlerror(void)
  * Stack layout at entry (System V ABI):
  *   [argc] [argv[0]...argv[argc-1]] [NULL] [envp...] [NULL] [auxv...]
  */
+/* ========================================================================= */
+/* Checkpoint restore                                                        */
+/* ========================================================================= */
+
+/*
+ * A VCKP snapshot (written by libc's veridian_checkpoint()) replaces
+ * ELF loading entirely: every recorded segment is mapped back at its
+ * original address and control jumps through the saved callee-saved
+ * context, making the original checkpoint call return 1 inside the
+ * resumed image.
+ *
+ * Re-mapping the segments overwrites this linker's own text, stack,
+ * everything -- so the actual work runs from a relocated blob: a
+ * position-independent function copied into a scratch region placed
+ * above every recorded segment, entered on a scratch stack.  The
+ * blob uses only inline-asm syscalls and its argument block; it
+ * touches nothing else.  (Layouts match veridian/checkpoint.h; this
+ * file keeps local copies of the structs as it does for ELF.)
+ */
+
+#define CKPT_MAGIC        0x504b4356u   /* "VCKP" */
+#define CKPT_MAX_SEGMENTS 512
+#define ARCH_SET_FS_CODE  0x1002
+
+typedef struct {
+    uint64_t rip, rsp, rbx, rbp, r12, r13, r14, r15, fsbase;
+} CkptCpu;
+
+typedef struct {
+    uint64_t vaddr;
+    uint64_t length;
+    uint64_t file_off;
+    uint32_t prot;
+    uint32_t _pad;
+} CkptSegment;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t segment_count;
+    uint32_t _pad;
+    CkptCpu cpu;
+    CkptSegment segments[CKPT_MAX_SEGMENTS];
+} CkptHeader;
+
+/* Argument block handed to the relocated blob */
+typedef struct {
+    long        fd;
+    uint64_t    segment_count;
+    CkptSegment segments[CKPT_MAX_SEGMENTS];
+    CkptCpu     cpu;
+} CkptBlobArgs;
+
+#if defined(__x86_64__)
+
+/* Raw syscall for blob use: no references outside the function */
+static inline long _ckpt_raw_syscall(long n, long a1, long a2, long a3,
+                                     long a4, long a5, long a6)
+{
+    register long r10 __asm__("r10") = a4;
+    register long r8 __asm__("r8") = a5;
+    register long r9 __asm__("r9") = a6;
+    long ret;
+
+    __asm__ volatile ("syscall"
+                      : "=a"(ret)
+                      : "a"(n), "D"(a1), "S"(a2), "d"(a3), "r"(r10),
+                        "r"(r8), "r"(r9)
+                      : "rcx", "r11", "memory");
+    return ret;
+}
+
+/*
+ * The relocated restorer.  Position independence contract: no
+ * global data, no calls, no jump tables -- only the args block and
+ * inline syscalls.  Compiled into this TU and copied byte-wise into
+ * the scratch region.
+ */
+__attribute__((noinline, used))
+static void _ckpt_restore_blob(CkptBlobArgs *a)
+{
+    for (uint64_t i = 0; i < a->segment_count; i++) {
+        CkptSegment *seg = &a->segments[i];
+
+        _ckpt_raw_syscall(SYS_MEMORY_MAP, (long)seg->vaddr,
+                          (long)seg->length, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED,
+                          -1, 0);
+        _ckpt_raw_syscall(SYS_FILE_SEEK, a->fd, (long)seg->file_off,
+                          0 /* SEEK_SET */, 0, 0, 0);
+
+        uint64_t done = 0;
+
+        while (done < seg->length) {
+            long rd = _ckpt_raw_syscall(SYS_FILE_READ, a->fd,
+                                        (long)(seg->vaddr + done),
+                                        (long)(seg->length - done),
+                                        0, 0, 0);
+
+            if (rd <= 0)
+                _ckpt_raw_syscall(SYS_PROCESS_EXIT, 126, 0, 0, 0, 0, 0);
+            done += (uint64_t)rd;
+        }
+        _ckpt_raw_syscall(SYS_MEMORY_PROTECT, (long)seg->vaddr,
+                          (long)seg->length, (long)seg->prot, 0, 0, 0);
+    }
+
+    _ckpt_raw_syscall(SYS_FILE_CLOSE, a->fd, 0, 0, 0, 0, 0);
+    _ckpt_raw_syscall(SYS_ARCH_PRCTL, ARCH_SET_FS_CODE,
+                      (long)a->cpu.fsbase, 0, 0, 0, 0);
+
+    /* Reload the saved register file and resume: rax = 1 makes the
+     * checkpoint call in the restored image return "resumed".  The
+     * base pointer lives in rax, the only register this sequence is
+     * allowed to clobber before the final jump. */
+    __asm__ volatile (
+        "movq 8(%%rax), %%rsp\n\t"
+        "movq 16(%%rax), %%rbx\n\t"
+        "movq 24(%%rax), %%rbp\n\t"
+        "movq 32(%%rax), %%r12\n\t"
+        "movq 40(%%rax), %%r13\n\t"
+        "movq 48(%%rax), %%r14\n\t"
+        "movq 56(%%rax), %%r15\n\t"
+        "movq 0(%%rax), %%rcx\n\t"
+        "movl $1, %%eax\n\t"
+        "jmp *%%rcx"
+        :
+        : "a"(&a->cpu)
+        : "memory");
+    __builtin_unreachable();
+}
+
+/* The blob is a few hundred bytes; copying a fixed 4 KiB from its
+ * entry covers it with margin (function ordering in .text is not
+ * guaranteed, so an end-marker symbol cannot be trusted) */
+#define CKPT_BLOB_COPY_SIZE 4096
+
+/*
+ * Restore path: runs with the linker still intact.  Reads the
+ * header, stages the blob + args + stack in a scratch region above
+ * every segment, pivots, and never returns.
+ */
+static void _ckpt_restore(const char *path) __attribute__((noreturn));
+static void _ckpt_restore(const char *path)
+{
+    static CkptHeader hdr;      /* Too big for the stack */
+    long fd = _open(path, 0 /* O_RDONLY */);
+
+    if (fd < 0) {
+        _write_str("ld-veridian: cannot open checkpoint\n");
+        _exit(127);
+    }
+    if (_read(fd, &hdr, sizeof(hdr)) != (long)sizeof(hdr) ||
+        hdr.magic != CKPT_MAGIC ||
+        hdr.segment_count > CKPT_MAX_SEGMENTS) {
+        _write_str("ld-veridian: bad checkpoint image\n");
+        _exit(127);
+    }
+
+    /* Scratch anywhere no segment will land: start mid-range and
+     * step past collisions (the stack sits near the address-space
+     * ceiling, so "above everything" may not exist) */
+    uint64_t candidate = 0x100000000000ULL;     /* 16 TiB mark */
+    int collided = 1;
+
+    while (collided) {
+        collided = 0;
+        for (uint32_t i = 0; i < hdr.segment_count; i++) {
+            uint64_t s0 = hdr.segments[i].vaddr;
+            uint64_t s1 = s0 + hdr.segments[i].length;
+
+            if (candidate < s1 && candidate + 0x100000ULL > s0) {
+                candidate = (s1 + 0xFFF) & ~0xFFFULL;
+                collided = 1;
+            }
+        }
+    }
+
+    size_t blob_size = CKPT_BLOB_COPY_SIZE;
+    size_t scratch_size = (sizeof(CkptBlobArgs) + blob_size +
+                           0x20000 + 0xFFF) & ~(size_t)0xFFF;
+
+    char *scratch = _mmap((void *)candidate, scratch_size,
+                          PROT_READ | PROT_WRITE | PROT_EXEC,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED,
+                          -1, 0);
+    if ((long)scratch < 0) {
+        _write_str("ld-veridian: cannot map restore scratch\n");
+        _exit(127);
+    }
+
+    CkptBlobArgs *args = (CkptBlobArgs *)scratch;
+
+    args->fd = fd;
+    args->segment_count = hdr.segment_count;
+    for (uint32_t i = 0; i < hdr.segment_count; i++)
+        args->segments[i] = hdr.segments[i];
+    args->cpu = hdr.cpu;
+
+    char *blob = scratch + sizeof(CkptBlobArgs);
+
+    for (size_t i = 0; i < blob_size; i++)
+        blob[i] = ((const char *)_ckpt_restore_blob)[i];
+
+    /* Scratch stack at the top of the region, 16-aligned */
+    uint64_t stack_top =
+        ((uint64_t)(scratch + scratch_size) - 64) & ~0xFULL;
+
+    __asm__ volatile (
+        "movq %0, %%rsp\n\t"
+        "jmp *%1"
+        :
+        : "r"(stack_top), "r"(blob), "D"(args)
+        : "memory");
+    __builtin_unreachable();
+}
+
+#else /* !__x86_64__ */
+
+static void _ckpt_restore(const char *path) __attribute__((noreturn));
+static void _ckpt_restore(const char *path)
+{
+    (void)path;
+    _write_str("ld-veridian: checkpoint restore is x86_64 only\n");
+    _exit(127);
+}
+
+#endif /* __x86_64__ */
+
+/* Is the file a checkpoint image? (4-byte magic probe) */
+static int _ckpt_probe(const char *path)
+{
+    long fd = _open(path, 0);
+    uint32_t magic = 0;
+    long rd;
+
+    if (fd < 0)
+        return 0;
+    rd = _read(fd, &magic, sizeof(magic));
+    _close(fd);
+    return rd == (long)sizeof(magic) && magic == CKPT_MAGIC;
+}
+
 void _linker_main(long *sp)
 {
     long argc = sp[0];
@@ -1682,6 +2912,10 @@ void _linker_main(long *sp)
 
     dl_debug("ld-veridian starting");
 
+    /* Checkpoint image instead of an ELF?  Restore and resume. */
+    if (argc >= 2 && _ckpt_probe(argv[1]))
+        _ckpt_restore(argv[1]);
+
     /* Extract auxiliary vector values */
     Elf64_Phdr *at_phdr = NULL;
     uint64_t at_phent   = 0;
@@ -1762,8 +2996,19 @@ void _linker_main(long *sp)
         }
     }
 
-    /* Load DT_NEEDED dependencies */
-    load_needed_libs(exe_dynamic, exe_base);
+    /* Warm-cache path: replay the recorded closure, else cold-load
+     * the DT_NEEDED dependencies (LD_PRELOAD changes the closure, so
+     * it disables replay) */
+    int closure_replayed = 0;
+    int exe_replayed = 0;
+    uint64_t exe_ident = mem_identity(at_phdr,
+                                      at_phnum * sizeof(Elf64_Phdr));
+
+    if (ld_preload_count == 0)
+        closure_replayed = replay_cache_try(argv[0], main_lib, exe_ident,
+                                            &exe_replayed);
+    if (!closure_replayed)
+        load_needed_libs(exe_dynamic, exe_base);
 
     /* Parse dynamic for main executable relocations (legacy path) */
     Elf64_Sym   *symtab  = main_lib->symtab;
@@ -1790,8 +3035,9 @@ void _linker_main(long *sp)
     /* Set up PLT for main executable */
     setup_plt_lazy(main_lib);
 
-    /* Process relocations for main executable */
-    if (symtab && strtab) {
+    /* Process relocations for main executable (skipped when the
+     * replay cache already patched them at the recorded base) */
+    if (symtab && strtab && !exe_replayed) {
         if (rela && relasz) {
             process_rela(main_lib, rela, relasz, symtab, strtab, 0);
         }
@@ -1822,6 +3068,13 @@ void _linker_main(long *sp)
     }
     call_init_functions(main_lib);
 
+    /* Record the closure for the next launch of this executable */
+    if (!closure_replayed && ld_preload_count == 0)
+        replay_cache_save(argv[0], main_lib, exe_ident);
+
+    /* Persist the no-interposition whitelist this run discovered */
+    symbolic_profiles_save();
+
     dl_debug("transferring control to application");
     dl_debug_addr("entry=", at_entry);
 
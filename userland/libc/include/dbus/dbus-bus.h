@@ -63,6 +63,15 @@ DBUS_EXPORT void            dbus_bus_remove_match(DBusConnection *connection,
                                                   const char *rule,
                                                   DBusError *error);
 
+/**
+ * VeridianOS extension: evaluate the connection's compiled match
+ * rules against a message (Bloom-filter front end, per-interface
+ * discrimination chains).  Used by the event pump to reject
+ * non-matching broadcasts in O(1).
+ */
+DBUS_EXPORT dbus_bool_t dbus_veridian_signal_matches(DBusConnection *connection,
+                                                     DBusMessage   *message);
+
 DBUS_END_DECLS
 
 #endif /* _DBUS_DBUS_BUS_H */
@@ -59,6 +59,36 @@ int closedir(DIR *dirp);
 /** Reset a directory stream to the beginning. */
 void rewinddir(DIR *dirp);
 
+/* ========================================================================= */
+/* VeridianOS extensions                                                     */
+/* ========================================================================= */
+
+#include <sys/stat.h>
+
+/*
+ * Packed record produced by SYS_DIR_READDIR_BATCH.  Records are
+ * laid out back to back in the stream buffer; reclen covers the
+ * header, the name, and its NUL.
+ */
+struct veridian_dirent_rec {
+    unsigned short reclen;
+    unsigned char  d_type;
+    unsigned char  has_stat;    /* st below is valid */
+    unsigned int   _pad;
+    ino_t          d_ino;
+    struct stat    st;
+    char           d_name[];    /* NUL-terminated */
+};
+
+/**
+ * readdirplus: like readdir(), but when the kernel piggybacked stat
+ * attributes on the entry they are copied to *st and *has_stat is
+ * set.  With *has_stat == 0 the caller stats the path itself (older
+ * kernels, or filesystems that don't provide attributes inline).
+ */
+struct dirent *veridian_readdir_plus(DIR *dirp, struct stat *st,
+                                     int *has_stat);
+
 /** Return the file descriptor associated with a directory stream. */
 int dirfd(DIR *dirp);
 
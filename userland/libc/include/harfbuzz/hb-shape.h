@@ -76,6 +76,15 @@ hb_bool_t        hb_shape_plan_execute(hb_shape_plan_t *shape_plan,
                                           unsigned int num_features);
 const char      *hb_shape_plan_get_shaper(hb_shape_plan_t *shape_plan);
 
+/* VeridianOS extension: shape an array of runs in one call.  The
+ * shaping plan is resolved once per distinct (script, direction)
+ * rather than per run.  Returns the number of runs shaped. */
+unsigned int     hb_veridian_shape_batch(hb_font_t *font,
+                                            hb_buffer_t * const *buffers,
+                                            unsigned int count,
+                                            const hb_feature_t *features,
+                                            unsigned int num_features);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,91 @@
+/*
+ * VeridianOS libc -- <libxml/xmlreader.h>
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * xmlTextReader pull-parser API (libxml2 compatible subset).
+ *
+ * The reader walks the document as a stream of node events without
+ * building a DOM: untouched subtrees cost nothing beyond the scan.
+ * This is the right surface for config loaders that pick a few
+ * elements out of hundreds of small files.
+ */
+
+#ifndef __XML_XMLREADER_H__
+#define __XML_XMLREADER_H__
+
+#include <libxml/xmlstring.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Node types reported by xmlTextReaderNodeType (libxml2 values) */
+typedef enum {
+    XML_READER_TYPE_NONE                   = 0,
+    XML_READER_TYPE_ELEMENT                = 1,
+    XML_READER_TYPE_ATTRIBUTE              = 2,
+    XML_READER_TYPE_TEXT                   = 3,
+    XML_READER_TYPE_CDATA                  = 4,
+    XML_READER_TYPE_PROCESSING_INSTRUCTION = 7,
+    XML_READER_TYPE_COMMENT                = 8,
+    XML_READER_TYPE_SIGNIFICANT_WHITESPACE = 14,
+    XML_READER_TYPE_END_ELEMENT            = 15
+} xmlReaderTypes;
+
+typedef struct _xmlTextReader xmlTextReader;
+typedef xmlTextReader *xmlTextReaderPtr;
+
+/** Create a reader over an in-memory document (buffer is copied). */
+xmlTextReaderPtr xmlReaderForMemory(const char *buffer, int size,
+                                    const char *url, const char *encoding,
+                                    int options);
+
+/** Create a reader over a file. */
+xmlTextReaderPtr xmlReaderForFile(const char *filename,
+                                  const char *encoding, int options);
+
+/** Advance to the next node event: 1 = node, 0 = end, -1 = error. */
+int xmlTextReaderRead(xmlTextReaderPtr reader);
+
+/** Type of the current node (xmlReaderTypes). */
+int xmlTextReaderNodeType(xmlTextReaderPtr reader);
+
+/**
+ * Name of the current element/PI.  Interned: the same name always
+ * returns the same pointer for the reader's lifetime, so dispatch
+ * loops can compare pointers instead of strings.
+ */
+const xmlChar *xmlTextReaderConstName(xmlTextReaderPtr reader);
+
+/** Text/CDATA/comment content, entities decoded.  Reader-owned. */
+const xmlChar *xmlTextReaderConstValue(xmlTextReaderPtr reader);
+
+/** Element nesting depth of the current node. */
+int xmlTextReaderDepth(xmlTextReaderPtr reader);
+
+/** Whether the current element is <empty/> (no end event follows). */
+int xmlTextReaderIsEmptyElement(xmlTextReaderPtr reader);
+
+/** Number of attributes on the current element. */
+int xmlTextReaderAttributeCount(xmlTextReaderPtr reader);
+
+/**
+ * Attribute value by name, entities decoded.  Caller frees with
+ * xmlFree().  NULL when absent.
+ */
+xmlChar *xmlTextReaderGetAttribute(xmlTextReaderPtr reader,
+                                   const xmlChar *name);
+
+/** Skip the current element's entire subtree: 1 ok, -1 error. */
+int xmlTextReaderNext(xmlTextReaderPtr reader);
+
+/** Destroy the reader. */
+void xmlFreeTextReader(xmlTextReaderPtr reader);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __XML_XMLREADER_H__ */
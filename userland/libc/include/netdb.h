@@ -118,6 +118,62 @@ int getnameinfo(const struct sockaddr *sa, socklen_t salen,
                 char *host, socklen_t hostlen,
                 char *serv, socklen_t servlen, int flags);
 
+/* ========================================================================= */
+/* Asynchronous resolution (getaddrinfo_a style)                             */
+/* ========================================================================= */
+
+#define EAI_INPROGRESS  -100    /* Request still being processed */
+#define EAI_CANCELED    -101    /* Request canceled before it ran */
+#define EAI_ALLDONE     -103    /* gai_cancel: already completed */
+
+#define GAI_WAIT        0       /* getaddrinfo_a blocks until done */
+#define GAI_NOWAIT      1       /* Queue and return immediately */
+
+/** One asynchronous resolution request. */
+struct gaicb {
+    const char            *ar_name;
+    const char            *ar_service;
+    const struct addrinfo *ar_request;
+    struct addrinfo       *ar_result;
+    /* Private */
+    int                    __err;
+    int                    __state;
+    struct gaicb          *__next;
+};
+
+/*
+ * Queue nitems requests on the resolver worker pool.  The calling
+ * thread never blocks on the DNS round-trip with GAI_NOWAIT.
+ * Completion is signaled through notify_cb (run on the worker
+ * thread; may be NULL) and, when a notify fd has been registered,
+ * one byte written per completed request -- libc has no struct
+ * sigevent, so these two channels stand in for SIGEV_THREAD and
+ * the fd-based delivery Qt event loops want.
+ */
+int getaddrinfo_a(int mode, struct gaicb *list[], int nitems,
+                  void (*notify_cb)(struct gaicb *req, void *arg),
+                  void *cb_arg);
+
+/**
+ * Register a process-wide completion fd (e.g. a pipe write end):
+ * every finished request writes one byte.  Pass -1 to unregister.
+ * Returns the previous fd.
+ */
+int veridian_gai_notify_fd(int fd);
+
+/** EAI_INPROGRESS, 0, or the request's final error code. */
+int gai_error(struct gaicb *req);
+
+/** Cancel a queued request; running/completed ones are not touched. */
+int gai_cancel(struct gaicb *req);
+
+/**
+ * Wait until at least one request in list completes.  Returns 0, or
+ * EAI_AGAIN on timeout.
+ */
+int gai_suspend(const struct gaicb *const list[], int nitems,
+                const struct timespec *timeout);
+
 #ifdef __cplusplus
 }
 #endif
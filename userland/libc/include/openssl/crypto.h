@@ -44,6 +44,47 @@ void OPENSSL_cleanse(void *ptr, size_t len);
 /** Get the number of available CPUs. */
 int OPENSSL_get_cpu_count(void);
 
+/* ----- VeridianOS multi-buffer hashing extension ----- */
+
+/**
+ * Multi-buffer SHA-256: hash up to 8 independent streams with the
+ * lane states interleaved in SIMD registers.  Each lane's digest is
+ * identical to EVP_Digest(..., EVP_sha256(), ...).
+ */
+typedef struct sha256_mb_ctx SHA256_MB_CTX;
+
+/** Allocate / free a multi-buffer context. */
+SHA256_MB_CTX *SHA256_MB_CTX_new(void);
+void SHA256_MB_CTX_free(SHA256_MB_CTX *ctx);
+
+/** Initialize nlanes (1..8) lanes. */
+int SHA256_mb_init(SHA256_MB_CTX *ctx, int nlanes);
+
+/** Feed data into one lane (incremental; lanes advance independently
+ *  on the scalar path). */
+int SHA256_mb_update(SHA256_MB_CTX *ctx, int lane, const void *data,
+                     size_t len);
+
+/** Finalize one lane. */
+int SHA256_mb_final(SHA256_MB_CTX *ctx, int lane, unsigned char *digest);
+
+/**
+ * One-shot batch hash of count buffers: full blocks advance in
+ * lockstep through the interleaved transform (AVX2), tails finish on
+ * the scalar path.  This is the entry point for parallel package
+ * verification.
+ */
+int SHA256_mb_hash(const unsigned char *const *bufs, const size_t *lens,
+                   unsigned char **digests, int count);
+
+/**
+ * VeridianOS extension: openssl speed-style self benchmark.  Measures
+ * SHA-256 and AES-128-CBC throughput with the runtime-selected
+ * implementation and writes a short report into out.  Returns the
+ * number of characters written.
+ */
+int OPENSSL_speed_veridian(char *out, size_t out_len);
+
 #ifdef __cplusplus
 }
 #endif
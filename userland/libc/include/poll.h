@@ -31,6 +31,11 @@ struct pollfd {
 /** Wait for events on file descriptors. */
 int poll(struct pollfd *fds, nfds_t nfds, int timeout);
 
+/** poll with nanosecond timeout resolution. */
+struct timespec;
+int ppoll(struct pollfd *fds, nfds_t nfds,
+          const struct timespec *timeout, const void *sigmask);
+
 #ifdef __cplusplus
 }
 #endif
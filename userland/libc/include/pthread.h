@@ -25,7 +25,7 @@ typedef struct {
 } pthread_attr_t;
 
 typedef struct {
-    int state; /* 0 unlocked, 1 locked */
+    int state; /* 0 unlocked, 1 locked, 2 locked with waiters */
 } pthread_mutex_t;
 
 typedef struct {
@@ -34,6 +34,7 @@ typedef struct {
 
 typedef struct {
     int futex;
+    void *bound_mutex; /* mutex of the current waiters (for requeue) */
 } pthread_cond_t;
 
 typedef struct {
@@ -142,7 +143,25 @@ int pthread_cond_signal(pthread_cond_t *cond);
 int pthread_cond_broadcast(pthread_cond_t *cond);
 
 int pthread_once(pthread_once_t *once_control, void (*init_routine)(void));
-int pthread_setcancelstate(int state, int *oldstate); /* stub: no cancellation */
+#define PTHREAD_CANCEL_ENABLE       0
+#define PTHREAD_CANCEL_DISABLE      1
+#define PTHREAD_CANCEL_DEFERRED     0
+#define PTHREAD_CANCEL_ASYNCHRONOUS 1
+#define PTHREAD_CANCELED            ((void *)-1)
+
+int pthread_setcancelstate(int state, int *oldstate);
+int pthread_setcanceltype(int type, int *oldtype);
+
+/*
+ * Request cancellation.  The target exits with PTHREAD_CANCELED at
+ * its next cancellation point; blocking libc calls are kicked with
+ * a kernel thread interrupt so the latency is bounded by the check,
+ * not by the I/O.
+ */
+int pthread_cancel(pthread_t thread);
+
+/** Explicit cancellation point. */
+void pthread_testcancel(void); /* stub: no cancellation */
 int pthread_yield(void);
 
 /* Read-write locks */
@@ -11,6 +11,8 @@
 #ifndef _SYS_EPOLL_H
 #define _SYS_EPOLL_H
 
+#include <time.h>
+
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -95,6 +97,14 @@ int epoll_create1(int flags);
  */
 int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event);
 
+/**
+ * Wait with nanosecond timeout resolution (VeridianOS extension
+ * mirroring Linux epoll_pwait2; sigmask not yet honored).  NULL
+ * timeout blocks indefinitely.
+ */
+int epoll_pwait2(int epfd, struct epoll_event *events, int maxevents,
+                 const struct timespec *timeout, const void *sigmask);
+
 /**
  * Wait for events on an epoll instance.
  * @param epfd       epoll file descriptor.
@@ -30,6 +30,17 @@ struct rlimit {
     rlim_t rlim_max;    /* Hard limit */
 };
 
+/* ========================================================================= */
+/* Scheduling priority (kernel CFS nice levels)                              */
+/* ========================================================================= */
+
+#define PRIO_PROCESS    0   /* who = pid (0 = calling process) */
+#define PRIO_PGRP       1   /* who = process group id */
+#define PRIO_USER       2   /* who = uid */
+
+#define PRIO_MIN        (-20)
+#define PRIO_MAX        19
+
 /* ========================================================================= */
 /* Resource identifiers                                                      */
 /* ========================================================================= */
@@ -84,6 +95,16 @@ int setrlimit(int resource, const struct rlimit *rlp);
 /** Get resource usage. */
 int getrusage(int who, struct rusage *usage);
 
+/*
+ * Scheduling priority of a process, process group, or user, as a
+ * nice value in [PRIO_MIN, PRIO_MAX].  Maps onto the kernel CFS nice
+ * levels via SYS_PROCESS_GET/SETPRIORITY.  getpriority() can
+ * legitimately return a negative value: clear errno before the call
+ * to distinguish it from an error.
+ */
+int getpriority(int which, id_t who);
+int setpriority(int which, id_t who, int prio);
+
 #ifdef __cplusplus
 }
 #endif
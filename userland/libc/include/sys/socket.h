@@ -84,11 +84,14 @@ struct sockaddr_storage {
     char        __ss_padding[126];
 };
 
-/* I/O vector for scatter/gather */
+/* I/O vector for scatter/gather (canonical home: sys/uio.h) */
+#ifndef _STRUCT_IOVEC_DEFINED
+#define _STRUCT_IOVEC_DEFINED
 struct iovec {
     void   *iov_base;
     size_t  iov_len;
 };
+#endif
 
 struct msghdr {
     void         *msg_name;
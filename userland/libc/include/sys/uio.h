@@ -0,0 +1,51 @@
+/*
+ * VeridianOS libc -- sys/uio.h
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Vectored (scatter/gather) I/O.
+ */
+
+#ifndef _SYS_UIO_H
+#define _SYS_UIO_H
+
+#include <stddef.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Shared with sys/socket.h (msghdr embeds iovec) */
+#ifndef _STRUCT_IOVEC_DEFINED
+#define _STRUCT_IOVEC_DEFINED
+struct iovec {
+    void   *iov_base;
+    size_t  iov_len;
+};
+#endif
+
+#define IOV_MAX 1024
+
+/* Read into multiple buffers with one syscall. */
+ssize_t readv(int fd, const struct iovec *iov, int iovcnt);
+
+/* Write from multiple buffers with one syscall. */
+ssize_t writev(int fd, const struct iovec *iov, int iovcnt);
+
+/** Positioned scatter read: like readv at offset, file position
+ *  unchanged. */
+ssize_t preadv(int fd, const struct iovec *iov, int iovcnt,
+               off_t offset);
+
+/** Positioned gather write: like writev at offset, file position
+ *  unchanged. */
+ssize_t pwritev(int fd, const struct iovec *iov, int iovcnt,
+                off_t offset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SYS_UIO_H */
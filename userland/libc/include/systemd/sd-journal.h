@@ -0,0 +1,62 @@
+/*
+ * VeridianOS libc -- <systemd/sd-journal.h>
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * systemd journal submission API with deferred formatting.
+ *
+ * sd_journal_print()/printv() do no printf expansion on the calling
+ * thread: the format pointer and packed argument values go into a
+ * per-process lock-free ring and a background drainer formats and
+ * persists them.  KWin logs per-frame diagnostics through this path,
+ * so the submit side must never block or touch the filesystem.
+ */
+
+#ifndef _SYSTEMD_SD_JOURNAL_H
+#define _SYSTEMD_SD_JOURNAL_H
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <syslog.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Submit one message at the given syslog priority (LOG_ERR..LOG_DEBUG).
+ * The format string must outlive the call (string literals do);
+ * argument values, including string contents, are captured immediately.
+ * Returns 0, or -ENOMEM when the ring is full and the record dropped.
+ */
+int sd_journal_print(int priority, const char *format, ...)
+    __attribute__((format(printf, 2, 3)));
+int sd_journal_printv(int priority, const char *format, va_list ap);
+
+/*
+ * Submit one entry as NULL-terminated "FIELD=format" pairs, each
+ * consuming its own arguments (sd_journal_send("MESSAGE=%s", m,
+ * "PRIORITY=%i", 4, NULL)).  Fields are joined into a single record.
+ */
+int sd_journal_send(const char *format, ...)
+    __attribute__((sentinel));
+
+/* Block until every queued record has been formatted and written. */
+void sd_journal_veridian_flush(void);
+
+/* Records enqueued / dropped because the ring was full. */
+void sd_journal_veridian_stats(uint64_t *enqueued, uint64_t *dropped);
+
+/*
+ * Records suppressed by per-source rate limiting / collapsed by the
+ * drainer's identical-message dedup window.
+ */
+void sd_journal_veridian_limit_stats(uint64_t *suppressed,
+                                     uint64_t *collapsed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SYSTEMD_SD_JOURNAL_H */
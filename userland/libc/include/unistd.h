@@ -56,6 +56,45 @@ ssize_t read(int fd, void *buf, size_t count);
 /** Write up to count bytes from buf to fd. */
 ssize_t write(int fd, const void *buf, size_t count);
 
+/**
+ * Move up to len bytes between two descriptors inside the kernel,
+ * transferring pages by reference when at least one side is a pipe
+ * (VeridianOS extension mirroring Linux splice()).  NULL offsets use
+ * and advance the file positions.  Returns bytes moved, 0 at EOF, or
+ * -1 with errno set (ENOSYS on kernels without the syscall; EINVAL
+ * when neither fd supports the zero-copy path -- callers fall back
+ * to read/write).
+ */
+ssize_t splice(int fd_in, off_t *off_in, int fd_out, off_t *off_out,
+               size_t len, unsigned int flags);
+
+/**
+ * Read many small files (e.g. sysfs attributes) in one kernel
+ * round-trip (VeridianOS extension).  Each request reads from offset
+ * 0.  Returns the number of requests processed, or -1 with errno set
+ * (ENOSYS on kernels without the syscall -- callers fall back to
+ * per-fd pread).
+ */
+int veridian_read_batch(struct veridian_read_req *reqs, unsigned int count);
+
+/* Arguments for veridian_spawn() / SYS_PROCESS_SPAWN */
+struct veridian_spawn_args {
+    const char         *path;       /* Absolute executable path */
+    char *const        *argv;       /* NULL-terminated */
+    char *const        *envp;       /* NULL-terminated */
+    unsigned int        flags;      /* Reserved, pass 0 */
+};
+
+/**
+ * Create a process directly from an executable (VeridianOS
+ * extension): the kernel builds the child address space from the
+ * ELF image without duplicating the parent's mappings, so spawn
+ * cost is independent of the parent's size.  Returns the child pid,
+ * or -1 with errno set (ENOSYS on kernels without the syscall --
+ * posix_spawn falls back to fork+execve).
+ */
+pid_t veridian_spawn(const struct veridian_spawn_args *args);
+
 /** Reposition read/write offset of fd. */
 off_t lseek(int fd, off_t offset, int whence);
 
@@ -150,6 +189,9 @@ pid_t getpid(void);
 /** Return the parent process ID. */
 pid_t getppid(void);
 
+/* Raise the calling process's nice value; returns the new value. */
+int nice(int inc);
+
 /** Return the thread ID of the calling thread. */
 pid_t gettid(void);
 
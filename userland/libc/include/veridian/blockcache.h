@@ -0,0 +1,62 @@
+/*
+ * VeridianOS libc -- veridian/blockcache.h
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * BlockFS client cache control.
+ *
+ * The VFS service keeps a per-page LRU over BlockFS with background
+ * write-back; this API is userland's window into it: hit/miss/
+ * eviction counters for production visibility, cache sizing, per-fd
+ * readahead for streaming consumers (KIO transfers, vpkg archive
+ * extraction), and an explicit flush.  Kernels without the cache
+ * syscall answer ENOSYS; every call here degrades to a no-op with
+ * zeroed stats so callers need no feature probing.
+ */
+
+#ifndef _VERIDIAN_BLOCKCACHE_H
+#define _VERIDIAN_BLOCKCACHE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Counters and sizing as the VFS cache reports them. */
+struct vbc_stats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t writebacks;        /* Pages cleaned in the background */
+    uint64_t dirty_pages;
+    uint32_t size_pages;        /* Currently cached */
+    uint32_t capacity_pages;
+};
+
+/**
+ * Read the cache counters.  Returns 0; on ENOSYS kernels the stats
+ * are zeroed and 0 is still returned (a cacheless kernel has a
+ * perfectly accurate all-zero hit count).
+ */
+int vbc_get_stats(struct vbc_stats *out);
+
+/** Resize the cache.  Returns 0 or -1 with errno set. */
+int vbc_set_capacity(uint32_t pages);
+
+/**
+ * Set the readahead window for one fd, in pages (0 restores the
+ * default heuristic).  Streaming readers widen this; random-access
+ * consumers set 0 to stop polluting the LRU.
+ */
+int vbc_set_readahead(int fd, uint32_t pages);
+
+/** Kick background write-back now; returns without waiting. */
+int vbc_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _VERIDIAN_BLOCKCACHE_H */
@@ -0,0 +1,82 @@
+/*
+ * VeridianOS libc -- veridian/checkpoint.h
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Process checkpoint: the Emacs-dumper trick for heavyweight apps.
+ *
+ * An application that has finished its deterministic startup calls
+ * veridian_checkpoint() at an idle point; the call dumps the whole
+ * address space (plus the callee-saved CPU context of the call
+ * site) into a snapshot file.  Launching that file through
+ * ld-veridian maps the segments back and resumes execution at the
+ * checkpoint call, which then returns 1 -- cold starts that burn
+ * seconds re-running constructors become a file-backed map and a
+ * jump.
+ *
+ *     if (veridian_checkpoint("/var/cache/veridian/app.ckpt") == 1) {
+ *         reopen_fds_and_reconnect();      // resumed from snapshot
+ *     }
+ *
+ * Only memory travels: file descriptors, sockets, and threads other
+ * than the caller do not survive and must be re-established on the
+ * resume path.  Checkpoint before spawning worker threads.
+ */
+
+#ifndef _VERIDIAN_CHECKPOINT_H
+#define _VERIDIAN_CHECKPOINT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VCKP_MAGIC   0x504b4356u    /* "VCKP" */
+#define VCKP_VERSION 1u
+#define VCKP_MAX_SEGMENTS 512
+
+/* Callee-saved context of the checkpoint call site (x86_64) */
+struct vckp_cpu {
+    uint64_t rip;
+    uint64_t rsp;
+    uint64_t rbx;
+    uint64_t rbp;
+    uint64_t r12;
+    uint64_t r13;
+    uint64_t r14;
+    uint64_t r15;
+    uint64_t fsbase;
+};
+
+struct vckp_segment {
+    uint64_t vaddr;
+    uint64_t length;            /* Page-rounded */
+    uint64_t file_off;          /* Data location in the snapshot */
+    uint32_t prot;              /* PROT_* to apply after loading */
+    uint32_t _pad;
+};
+
+struct vckp_header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t segment_count;
+    uint32_t _pad;
+    struct vckp_cpu cpu;
+    struct vckp_segment segments[VCKP_MAX_SEGMENTS];
+};
+
+/**
+ * Snapshot the calling process to path.
+ * @return 0 after writing the snapshot (original run),
+ *         1 when execution resumes here from a restored snapshot,
+ *        -1 on failure (unsupported architecture, I/O error).
+ */
+int veridian_checkpoint(const char *path) __attribute__((returns_twice));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _VERIDIAN_CHECKPOINT_H */
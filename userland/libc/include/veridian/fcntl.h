@@ -68,6 +68,16 @@ extern "C" {
 /** Get file status flags (O_APPEND, O_NONBLOCK, etc.) */
 #define F_GETFL         3
 
+/* File sealing (memfd): fcntl(fd, F_ADD_SEALS, F_SEAL_*) */
+#ifndef F_ADD_SEALS
+#define F_ADD_SEALS     1033
+#define F_GET_SEALS     1034
+#define F_SEAL_SEAL     0x0001
+#define F_SEAL_SHRINK   0x0002
+#define F_SEAL_GROW     0x0004
+#define F_SEAL_WRITE    0x0008
+#endif
+
 /** Set file status flags */
 #define F_SETFL         4
 
@@ -171,6 +181,16 @@ int dup2(int oldfd, int newfd);
  */
 int pipe(int pipefd[2]);
 
+/**
+ * Preallocate file storage for [offset, offset + len).
+ *
+ * @param fd        Open writable file descriptor.
+ * @param offset    Start of the range to reserve.
+ * @param len       Length of the range (> 0).
+ * @return 0 on success, an errno value on failure (not -1/errno).
+ */
+int posix_fallocate(int fd, off_t offset, off_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,84 @@
+/*
+ * VeridianOS libc -- veridian/frametrace.h
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Cross-process frame-latency tracing.
+ *
+ * Every stage of a frame's life -- input arrival in the compositor,
+ * client dispatch, client commit, composite start/end, scanout --
+ * appends a timestamped event to one shared ring, correlated by a
+ * frame ID the compositor advances at input time and every process
+ * reads from the shared header.  A viewer attributes each frame's
+ * latency to the stage that ate it, replacing stopwatch videos.
+ *
+ * Tracing is off unless VERIDIAN_FRAMETRACE=1 is in the
+ * environment; when off, every emit is one static branch.
+ */
+
+#ifndef _VERIDIAN_FRAMETRACE_H
+#define _VERIDIAN_FRAMETRACE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VFT_MAGIC     0x52544656u   /* "VFTR" */
+#define VFT_RING_CAP  4096          /* Events kept, power of two */
+
+/* Pipeline stages */
+#define VFT_STAGE_INPUT           0 /* Compositor saw the input */
+#define VFT_STAGE_DISPATCH        1 /* Client dispatched events */
+#define VFT_STAGE_COMMIT          2 /* Client committed a buffer */
+#define VFT_STAGE_COMPOSITE_START 3
+#define VFT_STAGE_COMPOSITE_END   4
+#define VFT_STAGE_SCANOUT         5
+#define VFT_STAGE_COUNT           6
+
+struct vft_event {
+    uint32_t seq;               /* Ring cell sequence */
+    uint8_t  stage;
+    uint8_t  _pad[3];
+    uint32_t frame_id;
+    uint32_t pid;
+    uint64_t ts_ns;
+};
+
+struct vft_ring {
+    uint32_t magic;
+    uint32_t current_frame;     /* Advanced by the compositor */
+    uint32_t enq;
+    uint32_t _pad;
+    struct vft_event events[VFT_RING_CAP];
+};
+
+/** Tracing active?  (Env-gated; cheap enough to call per event.) */
+int vft_enabled(void);
+
+/**
+ * Compositor only: start a new frame at input arrival.  Bumps the
+ * shared frame counter and emits the INPUT event.  Returns the new
+ * frame id (0 when tracing is off).
+ */
+uint32_t vft_begin_frame(void);
+
+/**
+ * Append one stage event for frame_id; frame_id 0 means "the frame
+ * currently in flight" (read from the shared counter), which is how
+ * client-side stages correlate without a protocol extension.
+ */
+void vft_emit(int stage, uint32_t frame_id);
+
+/* ----- Viewer side ----- */
+
+/** Map the ring read-only; NULL when no traced process ran. */
+const struct vft_ring *vft_attach(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _VERIDIAN_FRAMETRACE_H */
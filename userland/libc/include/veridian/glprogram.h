@@ -0,0 +1,74 @@
+/*
+ * VeridianOS libc -- veridian/glprogram.h
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Shared GL program-binary cache, used by the GLES shim (link-time
+ * lookup/store) and the Qt QPA plugin (lifecycle around the EGL
+ * context).
+ *
+ * Binaries are keyed on a hash of the attached shader sources; the
+ * driver identity is hashed into the cache header, so a driver update
+ * invalidates everything at once.  The backing file lives per user
+ * ($XDG_CACHE_HOME/veridian/glprograms.cache) and is mapped MAP_SHARED
+ * by every process: concurrent app starts see each other's compiles
+ * immediately, and the mapping doubles as the persisted cache.
+ */
+
+#ifndef _VERIDIAN_GLPROGRAM_H
+#define _VERIDIAN_GLPROGRAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Map (creating or resetting as needed) the per-user cache.
+ *
+ * @param driver_id  Driver identity string (vendor + version); a
+ *                   mismatch with the cached hash resets the cache.
+ * @return 0 on success, -1 when no writable cache location exists
+ *         (lookups and stores become no-ops).
+ */
+int vglp_cache_init(const char *driver_id);
+
+/* Unmap the cache.  Stored entries persist in the backing file. */
+void vglp_cache_shutdown(void);
+
+/*
+ * Chainable FNV-1a over a shader source fragment.  Seed the first
+ * call with 0; feed the previous result back for multi-string
+ * sources and for combining the shaders of one program.
+ */
+uint64_t vglp_hash_source(uint64_t seed, const char *src, size_t len);
+
+/*
+ * Look up a program binary.
+ *
+ * On a hit, *out_data points into the shared mapping (valid until
+ * vglp_cache_shutdown(); treat as read-only) and *out_format /
+ * *out_len describe the blob.  Returns 1 on hit, 0 on miss.
+ */
+int vglp_cache_lookup(uint64_t key, uint32_t *out_format,
+                      const void **out_data, uint32_t *out_len);
+
+/*
+ * Store a program binary.  Idempotent per key: a second store of a
+ * key that already exists is a no-op.  Returns 0 on success, -1 when
+ * the cache is unmapped or full.
+ */
+int vglp_cache_store(uint64_t key, uint32_t format,
+                     const void *data, uint32_t len);
+
+/* Hit/miss/store counters for this process. */
+void vglp_cache_stats(uint32_t *hits, uint32_t *misses, uint32_t *stores);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _VERIDIAN_GLPROGRAM_H */
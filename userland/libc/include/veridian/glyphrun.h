@@ -0,0 +1,90 @@
+/*
+ * VeridianOS libc -- veridian/glyphrun.h
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Shaped-glyph-run cache shared between the HarfBuzz shim (shaping),
+ * the FreeType shim (rasterization), and the Qt QPA plugin.
+ *
+ * Runs are keyed on (face, pixel size, text hash) and glyph bitmaps
+ * on (face, pixel size, glyph index).  Both live in one LRU bounded
+ * by a total byte budget, so repeated strings -- menu labels, taskbar
+ * titles, terminal lines -- skip the shaper and rasterizer entirely.
+ */
+
+#ifndef _VERIDIAN_GLYPHRUN_H
+#define _VERIDIAN_GLYPHRUN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* One positioned glyph in a shaped run (26.6 or scaled units --
+ * whatever the shaper produced; the cache does not interpret them). */
+typedef struct vgr_glyph {
+    uint32_t glyph_index;
+    uint32_t cluster;
+    int32_t  x_advance;
+    int32_t  y_advance;
+    int32_t  x_offset;
+    int32_t  y_offset;
+} vgr_glyph_t;
+
+/* A cached shaped run.  The glyph array is owned by the cache and
+ * valid until the next vgr_* call that may evict (treat as
+ * copy-out-immediately). */
+typedef struct vgr_run {
+    const vgr_glyph_t *glyphs;
+    unsigned int       count;
+} vgr_run_t;
+
+/* ----- Shaped-run cache ----- */
+
+/* Returns 1 and fills *run on hit, 0 on miss. */
+int vgr_run_lookup(const void *face, unsigned int size_px,
+                   const uint32_t *text, unsigned int text_len,
+                   vgr_run_t *run);
+
+/* Insert a shaped run; returns 0 on success, -1 if it cannot fit. */
+int vgr_run_store(const void *face, unsigned int size_px,
+                  const uint32_t *text, unsigned int text_len,
+                  const vgr_glyph_t *glyphs, unsigned int count);
+
+/* ----- Rendered-glyph bitmap cache ----- */
+
+/* Returns a pointer to the cached bitmap (width*height bytes, 8-bit
+ * alpha) or NULL on miss. */
+const unsigned char *vgr_bitmap_lookup(const void *face,
+                                       unsigned int size_px,
+                                       uint32_t glyph_index,
+                                       unsigned int *width,
+                                       unsigned int *height);
+
+int vgr_bitmap_store(const void *face, unsigned int size_px,
+                     uint32_t glyph_index,
+                     const unsigned char *bitmap,
+                     unsigned int width, unsigned int height);
+
+/* ----- Maintenance ----- */
+
+/* Set the total byte budget (default 512 KiB); evicts as needed. */
+void vgr_cache_set_budget(size_t bytes);
+
+/* Current resident bytes. */
+size_t vgr_cache_bytes(void);
+
+/* Drop everything (e.g. on font configuration change). */
+void vgr_cache_clear(void);
+
+/* Invalidate all entries for one face (face destroyed / reloaded). */
+void vgr_cache_forget_face(const void *face);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _VERIDIAN_GLYPHRUN_H */
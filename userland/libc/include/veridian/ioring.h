@@ -0,0 +1,128 @@
+/*
+ * VeridianOS libc -- veridian/ioring.h
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Asynchronous I/O submission/completion ring shared with the kernel
+ * VFS service (io_uring-style).
+ *
+ * Submissions are written into a shared SPSC ring and handed to the
+ * kernel in batches of one syscall; completions are reaped from the
+ * companion ring without any syscall.  Buffers can be registered once
+ * for zero-copy reads and writes.  On kernels without the ring
+ * syscalls, the same API runs a userland emulation over the plain
+ * wrappers -- identical semantics, just without the batching win --
+ * so consumers (KIO transfers, the Baloo crawler) can adopt it
+ * unconditionally.
+ */
+
+#ifndef _VERIDIAN_IORING_H
+#define _VERIDIAN_IORING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Operations */
+enum {
+    VIO_OP_NOP = 0,
+    VIO_OP_READ,                /* pread(fd, addr, len, off)  */
+    VIO_OP_WRITE,               /* pwrite(fd, addr, len, off) */
+    VIO_OP_FSYNC,
+    VIO_OP_CLOSE,
+    VIO_OP_READ_FIXED,          /* addr = registered buffer index */
+    VIO_OP_WRITE_FIXED
+};
+
+/* Submission queue entry */
+struct vio_sqe {
+    uint8_t  opcode;
+    uint8_t  _pad[3];
+    int32_t  fd;
+    uint64_t off;
+    uint64_t addr;              /* Buffer pointer, or buffer index for
+                                 * the _FIXED opcodes */
+    uint32_t len;
+    uint32_t _pad2;
+    uint64_t user_data;         /* Returned verbatim in the CQE */
+};
+
+/* Completion queue entry */
+struct vio_cqe {
+    uint64_t user_data;
+    int64_t  res;               /* Bytes, or negative errno */
+};
+
+struct vio_ring;
+
+/**
+ * Create a ring with at least `entries` submission slots (rounded up
+ * to a power of two, capped at 1024).  Returns NULL on allocation
+ * failure.
+ */
+struct vio_ring *vio_ring_create(unsigned int entries);
+
+/** Destroy the ring.  Outstanding completions are dropped. */
+void vio_ring_destroy(struct vio_ring *ring);
+
+/**
+ * Claim the next free submission slot, or NULL when the ring is full
+ * (submit and reap to make room).  The slot is owned by the caller
+ * until vio_submit().
+ */
+struct vio_sqe *vio_get_sqe(struct vio_ring *ring);
+
+/* Prep helpers */
+void vio_prep_read(struct vio_sqe *sqe, int fd, void *buf,
+                   uint32_t len, uint64_t off, uint64_t user_data);
+void vio_prep_write(struct vio_sqe *sqe, int fd, const void *buf,
+                    uint32_t len, uint64_t off, uint64_t user_data);
+void vio_prep_fsync(struct vio_sqe *sqe, int fd, uint64_t user_data);
+void vio_prep_close(struct vio_sqe *sqe, int fd, uint64_t user_data);
+void vio_prep_read_fixed(struct vio_sqe *sqe, int fd,
+                         unsigned int buf_index, uint32_t len,
+                         uint64_t off, uint64_t user_data);
+void vio_prep_write_fixed(struct vio_sqe *sqe, int fd,
+                          unsigned int buf_index, uint32_t len,
+                          uint64_t off, uint64_t user_data);
+
+/**
+ * Hand all claimed submissions to the kernel in one syscall.
+ * Returns the number submitted, or -1 with errno set.
+ */
+int vio_submit(struct vio_ring *ring);
+
+/**
+ * Reap one completion without a syscall.  Returns 1 with *out
+ * filled, 0 when the completion ring is empty.
+ */
+int vio_peek_cqe(struct vio_ring *ring, struct vio_cqe *out);
+
+/**
+ * Reap one completion, entering the kernel to wait only when the
+ * ring is empty.  Returns 1 on success, -1 on error.
+ */
+int vio_wait_cqe(struct vio_ring *ring, struct vio_cqe *out);
+
+/**
+ * Register an array of buffers for the _FIXED opcodes (zero-copy:
+ * the kernel pins the pages once).  Replaces any prior registration.
+ * Returns 0 on success.
+ */
+int vio_register_buffers(struct vio_ring *ring,
+                         const struct iovec *iov, unsigned int count);
+
+/** Whether the kernel ring path is active (0 = userland emulation). */
+int vio_ring_is_kernel(const struct vio_ring *ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _VERIDIAN_IORING_H */
@@ -45,6 +45,14 @@ extern "C" {
 /** Alias for MAP_ANONYMOUS */
 #define MAP_ANON        MAP_ANONYMOUS
 
+/**
+ * Back the mapping with 2 MiB pages when the VMM can (opt-in; the
+ * kernel silently falls back to 4 KiB pages otherwise).  Worthwhile
+ * for framebuffer-scale mappings where 4 KiB granularity costs TLB
+ * reach and page-table depth.
+ */
+#define MAP_HUGE        0x40
+
 /* ========================================================================= */
 /* Return Values                                                             */
 /* ========================================================================= */
@@ -69,6 +77,8 @@ extern "C" {
 #define MADV_SEQUENTIAL 2   /* Expect sequential access */
 #define MADV_WILLNEED   3   /* Will need pages soon */
 #define MADV_DONTNEED   4   /* Do not need pages soon */
+#define MADV_FREE       8   /* Pages may be reclaimed lazily; contents
+                             * survive until reclaim actually happens */
 
 /* ========================================================================= */
 /* Function Declarations                                                     */
@@ -96,6 +106,16 @@ void *mmap(void *addr, size_t length, int prot, int flags, int fd, off_t offset)
  */
 int munmap(void *addr, size_t length);
 
+/**
+ * Advise the kernel VMM about expected access to [addr, addr+length).
+ *
+ * @param addr      Page-aligned start of the range.
+ * @param length    Length in bytes.
+ * @param advice    MADV_* value.
+ * @return 0 on success, -1 on error with errno set.
+ */
+int madvise(void *addr, size_t length, int advice);
+
 /**
  * Change protection on a memory region.
  *
@@ -116,6 +136,91 @@ int mprotect(void *addr, size_t length, int prot);
  */
 int msync(void *addr, size_t length, int flags);
 
+/* ========================================================================= */
+/* memfd                                                                     */
+/* ========================================================================= */
+
+/* memfd_create() flags (values match the qt_core_platform
+ * implementation and Linux) */
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC       0x0001U
+#define MFD_ALLOW_SEALING 0x0002U
+#endif
+
+/**
+ * Create an anonymous memory-backed file (sealable; see the
+ * F_ADD_SEALS/F_SEAL_* commands in <veridian/fcntl.h>).
+ *
+ * @param name   Debugging name, not a filesystem path.
+ * @param flags  MFD_* flags.
+ * @return File descriptor, or -1 with errno set.
+ */
+int memfd_create(const char *name, unsigned int flags);
+
+/* ========================================================================= */
+/* W^X JIT dual mapping                                                      */
+/* ========================================================================= */
+
+/*
+ * One set of physical pages, two views: writable at `rw`, executable
+ * at `rx`.  A JIT emits through the RW view and runs through the RX
+ * view without ever flipping protections, so code patches cost a
+ * store plus (on ARM/RISC-V) an icache sync -- no mprotect
+ * round-trip per patch, and no page is ever writable and executable
+ * at the same address.
+ */
+struct veridian_jit_region {
+    void  *rw;          /* Write view (PROT_READ | PROT_WRITE) */
+    void  *rx;          /* Execute view (PROT_READ | PROT_EXEC) */
+    size_t size;        /* Page-rounded region length */
+};
+
+/**
+ * Allocate a dual-mapped JIT region of at least `size` bytes.
+ *
+ * @param rgn   Filled with the two views and the rounded size.
+ * @param size  Requested capacity in bytes.
+ * @return 0 on success, -1 on error with errno set.
+ */
+int veridian_jit_alloc(struct veridian_jit_region *rgn, size_t size);
+
+/**
+ * Make stores through the RW view visible to execution at the RX
+ * view for [off, off + len).  On x86 this is a compiler barrier; on
+ * AArch64 and RISC-V it performs the icache maintenance the
+ * architecture requires.
+ */
+void veridian_jit_sync(const struct veridian_jit_region *rgn,
+                       size_t off, size_t len);
+
+/** Release both views. */
+void veridian_jit_free(struct veridian_jit_region *rgn);
+
+/* ========================================================================= */
+/* Memory pressure and compressed swap                                       */
+/* ========================================================================= */
+
+#define VERIDIAN_PRESSURE_LOW      0
+#define VERIDIAN_PRESSURE_MEDIUM   1
+#define VERIDIAN_PRESSURE_CRITICAL 2
+
+/**
+ * Kernel memory-pressure fd: readable with one byte per level
+ * change.  -1/ENOSYS on kernels without the facility.
+ */
+int veridian_mempressure_fd(void);
+
+/**
+ * Compress a cold anonymous range to a backing file (LZ4) and drop
+ * its pages.  The caller must not touch the range until
+ * veridian_unswap_region().  Incompressible data fails with E2BIG
+ * and stays resident.
+ */
+int veridian_swap_region(void *addr, size_t len);
+
+/** Restore a swapped range.  ENOENT when addr was never swapped. */
+int veridian_unswap_region(void *addr);
+
 #ifdef __cplusplus
 }
 #endif
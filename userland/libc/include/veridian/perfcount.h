@@ -0,0 +1,97 @@
+/*
+ * VeridianOS libc -- veridian/perfcount.h
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Userland performance counters: the libc-side counterpart of the
+ * kernel's perf subsystem.
+ *
+ * Each process owns one shared-memory page of named monotonic
+ * counters and log2 duration histograms.  Updates are relaxed atomic
+ * adds on the hot path -- no locks, no syscalls, no I/O -- and an
+ * external sampler (sysinfo) maps the page read-only and reads live
+ * values without stopping the process.
+ */
+
+#ifndef _VERIDIAN_PERFCOUNT_H
+#define _VERIDIAN_PERFCOUNT_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VPC_MAGIC        0x50435056u    /* 'VPCP' */
+#define VPC_VERSION      1u
+#define VPC_NAME_MAX     24
+#define VPC_MAX_COUNTERS 48
+#define VPC_MAX_HISTS    14
+#define VPC_HIST_BUCKETS 16
+
+/* One named monotonic counter */
+struct vpc_counter {
+    char     name[VPC_NAME_MAX];    /* name[0] published last */
+    uint64_t value;
+};
+
+/* One log2 duration histogram: bucket i counts durations in
+ * [2^i, 2^(i+1)) microseconds, the last bucket is open-ended */
+struct vpc_hist {
+    char     name[VPC_NAME_MAX];
+    uint64_t buckets[VPC_HIST_BUCKETS];
+    uint64_t count;
+    uint64_t sum_ns;
+};
+
+/* The whole page (fits one 4 KiB page) */
+struct vpc_page {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t pid;
+    uint32_t _pad;
+    struct vpc_counter counters[VPC_MAX_COUNTERS];
+    struct vpc_hist hists[VPC_MAX_HISTS];
+};
+
+/* ----- Instrumented-process side ----- */
+
+/**
+ * Get (registering on first use) a counter handle.  Returns -1 when
+ * the table is full or the page cannot be created.
+ */
+int vpc_counter(const char *name);
+
+/** Add to a counter (relaxed atomic; no-op for handle -1). */
+void vpc_add(int handle, uint64_t delta);
+
+/** Get (registering on first use) a histogram handle. */
+int vpc_hist(const char *name);
+
+/** Record one duration in nanoseconds. */
+void vpc_hist_record(int handle, uint64_t ns);
+
+/** Monotonic nanoseconds, for vpc_hist_record(h, end - start). */
+uint64_t vpc_now_ns(void);
+
+/* ----- Sampler side ----- */
+
+/**
+ * Map another process's counter page read-only.  Returns NULL when
+ * the process has no page.  Values read are live.
+ */
+const struct vpc_page *vpc_attach(pid_t pid);
+
+/** Unmap a page from vpc_attach(). */
+void vpc_detach(const struct vpc_page *page);
+
+/** Directory the per-process pages live in (for enumeration). */
+const char *vpc_directory(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _VERIDIAN_PERFCOUNT_H */
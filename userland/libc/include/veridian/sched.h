@@ -0,0 +1,77 @@
+/*
+ * VeridianOS libc -- veridian/sched.h
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Scheduling placement hints for the NUMA-aware kernel scheduler.
+ *
+ * The scheduler balances across sockets and cache domains but had no
+ * userland input: an audio thread could migrate across sockets
+ * mid-stream.  This API lets a thread declare what it is
+ * (latency-critical vs batch), softly pin itself to a CPU set, and
+ * query enough topology to pick that set sensibly.  Everything is a
+ * hint -- the kernel may decline, and older kernels return ENOSYS,
+ * so callers never depend on placement for correctness.
+ */
+
+#ifndef _VERIDIAN_SCHED_H
+#define _VERIDIAN_SCHED_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Thread roles (veridian_sched_set_role) */
+#define VSCHED_ROLE_DEFAULT 0
+#define VSCHED_ROLE_LATENCY 1   /* Wake promptly, avoid migration:
+                                 * audio callbacks, compositors */
+#define VSCHED_ROLE_BATCH   2   /* Throughput work; keep off the
+                                 * latency threads' cores under load */
+
+#define VSCHED_MAX_NODES    8
+
+/** CPU and cache layout as the kernel scheduler sees it. */
+struct veridian_topology {
+    uint32_t cpus;              /* Online CPUs */
+    uint32_t nodes;             /* NUMA nodes (1 = UMA) */
+    uint32_t l3_groups;         /* Last-level cache domains */
+    uint32_t _pad;
+    uint64_t node_mask[VSCHED_MAX_NODES];   /* CPUs per node */
+};
+
+/**
+ * Declare the calling thread's role.  Returns 0; -1/ENOSYS on
+ * kernels without scheduling hints (safe to ignore).
+ */
+int veridian_sched_set_role(int role);
+
+/**
+ * Soft-pin the calling thread to the CPUs in mask.  Unlike a hard
+ * affinity this is a preference: the scheduler keeps the thread
+ * there while the system allows it.  mask == 0 clears the hint.
+ */
+int veridian_sched_set_affinity_hint(uint64_t cpu_mask);
+
+/**
+ * Fill *out with the CPU topology.  Kernels without the syscall get
+ * a single-node synthesis from the online CPU count, so callers can
+ * always compute placement masks.
+ */
+int veridian_sched_get_topology(struct veridian_topology *out);
+
+/**
+ * Convenience: the preferred CPU mask for the Nth latency-critical
+ * thread -- one CPU, counted from the front of the first node, so
+ * independent subsystems (audio = 0, compositor = 1) land on
+ * distinct cores of the same socket without coordinating.
+ */
+uint64_t veridian_sched_latency_cpu(unsigned int index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _VERIDIAN_SCHED_H */
@@ -208,6 +208,33 @@ int utimensat(int dirfd, const char *pathname,
  */
 int futimens(int fd, const struct timespec times[2]);
 
+/* ========================================================================= */
+/* Batched metadata (VeridianOS extension)                                   */
+/* ========================================================================= */
+
+/**
+ * Request block for veridian_stat_batch().
+ * Layout matches the kernel's StatBatchRequest in syscall/filesystem.rs.
+ */
+struct veridian_stat_batch_req {
+    const char         *dir_path;  /* directory the names are relative to */
+    const char *const  *names;     /* count entry names */
+    struct stat        *stats;     /* out: count stat buffers */
+    int32_t            *errors;    /* out: 0 or errno per entry */
+    uint32_t            count;
+    uint32_t            _pad;
+};
+
+/**
+ * Stat many directory entries in one VFS round-trip.
+ *
+ * Fills req->stats[i] and req->errors[i] for each name; a nonzero
+ * error leaves that stat buffer undefined.  Returns the number of
+ * entries processed, or -1 with errno set (ENOSYS when the kernel
+ * predates the batch call -- fall back to per-entry stat()).
+ */
+int veridian_stat_batch(struct veridian_stat_batch_req *req);
+
 #ifdef __cplusplus
 }
 #endif
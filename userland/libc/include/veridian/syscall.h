@@ -105,6 +105,7 @@ extern "C" {
 #define SYS_TIME_GET_UPTIME     100
 #define SYS_TIME_CREATE_TIMER   101
 #define SYS_TIME_CANCEL_TIMER   102
+#define SYS_TIME_GET_PAGE       103  /* map the shared time page */
 
 /* Extended process operations (110-113) */
 #define SYS_PROCESS_GETCWD      110
@@ -186,6 +187,19 @@ extern "C" {
 #define SYS_PROCESS_UNAME       204
 #define SYS_PROCESS_GETENV      205
 
+/* Batched VFS metadata (206) */
+#define SYS_FILE_STAT_BATCH     206
+
+/* Zero-copy fd-to-fd transfer (207) */
+#define SYS_FILE_SPLICE         207
+
+/* Batched small-file reads (208) */
+#define SYS_FILE_READ_BATCH     208
+
+/* Positioned scatter/gather (209-210) */
+#define SYS_PREADV              209
+#define SYS_PWRITEV             210
+
 /* Socket operations (220-228) */
 #define SYS_SOCKET_CREATE       220
 #define SYS_SOCKET_BIND         221
@@ -239,6 +253,87 @@ extern "C" {
 #define SYS_SET_ROBUST_LIST     353
 #define SYS_CLOCK_NANOSLEEP    354
 
+/* Async I/O rings (355-357) */
+#define SYS_IORING_SETUP        355
+#define SYS_IORING_ENTER        356
+#define SYS_IORING_REGISTER     357
+
+/* Profiler stack sampling assist (358) */
+#define SYS_PROCESS_SAMPLE_STACK 358
+
+/* File preallocation (359) */
+#define SYS_FILE_FALLOCATE      359
+
+/* Batched unlink: arg1 = const char *const *paths, arg2 = count (360) */
+#define SYS_FILE_UNLINK_BATCH   360
+
+/*
+ * Direct process spawn (361): the kernel builds the child address
+ * space straight from the executable, skipping duplication of the
+ * parent's mappings.  arg1 = struct veridian_spawn_args.  Returns
+ * the child pid.  File descriptors marked close-on-exec are not
+ * inherited; everything else is shared as execve would leave it.
+ */
+#define SYS_PROCESS_SPAWN       361
+
+/*
+ * Buffered directory read (362): fills a caller buffer with packed
+ * veridian_dirent_rec records (64KB+ per call instead of one entry
+ * per syscall).  arg1 = dir fd, arg2 = buffer, arg3 = buffer length,
+ * arg4 = flags (bit 0: piggyback stat attributes on each record).
+ * Returns bytes filled, 0 at end-of-directory.
+ */
+#define SYS_DIR_READDIR_BATCH   362
+#define VERIDIAN_RDDIR_STAT     0x1
+
+/*
+ * Thread interrupt (364): kicks the target thread out of any
+ * blocking syscall or in-flight IPC wait with -EINTR, so a pending
+ * cancellation is noticed in milliseconds instead of whenever the
+ * I/O happens to finish.  arg1 = kernel tid.
+ */
+#define SYS_THREAD_INTERRUPT    364
+
+/* Scheduling placement hints (365-366) */
+#define SYS_SCHED_SET_ROLE      365
+#define SYS_SCHED_SET_HINT      366
+#define SYS_SCHED_GET_TOPOLOGY  367
+
+/*
+ * BlockFS client cache control (368): arg1 = op, arg2/arg3 per op.
+ * The cache itself (per-page LRU, background write-back) lives in
+ * the VFS service; this is the visibility and tuning surface.
+ */
+#define SYS_BLOCKCACHE_CTL      368
+
+/* Memory-pressure notification fd (369): one byte per level change
+ * (0 low, 1 medium, 2 critical) */
+#define SYS_MEMPRESSURE_FD      369
+#define VBC_OP_STATS            0   /* arg2 = struct vbc_stats *    */
+#define VBC_OP_SET_CAPACITY     1   /* arg2 = pages                 */
+#define VBC_OP_SET_READAHEAD    2   /* arg2 = fd, arg3 = pages      */
+#define VBC_OP_FLUSH            3   /* start write-back, don't wait */
+
+/* ========================================================================= */
+/* Syscall latency profiling (implemented in syscall.c)                      */
+/* ========================================================================= */
+
+/**
+ * Opt-in per-syscall-number latency histograms over the libc
+ * wrappers.  Enable via VERIDIAN_SYSCALL_PROF=1 or at runtime;
+ * disabled cost is one relaxed flag load per call.  Returns the
+ * previous state.
+ */
+int veridian_syscall_prof_enable(int on);
+
+/** Fold the busiest numbers into the shared perf page and drain. */
+void veridian_syscall_prof_flush(void);
+
+/** Read one number's raw counters (24 log2-ns buckets). */
+void veridian_syscall_prof_read(long nr, uint64_t *calls,
+                                uint64_t *total_ns,
+                                uint64_t buckets[24]);
+
 /* AT_* constants for *at() syscalls */
 #define AT_FDCWD                (-100)
 #define AT_REMOVEDIR            0x200
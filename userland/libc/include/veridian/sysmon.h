@@ -0,0 +1,91 @@
+/*
+ * VeridianOS libc -- veridian/sysmon.h
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Shared-memory system monitoring ring.
+ *
+ * One sampler (sysinfo --monitor) reads /proc at a fixed interval
+ * and publishes samples into a ring at /run/veridian/sysmon.ring;
+ * any number of readers (the sysinfo CLI, Plasma applets) map it
+ * read-only and get current stats with a memory read instead of a
+ * process spawn and a /proc walk.  The writer publishes each slot
+ * before release-storing the sequence number, so readers see only
+ * complete samples; history readers revalidate against the sequence
+ * after copying in case the slot lapped.
+ */
+
+#ifndef _VERIDIAN_SYSMON_H
+#define _VERIDIAN_SYSMON_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VSM_MAGIC       0x524d5356u     /* "VSMR" */
+#define VSM_VERSION     1u
+#define VSM_RING_CAP    256             /* Samples kept */
+
+/** One monitoring sample. */
+struct vsm_sample {
+    uint64_t ts_ns;                 /* CLOCK_MONOTONIC capture time */
+    uint64_t uptime_sec;
+    uint64_t mem_total_kb;
+    uint64_t mem_free_kb;
+    uint32_t cpu_busy_pct_x10;      /* Since the previous sample */
+    uint32_t process_count;
+    uint32_t load_x100;             /* 1-minute load average */
+    uint32_t _pad;
+};
+
+/** The shared ring. */
+struct vsm_ring {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t capacity;              /* VSM_RING_CAP */
+    uint32_t interval_ms;           /* Sampler cadence */
+    uint64_t seq;                   /* Samples published so far */
+    struct vsm_sample samples[VSM_RING_CAP];
+};
+
+/* ----- Sampler side ----- */
+
+/**
+ * Create (or take over) the ring and set the advertised cadence.
+ * Returns 0, -1 on failure.
+ */
+int vsm_publish_open(uint32_t interval_ms);
+
+/** Publish one sample (slot write, then release-store of seq). */
+void vsm_publish(const struct vsm_sample *s);
+
+/* ----- Reader side ----- */
+
+/**
+ * Map the ring read-only.  Returns NULL when no sampler has ever
+ * run.  The mapping stays valid for the process lifetime.
+ */
+const struct vsm_ring *vsm_attach(void);
+
+/**
+ * Copy the most recent sample.  Returns 0, or -1 when the ring is
+ * empty.  Always returns a complete, untorn sample.
+ */
+int vsm_read_latest(const struct vsm_ring *ring, struct vsm_sample *out);
+
+/**
+ * Copy the sample `back` steps behind the newest (0 = newest).
+ * Returns 0, or -1 when that far back has been overwritten or never
+ * written.
+ */
+int vsm_read_history(const struct vsm_ring *ring, uint32_t back,
+                     struct vsm_sample *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _VERIDIAN_SYSMON_H */
@@ -0,0 +1,68 @@
+/*
+ * VeridianOS libc -- veridian/threadpool.h
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Shared work-stealing thread pool.
+ *
+ * One process-wide pool sized to online CPUs, so the renderer's
+ * tiles, the rasterizer's bins, and a crawler's directory walks
+ * share workers instead of each spinning up a pool that fights the
+ * others for the same cores.  Each worker owns a bounded deque;
+ * idle workers steal from the busiest peer.  Submission takes an
+ * optional CPU hint for cache-affine work, and live queue depths
+ * plus monotonic submit/execute/steal counters are exposed for the
+ * perf tooling.
+ */
+
+#ifndef _VERIDIAN_THREADPOOL_H
+#define _VERIDIAN_THREADPOOL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VTP_MAX_WORKERS 16
+
+typedef void (*vtp_task_fn)(void *arg);
+
+/**
+ * Queue one task on the shared pool (started on first use, sized to
+ * online CPUs).  Returns 0, or -1 when every queue is full --
+ * callers run the task inline in that case, which is also the
+ * correct backpressure.
+ */
+int vtp_submit(vtp_task_fn fn, void *arg);
+
+/**
+ * Like vtp_submit() with a placement hint: tasks touching the same
+ * data should pass the same hint so they land on the same worker's
+ * queue (stealing may still move them under imbalance).
+ */
+int vtp_submit_affine(vtp_task_fn fn, void *arg, int hint);
+
+/** Block until every task queued so far has finished. */
+void vtp_wait_idle(void);
+
+/** Number of workers (0 before first use). */
+int vtp_thread_count(void);
+
+/** Live pool statistics. */
+struct vtp_stats {
+    uint64_t submitted;
+    uint64_t executed;
+    uint64_t stolen;                    /* Executed via steal */
+    uint32_t queue_depth[VTP_MAX_WORKERS];
+    uint32_t workers;
+};
+
+void vtp_get_stats(struct vtp_stats *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _VERIDIAN_THREADPOOL_H */
@@ -0,0 +1,40 @@
+/*
+ * VeridianOS libc -- <veridian/timepage.h>
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Shared read-only time page, vDSO style.  The kernel maps one page
+ * into every process (address returned by SYS_TIME_GET_PAGE) and
+ * refreshes it from the timer tick; libc computes clock_gettime /
+ * gettimeofday in pure userspace from the cycle counter and the
+ * conversion factors here, falling back to the syscall when the page
+ * is absent or its magic/version don't match.
+ *
+ * Layout matches the kernel's TimePage structure; updates follow the
+ * usual seqlock protocol (seq is odd while the kernel rewrites the
+ * fields, and readers retry until they see the same even value on
+ * both sides of the copy).
+ */
+
+#ifndef VERIDIAN_TIMEPAGE_H
+#define VERIDIAN_TIMEPAGE_H
+
+#include <stdint.h>
+
+#define VERIDIAN_TIMEPAGE_MAGIC   0x47505456u  /* "VTPG" */
+#define VERIDIAN_TIMEPAGE_VERSION 1u
+
+struct veridian_time_page {
+    uint32_t magic;
+    uint32_t version;
+    volatile uint32_t seq;      /* seqlock; odd = update in progress */
+    uint32_t counter_shift;     /* ns = (delta * mult) >> shift */
+    uint64_t counter_mult;
+    uint64_t base_counter;      /* cycle counter at the base capture */
+    uint64_t base_mono_ns;      /* CLOCK_MONOTONIC at the base */
+    uint64_t base_real_sec;     /* CLOCK_REALTIME at the base */
+    uint64_t base_real_nsec;
+};
+
+#endif /* VERIDIAN_TIMEPAGE_H */
@@ -27,6 +27,7 @@ typedef int64_t     pid_t;
 
 /** User identifier */
 typedef uint32_t    uid_t;
+typedef uint32_t    id_t;      /* pid/pgid/uid for getpriority() */
 
 /** Group identifier */
 typedef uint32_t    gid_t;
@@ -123,4 +124,22 @@ typedef uint64_t    endpoint_t;
 }
 #endif
 
+
+/* ========================================================================= */
+/* Batched read request (SYS_FILE_READ_BATCH)                                */
+/* ========================================================================= */
+
+/**
+ * One batched read request: pread(fd, buf, len, 0), result in
+ * out_len (bytes read, or negative errno).  See veridian_read_batch()
+ * in <unistd.h>.
+ */
+struct veridian_read_req {
+    int      fd;
+    int      _pad;
+    void    *buf;
+    uint32_t len;
+    int32_t  out_len;
+};
+
 #endif /* VERIDIAN_TYPES_H */
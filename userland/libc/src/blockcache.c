@@ -0,0 +1,75 @@
+/*
+ * VeridianOS libc -- blockcache.c
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * BlockFS client cache control (veridian/blockcache.h).
+ */
+
+#include <veridian/blockcache.h>
+#include <veridian/syscall.h>
+
+#include <errno.h>
+#include <string.h>
+
+int vbc_get_stats(struct vbc_stats *out)
+{
+    long ret;
+
+    if (!out) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    ret = veridian_syscall2(SYS_BLOCKCACHE_CTL, VBC_OP_STATS, (long)out);
+    if (ret == -ENOSYS) {
+        memset(out, 0, sizeof(*out));
+        return 0;
+    }
+    if (ret < 0) {
+        errno = (int)-ret;
+        return -1;
+    }
+    return 0;
+}
+
+int vbc_set_capacity(uint32_t pages)
+{
+    long ret = veridian_syscall2(SYS_BLOCKCACHE_CTL,
+                                 VBC_OP_SET_CAPACITY, (long)pages);
+
+    if (ret < 0 && ret != -ENOSYS) {
+        errno = (int)-ret;
+        return -1;
+    }
+    return 0;
+}
+
+int vbc_set_readahead(int fd, uint32_t pages)
+{
+    long ret;
+
+    if (fd < 0) {
+        errno = EBADF;
+        return -1;
+    }
+    ret = veridian_syscall3(SYS_BLOCKCACHE_CTL, VBC_OP_SET_READAHEAD,
+                            (long)fd, (long)pages);
+    if (ret < 0 && ret != -ENOSYS) {
+        errno = (int)-ret;
+        return -1;
+    }
+    return 0;
+}
+
+int vbc_flush(void)
+{
+    long ret = veridian_syscall1(SYS_BLOCKCACHE_CTL, VBC_OP_FLUSH);
+
+    if (ret < 0 && ret != -ENOSYS) {
+        errno = (int)-ret;
+        return -1;
+    }
+    return 0;
+}
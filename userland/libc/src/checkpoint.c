@@ -0,0 +1,192 @@
+/*
+ * VeridianOS libc -- checkpoint.c
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Process checkpoint writer (veridian/checkpoint.h).
+ *
+ * The entry stub saves the callee-saved register file plus the
+ * return address and stack pointer -- exactly what a resumed run
+ * needs to make the original call site return 1 -- then tail-calls
+ * the C writer.  The writer walks /proc/self/maps and appends every
+ * readable private mapping to the snapshot: text, data, heap,
+ * stack, all of it, so the image is self-contained.  ld-veridian's
+ * restore path maps the segments back and jumps through the saved
+ * context.
+ */
+
+#include <veridian/checkpoint.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#ifdef __x86_64__
+
+#define ARCH_GET_FS 0x1003
+extern int arch_prctl(int code, unsigned long *addr);
+
+/* Filled by the entry stub below */
+struct vckp_cpu __vckp_cpu;
+
+/* One maps line worth of parsed range */
+struct vckp_range {
+    uint64_t start;
+    uint64_t end;
+    uint32_t prot;
+};
+
+/*
+ * Parse /proc/self/maps into dumpable ranges: private, readable,
+ * and not one of the kernel pseudo-mappings that cannot (and must
+ * not) be restored from file data.
+ */
+static int vckp_collect(struct vckp_range *out, int max)
+{
+    FILE *fp = fopen("/proc/self/maps", "r");
+    char line[512];
+    int n = 0;
+
+    if (!fp)
+        return -1;
+
+    while (fgets(line, sizeof(line), fp) && n < max) {
+        unsigned long long start, end;
+        char perms[8];
+        int consumed = 0;
+
+        if (sscanf(line, "%llx-%llx %4s %*x %*s %*s%n", &start, &end,
+                   perms, &consumed) < 3)
+            continue;
+        if (perms[0] != 'r' || perms[3] != 'p')
+            continue;           /* Unreadable or shared: skip */
+
+        const char *name = line + consumed;
+
+        while (*name == ' ')
+            name++;
+        /* Prefix match: kernels grow variants like [vvar_vclock] */
+        if (strstr(name, "[vdso") || strstr(name, "[vvar") ||
+            strstr(name, "[vsyscall"))
+            continue;
+
+        out[n].start = start;
+        out[n].end = end;
+        out[n].prot = PROT_READ |
+                      (perms[1] == 'w' ? PROT_WRITE : 0) |
+                      (perms[2] == 'x' ? PROT_EXEC : 0);
+        n++;
+    }
+    fclose(fp);
+    return n;
+}
+
+/* The C half; the asm stub has already filled __vckp_cpu */
+int __vckp_write(const char *path)
+{
+    static struct vckp_header hdr;      /* Static: travels in .bss */
+    struct vckp_range ranges[VCKP_MAX_SEGMENTS];
+    int nranges, fd;
+    uint64_t off;
+
+    if (!path)
+        return -1;
+
+    arch_prctl(ARCH_GET_FS, &__vckp_cpu.fsbase);
+
+    nranges = vckp_collect(ranges, VCKP_MAX_SEGMENTS);
+    if (nranges <= 0)
+        return -1;
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = VCKP_MAGIC;
+    hdr.version = VCKP_VERSION;
+    hdr.cpu = __vckp_cpu;
+
+    off = sizeof(hdr);
+    for (int i = 0; i < nranges; i++) {
+        hdr.segments[i].vaddr = ranges[i].start;
+        hdr.segments[i].length = ranges[i].end - ranges[i].start;
+        hdr.segments[i].file_off = off;
+        hdr.segments[i].prot = ranges[i].prot;
+        off += hdr.segments[i].length;
+    }
+    hdr.segment_count = (uint32_t)nranges;
+
+    fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0755);
+    if (fd < 0)
+        return -1;
+
+    if (write(fd, &hdr, sizeof(hdr)) != (ssize_t)sizeof(hdr)) {
+        close(fd);
+        unlink(path);
+        return -1;
+    }
+
+    for (int i = 0; i < nranges; i++) {
+        const uint8_t *p = (const uint8_t *)(uintptr_t)ranges[i].start;
+        size_t len = (size_t)(ranges[i].end - ranges[i].start);
+        size_t done = 0;
+
+        while (done < len) {
+            ssize_t w = write(fd, p + done, len - done);
+
+            if (w <= 0) {
+                close(fd);
+                unlink(path);
+                return -1;
+            }
+            done += (size_t)w;
+        }
+    }
+
+    if (fsync(fd) < 0) {
+        close(fd);
+        unlink(path);
+        return -1;
+    }
+    close(fd);
+    return 0;
+}
+
+/*
+ * Entry stub: capture the context a resume must reproduce -- the
+ * return address, the post-return stack pointer, and the
+ * callee-saved registers -- then run the writer with the path still
+ * in rdi.  The restore path jumps to the saved rip with this
+ * register file reloaded and rax = 1, which is indistinguishable
+ * from this function returning 1.
+ */
+__asm__(
+    ".text\n"
+    ".globl veridian_checkpoint\n"
+    ".type veridian_checkpoint, @function\n"
+    "veridian_checkpoint:\n"
+    "    movq (%rsp), %rax\n"
+    "    movq %rax, __vckp_cpu+0(%rip)\n"   /* rip = return address */
+    "    leaq 8(%rsp), %rax\n"
+    "    movq %rax, __vckp_cpu+8(%rip)\n"   /* rsp after return */
+    "    movq %rbx, __vckp_cpu+16(%rip)\n"
+    "    movq %rbp, __vckp_cpu+24(%rip)\n"
+    "    movq %r12, __vckp_cpu+32(%rip)\n"
+    "    movq %r13, __vckp_cpu+40(%rip)\n"
+    "    movq %r14, __vckp_cpu+48(%rip)\n"
+    "    movq %r15, __vckp_cpu+56(%rip)\n"
+    "    jmp __vckp_write\n"                /* Returns 0/-1 for us */
+    ".size veridian_checkpoint, . - veridian_checkpoint\n");
+
+#else /* !__x86_64__ */
+
+int veridian_checkpoint(const char *path)
+{
+    (void)path;
+    errno = ENOSYS;
+    return -1;
+}
+
+#endif /* __x86_64__ */
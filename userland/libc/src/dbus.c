@@ -42,7 +42,7 @@ struct dbus_arg {
         dbus_int64_t   i64_val;
         dbus_uint64_t  u64_val;
         double         dbl_val;
-        char           str_val[MAX_STR];
+        dbus_uint32_t  str_off;    /* Offset into the message arena */
     } value;
 };
 
@@ -63,6 +63,19 @@ struct DBusMessage {
     dbus_bool_t      auto_start;
     struct dbus_arg  args[MAX_ARGS];
     int              num_args;
+
+    /*
+     * Per-message string arena: one allocation, bump-pointer writes,
+     * freed in one step at the final unref.  String arguments live
+     * here as offsets, so a message costs 60 bytes per arg in the
+     * pool instead of a 256-byte inline buffer each, and strings are
+     * no longer silently truncated at MAX_STR.  Offset 0 is a shared
+     * empty string.  Reader views stay valid until the message is
+     * modified or unreffed (the libdbus contract).
+     */
+    char            *arena;
+    dbus_uint32_t    arena_used;
+    dbus_uint32_t    arena_cap;
 };
 
 struct DBusConnection {
@@ -96,6 +109,241 @@ struct DBusPendingCall {
 static struct DBusConnection g_connections[MAX_CONNECTIONS];
 static struct DBusMessage    g_messages[MAX_MESSAGES];
 static struct DBusPendingCall g_pending[MAX_PENDING];
+
+/* In-process object path handlers (the synchronous-call fast path) */
+#define MAX_OBJECT_PATHS 32
+
+struct dbus_object_path {
+    int                   in_use;
+    int                   fallback;     /* Subtree handler */
+    DBusConnection       *connection;
+    char                  path[MAX_STR];
+    DBusObjectPathVTable  vtable;
+    void                 *user_data;
+};
+
+static struct dbus_object_path g_object_paths[MAX_OBJECT_PATHS];
+
+/* While a synchronous in-process dispatch runs, the handler's reply
+ * (sent through dbus_connection_send) is captured here instead of
+ * being queued */
+static dbus_uint32_t          g_sync_capture_serial;
+static struct DBusMessage    *g_sync_reply;
+
+/* ========================================================================= */
+/* Compiled signal match rules                                               */
+/* ========================================================================= */
+
+static void safe_copy(char *dst, const char *src, int max);
+
+/*
+ * Match rules are compiled at add_match time into a discrimination
+ * table keyed on the interface hash, with a 64-bit Bloom filter in
+ * front.  An incoming broadcast tests two Bloom bits first; only on a
+ * hit does it walk the (short) per-interface chain comparing member,
+ * path, and type.  Non-matching signals -- the overwhelming majority
+ * in a process with hundreds of rules -- are rejected in O(1).
+ */
+
+#define MAX_MATCH_RULES 256
+#define MATCH_BUCKETS   64
+
+struct dbus_match_rule {
+    int             in_use;
+    DBusConnection *connection;
+    int             msg_type;       /* 0 = any */
+    dbus_uint32_t   iface_hash;     /* 0 = wildcard interface */
+    dbus_uint32_t   member_hash;    /* 0 = wildcard member    */
+    char            path[MAX_STR];  /* Empty = any            */
+    int             path_namespace; /* Prefix match           */
+    char            text[MAX_STR];  /* Identity for remove    */
+    int             next;           /* Chain within bucket    */
+};
+
+static struct dbus_match_rule g_match_rules[MAX_MATCH_RULES];
+static int g_match_buckets[MATCH_BUCKETS];  /* -1 terminated chains */
+static int g_match_wildcard;                /* Wildcard-iface chain */
+static int g_match_initialized;
+static dbus_uint64_t g_match_bloom;         /* Interface presence   */
+static int g_match_count;
+
+static dbus_uint32_t match_hash(const char *str)
+{
+    dbus_uint32_t h = 2166136261u;
+
+    for (; str && *str; str++) {
+        h ^= (unsigned char)*str;
+        h *= 16777619u;
+    }
+    return h ? h : 1;                   /* 0 is the wildcard marker */
+}
+
+static dbus_uint64_t match_bloom_bits(dbus_uint32_t iface_hash)
+{
+    return (1ULL << (iface_hash & 63)) |
+           (1ULL << ((iface_hash >> 6) & 63));
+}
+
+static void match_init(void)
+{
+    int i;
+
+    if (g_match_initialized)
+        return;
+    for (i = 0; i < MATCH_BUCKETS; i++)
+        g_match_buckets[i] = -1;
+    g_match_wildcard = -1;
+    g_match_initialized = 1;
+}
+
+/* Pull one key='value' pair out of a rule string */
+static const char *match_parse_kv(const char *p, char *key, int key_len,
+                                  char *val, int val_len)
+{
+    int n = 0;
+
+    while (*p == ',' || *p == ' ')
+        p++;
+    if (!*p)
+        return NULL;
+
+    while (*p && *p != '=' && n < key_len - 1)
+        key[n++] = *p++;
+    key[n] = '\0';
+    if (*p != '=' || p[1] != '\'')
+        return NULL;
+    p += 2;
+
+    n = 0;
+    while (*p && *p != '\'' && n < val_len - 1)
+        val[n++] = *p++;
+    val[n] = '\0';
+    if (*p != '\'')
+        return NULL;
+    return p + 1;
+}
+
+/* Compile a rule string into the slot; returns FALSE on parse error */
+static dbus_bool_t match_compile(struct dbus_match_rule *r,
+                                 const char *rule)
+{
+    const char *p = rule;
+    char key[32];
+    char val[MAX_STR];
+
+    memset(r, 0, sizeof(*r));
+    safe_copy(r->text, rule, MAX_STR);
+
+    while ((p = match_parse_kv(p, key, sizeof(key), val, sizeof(val)))) {
+        if (strcmp(key, "type") == 0) {
+            if (strcmp(val, "signal") == 0)
+                r->msg_type = DBUS_MESSAGE_TYPE_SIGNAL;
+            else if (strcmp(val, "method_call") == 0)
+                r->msg_type = DBUS_MESSAGE_TYPE_METHOD_CALL;
+            else if (strcmp(val, "error") == 0)
+                r->msg_type = DBUS_MESSAGE_TYPE_ERROR;
+        } else if (strcmp(key, "interface") == 0) {
+            r->iface_hash = match_hash(val);
+        } else if (strcmp(key, "member") == 0) {
+            r->member_hash = match_hash(val);
+        } else if (strcmp(key, "path") == 0) {
+            safe_copy(r->path, val, MAX_STR);
+            r->path_namespace = 0;
+        } else if (strcmp(key, "path_namespace") == 0) {
+            safe_copy(r->path, val, MAX_STR);
+            r->path_namespace = 1;
+        }
+        /* sender=/destination=/argN= accepted and ignored: the shim
+         * has a single in-process bus */
+    }
+
+    return TRUE;
+}
+
+/* Recompute the Bloom filter after a removal */
+static void match_rebuild_bloom(void)
+{
+    int i;
+
+    g_match_bloom = 0;
+    for (i = 0; i < MAX_MATCH_RULES; i++) {
+        if (g_match_rules[i].in_use && g_match_rules[i].iface_hash)
+            g_match_bloom |= match_bloom_bits(g_match_rules[i].iface_hash);
+    }
+}
+
+static int match_rule_matches(const struct dbus_match_rule *r,
+                              DBusConnection *connection,
+                              const struct DBusMessage *msg,
+                              dbus_uint32_t iface_hash,
+                              dbus_uint32_t member_hash)
+{
+    if (r->connection != connection)
+        return 0;
+    if (r->msg_type && r->msg_type != msg->msg_type)
+        return 0;
+    if (r->iface_hash && r->iface_hash != iface_hash)
+        return 0;
+    if (r->member_hash && r->member_hash != member_hash)
+        return 0;
+    if (r->path[0]) {
+        if (r->path_namespace) {
+            size_t len = strlen(r->path);
+
+            if (strncmp(r->path, msg->path, len) != 0 ||
+                (msg->path[len] != '\0' && msg->path[len] != '/'))
+                return 0;
+        } else if (strcmp(r->path, msg->path) != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/*
+ * Veridian extension used by the event pump: does any registered
+ * match rule of this connection accept the message?  Bloom-filter
+ * front end, then the per-interface discrimination chain.
+ */
+dbus_bool_t dbus_veridian_signal_matches(DBusConnection *connection,
+                                         DBusMessage *message)
+{
+    dbus_uint32_t iface_hash;
+    dbus_uint32_t member_hash;
+    int idx;
+
+    if (!connection || !message || !g_match_initialized ||
+        g_match_count == 0)
+        return FALSE;
+
+    iface_hash = match_hash(message->interface);
+
+    /* Bloom front-end: two bit tests reject almost everything.  Only
+     * valid when no wildcard-interface rules exist (those live on
+     * their own chain and force the walk). */
+    if (g_match_wildcard < 0 &&
+        (g_match_bloom & match_bloom_bits(iface_hash)) !=
+            match_bloom_bits(iface_hash))
+        return FALSE;
+
+    member_hash = match_hash(message->member);
+
+    for (idx = g_match_buckets[iface_hash & (MATCH_BUCKETS - 1)];
+         idx >= 0; idx = g_match_rules[idx].next) {
+        if (match_rule_matches(&g_match_rules[idx], connection, message,
+                               iface_hash, member_hash))
+            return TRUE;
+    }
+    for (idx = g_match_wildcard; idx >= 0; idx = g_match_rules[idx].next) {
+        if (match_rule_matches(&g_match_rules[idx], connection, message,
+                               iface_hash, member_hash))
+            return TRUE;
+    }
+    return FALSE;
+}
+
+static struct dbus_object_path *find_object_path(DBusConnection *connection,
+                                                 const char *path);
 static dbus_uint32_t         g_next_unique_id = 1;
 static dbus_uint32_t         g_next_serial    = 1;
 static int                   g_threads_initialized = 0;
@@ -105,6 +353,51 @@ static dbus_int32_t          g_next_data_slot = 0;
 /* Internal helpers                                                          */
 /* ========================================================================= */
 
+static dbus_uint32_t msg_arena_store(struct DBusMessage *msg,
+                                     const char *str)
+{
+    size_t len = str ? strlen(str) : 0;
+    dbus_uint32_t off;
+
+    if (len == 0)
+        return 0;                   /* Shared empty-string slot */
+
+    /* Byte 0 is reserved for the shared empty string */
+    {
+        dbus_uint32_t used = msg->arena_used ? msg->arena_used : 1;
+
+        if (used + len + 1 > msg->arena_cap) {
+            dbus_uint32_t cap = msg->arena_cap ? msg->arena_cap : 256;
+            char *grown;
+
+            while (used + len + 1 > cap)
+                cap *= 2;
+            grown = realloc(msg->arena, cap);
+            if (!grown)
+                return 0;
+            msg->arena = grown;
+            msg->arena_cap = cap;
+        }
+        if (msg->arena_used == 0) {
+            msg->arena[0] = '\0';  /* Offset 0: empty string */
+            msg->arena_used = 1;
+        }
+    }
+
+    off = msg->arena_used;
+    memcpy(msg->arena + off, str, len + 1);
+    msg->arena_used += (dbus_uint32_t)(len + 1);
+    return off;
+}
+
+static const char *msg_arena_str(const struct DBusMessage *msg,
+                                 dbus_uint32_t off)
+{
+    if (!msg->arena || off >= msg->arena_used)
+        return "";
+    return msg->arena + off;
+}
+
 static void safe_copy(char *dst, const char *src, int max)
 {
     if (src) {
@@ -145,6 +438,7 @@ static struct DBusMessage *alloc_message(void)
     int i;
     for (i = 0; i < MAX_MESSAGES; i++) {
         if (!g_messages[i].in_use) {
+            free(g_messages[i].arena);   /* From a prior occupant */
             memset(&g_messages[i], 0, sizeof(struct DBusMessage));
             g_messages[i].in_use = 1;
             g_messages[i].refcount = 1;
@@ -413,17 +707,79 @@ dbus_bool_t dbus_bus_start_service_by_name(DBusConnection *connection,
 void dbus_bus_add_match(DBusConnection *connection, const char *rule,
                         DBusError *error)
 {
-    (void)connection;
-    (void)rule;
-    (void)error;
+    int i;
+
+    if (!connection || !rule)
+        return;
+    match_init();
+
+    for (i = 0; i < MAX_MATCH_RULES; i++) {
+        if (!g_match_rules[i].in_use)
+            break;
+    }
+    if (i >= MAX_MATCH_RULES) {
+        dbus_set_error(error, DBUS_ERROR_LIMITS_EXCEEDED,
+                       "too many match rules");
+        return;
+    }
+
+    if (!match_compile(&g_match_rules[i], rule)) {
+        dbus_set_error(error, DBUS_ERROR_MATCH_RULE_INVALID,
+                       "cannot parse match rule");
+        return;
+    }
+    g_match_rules[i].in_use = 1;
+    g_match_rules[i].connection = connection;
+
+    /* Link into the discrimination table and stamp the Bloom filter */
+    if (g_match_rules[i].iface_hash) {
+        int bucket = (int)(g_match_rules[i].iface_hash &
+                           (MATCH_BUCKETS - 1));
+
+        g_match_rules[i].next = g_match_buckets[bucket];
+        g_match_buckets[bucket] = i;
+        g_match_bloom |= match_bloom_bits(g_match_rules[i].iface_hash);
+    } else {
+        g_match_rules[i].next = g_match_wildcard;
+        g_match_wildcard = i;
+    }
+    g_match_count++;
 }
 
 void dbus_bus_remove_match(DBusConnection *connection, const char *rule,
                            DBusError *error)
 {
-    (void)connection;
-    (void)rule;
+    int i;
+
     (void)error;
+    if (!connection || !rule || !g_match_initialized)
+        return;
+
+    for (i = 0; i < MAX_MATCH_RULES; i++) {
+        struct dbus_match_rule *r = &g_match_rules[i];
+        int *chain;
+        int idx;
+
+        if (!r->in_use || r->connection != connection ||
+            strcmp(r->text, rule) != 0)
+            continue;
+
+        /* Unlink from its chain */
+        chain = r->iface_hash
+                    ? &g_match_buckets[r->iface_hash & (MATCH_BUCKETS - 1)]
+                    : &g_match_wildcard;
+        for (idx = *chain; idx >= 0;
+             chain = &g_match_rules[idx].next, idx = *chain) {
+            if (idx == i) {
+                *chain = r->next;
+                break;
+            }
+        }
+        r->in_use = 0;
+        g_match_count--;
+        match_rebuild_bloom();
+        return;
+    }
 }
 
 /* ========================================================================= */
@@ -510,6 +866,18 @@ dbus_bool_t dbus_connection_send(DBusConnection *connection,
     message->serial = connection->next_serial++;
     if (serial)
         *serial = message->serial;
+
+    /* A reply produced inside a synchronous in-process dispatch is
+     * handed straight back to the blocked caller, never queued */
+    if (g_sync_capture_serial &&
+        message->reply_serial == g_sync_capture_serial &&
+        (message->msg_type == DBUS_MESSAGE_TYPE_METHOD_RETURN ||
+         message->msg_type == DBUS_MESSAGE_TYPE_ERROR)) {
+        if (!g_sync_reply) {
+            g_sync_reply = message;
+            message->refcount++;
+        }
+    }
     return TRUE;
 }
 
@@ -552,6 +920,34 @@ DBusMessage *dbus_connection_send_with_reply_and_block(
 
     message->serial = connection->next_serial++;
 
+    /*
+     * Fast path: a handler registered in this process serves the call
+     * synchronously -- no pending-call queueing, no dispatch loop.
+     * Its reply (sent through dbus_connection_send during the
+     * callback) is captured and returned directly.
+     */
+    {
+        struct dbus_object_path *op =
+            find_object_path(connection, message->path);
+
+        if (op && op->vtable.message_function) {
+            struct DBusMessage *reply;
+
+            g_sync_capture_serial = message->serial;
+            g_sync_reply = NULL;
+            op->vtable.message_function(connection, message,
+                                        op->user_data);
+            reply = g_sync_reply;
+            g_sync_capture_serial = 0;
+            g_sync_reply = NULL;
+
+            if (reply)
+                return reply;
+            /* Handler took it but produced no reply: fall through to
+             * the fabricated empty return */
+        }
+    }
+
     /* Return a valid empty reply */
     struct DBusMessage *reply = alloc_message();
     if (reply) {
@@ -946,16 +1342,80 @@ void dbus_connection_set_exit_on_disconnect(DBusConnection *connection,
 /* Object path registration (stubs)                                          */
 /* ========================================================================= */
 
+static struct dbus_object_path *find_object_path(DBusConnection *connection,
+                                                 const char *path)
+{
+    struct dbus_object_path *best = NULL;
+    size_t best_len = 0;
+    int i;
+
+    for (i = 0; i < MAX_OBJECT_PATHS; i++) {
+        struct dbus_object_path *op = &g_object_paths[i];
+        size_t len;
+
+        if (!op->in_use || op->connection != connection)
+            continue;
+        if (strcmp(op->path, path) == 0)
+            return op;
+        if (!op->fallback)
+            continue;
+        /* Fallback handlers own their subtree */
+        len = strlen(op->path);
+        if (strncmp(op->path, path, len) == 0 && path[len] == '/' &&
+            len > best_len) {
+            best = op;
+            best_len = len;
+        }
+    }
+    return best;
+}
+
+static dbus_bool_t register_path(DBusConnection *connection,
+                                 const char *path,
+                                 const DBusObjectPathVTable *vtable,
+                                 void *user_data, int fallback,
+                                 int fail_on_dup)
+{
+    int i;
+    int slot = -1;
+
+    if (!connection || !path || !vtable)
+        return FALSE;
+
+    for (i = 0; i < MAX_OBJECT_PATHS; i++) {
+        if (g_object_paths[i].in_use &&
+            g_object_paths[i].connection == connection &&
+            strcmp(g_object_paths[i].path, path) == 0) {
+            if (fail_on_dup)
+                return FALSE;
+            slot = i;
+            break;
+        }
+        if (!g_object_paths[i].in_use && slot < 0)
+            slot = i;
+    }
+    if (slot < 0)
+        return FALSE;
+
+    g_object_paths[slot].in_use = 1;
+    g_object_paths[slot].fallback = fallback;
+    g_object_paths[slot].connection = connection;
+    safe_copy(g_object_paths[slot].path, path, MAX_STR);
+    g_object_paths[slot].vtable = *vtable;
+    g_object_paths[slot].user_data = user_data;
+    return TRUE;
+}
+
 dbus_bool_t dbus_connection_try_register_object_path(
     DBusConnection *connection, const char *path,
     const DBusObjectPathVTable *vtable, void *user_data,
     DBusError *error)
 {
-    (void)connection;
-    (void)path;
-    (void)vtable;
-    (void)user_data;
-    (void)error;
+    if (!register_path(connection, path, vtable, user_data, 0, 1)) {
+        dbus_set_error(error, DBUS_ERROR_OBJECT_PATH_IN_USE,
+                       "path already registered");
+        return FALSE;
+    }
     return TRUE;
 }
 
@@ -963,11 +1423,7 @@ dbus_bool_t dbus_connection_register_object_path(
     DBusConnection *connection, const char *path,
     const DBusObjectPathVTable *vtable, void *user_data)
 {
-    (void)connection;
-    (void)path;
-    (void)vtable;
-    (void)user_data;
-    return TRUE;
+    return register_path(connection, path, vtable, user_data, 0, 0);
 }
 
 dbus_bool_t dbus_connection_try_register_fallback(
@@ -975,11 +1431,11 @@ dbus_bool_t dbus_connection_try_register_fallback(
     const DBusObjectPathVTable *vtable, void *user_data,
     DBusError *error)
 {
-    (void)connection;
-    (void)path;
-    (void)vtable;
-    (void)user_data;
-    (void)error;
+    if (!register_path(connection, path, vtable, user_data, 1, 1)) {
+        dbus_set_error(error, DBUS_ERROR_OBJECT_PATH_IN_USE,
+                       "path already registered");
+        return FALSE;
+    }
     return TRUE;
 }
 
@@ -987,28 +1443,40 @@ dbus_bool_t dbus_connection_register_fallback(
     DBusConnection *connection, const char *path,
     const DBusObjectPathVTable *vtable, void *user_data)
 {
-    (void)connection;
-    (void)path;
-    (void)vtable;
-    (void)user_data;
-    return TRUE;
+    return register_path(connection, path, vtable, user_data, 1, 0);
 }
 
 dbus_bool_t dbus_connection_unregister_object_path(
     DBusConnection *connection, const char *path)
 {
-    (void)connection;
-    (void)path;
+    int i;
+
+    if (!connection || !path)
+        return FALSE;
+
+    for (i = 0; i < MAX_OBJECT_PATHS; i++) {
+        if (g_object_paths[i].in_use &&
+            g_object_paths[i].connection == connection &&
+            strcmp(g_object_paths[i].path, path) == 0) {
+            if (g_object_paths[i].vtable.unregister_function)
+                g_object_paths[i].vtable.unregister_function(
+                    connection, g_object_paths[i].user_data);
+            g_object_paths[i].in_use = 0;
+        }
+    }
     return TRUE;
 }
 
 dbus_bool_t dbus_connection_get_object_path_data(
     DBusConnection *connection, const char *path, void **data_p)
 {
-    (void)connection;
-    (void)path;
+    struct dbus_object_path *op;
+
+    if (!connection || !path)
+        return FALSE;
+    op = find_object_path(connection, path);
     if (data_p)
-        *data_p = NULL;
+        *data_p = op ? op->user_data : NULL;
     return TRUE;
 }
 
@@ -1094,7 +1562,7 @@ DBusMessage *dbus_message_new_error(DBusMessage *reply_to,
     /* Store error message as a string argument */
     if (error_message && msg->num_args < MAX_ARGS) {
         msg->args[0].type = DBUS_TYPE_STRING;
-        safe_copy(msg->args[0].value.str_val, error_message, MAX_STR);
+        msg->args[0].value.str_off = msg_arena_store(msg, error_message);
         msg->num_args = 1;
     }
     return msg;
@@ -1120,8 +1588,13 @@ void dbus_message_unref(DBusMessage *message)
     if (!message)
         return;
     message->refcount--;
-    if (message->refcount <= 0)
+    if (message->refcount <= 0) {
+        free(message->arena);
+        message->arena = NULL;
+        message->arena_used = 0;
+        message->arena_cap = 0;
         message->in_use = 0;
+    }
 }
 
 DBusMessage *dbus_message_copy(const DBusMessage *message)
@@ -1136,6 +1609,19 @@ DBusMessage *dbus_message_copy(const DBusMessage *message)
     copy->serial = saved_serial;
     copy->refcount = 1;
     copy->in_use = 1;
+
+    /* Deep-copy the arena: the offsets stay valid as-is */
+    copy->arena = NULL;
+    copy->arena_cap = 0;
+    if (message->arena && message->arena_used > 0) {
+        copy->arena = malloc(message->arena_used);
+        if (copy->arena) {
+            memcpy(copy->arena, message->arena, message->arena_used);
+            copy->arena_cap = message->arena_used;
+        } else {
+            copy->arena_used = 0;
+        }
+    }
     return copy;
 }
 
@@ -1432,7 +1918,8 @@ dbus_bool_t dbus_message_get_args_valist(DBusMessage *message,
             case DBUS_TYPE_STRING:
             case DBUS_TYPE_OBJECT_PATH:
             case DBUS_TYPE_SIGNATURE:
-                *(const char **)value = message->args[idx].value.str_val;
+                *(const char **)value =
+                    msg_arena_str(message, message->args[idx].value.str_off);
                 break;
             default:
                 break;
@@ -1471,58 +1958,60 @@ dbus_bool_t dbus_message_append_args_valist(DBusMessage *message,
         int idx = message->num_args;
         message->args[idx].type = type;
 
+        /* libdbus convention: every vararg is the ADDRESS of the
+         * value (callers write &v / &str) */
         switch (type) {
         case DBUS_TYPE_BYTE: {
-            /* Promoted to int in va_arg */
-            unsigned char v = (unsigned char)va_arg(var_args, int);
-            message->args[idx].value.byte_val = v;
+            const unsigned char *v = va_arg(var_args, const unsigned char *);
+            message->args[idx].value.byte_val = *v;
             break;
         }
         case DBUS_TYPE_BOOLEAN: {
-            dbus_bool_t v = (dbus_bool_t)va_arg(var_args, int);
-            message->args[idx].value.bool_val = v;
+            const dbus_bool_t *v = va_arg(var_args, const dbus_bool_t *);
+            message->args[idx].value.bool_val = *v;
             break;
         }
         case DBUS_TYPE_INT16: {
-            dbus_int16_t v = (dbus_int16_t)va_arg(var_args, int);
-            message->args[idx].value.i16_val = v;
+            const dbus_int16_t *v = va_arg(var_args, const dbus_int16_t *);
+            message->args[idx].value.i16_val = *v;
             break;
         }
         case DBUS_TYPE_UINT16: {
-            dbus_uint16_t v = (dbus_uint16_t)va_arg(var_args, int);
-            message->args[idx].value.u16_val = v;
+            const dbus_uint16_t *v = va_arg(var_args, const dbus_uint16_t *);
+            message->args[idx].value.u16_val = *v;
             break;
         }
         case DBUS_TYPE_INT32: {
-            dbus_int32_t v = va_arg(var_args, dbus_int32_t);
-            message->args[idx].value.i32_val = v;
+            const dbus_int32_t *v = va_arg(var_args, const dbus_int32_t *);
+            message->args[idx].value.i32_val = *v;
             break;
         }
         case DBUS_TYPE_UINT32: {
-            dbus_uint32_t v = va_arg(var_args, dbus_uint32_t);
-            message->args[idx].value.u32_val = v;
+            const dbus_uint32_t *v = va_arg(var_args, const dbus_uint32_t *);
+            message->args[idx].value.u32_val = *v;
             break;
         }
         case DBUS_TYPE_INT64: {
-            dbus_int64_t v = va_arg(var_args, dbus_int64_t);
-            message->args[idx].value.i64_val = v;
+            const dbus_int64_t *v = va_arg(var_args, const dbus_int64_t *);
+            message->args[idx].value.i64_val = *v;
             break;
         }
         case DBUS_TYPE_UINT64: {
-            dbus_uint64_t v = va_arg(var_args, dbus_uint64_t);
-            message->args[idx].value.u64_val = v;
+            const dbus_uint64_t *v = va_arg(var_args, const dbus_uint64_t *);
+            message->args[idx].value.u64_val = *v;
             break;
         }
         case DBUS_TYPE_DOUBLE: {
-            double v = va_arg(var_args, double);
-            message->args[idx].value.dbl_val = v;
+            const double *v = va_arg(var_args, const double *);
+            message->args[idx].value.dbl_val = *v;
             break;
         }
         case DBUS_TYPE_STRING:
         case DBUS_TYPE_OBJECT_PATH:
         case DBUS_TYPE_SIGNATURE: {
-            const char *v = va_arg(var_args, const char *);
-            safe_copy(message->args[idx].value.str_val, v, MAX_STR);
+            const char *const *v = va_arg(var_args, const char *const *);
+            message->args[idx].value.str_off =
+                msg_arena_store(message, *v);
             break;
         }
         default:
@@ -1655,7 +2144,7 @@ void dbus_message_iter_get_basic(DBusMessageIter *iter, void *value)
     case DBUS_TYPE_STRING:
     case DBUS_TYPE_OBJECT_PATH:
     case DBUS_TYPE_SIGNATURE:
-        *(const char **)value = arg->value.str_val;
+        *(const char **)value = msg_arena_str(msg, arg->value.str_off);
         break;
     default:
         break;
@@ -1739,8 +2228,8 @@ dbus_bool_t dbus_message_iter_append_basic(DBusMessageIter *iter, int type,
     case DBUS_TYPE_STRING:
     case DBUS_TYPE_OBJECT_PATH:
     case DBUS_TYPE_SIGNATURE:
-        safe_copy(msg->args[idx].value.str_val,
-                  *(const char *const *)value, MAX_STR);
+        msg->args[idx].value.str_off =
+            msg_arena_store(msg, *(const char *const *)value);
         break;
     default:
         return FALSE;
@@ -6,6 +6,14 @@
  *
  * Directory stream operations built on top of the kernel's
  * SYS_DIR_OPENDIR / SYS_DIR_READDIR / SYS_DIR_CLOSEDIR syscalls.
+ *
+ * Entries are fetched through SYS_DIR_READDIR_BATCH in 64 KiB
+ * buffers -- one IPC per ~1000 entries instead of one per entry --
+ * and veridian_readdir_plus() opts into stat attributes piggybacked
+ * on each record, so a directory walk that lists and stats costs two
+ * orders of magnitude fewer syscalls on large trees.  Kernels
+ * without the batch call drop back to the per-entry syscall
+ * transparently.
  */
 
 #include <dirent.h>
@@ -18,10 +26,22 @@
 /* Internal DIR structure                                                    */
 /* ========================================================================= */
 
+#define DIR_BUF_SIZE (64 * 1024)
+
 struct _DIR {
     int             fd;         /* Kernel directory descriptor */
     struct dirent   entry;      /* Buffer for the current entry */
     int             eof;        /* Non-zero after end-of-directory */
+
+    /* Batched mode: packed records served from one wide buffer */
+    int             batch;      /* 0 untested, 1 active, -1 unsupported */
+    char           *buf;
+    size_t          buf_len;    /* Valid bytes in buf */
+    size_t          buf_off;    /* Next record offset */
+
+    /* Stat block of the record readdir() most recently returned */
+    struct stat     cur_st;
+    int             cur_has_stat;
 };
 
 /* ========================================================================= */
@@ -37,6 +57,129 @@ static inline long __syscall_ret(long r)
     return r;
 }
 
+/* ========================================================================= */
+/* Batched refill                                                            */
+/* ========================================================================= */
+
+/*
+ * Pull the next 64 KiB of records.  Returns 1 with records buffered,
+ * 0 at end-of-directory, -1 when the kernel lacks the batch call
+ * (caller reverts to per-entry mode).
+ */
+static int dir_refill(DIR *dirp, int want_stat)
+{
+    long ret;
+
+    if (!dirp->buf) {
+        dirp->buf = (char *)malloc(DIR_BUF_SIZE);
+        if (!dirp->buf)
+            return -1;
+    }
+
+    ret = veridian_syscall4(SYS_DIR_READDIR_BATCH, dirp->fd, dirp->buf,
+                            DIR_BUF_SIZE,
+                            want_stat ? VERIDIAN_RDDIR_STAT : 0);
+    if (ret == -ENOSYS)
+        return -1;
+    if (ret <= 0) {
+        if (ret < 0)
+            errno = (int)(-ret);
+        return 0;
+    }
+    dirp->buf_len = (size_t)ret;
+    dirp->buf_off = 0;
+    return 1;
+}
+
+/* Next record from the buffer, refilling as needed; NULL at EOF */
+static struct veridian_dirent_rec *dir_next_rec(DIR *dirp, int want_stat)
+{
+    for (;;) {
+        struct veridian_dirent_rec *rec;
+
+        if (dirp->buf_off + sizeof(*rec) > dirp->buf_len) {
+            int r = dir_refill(dirp, want_stat);
+
+            if (r < 0) {
+                dirp->batch = -1;
+                return NULL;
+            }
+            if (r == 0) {
+                dirp->eof = 1;
+                return NULL;
+            }
+        }
+        rec = (struct veridian_dirent_rec *)(dirp->buf + dirp->buf_off);
+        if (rec->reclen < sizeof(*rec) + 2 ||
+            dirp->buf_off + rec->reclen > dirp->buf_len) {
+            /* Malformed stream: stop rather than walk off the end */
+            dirp->eof = 1;
+            return NULL;
+        }
+        dirp->batch = 1;
+        dirp->buf_off += rec->reclen;
+        return rec;
+    }
+}
+
+/* Legacy one-entry-per-syscall path */
+static struct dirent *readdir_single(DIR *dirp)
+{
+    long ret = veridian_syscall3(SYS_DIR_READDIR, dirp->fd, &dirp->entry,
+                                 sizeof(struct dirent));
+    if (ret < 0) {
+        if (ret == -ENOENT || ret == 0) {
+            dirp->eof = 1;
+            return NULL;
+        }
+        errno = (int)(-ret);
+        return NULL;
+    }
+
+    if (dirp->entry.d_name[0] == '\0') {
+        dirp->eof = 1;
+        return NULL;
+    }
+    return &dirp->entry;
+}
+
+static struct dirent *readdir_common(DIR *dirp, int want_stat)
+{
+    if (!dirp) {
+        errno = EINVAL;
+        return NULL;
+    }
+    if (dirp->eof)
+        return NULL;
+
+    dirp->cur_has_stat = 0;
+
+    if (dirp->batch >= 0) {
+        struct veridian_dirent_rec *rec = dir_next_rec(dirp, want_stat);
+
+        if (rec) {
+            size_t nlen = strlen(rec->d_name);
+
+            if (nlen > NAME_MAX)
+                nlen = NAME_MAX;
+            dirp->entry.d_ino = rec->d_ino;
+            dirp->entry.d_type = rec->d_type;
+            memcpy(dirp->entry.d_name, rec->d_name, nlen);
+            dirp->entry.d_name[nlen] = '\0';
+            if (rec->has_stat) {
+                dirp->cur_st = rec->st;
+                dirp->cur_has_stat = 1;
+            }
+            return &dirp->entry;
+        }
+        if (dirp->batch != -1 || dirp->eof)
+            return NULL;
+        /* Batch unsupported: fall through to the per-entry path */
+    }
+
+    return readdir_single(dirp);
+}
+
 /* ========================================================================= */
 /* Public API                                                                */
 /* ========================================================================= */
@@ -61,46 +204,29 @@ DIR *opendir(const char *name)
         return NULL;
     }
 
-    dirp->fd  = (int)fd;
-    dirp->eof = 0;
-    memset(&dirp->entry, 0, sizeof(dirp->entry));
+    memset(dirp, 0, sizeof(*dirp));
+    dirp->fd = (int)fd;
     return dirp;
 }
 
 struct dirent *readdir(DIR *dirp)
 {
-    if (!dirp) {
-        errno = EINVAL;
-        return NULL;
-    }
-
-    if (dirp->eof)
-        return NULL;
+    return readdir_common(dirp, 0);
+}
 
-    /*
-     * The kernel's SYS_DIR_READDIR returns a dirent-compatible structure
-     * into the user-supplied buffer.  Returns 0 on success with data,
-     * -ENOENT at end-of-directory, or a negative errno on error.
-     */
-    long ret = veridian_syscall3(SYS_DIR_READDIR, dirp->fd, &dirp->entry,
-                                sizeof(struct dirent));
-    if (ret < 0) {
-        if (ret == -ENOENT || ret == 0) {
-            /* End of directory */
-            dirp->eof = 1;
-            return NULL;
-        }
-        errno = (int)(-ret);
-        return NULL;
-    }
+struct dirent *veridian_readdir_plus(DIR *dirp, struct stat *st,
+                                     int *has_stat)
+{
+    struct dirent *de = readdir_common(dirp, 1);
 
-    /* ret == 0 with data means success */
-    if (dirp->entry.d_name[0] == '\0') {
-        dirp->eof = 1;
-        return NULL;
+    if (has_stat)
+        *has_stat = 0;
+    if (de && dirp->cur_has_stat && st) {
+        *st = dirp->cur_st;
+        if (has_stat)
+            *has_stat = 1;
     }
-
-    return &dirp->entry;
+    return de;
 }
 
 int closedir(DIR *dirp)
@@ -111,6 +237,7 @@ int closedir(DIR *dirp)
     }
 
     long ret = veridian_syscall1(SYS_DIR_CLOSEDIR, dirp->fd);
+    free(dirp->buf);
     free(dirp);
 
     if (ret < 0) {
@@ -128,13 +255,13 @@ void rewinddir(DIR *dirp)
     /*
      * Close and re-open: the kernel doesn't have a rewinddir syscall,
      * so we simulate by noting we need to re-read from the start.
-     * For now, just reset the EOF flag — the kernel will restart
-     * enumeration on the next readdir call after a closedir+opendir.
-     *
-     * Simplified: just reset state. The kernel directory handle
-     * maintains its own position.
+     * The kernel directory handle maintains its own position.
      */
     dirp->eof = 0;
+    dirp->buf_len = 0;
+    dirp->buf_off = 0;
+    if (dirp->batch == 1)
+        dirp->batch = 0;
 }
 
 int dirfd(DIR *dirp)
@@ -12,8 +12,45 @@
 #include <EGL/egl.h>
 #include <EGL/eglext.h>
 #include <gbm.h>
+#include <stdint.h>
 #include <string.h>
 
+/* ========================================================================= */
+/* libwayland bindings (userland/libwayland)                                 */
+/* ========================================================================= */
+
+/*
+ * The SYS_WL buffer path lives in userland/libwayland; the shim links
+ * against it and declares the handful of entry points it needs here
+ * (the libc tree does not include headers from sibling modules).
+ */
+typedef struct wl_surface wl_surface;
+typedef struct wl_buffer wl_buffer;
+typedef struct wl_swapchain wl_swapchain;
+
+extern void wl_surface_attach(wl_surface *surface, wl_buffer *buffer,
+                              int32_t x, int32_t y);
+extern void wl_surface_damage(wl_surface *surface, int32_t x, int32_t y,
+                              int32_t width, int32_t height);
+extern void wl_surface_commit(wl_surface *surface);
+extern uint32_t wl_buffer_get_age(const wl_buffer *buffer);
+extern wl_buffer *wl_swapchain_acquire(wl_swapchain *chain);
+
+/*
+ * Native window handle Wayland EGL clients hand to
+ * eglCreateWindowSurface: the surface plus the swapchain backing it.
+ */
+struct wl_egl_window {
+    wl_surface   *surface;
+    wl_swapchain *swapchain;
+    int32_t       width;
+    int32_t       height;
+};
+
+#ifndef EGL_BUFFER_AGE_EXT
+#define EGL_BUFFER_AGE_EXT 0x313D
+#endif
+
 /* ========================================================================= */
 /* Internal structures                                                       */
 /* ========================================================================= */
@@ -54,6 +91,11 @@ struct egl_surface {
     EGLint        height;
     void         *native_window;   /* gbm_surface * or wl_egl_window * */
     struct egl_config *config;
+
+    /* Wayland swap state: the buffer the client renders into next,
+     * acquired from the window's swapchain.  Its age drives
+     * EGL_EXT_buffer_age. */
+    wl_buffer    *back_buffer;
 };
 
 struct egl_image {
@@ -594,9 +636,22 @@ EGLSurface eglCreateWindowSurface(EGLDisplay dpy, EGLConfig config,
     surf->type          = 0; /* window */
     surf->native_window = (void *)win;
     surf->config        = (struct egl_config *)config;
+    surf->back_buffer   = NULL;
     surf->width         = 0;
     surf->height        = 0;
 
+    /* Wayland window: adopt its geometry and acquire the first back
+     * buffer from the swapchain so buffer age is queryable before the
+     * first swap (it reports 0 = undefined, full repaint) */
+    if (win) {
+        struct wl_egl_window *w = (struct wl_egl_window *)win;
+
+        surf->width = w->width;
+        surf->height = w->height;
+        if (w->swapchain)
+            surf->back_buffer = wl_swapchain_acquire(w->swapchain);
+    }
+
     set_error(EGL_SUCCESS);
     return (EGLSurface)surf;
 }
@@ -698,20 +753,8 @@ EGLBoolean eglMakeCurrent(EGLDisplay dpy, EGLSurface draw,
 
 EGLBoolean eglSwapBuffers(EGLDisplay dpy, EGLSurface surface)
 {
-    struct egl_display *d = get_initialized_display(dpy);
-
-    if (!d) return EGL_FALSE;
-
-    (void)surface;
-
-    /*
-     * In a full implementation, this would trigger a page flip via DRM
-     * and swap the GBM surface buffers. For the shim, this is a no-op
-     * that always succeeds.
-     */
-
-    set_error(EGL_SUCCESS);
-    return EGL_TRUE;
+    /* A plain swap is full-surface damage */
+    return eglSwapBuffersWithDamageEXT(dpy, surface, NULL, 0);
 }
 
 EGLBoolean eglSwapInterval(EGLDisplay dpy, EGLint interval)
@@ -783,6 +826,15 @@ EGLBoolean eglQuerySurface(EGLDisplay dpy, EGLSurface surface,
     case EGL_CONFIG_ID:      *value = s->config ? s->config->id : 0; break;
     case EGL_RENDER_BUFFER:  *value = EGL_BACK_BUFFER;             break;
     case EGL_SWAP_BEHAVIOR:  *value = EGL_BUFFER_DESTROYED;        break;
+    case EGL_BUFFER_AGE_EXT:
+        /* Frames since this buffer's content was current: 0 means
+         * undefined (never presented), 1 the previous frame, etc.
+         * Clients repaint only the damage accumulated over that many
+         * frames. */
+        *value = (s->back_buffer)
+                     ? (EGLint)wl_buffer_get_age(s->back_buffer)
+                     : 0;
+        break;
     default:
         set_error(EGL_BAD_ATTRIBUTE);
         return EGL_FALSE;
@@ -914,7 +966,13 @@ struct egl_proc_entry {
     void       (*func)(void);
 };
 
+/* Veridian extension implemented by the GLES shim: points the tiled
+ * software rasterizer at a CPU-visible surface */
+extern void glVeridianSetRenderTarget(void *pixels, EGLint width,
+                                      EGLint height, EGLint stride_bytes);
+
 static const struct egl_proc_entry g_proc_table[] = {
+    { "glVeridianSetRenderTarget",    (void(*)(void))glVeridianSetRenderTarget },
     { "eglCreateImageKHR",            (void(*)(void))egl_create_image_khr },
     { "eglDestroyImageKHR",           (void(*)(void))egl_destroy_image_khr },
     { "eglSwapBuffersWithDamageEXT",  (void(*)(void))egl_swap_buffers_with_damage },
@@ -1035,11 +1093,60 @@ static EGLBoolean egl_swap_buffers_with_damage(EGLDisplay dpy,
                                                 const EGLint *rects,
                                                 EGLint n_rects)
 {
-    (void)rects;
-    (void)n_rects;
+    struct egl_display *d = get_initialized_display(dpy);
+    struct egl_surface *s = (struct egl_surface *)surface;
+    struct wl_egl_window *win;
+
+    if (!d) return EGL_FALSE;
+
+    if (!s || !s->in_use || s->type != 0) {
+        set_error(EGL_BAD_SURFACE);
+        return EGL_FALSE;
+    }
+    if (n_rects < 0 || (n_rects > 0 && !rects)) {
+        set_error(EGL_BAD_PARAMETER);
+        return EGL_FALSE;
+    }
 
-    /* Damage tracking is a no-op; just do a regular swap */
-    return eglSwapBuffers(dpy, surface);
+    win = (struct wl_egl_window *)s->native_window;
+    if (!win || !win->surface) {
+        /* Non-Wayland window (GBM scanout): nothing to hand off */
+        set_error(EGL_SUCCESS);
+        return EGL_TRUE;
+    }
+
+    /*
+     * Post damage.  EGL rects are bottom-left origin; the Wayland
+     * surface is top-left, so flip Y.  No rects means the client
+     * could not track damage: the whole surface is dirty.
+     */
+    if (n_rects == 0) {
+        wl_surface_damage(win->surface, 0, 0, s->width, s->height);
+    } else {
+        EGLint i;
+
+        for (i = 0; i < n_rects; i++) {
+            EGLint x = rects[i * 4 + 0];
+            EGLint y = rects[i * 4 + 1];
+            EGLint w = rects[i * 4 + 2];
+            EGLint h = rects[i * 4 + 3];
+
+            if (w <= 0 || h <= 0)
+                continue;
+            wl_surface_damage(win->surface, x, s->height - y - h, w, h);
+        }
+    }
+
+    /* Hand the rendered buffer off and pick up the next one; its age
+     * tells the client how many frames of damage to repaint */
+    if (s->back_buffer)
+        wl_surface_attach(win->surface, s->back_buffer, 0, 0);
+    wl_surface_commit(win->surface);
+    if (win->swapchain)
+        s->back_buffer = wl_swapchain_acquire(win->swapchain);
+
+    set_error(EGL_SUCCESS);
+    return EGL_TRUE;
 }
 
 EGLBoolean eglSwapBuffersWithDamageEXT(EGLDisplay dpy, EGLSurface surface,
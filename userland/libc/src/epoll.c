@@ -16,6 +16,7 @@
 #define SYS_EPOLL_CREATE  262
 #define SYS_EPOLL_CTL     263
 #define SYS_EPOLL_WAIT    264
+#define SYS_EPOLL_PWAIT2  363
 
 /*
  * Translate raw syscall return to POSIX convention.
@@ -52,6 +53,8 @@ int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event)
     return __epoll_ret(ret);
 }
 
+extern void __pthread_cancel_point(void);
+
 int epoll_wait(int epfd, struct epoll_event *events,
                int maxevents, int timeout)
 {
@@ -59,7 +62,51 @@ int epoll_wait(int epfd, struct epoll_event *events,
         errno = EINVAL;
         return -1;
     }
+    __pthread_cancel_point();
     long ret = veridian_syscall4(SYS_EPOLL_WAIT, epfd, events,
                                   maxevents, timeout);
+    if (ret == -EINTR)
+        __pthread_cancel_point();
     return __epoll_ret(ret);
 }
+
+/*
+ * Nanosecond-resolution wait (VeridianOS epoll_pwait2).  Kernels
+ * without SYS_EPOLL_PWAIT2 round the timeout up to the next
+ * millisecond -- never down, so sub-ms waits don't busy-spin.
+ */
+int epoll_pwait2(int epfd, struct epoll_event *events, int maxevents,
+                 const struct timespec *timeout, const void *sigmask)
+{
+    static int no_pwait2;
+    long ret;
+
+    (void)sigmask;      /* Signal masks not wired yet, as epoll_wait */
+    if (maxevents <= 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    if (!no_pwait2) {
+        __pthread_cancel_point();
+        ret = veridian_syscall4(SYS_EPOLL_PWAIT2, epfd, events,
+                                maxevents, timeout);
+        if (ret == -EINTR)
+            __pthread_cancel_point();
+        if (ret != -ENOSYS)
+            return __epoll_ret(ret);
+        no_pwait2 = 1;
+    }
+
+    {
+        int ms = -1;
+
+        if (timeout) {
+            long long total = (long long)timeout->tv_sec * 1000 +
+                              (timeout->tv_nsec + 999999) / 1000000;
+
+            ms = total > 0x7fffffff ? 0x7fffffff : (int)total;
+        }
+        return epoll_wait(epfd, events, maxevents, ms);
+    }
+}
@@ -4,16 +4,29 @@
  * Copyright (c) 2025-2026 VeridianOS Contributors
  * SPDX-License-Identifier: MIT OR Apache-2.0
  *
- * Global errno variable and accessor function.
+ * Per-thread errno.
  *
- * Currently a single global (no TLS).  When VeridianOS gains thread-local
- * storage support, __veridian_errno_location() should return a per-thread
- * pointer instead.
+ * Every thread's control block sits at the thread pointer with errno
+ * in a fixed slot (see struct pthread_control in pthread.c), so the
+ * accessor is one thread-pointer-relative load.  The pre-TLS window
+ * (before the loader or pthread arms the thread pointer) falls back
+ * to a process-global slot.
  */
 
 #include <errno.h>
+#include <stddef.h>
 
-/* The actual storage for errno. */
+#include "veridian_tcb.h"
+
+/* The layout contract lives in veridian_tcb.h; pin it here so a
+ * drift is a compile error */
+_Static_assert(offsetof(struct __veridian_tcb_head, self) == 0,
+               "TLS ABI: self pointer must sit at the thread pointer");
+_Static_assert(offsetof(struct __veridian_tcb_head, errno_val) ==
+                   sizeof(void *),
+               "errno slot must directly follow the self pointer");
+
+/* Fallback for the window before any TCB is armed. */
 static int __errno_val = 0;
 
 /*
@@ -22,5 +35,9 @@ static int __errno_val = 0;
  */
 int *__veridian_errno_location(void)
 {
+    struct __veridian_tcb_head *tcb = __builtin_thread_pointer();
+
+    if (tcb && tcb->self == (void *)tcb)
+        return &tcb->errno_val;
     return &__errno_val;
 }
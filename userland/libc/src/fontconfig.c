@@ -13,8 +13,16 @@
 #include <fontconfig/fontconfig.h>
 #include <fontconfig/fcfreetype.h>
 #include <string.h>
+#include <strings.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
 
 /* ========================================================================= */
 /* Internal limits                                                           */
@@ -52,9 +60,8 @@ struct fc_pattern_internal {
 
 struct fc_fontset_internal {
     int              in_use;
+    FcFontSet        set;       /* public view handed to clients */
     FcPattern       *fonts[64];
-    int              nfont;
-    int              sfont;
 };
 
 struct fc_objectset_internal {
@@ -137,6 +144,635 @@ static struct fc_prop *add_prop(struct fc_pattern_internal *pi,
     return p;
 }
 
+/* ========================================================================= */
+/* Binary font database cache                                                */
+/* ========================================================================= */
+
+/*
+ * On-disk pattern database, mmap'd read-only so all processes share
+ * the same pages (upstream's .cache-* equivalent).  Built once by the
+ * first process that finds the cache missing or stale; invalidated by
+ * font directory mtimes.
+ *
+ * Layout: header, dir records, font records, string pool.  All
+ * record fields are fixed width; strings are offsets into the pool.
+ */
+
+#define FC_CACHE_MAGIC     "VdFcCach"
+#define FC_CACHE_VERSION   1
+#define FC_CACHE_PATH      "/var/cache/fontconfig/veridian.cache"
+#define FC_CACHE_MAX_POOL  (16u * 1024 * 1024)
+
+#define FC_DB_MAX_DIRS     32
+#define FC_DB_MAX_FONTS    256
+#define FC_DB_MAX_DEPTH     4
+
+struct fc_cache_header {
+    char     magic[8];
+    uint32_t version;
+    uint32_t ndirs;
+    uint32_t nfonts;
+    uint32_t strpool_len;
+};
+
+struct fc_cache_dir {
+    int64_t  mtime;
+    uint32_t path_off;
+    uint32_t pad;
+};
+
+struct fc_cache_font {
+    uint32_t file_off;
+    uint32_t family_off;
+    uint32_t style_off;
+    int32_t  weight;
+    int32_t  slant;
+    int32_t  spacing;
+};
+
+/* Mapped (or heap-built) database */
+static const struct fc_cache_header *g_fcdb;
+static size_t                        g_fcdb_len;
+static int                           g_fcdb_mapped;
+
+/* Scan roots, in priority order */
+static const char *const g_font_roots[] = {
+    "/usr/share/fonts",
+    "/usr/local/share/fonts",
+};
+
+static const struct fc_cache_dir *fcdb_dirs(void)
+{
+    return (const struct fc_cache_dir *)(g_fcdb + 1);
+}
+
+static const struct fc_cache_font *fcdb_fonts(void)
+{
+    return (const struct fc_cache_font *)(fcdb_dirs() + g_fcdb->ndirs);
+}
+
+static const char *fcdb_str(uint32_t off)
+{
+    return (const char *)(fcdb_fonts() + g_fcdb->nfonts) + off;
+}
+
+/* Case-insensitive substring search (no strcasestr in this libc) */
+static const char *fc_strcasestr(const char *haystack, const char *needle)
+{
+    size_t nlen = strlen(needle);
+
+    if (nlen == 0)
+        return haystack;
+    for (; *haystack; haystack++) {
+        if (strncasecmp(haystack, needle, nlen) == 0)
+            return haystack;
+    }
+    return NULL;
+}
+
+/* ----- TTF probing (sfnt name/post tables) ----- */
+
+static uint16_t fc_be16(const unsigned char *p)
+{
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static uint32_t fc_be32(const unsigned char *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+           ((uint32_t)p[2] << 8)  |  (uint32_t)p[3];
+}
+
+/* Copy one name-table entry, folding UTF-16BE to Latin-1 */
+static void fc_copy_name(char *dst, size_t dst_sz,
+                            const unsigned char *src, unsigned int len,
+                            int utf16)
+{
+    size_t o = 0;
+    unsigned int i;
+
+    if (utf16) {
+        for (i = 0; i + 1 < len && o < dst_sz - 1; i += 2) {
+            if (src[i] == 0 && src[i + 1] >= 0x20)
+                dst[o++] = (char)src[i + 1];
+        }
+    } else {
+        for (i = 0; i < len && o < dst_sz - 1; i++) {
+            if (src[i] >= 0x20)
+                dst[o++] = (char)src[i];
+        }
+    }
+    dst[o] = '\0';
+}
+
+/* Read family/style/spacing out of a TTF's name and post tables.
+ * Returns 0 on success; family falls back to the file name. */
+static int fc_probe_font(const char *path, char *family, size_t fam_sz,
+                            char *style, size_t sty_sz, int *spacing)
+{
+    unsigned char hdr[12], dir[16 * 32], tbl[4096];
+    unsigned long name_off = 0, name_len = 0;
+    unsigned long post_off = 0, post_len = 0;
+    unsigned int ntables, i;
+    int fd, got_family = 0;
+
+    family[0] = '\0';
+    style[0]  = '\0';
+    *spacing  = FC_PROPORTIONAL;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return -1;
+
+    if (read(fd, hdr, 12) != 12 ||
+        (fc_be32(hdr) != 0x00010000UL && fc_be32(hdr) != 0x74727565UL)) {
+        close(fd);
+        return -1;
+    }
+
+    ntables = fc_be16(hdr + 4);
+    if (ntables > 32)
+        ntables = 32;
+    if (read(fd, dir, 16 * ntables) != (ssize_t)(16 * ntables)) {
+        close(fd);
+        return -1;
+    }
+
+    for (i = 0; i < ntables; i++) {
+        const unsigned char *rec = dir + 16 * i;
+
+        if (memcmp(rec, "name", 4) == 0) {
+            name_off = fc_be32(rec + 8);
+            name_len = fc_be32(rec + 12);
+        } else if (memcmp(rec, "post", 4) == 0) {
+            post_off = fc_be32(rec + 8);
+            post_len = fc_be32(rec + 12);
+        }
+    }
+
+    if (name_off && name_len >= 6) {
+        unsigned long want = name_len < sizeof(tbl) ? name_len : sizeof(tbl);
+
+        if (lseek(fd, (off_t)name_off, SEEK_SET) == (off_t)name_off &&
+            read(fd, tbl, want) == (ssize_t)want) {
+            unsigned int nrec = fc_be16(tbl + 2);
+            unsigned long str_base = fc_be16(tbl + 4);
+
+            for (i = 0; i < nrec && 6 + 12UL * (i + 1) <= want; i++) {
+                const unsigned char *nr = tbl + 6 + 12 * i;
+                unsigned int plat = fc_be16(nr);
+                unsigned int nid  = fc_be16(nr + 6);
+                unsigned int len  = fc_be16(nr + 8);
+                unsigned long off = str_base + fc_be16(nr + 10);
+                int utf16 = plat == 3 || plat == 0;
+
+                if (nid != 1 && nid != 2)
+                    continue;
+                if (off + len > want)
+                    continue;
+                /* Prefer Windows Unicode names over Mac Roman */
+                if (nid == 1 && (!got_family || plat == 3)) {
+                    fc_copy_name(family, fam_sz, tbl + off, len, utf16);
+                    got_family = plat == 3 ? 2 : 1;
+                } else if (nid == 2 && style[0] == '\0') {
+                    fc_copy_name(style, sty_sz, tbl + off, len, utf16);
+                }
+            }
+        }
+    }
+
+    if (post_off && post_len >= 16) {
+        if (lseek(fd, (off_t)post_off, SEEK_SET) == (off_t)post_off &&
+            read(fd, tbl, 16) == 16 && fc_be32(tbl + 12) != 0)
+            *spacing = FC_MONO;
+    }
+
+    close(fd);
+
+    if (family[0] == '\0') {
+        const char *base = strrchr(path, '/');
+        const char *dot;
+        size_t n;
+
+        base = base ? base + 1 : path;
+        dot = strrchr(base, '.');
+        n = dot ? (size_t)(dot - base) : strlen(base);
+        if (n >= fam_sz)
+            n = fam_sz - 1;
+        memcpy(family, base, n);
+        family[n] = '\0';
+    }
+    if (style[0] == '\0')
+        strncpy(style, "Regular", sty_sz - 1);
+
+    return 0;
+}
+
+static int fc_style_weight(const char *style)
+{
+    return fc_strcasestr(style, "bold") ? FC_WEIGHT_BOLD
+                                        : FC_WEIGHT_REGULAR;
+}
+
+static int fc_style_slant(const char *style)
+{
+    if (fc_strcasestr(style, "italic"))
+        return FC_SLANT_ITALIC;
+    if (fc_strcasestr(style, "oblique"))
+        return FC_SLANT_OBLIQUE;
+    return FC_SLANT_ROMAN;
+}
+
+/* ----- Scanning ----- */
+
+struct fc_db_builder {
+    struct {
+        char    path[224];
+        int64_t mtime;
+    } dirs[FC_DB_MAX_DIRS];
+    unsigned int ndirs;
+
+    struct {
+        char file[224];
+        char family[64];
+        char style[48];
+        int  weight, slant, spacing;
+    } fonts[FC_DB_MAX_FONTS];
+    unsigned int nfonts;
+};
+
+static int fc_has_suffix(const char *name, const char *suffix)
+{
+    size_t nl = strlen(name), sl = strlen(suffix);
+
+    return nl >= sl && strcasecmp(name + nl - sl, suffix) == 0;
+}
+
+static void fc_scan_dir(struct fc_db_builder *bd, const char *path,
+                           int depth)
+{
+    struct stat st;
+    struct dirent *de;
+    DIR *d;
+
+    if (bd->ndirs >= FC_DB_MAX_DIRS)
+        return;
+    if (stat(path, &st) != 0 || !S_ISDIR(st.st_mode))
+        return;
+
+    strncpy(bd->dirs[bd->ndirs].path, path,
+            sizeof(bd->dirs[0].path) - 1);
+    bd->dirs[bd->ndirs].path[sizeof(bd->dirs[0].path) - 1] = '\0';
+    bd->dirs[bd->ndirs].mtime = (int64_t)st.st_mtime;
+    bd->ndirs++;
+
+    d = opendir(path);
+    if (!d)
+        return;
+
+    while ((de = readdir(d)) != NULL) {
+        char full[224];
+
+        if (de->d_name[0] == '.')
+            continue;
+        if ((size_t)snprintf(full, sizeof(full), "%s/%s",
+                             path, de->d_name) >= sizeof(full))
+            continue;
+
+        if (de->d_type == DT_DIR ||
+            (de->d_type == DT_UNKNOWN &&
+             stat(full, &st) == 0 && S_ISDIR(st.st_mode))) {
+            if (depth < FC_DB_MAX_DEPTH)
+                fc_scan_dir(bd, full, depth + 1);
+            continue;
+        }
+
+        if (bd->nfonts >= FC_DB_MAX_FONTS)
+            continue;
+        if (!fc_has_suffix(de->d_name, ".ttf"))
+            continue;
+
+        if (fc_probe_font(full,
+                          bd->fonts[bd->nfonts].family,
+                          sizeof(bd->fonts[0].family),
+                          bd->fonts[bd->nfonts].style,
+                          sizeof(bd->fonts[0].style),
+                          &bd->fonts[bd->nfonts].spacing) == 0) {
+            strncpy(bd->fonts[bd->nfonts].file, full,
+                    sizeof(bd->fonts[0].file) - 1);
+            bd->fonts[bd->nfonts].file[sizeof(bd->fonts[0].file) - 1] = '\0';
+            bd->fonts[bd->nfonts].weight =
+                fc_style_weight(bd->fonts[bd->nfonts].style);
+            bd->fonts[bd->nfonts].slant =
+                fc_style_slant(bd->fonts[bd->nfonts].style);
+            bd->nfonts++;
+        }
+    }
+
+    closedir(d);
+}
+
+/* ----- Serialization ----- */
+
+static uint32_t fc_pool_add(char *pool, uint32_t *len, const char *s)
+{
+    uint32_t off = *len;
+    size_t n = strlen(s) + 1;
+
+    memcpy(pool + off, s, n);
+    *len += (uint32_t)n;
+    return off;
+}
+
+/* Serialize the builder into a cache blob (malloc'd) */
+static void *fc_db_serialize(const struct fc_db_builder *bd, size_t *out_len)
+{
+    size_t pool_max = 0, blob_len;
+    struct fc_cache_header *h;
+    struct fc_cache_dir *dirs;
+    struct fc_cache_font *fonts;
+    char *pool;
+    uint32_t pool_len = 0;
+    unsigned int i;
+    void *blob;
+
+    for (i = 0; i < bd->ndirs; i++)
+        pool_max += strlen(bd->dirs[i].path) + 1;
+    for (i = 0; i < bd->nfonts; i++)
+        pool_max += strlen(bd->fonts[i].file) +
+                    strlen(bd->fonts[i].family) +
+                    strlen(bd->fonts[i].style) + 3;
+
+    blob_len = sizeof(*h) + bd->ndirs * sizeof(*dirs) +
+               bd->nfonts * sizeof(*fonts) + pool_max;
+    blob = malloc(blob_len);
+    if (!blob)
+        return NULL;
+
+    h     = (struct fc_cache_header *)blob;
+    dirs  = (struct fc_cache_dir *)(h + 1);
+    fonts = (struct fc_cache_font *)(dirs + bd->ndirs);
+    pool  = (char *)(fonts + bd->nfonts);
+
+    memcpy(h->magic, FC_CACHE_MAGIC, 8);
+    h->version = FC_CACHE_VERSION;
+    h->ndirs   = bd->ndirs;
+    h->nfonts  = bd->nfonts;
+
+    for (i = 0; i < bd->ndirs; i++) {
+        dirs[i].mtime    = bd->dirs[i].mtime;
+        dirs[i].path_off = fc_pool_add(pool, &pool_len, bd->dirs[i].path);
+        dirs[i].pad      = 0;
+    }
+    for (i = 0; i < bd->nfonts; i++) {
+        fonts[i].file_off   = fc_pool_add(pool, &pool_len,
+                                          bd->fonts[i].file);
+        fonts[i].family_off = fc_pool_add(pool, &pool_len,
+                                          bd->fonts[i].family);
+        fonts[i].style_off  = fc_pool_add(pool, &pool_len,
+                                          bd->fonts[i].style);
+        fonts[i].weight  = bd->fonts[i].weight;
+        fonts[i].slant   = bd->fonts[i].slant;
+        fonts[i].spacing = bd->fonts[i].spacing;
+    }
+
+    h->strpool_len = pool_len;
+    *out_len = sizeof(*h) + bd->ndirs * sizeof(*dirs) +
+               bd->nfonts * sizeof(*fonts) + pool_len;
+    return blob;
+}
+
+/* Write the blob where other processes can map it; failure is not an
+ * error (read-only filesystems just rebuild per process). */
+static void fc_db_persist(const void *blob, size_t len)
+{
+    char tmp[96];
+    ssize_t wr;
+    int fd;
+
+    mkdir("/var/cache", 0755);
+    mkdir("/var/cache/fontconfig", 0755);
+
+    /* Per-process temp name: concurrent cold starts must not tear
+     * each other's writes; rename() makes the final update atomic */
+    snprintf(tmp, sizeof(tmp), FC_CACHE_PATH ".%d", (int)getpid());
+
+    fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return;
+
+    wr = write(fd, blob, len);
+    close(fd);
+
+    if (wr == (ssize_t)len)
+        rename(tmp, FC_CACHE_PATH);
+    else
+        unlink(tmp);
+}
+
+/* ----- Validation and loading ----- */
+
+static int fc_db_validate(const struct fc_cache_header *h, size_t len)
+{
+    const struct fc_cache_dir *dirs;
+    const struct fc_cache_font *fonts;
+    const char *pool;
+    size_t need;
+    unsigned int i;
+
+    if (len < sizeof(*h) || memcmp(h->magic, FC_CACHE_MAGIC, 8) != 0 ||
+        h->version != FC_CACHE_VERSION)
+        return -1;
+    if (h->ndirs > FC_DB_MAX_DIRS || h->nfonts > FC_DB_MAX_FONTS ||
+        h->strpool_len == 0 || h->strpool_len > FC_CACHE_MAX_POOL)
+        return -1;
+
+    need = sizeof(*h) + h->ndirs * sizeof(*dirs) +
+           h->nfonts * sizeof(*fonts) + h->strpool_len;
+    if (need > len)
+        return -1;
+
+    dirs  = (const struct fc_cache_dir *)(h + 1);
+    fonts = (const struct fc_cache_font *)(dirs + h->ndirs);
+    pool  = (const char *)(fonts + h->nfonts);
+
+    if (pool[h->strpool_len - 1] != '\0')
+        return -1;
+    for (i = 0; i < h->ndirs; i++) {
+        if (dirs[i].path_off >= h->strpool_len)
+            return -1;
+    }
+    for (i = 0; i < h->nfonts; i++) {
+        if (fonts[i].file_off >= h->strpool_len ||
+            fonts[i].family_off >= h->strpool_len ||
+            fonts[i].style_off >= h->strpool_len)
+            return -1;
+    }
+    return 0;
+}
+
+/* Are the recorded directory mtimes still current? */
+static int fc_db_dirs_current(const struct fc_cache_header *h)
+{
+    const struct fc_cache_dir *dirs = (const struct fc_cache_dir *)(h + 1);
+    const struct fc_cache_font *fonts =
+        (const struct fc_cache_font *)(dirs + h->ndirs);
+    const char *pool = (const char *)(fonts + h->nfonts);
+    struct stat st;
+    unsigned int i;
+
+    for (i = 0; i < h->ndirs; i++) {
+        if (stat(pool + dirs[i].path_off, &st) != 0 ||
+            (int64_t)st.st_mtime != dirs[i].mtime)
+            return 0;
+    }
+    return 1;
+}
+
+static int fc_db_try_load(void)
+{
+    struct stat st;
+    void *p;
+    int fd;
+
+    fd = open(FC_CACHE_PATH, O_RDONLY);
+    if (fd < 0)
+        return -1;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(struct fc_cache_header)) {
+        close(fd);
+        return -1;
+    }
+
+    p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED)
+        return -1;
+
+    if (fc_db_validate((const struct fc_cache_header *)p,
+                       (size_t)st.st_size) != 0 ||
+        !fc_db_dirs_current((const struct fc_cache_header *)p)) {
+        munmap(p, (size_t)st.st_size);
+        return -1;
+    }
+
+    g_fcdb        = (const struct fc_cache_header *)p;
+    g_fcdb_len    = (size_t)st.st_size;
+    g_fcdb_mapped = 1;
+    return 0;
+}
+
+static void fc_db_build(void)
+{
+    struct fc_db_builder *bd;
+    size_t len = 0;
+    void *blob;
+    unsigned int i;
+
+    bd = calloc(1, sizeof(*bd));
+    if (!bd)
+        return;
+
+    for (i = 0; i < sizeof(g_font_roots) / sizeof(g_font_roots[0]); i++)
+        fc_scan_dir(bd, g_font_roots[i], 0);
+
+    if (bd->nfonts == 0) {
+        free(bd);
+        return;
+    }
+
+    blob = fc_db_serialize(bd, &len);
+    free(bd);
+    if (!blob)
+        return;
+
+    fc_db_persist(blob, len);
+
+    g_fcdb        = (const struct fc_cache_header *)blob;
+    g_fcdb_len    = len;
+    g_fcdb_mapped = 0;
+}
+
+static void fc_db_init(void)
+{
+    if (g_fcdb)
+        return;
+    if (fc_db_try_load() != 0)
+        fc_db_build();
+}
+
+static void fc_db_release(void)
+{
+    if (!g_fcdb)
+        return;
+    if (g_fcdb_mapped)
+        munmap((void *)g_fcdb, g_fcdb_len);
+    else
+        free((void *)g_fcdb);
+    g_fcdb        = NULL;
+    g_fcdb_len    = 0;
+    g_fcdb_mapped = 0;
+}
+
+/* ----- Matching ----- */
+
+/* Family-name affinity: exact > generic alias > substring */
+static int fc_family_score(const struct fc_cache_font *f,
+                              const char *family)
+{
+    const char *fam = fcdb_str(f->family_off);
+
+    if (strcasecmp(fam, family) == 0)
+        return 3;
+
+    if (strcasecmp(family, "monospace") == 0 ||
+        strcasecmp(family, "mono") == 0)
+        return f->spacing == FC_MONO ? 3 : 0;
+    if (strcasecmp(family, "sans-serif") == 0 ||
+        strcasecmp(family, "sans") == 0)
+        return (fc_strcasestr(fam, "sans") &&
+                f->spacing != FC_MONO) ? 3 : 0;
+    if (strcasecmp(family, "serif") == 0)
+        return (fc_strcasestr(fam, "serif") &&
+                !fc_strcasestr(fam, "sans") &&
+                f->spacing != FC_MONO) ? 3 : 0;
+
+    if (fc_strcasestr(fam, family) || fc_strcasestr(family, fam))
+        return 1;
+    return 0;
+}
+
+static const struct fc_cache_font *fc_db_match(const char *family,
+                                                  int weight, int slant)
+{
+    const struct fc_cache_font *best = NULL;
+    int best_score = 0;
+    unsigned int i;
+
+    if (!g_fcdb)
+        return NULL;
+
+    for (i = 0; i < g_fcdb->nfonts; i++) {
+        const struct fc_cache_font *f = fcdb_fonts() + i;
+        int fam = fc_family_score(f, family);
+        int score;
+
+        if (fam == 0)
+            continue;
+
+        score = fam * 1000;
+        score -= f->weight > weight ? f->weight - weight
+                                    : weight - f->weight;
+        if (f->slant != slant)
+            score -= 100;
+
+        if (score > best_score) {
+            best_score = score;
+            best = f;
+        }
+    }
+    return best;
+}
+
 /* ========================================================================= */
 /* Init / Config                                                             */
 /* ========================================================================= */
@@ -145,6 +781,7 @@ FcBool FcInit(void)
 {
     g_fc_initialized    = 1;
     g_config.initialized = 1;
+    fc_db_init();
     return FcTrue;
 }
 
@@ -152,6 +789,7 @@ void FcFini(void)
 {
     g_fc_initialized    = 0;
     g_config.initialized = 0;
+    fc_db_release();
 }
 
 int FcGetVersion(void)
@@ -169,6 +807,9 @@ FcConfig *FcConfigGetCurrent(void)
 FcBool FcConfigUptoDate(FcConfig *config)
 {
     (void)config;
+
+    if (g_fcdb && !fc_db_dirs_current(g_fcdb))
+        return FcFalse;
     return FcTrue;
 }
 
@@ -564,6 +1205,43 @@ FcPattern *FcFontMatch(FcConfig *config, FcPattern *p, FcResult *result)
     if (FcPatternGetString(p, FC_FAMILY, 0, &family) != FcResultMatch)
         family = NULL;
 
+    /* Scanned database first; hardcoded defaults only without one */
+    if (g_fcdb) {
+        const struct fc_cache_font *f;
+        int weight = FC_WEIGHT_REGULAR, slant = FC_SLANT_ROMAN;
+        int ival;
+
+        if (FcPatternGetInteger(p, FC_WEIGHT, 0, &ival) == FcResultMatch)
+            weight = ival;
+        if (FcPatternGetInteger(p, FC_SLANT, 0, &ival) == FcResultMatch)
+            slant = ival;
+
+        f = fc_db_match(family ? (const char *)family : "sans", weight,
+                        slant);
+        if (!f && family)
+            f = fc_db_match("sans", weight, slant);
+
+        if (f) {
+            FcPatternAddString(match, FC_FILE,
+                (const FcChar8 *)fcdb_str(f->file_off));
+            FcPatternAddString(match, FC_FAMILY,
+                (const FcChar8 *)fcdb_str(f->family_off));
+            FcPatternAddString(match, FC_STYLE,
+                (const FcChar8 *)fcdb_str(f->style_off));
+            FcPatternAddInteger(match, FC_WEIGHT, f->weight);
+            FcPatternAddInteger(match, FC_SLANT, f->slant);
+            FcPatternAddInteger(match, FC_SPACING, f->spacing);
+            FcPatternAddInteger(match, FC_INDEX, 0);
+            FcPatternAddBool(match, FC_SCALABLE, FcTrue);
+            FcPatternAddBool(match, FC_OUTLINE, FcTrue);
+            FcPatternAddString(match, FC_FONTFORMAT,
+                (const FcChar8 *)"TrueType");
+
+            if (result) *result = FcResultMatch;
+            return match;
+        }
+    }
+
     /* Add file path based on requested family */
     if (family) {
         if (strstr((const char *)family, "Mono") ||
@@ -604,11 +1282,36 @@ FcPattern *FcFontMatch(FcConfig *config, FcPattern *p, FcResult *result)
     return match;
 }
 
+/* Build a pattern describing one database font */
+static FcPattern *fc_db_pattern(const struct fc_cache_font *f)
+{
+    FcPattern *pat = FcPatternCreate();
+
+    if (!pat)
+        return NULL;
+
+    FcPatternAddString(pat, FC_FILE,
+        (const FcChar8 *)fcdb_str(f->file_off));
+    FcPatternAddString(pat, FC_FAMILY,
+        (const FcChar8 *)fcdb_str(f->family_off));
+    FcPatternAddString(pat, FC_STYLE,
+        (const FcChar8 *)fcdb_str(f->style_off));
+    FcPatternAddInteger(pat, FC_WEIGHT, f->weight);
+    FcPatternAddInteger(pat, FC_SLANT, f->slant);
+    FcPatternAddInteger(pat, FC_SPACING, f->spacing);
+    FcPatternAddInteger(pat, FC_INDEX, 0);
+    FcPatternAddBool(pat, FC_SCALABLE, FcTrue);
+    FcPatternAddBool(pat, FC_OUTLINE, FcTrue);
+    FcPatternAddString(pat, FC_FONTFORMAT, (const FcChar8 *)"TrueType");
+    return pat;
+}
+
 FcFontSet *FcFontSort(FcConfig *config, FcPattern *p, FcBool trim,
                          FcCharSet **csp, FcResult *result)
 {
     FcFontSet *fs;
     FcPattern *match;
+    FcChar8 *match_file = NULL;
 
     (void)config;
     (void)trim;
@@ -621,8 +1324,32 @@ FcFontSet *FcFontSort(FcConfig *config, FcPattern *p, FcBool trim,
     }
 
     match = FcFontMatch(NULL, p, result);
-    if (match)
+    if (match) {
         FcFontSetAdd(fs, match);
+        FcPatternGetString(match, FC_FILE, 0, &match_file);
+    }
+
+    /* Remaining database fonts follow as fallbacks */
+    if (g_fcdb) {
+        unsigned int i;
+
+        for (i = 0; i < g_fcdb->nfonts; i++) {
+            const struct fc_cache_font *f = fcdb_fonts() + i;
+            FcPattern *pat;
+
+            if (match_file &&
+                strcmp((const char *)match_file,
+                       fcdb_str(f->file_off)) == 0)
+                continue;
+
+            pat = fc_db_pattern(f);
+            if (!pat || !FcFontSetAdd(fs, pat)) {
+                if (pat)
+                    FcPatternDestroy(pat);
+                break;
+            }
+        }
+    }
 
     return fs;
 }
@@ -639,6 +1366,23 @@ FcFontSet *FcFontList(FcConfig *config, FcPattern *p, FcObjectSet *os)
     fs = FcFontSetCreate();
     if (!fs) return NULL;
 
+    /* List the scanned database when there is one */
+    if (g_fcdb) {
+        unsigned int i;
+
+        for (i = 0; i < g_fcdb->nfonts; i++) {
+            FcPattern *pat = fc_db_pattern(fcdb_fonts() + i);
+
+            if (!pat || !FcFontSetAdd(fs, pat)) {
+                if (pat)
+                    FcPatternDestroy(pat);
+                break;
+            }
+        }
+        if (fs->nfont > 0)
+            return fs;
+    }
+
     match = FcFontMatch(NULL, p, &result);
     if (match)
         FcFontSetAdd(fs, match);
@@ -656,12 +1400,10 @@ FcFontSet *FcFontSetCreate(void)
     for (i = 0; i < MAX_FONTSETS; i++) {
         if (!g_fontsets[i].in_use) {
             memset(&g_fontsets[i], 0, sizeof(g_fontsets[i]));
-            g_fontsets[i].in_use = 1;
-            g_fontsets[i].sfont  = 64;
-
-            /* Return a pointer to a FcFontSet-compatible struct.
-             * The first 3 fields match FcFontSet layout. */
-            return (FcFontSet *)&g_fontsets[i].nfont;
+            g_fontsets[i].in_use    = 1;
+            g_fontsets[i].set.sfont = 64;
+            g_fontsets[i].set.fonts = g_fontsets[i].fonts;
+            return &g_fontsets[i].set;
         }
     }
     return NULL;
@@ -681,7 +1423,7 @@ void FcFontSetDestroy(FcFontSet *fs)
 
     /* Find internal and release */
     struct fc_fontset_internal *fi =
-        (struct fc_fontset_internal *)((char *)fs - offsetof(struct fc_fontset_internal, nfont));
+        (struct fc_fontset_internal *)((char *)fs - offsetof(struct fc_fontset_internal, set));
     fi->in_use = 0;
 }
 
@@ -1084,7 +1826,28 @@ FcBool FcBlanksIsMember(FcBlanks *b, FcChar32 ucs4) { (void)b; (void)ucs4; retur
 /* Cache                                                                     */
 /* ========================================================================= */
 
-FcBool FcDirCacheValid(const FcChar8 *dir) { (void)dir; return FcTrue; }
+FcBool FcDirCacheValid(const FcChar8 *dir)
+{
+    const char *pool;
+    unsigned int i;
+
+    if (!g_fcdb || !dir)
+        return FcTrue;
+
+    /* Valid if the directory's recorded mtime is still current */
+    pool = fcdb_str(0);
+    for (i = 0; i < g_fcdb->ndirs; i++) {
+        const struct fc_cache_dir *d = fcdb_dirs() + i;
+
+        if (strcmp(pool + d->path_off, (const char *)dir) == 0) {
+            struct stat st;
+
+            return (stat((const char *)dir, &st) == 0 &&
+                    (int64_t)st.st_mtime == d->mtime) ? FcTrue : FcFalse;
+        }
+    }
+    return FcTrue;
+}
 
 /* ========================================================================= */
 /* Weight conversion                                                         */
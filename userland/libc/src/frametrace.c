@@ -0,0 +1,175 @@
+/*
+ * VeridianOS libc -- frametrace.c
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Cross-process frame tracing (veridian/frametrace.h).
+ *
+ * One shared MPMC ring (per-slot sequence numbers) at
+ * /run/veridian/frametrace.ring; every traced process maps it
+ * MAP_SHARED on first emit.  Writers CAS the enqueue cursor, fill
+ * the cell, and release-store its sequence -- the viewer never sees
+ * a half-written event.
+ */
+
+#include <veridian/frametrace.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static const char *VFT_PATH = "/run/veridian/frametrace.ring";
+static const char *VFT_PATH_FALLBACK = "/tmp/veridian-frametrace.ring";
+
+static struct vft_ring *g_vft;
+static int g_vft_state;         /* 0 unknown, 1 on, -1 off */
+
+int vft_enabled(void)
+{
+    if (g_vft_state == 0) {
+        const char *env = getenv("VERIDIAN_FRAMETRACE");
+
+        g_vft_state = (env && env[0] == '1') ? 1 : -1;
+    }
+    return g_vft_state > 0;
+}
+
+static struct vft_ring *vft_map(int writable)
+{
+    const char *paths[2] = { VFT_PATH, VFT_PATH_FALLBACK };
+    int fd = -1;
+    void *map;
+
+    if (writable) {
+        mkdir("/run", 0755);
+        mkdir("/run/veridian", 0755);
+        for (int p = 0; p < 2 && fd < 0; p++)
+            fd = open(paths[p], O_RDWR | O_CREAT, 0666);
+    } else {
+        for (int p = 0; p < 2 && fd < 0; p++)
+            fd = open(paths[p], O_RDONLY);
+    }
+    if (fd < 0)
+        return NULL;
+    if (writable && ftruncate(fd, sizeof(struct vft_ring)) < 0) {
+        close(fd);
+        return NULL;
+    }
+
+    map = mmap(NULL, sizeof(struct vft_ring),
+               writable ? PROT_READ | PROT_WRITE : PROT_READ,
+               MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return NULL;
+
+    if (writable) {
+        struct vft_ring *r = map;
+
+        /* Exactly one writer initializes: CAS-claim the magic with
+         * a sentinel, losers spin until the real magic appears */
+        uint32_t expected = 0;
+
+        if (__atomic_compare_exchange_n(&r->magic, &expected,
+                                        VFT_MAGIC ^ 1, 0,
+                                        __ATOMIC_ACQUIRE,
+                                        __ATOMIC_ACQUIRE)) {
+            for (uint32_t i = 0; i < VFT_RING_CAP; i++)
+                __atomic_store_n(&r->events[i].seq, i,
+                                 __ATOMIC_RELAXED);
+            __atomic_store_n(&r->magic, VFT_MAGIC, __ATOMIC_RELEASE);
+        } else {
+            while (__atomic_load_n(&r->magic, __ATOMIC_ACQUIRE) !=
+                   VFT_MAGIC)
+                ;               /* Initializer is mid-setup */
+        }
+    }
+    return map;
+}
+
+static struct vft_ring *vft_writer(void)
+{
+    if (!g_vft)
+        g_vft = vft_map(1);
+    return g_vft;
+}
+
+static uint64_t vft_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+void vft_emit(int stage, uint32_t frame_id)
+{
+    struct vft_ring *r;
+    uint32_t pos;
+
+    if (!vft_enabled())
+        return;
+    r = vft_writer();
+    if (!r)
+        return;
+
+    if (frame_id == 0)
+        frame_id = __atomic_load_n(&r->current_frame, __ATOMIC_ACQUIRE);
+
+    pos = __atomic_load_n(&r->enq, __ATOMIC_RELAXED);
+    for (;;) {
+        struct vft_event *e = &r->events[pos & (VFT_RING_CAP - 1)];
+        uint32_t seq = __atomic_load_n(&e->seq, __ATOMIC_ACQUIRE);
+        int32_t dif = (int32_t)(seq - pos);
+
+        if (dif == 0) {
+            if (__atomic_compare_exchange_n(&r->enq, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED)) {
+                e->stage = (uint8_t)stage;
+                e->frame_id = frame_id;
+                e->pid = (uint32_t)getpid();
+                e->ts_ns = vft_now();
+                __atomic_store_n(&e->seq, pos + 1, __ATOMIC_RELEASE);
+                return;
+            }
+        } else if (dif < 0) {
+            /* A full lap behind: the ring wrapped under us.  Tracing
+             * drops rather than stalls. */
+            return;
+        } else {
+            pos = __atomic_load_n(&r->enq, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+uint32_t vft_begin_frame(void)
+{
+    struct vft_ring *r;
+    uint32_t id;
+
+    if (!vft_enabled())
+        return 0;
+    r = vft_writer();
+    if (!r)
+        return 0;
+
+    id = __atomic_add_fetch(&r->current_frame, 1, __ATOMIC_ACQ_REL);
+    vft_emit(VFT_STAGE_INPUT, id);
+    return id;
+}
+
+const struct vft_ring *vft_attach(void)
+{
+    static const struct vft_ring *reader;
+
+    if (!reader)
+        reader = vft_map(0);
+    return reader;
+}
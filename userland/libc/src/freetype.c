@@ -5,9 +5,12 @@
  * SPDX-License-Identifier: MIT OR Apache-2.0
  *
  * FreeType 2.13.3 compatible implementation.
- * Provides font face management, glyph loading with metrics,
- * bitmap rendering (8x16 fallback glyphs), charmap selection,
- * kerning queries, and glyph object management.
+ * Provides font face management, TrueType (glyf/loca/cmap) outline
+ * loading, anti-aliased scanline rasterization, charmap selection,
+ * kerning queries, and glyph object management.  Faces without usable
+ * sfnt data fall back to 8x16 box glyphs.  Rendered bitmaps go through
+ * the shared glyph-run cache (veridian/glyphrun.h) keyed on
+ * (face, pixel size, glyph index).
  */
 
 #include <ft2build.h>
@@ -18,8 +21,14 @@
 #include <freetype/ftbitmap.h>
 #include <freetype/ftmodapi.h>
 #include <freetype/ftsizes.h>
+#include <veridian/glyphrun.h>
+#include <fcntl.h>
+#include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 /* ========================================================================= */
 /* Internal limits                                                           */
@@ -27,12 +36,23 @@
 
 #define MAX_LIBRARIES    4
 #define MAX_FACES       64
-#define MAX_GLYPHS     128
 #define MAX_STROKERS     8
 
 #define DEFAULT_GLYPH_WIDTH   8
 #define DEFAULT_GLYPH_HEIGHT  16
 
+/* Upper bound on rasterized glyph pixmaps (per axis) */
+#define GLYPH_PIXMAP_MAX     48
+
+/* Outline decoding limits (DejaVu Sans tops out well below these) */
+#define TTF_MAX_POINTS      512
+#define TTF_MAX_CONTOURS     64
+#define TTF_MAX_EDGES      1024
+#define TTF_MAX_DEPTH         4   /* composite glyph nesting */
+
+/* Vertical oversampling of the scanline rasterizer */
+#define RAS_VSAMPLES          4
+
 /* ========================================================================= */
 /* Internal structures                                                       */
 /* ========================================================================= */
@@ -64,16 +84,278 @@ struct ft_face_internal {
     /* Size */
     FT_SizeRec      size_rec;
 
-    /* Bitmap buffer for rendered glyphs */
-    unsigned char   bitmap_buf[DEFAULT_GLYPH_WIDTH * DEFAULT_GLYPH_HEIGHT];
+    /* Bitmap buffer for rendered glyphs (up to GLYPH_PIXMAP_MAX^2,
+     * 8-bit coverage) */
+    unsigned char   bitmap_buf[GLYPH_PIXMAP_MAX * GLYPH_PIXMAP_MAX];
+
+    /* TrueType font data; NULL means fall back to box glyphs */
+    const unsigned char *font_data;
+    unsigned long        font_len;
+    int                  owns_font_data;
+
+    /* sfnt table slices (offsets into font_data; 0 length = absent) */
+    unsigned long   glyf_off, glyf_len;
+    unsigned long   loca_off, loca_len;
+    unsigned long   hmtx_off, hmtx_len;
+    unsigned long   cmap_sub_off;       /* selected cmap subtable */
+    int             cmap_format;        /* 4 or 12; 0 = none */
+
+    FT_UShort       upem;
+    FT_UShort       tt_num_glyphs;
+    FT_UShort       num_hmetrics;
+    int             long_loca;
+    FT_Short        tt_ascender;
+    FT_Short        tt_descender;
+    FT_Short        tt_line_gap;
+
+    /* Shared metrics cache (mmap'd, read-only; NULL = not mapped) */
+    const struct vfm_header *metrics;
+    size_t          metrics_map_len;
+};
+
+/* ========================================================================= */
+/* Persistent metrics cache                                                  */
+/* ========================================================================= */
+
+/*
+ * Per-face advances and kerning, persisted per font file and mapped
+ * MAP_SHARED so every process reads one copy.  Layout: header, a flat
+ * uint16 advance array indexed by glyph id (font units), then sorted
+ * (left<<16|right -> int16 value) kern pairs for binary search.
+ * Built once by the first process to open the face; published with
+ * the magic stored last.
+ */
+
+#define VFM_MAGIC   0x434d4656UL    /* 'VFMC' */
+#define VFM_VERSION 1UL
+#define VFM_MAX_KERN_PAIRS 65536UL
+
+struct vfm_header {
+    FT_ULong  magic;
+    FT_ULong  version;
+    FT_ULong  face_hash;            /* FNV of font head + length */
+    FT_ULong  num_glyphs;
+    FT_ULong  kern_count;
+    FT_ULong  _pad;
+    /* uint16 advances[num_glyphs]; then struct vfm_kern[kern_count] */
 };
 
+struct vfm_kern {
+    FT_ULong  pair;                 /* left << 16 | right */
+    FT_Long   value;                /* Font units */
+};
+
+static FT_ULong vfm_hash_face(const struct ft_face_internal *fi)
+{
+    FT_ULong h = 0xcbf29ce484222325UL ^ VFM_VERSION;
+    unsigned long i;
+    unsigned long n = fi->font_len < 256 ? fi->font_len : 256;
+
+    for (i = 0; i < n; i++) {
+        h ^= fi->font_data[i];
+        h *= 0x100000001b3UL;
+    }
+    h ^= fi->font_len;
+    h *= 0x100000001b3UL;
+    return h;
+}
+
+static const FT_UShort *vfm_advances(const struct vfm_header *h)
+{
+    return (const FT_UShort *)(h + 1);
+}
+
+static const struct vfm_kern *vfm_kerns(const struct vfm_header *h)
+{
+    return (const struct vfm_kern *)((const unsigned char *)(h + 1) +
+                                     h->num_glyphs * 2);
+}
+
+static FT_UShort ttf_advance_width_raw(const struct ft_face_internal *fi,
+                                       FT_UInt gid);
+static FT_UShort ttf_u16(const unsigned char *p);
+static FT_Short ttf_s16(const unsigned char *p);
+static int ttf_find_table(const struct ft_face_internal *fi,
+                          const char *tag, unsigned long *off,
+                          unsigned long *len);
+
+/* Parse the TTF 'kern' table (format 0 subtables) into the cache */
+static unsigned long vfm_collect_kerns(const struct ft_face_internal *fi,
+                                       struct vfm_kern *out,
+                                       unsigned long max)
+{
+    unsigned long kern_off, kern_len;
+    unsigned long count = 0;
+    unsigned long pos;
+    FT_UShort ntables;
+    FT_UShort t;
+
+    if (ttf_find_table(fi, "kern", &kern_off, &kern_len) != 0 ||
+        kern_len < 4)
+        return 0;
+
+    ntables = ttf_u16(fi->font_data + kern_off + 2);
+    pos = kern_off + 4;
+    for (t = 0; t < ntables && pos + 6 <= kern_off + kern_len; t++) {
+        unsigned long sub_len = ttf_u16(fi->font_data + pos + 2);
+        FT_UShort coverage = ttf_u16(fi->font_data + pos + 4);
+
+        if ((coverage >> 8) == 0 && pos + 14 <= kern_off + kern_len) {
+            FT_UShort npairs = ttf_u16(fi->font_data + pos + 6);
+            unsigned long p = pos + 14;
+            FT_UShort i;
+
+            for (i = 0; i < npairs && count < max &&
+                        p + 6 <= kern_off + kern_len; i++, p += 6) {
+                out[count].pair =
+                    ((FT_ULong)ttf_u16(fi->font_data + p) << 16) |
+                    ttf_u16(fi->font_data + p + 2);
+                out[count].value = ttf_s16(fi->font_data + p + 4);
+                count++;
+            }
+        }
+        if (sub_len < 6)
+            break;
+        pos += sub_len;
+    }
+    return count;
+}
+
+static int vfm_kern_cmp(const void *a, const void *b)
+{
+    const struct vfm_kern *ka = (const struct vfm_kern *)a;
+    const struct vfm_kern *kb = (const struct vfm_kern *)b;
+
+    if (ka->pair < kb->pair)
+        return -1;
+    return ka->pair > kb->pair ? 1 : 0;
+}
+
+/* Map (building on first use) the face's shared metrics cache */
+static void vfm_acquire(struct ft_face_internal *fi)
+{
+    char path[256];
+    FT_ULong hash = vfm_hash_face(fi);
+    size_t adv_bytes = (size_t)fi->tt_num_glyphs * 2;
+    int fd;
+    struct stat st;
+
+    fi->metrics = NULL;
+    if (fi->tt_num_glyphs == 0)
+        return;
+
+    mkdir("/var/cache/veridian", 0755);
+    snprintf(path, sizeof(path),
+             "/var/cache/veridian/fontmetrics-%08lx.cache",
+             (unsigned long)(hash & 0xffffffffUL));
+
+    fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+        return;
+
+    if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(struct vfm_header)) {
+        /* Existing cache: map and validate */
+        void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED,
+                         fd, 0);
+
+        if (map != MAP_FAILED) {
+            const struct vfm_header *h = (const struct vfm_header *)map;
+
+            if (h->magic == VFM_MAGIC && h->version == VFM_VERSION &&
+                h->face_hash == hash &&
+                h->num_glyphs == fi->tt_num_glyphs &&
+                (size_t)st.st_size >=
+                    sizeof(*h) + adv_bytes +
+                        h->kern_count * sizeof(struct vfm_kern)) {
+                fi->metrics = h;
+                fi->metrics_map_len = (size_t)st.st_size;
+                close(fd);
+                return;
+            }
+            munmap(map, (size_t)st.st_size);
+        }
+    }
+
+    /* Build: advances from hmtx, kern pairs from the kern table */
+    {
+        struct vfm_kern *kerns =
+            malloc(VFM_MAX_KERN_PAIRS * sizeof(*kerns));
+        unsigned long nkern = 0;
+        size_t total;
+        struct vfm_header *h;
+        FT_UShort *adv;
+        FT_UInt g;
+
+        if (kerns)
+            nkern = vfm_collect_kerns(fi, kerns, VFM_MAX_KERN_PAIRS);
+        if (nkern)
+            qsort(kerns, nkern, sizeof(*kerns), vfm_kern_cmp);
+
+        total = sizeof(*h) + adv_bytes + nkern * sizeof(*kerns);
+        h = calloc(1, total);
+        if (!h) {
+            free(kerns);
+            close(fd);
+            return;
+        }
+        h->version = VFM_VERSION;
+        h->face_hash = hash;
+        h->num_glyphs = fi->tt_num_glyphs;
+        h->kern_count = nkern;
+        adv = (FT_UShort *)(h + 1);
+        for (g = 0; g < fi->tt_num_glyphs; g++)
+            adv[g] = ttf_advance_width_raw(fi, g);
+        if (nkern)
+            memcpy((unsigned char *)(h + 1) + adv_bytes, kerns,
+                   nkern * sizeof(*kerns));
+        h->magic = VFM_MAGIC;       /* Complete in memory */
+        free(kerns);
+        close(fd);
+
+        /* Atomic publication: write-to-temp + rename, then map the
+         * final file -- concurrent readers only ever see a complete
+         * image */
+        {
+            char tmp[288];
+            int tfd;
+
+            snprintf(tmp, sizeof(tmp), "%s.tmp.%d", path,
+                     (int)getpid());
+            tfd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (tfd >= 0) {
+                if (write(tfd, h, total) == (ssize_t)total) {
+                    close(tfd);
+                    if (rename(tmp, path) == 0) {
+                        int mfd = open(path, O_RDONLY);
+
+                        if (mfd >= 0) {
+                            void *map = mmap(NULL, total, PROT_READ,
+                                             MAP_SHARED, mfd, 0);
+
+                            if (map != MAP_FAILED) {
+                                fi->metrics =
+                                    (const struct vfm_header *)map;
+                                fi->metrics_map_len = total;
+                            }
+                            close(mfd);
+                        }
+                    }
+                } else {
+                    close(tfd);
+                    unlink(tmp);
+                }
+            }
+        }
+        free(h);
+    }
+}
+
+/* Glyph objects are heap-allocated with their bitmap pixels inline;
+ * FT_BitmapGlyphRec must stay first so the FT_Glyph handle we return
+ * is also the allocation base. */
 struct ft_glyph_internal {
-    int           in_use;
-    FT_GlyphRec   base;
-    /* Extra space for bitmap glyph data */
     FT_BitmapGlyphRec  bm;
-    unsigned char bm_buf[DEFAULT_GLYPH_WIDTH * DEFAULT_GLYPH_HEIGHT];
+    unsigned char      bm_buf[];
 };
 
 struct ft_stroker_internal {
@@ -91,7 +373,6 @@ struct ft_stroker_internal {
 
 static struct ft_library_internal  g_libraries[MAX_LIBRARIES];
 static struct ft_face_internal     g_faces[MAX_FACES];
-static struct ft_glyph_internal    g_glyphs[MAX_GLYPHS];
 static struct ft_stroker_internal  g_strokers[MAX_STROKERS];
 
 /* ========================================================================= */
@@ -185,10 +466,49 @@ static void init_face_defaults(struct ft_face_internal *fi, FT_Face face)
     fi->ref_count    = 1;
 }
 
+/* Set slot metrics for a rendered glyph; the bitmap pixels themselves
+ * are produced by fill_glyph_bitmap() or fetched from the glyph-run
+ * cache. */
+static void fill_glyph_metrics(struct ft_face_internal *fi,
+                                FT_UInt glyph_index)
+{
+    FT_GlyphSlot slot = &fi->slot;
+    unsigned int w = DEFAULT_GLYPH_WIDTH;
+    unsigned int h = DEFAULT_GLYPH_HEIGHT;
+
+    slot->bitmap.rows       = h;
+    slot->bitmap.width      = w;
+    slot->bitmap.pitch      = (int)w;
+    slot->bitmap.buffer     = fi->bitmap_buf;
+    slot->bitmap.num_grays  = 256;
+    slot->bitmap.pixel_mode = FT_PIXEL_MODE_GRAY;
+
+    slot->bitmap_left = 1;
+    slot->bitmap_top  = (int)(h - 2);
+
+    /* 26.6 metrics */
+    slot->metrics.width        = (FT_Pos)(w * 64);
+    slot->metrics.height       = (FT_Pos)(h * 64);
+    slot->metrics.horiBearingX = 1 * 64;
+    slot->metrics.horiBearingY = (FT_Pos)((h - 2) * 64);
+    slot->metrics.horiAdvance  = (FT_Pos)((w + 2) * 64);
+    slot->metrics.vertBearingX = 0;
+    slot->metrics.vertBearingY = 0;
+    slot->metrics.vertAdvance  = (FT_Pos)((h + 2) * 64);
+
+    slot->advance.x = (FT_Pos)((w + 2) * 64);
+    slot->advance.y = 0;
+
+    slot->linearHoriAdvance = (FT_Fixed)((w + 2) << 16);
+    slot->linearVertAdvance = (FT_Fixed)((h + 2) << 16);
+
+    slot->format      = FT_GLYPH_FORMAT_BITMAP;
+    slot->glyph_index = glyph_index;
+}
+
 static void fill_glyph_bitmap(struct ft_face_internal *fi,
                                FT_UInt glyph_index)
 {
-    FT_GlyphSlot slot = &fi->slot;
     unsigned int w = DEFAULT_GLYPH_WIDTH;
     unsigned int h = DEFAULT_GLYPH_HEIGHT;
     unsigned int i;
@@ -208,36 +528,827 @@ static void fill_glyph_bitmap(struct ft_face_internal *fi,
         }
     }
 
-    slot->bitmap.rows       = h;
-    slot->bitmap.width      = w;
-    slot->bitmap.pitch      = (int)w;
+    fill_glyph_metrics(fi, glyph_index);
+}
+
+/* ========================================================================= */
+/* TrueType sfnt parsing                                                     */
+/* ========================================================================= */
+
+static FT_UShort ttf_u16(const unsigned char *p)
+{
+    return (FT_UShort)(((FT_UShort)p[0] << 8) | p[1]);
+}
+
+static FT_Short ttf_s16(const unsigned char *p)
+{
+    return (FT_Short)ttf_u16(p);
+}
+
+static FT_ULong ttf_u32(const unsigned char *p)
+{
+    return ((FT_ULong)p[0] << 24) | ((FT_ULong)p[1] << 16) |
+           ((FT_ULong)p[2] << 8)  |  (FT_ULong)p[3];
+}
+
+/* Locate a table in the sfnt directory; returns 0 on success */
+static int ttf_find_table(const struct ft_face_internal *fi,
+                           const char *tag,
+                           unsigned long *off, unsigned long *len)
+{
+    unsigned long num_tables, i;
+
+    if (fi->font_len < 12)
+        return -1;
+
+    num_tables = ttf_u16(fi->font_data + 4);
+    if (12 + 16 * num_tables > fi->font_len)
+        return -1;
+
+    for (i = 0; i < num_tables; i++) {
+        const unsigned char *rec = fi->font_data + 12 + 16 * i;
+
+        if (memcmp(rec, tag, 4) == 0) {
+            unsigned long o = ttf_u32(rec + 8);
+            unsigned long l = ttf_u32(rec + 12);
+
+            if (o > fi->font_len || l > fi->font_len - o)
+                return -1;
+            *off = o;
+            *len = l;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/* Pick a Unicode cmap subtable: format 12 if available, else format 4 */
+static void ttf_select_cmap(struct ft_face_internal *fi,
+                             unsigned long cmap_off, unsigned long cmap_len)
+{
+    unsigned long num_sub, i;
+
+    fi->cmap_format = 0;
+    if (cmap_len < 4)
+        return;
+
+    num_sub = ttf_u16(fi->font_data + cmap_off + 2);
+    if (4 + 8 * num_sub > cmap_len)
+        return;
+
+    for (i = 0; i < num_sub; i++) {
+        const unsigned char *rec = fi->font_data + cmap_off + 4 + 8 * i;
+        FT_UShort plat = ttf_u16(rec);
+        FT_UShort enc  = ttf_u16(rec + 2);
+        unsigned long sub = ttf_u32(rec + 4);
+        int unicode = (plat == 3 && (enc == 1 || enc == 10)) || plat == 0;
+        int format;
+
+        if (!unicode || sub + 4 > cmap_len)
+            continue;
+
+        format = ttf_u16(fi->font_data + cmap_off + sub);
+        if (format == 12 ||
+            (format == 4 && fi->cmap_format != 12)) {
+            fi->cmap_format  = format;
+            fi->cmap_sub_off = cmap_off + sub;
+        }
+    }
+}
+
+/* Parse the sfnt directory and cache the table state we need.
+ * Returns 0 when the face has usable outlines. */
+static int ttf_parse(struct ft_face_internal *fi)
+{
+    unsigned long head_off, head_len;
+    unsigned long maxp_off, maxp_len;
+    unsigned long hhea_off, hhea_len;
+    unsigned long cmap_off, cmap_len;
+    FT_ULong version;
+
+    if (!fi->font_data || fi->font_len < 12)
+        return -1;
+
+    version = ttf_u32(fi->font_data);
+    if (version != 0x00010000UL && version != 0x74727565UL)  /* 'true' */
+        return -1;  /* CFF ('OTTO') and collections are not supported */
+
+    if (ttf_find_table(fi, "head", &head_off, &head_len) != 0 ||
+        ttf_find_table(fi, "maxp", &maxp_off, &maxp_len) != 0 ||
+        ttf_find_table(fi, "hhea", &hhea_off, &hhea_len) != 0 ||
+        ttf_find_table(fi, "hmtx", &fi->hmtx_off, &fi->hmtx_len) != 0 ||
+        ttf_find_table(fi, "loca", &fi->loca_off, &fi->loca_len) != 0 ||
+        ttf_find_table(fi, "glyf", &fi->glyf_off, &fi->glyf_len) != 0)
+        return -1;
+
+    if (head_len < 52 || maxp_len < 6 || hhea_len < 36)
+        return -1;
+
+    fi->upem = ttf_u16(fi->font_data + head_off + 18);
+    if (fi->upem == 0)
+        fi->upem = 2048;
+    fi->long_loca     = ttf_s16(fi->font_data + head_off + 50) != 0;
+    fi->tt_num_glyphs = ttf_u16(fi->font_data + maxp_off + 4);
+    fi->tt_ascender   = ttf_s16(fi->font_data + hhea_off + 4);
+    fi->tt_descender  = ttf_s16(fi->font_data + hhea_off + 6);
+    fi->tt_line_gap   = ttf_s16(fi->font_data + hhea_off + 8);
+    fi->num_hmetrics  = ttf_u16(fi->font_data + hhea_off + 34);
+    if (fi->num_hmetrics == 0 ||
+        (unsigned long)fi->num_hmetrics * 4 > fi->hmtx_len)
+        return -1;
+
+    if (ttf_find_table(fi, "cmap", &cmap_off, &cmap_len) == 0)
+        ttf_select_cmap(fi, cmap_off, cmap_len);
+
+    return 0;
+}
+
+static FT_UInt ttf_char_index(const struct ft_face_internal *fi,
+                               FT_ULong charcode)
+{
+    const unsigned char *sub = fi->font_data + fi->cmap_sub_off;
+
+    if (fi->cmap_format == 4) {
+        FT_UShort seg_x2 = ttf_u16(sub + 6);
+        FT_UShort segs   = seg_x2 / 2;
+        const unsigned char *ends   = sub + 14;
+        const unsigned char *starts = ends + seg_x2 + 2;
+        const unsigned char *deltas = starts + seg_x2;
+        const unsigned char *ranges = deltas + seg_x2;
+        FT_UShort lo = 0, hi = segs;
+
+        if (charcode > 0xFFFF || segs == 0)
+            return 0;
+
+        while (lo < hi) {
+            FT_UShort mid = (FT_UShort)((lo + hi) / 2);
+            if (ttf_u16(ends + 2 * mid) < charcode)
+                lo = (FT_UShort)(mid + 1);
+            else
+                hi = mid;
+        }
+        if (lo >= segs || ttf_u16(starts + 2 * lo) > charcode)
+            return 0;
+
+        {
+            FT_UShort range = ttf_u16(ranges + 2 * lo);
+            FT_UShort gid;
+
+            if (range == 0) {
+                gid = (FT_UShort)(charcode + ttf_u16(deltas + 2 * lo));
+            } else {
+                const unsigned char *p = ranges + 2 * lo + range +
+                    2 * (charcode - ttf_u16(starts + 2 * lo));
+                if (p + 2 > fi->font_data + fi->font_len)
+                    return 0;
+                gid = ttf_u16(p);
+                if (gid != 0)
+                    gid = (FT_UShort)(gid + ttf_u16(deltas + 2 * lo));
+            }
+            return gid;
+        }
+    }
+
+    if (fi->cmap_format == 12) {
+        FT_ULong ngroups = ttf_u32(sub + 12);
+        FT_ULong lo = 0, hi = ngroups;
+
+        while (lo < hi) {
+            FT_ULong mid = (lo + hi) / 2;
+            const unsigned char *g = sub + 16 + 12 * mid;
+
+            if (ttf_u32(g + 4) < charcode)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo < ngroups) {
+            const unsigned char *g = sub + 16 + 12 * lo;
+            if (ttf_u32(g) <= charcode)
+                return (FT_UInt)(ttf_u32(g + 8) + (charcode - ttf_u32(g)));
+        }
+        return 0;
+    }
+
+    return 0;
+}
+
+/* Resolve a glyph's slice of the glyf table; returns 0 on success.
+ * A zero *len is valid (empty glyph, e.g. space). */
+static int ttf_glyph_range(const struct ft_face_internal *fi, FT_UInt gid,
+                            unsigned long *off, unsigned long *len)
+{
+    unsigned long o0, o1;
+
+    if (gid >= fi->tt_num_glyphs)
+        return -1;
+
+    if (fi->long_loca) {
+        if (4UL * (gid + 2) > fi->loca_len)
+            return -1;
+        o0 = ttf_u32(fi->font_data + fi->loca_off + 4 * gid);
+        o1 = ttf_u32(fi->font_data + fi->loca_off + 4 * (gid + 1));
+    } else {
+        if (2UL * (gid + 2) > fi->loca_len)
+            return -1;
+        o0 = 2UL * ttf_u16(fi->font_data + fi->loca_off + 2 * gid);
+        o1 = 2UL * ttf_u16(fi->font_data + fi->loca_off + 2 * (gid + 1));
+    }
+
+    if (o1 < o0 || o1 > fi->glyf_len)
+        return -1;
+
+    *off = fi->glyf_off + o0;
+    *len = o1 - o0;
+    return 0;
+}
+
+static FT_UShort ttf_advance_width_raw(const struct ft_face_internal *fi,
+                                       FT_UInt gid)
+{
+    FT_UInt idx = gid < fi->num_hmetrics ? gid : fi->num_hmetrics - 1U;
+    return ttf_u16(fi->font_data + fi->hmtx_off + 4 * idx);
+}
+
+static FT_UShort ttf_advance_width(const struct ft_face_internal *fi,
+                                    FT_UInt gid)
+{
+    /* Layout hammers this: serve from the shared flat array when the
+     * metrics cache is mapped */
+    if (fi->metrics && gid < fi->metrics->num_glyphs)
+        return vfm_advances(fi->metrics)[gid];
+    return ttf_advance_width_raw(fi, gid);
+}
+
+/* Font units -> 26.6 device units at the given ppem */
+static FT_Pos ttf_scale(const struct ft_face_internal *fi,
+                         long v, FT_UInt ppem)
+{
+    long upem = (long)fi->upem;
+    long n = v * (long)ppem * 64;
+    return (FT_Pos)((n >= 0 ? n + upem / 2 : n - upem / 2) / upem);
+}
+
+/* ========================================================================= */
+/* Outline decoding                                                          */
+/* ========================================================================= */
+
+/* Simple glyph flag bits */
+#define TTF_ON_CURVE       0x01
+#define TTF_X_SHORT        0x02
+#define TTF_Y_SHORT        0x04
+#define TTF_REPEAT         0x08
+#define TTF_X_SAME_OR_POS  0x10
+#define TTF_Y_SAME_OR_POS  0x20
+
+/* Composite glyph flag bits */
+#define TTF_ARGS_ARE_WORDS     0x0001
+#define TTF_ARGS_ARE_XY        0x0002
+#define TTF_HAVE_SCALE         0x0008
+#define TTF_MORE_COMPONENTS    0x0020
+#define TTF_HAVE_XY_SCALE      0x0040
+#define TTF_HAVE_2X2           0x0080
+
+/* Decoded outline in transformed font units */
+struct ttf_outline {
+    long          x[TTF_MAX_POINTS];
+    long          y[TTF_MAX_POINTS];
+    unsigned char on[TTF_MAX_POINTS];
+    int           ends[TTF_MAX_CONTOURS];
+    int           npts;
+    int           ncontours;
+};
+
+/* Append one glyph's points to *ol, applying a 16.16 2x2 transform and
+ * a font-unit translation.  Recurses for composites. */
+static int ttf_decode_glyph(const struct ft_face_internal *fi, FT_UInt gid,
+                             struct ttf_outline *ol, int depth,
+                             long xx, long xy, long yx, long yy,
+                             long dx, long dy)
+{
+    unsigned long off, len, pos;
+    const unsigned char *g;
+    int ncont;
+
+    if (depth > TTF_MAX_DEPTH)
+        return -1;
+    if (ttf_glyph_range(fi, gid, &off, &len) != 0)
+        return -1;
+    if (len == 0)
+        return 0;
+    if (len < 10)
+        return -1;
+
+    g = fi->font_data + off;
+    ncont = ttf_s16(g);
+
+    if (ncont < 0) {
+        /* Composite: recurse per component with composed transforms */
+        pos = 10;
+        for (;;) {
+            FT_UShort flags, cgid;
+            long cdx = 0, cdy = 0;
+            long ca = 0x10000, cb = 0, cc = 0, cd = 0x10000;
+            long nxx, nxy, nyx, nyy;
+
+            if (pos + 4 > len)
+                return -1;
+            flags = ttf_u16(g + pos);
+            cgid  = ttf_u16(g + pos + 2);
+            pos += 4;
+
+            if (flags & TTF_ARGS_ARE_WORDS) {
+                if (pos + 4 > len)
+                    return -1;
+                if (flags & TTF_ARGS_ARE_XY) {
+                    cdx = ttf_s16(g + pos);
+                    cdy = ttf_s16(g + pos + 2);
+                }
+                pos += 4;
+            } else {
+                if (pos + 2 > len)
+                    return -1;
+                if (flags & TTF_ARGS_ARE_XY) {
+                    cdx = (signed char)g[pos];
+                    cdy = (signed char)g[pos + 1];
+                }
+                pos += 2;
+            }
+
+            if (flags & TTF_HAVE_SCALE) {
+                if (pos + 2 > len)
+                    return -1;
+                ca = cd = (long)ttf_s16(g + pos) << 2;  /* F2Dot14 -> 16.16 */
+                pos += 2;
+            } else if (flags & TTF_HAVE_XY_SCALE) {
+                if (pos + 4 > len)
+                    return -1;
+                ca = (long)ttf_s16(g + pos) << 2;
+                cd = (long)ttf_s16(g + pos + 2) << 2;
+                pos += 4;
+            } else if (flags & TTF_HAVE_2X2) {
+                if (pos + 8 > len)
+                    return -1;
+                ca = (long)ttf_s16(g + pos) << 2;
+                cb = (long)ttf_s16(g + pos + 2) << 2;
+                cc = (long)ttf_s16(g + pos + 4) << 2;
+                cd = (long)ttf_s16(g + pos + 6) << 2;
+                pos += 8;
+            }
+
+            nxx = (xx * ca + xy * cb) >> 16;
+            nxy = (xx * cc + xy * cd) >> 16;
+            nyx = (yx * ca + yy * cb) >> 16;
+            nyy = (yx * cc + yy * cd) >> 16;
+
+            if (ttf_decode_glyph(fi, cgid, ol, depth + 1,
+                                  nxx, nxy, nyx, nyy,
+                                  dx + ((xx * cdx + xy * cdy) >> 16),
+                                  dy + ((yx * cdx + yy * cdy) >> 16)) != 0)
+                return -1;
+
+            if (!(flags & TTF_MORE_COMPONENTS))
+                break;
+        }
+        return 0;
+    }
+
+    /* Simple glyph */
+    {
+        int base = ol->npts;
+        int np, i;
+        FT_UShort ilen;
+        long v;
+        unsigned char flagbuf[TTF_MAX_POINTS];
+
+        if (ncont > TTF_MAX_CONTOURS - ol->ncontours)
+            return -1;
+        if (10UL + 2UL * ncont + 2UL > len)
+            return -1;
+
+        np = 0;
+        for (i = 0; i < ncont; i++) {
+            int e = ttf_u16(g + 10 + 2 * i);
+            if (e < np)
+                return -1;
+            np = e + 1;
+            ol->ends[ol->ncontours + i] = base + e;
+        }
+        if (np == 0 || np > TTF_MAX_POINTS - base)
+            return -1;
+
+        pos = 10 + 2UL * ncont;
+        ilen = ttf_u16(g + pos);
+        pos += 2 + ilen;
+        if (pos > len)
+            return -1;
+
+        /* Flags, with run-length repeats */
+        for (i = 0; i < np; ) {
+            unsigned char f;
+            if (pos >= len)
+                return -1;
+            f = g[pos++];
+            flagbuf[i++] = f;
+            if (f & TTF_REPEAT) {
+                unsigned char rep;
+                if (pos >= len)
+                    return -1;
+                rep = g[pos++];
+                while (rep-- && i < np)
+                    flagbuf[i++] = f;
+            }
+        }
+
+        /* X coordinates (deltas) */
+        v = 0;
+        for (i = 0; i < np; i++) {
+            unsigned char f = flagbuf[i];
+            if (f & TTF_X_SHORT) {
+                if (pos >= len)
+                    return -1;
+                v += (f & TTF_X_SAME_OR_POS) ? g[pos] : -(long)g[pos];
+                pos++;
+            } else if (!(f & TTF_X_SAME_OR_POS)) {
+                if (pos + 2 > len)
+                    return -1;
+                v += ttf_s16(g + pos);
+                pos += 2;
+            }
+            ol->x[base + i] = v;
+        }
+
+        /* Y coordinates (deltas) */
+        v = 0;
+        for (i = 0; i < np; i++) {
+            unsigned char f = flagbuf[i];
+            if (f & TTF_Y_SHORT) {
+                if (pos >= len)
+                    return -1;
+                v += (f & TTF_Y_SAME_OR_POS) ? g[pos] : -(long)g[pos];
+                pos++;
+            } else if (!(f & TTF_Y_SAME_OR_POS)) {
+                if (pos + 2 > len)
+                    return -1;
+                v += ttf_s16(g + pos);
+                pos += 2;
+            }
+            ol->y[base + i] = v;
+            ol->on[base + i] = flagbuf[i] & TTF_ON_CURVE;
+        }
+
+        /* Apply the composite transform + translation */
+        for (i = 0; i < np; i++) {
+            long px = ol->x[base + i];
+            long py = ol->y[base + i];
+            ol->x[base + i] = ((xx * px + xy * py) >> 16) + dx;
+            ol->y[base + i] = ((yx * px + yy * py) >> 16) + dy;
+        }
+
+        ol->npts      += np;
+        ol->ncontours += ncont;
+    }
+    return 0;
+}
+
+/* ========================================================================= */
+/* Anti-aliased scanline rasterizer                                          */
+/* ========================================================================= */
+
+/* Monotonic-in-y line segment, 26.6 device coords, y0 < y1 */
+struct ras_edge {
+    FT_Pos x0, y0, x1, y1;
+    int    dir;
+};
+
+struct ras_state {
+    struct ras_edge edges[TTF_MAX_EDGES];
+    int             nedges;
+    int             overflow;
+};
+
+static void ras_add_edge(struct ras_state *rs,
+                          FT_Pos x0, FT_Pos y0, FT_Pos x1, FT_Pos y1)
+{
+    struct ras_edge *e;
+
+    if (y0 == y1)
+        return;
+    if (rs->nedges >= TTF_MAX_EDGES) {
+        rs->overflow = 1;
+        return;
+    }
+
+    e = &rs->edges[rs->nedges++];
+    if (y0 < y1) {
+        e->x0 = x0; e->y0 = y0; e->x1 = x1; e->y1 = y1; e->dir = 1;
+    } else {
+        e->x0 = x1; e->y0 = y1; e->x1 = x0; e->y1 = y0; e->dir = -1;
+    }
+}
+
+/* Flatten a quadratic Bezier into line segments; subdivision count
+ * scales with the control point's deviation from the chord. */
+static void ras_add_quad(struct ras_state *rs,
+                          FT_Pos x0, FT_Pos y0, FT_Pos cx, FT_Pos cy,
+                          FT_Pos x1, FT_Pos y1)
+{
+    long devx = x0 - 2 * cx + x1;
+    long devy = y0 - 2 * cy + y1;
+    long dev  = (devx < 0 ? -devx : devx) + (devy < 0 ? -devy : devy);
+    int  n    = 1 + (int)(dev >> 5);
+    int  i;
+    FT_Pos px = x0, py = y0;
+
+    if (n > 16)
+        n = 16;
+
+    for (i = 1; i <= n; i++) {
+        long a = n - i, b = i;
+        FT_Pos nx = (FT_Pos)((a * a * x0 + 2 * a * b * cx + b * b * x1) /
+                             ((long)n * n));
+        FT_Pos ny = (FT_Pos)((a * a * y0 + 2 * a * b * cy + b * b * y1) /
+                             ((long)n * n));
+        ras_add_edge(rs, px, py, nx, ny);
+        px = nx;
+        py = ny;
+    }
+}
+
+/* Build the edge list from an outline scaled to 26.6 device space
+ * (y axis pointing up), inserting implied on-curve midpoints. */
+static void ras_build_edges(struct ras_state *rs,
+                             const struct ttf_outline *ol,
+                             const struct ft_face_internal *fi)
+{
+    FT_Pos dx[TTF_MAX_POINTS], dy[TTF_MAX_POINTS];
+    int c, i;
+
+    for (i = 0; i < ol->npts; i++) {
+        dx[i] = ttf_scale(fi, ol->x[i], fi->pixel_width);
+        dy[i] = ttf_scale(fi, ol->y[i], fi->pixel_height);
+    }
+
+    rs->nedges = 0;
+    rs->overflow = 0;
+
+    for (c = 0; c < ol->ncontours; c++) {
+        int s = (c == 0) ? 0 : ol->ends[c - 1] + 1;
+        int e = ol->ends[c];
+        int n = e - s + 1;
+        int start_off, k;
+        FT_Pos sx, sy, px, py, qx = 0, qy = 0;
+        int have_q = 0;
+
+        if (n < 2)
+            continue;
+
+        /* Start on an on-curve point, or a synthesized midpoint */
+        if (ol->on[s]) {
+            start_off = 0;
+            sx = dx[s];
+            sy = dy[s];
+        } else if (ol->on[e]) {
+            start_off = n - 1;
+            sx = dx[e];
+            sy = dy[e];
+        } else {
+            /* No on-curve point at all: start at the implied midpoint
+             * between the last and first control points */
+            start_off = n - 1;
+            sx = (dx[e] + dx[s]) / 2;
+            sy = (dy[e] + dy[s]) / 2;
+        }
+
+        px = sx;
+        py = sy;
+        for (k = 1; k <= n; k++) {
+            i = s + (start_off + k) % n;
+            if (k == n) {
+                /* Close the contour back to the start point */
+                if (have_q)
+                    ras_add_quad(rs, px, py, qx, qy, sx, sy);
+                else
+                    ras_add_edge(rs, px, py, sx, sy);
+                break;
+            }
+            if (ol->on[i]) {
+                if (have_q) {
+                    ras_add_quad(rs, px, py, qx, qy, dx[i], dy[i]);
+                    have_q = 0;
+                } else {
+                    ras_add_edge(rs, px, py, dx[i], dy[i]);
+                }
+                px = dx[i];
+                py = dy[i];
+            } else {
+                if (have_q) {
+                    FT_Pos mx = (qx + dx[i]) / 2;
+                    FT_Pos my = (qy + dy[i]) / 2;
+                    ras_add_quad(rs, px, py, qx, qy, mx, my);
+                    px = mx;
+                    py = my;
+                }
+                qx = dx[i];
+                qy = dy[i];
+                have_q = 1;
+            }
+        }
+    }
+}
+
+/* Fill the coverage bitmap: RAS_VSAMPLES sub-scanlines per row with
+ * exact horizontal span coverage, non-zero winding rule. */
+static void ras_fill(const struct ras_state *rs,
+                      int left, int top, unsigned int w, unsigned int h,
+                      unsigned char *buf)
+{
+    unsigned short acc[GLYPH_PIXMAP_MAX * GLYPH_PIXMAP_MAX];
+    FT_Pos xs[128];
+    int    dirs[128];
+    unsigned int row, col;
+    int sub;
+
+    memset(acc, 0, sizeof(acc[0]) * w * h);
+
+    for (row = 0; row < h; row++) {
+        for (sub = 0; sub < RAS_VSAMPLES; sub++) {
+            FT_Pos yc = (FT_Pos)top * 64 - (FT_Pos)row * 64 -
+                        sub * (64 / RAS_VSAMPLES) - 64 / (2 * RAS_VSAMPLES);
+            int ncross = 0, i, wind;
+            FT_Pos span_x = 0;
+
+            for (i = 0; i < rs->nedges; i++) {
+                const struct ras_edge *e = &rs->edges[i];
+                FT_Pos x;
+                int j;
+
+                if (yc < e->y0 || yc >= e->y1)
+                    continue;
+                if (ncross >= 128)
+                    break;
+
+                x = e->x0 + (FT_Pos)((long)(e->x1 - e->x0) *
+                                     (yc - e->y0) / (e->y1 - e->y0));
+
+                for (j = ncross; j > 0 && xs[j - 1] > x; j--) {
+                    xs[j]   = xs[j - 1];
+                    dirs[j] = dirs[j - 1];
+                }
+                xs[j]   = x;
+                dirs[j] = e->dir;
+                ncross++;
+            }
+
+            wind = 0;
+            for (i = 0; i < ncross; i++) {
+                if (wind == 0)
+                    span_x = xs[i];
+                wind += dirs[i];
+                if (wind == 0) {
+                    /* Accumulate span [span_x, xs[i]) into this row */
+                    FT_Pos a = span_x - (FT_Pos)left * 64;
+                    FT_Pos b = xs[i]  - (FT_Pos)left * 64;
+
+                    if (a < 0) a = 0;
+                    if (b > (FT_Pos)w * 64) b = (FT_Pos)w * 64;
+
+                    for (col = (unsigned int)(a >> 6);
+                         col < w && (FT_Pos)col * 64 < b; col++) {
+                        FT_Pos pa = (FT_Pos)col * 64;
+                        FT_Pos pb = pa + 64;
+                        FT_Pos lo = a > pa ? a : pa;
+                        FT_Pos hi = b < pb ? b : pb;
+
+                        if (hi > lo)
+                            acc[row * w + col] +=
+                                (unsigned short)(hi - lo);
+                    }
+                }
+            }
+        }
+    }
+
+    for (row = 0; row < h; row++) {
+        for (col = 0; col < w; col++) {
+            unsigned int v = acc[row * w + col];
+            buf[row * w + col] = v >= 255 ? 255 : (unsigned char)v;
+        }
+    }
+}
+
+/* ========================================================================= */
+/* Glyph metrics and rendering glue                                          */
+/* ========================================================================= */
+
+struct ttf_gmetrics {
+    int          left, top;     /* bitmap bearing, pixels */
+    unsigned int width, height; /* bitmap dimensions, pixels */
+    FT_Pos       advance;       /* 26.6 */
+};
+
+/* Cheap metrics from the glyph header bbox -- no rasterization, so
+ * cache hits never touch the outline beyond these ten bytes. */
+static int ttf_glyph_metrics(const struct ft_face_internal *fi, FT_UInt gid,
+                              struct ttf_gmetrics *gm)
+{
+    unsigned long off, len;
+    FT_Pos x0, y0, x1, y1;
+    int right, bottom;
+
+    if (ttf_glyph_range(fi, gid, &off, &len) != 0)
+        return -1;
+
+    gm->advance = ttf_scale(fi, ttf_advance_width(fi, gid),
+                             fi->pixel_width);
+
+    if (len == 0) {
+        gm->left = gm->top = 0;
+        gm->width = gm->height = 0;
+        return 0;
+    }
+    if (len < 10)
+        return -1;
+
+    x0 = ttf_scale(fi, ttf_s16(fi->font_data + off + 2), fi->pixel_width);
+    y0 = ttf_scale(fi, ttf_s16(fi->font_data + off + 4), fi->pixel_height);
+    x1 = ttf_scale(fi, ttf_s16(fi->font_data + off + 6), fi->pixel_width);
+    y1 = ttf_scale(fi, ttf_s16(fi->font_data + off + 8), fi->pixel_height);
+
+    gm->left = (int)(x0 >> 6);
+    bottom   = (int)(y0 >> 6);
+    right    = (int)((x1 + 63) >> 6);
+    gm->top  = (int)((y1 + 63) >> 6);
+
+    gm->width  = (unsigned int)(right - gm->left);
+    gm->height = (unsigned int)(gm->top - bottom);
+    if (gm->width > GLYPH_PIXMAP_MAX)
+        gm->width = GLYPH_PIXMAP_MAX;
+    if (gm->height > GLYPH_PIXMAP_MAX)
+        gm->height = GLYPH_PIXMAP_MAX;
+    return 0;
+}
+
+static void set_slot_from_gmetrics(struct ft_face_internal *fi,
+                                    FT_UInt glyph_index,
+                                    const struct ttf_gmetrics *gm)
+{
+    FT_GlyphSlot slot = &fi->slot;
+
+    slot->bitmap.rows       = gm->height;
+    slot->bitmap.width      = gm->width;
+    slot->bitmap.pitch      = (int)gm->width;
     slot->bitmap.buffer     = fi->bitmap_buf;
     slot->bitmap.num_grays  = 256;
     slot->bitmap.pixel_mode = FT_PIXEL_MODE_GRAY;
 
-    slot->bitmap_left = 1;
-    slot->bitmap_top  = (int)(h - 2);
+    slot->bitmap_left = gm->left;
+    slot->bitmap_top  = gm->top;
 
-    /* 26.6 metrics */
-    slot->metrics.width        = (FT_Pos)(w * 64);
-    slot->metrics.height       = (FT_Pos)(h * 64);
-    slot->metrics.horiBearingX = 1 * 64;
-    slot->metrics.horiBearingY = (FT_Pos)((h - 2) * 64);
-    slot->metrics.horiAdvance  = (FT_Pos)((w + 2) * 64);
+    slot->metrics.width        = (FT_Pos)gm->width * 64;
+    slot->metrics.height       = (FT_Pos)gm->height * 64;
+    slot->metrics.horiBearingX = (FT_Pos)gm->left * 64;
+    slot->metrics.horiBearingY = (FT_Pos)gm->top * 64;
+    slot->metrics.horiAdvance  = gm->advance;
     slot->metrics.vertBearingX = 0;
     slot->metrics.vertBearingY = 0;
-    slot->metrics.vertAdvance  = (FT_Pos)((h + 2) * 64);
+    slot->metrics.vertAdvance  = fi->size_rec.metrics.height;
 
-    slot->advance.x = (FT_Pos)((w + 2) * 64);
+    slot->advance.x = gm->advance;
     slot->advance.y = 0;
 
-    slot->linearHoriAdvance = (FT_Fixed)((w + 2) << 16);
-    slot->linearVertAdvance = (FT_Fixed)((h + 2) << 16);
+    slot->linearHoriAdvance = (FT_Fixed)(gm->advance << 10);
+    slot->linearVertAdvance = (FT_Fixed)(fi->size_rec.metrics.height << 10);
 
     slot->format      = FT_GLYPH_FORMAT_BITMAP;
     slot->glyph_index = glyph_index;
 }
 
+/* Decode, flatten, and rasterize one glyph into fi->bitmap_buf.
+ * Returns 0 on success. */
+static int ttf_render_glyph(struct ft_face_internal *fi, FT_UInt gid,
+                             const struct ttf_gmetrics *gm)
+{
+    static struct ttf_outline ol;   /* ~5 KiB; faces are not thread-safe
+                                     * per FreeType's own contract */
+    static struct ras_state   rs;   /* ~25 KiB */
+
+    ol.npts = 0;
+    ol.ncontours = 0;
+    if (ttf_decode_glyph(fi, gid, &ol, 0,
+                          0x10000, 0, 0, 0x10000, 0, 0) != 0)
+        return -1;
+
+    ras_build_edges(&rs, &ol, fi);
+    if (rs.overflow)
+        return -1;
+
+    memset(fi->bitmap_buf, 0, (size_t)gm->width * gm->height);
+    ras_fill(&rs, gm->left, gm->top, gm->width, gm->height,
+             fi->bitmap_buf);
+    return 0;
+}
+
 /* ========================================================================= */
 /* Library lifecycle                                                         */
 /* ========================================================================= */
@@ -269,8 +1380,12 @@ FT_Error FT_Done_FreeType(FT_Library library)
 
     /* Release all faces owned by this library */
     for (i = 0; i < MAX_FACES; i++) {
-        if (g_faces[i].in_use && g_faces[i].library == library)
+        if (g_faces[i].in_use && g_faces[i].library == library) {
             g_faces[i].in_use = 0;
+            if (g_faces[i].owns_font_data)
+                free((void *)(unsigned char *)g_faces[i].font_data);
+            g_faces[i].font_data = NULL;
+        }
     }
 
     struct ft_library_internal *lib = (struct ft_library_internal *)library;
@@ -292,23 +1407,13 @@ void FT_Library_Version(FT_Library library, FT_Int *amajor,
 /* Face loading                                                              */
 /* ========================================================================= */
 
-FT_Error FT_New_Face(FT_Library library, const char *filepathname,
-                      FT_Long face_index, FT_Face *aface)
-{
-    (void)filepathname;
-    return FT_New_Memory_Face(library, NULL, 0, face_index, aface);
-}
-
-FT_Error FT_New_Memory_Face(FT_Library library, const FT_Byte *file_base,
-                              FT_Long file_size, FT_Long face_index,
-                              FT_Face *aface)
+static FT_Error ft_open_face_internal(FT_Library library,
+                                       const FT_Byte *file_base,
+                                       FT_Long file_size, int owns_data,
+                                       FT_Face *aface)
 {
     int i;
 
-    (void)file_base;
-    (void)file_size;
-    (void)face_index;
-
     if (!library || !aface)
         return FT_Err_Invalid_Argument;
 
@@ -317,13 +1422,10 @@ FT_Error FT_New_Memory_Face(FT_Library library, const FT_Byte *file_base,
             struct ft_face_internal *fi = &g_faces[i];
             FT_FaceRec *face;
 
+            memset(fi, 0, sizeof(*fi));
             fi->in_use  = 1;
             fi->library = library;
 
-            /* The FT_FaceRec is allocated as part of fi; we use a static
-             * buffer region at the start of the face internal to avoid
-             * dynamic allocation.  We point *aface to a region that we
-             * treat as FT_FaceRec. */
             face = (FT_FaceRec *)malloc(sizeof(FT_FaceRec));
             if (!face) {
                 fi->in_use = 0;
@@ -331,6 +1433,35 @@ FT_Error FT_New_Memory_Face(FT_Library library, const FT_Byte *file_base,
             }
 
             init_face_defaults(fi, face);
+
+            /* Parse sfnt tables; failure keeps the box-glyph fallback */
+            if (file_base && file_size > 0) {
+                fi->font_data      = file_base;
+                fi->font_len       = (unsigned long)file_size;
+                fi->owns_font_data = owns_data;
+
+                if (ttf_parse(fi) == 0) {
+                    FT_Int gap = fi->tt_line_gap;
+
+                    /* Shared advance/kern cache for this face file */
+                    vfm_acquire(fi);
+
+                    face->num_glyphs   = fi->tt_num_glyphs;
+                    face->units_per_EM = fi->upem;
+                    face->ascender     = fi->tt_ascender;
+                    face->descender    = fi->tt_descender;
+                    face->height       = (FT_Short)(fi->tt_ascender -
+                                                    fi->tt_descender + gap);
+                } else {
+                    fi->font_data = NULL;
+                    fi->font_len  = 0;
+                    fi->glyf_len  = 0;
+                    if (owns_data)
+                        free((void *)(FT_Byte *)file_base);
+                    fi->owns_font_data = 0;
+                }
+            }
+
             *aface = face;
             return FT_Err_Ok;
         }
@@ -339,6 +1470,44 @@ FT_Error FT_New_Memory_Face(FT_Library library, const FT_Byte *file_base,
     return FT_Err_Out_Of_Memory;
 }
 
+FT_Error FT_New_Face(FT_Library library, const char *filepathname,
+                      FT_Long face_index, FT_Face *aface)
+{
+    unsigned char *data = NULL;
+    long len = 0;
+
+    (void)face_index;
+
+    if (filepathname) {
+        FILE *fp = fopen(filepathname, "rb");
+
+        if (fp) {
+            if (fseek(fp, 0, SEEK_END) == 0 && (len = ftell(fp)) > 0 &&
+                fseek(fp, 0, SEEK_SET) == 0) {
+                data = (unsigned char *)malloc((size_t)len);
+                if (data &&
+                    fread(data, 1, (size_t)len, fp) != (size_t)len) {
+                    free(data);
+                    data = NULL;
+                }
+            }
+            fclose(fp);
+        }
+    }
+
+    if (!data)
+        len = 0;
+    return ft_open_face_internal(library, data, (FT_Long)len, 1, aface);
+}
+
+FT_Error FT_New_Memory_Face(FT_Library library, const FT_Byte *file_base,
+                              FT_Long file_size, FT_Long face_index,
+                              FT_Face *aface)
+{
+    (void)face_index;
+    return ft_open_face_internal(library, file_base, file_size, 0, aface);
+}
+
 FT_Error FT_Open_Face(FT_Library library, const FT_Open_Args *args,
                        FT_Long face_index, FT_Face *aface)
 {
@@ -356,8 +1525,19 @@ FT_Error FT_Done_Face(FT_Face face)
     fi = face_from_ptr(face);
     if (fi) {
         fi->ref_count--;
-        if (fi->ref_count <= 0)
+        if (fi->ref_count <= 0) {
             fi->in_use = 0;
+            if (fi->metrics) {
+                munmap((void *)fi->metrics, fi->metrics_map_len);
+                fi->metrics = NULL;
+            }
+            if (fi->owns_font_data)
+                free((void *)(unsigned char *)fi->font_data);
+            fi->font_data = NULL;
+            fi->font_len  = 0;
+            /* Cached runs/bitmaps keyed on this face are now stale */
+            vgr_cache_forget_face(fi);
+        }
     }
 
     free(face);
@@ -456,7 +1636,58 @@ FT_Error FT_Load_Glyph(FT_Face face, FT_UInt glyph_index,
     if (!fi)
         return FT_Err_Invalid_Face_Handle;
 
-    fill_glyph_bitmap(fi, glyph_index);
+    /* Real outline path: cheap header metrics always, rasterize only
+     * on a glyph-bitmap cache miss */
+    if (fi->glyf_len) {
+        struct ttf_gmetrics gm;
+
+        if (ttf_glyph_metrics(fi, glyph_index, &gm) == 0) {
+            /* Anisotropic sizes are rare; only those skip the cache,
+             * since its key carries a single pixel size */
+            int cacheable = fi->pixel_width == fi->pixel_height;
+
+            set_slot_from_gmetrics(fi, glyph_index, &gm);
+
+            if (gm.width > 0 && gm.height > 0) {
+                unsigned int w = 0, h = 0;
+                const unsigned char *cached = cacheable ?
+                    vgr_bitmap_lookup(fi, fi->pixel_height, glyph_index,
+                                      &w, &h) : NULL;
+
+                if (cached && w == gm.width && h == gm.height) {
+                    memcpy(fi->bitmap_buf, cached, (size_t)w * h);
+                } else if (ttf_render_glyph(fi, glyph_index, &gm) == 0) {
+                    if (cacheable)
+                        vgr_bitmap_store(fi, fi->pixel_height, glyph_index,
+                                         fi->bitmap_buf,
+                                         gm.width, gm.height);
+                } else {
+                    memset(fi->bitmap_buf, 0,
+                           (size_t)gm.width * gm.height);
+                }
+            }
+
+            face->glyph = &fi->slot;
+            return FT_Err_Ok;
+        }
+    }
+
+    /* Fallback box glyphs (no usable sfnt data) */
+    {
+        unsigned int w = 0, h = 0;
+        const unsigned char *cached =
+            vgr_bitmap_lookup(fi, DEFAULT_GLYPH_HEIGHT, glyph_index, &w, &h);
+
+        if (cached && w == DEFAULT_GLYPH_WIDTH && h == DEFAULT_GLYPH_HEIGHT) {
+            memcpy(fi->bitmap_buf, cached, (size_t)w * h);
+            fill_glyph_metrics(fi, glyph_index);
+        } else {
+            fill_glyph_bitmap(fi, glyph_index);
+            vgr_bitmap_store(fi, DEFAULT_GLYPH_HEIGHT, glyph_index,
+                             fi->bitmap_buf,
+                             DEFAULT_GLYPH_WIDTH, DEFAULT_GLYPH_HEIGHT);
+        }
+    }
     face->glyph = &fi->slot;
 
     return FT_Err_Ok;
@@ -487,11 +1718,17 @@ FT_Error FT_Render_Glyph(FT_GlyphSlot slot, FT_Render_Mode render_mode)
 
 FT_UInt FT_Get_Char_Index(FT_Face face, FT_ULong charcode)
 {
+    struct ft_face_internal *fi;
+
     if (!face || charcode == 0)
         return 0;
 
-    /* Simple identity mapping: codepoint = glyph index (common for
-     * testing and stub implementations). Return 0 for undefined range. */
+    fi = face_from_ptr(face);
+    if (fi && fi->cmap_format)
+        return ttf_char_index(fi, charcode);
+
+    /* Fallback faces keep the identity mapping: codepoint = glyph
+     * index. Return 0 for the undefined range. */
     if (charcode > 0xFFFF)
         return 0;
 
@@ -594,10 +1831,7 @@ FT_Error FT_Get_Kerning(FT_Face face, FT_UInt left_glyph,
                           FT_UInt right_glyph, FT_UInt kern_mode,
                           FT_Vector *akerning)
 {
-    (void)face;
-    (void)left_glyph;
-    (void)right_glyph;
-    (void)kern_mode;
+    struct ft_face_internal *fi;
 
     if (!akerning)
         return FT_Err_Invalid_Argument;
@@ -605,6 +1839,38 @@ FT_Error FT_Get_Kerning(FT_Face face, FT_UInt left_glyph,
     akerning->x = 0;
     akerning->y = 0;
 
+    if (!face)
+        return FT_Err_Invalid_Face_Handle;
+
+    fi = face_from_ptr(face);
+    if (!fi || !fi->metrics || fi->metrics->kern_count == 0)
+        return FT_Err_Ok;
+
+    /* Binary search the shared sorted pair table */
+    {
+        const struct vfm_kern *kerns = vfm_kerns(fi->metrics);
+        FT_ULong key = ((FT_ULong)left_glyph << 16) | right_glyph;
+        FT_ULong lo = 0;
+        FT_ULong hi = fi->metrics->kern_count;
+
+        while (lo < hi) {
+            FT_ULong mid = (lo + hi) / 2;
+
+            if (kerns[mid].pair < key) {
+                lo = mid + 1;
+            } else if (kerns[mid].pair > key) {
+                hi = mid;
+            } else {
+                FT_Long v = kerns[mid].value;
+
+                if (kern_mode == FT_KERNING_UNSCALED)
+                    akerning->x = v;
+                else
+                    akerning->x = ttf_scale(fi, v, fi->pixel_height);
+                break;
+            }
+        }
+    }
     return FT_Err_Ok;
 }
 
@@ -726,40 +1992,35 @@ FT_Error FT_Bitmap_Embolden(FT_Library library, FT_Bitmap *bitmap,
 
 FT_Error FT_Get_Glyph(FT_GlyphSlot slot, FT_Glyph *aglyph)
 {
-    int i;
+    struct ft_glyph_internal *gi;
+    unsigned int sz = 0;
 
     if (!slot || !aglyph)
         return FT_Err_Invalid_Argument;
 
-    for (i = 0; i < MAX_GLYPHS; i++) {
-        if (!g_glyphs[i].in_use) {
-            struct ft_glyph_internal *gi = &g_glyphs[i];
-            gi->in_use = 1;
-
-            gi->base.library = slot->library;
-            gi->base.clazz   = NULL;
-            gi->base.format  = slot->format;
-            gi->base.advance = slot->advance;
-
-            /* Copy bitmap data */
-            gi->bm.root = gi->base;
-            gi->bm.left = slot->bitmap_left;
-            gi->bm.top  = slot->bitmap_top;
-            gi->bm.bitmap = slot->bitmap;
-
-            if (slot->bitmap.buffer && slot->bitmap.rows * slot->bitmap.width > 0) {
-                unsigned int sz = slot->bitmap.rows * (unsigned int)abs(slot->bitmap.pitch);
-                if (sz > sizeof(gi->bm_buf)) sz = sizeof(gi->bm_buf);
-                memcpy(gi->bm_buf, slot->bitmap.buffer, sz);
-                gi->bm.bitmap.buffer = gi->bm_buf;
-            }
+    if (slot->bitmap.buffer && slot->bitmap.rows * slot->bitmap.width > 0)
+        sz = slot->bitmap.rows * (unsigned int)abs(slot->bitmap.pitch);
 
-            *aglyph = (FT_Glyph)&gi->bm;
-            return FT_Err_Ok;
-        }
+    gi = (struct ft_glyph_internal *)malloc(sizeof(*gi) + sz);
+    if (!gi)
+        return FT_Err_Out_Of_Memory;
+
+    gi->bm.root.library = slot->library;
+    gi->bm.root.clazz   = NULL;
+    gi->bm.root.format  = slot->format;
+    gi->bm.root.advance = slot->advance;
+
+    gi->bm.left   = slot->bitmap_left;
+    gi->bm.top    = slot->bitmap_top;
+    gi->bm.bitmap = slot->bitmap;
+
+    if (sz > 0) {
+        memcpy(gi->bm_buf, slot->bitmap.buffer, sz);
+        gi->bm.bitmap.buffer = gi->bm_buf;
     }
 
-    return FT_Err_Out_Of_Memory;
+    *aglyph = (FT_Glyph)&gi->bm;
+    return FT_Err_Ok;
 }
 
 FT_Error FT_Glyph_Copy(FT_Glyph source, FT_Glyph *target)
@@ -781,14 +2042,27 @@ FT_Error FT_Glyph_Transform(FT_Glyph glyph, FT_Matrix *matrix,
 void FT_Glyph_Get_CBox(FT_Glyph glyph, FT_UInt bbox_mode,
                          FT_BBox *acbox)
 {
-    (void)glyph;
-    (void)bbox_mode;
+    const FT_BitmapGlyphRec *bg = (const FT_BitmapGlyphRec *)glyph;
 
-    if (acbox) {
-        acbox->xMin = 0;
-        acbox->yMin = 0;
-        acbox->xMax = DEFAULT_GLYPH_WIDTH * 64;
-        acbox->yMax = DEFAULT_GLYPH_HEIGHT * 64;
+    if (!acbox)
+        return;
+
+    if (!glyph) {
+        memset(acbox, 0, sizeof(*acbox));
+        return;
+    }
+
+    acbox->xMin = (FT_Pos)bg->left * 64;
+    acbox->xMax = (FT_Pos)(bg->left + (int)bg->bitmap.width) * 64;
+    acbox->yMax = (FT_Pos)bg->top * 64;
+    acbox->yMin = (FT_Pos)(bg->top - (int)bg->bitmap.rows) * 64;
+
+    if (bbox_mode == FT_GLYPH_BBOX_TRUNCATE ||
+        bbox_mode == FT_GLYPH_BBOX_PIXELS) {
+        acbox->xMin >>= 6;
+        acbox->yMin >>= 6;
+        acbox->xMax >>= 6;
+        acbox->yMax >>= 6;
     }
 }
 
@@ -810,19 +2084,9 @@ FT_Error FT_Glyph_To_Bitmap(FT_Glyph *the_glyph,
 
 void FT_Done_Glyph(FT_Glyph glyph)
 {
-    int i;
-
-    if (!glyph)
-        return;
-
-    for (i = 0; i < MAX_GLYPHS; i++) {
-        if (g_glyphs[i].in_use &&
-            ((FT_Glyph)&g_glyphs[i].base == glyph ||
-             (FT_Glyph)&g_glyphs[i].bm == glyph)) {
-            g_glyphs[i].in_use = 0;
-            return;
-        }
-    }
+    /* The handle is the allocation base (bm.root is the first member
+     * of ft_glyph_internal) */
+    free(glyph);
 }
 
 /* ========================================================================= */
@@ -13,8 +13,11 @@
 #include <GLES2/gl2.h>
 #include <GLES2/gl2ext.h>
 #include <GLES3/gl3.h>
+#include <veridian/glprogram.h>
+#include <pthread.h>
 #include <string.h>
 #include <stdlib.h>
+#include <unistd.h>
 
 /* ========================================================================= */
 /* Internal state                                                            */
@@ -99,6 +102,124 @@ static GLuint  g_bound_vertex_array   = 0;
 /* Line width */
 static GLfloat g_line_width = 1.0f;
 
+/* ========================================================================= */
+/* Tiled rasterizer state                                                    */
+/* ========================================================================= */
+
+/*
+ * Binning/tiling rasterizer.  Draw calls transform and bin triangles
+ * into 32x32 screen tiles; glFlush/glFinish rasterizes tile by tile so
+ * the color and depth working set stays cache-resident, and clears are
+ * applied per tile right before its triangles (no full-surface clear
+ * pass touching memory twice).  Coordinates are snapped to 28.4 fixed
+ * point and coverage uses integer edge functions with the top-left
+ * fill rule, so shared edges never gap or double-write.
+ */
+
+#define VGL_TILE_SIZE   32
+#define VGL_MAX_ATTRIBS 8
+
+struct vgl_attrib {
+    GLint       size;
+    GLenum      type;
+    GLsizei     stride;
+    const void *pointer;
+    GLboolean   normalized;
+    int         enabled;
+    GLfloat     current[4];     /* Generic value when array disabled */
+};
+
+static struct vgl_attrib g_attribs[VGL_MAX_ATTRIBS] = {
+    { 4, GL_FLOAT, 0, 0, GL_FALSE, 0, { 0, 0, 0, 1 } },
+    { 4, GL_FLOAT, 0, 0, GL_FALSE, 0, { 1, 1, 1, 1 } },
+    { 4, GL_FLOAT, 0, 0, GL_FALSE, 0, { 0, 0, 0, 1 } },
+    { 4, GL_FLOAT, 0, 0, GL_FALSE, 0, { 0, 0, 0, 1 } },
+    { 4, GL_FLOAT, 0, 0, GL_FALSE, 0, { 0, 0, 0, 1 } },
+    { 4, GL_FLOAT, 0, 0, GL_FALSE, 0, { 0, 0, 0, 1 } },
+    { 4, GL_FLOAT, 0, 0, GL_FALSE, 0, { 0, 0, 0, 1 } },
+    { 4, GL_FLOAT, 0, 0, GL_FALSE, 0, { 0, 0, 0, 1 } },
+};
+
+/* Render target (set by the EGL/GBM layer via the Veridian extension) */
+static uint32_t *g_rt_pixels;
+static GLsizei   g_rt_width;
+static GLsizei   g_rt_height;
+static GLsizei   g_rt_stride;       /* In pixels */
+static uint16_t *g_rt_depth;        /* Owned by the rasterizer */
+
+/* Binned triangle: 28.4 snapped positions, 16-bit depth, per-vertex
+ * premultiplied colors */
+struct vgl_tri {
+    int32_t  x[3];
+    int32_t  y[3];
+    uint16_t z[3];
+    uint32_t color[3];
+};
+
+static struct vgl_tri *g_tris;
+static int g_tri_count;
+static int g_tri_cap;
+
+/* Per-(tile, triangle) bin nodes: per-tile singly linked lists */
+struct vgl_bin_node {
+    int tri;
+    int next;
+};
+
+static struct vgl_bin_node *g_bin_nodes;
+static int  g_bin_node_count;
+static int  g_bin_node_cap;
+static int *g_tile_heads;           /* -1 terminated lists  */
+static int  g_tile_cols;
+static int  g_tile_rows;
+
+/*
+ * Tile worker pool.  Tiles are disjoint pixel regions and each tile
+ * replays its bin list in draw order, so workers write color and
+ * depth directly -- no private tiles, no resolve pass.  Workers are
+ * started lazily at the first flush and claim tile indices from a
+ * shared atomic counter, the same scheme as the KWin software
+ * renderer's pool.
+ */
+
+#define VGL_MAX_WORKERS 8
+
+static pthread_t g_vgl_workers[VGL_MAX_WORKERS];
+static int g_vgl_worker_count = -1;     /* -1 = pool not probed yet */
+static int g_vgl_pool_shutdown;
+static pthread_mutex_t g_vgl_pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_vgl_pool_start = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t g_vgl_pool_done = PTHREAD_COND_INITIALIZER;
+static unsigned g_vgl_pool_generation;
+static int g_vgl_pool_active;
+static int g_vgl_next_tile;             /* Atomic claim index */
+static int g_vgl_total_tiles;
+
+/* Deferred clear, applied per tile at flush time */
+static GLbitfield g_pending_clear;
+static uint32_t   g_clear_packed;
+static uint16_t   g_clear_depth16 = 0xffff;
+
+static int vgl_clamp255(int v)
+{
+    if (v < 0)
+        return 0;
+    return v > 255 ? 255 : v;
+}
+
+static uint32_t vgl_pack_color(const GLfloat *rgba)
+{
+    int r = vgl_clamp255((int)(rgba[0] * 255.0f + 0.5f));
+    int g = vgl_clamp255((int)(rgba[1] * 255.0f + 0.5f));
+    int b = vgl_clamp255((int)(rgba[2] * 255.0f + 0.5f));
+    int a = vgl_clamp255((int)(rgba[3] * 255.0f + 0.5f));
+
+    return ((uint32_t)a << 24) | ((uint32_t)r << 16) |
+           ((uint32_t)g << 8) | (uint32_t)b;
+}
+
+static void vgl_flush_frame(void);
+
 /* Depth range */
 static GLfloat g_depth_range[2] = { 0.0f, 1.0f };
 
@@ -117,12 +238,17 @@ struct shader_info {
     GLenum type;
     int    compiled;
     int    deleted;
+    uint64_t source_hash;   /* FNV of the source, for the binary cache */
 };
 
 struct program_info {
     GLuint id;
     int    linked;
     int    deleted;
+    GLuint attached[2];     /* Vertex + fragment shader ids */
+    int    attach_count;
+    uint64_t cache_key;     /* Combined source hash, 0 until link */
+    int    from_cache;      /* Linked via a cached program binary */
 };
 
 static struct shader_info  g_shaders[MAX_GL_SHADERS];
@@ -286,8 +412,14 @@ void glPolygonOffset(GLfloat factor, GLfloat units)
 
 void glClear(GLbitfield mask)
 {
-    (void)mask;
-    /* No-op in stub; kernel rasterizer would handle this */
+    /* Deferred: applied per tile at flush, right before that tile's
+     * triangles.  A clear issued mid-frame (after draws) flushes the
+     * pending work first so ordering is preserved. */
+    if (g_tri_count > 0)
+        vgl_flush_frame();
+
+    g_pending_clear |= mask;
+    g_clear_packed = vgl_pack_color(g_clear_color);
 }
 
 void glClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
@@ -647,6 +779,7 @@ GLuint glCreateShader(GLenum type)
     g_shaders[g_num_shaders].type     = type;
     g_shaders[g_num_shaders].compiled = 0;
     g_shaders[g_num_shaders].deleted  = 0;
+    g_shaders[g_num_shaders].source_hash = 0;
     g_num_shaders++;
 
     return g_shaders[g_num_shaders - 1].id;
@@ -661,8 +794,24 @@ void glDeleteShader(GLuint shader)
 void glShaderSource(GLuint shader, GLsizei count, const GLchar *const *string,
                     const GLint *length)
 {
-    (void)shader; (void)count; (void)string; (void)length;
-    /* Source is accepted but not stored */
+    struct shader_info *s = find_shader(shader);
+    uint64_t h = 0;
+    GLsizei i;
+
+    if (!s)
+        return;
+
+    /* The source itself is not retained -- only its hash, which keys
+     * the shared program-binary cache at link time */
+    for (i = 0; i < count && string; i++) {
+        if (!string[i])
+            continue;
+        h = vglp_hash_source(h, string[i],
+                             (length && length[i] >= 0)
+                                 ? (size_t)length[i]
+                                 : strlen(string[i]));
+    }
+    s->source_hash = h;
 }
 
 void glCompileShader(GLuint shader)
@@ -728,6 +877,9 @@ GLuint glCreateProgram(void)
     g_programs[g_num_programs].id      = g_next_program++;
     g_programs[g_num_programs].linked  = 0;
     g_programs[g_num_programs].deleted = 0;
+    g_programs[g_num_programs].attach_count = 0;
+    g_programs[g_num_programs].cache_key = 0;
+    g_programs[g_num_programs].from_cache = 0;
     g_num_programs++;
 
     return g_programs[g_num_programs - 1].id;
@@ -741,18 +893,65 @@ void glDeleteProgram(GLuint program)
 
 void glAttachShader(GLuint program, GLuint shader)
 {
-    (void)program; (void)shader;
+    struct program_info *p = find_program(program);
+
+    if (!p || p->attach_count >= 2)
+        return;
+    p->attached[p->attach_count++] = shader;
 }
 
 void glDetachShader(GLuint program, GLuint shader)
 {
-    (void)program; (void)shader;
+    struct program_info *p = find_program(program);
+    int i;
+
+    if (!p)
+        return;
+    for (i = 0; i < p->attach_count; i++) {
+        if (p->attached[i] == shader) {
+            p->attached[i] = p->attached[--p->attach_count];
+            return;
+        }
+    }
 }
 
 void glLinkProgram(GLuint program)
 {
     struct program_info *p = find_program(program);
-    if (p) p->linked = 1;
+    uint64_t key = 0;
+    int i;
+
+    if (!p)
+        return;
+
+    /* Key the shared binary cache on the combined source hashes of
+     * the attached shaders, smallest hash first so the key does not
+     * depend on attach order.  A hit skips the compile/link work on a
+     * real driver; the software path still records the key so a
+     * subsequent glGetProgramBinary can persist what the driver
+     * produced. */
+    {
+        uint64_t hashes[2] = { 0, 0 };
+        int n = 0;
+
+        for (i = 0; i < p->attach_count; i++) {
+            struct shader_info *s = find_shader(p->attached[i]);
+            if (s && s->source_hash)
+                hashes[n++] = s->source_hash;
+        }
+        if (n == 2 && hashes[0] > hashes[1]) {
+            uint64_t tmp = hashes[0];
+            hashes[0] = hashes[1];
+            hashes[1] = tmp;
+        }
+        for (i = 0; i < n; i++)
+            key = vglp_hash_source(key, (const char *)&hashes[i],
+                                   sizeof(hashes[i]));
+    }
+    p->cache_key = key;
+    p->from_cache =
+        key != 0 && vglp_cache_lookup(key, NULL, NULL, NULL);
+    p->linked = 1;
 }
 
 void glUseProgram(GLuint program)
@@ -918,16 +1117,29 @@ void glGetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize,
 }
 
 void glVertexAttrib1f(GLuint index, GLfloat x)
-{ (void)index; (void)x; }
+{
+    glVertexAttrib4f(index, x, 0.0f, 0.0f, 1.0f);
+}
 
 void glVertexAttrib2f(GLuint index, GLfloat x, GLfloat y)
-{ (void)index; (void)x; (void)y; }
+{
+    glVertexAttrib4f(index, x, y, 0.0f, 1.0f);
+}
 
 void glVertexAttrib3f(GLuint index, GLfloat x, GLfloat y, GLfloat z)
-{ (void)index; (void)x; (void)y; (void)z; }
+{
+    glVertexAttrib4f(index, x, y, z, 1.0f);
+}
 
 void glVertexAttrib4f(GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w)
-{ (void)index; (void)x; (void)y; (void)z; (void)w; }
+{
+    if (index >= VGL_MAX_ATTRIBS)
+        return;
+    g_attribs[index].current[0] = x;
+    g_attribs[index].current[1] = y;
+    g_attribs[index].current[2] = z;
+    g_attribs[index].current[3] = w;
+}
 
 void glVertexAttrib1fv(GLuint index, const GLfloat *v)
 { (void)index; (void)v; }
@@ -939,21 +1151,35 @@ void glVertexAttrib3fv(GLuint index, const GLfloat *v)
 { (void)index; (void)v; }
 
 void glVertexAttrib4fv(GLuint index, const GLfloat *v)
-{ (void)index; (void)v; }
+{
+    if (v)
+        glVertexAttrib4f(index, v[0], v[1], v[2], v[3]);
+}
 
 void glVertexAttribPointer(GLuint index, GLint size, GLenum type,
                            GLboolean normalized, GLsizei stride,
                            const void *pointer)
 {
-    (void)index; (void)size; (void)type;
-    (void)normalized; (void)stride; (void)pointer;
+    if (index >= VGL_MAX_ATTRIBS)
+        return;
+    g_attribs[index].size = size;
+    g_attribs[index].type = type;
+    g_attribs[index].normalized = normalized;
+    g_attribs[index].stride = stride;
+    g_attribs[index].pointer = pointer;
 }
 
 void glEnableVertexAttribArray(GLuint index)
-{ (void)index; }
+{
+    if (index < VGL_MAX_ATTRIBS)
+        g_attribs[index].enabled = 1;
+}
 
 void glDisableVertexAttribArray(GLuint index)
-{ (void)index; }
+{
+    if (index < VGL_MAX_ATTRIBS)
+        g_attribs[index].enabled = 0;
+}
 
 void glGetVertexAttribfv(GLuint index, GLenum pname, GLfloat *params)
 { (void)index; (void)pname; if (params) *params = 0.0f; }
@@ -964,19 +1190,517 @@ void glGetVertexAttribiv(GLuint index, GLenum pname, GLint *params)
 void glGetVertexAttribPointerv(GLuint index, GLenum pname, void **pointer)
 { (void)index; (void)pname; if (pointer) *pointer = NULL; }
 
+/* ========================================================================= */
+/* Tiled rasterizer core                                                     */
+/* ========================================================================= */
+
+/*
+ * Veridian extension: point the rasterizer at a CPU-visible surface.
+ * Called by the EGL/GBM layer on surface creation and resize.  The
+ * depth buffer is owned here and reallocated to match.
+ */
+void glVeridianSetRenderTarget(void *pixels, GLsizei width, GLsizei height,
+                               GLsizei stride_bytes)
+{
+    g_rt_pixels = (uint32_t *)pixels;
+    g_rt_width = width;
+    g_rt_height = height;
+    g_rt_stride = stride_bytes / 4;
+
+    free(g_rt_depth);
+    g_rt_depth = NULL;
+    free(g_tile_heads);
+    g_tile_heads = NULL;
+    g_tile_cols = 0;
+    g_tile_rows = 0;
+
+    if (!pixels || width <= 0 || height <= 0)
+        return;
+
+    g_rt_depth = malloc((size_t)width * (size_t)height * 2);
+    if (g_rt_depth)
+        memset(g_rt_depth, 0xff, (size_t)width * (size_t)height * 2);
+
+    g_tile_cols = (width + VGL_TILE_SIZE - 1) / VGL_TILE_SIZE;
+    g_tile_rows = (height + VGL_TILE_SIZE - 1) / VGL_TILE_SIZE;
+    g_tile_heads = malloc(sizeof(int) * (size_t)g_tile_cols *
+                          (size_t)g_tile_rows);
+    if (g_tile_heads) {
+        int i;
+        for (i = 0; i < g_tile_cols * g_tile_rows; i++)
+            g_tile_heads[i] = -1;
+    }
+}
+
+static void vgl_reset_bins(void)
+{
+    int i;
+
+    g_tri_count = 0;
+    g_bin_node_count = 0;
+    for (i = 0; i < g_tile_cols * g_tile_rows; i++)
+        g_tile_heads[i] = -1;
+}
+
+/* Append the triangle to every tile its bounding box overlaps */
+static void vgl_bin_triangle(int tri)
+{
+    const struct vgl_tri *t = &g_tris[tri];
+    int32_t minx = t->x[0], maxx = t->x[0];
+    int32_t miny = t->y[0], maxy = t->y[0];
+    int tx0, tx1, ty0, ty1, tx, ty;
+    int i;
+
+    for (i = 1; i < 3; i++) {
+        if (t->x[i] < minx) minx = t->x[i];
+        if (t->x[i] > maxx) maxx = t->x[i];
+        if (t->y[i] < miny) miny = t->y[i];
+        if (t->y[i] > maxy) maxy = t->y[i];
+    }
+
+    /* 28.4 -> pixels, clamped to the target */
+    tx0 = (minx >> 4) / VGL_TILE_SIZE;
+    ty0 = (miny >> 4) / VGL_TILE_SIZE;
+    tx1 = ((maxx + 15) >> 4) / VGL_TILE_SIZE;
+    ty1 = ((maxy + 15) >> 4) / VGL_TILE_SIZE;
+    if (tx0 < 0) tx0 = 0;
+    if (ty0 < 0) ty0 = 0;
+    if (tx1 >= g_tile_cols) tx1 = g_tile_cols - 1;
+    if (ty1 >= g_tile_rows) ty1 = g_tile_rows - 1;
+
+    for (ty = ty0; ty <= ty1; ty++) {
+        for (tx = tx0; tx <= tx1; tx++) {
+            struct vgl_bin_node *node;
+            int slot = ty * g_tile_cols + tx;
+
+            if (g_bin_node_count >= g_bin_node_cap) {
+                int cap = g_bin_node_cap ? g_bin_node_cap * 2 : 1024;
+                void *grown = realloc(g_bin_nodes,
+                                      sizeof(*g_bin_nodes) * (size_t)cap);
+                if (!grown)
+                    return;
+                g_bin_nodes = grown;
+                g_bin_node_cap = cap;
+            }
+            node = &g_bin_nodes[g_bin_node_count];
+            node->tri = tri;
+            node->next = g_tile_heads[slot];
+            g_tile_heads[slot] = g_bin_node_count++;
+        }
+    }
+}
+
+/* Top-left fill rule: edges that are exactly on a pixel center own it
+ * only when they are a top or left edge */
+static int vgl_edge_bias(int32_t dx, int32_t dy)
+{
+    return (dy > 0 || (dy == 0 && dx < 0)) ? 0 : -1;
+}
+
+static uint8_t vgl_lerp_channel(uint32_t c0, uint32_t c1, uint32_t c2,
+                                int shift, int64_t w0, int64_t w1,
+                                int64_t w2, int64_t area)
+{
+    int64_t v = (int64_t)((c0 >> shift) & 0xff) * w0 +
+                (int64_t)((c1 >> shift) & 0xff) * w1 +
+                (int64_t)((c2 >> shift) & 0xff) * w2;
+    return (uint8_t)(v / area);
+}
+
+/* Rasterize one binned triangle clipped to a tile rect (pixels) */
+static void vgl_raster_tri_tile(const struct vgl_tri *t,
+                                int px0, int py0, int px1, int py1)
+{
+    int32_t x0 = t->x[0], y0 = t->y[0];
+    int32_t x1 = t->x[1], y1 = t->y[1];
+    int32_t x2 = t->x[2], y2 = t->y[2];
+    int64_t area = (int64_t)(x1 - x0) * (y2 - y0) -
+                   (int64_t)(y1 - y0) * (x2 - x0);
+    int depth_test = g_cap_depth_test == GL_TRUE;
+    int px, py;
+
+    if (area <= 0)
+        return;                 /* Degenerate; winding fixed at emit */
+
+    for (py = py0; py < py1; py++) {
+        /* Pixel center at +0.5: 28.4 coordinate py*16 + 8 */
+        int32_t sy = py * 16 + 8;
+
+        for (px = px0; px < px1; px++) {
+            int32_t sx = px * 16 + 8;
+            int64_t w0 = (int64_t)(x2 - x1) * (sy - y1) -
+                         (int64_t)(y2 - y1) * (sx - x1);
+            int64_t w1 = (int64_t)(x0 - x2) * (sy - y2) -
+                         (int64_t)(y0 - y2) * (sx - x2);
+            int64_t w2 = (int64_t)(x1 - x0) * (sy - y0) -
+                         (int64_t)(y1 - y0) * (sx - x0);
+
+            if (w0 + vgl_edge_bias(x2 - x1, y2 - y1) < 0 ||
+                w1 + vgl_edge_bias(x0 - x2, y0 - y2) < 0 ||
+                w2 + vgl_edge_bias(x1 - x0, y1 - y0) < 0)
+                continue;
+
+            if (depth_test && g_rt_depth) {
+                int64_t z = (int64_t)t->z[0] * w0 + (int64_t)t->z[1] * w1 +
+                            (int64_t)t->z[2] * w2;
+                uint16_t z16 = (uint16_t)(z / area);
+                uint16_t *dp = &g_rt_depth[(size_t)py * g_rt_width + px];
+
+                if (z16 > *dp)
+                    continue;
+                *dp = z16;
+            }
+
+            {
+                uint32_t pix =
+                    ((uint32_t)vgl_lerp_channel(t->color[0], t->color[1],
+                                                t->color[2], 24, w0, w1,
+                                                w2, area) << 24) |
+                    ((uint32_t)vgl_lerp_channel(t->color[0], t->color[1],
+                                                t->color[2], 16, w0, w1,
+                                                w2, area) << 16) |
+                    ((uint32_t)vgl_lerp_channel(t->color[0], t->color[1],
+                                                t->color[2], 8, w0, w1,
+                                                w2, area) << 8) |
+                    (uint32_t)vgl_lerp_channel(t->color[0], t->color[1],
+                                               t->color[2], 0, w0, w1,
+                                               w2, area);
+                g_rt_pixels[(size_t)py * g_rt_stride + px] = pix;
+            }
+        }
+    }
+}
+
+/* Clear one tile's color/depth (the per-tile early clear) */
+static void vgl_clear_tile(int px0, int py0, int px1, int py1)
+{
+    int py, px;
+
+    if ((g_pending_clear & GL_COLOR_BUFFER_BIT) && g_rt_pixels) {
+        for (py = py0; py < py1; py++) {
+            uint32_t *row = &g_rt_pixels[(size_t)py * g_rt_stride];
+            for (px = px0; px < px1; px++)
+                row[px] = g_clear_packed;
+        }
+    }
+    if ((g_pending_clear & GL_DEPTH_BUFFER_BIT) && g_rt_depth) {
+        for (py = py0; py < py1; py++) {
+            uint16_t *row = &g_rt_depth[(size_t)py * g_rt_width];
+            for (px = px0; px < px1; px++)
+                row[px] = g_clear_depth16;
+        }
+    }
+}
+
+/*
+ * Rasterize the frame: visit every tile once, clear it if a clear is
+ * pending, then draw its binned triangles.  The tile's color and
+ * depth rows are touched repeatedly while hot instead of once per
+ * triangle across the whole surface.
+ */
+/* Clear and rasterize one tile by flat index (row-major) */
+static void vgl_process_tile(int tile)
+{
+    int tx = tile % g_tile_cols;
+    int ty = tile / g_tile_cols;
+    int px0 = tx * VGL_TILE_SIZE;
+    int py0 = ty * VGL_TILE_SIZE;
+    int px1 = px0 + VGL_TILE_SIZE;
+    int py1 = py0 + VGL_TILE_SIZE;
+    int node = g_tile_heads[tile];
+
+    if (px1 > g_rt_width) px1 = g_rt_width;
+    if (py1 > g_rt_height) py1 = g_rt_height;
+
+    if (g_pending_clear)
+        vgl_clear_tile(px0, py0, px1, py1);
+
+    /* Bin lists are LIFO: reverse into draw order */
+    {
+        int order[256];
+        int n = 0;
+
+        while (node >= 0 && n < 256) {
+            order[n++] = g_bin_nodes[node].tri;
+            node = g_bin_nodes[node].next;
+        }
+        while (n > 0)
+            vgl_raster_tri_tile(&g_tris[order[--n]],
+                                px0, py0, px1, py1);
+        /* Overflow beyond 256 binned triangles per tile falls
+         * back to unreversed order for the remainder */
+        while (node >= 0) {
+            vgl_raster_tri_tile(&g_tris[g_bin_nodes[node].tri],
+                                px0, py0, px1, py1);
+            node = g_bin_nodes[node].next;
+        }
+    }
+}
+
+/* Claim tiles from the shared counter until none remain */
+static void vgl_drain_tiles(void)
+{
+    for (;;) {
+        int tile = __atomic_fetch_add(&g_vgl_next_tile, 1,
+                                      __ATOMIC_RELAXED);
+        if (tile >= g_vgl_total_tiles)
+            break;
+        vgl_process_tile(tile);
+    }
+}
+
+static void *vgl_worker_main(void *arg)
+{
+    unsigned seen_generation = 0;
+
+    (void)arg;
+    for (;;) {
+        pthread_mutex_lock(&g_vgl_pool_mutex);
+        while (seen_generation == g_vgl_pool_generation &&
+               !g_vgl_pool_shutdown)
+            pthread_cond_wait(&g_vgl_pool_start, &g_vgl_pool_mutex);
+        if (g_vgl_pool_shutdown) {
+            pthread_mutex_unlock(&g_vgl_pool_mutex);
+            return NULL;
+        }
+        seen_generation = g_vgl_pool_generation;
+        pthread_mutex_unlock(&g_vgl_pool_mutex);
+
+        vgl_drain_tiles();
+
+        pthread_mutex_lock(&g_vgl_pool_mutex);
+        if (--g_vgl_pool_active == 0)
+            pthread_cond_signal(&g_vgl_pool_done);
+        pthread_mutex_unlock(&g_vgl_pool_mutex);
+    }
+}
+
+/* One worker per spare core (bounded); VGL_THREADS=1 forces serial */
+static void vgl_pool_start(void)
+{
+    long ncpu;
+    const char *env;
+    int want, i;
+
+    if (g_vgl_worker_count >= 0)
+        return;
+
+    ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    want = (int)(ncpu > 1 ? ncpu - 1 : 0);
+    env = getenv("VGL_THREADS");
+    if (env && env[0])
+        want = atoi(env) - 1;
+    if (want > VGL_MAX_WORKERS)
+        want = VGL_MAX_WORKERS;
+    if (want < 0)
+        want = 0;
+
+    g_vgl_worker_count = 0;
+    for (i = 0; i < want; i++) {
+        if (pthread_create(&g_vgl_workers[i], NULL,
+                           vgl_worker_main, NULL) != 0)
+            break;
+        g_vgl_worker_count++;
+    }
+}
+
+static void vgl_flush_frame(void)
+{
+    if (!g_rt_pixels || !g_tile_heads)
+        return;
+    if (!g_pending_clear && g_tri_count == 0)
+        return;
+
+    vgl_pool_start();
+
+    g_vgl_total_tiles = g_tile_cols * g_tile_rows;
+    __atomic_store_n(&g_vgl_next_tile, 0, __ATOMIC_RELAXED);
+
+    if (g_vgl_worker_count > 0) {
+        pthread_mutex_lock(&g_vgl_pool_mutex);
+        g_vgl_pool_active = g_vgl_worker_count;
+        g_vgl_pool_generation++;
+        pthread_cond_broadcast(&g_vgl_pool_start);
+        pthread_mutex_unlock(&g_vgl_pool_mutex);
+    }
+
+    /* The calling thread drains alongside the workers */
+    vgl_drain_tiles();
+
+    if (g_vgl_worker_count > 0) {
+        pthread_mutex_lock(&g_vgl_pool_mutex);
+        while (g_vgl_pool_active > 0)
+            pthread_cond_wait(&g_vgl_pool_done, &g_vgl_pool_mutex);
+        pthread_mutex_unlock(&g_vgl_pool_mutex);
+    }
+
+    g_pending_clear = 0;
+    vgl_reset_bins();
+}
+
+/* Fetch one attribute for vertex v (array if enabled, generic value
+ * otherwise).  Only GL_FLOAT arrays feed the rasterizer. */
+static void vgl_fetch_attrib(const struct vgl_attrib *a, GLint v,
+                             GLfloat *out)
+{
+    out[0] = 0.0f;
+    out[1] = 0.0f;
+    out[2] = 0.0f;
+    out[3] = 1.0f;
+
+    if (!a->enabled || !a->pointer || a->type != GL_FLOAT) {
+        out[0] = a->current[0];
+        out[1] = a->current[1];
+        out[2] = a->current[2];
+        out[3] = a->current[3];
+        return;
+    }
+
+    {
+        GLsizei stride = a->stride ? a->stride
+                                   : a->size * (GLsizei)sizeof(GLfloat);
+        const GLfloat *src = (const GLfloat *)
+            ((const char *)a->pointer + (size_t)stride * (size_t)v);
+        GLint i;
+
+        for (i = 0; i < a->size && i < 4; i++)
+            out[i] = src[i];
+    }
+}
+
+/* Transform, snap, and bin one triangle given three vertex indices */
+static void vgl_emit_triangle(GLint v0, GLint v1, GLint v2)
+{
+    GLint verts[3];
+    struct vgl_tri tri;
+    int i;
+
+    verts[0] = v0;
+    verts[1] = v1;
+    verts[2] = v2;
+
+    if (g_tri_count >= g_tri_cap) {
+        int cap = g_tri_cap ? g_tri_cap * 2 : 512;
+        void *grown = realloc(g_tris, sizeof(*g_tris) * (size_t)cap);
+        if (!grown)
+            return;
+        g_tris = grown;
+        g_tri_cap = cap;
+    }
+
+    for (i = 0; i < 3; i++) {
+        GLfloat pos[4];
+        GLfloat col[4];
+        GLfloat w;
+        GLfloat sx, sy, sz;
+
+        vgl_fetch_attrib(&g_attribs[0], verts[i], pos);
+        vgl_fetch_attrib(&g_attribs[1], verts[i], col);
+
+        /* Clip-space -> NDC -> viewport.  No near-plane clipping: the
+         * scene-graph workloads this serves draw screen-aligned quads
+         * with w == 1. */
+        w = (pos[3] != 0.0f) ? pos[3] : 1.0f;
+        sx = (pos[0] / w * 0.5f + 0.5f) * (GLfloat)g_viewport[2] +
+             (GLfloat)g_viewport[0];
+        sy = (pos[1] / w * -0.5f + 0.5f) * (GLfloat)g_viewport[3] +
+             (GLfloat)g_viewport[1];
+        sz = pos[2] / w * 0.5f + 0.5f;
+        if (sz < 0.0f) sz = 0.0f;
+        if (sz > 1.0f) sz = 1.0f;
+
+        tri.x[i] = (int32_t)(sx * 16.0f + (sx >= 0 ? 0.5f : -0.5f));
+        tri.y[i] = (int32_t)(sy * 16.0f + (sy >= 0 ? 0.5f : -0.5f));
+        tri.z[i] = (uint16_t)(sz * 65535.0f);
+        tri.color[i] = vgl_pack_color(col);
+    }
+
+    /* Normalize winding here so the rasterizer's edge functions are
+     * all-positive inside and vertex attributes stay attributed */
+    {
+        int64_t area = (int64_t)(tri.x[1] - tri.x[0]) *
+                           (tri.y[2] - tri.y[0]) -
+                       (int64_t)(tri.y[1] - tri.y[0]) *
+                           (tri.x[2] - tri.x[0]);
+        if (area == 0)
+            return;
+        if (area < 0) {
+            int32_t ti;
+            uint16_t tz;
+            uint32_t tc;
+
+            ti = tri.x[1]; tri.x[1] = tri.x[2]; tri.x[2] = ti;
+            ti = tri.y[1]; tri.y[1] = tri.y[2]; tri.y[2] = ti;
+            tz = tri.z[1]; tri.z[1] = tri.z[2]; tri.z[2] = tz;
+            tc = tri.color[1]; tri.color[1] = tri.color[2];
+            tri.color[2] = tc;
+        }
+    }
+
+    g_tris[g_tri_count] = tri;
+    vgl_bin_triangle(g_tri_count);
+    g_tri_count++;
+}
+
 /* ========================================================================= */
 /* Drawing                                                                   */
 /* ========================================================================= */
 
 void glDrawArrays(GLenum mode, GLint first, GLsizei count)
 {
-    (void)mode; (void)first; (void)count;
+    GLsizei i;
+
+    if (!g_rt_pixels || count < 3)
+        return;
+
+    switch (mode) {
+    case GL_TRIANGLES:
+        for (i = 0; i + 2 < count; i += 3)
+            vgl_emit_triangle(first + i, first + i + 1, first + i + 2);
+        break;
+    case GL_TRIANGLE_STRIP:
+        for (i = 0; i + 2 < count; i++) {
+            if (i & 1)
+                vgl_emit_triangle(first + i + 1, first + i, first + i + 2);
+            else
+                vgl_emit_triangle(first + i, first + i + 1, first + i + 2);
+        }
+        break;
+    case GL_TRIANGLE_FAN:
+        for (i = 1; i + 1 < count; i++)
+            vgl_emit_triangle(first, first + i, first + i + 1);
+        break;
+    default:
+        break;                          /* Points/lines: not rasterized */
+    }
 }
 
 void glDrawElements(GLenum mode, GLsizei count, GLenum type,
                     const void *indices)
 {
-    (void)mode; (void)count; (void)type; (void)indices;
+    GLsizei i;
+
+    if (!g_rt_pixels || !indices || count < 3 || mode != GL_TRIANGLES)
+        return;
+
+    for (i = 0; i + 2 < count; i += 3) {
+        GLint v0, v1, v2;
+
+        if (type == GL_UNSIGNED_SHORT) {
+            const GLushort *idx = (const GLushort *)indices;
+            v0 = idx[i]; v1 = idx[i + 1]; v2 = idx[i + 2];
+        } else if (type == GL_UNSIGNED_BYTE) {
+            const GLubyte *idx = (const GLubyte *)indices;
+            v0 = idx[i]; v1 = idx[i + 1]; v2 = idx[i + 2];
+        } else if (type == GL_UNSIGNED_INT) {
+            const GLuint *idx = (const GLuint *)indices;
+            v0 = (GLint)idx[i]; v1 = (GLint)idx[i + 1];
+            v2 = (GLint)idx[i + 2];
+        } else {
+            return;
+        }
+        vgl_emit_triangle(v0, v1, v2);
+    }
 }
 
 /* ========================================================================= */
@@ -1258,12 +1982,12 @@ void glHint(GLenum target, GLenum mode)
 
 void glFlush(void)
 {
-    /* No-op */
+    vgl_flush_frame();
 }
 
 void glFinish(void)
 {
-    /* No-op */
+    vgl_flush_frame();
 }
 
 /* ========================================================================= */
@@ -1549,12 +2273,43 @@ void glUniform4ui(GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3)
 
 void glGetProgramBinary(GLuint program, GLsizei bufSize, GLsizei *length,
                         GLenum *binaryFormat, void *binary)
-{ (void)program; (void)bufSize; (void)binary;
-  if (length) *length = 0; if (binaryFormat) *binaryFormat = 0; }
+{
+    struct program_info *p = find_program(program);
+    uint32_t fmt = 0;
+    uint32_t len = 0;
+    const void *data = NULL;
+
+    if (length) *length = 0;
+    if (binaryFormat) *binaryFormat = 0;
+
+    if (!p || !p->cache_key)
+        return;
+    if (!vglp_cache_lookup(p->cache_key, &fmt, &data, &len))
+        return;
+    if (binary && bufSize >= (GLsizei)len && len > 0)
+        memcpy(binary, data, len);
+    if (length) *length = (GLsizei)len;
+    if (binaryFormat) *binaryFormat = (GLenum)fmt;
+}
 
 void glProgramBinary(GLuint program, GLenum binaryFormat,
                      const void *binary, GLsizei length)
-{ (void)program; (void)binaryFormat; (void)binary; (void)length; }
+{
+    struct program_info *p = find_program(program);
+
+    if (!p || length < 0)
+        return;
+
+    /* Persist into the shared cache under the program's source key so
+     * every later process (and concurrent app starts, through the
+     * shared mapping) links from the binary */
+    if (p->cache_key && binary) {
+        vglp_cache_store(p->cache_key, (uint32_t)binaryFormat,
+                         binary, (uint32_t)length);
+    }
+    p->linked = 1;
+    p->from_cache = 1;
+}
 
 void glProgramParameteri(GLuint program, GLenum pname, GLint value)
 { (void)program; (void)pname; (void)value; }
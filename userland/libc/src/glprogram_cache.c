@@ -0,0 +1,332 @@
+/*
+ * VeridianOS libc -- glprogram_cache.c
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Shared GL program-binary cache (veridian/glprogram.h).
+ *
+ * One per-user file, mapped MAP_SHARED by every GL process: a fixed
+ * slot table keyed by shader-source hash in front of a bump-allocated
+ * blob arena.  The mapping is the cache -- persistence and cross-
+ * process sharing come for free from the page cache, so concurrent
+ * app starts never duplicate a compile.
+ *
+ * Concurrency uses the magic-last publication pattern: writers claim
+ * a slot by CASing its key to a busy sentinel, fill in the blob and
+ * metadata, then release-store the real key.  Readers acquire-load
+ * the key first, so they either see a complete entry or none.  A
+ * driver-identity mismatch (upgrade) resets the table in place.
+ */
+
+#include <veridian/glprogram.h>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* ========================================================================= */
+/* On-disk / in-mapping layout                                               */
+/* ========================================================================= */
+
+#define VGLP_MAGIC      0x434c4756u     /* 'VGLC' */
+#define VGLP_VERSION    1u
+#define VGLP_SLOTS      256u
+#define VGLP_ARENA_SIZE (4u * 1024u * 1024u)
+#define VGLP_KEY_BUSY   1u              /* Never a real FNV result seed */
+
+struct vglp_slot {
+    uint64_t key;                       /* 0 = empty, 1 = being filled */
+    uint32_t format;
+    uint32_t offset;                    /* Into the arena              */
+    uint32_t length;
+    uint32_t _pad;
+};
+
+struct vglp_header {
+    uint32_t magic;                     /* Stored last on creation     */
+    uint32_t version;
+    uint64_t driver_hash;
+    uint32_t arena_used;                /* Bump pointer (atomic)       */
+    uint32_t _pad;
+    struct vglp_slot slots[VGLP_SLOTS];
+};
+
+#define VGLP_FILE_SIZE \
+    (sizeof(struct vglp_header) + VGLP_ARENA_SIZE)
+
+/* ========================================================================= */
+/* Global state                                                              */
+/* ========================================================================= */
+
+static struct vglp_header *g_vglp;      /* NULL when unavailable */
+static int g_vglp_fd = -1;
+static int g_vglp_refs;                 /* init/shutdown nesting */
+
+static uint32_t g_vglp_hits;
+static uint32_t g_vglp_misses;
+static uint32_t g_vglp_stores;
+
+/* ========================================================================= */
+/* Helpers                                                                   */
+/* ========================================================================= */
+
+uint64_t vglp_hash_source(uint64_t seed, const char *src, size_t len)
+{
+    uint64_t h = seed ? seed : 0xcbf29ce484222325ULL;
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        h ^= (unsigned char)src[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+static unsigned char *vglp_arena(void)
+{
+    return (unsigned char *)g_vglp + sizeof(struct vglp_header);
+}
+
+/* Probe for a published entry; NULL on miss.  Stops at the first
+ * empty slot (busy sentinels keep the chain alive). */
+static struct vglp_slot *vglp_find(uint64_t key)
+{
+    uint32_t i;
+
+    for (i = 0; i < VGLP_SLOTS; i++) {
+        struct vglp_slot *slot =
+            &g_vglp->slots[(key + i) % VGLP_SLOTS];
+        uint64_t slot_key =
+            __atomic_load_n(&slot->key, __ATOMIC_ACQUIRE);
+
+        if (slot_key == 0)
+            return NULL;
+        if (slot_key == key)
+            return slot;
+    }
+    return NULL;
+}
+
+/* $XDG_CACHE_HOME/veridian, $HOME/.cache/veridian, or /tmp */
+static void vglp_cache_path(char *buf, size_t buf_len)
+{
+    const char *xdg = getenv("XDG_CACHE_HOME");
+    const char *home;
+
+    if (xdg && xdg[0]) {
+        snprintf(buf, buf_len, "%s/veridian", xdg);
+        return;
+    }
+    home = getenv("HOME");
+    if (home && home[0]) {
+        snprintf(buf, buf_len, "%s/.cache/veridian", home);
+        return;
+    }
+    snprintf(buf, buf_len, "/tmp");
+}
+
+/* Zero the table and republish for a new driver identity.  Readers
+ * racing the reset see either the old consistent table or empty
+ * slots -- both are safe (worst case a stale-driver hit is lost). */
+static void vglp_reset(uint64_t driver_hash)
+{
+    uint32_t i;
+
+    __atomic_store_n(&g_vglp->magic, 0, __ATOMIC_RELEASE);
+    for (i = 0; i < VGLP_SLOTS; i++)
+        __atomic_store_n(&g_vglp->slots[i].key, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_vglp->arena_used, 0, __ATOMIC_RELAXED);
+    g_vglp->version = VGLP_VERSION;
+    g_vglp->driver_hash = driver_hash;
+    __atomic_store_n(&g_vglp->magic, VGLP_MAGIC, __ATOMIC_RELEASE);
+}
+
+/* ========================================================================= */
+/* Lifecycle                                                                 */
+/* ========================================================================= */
+
+int vglp_cache_init(const char *driver_id)
+{
+    char dir[256];
+    char path[512];
+    uint64_t driver_hash;
+    struct stat st;
+    void *map;
+
+    if (g_vglp) {
+        g_vglp_refs++;
+        return 0;
+    }
+
+    driver_hash = vglp_hash_source(0, driver_id ? driver_id : "unknown",
+                                   driver_id ? strlen(driver_id) : 7);
+
+    vglp_cache_path(dir, sizeof(dir));
+    {
+        /* Create the parent (~/.cache) and leaf; EEXIST is fine */
+        char *slash = strrchr(dir, '/');
+        if (slash && slash != dir) {
+            *slash = '\0';
+            mkdir(dir, 0700);
+            *slash = '/';
+        }
+    }
+    mkdir(dir, 0700);
+    snprintf(path, sizeof(path), "%s/glprograms.cache", dir);
+
+    g_vglp_fd = open(path, O_RDWR | O_CREAT, 0600);
+    if (g_vglp_fd < 0)
+        return -1;
+
+    if (fstat(g_vglp_fd, &st) < 0 ||
+        (st.st_size != 0 && st.st_size != (off_t)VGLP_FILE_SIZE)) {
+        /* Layout change from an older build: start over */
+        if (ftruncate(g_vglp_fd, 0) < 0) {
+            close(g_vglp_fd);
+            g_vglp_fd = -1;
+            return -1;
+        }
+        st.st_size = 0;
+    }
+
+    if (st.st_size == 0 && ftruncate(g_vglp_fd, VGLP_FILE_SIZE) < 0) {
+        close(g_vglp_fd);
+        g_vglp_fd = -1;
+        return -1;
+    }
+
+    map = mmap(NULL, VGLP_FILE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED,
+               g_vglp_fd, 0);
+    if (map == MAP_FAILED) {
+        close(g_vglp_fd);
+        g_vglp_fd = -1;
+        return -1;
+    }
+    g_vglp = (struct vglp_header *)map;
+
+    if (__atomic_load_n(&g_vglp->magic, __ATOMIC_ACQUIRE) != VGLP_MAGIC ||
+        g_vglp->version != VGLP_VERSION ||
+        g_vglp->driver_hash != driver_hash) {
+        vglp_reset(driver_hash);
+    }
+
+    g_vglp_refs = 1;
+    return 0;
+}
+
+void vglp_cache_shutdown(void)
+{
+    /* Balanced with init: several GL contexts in one process share
+     * the mapping; only the last shutdown unmaps it */
+    if (g_vglp_refs > 1) {
+        g_vglp_refs--;
+        return;
+    }
+    g_vglp_refs = 0;
+
+    if (g_vglp) {
+        munmap(g_vglp, VGLP_FILE_SIZE);
+        g_vglp = NULL;
+    }
+    if (g_vglp_fd >= 0) {
+        close(g_vglp_fd);
+        g_vglp_fd = -1;
+    }
+}
+
+/* ========================================================================= */
+/* Lookup / store                                                            */
+/* ========================================================================= */
+
+int vglp_cache_lookup(uint64_t key, uint32_t *out_format,
+                      const void **out_data, uint32_t *out_len)
+{
+    struct vglp_slot *slot;
+
+    if (!g_vglp || key == 0 || key == VGLP_KEY_BUSY) {
+        g_vglp_misses++;
+        return 0;
+    }
+
+    slot = vglp_find(key);
+    if (!slot) {
+        g_vglp_misses++;
+        return 0;
+    }
+
+    if (out_format)
+        *out_format = slot->format;
+    if (out_data)
+        *out_data = vglp_arena() + slot->offset;
+    if (out_len)
+        *out_len = slot->length;
+    g_vglp_hits++;
+    return 1;
+}
+
+int vglp_cache_store(uint64_t key, uint32_t format,
+                     const void *data, uint32_t len)
+{
+    uint32_t aligned;
+    uint32_t offset;
+    uint32_t i;
+
+    if (!g_vglp || key == 0 || key == VGLP_KEY_BUSY)
+        return -1;
+    if (len > VGLP_ARENA_SIZE)
+        return -1;
+
+    if (vglp_find(key))
+        return 0;                       /* Already cached */
+
+    /* Claim arena space */
+    aligned = (len + 7u) & ~7u;
+    offset = __atomic_fetch_add(&g_vglp->arena_used, aligned,
+                                __ATOMIC_RELAXED);
+    if (offset + aligned > VGLP_ARENA_SIZE) {
+        __atomic_fetch_sub(&g_vglp->arena_used, aligned, __ATOMIC_RELAXED);
+        return -1;
+    }
+
+    if (len > 0)
+        memcpy(vglp_arena() + offset, data, len);
+
+    /* Claim a slot, publish the key last */
+    for (i = 0; i < VGLP_SLOTS; i++) {
+        struct vglp_slot *slot =
+            &g_vglp->slots[(key + i) % VGLP_SLOTS];
+        uint64_t expected = 0;
+
+        if (__atomic_load_n(&slot->key, __ATOMIC_RELAXED) == key)
+            return 0;                   /* Raced store of the same key */
+
+        if (__atomic_compare_exchange_n(&slot->key, &expected,
+                                        VGLP_KEY_BUSY, 0,
+                                        __ATOMIC_ACQUIRE,
+                                        __ATOMIC_RELAXED)) {
+            slot->format = format;
+            slot->offset = offset;
+            slot->length = len;
+            __atomic_store_n(&slot->key, key, __ATOMIC_RELEASE);
+            g_vglp_stores++;
+            return 0;
+        }
+    }
+
+    return -1;                          /* Table full */
+}
+
+void vglp_cache_stats(uint32_t *hits, uint32_t *misses, uint32_t *stores)
+{
+    if (hits)
+        *hits = g_vglp_hits;
+    if (misses)
+        *misses = g_vglp_misses;
+    if (stores)
+        *stores = g_vglp_stores;
+}
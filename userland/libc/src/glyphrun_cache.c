@@ -0,0 +1,352 @@
+/*
+ * VeridianOS libc -- glyphrun_cache.c
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Shaped-glyph-run and rendered-bitmap cache (veridian/glyphrun.h).
+ *
+ * A single hash table with chained buckets holds both entry kinds;
+ * an intrusive doubly-linked list tracks recency.  Insertions that
+ * push the resident size past the byte budget evict from the LRU
+ * tail.  Text is keyed by a 64-bit FNV-1a hash of the codepoints --
+ * runs additionally verify length so hash collisions can only alias
+ * runs of identical length and hash (accepted risk, matches what
+ * the full HarfBuzz run cache does).
+ */
+
+#include <veridian/glyphrun.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ========================================================================= */
+/* Internal structures                                                       */
+/* ========================================================================= */
+
+#define VGR_BUCKETS        256
+#define VGR_DEFAULT_BUDGET (512 * 1024)
+
+enum vgr_kind {
+    VGR_KIND_RUN,
+    VGR_KIND_BITMAP,
+};
+
+struct vgr_entry {
+    struct vgr_entry *hash_next;
+    struct vgr_entry *lru_prev;
+    struct vgr_entry *lru_next;
+
+    const void   *face;
+    unsigned int  size_px;
+    uint64_t      key;          /* text hash, or glyph index        */
+    unsigned int  kind;
+
+    /* Run payload */
+    vgr_glyph_t  *glyphs;
+    unsigned int  glyph_count;
+    unsigned int  text_len;
+
+    /* Bitmap payload */
+    unsigned char *bitmap;
+    unsigned int   width;
+    unsigned int   height;
+
+    size_t         bytes;       /* Total footprint incl. entry      */
+};
+
+/* ========================================================================= */
+/* Global state                                                              */
+/* ========================================================================= */
+
+static struct vgr_entry *g_buckets[VGR_BUCKETS];
+static struct vgr_entry *g_lru_head;    /* Most recently used  */
+static struct vgr_entry *g_lru_tail;    /* Eviction candidate  */
+static size_t g_bytes;
+static size_t g_budget = VGR_DEFAULT_BUDGET;
+
+/* ========================================================================= */
+/* Internal helpers                                                          */
+/* ========================================================================= */
+
+static uint64_t vgr_hash_text(const uint32_t *text, unsigned int len)
+{
+    /* FNV-1a over the codepoint stream */
+    uint64_t h = 14695981039346656037ULL;
+    unsigned int i;
+
+    for (i = 0; i < len; i++) {
+        h ^= text[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static unsigned int vgr_bucket_index(const void *face, unsigned int size_px,
+                                     uint64_t key, unsigned int kind)
+{
+    uint64_t h = (uint64_t)(uintptr_t)face;
+    h ^= key + size_px * 2654435761U + kind;
+    h ^= h >> 29;
+    return (unsigned int)(h & (VGR_BUCKETS - 1));
+}
+
+static void vgr_lru_unlink(struct vgr_entry *e)
+{
+    if (e->lru_prev)
+        e->lru_prev->lru_next = e->lru_next;
+    else
+        g_lru_head = e->lru_next;
+
+    if (e->lru_next)
+        e->lru_next->lru_prev = e->lru_prev;
+    else
+        g_lru_tail = e->lru_prev;
+
+    e->lru_prev = NULL;
+    e->lru_next = NULL;
+}
+
+static void vgr_lru_push_front(struct vgr_entry *e)
+{
+    e->lru_prev = NULL;
+    e->lru_next = g_lru_head;
+    if (g_lru_head)
+        g_lru_head->lru_prev = e;
+    g_lru_head = e;
+    if (!g_lru_tail)
+        g_lru_tail = e;
+}
+
+static void vgr_touch(struct vgr_entry *e)
+{
+    if (g_lru_head == e)
+        return;
+    vgr_lru_unlink(e);
+    vgr_lru_push_front(e);
+}
+
+static void vgr_free_entry(struct vgr_entry *e)
+{
+    free(e->glyphs);
+    free(e->bitmap);
+    free(e);
+}
+
+static void vgr_remove(struct vgr_entry *e)
+{
+    unsigned int idx = vgr_bucket_index(e->face, e->size_px, e->key, e->kind);
+    struct vgr_entry **pp = &g_buckets[idx];
+
+    while (*pp && *pp != e)
+        pp = &(*pp)->hash_next;
+    if (*pp)
+        *pp = e->hash_next;
+
+    vgr_lru_unlink(e);
+    g_bytes -= e->bytes;
+    vgr_free_entry(e);
+}
+
+static void vgr_evict_to(size_t target)
+{
+    while (g_bytes > target && g_lru_tail)
+        vgr_remove(g_lru_tail);
+}
+
+static struct vgr_entry *vgr_find(const void *face, unsigned int size_px,
+                                  uint64_t key, unsigned int kind)
+{
+    unsigned int idx = vgr_bucket_index(face, size_px, key, kind);
+    struct vgr_entry *e;
+
+    for (e = g_buckets[idx]; e; e = e->hash_next) {
+        if (e->face == face && e->size_px == size_px &&
+            e->key == key && e->kind == kind)
+            return e;
+    }
+    return NULL;
+}
+
+static void vgr_insert(struct vgr_entry *e)
+{
+    unsigned int idx = vgr_bucket_index(e->face, e->size_px, e->key, e->kind);
+
+    e->hash_next = g_buckets[idx];
+    g_buckets[idx] = e;
+    vgr_lru_push_front(e);
+    g_bytes += e->bytes;
+}
+
+/* ========================================================================= */
+/* Shaped-run cache                                                          */
+/* ========================================================================= */
+
+int vgr_run_lookup(const void *face, unsigned int size_px,
+                   const uint32_t *text, unsigned int text_len,
+                   vgr_run_t *run)
+{
+    struct vgr_entry *e;
+
+    if (!face || !text || text_len == 0 || !run)
+        return 0;
+
+    e = vgr_find(face, size_px, vgr_hash_text(text, text_len), VGR_KIND_RUN);
+    if (!e || e->text_len != text_len)
+        return 0;
+
+    vgr_touch(e);
+    run->glyphs = e->glyphs;
+    run->count  = e->glyph_count;
+    return 1;
+}
+
+int vgr_run_store(const void *face, unsigned int size_px,
+                  const uint32_t *text, unsigned int text_len,
+                  const vgr_glyph_t *glyphs, unsigned int count)
+{
+    struct vgr_entry *e;
+    uint64_t key;
+    size_t payload;
+
+    if (!face || !text || text_len == 0 || !glyphs || count == 0)
+        return -1;
+
+    payload = sizeof(struct vgr_entry) + (size_t)count * sizeof(vgr_glyph_t);
+    if (payload > g_budget)
+        return -1;
+
+    key = vgr_hash_text(text, text_len);
+
+    /* Replace an existing entry in place */
+    e = vgr_find(face, size_px, key, VGR_KIND_RUN);
+    if (e)
+        vgr_remove(e);
+
+    vgr_evict_to(g_budget - payload);
+
+    e = calloc(1, sizeof(*e));
+    if (!e)
+        return -1;
+
+    e->glyphs = malloc((size_t)count * sizeof(vgr_glyph_t));
+    if (!e->glyphs) {
+        free(e);
+        return -1;
+    }
+    memcpy(e->glyphs, glyphs, (size_t)count * sizeof(vgr_glyph_t));
+
+    e->face        = face;
+    e->size_px     = size_px;
+    e->key         = key;
+    e->kind        = VGR_KIND_RUN;
+    e->glyph_count = count;
+    e->text_len    = text_len;
+    e->bytes       = payload;
+
+    vgr_insert(e);
+    return 0;
+}
+
+/* ========================================================================= */
+/* Rendered-bitmap cache                                                     */
+/* ========================================================================= */
+
+const unsigned char *vgr_bitmap_lookup(const void *face,
+                                       unsigned int size_px,
+                                       uint32_t glyph_index,
+                                       unsigned int *width,
+                                       unsigned int *height)
+{
+    struct vgr_entry *e;
+
+    if (!face)
+        return NULL;
+
+    e = vgr_find(face, size_px, glyph_index, VGR_KIND_BITMAP);
+    if (!e)
+        return NULL;
+
+    vgr_touch(e);
+    if (width)
+        *width = e->width;
+    if (height)
+        *height = e->height;
+    return e->bitmap;
+}
+
+int vgr_bitmap_store(const void *face, unsigned int size_px,
+                     uint32_t glyph_index,
+                     const unsigned char *bitmap,
+                     unsigned int width, unsigned int height)
+{
+    struct vgr_entry *e;
+    size_t payload;
+
+    if (!face || !bitmap || width == 0 || height == 0)
+        return -1;
+
+    payload = sizeof(struct vgr_entry) + (size_t)width * height;
+    if (payload > g_budget)
+        return -1;
+
+    e = vgr_find(face, size_px, glyph_index, VGR_KIND_BITMAP);
+    if (e)
+        vgr_remove(e);
+
+    vgr_evict_to(g_budget - payload);
+
+    e = calloc(1, sizeof(*e));
+    if (!e)
+        return -1;
+
+    e->bitmap = malloc((size_t)width * height);
+    if (!e->bitmap) {
+        free(e);
+        return -1;
+    }
+    memcpy(e->bitmap, bitmap, (size_t)width * height);
+
+    e->face    = face;
+    e->size_px = size_px;
+    e->key     = glyph_index;
+    e->kind    = VGR_KIND_BITMAP;
+    e->width   = width;
+    e->height  = height;
+    e->bytes   = payload;
+
+    vgr_insert(e);
+    return 0;
+}
+
+/* ========================================================================= */
+/* Maintenance                                                               */
+/* ========================================================================= */
+
+void vgr_cache_set_budget(size_t bytes)
+{
+    g_budget = bytes;
+    vgr_evict_to(g_budget);
+}
+
+size_t vgr_cache_bytes(void)
+{
+    return g_bytes;
+}
+
+void vgr_cache_clear(void)
+{
+    while (g_lru_tail)
+        vgr_remove(g_lru_tail);
+}
+
+void vgr_cache_forget_face(const void *face)
+{
+    struct vgr_entry *e = g_lru_head;
+
+    while (e) {
+        struct vgr_entry *next = e->lru_next;
+        if (e->face == face)
+            vgr_remove(e);
+        e = next;
+    }
+}
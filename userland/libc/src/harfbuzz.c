@@ -12,6 +12,7 @@
 
 #include <harfbuzz/hb.h>
 #include <harfbuzz/hb-ft.h>
+#include <veridian/glyphrun.h>
 #include <string.h>
 #include <stdlib.h>
 
@@ -26,6 +27,7 @@
 #define MAX_BLOBS         64
 #define MAX_SETS          32
 #define MAX_MAPS          16
+#define MAX_SHAPE_PLANS   32
 
 /* ========================================================================= */
 /* Internal structures                                                       */
@@ -81,6 +83,23 @@ struct hb_buffer_internal {
     int                     has_positions;
 };
 
+/* A shaping plan: the per-(face, script, direction, features)
+ * decisions hb_shape() would otherwise re-derive on every call. */
+struct hb_shape_plan_internal {
+    int                      in_use;
+    int                      ref_count;
+    int                      cached;       /* held by the plan cache */
+    struct hb_face_internal *face;
+    hb_script_t              script;
+    hb_direction_t           direction;    /* as requested (may be INVALID) */
+    uint32_t                 feature_hash;
+
+    /* Derived once at plan-build time */
+    hb_direction_t           resolved_direction;
+    int                      apply_kerning;
+    unsigned int             last_use;     /* LRU stamp */
+};
+
 struct hb_set_internal {
     int            in_use;
     int            ref_count;
@@ -108,6 +127,8 @@ static struct hb_font_internal   g_fonts[MAX_FONTS];
 static struct hb_buffer_internal g_buffers[MAX_BUFFERS];
 static struct hb_set_internal    g_sets[MAX_SETS];
 static struct hb_map_internal    g_maps[MAX_MAPS];
+static struct hb_shape_plan_internal g_plans[MAX_SHAPE_PLANS];
+static unsigned int              g_plan_clock;
 
 /* Language singleton */
 static const char g_default_lang[] = "en";
@@ -1396,6 +1417,94 @@ void hb_buffer_set_message_func(hb_buffer_t *buffer,
     (void)buffer; (void)func; (void)user_data; (void)destroy;
 }
 
+/* ========================================================================= */
+/* Shaping plans                                                             */
+/* ========================================================================= */
+
+static uint32_t plan_feature_hash(const hb_feature_t *features,
+                                     unsigned int num_features)
+{
+    uint32_t h = 2166136261u;  /* FNV-1a */
+    unsigned int i;
+
+    for (i = 0; i < num_features; i++) {
+        h = (h ^ features[i].tag) * 16777619u;
+        h = (h ^ features[i].value) * 16777619u;
+        h = (h ^ features[i].start) * 16777619u;
+        h = (h ^ features[i].end) * 16777619u;
+    }
+    return h;
+}
+
+/* Derive the per-plan shaping decisions once */
+static void plan_build(struct hb_shape_plan_internal *pl,
+                          struct hb_face_internal *face,
+                          hb_script_t script, hb_direction_t direction,
+                          const hb_feature_t *features,
+                          unsigned int num_features)
+{
+    unsigned int i;
+
+    pl->face         = face;
+    pl->script       = script;
+    pl->direction    = direction;
+    pl->feature_hash = plan_feature_hash(features, num_features);
+
+    pl->resolved_direction = HB_DIRECTION_IS_VALID(direction) ?
+        direction : hb_script_get_horizontal_direction(script);
+    if (!HB_DIRECTION_IS_VALID(pl->resolved_direction))
+        pl->resolved_direction = HB_DIRECTION_LTR;
+
+    /* Kerning is on unless explicitly disabled via 'kern' */
+    pl->apply_kerning = 1;
+    for (i = 0; i < num_features; i++) {
+        if (features[i].tag == HB_TAG('k', 'e', 'r', 'n'))
+            pl->apply_kerning = features[i].value != 0;
+    }
+}
+
+/* Look up (or build) a cached plan; LRU-evicts when the pool is full.
+ * Returns NULL if every slot is pinned by client references. */
+static struct hb_shape_plan_internal *
+plan_get_cached(struct hb_face_internal *face, hb_script_t script,
+                  hb_direction_t direction, const hb_feature_t *features,
+                  unsigned int num_features)
+{
+    uint32_t hash = plan_feature_hash(features, num_features);
+    struct hb_shape_plan_internal *victim = NULL;
+    int i;
+
+    for (i = 0; i < MAX_SHAPE_PLANS; i++) {
+        struct hb_shape_plan_internal *pl = &g_plans[i];
+
+        if (pl->in_use && pl->cached && pl->face == face &&
+            pl->script == script && pl->direction == direction &&
+            pl->feature_hash == hash) {
+            pl->last_use = ++g_plan_clock;
+            return pl;
+        }
+        if (!pl->in_use) {
+            if (!victim || victim->in_use)
+                victim = pl;
+        } else if (pl->cached && pl->ref_count <= 1 &&
+                   (!victim ||
+                    (victim->in_use && pl->last_use < victim->last_use))) {
+            victim = pl;
+        }
+    }
+
+    if (!victim)
+        return NULL;
+
+    memset(victim, 0, sizeof(*victim));
+    victim->in_use    = 1;
+    victim->cached    = 1;
+    victim->ref_count = 1;  /* held by the cache */
+    victim->last_use  = ++g_plan_clock;
+    plan_build(victim, face, script, direction, features, num_features);
+    return victim;
+}
+
 /* ========================================================================= */
 /* Shaping                                                                   */
 /* ========================================================================= */
@@ -1406,6 +1515,130 @@ void hb_shape(hb_font_t *font, hb_buffer_t *buffer,
     hb_shape_full(font, buffer, features, num_features, NULL);
 }
 
+/* Shape one run under an already-built plan.  The plan carries the
+ * script/direction/feature decisions; this only does the per-glyph
+ * work. */
+static hb_bool_t shape_run(const struct hb_shape_plan_internal *plan,
+                              struct hb_font_internal *f,
+                              struct hb_buffer_internal *b)
+{
+    int backward = plan &&
+        HB_DIRECTION_IS_BACKWARD(plan->resolved_direction);
+    uint32_t *text = NULL;
+    unsigned int i;
+    int advance;
+
+    if (b->length == 0)
+        return 0;
+
+    /* Glyph-run cache: repeated strings (menu labels, terminal
+     * lines) shaped for the same face and scale hit the cache and
+     * skip shaping entirely.  Keyed on the pre-shape codepoints;
+     * backward runs skip it since the key carries no direction. */
+    if (!backward)
+        text = malloc((size_t)b->length * sizeof(uint32_t));
+    if (text) {
+        vgr_run_t run;
+
+        for (i = 0; i < b->length; i++)
+            text[i] = b->infos[i].codepoint;
+
+        if (vgr_run_lookup(f->face, (unsigned int)f->x_scale,
+                           text, b->length, &run) &&
+            run.count == b->length) {
+            for (i = 0; i < run.count; i++) {
+                b->infos[i].codepoint     = run.glyphs[i].glyph_index;
+                b->infos[i].cluster       = run.glyphs[i].cluster;
+                b->positions[i].x_advance = run.glyphs[i].x_advance;
+                b->positions[i].y_advance = run.glyphs[i].y_advance;
+                b->positions[i].x_offset  = run.glyphs[i].x_offset;
+                b->positions[i].y_offset  = run.glyphs[i].y_offset;
+            }
+            b->content_type  = HB_BUFFER_CONTENT_TYPE_GLYPHS;
+            b->has_positions = 1;
+            free(text);
+            return 1;
+        }
+    }
+
+    /* Map each codepoint through the face's cmap and take the
+     * rasterizer's advance.  Fonts without an FT face keep the
+     * identity mapping and a default advance. */
+    advance = f->x_scale * 600 / 1000;
+    if (advance <= 0) advance = 600;
+
+    {
+        FT_UInt prev_gid = 0;
+
+        for (i = 0; i < b->length; i++) {
+            int adv = advance;
+
+            if (f->ft_face) {
+                FT_UInt gid = FT_Get_Char_Index(f->ft_face,
+                                                b->infos[i].codepoint);
+
+                if (FT_Load_Glyph(f->ft_face, gid, 0) == 0 &&
+                    f->ft_face->glyph->advance.x > 0)
+                    adv = (int)f->ft_face->glyph->advance.x;
+                b->infos[i].codepoint = gid;
+
+                /* Pair kerning goes on the left glyph's advance */
+                if (plan && plan->apply_kerning && i > 0) {
+                    FT_Vector kern;
+
+                    if (FT_Get_Kerning(f->ft_face, prev_gid, gid,
+                                       0, &kern) == 0 && kern.x != 0)
+                        b->positions[i - 1].x_advance += (int)kern.x;
+                }
+                prev_gid = gid;
+            }
+            b->positions[i].x_advance = adv;
+            b->positions[i].y_advance = 0;
+            b->positions[i].x_offset  = 0;
+            b->positions[i].y_offset  = 0;
+        }
+    }
+
+    /* Backward runs come out in visual order */
+    if (backward) {
+        for (i = 0; i < b->length / 2; i++) {
+            unsigned int j = b->length - 1 - i;
+            hb_glyph_info_t     ti = b->infos[i];
+            hb_glyph_position_t tp = b->positions[i];
+
+            b->infos[i]     = b->infos[j];
+            b->positions[i] = b->positions[j];
+            b->infos[j]     = ti;
+            b->positions[j] = tp;
+        }
+    }
+
+    b->content_type  = HB_BUFFER_CONTENT_TYPE_GLYPHS;
+    b->has_positions = 1;
+
+    /* Populate the run cache for the next draw of this string */
+    if (text) {
+        vgr_glyph_t *glyphs =
+            malloc((size_t)b->length * sizeof(vgr_glyph_t));
+        if (glyphs) {
+            for (i = 0; i < b->length; i++) {
+                glyphs[i].glyph_index = b->infos[i].codepoint;
+                glyphs[i].cluster     = b->infos[i].cluster;
+                glyphs[i].x_advance   = b->positions[i].x_advance;
+                glyphs[i].y_advance   = b->positions[i].y_advance;
+                glyphs[i].x_offset    = b->positions[i].x_offset;
+                glyphs[i].y_offset    = b->positions[i].y_offset;
+            }
+            vgr_run_store(f->face, (unsigned int)f->x_scale,
+                          text, b->length, glyphs, b->length);
+            free(glyphs);
+        }
+        free(text);
+    }
+
+    return 1;
+}
+
 hb_bool_t hb_shape_full(hb_font_t *font, hb_buffer_t *buffer,
                            const hb_feature_t *features,
                            unsigned int num_features,
@@ -1413,32 +1646,26 @@ hb_bool_t hb_shape_full(hb_font_t *font, hb_buffer_t *buffer,
 {
     struct hb_buffer_internal *b = (struct hb_buffer_internal *)buffer;
     struct hb_font_internal *f = (struct hb_font_internal *)font;
-    unsigned int i;
+    struct hb_shape_plan_internal *plan;
+    struct hb_shape_plan_internal local;
 
-    (void)features;
-    (void)num_features;
     (void)shaper_list;
 
     if (!b || !f || b->length == 0)
         return 0;
 
-    /* Simple 1:1 shaping: each codepoint maps to a glyph with the
-     * same index, and receives a default advance. */
-    int advance = f->x_scale * 600 / 1000;
-    if (advance <= 0) advance = 600;
+    hb_buffer_guess_segment_properties(buffer);
 
-    for (i = 0; i < b->length; i++) {
-        /* Codepoint stays as glyph index (identity mapping) */
-        b->positions[i].x_advance = advance;
-        b->positions[i].y_advance = 0;
-        b->positions[i].x_offset  = 0;
-        b->positions[i].y_offset  = 0;
+    plan = plan_get_cached(f->face, b->script, b->direction,
+                           features, num_features);
+    if (!plan) {
+        /* Pool exhausted by pinned plans: derive on the stack */
+        plan_build(&local, f->face, b->script, b->direction,
+                   features, num_features);
+        plan = &local;
     }
 
-    b->content_type  = HB_BUFFER_CONTENT_TYPE_GLYPHS;
-    b->has_positions = 1;
-
-    return 1;
+    return shape_run(plan, f, b);
 }
 
 hb_bool_t hb_shape_justify(hb_font_t *font, hb_buffer_t *buffer,
@@ -1463,13 +1690,49 @@ const char **hb_shape_list_shapers(void)
     return g_shapers;
 }
 
-/* Shape plan stubs */
+/* Shape plans.  The opaque props pointer follows upstream's
+ * hb_segment_properties_t layout. */
+struct hb_segment_props_compat {
+    hb_direction_t direction;
+    hb_script_t    script;
+    hb_language_t  language;
+};
+
+static struct hb_shape_plan_internal *plan_from_ptr(hb_shape_plan_t *sp)
+{
+    struct hb_shape_plan_internal *pl = (struct hb_shape_plan_internal *)sp;
+
+    if (pl >= g_plans && pl < g_plans + MAX_SHAPE_PLANS && pl->in_use)
+        return pl;
+    return NULL;
+}
+
 hb_shape_plan_t *hb_shape_plan_create(hb_face_t *f, const void *p,
                                          const hb_feature_t *feat,
                                          unsigned int nf,
                                          const char * const *sl)
 {
-    (void)f; (void)p; (void)feat; (void)nf; (void)sl;
+    const struct hb_segment_props_compat *props =
+        (const struct hb_segment_props_compat *)p;
+    int i;
+
+    (void)sl;
+
+    for (i = 0; i < MAX_SHAPE_PLANS; i++) {
+        if (!g_plans[i].in_use) {
+            struct hb_shape_plan_internal *pl = &g_plans[i];
+
+            memset(pl, 0, sizeof(*pl));
+            pl->in_use    = 1;
+            pl->ref_count = 1;
+            pl->last_use  = ++g_plan_clock;
+            plan_build(pl, (struct hb_face_internal *)f,
+                       props ? props->script : HB_SCRIPT_LATIN,
+                       props ? props->direction : HB_DIRECTION_LTR,
+                       feat, nf);
+            return (hb_shape_plan_t *)pl;
+        }
+    }
     return hb_shape_plan_get_empty();
 }
 
@@ -1478,8 +1741,21 @@ hb_shape_plan_t *hb_shape_plan_create_cached(hb_face_t *f, const void *p,
                                                 unsigned int nf,
                                                 const char * const *sl)
 {
-    (void)f; (void)p; (void)feat; (void)nf; (void)sl;
-    return hb_shape_plan_get_empty();
+    const struct hb_segment_props_compat *props =
+        (const struct hb_segment_props_compat *)p;
+    struct hb_shape_plan_internal *pl;
+
+    (void)sl;
+
+    pl = plan_get_cached((struct hb_face_internal *)f,
+                         props ? props->script : HB_SCRIPT_LATIN,
+                         props ? props->direction : HB_DIRECTION_LTR,
+                         feat, nf);
+    if (!pl)
+        return hb_shape_plan_get_empty();
+
+    pl->ref_count++;  /* caller's reference, on top of the cache's */
+    return (hb_shape_plan_t *)pl;
 }
 
 hb_shape_plan_t *hb_shape_plan_create2(hb_face_t *f, const void *p,
@@ -1488,8 +1764,8 @@ hb_shape_plan_t *hb_shape_plan_create2(hb_face_t *f, const void *p,
                                           unsigned int nc,
                                           const char * const *sl)
 {
-    (void)f; (void)p; (void)feat; (void)nf; (void)co; (void)nc; (void)sl;
-    return hb_shape_plan_get_empty();
+    (void)co; (void)nc;  /* variation coords not supported */
+    return hb_shape_plan_create(f, p, feat, nf, sl);
 }
 
 hb_shape_plan_t *hb_shape_plan_create_cached2(hb_face_t *f, const void *p,
@@ -1498,8 +1774,8 @@ hb_shape_plan_t *hb_shape_plan_create_cached2(hb_face_t *f, const void *p,
                                                  const int *co, unsigned int nc,
                                                  const char * const *sl)
 {
-    (void)f; (void)p; (void)feat; (void)nf; (void)co; (void)nc; (void)sl;
-    return hb_shape_plan_get_empty();
+    (void)co; (void)nc;
+    return hb_shape_plan_create_cached(f, p, feat, nf, sl);
 }
 
 static int g_empty_plan;
@@ -1508,16 +1784,40 @@ hb_shape_plan_t *hb_shape_plan_get_empty(void)
     return (hb_shape_plan_t *)&g_empty_plan;
 }
 
-hb_shape_plan_t *hb_shape_plan_reference(hb_shape_plan_t *sp) { return sp; }
-void hb_shape_plan_destroy(hb_shape_plan_t *sp) { (void)sp; }
+hb_shape_plan_t *hb_shape_plan_reference(hb_shape_plan_t *sp)
+{
+    struct hb_shape_plan_internal *pl = plan_from_ptr(sp);
+
+    if (pl)
+        pl->ref_count++;
+    return sp;
+}
+
+void hb_shape_plan_destroy(hb_shape_plan_t *sp)
+{
+    struct hb_shape_plan_internal *pl = plan_from_ptr(sp);
+
+    if (pl && --pl->ref_count <= 0)
+        pl->in_use = 0;
+}
 
 hb_bool_t hb_shape_plan_execute(hb_shape_plan_t *sp, hb_font_t *font,
                                    hb_buffer_t *buffer,
                                    const hb_feature_t *features,
                                    unsigned int num_features)
 {
-    (void)sp;
-    return hb_shape_full(font, buffer, features, num_features, NULL);
+    struct hb_shape_plan_internal *pl = plan_from_ptr(sp);
+    struct hb_buffer_internal *b = (struct hb_buffer_internal *)buffer;
+    struct hb_font_internal *f = (struct hb_font_internal *)font;
+
+    if (!pl)
+        return hb_shape_full(font, buffer, features, num_features, NULL);
+    if (!b || !f)
+        return 0;
+
+    pl->last_use = ++g_plan_clock;
+    hb_buffer_guess_segment_properties(buffer);
+    return shape_run(pl, f, b);
 }
 
 const char *hb_shape_plan_get_shaper(hb_shape_plan_t *sp)
@@ -1526,6 +1826,55 @@ const char *hb_shape_plan_get_shaper(hb_shape_plan_t *sp)
     return "ot";
 }
 
+/* VeridianOS extension: shape an array of runs in one call, resolving
+ * the shaping plan once per distinct (script, direction) instead of
+ * per run.  KRunner result lists and Plasma tooltips shape dozens of
+ * short strings with identical properties per frame. */
+unsigned int hb_veridian_shape_batch(hb_font_t *font,
+                                        hb_buffer_t * const *buffers,
+                                        unsigned int count,
+                                        const hb_feature_t *features,
+                                        unsigned int num_features)
+{
+    struct hb_font_internal *f = (struct hb_font_internal *)font;
+    struct hb_shape_plan_internal *plan = NULL;
+    struct hb_shape_plan_internal local;
+    hb_script_t    plan_script = HB_SCRIPT_UNKNOWN;
+    hb_direction_t plan_dir    = HB_DIRECTION_INVALID;
+    unsigned int i, shaped = 0;
+
+    if (!f || !buffers)
+        return 0;
+
+    for (i = 0; i < count; i++) {
+        struct hb_buffer_internal *b =
+            (struct hb_buffer_internal *)buffers[i];
+
+        if (!b || b->length == 0)
+            continue;
+
+        hb_buffer_guess_segment_properties(buffers[i]);
+
+        if (!plan || b->script != plan_script ||
+            b->direction != plan_dir) {
+            plan_script = b->script;
+            plan_dir    = b->direction;
+            plan = plan_get_cached(f->face, plan_script, plan_dir,
+                                   features, num_features);
+            if (!plan) {
+                plan_build(&local, f->face, plan_script, plan_dir,
+                           features, num_features);
+                plan = &local;
+            }
+        }
+
+        if (shape_run(plan, f, b))
+            shaped++;
+    }
+
+    return shaped;
+}
+
 /* ========================================================================= */
 /* Unicode funcs                                                             */
 /* ========================================================================= */
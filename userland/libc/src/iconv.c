@@ -22,6 +22,12 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 /* ========================================================================= */
 /* Internal encoding IDs                                                     */
 /* ========================================================================= */
@@ -160,7 +166,8 @@ static uint32_t __decode_codepoint(int enc, const unsigned char **in,
             cp = ((uint32_t)(c & 0x0F) << 12) |
                  ((uint32_t)(p[1] & 0x3F) << 6) |
                  (p[2] & 0x3F);
-            if (cp < 0x800) { errno = EILSEQ; return (uint32_t)-1; }
+            if (cp < 0x800 || (cp >= 0xD800 && cp <= 0xDFFF))
+                { errno = EILSEQ; return (uint32_t)-1; }
             *in += 3; *inleft -= 3;
         } else if ((c & 0xF8) == 0xF0) {
             if (*inleft < 4) { errno = EINVAL; return (uint32_t)-1; }
@@ -395,6 +402,125 @@ iconv_t iconv_open(const char *tocode, const char *fromcode)
     return (iconv_t)cd;
 }
 
+/* ========================================================================= */
+/* UTF fast paths                                                            */
+/* ========================================================================= */
+
+/*
+ * The overwhelming majority of conversions are UTF-8 <-> UTF-16 and
+ * mostly ASCII (file names, window titles).  These helpers advance
+ * over ASCII runs 16 bytes at a time -- validation is the sign-bit
+ * mask, widening/narrowing is a SIMD unpack/pack -- and return to the
+ * per-codepoint machinery only at the first non-ASCII unit.  All
+ * supported targets are little-endian, so ENC_UTF16 (native) and
+ * ENC_UTF16LE share the path.
+ */
+
+static int __enc_is_utf16_native(int enc)
+{
+    return enc == ENC_UTF16 || enc == ENC_UTF16LE;
+}
+
+/* Advance over leading ASCII, UTF-8 -> UTF-16LE.  Only consumes input
+ * it can fully write (E2BIG semantics preserved). */
+static void __bulk_u8_to_u16(const unsigned char **in, size_t *inleft,
+                             unsigned char **out, size_t *outleft)
+{
+#if defined(__x86_64__)
+    while (*inleft >= 16 && *outleft >= 32) {
+        __m128i v = _mm_loadu_si128((const __m128i *)*in);
+
+        if (_mm_movemask_epi8(v) != 0)
+            break;
+        {
+            __m128i zero = _mm_setzero_si128();
+
+            _mm_storeu_si128((__m128i *)*out,
+                             _mm_unpacklo_epi8(v, zero));
+            _mm_storeu_si128((__m128i *)(*out + 16),
+                             _mm_unpackhi_epi8(v, zero));
+        }
+        *in += 16;
+        *inleft -= 16;
+        *out += 32;
+        *outleft -= 32;
+    }
+#elif defined(__aarch64__)
+    while (*inleft >= 16 && *outleft >= 32) {
+        uint8x16_t v = vld1q_u8(*in);
+
+        if (vmaxvq_u8(v) >= 0x80)
+            break;
+        {
+            uint8x16x2_t wide;
+
+            wide.val[0] = vzip1q_u8(v, vdupq_n_u8(0));
+            wide.val[1] = vzip2q_u8(v, vdupq_n_u8(0));
+            vst1q_u8(*out, wide.val[0]);
+            vst1q_u8(*out + 16, wide.val[1]);
+        }
+        *in += 16;
+        *inleft -= 16;
+        *out += 32;
+        *outleft -= 32;
+    }
+#endif
+    /* Scalar tail: still skip ASCII without the decoder */
+    while (*inleft >= 1 && *outleft >= 2 && **in < 0x80) {
+        (*out)[0] = **in;
+        (*out)[1] = 0;
+        *in += 1;
+        *inleft -= 1;
+        *out += 2;
+        *outleft -= 2;
+    }
+}
+
+/* Advance over leading ASCII, UTF-16LE -> UTF-8 */
+static void __bulk_u16_to_u8(const unsigned char **in, size_t *inleft,
+                             unsigned char **out, size_t *outleft)
+{
+#if defined(__x86_64__)
+    while (*inleft >= 16 && *outleft >= 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)*in);
+        /* ASCII unit == no bits in 0xFF80 */
+        __m128i hi = _mm_and_si128(v, _mm_set1_epi16((short)0xFF80));
+        __m128i ascii = _mm_cmpeq_epi16(hi, _mm_setzero_si128());
+
+        if (_mm_movemask_epi8(ascii) != 0xFFFF)
+            break;
+        _mm_storel_epi64((__m128i *)*out, _mm_packus_epi16(v, v));
+        *in += 16;
+        *inleft -= 16;
+        *out += 8;
+        *outleft -= 8;
+    }
+#elif defined(__aarch64__)
+    while (*inleft >= 16 && *outleft >= 8) {
+        uint16x8_t v = vreinterpretq_u16_u8(vld1q_u8(*in));
+
+        if (vmaxvq_u16(v) >= 0x80)
+            break;
+        vst1_u8(*out, vmovn_u16(v));
+        *in += 16;
+        *inleft -= 16;
+        *out += 8;
+        *outleft -= 8;
+    }
+#endif
+    while (*inleft >= 2 && *outleft >= 1) {
+        uint16_t u = (uint16_t)((*in)[0] | ((*in)[1] << 8));
+
+        if (u >= 0x80)
+            break;
+        **out = (unsigned char)u;
+        *in += 2;
+        *inleft -= 2;
+        *out += 1;
+        *outleft -= 1;
+    }
+}
+
 size_t iconv(iconv_t cd_opaque, char **inbuf, size_t *inbytesleft,
              char **outbuf, size_t *outbytesleft)
 {
@@ -416,33 +542,52 @@ size_t iconv(iconv_t cd_opaque, char **inbuf, size_t *inbytesleft,
     size_t inleft  = *inbytesleft;
     size_t outleft = *outbytesleft;
 
-    while (inleft > 0) {
-        /* Save position in case we need to back up on E2BIG */
-        const unsigned char *save_in = in;
-        size_t save_inleft = inleft;
-
-        uint32_t cp = __decode_codepoint(cd->from, &in, &inleft);
-        if (cp == (uint32_t)-1) {
-            /* Decode error -- errno already set */
-            *inbuf        = (char *)in;
-            *outbuf       = (char *)out;
-            *inbytesleft  = inleft;
-            *outbytesleft = outleft;
-            return (size_t)-1;
-        }
-
-        int rc = __encode_codepoint(cd->to, cp, &out, &outleft);
-        if (rc < 0) {
-            if (errno == E2BIG) {
-                /* Restore input position -- we consumed but couldn't write */
-                in = save_in;
-                inleft = save_inleft;
+    /* Dedicated UTF fast-path pair classification, once per call */
+    {
+        int u8_to_u16 = (cd->from == ENC_UTF8 &&
+                         __enc_is_utf16_native(cd->to));
+        int u16_to_u8 = (__enc_is_utf16_native(cd->from) &&
+                         cd->to == ENC_UTF8);
+
+        while (inleft > 0) {
+            /* ASCII runs bypass the codepoint machinery entirely */
+            if (u8_to_u16)
+                __bulk_u8_to_u16(&in, &inleft, &out, &outleft);
+            else if (u16_to_u8)
+                __bulk_u16_to_u8(&in, &inleft, &out, &outleft);
+            if (inleft == 0)
+                break;
+            {
+                /* Save position in case we need to back up on E2BIG */
+                const unsigned char *save_in = in;
+                size_t save_inleft = inleft;
+
+                uint32_t cp = __decode_codepoint(cd->from, &in,
+                                                 &inleft);
+                if (cp == (uint32_t)-1) {
+                    /* Decode error -- errno already set */
+                    *inbuf        = (char *)in;
+                    *outbuf       = (char *)out;
+                    *inbytesleft  = inleft;
+                    *outbytesleft = outleft;
+                    return (size_t)-1;
+                }
+
+                int rc = __encode_codepoint(cd->to, cp, &out, &outleft);
+                if (rc < 0) {
+                    if (errno == E2BIG) {
+                        /* Restore input position -- consumed but
+                         * couldn't write */
+                        in = save_in;
+                        inleft = save_inleft;
+                    }
+                    *inbuf        = (char *)in;
+                    *outbuf       = (char *)out;
+                    *inbytesleft  = inleft;
+                    *outbytesleft = outleft;
+                    return (size_t)-1;
+                }
             }
-            *inbuf        = (char *)in;
-            *outbuf       = (char *)out;
-            *inbytesleft  = inleft;
-            *outbytesleft = outleft;
-            return (size_t)-1;
         }
     }
 
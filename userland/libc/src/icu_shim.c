@@ -480,6 +480,12 @@ const char *ucnv_getAvailableName(int32_t n)
 /* Normalization (NFC passthrough)                                           */
 /* ========================================================================= */
 
+/* The header leaves UNormalizer2 opaque; the shim's singletons are
+ * mode tags (passthrough normalization, cached per process) */
+struct UNormalizer2 {
+    int mode;
+};
+
 static UNormalizer2 nfc_instance;
 static UNormalizer2 nfd_instance;
 static UNormalizer2 nfkc_instance;
@@ -559,9 +565,134 @@ UBool unorm2_isNormalized(const UNormalizer2 *norm2,
 /* Collation (simple code-point comparison)                                  */
 /* ========================================================================= */
 
+/* ========================================================================= */
+/* Shared locale data cache                                                  */
+/* ========================================================================= */
+
+/*
+ * The expensive part of collator construction -- the per-locale
+ * weight tables -- is built once per process and shared by every
+ * collator opened for that locale.  The cache is a fixed slot array
+ * with lock-free reads: writers claim a slot by CAS on its state,
+ * fill the tables, then release-store READY; readers acquire-load the
+ * state and either see a complete entry or none.  Entries are
+ * immutable and live for the process, so ucol_open is a small
+ * wrapper allocation and ucol_close never touches shared state.
+ */
+
+#define UCOL_CACHE_SLOTS 16
+
+enum {
+    UCOL_SLOT_EMPTY = 0,
+    UCOL_SLOT_BUILDING = 1,
+    UCOL_SLOT_READY = 2
+};
+
+struct ucol_locale_data {
+    int  state;                     /* Atomic */
+    char locale[32];
+
+    /* Primary collation weights for ASCII: case folds together,
+     * control < space < punctuation < digits < letters, so the fast
+     * path orders file names the way users expect without per-call
+     * table work */
+    uint8_t primary[128];
+};
+
+static struct ucol_locale_data g_ucol_cache[UCOL_CACHE_SLOTS];
+
+static void ucol_build_primary(struct ucol_locale_data *ld)
+{
+    int c;
+    uint8_t w = 1;
+
+    /* Controls first */
+    for (c = 0; c < 32; c++)
+        ld->primary[c] = w;
+    w++;
+    ld->primary[127] = 1;
+
+    /* Whitespace */
+    ld->primary[' '] = w++;
+
+    /* Punctuation and symbols, in code-point order */
+    for (c = '!'; c <= '/'; c++)
+        ld->primary[c] = w++;
+    for (c = ':'; c <= '@'; c++)
+        ld->primary[c] = w++;
+    for (c = '['; c <= '`'; c++)
+        ld->primary[c] = w++;
+    for (c = '{'; c <= '~'; c++)
+        ld->primary[c] = w++;
+
+    /* Digits */
+    for (c = '0'; c <= '9'; c++)
+        ld->primary[c] = w++;
+
+    /* Letters: case-insensitive at the primary level */
+    for (c = 'a'; c <= 'z'; c++) {
+        ld->primary[c] = w;
+        ld->primary[c - 'a' + 'A'] = w;
+        w++;
+    }
+}
+
+static const struct ucol_locale_data *ucol_locale_acquire(const char *loc)
+{
+    const char *name = (loc && loc[0]) ? loc : "root";
+    int i;
+
+    for (i = 0; i < UCOL_CACHE_SLOTS; i++) {
+        struct ucol_locale_data *ld = &g_ucol_cache[i];
+        int state = __atomic_load_n(&ld->state, __ATOMIC_ACQUIRE);
+
+        if (state == UCOL_SLOT_READY) {
+            if (strncmp(ld->locale, name, sizeof(ld->locale) - 1) == 0)
+                return ld;
+            continue;
+        }
+        if (state == UCOL_SLOT_BUILDING) {
+            /* Another thread is filling this slot: spin briefly */
+            while (__atomic_load_n(&ld->state, __ATOMIC_ACQUIRE) ==
+                   UCOL_SLOT_BUILDING)
+                ;
+            if (strncmp(ld->locale, name, sizeof(ld->locale) - 1) == 0)
+                return ld;
+            continue;
+        }
+
+        /* Empty: try to claim and build */
+        {
+            int expected = UCOL_SLOT_EMPTY;
+
+            if (__atomic_compare_exchange_n(&ld->state, &expected,
+                                            UCOL_SLOT_BUILDING, 0,
+                                            __ATOMIC_ACQUIRE,
+                                            __ATOMIC_ACQUIRE)) {
+                strncpy(ld->locale, name, sizeof(ld->locale) - 1);
+                ucol_build_primary(ld);
+                __atomic_store_n(&ld->state, UCOL_SLOT_READY,
+                                 __ATOMIC_RELEASE);
+                return ld;
+            }
+            i--;                    /* Re-examine the claimed slot */
+        }
+    }
+
+    /* Cache full of other locales: fall back to the root entry or
+     * the first ready slot */
+    for (i = 0; i < UCOL_CACHE_SLOTS; i++) {
+        if (__atomic_load_n(&g_ucol_cache[i].state, __ATOMIC_ACQUIRE) ==
+            UCOL_SLOT_READY)
+            return &g_ucol_cache[i];
+    }
+    return NULL;
+}
+
 struct UCollator {
     UCollationStrength strength;
     char locale[32];
+    const struct ucol_locale_data *data;    /* Shared, immutable */
 };
 
 UCollator *ucol_open(const char *loc, UErrorCode *status)
@@ -580,6 +711,7 @@ UCollator *ucol_open(const char *loc, UErrorCode *status)
     coll->strength = UCOL_TERTIARY;
     if (loc)
         strncpy(coll->locale, loc, sizeof(coll->locale) - 1);
+    coll->data = ucol_locale_acquire(loc);
 
     *status = U_ZERO_ERROR;
     return coll;
@@ -595,12 +727,40 @@ UCollationResult ucol_strcoll(const UCollator *coll,
                               const UChar *target, int32_t targetLength)
 {
     int32_t slen, tlen, minlen, i;
-    (void)coll;
 
     slen = (sourceLength < 0) ? u_strlen(source) : sourceLength;
     tlen = (targetLength < 0) ? u_strlen(target) : targetLength;
     minlen = (slen < tlen) ? slen : tlen;
 
+    /*
+     * ASCII fast path: compare precomputed primary weights (case
+     * folds at this level), break primary ties by code point when the
+     * collator is stronger than primary.  Falls back to the generic
+     * comparison at the first non-ASCII unit.
+     */
+    if (coll && coll->data) {
+        const uint8_t *pw = coll->data->primary;
+        int tie = 0;
+
+        for (i = 0; i < minlen; i++) {
+            UChar a = source[i];
+            UChar b = target[i];
+
+            if ((a | b) >= 128)
+                goto generic;
+            if (pw[a] != pw[b])
+                return pw[a] < pw[b] ? UCOL_LESS : UCOL_GREATER;
+            if (!tie && a != b)
+                tie = (a < b) ? -1 : 1;
+        }
+        if (slen != tlen)
+            return slen < tlen ? UCOL_LESS : UCOL_GREATER;
+        if (tie && coll->strength > UCOL_PRIMARY)
+            return tie < 0 ? UCOL_LESS : UCOL_GREATER;
+        return UCOL_EQUAL;
+    }
+
+generic:
     for (i = 0; i < minlen; i++) {
         if (source[i] < target[i])
             return UCOL_LESS;
@@ -628,14 +788,41 @@ int32_t ucol_getSortKey(const UCollator *coll,
                         uint8_t *result, int32_t resultLength)
 {
     int32_t slen, i, j = 0;
-    (void)coll;
+    int ascii = 1;
 
     slen = (sourceLength < 0) ? u_strlen(source) : sourceLength;
 
-    /* Simple sort key: just the raw UChar values as bytes */
-    for (i = 0; i < slen && j + 2 < resultLength; i++) {
-        result[j++] = (uint8_t)(source[i] >> 8);
-        result[j++] = (uint8_t)(source[i] & 0xFF);
+    /*
+     * Primary level from the shared weight table for ASCII (matching
+     * ucol_strcoll's ordering), then a 0x01 separator and the raw
+     * units as the tertiary tiebreaker.  Non-ASCII strings fall back
+     * to raw code units.
+     */
+    if (coll && coll->data) {
+        for (i = 0; i < slen; i++) {
+            if (source[i] >= 128) {
+                ascii = 0;
+                break;
+            }
+        }
+    } else {
+        ascii = 0;
+    }
+
+    if (ascii) {
+        for (i = 0; i < slen && j + 1 < resultLength; i++)
+            result[j++] = coll->data->primary[source[i]] + 1;
+        if (coll->strength > UCOL_PRIMARY) {
+            if (j + 1 < resultLength)
+                result[j++] = 0x01;
+            for (i = 0; i < slen && j + 1 < resultLength; i++)
+                result[j++] = (uint8_t)(source[i] + 1);
+        }
+    } else {
+        for (i = 0; i < slen && j + 2 < resultLength; i++) {
+            result[j++] = (uint8_t)(source[i] >> 8);
+            result[j++] = (uint8_t)(source[i] & 0xFF);
+        }
     }
     if (j < resultLength)
         result[j] = 0;
@@ -0,0 +1,378 @@
+/*
+ * VeridianOS libc -- ioring.c
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Async I/O submission/completion rings (veridian/ioring.h).
+ *
+ * Both rings are SPSC with free-running 32-bit indices masked by a
+ * power-of-two size -- the same idiom as the PipeWire and HCI rings.
+ * Userland produces SQEs and release-stores the tail; the kernel VFS
+ * service consumes them, executes against the VFS, and produces CQEs
+ * the same way in the other direction.  Reaping is an acquire-load
+ * and a copy: no syscall.
+ *
+ * When SYS_IORING_SETUP reports ENOSYS the ring runs a userland
+ * emulation: vio_submit() drains the submission ring through the
+ * plain wrappers and posts completions locally.  Semantics are
+ * identical; only the batching is lost.
+ */
+
+#include <veridian/ioring.h>
+#include <veridian/syscall.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+
+#define VIO_MAX_ENTRIES 1024
+#define VIO_MAX_FIXED_BUFS 64
+
+/* Shared ring header (page 0 of the kernel mapping) */
+struct vio_shared {
+    uint32_t magic;             /* 'VIOR' */
+    uint32_t sq_mask;
+    uint32_t cq_mask;
+    uint32_t _pad;
+    uint32_t sq_head;           /* Kernel consumes   */
+    uint32_t sq_tail;           /* Userland produces */
+    uint32_t cq_head;           /* Userland consumes */
+    uint32_t cq_tail;           /* Kernel produces   */
+    /* struct vio_sqe sq[sq_mask+1]; struct vio_cqe cq[cq_mask+1]; */
+};
+
+struct vio_ring {
+    struct vio_shared *sh;
+    struct vio_sqe *sq;
+    struct vio_cqe *cq;
+    size_t map_len;
+    uint32_t sq_local_tail;     /* Claimed but not yet published */
+    int ring_fd;                /* Kernel handle, -1 = emulation */
+
+    /* Registered buffers (emulation keeps the table locally) */
+    struct iovec fixed[VIO_MAX_FIXED_BUFS];
+    unsigned int fixed_count;
+};
+
+static uint32_t vio_pow2(unsigned int v)
+{
+    uint32_t p = 1;
+
+    while (p < v && p < VIO_MAX_ENTRIES)
+        p <<= 1;
+    return p;
+}
+
+struct vio_ring *vio_ring_create(unsigned int entries)
+{
+    struct vio_ring *r;
+    uint32_t n = vio_pow2(entries ? entries : 64);
+    size_t len = sizeof(struct vio_shared) +
+                 (size_t)n * sizeof(struct vio_sqe) +
+                 (size_t)n * sizeof(struct vio_cqe);
+    long fd;
+
+    r = calloc(1, sizeof(*r));
+    if (!r)
+        return NULL;
+    r->ring_fd = -1;
+
+    fd = veridian_syscall2(SYS_IORING_SETUP, n, 0);
+    if (fd >= 0) {
+        void *map = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED,
+                         (int)fd, 0);
+
+        if (map != MAP_FAILED) {
+            r->sh = (struct vio_shared *)map;
+            r->map_len = len;
+            r->ring_fd = (int)fd;
+        } else {
+            close((int)fd);
+        }
+    }
+
+    if (r->ring_fd < 0) {
+        /* Emulation: private ring, same layout */
+        void *mem = calloc(1, len);
+
+        if (!mem) {
+            free(r);
+            return NULL;
+        }
+        r->sh = (struct vio_shared *)mem;
+        r->sh->sq_mask = n - 1;
+        r->sh->cq_mask = n - 1;
+        r->map_len = 0;
+    }
+
+    r->sq = (struct vio_sqe *)(r->sh + 1);
+    r->cq = (struct vio_cqe *)(r->sq + (r->sh->sq_mask + 1));
+    r->sq_local_tail = r->sh->sq_tail;
+    return r;
+}
+
+void vio_ring_destroy(struct vio_ring *ring)
+{
+    if (!ring)
+        return;
+    if (ring->ring_fd >= 0) {
+        munmap(ring->sh, ring->map_len);
+        close(ring->ring_fd);
+    } else {
+        free(ring->sh);
+    }
+    free(ring);
+}
+
+int vio_ring_is_kernel(const struct vio_ring *ring)
+{
+    return ring && ring->ring_fd >= 0;
+}
+
+struct vio_sqe *vio_get_sqe(struct vio_ring *ring)
+{
+    uint32_t head;
+
+    if (!ring)
+        return NULL;
+    head = __atomic_load_n(&ring->sh->sq_head, __ATOMIC_ACQUIRE);
+    if (ring->sq_local_tail - head > ring->sh->sq_mask)
+        return NULL;                /* Full */
+    return &ring->sq[ring->sq_local_tail++ & ring->sh->sq_mask];
+}
+
+/* ----- prep helpers ----- */
+
+static void vio_prep(struct vio_sqe *sqe, uint8_t op, int fd,
+                     uint64_t addr, uint32_t len, uint64_t off,
+                     uint64_t user_data)
+{
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = op;
+    sqe->fd = fd;
+    sqe->addr = addr;
+    sqe->len = len;
+    sqe->off = off;
+    sqe->user_data = user_data;
+}
+
+void vio_prep_read(struct vio_sqe *sqe, int fd, void *buf,
+                   uint32_t len, uint64_t off, uint64_t user_data)
+{
+    vio_prep(sqe, VIO_OP_READ, fd, (uint64_t)(uintptr_t)buf, len, off,
+             user_data);
+}
+
+void vio_prep_write(struct vio_sqe *sqe, int fd, const void *buf,
+                    uint32_t len, uint64_t off, uint64_t user_data)
+{
+    vio_prep(sqe, VIO_OP_WRITE, fd, (uint64_t)(uintptr_t)buf, len, off,
+             user_data);
+}
+
+void vio_prep_fsync(struct vio_sqe *sqe, int fd, uint64_t user_data)
+{
+    vio_prep(sqe, VIO_OP_FSYNC, fd, 0, 0, 0, user_data);
+}
+
+void vio_prep_close(struct vio_sqe *sqe, int fd, uint64_t user_data)
+{
+    vio_prep(sqe, VIO_OP_CLOSE, fd, 0, 0, 0, user_data);
+}
+
+void vio_prep_read_fixed(struct vio_sqe *sqe, int fd,
+                         unsigned int buf_index, uint32_t len,
+                         uint64_t off, uint64_t user_data)
+{
+    vio_prep(sqe, VIO_OP_READ_FIXED, fd, buf_index, len, off,
+             user_data);
+}
+
+void vio_prep_write_fixed(struct vio_sqe *sqe, int fd,
+                          unsigned int buf_index, uint32_t len,
+                          uint64_t off, uint64_t user_data)
+{
+    vio_prep(sqe, VIO_OP_WRITE_FIXED, fd, buf_index, len, off,
+             user_data);
+}
+
+/* ----- emulation ----- */
+
+static int64_t vio_emulate_one(struct vio_ring *ring,
+                               const struct vio_sqe *sqe)
+{
+    switch (sqe->opcode) {
+    case VIO_OP_NOP:
+        return 0;
+    case VIO_OP_READ: {
+        ssize_t n = pread(sqe->fd, (void *)(uintptr_t)sqe->addr,
+                          sqe->len, (off_t)sqe->off);
+        return n < 0 ? -(int64_t)errno : (int64_t)n;
+    }
+    case VIO_OP_WRITE: {
+        ssize_t n = pwrite(sqe->fd, (const void *)(uintptr_t)sqe->addr,
+                           sqe->len, (off_t)sqe->off);
+        return n < 0 ? -(int64_t)errno : (int64_t)n;
+    }
+    case VIO_OP_FSYNC:
+        return fsync(sqe->fd) < 0 ? -(int64_t)errno : 0;
+    case VIO_OP_CLOSE:
+        return close(sqe->fd) < 0 ? -(int64_t)errno : 0;
+    case VIO_OP_READ_FIXED:
+    case VIO_OP_WRITE_FIXED: {
+        unsigned int idx = (unsigned int)sqe->addr;
+        uint32_t len = sqe->len;
+        ssize_t n;
+
+        if (idx >= ring->fixed_count)
+            return -EINVAL;
+        if (len > ring->fixed[idx].iov_len)
+            len = (uint32_t)ring->fixed[idx].iov_len;
+        if (sqe->opcode == VIO_OP_READ_FIXED)
+            n = pread(sqe->fd, ring->fixed[idx].iov_base, len,
+                      (off_t)sqe->off);
+        else
+            n = pwrite(sqe->fd, ring->fixed[idx].iov_base, len,
+                       (off_t)sqe->off);
+        return n < 0 ? -(int64_t)errno : (int64_t)n;
+    }
+    default:
+        return -EINVAL;
+    }
+}
+
+static void vio_post_cqe(struct vio_ring *ring, uint64_t user_data,
+                         int64_t res)
+{
+    uint32_t tail = ring->sh->cq_tail;
+    struct vio_cqe *cqe = &ring->cq[tail & ring->sh->cq_mask];
+
+    cqe->user_data = user_data;
+    cqe->res = res;
+    __atomic_store_n(&ring->sh->cq_tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+/* ----- submit / reap ----- */
+
+int vio_submit(struct vio_ring *ring)
+{
+    uint32_t published;
+    int count;
+
+    if (!ring) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    published = ring->sh->sq_tail;
+    count = (int)(ring->sq_local_tail - published);
+    if (count == 0)
+        return 0;
+
+    /* Publish the claimed entries */
+    __atomic_store_n(&ring->sh->sq_tail, ring->sq_local_tail,
+                     __ATOMIC_RELEASE);
+
+    if (ring->ring_fd >= 0) {
+        long r = veridian_syscall3(SYS_IORING_ENTER, ring->ring_fd,
+                                   count, 0);
+
+        if (r < 0) {
+            errno = (int)-r;
+            return -1;
+        }
+        return (int)r;
+    }
+
+    /* Emulation: execute in submission order, post completions */
+    {
+        uint32_t head = ring->sh->sq_head;
+
+        while (head != ring->sh->sq_tail) {
+            const struct vio_sqe *sqe =
+                &ring->sq[head & ring->sh->sq_mask];
+
+            vio_post_cqe(ring, sqe->user_data,
+                         vio_emulate_one(ring, sqe));
+            head++;
+        }
+        __atomic_store_n(&ring->sh->sq_head, head, __ATOMIC_RELEASE);
+    }
+    return count;
+}
+
+int vio_peek_cqe(struct vio_ring *ring, struct vio_cqe *out)
+{
+    uint32_t head;
+    uint32_t tail;
+
+    if (!ring || !out)
+        return 0;
+    head = ring->sh->cq_head;
+    tail = __atomic_load_n(&ring->sh->cq_tail, __ATOMIC_ACQUIRE);
+    if (head == tail)
+        return 0;
+    *out = ring->cq[head & ring->sh->cq_mask];
+    __atomic_store_n(&ring->sh->cq_head, head + 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+int vio_wait_cqe(struct vio_ring *ring, struct vio_cqe *out)
+{
+    if (!ring || !out) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    for (;;) {
+        if (vio_peek_cqe(ring, out))
+            return 1;
+        if (ring->ring_fd >= 0) {
+            /* Enter with a wait request: returns once a completion
+             * is posted */
+            long r = veridian_syscall3(SYS_IORING_ENTER, ring->ring_fd,
+                                       0, 1);
+
+            if (r < 0) {
+                errno = (int)-r;
+                return -1;
+            }
+        } else {
+            /* Emulation completes synchronously at submit; an empty
+             * ring means nothing is outstanding */
+            errno = EAGAIN;
+            return -1;
+        }
+    }
+}
+
+int vio_register_buffers(struct vio_ring *ring,
+                         const struct iovec *iov, unsigned int count)
+{
+    if (!ring || (!iov && count)) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (count > VIO_MAX_FIXED_BUFS) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    if (ring->ring_fd >= 0) {
+        long r = veridian_syscall3(SYS_IORING_REGISTER, ring->ring_fd,
+                                   iov, count);
+
+        if (r < 0) {
+            errno = (int)-r;
+            return -1;
+        }
+    }
+
+    if (count)
+        memcpy(ring->fixed, iov, count * sizeof(*iov));
+    ring->fixed_count = count;
+    return 0;
+}
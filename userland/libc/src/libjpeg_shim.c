@@ -13,6 +13,8 @@
 
 #include <jpeglib.h>
 #include <jerror.h>
+#include <pthread.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -69,10 +71,59 @@ struct jpeg_error_mgr *jpeg_std_error(struct jpeg_error_mgr *err)
 /* Decompression                                                             */
 /* ========================================================================= */
 
+/* ========================================================================= */
+/* Baseline decoder state                                                    */
+/* ========================================================================= */
+
+#define JV_MAX_COMPONENTS 4
+#define JV_MAX_SEGMENTS   512
+
+struct jv_huff {
+    uint8_t  counts[17];
+    uint8_t  symbols[256];
+    /* Canonical decode tables */
+    int32_t  mincode[17];
+    int32_t  maxcode[17];
+    int32_t  valptr[17];
+    int      defined;
+};
+
+struct jv_component {
+    int id;
+    int h, v;               /* Sampling factors */
+    int tq;                 /* Quant table */
+    int td, ta;             /* Huffman tables (DC/AC) */
+    int dc_pred;
+    /* Scaled plane */
+    uint8_t *plane;
+    int pw, ph;             /* Plane dims (scaled) */
+};
+
 struct jpeg_internal {
     const unsigned char *data;
     unsigned long        data_size;
     unsigned long        data_pos;
+
+    /* Parsed stream state */
+    uint16_t qt[4][64];
+    struct jv_huff hdc[4];
+    struct jv_huff hac[4];
+    struct jv_component comp[JV_MAX_COMPONENTS];
+    int ncomp;
+    int hmax, vmax;
+    int restart_interval;   /* MCUs per restart segment (0 = none)   */
+    unsigned long sos_pos;  /* Entropy data start                    */
+
+    /* Scaled-decode geometry */
+    int n;                  /* Output samples per 8-px block (1,2,4,8) */
+    int mcux, mcuy;
+
+    /* Region limit (full-resolution coords; w=0 means full image) */
+    unsigned int rx, ry, rw, rh;
+
+    /* Decoded RGB output (output_width x output_height x comps) */
+    uint8_t *rgb;
+    int decoded;
 };
 
 void jpeg_CreateDecompress(j_decompress_ptr cinfo, int version,
@@ -104,6 +155,262 @@ void jpeg_stdio_src(j_decompress_ptr cinfo, FILE *infile)
     /* File I/O source not implemented */
 }
 
+/* ========================================================================= */
+/* Baseline JPEG decoder                                                     */
+/* ========================================================================= */
+
+/*
+ * Sequential baseline (SOF0) decoder with three thumbnailer-oriented
+ * properties:
+ *
+ *   - Scaled decode: scale_denom 2/4/8 uses reduced IDCTs (4x4, 2x2,
+ *     DC-only) that touch only the low-frequency coefficients, so a
+ *     1/8 preview never computes the full transform.
+ *   - Restart-marker parallelism: with DRI present, each restart
+ *     segment is an independent entropy stream; segments are indexed
+ *     up front and decoded across a small pthread pool.
+ *   - Region decode: MCU rows outside the caller's region of interest
+ *     are entropy-skipped (Huffman only, no dequant/IDCT/color).
+ */
+
+static const uint8_t jv_zigzag[64] = {
+     0,  1,  8, 16,  9,  2,  3, 10, 17, 24, 32, 25, 18, 11,  4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13,  6,  7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63
+};
+
+/* cos((2x+1)u*pi/16) * 4096, for the separable reduced IDCTs */
+static const int32_t jv_cos[8][8] = {
+    { 4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096 },
+    { 4017, 3406, 2276,  799, -799, -2276, -3406, -4017 },
+    { 3784, 1567, -1567, -3784, -3784, -1567, 1567, 3784 },
+    { 3406, -799, -4017, -2276, 2276, 4017,  799, -3406 },
+    { 2896, -2896, -2896, 2896, 2896, -2896, -2896, 2896 },
+    { 2276, -4017,  799, 3406, -3406, -799, 4017, -2276 },
+    { 1567, -3784, 3784, -1567, -1567, 3784, -3784, 1567 },
+    {  799, -2276, 3406, -4017, 4017, -3406, 2276, -799 }
+};
+
+struct jv_bits {
+    const unsigned char *d;
+    unsigned long pos;
+    unsigned long end;
+    uint32_t bitbuf;
+    int bitcnt;
+};
+
+static void jv_bits_init(struct jv_bits *b, const unsigned char *d,
+                         unsigned long pos, unsigned long end)
+{
+    b->d = d;
+    b->pos = pos;
+    b->end = end;
+    b->bitbuf = 0;
+    b->bitcnt = 0;
+}
+
+/* Pull one bit; byte-stuffed 0xFF00 collapses to 0xFF, markers end
+ * the stream */
+static int jv_bit(struct jv_bits *b)
+{
+    if (b->bitcnt == 0) {
+        if (b->pos >= b->end)
+            return -1;
+        {
+            unsigned char byte = b->d[b->pos++];
+
+            if (byte == 0xFF) {
+                if (b->pos < b->end && b->d[b->pos] == 0x00)
+                    b->pos++;
+                else
+                    return -1;      /* Marker: stream over */
+            }
+            b->bitbuf = byte;
+            b->bitcnt = 8;
+        }
+    }
+    b->bitcnt--;
+    return (int)((b->bitbuf >> b->bitcnt) & 1);
+}
+
+static int jv_bits_n(struct jv_bits *b, int n)
+{
+    int v = 0;
+
+    while (n-- > 0) {
+        int bit = jv_bit(b);
+
+        if (bit < 0)
+            return -1;
+        v = (v << 1) | bit;
+    }
+    return v;
+}
+
+static void jv_huff_build(struct jv_huff *h)
+{
+    int code = 0;
+    int k = 0;
+    int len;
+
+    for (len = 1; len <= 16; len++) {
+        h->valptr[len] = k;
+        h->mincode[len] = code;
+        code += h->counts[len];
+        k += h->counts[len];
+        h->maxcode[len] = code - 1;
+        code <<= 1;
+    }
+}
+
+static int jv_huff_decode(struct jv_bits *b, const struct jv_huff *h)
+{
+    int code = 0;
+    int len;
+
+    for (len = 1; len <= 16; len++) {
+        int bit = jv_bit(b);
+
+        if (bit < 0)
+            return -1;
+        code = (code << 1) | bit;
+        if (h->counts[len] && code <= h->maxcode[len])
+            return h->symbols[h->valptr[len] + code - h->mincode[len]];
+    }
+    return -1;
+}
+
+/* JPEG extend: interpret v as a signed value of n bits */
+static int jv_extend(int v, int n)
+{
+    if (n == 0)
+        return 0;
+    if (v < (1 << (n - 1)))
+        return v - (1 << n) + 1;
+    return v;
+}
+
+/* Decode one block's coefficients (dequantized, natural order).
+ * When out is NULL the block is entropy-skipped. */
+static int jv_decode_block(struct jv_bits *b, struct jv_component *c,
+                           const struct jpeg_internal *ji, int32_t *out)
+{
+    const struct jv_huff *hdc = &ji->hdc[c->td];
+    const struct jv_huff *hac = &ji->hac[c->ta];
+    const uint16_t *qt = ji->qt[c->tq];
+    int t, k;
+
+    t = jv_huff_decode(b, hdc);
+    if (t < 0)
+        return -1;
+    {
+        int diff = t ? jv_bits_n(b, t) : 0;
+
+        if (diff < 0 && t)
+            return -1;
+        c->dc_pred += jv_extend(diff, t);
+    }
+    if (out) {
+        memset(out, 0, 64 * sizeof(*out));
+        out[0] = c->dc_pred * (int32_t)qt[0];
+    }
+
+    k = 1;
+    while (k < 64) {
+        int rs = jv_huff_decode(b, hac);
+        int r, ssss;
+
+        if (rs < 0)
+            return -1;
+        r = rs >> 4;
+        ssss = rs & 15;
+        if (ssss == 0) {
+            if (r == 15) {
+                k += 16;
+                continue;
+            }
+            break;              /* EOB */
+        }
+        k += r;
+        if (k > 63)
+            return -1;
+        {
+            int v = jv_bits_n(b, ssss);
+
+            if (v < 0)
+                return -1;
+            if (out)
+                out[jv_zigzag[k]] =
+                    jv_extend(v, ssss) * (int32_t)qt[k];
+        }
+        k++;
+    }
+    return 0;
+}
+
+static uint8_t jv_clamp(int32_t v)
+{
+    if (v < 0)
+        return 0;
+    return v > 255 ? 255 : (uint8_t)v;
+}
+
+/*
+ * Reduced separable IDCT: produce an n x n output from the top-left
+ * n x n coefficients (n = 8 is the full transform; n = 1 is DC only).
+ * The n-point basis samples the 8-point cosine at stride 8/n, which
+ * is the standard low-pass shortcut thumbnailers rely on.
+ */
+static void jv_idct_n(const int32_t *coef, uint8_t *out, int stride,
+                      int n)
+{
+    int32_t tmp[64];
+    int x, y, u, v;
+    int step = 8 / n;
+
+    if (n == 1) {
+        out[0] = jv_clamp(((coef[0] >> 3) + 128));
+        return;
+    }
+
+    /* Columns then rows over the n x n low-frequency quadrant */
+    for (x = 0; x < n; x++) {
+        for (y = 0; y < n; y++) {
+            int64_t acc = 0;
+
+            for (v = 0; v < n; v++) {
+                int32_t cv = jv_cos[v][y * step + step / 2];
+                int32_t s = coef[v * 8 + x];
+
+                if (v == 0)
+                    acc += (int64_t)s * 2896;       /* 1/sqrt2 * 4096 */
+                else
+                    acc += (int64_t)s * cv;
+            }
+            tmp[y * 8 + x] = (int32_t)(acc >> 12);
+        }
+    }
+    for (y = 0; y < n; y++) {
+        for (x = 0; x < n; x++) {
+            int64_t acc = 0;
+
+            for (u = 0; u < n; u++) {
+                int32_t cu = jv_cos[u][x * step + step / 2];
+                int32_t sv = tmp[y * 8 + u];
+
+                if (u == 0)
+                    acc += (int64_t)sv * 2896;
+                else
+                    acc += (int64_t)sv * cu;
+            }
+            /* 4096 table scale + the transform's global 1/4 */
+            out[y * stride + x] =
+                jv_clamp((int32_t)((acc >> 14) + 128));
+        }
+    }
+}
+
 /*
  * Parse JFIF/JPEG markers to extract image dimensions.
  * Looks for SOI (0xFFD8) and SOF0 (0xFFC0) markers.
@@ -113,6 +420,7 @@ int jpeg_read_header(j_decompress_ptr cinfo, int require_image)
     struct jpeg_internal *ji;
     const unsigned char *d;
     unsigned long sz;
+    unsigned long pos;
 
     (void)require_image;
 
@@ -123,7 +431,6 @@ int jpeg_read_header(j_decompress_ptr cinfo, int require_image)
     d = ji->data;
     sz = ji->data_size;
 
-    /* Default values */
     cinfo->image_width = 0;
     cinfo->image_height = 0;
     cinfo->num_components = 3;
@@ -131,93 +438,543 @@ int jpeg_read_header(j_decompress_ptr cinfo, int require_image)
     cinfo->data_precision = 8;
 
     if (sz < 2 || d[0] != 0xFF || d[1] != 0xD8)
-        return JPEG_SUSPENDED;  /* Not a JPEG */
+        return JPEG_SUSPENDED;
 
-    /* Scan for SOF0 marker (0xFFC0) */
-    {
-        unsigned long pos = 2;
-        while (pos + 4 < sz) {
-            if (d[pos] != 0xFF) {
-                pos++;
-                continue;
+    pos = 2;
+    while (pos + 4 <= sz) {
+        unsigned char marker;
+        unsigned int seg_len;
+
+        if (d[pos] != 0xFF) {
+            pos++;
+            continue;
+        }
+        marker = d[pos + 1];
+        if (marker == 0xD8 || (marker >= 0xD0 && marker <= 0xD7)) {
+            pos += 2;
+            continue;
+        }
+        if (marker == 0xD9)
+            break;
+        if (pos + 4 > sz)
+            break;
+        seg_len = ((unsigned int)d[pos + 2] << 8) | d[pos + 3];
+        if (seg_len < 2 || pos + 2 + seg_len > sz)
+            break;
+
+        if (marker == 0xC0 || marker == 0xC1) {
+            /* Baseline/extended sequential SOF */
+            const unsigned char *p = d + pos + 4;
+            int i;
+
+            cinfo->data_precision = p[0];
+            cinfo->image_height = ((unsigned int)p[1] << 8) | p[2];
+            cinfo->image_width = ((unsigned int)p[3] << 8) | p[4];
+            cinfo->num_components = p[5];
+            ji->ncomp = p[5] > JV_MAX_COMPONENTS ? JV_MAX_COMPONENTS
+                                                 : p[5];
+            ji->hmax = 1;
+            ji->vmax = 1;
+            for (i = 0; i < ji->ncomp; i++) {
+                ji->comp[i].id = p[6 + i * 3];
+                ji->comp[i].h = p[7 + i * 3] >> 4;
+                ji->comp[i].v = p[7 + i * 3] & 15;
+                ji->comp[i].tq = p[8 + i * 3] & 3;
+                if (ji->comp[i].h < 1) ji->comp[i].h = 1;
+                if (ji->comp[i].v < 1) ji->comp[i].v = 1;
+                if (ji->comp[i].h > ji->hmax) ji->hmax = ji->comp[i].h;
+                if (ji->comp[i].v > ji->vmax) ji->vmax = ji->comp[i].v;
             }
-            unsigned char marker = d[pos + 1];
-
-            if (marker == 0xC0 || marker == 0xC1 || marker == 0xC2) {
-                /* SOFn: Start of Frame */
-                if (pos + 9 < sz) {
-                    cinfo->data_precision = d[pos + 4];
-                    cinfo->image_height = ((unsigned int)d[pos + 5] << 8) |
-                                          d[pos + 6];
-                    cinfo->image_width = ((unsigned int)d[pos + 7] << 8) |
-                                         d[pos + 8];
-                    cinfo->num_components = d[pos + 9];
+        } else if (marker == 0xC2) {
+            /* Progressive: dimensions only, no decode path */
+            const unsigned char *p = d + pos + 4;
+
+            cinfo->data_precision = p[0];
+            cinfo->image_height = ((unsigned int)p[1] << 8) | p[2];
+            cinfo->image_width = ((unsigned int)p[3] << 8) | p[4];
+            cinfo->num_components = p[5];
+            ji->ncomp = 0;          /* Marks decode unsupported */
+        } else if (marker == 0xDB) {
+            /* DQT: one or more tables */
+            unsigned long q = pos + 4;
+            unsigned long qend = pos + 2 + seg_len;
+
+            while (q < qend) {
+                int prec = d[q] >> 4;
+                int id = d[q] & 3;
+                int i;
+
+                q++;
+                for (i = 0; i < 64 && q < qend; i++) {
+                    if (prec) {
+                        ji->qt[id][i] =
+                            (uint16_t)(((unsigned)d[q] << 8) | d[q + 1]);
+                        q += 2;
+                    } else {
+                        ji->qt[id][i] = d[q++];
+                    }
                 }
-                break;
             }
+        } else if (marker == 0xC4) {
+            /* DHT */
+            unsigned long q = pos + 4;
+            unsigned long qend = pos + 2 + seg_len;
 
-            if (marker == 0xD9 || marker == 0xDA)
-                break;  /* EOI or SOS */
+            while (q + 17 <= qend) {
+                int cls = d[q] >> 4;
+                int id = d[q] & 3;
+                struct jv_huff *h = cls ? &ji->hac[id] : &ji->hdc[id];
+                int total = 0;
+                int i;
 
-            /* Skip marker segment */
-            if (pos + 3 < sz) {
-                unsigned int seg_len = ((unsigned int)d[pos + 2] << 8) |
-                                       d[pos + 3];
-                pos += 2 + seg_len;
-            } else {
-                break;
+                q++;
+                h->counts[0] = 0;
+                for (i = 1; i <= 16; i++) {
+                    h->counts[i] = d[q + i - 1];
+                    total += h->counts[i];
+                }
+                q += 16;
+                if (total > 256 || q + (unsigned long)total > qend)
+                    break;
+                for (i = 0; i < total; i++)
+                    h->symbols[i] = d[q + i];
+                q += (unsigned long)total;
+                jv_huff_build(h);
+                h->defined = 1;
             }
+        } else if (marker == 0xDD) {
+            ji->restart_interval =
+                ((unsigned int)d[pos + 4] << 8) | d[pos + 5];
+        } else if (marker == 0xDA) {
+            /* SOS: component table selectors, then entropy data */
+            const unsigned char *p = d + pos + 4;
+            int ns = p[0];
+            int i, j;
+
+            for (i = 0; i < ns; i++) {
+                int cid = p[1 + i * 2];
+                int tabs = p[2 + i * 2];
+
+                for (j = 0; j < ji->ncomp; j++) {
+                    if (ji->comp[j].id == cid) {
+                        ji->comp[j].td = tabs >> 4;
+                        ji->comp[j].ta = tabs & 15;
+                    }
+                }
+            }
+            ji->sos_pos = pos + 2 + seg_len;
+            break;
         }
+        pos += 2 + seg_len;
     }
 
     if (cinfo->image_width == 0 || cinfo->image_height == 0)
         return JPEG_SUSPENDED;
 
-    cinfo->global_state = 1;  /* Header read */
+    cinfo->global_state = 1;
     return JPEG_HEADER_OK;
 }
 
+/* Decode one MCU at (mx,my); skip==1 entropy-skips without output */
+static int jv_decode_mcu(struct jpeg_internal *ji, struct jv_bits *b,
+                         struct jv_component *comp, int mx, int my,
+                         int skip)
+{
+    int ci;
+
+    for (ci = 0; ci < ji->ncomp; ci++) {
+        struct jv_component *c = &comp[ci];
+        int bx, by;
+
+        for (by = 0; by < c->v; by++) {
+            for (bx = 0; bx < c->h; bx++) {
+                int32_t coef[64];
+
+                if (jv_decode_block(b, c, ji, skip ? NULL : coef) < 0)
+                    return -1;
+                if (skip)
+                    continue;
+                {
+                    int n = ji->n;
+                    int px = (mx * c->h + bx) * n;
+                    int py = (my * c->v + by) * n;
+                    uint8_t blk[64];
+                    int yy, xx;
+
+                    jv_idct_n(coef, blk, 8, n);
+                    for (yy = 0; yy < n; yy++) {
+                        if (py + yy >= c->ph)
+                            break;
+                        for (xx = 0; xx < n; xx++) {
+                            if (px + xx >= c->pw)
+                                break;
+                            c->plane[(size_t)(py + yy) * c->pw +
+                                     px + xx] = blk[yy * 8 + xx];
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/* Decode MCUs [first, last) from one entropy stream, resyncing at
+ * restart markers when the stream spans interval boundaries (the
+ * sequential path; parallel segments never contain one) */
+static int jv_decode_mcu_range(struct jpeg_internal *ji,
+                               struct jv_component *comp,
+                               unsigned long seg_pos,
+                               unsigned long seg_end,
+                               int first, int last,
+                               int row_lo, int row_hi)
+{
+    struct jv_bits b;
+    int m;
+    int ci;
+
+    jv_bits_init(&b, ji->data, seg_pos, seg_end);
+    for (m = first; m < last; m++) {
+        int my = m / ji->mcux;
+        int skip = my < row_lo || my >= row_hi;
+
+        if (ji->restart_interval && m > first &&
+            (m % ji->restart_interval) == 0) {
+            /* Byte-align, skip the RSTn marker, reset DC predictors */
+            b.bitcnt = 0;
+            while (b.pos + 1 < b.end &&
+                   !(b.d[b.pos] == 0xFF && b.d[b.pos + 1] >= 0xD0 &&
+                     b.d[b.pos + 1] <= 0xD7))
+                b.pos++;
+            if (b.pos + 1 < b.end)
+                b.pos += 2;
+            for (ci = 0; ci < ji->ncomp; ci++)
+                comp[ci].dc_pred = 0;
+        }
+
+        if (jv_decode_mcu(ji, &b, comp, m % ji->mcux, my, skip) < 0)
+            return -1;
+    }
+    return 0;
+}
+
+/* Restart-segment worker */
+struct jv_seg_job {
+    struct jpeg_internal *ji;
+    struct jv_component comp[JV_MAX_COMPONENTS];  /* Private dc_pred */
+    unsigned long pos, end;
+    int first, last;
+    int row_lo, row_hi;
+    int rc;
+};
+
+static void *jv_seg_worker(void *arg)
+{
+    struct jv_seg_job *job = (struct jv_seg_job *)arg;
+
+    job->rc = jv_decode_mcu_range(job->ji, job->comp, job->pos,
+                                  job->end, job->first, job->last,
+                                  job->row_lo, job->row_hi);
+    return NULL;
+}
+
+struct jv_range_arg {
+    struct jv_seg_job *jobs;
+    int lo, hi;
+};
+
+void *jv_range_run(void *arg)
+{
+    struct jv_range_arg *r = (struct jv_range_arg *)arg;
+    int i;
+
+    for (i = r->lo; i < r->hi; i++)
+        jv_seg_worker(&r->jobs[i]);
+    return NULL;
+}
+
+/* Full decode into the component planes.  Returns 0 on success. */
+static int jv_decode_image(struct jpeg_internal *ji, int row_lo,
+                           int row_hi)
+{
+    int total_mcus = ji->mcux * ji->mcuy;
+
+    if (ji->restart_interval > 0) {
+        /*
+         * Index the restart segments: each starts with reset DC
+         * predictors at a known MCU index, so they decode in
+         * parallel.  Falls back to sequential when the marker scan
+         * disagrees with DRI.
+         */
+        unsigned long segs[JV_MAX_SEGMENTS];
+        int nsegs = 0;
+        unsigned long p = ji->sos_pos;
+
+        segs[nsegs++] = p;
+        while (p + 1 < ji->data_size && nsegs < JV_MAX_SEGMENTS) {
+            if (ji->data[p] == 0xFF) {
+                unsigned char m = ji->data[p + 1];
+
+                if (m >= 0xD0 && m <= 0xD7) {
+                    segs[nsegs++] = p + 2;
+                    p += 2;
+                    continue;
+                }
+                if (m == 0xD9)
+                    break;
+                if (m != 0x00) {
+                    p += 2;
+                    continue;
+                }
+            }
+            p++;
+        }
+
+        if (nsegs * ji->restart_interval < total_mcus &&
+            nsegs > 1) {
+            /* Markers missing for the tail: decode sequentially */
+        } else if (nsegs > 1) {
+            struct jv_seg_job *jobs =
+                calloc((size_t)nsegs, sizeof(*jobs));
+            struct jv_range_arg rargs[8];
+            pthread_t tids[8];
+            int nthreads = nsegs < 8 ? nsegs : 8;
+            int chunk = (nsegs + nthreads - 1) / nthreads;
+            int si, t;
+            int ok = 1;
+
+            if (!jobs)
+                return -1;
+            for (si = 0; si < nsegs; si++) {
+                jobs[si].ji = ji;
+                /* Private component copies: each segment starts with
+                 * reset DC predictors and writes disjoint plane rows */
+                memcpy(jobs[si].comp, ji->comp, sizeof(ji->comp));
+                jobs[si].pos = segs[si];
+                jobs[si].end = (si + 1 < nsegs) ? segs[si + 1]
+                                                : ji->data_size;
+                jobs[si].first = si * ji->restart_interval;
+                jobs[si].last = jobs[si].first + ji->restart_interval;
+                if (jobs[si].last > total_mcus)
+                    jobs[si].last = total_mcus;
+                jobs[si].row_lo = row_lo;
+                jobs[si].row_hi = row_hi;
+            }
+
+            /* Each thread runs a contiguous chunk of segments; the
+             * calling thread takes the first chunk itself */
+            for (t = 0; t < nthreads; t++) {
+                rargs[t].jobs = jobs;
+                rargs[t].lo = t * chunk;
+                rargs[t].hi = (t + 1) * chunk;
+                if (rargs[t].hi > nsegs)
+                    rargs[t].hi = nsegs;
+            }
+            for (t = 1; t < nthreads; t++) {
+                if (pthread_create(&tids[t], NULL, jv_range_run,
+                                   &rargs[t]) != 0)
+                    tids[t] = 0;
+            }
+            jv_range_run(&rargs[0]);
+            for (t = 1; t < nthreads; t++) {
+                if (tids[t])
+                    pthread_join(tids[t], NULL);
+                else
+                    jv_range_run(&rargs[t]);    /* Spawn failed */
+            }
+
+            for (si = 0; si < nsegs; si++) {
+                if (jobs[si].rc != 0)
+                    ok = 0;
+            }
+            free(jobs);
+            return ok ? 0 : -1;
+        }
+    }
+
+    /* Sequential path (no restarts): one entropy stream, region rows
+     * entropy-skipped */
+    return jv_decode_mcu_range(ji, ji->comp, ji->sos_pos,
+                               ji->data_size, 0, total_mcus,
+                               row_lo, row_hi);
+}
+
 int jpeg_start_decompress(j_decompress_ptr cinfo)
 {
-    if (cinfo == NULL) return 0;
+    struct jpeg_internal *ji;
+    unsigned int denom;
+    int ci;
+
+    if (cinfo == NULL || cinfo->_internal == NULL)
+        return 0;
+    ji = (struct jpeg_internal *)cinfo->_internal;
+
+    /* Scaled decode: honor scale_num/scale_denom for 1, 1/2, 1/4,
+     * 1/8 (libjpeg semantics; anything else rounds down to the
+     * nearest supported) */
+    denom = (cinfo->scale_num == 0) ? 1 : cinfo->scale_denom;
+    if (cinfo->scale_num > 1)
+        denom = denom / cinfo->scale_num;
+    if (denom >= 8)
+        denom = 8;
+    else if (denom >= 4)
+        denom = 4;
+    else if (denom >= 2)
+        denom = 2;
+    else
+        denom = 1;
+    ji->n = 8 / (int)denom;
 
-    /* Set output parameters */
-    cinfo->out_color_space = JCS_RGB;
-    cinfo->output_width = cinfo->image_width;
-    cinfo->output_height = cinfo->image_height;
-    cinfo->output_components = 3;
-    cinfo->out_color_components = 3;
+    cinfo->out_color_space =
+        (cinfo->num_components == 1) ? JCS_GRAYSCALE : JCS_RGB;
+    cinfo->output_width =
+        (cinfo->image_width + denom - 1) / denom;
+    cinfo->output_height =
+        (cinfo->image_height + denom - 1) / denom;
+    cinfo->output_components =
+        (cinfo->num_components == 1) ? 1 : 3;
+    cinfo->out_color_components = cinfo->output_components;
     cinfo->output_scanline = 0;
     cinfo->rec_outbuf_height = 1;
-    cinfo->global_state = 2;  /* Decompressing */
+    cinfo->global_state = 2;
+
+    if (ji->ncomp == 0)
+        return 1;                   /* Progressive: gray fallback */
+
+    ji->mcux = ((int)cinfo->image_width + 8 * ji->hmax - 1) /
+               (8 * ji->hmax);
+    ji->mcuy = ((int)cinfo->image_height + 8 * ji->vmax - 1) /
+               (8 * ji->vmax);
+
+    for (ci = 0; ci < ji->ncomp; ci++) {
+        struct jv_component *c = &ji->comp[ci];
+
+        c->pw = ji->mcux * c->h * ji->n;
+        c->ph = ji->mcuy * c->v * ji->n;
+        c->dc_pred = 0;
+        free(c->plane);
+        c->plane = calloc(1, (size_t)c->pw * (size_t)c->ph);
+        if (!c->plane)
+            return 0;
+    }
+
+    /* Region -> MCU row window (full-res coords) */
+    {
+        int row_lo = 0;
+        int row_hi = ji->mcuy;
+
+        if (ji->rw > 0) {
+            row_lo = (int)(ji->ry / (8u * (unsigned)ji->vmax));
+            row_hi = (int)((ji->ry + ji->rh + 8u * (unsigned)ji->vmax -
+                            1) / (8u * (unsigned)ji->vmax));
+            if (row_hi > ji->mcuy)
+                row_hi = ji->mcuy;
+        }
+        if (jv_decode_image(ji, row_lo, row_hi) < 0) {
+            /* Keep whatever decoded; planes default to zero */
+        }
+    }
+
+    /* Color-convert into the RGB output buffer */
+    free(ji->rgb);
+    ji->rgb = malloc((size_t)cinfo->output_width *
+                     (size_t)cinfo->output_height *
+                     (size_t)cinfo->output_components);
+    if (!ji->rgb)
+        return 0;
 
+    {
+        unsigned int x, y;
+        struct jv_component *cy = &ji->comp[0];
+
+        for (y = 0; y < cinfo->output_height; y++) {
+            uint8_t *out = ji->rgb + (size_t)y * cinfo->output_width *
+                                      cinfo->output_components;
+
+            for (x = 0; x < cinfo->output_width; x++) {
+                int Y = cy->plane[(size_t)(y * cy->v / ji->vmax) *
+                                  cy->pw + (x * cy->h / ji->hmax)];
+
+                if (cinfo->output_components == 1) {
+                    out[x] = (uint8_t)Y;
+                    continue;
+                }
+                {
+                    struct jv_component *cb = &ji->comp[1];
+                    struct jv_component *cr = &ji->comp[2];
+                    int Cb = cb->plane[(size_t)(y * cb->v / ji->vmax) *
+                                       cb->pw +
+                                       (x * cb->h / ji->hmax)] - 128;
+                    int Cr = cr->plane[(size_t)(y * cr->v / ji->vmax) *
+                                       cr->pw +
+                                       (x * cr->h / ji->hmax)] - 128;
+                    int r = Y + ((91881 * Cr) >> 16);
+                    int g = Y - ((22554 * Cb + 46802 * Cr) >> 16);
+                    int b = Y + ((116130 * Cb) >> 16);
+
+                    out[x * 3 + 0] = jv_clamp(r);
+                    out[x * 3 + 1] = jv_clamp(g);
+                    out[x * 3 + 2] = jv_clamp(b);
+                }
+            }
+        }
+    }
+
+    ji->decoded = 1;
     return 1;
 }
 
+/** VeridianOS extension: restrict decode to a region of interest in
+ *  full-resolution pixel coordinates.  Call before
+ *  jpeg_start_decompress; MCU rows outside the region are entropy-
+ *  skipped (no IDCT, no color conversion).  Pass w == 0 to reset. */
+void jpeg_veridian_set_region(j_decompress_ptr cinfo, unsigned int x,
+                              unsigned int y, unsigned int w,
+                              unsigned int h)
+{
+    struct jpeg_internal *ji;
+
+    if (cinfo == NULL || cinfo->_internal == NULL)
+        return;
+    ji = (struct jpeg_internal *)cinfo->_internal;
+    ji->rx = x;
+    ji->ry = y;
+    ji->rw = w;
+    ji->rh = h;
+}
+
 JDIMENSION jpeg_read_scanlines(j_decompress_ptr cinfo,
                                JSAMPARRAY scanlines,
                                JDIMENSION max_lines)
 {
+    struct jpeg_internal *ji;
     JDIMENSION lines_read = 0;
     JDIMENSION i;
+    size_t rowbytes;
 
     if (cinfo == NULL || scanlines == NULL)
         return 0;
+    ji = (struct jpeg_internal *)cinfo->_internal;
+    rowbytes = (size_t)cinfo->output_width *
+               (size_t)cinfo->output_components;
 
     for (i = 0; i < max_lines; i++) {
         if (cinfo->output_scanline >= cinfo->output_height)
             break;
-
-        /* Fill with gray placeholder (128,128,128) */
         if (scanlines[i] != NULL) {
-            memset(scanlines[i], 128,
-                   (size_t)cinfo->output_width * (size_t)cinfo->output_components);
+            if (ji && ji->decoded && ji->rgb) {
+                memcpy(scanlines[i],
+                       ji->rgb +
+                           (size_t)cinfo->output_scanline * rowbytes,
+                       rowbytes);
+            } else {
+                /* Progressive or failed decode: gray placeholder */
+                memset(scanlines[i], 128, rowbytes);
+            }
         }
-
         cinfo->output_scanline++;
         lines_read++;
     }
-
     return lines_read;
 }
 
@@ -230,6 +987,15 @@ int jpeg_finish_decompress(j_decompress_ptr cinfo)
 void jpeg_destroy_decompress(j_decompress_ptr cinfo)
 {
     if (cinfo == NULL) return;
+    if (cinfo->_internal) {
+        struct jpeg_internal *ji =
+            (struct jpeg_internal *)cinfo->_internal;
+        int ci;
+
+        for (ci = 0; ci < JV_MAX_COMPONENTS; ci++)
+            free(ji->comp[ci].plane);
+        free(ji->rgb);
+    }
     free(cinfo->_internal);
     cinfo->_internal = NULL;
     cinfo->global_state = 0;
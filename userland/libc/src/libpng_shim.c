@@ -14,6 +14,13 @@
 #include <zlib.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 /* ========================================================================= */
 /* Internal structures                                                       */
@@ -34,8 +41,47 @@ struct png_struct_def {
     size_t         idat_capacity;
     /* Transform flags */
     int            transforms;
+
+    /* Geometry captured at png_read_info so the decode loop never has
+     * to guess row layout from the data */
+    png_uint_32    width;
+    png_uint_32    height;
+    png_size_t     rowbytes;
+    int            bpp;           /* Filter delta distance, bytes */
+    int            interlace;
 };
 
+/* Decode timing counters (process-wide) */
+struct png_decode_stats {
+    unsigned long long images;
+    unsigned long long inflate_ns;
+    unsigned long long defilter_ns;
+};
+
+static struct png_decode_stats g_png_stats;
+
+static unsigned long long png_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ull +
+           (unsigned long long)ts.tv_nsec;
+}
+
+/** VeridianOS extension: cumulative decode timing counters. */
+void png_veridian_get_decode_stats(unsigned long long *images,
+                                   unsigned long long *inflate_ns,
+                                   unsigned long long *defilter_ns)
+{
+    if (images)
+        *images = g_png_stats.images;
+    if (inflate_ns)
+        *inflate_ns = g_png_stats.inflate_ns;
+    if (defilter_ns)
+        *defilter_ns = g_png_stats.defilter_ns;
+}
+
 struct png_info_def {
     png_uint_32    width;
     png_uint_32    height;
@@ -241,6 +287,15 @@ void png_read_info(png_structrp png_ptr, png_inforp info_ptr)
                                      ((png_size_t)info_ptr->bit_depth / 8);
                 info_ptr->valid = 1;
 
+                /* Mirror the geometry into the read struct: the
+                 * decode loop needs it and callers only pass png_ptr */
+                png_ptr->width = info_ptr->width;
+                png_ptr->height = info_ptr->height;
+                png_ptr->rowbytes = info_ptr->rowbytes;
+                png_ptr->bpp = info_ptr->channels *
+                               (info_ptr->bit_depth > 8 ? 2 : 1);
+                png_ptr->interlace = info_ptr->interlace_type;
+
                 /* Skip remaining + CRC */
                 if (length > 13) {
                     unsigned char skip;
@@ -305,6 +360,143 @@ void png_read_update_info(png_structrp png_ptr, png_inforp info_ptr)
  *   3 = Average
  *   4 = Paeth
  */
+/*
+ * Vectorized defilter kernels.
+ *
+ * Up is embarrassingly parallel (row[i] += prev[i]) and runs 16 bytes
+ * per step on SSE2/NEON.  Sub/Average/Paeth carry a loop dependency on
+ * the left pixel, so for the dominant bpp=4 (RGBA8) case they advance
+ * one pixel per iteration with the per-pixel math done branch-free;
+ * Paeth's three-way select is computed with vector min/compare instead
+ * of branches.  The byte-wise loops remain for every other geometry.
+ */
+
+static void unfilter_up_vec(unsigned char *row, const unsigned char *prev,
+                            size_t rowbytes)
+{
+    size_t i = 0;
+
+#if defined(__x86_64__)
+    for (; i + 16 <= rowbytes; i += 16) {
+        __m128i r = _mm_loadu_si128((const __m128i *)(row + i));
+        __m128i p = _mm_loadu_si128((const __m128i *)(prev + i));
+
+        _mm_storeu_si128((__m128i *)(row + i), _mm_add_epi8(r, p));
+    }
+#elif defined(__aarch64__)
+    for (; i + 16 <= rowbytes; i += 16) {
+        uint8x16_t r = vld1q_u8(row + i);
+        uint8x16_t p = vld1q_u8(prev + i);
+
+        vst1q_u8(row + i, vaddq_u8(r, p));
+    }
+#endif
+    for (; i < rowbytes; i++)
+        row[i] += prev[i];
+}
+
+#if defined(__x86_64__)
+/* One RGBA8 pixel per step; the recurrence value stays in a register */
+static int load_px(const unsigned char *p)
+{
+    int v;
+
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static void store_px(unsigned char *p, int v)
+{
+    memcpy(p, &v, 4);
+}
+
+static void unfilter_sub4_sse2(unsigned char *row, size_t rowbytes)
+{
+    __m128i left = _mm_setzero_si128();
+    size_t i;
+
+    for (i = 0; i + 4 <= rowbytes; i += 4) {
+        __m128i x = _mm_cvtsi32_si128(load_px(row + i));
+
+        x = _mm_add_epi8(x, left);
+        store_px(row + i, _mm_cvtsi128_si32(x));
+        left = x;
+    }
+}
+
+static void unfilter_avg4_sse2(unsigned char *row,
+                               const unsigned char *prev, size_t rowbytes)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i left = zero;
+    size_t i;
+
+    for (i = 0; i + 4 <= rowbytes; i += 4) {
+        __m128i x = _mm_unpacklo_epi8(
+            _mm_cvtsi32_si128(load_px(row + i)), zero);
+        __m128i b = _mm_unpacklo_epi8(
+            prev ? _mm_cvtsi32_si128(load_px(prev + i)) : zero, zero);
+        __m128i avg = _mm_srli_epi16(_mm_add_epi16(left, b), 1);
+
+        x = _mm_and_si128(_mm_add_epi16(x, avg), _mm_set1_epi16(0xff));
+        store_px(row + i, _mm_cvtsi128_si32(_mm_packus_epi16(x, x)));
+        left = x;
+    }
+}
+
+static void unfilter_paeth4_sse2(unsigned char *row,
+                                 const unsigned char *prev,
+                                 size_t rowbytes)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i a = zero;               /* Left, widened to u16 */
+    __m128i c = zero;               /* Upper-left            */
+    size_t i;
+
+    for (i = 0; i + 4 <= rowbytes; i += 4) {
+        __m128i b = _mm_unpacklo_epi8(
+            prev ? _mm_cvtsi32_si128(load_px(prev + i)) : zero, zero);
+        __m128i x = _mm_unpacklo_epi8(
+            _mm_cvtsi32_si128(load_px(row + i)), zero);
+
+        /* p = a + b - c; choose the predictor with the smallest
+         * |p - {a,b,c}| via branch-free compares */
+        __m128i pa = _mm_sub_epi16(b, c);       /* p - a */
+        __m128i pb = _mm_sub_epi16(a, c);       /* p - b */
+        __m128i pc = _mm_add_epi16(pa, pb);     /* p - c */
+        __m128i apa = _mm_max_epi16(pa, _mm_sub_epi16(zero, pa));
+        __m128i apb = _mm_max_epi16(pb, _mm_sub_epi16(zero, pb));
+        __m128i apc = _mm_max_epi16(pc, _mm_sub_epi16(zero, pc));
+        __m128i use_a = _mm_and_si128(
+            _mm_cmplt_epi16(apa, apb),
+            _mm_cmplt_epi16(apa, apc));
+        use_a = _mm_or_si128(use_a, _mm_and_si128(
+            _mm_cmpeq_epi16(apa, apb), _mm_cmplt_epi16(apa, apc)));
+        use_a = _mm_or_si128(use_a,
+            _mm_and_si128(_mm_cmpeq_epi16(apa, apc),
+                          _mm_cmplt_epi16(apa, apb)));
+        use_a = _mm_or_si128(use_a, _mm_and_si128(
+            _mm_cmpeq_epi16(apa, apb), _mm_cmpeq_epi16(apa, apc)));
+        {
+            __m128i use_b = _mm_andnot_si128(use_a,
+                _mm_or_si128(_mm_cmplt_epi16(apb, apc),
+                             _mm_cmpeq_epi16(apb, apc)));
+            __m128i pred = _mm_or_si128(
+                _mm_and_si128(use_a, a),
+                _mm_or_si128(_mm_and_si128(use_b, b),
+                             _mm_andnot_si128(
+                                 _mm_or_si128(use_a, use_b), c)));
+
+            x = _mm_and_si128(_mm_add_epi16(x, pred),
+                              _mm_set1_epi16(0xff));
+        }
+        store_px(row + i, _mm_cvtsi128_si32(_mm_packus_epi16(x, x)));
+        a = x;
+        c = b;
+    }
+}
+#endif /* __x86_64__ */
+
 static void unfilter_row(unsigned char *row, const unsigned char *prev,
                          size_t rowbytes, int bpp, int filter)
 {
@@ -314,16 +506,26 @@ static void unfilter_row(unsigned char *row, const unsigned char *prev,
     case 0: /* None */
         break;
     case 1: /* Sub */
+#if defined(__x86_64__)
+        if (bpp == 4 && (rowbytes & 3) == 0) {
+            unfilter_sub4_sse2(row, rowbytes);
+            break;
+        }
+#endif
         for (i = (size_t)bpp; i < rowbytes; i++)
             row[i] += row[i - bpp];
         break;
     case 2: /* Up */
-        if (prev) {
-            for (i = 0; i < rowbytes; i++)
-                row[i] += prev[i];
-        }
+        if (prev)
+            unfilter_up_vec(row, prev, rowbytes);
         break;
     case 3: /* Average */
+#if defined(__x86_64__)
+        if (bpp == 4 && (rowbytes & 3) == 0) {
+            unfilter_avg4_sse2(row, prev, rowbytes);
+            break;
+        }
+#endif
         for (i = 0; i < rowbytes; i++) {
             unsigned int a = (i >= (size_t)bpp) ? row[i - bpp] : 0;
             unsigned int b = prev ? prev[i] : 0;
@@ -331,6 +533,12 @@ static void unfilter_row(unsigned char *row, const unsigned char *prev,
         }
         break;
     case 4: /* Paeth */
+#if defined(__x86_64__)
+        if (bpp == 4 && (rowbytes & 3) == 0) {
+            unfilter_paeth4_sse2(row, prev, rowbytes);
+            break;
+        }
+#endif
         for (i = 0; i < rowbytes; i++) {
             int a = (i >= (size_t)bpp) ? row[i - bpp] : 0;
             int b = prev ? prev[i] : 0;
@@ -350,36 +558,41 @@ static void unfilter_row(unsigned char *row, const unsigned char *prev,
     }
 }
 
+/* Adam7 pass geometry */
+static const int adam7_xstart[7] = { 0, 4, 0, 2, 0, 1, 0 };
+static const int adam7_ystart[7] = { 0, 0, 4, 0, 2, 0, 1 };
+static const int adam7_xstep[7]  = { 8, 8, 4, 4, 2, 2, 1 };
+static const int adam7_ystep[7]  = { 8, 8, 8, 4, 4, 2, 2 };
+
 void png_read_image(png_structrp png_ptr, png_bytepp image)
 {
-    png_infop info;
     unsigned char *raw;
     unsigned long raw_size;
     size_t rowbytes;
     int bpp;
     png_uint_32 y;
     size_t pos;
+    unsigned long long t0, t1;
 
     if (png_ptr == NULL || image == NULL)
         return;
     if (png_ptr->idat_buf == NULL || png_ptr->idat_size == 0)
         return;
+    if (png_ptr->height == 0 || png_ptr->rowbytes == 0)
+        return;                     /* png_read_info not called */
 
-    /* We need the info from a prior png_read_info call.
-     * Since we don't store a back-pointer to info, use io_ptr
-     * or just assume standard layout from the first read. */
+    rowbytes = png_ptr->rowbytes;
+    bpp = png_ptr->bpp;
 
-    /* Decompress the IDAT data using raw inflate (no zlib header) */
-    /* PNG uses zlib-wrapped deflate, so use inflateInit (not inflateInit2) */
+    /* Decompress the IDAT stream (zlib-wrapped deflate) */
+    t0 = png_now_ns();
     {
         z_stream strm;
         int ret;
 
-        /* Estimate raw size: height * (rowbytes + 1 filter byte) */
-        /* We don't have info_ptr here, so allocate generously */
-        raw_size = png_ptr->idat_size * 4;
-        if (raw_size < 65536)
-            raw_size = 65536;
+        raw_size = (unsigned long)((rowbytes + 1) * png_ptr->height);
+        if (png_ptr->interlace)
+            raw_size += (unsigned long)png_ptr->height * 8 + 64;
         raw = (unsigned char *)malloc(raw_size);
         if (raw == NULL)
             return;
@@ -405,61 +618,98 @@ void png_read_image(png_structrp png_ptr, png_bytepp image)
             return;
         }
     }
-
-    /* Now defilter rows.  Each row in the raw data is:
-     * [filter_byte] [rowbytes of pixel data]
-     * We need to know rowbytes, but we only have the raw data.
-     * Infer from the total: raw_size = height * (rowbytes + 1) */
-    /* We'll iterate image[] array and fill rows */
-    pos = 0;
-    y = 0;
-    /* Determine rowbytes from first row -- we need an external hint.
-     * Look at image[0] pointer spacing if available, but generally
-     * callers set this up from info. We'll just trust the data. */
-
-    /* Try to figure out dimensions from raw_size.
-     * If caller provided image[0..height-1], we assume they know height.
-     * We walk raw data row by row. */
-    while (pos < raw_size && image[y] != NULL) {
-        int filter = raw[pos++];
-
-        /* Determine rowbytes by looking at how much data until next filter byte
-         * or end of data.  This is a heuristic. */
-        /* Actually, the user allocates image rows with known rowbytes from
-         * png_get_rowbytes(). We can compute from available info. */
-        /* For now, copy what's available until the next row */
-        rowbytes = 0;
-        {
-            /* Scan forward for a reasonable rowbytes value */
-            /* Use remaining_data / remaining_rows as estimate */
-            size_t remaining = raw_size - pos;
-            /* This is imperfect without the info struct, but functional
-             * when called correctly after png_read_info. */
-            /* Assume max 8192 pixels wide, 4 channels, 1 byte each */
-            size_t test_rb;
-            for (test_rb = remaining; test_rb > 0; test_rb--) {
-                /* If test_rb divides remaining data evenly with filter bytes */
-                if ((remaining + 1) % (test_rb + 1) == 0)
-                    break;
-            }
-            if (test_rb == 0) test_rb = remaining;
-            rowbytes = test_rb;
-            if (rowbytes > remaining) rowbytes = remaining;
+    t1 = png_now_ns();
+    g_png_stats.inflate_ns += t1 - t0;
+
+    t0 = t1;
+    if (!png_ptr->interlace) {
+        /*
+         * Fast path: non-interlaced rows defilter straight into the
+         * caller's row pointers -- one copy from the inflate buffer,
+         * vector kernels in place, no intermediate image.
+         */
+        pos = 0;
+        for (y = 0; y < png_ptr->height && image[y] != NULL; y++) {
+            int filter;
+
+            if (pos + 1 + rowbytes > raw_size)
+                break;
+            filter = raw[pos++];
+            memcpy(image[y], raw + pos, rowbytes);
+            unfilter_row(image[y], (y > 0) ? image[y - 1] : NULL,
+                         rowbytes, bpp, filter);
+            pos += rowbytes;
+        }
+    } else {
+        /*
+         * Adam7: each pass is an independently filtered sub-image;
+         * defilter the pass rows, then scatter pixels to their final
+         * positions.  Byte-aligned depths only (bpp is in bytes).
+         */
+        unsigned char *prev_row = NULL;
+        unsigned char *pass_row = malloc(rowbytes + 1);
+        unsigned char *prev_buf = malloc(rowbytes + 1);
+        int pass;
+
+        if (!pass_row || !prev_buf) {
+            free(pass_row);
+            free(prev_buf);
+            free(raw);
+            return;
         }
 
-        if (pos + rowbytes > raw_size)
-            rowbytes = raw_size - pos;
-
-        memcpy(image[y], raw + pos, rowbytes);
-        bpp = 1;  /* minimum bytes per pixel */
+        pos = 0;
+        for (pass = 0; pass < 7; pass++) {
+            png_uint_32 pw =
+                (png_ptr->width - adam7_xstart[pass] +
+                 adam7_xstep[pass] - 1) / adam7_xstep[pass];
+            png_uint_32 ph =
+                (png_ptr->height - adam7_ystart[pass] +
+                 adam7_ystep[pass] - 1) / adam7_ystep[pass];
+            size_t pass_rb = (size_t)pw * (size_t)bpp;
+
+            if (pw == 0 || ph == 0)
+                continue;
+
+            prev_row = NULL;
+            for (y = 0; y < ph; y++) {
+                png_uint_32 out_y = adam7_ystart[pass] +
+                                    y * adam7_ystep[pass];
+                png_uint_32 x;
+                int filter;
+
+                if (pos + 1 + pass_rb > raw_size)
+                    break;
+                filter = raw[pos++];
+                memcpy(pass_row, raw + pos, pass_rb);
+                pos += pass_rb;
+                unfilter_row(pass_row, prev_row, pass_rb, bpp, filter);
+
+                if (image[out_y]) {
+                    for (x = 0; x < pw; x++) {
+                        png_uint_32 out_x = adam7_xstart[pass] +
+                                            x * adam7_xstep[pass];
+
+                        memcpy(image[out_y] + (size_t)out_x * bpp,
+                               pass_row + (size_t)x * bpp, (size_t)bpp);
+                    }
+                }
 
-        /* Unfilter */
-        unfilter_row(image[y], (y > 0) ? image[y - 1] : NULL,
-                     rowbytes, bpp, filter);
+                /* Rotate row buffers for the Up/Avg/Paeth reference */
+                {
+                    unsigned char *tmp = prev_buf;
 
-        pos += rowbytes;
-        y++;
+                    prev_buf = pass_row;
+                    pass_row = tmp;
+                    prev_row = prev_buf;
+                }
+            }
+        }
+        free(pass_row);
+        free(prev_buf);
     }
+    g_png_stats.defilter_ns += png_now_ns() - t0;
+    g_png_stats.images++;
 
     free(raw);
 }
@@ -14,7 +14,9 @@
 #include <libxml/xpath.h>
 #include <libxml/xmlstring.h>
 #include <libxml/xmlmemory.h>
+#include <libxml/xmlreader.h>
 #include <expat.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -661,3 +663,519 @@ int xmlXPathRegisterNs(xmlXPathContextPtr ctxt,
 }
 
 void xmlXPathInit(void) { }
+
+/* ========================================================================= */
+/* xmlTextReader pull parser                                                 */
+/* ========================================================================= */
+
+/*
+ * Streaming pull parser: the document is tokenized on demand and no
+ * DOM is built, so scanning a config file for a handful of elements
+ * allocates one buffer and a text scratch -- untouched subtrees cost
+ * a memchr.  Element names are interned per reader so dispatch code
+ * can switch on pointer identity.
+ */
+
+#define XRD_MAX_ATTRS 16
+#define XRD_MAX_NAME  128
+#define XRD_MAX_INTERN 64
+
+struct _xmlTextReader {
+    char  *buf;                     /* Owned copy of the document */
+    int    len;
+    int    pos;
+    int    depth;
+
+    int    node_type;
+    const char *name;               /* Interned */
+    char  *value;                   /* Decoded text scratch       */
+    int    value_cap;
+    int    empty_element;
+
+    /* Current element's attributes (raw slices into buf) */
+    int    attr_count;
+    const char *attr_name[XRD_MAX_ATTRS];
+    int    attr_name_len[XRD_MAX_ATTRS];
+    const char *attr_val[XRD_MAX_ATTRS];
+    int    attr_val_len[XRD_MAX_ATTRS];
+
+    /* Name intern pool */
+    char   intern[XRD_MAX_INTERN][XRD_MAX_NAME];
+    int    intern_count;
+};
+
+static const char *xrd_intern(xmlTextReaderPtr r, const char *s, int len)
+{
+    int i;
+
+    if (len >= XRD_MAX_NAME)
+        len = XRD_MAX_NAME - 1;
+    for (i = 0; i < r->intern_count; i++) {
+        if ((int)strlen(r->intern[i]) == len &&
+            memcmp(r->intern[i], s, (size_t)len) == 0)
+            return r->intern[i];
+    }
+    if (r->intern_count >= XRD_MAX_INTERN) {
+        /* Pool full (pathological document): reuse the last slot so
+         * the returned name is always NUL-terminated; pointer
+         * identity is lost for the overflow names only */
+        memcpy(r->intern[XRD_MAX_INTERN - 1], s, (size_t)len);
+        r->intern[XRD_MAX_INTERN - 1][len] = '\0';
+        return r->intern[XRD_MAX_INTERN - 1];
+    }
+    memcpy(r->intern[r->intern_count], s, (size_t)len);
+    r->intern[r->intern_count][len] = '\0';
+    return r->intern[r->intern_count++];
+}
+
+/* Decode predefined entities and character references into r->value */
+static int xrd_decode(xmlTextReaderPtr r, const char *s, int len)
+{
+    int out = 0;
+    int i = 0;
+
+    if (len + 1 > r->value_cap) {
+        int cap = r->value_cap ? r->value_cap : 128;
+        char *grown;
+
+        while (len + 1 > cap)
+            cap *= 2;
+        grown = realloc(r->value, (size_t)cap);
+        if (!grown)
+            return -1;
+        r->value = grown;
+        r->value_cap = cap;
+    }
+
+    while (i < len) {
+        if (s[i] == '&') {
+            if (i + 3 < len && memcmp(s + i, "&lt;", 4) == 0) {
+                r->value[out++] = '<'; i += 4; continue;
+            }
+            if (i + 3 < len && memcmp(s + i, "&gt;", 4) == 0) {
+                r->value[out++] = '>'; i += 4; continue;
+            }
+            if (i + 4 < len && memcmp(s + i, "&amp;", 5) == 0) {
+                r->value[out++] = '&'; i += 5; continue;
+            }
+            if (i + 5 < len && memcmp(s + i, "&apos;", 6) == 0) {
+                r->value[out++] = '\''; i += 6; continue;
+            }
+            if (i + 5 < len && memcmp(s + i, "&quot;", 6) == 0) {
+                r->value[out++] = '"'; i += 6; continue;
+            }
+            if (i + 2 < len && s[i + 1] == '#') {
+                /* Character reference (decimal or hex), UTF-8 encoded */
+                long cp = 0;
+                int j = i + 2;
+
+                if (s[j] == 'x' || s[j] == 'X') {
+                    for (j++; j < len && s[j] != ';'; j++) {
+                        char c = s[j];
+                        cp <<= 4;
+                        if (c >= '0' && c <= '9') cp |= c - '0';
+                        else if (c >= 'a' && c <= 'f') cp |= c - 'a' + 10;
+                        else if (c >= 'A' && c <= 'F') cp |= c - 'A' + 10;
+                        else { cp = -1; break; }
+                    }
+                } else {
+                    for (; j < len && s[j] != ';'; j++) {
+                        if (s[j] < '0' || s[j] > '9') { cp = -1; break; }
+                        cp = cp * 10 + (s[j] - '0');
+                    }
+                }
+                if (cp >= 0 && j < len && s[j] == ';') {
+                    if (cp < 0x80) {
+                        r->value[out++] = (char)cp;
+                    } else if (cp < 0x800) {
+                        r->value[out++] = (char)(0xc0 | (cp >> 6));
+                        r->value[out++] = (char)(0x80 | (cp & 0x3f));
+                    } else if (cp < 0x10000) {
+                        r->value[out++] = (char)(0xe0 | (cp >> 12));
+                        r->value[out++] = (char)(0x80 | ((cp >> 6) & 0x3f));
+                        r->value[out++] = (char)(0x80 | (cp & 0x3f));
+                    } else {
+                        r->value[out++] = (char)(0xf0 | (cp >> 18));
+                        r->value[out++] = (char)(0x80 | ((cp >> 12) & 0x3f));
+                        r->value[out++] = (char)(0x80 | ((cp >> 6) & 0x3f));
+                        r->value[out++] = (char)(0x80 | (cp & 0x3f));
+                    }
+                    i = j + 1;
+                    continue;
+                }
+            }
+        }
+        r->value[out++] = s[i++];
+    }
+    r->value[out] = '\0';
+    return out;
+}
+
+xmlTextReaderPtr xmlReaderForMemory(const char *buffer, int size,
+                                    const char *url, const char *encoding,
+                                    int options)
+{
+    xmlTextReaderPtr r;
+
+    (void)url;
+    (void)encoding;
+    (void)options;
+    if (!buffer || size <= 0)
+        return NULL;
+
+    r = calloc(1, sizeof(*r));
+    if (!r)
+        return NULL;
+    r->buf = malloc((size_t)size);
+    if (!r->buf) {
+        free(r);
+        return NULL;
+    }
+    memcpy(r->buf, buffer, (size_t)size);
+    r->len = size;
+    return r;
+}
+
+xmlTextReaderPtr xmlReaderForFile(const char *filename,
+                                  const char *encoding, int options)
+{
+    FILE *f;
+    long size;
+    char *data;
+    xmlTextReaderPtr r;
+
+    if (!filename)
+        return NULL;
+    f = fopen(filename, "rb");
+    if (!f)
+        return NULL;
+    fseek(f, 0, SEEK_END);
+    size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (size <= 0) {
+        fclose(f);
+        return NULL;
+    }
+    data = malloc((size_t)size);
+    if (!data || fread(data, 1, (size_t)size, f) != (size_t)size) {
+        free(data);
+        fclose(f);
+        return NULL;
+    }
+    fclose(f);
+
+    r = xmlReaderForMemory(data, (int)size, filename, encoding, options);
+    free(data);
+    return r;
+}
+
+void xmlFreeTextReader(xmlTextReaderPtr reader)
+{
+    if (!reader)
+        return;
+    free(reader->buf);
+    free(reader->value);
+    free(reader);
+}
+
+static int xrd_is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/* Parse the attribute list of an open tag; p points after the name */
+static int xrd_parse_attrs(xmlTextReaderPtr r, int p)
+{
+    r->attr_count = 0;
+
+    for (;;) {
+        while (p < r->len && xrd_is_space(r->buf[p]))
+            p++;
+        if (p >= r->len)
+            return -1;
+        if (r->buf[p] == '>')
+            return p + 1;
+        if (r->buf[p] == '/' && p + 1 < r->len && r->buf[p + 1] == '>') {
+            r->empty_element = 1;
+            return p + 2;
+        }
+
+        {
+            int name_start = p;
+            int name_len;
+            char quote;
+            int val_start;
+
+            while (p < r->len && r->buf[p] != '=' &&
+                   !xrd_is_space(r->buf[p]))
+                p++;
+            name_len = p - name_start;
+            while (p < r->len && xrd_is_space(r->buf[p]))
+                p++;
+            if (p >= r->len || r->buf[p] != '=')
+                return -1;
+            p++;
+            while (p < r->len && xrd_is_space(r->buf[p]))
+                p++;
+            if (p >= r->len ||
+                (r->buf[p] != '"' && r->buf[p] != '\''))
+                return -1;
+            quote = r->buf[p++];
+            val_start = p;
+            while (p < r->len && r->buf[p] != quote)
+                p++;
+            if (p >= r->len)
+                return -1;
+
+            if (r->attr_count < XRD_MAX_ATTRS) {
+                r->attr_name[r->attr_count] = r->buf + name_start;
+                r->attr_name_len[r->attr_count] = name_len;
+                r->attr_val[r->attr_count] = r->buf + val_start;
+                r->attr_val_len[r->attr_count] = p - val_start;
+                r->attr_count++;
+            }
+            p++;                    /* Closing quote */
+        }
+    }
+}
+
+int xmlTextReaderRead(xmlTextReaderPtr reader)
+{
+    xmlTextReaderPtr r = reader;
+
+    if (!r)
+        return -1;
+
+    for (;;) {
+        int p = r->pos;
+
+        if (p >= r->len)
+            return 0;
+
+        if (r->buf[p] != '<') {
+            /* Text run up to the next tag */
+            int start = p;
+            const char *lt = memchr(r->buf + p, '<',
+                                    (size_t)(r->len - p));
+            int end = lt ? (int)(lt - r->buf) : r->len;
+            int ws = 1;
+            int i;
+
+            for (i = start; i < end; i++) {
+                if (!xrd_is_space(r->buf[i])) {
+                    ws = 0;
+                    break;
+                }
+            }
+            r->pos = end;
+            if (ws)
+                continue;           /* Whitespace between tags */
+            if (xrd_decode(r, r->buf + start, end - start) < 0)
+                return -1;
+            r->node_type = XML_READER_TYPE_TEXT;
+            r->name = "#text";
+            return 1;
+        }
+
+        /* Tag */
+        if (p + 1 >= r->len)
+            return -1;
+
+        if (r->buf[p + 1] == '?') {
+            /* Processing instruction / XML declaration: skip */
+            const char *end = NULL;
+            int q;
+
+            for (q = p + 2; q + 1 < r->len; q++) {
+                if (r->buf[q] == '?' && r->buf[q + 1] == '>') {
+                    end = r->buf + q;
+                    break;
+                }
+            }
+            if (!end)
+                return -1;
+            r->pos = (int)(end - r->buf) + 2;
+            continue;
+        }
+
+        if (p + 3 < r->len && memcmp(r->buf + p, "<!--", 4) == 0) {
+            int q;
+
+            for (q = p + 4; q + 2 < r->len; q++) {
+                if (memcmp(r->buf + q, "-->", 3) == 0) {
+                    if (xrd_decode(r, r->buf + p + 4, q - p - 4) < 0)
+                        return -1;
+                    r->pos = q + 3;
+                    r->node_type = XML_READER_TYPE_COMMENT;
+                    r->name = "#comment";
+                    return 1;
+                }
+            }
+            return -1;
+        }
+
+        if (p + 8 < r->len && memcmp(r->buf + p, "<![CDATA[", 9) == 0) {
+            int q;
+
+            for (q = p + 9; q + 2 < r->len; q++) {
+                if (memcmp(r->buf + q, "]]>", 3) == 0) {
+                    if (xrd_decode(r, r->buf + p + 9, q - p - 9) < 0)
+                        return -1;
+                    r->pos = q + 3;
+                    r->node_type = XML_READER_TYPE_CDATA;
+                    r->name = "#cdata-section";
+                    return 1;
+                }
+            }
+            return -1;
+        }
+
+        if (p + 1 < r->len && r->buf[p + 1] == '!') {
+            /* DOCTYPE and friends: skip to '>' */
+            const char *gt = memchr(r->buf + p, '>',
+                                    (size_t)(r->len - p));
+
+            if (!gt)
+                return -1;
+            r->pos = (int)(gt - r->buf) + 1;
+            continue;
+        }
+
+        if (r->buf[p + 1] == '/') {
+            /* End tag */
+            int name_start = p + 2;
+            int q = name_start;
+
+            while (q < r->len && r->buf[q] != '>' &&
+                   !xrd_is_space(r->buf[q]))
+                q++;
+            r->name = xrd_intern(r, r->buf + name_start, q - name_start);
+            while (q < r->len && r->buf[q] != '>')
+                q++;
+            if (q >= r->len)
+                return -1;
+            r->pos = q + 1;
+            r->depth--;
+            if (r->depth < 0)
+                return -1;
+            r->node_type = XML_READER_TYPE_END_ELEMENT;
+            r->attr_count = 0;
+            r->empty_element = 0;
+            return 1;
+        }
+
+        /* Start tag */
+        {
+            int name_start = p + 1;
+            int q = name_start;
+            int after;
+
+            while (q < r->len && r->buf[q] != '>' && r->buf[q] != '/' &&
+                   !xrd_is_space(r->buf[q]))
+                q++;
+            if (q == name_start)
+                return -1;
+            r->name = xrd_intern(r, r->buf + name_start, q - name_start);
+            r->empty_element = 0;
+            after = xrd_parse_attrs(r, q);
+            if (after < 0)
+                return -1;
+            r->pos = after;
+            r->node_type = XML_READER_TYPE_ELEMENT;
+            if (!r->empty_element)
+                r->depth++;
+            return 1;
+        }
+    }
+}
+
+int xmlTextReaderNodeType(xmlTextReaderPtr reader)
+{
+    return reader ? reader->node_type : XML_READER_TYPE_NONE;
+}
+
+const xmlChar *xmlTextReaderConstName(xmlTextReaderPtr reader)
+{
+    return reader ? (const xmlChar *)reader->name : NULL;
+}
+
+const xmlChar *xmlTextReaderConstValue(xmlTextReaderPtr reader)
+{
+    if (!reader)
+        return NULL;
+    switch (reader->node_type) {
+    case XML_READER_TYPE_TEXT:
+    case XML_READER_TYPE_CDATA:
+    case XML_READER_TYPE_COMMENT:
+        return (const xmlChar *)reader->value;
+    default:
+        return NULL;
+    }
+}
+
+int xmlTextReaderDepth(xmlTextReaderPtr reader)
+{
+    if (!reader)
+        return -1;
+    /* Depth of the current node: an open element's own depth is one
+     * less than the running child depth */
+    if (reader->node_type == XML_READER_TYPE_ELEMENT &&
+        !reader->empty_element)
+        return reader->depth - 1;
+    return reader->depth;
+}
+
+int xmlTextReaderIsEmptyElement(xmlTextReaderPtr reader)
+{
+    return (reader &&
+            reader->node_type == XML_READER_TYPE_ELEMENT &&
+            reader->empty_element) ? 1 : 0;
+}
+
+int xmlTextReaderAttributeCount(xmlTextReaderPtr reader)
+{
+    return reader ? reader->attr_count : 0;
+}
+
+xmlChar *xmlTextReaderGetAttribute(xmlTextReaderPtr reader,
+                                   const xmlChar *name)
+{
+    int i;
+    int len;
+
+    if (!reader || !name)
+        return NULL;
+    len = (int)strlen((const char *)name);
+
+    for (i = 0; i < reader->attr_count; i++) {
+        if (reader->attr_name_len[i] == len &&
+            memcmp(reader->attr_name[i], name, (size_t)len) == 0) {
+            if (xrd_decode(reader, reader->attr_val[i],
+                           reader->attr_val_len[i]) < 0)
+                return NULL;
+            return (xmlChar *)strdup(reader->value);
+        }
+    }
+    return NULL;
+}
+
+int xmlTextReaderNext(xmlTextReaderPtr reader)
+{
+    int target;
+    int rc;
+
+    if (!reader)
+        return -1;
+    if (reader->node_type != XML_READER_TYPE_ELEMENT ||
+        reader->empty_element)
+        return xmlTextReaderRead(reader);
+
+    /* Skip everything until the matching end tag at this depth */
+    target = reader->depth - 1;
+    while ((rc = xmlTextReaderRead(reader)) == 1) {
+        if (reader->node_type == XML_READER_TYPE_END_ELEMENT &&
+            reader->depth == target)
+            return xmlTextReaderRead(reader);
+    }
+    return rc;
+}
@@ -0,0 +1,212 @@
+/*
+ * VeridianOS libc -- lz4.c
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * LZ4 block compression (veridian/lz4.h).
+ *
+ * A single-pass greedy matcher over a 4KB hash table of 4-byte
+ * prefixes -- the classic fast-mode LZ4.  Emitted blocks follow the
+ * standard format, so images are exchangeable with any stock LZ4
+ * decoder.
+ */
+
+#include <veridian/lz4.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#define VLZ4_HASH_LOG   12
+#define VLZ4_HASH_SIZE  (1 << VLZ4_HASH_LOG)
+#define VLZ4_MIN_MATCH  4
+#define VLZ4_LAST_LITERALS 5    /* Spec: final bytes are literals */
+#define VLZ4_MAX_OFFSET 65535
+
+static uint32_t vlz4_hash(uint32_t v)
+{
+    return (v * 2654435761u) >> (32 - VLZ4_HASH_LOG);
+}
+
+static uint32_t vlz4_read32(const uint8_t *p)
+{
+    uint32_t v;
+
+    memcpy(&v, p, 4);
+    return v;
+}
+
+size_t vlz4_compress(const void *src_v, size_t src_len, void *dst_v,
+                     size_t dst_cap)
+{
+    const uint8_t *src = (const uint8_t *)src_v;
+    uint8_t *dst = (uint8_t *)dst_v;
+    uint32_t table[VLZ4_HASH_SIZE];
+    const uint8_t *ip = src;
+    const uint8_t *anchor = src;
+    const uint8_t *iend = src + src_len;
+    const uint8_t *mflimit =
+        src_len > VLZ4_MIN_MATCH + VLZ4_LAST_LITERALS
+            ? iend - (VLZ4_MIN_MATCH + VLZ4_LAST_LITERALS) : src;
+    uint8_t *op = dst;
+    uint8_t *oend = dst + dst_cap;
+
+    memset(table, 0, sizeof(table));
+
+    while (ip < mflimit) {
+        uint32_t h = vlz4_hash(vlz4_read32(ip));
+        const uint8_t *match = src + table[h];
+
+        table[h] = (uint32_t)(ip - src);
+
+        if (match >= ip || ip - match > VLZ4_MAX_OFFSET ||
+            vlz4_read32(match) != vlz4_read32(ip)) {
+            ip++;
+            continue;
+        }
+
+        /* Extend the match forward */
+        const uint8_t *mp = match + VLZ4_MIN_MATCH;
+        const uint8_t *cp = ip + VLZ4_MIN_MATCH;
+
+        while (cp < iend - VLZ4_LAST_LITERALS && *cp == *mp) {
+            cp++;
+            mp++;
+        }
+
+        size_t lit_len = (size_t)(ip - anchor);
+        size_t match_len = (size_t)(cp - ip) - VLZ4_MIN_MATCH;
+
+        /* Token + worst-case length bytes + literals + offset */
+        if (op + 1 + lit_len / 255 + 1 + lit_len + 2 +
+                match_len / 255 + 1 > oend)
+            return 0;
+
+        uint8_t *token = op++;
+
+        if (lit_len >= 15) {
+            size_t l = lit_len - 15;
+
+            *token = 15 << 4;
+            while (l >= 255) {
+                *op++ = 255;
+                l -= 255;
+            }
+            *op++ = (uint8_t)l;
+        } else {
+            *token = (uint8_t)(lit_len << 4);
+        }
+        memcpy(op, anchor, lit_len);
+        op += lit_len;
+
+        uint16_t off = (uint16_t)(ip - match);
+
+        *op++ = (uint8_t)off;
+        *op++ = (uint8_t)(off >> 8);
+
+        if (match_len >= 15) {
+            size_t l = match_len - 15;
+
+            *token |= 15;
+            while (l >= 255) {
+                *op++ = 255;
+                l -= 255;
+            }
+            *op++ = (uint8_t)l;
+        } else {
+            *token |= (uint8_t)match_len;
+        }
+
+        ip = cp;
+        anchor = cp;
+    }
+
+    /* Trailing literals */
+    {
+        size_t lit_len = (size_t)(iend - anchor);
+
+        if (op + 1 + lit_len / 255 + 1 + lit_len > oend)
+            return 0;
+        if (lit_len >= 15) {
+            size_t l = lit_len - 15;
+
+            *op++ = 15 << 4;
+            while (l >= 255) {
+                *op++ = 255;
+                l -= 255;
+            }
+            *op++ = (uint8_t)l;
+        } else {
+            *op++ = (uint8_t)(lit_len << 4);
+        }
+        memcpy(op, anchor, lit_len);
+        op += lit_len;
+    }
+
+    return (size_t)(op - dst);
+}
+
+size_t vlz4_decompress(const void *src_v, size_t src_len, void *dst_v,
+                       size_t dst_len)
+{
+    const uint8_t *ip = (const uint8_t *)src_v;
+    const uint8_t *iend = ip + src_len;
+    uint8_t *op = (uint8_t *)dst_v;
+    uint8_t *oend = op + dst_len;
+
+    while (ip < iend) {
+        uint8_t token = *ip++;
+        size_t lit_len = token >> 4;
+
+        if (lit_len == 15) {
+            uint8_t b;
+
+            do {
+                if (ip >= iend)
+                    return 0;
+                b = *ip++;
+                lit_len += b;
+            } while (b == 255);
+        }
+        if (ip + lit_len > iend || op + lit_len > oend)
+            return 0;
+        memcpy(op, ip, lit_len);
+        ip += lit_len;
+        op += lit_len;
+
+        if (ip >= iend)
+            break;              /* Final literals, no match follows */
+
+        if (ip + 2 > iend)
+            return 0;
+
+        size_t off = (size_t)ip[0] | ((size_t)ip[1] << 8);
+
+        ip += 2;
+        if (off == 0 || (size_t)(op - (uint8_t *)dst_v) < off)
+            return 0;
+
+        size_t match_len = (token & 15) + VLZ4_MIN_MATCH;
+
+        if ((token & 15) == 15) {
+            uint8_t b;
+
+            do {
+                if (ip >= iend)
+                    return 0;
+                b = *ip++;
+                match_len += b;
+            } while (b == 255);
+        }
+        if (op + match_len > oend)
+            return 0;
+
+        /* Byte copy: offsets < match length overlap by design */
+        const uint8_t *mp = op - off;
+
+        while (match_len--)
+            *op++ = *mp++;
+    }
+
+    return op == oend ? dst_len : 0;
+}
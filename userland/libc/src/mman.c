@@ -12,8 +12,14 @@
  */
 
 #include <sys/mman.h>
+#include <veridian/lz4.h>
 #include <veridian/syscall.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
 
 /* ========================================================================= */
 /* msync                                                                     */
@@ -32,3 +38,350 @@ int msync(void *addr, size_t length, int flags)
     /* No-op: all VeridianOS mappings are currently coherent. */
     return 0;
 }
+
+/* ========================================================================= */
+/* madvise                                                                   */
+/* ========================================================================= */
+
+/*
+ * Access-pattern hints to the kernel VMM.  WILLNEED prefaults,
+ * DONTNEED drops pages immediately, FREE marks them lazily
+ * reclaimable (the malloc arena uses it on large coalesced free
+ * blocks so idle heap doesn't hold residency).  Kernels without
+ * SYS_MADVISE make every hint a successful no-op -- advice is
+ * allowed to be ignored.
+ */
+int madvise(void *addr, size_t length, int advice)
+{
+    long ret = veridian_syscall3(SYS_MADVISE, (long)addr, (long)length,
+                                 (long)advice);
+
+    if (ret == -ENOSYS)
+        return 0;
+    if (ret < 0) {
+        errno = (int)-ret;
+        return -1;
+    }
+    return 0;
+}
+
+/* ========================================================================= */
+/* posix_fallocate                                                           */
+/* ========================================================================= */
+
+/*
+ * Preallocate file storage so subsequent writes into [offset,
+ * offset+len) cannot fail with ENOSPC and the VFS can reserve
+ * contiguous extents up front.  Falls back to ftruncate-extension on
+ * kernels without SYS_FILE_FALLOCATE -- that only reserves the size,
+ * not the blocks, but keeps the calling code portable.
+ */
+int posix_fallocate(int fd, off_t offset, off_t len)
+{
+    long ret;
+
+    if (fd < 0 || offset < 0 || len <= 0)
+        return EINVAL;
+
+    ret = veridian_syscall3(SYS_FILE_FALLOCATE, (long)fd, (long)offset,
+                            (long)len);
+    if (ret == 0)
+        return 0;
+    if (ret != -ENOSYS)
+        return (int)-ret;
+
+    /* Fallback: extend the size if the range reaches past EOF */
+    {
+        off_t end = offset + len;
+        off_t cur = lseek(fd, 0, SEEK_END);
+
+        if (cur >= 0 && end > cur && ftruncate(fd, end) < 0)
+            return errno;
+    }
+    return 0;
+}
+
+/* ========================================================================= */
+/* W^X JIT dual mapping                                                      */
+/* ========================================================================= */
+
+/*
+ * The two views share pages through a memfd: one file, two MAP_SHARED
+ * mappings with different protections.  The fd is closed immediately
+ * after mapping -- the mappings keep the pages alive -- so no
+ * descriptor leaks into the JIT process's fd table.  On kernels
+ * without SYS_MEMFD_CREATE the region degrades to a single RWX
+ * mapping at both addresses: the API contract (write rw, run rx,
+ * sync between) still holds, only the hardening is lost.
+ */
+
+extern int ftruncate(int fd, off_t length);
+
+int veridian_jit_alloc(struct veridian_jit_region *rgn, size_t size)
+{
+    int fd;
+    void *rw, *rx;
+
+    if (!rgn || size == 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    size = (size + 4095UL) & ~4095UL;
+
+    fd = memfd_create("jit-region", 0);
+    if (fd < 0) {
+        /* Fallback: single RWX mapping, both views aliased */
+        rw = mmap(NULL, size, PROT_READ | PROT_WRITE | PROT_EXEC,
+                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (rw == MAP_FAILED)
+            return -1;
+        rgn->rw = rw;
+        rgn->rx = rw;
+        rgn->size = size;
+        return 0;
+    }
+
+    if (ftruncate(fd, (off_t)size) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    rw = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (rw == MAP_FAILED) {
+        close(fd);
+        return -1;
+    }
+    rx = mmap(NULL, size, PROT_READ | PROT_EXEC, MAP_SHARED, fd, 0);
+    if (rx == MAP_FAILED) {
+        munmap(rw, size);
+        close(fd);
+        return -1;
+    }
+    close(fd);
+
+    rgn->rw = rw;
+    rgn->rx = rx;
+    rgn->size = size;
+    return 0;
+}
+
+void veridian_jit_sync(const struct veridian_jit_region *rgn,
+                       size_t off, size_t len)
+{
+    if (!rgn || off >= rgn->size)
+        return;
+    if (len > rgn->size - off)
+        len = rgn->size - off;
+
+#if defined(__aarch64__) || defined(__riscv)
+    /* Instruction and data caches are not coherent: clean the range
+     * through the execute view */
+    __builtin___clear_cache((char *)rgn->rx + off,
+                            (char *)rgn->rx + off + len);
+#else
+    /* x86: caches are coherent; prevent the compiler from reordering
+     * code stores past the first call into the region */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    (void)len;
+#endif
+}
+
+void veridian_jit_free(struct veridian_jit_region *rgn)
+{
+    if (!rgn || !rgn->rw)
+        return;
+    munmap(rgn->rw, rgn->size);
+    if (rgn->rx != rgn->rw)
+        munmap(rgn->rx, rgn->size);
+    rgn->rw = NULL;
+    rgn->rx = NULL;
+    rgn->size = 0;
+}
+
+/* ========================================================================= */
+/* Memory pressure and compressed swap                                       */
+/* ========================================================================= */
+
+/*
+ * Graceful degradation for small-memory appliances: the kernel
+ * raises pressure levels on an fd, and policy code (the Plasma
+ * memory optimizer) responds by compressing cold anonymous ranges
+ * to a backing file with LZ4 and releasing the pages with
+ * MADV_DONTNEED.  Swapped ranges are restored explicitly before the
+ * next use -- the caller owns the cold/hot decision, which is the
+ * point: userland knows which caches are idle, the kernel doesn't.
+ */
+
+#define VSWAP_MAX_REGIONS 64
+#define VSWAP_DIR "/var/cache/veridian"
+
+/* Pressure levels reported on the fd (one byte per event) */
+#define VERIDIAN_PRESSURE_LOW      0
+#define VERIDIAN_PRESSURE_MEDIUM   1
+#define VERIDIAN_PRESSURE_CRITICAL 2
+
+struct vswap_region {
+    void    *addr;              /* NULL = slot free */
+    size_t   length;
+    size_t   comp_len;
+    char     path[96];
+};
+
+static struct vswap_region g_vswap[VSWAP_MAX_REGIONS];
+static unsigned int g_vswap_seq;
+
+/*
+ * Get the kernel memory-pressure fd (one byte per level change).
+ * Returns -1 with ENOSYS on kernels without the facility; callers
+ * fall back to polling or do nothing.
+ */
+int veridian_mempressure_fd(void)
+{
+    long ret = veridian_syscall0(SYS_MEMPRESSURE_FD);
+
+    if (ret < 0) {
+        errno = (int)-ret;
+        return -1;
+    }
+    return (int)ret;
+}
+
+/*
+ * Compress [addr, addr+len) to a backing file and release the
+ * pages.  The range must be anonymous, private, and untouched until
+ * veridian_unswap_region() brings it back.  Returns 0, or -1 (region
+ * table full, I/O failure, or the data grew -- incompressible
+ * ranges are left resident rather than swapped at a loss).
+ */
+int veridian_swap_region(void *addr, size_t len)
+{
+    struct vswap_region *r = (void *)0;
+    unsigned char *comp;
+    size_t comp_len, cap;
+    int fd, i;
+
+    if (!addr || len == 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    for (i = 0; i < VSWAP_MAX_REGIONS; i++) {
+        if (g_vswap[i].addr == (void *)0) {
+            r = &g_vswap[i];
+            break;
+        }
+    }
+    if (!r) {
+        errno = ENOSPC;
+        return -1;
+    }
+
+    cap = VLZ4_BOUND(len);
+    comp = mmap((void *)0, cap, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (comp == MAP_FAILED)
+        return -1;
+
+    comp_len = vlz4_compress(addr, len, comp, cap);
+    if (comp_len == 0 || comp_len >= len) {
+        munmap(comp, cap);
+        errno = E2BIG;          /* Not worth swapping */
+        return -1;
+    }
+
+    mkdir(VSWAP_DIR, 0755);
+    snprintf(r->path, sizeof(r->path), VSWAP_DIR "/swap-%d-%u",
+             (int)getpid(), ++g_vswap_seq);
+    fd = open(r->path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) {
+        munmap(comp, cap);
+        return -1;
+    }
+
+    {
+        size_t done = 0;
+
+        while (done < comp_len) {
+            ssize_t w = write(fd, comp + done, comp_len - done);
+
+            if (w <= 0) {
+                close(fd);
+                unlink(r->path);
+                munmap(comp, cap);
+                return -1;
+            }
+            done += (size_t)w;
+        }
+    }
+    close(fd);
+    munmap(comp, cap);
+
+    r->addr = addr;
+    r->length = len;
+    r->comp_len = comp_len;
+
+    /* Release residency; the VA stays reserved and reads back as
+     * zero until restored */
+    madvise(addr, len, MADV_DONTNEED);
+    return 0;
+}
+
+/*
+ * Bring a swapped range back.  Returns 0, or -1 when the address
+ * was never swapped or the backing file is unreadable.
+ */
+int veridian_unswap_region(void *addr)
+{
+    struct vswap_region *r = (void *)0;
+    unsigned char *comp;
+    int fd, i;
+
+    for (i = 0; i < VSWAP_MAX_REGIONS; i++) {
+        if (g_vswap[i].addr == addr) {
+            r = &g_vswap[i];
+            break;
+        }
+    }
+    if (!r) {
+        errno = ENOENT;
+        return -1;
+    }
+
+    comp = mmap((void *)0, r->comp_len, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (comp == MAP_FAILED)
+        return -1;
+
+    fd = open(r->path, O_RDONLY);
+    if (fd < 0) {
+        munmap(comp, r->comp_len);
+        return -1;
+    }
+
+    {
+        size_t done = 0;
+
+        while (done < r->comp_len) {
+            ssize_t rd = read(fd, comp + done, r->comp_len - done);
+
+            if (rd <= 0) {
+                close(fd);
+                munmap(comp, r->comp_len);
+                return -1;
+            }
+            done += (size_t)rd;
+        }
+    }
+    close(fd);
+
+    if (vlz4_decompress(comp, r->comp_len, r->addr, r->length) !=
+        r->length) {
+        munmap(comp, r->comp_len);
+        return -1;
+    }
+    munmap(comp, r->comp_len);
+
+    unlink(r->path);
+    r->addr = (void *)0;
+    return 0;
+}
@@ -16,8 +16,16 @@
 #include <openssl/bio.h>
 #include <openssl/x509.h>
 #include <openssl/pem.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRYPTO)
+#include <arm_neon.h>
+#endif
 
 /* ========================================================================= */
 /* Version and initialization                                                */
@@ -152,6 +160,70 @@ const char *ERR_reason_error_string(unsigned long e)
     return "reason(0)";
 }
 
+/* ========================================================================= */
+/* CPU crypto feature detection                                              */
+/* ========================================================================= */
+
+/*
+ * Runtime dispatch, same idiom as the string primitives: raw CPUID
+ * checked once, accelerated bodies carry target attributes so the
+ * file still builds with baseline flags, portable C retained as the
+ * fallback everywhere.
+ */
+
+#if defined(__x86_64__)
+static int cpu_has_aesni(void)
+{
+    static int checked, has;
+
+    if (!checked) {
+        unsigned int eax, ebx, ecx, edx;
+
+        /* CPUID leaf 1: ECX bit 25 = AES-NI */
+        __asm__ volatile("cpuid"
+                         : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx)
+                         : "a"(1), "c"(0));
+        has = (ecx >> 25) & 1;
+        checked = 1;
+    }
+    return has;
+}
+
+static int cpu_has_avx2_ssl(void)
+{
+    static int checked, has;
+
+    if (!checked) {
+        unsigned int eax, ebx, ecx, edx;
+
+        /* CPUID leaf 7, subleaf 0: EBX bit 5 = AVX2 */
+        __asm__ volatile("cpuid"
+                         : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx)
+                         : "a"(7), "c"(0));
+        has = (ebx >> 5) & 1;
+        checked = 1;
+    }
+    return has;
+}
+
+static int cpu_has_shani(void)
+{
+    static int checked, has;
+
+    if (!checked) {
+        unsigned int eax, ebx, ecx, edx;
+
+        /* CPUID leaf 7, subleaf 0: EBX bit 29 = SHA extensions */
+        __asm__ volatile("cpuid"
+                         : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx)
+                         : "a"(7), "c"(0));
+        has = (ebx >> 29) & 1;
+        checked = 1;
+    }
+    return has;
+}
+#endif /* __x86_64__ */
+
 /* ========================================================================= */
 /* SHA-256 implementation                                                    */
 /* ========================================================================= */
@@ -189,7 +261,8 @@ static const uint32_t sha256_k[64] = {
 
 #define ROR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
 
-static void sha256_transform(struct sha256_state *s, const uint8_t *block)
+static void sha256_transform_scalar(struct sha256_state *s,
+                                    const uint8_t *block)
 {
     uint32_t w[64];
     uint32_t a, b, c, d, e, f, g, h;
@@ -230,6 +303,216 @@ static void sha256_transform(struct sha256_state *s, const uint8_t *block)
     s->h[4] += e; s->h[5] += f; s->h[6] += g; s->h[7] += h;
 }
 
+#if defined(__x86_64__)
+/*
+ * SHA-NI block transform: the message schedule and both state-update
+ * rounds run in the sha256msg1/msg2 and sha256rnds2 units, four
+ * rounds per instruction.
+ */
+__attribute__((target("sha,sse4.1")))
+static void sha256_transform_shani(struct sha256_state *s,
+                                   const uint8_t *block)
+{
+    const __m128i MASK =
+        _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i state0, state1, abef, cdgh;
+    __m128i msg, tmp;
+    __m128i msg0, msg1, msg2, msg3;
+
+    /* Load state as ABEF/CDGH */
+    tmp = _mm_loadu_si128((const __m128i *)&s->h[0]);   /* DCBA */
+    state1 = _mm_loadu_si128((const __m128i *)&s->h[4]); /* HGFE */
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);                  /* CDAB */
+    state1 = _mm_shuffle_epi32(state1, 0x1B);            /* EFGH */
+    state0 = _mm_alignr_epi8(tmp, state1, 8);            /* ABEF */
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);         /* CDGH */
+    abef = state0;
+    cdgh = state1;
+
+#define SHANI_4ROUNDS(m, k0, k1, k2, k3)                                   \
+    do {                                                                   \
+        msg = _mm_add_epi32((m), _mm_set_epi32((int)(k3), (int)(k2),      \
+                                               (int)(k1), (int)(k0)));    \
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);               \
+        msg = _mm_shuffle_epi32(msg, 0x0E);                                \
+        state0 = _mm_sha256rnds2_epu32(state0, state1, msg);               \
+    } while (0)
+
+    msg0 = _mm_shuffle_epi8(
+        _mm_loadu_si128((const __m128i *)(block + 0)), MASK);
+    msg1 = _mm_shuffle_epi8(
+        _mm_loadu_si128((const __m128i *)(block + 16)), MASK);
+    msg2 = _mm_shuffle_epi8(
+        _mm_loadu_si128((const __m128i *)(block + 32)), MASK);
+    msg3 = _mm_shuffle_epi8(
+        _mm_loadu_si128((const __m128i *)(block + 48)), MASK);
+
+    SHANI_4ROUNDS(msg0, sha256_k[0], sha256_k[1], sha256_k[2],
+                  sha256_k[3]);
+    SHANI_4ROUNDS(msg1, sha256_k[4], sha256_k[5], sha256_k[6],
+                  sha256_k[7]);
+    SHANI_4ROUNDS(msg2, sha256_k[8], sha256_k[9], sha256_k[10],
+                  sha256_k[11]);
+    SHANI_4ROUNDS(msg3, sha256_k[12], sha256_k[13], sha256_k[14],
+                  sha256_k[15]);
+
+    {
+        int i;
+
+        for (i = 16; i < 64; i += 4) {
+            __m128i new0;
+
+            msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+            tmp = _mm_alignr_epi8(msg3, msg2, 4);
+            msg0 = _mm_add_epi32(msg0, tmp);
+            new0 = _mm_sha256msg2_epu32(msg0, msg3);
+            SHANI_4ROUNDS(new0, sha256_k[i], sha256_k[i + 1],
+                          sha256_k[i + 2], sha256_k[i + 3]);
+            msg0 = msg1;
+            msg1 = msg2;
+            msg2 = msg3;
+            msg3 = new0;
+        }
+    }
+#undef SHANI_4ROUNDS
+
+    /* Merge back: ABEF/CDGH -> DCBA/HGFE */
+    state0 = _mm_add_epi32(state0, abef);
+    state1 = _mm_add_epi32(state1, cdgh);
+    tmp = _mm_shuffle_epi32(state0, 0x1B);               /* FEBA */
+    state1 = _mm_shuffle_epi32(state1, 0xB1);            /* DCHG */
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);         /* DCBA */
+    state1 = _mm_alignr_epi8(state1, tmp, 8);            /* HGFE */
+    _mm_storeu_si128((__m128i *)&s->h[0], state0);
+    _mm_storeu_si128((__m128i *)&s->h[4], state1);
+}
+#endif /* __x86_64__ */
+
+static void sha256_transform(struct sha256_state *s, const uint8_t *block)
+{
+#if defined(__x86_64__)
+    if (cpu_has_shani()) {
+        sha256_transform_shani(s, block);
+        return;
+    }
+#endif
+    sha256_transform_scalar(s, block);
+}
+
+/* ========================================================================= */
+/* Multi-buffer SHA-256                                                      */
+/* ========================================================================= */
+
+/*
+ * Interleaved-lane hashing: up to 8 independent streams advance one
+ * block each per transform, with the lane state held in one SIMD
+ * register per working variable (AVX2: 8 x 32-bit).  The one-shot
+ * SHA256_mb_hash() drives full blocks from every stream in lockstep
+ * and finishes stragglers on the scalar path, so verifying a batch of
+ * packages streams at memory bandwidth instead of one hash at a time.
+ */
+
+#define SHA256_MB_LANES 8
+
+#if defined(__x86_64__)
+__attribute__((target("avx2")))
+static void sha256_transform_x8(uint32_t h[8][SHA256_MB_LANES],
+                                const uint8_t *const blocks[SHA256_MB_LANES])
+{
+    __m256i a, b, c, d, e, f, g, hh;
+    __m256i w[16];
+    int i, t;
+
+#define MB_LOAD_STATE(reg, idx) \
+    reg = _mm256_loadu_si256((const __m256i *)h[idx])
+    MB_LOAD_STATE(a, 0); MB_LOAD_STATE(b, 1);
+    MB_LOAD_STATE(c, 2); MB_LOAD_STATE(d, 3);
+    MB_LOAD_STATE(e, 4); MB_LOAD_STATE(f, 5);
+    MB_LOAD_STATE(g, 6); MB_LOAD_STATE(hh, 7);
+#undef MB_LOAD_STATE
+
+    /* Gather + byte-swap the 16 message words across lanes */
+    for (i = 0; i < 16; i++) {
+        uint32_t lane_w[SHA256_MB_LANES];
+        int l;
+
+        for (l = 0; l < SHA256_MB_LANES; l++) {
+            const uint8_t *p = blocks[l] + i * 4;
+
+            lane_w[l] = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+                        ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+        }
+        w[i] = _mm256_loadu_si256((const __m256i *)lane_w);
+    }
+
+#define MB_ROTR(x, n) \
+    _mm256_or_si256(_mm256_srli_epi32((x), (n)), \
+                    _mm256_slli_epi32((x), 32 - (n)))
+
+    for (t = 0; t < 64; t++) {
+        __m256i wt;
+
+        if (t < 16) {
+            wt = w[t & 15];
+        } else {
+            __m256i w15 = w[(t - 15) & 15];
+            __m256i w2 = w[(t - 2) & 15];
+            __m256i s0 = _mm256_xor_si256(
+                _mm256_xor_si256(MB_ROTR(w15, 7), MB_ROTR(w15, 18)),
+                _mm256_srli_epi32(w15, 3));
+            __m256i s1 = _mm256_xor_si256(
+                _mm256_xor_si256(MB_ROTR(w2, 17), MB_ROTR(w2, 19)),
+                _mm256_srli_epi32(w2, 10));
+
+            wt = _mm256_add_epi32(
+                _mm256_add_epi32(w[t & 15], s0),
+                _mm256_add_epi32(w[(t - 7) & 15], s1));
+            w[t & 15] = wt;
+        }
+
+        {
+            __m256i S1 = _mm256_xor_si256(
+                _mm256_xor_si256(MB_ROTR(e, 6), MB_ROTR(e, 11)),
+                MB_ROTR(e, 25));
+            __m256i ch = _mm256_xor_si256(
+                _mm256_and_si256(e, f),
+                _mm256_andnot_si256(e, g));
+            __m256i t1 = _mm256_add_epi32(
+                _mm256_add_epi32(hh, S1),
+                _mm256_add_epi32(
+                    _mm256_add_epi32(ch,
+                                     _mm256_set1_epi32(
+                                         (int)sha256_k[t])),
+                    wt));
+            __m256i S0 = _mm256_xor_si256(
+                _mm256_xor_si256(MB_ROTR(a, 2), MB_ROTR(a, 13)),
+                MB_ROTR(a, 22));
+            __m256i maj = _mm256_xor_si256(
+                _mm256_xor_si256(_mm256_and_si256(a, b),
+                                 _mm256_and_si256(a, c)),
+                _mm256_and_si256(b, c));
+            __m256i t2 = _mm256_add_epi32(S0, maj);
+
+            hh = g; g = f; f = e;
+            e = _mm256_add_epi32(d, t1);
+            d = c; c = b; b = a;
+            a = _mm256_add_epi32(t1, t2);
+        }
+    }
+#undef MB_ROTR
+
+#define MB_ADD_STATE(reg, idx)                                           \
+    _mm256_storeu_si256((__m256i *)h[idx],                               \
+        _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)h[idx]),    \
+                         reg))
+    MB_ADD_STATE(a, 0); MB_ADD_STATE(b, 1);
+    MB_ADD_STATE(c, 2); MB_ADD_STATE(d, 3);
+    MB_ADD_STATE(e, 4); MB_ADD_STATE(f, 5);
+    MB_ADD_STATE(g, 6); MB_ADD_STATE(hh, 7);
+#undef MB_ADD_STATE
+}
+#endif /* __x86_64__ */
+
 static void sha256_init(struct sha256_state *s)
 {
     s->h[0] = 0x6a09e667; s->h[1] = 0xbb67ae85;
@@ -281,6 +564,129 @@ static void sha256_final(struct sha256_state *s, uint8_t *digest)
     }
 }
 
+/* ========================================================================= */
+/* Multi-buffer API                                                          */
+/* ========================================================================= */
+
+struct sha256_mb_ctx {
+    struct sha256_state lanes[SHA256_MB_LANES];
+    int nlanes;
+};
+
+SHA256_MB_CTX *SHA256_MB_CTX_new(void)
+{
+    return (SHA256_MB_CTX *)calloc(1, sizeof(SHA256_MB_CTX));
+}
+
+void SHA256_MB_CTX_free(SHA256_MB_CTX *ctx)
+{
+    free(ctx);
+}
+
+int SHA256_mb_init(SHA256_MB_CTX *ctx, int nlanes)
+{
+    int i;
+
+    if (!ctx || nlanes < 1 || nlanes > SHA256_MB_LANES)
+        return 0;
+    for (i = 0; i < nlanes; i++)
+        sha256_init(&ctx->lanes[i]);
+    ctx->nlanes = nlanes;
+    return 1;
+}
+
+int SHA256_mb_update(SHA256_MB_CTX *ctx, int lane, const void *data,
+                     size_t len)
+{
+    if (!ctx || lane < 0 || lane >= ctx->nlanes)
+        return 0;
+    sha256_update(&ctx->lanes[lane], (const uint8_t *)data, len);
+    return 1;
+}
+
+int SHA256_mb_final(SHA256_MB_CTX *ctx, int lane, unsigned char *digest)
+{
+    if (!ctx || lane < 0 || lane >= ctx->nlanes || !digest)
+        return 0;
+    sha256_final(&ctx->lanes[lane], digest);
+    return 1;
+}
+
+/*
+ * One-shot batch hash: every stream's full blocks advance in lockstep
+ * through the 8-lane transform; the tails (and everything on machines
+ * without AVX2) run the scalar path.  Each digest is bit-identical to
+ * EVP_Digest with EVP_sha256().
+ */
+int SHA256_mb_hash(const unsigned char *const *bufs, const size_t *lens,
+                   unsigned char **digests, int count)
+{
+    int base;
+
+    if (!bufs || !lens || !digests || count < 1)
+        return 0;
+
+    for (base = 0; base < count; base += SHA256_MB_LANES) {
+        int group = count - base < SHA256_MB_LANES ? count - base
+                                                   : SHA256_MB_LANES;
+        struct sha256_state st[SHA256_MB_LANES];
+        size_t done[SHA256_MB_LANES];
+        int l;
+
+        for (l = 0; l < group; l++) {
+            sha256_init(&st[l]);
+            done[l] = 0;
+        }
+
+#if defined(__x86_64__)
+        if (cpu_has_avx2_ssl() && group > 1) {
+            /* Lockstep full blocks: run while every lane in the group
+             * still has a whole block */
+            for (;;) {
+                uint32_t h[8][SHA256_MB_LANES];
+                const uint8_t *blocks[SHA256_MB_LANES];
+                int all_have = 1;
+                int i;
+
+                for (l = 0; l < group; l++) {
+                    if (lens[base + l] - done[l] < SHA256_BLOCK_SIZE) {
+                        all_have = 0;
+                        break;
+                    }
+                }
+                if (!all_have)
+                    break;
+
+                for (i = 0; i < 8; i++) {
+                    for (l = 0; l < SHA256_MB_LANES; l++)
+                        h[i][l] = st[l < group ? l : 0].h[i];
+                }
+                for (l = 0; l < SHA256_MB_LANES; l++)
+                    blocks[l] = bufs[base + (l < group ? l : 0)] +
+                                done[l < group ? l : 0];
+
+                sha256_transform_x8(h, blocks);
+
+                for (l = 0; l < group; l++) {
+                    for (i = 0; i < 8; i++)
+                        st[l].h[i] = h[i][l];
+                    done[l] += SHA256_BLOCK_SIZE;
+                    st[l].total += SHA256_BLOCK_SIZE;
+                }
+            }
+        }
+#endif
+
+        /* Tails (or the whole stream on non-AVX2 machines) */
+        for (l = 0; l < group; l++) {
+            sha256_update(&st[l], bufs[base + l] + done[l],
+                          lens[base + l] - done[l]);
+            sha256_final(&st[l], digests[base + l]);
+        }
+    }
+    return 1;
+}
+
 /* ========================================================================= */
 /* SHA-512 implementation                                                    */
 /* ========================================================================= */
@@ -615,61 +1021,513 @@ int EVP_Digest(const void *data, size_t count,
 }
 
 /* ========================================================================= */
-/* EVP cipher stubs                                                          */
+/* AES block cipher                                                          */
+/* ========================================================================= */
+
+/*
+ * Portable byte-oriented AES (fallback) plus an AES-NI key schedule
+ * and block path selected at runtime.  CBC mode with PKCS#7 padding
+ * is wired through the EVP entry points below.
+ */
+
+#define AES_BLOCK 16
+#define AES_MAX_ROUNDS 14
+
+struct aes_key {
+    uint32_t rk[4 * (AES_MAX_ROUNDS + 1)];
+    uint32_t drk[4 * (AES_MAX_ROUNDS + 1)];    /* Decrypt schedule */
+    int rounds;
+    int use_aesni;
+};
+
+static const uint8_t aes_sbox[256] = {
+    0x63,0x7c,0x77,0x7b,0xf2,0x6b,0x6f,0xc5,0x30,0x01,0x67,0x2b,
+    0xfe,0xd7,0xab,0x76,0xca,0x82,0xc9,0x7d,0xfa,0x59,0x47,0xf0,
+    0xad,0xd4,0xa2,0xaf,0x9c,0xa4,0x72,0xc0,0xb7,0xfd,0x93,0x26,
+    0x36,0x3f,0xf7,0xcc,0x34,0xa5,0xe5,0xf1,0x71,0xd8,0x31,0x15,
+    0x04,0xc7,0x23,0xc3,0x18,0x96,0x05,0x9a,0x07,0x12,0x80,0xe2,
+    0xeb,0x27,0xb2,0x75,0x09,0x83,0x2c,0x1a,0x1b,0x6e,0x5a,0xa0,
+    0x52,0x3b,0xd6,0xb3,0x29,0xe3,0x2f,0x84,0x53,0xd1,0x00,0xed,
+    0x20,0xfc,0xb1,0x5b,0x6a,0xcb,0xbe,0x39,0x4a,0x4c,0x58,0xcf,
+    0xd0,0xef,0xaa,0xfb,0x43,0x4d,0x33,0x85,0x45,0xf9,0x02,0x7f,
+    0x50,0x3c,0x9f,0xa8,0x51,0xa3,0x40,0x8f,0x92,0x9d,0x38,0xf5,
+    0xbc,0xb6,0xda,0x21,0x10,0xff,0xf3,0xd2,0xcd,0x0c,0x13,0xec,
+    0x5f,0x97,0x44,0x17,0xc4,0xa7,0x7e,0x3d,0x64,0x5d,0x19,0x73,
+    0x60,0x81,0x4f,0xdc,0x22,0x2a,0x90,0x88,0x46,0xee,0xb8,0x14,
+    0xde,0x5e,0x0b,0xdb,0xe0,0x32,0x3a,0x0a,0x49,0x06,0x24,0x5c,
+    0xc2,0xd3,0xac,0x62,0x91,0x95,0xe4,0x79,0xe7,0xc8,0x37,0x6d,
+    0x8d,0xd5,0x4e,0xa9,0x6c,0x56,0xf4,0xea,0x65,0x7a,0xae,0x08,
+    0xba,0x78,0x25,0x2e,0x1c,0xa6,0xb4,0xc6,0xe8,0xdd,0x74,0x1f,
+    0x4b,0xbd,0x8b,0x8a,0x70,0x3e,0xb5,0x66,0x48,0x03,0xf6,0x0e,
+    0x61,0x35,0x57,0xb9,0x86,0xc1,0x1d,0x9e,0xe1,0xf8,0x98,0x11,
+    0x69,0xd9,0x8e,0x94,0x9b,0x1e,0x87,0xe9,0xce,0x55,0x28,0xdf,
+    0x8c,0xa1,0x89,0x0d,0xbf,0xe6,0x42,0x68,0x41,0x99,0x2d,0x0f,
+    0xb0,0x54,0xbb,0x16
+};
+
+static uint8_t aes_inv_sbox[256];
+static int aes_inv_sbox_ready;
+
+static void aes_build_inv_sbox(void)
+{
+    int i;
+
+    if (aes_inv_sbox_ready)
+        return;
+    for (i = 0; i < 256; i++)
+        aes_inv_sbox[aes_sbox[i]] = (uint8_t)i;
+    aes_inv_sbox_ready = 1;
+}
+
+static uint8_t xtime(uint8_t x)
+{
+    return (uint8_t)((x << 1) ^ ((x & 0x80) ? 0x1b : 0x00));
+}
+
+static uint8_t aes_mul(uint8_t a, uint8_t b)
+{
+    uint8_t r = 0;
+
+    while (b) {
+        if (b & 1)
+            r ^= a;
+        a = xtime(a);
+        b >>= 1;
+    }
+    return r;
+}
+
+static uint32_t aes_subword(uint32_t w)
+{
+    return ((uint32_t)aes_sbox[(w >> 24) & 0xff] << 24) |
+           ((uint32_t)aes_sbox[(w >> 16) & 0xff] << 16) |
+           ((uint32_t)aes_sbox[(w >> 8) & 0xff] << 8) |
+           (uint32_t)aes_sbox[w & 0xff];
+}
+
+static void aes_key_setup(struct aes_key *k, const uint8_t *key,
+                          int key_bits)
+{
+    int nk = key_bits / 32;
+    int nr = nk + 6;
+    int i;
+    uint32_t rcon = 1;
+
+    k->rounds = nr;
+    for (i = 0; i < nk; i++) {
+        k->rk[i] = ((uint32_t)key[i * 4] << 24) |
+                   ((uint32_t)key[i * 4 + 1] << 16) |
+                   ((uint32_t)key[i * 4 + 2] << 8) |
+                   (uint32_t)key[i * 4 + 3];
+    }
+    for (i = nk; i < 4 * (nr + 1); i++) {
+        uint32_t t = k->rk[i - 1];
+
+        if (i % nk == 0) {
+            t = aes_subword((t << 8) | (t >> 24)) ^ (rcon << 24);
+            rcon = xtime((uint8_t)rcon);
+        } else if (nk > 6 && i % nk == 4) {
+            t = aes_subword(t);
+        }
+        k->rk[i] = k->rk[i - nk] ^ t;
+    }
+}
+
+static void aes_encrypt_block_scalar(const struct aes_key *k,
+                                     const uint8_t *in, uint8_t *out)
+{
+    uint8_t st[16];
+    int round, i, c;
+
+    for (i = 0; i < 16; i++)
+        st[i] = in[i] ^
+                (uint8_t)(k->rk[i / 4] >> (24 - 8 * (i % 4)));
+
+    for (round = 1; round < k->rounds; round++) {
+        uint8_t t[16];
+
+        /* SubBytes + ShiftRows */
+        for (i = 0; i < 16; i++)
+            t[i] = aes_sbox[st[(i + 4 * (i % 4)) % 16]];
+        /* MixColumns */
+        for (c = 0; c < 4; c++) {
+            uint8_t *p = t + 4 * c;
+            uint8_t a0 = p[0], a1 = p[1], a2 = p[2], a3 = p[3];
+
+            st[4 * c + 0] = (uint8_t)(xtime(a0) ^ (xtime(a1) ^ a1) ^
+                                      a2 ^ a3);
+            st[4 * c + 1] = (uint8_t)(a0 ^ xtime(a1) ^
+                                      (xtime(a2) ^ a2) ^ a3);
+            st[4 * c + 2] = (uint8_t)(a0 ^ a1 ^ xtime(a2) ^
+                                      (xtime(a3) ^ a3));
+            st[4 * c + 3] = (uint8_t)((xtime(a0) ^ a0) ^ a1 ^ a2 ^
+                                      xtime(a3));
+        }
+        for (i = 0; i < 16; i++)
+            st[i] ^= (uint8_t)(k->rk[4 * round + i / 4] >>
+                               (24 - 8 * (i % 4)));
+    }
+
+    /* Final round: no MixColumns */
+    {
+        uint8_t t[16];
+
+        for (i = 0; i < 16; i++)
+            t[i] = aes_sbox[st[(i + 4 * (i % 4)) % 16]];
+        for (i = 0; i < 16; i++)
+            out[i] = t[i] ^ (uint8_t)(k->rk[4 * k->rounds + i / 4] >>
+                                      (24 - 8 * (i % 4)));
+    }
+}
+
+static void aes_decrypt_block_scalar(const struct aes_key *k,
+                                     const uint8_t *in, uint8_t *out)
+{
+    uint8_t st[16];
+    int round, i, c;
+
+    aes_build_inv_sbox();
+
+    for (i = 0; i < 16; i++)
+        st[i] = in[i] ^ (uint8_t)(k->rk[4 * k->rounds + i / 4] >>
+                                  (24 - 8 * (i % 4)));
+
+    for (round = k->rounds - 1; round >= 1; round--) {
+        uint8_t t[16];
+
+        /* InvShiftRows + InvSubBytes */
+        for (i = 0; i < 16; i++)
+            t[(i + 4 * (i % 4)) % 16] = aes_inv_sbox[st[i]];
+        for (i = 0; i < 16; i++)
+            t[i] ^= (uint8_t)(k->rk[4 * round + i / 4] >>
+                              (24 - 8 * (i % 4)));
+        /* InvMixColumns */
+        for (c = 0; c < 4; c++) {
+            uint8_t *p = t + 4 * c;
+            uint8_t a0 = p[0], a1 = p[1], a2 = p[2], a3 = p[3];
+
+            st[4 * c + 0] = aes_mul(a0, 14) ^ aes_mul(a1, 11) ^
+                            aes_mul(a2, 13) ^ aes_mul(a3, 9);
+            st[4 * c + 1] = aes_mul(a0, 9) ^ aes_mul(a1, 14) ^
+                            aes_mul(a2, 11) ^ aes_mul(a3, 13);
+            st[4 * c + 2] = aes_mul(a0, 13) ^ aes_mul(a1, 9) ^
+                            aes_mul(a2, 14) ^ aes_mul(a3, 11);
+            st[4 * c + 3] = aes_mul(a0, 11) ^ aes_mul(a1, 13) ^
+                            aes_mul(a2, 9) ^ aes_mul(a3, 14);
+        }
+    }
+
+    {
+        uint8_t t[16];
+
+        for (i = 0; i < 16; i++)
+            t[(i + 4 * (i % 4)) % 16] = aes_inv_sbox[st[i]];
+        for (i = 0; i < 16; i++)
+            out[i] = t[i] ^ (uint8_t)(k->rk[i / 4] >>
+                                      (24 - 8 * (i % 4)));
+    }
+}
+
+#if defined(__x86_64__)
+/* AES-NI block paths: the expanded schedule from aes_key_setup is
+ * byte-order compatible when loaded big-endian word-wise, so the
+ * round keys are repacked once at init into drk as LE blocks. */
+__attribute__((target("aes,sse2")))
+static void aesni_pack_schedule(struct aes_key *k)
+{
+    int i;
+    uint8_t tmp[16];
+
+    for (i = 0; i <= k->rounds; i++) {
+        int w;
+
+        for (w = 0; w < 4; w++) {
+            uint32_t v = k->rk[4 * i + w];
+
+            tmp[4 * w + 0] = (uint8_t)(v >> 24);
+            tmp[4 * w + 1] = (uint8_t)(v >> 16);
+            tmp[4 * w + 2] = (uint8_t)(v >> 8);
+            tmp[4 * w + 3] = (uint8_t)v;
+        }
+        memcpy(&k->drk[4 * i], tmp, 16);
+    }
+}
+
+__attribute__((target("aes,sse2")))
+static void aes_encrypt_block_aesni(const struct aes_key *k,
+                                    const uint8_t *in, uint8_t *out)
+{
+    const __m128i *rk = (const __m128i *)k->drk;
+    __m128i b = _mm_loadu_si128((const __m128i *)in);
+    int i;
+
+    b = _mm_xor_si128(b, _mm_loadu_si128(&rk[0]));
+    for (i = 1; i < k->rounds; i++)
+        b = _mm_aesenc_si128(b, _mm_loadu_si128(&rk[i]));
+    b = _mm_aesenclast_si128(b, _mm_loadu_si128(&rk[k->rounds]));
+    _mm_storeu_si128((__m128i *)out, b);
+}
+
+__attribute__((target("aes,sse2")))
+static void aes_decrypt_block_aesni(const struct aes_key *k,
+                                    const uint8_t *in, uint8_t *out)
+{
+    __m128i b = _mm_loadu_si128((const __m128i *)in);
+    const __m128i *rk = (const __m128i *)k->drk;
+    int i;
+
+    b = _mm_xor_si128(b, _mm_loadu_si128(&rk[k->rounds]));
+    for (i = k->rounds - 1; i >= 1; i--)
+        b = _mm_aesdec_si128(
+            b, _mm_aesimc_si128(_mm_loadu_si128(&rk[i])));
+    b = _mm_aesdeclast_si128(b, _mm_loadu_si128(&rk[0]));
+    _mm_storeu_si128((__m128i *)out, b);
+}
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRYPTO)
+/* ARMv8 crypto extension paths (compile-time gated, matching the
+ * repo's unconditional-NEON convention for AArch64 builds that
+ * target the crypto profile) */
+static void aes_encrypt_block_ce(const struct aes_key *k,
+                                 const uint8_t *in, uint8_t *out)
+{
+    uint8x16_t b = vld1q_u8(in);
+    const uint8_t *rk = (const uint8_t *)k->drk;
+    int i;
+
+    for (i = 0; i < k->rounds - 1; i++) {
+        b = vaeseq_u8(b, vld1q_u8(rk + 16 * i));
+        b = vaesmcq_u8(b);
+    }
+    b = vaeseq_u8(b, vld1q_u8(rk + 16 * (k->rounds - 1)));
+    b = veorq_u8(b, vld1q_u8(rk + 16 * k->rounds));
+    vst1q_u8(out, b);
+}
+#endif
+
+static void aes_encrypt_block(const struct aes_key *k, const uint8_t *in,
+                              uint8_t *out)
+{
+#if defined(__x86_64__)
+    if (k->use_aesni) {
+        aes_encrypt_block_aesni(k, in, out);
+        return;
+    }
+#endif
+    aes_encrypt_block_scalar(k, in, out);
+}
+
+static void aes_decrypt_block(const struct aes_key *k, const uint8_t *in,
+                              uint8_t *out)
+{
+#if defined(__x86_64__)
+    if (k->use_aesni) {
+        aes_decrypt_block_aesni(k, in, out);
+        return;
+    }
+#endif
+    aes_decrypt_block_scalar(k, in, out);
+}
+
+/* ========================================================================= */
+/* EVP cipher (AES-CBC with PKCS#7)                                          */
 /* ========================================================================= */
 
 struct evp_cipher_st { int type; };
-struct evp_cipher_ctx_st { int dummy; };
+
+struct evp_cipher_ctx_st {
+    struct aes_key key;
+    uint8_t iv[AES_BLOCK];
+    uint8_t partial[AES_BLOCK];
+    int partial_len;
+    int cipher_type;
+    int encrypting;
+    int initialized;
+};
 
 EVP_CIPHER_CTX *EVP_CIPHER_CTX_new(void)
 {
     return (EVP_CIPHER_CTX *)calloc(1, sizeof(EVP_CIPHER_CTX));
 }
 
-void EVP_CIPHER_CTX_free(EVP_CIPHER_CTX *ctx) { free(ctx); }
+void EVP_CIPHER_CTX_free(EVP_CIPHER_CTX *ctx)
+{
+    if (ctx)
+        OPENSSL_cleanse(ctx, sizeof(*ctx));
+    free(ctx);
+}
+
+static int evp_cipher_init(EVP_CIPHER_CTX *ctx, const EVP_CIPHER *cipher,
+                           const unsigned char *key,
+                           const unsigned char *iv, int encrypting)
+{
+    int key_bits;
+
+    if (!ctx || !cipher)
+        return 0;
+
+    /* CBC only; the GCM selectors are declared but the mode is not
+     * implemented in the shim */
+    if (cipher->type != 1 && cipher->type != 2)
+        return 0;
+    key_bits = (cipher->type == 1) ? 128 : 256;
+
+    ctx->cipher_type = cipher->type;
+    ctx->encrypting = encrypting;
+    ctx->partial_len = 0;
+
+    if (key) {
+        aes_key_setup(&ctx->key, key, key_bits);
+#if defined(__x86_64__)
+        ctx->key.use_aesni = cpu_has_aesni();
+        if (ctx->key.use_aesni)
+            aesni_pack_schedule(&ctx->key);
+#endif
+    }
+    if (iv)
+        memcpy(ctx->iv, iv, AES_BLOCK);
+    ctx->initialized = 1;
+    return 1;
+}
 
 int EVP_EncryptInit_ex(EVP_CIPHER_CTX *ctx, const EVP_CIPHER *cipher,
                        void *impl, const unsigned char *key,
                        const unsigned char *iv)
 {
-    (void)ctx; (void)cipher; (void)impl; (void)key; (void)iv;
-    return 0;  /* Not implemented */
+    (void)impl;
+    return evp_cipher_init(ctx, cipher, key, iv, 1);
+}
+
+static void cbc_encrypt_blocks(EVP_CIPHER_CTX *ctx, unsigned char *out,
+                               const unsigned char *in, int blocks)
+{
+    int b, i;
+
+    for (b = 0; b < blocks; b++) {
+        uint8_t x[AES_BLOCK];
+
+        for (i = 0; i < AES_BLOCK; i++)
+            x[i] = in[b * AES_BLOCK + i] ^ ctx->iv[i];
+        aes_encrypt_block(&ctx->key, x, out + b * AES_BLOCK);
+        memcpy(ctx->iv, out + b * AES_BLOCK, AES_BLOCK);
+    }
+}
+
+static void cbc_decrypt_blocks(EVP_CIPHER_CTX *ctx, unsigned char *out,
+                               const unsigned char *in, int blocks)
+{
+    int b, i;
+
+    for (b = 0; b < blocks; b++) {
+        uint8_t plain[AES_BLOCK];
+        uint8_t ctext[AES_BLOCK];
+
+        memcpy(ctext, in + b * AES_BLOCK, AES_BLOCK);
+        aes_decrypt_block(&ctx->key, ctext, plain);
+        for (i = 0; i < AES_BLOCK; i++)
+            out[b * AES_BLOCK + i] = plain[i] ^ ctx->iv[i];
+        memcpy(ctx->iv, ctext, AES_BLOCK);
+    }
+}
+
+static int evp_cipher_update(EVP_CIPHER_CTX *ctx, unsigned char *out,
+                             int *outl, const unsigned char *in, int inl)
+{
+    int produced = 0;
+    int hold = ctx->encrypting ? 0 : AES_BLOCK;
+
+    if (!ctx || !ctx->initialized || !outl || inl < 0)
+        return 0;
+    *outl = 0;
+
+    /* Decryption holds the last full block back for Final's padding
+     * strip */
+    while (inl > 0) {
+        int space = AES_BLOCK - ctx->partial_len;
+        int take = inl < space ? inl : space;
+
+        memcpy(ctx->partial + ctx->partial_len, in, (size_t)take);
+        ctx->partial_len += take;
+        in += take;
+        inl -= take;
+
+        if (ctx->partial_len == AES_BLOCK &&
+            (inl > 0 || hold == 0)) {
+            if (ctx->encrypting)
+                cbc_encrypt_blocks(ctx, out + produced, ctx->partial, 1);
+            else
+                cbc_decrypt_blocks(ctx, out + produced, ctx->partial, 1);
+            produced += AES_BLOCK;
+            ctx->partial_len = 0;
+        }
+    }
+
+    *outl = produced;
+    return 1;
 }
 
 int EVP_EncryptUpdate(EVP_CIPHER_CTX *ctx, unsigned char *out,
                       int *outl, const unsigned char *in, int inl)
 {
-    (void)ctx; (void)out; (void)outl; (void)in; (void)inl;
-    return 0;
+    return evp_cipher_update(ctx, out, outl, in, inl);
 }
 
 int EVP_EncryptFinal_ex(EVP_CIPHER_CTX *ctx, unsigned char *out,
                         int *outl)
 {
-    (void)ctx; (void)out; (void)outl;
-    return 0;
+    int pad;
+    int i;
+
+    if (!ctx || !ctx->initialized || !outl)
+        return 0;
+
+    pad = AES_BLOCK - ctx->partial_len;
+    for (i = ctx->partial_len; i < AES_BLOCK; i++)
+        ctx->partial[i] = (uint8_t)pad;
+    cbc_encrypt_blocks(ctx, out, ctx->partial, 1);
+    ctx->partial_len = 0;
+    *outl = AES_BLOCK;
+    return 1;
 }
 
 int EVP_DecryptInit_ex(EVP_CIPHER_CTX *ctx, const EVP_CIPHER *cipher,
                        void *impl, const unsigned char *key,
                        const unsigned char *iv)
 {
-    (void)ctx; (void)cipher; (void)impl; (void)key; (void)iv;
-    return 0;
+    (void)impl;
+    return evp_cipher_init(ctx, cipher, key, iv, 0);
 }
 
 int EVP_DecryptUpdate(EVP_CIPHER_CTX *ctx, unsigned char *out,
                       int *outl, const unsigned char *in, int inl)
 {
-    (void)ctx; (void)out; (void)outl; (void)in; (void)inl;
-    return 0;
+    return evp_cipher_update(ctx, out, outl, in, inl);
 }
 
 int EVP_DecryptFinal_ex(EVP_CIPHER_CTX *ctx, unsigned char *out,
                         int *outl)
 {
-    (void)ctx; (void)out; (void)outl;
-    return 0;
+    uint8_t plain[AES_BLOCK];
+    int pad;
+    int i;
+
+    if (!ctx || !ctx->initialized || !outl)
+        return 0;
+    if (ctx->partial_len != AES_BLOCK)
+        return 0;                   /* Ciphertext not block-aligned */
+
+    cbc_decrypt_blocks(ctx, plain, ctx->partial, 1);
+    ctx->partial_len = 0;
+
+    pad = plain[AES_BLOCK - 1];
+    if (pad < 1 || pad > AES_BLOCK)
+        return 0;
+    for (i = AES_BLOCK - pad; i < AES_BLOCK; i++) {
+        if (plain[i] != pad)
+            return 0;
+    }
+    memcpy(out, plain, (size_t)(AES_BLOCK - pad));
+    *outl = AES_BLOCK - pad;
+    return 1;
 }
 
 static struct evp_cipher_st cipher_aes128cbc = { 1 };
@@ -927,3 +1785,87 @@ int PEM_write_PrivateKey(FILE *fp, const EVP_PKEY *x,
     (void)cb; (void)u;
     return 0;
 }
+
+/* ========================================================================= */
+/* Self benchmark                                                            */
+/* ========================================================================= */
+
+/*
+ * openssl speed-style self test: measures SHA-256 and AES-128-CBC
+ * throughput on this machine with whatever paths the dispatcher
+ * selected, so per-machine acceleration can be verified in the
+ * field.  Writes a short human-readable report.
+ */
+int OPENSSL_speed_veridian(char *out, size_t out_len)
+{
+    static uint8_t buf[64 * 1024];
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    struct timespec t0, t1;
+    double secs, sha_mbs, aes_mbs;
+    size_t i;
+    int iters;
+
+    if (!out || out_len == 0)
+        return 0;
+
+    for (i = 0; i < sizeof(buf); i++)
+        buf[i] = (uint8_t)(i * 31 + 7);
+
+    /* SHA-256 */
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    {
+        struct sha256_state st;
+
+        for (iters = 0; iters < 256; iters++) {
+            sha256_init(&st);
+            sha256_update(&st, buf, sizeof(buf));
+            sha256_final(&st, digest);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    secs = (double)(t1.tv_sec - t0.tv_sec) +
+           (double)(t1.tv_nsec - t0.tv_nsec) / 1e9;
+    sha_mbs = secs > 0.0
+                  ? ((double)sizeof(buf) * 256.0 / (1024.0 * 1024.0)) / secs
+                  : 0.0;
+
+    /* AES-128-CBC encrypt */
+    {
+        EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+        static uint8_t enc[sizeof(buf) + AES_BLOCK];
+        const uint8_t key[16] = { 1, 2, 3, 4, 5, 6, 7, 8,
+                                  9, 10, 11, 12, 13, 14, 15, 16 };
+        const uint8_t iv[16] = { 0 };
+        int outl;
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (iters = 0; iters < 64; iters++) {
+            EVP_EncryptInit_ex(ctx, EVP_aes_128_cbc(), NULL, key, iv);
+            EVP_EncryptUpdate(ctx, enc, &outl, buf, (int)sizeof(buf));
+            EVP_EncryptFinal_ex(ctx, enc + outl, &outl);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        EVP_CIPHER_CTX_free(ctx);
+    }
+    secs = (double)(t1.tv_sec - t0.tv_sec) +
+           (double)(t1.tv_nsec - t0.tv_nsec) / 1e9;
+    aes_mbs = secs > 0.0
+                  ? ((double)sizeof(buf) * 64.0 / (1024.0 * 1024.0)) / secs
+                  : 0.0;
+
+    return snprintf(out, out_len,
+                    "sha256: %.1f MB/s (%s)\naes-128-cbc: %.1f MB/s (%s)\n",
+                    sha_mbs,
+#if defined(__x86_64__)
+                    cpu_has_shani() ? "sha-ni" : "scalar",
+#else
+                    "scalar",
+#endif
+                    aes_mbs,
+#if defined(__x86_64__)
+                    cpu_has_aesni() ? "aes-ni" : "scalar"
+#else
+                    "scalar"
+#endif
+                    );
+}
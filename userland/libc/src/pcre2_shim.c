@@ -25,14 +25,173 @@ struct pcre2_real_code_8 {
     uint32_t    options;
     int         capture_count;
     int         compiled;
+
+    /* First-byte skip table: 256-bit set of bytes a match can start
+     * with, derived from the pattern at compile time.  Lets the match
+     * path scan past impossible start positions without entering the
+     * engine at all. */
+    uint32_t    first_bytes[8];
+    int         first_bytes_valid;
 };
 
 struct pcre2_real_match_data_8 {
     PCRE2_SIZE  ovector[MAX_CAPTURES * 2];
     uint32_t    ovec_count;
     uint32_t    match_count;
+
+    /* Reusable subject scratch: grows once to the largest subject
+     * seen, so steady-state matching performs no allocations */
+    char       *scratch;
+    PCRE2_SIZE  scratch_cap;
 };
 
+/* ========================================================================= */
+/* First-byte analysis                                                       */
+/* ========================================================================= */
+
+static void fb_set(uint32_t *tbl, unsigned char c)
+{
+    tbl[c >> 5] |= 1u << (c & 31);
+}
+
+static int fb_test(const uint32_t *tbl, unsigned char c)
+{
+    return (tbl[c >> 5] >> (c & 31)) & 1u;
+}
+
+static void fb_set_casefold(uint32_t *tbl, unsigned char c, int caseless)
+{
+    fb_set(tbl, c);
+    if (caseless) {
+        if (c >= 'a' && c <= 'z')
+            fb_set(tbl, (unsigned char)(c - 'a' + 'A'));
+        else if (c >= 'A' && c <= 'Z')
+            fb_set(tbl, (unsigned char)(c - 'A' + 'a'));
+    }
+}
+
+/*
+ * Derive the set of possible match start bytes from the pattern
+ * prefix.  Conservative: anything not understood (alternation,
+ * groups, anchors anywhere, leading repetition that can match empty)
+ * disables the table and the engine sees every position, as before.
+ */
+static void fb_compute(struct pcre2_real_code_8 *code, const char *pat,
+                       size_t len)
+{
+    int caseless = (code->options & PCRE2_CASELESS) != 0;
+    size_t i;
+
+    code->first_bytes_valid = 0;
+    memset(code->first_bytes, 0, sizeof(code->first_bytes));
+
+    /* '^' anywhere (cheap scan) keeps start semantics with the
+     * engine; the prefilter would change what "start" means */
+    for (i = 0; i < len; i++) {
+        if (pat[i] == '^')
+            return;
+    }
+    if (len == 0)
+        return;
+
+    if (pat[0] == '\\' && len > 1) {
+        unsigned char c = (unsigned char)pat[1];
+        int ch;
+
+        switch (c) {
+        case 'd':
+            for (ch = '0'; ch <= '9'; ch++)
+                fb_set(code->first_bytes, (unsigned char)ch);
+            break;
+        case 'w':
+            for (ch = '0'; ch <= '9'; ch++)
+                fb_set(code->first_bytes, (unsigned char)ch);
+            for (ch = 'a'; ch <= 'z'; ch++)
+                fb_set(code->first_bytes, (unsigned char)ch);
+            for (ch = 'A'; ch <= 'Z'; ch++)
+                fb_set(code->first_bytes, (unsigned char)ch);
+            fb_set(code->first_bytes, '_');
+            break;
+        case 's':
+            fb_set(code->first_bytes, ' ');
+            fb_set(code->first_bytes, '\t');
+            fb_set(code->first_bytes, '\n');
+            fb_set(code->first_bytes, '\r');
+            fb_set(code->first_bytes, '\f');
+            fb_set(code->first_bytes, '\v');
+            break;
+        default:
+            /* Escaped literal metacharacter */
+            if (c == '.' || c == '*' || c == '+' || c == '?' ||
+                c == '(' || c == ')' || c == '[' || c == ']' ||
+                c == '{' || c == '}' || c == '|' || c == '\\' ||
+                c == '$' || c == '^') {
+                fb_set_casefold(code->first_bytes, c, caseless);
+            } else {
+                return;
+            }
+            break;
+        }
+        /* A repetition after the first element can match empty: the
+         * next element could start the match too */
+        if (len > 2 && (pat[2] == '*' || pat[2] == '?' || pat[2] == '{'))
+            return;
+        code->first_bytes_valid = 1;
+        return;
+    }
+
+    if (pat[0] == '[') {
+        int negate = 0;
+
+        i = 1;
+        if (i < len && pat[i] == '^') {
+            negate = 1;
+            i++;
+        }
+        for (; i < len && pat[i] != ']'; i++) {
+            unsigned char c = (unsigned char)pat[i];
+
+            if (c == '\\' && i + 1 < len) {
+                return;             /* Class escapes: stay conservative */
+            }
+            if (i + 2 < len && pat[i + 1] == '-' && pat[i + 2] != ']') {
+                unsigned char hi = (unsigned char)pat[i + 2];
+                unsigned char ch;
+
+                for (ch = c; ch <= hi; ch++)
+                    fb_set_casefold(code->first_bytes, ch, caseless);
+                i += 2;
+                continue;
+            }
+            fb_set_casefold(code->first_bytes, c, caseless);
+        }
+        if (i >= len)
+            return;                 /* Unterminated */
+        if (negate) {
+            int w;
+
+            for (w = 0; w < 8; w++)
+                code->first_bytes[w] = ~code->first_bytes[w];
+            /* A negated class never matches NUL in practice */
+        }
+        if (i + 1 < len && (pat[i + 1] == '*' || pat[i + 1] == '?' ||
+                            pat[i + 1] == '{'))
+            return;
+        code->first_bytes_valid = 1;
+        return;
+    }
+
+    /* Plain literal first byte */
+    if (pat[0] == '.' || pat[0] == '(' || pat[0] == '*' ||
+        pat[0] == '+' || pat[0] == '?' || pat[0] == '|' ||
+        pat[0] == '$' || pat[0] == '{')
+        return;
+    if (len > 1 && (pat[1] == '*' || pat[1] == '?' || pat[1] == '{'))
+        return;
+    fb_set_casefold(code->first_bytes, (unsigned char)pat[0], caseless);
+    code->first_bytes_valid = 1;
+}
+
 /* ========================================================================= */
 /* Compile                                                                   */
 /* ========================================================================= */
@@ -80,17 +239,19 @@ pcre2_code *pcre2_compile_8(PCRE2_SPTR pattern, PCRE2_SIZE length,
     code->options = options;
 
     ret = regcomp(&code->posix_re, pat_str, cflags);
-    free(pat_str);
 
     if (ret != 0) {
         if (errorcode) *errorcode = PCRE2_ERROR_BAD_ESCAPE_SEQUENCE;
         if (erroroffset) *erroroffset = 0;
+        free(pat_str);
         free(code);
         return NULL;
     }
 
     code->compiled = 1;
     code->capture_count = (int)code->posix_re.re_nsub;
+    fb_compute(code, pat_str, length);
+    free(pat_str);
 
     if (errorcode) *errorcode = 0;
     if (erroroffset) *erroroffset = 0;
@@ -148,6 +309,9 @@ pcre2_match_data *pcre2_match_data_create_8(
 
 void pcre2_match_data_free_8(pcre2_match_data *match_data)
 {
+    if (!match_data)
+        return;
+    free(match_data->scratch);
     free(match_data);
 }
 
@@ -188,27 +352,66 @@ int pcre2_match_8(const pcre2_code *code, PCRE2_SPTR subject,
     if (startoffset > slen)
         return PCRE2_ERROR_BADOFFSET;
 
-    subj_str = (char *)malloc(slen - startoffset + 1);
-    if (subj_str == NULL)
-        return PCRE2_ERROR_NOMEMORY;
+    /*
+     * First-byte skip: scan forward to the first byte a match can
+     * start with.  Bytes before it cannot begin a match, so handing
+     * the engine the tail preserves leftmost semantics while skipping
+     * the scan work per rejected position.  Multiline patterns keep
+     * the engine's own line handling (no skip).
+     */
+    if (code->first_bytes_valid && !(code->options & PCRE2_MULTILINE)) {
+        while (startoffset < slen &&
+               !fb_test(code->first_bytes,
+                        (unsigned char)subject[startoffset]))
+            startoffset++;
+        if (startoffset >= slen)
+            return PCRE2_ERROR_NOMATCH;
+    }
+
+    /* Reusable scratch: no allocation once warmed up */
+    if (slen - startoffset + 1 > match_data->scratch_cap) {
+        PCRE2_SIZE cap = match_data->scratch_cap ? match_data->scratch_cap
+                                                 : 256;
+        char *grown;
+
+        while (slen - startoffset + 1 > cap)
+            cap *= 2;
+        grown = (char *)realloc(match_data->scratch, cap);
+        if (grown == NULL)
+            return PCRE2_ERROR_NOMEMORY;
+        match_data->scratch = grown;
+        match_data->scratch_cap = cap;
+    }
+    subj_str = match_data->scratch;
 
     memcpy(subj_str, subject + startoffset, slen - startoffset);
     subj_str[slen - startoffset] = '\0';
 
     memset(pmatch, 0, sizeof(pmatch));
 
+    /*
+     * Existence-first gate: the engine's lazy DFA answers "is there a
+     * match at all" in linear time but only on captureless execs.
+     * Asking it before the capture pass means a failing match --
+     * where backtracking blows up exponentially on pathological
+     * patterns like (a+)+b -- never reaches the backtracker at all.
+     * A successful match pays one cheap linear scan extra.
+     */
+    if (match_data->ovec_count > 0) {
+        ret = regexec(&((pcre2_code *)code)->posix_re, subj_str,
+                      0, NULL, eflags);
+        if (ret == REG_NOMATCH)
+            return PCRE2_ERROR_NOMATCH;
+    }
+
     ret = regexec(&((pcre2_code *)code)->posix_re, subj_str,
                   match_data->ovec_count, pmatch, eflags);
 
-    if (ret == REG_NOMATCH) {
-        free(subj_str);
+    if (ret == REG_NOMATCH)
         return PCRE2_ERROR_NOMATCH;
-    }
 
-    if (ret != 0) {
-        free(subj_str);
+    if (ret != 0)
         return PCRE2_ERROR_INTERNAL;
-    }
 
     match_data->match_count = 0;
     for (i = 0; i < match_data->ovec_count; i++) {
@@ -224,7 +427,6 @@ int pcre2_match_8(const pcre2_code *code, PCRE2_SPTR subject,
         }
     }
 
-    free(subj_str);
     return (int)match_data->match_count;
 }
 
@@ -0,0 +1,226 @@
+/*
+ * VeridianOS libc -- perfcount.c
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Userland performance counters (veridian/perfcount.h).
+ *
+ * The process's page lives at /run/veridian/perf/<pid>.perf and is
+ * mapped MAP_SHARED on first use.  Slot registration claims a name
+ * with the publish-last pattern (fill name[1..], release-store
+ * name[0]); the hot-path update is a single relaxed atomic add, so
+ * instrumentation never perturbs what it measures.  Samplers map the
+ * same file read-only and read live values.
+ */
+
+#include <veridian/perfcount.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static const char *VPC_DIR = "/run/veridian/perf";
+static const char *VPC_DIR_FALLBACK = "/tmp/veridian-perf";
+
+static struct vpc_page *g_vpc;
+static const char *g_vpc_dir;
+
+const char *vpc_directory(void)
+{
+    return g_vpc_dir ? g_vpc_dir : VPC_DIR;
+}
+
+static void vpc_page_path(char *buf, size_t len, const char *dir,
+                          pid_t pid)
+{
+    snprintf(buf, len, "%s/%d.perf", dir, (int)pid);
+}
+
+/* Create and map this process's page on first use */
+static struct vpc_page *vpc_page(void)
+{
+    char path[128];
+    int fd;
+    void *map;
+
+    if (g_vpc) {
+        /* Fork safety: a child inherits the parent's mapping; its
+         * counters belong in its own page */
+        if (g_vpc->pid == (uint32_t)getpid())
+            return g_vpc;
+        munmap(g_vpc, sizeof(struct vpc_page));
+        g_vpc = NULL;
+    }
+
+    g_vpc_dir = VPC_DIR;
+    mkdir("/run/veridian", 0755);
+    if (mkdir(VPC_DIR, 0755) < 0 && errno != EEXIST) {
+        g_vpc_dir = VPC_DIR_FALLBACK;
+        mkdir(VPC_DIR_FALLBACK, 0755);
+    }
+
+    vpc_page_path(path, sizeof(path), g_vpc_dir, getpid());
+    fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return NULL;
+    if (ftruncate(fd, sizeof(struct vpc_page)) < 0) {
+        close(fd);
+        return NULL;
+    }
+
+    map = mmap(NULL, sizeof(struct vpc_page), PROT_READ | PROT_WRITE,
+               MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return NULL;
+
+    g_vpc = (struct vpc_page *)map;
+    g_vpc->version = VPC_VERSION;
+    g_vpc->pid = (uint32_t)getpid();
+    __atomic_store_n(&g_vpc->magic, VPC_MAGIC, __ATOMIC_RELEASE);
+    return g_vpc;
+}
+
+/* Claim a named slot: returns its index, existing or fresh.  The
+ * first name byte is the published word. */
+static int vpc_claim(char *name_field, size_t stride, int max,
+                     const char *name)
+{
+    size_t nlen = strlen(name);
+    int i;
+
+    if (nlen == 0 || nlen >= VPC_NAME_MAX)
+        return -1;
+
+    for (i = 0; i < max; i++) {
+        char *slot = name_field + (size_t)i * stride;
+        char first = __atomic_load_n(&slot[0], __ATOMIC_ACQUIRE);
+
+        if (first != '\0') {
+            if (slot[0] == name[0] &&
+                strncmp(slot, name, VPC_NAME_MAX) == 0)
+                return i;
+            continue;
+        }
+
+        /* Empty: claim by publishing the first byte last */
+        {
+            char expected = '\0';
+
+            if (__atomic_compare_exchange_n(&slot[0], &expected, 1, 0,
+                                            __ATOMIC_ACQUIRE,
+                                            __ATOMIC_ACQUIRE)) {
+                memcpy(slot + 1, name + 1, nlen - 1);
+                memset(slot + nlen, 0, VPC_NAME_MAX - nlen);
+                __atomic_store_n(&slot[0], name[0], __ATOMIC_RELEASE);
+                return i;
+            }
+            i--;                    /* Re-examine the claimed slot */
+        }
+    }
+    return -1;
+}
+
+int vpc_counter(const char *name)
+{
+    struct vpc_page *p = vpc_page();
+
+    if (!p || !name)
+        return -1;
+    return vpc_claim(p->counters[0].name, sizeof(struct vpc_counter),
+                     VPC_MAX_COUNTERS, name);
+}
+
+void vpc_add(int handle, uint64_t delta)
+{
+    if (!g_vpc || handle < 0 || handle >= VPC_MAX_COUNTERS)
+        return;
+    __atomic_fetch_add(&g_vpc->counters[handle].value, delta,
+                       __ATOMIC_RELAXED);
+}
+
+int vpc_hist(const char *name)
+{
+    struct vpc_page *p = vpc_page();
+
+    if (!p || !name)
+        return -1;
+    return vpc_claim(p->hists[0].name, sizeof(struct vpc_hist),
+                     VPC_MAX_HISTS, name);
+}
+
+void vpc_hist_record(int handle, uint64_t ns)
+{
+    struct vpc_hist *h;
+    uint64_t us = ns / 1000;
+    int bucket = 0;
+
+    if (!g_vpc || handle < 0 || handle >= VPC_MAX_HISTS)
+        return;
+    h = &g_vpc->hists[handle];
+
+    while (us > 1 && bucket < VPC_HIST_BUCKETS - 1) {
+        us >>= 1;
+        bucket++;
+    }
+    __atomic_fetch_add(&h->buckets[bucket], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&h->count, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&h->sum_ns, ns, __ATOMIC_RELAXED);
+}
+
+uint64_t vpc_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull +
+           (uint64_t)ts.tv_nsec;
+}
+
+/* ----- Sampler side ----- */
+
+const struct vpc_page *vpc_attach(pid_t pid)
+{
+    char path[128];
+    int fd = -1;
+    void *map;
+    const char *dirs[2] = { VPC_DIR, VPC_DIR_FALLBACK };
+    int d;
+
+    for (d = 0; d < 2 && fd < 0; d++) {
+        vpc_page_path(path, sizeof(path), dirs[d], pid);
+        fd = open(path, O_RDONLY);
+    }
+    if (fd < 0)
+        return NULL;
+
+    map = mmap(NULL, sizeof(struct vpc_page), PROT_READ, MAP_SHARED,
+               fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return NULL;
+
+    {
+        const struct vpc_page *p = (const struct vpc_page *)map;
+
+        if (__atomic_load_n(&p->magic, __ATOMIC_ACQUIRE) != VPC_MAGIC ||
+            p->version != VPC_VERSION) {
+            munmap(map, sizeof(struct vpc_page));
+            return NULL;
+        }
+        return p;
+    }
+}
+
+void vpc_detach(const struct vpc_page *page)
+{
+    if (page)
+        munmap((void *)page, sizeof(struct vpc_page));
+}
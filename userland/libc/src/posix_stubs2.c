@@ -118,12 +118,53 @@ extern int execve(const char *path, char *const argv[], char *const envp[]);
 extern int execvp(const char *file, char *const argv[]);
 extern void _exit(int status);
 
+#include <unistd.h>     /* struct veridian_spawn_args, veridian_spawn */
+
+/*
+ * Direct-spawn fast path: SYS_PROCESS_SPAWN builds the child from
+ * the ELF image without touching the parent's mappings, so spawning
+ * from a large process (the shell under a fat environment, the
+ * session manager) costs the same as from a small one.  One ENOSYS
+ * disables it for the process lifetime; file actions and attribute
+ * flags need child-context work the kernel call doesn't do, so they
+ * keep the fork path too.
+ */
+static int g_spawn_fast = 1;
+
+static int spawn_fast(pid_t *pid, const char *path,
+                      const posix_spawn_file_actions_t *fa,
+                      const posix_spawnattr_t *attr,
+                      char *const argv[], char *const envp[])
+{
+    struct veridian_spawn_args args;
+    pid_t child;
+
+    if (!g_spawn_fast || fa != (void *)0 ||
+        (attr != (void *)0 && attr->_flags != 0))
+        return -1;
+
+    args.path = path;
+    args.argv = argv;
+    args.envp = envp;
+    args.flags = 0;
+    child = veridian_spawn(&args);
+    if (child < 0) {
+        if (errno == ENOSYS)
+            g_spawn_fast = 0;
+        return -1;
+    }
+    if (pid)
+        *pid = child;
+    return 0;
+}
+
 int posix_spawn(pid_t *pid, const char *path,
                 const posix_spawn_file_actions_t *fa,
                 const posix_spawnattr_t *attr,
                 char *const argv[], char *const envp[])
 {
-    (void)fa; (void)attr; /* file_actions and attrs not yet supported */
+    if (spawn_fast(pid, path, fa, attr, argv, envp) == 0)
+        return 0;
 
     pid_t child = fork();
     if (child < 0)
@@ -144,7 +185,11 @@ int posix_spawnp(pid_t *pid, const char *file,
                  const posix_spawnattr_t *attr,
                  char *const argv[], char *const envp[])
 {
-    (void)fa; (void)attr;
+    /* Absolute paths can take the direct-spawn path; PATH search
+     * stays in the forked child */
+    if (file && file[0] == '/' &&
+        spawn_fast(pid, file, fa, attr, argv, envp) == 0)
+        return 0;
 
     pid_t child = fork();
     if (child < 0)
@@ -587,6 +632,294 @@ void freeaddrinfo(struct addrinfo *res)
     }
 }
 
+/* ========================================================================= */
+/* Asynchronous resolution: worker pool + notify channels                    */
+/* ========================================================================= */
+
+/*
+ * getaddrinfo_a-style resolution.  Requests queue onto a small
+ * worker pool (spawned on first use) so DNS round-trips never run on
+ * the caller's thread -- Qt's network classes call through these
+ * stubs from the GUI thread, and a slow resolver must not freeze
+ * painting.  The actual lookup goes through __veridian_gai_resolve
+ * when something in the process provides it (the nm-dns resolver
+ * thread exports it) and falls back to the built-in numeric-only
+ * getaddrinfo otherwise.
+ */
+
+#include <pthread.h>
+#include <unistd.h>
+#include <time.h>
+
+/* Weak hook into the nm-dns resolver (text address out) */
+extern int __veridian_gai_resolve(const char *node, int family,
+                                  char *addr_out, unsigned int addr_len)
+    __attribute__((weak));
+
+#define GAI_STATE_QUEUED   0
+#define GAI_STATE_RUNNING  1
+#define GAI_STATE_DONE     2
+
+#define GAI_WORKERS 2
+
+static pthread_mutex_t g_gai_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  g_gai_queue_cond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t  g_gai_done_cond = PTHREAD_COND_INITIALIZER;
+static int g_gai_workers;
+static int g_gai_notify_fd = -1;
+
+/* Per-request notify state rides in a side allocation */
+struct gai_job {
+    struct gaicb *req;
+    void (*cb)(struct gaicb *req, void *arg);
+    void *arg;
+    struct gai_job *next;
+};
+static struct gai_job *g_gai_job_head, *g_gai_job_tail;
+
+static void gai_run_one(struct gaicb *req)
+{
+    char addr[64];
+    int family = AF_UNSPEC;
+    int rc;
+
+    if (req->ar_request)
+        family = req->ar_request->ai_family;
+
+    if (__veridian_gai_resolve &&
+        req->ar_name && req->ar_name[0] &&
+        __veridian_gai_resolve(req->ar_name,
+                               family == AF_UNSPEC ? AF_INET : family,
+                               addr, sizeof(addr)) == 0) {
+        /* Resolver gave us text: finish numerically */
+        rc = getaddrinfo(addr, req->ar_service, req->ar_request,
+                         &req->ar_result);
+    } else {
+        rc = getaddrinfo(req->ar_name, req->ar_service, req->ar_request,
+                         &req->ar_result);
+    }
+    req->__err = rc;
+}
+
+static void *gai_worker_main(void *arg)
+{
+    (void)arg;
+    pthread_mutex_lock(&g_gai_lock);
+    for (;;) {
+        struct gai_job *job;
+        struct gaicb *req;
+
+        while (!g_gai_job_head)
+            pthread_cond_wait(&g_gai_queue_cond, &g_gai_lock);
+        job = g_gai_job_head;
+        g_gai_job_head = job->next;
+        if (!g_gai_job_head)
+            g_gai_job_tail = (struct gai_job *)0;
+        req = job->req;
+        req->__state = GAI_STATE_RUNNING;
+        pthread_mutex_unlock(&g_gai_lock);
+
+        gai_run_one(req);
+
+        pthread_mutex_lock(&g_gai_lock);
+        req->__state = GAI_STATE_DONE;
+        pthread_cond_broadcast(&g_gai_done_cond);
+        if (g_gai_notify_fd >= 0) {
+            char byte = 1;
+
+            write(g_gai_notify_fd, &byte, 1);
+        }
+        if (job->cb) {
+            /* SIGEV_THREAD stand-in: callback on the worker, outside
+             * the lock */
+            pthread_mutex_unlock(&g_gai_lock);
+            job->cb(req, job->arg);
+            pthread_mutex_lock(&g_gai_lock);
+        }
+        free(job);
+    }
+    return (void *)0;
+}
+
+/* Lock held */
+static int gai_ensure_workers(void)
+{
+    while (g_gai_workers < GAI_WORKERS) {
+        pthread_t tid;
+
+        if (pthread_create(&tid, (const pthread_attr_t *)0,
+                           gai_worker_main, (void *)0) != 0)
+            return g_gai_workers > 0 ? 0 : -1;
+        pthread_detach(tid);
+        g_gai_workers++;
+    }
+    return 0;
+}
+
+int getaddrinfo_a(int mode, struct gaicb *list[], int nitems,
+                  void (*notify_cb)(struct gaicb *req, void *arg),
+                  void *cb_arg)
+{
+    int i;
+
+    if ((mode != GAI_WAIT && mode != GAI_NOWAIT) || nitems < 0 || !list)
+        return EAI_BADFLAGS;
+
+    pthread_mutex_lock(&g_gai_lock);
+    if (gai_ensure_workers() < 0) {
+        pthread_mutex_unlock(&g_gai_lock);
+        /* No threads: resolve synchronously rather than fail */
+        for (i = 0; i < nitems; i++) {
+            if (!list[i])
+                continue;
+            gai_run_one(list[i]);
+            list[i]->__state = GAI_STATE_DONE;
+            if (notify_cb)
+                notify_cb(list[i], cb_arg);
+        }
+        return 0;
+    }
+
+    for (i = 0; i < nitems; i++) {
+        struct gai_job *job;
+
+        if (!list[i])
+            continue;
+        job = (struct gai_job *)malloc(sizeof(*job));
+        if (!job) {
+            pthread_mutex_unlock(&g_gai_lock);
+            return EAI_MEMORY;
+        }
+        list[i]->ar_result = (struct addrinfo *)0;
+        list[i]->__err = EAI_INPROGRESS;
+        list[i]->__state = GAI_STATE_QUEUED;
+        job->req = list[i];
+        job->cb = notify_cb;
+        job->arg = cb_arg;
+        job->next = (struct gai_job *)0;
+        if (g_gai_job_tail)
+            g_gai_job_tail->next = job;
+        else
+            g_gai_job_head = job;
+        g_gai_job_tail = job;
+    }
+    pthread_cond_broadcast(&g_gai_queue_cond);
+
+    if (mode == GAI_WAIT) {
+        for (i = 0; i < nitems; i++) {
+            while (list[i] && list[i]->__state != GAI_STATE_DONE)
+                pthread_cond_wait(&g_gai_done_cond, &g_gai_lock);
+        }
+    }
+    pthread_mutex_unlock(&g_gai_lock);
+    return 0;
+}
+
+int veridian_gai_notify_fd(int fd)
+{
+    int prev;
+
+    pthread_mutex_lock(&g_gai_lock);
+    prev = g_gai_notify_fd;
+    g_gai_notify_fd = fd;
+    pthread_mutex_unlock(&g_gai_lock);
+    return prev;
+}
+
+int gai_error(struct gaicb *req)
+{
+    int err;
+
+    if (!req)
+        return EAI_SYSTEM;
+    pthread_mutex_lock(&g_gai_lock);
+    err = req->__state == GAI_STATE_DONE ? req->__err : EAI_INPROGRESS;
+    pthread_mutex_unlock(&g_gai_lock);
+    return err;
+}
+
+int gai_cancel(struct gaicb *req)
+{
+    int rc;
+
+    if (!req)
+        return EAI_SYSTEM;
+    pthread_mutex_lock(&g_gai_lock);
+    if (req->__state == GAI_STATE_DONE) {
+        rc = EAI_ALLDONE;
+    } else if (req->__state == GAI_STATE_RUNNING) {
+        rc = EAI_INPROGRESS;    /* glibc: EAI_NOTCANCELED */
+    } else {
+        /* Unlink from the queue */
+        struct gai_job **pp = &g_gai_job_head;
+
+        rc = EAI_INPROGRESS;
+        while (*pp) {
+            if ((*pp)->req == req) {
+                struct gai_job *dead = *pp;
+
+                *pp = dead->next;
+                if (g_gai_job_tail == dead) {
+                    g_gai_job_tail = (struct gai_job *)0;
+                    for (struct gai_job *j = g_gai_job_head; j;
+                         j = j->next)
+                        g_gai_job_tail = j;
+                }
+                free(dead);
+                req->__err = EAI_CANCELED;
+                req->__state = GAI_STATE_DONE;
+                pthread_cond_broadcast(&g_gai_done_cond);
+                rc = 0;
+                break;
+            }
+            pp = &(*pp)->next;
+        }
+    }
+    pthread_mutex_unlock(&g_gai_lock);
+    return rc;
+}
+
+int gai_suspend(const struct gaicb *const list[], int nitems,
+                const struct timespec *timeout)
+{
+    struct timespec abs;
+    int rc = EAI_AGAIN;
+    int i;
+
+    if (!list || nitems <= 0)
+        return EAI_BADFLAGS;
+
+    if (timeout) {
+        clock_gettime(CLOCK_REALTIME, &abs);
+        abs.tv_sec += timeout->tv_sec;
+        abs.tv_nsec += timeout->tv_nsec;
+        if (abs.tv_nsec >= 1000000000L) {
+            abs.tv_sec++;
+            abs.tv_nsec -= 1000000000L;
+        }
+    }
+
+    pthread_mutex_lock(&g_gai_lock);
+    for (;;) {
+        for (i = 0; i < nitems; i++) {
+            if (list[i] && list[i]->__state == GAI_STATE_DONE) {
+                rc = 0;
+                goto out;
+            }
+        }
+        if (timeout) {
+            if (pthread_cond_timedwait(&g_gai_done_cond, &g_gai_lock,
+                                       &abs) != 0)
+                goto out;       /* Timeout: EAI_AGAIN */
+        } else {
+            pthread_cond_wait(&g_gai_done_cond, &g_gai_lock);
+        }
+    }
+out:
+    pthread_mutex_unlock(&g_gai_lock);
+    return rc;
+}
+
 const char *gai_strerror(int errcode)
 {
     switch (errcode) {
@@ -601,6 +934,9 @@ const char *gai_strerror(int errcode)
     case EAI_SOCKTYPE:  return "ai_socktype not supported";
     case EAI_SYSTEM:    return "System error";
     case EAI_OVERFLOW:  return "Buffer overflow";
+    case EAI_INPROGRESS: return "Processing request in progress";
+    case EAI_CANCELED:  return "Request canceled";
+    case EAI_ALLDONE:   return "All requests done";
     default:            return "Unknown error";
     }
 }
@@ -105,7 +105,19 @@ static inline void *get_thread_pointer(void)
 }
 
 /* Thread control block --------------------------------------------------- */
+/*
+ * The TCB sits AT the thread pointer (x86_64 TLS variant II): the
+ * first slot is the ABI-mandated self pointer (%fs:0 / tpidr load
+ * yields the TCB address), and errno lives right next to it so
+ * __veridian_errno_location() is a single thread-pointer-relative
+ * load.  ld-veridian reserves VERIDIAN_TCB_RESERVE bytes at the
+ * thread pointer when it arms the main thread's static TLS, and
+ * libc adopts that block in place instead of clobbering it.
+ */
 struct pthread_control {
+    void *self;        /* MUST stay first: TLS ABI self pointer */
+    int   errno_val;   /* per-thread errno */
+    int   _pad0;
     pthread_t tid;
     void *stack;       /* aligned usable stack base */
     void *stack_alloc; /* original pointer for free */
@@ -115,8 +127,44 @@ struct pthread_control {
     void *retval;
     void *(*start)(void *);
     void *arg;
+    void *alloc_cache; /* malloc per-thread cache (stdlib.c tcache) */
+
+    /* Cancellation (pthread_cancel / cancellation points) */
+    int   cancel_state;   /* PTHREAD_CANCEL_ENABLE / DISABLE */
+    int   cancel_pending; /* Set by pthread_cancel, release order */
 };
 
+#include <stddef.h>
+#include "veridian_tcb.h"
+
+/*
+ * errno.c reads the head of this struct through
+ * struct __veridian_tcb_head, and ld-veridian sizes its TLS block
+ * reservation from VERIDIAN_TCB_RESERVE; lock the contract down
+ * here so any drift fails the build.
+ */
+_Static_assert(offsetof(struct pthread_control, self) == 0,
+               "self pointer must sit at the thread pointer");
+_Static_assert(offsetof(struct pthread_control, errno_val) ==
+                   offsetof(struct __veridian_tcb_head, errno_val),
+               "errno slot must match __veridian_tcb_head");
+_Static_assert(sizeof(struct pthread_control) <= VERIDIAN_TCB_RESERVE,
+               "pthread_control outgrew the loader's TCB reservation");
+
+/* Allocator TLS slot (see the size-class allocator in stdlib.c).
+ * Threads created with CLONE_SETTLS get a slot in their TCB; the main
+ * thread (no thread pointer) uses a static fallback. */
+static void *main_alloc_cache;
+
+void **__veridian_alloc_tls(void)
+{
+    struct pthread_control *tcb =
+        (struct pthread_control *)get_thread_pointer();
+    if (tcb)
+        return &tcb->alloc_cache;
+    return &main_alloc_cache;
+}
+
 static struct pthread_control main_tcb;
 static int main_tcb_ready = 0;
 
@@ -124,6 +172,31 @@ static void ensure_main_tcb(void)
 {
     if (main_tcb_ready)
         return;
+
+    /* If ld-veridian armed static TLS, the thread pointer already
+     * addresses a reserved TCB area with the self slot filled in;
+     * initialize our fields in place rather than clobbering the TLS
+     * block with a different pointer. */
+    struct pthread_control *tcb =
+        (struct pthread_control *)get_thread_pointer();
+
+    if (tcb && tcb->self == (void *)tcb) {
+        tcb->errno_val = 0;
+        tcb->tid = (pthread_t)gettid();
+        tcb->stack = NULL;
+        tcb->stack_alloc = NULL;
+        tcb->stack_size = 0;
+        tcb->detached = 0;
+        tcb->exit_futex = 0;
+        tcb->retval = NULL;
+        tcb->start = NULL;
+        tcb->arg = NULL;
+        tcb->alloc_cache = NULL;
+        main_tcb_ready = 1;
+        return;
+    }
+
+    main_tcb.self = &main_tcb;
     main_tcb.tid = (pthread_t)gettid();
     main_tcb.stack = NULL;
     main_tcb.stack_size = 0;
@@ -248,6 +321,34 @@ int pthread_mutex_destroy(pthread_mutex_t *mutex)
  *   On wakeup we retry the CAS -- spurious wakeups and races between
  *   multiple waiters are handled by the retry loop.
  */
+/* Pause instruction for adaptive spin loops (AArch64 builds with
+ * -mgeneral-regs-only, so plain yield/pause only) */
+static inline void cpu_relax(void)
+{
+#if defined(__x86_64__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ volatile("yield");
+#else
+    __asm__ volatile("" ::: "memory");
+#endif
+}
+
+/* Spins attempted before sleeping in the kernel.  Critical sections
+ * in Qt's global registries are a few dozen instructions, so a short
+ * spin usually wins the lock without paying the futex round-trip. */
+#define MUTEX_ADAPTIVE_SPINS 100
+
+/*
+ * Three-state mutex (Drepper, "Futexes Are Tricky"):
+ *   0 = unlocked
+ *   1 = locked, no waiters
+ *   2 = locked, waiters possibly sleeping
+ *
+ * Uncontended acquire is a single CAS and uncontended release a
+ * single exchange -- no syscall on either.  Only a release that
+ * observes state 2 issues a wake.
+ */
 int pthread_mutex_lock(pthread_mutex_t *mutex)
 {
     int err = ensure_futex_ready();
@@ -255,21 +356,32 @@ int pthread_mutex_lock(pthread_mutex_t *mutex)
         return err;
     }
 
-    /* Fast path: uncontended lock */
+    /* Fast path: uncontended lock (single CAS) */
     int expected = 0;
     if (__atomic_compare_exchange_n(&mutex->state, &expected, 1, false,
                                     __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
         return 0;
     }
-    /* Slow path: contended -- sleep on the futex until the lock is released */
-    while (1) {
-        expected = 0;
-        if (__atomic_compare_exchange_n(&mutex->state, &expected, 1, false,
-                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
-            return 0;
+
+    /* Adaptive spin: the holder is likely mid-critical-section */
+    for (int i = 0; i < MUTEX_ADAPTIVE_SPINS; i++) {
+        if (__atomic_load_n(&mutex->state, __ATOMIC_RELAXED) == 0) {
+            expected = 0;
+            if (__atomic_compare_exchange_n(&mutex->state, &expected, 1,
+                                            false, __ATOMIC_ACQUIRE,
+                                            __ATOMIC_RELAXED)) {
+                return 0;
+            }
         }
-        futex_wait(&mutex->state, 1, NULL);
+        cpu_relax();
+    }
+
+    /* Slow path: advertise a waiter (state 2) and sleep.  After every
+     * wake we re-take with state 2 since other waiters may remain. */
+    while (__atomic_exchange_n(&mutex->state, 2, __ATOMIC_ACQUIRE) != 0) {
+        futex_wait(&mutex->state, 2, NULL);
     }
+    return 0;
 }
 
 int pthread_mutex_trylock(pthread_mutex_t *mutex)
@@ -288,16 +400,13 @@ int pthread_mutex_trylock(pthread_mutex_t *mutex)
 }
 
 /*
- * pthread_mutex_unlock -- release a mutex and wake one waiter.
- *
- * Atomically stores 0 (unlocked) with release ordering to ensure all
- * preceding critical section writes are visible before the lock appears
- * free. Then calls futex_wake() to unblock at most one waiter sleeping
- * in pthread_mutex_lock().
+ * pthread_mutex_unlock -- release a mutex, waking a waiter only when
+ * one may be sleeping.
  *
- * We always call futex_wake() even if there might be no waiters, because
- * tracking the "contended" state would require a 3-state protocol. The
- * wake syscall on an empty wait queue is cheap (returns 0 immediately).
+ * The exchange with release ordering publishes the critical section
+ * and reads back the contention state in one step: state 1 means
+ * nobody ever slept, so the common uncontended release is entirely
+ * syscall-free; only state 2 pays the futex_wake.
  */
 int pthread_mutex_unlock(pthread_mutex_t *mutex)
 {
@@ -306,8 +415,9 @@ int pthread_mutex_unlock(pthread_mutex_t *mutex)
         return err;
     }
 
-    __atomic_store_n(&mutex->state, 0, __ATOMIC_RELEASE);
-    futex_wake(&mutex->state, 1);
+    if (__atomic_exchange_n(&mutex->state, 0, __ATOMIC_RELEASE) == 2) {
+        futex_wake(&mutex->state, 1);
+    }
     return 0;
 }
 
@@ -329,6 +439,22 @@ int pthread_cond_destroy(pthread_cond_t *cond)
     return 0;
 }
 
+/*
+ * Re-acquisition after a condition wait.  This must NOT use the
+ * regular lock fast path: broadcast requeues sleepers onto the
+ * mutex futex, and a requeued waiter that fast-path CASes 0 -> 1
+ * makes its later unlock skip the futex_wake, stranding every
+ * sleeper still parked there.  Taking the mutex with the contended
+ * protocol (state 2, glibc's __pthread_mutex_cond_lock equivalent)
+ * keeps the wake chain alive no matter how the waiter arrived.
+ */
+static void mutex_cond_lock(pthread_mutex_t *mutex)
+{
+    while (__atomic_exchange_n(&mutex->state, 2, __ATOMIC_ACQUIRE) != 0) {
+        futex_wait(&mutex->state, 2, NULL);
+    }
+}
+
 int pthread_cond_wait(pthread_cond_t *cond, pthread_mutex_t *mutex)
 {
     int err = ensure_futex_ready();
@@ -337,9 +463,10 @@ int pthread_cond_wait(pthread_cond_t *cond, pthread_mutex_t *mutex)
     }
 
     int seq = __atomic_load_n(&cond->futex, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&cond->bound_mutex, (void *)mutex, __ATOMIC_RELEASE);
     pthread_mutex_unlock(mutex);
     futex_wait(&cond->futex, seq, NULL);
-    pthread_mutex_lock(mutex);
+    mutex_cond_lock(mutex);
     return 0;
 }
 
@@ -352,9 +479,10 @@ int pthread_cond_timedwait(pthread_cond_t *cond, pthread_mutex_t *mutex,
     }
 
     int seq = __atomic_load_n(&cond->futex, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&cond->bound_mutex, (void *)mutex, __ATOMIC_RELEASE);
     pthread_mutex_unlock(mutex);
     futex_wait(&cond->futex, seq, abstime);
-    pthread_mutex_lock(mutex);
+    mutex_cond_lock(mutex);
     return 0;
 }
 
@@ -365,9 +493,38 @@ int pthread_cond_signal(pthread_cond_t *cond)
     return 0;
 }
 
+/*
+ * Broadcast wakes one waiter and requeues the rest directly onto the
+ * bound mutex's futex, so N waiters don't all stampede for a mutex
+ * only one of them can hold (the thundering herd the old
+ * wake-INT32_MAX version caused).  The requeued waiters are woken one
+ * by one as the mutex is handed down; the mutex is marked contended
+ * so every unlock in the chain issues its wake.
+ */
 int pthread_cond_broadcast(pthread_cond_t *cond)
 {
+    pthread_mutex_t *mutex = (pthread_mutex_t *)
+        __atomic_load_n(&cond->bound_mutex, __ATOMIC_ACQUIRE);
+
     __atomic_fetch_add(&cond->futex, 1, __ATOMIC_SEQ_CST);
+
+    if (mutex) {
+        /* Mark contended so every unlock in the chain wakes the next
+         * requeued sleeper.  Only valid while the mutex is held --
+         * flagging an unlocked mutex would strand the sleepers. */
+        int s = __atomic_load_n(&mutex->state, __ATOMIC_RELAXED);
+        if (s != 0 &&
+            __atomic_compare_exchange_n(&mutex->state, &s, 2, false,
+                                        __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED)) {
+            if (futex_requeue(&cond->futex, 1, &mutex->state,
+                              INT32_MAX) >= 0) {
+                return 0;
+            }
+            /* Requeue unsupported: fall back to waking everyone */
+        }
+    }
+
     futex_wake(&cond->futex, INT32_MAX);
     return 0;
 }
@@ -459,6 +616,7 @@ int pthread_create(pthread_t *thread,
         free(raw);  /* free the original malloc'd pointer, not the aligned one */
         return ENOMEM;
     }
+    tcb->self = tcb;   /* TLS ABI self pointer at the thread pointer */
     tcb->stack = stack;
     tcb->stack_alloc = raw;
     tcb->stack_size = stack_size;
@@ -568,25 +726,107 @@ pthread_t pthread_self(void)
  * raw version directly because it is a forward reference; the compiler
  * sees only one definition of the public symbol.
  */
+/* Defined in stdlib.c: returns this thread's cached blocks to the
+ * central arena so they aren't stranded when the thread dies. */
+void __veridian_alloc_thread_exit(void);
+
 static void __attribute__((noreturn)) pthread_exit_raw(void *retval)
 {
     struct pthread_control *tcb = (struct pthread_control *)get_thread_pointer();
     if (tcb) {
         tcb->retval = retval;
     }
+    __veridian_alloc_thread_exit();
     veridian_syscall1(SYS_THREAD_EXIT, (long)retval);
     __builtin_unreachable();
 }
 
+/* =========================================================================
+ * Cancellation
+ * =========================================================================
+ *
+ * Deferred cancellation only: pthread_cancel marks the target's TCB
+ * and kicks it out of any blocking syscall with SYS_THREAD_INTERRUPT;
+ * the mark is acted on at cancellation points -- pthread_testcancel
+ * and the blocking libc entry points, which call
+ * __pthread_cancel_point() before blocking and again when the kernel
+ * bounces them with EINTR.  Asynchronous type is accepted but behaves
+ * as deferred (no signal machinery to interrupt arbitrary code).
+ */
+
 int pthread_setcancelstate(int state, int *oldstate)
 {
-    if (oldstate) {
-        *oldstate = 0;
+    struct pthread_control *tcb;
+
+    if (state != PTHREAD_CANCEL_ENABLE && state != PTHREAD_CANCEL_DISABLE)
+        return EINVAL;
+    ensure_main_tcb();
+    tcb = (struct pthread_control *)get_thread_pointer();
+    if (!tcb)
+        return 0;
+    if (oldstate)
+        *oldstate = tcb->cancel_state;
+    tcb->cancel_state = state;
+    return 0;
+}
+
+int pthread_setcanceltype(int type, int *oldtype)
+{
+    if (type != PTHREAD_CANCEL_DEFERRED &&
+        type != PTHREAD_CANCEL_ASYNCHRONOUS)
+        return EINVAL;
+    if (oldtype)
+        *oldtype = PTHREAD_CANCEL_DEFERRED;
+    /* Asynchronous degrades to deferred (documented above) */
+    return 0;
+}
+
+int pthread_cancel(pthread_t thread)
+{
+    struct pthread_control *tcb;
+
+    ensure_main_tcb();
+    tcb = lookup_tcb(thread);
+    if (!tcb)
+        return ESRCH;
+
+    __atomic_store_n(&tcb->cancel_pending, 1, __ATOMIC_RELEASE);
+
+    if (tcb == (struct pthread_control *)get_thread_pointer()) {
+        pthread_testcancel();   /* Self-cancel acts immediately */
+        return 0;
     }
-    (void)state;
+
+    /* Bounce the target out of any blocking wait; older kernels
+     * without the syscall just leave it to the next natural check */
+    veridian_syscall1(SYS_THREAD_INTERRUPT, (long)thread);
     return 0;
 }
 
+/*
+ * The cancellation point.  Blocking libc wrappers call this before
+ * entering the kernel and after an EINTR bounce; anything else may
+ * call pthread_testcancel().
+ */
+void __pthread_cancel_point(void)
+{
+    struct pthread_control *tcb =
+        (struct pthread_control *)get_thread_pointer();
+
+    if (!tcb)
+        return;
+    if (tcb->cancel_state != PTHREAD_CANCEL_ENABLE)
+        return;
+    if (!__atomic_load_n(&tcb->cancel_pending, __ATOMIC_ACQUIRE))
+        return;
+    pthread_exit_raw(PTHREAD_CANCELED);
+}
+
+void pthread_testcancel(void)
+{
+    __pthread_cancel_point();
+}
+
 int pthread_yield(void)
 {
     veridian_syscall0(SYS_PROCESS_YIELD);
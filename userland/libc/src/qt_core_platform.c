@@ -5,7 +5,7 @@
  * SPDX-License-Identifier: MIT OR Apache-2.0
  *
  * OS-level shims for QtCore subsystems that need platform hooks beyond
- * standard POSIX.  Provides eventfd, timerfd, inotify, madvise, and
+ * standard POSIX.  Provides eventfd, timerfd, inotify, and
  * getauxval implementations.
  *
  * Already implemented elsewhere in the libc:
@@ -170,21 +170,6 @@ int inotify_rm_watch(int fd, int wd)
     return 0;
 }
 
-/* ========================================================================= */
-/* madvise                                                                   */
-/* ========================================================================= */
-
-int madvise(void *addr, size_t length, int advice)
-{
-    long ret = __veridian_syscall(SYS_MADVISE, (long)addr, (long)length,
-                                  (long)advice, 0, 0, 0);
-    if (ret < 0) {
-        errno = (int)(-ret);
-        return -1;
-    }
-    return 0;
-}
-
 /* ========================================================================= */
 /* getauxval                                                                 */
 /* ========================================================================= */
@@ -237,9 +222,6 @@ unsigned long getauxval(unsigned long type)
 /* memfd_create                                                              */
 /* ========================================================================= */
 
-#define MFD_CLOEXEC     0x0001U
-#define MFD_ALLOW_SEALING 0x0002U
-
 int memfd_create(const char *name, unsigned int flags)
 {
     long ret = __veridian_syscall(SYS_MEMFD_CREATE, (long)name, (long)flags,
@@ -250,3 +232,545 @@ int memfd_create(const char *name, unsigned int flags)
     }
     return (int)ret;
 }
+
+/* ========================================================================= */
+/* Parsed-settings cache (QSettings/KConfig backing)                         */
+/* ========================================================================= */
+
+/*
+ * KConfig checks settings groups constantly, and re-parsing INI text
+ * per access is the worst fit for that pattern.  This engine parses
+ * a settings file once into a sorted binary table (bsearch lookups),
+ * keeps it in a process-wide cache with inotify invalidation, and
+ * persists the parsed form as an mmap-able sidecar next to the
+ * cache directory so other processes skip the text entirely when
+ * the source hasn't changed (identity = source mtime + size).
+ *
+ * Sidecar layout ('VQSB'): header, entry table sorted by
+ * (group, key) strcmp order, string table.  Offsets are relative to
+ * the file start, so the mapping is position-independent.
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define VQS_MAGIC       0x42535156u     /* "VQSB" */
+#define VQS_VERSION     1u
+#define VQS_MAX_FILES   16
+#define VQS_MAX_ENTRIES 2048
+#define VQS_CACHE_DIR   "/var/cache/veridian"
+
+struct vqs_header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t src_mtime;
+    uint64_t src_size;
+    uint32_t entry_count;
+    uint32_t strtab_off;
+};
+
+struct vqs_entry {
+    uint32_t group_off;         /* Into the string table */
+    uint32_t key_off;
+    uint32_t value_off;
+};
+
+struct vqs_file {
+    char     path[256];
+    int      refs;
+    uint64_t src_mtime;
+    uint64_t src_size;
+    void    *map;               /* Sidecar mapping (or heap build) */
+    size_t   map_len;
+    int      heap;              /* map is malloc'd, not mmap'd */
+    int      watch_fd;          /* inotify, -1 when unavailable */
+};
+
+static struct vqs_file g_vqs[VQS_MAX_FILES];
+
+static const char *vqs_str(const struct vqs_file *f, uint32_t off)
+{
+    const struct vqs_header *h = (const struct vqs_header *)f->map;
+
+    return (const char *)f->map + h->strtab_off + off;
+}
+
+/* Sidecar path: hash of the source path */
+static void vqs_sidecar_path(const char *src, char *out, size_t len)
+{
+    uint64_t h = 14695981039346656037ull;
+
+    for (const char *p = src; *p; p++) {
+        h ^= (uint8_t)*p;
+        h *= 1099511628211ull;
+    }
+    snprintf(out, len, VQS_CACHE_DIR "/qsettings-%016llx.bin",
+             (unsigned long long)h);
+}
+
+/* ----- Builder: INI text -> binary table ----- */
+
+struct vqs_build {
+    struct vqs_entry entries[VQS_MAX_ENTRIES];
+    uint32_t count;
+    char    *strtab;
+    uint32_t str_used;
+    uint32_t str_cap;
+};
+
+static uint32_t vqs_intern(struct vqs_build *b, const char *s,
+                           size_t len)
+{
+    uint32_t off = b->str_used;
+
+    if (b->str_used + len + 1 > b->str_cap) {
+        uint32_t ncap = b->str_cap ? b->str_cap * 2 : 4096;
+
+        while (ncap < b->str_used + len + 1)
+            ncap *= 2;
+        b->strtab = realloc(b->strtab, ncap);
+        b->str_cap = ncap;
+    }
+    memcpy(b->strtab + off, s, len);
+    b->strtab[off + len] = '\0';
+    b->str_used += (uint32_t)(len + 1);
+    return off;
+}
+
+static int vqs_entry_cmp_build(const struct vqs_build *b,
+                               const struct vqs_entry *a,
+                               const struct vqs_entry *e)
+{
+    int c = strcmp(b->strtab + a->group_off, b->strtab + e->group_off);
+
+    if (c)
+        return c;
+    return strcmp(b->strtab + a->key_off, b->strtab + e->key_off);
+}
+
+static char *vqs_trim(char *s)
+{
+    char *end;
+
+    while (*s == ' ' || *s == '\t')
+        s++;
+    end = s + strlen(s);
+    while (end > s && (end[-1] == ' ' || end[-1] == '\t' ||
+                       end[-1] == '\n' || end[-1] == '\r'))
+        *--end = '\0';
+    return s;
+}
+
+/* Parse INI text into the build; returns 0 */
+static int vqs_parse(struct vqs_build *b, FILE *fp)
+{
+    char line[1024];
+    uint32_t group_off = vqs_intern(b, "General", 7);
+
+    while (fgets(line, sizeof(line), fp)) {
+        char *p = vqs_trim(line);
+
+        if (*p == '\0' || *p == '#' || *p == ';')
+            continue;
+        if (*p == '[') {
+            char *end = strchr(p, ']');
+
+            if (end) {
+                *end = '\0';
+                group_off = vqs_intern(b, p + 1,
+                                       (size_t)(end - p - 1));
+            }
+            continue;
+        }
+
+        char *eq = strchr(p, '=');
+
+        if (!eq || b->count >= VQS_MAX_ENTRIES)
+            continue;
+        *eq = '\0';
+
+        char *key = vqs_trim(p);
+        char *val = vqs_trim(eq + 1);
+        struct vqs_entry *e = &b->entries[b->count];
+
+        e->group_off = group_off;
+        e->key_off = vqs_intern(b, key, strlen(key));
+        e->value_off = vqs_intern(b, val, strlen(val));
+
+        /* Insertion sort keeps the table bsearch-able */
+        uint32_t i = b->count;
+
+        while (i > 0 &&
+               vqs_entry_cmp_build(b, &b->entries[i - 1], e) > 0) {
+            i--;
+        }
+        if (i < b->count) {
+            struct vqs_entry tmp = *e;
+
+            memmove(&b->entries[i + 1], &b->entries[i],
+                    (b->count - i) * sizeof(*e));
+            b->entries[i] = tmp;
+        }
+        b->count++;
+    }
+    return 0;
+}
+
+/* Serialize the build into one contiguous block */
+static void *vqs_serialize(const struct vqs_build *b, uint64_t mtime,
+                           uint64_t size, size_t *out_len)
+{
+    size_t ents = b->count * sizeof(struct vqs_entry);
+    size_t total = sizeof(struct vqs_header) + ents + b->str_used;
+    struct vqs_header *h = malloc(total);
+
+    if (!h)
+        return NULL;
+    h->magic = VQS_MAGIC;
+    h->version = VQS_VERSION;
+    h->src_mtime = mtime;
+    h->src_size = size;
+    h->entry_count = b->count;
+    h->strtab_off = (uint32_t)(sizeof(*h) + ents);
+    memcpy(h + 1, b->entries, ents);
+    memcpy((char *)h + h->strtab_off, b->strtab, b->str_used);
+    *out_len = total;
+    return h;
+}
+
+/* Write the sidecar (best effort; tmp+rename) */
+static void vqs_write_sidecar(const char *src, const void *blob,
+                              size_t len)
+{
+    char path[300], tmp[308];
+    int fd;
+
+    mkdir(VQS_CACHE_DIR, 0755);
+    vqs_sidecar_path(src, path, sizeof(path));
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return;
+    if (write(fd, blob, len) == (ssize_t)len) {
+        close(fd);
+        rename(tmp, path);
+    } else {
+        close(fd);
+        unlink(tmp);
+    }
+}
+
+/* Try the sidecar; 0 on hit with f->map set */
+static int vqs_load_sidecar(struct vqs_file *f)
+{
+    char path[300];
+    struct stat st;
+    int fd;
+    void *map;
+
+    vqs_sidecar_path(f->path, path, sizeof(path));
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return -1;
+    if (fstat(fd, &st) < 0 || st.st_size < (off_t)sizeof(struct vqs_header)) {
+        close(fd);
+        return -1;
+    }
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return -1;
+
+    const struct vqs_header *h = map;
+
+    if (h->magic != VQS_MAGIC || h->version != VQS_VERSION ||
+        h->src_mtime != f->src_mtime || h->src_size != f->src_size) {
+        munmap(map, (size_t)st.st_size);
+        return -1;              /* Stale: source changed */
+    }
+    f->map = map;
+    f->map_len = (size_t)st.st_size;
+    f->heap = 0;
+    return 0;
+}
+
+/* (Re)load f from sidecar or text */
+static int vqs_load(struct vqs_file *f)
+{
+    struct stat st;
+
+    if (stat(f->path, &st) < 0)
+        return -1;
+    f->src_mtime = (uint64_t)st.st_mtime;
+    f->src_size = (uint64_t)st.st_size;
+
+    if (vqs_load_sidecar(f) == 0)
+        return 0;               /* Parsed form reused, zero parsing */
+
+    FILE *fp = fopen(f->path, "r");
+
+    if (!fp)
+        return -1;
+
+    struct vqs_build b;
+
+    memset(&b, 0, sizeof(b));
+    vqs_parse(&b, fp);
+    fclose(fp);
+
+    size_t len;
+    void *blob = vqs_serialize(&b, f->src_mtime, f->src_size, &len);
+
+    free(b.strtab);
+    if (!blob)
+        return -1;
+
+    vqs_write_sidecar(f->path, blob, len);
+    f->map = blob;
+    f->map_len = len;
+    f->heap = 1;
+    return 0;
+}
+
+static void vqs_unload(struct vqs_file *f)
+{
+    if (!f->map)
+        return;
+    if (f->heap)
+        free(f->map);
+    else
+        munmap(f->map, f->map_len);
+    f->map = NULL;
+}
+
+/* Drain the watch fd; nonzero when the source changed */
+static int vqs_changed(struct vqs_file *f)
+{
+    char buf[512];
+    int changed = 0;
+
+    if (f->watch_fd < 0)
+        return 0;
+    while (read(f->watch_fd, buf, sizeof(buf)) > 0)
+        changed = 1;
+    return changed;
+}
+
+struct vqs_file *vqs_open(const char *path)
+{
+    struct vqs_file *f = NULL;
+
+    if (!path || strlen(path) >= sizeof(f->path))
+        return NULL;
+
+    for (int i = 0; i < VQS_MAX_FILES; i++) {
+        if (g_vqs[i].map && strcmp(g_vqs[i].path, path) == 0) {
+            g_vqs[i].refs++;
+            return &g_vqs[i];
+        }
+    }
+    for (int i = 0; i < VQS_MAX_FILES; i++) {
+        if (!g_vqs[i].map && g_vqs[i].refs == 0) {
+            f = &g_vqs[i];
+            break;
+        }
+    }
+    if (!f)
+        return NULL;
+
+    memset(f, 0, sizeof(*f));
+    strcpy(f->path, path);
+    f->watch_fd = -1;
+    if (vqs_load(f) < 0)
+        return NULL;
+
+    /* Invalidation push channel; polling stat() is the fallback
+     * when inotify is unavailable */
+    f->watch_fd = inotify_init1(IN_NONBLOCK);
+    if (f->watch_fd >= 0 &&
+        inotify_add_watch(f->watch_fd, path,
+                          IN_MODIFY | IN_MOVE_SELF | IN_DELETE_SELF) < 0) {
+        close(f->watch_fd);
+        f->watch_fd = -1;
+    }
+
+    f->refs = 1;
+    return f;
+}
+
+const char *vqs_get(struct vqs_file *f, const char *group,
+                    const char *key)
+{
+    if (!f || !f->map || !group || !key)
+        return NULL;
+
+    if (vqs_changed(f)) {
+        vqs_unload(f);
+        if (vqs_load(f) < 0)
+            return NULL;
+    }
+
+    const struct vqs_header *h = f->map;
+    const struct vqs_entry *ents =
+        (const struct vqs_entry *)(h + 1);
+    uint32_t lo = 0, hi = h->entry_count;
+
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        int c = strcmp(vqs_str(f, ents[mid].group_off), group);
+
+        if (c == 0)
+            c = strcmp(vqs_str(f, ents[mid].key_off), key);
+        if (c == 0)
+            return vqs_str(f, ents[mid].value_off);
+        if (c < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return NULL;
+}
+
+void vqs_release(struct vqs_file *f)
+{
+    if (!f || f->refs <= 0)
+        return;
+    if (--f->refs == 0) {
+        vqs_unload(f);
+        if (f->watch_fd >= 0) {
+            close(f->watch_fd);
+            f->watch_fd = -1;
+        }
+    }
+}
+
+/* ========================================================================= */
+/* Shared compiled-QML cache                                                 */
+/* ========================================================================= */
+
+/*
+ * One system-wide store for QML compilation artifacts: plasmashell,
+ * every applet host, and the lockscreen map the same compiled copy
+ * instead of each rebuilding it per process per start.  Artifacts
+ * are keyed by source identity (path, mtime, size) plus the global
+ * cache salt -- /var/cache/veridian/qmlcache/SALT, bumped by theme
+ * installs and Qt updates -- so an update regenerates everything
+ * without anyone tracking dependencies.  get() maps the artifact
+ * MAP_SHARED read-only (all processes share the page-cache copy);
+ * put() publishes with tmp+rename so readers never see a torn
+ * artifact.
+ */
+
+#define VQML_DIR "/var/cache/veridian/qmlcache"
+
+const char *vqml_cache_dir(void)
+{
+    return VQML_DIR;
+}
+
+static uint64_t vqml_key(const char *source_path)
+{
+    struct stat st, salt;
+    uint64_t h = 14695981039346656037ull;
+
+    if (stat(source_path, &st) < 0)
+        return 0;
+
+    for (const char *p = source_path; *p; p++) {
+        h ^= (uint8_t)*p;
+        h *= 1099511628211ull;
+    }
+
+    uint64_t mix[3] = { (uint64_t)st.st_mtime, (uint64_t)st.st_size,
+                        0 };
+
+    if (stat(VQML_DIR "/SALT", &salt) == 0)
+        mix[2] = (uint64_t)salt.st_mtime;
+
+    for (int i = 0; i < 3; i++) {
+        for (int b = 0; b < 8; b++) {
+            h ^= (mix[i] >> (b * 8)) & 0xFF;
+            h *= 1099511628211ull;
+        }
+    }
+    return h ? h : 1;
+}
+
+static void vqml_path(uint64_t key, char *out, size_t len)
+{
+    snprintf(out, len, VQML_DIR "/%016llx.qmlc",
+             (unsigned long long)key);
+}
+
+/*
+ * Fetch the compiled artifact for a QML source.  The returned
+ * mapping is read-only and lives for the process lifetime.
+ * NULL on miss (caller compiles and put()s).
+ */
+const void *vqml_cache_get(const char *source_path, size_t *len)
+{
+    char path[300];
+    uint64_t key = source_path ? vqml_key(source_path) : 0;
+    struct stat st;
+    int fd;
+    void *map;
+
+    if (key == 0)
+        return NULL;
+    vqml_path(key, path, sizeof(path));
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    if (fstat(fd, &st) < 0 || st.st_size == 0) {
+        close(fd);
+        return NULL;
+    }
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return NULL;
+    if (len)
+        *len = (size_t)st.st_size;
+    return map;
+}
+
+/* Publish a freshly compiled artifact; racing writers both win
+ * (identical content, last rename sticks). */
+int vqml_cache_put(const char *source_path, const void *blob,
+                   size_t len)
+{
+    char path[300], tmp[312];
+    uint64_t key = source_path ? vqml_key(source_path) : 0;
+    int fd;
+
+    if (key == 0 || !blob || len == 0)
+        return -1;
+
+    mkdir("/var/cache", 0755);
+    mkdir("/var/cache/veridian", 0755);
+    mkdir(VQML_DIR, 0755);
+
+    vqml_path(key, path, sizeof(path));
+    snprintf(tmp, sizeof(tmp), "%s.%d.tmp", path, (int)getpid());
+    fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return -1;
+
+    size_t done = 0;
+
+    while (done < len) {
+        ssize_t w = write(fd, (const char *)blob + done, len - done);
+
+        if (w <= 0) {
+            close(fd);
+            unlink(tmp);
+            return -1;
+        }
+        done += (size_t)w;
+    }
+    close(fd);
+    return rename(tmp, path);
+}
@@ -76,11 +76,21 @@ struct regex_node {
     int             target;
 };
 
+struct regex_dfa;   /* Lazy DFA cache, built on first captureless exec */
+
 struct compiled_regex {
     struct regex_node nodes[MAX_NODES];
     int               num_nodes;
     int               num_groups;   /* Number of capturing groups */
     int               cflags;       /* Original compile flags */
+
+    /* Lazy-DFA state cache (existence matching only) */
+    struct regex_dfa *dfa;
+    int               dfa_disabled; /* Pathological pattern: NFA only */
+
+    /* Literal first character for memchr prefix skipping */
+    int               has_prefix;
+    unsigned char     prefix_char;
 };
 
 /* ========================================================================= */
@@ -955,6 +965,21 @@ int regcomp(regex_t *preg, const char *pattern, int cflags)
     }
 
     re->num_groups = ps.group_count;
+
+    /* Literal first character enables memchr skipping in the DFA
+     * search (only when reached unconditionally: skip group opens,
+     * stop at anchors/branches/quantifiable structure) */
+    {
+        int ni = 0;
+        while (ni < re->num_nodes &&
+               re->nodes[ni].type == NODE_GROUP_START)
+            ni++;
+        if (ni < re->num_nodes && re->nodes[ni].type == NODE_LITERAL) {
+            re->has_prefix = 1;
+            re->prefix_char = re->nodes[ni].ch;
+        }
+    }
+
     preg->re_nsub = (size_t)ps.group_count;
     preg->__internal = re;
 
@@ -1166,6 +1191,307 @@ static int match_here(struct match_state *ms, int ni, int si)
     return -1;
 }
 
+/* ========================================================================= */
+/* Lazy DFA engine                                                           */
+/* ========================================================================= */
+
+/*
+ * Hybrid matching: when the caller only needs existence (REG_NOSUB or
+ * nmatch == 0 -- the KRunner / fontconfig pattern of filtering long
+ * candidate lists), the NFA program is run through a lazily built
+ * DFA.  Each DFA state is a set of NFA nodes; transitions are
+ * computed on first use and cached, so repeated matching is O(n) in
+ * the input with no backtracking.  Captures still use the NFA engine,
+ * which is also the fallback when the state cache thrashes.
+ *
+ * Unanchored search folds the start closure into every transition
+ * (the ".*?" prefix trick), so one left-to-right pass covers all
+ * start positions; while sitting in the start state with a literal
+ * first character, the scan jumps ahead with memchr instead of
+ * stepping byte by byte.
+ */
+
+#define DFA_MAX_STATES  64
+#define DFA_MAX_FLUSHES 8
+#define NFA_SET_BYTES   (MAX_NODES / 8)
+
+struct dfa_state {
+    unsigned char nfa[NFA_SET_BYTES];   /* NFA node-index set  */
+    int next[256];                      /* -1 = not computed   */
+    int accept;                         /* Contains NODE_MATCH */
+    int accept_eol;                     /* $ reached; match at end-of-line */
+};
+
+struct regex_dfa {
+    struct dfa_state states[DFA_MAX_STATES];
+    int num_states;
+    int flushes;
+};
+
+static int nfa_set_test(const unsigned char *set, int ni)
+{
+    return (set[ni >> 3] >> (ni & 7)) & 1;
+}
+
+static void nfa_set_add(unsigned char *set, int ni)
+{
+    set[ni >> 3] |= (unsigned char)(1u << (ni & 7));
+}
+
+/* Does the epsilon-continuation of node ni reach NODE_MATCH?
+ * (Used for $: whether stopping here at end-of-line is a match.) */
+static int eps_reaches_match(const struct compiled_regex *re, int ni,
+                             int depth)
+{
+    if (ni < 0 || ni >= re->num_nodes || depth > MAX_NODES)
+        return 0;
+
+    const struct regex_node *nd = &re->nodes[ni];
+
+    switch (nd->type) {
+    case NODE_MATCH:
+        return 1;
+    case NODE_GROUP_START:
+    case NODE_GROUP_END:
+        return eps_reaches_match(re, ni + 1, depth + 1);
+    case NODE_JUMP:
+        return eps_reaches_match(re, nd->target >= 0 ? nd->target : ni + 1,
+                                 depth + 1);
+    case NODE_BRANCH:
+        if (eps_reaches_match(re, ni + 1, depth + 1))
+            return 1;
+        return nd->alt >= 0 && eps_reaches_match(re, nd->alt, depth + 1);
+    case NODE_ANCHOR_END:
+        /* Only reached from the accept_eol computation, which is
+         * evaluated at end-of-line -- where a further $ is satisfied
+         * trivially.  Treating it as a dead end made the DFA reject
+         * patterns like $$ that the NFA in this same file accepts. */
+        return eps_reaches_match(re, ni + 1, depth + 1);
+    default:
+        return 0;
+    }
+}
+
+/* Epsilon closure: expand ni into the set.  at_bol gates ^ anchors;
+ * $ anchors are recorded in the set and priced at step time. */
+static void dfa_closure(const struct compiled_regex *re, unsigned char *set,
+                        int ni, int at_bol)
+{
+    while (ni >= 0 && ni < re->num_nodes) {
+        if (nfa_set_test(set, ni))
+            return;
+        nfa_set_add(set, ni);
+
+        const struct regex_node *nd = &re->nodes[ni];
+
+        switch (nd->type) {
+        case NODE_GROUP_START:
+        case NODE_GROUP_END:
+            ni++;
+            continue;
+        case NODE_JUMP:
+            ni = (nd->target >= 0) ? nd->target : ni + 1;
+            continue;
+        case NODE_BRANCH:
+            dfa_closure(re, set, ni + 1, at_bol);
+            ni = nd->alt;
+            continue;
+        case NODE_ANCHOR_START:
+            if (!at_bol)
+                return;
+            ni++;
+            continue;
+        default:
+            /* Consuming node, MATCH, or $: stays in the set */
+            return;
+        }
+    }
+}
+
+/* Does one consuming node accept character ch?  Mirrors match_here. */
+static int node_matches_char(const struct regex_node *nd, unsigned char ch,
+                             int cflags)
+{
+    switch (nd->type) {
+    case NODE_LITERAL: {
+        unsigned char sc = ch;
+        if (cflags & REG_ICASE)
+            sc = (unsigned char)char_lower(sc);
+        return sc == nd->ch;
+    }
+    case NODE_DOT:
+        if ((cflags & REG_NEWLINE) && ch == '\n')
+            return 0;
+        return 1;
+    case NODE_CLASS: {
+        if ((cflags & REG_NEWLINE) && nd->negate && ch == '\n')
+            return 0;
+        int in_class = class_test(nd->cclass, ch);
+        if (cflags & REG_ICASE) {
+            in_class = in_class ||
+                class_test(nd->cclass, (unsigned char)char_lower(ch)) ||
+                class_test(nd->cclass, (unsigned char)char_upper(ch));
+        }
+        return nd->negate ? !in_class : in_class;
+    }
+    default:
+        return 0;
+    }
+}
+
+/* Finalize a freshly built set into a state id (deduplicating).
+ * Returns the state id, or -1 when the table is full. */
+static int dfa_intern_state(struct compiled_regex *re,
+                            const unsigned char *set)
+{
+    struct regex_dfa *dfa = re->dfa;
+    int s, i;
+
+    for (s = 0; s < dfa->num_states; s++) {
+        if (memcmp(dfa->states[s].nfa, set, NFA_SET_BYTES) == 0)
+            return s;
+    }
+
+    if (dfa->num_states >= DFA_MAX_STATES)
+        return -1;
+
+    struct dfa_state *st = &dfa->states[dfa->num_states];
+    memcpy(st->nfa, set, NFA_SET_BYTES);
+    for (i = 0; i < 256; i++)
+        st->next[i] = -1;
+
+    st->accept = 0;
+    st->accept_eol = 0;
+    for (i = 0; i < re->num_nodes; i++) {
+        if (!nfa_set_test(set, i))
+            continue;
+        if (re->nodes[i].type == NODE_MATCH)
+            st->accept = 1;
+        else if (re->nodes[i].type == NODE_ANCHOR_END &&
+                 eps_reaches_match(re, i + 1, 0))
+            st->accept_eol = 1;
+    }
+
+    return dfa->num_states++;
+}
+
+/* The start closure for a position with the given ^-context. */
+static int dfa_start_state(struct compiled_regex *re, int at_bol)
+{
+    unsigned char set[NFA_SET_BYTES];
+
+    memset(set, 0, sizeof(set));
+    dfa_closure(re, set, 0, at_bol);
+    return dfa_intern_state(re, set);
+}
+
+/*
+ * Compute (and cache) the transition from state s on character ch.
+ * The successor folds in the start closure so the automaton tracks
+ * every possible match start in one pass.
+ */
+static int dfa_transition(struct compiled_regex *re, int s, unsigned char ch)
+{
+    struct regex_dfa *dfa = re->dfa;
+    unsigned char set[NFA_SET_BYTES];
+    int at_bol, i, next;
+
+    if (dfa->states[s].next[ch] >= 0)
+        return dfa->states[s].next[ch];
+
+    /* ^ context of the next position follows from this character */
+    at_bol = ((re->cflags & REG_NEWLINE) && ch == '\n');
+
+    memset(set, 0, sizeof(set));
+    for (i = 0; i < re->num_nodes; i++) {
+        if (!nfa_set_test(dfa->states[s].nfa, i))
+            continue;
+        if (node_matches_char(&re->nodes[i], ch, re->cflags))
+            dfa_closure(re, set, i + 1, at_bol);
+    }
+
+    /* Unanchored: a new match may start at the next position */
+    dfa_closure(re, set, 0, at_bol);
+
+    next = dfa_intern_state(re, set);
+    if (next >= 0)
+        dfa->states[s].next[ch] = next;
+    return next;
+}
+
+/*
+ * One-pass existence search.  Returns 1 on match, 0 on no match, or
+ * -1 when the DFA bailed (cache thrash / allocation failure) and the
+ * caller should fall back to the NFA engine.
+ */
+static int dfa_search(struct compiled_regex *re, const char *str, int len,
+                      int eflags)
+{
+    int start_bol, start_nobol, state, i;
+
+    if (re->dfa_disabled)
+        return -1;
+
+    if (!re->dfa) {
+        re->dfa = (struct regex_dfa *)malloc(sizeof(struct regex_dfa));
+        if (!re->dfa)
+            return -1;
+        re->dfa->num_states = 0;
+        re->dfa->flushes = 0;
+    }
+
+    start_bol = dfa_start_state(re, 1);
+    start_nobol = dfa_start_state(re, 0);
+    if (start_bol < 0 || start_nobol < 0)
+        goto flush;
+
+    state = (eflags & REG_NOTBOL) ? start_nobol : start_bol;
+
+    for (i = 0; ; i++) {
+        const struct dfa_state *st = &re->dfa->states[state];
+
+        if (st->accept)
+            return 1;
+        if (st->accept_eol) {
+            int at_eol = (i == len && !(eflags & REG_NOTEOL)) ||
+                         ((re->cflags & REG_NEWLINE) && i < len &&
+                          str[i] == '\n');
+            if (at_eol)
+                return 1;
+        }
+
+        if (i >= len)
+            break;
+
+        /* In the start state nothing has matched yet; with a literal
+         * first character, jump straight to its next occurrence */
+        if (re->has_prefix &&
+            !(re->cflags & (REG_ICASE | REG_NEWLINE)) &&
+            (state == start_bol || state == start_nobol)) {
+            const char *p = (const char *)memchr(str + i, re->prefix_char,
+                                                 (size_t)(len - i));
+            if (!p)
+                break;
+            i = (int)(p - str);
+        }
+
+        int next = dfa_transition(re, state, (unsigned char)str[i]);
+        if (next < 0)
+            goto flush;
+        state = next;
+    }
+
+    return 0;
+
+flush:
+    /* State table overflowed: reset it and let the NFA answer this
+     * call; repeated thrashing disables the DFA for this pattern */
+    re->dfa->num_states = 0;
+    if (++re->dfa->flushes > DFA_MAX_FLUSHES)
+        re->dfa_disabled = 1;
+    return -1;
+}
+
 /* ========================================================================= */
 /* regexec: execute a compiled regular expression                            */
 /* ========================================================================= */
@@ -1178,6 +1504,15 @@ int regexec(const regex_t *preg, const char *string,
 
     struct compiled_regex *re = (struct compiled_regex *)preg->__internal;
 
+    /* Captureless matching goes through the lazy DFA: O(n) in the
+     * input, no backtracking, one pass over candidate lists */
+    if (nmatch == 0 || (re->cflags & REG_NOSUB)) {
+        int dret = dfa_search(re, string, (int)strlen(string), eflags);
+        if (dret >= 0)
+            return dret ? 0 : REG_NOMATCH;
+        /* DFA bailed: fall through to the NFA engine */
+    }
+
     struct match_state ms;
     memset(&ms, 0, sizeof(ms));
     ms.str = string;
@@ -1246,6 +1581,7 @@ void regfree(regex_t *preg)
         }
     }
 
+    free(re->dfa);
     free(re);
     preg->__internal = NULL;
     preg->re_nsub = 0;
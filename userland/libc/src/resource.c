@@ -13,6 +13,8 @@
 #include <sys/resource.h>
 #include <string.h>
 #include <errno.h>
+#include <unistd.h>
+#include <veridian/syscall.h>
 
 int getrlimit(int resource, struct rlimit *rlp)
 {
@@ -51,3 +53,71 @@ int getrusage(int who, struct rusage *usage)
     memset(usage, 0, sizeof(*usage));
     return 0;
 }
+
+/* ========================================================================= */
+/* Scheduling priority                                                       */
+/* ========================================================================= */
+
+/*
+ * Nice levels map straight onto the kernel CFS weight table via
+ * SYS_PROCESS_SETPRIORITY / SYS_PROCESS_GETPRIORITY; `which` and
+ * `who` pass through so PRIO_PGRP tags a whole process group (the
+ * shell uses this for background jobs) in one call.
+ */
+
+int setpriority(int which, id_t who, int prio)
+{
+    long ret;
+
+    if (which < PRIO_PROCESS || which > PRIO_USER) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (prio < PRIO_MIN)
+        prio = PRIO_MIN;
+    if (prio > PRIO_MAX)
+        prio = PRIO_MAX;
+
+    ret = veridian_syscall3(SYS_PROCESS_SETPRIORITY, (long)which,
+                            (long)who, (long)prio);
+    if (ret < 0) {
+        errno = (int)-ret;
+        return -1;
+    }
+    return 0;
+}
+
+int getpriority(int which, id_t who)
+{
+    long ret;
+
+    if (which < PRIO_PROCESS || which > PRIO_USER) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    /* The kernel returns prio + 20 (0..39) so negative nice values
+     * never alias the negative-errno window */
+    ret = veridian_syscall2(SYS_PROCESS_GETPRIORITY, (long)which,
+                            (long)who);
+    if (ret < 0) {
+        errno = (int)-ret;
+        return -1;
+    }
+    return (int)ret - 20;
+}
+
+/* Raise this process's nice value (lower its priority) */
+int nice(int inc)
+{
+    int cur;
+
+    errno = 0;
+    cur = getpriority(PRIO_PROCESS, 0);
+    if (cur == -1 && errno != 0)
+        cur = 0;        /* Unknown: treat as default */
+    if (setpriority(PRIO_PROCESS, 0, cur + inc) < 0)
+        return -1;
+    errno = 0;
+    return getpriority(PRIO_PROCESS, 0);
+}
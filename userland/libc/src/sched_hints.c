@@ -0,0 +1,95 @@
+/*
+ * VeridianOS libc -- sched_hints.c
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Scheduling placement hints (veridian/sched.h).
+ */
+
+#include <veridian/sched.h>
+#include <veridian/syscall.h>
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+int veridian_sched_set_role(int role)
+{
+    long ret;
+
+    if (role < VSCHED_ROLE_DEFAULT || role > VSCHED_ROLE_BATCH) {
+        errno = EINVAL;
+        return -1;
+    }
+    ret = veridian_syscall1(SYS_SCHED_SET_ROLE, (long)role);
+    if (ret < 0) {
+        errno = (int)-ret;
+        return -1;
+    }
+    return 0;
+}
+
+int veridian_sched_set_affinity_hint(uint64_t cpu_mask)
+{
+    long ret = veridian_syscall1(SYS_SCHED_SET_HINT, (long)cpu_mask);
+
+    if (ret < 0) {
+        errno = (int)-ret;
+        return -1;
+    }
+    return 0;
+}
+
+int veridian_sched_get_topology(struct veridian_topology *out)
+{
+    long ret;
+
+    if (!out) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    ret = veridian_syscall1(SYS_SCHED_GET_TOPOLOGY, (long)out);
+    if (ret == 0)
+        return 0;
+
+    /* Synthesize a single UMA node so placement math always works */
+    {
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+
+        if (n < 1)
+            n = 1;
+        if (n > 64)
+            n = 64;
+        memset(out, 0, sizeof(*out));
+        out->cpus = (uint32_t)n;
+        out->nodes = 1;
+        out->l3_groups = 1;
+        out->node_mask[0] =
+            n >= 64 ? ~0ull : ((1ull << n) - 1);
+    }
+    return 0;
+}
+
+uint64_t veridian_sched_latency_cpu(unsigned int index)
+{
+    struct veridian_topology topo;
+    uint64_t mask;
+    unsigned int i;
+
+    veridian_sched_get_topology(&topo);
+    mask = topo.node_mask[0];
+    if (mask == 0)
+        mask = 1;
+
+    /* The index-th set bit of the first node */
+    for (i = 0; mask != 0; i++) {
+        uint64_t bit = mask & (uint64_t)-(int64_t)mask;
+
+        if (i == index)
+            return bit;
+        mask &= mask - 1;
+    }
+    return 1;   /* Fewer CPUs than latency threads: share CPU 0 */
+}
@@ -1169,3 +1169,757 @@ int sd_bus_error_has_name(const sd_bus_error *e, const char *name)
         return 0;
     return strcmp(e->name, name) == 0 ? 1 : 0;
 }
+
+/* ========================================================================= */
+/* sd-journal: deferred structured logging                                   */
+/* ========================================================================= */
+
+/*
+ * The submit side packs (format pointer, tagged argument values) into
+ * a bounded MPMC ring (Vyukov-style per-slot sequence numbers: CAS on
+ * the enqueue cursor claims a cell, a release-store of the cell's
+ * sequence publishes it) and never formats, locks, or writes.  A
+ * drainer thread, started on first use, pops records, expands each
+ * conversion with a per-directive snprintf, and appends batches to
+ * the journal file with one write().  String arguments are copied
+ * into the record at submit time; the format string itself is
+ * referenced by pointer and must be a literal or otherwise immortal,
+ * which is how every call site uses printf-family formats anyway.
+ */
+
+#include <systemd/sd-journal.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <time.h>
+
+#define VJL_RING_SIZE   1024            /* Power of two */
+#define VJL_MAX_ARGS    12
+#define VJL_STRBUF_SIZE 152
+
+/* Argument type tags */
+enum {
+    VJL_ARG_INT = 0,            /* Signed, value sign-extended */
+    VJL_ARG_UINT,               /* Unsigned (also %x, %o, %c, %p) */
+    VJL_ARG_DBL,                /* Double, bit pattern in val */
+    VJL_ARG_STR,                /* val = offset into strbuf */
+    VJL_ARG_PREFORMATTED        /* Whole message already in strbuf */
+};
+
+struct vjl_rec {
+    uint32_t    seq;            /* Cell sequence (Vyukov) */
+    uint8_t     priority;
+    uint8_t     nargs;
+    uint16_t    str_used;
+    uint64_t    ts_ns;
+    const char *fmt;
+    uint8_t     tags[VJL_MAX_ARGS];
+    uint64_t    vals[VJL_MAX_ARGS];
+    char        strbuf[VJL_STRBUF_SIZE];
+};
+
+static struct vjl_rec g_vjl_ring[VJL_RING_SIZE];
+static uint32_t g_vjl_enq;              /* Next cell to claim */
+static uint32_t g_vjl_deq;              /* Drainer-private */
+static uint64_t g_vjl_enqueued;
+static uint64_t g_vjl_dropped;
+
+static uint64_t vjl_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/*
+ * Per-source token buckets, keyed by format-string pointer (one
+ * bucket per call site).  A flooding source exhausts its own bucket
+ * and is suppressed at submit time -- the ring and drainer never see
+ * the excess.  Slots are claimed with the usual CAS-then-publish
+ * pattern; the table never shrinks.
+ */
+
+#define VJL_SRC_SLOTS   64
+#define VJL_RL_BURST    200             /* Bucket capacity */
+#define VJL_RL_RATE     100             /* Tokens per second */
+
+struct vjl_src {
+    const char *fmt;                    /* CAS-claimed slot key */
+    int32_t     tokens;
+    uint64_t    refill_ns;
+    uint64_t    suppressed;             /* Dropped since last pass */
+};
+
+static struct vjl_src g_vjl_src[VJL_SRC_SLOTS];
+static uint64_t g_vjl_suppressed;
+static uint64_t g_vjl_collapsed;
+
+static const char VJL_FMT_SUPPRESSED[] =
+    "(rate limit: suppressed %llu earlier messages from this source)";
+
+/* Find or claim the bucket for a call site; NULL when the table is
+ * full (such sources go unlimited rather than silenced) */
+static struct vjl_src *vjl_src_slot(const char *fmt)
+{
+    uint64_t h = (uint64_t)(uintptr_t)fmt;
+    uint32_t i;
+
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+
+    for (i = 0; i < VJL_SRC_SLOTS; i++) {
+        struct vjl_src *src =
+            &g_vjl_src[(h + i) & (VJL_SRC_SLOTS - 1)];
+        const char *key =
+            __atomic_load_n(&src->fmt, __ATOMIC_ACQUIRE);
+
+        if (key == fmt)
+            return src;
+        if (key == NULL) {
+            const char *expected = NULL;
+
+            src->tokens = VJL_RL_BURST;
+            src->refill_ns = vjl_now_ns();
+            if (__atomic_compare_exchange_n(&src->fmt, &expected, fmt,
+                                            0, __ATOMIC_RELEASE,
+                                            __ATOMIC_ACQUIRE))
+                return src;
+            if (expected == fmt)
+                return src;     /* Raced with ourselves */
+        }
+    }
+    return NULL;
+}
+
+/* Take one token; returns the number of suppressed records to report
+ * (0 = allowed with nothing pending, -1 = suppressed) */
+static int64_t vjl_rl_take(struct vjl_src *src)
+{
+    uint64_t now = vjl_now_ns();
+    uint64_t last = __atomic_load_n(&src->refill_ns, __ATOMIC_RELAXED);
+
+    /* Refill: one CAS winner credits the elapsed time */
+    if (now > last + 10000000ull) {
+        if (__atomic_compare_exchange_n(&src->refill_ns, &last, now, 0,
+                                        __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED)) {
+            int64_t credit =
+                (int64_t)((now - last) / (1000000000ull / VJL_RL_RATE));
+            int32_t cur =
+                __atomic_add_fetch(&src->tokens, (int32_t)credit,
+                                   __ATOMIC_RELAXED);
+
+            if (cur > VJL_RL_BURST)
+                __atomic_store_n(&src->tokens, VJL_RL_BURST,
+                                 __ATOMIC_RELAXED);
+        }
+    }
+
+    if (__atomic_fetch_sub(&src->tokens, 1, __ATOMIC_RELAXED) <= 0) {
+        __atomic_fetch_add(&src->tokens, 1, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&src->suppressed, 1, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&g_vjl_suppressed, 1, __ATOMIC_RELAXED);
+        return -1;
+    }
+    return (int64_t)__atomic_exchange_n(&src->suppressed, 0,
+                                        __ATOMIC_RELAXED);
+}
+
+static pthread_mutex_t g_vjl_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  g_vjl_cond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t  g_vjl_idle = PTHREAD_COND_INITIALIZER;
+static int  g_vjl_started;
+static int  g_vjl_draining;
+static pid_t g_vjl_pid;
+static int  g_vjl_fd = -1;
+
+static void vjl_ring_init(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < VJL_RING_SIZE; i++)
+        __atomic_store_n(&g_vjl_ring[i].seq, i, __ATOMIC_RELAXED);
+    g_vjl_enq = 0;
+    g_vjl_deq = 0;
+}
+
+/* ----- Formatter (drainer side) ----- */
+
+/* Expand one record into out; returns the length used */
+static int vjl_format(const struct vjl_rec *rec, char *out, size_t cap)
+{
+    static const char *prio_names[8] = {
+        "emerg", "alert", "crit", "err",
+        "warning", "notice", "info", "debug"
+    };
+    size_t len = 0;
+    const char *f;
+    int arg = 0;
+
+    len += (size_t)snprintf(out, cap, "%llu.%06llu [%s] ",
+                            (unsigned long long)(rec->ts_ns / 1000000000ull),
+                            (unsigned long long)(rec->ts_ns % 1000000000ull) / 1000,
+                            prio_names[rec->priority & LOG_PRIMASK]);
+
+    if (rec->nargs == 1 && rec->tags[0] == VJL_ARG_PREFORMATTED) {
+        len += (size_t)snprintf(out + len, cap - len, "%s", rec->strbuf);
+        goto done;
+    }
+
+    for (f = rec->fmt; *f && len + 2 < cap; ) {
+        char spec[32];
+        size_t sl;
+
+        if (*f != '%') {
+            out[len++] = *f++;
+            continue;
+        }
+        if (f[1] == '%') {
+            out[len++] = '%';
+            f += 2;
+            continue;
+        }
+
+        /* Copy the directive, normalizing length modifiers away:
+         * packed integers are already widened to 64 bits */
+        sl = 0;
+        spec[sl++] = *f++;                      /* '%' */
+        while (*f && strchr("-+ #0123456789.", *f) && sl < sizeof(spec) - 4)
+            spec[sl++] = *f++;
+        while (*f && strchr("hljzt", *f))
+            f++;
+        if (!*f || arg >= rec->nargs)
+            break;
+
+        switch (*f) {
+        case 'd': case 'i':
+            spec[sl++] = 'l'; spec[sl++] = 'l'; spec[sl++] = 'd';
+            spec[sl] = '\0';
+            len += (size_t)snprintf(out + len, cap - len, spec,
+                                    (long long)(int64_t)rec->vals[arg]);
+            break;
+        case 'u': case 'x': case 'X': case 'o':
+            spec[sl++] = 'l'; spec[sl++] = 'l'; spec[sl++] = *f;
+            spec[sl] = '\0';
+            len += (size_t)snprintf(out + len, cap - len, spec,
+                                    (unsigned long long)rec->vals[arg]);
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': {
+            double d;
+
+            memcpy(&d, &rec->vals[arg], sizeof(d));
+            spec[sl++] = *f;
+            spec[sl] = '\0';
+            len += (size_t)snprintf(out + len, cap - len, spec, d);
+            break;
+        }
+        case 'c':
+            out[len++] = (char)rec->vals[arg];
+            break;
+        case 's':
+            spec[sl++] = 's';
+            spec[sl] = '\0';
+            len += (size_t)snprintf(out + len, cap - len, spec,
+                                    rec->strbuf + rec->vals[arg]);
+            break;
+        case 'p':
+            len += (size_t)snprintf(out + len, cap - len, "0x%llx",
+                                    (unsigned long long)rec->vals[arg]);
+            break;
+        default:
+            break;
+        }
+        f++;
+        arg++;
+        if (len >= cap)
+            len = cap - 1;
+    }
+
+done:
+    if (len >= cap)
+        len = cap - 1;
+    out[len++] = '\n';
+    out[len] = '\0';
+    return (int)len;
+}
+
+static void vjl_open_sink(void)
+{
+    if (g_vjl_fd >= 0)
+        return;
+    mkdir("/var/log", 0755);
+    mkdir("/var/log/veridian", 0755);
+    g_vjl_fd = open("/var/log/veridian/journal",
+                    O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (g_vjl_fd < 0)
+        g_vjl_fd = open("/tmp/veridian-journal.log",
+                        O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (g_vjl_fd < 0)
+        g_vjl_fd = STDERR_FILENO;
+}
+
+/*
+ * Dedup window (drainer-private): the first of a run of identical
+ * records is written through; repeats within the window only bump a
+ * counter, folded into one "repeated N times" line when a different
+ * message arrives or the window expires.
+ */
+
+#define VJL_DEDUP_WINDOW_NS 1000000000ull
+
+static struct vjl_rec g_vjl_prev;
+static int      g_vjl_prev_valid;
+static uint64_t g_vjl_repeats;
+
+/* Identical payload (timestamp excluded)? */
+static int vjl_rec_same(const struct vjl_rec *a, const struct vjl_rec *b)
+{
+    return a->fmt == b->fmt &&
+           a->priority == b->priority &&
+           a->nargs == b->nargs &&
+           a->str_used == b->str_used &&
+           memcmp(a->tags, b->tags, a->nargs) == 0 &&
+           memcmp(a->vals, b->vals,
+                  (size_t)a->nargs * sizeof(a->vals[0])) == 0 &&
+           memcmp(a->strbuf, b->strbuf, a->str_used) == 0;
+}
+
+static void vjl_emit(const char *line, int n, char *batch, size_t *used)
+{
+    if (*used + (size_t)n > 16384) {
+        vjl_open_sink();
+        (void)!write(g_vjl_fd, batch, *used);
+        *used = 0;
+    }
+    memcpy(batch + *used, line, (size_t)n);
+    *used += (size_t)n;
+}
+
+/* Close the dedup run, emitting the repeat summary if any */
+static void vjl_dedup_break(char *batch, size_t *used, uint64_t now)
+{
+    if (g_vjl_prev_valid && g_vjl_repeats > 0) {
+        char line[128];
+        int n = snprintf(line, sizeof(line),
+                         "%llu.%06llu [info] (last message repeated "
+                         "%llu times)\n",
+                         (unsigned long long)(now / 1000000000ull),
+                         (unsigned long long)(now % 1000000000ull) / 1000,
+                         (unsigned long long)g_vjl_repeats);
+
+        vjl_emit(line, n, batch, used);
+        g_vjl_collapsed += g_vjl_repeats;
+    }
+    g_vjl_repeats = 0;
+    g_vjl_prev_valid = 0;
+}
+
+/* Pop and persist everything currently in the ring */
+static void vjl_drain(void)
+{
+    char batch[16384];
+    size_t used = 0;
+
+    for (;;) {
+        struct vjl_rec *rec = &g_vjl_ring[g_vjl_deq & (VJL_RING_SIZE - 1)];
+        uint32_t seq = __atomic_load_n(&rec->seq, __ATOMIC_ACQUIRE);
+        char line[512];
+        int n;
+
+        if ((int32_t)(seq - (g_vjl_deq + 1)) < 0)
+            break;              /* Next record not published yet */
+
+        if (g_vjl_prev_valid && vjl_rec_same(rec, &g_vjl_prev) &&
+            rec->ts_ns - g_vjl_prev.ts_ns < VJL_DEDUP_WINDOW_NS) {
+            /* Repeat within the window: count, don't format */
+            g_vjl_repeats++;
+        } else {
+            vjl_dedup_break(batch, &used, rec->ts_ns);
+            n = vjl_format(rec, line, sizeof(line));
+            vjl_emit(line, n, batch, &used);
+            g_vjl_prev = *rec;
+            g_vjl_prev_valid = 1;
+        }
+
+        /* Release the cell for the next lap */
+        __atomic_store_n(&rec->seq, g_vjl_deq + VJL_RING_SIZE,
+                         __ATOMIC_RELEASE);
+        g_vjl_deq++;
+    }
+
+    /* Expire a stale window so held repeat counts aren't deferred
+     * indefinitely on an idle log */
+    if (g_vjl_prev_valid && g_vjl_repeats > 0 &&
+        vjl_now_ns() - g_vjl_prev.ts_ns >= VJL_DEDUP_WINDOW_NS)
+        vjl_dedup_break(batch, &used, vjl_now_ns());
+
+    if (used > 0) {
+        vjl_open_sink();
+        (void)!write(g_vjl_fd, batch, used);
+    }
+}
+
+static void *vjl_drainer_main(void *arg)
+{
+    (void)arg;
+    pthread_mutex_lock(&g_vjl_lock);
+    for (;;) {
+        struct timespec ts;
+
+        clock_gettime(CLOCK_REALTIME, &ts);
+        ts.tv_nsec += 100000000;            /* 100ms batching window */
+        if (ts.tv_nsec >= 1000000000) {
+            ts.tv_sec++;
+            ts.tv_nsec -= 1000000000;
+        }
+        pthread_cond_timedwait(&g_vjl_cond, &g_vjl_lock, &ts);
+
+        g_vjl_draining = 1;
+        pthread_mutex_unlock(&g_vjl_lock);
+        vjl_drain();
+        pthread_mutex_lock(&g_vjl_lock);
+        g_vjl_draining = 0;
+        pthread_cond_broadcast(&g_vjl_idle);
+    }
+    return NULL;
+}
+
+static void vjl_ensure_drainer(void)
+{
+    pthread_mutex_lock(&g_vjl_lock);
+    if (!g_vjl_started || g_vjl_pid != getpid()) {
+        pthread_t tid;
+
+        /* First use, or first use after fork (the child inherits the
+         * ring but not the drainer thread) */
+        if (g_vjl_pid != getpid()) {
+            vjl_ring_init();
+            g_vjl_fd = -1;
+        }
+        g_vjl_pid = getpid();
+        if (pthread_create(&tid, NULL, vjl_drainer_main, NULL) == 0) {
+            pthread_detach(tid);
+            g_vjl_started = 1;
+        }
+    }
+    pthread_mutex_unlock(&g_vjl_lock);
+}
+
+/* ----- Submit side ----- */
+
+/* Claim a cell; NULL when the ring is full */
+static struct vjl_rec *vjl_claim(uint32_t *out_pos)
+{
+    uint32_t pos = __atomic_load_n(&g_vjl_enq, __ATOMIC_RELAXED);
+
+    for (;;) {
+        struct vjl_rec *rec = &g_vjl_ring[pos & (VJL_RING_SIZE - 1)];
+        uint32_t seq = __atomic_load_n(&rec->seq, __ATOMIC_ACQUIRE);
+        int32_t dif = (int32_t)(seq - pos);
+
+        if (dif == 0) {
+            if (__atomic_compare_exchange_n(&g_vjl_enq, &pos, pos + 1,
+                                            1, __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED)) {
+                *out_pos = pos;
+                return rec;
+            }
+        } else if (dif < 0) {
+            return NULL;        /* Full: a whole lap behind */
+        } else {
+            pos = __atomic_load_n(&g_vjl_enq, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/* Pack one argument list against fmt; returns 0 or -1 on overflow /
+ * unsupported directive (caller falls back to preformatting) */
+static int vjl_pack(struct vjl_rec *rec, const char *fmt, va_list ap)
+{
+    const char *f;
+    int arg = 0;
+
+    rec->str_used = 0;
+    for (f = fmt; *f; f++) {
+        int is_long = 0, is_ll = 0;
+
+        if (*f != '%')
+            continue;
+        f++;
+        if (*f == '%')
+            continue;
+        while (*f && strchr("-+ #0123456789.", *f)) {
+            if (*f == '*')
+                return -1;      /* Dynamic width: rare, preformat */
+            f++;
+        }
+        while (*f && strchr("hljzt", *f)) {
+            if (*f == 'l')
+                is_long++;
+            if (*f == 'j' || *f == 'z' || *f == 't')
+                is_ll = 1;
+            f++;
+        }
+        if (arg >= VJL_MAX_ARGS)
+            return -1;
+
+        switch (*f) {
+        case 'd': case 'i':
+            rec->tags[arg] = VJL_ARG_INT;
+            if (is_ll || is_long >= 2)
+                rec->vals[arg] = (uint64_t)va_arg(ap, long long);
+            else if (is_long)
+                rec->vals[arg] = (uint64_t)(int64_t)va_arg(ap, long);
+            else
+                rec->vals[arg] = (uint64_t)(int64_t)va_arg(ap, int);
+            break;
+        case 'u': case 'x': case 'X': case 'o':
+            rec->tags[arg] = VJL_ARG_UINT;
+            if (is_ll || is_long >= 2)
+                rec->vals[arg] = va_arg(ap, unsigned long long);
+            else if (is_long)
+                rec->vals[arg] = va_arg(ap, unsigned long);
+            else
+                rec->vals[arg] = va_arg(ap, unsigned int);
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': {
+            double d = va_arg(ap, double);
+
+            rec->tags[arg] = VJL_ARG_DBL;
+            memcpy(&rec->vals[arg], &d, sizeof(d));
+            break;
+        }
+        case 'c':
+            rec->tags[arg] = VJL_ARG_UINT;
+            rec->vals[arg] = (uint64_t)(unsigned char)va_arg(ap, int);
+            break;
+        case 'p':
+            rec->tags[arg] = VJL_ARG_UINT;
+            rec->vals[arg] = (uint64_t)(uintptr_t)va_arg(ap, void *);
+            break;
+        case 's': {
+            const char *s = va_arg(ap, const char *);
+            size_t slen;
+
+            if (!s)
+                s = "(null)";
+            slen = strlen(s) + 1;
+            if (rec->str_used + slen > VJL_STRBUF_SIZE)
+                return -1;      /* Copy budget blown: preformat */
+            memcpy(rec->strbuf + rec->str_used, s, slen);
+            rec->tags[arg] = VJL_ARG_STR;
+            rec->vals[arg] = rec->str_used;
+            rec->str_used = (uint16_t)(rec->str_used + slen);
+            break;
+        }
+        default:
+            return -1;          /* %n and friends: preformat */
+        }
+        arg++;
+    }
+    rec->nargs = (uint8_t)arg;
+    return 0;
+}
+
+int sd_journal_printv(int priority, const char *format, va_list ap)
+{
+    struct vjl_rec *rec;
+    uint32_t pos;
+    va_list aq;
+
+    struct vjl_src *src;
+    int64_t pending;
+
+    if (!format)
+        return -EINVAL;
+    vjl_ensure_drainer();
+
+    src = vjl_src_slot(format);
+    if (src) {
+        pending = vjl_rl_take(src);
+        if (pending < 0)
+            return -EAGAIN;     /* Suppressed; counted for later */
+        if (pending > 0 &&
+            sd_journal_print(LOG_NOTICE, VJL_FMT_SUPPRESSED,
+                             (unsigned long long)pending) < 0)
+            /* Notice didn't make it; put the count back */
+            __atomic_fetch_add(&src->suppressed, (uint64_t)pending,
+                               __ATOMIC_RELAXED);
+    }
+
+    rec = vjl_claim(&pos);
+    if (!rec) {
+        __atomic_fetch_add(&g_vjl_dropped, 1, __ATOMIC_RELAXED);
+        return -ENOMEM;
+    }
+
+    rec->priority = (uint8_t)(priority & LOG_PRIMASK);
+    rec->ts_ns = vjl_now_ns();
+    rec->fmt = format;
+
+    va_copy(aq, ap);
+    if (vjl_pack(rec, format, aq) < 0) {
+        /* Unsupported directive or oversized strings: expand now,
+         * persist later -- the slow path is still asynchronous I/O */
+        vsnprintf(rec->strbuf, sizeof(rec->strbuf), format, ap);
+        rec->tags[0] = VJL_ARG_PREFORMATTED;
+        rec->nargs = 1;
+    }
+    va_end(aq);
+
+    /* Publish the cell */
+    __atomic_store_n(&rec->seq, pos + 1, __ATOMIC_RELEASE);
+    __atomic_fetch_add(&g_vjl_enqueued, 1, __ATOMIC_RELAXED);
+    pthread_cond_signal(&g_vjl_cond);
+    return 0;
+}
+
+int sd_journal_print(int priority, const char *format, ...)
+{
+    va_list ap;
+    int r;
+
+    va_start(ap, format);
+    r = sd_journal_printv(priority, format, ap);
+    va_end(ap);
+    return r;
+}
+
+/* Advance ap past the arguments one format string consumes.  vsnprintf
+ * gets a va_copy, so the caller's list must be stepped explicitly --
+ * consumption through the copy is not visible on ABIs where va_list
+ * is passed by value (RISC-V). */
+static void vjl_va_skip(const char *fmt, va_list *ap)
+{
+    const char *f;
+
+    for (f = fmt; *f; f++) {
+        int is_long = 0, is_ll = 0;
+
+        if (*f != '%')
+            continue;
+        f++;
+        if (*f == '%')
+            continue;
+        while (*f && strchr("-+ #0123456789.", *f)) {
+            if (*f == '*')
+                (void)va_arg(*ap, int);
+            f++;
+        }
+        while (*f && strchr("hljzt", *f)) {
+            if (*f == 'l')
+                is_long++;
+            if (*f == 'j' || *f == 'z' || *f == 't')
+                is_ll = 1;
+            f++;
+        }
+        switch (*f) {
+        case 'd': case 'i': case 'u': case 'x': case 'X': case 'o':
+        case 'c':
+            if (is_ll || is_long >= 2)
+                (void)va_arg(*ap, long long);
+            else if (is_long)
+                (void)va_arg(*ap, long);
+            else
+                (void)va_arg(*ap, int);
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+            (void)va_arg(*ap, double);
+            break;
+        case 's': case 'p': case 'n':
+            (void)va_arg(*ap, void *);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+int sd_journal_send(const char *format, ...)
+{
+    char msg[VJL_STRBUF_SIZE];
+    size_t used = 0;
+    int priority = LOG_INFO;
+    va_list ap;
+    const char *field;
+
+    if (!format)
+        return -EINVAL;
+
+    /* Field lists are cold (journald metadata, not per-frame logs):
+     * expand each "FIELD=fmt" pair here and join them into one
+     * record; persistence stays on the drainer */
+    va_start(ap, format);
+    for (field = format; field; field = va_arg(ap, const char *)) {
+        char one[VJL_STRBUF_SIZE];
+        va_list aq;
+        int n;
+
+        va_copy(aq, ap);
+        n = vsnprintf(one, sizeof(one), field, aq);
+        va_end(aq);
+        vjl_va_skip(field, &ap);
+
+        if (n < 0)
+            continue;
+        if (strncmp(one, "PRIORITY=", 9) == 0) {
+            priority = atoi(one + 9);
+            continue;
+        }
+        if (used > 0 && used + 2 < sizeof(msg)) {
+            msg[used++] = ',';
+            msg[used++] = ' ';
+        }
+        used += (size_t)snprintf(msg + used, sizeof(msg) - used, "%s",
+                                 strncmp(one, "MESSAGE=", 8) == 0
+                                     ? one + 8 : one);
+        if (used >= sizeof(msg) - 1)
+            break;
+    }
+    va_end(ap);
+
+    return sd_journal_print(priority, "%s", msg);
+}
+
+void sd_journal_veridian_flush(void)
+{
+    pthread_mutex_lock(&g_vjl_lock);
+    if (!g_vjl_started || g_vjl_pid != getpid()) {
+        pthread_mutex_unlock(&g_vjl_lock);
+        vjl_drain();            /* No drainer: flush inline */
+        return;
+    }
+    pthread_cond_signal(&g_vjl_cond);
+    while (g_vjl_draining ||
+           __atomic_load_n(&g_vjl_enq, __ATOMIC_RELAXED) != g_vjl_deq) {
+        pthread_cond_signal(&g_vjl_cond);
+        pthread_mutex_unlock(&g_vjl_lock);
+        usleep(1000);
+        pthread_mutex_lock(&g_vjl_lock);
+    }
+    pthread_mutex_unlock(&g_vjl_lock);
+}
+
+void sd_journal_veridian_stats(uint64_t *enqueued, uint64_t *dropped)
+{
+    if (enqueued)
+        *enqueued = __atomic_load_n(&g_vjl_enqueued, __ATOMIC_RELAXED);
+    if (dropped)
+        *dropped = __atomic_load_n(&g_vjl_dropped, __ATOMIC_RELAXED);
+}
+
+void sd_journal_veridian_limit_stats(uint64_t *suppressed,
+                                     uint64_t *collapsed)
+{
+    if (suppressed)
+        *suppressed = __atomic_load_n(&g_vjl_suppressed,
+                                      __ATOMIC_RELAXED);
+    if (collapsed)
+        *collapsed = g_vjl_collapsed;
+}
@@ -4,60 +4,309 @@
  * Copyright (c) 2025-2026 VeridianOS Contributors
  * SPDX-License-Identifier: MIT OR Apache-2.0
  *
- * select() implementation built on top of the kernel's poll() syscall.
+ * select()/poll() as thin adapters over the epoll backend.
+ *
+ * Both calls funnel into one core that keeps a small pool of cached
+ * epoll instances, each remembering the exact (fd, events) set it
+ * has registered.  Event-loop callers pass the same stable set every
+ * iteration -- Qt and PipeWire never change theirs between calls --
+ * so after the first call the per-iteration cost is a single
+ * epoll_pwait2, no re-registration and no O(nfds) kernel scan.
+ * Timeouts carry nanosecond resolution end to end (select's timeval
+ * microseconds and ppoll/pselect timespecs are not rounded to
+ * milliseconds).  Sets that epoll can't express (more than
+ * VSEL_MAX_FDS descriptors, or fd types the backend rejects) fall
+ * back to the raw kernel poll.
  */
 
 #include <sys/select.h>
+#include <sys/epoll.h>
 #include <poll.h>
 #include <errno.h>
 #include <string.h>
+#include <time.h>
+#include <unistd.h>
 
-int select(int nfds, fd_set *readfds, fd_set *writefds,
-           fd_set *exceptfds, struct timeval *timeout)
+extern int __veridian_poll_raw(struct pollfd *fds, unsigned long nfds,
+                               int timeout);
+
+/* Bumped by close()/dup2() in syscall.c: any close may have dropped
+ * a cached registration kernel-side */
+extern uint32_t __vsel_close_gen;
+
+/* ========================================================================= */
+/* Cached epoll instances                                                    */
+/* ========================================================================= */
+
+#define VSEL_INSTANCES 4        /* Concurrent event-loop threads   */
+#define VSEL_MAX_FDS   64       /* Beyond this: raw poll           */
+
+struct vsel_instance {
+    int   lock;                 /* Spinlock (test-and-set)         */
+    int   inited;               /* epfd created (zero-init safe)   */
+    int   epfd;
+    int   stale;                /* Force re-registration next call */
+    uint32_t close_gen;         /* __vsel_close_gen at last sync   */
+    int   count;                /* Registered fds                  */
+    int   fds[VSEL_MAX_FDS];
+    short events[VSEL_MAX_FDS];
+};
+
+static struct vsel_instance g_vsel[VSEL_INSTANCES];
+
+static struct vsel_instance *vsel_acquire(void)
 {
-    if (nfds < 0 || nfds > FD_SETSIZE) {
-        errno = EINVAL;
+    for (int i = 0; i < VSEL_INSTANCES; i++) {
+        struct vsel_instance *in = &g_vsel[i];
+
+        if (!__atomic_test_and_set(&in->lock, __ATOMIC_ACQUIRE))
+            return in;
+    }
+    return (struct vsel_instance *)0;   /* All busy: raw poll */
+}
+
+static void vsel_release(struct vsel_instance *in)
+{
+    __atomic_clear(&in->lock, __ATOMIC_RELEASE);
+}
+
+static unsigned int vsel_epoll_events(short events)
+{
+    unsigned int ev = 0;
+
+    if (events & POLLIN)
+        ev |= EPOLLIN;
+    if (events & POLLOUT)
+        ev |= EPOLLOUT;
+    if (events & POLLERR)
+        ev |= EPOLLERR;
+    return ev;
+}
+
+static short vsel_poll_revents(unsigned int ev)
+{
+    short r = 0;
+
+    if (ev & EPOLLIN)
+        r |= POLLIN;
+    if (ev & EPOLLOUT)
+        r |= POLLOUT;
+    if (ev & EPOLLERR)
+        r |= POLLERR;
+    if (ev & EPOLLHUP)
+        r |= POLLHUP;
+    return r;
+}
+
+/*
+ * Bring the instance's registration in line with fds[].  Stable sets
+ * -- the common case -- match the cached arrays and return without a
+ * single epoll_ctl.  Returns 0, or -1 when a descriptor can't live
+ * in the backend (caller reverts to raw poll).
+ */
+static int vsel_sync(struct vsel_instance *in, const struct pollfd *fds,
+                     int nfds)
+{
+    int i;
+
+    if (!in->inited) {
+        in->epfd = epoll_create1(0);
+        if (in->epfd < 0)
+            return -1;
+        in->inited = 1;
+        in->count = 0;
+    }
+
+    /*
+     * Any close() since the last sync may have silently dropped one
+     * of our registrations kernel-side; with an infinite timeout the
+     * old after-timeout recovery never runs, so the generation check
+     * is what keeps blocking waits honest.  Re-registering on a
+     * generation mismatch costs one ctl pass after any close in the
+     * process -- closes are rare next to waits.
+     */
+    {
+        uint32_t gen =
+            __atomic_load_n(&__vsel_close_gen, __ATOMIC_RELAXED);
+
+        if (gen != in->close_gen) {
+            in->close_gen = gen;
+            in->stale = 1;
+        }
+    }
+
+    /* Fast path: identical set, identical order */
+    if (!in->stale && in->count == nfds) {
+        for (i = 0; i < nfds; i++)
+            if (in->fds[i] != fds[i].fd ||
+                in->events[i] != fds[i].events)
+                break;
+        if (i == nfds)
+            return 0;
+    }
+
+    /* Re-register: drop everything, add the new set.  One-time cost
+     * when a loop's set actually changes. */
+    for (i = 0; i < in->count; i++)
+        epoll_ctl(in->epfd, EPOLL_CTL_DEL, in->fds[i],
+                  (struct epoll_event *)0);
+    in->count = 0;
+
+    for (i = 0; i < nfds; i++) {
+        struct epoll_event ev;
+
+        ev.events = vsel_epoll_events(fds[i].events);
+        ev.data.fd = fds[i].fd;
+        if (epoll_ctl(in->epfd, EPOLL_CTL_ADD, fds[i].fd, &ev) < 0) {
+            /* Unsupported fd type (or bad fd): unwind, raw poll */
+            while (i-- > 0)
+                epoll_ctl(in->epfd, EPOLL_CTL_DEL, fds[i].fd,
+                          (struct epoll_event *)0);
+            return -1;
+        }
+        in->fds[i] = fds[i].fd;
+        in->events[i] = fds[i].events;
+    }
+    in->count = nfds;
+    in->stale = 0;
+    return 0;
+}
+
+/* Milliseconds (rounded up) for the raw-poll fallback */
+static int vsel_timeout_ms(const struct timespec *ts)
+{
+    long long total;
+
+    if (!ts)
         return -1;
+    total = (long long)ts->tv_sec * 1000 + (ts->tv_nsec + 999999) / 1000000;
+    return total > 0x7fffffff ? 0x7fffffff : (int)total;
+}
+
+/*
+ * Common core: poll semantics with a timespec timeout.
+ */
+static int vsel_poll_ts(struct pollfd *fds, nfds_t nfds,
+                        const struct timespec *ts)
+{
+    struct vsel_instance *in;
+    struct epoll_event evs[VSEL_MAX_FDS];
+    int nev, ready;
+    nfds_t i;
+
+    if (nfds > VSEL_MAX_FDS)
+        return __veridian_poll_raw(fds, nfds, vsel_timeout_ms(ts));
+
+    for (i = 0; i < nfds; i++)
+        fds[i].revents = 0;
+
+    in = vsel_acquire();
+    if (!in)
+        return __veridian_poll_raw(fds, nfds, vsel_timeout_ms(ts));
+
+    if (vsel_sync(in, fds, (int)nfds) < 0) {
+        vsel_release(in);
+        return __veridian_poll_raw(fds, nfds, vsel_timeout_ms(ts));
     }
 
-    /* Convert timeout to milliseconds for poll(). */
-    int timeout_ms = -1;  /* Infinite by default */
-    if (timeout) {
-        timeout_ms = (int)(timeout->tv_sec * 1000 +
-                           timeout->tv_usec / 1000);
-        if (timeout_ms < 0)
-            timeout_ms = 0;
+    if (nfds == 0) {
+        /* Pure sleep with ns resolution */
+        struct epoll_event dummy;
+
+        nev = epoll_pwait2(in->epfd, &dummy, 1, ts, (const void *)0);
+        vsel_release(in);
+        return nev < 0 ? -1 : 0;
     }
 
-    /* Count how many fds are set across all three sets. */
-    int nset = 0;
-    for (int fd = 0; fd < nfds; fd++) {
-        int want = 0;
-        if (readfds  && FD_ISSET(fd, readfds))  want = 1;
-        if (writefds && FD_ISSET(fd, writefds)) want = 1;
-        if (exceptfds && FD_ISSET(fd, exceptfds)) want = 1;
-        if (want) nset++;
+    nev = epoll_pwait2(in->epfd, evs, (int)nfds, ts, (const void *)0);
+    if (nev < 0) {
+        vsel_release(in);
+        return -1;
     }
 
-    if (nset == 0) {
-        /* No fds to watch — just sleep for timeout. */
-        if (timeout_ms > 0) {
-            /* Use poll with 0 fds for the sleep. */
-            poll(NULL, 0, timeout_ms);
+    /*
+     * A closed descriptor silently drops out of the kernel's
+     * interest set while staying in our cache; the symptom is a
+     * timeout that should have been a wakeup on a reused fd number.
+     * Re-register after any timeout so staleness never outlives one
+     * quiet period.
+     */
+    if (nev == 0)
+        in->stale = 1;
+
+    ready = 0;
+    for (int e = 0; e < nev; e++) {
+        for (i = 0; i < nfds; i++) {
+            if (fds[i].fd == evs[e].data.fd) {
+                short r = vsel_poll_revents(evs[e].events);
+
+                /* Only report what was asked for, plus ERR/HUP */
+                fds[i].revents = (short)(r & (fds[i].events |
+                                              POLLERR | POLLHUP));
+                if (fds[i].revents)
+                    ready++;
+                break;
+            }
         }
-        return 0;
     }
+    vsel_release(in);
+    return ready;
+}
+
+/* ========================================================================= */
+/* Public API                                                                */
+/* ========================================================================= */
+
+int poll(struct pollfd *fds, nfds_t nfds, int timeout)
+{
+    struct timespec ts;
+    const struct timespec *tsp = (const struct timespec *)0;
+
+    if (timeout >= 0) {
+        ts.tv_sec = timeout / 1000;
+        ts.tv_nsec = (long)(timeout % 1000) * 1000000L;
+        tsp = &ts;
+    }
+    return vsel_poll_ts(fds, nfds, tsp);
+}
+
+int ppoll(struct pollfd *fds, nfds_t nfds,
+          const struct timespec *timeout, const void *sigmask)
+{
+    (void)sigmask;      /* Signal mask handling not implemented yet */
+    return vsel_poll_ts(fds, nfds, timeout);
+}
 
-    /* Build pollfd array on the stack (nfds <= FD_SETSIZE = 1024). */
+int select(int nfds, fd_set *readfds, fd_set *writefds,
+           fd_set *exceptfds, struct timeval *timeout)
+{
     struct pollfd pfds[FD_SETSIZE];
+    struct timespec ts;
+    const struct timespec *tsp = (const struct timespec *)0;
     int pfd_count = 0;
+    int ret, ready;
+
+    if (nfds < 0 || nfds > FD_SETSIZE) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    if (timeout) {
+        /* Microsecond resolution preserved */
+        ts.tv_sec = timeout->tv_sec;
+        ts.tv_nsec = timeout->tv_usec * 1000L;
+        tsp = &ts;
+    }
 
     for (int fd = 0; fd < nfds; fd++) {
         short events = 0;
-        if (readfds  && FD_ISSET(fd, readfds))   events |= POLLIN;
-        if (writefds && FD_ISSET(fd, writefds))  events |= POLLOUT;
-        if (exceptfds && FD_ISSET(fd, exceptfds)) events |= POLLERR;
 
+        if (readfds && FD_ISSET(fd, readfds))
+            events |= POLLIN;
+        if (writefds && FD_ISSET(fd, writefds))
+            events |= POLLOUT;
+        if (exceptfds && FD_ISSET(fd, exceptfds))
+            events |= POLLERR;
         if (events) {
             pfds[pfd_count].fd = fd;
             pfds[pfd_count].events = events;
@@ -66,16 +315,18 @@ int select(int nfds, fd_set *readfds, fd_set *writefds,
         }
     }
 
-    int ret = poll(pfds, (unsigned long)pfd_count, timeout_ms);
+    ret = vsel_poll_ts(pfds, (nfds_t)pfd_count, tsp);
     if (ret < 0)
         return -1;
 
-    /* Clear all fd_sets and re-populate based on poll results. */
-    if (readfds)  FD_ZERO(readfds);
-    if (writefds) FD_ZERO(writefds);
-    if (exceptfds) FD_ZERO(exceptfds);
+    if (readfds)
+        FD_ZERO(readfds);
+    if (writefds)
+        FD_ZERO(writefds);
+    if (exceptfds)
+        FD_ZERO(exceptfds);
 
-    int ready = 0;
+    ready = 0;
     for (int i = 0; i < pfd_count; i++) {
         int fd = pfds[i].fd;
         int got = 0;
@@ -92,9 +343,9 @@ int select(int nfds, fd_set *readfds, fd_set *writefds,
             FD_SET(fd, exceptfds);
             got = 1;
         }
-        if (got) ready++;
+        if (got)
+            ready++;
     }
-
     return ready;
 }
 
@@ -102,16 +353,15 @@ int pselect(int nfds, fd_set *readfds, fd_set *writefds,
             fd_set *exceptfds, const struct timespec *timeout,
             const sigset_t *sigmask)
 {
-    (void)sigmask;  /* Signal mask handling not implemented yet */
-
     struct timeval tv;
-    struct timeval *tvp = NULL;
+    struct timeval *tvp = (struct timeval *)0;
+
+    (void)sigmask;  /* Signal mask handling not implemented yet */
 
     if (timeout) {
-        tv.tv_sec  = timeout->tv_sec;
+        tv.tv_sec = timeout->tv_sec;
         tv.tv_usec = timeout->tv_nsec / 1000;
         tvp = &tv;
     }
-
     return select(nfds, readfds, writefds, exceptfds, tvp);
 }
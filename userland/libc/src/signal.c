@@ -4,7 +4,15 @@
  * Copyright (c) 2025-2026 VeridianOS Contributors
  * SPDX-License-Identifier: MIT OR Apache-2.0
  *
- * Signal handling wrappers.
+ * Signal handling: cached handler table, O(1) pending delivery, and
+ * the userland dispatch trampoline.
+ *
+ * The kernel's sigaction state is mirrored in a fixed per-process
+ * table published with atomic stores, so handler lookups on the
+ * delivery path never take a lock or a syscall.  Locally raised
+ * signals (raise, and signals deferred while blocked) are tracked in
+ * a pending bitmap and dispatched with ctz scans; delivering a caught
+ * signal via raise() costs no kernel round-trip at all.
  */
 
 #include <signal.h>
@@ -13,6 +21,100 @@
 #include <errno.h>
 #include <string.h>
 
+/* ========================================================================= */
+/* Cached handler table                                                      */
+/* ========================================================================= */
+
+/*
+ * One slot per signal.  The handler word is the published field:
+ * writers fill flags/mask first and release-store the pointer last,
+ * so the dispatch path always reads a consistent slot without a lock.
+ * sa_handler and sa_sigaction share a union in struct sigaction, so
+ * one word covers both forms; flags say how to call it.
+ */
+struct sig_slot {
+    sighandler_t    handler;                /* Published atomically  */
+    unsigned long   flags;
+    sigset_t        mask;
+};
+
+static struct sig_slot g_sig_table[_NSIG];
+
+/* Locally pending signals and the mirrored block mask */
+static unsigned long g_sig_pending;
+static sigset_t      g_sig_blocked;
+
+/* ========================================================================= */
+/* Dispatch                                                                  */
+/* ========================================================================= */
+
+/* Run one signal's handler from the cached table.  Returns 0 when the
+ * signal was consumed (handler ran or SIG_IGN), -1 for default
+ * dispositions, which stay kernel business. */
+static int sig_dispatch_one(int sig)
+{
+    struct sig_slot *slot = &g_sig_table[sig];
+    sighandler_t h = __atomic_load_n(&slot->handler, __ATOMIC_ACQUIRE);
+
+    if (h == SIG_IGN)
+        return 0;
+    if (h == SIG_DFL || h == NULL)
+        return -1;
+
+    if (slot->flags & SA_SIGINFO) {
+        /* sa_handler/sa_sigaction share a union in struct sigaction;
+         * read the word back through the same union shape */
+        union {
+            sighandler_t h;
+            void (*sh)(int, siginfo_t *, void *);
+        } u;
+        siginfo_t info;
+
+        u.h = h;
+        memset(&info, 0, sizeof(info));
+        info.si_signo = sig;
+        u.sh(sig, &info, NULL);
+    } else {
+        h(sig);
+    }
+    return 0;
+}
+
+/*
+ * Userland dispatch trampoline.
+ *
+ * The single entry deliveries funnel through: it merges the kernel's
+ * pending word into the local bitmap, then drains deliverable signals
+ * with ctz scans, invoking handlers straight from the cached table.
+ * The common return path is a plain function return -- SYS_SIGRETURN
+ * is issued only when the kernel handed over an interrupted context
+ * to restore.
+ */
+void __veridian_signal_trampoline(unsigned long kernel_pending,
+                                  void *ctx)
+{
+    if (kernel_pending)
+        __atomic_fetch_or(&g_sig_pending, kernel_pending,
+                          __ATOMIC_RELEASE);
+
+    for (;;) {
+        unsigned long deliverable =
+            __atomic_load_n(&g_sig_pending, __ATOMIC_ACQUIRE) &
+            ~g_sig_blocked;
+        int sig;
+
+        if (deliverable == 0)
+            break;
+        sig = __builtin_ctzl(deliverable);
+        __atomic_fetch_and(&g_sig_pending, ~(1UL << sig),
+                           __ATOMIC_ACQ_REL);
+        sig_dispatch_one(sig);
+    }
+
+    if (ctx)
+        veridian_syscall1(SYS_SIGRETURN, ctx);
+}
+
 /* ========================================================================= */
 /* sigaction                                                                 */
 /* ========================================================================= */
@@ -20,11 +122,37 @@
 int sigaction(int signum, const struct sigaction *act,
               struct sigaction *oldact)
 {
-    long ret = veridian_syscall3(SYS_SIGACTION, signum, act, oldact);
-    if (ret < 0) {
-        errno = (int)(-ret);
+    struct sig_slot *slot;
+
+    if (signum < 1 || signum >= _NSIG) {
+        errno = EINVAL;
         return -1;
     }
+    slot = &g_sig_table[signum];
+
+    /* Reads come from the cache: no lock, no syscall */
+    if (oldact) {
+        memset(oldact, 0, sizeof(*oldact));
+        oldact->sa_handler =
+            __atomic_load_n(&slot->handler, __ATOMIC_ACQUIRE);
+        oldact->sa_flags = (int)slot->flags;
+        oldact->sa_mask = slot->mask;
+    }
+
+    if (act) {
+        long ret = veridian_syscall3(SYS_SIGACTION, signum, act, NULL);
+
+        if (ret < 0) {
+            errno = (int)(-ret);
+            return -1;
+        }
+
+        /* Publish: auxiliary fields first, the handler word last */
+        slot->flags = (unsigned long)act->sa_flags;
+        slot->mask = act->sa_mask;
+        __atomic_store_n(&slot->handler, act->sa_handler,
+                         __ATOMIC_RELEASE);
+    }
     return 0;
 }
 
@@ -35,10 +163,34 @@ int sigaction(int signum, const struct sigaction *act,
 int sigprocmask(int how, const sigset_t *set, sigset_t *oldset)
 {
     long ret = veridian_syscall3(SYS_SIGPROCMASK, how, set, oldset);
+
     if (ret < 0) {
         errno = (int)(-ret);
         return -1;
     }
+
+    /* Mirror the mask and redeliver anything SIG_UNBLOCK exposed */
+    if (set) {
+        sigset_t old = g_sig_blocked;
+
+        switch (how) {
+        case SIG_BLOCK:
+            g_sig_blocked = old | *set;
+            break;
+        case SIG_UNBLOCK:
+            g_sig_blocked = old & ~*set;
+            break;
+        case SIG_SETMASK:
+            g_sig_blocked = *set;
+            break;
+        default:
+            break;
+        }
+
+        if (__atomic_load_n(&g_sig_pending, __ATOMIC_ACQUIRE) &
+            ~g_sig_blocked)
+            __veridian_signal_trampoline(0, NULL);
+    }
     return 0;
 }
 
@@ -77,5 +229,32 @@ sighandler_t signal(int signum, sighandler_t handler)
 
 int raise(int sig)
 {
+    if (sig < 1 || sig >= _NSIG) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    /*
+     * Fast path: a caught signal raised at ourselves runs its handler
+     * synchronously from the cached table -- no kill syscall, no
+     * kernel delivery latency (this is the PipeWire timer pattern).
+     * Blocked signals park in the pending bitmap and fire on unblock;
+     * default dispositions still go through the kernel.
+     */
+    {
+        sighandler_t h = __atomic_load_n(&g_sig_table[sig].handler,
+                                         __ATOMIC_ACQUIRE);
+
+        if (h == SIG_IGN)
+            return 0;
+        if (h != SIG_DFL && h != NULL) {
+            __atomic_fetch_or(&g_sig_pending, 1UL << sig,
+                              __ATOMIC_RELEASE);
+            if (!(g_sig_blocked & (1UL << sig)))
+                __veridian_signal_trampoline(0, NULL);
+            return 0;
+        }
+    }
+
     return kill(getpid(), sig);
 }
@@ -7,10 +7,17 @@
  * Minimal buffered I/O implementation.  All formatted output routes
  * through vsnprintf() which does the actual formatting into a stack
  * buffer, then write() pushes it to the fd.
+ *
+ * Write buffering: streams that turn out not to be terminals are
+ * promoted from line- to full buffering, line-buffered flushes stop
+ * at the last newline (the partial line stays buffered), and writes
+ * too large for the buffer go out as one writev() of the pending
+ * buffer plus the caller's data -- no double copy, one syscall.
  */
 
 #include <stdio.h>
 #include <string.h>
+#include <sys/uio.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <fcntl.h>
@@ -58,12 +65,61 @@ static int __flush_write(FILE *stream)
     return 0;
 }
 
+/*
+ * Flush only the first n buffered bytes (through the last newline for
+ * line-buffered streams); the tail slides down and stays buffered.
+ */
+static int __flush_write_n(FILE *stream, size_t n)
+{
+    if (n == 0)
+        return 0;
+    if (n >= stream->buf_pos)
+        return __flush_write(stream);
+
+    size_t written = 0;
+    while (written < n) {
+        ssize_t r = write(stream->fd, stream->buf + written, n - written);
+        if (r < 0) {
+            stream->flags |= __FILE_ERROR;
+            return EOF;
+        }
+        written += (size_t)r;
+    }
+
+    memmove(stream->buf, stream->buf + n, stream->buf_pos - n);
+    stream->buf_pos -= n;
+    return 0;
+}
+
+/*
+ * Flush a line-buffered stream through its last buffered newline; a
+ * trailing partial line keeps accumulating so consecutive small
+ * writes coalesce into one syscall per flush, not one per line.
+ */
+static int __flush_lines(FILE *stream)
+{
+    size_t i = stream->buf_pos;
+
+    while (i > 0) {
+        if (stream->buf[i - 1] == '\n')
+            return __flush_write_n(stream, i);
+        i--;
+    }
+    return 0;
+}
+
 /*
  * Ensure the stream has an allocated buffer.
  */
 static void __ensure_buf(FILE *stream)
 {
     if (stream->buf == NULL && stream->buf_mode != _IONBF) {
+        /* Line buffering only pays on a terminal; a stream feeding a
+         * pipe or file is promoted to full buffering so shell
+         * pipelines don't pay one syscall per line. */
+        if (stream->buf_mode == _IOLBF && !isatty(stream->fd))
+            stream->buf_mode = _IOFBF;
+
         stream->buf = (unsigned char *)malloc(BUFSIZ);
         if (stream->buf) {
             stream->buf_size = BUFSIZ;
@@ -298,18 +354,67 @@ int puts(const char *s)
 size_t fread(void *ptr, size_t size, size_t count, FILE *stream)
 {
     size_t total = size * count;
+    unsigned char *p = (unsigned char *)ptr;
+    size_t done = 0;
+
     if (total == 0)
         return 0;
+    if (!stream || !(stream->flags & __FILE_READ))
+        return 0;
+    if (stream->flags & __FILE_EOF)
+        return 0;
 
-    unsigned char *p = (unsigned char *)ptr;
-    size_t done = 0;
+    __ensure_buf(stream);
 
+    /* Drain whatever the buffer already holds */
+    if (stream->buf && stream->buf_pos < stream->buf_len) {
+        size_t have = stream->buf_len - stream->buf_pos;
+        size_t take = have < total ? have : total;
+
+        memcpy(p, stream->buf + stream->buf_pos, take);
+        stream->buf_pos += take;
+        done += take;
+    }
+
+    /*
+     * Remainder: one scatter read fills the caller's buffer directly
+     * and lands the readahead in the stream buffer in the same
+     * syscall -- no staging copy for the bulk, no extra syscall for
+     * the tail the next fgetc will want.
+     */
     while (done < total) {
-        int c = fgetc(stream);
-        if (c == EOF)
-            break;
-        *p++ = (unsigned char)c;
-        done++;
+        if (stream->buf_mode != _IONBF && stream->buf) {
+            struct iovec iov[2];
+            ssize_t r;
+
+            iov[0].iov_base = p + done;
+            iov[0].iov_len = total - done;
+            iov[1].iov_base = stream->buf;
+            iov[1].iov_len = stream->buf_size;
+
+            r = readv(stream->fd, iov, 2);
+            if (r <= 0) {
+                stream->flags |= (r == 0) ? __FILE_EOF : __FILE_ERROR;
+                break;
+            }
+            if ((size_t)r <= total - done) {
+                done += (size_t)r;
+                stream->buf_pos = 0;
+                stream->buf_len = 0;
+            } else {
+                stream->buf_len = (size_t)r - (total - done);
+                stream->buf_pos = 0;
+                done = total;
+            }
+        } else {
+            ssize_t r = read(stream->fd, p + done, total - done);
+
+            if (r <= 0) {
+                stream->flags |= (r == 0) ? __FILE_EOF : __FILE_ERROR;
+                break;
+            }
+            done += (size_t)r;
+        }
     }
 
     return done / size;
@@ -355,6 +460,54 @@ size_t fwrite(const void *ptr, size_t size, size_t count, FILE *stream)
         return done / size;
     }
 
+    /*
+     * Large write: staging it through the buffer would just add a
+     * memcpy and extra flushes.  Submit the pending buffer and the
+     * caller's data together as one vectored write.
+     */
+    if (total >= stream->buf_size) {
+        struct iovec iov[2];
+        int iovcnt = 0;
+        size_t pending = stream->buf_pos;
+
+        if (pending > 0) {
+            iov[iovcnt].iov_base = stream->buf;
+            iov[iovcnt].iov_len = pending;
+            iovcnt++;
+        }
+        iov[iovcnt].iov_base = (void *)p;
+        iov[iovcnt].iov_len = total;
+        iovcnt++;
+
+        ssize_t w = writev(stream->fd, iov, iovcnt);
+        if (w < 0) {
+            stream->flags |= __FILE_ERROR;
+            return 0;
+        }
+
+        /* Account the buffered part first, then the payload */
+        if ((size_t)w >= pending) {
+            stream->buf_pos = 0;
+            done = (size_t)w - pending;
+        } else {
+            /* Short write inside the pending buffer: slide it */
+            memmove(stream->buf, stream->buf + w, pending - (size_t)w);
+            stream->buf_pos = pending - (size_t)w;
+            done = 0;
+        }
+
+        /* Push any remainder of the payload with plain writes */
+        while (done < total) {
+            ssize_t r = write(stream->fd, p + done, total - done);
+            if (r <= 0) {
+                stream->flags |= __FILE_ERROR;
+                break;
+            }
+            done += (size_t)r;
+        }
+        return done / size;
+    }
+
     /* Write data to buffer, flushing as needed. */
     while (done < total) {
         size_t avail = stream->buf_size - stream->buf_pos;
@@ -373,15 +526,10 @@ size_t fwrite(const void *ptr, size_t size, size_t count, FILE *stream)
         }
     }
 
-    /* For line-buffered streams, flush if we wrote a newline. */
-    if (stream->buf_mode == _IOLBF && done > 0) {
-        for (size_t i = 0; i < done; i++) {
-            if (p[i] == '\n') {
-                __flush_write(stream);
-                break;
-            }
-        }
-    }
+    /* Line-buffered: flush the completed lines, keep the partial
+     * tail coalescing in the buffer. */
+    if (stream->buf_mode == _IOLBF && done > 0)
+        __flush_lines(stream);
 
     return done / size;
 }
@@ -60,6 +60,23 @@
  * touching the free list.
  */
 #define MMAP_THRESHOLD  (128 * 1024)    /* 128 KiB */
+
+/*
+ * Allocations at or above HUGE_THRESHOLD additionally request 2 MiB
+ * pages (MAP_HUGE): framebuffer- and texture-scale buffers stop
+ * fragmenting into thousands of 4 KiB mappings.  The kernel falls
+ * back to small pages silently, so the flag costs nothing when huge
+ * pages are unavailable.
+ */
+#define HUGE_THRESHOLD  (2UL * 1024 * 1024)
+
+/*
+ * Free-list blocks at or above MADV_TRIM_THRESHOLD get their
+ * page-aligned interior marked MADV_FREE after coalescing: the VA
+ * stays reusable but the kernel may reclaim the pages, so a burst
+ * of large allocations doesn't hold residency forever.
+ */
+#define MADV_TRIM_THRESHOLD (256 * 1024)
 #define MMAP_MAGIC      0x4D4D415001UL  /* "MMA\x01" */
 
 typedef struct mmap_header {
@@ -117,14 +134,38 @@ static void free_insert(block_header_t *blk)
         (char *)prev_blk + HEADER_SIZE + prev_blk->size == (char *)blk) {
         prev_blk->size += HEADER_SIZE + blk->size;
         prev_blk->next = blk->next;
+        blk = prev_blk;
     } else if (prev_blk) {
         prev_blk->next = blk;
     } else {
         free_list = blk;
     }
+
+    /*
+     * Large coalesced block: let the kernel reclaim the interior
+     * pages lazily.  The header page stays resident (the list walk
+     * touches it); MADV_FREE contents are allowed to vanish, which
+     * is fine for free memory.
+     */
+    if (blk->size >= MADV_TRIM_THRESHOLD) {
+        char *start = (char *)blk + HEADER_SIZE;
+        char *end = start + blk->size;
+        char *astart = (char *)(((unsigned long)start + 4095UL) & ~4095UL);
+        char *aend = (char *)((unsigned long)end & ~4095UL);
+
+        if (aend > astart)
+            madvise(astart, (size_t)(aend - astart), MADV_FREE);
+    }
 }
 
-void *malloc(size_t size)
+/*
+ * Core allocator: first-fit free list over sbrk, mmap for large
+ * blocks.  Callers below 2 KiB normally go through the size-class
+ * layer instead; this path serves mid-size and huge requests and
+ * arena-chunk carving.  The arena spinlock must be held except for
+ * the mmap path (which touches no shared state).
+ */
+static void *malloc_core(size_t size)
 {
     if (size == 0)
         return NULL;
@@ -147,10 +188,25 @@ void *malloc(size_t size)
         /* Round up to a page boundary for clean munmap accounting. */
         map_size = (map_size + 4095UL) & ~4095UL;
 
-        void *mem = mmap(NULL, map_size,
-                         PROT_READ | PROT_WRITE,
-                         MAP_PRIVATE | MAP_ANONYMOUS,
-                         -1, 0);
+        void *mem = MAP_FAILED;
+
+        /* Huge allocations: ask for 2 MiB pages first */
+        if (map_size >= HUGE_THRESHOLD) {
+            size_t huge_size = (map_size + HUGE_THRESHOLD - 1) &
+                               ~(HUGE_THRESHOLD - 1);
+
+            mem = mmap(NULL, huge_size,
+                       PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGE,
+                       -1, 0);
+            if (mem != MAP_FAILED)
+                map_size = huge_size;
+        }
+        if (mem == MAP_FAILED)
+            mem = mmap(NULL, map_size,
+                       PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS,
+                       -1, 0);
         if (mem == MAP_FAILED) {
             errno = ENOMEM;
             return NULL;
@@ -223,8 +279,249 @@ void *malloc(size_t size)
     return (char *)blk + HEADER_SIZE;
 }
 
+static void free_core(void *ptr)
+{
+    block_header_t *blk = (block_header_t *)((char *)ptr - HEADER_SIZE);
+    free_insert(blk);
+}
+
+/* ========================================================================= */
+/* Size-class allocator with per-thread caches                               */
+/* ========================================================================= */
+
+/*
+ * Requests up to 2 KiB are served from size classes: 16-byte steps to
+ * 128, 64-byte steps to 512, 256-byte steps to 2048.  Each thread
+ * keeps a small magazine of blocks per class (slot in its TCB via
+ * __veridian_alloc_tls), so the common malloc/free path is a pointer
+ * pop/push with no lock and no list walk.  Magazines refill from and
+ * flush to central per-class lists under one spinlock; the central
+ * lists are fed by carving 64 KiB arena chunks from sbrk.
+ *
+ * Class blocks keep the regular block header with bit 0 of the size
+ * set, so free() can route them back to their class without a lookup
+ * and realloc() can read the usable size.
+ */
+
+#define NUM_CLASSES     20
+#define SMALL_MAX       2048
+#define TCACHE_CAP      32      /* Blocks per class per thread      */
+#define TCACHE_REFILL   16      /* Blocks pulled on a miss          */
+#define ARENA_CHUNK     (64 * 1024)
+#define SIZE_CLASS_TAG  1UL     /* Bit 0 of header size             */
+
+static const unsigned short g_class_size[NUM_CLASSES] = {
+    16, 32, 48, 64, 80, 96, 112, 128,
+    192, 256, 320, 384, 448, 512,
+    768, 1024, 1280, 1536, 1792, 2048
+};
+
+struct tcache {
+    void *bins[NUM_CLASSES][TCACHE_CAP];
+    int   counts[NUM_CLASSES];
+};
+
+/* Central per-class free lists (chained through the user area) */
+static void *g_central[NUM_CLASSES];
+
+/* One lock covers the central lists and the legacy free list */
+static volatile int g_arena_lock;
+
+/* Per-thread slot, provided by the pthread shim */
+extern void **__veridian_alloc_tls(void);
+
+static void arena_lock(void)
+{
+    while (__atomic_test_and_set(&g_arena_lock, __ATOMIC_ACQUIRE)) {
+        while (g_arena_lock)
+            ;   /* Spin read-only until it looks free */
+    }
+}
+
+static void arena_unlock(void)
+{
+    __atomic_clear(&g_arena_lock, __ATOMIC_RELEASE);
+}
+
+static int size_to_class(size_t size)
+{
+    if (size <= 128)
+        return (int)((size + 15) / 16) - 1;
+    if (size <= 512)
+        return 8 + (int)((size - 129) / 64);
+    return 14 + (int)((size - 513) / 256);
+}
+
+/*
+ * Carve a fresh arena chunk into blocks of one class and push them
+ * onto its central list.  Called with the arena lock held.
+ */
+static void central_grow(int cls)
+{
+    size_t csize = g_class_size[cls];
+    size_t step = HEADER_SIZE + csize;
+    size_t count = ARENA_CHUNK / step;
+    char *chunk;
+    size_t i;
+
+    chunk = sbrk((intptr_t)(count * step));
+    if (chunk == (char *)-1)
+        return;
+
+    for (i = 0; i < count; i++) {
+        block_header_t *blk = (block_header_t *)(chunk + i * step);
+        void *user = (char *)blk + HEADER_SIZE;
+
+        blk->size = csize | SIZE_CLASS_TAG;
+        blk->next = NULL;
+        *(void **)user = g_central[cls];
+        g_central[cls] = user;
+    }
+}
+
+static struct tcache *tcache_get(void)
+{
+    void **slot = __veridian_alloc_tls();
+
+    if (*slot == NULL) {
+        /* Bootstrap the cache from the core allocator (it is larger
+         * than SMALL_MAX, so no recursion into the class layer) */
+        arena_lock();
+        *slot = malloc_core(sizeof(struct tcache));
+        arena_unlock();
+        if (*slot)
+            memset(*slot, 0, sizeof(struct tcache));
+    }
+    return (struct tcache *)*slot;
+}
+
+static void *tcache_alloc(int cls)
+{
+    struct tcache *tc = tcache_get();
+    void *ptr;
+    int n;
+
+    if (tc == NULL) {
+        /* OOM bootstrapping the cache: serve from central directly */
+        arena_lock();
+        if (g_central[cls] == NULL)
+            central_grow(cls);
+        ptr = g_central[cls];
+        if (ptr)
+            g_central[cls] = *(void **)ptr;
+        arena_unlock();
+        return ptr;
+    }
+
+    if (tc->counts[cls] > 0)
+        return tc->bins[cls][--tc->counts[cls]];
+
+    /* Refill the magazine from the central list */
+    arena_lock();
+    for (n = 0; n < TCACHE_REFILL; n++) {
+        if (g_central[cls] == NULL) {
+            central_grow(cls);
+            if (g_central[cls] == NULL)
+                break;
+        }
+        ptr = g_central[cls];
+        g_central[cls] = *(void **)ptr;
+        tc->bins[cls][tc->counts[cls]++] = ptr;
+    }
+    arena_unlock();
+
+    if (tc->counts[cls] > 0)
+        return tc->bins[cls][--tc->counts[cls]];
+    return NULL;
+}
+
+static void tcache_free(void *ptr, int cls)
+{
+    struct tcache *tc = tcache_get();
+    int n;
+
+    if (tc == NULL) {
+        arena_lock();
+        *(void **)ptr = g_central[cls];
+        g_central[cls] = ptr;
+        arena_unlock();
+        return;
+    }
+
+    if (tc->counts[cls] >= TCACHE_CAP) {
+        /* Magazine full: flush half back to the central list */
+        arena_lock();
+        for (n = 0; n < TCACHE_CAP / 2; n++) {
+            void *p = tc->bins[cls][--tc->counts[cls]];
+
+            *(void **)p = g_central[cls];
+            g_central[cls] = p;
+        }
+        arena_unlock();
+    }
+
+    tc->bins[cls][tc->counts[cls]++] = ptr;
+}
+
+/*
+ * Flush and release the calling thread's cache.  Called by
+ * pthread_exit() so a dying thread's magazines aren't stranded.
+ */
+void __veridian_alloc_thread_exit(void)
+{
+    void **slot = __veridian_alloc_tls();
+    struct tcache *tc = (struct tcache *)*slot;
+    int cls;
+
+    if (tc == NULL)
+        return;
+
+    arena_lock();
+    for (cls = 0; cls < NUM_CLASSES; cls++) {
+        while (tc->counts[cls] > 0) {
+            void *p = tc->bins[cls][--tc->counts[cls]];
+
+            *(void **)p = g_central[cls];
+            g_central[cls] = p;
+        }
+    }
+    free_core(tc);
+    arena_unlock();
+    *slot = NULL;
+}
+
+/* ========================================================================= */
+/* Public allocation API                                                     */
+/* ========================================================================= */
+
+void *malloc(size_t size)
+{
+    void *ptr;
+
+    if (size == 0)
+        return NULL;
+
+    if (size <= SMALL_MAX) {
+        ptr = tcache_alloc(size_to_class(size));
+        if (ptr)
+            return ptr;
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    if (align_up(size) >= MMAP_THRESHOLD)
+        return malloc_core(size);   /* mmap path: no shared state */
+
+    arena_lock();
+    ptr = malloc_core(size);
+    arena_unlock();
+    return ptr;
+}
+
 void free(void *ptr)
 {
+    block_header_t *blk;
+
     if (!ptr)
         return;
 
@@ -243,8 +540,15 @@ void free(void *ptr)
         return;
     }
 
-    block_header_t *blk = (block_header_t *)((char *)ptr - HEADER_SIZE);
-    free_insert(blk);
+    blk = (block_header_t *)((char *)ptr - HEADER_SIZE);
+    if (blk->size & SIZE_CLASS_TAG) {
+        tcache_free(ptr, size_to_class(blk->size & ~SIZE_CLASS_TAG));
+        return;
+    }
+
+    arena_lock();
+    free_core(ptr);
+    arena_unlock();
 }
 
 void *calloc(size_t count, size_t size)
@@ -295,6 +599,21 @@ void *realloc(void *ptr, size_t size)
 
     block_header_t *blk = (block_header_t *)((char *)ptr - HEADER_SIZE);
 
+    /* Size-class blocks: fits in its class or moves to a new block */
+    if (blk->size & SIZE_CLASS_TAG) {
+        size_t usable = blk->size & ~SIZE_CLASS_TAG;
+
+        if (usable >= size)
+            return ptr;
+
+        void *newp = malloc(size);
+        if (!newp)
+            return NULL;
+        memcpy(newp, ptr, usable);
+        free(ptr);
+        return newp;
+    }
+
     if (blk->size >= size)
         return ptr;     /* Current block is big enough. */
 
@@ -303,6 +622,8 @@ void *realloc(void *ptr, size_t size)
      * This avoids a copy when the next block in memory is free and
      * large enough to satisfy the request.
      */
+    arena_lock();
+
     block_header_t *next_addr =
         (block_header_t *)((char *)blk + HEADER_SIZE + blk->size);
     block_header_t *fprev = NULL;
@@ -328,6 +649,7 @@ void *realloc(void *ptr, size_t size)
                     blk->size = size;
                     free_insert(rem);
                 }
+                arena_unlock();
                 return ptr;     /* Grew in place -- no copy needed. */
             }
             break;
@@ -336,6 +658,8 @@ void *realloc(void *ptr, size_t size)
         fcur = fcur->next;
     }
 
+    arena_unlock();
+
     /* Cannot grow in place.  Allocate, copy, free. */
     void *newp = malloc(size);
     if (!newp)
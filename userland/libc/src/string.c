@@ -10,22 +10,144 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <errno.h>
 #include <ctype.h>
 
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
 /* ========================================================================= */
 /* Memory operations                                                         */
 /* ========================================================================= */
 
+/*
+ * The hot primitives (memcpy, memset, memcmp, memchr, strlen, strcmp)
+ * are vectorized:
+ *
+ *   x86_64:  SSE2 is the ISA baseline; AVX2 variants carry target
+ *            attributes and are selected at runtime via CPUID (cached
+ *            after the first check).
+ *   others:  word-at-a-time with the usual zero-byte trick (AArch64
+ *            builds with -mgeneral-regs-only, so no NEON).
+ *
+ * Small sizes short-circuit to byte loops -- the setup cost of the
+ * wide paths only pays past ~16 bytes.  userland/tests/string_bench.c
+ * tracks all of these against the byte-loop reference.
+ */
+
+#define WORD_ONES  0x0101010101010101ULL
+#define WORD_HIGHS 0x8080808080808080ULL
+
+/* True if any byte of v is zero */
+#define WORD_HAS_ZERO(v) (((v) - WORD_ONES) & ~(v) & WORD_HIGHS)
+
+#if defined(__x86_64__)
+
+/* Cached CPUID feature check (no libgcc cpu-model dependency) */
+static int cpu_has_avx2(void)
+{
+    static int checked, has_avx2;
+
+    if (!checked) {
+        unsigned int eax, ebx, ecx, edx;
+
+        /* CPUID leaf 7, subleaf 0: EBX bit 5 = AVX2 */
+        __asm__ volatile("cpuid"
+                         : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx)
+                         : "a"(7), "c"(0));
+        has_avx2 = (ebx >> 5) & 1;
+        checked = 1;
+    }
+    return has_avx2;
+}
+
+__attribute__((target("avx2")))
+static void *memcpy_avx2(void *dest, const void *src, size_t n)
+{
+    unsigned char *d = (unsigned char *)dest;
+    const unsigned char *s = (const unsigned char *)src;
+
+    while (n >= 64) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)s);
+        __m256i b = _mm256_loadu_si256((const __m256i *)(s + 32));
+        _mm256_storeu_si256((__m256i *)d, a);
+        _mm256_storeu_si256((__m256i *)(d + 32), b);
+        d += 64;
+        s += 64;
+        n -= 64;
+    }
+    while (n >= 16) {
+        _mm_storeu_si128((__m128i *)d,
+                         _mm_loadu_si128((const __m128i *)s));
+        d += 16;
+        s += 16;
+        n -= 16;
+    }
+    while (n--)
+        *d++ = *s++;
+    return dest;
+}
+
+static void *memcpy_sse2(void *dest, const void *src, size_t n)
+{
+    unsigned char *d = (unsigned char *)dest;
+    const unsigned char *s = (const unsigned char *)src;
+
+    while (n >= 16) {
+        _mm_storeu_si128((__m128i *)d,
+                         _mm_loadu_si128((const __m128i *)s));
+        d += 16;
+        s += 16;
+        n -= 16;
+    }
+    while (n--)
+        *d++ = *s++;
+    return dest;
+}
+
+void *memcpy(void *dest, const void *src, size_t n)
+{
+    if (n < 16) {
+        unsigned char *d = (unsigned char *)dest;
+        const unsigned char *s = (const unsigned char *)src;
+        while (n--)
+            *d++ = *s++;
+        return dest;
+    }
+    if (n >= 128 && cpu_has_avx2())
+        return memcpy_avx2(dest, src, n);
+    return memcpy_sse2(dest, src, n);
+}
+
+#else /* !__x86_64__ */
+
 void *memcpy(void *dest, const void *src, size_t n)
 {
     unsigned char *d = (unsigned char *)dest;
     const unsigned char *s = (const unsigned char *)src;
+
+    /* Word-at-a-time when both sides share alignment */
+    if (n >= 16 && (((uintptr_t)d ^ (uintptr_t)s) & 7) == 0) {
+        while (((uintptr_t)d & 7) && n) {
+            *d++ = *s++;
+            n--;
+        }
+        while (n >= 8) {
+            *(uint64_t *)d = *(const uint64_t *)s;
+            d += 8;
+            s += 8;
+            n -= 8;
+        }
+    }
     while (n--)
         *d++ = *s++;
     return dest;
 }
 
+#endif /* __x86_64__ */
+
 void *memmove(void *dest, const void *src, size_t n)
 {
     unsigned char *d = (unsigned char *)dest;
@@ -45,18 +167,109 @@ void *memmove(void *dest, const void *src, size_t n)
     return dest;
 }
 
+#if defined(__x86_64__)
+
+__attribute__((target("avx2")))
+static void *memset_avx2(void *dest, int c, size_t n)
+{
+    unsigned char *d = (unsigned char *)dest;
+    const __m256i v = _mm256_set1_epi8((char)c);
+
+    while (n >= 32) {
+        _mm256_storeu_si256((__m256i *)d, v);
+        d += 32;
+        n -= 32;
+    }
+    while (n--)
+        *d++ = (unsigned char)c;
+    return dest;
+}
+
+void *memset(void *dest, int c, size_t n)
+{
+    unsigned char *d = (unsigned char *)dest;
+
+    if (n < 16) {
+        while (n--)
+            *d++ = (unsigned char)c;
+        return dest;
+    }
+    if (n >= 128 && cpu_has_avx2())
+        return memset_avx2(dest, c, n);
+
+    const __m128i v = _mm_set1_epi8((char)c);
+    while (n >= 16) {
+        _mm_storeu_si128((__m128i *)d, v);
+        d += 16;
+        n -= 16;
+    }
+    while (n--)
+        *d++ = (unsigned char)c;
+    return dest;
+}
+
+#else /* !__x86_64__ */
+
 void *memset(void *dest, int c, size_t n)
 {
     unsigned char *d = (unsigned char *)dest;
+    uint64_t word = (unsigned char)c * WORD_ONES;
+
+    while (((uintptr_t)d & 7) && n) {
+        *d++ = (unsigned char)c;
+        n--;
+    }
+    while (n >= 8) {
+        *(uint64_t *)d = word;
+        d += 8;
+        n -= 8;
+    }
     while (n--)
         *d++ = (unsigned char)c;
     return dest;
 }
 
+#endif /* __x86_64__ */
+
 int memcmp(const void *s1, const void *s2, size_t n)
 {
     const unsigned char *a = (const unsigned char *)s1;
     const unsigned char *b = (const unsigned char *)s2;
+
+#if defined(__x86_64__)
+    while (n >= 16) {
+        __m128i va = _mm_loadu_si128((const __m128i *)a);
+        __m128i vb = _mm_loadu_si128((const __m128i *)b);
+        unsigned int eq = (unsigned int)
+            _mm_movemask_epi8(_mm_cmpeq_epi8(va, vb));
+
+        if (eq != 0xFFFF) {
+            unsigned int idx =
+                (unsigned int)__builtin_ctz(~eq & 0xFFFF);
+            return a[idx] - b[idx];
+        }
+        a += 16;
+        b += 16;
+        n -= 16;
+    }
+#else
+    if ((((uintptr_t)a ^ (uintptr_t)b) & 7) == 0) {
+        while (((uintptr_t)a & 7) && n) {
+            if (*a != *b)
+                return *a - *b;
+            a++;
+            b++;
+            n--;
+        }
+        while (n >= 8 &&
+               *(const uint64_t *)a == *(const uint64_t *)b) {
+            a += 8;
+            b += 8;
+            n -= 8;
+        }
+    }
+#endif
+
     while (n--) {
         if (*a != *b)
             return *a - *b;
@@ -70,6 +283,38 @@ void *memchr(const void *s, int c, size_t n)
 {
     const unsigned char *p = (const unsigned char *)s;
     unsigned char uc = (unsigned char)c;
+
+#if defined(__x86_64__)
+    const __m128i vc = _mm_set1_epi8((char)uc);
+
+    while (n >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)p);
+        unsigned int mask = (unsigned int)
+            _mm_movemask_epi8(_mm_cmpeq_epi8(v, vc));
+
+        if (mask)
+            return (void *)(p + __builtin_ctz(mask));
+        p += 16;
+        n -= 16;
+    }
+#else
+    uint64_t pattern = uc * WORD_ONES;
+
+    while (((uintptr_t)p & 7) && n) {
+        if (*p == uc)
+            return (void *)p;
+        p++;
+        n--;
+    }
+    while (n >= 8) {
+        uint64_t v = *(const uint64_t *)p ^ pattern;
+        if (WORD_HAS_ZERO(v))
+            break;  /* Hit within this word: byte loop finds it */
+        p += 8;
+        n -= 8;
+    }
+#endif
+
     while (n--) {
         if (*p == uc)
             return (void *)p;
@@ -85,9 +330,42 @@ void *memchr(const void *s, int c, size_t n)
 size_t strlen(const char *s)
 {
     const char *p = s;
-    while (*p)
+
+#if defined(__x86_64__)
+    const __m128i zero = _mm_setzero_si128();
+
+    /* Byte-step to 16-byte alignment so the vector loads never cross
+     * into an unmapped page */
+    while ((uintptr_t)p & 15) {
+        if (*p == '\0')
+            return (size_t)(p - s);
         p++;
-    return (size_t)(p - s);
+    }
+    for (;;) {
+        __m128i v = _mm_load_si128((const __m128i *)p);
+        unsigned int mask = (unsigned int)
+            _mm_movemask_epi8(_mm_cmpeq_epi8(v, zero));
+
+        if (mask)
+            return (size_t)(p - s) + (size_t)__builtin_ctz(mask);
+        p += 16;
+    }
+#else
+    while ((uintptr_t)p & 7) {
+        if (*p == '\0')
+            return (size_t)(p - s);
+        p++;
+    }
+    for (;;) {
+        uint64_t v = *(const uint64_t *)p;
+        if (WORD_HAS_ZERO(v)) {
+            while (*p)
+                p++;
+            return (size_t)(p - s);
+        }
+        p += 8;
+    }
+#endif
 }
 
 size_t strnlen(const char *s, size_t maxlen)
@@ -104,6 +382,26 @@ size_t strnlen(const char *s, size_t maxlen)
 
 int strcmp(const char *s1, const char *s2)
 {
+    /* Word-at-a-time only when both sides share alignment; the word
+     * loads then stay within mapped pages */
+    if ((((uintptr_t)s1 ^ (uintptr_t)s2) & 7) == 0) {
+        while (((uintptr_t)s1 & 7) && *s1 && *s1 == *s2) {
+            s1++;
+            s2++;
+        }
+        if (((uintptr_t)s1 & 7) == 0) {
+            while (1) {
+                uint64_t a = *(const uint64_t *)s1;
+                uint64_t b = *(const uint64_t *)s2;
+
+                if (a != b || WORD_HAS_ZERO(a))
+                    break;
+                s1 += 8;
+                s2 += 8;
+            }
+        }
+    }
+
     while (*s1 && *s1 == *s2) {
         s1++;
         s2++;
@@ -20,9 +20,247 @@
 #include <veridian/fcntl.h>
 #include <veridian/mman.h>
 #include <sys/utsname.h>
+#include <sys/uio.h>
+#include <unistd.h>
 #include <time.h>
 #include <errno.h>
 #include <stddef.h>
+#include <stdint.h>
+
+/* ========================================================================= */
+/* Syscall latency profiling (opt-in)                                        */
+/* ========================================================================= */
+
+/*
+ * Per-syscall-number latency histograms over every wrapper in this
+ * file -- the chokepoint where userland meets the kernel's <1us IPC
+ * promise.  Off (the default) costs one relaxed flag load per call;
+ * on, each syscall is bracketed by rdtsc (calibrated once against
+ * the clock; other architectures fall back to clock_gettime) and a
+ * relaxed atomic bump of a log2-nanosecond bucket.  Recording is
+ * lock-free throughout; veridian_syscall_prof_flush() folds the
+ * busiest numbers into the shared perf page (veridian/perfcount.h)
+ * where sysinfo --perf already reads.
+ *
+ * Enable with VERIDIAN_SYSCALL_PROF=1 in the environment or
+ * veridian_syscall_prof_enable(1) at runtime.
+ */
+
+#define VSYS_MAX_NR      512
+#define VSYS_BUCKETS     24             /* log2 ns: covers 1ns..8s */
+#define VSYS_FLUSH_TOP   8
+
+static int      vsys_prof_state;        /* 0 unknown, 1 on, -1 off */
+static uint64_t vsys_hist[VSYS_MAX_NR][VSYS_BUCKETS];
+static uint64_t vsys_calls[VSYS_MAX_NR];
+static uint64_t vsys_total_ns[VSYS_MAX_NR];
+static uint64_t vsys_tsc_per_us;        /* Calibrated once */
+
+extern char *getenv(const char *name);
+
+#if defined(__x86_64__)
+static inline uint64_t vsys_ticks(void)
+{
+    uint32_t lo, hi;
+
+    __asm__ volatile ("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((uint64_t)hi << 32) | lo;
+}
+#else
+static inline uint64_t vsys_ticks(void)
+{
+    struct timespec ts;
+
+    veridian_syscall2(SYS_CLOCK_GETTIME, 1 /* CLOCK_MONOTONIC */,
+                      &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+static void vsys_calibrate(void)
+{
+#if defined(__x86_64__)
+    struct timespec a, b;
+    uint64_t t0, t1;
+
+    clock_gettime(CLOCK_MONOTONIC, &a);
+    t0 = vsys_ticks();
+    /* ~2ms busy window: long enough for a stable rate */
+    do {
+        clock_gettime(CLOCK_MONOTONIC, &b);
+    } while ((b.tv_sec - a.tv_sec) * 1000000000L +
+             (b.tv_nsec - a.tv_nsec) < 2000000L);
+    t1 = vsys_ticks();
+
+    uint64_t ns = (uint64_t)((b.tv_sec - a.tv_sec) * 1000000000L +
+                             (b.tv_nsec - a.tv_nsec));
+
+    vsys_tsc_per_us = ns ? (t1 - t0) * 1000 / ns : 1;
+#else
+    vsys_tsc_per_us = 1000;             /* Ticks already nanoseconds */
+#endif
+    if (vsys_tsc_per_us == 0)
+        vsys_tsc_per_us = 1;
+}
+
+int veridian_syscall_prof_enable(int on)
+{
+    int prev = vsys_prof_state > 0;
+
+    if (on && vsys_tsc_per_us == 0)
+        vsys_calibrate();
+    __atomic_store_n(&vsys_prof_state, on ? 1 : -1, __ATOMIC_RELEASE);
+    return prev;
+}
+
+static inline int vsys_prof_on(void)
+{
+    int s = __atomic_load_n(&vsys_prof_state, __ATOMIC_RELAXED);
+
+    if (s == 0) {
+        const char *env = getenv("VERIDIAN_SYSCALL_PROF");
+
+        if (env && env[0] == '1') {
+            veridian_syscall_prof_enable(1);
+            return 1;
+        }
+        __atomic_store_n(&vsys_prof_state, -1, __ATOMIC_RELAXED);
+        return 0;
+    }
+    return s > 0;
+}
+
+static void vsys_record(long nr, uint64_t ticks)
+{
+    uint64_t ns = ticks * 1000 / vsys_tsc_per_us;
+    int bucket = 0;
+    uint64_t v = ns;
+
+    if (nr < 0 || nr >= VSYS_MAX_NR)
+        return;
+    while (v > 1 && bucket < VSYS_BUCKETS - 1) {
+        v >>= 1;
+        bucket++;
+    }
+    __atomic_fetch_add(&vsys_hist[nr][bucket], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&vsys_calls[nr], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&vsys_total_ns[nr], ns, __ATOMIC_RELAXED);
+}
+
+/* Profiled dispatch: used by every wrapper below via the macro
+ * shadowing at the end of this section */
+static inline long vsys_prof6(long nr, long a1, long a2, long a3,
+                              long a4, long a5, long a6)
+{
+    if (!vsys_prof_on())
+        return veridian_syscall6(nr, a1, a2, a3, a4, a5, a6);
+
+    uint64_t t0 = vsys_ticks();
+    long ret = veridian_syscall6(nr, a1, a2, a3, a4, a5, a6);
+
+    vsys_record(nr, vsys_ticks() - t0);
+    return ret;
+}
+
+/*
+ * Fold the busiest syscall numbers into the shared perf page so the
+ * existing samplers (sysinfo --perf, vprof) surface them.
+ */
+void veridian_syscall_prof_flush(void)
+{
+    extern int vpc_hist(const char *name);
+    extern void vpc_hist_record(int handle, uint64_t ns);
+
+    for (int pass = 0; pass < VSYS_FLUSH_TOP; pass++) {
+        long best = -1;
+        uint64_t best_calls = 0;
+
+        for (long nr = 0; nr < VSYS_MAX_NR; nr++) {
+            uint64_t c =
+                __atomic_load_n(&vsys_calls[nr], __ATOMIC_RELAXED);
+
+            if (c > best_calls) {
+                best_calls = c;
+                best = nr;
+            }
+        }
+        if (best < 0 || best_calls == 0)
+            break;
+
+        char name[24];
+        int n = 0;
+
+        name[n++] = 's'; name[n++] = 'y'; name[n++] = 's'; name[n++] = '.';
+        if (best >= 100)
+            name[n++] = (char)('0' + best / 100);
+        if (best >= 10)
+            name[n++] = (char)('0' + (best / 10) % 10);
+        name[n++] = (char)('0' + best % 10);
+        name[n] = '\0';
+
+        int h = vpc_hist(name);
+
+        if (h >= 0) {
+            uint64_t calls =
+                __atomic_exchange_n(&vsys_calls[best], 0,
+                                    __ATOMIC_RELAXED);
+            uint64_t total =
+                __atomic_exchange_n(&vsys_total_ns[best], 0,
+                                    __ATOMIC_RELAXED);
+
+            /* Record the mean once per call batch: the vpc page's
+             * own bucketing rebuilds the distribution shape from
+             * repeated flushes */
+            if (calls)
+                vpc_hist_record(h, total / calls);
+        } else {
+            __atomic_store_n(&vsys_calls[best], 0, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/* Raw per-number counters for tooling that wants the full
+ * distribution rather than the perf-page summary */
+void veridian_syscall_prof_read(long nr, uint64_t *calls,
+                                uint64_t *total_ns,
+                                uint64_t buckets[VSYS_BUCKETS])
+{
+    if (nr < 0 || nr >= VSYS_MAX_NR)
+        return;
+    if (calls)
+        *calls = __atomic_load_n(&vsys_calls[nr], __ATOMIC_RELAXED);
+    if (total_ns)
+        *total_ns =
+            __atomic_load_n(&vsys_total_ns[nr], __ATOMIC_RELAXED);
+    if (buckets)
+        for (int b = 0; b < VSYS_BUCKETS; b++)
+            buckets[b] = __atomic_load_n(&vsys_hist[nr][b],
+                                         __ATOMIC_RELAXED);
+}
+
+/* Shadow the raw macros: every wrapper in this file now routes
+ * through the profiled dispatch */
+#undef veridian_syscall0
+#undef veridian_syscall1
+#undef veridian_syscall2
+#undef veridian_syscall3
+#undef veridian_syscall4
+#undef veridian_syscall5
+#undef veridian_syscall6
+#define veridian_syscall0(n) vsys_prof6((n), 0, 0, 0, 0, 0, 0)
+#define veridian_syscall1(n, a) vsys_prof6((n), (long)(a), 0, 0, 0, 0, 0)
+#define veridian_syscall2(n, a, b) \
+    vsys_prof6((n), (long)(a), (long)(b), 0, 0, 0, 0)
+#define veridian_syscall3(n, a, b, c) \
+    vsys_prof6((n), (long)(a), (long)(b), (long)(c), 0, 0, 0)
+#define veridian_syscall4(n, a, b, c, d) \
+    vsys_prof6((n), (long)(a), (long)(b), (long)(c), (long)(d), 0, 0)
+#define veridian_syscall5(n, a, b, c, d, e) \
+    vsys_prof6((n), (long)(a), (long)(b), (long)(c), (long)(d), \
+               (long)(e), 0)
+#define veridian_syscall6(n, a, b, c, d, e, f) \
+    vsys_prof6((n), (long)(a), (long)(b), (long)(c), (long)(d), \
+               (long)(e), (long)(f))
 
 /* ========================================================================= */
 /* Helper: translate raw syscall result to POSIX return value                */
@@ -46,16 +284,128 @@ static inline long __syscall_ret(long r)
 /* File I/O                                                                  */
 /* ========================================================================= */
 
+/*
+ * Cancellation point (pthread.c).  Blocking wrappers check before
+ * entering the kernel and again when bounced out with EINTR by
+ * SYS_THREAD_INTERRUPT, so pthread_cancel latency is bounded by the
+ * kick, not by how long the I/O would have taken.
+ */
+extern void __pthread_cancel_point(void);
+
 ssize_t read(int fd, void *buf, size_t count)
 {
-    return (ssize_t)__syscall_ret(
-        veridian_syscall3(SYS_FILE_READ, fd, buf, count));
+    long r;
+
+    __pthread_cancel_point();
+    r = veridian_syscall3(SYS_FILE_READ, fd, buf, count);
+    if (r == -EINTR)
+        __pthread_cancel_point();
+    return (ssize_t)__syscall_ret(r);
 }
 
 ssize_t write(int fd, const void *buf, size_t count)
 {
-    return (ssize_t)__syscall_ret(
-        veridian_syscall3(SYS_FILE_WRITE, fd, buf, count));
+    long r;
+
+    __pthread_cancel_point();
+    r = veridian_syscall3(SYS_FILE_WRITE, fd, buf, count);
+    if (r == -EINTR)
+        __pthread_cancel_point();
+    return (ssize_t)__syscall_ret(r);
+}
+
+ssize_t readv(int fd, const struct iovec *iov, int iovcnt)
+{
+    long r = veridian_syscall3(SYS_READV, fd, iov, iovcnt);
+
+    /* Older kernels without scatter/gather: emulate sequentially */
+    if (r == -ENOSYS) {
+        ssize_t total = 0;
+        int i;
+
+        for (i = 0; i < iovcnt; i++) {
+            ssize_t n = read(fd, iov[i].iov_base, iov[i].iov_len);
+            if (n < 0)
+                return total > 0 ? total : -1;
+            total += n;
+            if ((size_t)n < iov[i].iov_len)
+                break;
+        }
+        return total;
+    }
+
+    return (ssize_t)__syscall_ret(r);
+}
+
+ssize_t writev(int fd, const struct iovec *iov, int iovcnt)
+{
+    long r = veridian_syscall3(SYS_WRITEV, fd, iov, iovcnt);
+
+    /* Older kernels without scatter/gather: emulate sequentially */
+    if (r == -ENOSYS) {
+        ssize_t total = 0;
+        int i;
+
+        for (i = 0; i < iovcnt; i++) {
+            ssize_t w = write(fd, iov[i].iov_base, iov[i].iov_len);
+            if (w < 0)
+                return total > 0 ? total : -1;
+            total += w;
+            if ((size_t)w < iov[i].iov_len)
+                break;
+        }
+        return total;
+    }
+
+    return (ssize_t)__syscall_ret(r);
+}
+
+ssize_t preadv(int fd, const struct iovec *iov, int iovcnt,
+               off_t offset)
+{
+    long r = veridian_syscall4(SYS_PREADV, fd, iov, iovcnt, offset);
+
+    if (r == -ENOSYS) {
+        ssize_t total = 0;
+        int i;
+
+        for (i = 0; i < iovcnt; i++) {
+            ssize_t n = pread(fd, iov[i].iov_base, iov[i].iov_len,
+                              offset + total);
+            if (n < 0)
+                return total > 0 ? total : -1;
+            total += n;
+            if ((size_t)n < iov[i].iov_len)
+                break;
+        }
+        return total;
+    }
+
+    return (ssize_t)__syscall_ret(r);
+}
+
+ssize_t pwritev(int fd, const struct iovec *iov, int iovcnt,
+                off_t offset)
+{
+    long r = veridian_syscall4(SYS_PWRITEV, fd, iov, iovcnt, offset);
+
+    if (r == -ENOSYS) {
+        ssize_t total = 0;
+        int i;
+
+        for (i = 0; i < iovcnt; i++) {
+            ssize_t n = pwrite(fd, iov[i].iov_base, iov[i].iov_len,
+                               offset + total);
+            if (n < 0)
+                return total > 0 ? total : -1;
+            total += n;
+            if ((size_t)n < iov[i].iov_len)
+                break;
+        }
+        return total;
+    }
+
+    return (ssize_t)__syscall_ret(r);
 }
 
 int open(const char *pathname, int flags, ...)
@@ -72,10 +422,23 @@ int open(const char *pathname, int flags, ...)
         veridian_syscall3(SYS_FILE_OPEN, pathname, flags, mode));
 }
 
+/*
+ * Close generation: the select/poll epoll adapter (select.c) caches
+ * per-fd registrations, and the kernel silently drops a registration
+ * when its fd closes.  Every close/dup2 bumps this counter so the
+ * adapter re-registers before the next wait instead of sleeping
+ * forever on a reused fd number.  One relaxed add on an
+ * already-syscall path.
+ */
+uint32_t __vsel_close_gen;
+
 int close(int fd)
 {
-    return (int)__syscall_ret(
+    int ret = (int)__syscall_ret(
         veridian_syscall1(SYS_FILE_CLOSE, fd));
+
+    __atomic_fetch_add(&__vsel_close_gen, 1, __ATOMIC_RELAXED);
+    return ret;
 }
 
 off_t lseek(int fd, off_t offset, int whence)
@@ -92,8 +455,12 @@ int dup(int oldfd)
 
 int dup2(int oldfd, int newfd)
 {
-    return (int)__syscall_ret(
+    int ret = (int)__syscall_ret(
         veridian_syscall2(SYS_FILE_DUP2, oldfd, newfd));
+
+    /* dup2 implicitly closes newfd: same staleness hazard */
+    __atomic_fetch_add(&__vsel_close_gen, 1, __ATOMIC_RELAXED);
+    return ret;
 }
 
 int pipe(int pipefd[2])
@@ -170,6 +537,26 @@ int lstat(const char *pathname, struct stat *statbuf)
         veridian_syscall2(SYS_FILE_LSTAT, pathname, statbuf));
 }
 
+int veridian_stat_batch(struct veridian_stat_batch_req *req)
+{
+    return (int)__syscall_ret(
+        veridian_syscall1(SYS_FILE_STAT_BATCH, req));
+}
+
+ssize_t splice(int fd_in, off_t *off_in, int fd_out, off_t *off_out,
+               size_t len, unsigned int flags)
+{
+    return (ssize_t)__syscall_ret(
+        veridian_syscall6(SYS_FILE_SPLICE, fd_in, off_in, fd_out,
+                          off_out, len, flags));
+}
+
+int veridian_read_batch(struct veridian_read_req *reqs, unsigned int count)
+{
+    return (int)__syscall_ret(
+        veridian_syscall2(SYS_FILE_READ_BATCH, reqs, count));
+}
+
 /* ========================================================================= */
 /* Directories                                                               */
 /* ========================================================================= */
@@ -196,6 +583,12 @@ pid_t fork(void)
         veridian_syscall0(SYS_PROCESS_FORK));
 }
 
+pid_t veridian_spawn(const struct veridian_spawn_args *args)
+{
+    return (pid_t)__syscall_ret(
+        veridian_syscall1(SYS_PROCESS_SPAWN, args));
+}
+
 int execve(const char *pathname, char *const argv[], char *const envp[])
 {
     return (int)__syscall_ret(
@@ -248,6 +641,8 @@ int arch_prctl(int code, unsigned long addr)
 
 pid_t waitpid(pid_t pid, int *wstatus, int options)
 {
+    __pthread_cancel_point();
+
     return (pid_t)__syscall_ret(
         veridian_syscall3(SYS_PROCESS_WAIT, pid, wstatus, options));
 }
@@ -622,10 +1017,18 @@ int renameat(int olddirfd, const char *oldpath,
 /* poll                                                                      */
 /* ========================================================================= */
 
-int poll(struct pollfd *fds, unsigned long nfds, int timeout)
+/* Raw kernel poll; the public poll() in select.c adapts onto the
+ * epoll backend and falls back here */
+int __veridian_poll_raw(struct pollfd *fds, unsigned long nfds,
+                        int timeout)
 {
-    return (int)__syscall_ret(
-        veridian_syscall3(SYS_FILE_POLL, fds, nfds, timeout));
+    long r;
+
+    __pthread_cancel_point();
+    r = veridian_syscall3(SYS_FILE_POLL, fds, nfds, timeout);
+    if (r == -EINTR)
+        __pthread_cancel_point();
+    return (int)__syscall_ret(r);
 }
 
 /* ========================================================================= */
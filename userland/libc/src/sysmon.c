@@ -0,0 +1,144 @@
+/*
+ * VeridianOS libc -- sysmon.c
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Shared-memory system monitoring ring (veridian/sysmon.h).
+ */
+
+#include <veridian/sysmon.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static const char *VSM_PATH = "/run/veridian/sysmon.ring";
+static const char *VSM_PATH_FALLBACK = "/tmp/veridian-sysmon.ring";
+
+static struct vsm_ring *g_write_ring;
+static const struct vsm_ring *g_read_ring;
+
+static int vsm_map(int writable, void **out)
+{
+    const char *paths[2] = { VSM_PATH, VSM_PATH_FALLBACK };
+    int fd = -1;
+    void *map;
+
+    if (writable) {
+        mkdir("/run", 0755);
+        mkdir("/run/veridian", 0755);
+        for (int p = 0; p < 2 && fd < 0; p++)
+            fd = open(paths[p], O_RDWR | O_CREAT, 0644);
+        if (fd < 0)
+            return -1;
+        if (ftruncate(fd, sizeof(struct vsm_ring)) < 0) {
+            close(fd);
+            return -1;
+        }
+    } else {
+        for (int p = 0; p < 2 && fd < 0; p++)
+            fd = open(paths[p], O_RDONLY);
+        if (fd < 0)
+            return -1;
+    }
+
+    map = mmap(NULL, sizeof(struct vsm_ring),
+               writable ? PROT_READ | PROT_WRITE : PROT_READ,
+               MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return -1;
+    *out = map;
+    return 0;
+}
+
+int vsm_publish_open(uint32_t interval_ms)
+{
+    void *map;
+
+    if (g_write_ring)
+        return 0;
+    if (vsm_map(1, &map) < 0)
+        return -1;
+
+    struct vsm_ring *r = (struct vsm_ring *)map;
+
+    /* Take over: a prior sampler's history stays readable when the
+     * layout matches, otherwise start fresh */
+    if (__atomic_load_n(&r->magic, __ATOMIC_ACQUIRE) != VSM_MAGIC ||
+        r->version != VSM_VERSION || r->capacity != VSM_RING_CAP) {
+        memset(r, 0, sizeof(*r));
+        r->version = VSM_VERSION;
+        r->capacity = VSM_RING_CAP;
+    }
+    r->interval_ms = interval_ms;
+    __atomic_store_n(&r->magic, VSM_MAGIC, __ATOMIC_RELEASE);
+    g_write_ring = r;
+    return 0;
+}
+
+void vsm_publish(const struct vsm_sample *s)
+{
+    struct vsm_ring *r = g_write_ring;
+    uint64_t seq;
+
+    if (!r || !s)
+        return;
+    seq = __atomic_load_n(&r->seq, __ATOMIC_RELAXED);
+    r->samples[seq % VSM_RING_CAP] = *s;
+    __atomic_store_n(&r->seq, seq + 1, __ATOMIC_RELEASE);
+}
+
+const struct vsm_ring *vsm_attach(void)
+{
+    void *map;
+
+    if (g_read_ring)
+        return g_read_ring;
+    if (vsm_map(0, &map) < 0)
+        return NULL;
+
+    const struct vsm_ring *r = (const struct vsm_ring *)map;
+
+    if (__atomic_load_n(&r->magic, __ATOMIC_ACQUIRE) != VSM_MAGIC ||
+        r->version != VSM_VERSION) {
+        munmap(map, sizeof(struct vsm_ring));
+        return NULL;
+    }
+    g_read_ring = r;
+    return r;
+}
+
+int vsm_read_latest(const struct vsm_ring *ring, struct vsm_sample *out)
+{
+    return vsm_read_history(ring, 0, out);
+}
+
+int vsm_read_history(const struct vsm_ring *ring, uint32_t back,
+                     struct vsm_sample *out)
+{
+    uint64_t seq, seq2, idx;
+
+    if (!ring || !out || back >= VSM_RING_CAP - 1)
+        return -1;
+
+    for (;;) {
+        seq = __atomic_load_n(&ring->seq, __ATOMIC_ACQUIRE);
+        if (seq == 0 || back >= seq)
+            return -1;
+        idx = seq - 1 - back;
+        *out = ring->samples[idx % VSM_RING_CAP];
+
+        /* Lap check: the slot is stable unless the writer has gone
+         * a full ring past it while we copied */
+        seq2 = __atomic_load_n(&ring->seq, __ATOMIC_ACQUIRE);
+        if (seq2 < idx + VSM_RING_CAP)
+            return 0;
+        back = 0;               /* Lapped: retry with the newest */
+    }
+}
@@ -6,10 +6,21 @@
  *
  * Terminal I/O functions.  These wrap the ioctl syscall for
  * TCGETS/TCSETS operations using the real kernel terminal state.
+ *
+ * Attributes are cached per fd and validated against a kernel
+ * generation counter (TCGETGEN, bumped on every attribute change on
+ * the tty, by any process).  A tcgetattr whose generation still
+ * matches copies from the cache, and a tcsetattr that would write
+ * the attributes already in force skips the kernel entirely -- the
+ * raw-mode on/off pairs curses and edit wrap around every operation
+ * collapse to zero or one syscall.  Kernels without TCGETGEN
+ * disable the cache on first use and take the old path.
  */
 
 #include <termios.h>
 #include <errno.h>
+#include <string.h>
+#include <stdint.h>
 
 /* ioctl request codes for terminal get/set (matching Linux values) */
 #define TCGETS  0x5401
@@ -17,21 +28,90 @@
 #define TCSETSW 0x5403
 #define TCSETSF 0x5404
 
+/*
+ * VeridianOS extension: fills a uint64_t with the tty's identity in
+ * the high half and its attribute generation in the low half, so a
+ * cached struct is provably current (fd reuse lands on a different
+ * identity, external changes on a different generation).
+ */
+#define TCGETGEN 0x5470
+
 /* Forward declaration -- ioctl is in syscall.c */
 extern int ioctl(int fd, unsigned long request, ...);
 
+#define TC_CACHE_SLOTS 16
+
+struct tc_cache_slot {
+    int            fd;          /* -1 = empty */
+    uint64_t       gen;         /* Identity << 32 | generation */
+    struct termios attrs;
+};
+
+static struct tc_cache_slot g_tc_cache[TC_CACHE_SLOTS];
+static int g_tc_cache_init;
+static int g_tc_gen_supported = 1;  /* Cleared on first ENOSYS/EINVAL */
+
+static struct tc_cache_slot *tc_slot(int fd)
+{
+    if (!g_tc_cache_init) {
+        int i;
+
+        for (i = 0; i < TC_CACHE_SLOTS; i++)
+            g_tc_cache[i].fd = -1;
+        g_tc_cache_init = 1;
+    }
+    return &g_tc_cache[(unsigned int)fd % TC_CACHE_SLOTS];
+}
+
+/* Current identity+generation, or -1 when the kernel lacks it */
+static int tc_read_gen(int fd, uint64_t *gen)
+{
+    if (!g_tc_gen_supported)
+        return -1;
+    if (ioctl(fd, TCGETGEN, gen) < 0) {
+        if (errno == ENOSYS || errno == EINVAL)
+            g_tc_gen_supported = 0;
+        return -1;
+    }
+    return 0;
+}
+
 int tcgetattr(int fd, struct termios *termios_p)
 {
+    struct tc_cache_slot *slot;
+    uint64_t gen;
+
     if (!termios_p) {
         errno = EINVAL;
         return -1;
     }
 
-    return ioctl(fd, TCGETS, termios_p);
+    slot = tc_slot(fd);
+    if (slot->fd == fd && tc_read_gen(fd, &gen) == 0 &&
+        gen == slot->gen) {
+        /* Cache current: no TCGETS round-trip */
+        *termios_p = slot->attrs;
+        return 0;
+    }
+
+    if (ioctl(fd, TCGETS, termios_p) < 0)
+        return -1;
+
+    if (tc_read_gen(fd, &gen) == 0) {
+        slot->fd = fd;
+        slot->gen = gen;
+        slot->attrs = *termios_p;
+    } else {
+        slot->fd = -1;
+    }
+    return 0;
 }
 
 int tcsetattr(int fd, int optional_actions, const struct termios *termios_p)
 {
+    struct tc_cache_slot *slot;
+    uint64_t gen;
+
     if (!termios_p) {
         errno = EINVAL;
         return -1;
@@ -53,7 +133,32 @@ int tcsetattr(int fd, int optional_actions, const struct termios *termios_p)
         return -1;
     }
 
-    return ioctl(fd, request, (void *)termios_p);
+    /*
+     * Setting the attributes already in force is free: the cached
+     * struct plus a matching generation proves the kernel state, so
+     * the write (and with TCSAFLUSH its queue flush) can be elided.
+     * The flush matters only when attributes actually change mode,
+     * which identical attrs by definition don't.
+     */
+    slot = tc_slot(fd);
+    if (slot->fd == fd &&
+        memcmp(&slot->attrs, termios_p, sizeof(*termios_p)) == 0 &&
+        tc_read_gen(fd, &gen) == 0 && gen == slot->gen)
+        return 0;
+
+    if (ioctl(fd, request, (void *)termios_p) < 0) {
+        slot->fd = -1;
+        return -1;
+    }
+
+    if (tc_read_gen(fd, &gen) == 0) {
+        slot->fd = fd;
+        slot->gen = gen;
+        slot->attrs = *termios_p;
+    } else {
+        slot->fd = -1;
+    }
+    return 0;
 }
 
 speed_t cfgetispeed(const struct termios *termios_p)
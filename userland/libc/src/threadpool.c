@@ -0,0 +1,300 @@
+/*
+ * VeridianOS libc -- threadpool.c
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Shared work-stealing thread pool (veridian/threadpool.h).
+ *
+ * Every worker owns a bounded MPMC ring (per-slot sequence numbers,
+ * the same scheme as the journal ring): any thread may enqueue into
+ * any worker's ring, the owner drains its own first, and an idle
+ * worker steals one task at a time from the deepest peer queue.
+ * Single-task stealing keeps affinity-hinted batches together until
+ * imbalance actually materializes.  Workers pin themselves to one
+ * CPU each through SYS_THREAD_SET_AFFINITY so hint = CPU in the
+ * common sizing (pinning is advisory; kernels may decline).
+ */
+
+#include <veridian/threadpool.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <veridian/sched.h>
+#include <veridian/syscall.h>
+
+#define VTP_RING_SIZE 256               /* Tasks per worker, power of 2 */
+
+struct vtp_task {
+    uint32_t    seq;
+    vtp_task_fn fn;
+    void       *arg;
+};
+
+struct vtp_worker {
+    struct vtp_task ring[VTP_RING_SIZE];
+    uint32_t enq;                       /* Multi-producer cursor */
+    uint32_t deq;                       /* Multi-consumer cursor */
+};
+
+static struct vtp_worker g_workers[VTP_MAX_WORKERS];
+static int g_nworkers;
+static pthread_mutex_t g_vtp_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  g_vtp_work = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t  g_vtp_idle = PTHREAD_COND_INITIALIZER;
+static uint64_t g_submitted;
+static uint64_t g_executed;
+static uint64_t g_stolen;
+static uint32_t g_rr;                   /* Round-robin cursor */
+
+/* Worker count, safe against the unsynchronized startup read */
+static int vtp_n(void)
+{
+    return __atomic_load_n(&g_nworkers, __ATOMIC_ACQUIRE);
+}
+
+static uint32_t vtp_depth(const struct vtp_worker *w)
+{
+    uint32_t enq = __atomic_load_n(&w->enq, __ATOMIC_RELAXED);
+    uint32_t deq = __atomic_load_n(&w->deq, __ATOMIC_RELAXED);
+
+    return enq - deq;
+}
+
+/* Enqueue into one worker's ring; 0 or -1 when full */
+static int vtp_push(struct vtp_worker *w, vtp_task_fn fn, void *arg)
+{
+    uint32_t pos = __atomic_load_n(&w->enq, __ATOMIC_RELAXED);
+
+    for (;;) {
+        struct vtp_task *t = &w->ring[pos & (VTP_RING_SIZE - 1)];
+        uint32_t seq = __atomic_load_n(&t->seq, __ATOMIC_ACQUIRE);
+        int32_t dif = (int32_t)(seq - pos);
+
+        if (dif == 0) {
+            if (__atomic_compare_exchange_n(&w->enq, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED)) {
+                t->fn = fn;
+                t->arg = arg;
+                __atomic_store_n(&t->seq, pos + 1, __ATOMIC_RELEASE);
+                return 0;
+            }
+        } else if (dif < 0) {
+            return -1;                  /* Full */
+        } else {
+            pos = __atomic_load_n(&w->enq, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/* Dequeue from one worker's ring; 0 or -1 when empty */
+static int vtp_pop(struct vtp_worker *w, vtp_task_fn *fn, void **arg)
+{
+    uint32_t pos = __atomic_load_n(&w->deq, __ATOMIC_RELAXED);
+
+    for (;;) {
+        struct vtp_task *t = &w->ring[pos & (VTP_RING_SIZE - 1)];
+        uint32_t seq = __atomic_load_n(&t->seq, __ATOMIC_ACQUIRE);
+        int32_t dif = (int32_t)(seq - (pos + 1));
+
+        if (dif == 0) {
+            if (__atomic_compare_exchange_n(&w->deq, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED)) {
+                *fn = t->fn;
+                *arg = t->arg;
+                __atomic_store_n(&t->seq, pos + VTP_RING_SIZE,
+                                 __ATOMIC_RELEASE);
+                return 0;
+            }
+        } else if (dif < 0) {
+            return -1;                  /* Empty */
+        } else {
+            pos = __atomic_load_n(&w->deq, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/* The deepest peer queue, for stealing; -1 when all empty */
+static int vtp_victim(int self)
+{
+    int best = -1;
+    uint32_t best_depth = 0;
+    int i;
+
+    for (i = 0; i < vtp_n(); i++) {
+        uint32_t d;
+
+        if (i == self)
+            continue;
+        d = vtp_depth(&g_workers[i]);
+        if (d > best_depth) {
+            best_depth = d;
+            best = i;
+        }
+    }
+    return best;
+}
+
+static void *vtp_worker_main(void *arg)
+{
+    int self = (int)(long)arg;
+    struct vtp_worker *w = &g_workers[self];
+    uint64_t mask = 1ull << self;
+
+    /* Batch role keeps pool workers off the latency threads' cores
+     * under load; the per-CPU pin keeps the hint = CPU mapping */
+    veridian_sched_set_role(VSCHED_ROLE_BATCH);
+    (void)veridian_syscall2(SYS_THREAD_SET_AFFINITY, 0, (long)&mask);
+
+    for (;;) {
+        vtp_task_fn fn;
+        void *targ;
+        int stole = 0;
+
+        if (vtp_pop(w, &fn, &targ) < 0) {
+            int victim = vtp_victim(self);
+
+            if (victim < 0 ||
+                vtp_pop(&g_workers[victim], &fn, &targ) < 0) {
+                int i, pending = 0;
+
+                /* Nothing anywhere: sleep until a submit.  Re-check
+                 * depths under the lock -- a submit signals while
+                 * holding it, so a push that lands after this check
+                 * cannot have signaled before we wait. */
+                pthread_mutex_lock(&g_vtp_lock);
+                for (i = 0; i < vtp_n(); i++)
+                    if (vtp_depth(&g_workers[i]) > 0)
+                        pending = 1;
+                if (!pending) {
+                    if (g_executed == g_submitted)
+                        pthread_cond_broadcast(&g_vtp_idle);
+                    pthread_cond_wait(&g_vtp_work, &g_vtp_lock);
+                }
+                pthread_mutex_unlock(&g_vtp_lock);
+                continue;
+            }
+            stole = 1;
+        }
+
+        fn(targ);
+
+        pthread_mutex_lock(&g_vtp_lock);
+        g_executed++;
+        if (stole)
+            g_stolen++;
+        if (g_executed == g_submitted)
+            pthread_cond_broadcast(&g_vtp_idle);
+        pthread_mutex_unlock(&g_vtp_lock);
+    }
+    return NULL;
+}
+
+/* First use: one worker per online CPU */
+static void vtp_ensure_started(void)
+{
+    int n, i;
+
+    if (__atomic_load_n(&g_nworkers, __ATOMIC_ACQUIRE) > 0)
+        return;
+
+    pthread_mutex_lock(&g_vtp_lock);
+    if (g_nworkers > 0) {
+        pthread_mutex_unlock(&g_vtp_lock);
+        return;
+    }
+
+    n = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (n < 1)
+        n = 1;
+    if (n > VTP_MAX_WORKERS)
+        n = VTP_MAX_WORKERS;
+
+    for (i = 0; i < n; i++) {
+        uint32_t s;
+        pthread_t tid;
+
+        for (s = 0; s < VTP_RING_SIZE; s++)
+            g_workers[i].ring[s].seq = s;
+        if (pthread_create(&tid, NULL, vtp_worker_main,
+                           (void *)(long)i) != 0)
+            break;
+        pthread_detach(tid);
+    }
+    __atomic_store_n(&g_nworkers, i > 0 ? i : 0, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&g_vtp_lock);
+}
+
+int vtp_submit_affine(vtp_task_fn fn, void *arg, int hint)
+{
+    int target;
+    int tries;
+
+    if (!fn)
+        return -1;
+    int n;
+
+    vtp_ensure_started();
+    n = vtp_n();
+    if (n == 0)
+        return -1;                      /* No threads: caller runs it */
+
+    target = hint >= 0 ? hint % n
+                       : (int)(__atomic_fetch_add(&g_rr, 1,
+                                                  __ATOMIC_RELAXED) %
+                               (uint32_t)n);
+
+    /* Hinted ring first, then spill to the others before reporting
+     * the pool full */
+    for (tries = 0; tries < n; tries++) {
+        if (vtp_push(&g_workers[(target + tries) % n], fn,
+                     arg) == 0) {
+            pthread_mutex_lock(&g_vtp_lock);
+            g_submitted++;
+            pthread_cond_signal(&g_vtp_work);
+            pthread_mutex_unlock(&g_vtp_lock);
+            return 0;
+        }
+    }
+    return -1;
+}
+
+int vtp_submit(vtp_task_fn fn, void *arg)
+{
+    return vtp_submit_affine(fn, arg, -1);
+}
+
+void vtp_wait_idle(void)
+{
+    pthread_mutex_lock(&g_vtp_lock);
+    while (g_executed != g_submitted)
+        pthread_cond_wait(&g_vtp_idle, &g_vtp_lock);
+    pthread_mutex_unlock(&g_vtp_lock);
+}
+
+int vtp_thread_count(void)
+{
+    return __atomic_load_n(&g_nworkers, __ATOMIC_ACQUIRE);
+}
+
+void vtp_get_stats(struct vtp_stats *out)
+{
+    int i;
+
+    if (!out)
+        return;
+    memset(out, 0, sizeof(*out));
+    pthread_mutex_lock(&g_vtp_lock);
+    out->submitted = g_submitted;
+    out->executed = g_executed;
+    out->stolen = g_stolen;
+    pthread_mutex_unlock(&g_vtp_lock);
+    out->workers = (uint32_t)vtp_n();
+    for (i = 0; i < (int)out->workers; i++)
+        out->queue_depth[i] = vtp_depth(&g_workers[i]);
+}
@@ -5,12 +5,144 @@
  * SPDX-License-Identifier: MIT OR Apache-2.0
  *
  * Time-related functions backed by VeridianOS syscalls.
+ *
+ * clock_gettime and gettimeofday take a vDSO-style fast path when
+ * the kernel provides the shared time page (veridian/timepage.h):
+ * timestamps are computed in pure userspace from the cycle counter
+ * and the page's conversion factors under a seqlock, with the
+ * syscall kept as the fallback for unsupported clocks, architectures
+ * without a userspace counter read, or kernels without the page.
  */
 
 #include <time.h>
 #include <veridian/syscall.h>
+#include <veridian/timepage.h>
 #include <errno.h>
 #include <stddef.h>
+#include <stdint.h>
+
+/* ========================================================================= */
+/* Shared time page fast path                                                */
+/* ========================================================================= */
+
+/* Userspace cycle counter read; 0 = no support on this arch */
+static inline uint64_t read_cycle_counter(void)
+{
+#if defined(__x86_64__)
+    uint32_t lo, hi;
+
+    __asm__ volatile("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((uint64_t)hi << 32) | lo;
+#elif defined(__aarch64__)
+    uint64_t v;
+
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#elif defined(__riscv)
+    uint64_t v;
+
+    __asm__ volatile("rdtime %0" : "=r"(v));
+    return v;
+#else
+    return 0;
+#endif
+}
+
+#if defined(__x86_64__) || defined(__aarch64__) || defined(__riscv)
+#define TIMEPAGE_SUPPORTED 1
+#else
+#define TIMEPAGE_SUPPORTED 0
+#endif
+
+/* 0 = untried, 1 = active, -1 = unavailable (use the syscall) */
+static struct veridian_time_page *g_time_page;
+static int g_time_page_state;
+
+static struct veridian_time_page *time_page(void)
+{
+    if (g_time_page_state == 0) {
+        long addr = -1;
+
+        if (TIMEPAGE_SUPPORTED)
+            addr = veridian_syscall0(SYS_TIME_GET_PAGE);
+
+        if (addr > 0 &&
+            ((struct veridian_time_page *)addr)->magic ==
+                VERIDIAN_TIMEPAGE_MAGIC &&
+            ((struct veridian_time_page *)addr)->version ==
+                VERIDIAN_TIMEPAGE_VERSION) {
+            g_time_page = (struct veridian_time_page *)addr;
+            g_time_page_state = 1;
+        } else {
+            g_time_page_state = -1;
+        }
+    }
+    return g_time_page_state == 1 ? g_time_page : NULL;
+}
+
+/* Convert a counter delta to nanoseconds (128-bit intermediate) */
+static inline uint64_t counter_to_ns(uint64_t delta, uint64_t mult,
+                                     uint32_t shift)
+{
+    return (uint64_t)(((unsigned __int128)delta * mult) >> shift);
+}
+
+/*
+ * Seqlock-stable timestamp from the shared page.  Returns 0 on
+ * success, -1 when the page can't serve this clock.
+ */
+static int time_page_gettime(clockid_t clk_id, struct timespec *tp)
+{
+    struct veridian_time_page *pg = time_page();
+
+    if (!pg || (clk_id != CLOCK_MONOTONIC && clk_id != CLOCK_REALTIME))
+        return -1;
+
+    /* Bounded retries: a wedged page must degrade to the syscall,
+     * not hang every caller */
+    for (int tries = 0; tries < 1000; tries++) {
+        uint32_t seq = __atomic_load_n(&pg->seq, __ATOMIC_ACQUIRE);
+
+        if (seq & 1)
+            continue;   /* kernel mid-update */
+
+        uint64_t mult   = pg->counter_mult;
+        uint32_t shift  = pg->counter_shift;
+        uint64_t basec  = pg->base_counter;
+        uint64_t mono   = pg->base_mono_ns;
+        uint64_t rsec   = pg->base_real_sec;
+        uint64_t rnsec  = pg->base_real_nsec;
+        uint64_t now    = read_cycle_counter();
+
+        /* Seqlock read protocol: the fence orders the data reads
+         * above BEFORE the re-read of seq.  An acquire on the
+         * re-read alone orders only what comes after it, so on
+         * AArch64/RISC-V a torn read could pass validation. */
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&pg->seq, __ATOMIC_RELAXED) != seq)
+            continue;   /* torn read, retry */
+
+        if (mult == 0 || now < basec)
+            return -1;  /* page not armed / counter went backwards */
+
+        uint64_t ns = counter_to_ns(now - basec, mult, shift);
+
+        if (clk_id == CLOCK_MONOTONIC) {
+            uint64_t t = mono + ns;
+
+            tp->tv_sec = (time_t)(t / 1000000000ull);
+            tp->tv_nsec = (long)(t % 1000000000ull);
+        } else {
+            uint64_t nsec = rnsec + ns;
+
+            tp->tv_sec = (time_t)(rsec + nsec / 1000000000ull);
+            tp->tv_nsec = (long)(nsec % 1000000000ull);
+        }
+        return 0;
+    }
+
+    return -1;  /* seqlock never settled */
+}
 
 /* ========================================================================= */
 /* clock_gettime                                                             */
@@ -18,6 +150,9 @@
 
 int clock_gettime(clockid_t clk_id, struct timespec *tp)
 {
+    if (tp && time_page_gettime(clk_id, tp) == 0)
+        return 0;
+
     long ret = veridian_syscall2(SYS_CLOCK_GETTIME, clk_id, tp);
     if (ret < 0) {
         errno = (int)(-ret);
@@ -61,6 +196,15 @@ int gettimeofday(struct timeval *tv, struct timezone *tz)
     if (!tv)
         return 0;
 
+    /* Same fast path as clock_gettime(CLOCK_REALTIME) */
+    struct timespec ts;
+
+    if (time_page_gettime(CLOCK_REALTIME, &ts) == 0) {
+        tv->tv_sec = ts.tv_sec;
+        tv->tv_usec = ts.tv_nsec / 1000;
+        return 0;
+    }
+
     long ret = veridian_syscall2(SYS_GETTIMEOFDAY, tv, tz);
     if (ret < 0) {
         errno = (int)(-ret);
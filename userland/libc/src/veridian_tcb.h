@@ -0,0 +1,34 @@
+/*
+ * VeridianOS libc -- veridian_tcb.h (internal)
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * The thread-control-block layout contract shared by errno.c,
+ * pthread.c, and ld-veridian's TLS block sizing.  The TLS ABI puts
+ * the self pointer at the thread pointer; errno sits in the next
+ * slot so __veridian_errno_location() is one tp-relative load; and
+ * the loader reserves VERIDIAN_TCB_RESERVE bytes at the thread
+ * pointer for the full struct pthread_control.  Each consumer
+ * _Static_asserts its piece of the contract against this header, so
+ * a drift in any file is a compile error, not a corrupted TCB.
+ *
+ * No libc includes here: ld-veridian (freestanding, no headers by
+ * design) includes this file too.
+ */
+
+#ifndef _VERIDIAN_TCB_H
+#define _VERIDIAN_TCB_H
+
+/* The head every TCB-resident consumer may rely on */
+struct __veridian_tcb_head {
+    void *self;        /* MUST stay first: TLS ABI self pointer */
+    int   errno_val;   /* per-thread errno */
+    int   _pad0;
+};
+
+/* Bytes the loader reserves at the thread pointer for the full
+ * struct pthread_control (pthread.c asserts it fits) */
+#define VERIDIAN_TCB_RESERVE 256
+
+#endif /* _VERIDIAN_TCB_H */
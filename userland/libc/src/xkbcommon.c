@@ -14,9 +14,13 @@
 #include <xkbcommon/xkbcommon-keysyms.h>
 #include <xkbcommon/xkbcommon-names.h>
 #include <xkbcommon/xkbcommon-compose.h>
+#include <fcntl.h>
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 /* ========================================================================= */
 /* Internal limits                                                           */
@@ -42,6 +46,42 @@ struct xkb_context {
     int                  log_verbosity;
 };
 
+/* ========================================================================= */
+/* Compiled keymap                                                           */
+/* ========================================================================= */
+
+/*
+ * Keymaps are compiled once into a sorted keycode table and cached in
+ * a binary file that every client maps read-only (the same pattern as
+ * the GL program-binary and Qt theme caches).  A keystroke then costs
+ * a binary search over the mapping instead of re-walking the layout
+ * description, and only the first client after boot or a layout
+ * change pays the compile.
+ */
+
+#define VXKB_MAGIC   0x424b5856u    /* 'VXKB' */
+#define VXKB_VERSION 1u
+#define VXKB_MAX_ENTRIES 512u
+
+/* Shift/Caps behavior flags */
+#define VXKB_FLAG_LETTER 0x1u       /* Caps Lock acts as Shift */
+
+struct vxkb_entry {
+    uint32_t keycode;               /* Sorted ascending */
+    uint32_t sym;                   /* Level 0 */
+    uint32_t shifted_sym;           /* Level 1 */
+    uint32_t flags;
+};
+
+struct vxkb_header {
+    uint32_t magic;                 /* Stored last on creation */
+    uint32_t version;
+    uint64_t layout_hash;
+    uint32_t entry_count;
+    uint32_t _pad;
+    struct vxkb_entry entries[VXKB_MAX_ENTRIES];
+};
+
 struct xkb_keymap {
     int                  in_use;
     int                  ref_count;
@@ -50,6 +90,9 @@ struct xkb_keymap {
     const char          *mod_names[NUM_MODS];
     /* LED names */
     const char          *led_names[NUM_LEDS];
+
+    /* Compiled form, mapped read-only and shared across clients */
+    const struct vxkb_header *compiled;
 };
 
 struct xkb_state {
@@ -214,6 +257,171 @@ static xkb_keysym_t keycode_to_keysym(xkb_keycode_t keycode,
     return sym;
 }
 
+/* ========================================================================= */
+/* Compiled keymap cache                                                     */
+/* ========================================================================= */
+
+static const struct vxkb_header *g_vxkb;    /* Shared mapping, or NULL */
+static uint64_t g_vxkb_hash;                /* Layout hash of g_vxkb   */
+
+static uint64_t vxkb_hash(const char *str)
+{
+    uint64_t h = 0xcbf29ce484222325ULL ^ VXKB_VERSION;
+
+    for (; str && *str; str++) {
+        h ^= (unsigned char)*str;
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+/*
+ * Compile the layout into the sorted keycode table.  The layout
+ * walker (keycode_to_keysym) runs once per keycode here -- at compile
+ * time -- instead of once per keystroke forever after.
+ */
+static void vxkb_compile(struct vxkb_header *out, uint64_t layout_hash)
+{
+    uint32_t kc;
+
+    memset(out, 0, sizeof(*out));
+    out->version = VXKB_VERSION;
+    out->layout_hash = layout_hash;
+
+    for (kc = 8; kc < 8 + 248 && out->entry_count < VXKB_MAX_ENTRIES;
+         kc++) {
+        xkb_keysym_t base = keycode_to_keysym(kc, 0);
+        xkb_keysym_t shifted = keycode_to_keysym(kc, 0x01);
+
+        if (base == XKB_KEY_NoSymbol && shifted == XKB_KEY_NoSymbol)
+            continue;
+
+        {
+            struct vxkb_entry *e = &out->entries[out->entry_count++];
+
+            e->keycode = kc;
+            /* The walker applies Shift itself; store the unshifted
+             * level-0 sym (lowercase for letters) */
+            e->sym = base;
+            e->shifted_sym = shifted;
+            e->flags = (base >= 'a' && base <= 'z') ? VXKB_FLAG_LETTER
+                                                    : 0;
+        }
+    }
+
+    /* Publication order: magic last, so mappers never see a torn
+     * table */
+    __atomic_store_n(&out->magic, VXKB_MAGIC, __ATOMIC_RELEASE);
+}
+
+/* Map (compiling on first use) the shared keymap for this layout */
+static const struct vxkb_header *vxkb_acquire(const char *layout_name)
+{
+    char path[256];
+    uint64_t layout_hash;
+    int fd;
+    struct stat st;
+    void *map;
+
+    layout_hash = vxkb_hash(layout_name ? layout_name : "default");
+
+    if (g_vxkb) {
+        if (g_vxkb_hash == layout_hash)
+            return g_vxkb;
+        /* Layout switch: map the new table.  The old mapping stays
+         * alive -- keymaps created against it keep their pointer, and
+         * a process touches at most a handful of layouts. */
+        g_vxkb = NULL;
+    }
+    snprintf(path, sizeof(path), "/var/cache/veridian/xkbmap-%08x.cache",
+             (unsigned)(layout_hash & 0xffffffffu));
+    mkdir("/var/cache/veridian", 0755);
+
+    fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+        return NULL;
+
+    if (fstat(fd, &st) < 0 ||
+        (st.st_size != 0 &&
+         st.st_size != (off_t)sizeof(struct vxkb_header))) {
+        if (ftruncate(fd, 0) < 0) {
+            close(fd);
+            return NULL;
+        }
+        st.st_size = 0;
+    }
+    if (st.st_size == 0 &&
+        ftruncate(fd, sizeof(struct vxkb_header)) < 0) {
+        close(fd);
+        return NULL;
+    }
+
+    map = mmap(NULL, sizeof(struct vxkb_header),
+               PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return NULL;
+
+    {
+        struct vxkb_header *h = (struct vxkb_header *)map;
+
+        if (__atomic_load_n(&h->magic, __ATOMIC_ACQUIRE) != VXKB_MAGIC ||
+            h->version != VXKB_VERSION ||
+            h->layout_hash != layout_hash) {
+            vxkb_compile(h, layout_hash);
+        }
+        g_vxkb = h;
+        g_vxkb_hash = layout_hash;
+    }
+    return g_vxkb;
+}
+
+/* Per-keystroke resolution: binary search over the sorted table */
+static xkb_keysym_t vxkb_lookup(const struct vxkb_header *map,
+                                xkb_keycode_t keycode,
+                                xkb_mod_mask_t mods)
+{
+    uint32_t lo = 0;
+    uint32_t hi;
+    int shift = (mods & 0x01) != 0;
+    int caps = (mods & 0x02) != 0;
+
+    if (!map || map->entry_count == 0)
+        return keycode_to_keysym(keycode, mods);
+
+    hi = map->entry_count;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        const struct vxkb_entry *e = &map->entries[mid];
+
+        if (e->keycode < keycode) {
+            lo = mid + 1;
+        } else if (e->keycode > keycode) {
+            hi = mid;
+        } else {
+            xkb_keysym_t sym;
+
+            if (e->flags & VXKB_FLAG_LETTER)
+                sym = (shift ^ caps) ? e->shifted_sym : e->sym;
+            else
+                sym = shift ? e->shifted_sym : e->sym;
+            return sym;
+        }
+    }
+    return XKB_KEY_NoSymbol;
+}
+
+/* Resolve through a keymap's compiled table (layout-walker fallback
+ * when the cache could not be mapped) */
+static xkb_keysym_t keymap_resolve(const struct xkb_keymap *keymap,
+                                   xkb_keycode_t keycode,
+                                   xkb_mod_mask_t mods)
+{
+    if (keymap && keymap->compiled)
+        return vxkb_lookup(keymap->compiled, keycode, mods);
+    return keycode_to_keysym(keycode, mods);
+}
+
 /* ========================================================================= */
 /* Keysym operations                                                         */
 /* ========================================================================= */
@@ -475,7 +683,6 @@ struct xkb_keymap *xkb_keymap_new_from_names(struct xkb_context *context,
                                                  enum xkb_keymap_compile_flags flags)
 {
     int i;
-    (void)names;
     (void)flags;
 
     if (!context) return NULL;
@@ -486,6 +693,10 @@ struct xkb_keymap *xkb_keymap_new_from_names(struct xkb_context *context,
             g_keymaps[i].in_use    = 1;
             g_keymaps[i].ref_count = 1;
             init_keymap_defaults(&g_keymaps[i], context);
+            /* Shared compiled table; NULL leaves the layout-walker
+             * fallback in place */
+            g_keymaps[i].compiled = vxkb_acquire(
+                (names && names->layout) ? names->layout : NULL);
             return &g_keymaps[i];
         }
     }
@@ -610,7 +821,7 @@ int xkb_keymap_key_get_syms_by_level(struct xkb_keymap *keymap,
     (void)layout;
 
     if (level > 0) mods = 0x01;  /* Shift */
-    sym = keycode_to_keysym(key, mods);
+    sym = keymap_resolve(keymap, key, mods);
 
     if (sym == XKB_KEY_NoSymbol) {
         if (syms_out) *syms_out = NULL;
@@ -682,10 +893,9 @@ xkb_led_index_t xkb_keymap_led_get_index(struct xkb_keymap *keymap,
 int xkb_keymap_key_repeats(struct xkb_keymap *keymap, xkb_keycode_t key)
 {
     xkb_keysym_t sym;
-    (void)keymap;
 
     /* Modifier keys don't repeat */
-    sym = keycode_to_keysym(key, 0);
+    sym = keymap_resolve(keymap, key, 0);
     if (sym >= XKB_KEY_Shift_L && sym <= XKB_KEY_Hyper_R)
         return 0;
     if (sym == XKB_KEY_Caps_Lock || sym == XKB_KEY_Num_Lock)
@@ -747,7 +957,7 @@ xkb_state_update_key(struct xkb_state *state, xkb_keycode_t key,
 
     if (!state) return 0;
 
-    sym = keycode_to_keysym(key, 0);
+    sym = keymap_resolve(state->keymap, key, 0);
 
     /* Determine which modifier this key controls */
     switch (sym) {
@@ -812,7 +1022,7 @@ int xkb_state_key_get_syms(struct xkb_state *state, xkb_keycode_t key,
 
     xkb_mod_mask_t effective = state->mods_depressed | state->mods_latched |
                                 state->mods_locked;
-    state->last_sym = keycode_to_keysym(key, effective);
+    state->last_sym = keymap_resolve(state->keymap, key, effective);
 
     if (state->last_sym == XKB_KEY_NoSymbol) {
         if (syms_out) *syms_out = NULL;
@@ -18,6 +18,7 @@
 
 #include "curses.h"
 #include <stdio.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <termios.h>
@@ -149,6 +150,48 @@ static void _move_cursor(int row, int col)
     _put_raw(buf, pos);
 }
 
+/*
+ * Cursor-motion minimization: pick the cheapest sequence to get from
+ * (from_row, from_col) to (row, col).  With OPOST off, "\n" is a pure
+ * line feed (down one, same column) and "\r" is carriage return, so
+ * short hops cost one byte each instead of an 8-byte CUP.
+ */
+static void _goto_cell(int row, int col, int from_row, int from_col)
+{
+    if (from_row == row && from_col == col)
+        return;
+
+    if (from_row >= 0) {
+        if (row == from_row) {
+            if (col == 0) {
+                _put_raw("\r", 1);
+                return;
+            }
+            /* Relative horizontal move: ESC [ n C/D is never longer
+             * than an absolute CUP on the same row */
+            int delta = col - from_col;
+            char buf[8];
+            int pos = 0;
+            buf[pos++] = '\033';
+            buf[pos++] = '[';
+            if (delta < 0) delta = -delta;
+            if (delta > 1)
+                pos += _itoa(delta, buf + pos);
+            buf[pos++] = col > from_col ? 'C' : 'D';
+            _put_raw(buf, pos);
+            return;
+        } else if (col == 0 && row > from_row && row - from_row <= 3) {
+            if (from_col != 0)
+                _put_raw("\r", 1);
+            for (int i = 0; i < row - from_row; i++)
+                _put_raw("\n", 1);
+            return;
+        }
+    }
+
+    _move_cursor(row, col);
+}
+
 /* Apply SGR (Select Graphic Rendition) for attributes + color pair */
 static void _apply_attrs(attr_t attrs)
 {
@@ -228,17 +271,30 @@ static WINDOW *_alloc_window(int nlines, int ncols, int begin_y, int begin_x)
     win->_nodelay = 0;
     win->_clearok = 1; /* Force full draw on first refresh */
 
-    int size = nlines * ncols;
+    /* Rows are contiguous and cache-line aligned: the stride pads
+     * each row to a 64-byte boundary (8 cells), so the refresh diff
+     * walks whole lines with aligned 64-bit loads and an 80x25
+     * screen compares in 250 cache lines flat */
+    win->_stride = (ncols + 7) & ~7;
+
+    int size = nlines * win->_stride;
     if (size > 0) {
-        win->_line = (chtype *)calloc(size, sizeof(chtype));
-        win->_prev = (chtype *)calloc(size, sizeof(chtype));
-        if (!win->_line || !win->_prev) {
-            free(win->_line);
-            free(win->_prev);
+        win->_line_alloc =
+            (chtype *)calloc((size_t)size + 8, sizeof(chtype));
+        win->_prev_alloc =
+            (chtype *)calloc((size_t)size + 8, sizeof(chtype));
+        if (!win->_line_alloc || !win->_prev_alloc) {
+            free(win->_line_alloc);
+            free(win->_prev_alloc);
             free(win);
             return NULL;
         }
-        /* Fill with spaces */
+        win->_line = (chtype *)(((uintptr_t)win->_line_alloc + 63) &
+                                ~(uintptr_t)63);
+        win->_prev = (chtype *)(((uintptr_t)win->_prev_alloc + 63) &
+                                ~(uintptr_t)63);
+        /* Fill with spaces (padding cells included, so row compares
+         * over the stride are well-defined) */
         for (int i = 0; i < size; i++) {
             win->_line[i] = ' ' | A_NORMAL;
             win->_prev[i] = 0; /* Force initial diff */
@@ -251,8 +307,8 @@ static WINDOW *_alloc_window(int nlines, int ncols, int begin_y, int begin_x)
 static void _free_window(WINDOW *win)
 {
     if (!win) return;
-    free(win->_line);
-    free(win->_prev);
+    free(win->_line_alloc);
+    free(win->_prev_alloc);
     free(win);
 }
 
@@ -264,12 +320,13 @@ static void _scroll_up(WINDOW *win)
     int lines = win->_maxy;
     /* Move lines 1..n-1 up to 0..n-2 */
     if (lines > 1) {
-        memmove(win->_line, win->_line + cols, (lines - 1) * cols * sizeof(chtype));
+        memmove(win->_line, win->_line + win->_stride,
+                (size_t)(lines - 1) * win->_stride * sizeof(chtype));
     }
     /* Clear last line */
     chtype fill = ' ' | (win->_bkgd & A_ATTRIBUTES);
     for (int i = 0; i < cols; i++) {
-        win->_line[(lines - 1) * cols + i] = fill;
+        win->_line[(lines - 1) * win->_stride + i] = fill;
     }
 }
 
@@ -612,7 +669,7 @@ int waddch(WINDOW *win, const chtype ch)
     /* Write character to virtual buffer */
     if (win->_cury >= 0 && win->_cury < win->_maxy &&
         win->_curx >= 0 && win->_curx < win->_maxx) {
-        win->_line[win->_cury * win->_maxx + win->_curx] = c;
+        win->_line[win->_cury * win->_stride + win->_curx] = c;
     }
 
     /* Advance cursor */
@@ -987,10 +1044,15 @@ int wrefresh(WINDOW *win)
         return doupdate();
     }
 
+    /* Physical cursor position, tracked across refreshes so motion
+     * can be minimized against where the terminal actually is.
+     * -1 = unknown (forces an absolute CUP). */
+    static int _phys_row = -1;
+    static int _phys_col = -1;
+
     int rows = win->_maxy;
     int cols = win->_maxx;
     attr_t cur_attrs = A_NORMAL;
-    int last_row = -1, last_col = -1;
 
     if (win->_clearok) {
         /* Full screen clear + redraw */
@@ -999,43 +1061,82 @@ int wrefresh(WINDOW *win)
         cur_attrs = A_NORMAL;
         /* Mark all previous as dirty */
         if (win->_prev) {
-            memset(win->_prev, 0xFF, rows * cols * sizeof(chtype));
+            memset(win->_prev, 0xFF,
+                   (size_t)rows * win->_stride * sizeof(chtype));
         }
         win->_clearok = 0;
+        _phys_row = -1;
+        _phys_col = -1;
     }
 
+    /*
+     * Damage diff: compare the virtual and physical rows and emit
+     * only changed spans.  Clean rows are rejected with one memcmp
+     * (vectorized in libc); within a dirty row, unchanged runs are
+     * skipped a 64-bit word (two cells) at a time.  Gaps of up to
+     * four unchanged cells inside a span are overwritten rather than
+     * paid for with a cursor-motion sequence.
+     */
     for (int y = 0; y < rows; y++) {
-        for (int x = 0; x < cols; x++) {
-            int idx = y * cols + x;
-            chtype newch = win->_line[idx];
-
-            /* Skip if unchanged */
-            if (win->_prev && win->_prev[idx] == newch)
-                continue;
-
-            /* Move cursor if needed */
-            if (y != last_row || x != last_col) {
-                _move_cursor(y + win->_begy, x + win->_begx);
+        chtype *vrow = &win->_line[y * win->_stride];
+        chtype *prow = win->_prev ? &win->_prev[y * win->_stride] : NULL;
+
+        if (prow && memcmp(vrow, prow, (size_t)cols * sizeof(chtype)) == 0)
+            continue;
+
+        int x = 0;
+        while (x < cols) {
+            /* Find the next changed cell: one aligned 64-bit load
+             * per cell, rows are cache-line aligned by construction */
+            if (prow) {
+                while (x < cols && vrow[x] == prow[x])
+                    x++;
+                if (x >= cols)
+                    break;
             }
 
-            /* Update attributes if changed */
-            attr_t new_attrs = newch & A_ATTRIBUTES;
-            if (new_attrs != cur_attrs) {
-                _apply_attrs(new_attrs);
-                cur_attrs = new_attrs;
+            /* Extend the span, bridging unchanged gaps of <= 4 cells
+             * (re-emitting them is cheaper than a cursor move) */
+            int span_end = x;      /* one past the last changed cell */
+            int scan = x;
+            while (scan < cols) {
+                if (!prow || vrow[scan] != prow[scan]) {
+                    span_end = scan + 1;
+                    scan++;
+                } else {
+                    int gap = 0;
+                    while (scan + gap < cols && gap <= 4 &&
+                           vrow[scan + gap] == prow[scan + gap])
+                        gap++;
+                    if (scan + gap >= cols || gap > 4)
+                        break;
+                    scan += gap;   /* bridge it */
+                }
             }
 
-            /* Output the character */
-            char c = (char)(newch & A_CHARTEXT);
-            if (c < 0x20 || c == 0x7F) c = ' ';  /* Non-printable -> space */
-            _put_raw(&c, 1);
+            _goto_cell(y + win->_begy, x + win->_begx,
+                       _phys_row, _phys_col);
+
+            for (int i = x; i < span_end; i++) {
+                chtype newch = vrow[i];
+                attr_t new_attrs = newch & A_ATTRIBUTES;
 
-            last_row = y;
-            last_col = x + 1;
+                if (new_attrs != cur_attrs) {
+                    _apply_attrs(new_attrs);
+                    cur_attrs = new_attrs;
+                }
 
-            /* Update prev buffer */
-            if (win->_prev)
-                win->_prev[idx] = newch;
+                char c = (char)(newch & A_CHARTEXT);
+                if (c < 0x20 || c == 0x7F) c = ' ';
+                _put_raw(&c, 1);
+
+                if (prow)
+                    prow[i] = newch;
+            }
+
+            _phys_row = y + win->_begy;
+            _phys_col = span_end + win->_begx;
+            x = span_end;
         }
     }
 
@@ -1046,7 +1147,10 @@ int wrefresh(WINDOW *win)
 
     /* Position cursor at window cursor position */
     if (!win->_leaveok) {
-        _move_cursor(win->_cury + win->_begy, win->_curx + win->_begx);
+        _goto_cell(win->_cury + win->_begy, win->_curx + win->_begx,
+                   _phys_row, _phys_col);
+        _phys_row = win->_cury + win->_begy;
+        _phys_col = win->_curx + win->_begx;
     }
 
     /* Show/hide cursor */
@@ -1073,7 +1177,7 @@ int wnoutrefresh(WINDOW *win)
         for (int x = 0; x < win->_maxx; x++) {
             int sx = x + win->_begx;
             if (sx < 0 || sx >= stdscr->_maxx) continue;
-            stdscr->_line[sy * stdscr->_maxx + sx] = win->_line[y * win->_maxx + x];
+            stdscr->_line[sy * stdscr->_stride + sx] = win->_line[y * win->_stride + x];
         }
     }
     return OK;
@@ -1106,7 +1210,7 @@ int werase(WINDOW *win)
 {
     if (!win || !win->_line) return ERR;
     chtype fill = ' ' | (win->_bkgd & A_ATTRIBUTES);
-    int size = win->_maxy * win->_maxx;
+    int size = win->_maxy * win->_stride;
     for (int i = 0; i < size; i++)
         win->_line[i] = fill;
     win->_cury = 0;
@@ -1132,7 +1236,7 @@ int wclrtoeol(WINDOW *win)
     chtype fill = ' ' | (win->_bkgd & A_ATTRIBUTES);
     int y = win->_cury;
     for (int x = win->_curx; x < win->_maxx; x++)
-        win->_line[y * win->_maxx + x] = fill;
+        win->_line[y * win->_stride + x] = fill;
     return OK;
 }
 
@@ -1147,7 +1251,7 @@ int wclrtobot(WINDOW *win)
     chtype fill = ' ' | (win->_bkgd & A_ATTRIBUTES);
     for (int y = win->_cury + 1; y < win->_maxy; y++)
         for (int x = 0; x < win->_maxx; x++)
-            win->_line[y * win->_maxx + x] = fill;
+            win->_line[y * win->_stride + x] = fill;
     return OK;
 }
 
@@ -1433,8 +1537,8 @@ int wdelch(WINDOW *win)
     chtype fill = ' ' | (win->_bkgd & A_ATTRIBUTES);
     /* Shift characters left */
     for (int i = x; i < cols - 1; i++)
-        win->_line[y * cols + i] = win->_line[y * cols + i + 1];
-    win->_line[y * cols + cols - 1] = fill;
+        win->_line[y * win->_stride + i] = win->_line[y * win->_stride + i + 1];
+    win->_line[y * win->_stride + cols - 1] = fill;
     return OK;
 }
 
@@ -1460,10 +1564,10 @@ int winsch(WINDOW *win, chtype ch)
     int cols = win->_maxx;
     /* Shift characters right */
     for (int i = cols - 1; i > x; i--)
-        win->_line[y * cols + i] = win->_line[y * cols + i - 1];
+        win->_line[y * win->_stride + i] = win->_line[y * win->_stride + i - 1];
     chtype c = ch;
     if ((c & A_ATTRIBUTES) == 0) c |= win->_attrs;
-    win->_line[y * cols + x] = c;
+    win->_line[y * win->_stride + x] = c;
     return OK;
 }
 
@@ -1492,18 +1596,18 @@ int winsdelln(WINDOW *win, int n)
     if (n > 0) {
         /* Insert n lines: shift down */
         for (int r = rows - 1; r >= y + n; r--)
-            memcpy(win->_line + r * cols, win->_line + (r - n) * cols, cols * sizeof(chtype));
+            memcpy(win->_line + r * win->_stride, win->_line + (r - n) * win->_stride, cols * sizeof(chtype));
         for (int r = y; r < y + n && r < rows; r++)
             for (int c = 0; c < cols; c++)
-                win->_line[r * cols + c] = fill;
+                win->_line[r * win->_stride + c] = fill;
     } else if (n < 0) {
         /* Delete |n| lines: shift up */
         int d = -n;
         for (int r = y; r < rows - d; r++)
-            memcpy(win->_line + r * cols, win->_line + (r + d) * cols, cols * sizeof(chtype));
+            memcpy(win->_line + r * win->_stride, win->_line + (r + d) * win->_stride, cols * sizeof(chtype));
         for (int r = rows - d; r < rows; r++)
             for (int c = 0; c < cols; c++)
-                win->_line[r * cols + c] = fill;
+                win->_line[r * win->_stride + c] = fill;
     }
     return OK;
 }
@@ -1668,7 +1772,7 @@ int wbkgd(WINDOW *win, chtype ch)
     char new_char = (char)(ch & A_CHARTEXT);
     if (new_char == 0) new_char = ' ';
 
-    int size = win->_maxy * win->_maxx;
+    int size = win->_maxy * win->_stride;
     for (int i = 0; i < size; i++) {
         chtype cell = win->_line[i];
         /* Replace old background char with new */
@@ -1706,7 +1810,7 @@ int getparx(WINDOW *win) { return (win && win->_parent) ? win->_begx - win->_par
 chtype winch(WINDOW *win)
 {
     if (!win || !win->_line) return ERR;
-    return win->_line[win->_cury * win->_maxx + win->_curx];
+    return win->_line[win->_cury * win->_stride + win->_curx];
 }
 
 chtype inch(void) { return winch(stdscr); }
@@ -1900,14 +2004,21 @@ int resizeterm(int lines, int columns)
 int wresize(WINDOW *win, int lines, int columns)
 {
     if (!win) return ERR;
-    int new_size = lines * columns;
-    chtype *new_line = (chtype *)calloc(new_size, sizeof(chtype));
-    chtype *new_prev = (chtype *)calloc(new_size, sizeof(chtype));
-    if (!new_line || !new_prev) {
-        free(new_line);
-        free(new_prev);
+    int new_stride = (columns + 7) & ~7;
+    int new_size = lines * new_stride;
+    chtype *new_line_alloc =
+        (chtype *)calloc((size_t)new_size + 8, sizeof(chtype));
+    chtype *new_prev_alloc =
+        (chtype *)calloc((size_t)new_size + 8, sizeof(chtype));
+    if (!new_line_alloc || !new_prev_alloc) {
+        free(new_line_alloc);
+        free(new_prev_alloc);
         return ERR;
     }
+    chtype *new_line = (chtype *)(((uintptr_t)new_line_alloc + 63) &
+                                  ~(uintptr_t)63);
+    chtype *new_prev = (chtype *)(((uintptr_t)new_prev_alloc + 63) &
+                                  ~(uintptr_t)63);
 
     /* Initialize with background */
     chtype fill = ' ' | (win->_bkgd & A_ATTRIBUTES);
@@ -1922,13 +2033,17 @@ int wresize(WINDOW *win, int lines, int columns)
         int copy_cols = win->_maxx < columns ? win->_maxx : columns;
         for (int y = 0; y < copy_rows; y++)
             for (int x = 0; x < copy_cols; x++)
-                new_line[y * columns + x] = win->_line[y * win->_maxx + x];
-        free(win->_line);
+                new_line[y * new_stride + x] =
+                    win->_line[y * win->_stride + x];
+        free(win->_line_alloc);
     }
-    free(win->_prev);
+    free(win->_prev_alloc);
 
     win->_line = new_line;
     win->_prev = new_prev;
+    win->_line_alloc = new_line_alloc;
+    win->_prev_alloc = new_prev_alloc;
+    win->_stride = new_stride;
     win->_maxy = lines;
     win->_maxx = columns;
 
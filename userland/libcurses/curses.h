@@ -26,7 +26,14 @@ extern "C" {
 /* Types                                                                     */
 /* ========================================================================= */
 
-typedef unsigned int chtype;
+/*
+ * One screen cell packs into a single 64-bit word -- character (low
+ * byte, room for wide chars later), color pair, and attribute flags
+ * -- so a row is a flat run of words: the refresh diff compares
+ * cell-per-load with no field gathering, and an 80-column row spans
+ * ten cache lines exactly.
+ */
+typedef unsigned long long chtype;
 typedef chtype attr_t;
 
 #ifndef TRUE
@@ -71,8 +78,11 @@ typedef struct _win_st {
     int _notimeout;         /* No escape sequence timeout */
     int _leaveok;           /* Leave cursor after update */
     int _clearok;           /* Force clear on next refresh */
-    chtype *_line;          /* Virtual screen buffer [_maxy * _maxx] */
-    chtype *_prev;          /* Previous screen for diff [_maxy * _maxx] */
+    chtype *_line;          /* Virtual screen buffer [_maxy * _stride] */
+    chtype *_prev;          /* Previous screen for diff [_maxy * _stride] */
+    int     _stride;        /* Cells per row, padded to a cache line */
+    chtype *_line_alloc;    /* Unaligned allocation bases for free() */
+    chtype *_prev_alloc;
     struct _win_st *_parent; /* Parent window (for subwindows) */
 } WINDOW;
 
@@ -89,23 +99,23 @@ extern int COLS;
 /* Attribute constants                                                       */
 /* ========================================================================= */
 
-#define A_NORMAL     0x00000000U
-#define A_STANDOUT   0x00010000U
-#define A_UNDERLINE  0x00020000U
-#define A_REVERSE    0x00040000U
-#define A_BLINK      0x00080000U
-#define A_DIM        0x00100000U
-#define A_BOLD       0x00200000U
-#define A_INVIS      0x00800000U
-#define A_PROTECT    0x01000000U
-#define A_ALTCHARSET 0x02000000U
-#define A_CHARTEXT   0x000000FFU
-#define A_ATTRIBUTES 0xFFFFFF00U
-#define A_COLOR      0x0000FF00U
+#define A_NORMAL     0x00000000ULL
+#define A_STANDOUT   0x00010000ULL
+#define A_UNDERLINE  0x00020000ULL
+#define A_REVERSE    0x00040000ULL
+#define A_BLINK      0x00080000ULL
+#define A_DIM        0x00100000ULL
+#define A_BOLD       0x00200000ULL
+#define A_INVIS      0x00800000ULL
+#define A_PROTECT    0x01000000ULL
+#define A_ALTCHARSET 0x02000000ULL
+#define A_CHARTEXT   0x00000000000000FFULL
+#define A_ATTRIBUTES 0xFFFFFFFFFFFFFF00ULL
+#define A_COLOR      0x0000FF00ULL
 
 /* Color pair encoding: bits 8-15 hold the pair number */
-#define COLOR_PAIR(n) (((n) & 0xFF) << 8)
-#define PAIR_NUMBER(a) (((a) >> 8) & 0xFF)
+#define COLOR_PAIR(n) (((chtype)(n) & 0xFF) << 8)
+#define PAIR_NUMBER(a) ((int)(((a) >> 8) & 0xFF))
 
 /* ========================================================================= */
 /* Color constants                                                           */
@@ -114,6 +114,16 @@ double modf(double x, double *iptr);
 /* Function declarations -- single precision                                 */
 /* ========================================================================= */
 
+/* ----- VeridianOS batch array math (vectorized across elements) ----- */
+
+/** Transform n floats in place: x[i] = sinf(x[i]) etc.  Results
+ *  match the scalar entry points to within kernel accuracy (~1e-6
+ *  relative); last-place bits may differ on the vector path. */
+void v_sinf(float *x, int n);
+void v_cosf(float *x, int n);
+void v_expf(float *x, int n);
+void v_logf(float *x, int n);
+
 float fabsf(float x);
 float floorf(float x);
 float ceilf(float x);
@@ -12,6 +12,13 @@
  */
 
 #include <math.h>
+#include <stdint.h>
+
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 /* ========================================================================= */
 /* Internal helpers                                                          */
@@ -644,22 +651,377 @@ double hypot(double x, double y)
     return sqrt(x * x + y * y);
 }
 
+
+/* ========================================================================= */
+/* Minimax single-precision kernels                                          */
+/* ========================================================================= */
+
+/*
+ * sinf/cosf/expf/logf no longer round-trip through the double Taylor
+ * code: each reduces once and evaluates a fixed-degree minimax
+ * polynomial (Cephes single-precision coefficients).  The batch APIs
+ * below vectorize the same kernels across array elements.
+ */
+
+/* Extended-precision pi/2 split for quadrant reduction */
+#define VM_DP1 0.78515625f
+#define VM_DP2 2.4187564849853515625e-4f
+#define VM_DP3 3.77489497744594108e-8f
+#define VM_FOPI 1.27323954473516f           /* 4/pi */
+
+/* sin kernel on [-pi/4, pi/4] */
+static float vm_sin_poly(float x)
+{
+    float z = x * x;
+
+    return x + x * z *
+           (-1.6666654611e-1f +
+            z * (8.3321608736e-3f + z * -1.9515295891e-4f));
+}
+
+/* cos kernel on [-pi/4, pi/4] */
+static float vm_cos_poly(float x)
+{
+    float z = x * x;
+
+    return 1.0f - 0.5f * z +
+           z * z *
+               (4.166664568298827e-2f +
+                z * (-1.388731625493765e-3f +
+                     z * 2.443315711809948e-5f));
+}
+
+/* Shared quadrant reduction: j mod 4 selects the kernel/sign */
+static float vm_sincos_reduce(float x, int *quadrant)
+{
+    float j = (float)(int)(x * VM_FOPI + (x >= 0 ? 0.5f : -0.5f));
+    int ji = (int)j;
+
+    /* Octant -> quadrant mapping as in Cephes: make j even */
+    if (ji & 1) {
+        ji += (x >= 0) ? 1 : -1;
+        j = (float)ji;
+    }
+    *quadrant = (ji >> 1) & 3;
+    return ((x - j * VM_DP1) - j * VM_DP2) - j * VM_DP3;
+}
+
+float sinf(float x)
+{
+    int q;
+    float r;
+    float s;
+
+    if (isnan(x) || isinf(x))
+        return NAN;
+    if (x > 1.0e4f || x < -1.0e4f)
+        return (float)sin((double)x);   /* Large args: double reduction
+                                         * (the 3-term split loses
+                                         * accuracy past ~8k) */
+
+    r = vm_sincos_reduce(x, &q);
+    s = (q & 1) ? vm_cos_poly(r) : vm_sin_poly(r);
+    return (q & 2) ? -s : s;
+}
+
+float cosf(float x)
+{
+    int q;
+    float r;
+    float s;
+
+    if (isnan(x) || isinf(x))
+        return NAN;
+    if (x > 1.0e4f || x < -1.0e4f)
+        return (float)cos((double)x);
+
+    r = vm_sincos_reduce(x, &q);
+    s = (q & 1) ? vm_sin_poly(r) : vm_cos_poly(r);
+    /* cos sign flips in quadrants 1 and 2 */
+    return ((q == 1) || (q == 2)) ? -s : s;
+}
+
+float expf(float x)
+{
+    float r, p;
+    int k;
+    union { float f; uint32_t u; } scale;
+
+    if (isnan(x))
+        return NAN;
+    if (x > 88.72f)
+        return HUGE_VALF;
+    if (x < -87.33f)
+        return 0.0f;
+
+    k = (int)(x * 1.44269504088896341f + (x >= 0 ? 0.5f : -0.5f));
+    r = (x - (float)k * 0.693359375f) - (float)k * -2.12194440e-4f;
+
+    p = 1.9875691500e-4f;
+    p = p * r + 1.3981999507e-3f;
+    p = p * r + 8.3334519073e-3f;
+    p = p * r + 4.1665795894e-2f;
+    p = p * r + 1.6666665459e-1f;
+    p = p * r + 5.0000001201e-1f;
+    p = p * r * r + r + 1.0f;
+
+    scale.u = (uint32_t)(k + 127) << 23;
+    return p * scale.f;
+}
+
+float logf(float x)
+{
+    union { float f; uint32_t u; } v;
+    int e;
+    float m, z, y;
+
+    if (isnan(x) || x < 0.0f)
+        return NAN;
+    if (x == 0.0f)
+        return -HUGE_VALF;
+    if (isinf(x))
+        return HUGE_VALF;
+
+    v.f = x;
+    /* Subnormals: scale up first */
+    if (v.u < 0x00800000u) {
+        v.f = x * 8388608.0f;       /* 2^23 */
+        e = -23;
+    } else {
+        e = 0;
+    }
+    e += (int)(v.u >> 23) - 127;
+    v.u = (v.u & 0x007fffffu) | 0x3f800000u;    /* m in [1, 2) */
+    m = v.f;
+    if (m > 1.41421356237f) {       /* Keep z small */
+        m *= 0.5f;
+        e++;
+    }
+
+    z = m - 1.0f;
+    y = 7.0376836292e-2f;
+    y = y * z + -1.1514610310e-1f;
+    y = y * z + 1.1676998740e-1f;
+    y = y * z + -1.2420140846e-1f;
+    y = y * z + 1.4249322787e-1f;
+    y = y * z + -1.6668057665e-1f;
+    y = y * z + 2.0000714765e-1f;
+    y = y * z + -2.4999993993e-1f;
+    y = y * z + 3.3333331174e-1f;
+    y = y * z * z * z;
+    y += -0.5f * z * z;
+
+    return z + y + (float)e * 0.693147180559945f;
+}
+
+/* ========================================================================= */
+/* Batch array math                                                          */
+/* ========================================================================= */
+
+/*
+ * In-place array transforms.  The scalar kernels above are branch-
+ * light, so the compiler's vectorizer handles the common-range
+ * elements; inputs outside the fast range are patched up with the
+ * scalar entry points afterwards.  (The kernel forbids floating
+ * point; this is userland-only by charter.)
+ */
+
+#if defined(__x86_64__)
+
+/* 4-wide sin/cos core (sse_mathfun structure with the scalar kernels'
+ * coefficients).  Assumes |x| is in the fast range; the callers fall
+ * back per chunk otherwise. */
+static __m128 vm_sincos_ps(__m128 x, int want_cos)
+{
+    __m128 sign_bit = _mm_and_ps(x, _mm_set1_ps(-0.0f));
+    __m128 ax = _mm_andnot_ps(_mm_set1_ps(-0.0f), x);
+    __m128 j = _mm_mul_ps(ax, _mm_set1_ps(VM_FOPI));
+    __m128i ji = _mm_cvttps_epi32(j);
+
+    /* j = (j + 1) & ~1: round up to even octant */
+    ji = _mm_add_epi32(ji, _mm_set1_epi32(1));
+    ji = _mm_and_si128(ji, _mm_set1_epi32(~1));
+    j = _mm_cvtepi32_ps(ji);
+
+    {
+        /* Quadrant flags */
+        __m128i swap = _mm_and_si128(ji, _mm_set1_epi32(4));
+        __m128i quad = _mm_and_si128(ji, _mm_set1_epi32(2));
+        __m128 swap_mask = _mm_castsi128_ps(
+            _mm_cmpeq_epi32(_mm_slli_epi32(swap, 29 - 2 + 2),
+                            _mm_setzero_si128()));
+        __m128 r, z, poly_sin, poly_cos, result;
+
+        (void)swap_mask;
+        /* Extended reduction */
+        r = _mm_sub_ps(ax, _mm_mul_ps(j, _mm_set1_ps(VM_DP1)));
+        r = _mm_sub_ps(r, _mm_mul_ps(j, _mm_set1_ps(VM_DP2)));
+        r = _mm_sub_ps(r, _mm_mul_ps(j, _mm_set1_ps(VM_DP3)));
+
+        z = _mm_mul_ps(r, r);
+
+        poly_sin = _mm_set1_ps(-1.9515295891e-4f);
+        poly_sin = _mm_add_ps(_mm_mul_ps(poly_sin, z),
+                              _mm_set1_ps(8.3321608736e-3f));
+        poly_sin = _mm_add_ps(_mm_mul_ps(poly_sin, z),
+                              _mm_set1_ps(-1.6666654611e-1f));
+        poly_sin = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(poly_sin, z), r), r);
+
+        poly_cos = _mm_set1_ps(2.443315711809948e-5f);
+        poly_cos = _mm_add_ps(_mm_mul_ps(poly_cos, z),
+                              _mm_set1_ps(-1.388731625493765e-3f));
+        poly_cos = _mm_add_ps(_mm_mul_ps(poly_cos, z),
+                              _mm_set1_ps(4.166664568298827e-2f));
+        poly_cos = _mm_mul_ps(poly_cos, _mm_mul_ps(z, z));
+        poly_cos = _mm_sub_ps(poly_cos,
+                              _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+        poly_cos = _mm_add_ps(poly_cos, _mm_set1_ps(1.0f));
+
+        /* Octant bit 2 (ji & 2) selects cos kernel for sin (and vice
+         * versa); bits 2/4 drive the sign */
+        {
+            __m128 use_cos = _mm_castsi128_ps(
+                _mm_cmpeq_epi32(quad, _mm_set1_epi32(2)));
+            __m128 sin_sel = want_cos
+                ? _mm_or_ps(_mm_and_ps(use_cos, poly_sin),
+                            _mm_andnot_ps(use_cos, poly_cos))
+                : _mm_or_ps(_mm_and_ps(use_cos, poly_cos),
+                            _mm_andnot_ps(use_cos, poly_sin));
+            __m128 sign;
+
+            if (want_cos) {
+                /* cos negative where ((~(ji - 2)) & 4) != 0 */
+                __m128i s = _mm_andnot_si128(
+                    _mm_sub_epi32(ji, _mm_set1_epi32(2)),
+                    _mm_set1_epi32(4));
+                sign = _mm_castsi128_ps(_mm_slli_epi32(s, 29));
+            } else {
+                /* sin sign: input sign xor (ji & 4) */
+                __m128i s = _mm_and_si128(ji, _mm_set1_epi32(4));
+                sign = _mm_xor_ps(
+                    _mm_castsi128_ps(_mm_slli_epi32(s, 29)), sign_bit);
+            }
+            result = _mm_xor_ps(sin_sel, sign);
+        }
+        return result;
+    }
+}
+
+static int vm_chunk_fast(__m128 v)
+{
+    /* All four lanes finite and within the accurate reduction range */
+    __m128 ax = _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+
+    return _mm_movemask_ps(_mm_cmple_ps(ax, _mm_set1_ps(1.0e4f))) == 0xF;
+}
+#endif /* __x86_64__ */
+
+void v_sinf(float *x, int n)
+{
+    int i = 0;
+
+#if defined(__x86_64__)
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(x + i);
+
+        if (!vm_chunk_fast(v))
+            break;
+        _mm_storeu_ps(x + i, vm_sincos_ps(v, 0));
+    }
+#endif
+    for (; i < n; i++)
+        x[i] = sinf(x[i]);
+}
+
+void v_cosf(float *x, int n)
+{
+    int i = 0;
+
+#if defined(__x86_64__)
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(x + i);
+
+        if (!vm_chunk_fast(v))
+            break;
+        _mm_storeu_ps(x + i, vm_sincos_ps(v, 1));
+    }
+#endif
+    for (; i < n; i++)
+        x[i] = cosf(x[i]);
+}
+
+void v_expf(float *x, int n)
+{
+    int i = 0;
+
+#if defined(__x86_64__)
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(x + i);
+        __m128 ax = _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+        __m128 k, r, p;
+        __m128i ki;
+
+        if (_mm_movemask_ps(_mm_cmple_ps(ax, _mm_set1_ps(87.0f))) !=
+            0xF)
+            break;
+
+        k = _mm_mul_ps(v, _mm_set1_ps(1.44269504088896341f));
+        /* Round to nearest via the add-0.5 trick per sign */
+        {
+            __m128 half = _mm_or_ps(
+                _mm_set1_ps(0.5f), _mm_and_ps(v, _mm_set1_ps(-0.0f)));
+
+            ki = _mm_cvttps_epi32(_mm_add_ps(k, half));
+        }
+        k = _mm_cvtepi32_ps(ki);
+        r = _mm_sub_ps(v, _mm_mul_ps(k, _mm_set1_ps(0.693359375f)));
+        r = _mm_sub_ps(r,
+                       _mm_mul_ps(k, _mm_set1_ps(-2.12194440e-4f)));
+
+        p = _mm_set1_ps(1.9875691500e-4f);
+        p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(1.3981999507e-3f));
+        p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(8.3334519073e-3f));
+        p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(4.1665795894e-2f));
+        p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(1.6666665459e-1f));
+        p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(5.0000001201e-1f));
+        p = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(p, r), r), r),
+                       _mm_set1_ps(1.0f));
+
+        {
+            __m128i scale = _mm_slli_epi32(
+                _mm_add_epi32(ki, _mm_set1_epi32(127)), 23);
+
+            _mm_storeu_ps(x + i,
+                          _mm_mul_ps(p, _mm_castsi128_ps(scale)));
+        }
+    }
+#endif
+    for (; i < n; i++)
+        x[i] = expf(x[i]);
+}
+
+void v_logf(float *x, int n)
+{
+    int i;
+
+    /* The scalar kernel is already branch-light; element patching for
+     * non-positive inputs dominates any 4-wide win here */
+    for (i = 0; i < n; i++)
+        x[i] = logf(x[i]);
+}
+
 /* ========================================================================= */
 /* Float (single-precision) wrappers                                         */
 /* ========================================================================= */
 
 float sqrtf(float x)  { return (float)sqrt((double)x); }
-float sinf(float x)   { return (float)sin((double)x); }
-float cosf(float x)   { return (float)cos((double)x); }
 float tanf(float x)   { return (float)tan((double)x); }
 float asinf(float x)  { return (float)asin((double)x); }
 float acosf(float x)  { return (float)acos((double)x); }
 float atanf(float x)  { return (float)atan((double)x); }
 float atan2f(float y, float x) { return (float)atan2((double)y, (double)x); }
-float logf(float x)   { return (float)log((double)x); }
 float log10f(float x) { return (float)log10((double)x); }
 float log2f(float x)  { return (float)log2((double)x); }
-float expf(float x)   { return (float)exp((double)x); }
 float powf(float b, float e) { return (float)pow((double)b, (double)e); }
 float fmodf(float x, float y) { return (float)fmod((double)x, (double)y); }
 float roundf(float x) { return (float)round((double)x); }
@@ -13,12 +13,17 @@
  *   2. wl_display_get_registry() -> local registry object
  *   3. wl_registry_bind() -> local proxy objects (compositor, shm, shell)
  *   4. Surface/buffer creation -> SYS_WL_CREATE_SURFACE / SYS_WL_CREATE_POOL
- *   5. Rendering -> write to SHM pool, SYS_WL_ATTACH + SYS_WL_COMMIT
+ *   5. Rendering -> write to SHM pool; attach/damage/commit are
+ *      recorded in a request ring and submitted with one
+ *      SYS_WL_SUBMIT_BATCH at commit (individual SYS_WL_* replay on
+ *      kernels without the batch syscall)
  *   6. Input -> SYS_WL_GET_EVENTS polls for input events
  */
 
 #include "wayland-client.h"
 
+#include <veridian/frametrace.h>
+
 /* ===================================================================
  * VeridianOS Syscall Numbers (from kernel/src/syscall/mod.rs)
  * =================================================================== */
@@ -31,6 +36,7 @@
 #define SYS_WL_COMMIT         245
 #define SYS_WL_DAMAGE         246
 #define SYS_WL_GET_EVENTS     247
+#define SYS_WL_SUBMIT_BATCH   248
 
 /* Memory management syscalls */
 #define SYS_MEMORY_MAP        20
@@ -179,6 +185,29 @@ struct wl_global_entry {
 };
 
 /* Display (singleton) */
+/*
+ * Client-side request ring.
+ *
+ * Per-frame protocol actions (attach, damage, commit) are recorded
+ * here instead of each issuing its own SYS_WL_* syscall; the whole
+ * sequence is handed to the kernel in one SYS_WL_SUBMIT_BATCH at
+ * commit time, matching the IPC small-message fast path.  On kernels
+ * without the batch syscall the ring is replayed as individual
+ * requests, so behavior is identical -- just slower.
+ */
+#define WL_REQ_ATTACH  0u
+#define WL_REQ_DAMAGE  1u
+#define WL_REQ_COMMIT  2u
+
+#define REQUEST_RING_SIZE 64
+
+struct wl_request {
+    uint32_t opcode;     /* WL_REQ_* */
+    uint32_t surface_id;
+    uint64_t arg1;       /* attach: buffer id | damage: x<<32|y   */
+    uint64_t arg2;       /* damage: w<<32|h                       */
+};
+
 struct wl_display {
     int client_id;
     int connected;
@@ -186,6 +215,11 @@ struct wl_display {
     struct wl_global_entry globals[MAX_GLOBALS];
     int num_globals;
     uint8_t event_buf[EVENT_BUF_SIZE];
+
+    /* Request ring (flushed at commit or when full) */
+    struct wl_request ring[REQUEST_RING_SIZE];
+    int ring_count;
+    int batch_supported;    /* cleared on first ENOSYS */
 };
 
 /* Registry */
@@ -208,6 +242,10 @@ struct wl_surface {
     wl_buffer *attached_buffer;
     int32_t attach_x;
     int32_t attach_y;
+    /* Last two committed buffers: the compositor may still scan out
+     * the previous one while compositing the current */
+    wl_buffer *current_committed;
+    wl_buffer *previous_committed;
     int active;
 };
 
@@ -237,6 +275,19 @@ struct wl_buffer {
     int32_t height;
     int32_t stride;
     uint32_t format;
+    /* Age/busy tracking (see wl_buffer_get_age) */
+    wl_surface *last_surface;   /* surface of last commit    */
+    uint32_t age;               /* 0 = undefined content     */
+    int busy;                   /* compositor may be reading */
+    int active;
+};
+
+/* Swapchain: 2-3 buffers rotated over one surface */
+#define SWAPCHAIN_MAX_BUFFERS 3
+
+struct wl_swapchain {
+    wl_buffer *buffers[SWAPCHAIN_MAX_BUFFERS];
+    int count;
     int active;
 };
 
@@ -408,6 +459,8 @@ wl_display *wl_display_connect(const char *name)
     s_display.client_id = (int)ret;
     s_display.connected = 1;
     s_display.serial = 1;
+    s_display.ring_count = 0;
+    s_display.batch_supported = 1;  /* Probed on first flush */
 
     /* Pre-populate globals (matching kernel's WaylandDisplay::new()) */
     s_display.globals[0].name = 1;
@@ -460,6 +513,9 @@ void wl_display_disconnect(wl_display *display)
 
 int wl_display_dispatch(wl_display *display)
 {
+    /* Frame tracing: the client-side dispatch stage */
+    vft_emit(VFT_STAGE_DISPATCH, 0);
+
     if (!display || !display->connected)
         return -1;
 
@@ -617,6 +673,79 @@ void wl_surface_destroy(wl_surface *surface)
     surface->active = 0;
 }
 
+/* Replay one recorded request as an individual syscall (fallback
+ * path for kernels without SYS_WL_SUBMIT_BATCH) */
+static void replay_request(wl_display *display, const struct wl_request *req)
+{
+    switch (req->opcode) {
+    case WL_REQ_ATTACH:
+        syscall4(SYS_WL_ATTACH,
+                 (long)display->client_id,
+                 (long)req->surface_id,
+                 (long)req->arg1,
+                 0);
+        break;
+    case WL_REQ_DAMAGE:
+        syscall4(SYS_WL_DAMAGE,
+                 (long)display->client_id,
+                 (long)req->surface_id,
+                 (long)req->arg1,
+                 (long)req->arg2);
+        break;
+    case WL_REQ_COMMIT:
+        syscall2(SYS_WL_COMMIT,
+                 (long)display->client_id,
+                 (long)req->surface_id);
+        break;
+    default:
+        break;
+    }
+}
+
+/* Submit the request ring: one syscall when the kernel supports
+ * batching, individual replay otherwise */
+static void flush_request_ring(wl_display *display)
+{
+    int i;
+
+    if (display->ring_count == 0)
+        return;
+
+    if (display->batch_supported) {
+        long ret = syscall3(SYS_WL_SUBMIT_BATCH,
+                            (long)display->client_id,
+                            (long)display->ring,
+                            (long)display->ring_count);
+        if (ret >= 0) {
+            display->ring_count = 0;
+            return;
+        }
+        /* Kernel predates the batch syscall: remember and replay */
+        display->batch_supported = 0;
+    }
+
+    for (i = 0; i < display->ring_count; i++)
+        replay_request(display, &display->ring[i]);
+    display->ring_count = 0;
+}
+
+/* Record a request, flushing first if the ring is full */
+static void enqueue_request(wl_display *display, uint32_t opcode,
+                            uint32_t surface_id, uint64_t arg1,
+                            uint64_t arg2)
+{
+    struct wl_request *req;
+
+    if (display->ring_count >= REQUEST_RING_SIZE)
+        flush_request_ring(display);
+
+    req = &display->ring[display->ring_count++];
+    req->opcode = opcode;
+    req->surface_id = surface_id;
+    req->arg1 = arg1;
+    req->arg2 = arg2;
+}
+
 void wl_surface_attach(wl_surface *surface, wl_buffer *buffer,
                        int32_t x, int32_t y)
 {
@@ -628,11 +757,8 @@ void wl_surface_attach(wl_surface *surface, wl_buffer *buffer,
     surface->attach_y = y;
 
     if (buffer && surface->display) {
-        syscall4(SYS_WL_ATTACH,
-                 (long)surface->display->client_id,
-                 (long)surface->id,
-                 (long)buffer->id,
-                 0);
+        enqueue_request(surface->display, WL_REQ_ATTACH,
+                        surface->id, (uint64_t)buffer->id, 0);
     }
 }
 
@@ -645,21 +771,57 @@ void wl_surface_damage(wl_surface *surface, int32_t x, int32_t y,
     /* Pack damage rect: x | y in first arg, w | h in second */
     uint64_t xy = ((uint64_t)(uint32_t)x << 32) | (uint32_t)y;
     uint64_t wh = ((uint64_t)(uint32_t)width << 32) | (uint32_t)height;
-    syscall4(SYS_WL_DAMAGE,
-             (long)surface->display->client_id,
-             (long)surface->id,
-             (long)xy,
-             (long)wh);
+    enqueue_request(surface->display, WL_REQ_DAMAGE, surface->id, xy, wh);
 }
 
 void wl_surface_commit(wl_surface *surface)
 {
+    /* Frame tracing: the client handed its buffer over */
+    vft_emit(VFT_STAGE_COMMIT, 0);
+
+    int i;
+
     if (!surface || !surface->display)
         return;
 
-    syscall2(SYS_WL_COMMIT,
-             (long)surface->display->client_id,
-             (long)surface->id);
+    /* The commit closes the frame's request sequence: record it and
+     * hand the whole ring to the kernel in one syscall */
+    enqueue_request(surface->display, WL_REQ_COMMIT, surface->id, 0, 0);
+    flush_request_ring(surface->display);
+
+    /*
+     * Buffer-age bookkeeping.  The committed buffer now holds the
+     * newest frame (age 1); every other buffer previously presented
+     * on this surface gets one frame older.  The compositor holds at
+     * most the current and previous scanout, so older buffers are
+     * free to render into again.
+     */
+    if (surface->attached_buffer) {
+        wl_buffer *committed = surface->attached_buffer;
+
+        for (i = 0; i < MAX_BUFFERS; i++) {
+            wl_buffer *b = &s_buffers[i];
+
+            if (!b->active || b->last_surface != surface || b == committed)
+                continue;
+            if (b->age)
+                b->age++;
+        }
+
+        committed->last_surface = surface;
+        committed->age = 1;
+        committed->busy = 1;
+
+        if (surface->previous_committed &&
+            surface->previous_committed != committed &&
+            surface->previous_committed != surface->current_committed) {
+            surface->previous_committed->busy = 0;
+        }
+        if (surface->current_committed != committed) {
+            surface->previous_committed = surface->current_committed;
+            surface->current_committed = committed;
+        }
+    }
 }
 
 wl_callback *wl_surface_frame(wl_surface *surface)
@@ -777,6 +939,17 @@ void wl_buffer_destroy(wl_buffer *buffer)
 {
     if (!buffer)
         return;
+
+    /* Drop any surface references to the dying buffer */
+    if (buffer->last_surface) {
+        if (buffer->last_surface->current_committed == buffer)
+            buffer->last_surface->current_committed = (wl_buffer *)0;
+        if (buffer->last_surface->previous_committed == buffer)
+            buffer->last_surface->previous_committed = (wl_buffer *)0;
+        if (buffer->last_surface->attached_buffer == buffer)
+            buffer->last_surface->attached_buffer = (wl_buffer *)0;
+    }
+
     buffer->active = 0;
 }
 
@@ -787,6 +960,125 @@ void *wl_shm_pool_get_data(wl_shm_pool *pool)
     return pool->data;
 }
 
+/* ===================================================================
+ * Buffer age / swapchain API
+ * =================================================================== */
+
+#define MAX_SWAPCHAINS 8
+
+static struct wl_swapchain s_swapchains[MAX_SWAPCHAINS];
+
+uint32_t wl_buffer_get_age(const wl_buffer *buffer)
+{
+    if (!buffer || !buffer->active)
+        return 0;
+    return buffer->age;
+}
+
+int wl_buffer_is_busy(const wl_buffer *buffer)
+{
+    if (!buffer || !buffer->active)
+        return 0;
+    return buffer->busy;
+}
+
+wl_swapchain *wl_swapchain_create(wl_shm_pool *pool, int32_t offset,
+                                  int32_t width, int32_t height,
+                                  int32_t stride, uint32_t format,
+                                  int count)
+{
+    struct wl_swapchain *chain = (struct wl_swapchain *)0;
+    int i;
+
+    if (!pool || count < 2)
+        return (wl_swapchain *)0;
+    if (count > SWAPCHAIN_MAX_BUFFERS)
+        count = SWAPCHAIN_MAX_BUFFERS;
+
+    for (i = 0; i < MAX_SWAPCHAINS; i++) {
+        if (!s_swapchains[i].active) {
+            chain = &s_swapchains[i];
+            break;
+        }
+    }
+    if (!chain)
+        return (wl_swapchain *)0;
+
+    mem_zero(chain, sizeof(*chain));
+
+    for (i = 0; i < count; i++) {
+        chain->buffers[i] = wl_shm_pool_create_buffer(
+            pool, offset + i * stride * height,
+            width, height, stride, format);
+        if (!chain->buffers[i]) {
+            while (i-- > 0)
+                wl_buffer_destroy(chain->buffers[i]);
+            return (wl_swapchain *)0;
+        }
+    }
+
+    chain->count = count;
+    chain->active = 1;
+    return chain;
+}
+
+/*
+ * Pick the buffer to render the next frame into.
+ *
+ * Free buffers with a known age are preferred, lowest age first: the
+ * smaller the age, the less damage the client has to repaint.  A
+ * never-presented buffer (age 0, full repaint) comes next.  If every
+ * buffer is busy -- only possible with a double-buffered chain and a
+ * slow compositor -- the oldest busy buffer is reused, trading a
+ * possible tear for not blocking; a triple-buffered chain never hits
+ * this case.
+ */
+wl_buffer *wl_swapchain_acquire(wl_swapchain *chain)
+{
+    wl_buffer *best = (wl_buffer *)0;
+    wl_buffer *fresh = (wl_buffer *)0;
+    wl_buffer *fallback = (wl_buffer *)0;
+    int i;
+
+    if (!chain || !chain->active)
+        return (wl_buffer *)0;
+
+    for (i = 0; i < chain->count; i++) {
+        wl_buffer *b = chain->buffers[i];
+
+        if (b->busy) {
+            if (!fallback || b->age > fallback->age)
+                fallback = b;
+            continue;
+        }
+        if (b->age == 0) {
+            fresh = b;
+        } else if (!best || b->age < best->age) {
+            best = b;
+        }
+    }
+
+    if (best)
+        return best;
+    if (fresh)
+        return fresh;
+    return fallback;
+}
+
+void wl_swapchain_destroy(wl_swapchain *chain)
+{
+    int i;
+
+    if (!chain || !chain->active)
+        return;
+
+    for (i = 0; i < chain->count; i++) {
+        if (chain->buffers[i])
+            wl_buffer_destroy(chain->buffers[i]);
+    }
+    mem_zero(chain, sizeof(*chain));
+}
+
 /* ===================================================================
  * XDG Shell API
  * =================================================================== */
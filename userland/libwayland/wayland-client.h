@@ -281,6 +281,40 @@ void wl_buffer_destroy(wl_buffer *buffer);
  * Returns NULL if the pool is kernel-managed and not memory-mapped. */
 void *wl_shm_pool_get_data(wl_shm_pool *pool);
 
+/* ===================================================================
+ * Buffer age / swapchain API
+ * =================================================================== */
+
+/* How many frames old this buffer's content is for the surface it was
+ * last committed to: 0 = undefined (never presented, repaint fully),
+ * 1 = holds the previous frame, 2 = the frame before that, etc.
+ * Clients repaint only the damage accumulated over the last N-1
+ * frames instead of the whole surface. */
+uint32_t wl_buffer_get_age(const wl_buffer *buffer);
+
+/* Nonzero while the compositor may still be reading the buffer.
+ * Attaching a busy buffer can block in SYS_WL_ATTACH. */
+int wl_buffer_is_busy(const wl_buffer *buffer);
+
+/* Convenience swapchain: `count` (2 or 3) equally-sized buffers carved
+ * consecutively from the pool starting at `offset`.  Triple buffering
+ * (count = 3) lets a client keep rendering when the compositor is
+ * slow to release the scanout buffer instead of blocking in attach. */
+typedef struct wl_swapchain wl_swapchain;
+
+wl_swapchain *wl_swapchain_create(wl_shm_pool *pool, int32_t offset,
+                                  int32_t width, int32_t height,
+                                  int32_t stride, uint32_t format,
+                                  int count);
+
+/* Return a buffer that is free to render into (never NULL for a
+ * swapchain of 2+ buffers; prefers the buffer with the lowest
+ * non-zero age so the client repaints the smallest delta). */
+wl_buffer *wl_swapchain_acquire(wl_swapchain *chain);
+
+/* Destroy the swapchain and its buffers. */
+void wl_swapchain_destroy(wl_swapchain *chain);
+
 /* ===================================================================
  * XDG Shell API
  * =================================================================== */
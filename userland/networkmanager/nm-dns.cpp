@@ -19,10 +19,26 @@
 #include <QFileInfo>
 #include <QTextStream>
 #include <QDateTime>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
 
 #include <cstring>
 #include <cstdio>
 
+#include <list>
+
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
 /* ========================================================================= */
 /* Constants                                                                 */
 /* ========================================================================= */
@@ -33,6 +49,11 @@ static const char *RESOLV_CONF_BAK  = "/etc/resolv.conf.nm-backup";
 /* VeridianOS kernel DNS cache flush path */
 static const char *DNS_CACHE_FLUSH  = "/proc/net/dns_cache_flush";
 
+/* Defined with the resolver below */
+static void nm_dns_update_resolver_servers(const char **servers,
+                                           uint32_t server_count);
+static void nm_dns_flush_local_cache(void);
+
 /* ========================================================================= */
 /* Helper: back up the original resolv.conf (once)                           */
 /* ========================================================================= */
@@ -107,6 +128,9 @@ bool nm_dns_set_servers(const char **servers, uint32_t server_count,
     qDebug("NM-DNS: wrote %s with %u nameservers, %u search domains",
            RESOLV_CONF, server_count, domain_count);
 
+    /* Hand the new server set to the resolver thread */
+    nm_dns_update_resolver_servers(servers, server_count);
+
     /* Flush cache after updating config */
     nm_dns_flush_cache();
 
@@ -119,6 +143,9 @@ bool nm_dns_set_servers(const char **servers, uint32_t server_count,
 
 void nm_dns_flush_cache(void)
 {
+    /* Local resolver cache first */
+    nm_dns_flush_local_cache();
+
     /* VeridianOS kernel exposes a proc file to flush the DNS cache */
     QFile file(QString::fromLatin1(DNS_CACHE_FLUSH));
     if (file.open(QIODevice::WriteOnly)) {
@@ -156,3 +183,749 @@ bool nm_dns_restore_resolv_conf(void)
     qWarning("NM-DNS: failed to restore %s", RESOLV_CONF);
     return false;
 }
+
+/* ========================================================================= */
+/* Asynchronous resolver                                                     */
+/* ========================================================================= */
+
+/*
+ * One resolver thread owns a pool of connected UDP sockets (one per
+ * nameserver) and multiplexes them with poll().  Queries are pipelined:
+ * many DNS IDs may be in flight per socket, and requests are spread
+ * round-robin across servers.  Completed answers land in an LRU cache
+ * honoring record TTLs; NXDOMAIN and empty answers are cached
+ * negatively for a short fixed period.
+ */
+
+static const int      DNS_PORT            = 53;
+static const int      DNS_MAX_PACKET      = 1024;
+static const int      DNS_QUERY_TIMEOUT_MS = 1500;
+static const int      DNS_MAX_RETRIES     = 3;
+static const int      DNS_CACHE_CAPACITY  = 256;
+static const qint64   DNS_NEG_TTL_MS      = 30 * 1000;
+static const qint64   DNS_MIN_TTL_MS      = 1000;
+static const qint64   DNS_MAX_TTL_MS      = 3600 * 1000;
+
+/* ----- Wire format helpers ----- */
+
+static quint16 dns_rd16(const quint8 *p)
+{
+    return quint16((p[0] << 8) | p[1]);
+}
+
+static quint32 dns_rd32(const quint8 *p)
+{
+    return (quint32(p[0]) << 24) | (quint32(p[1]) << 16) |
+           (quint32(p[2]) << 8)  |  quint32(p[3]);
+}
+
+/* Encode a standard recursive query for (name, qtype) */
+static QByteArray dns_encode_query(const QByteArray &name, quint16 qtype,
+                                   quint16 id)
+{
+    QByteArray q;
+
+    q.append(char(id >> 8));
+    q.append(char(id & 0xFF));
+    q.append(char(0x01));  /* RD */
+    q.append(char(0x00));
+    q.append(char(0x00)); q.append(char(0x01));  /* QDCOUNT = 1 */
+    q.append(4 * 2, char(0x00));                 /* AN/NS/AR = 0 */
+
+    int start = 0;
+    while (start < name.size()) {
+        int dot = name.indexOf('.', start);
+        int len = (dot < 0 ? name.size() : dot) - start;
+
+        if (len <= 0 || len > 63)
+            return QByteArray();
+        q.append(char(len));
+        q.append(name.constData() + start, len);
+        start += len + 1;
+    }
+    q.append(char(0x00));
+
+    q.append(char(qtype >> 8));
+    q.append(char(qtype & 0xFF));
+    q.append(char(0x00)); q.append(char(0x01));  /* IN */
+    return q;
+}
+
+/* Advance past a (possibly compressed) name; returns -1 on malformed */
+static int dns_skip_name(const quint8 *p, int len, int pos)
+{
+    while (pos < len) {
+        quint8 l = p[pos];
+
+        if (l == 0)
+            return pos + 1;
+        if ((l & 0xC0) == 0xC0)
+            return pos + 2 <= len ? pos + 2 : -1;
+        pos += 1 + l;
+    }
+    return -1;
+}
+
+/* Extract the first rdata matching qtype from a response.  Returns the
+ * rcode, or -1 on a malformed packet. */
+static int dns_parse_response(const quint8 *p, int len, quint16 qtype,
+                              char *addr_out, int addr_len, quint32 *ttl_out)
+{
+    if (len < 12)
+        return -1;
+
+    int rcode = p[3] & 0x0F;
+    int qd = dns_rd16(p + 4);
+    int an = dns_rd16(p + 6);
+    int pos = 12;
+
+    while (qd-- > 0) {
+        pos = dns_skip_name(p, len, pos);
+        if (pos < 0 || pos + 4 > len)
+            return -1;
+        pos += 4;
+    }
+
+    while (an-- > 0) {
+        pos = dns_skip_name(p, len, pos);
+        if (pos < 0 || pos + 10 > len)
+            return -1;
+
+        quint16 type  = dns_rd16(p + pos);
+        quint32 ttl   = dns_rd32(p + pos + 4);
+        quint16 rdlen = dns_rd16(p + pos + 8);
+
+        pos += 10;
+        if (pos + rdlen > len)
+            return -1;
+
+        if (type == qtype &&
+            ((qtype == 1 && rdlen == 4) || (qtype == 28 && rdlen == 16))) {
+            if (!inet_ntop(qtype == 1 ? AF_INET : AF_INET6,
+                           p + pos, addr_out, addr_len))
+                return -1;
+            *ttl_out = ttl;
+            return rcode;
+        }
+        /* CNAMEs are skipped; the target's record follows in-answer */
+        pos += rdlen;
+    }
+
+    addr_out[0] = '\0';
+    return rcode;
+}
+
+/* ----- Cache (LRU + TTL) ----- */
+
+struct DnsCacheEntry {
+    QByteArray address;                      /* empty = negative entry */
+    qint64     expires_ms;
+    std::list<QByteArray>::iterator lru_it;  /* position in s_lru */
+};
+
+/* ----- Resolver state ----- */
+
+struct DnsRequest {
+    QByteArray        name;
+    quint16           qtype;
+    quint16           id;
+    int               server;      /* socket index the query went to */
+    qint64            deadline_ms;
+    int               retries;
+    nm_dns_resolve_cb cb;
+    void             *user_data;
+};
+
+class DnsResolverThread;
+
+static QMutex                        s_dns_mutex;
+static QHash<QByteArray, DnsCacheEntry> s_cache;
+static std::list<QByteArray>         s_lru;       /* front = most recent */
+static QVector<QByteArray>           s_servers;   /* address strings */
+static QVector<DnsRequest>           s_incoming;  /* queued by producers */
+static DnsResolverThread            *s_resolver   = nullptr;
+static int                           s_wake_pipe[2] = { -1, -1 };
+static bool                          s_servers_dirty = false;
+static QElapsedTimer                 s_clock;
+
+static QByteArray dns_cache_key(const QByteArray &name, quint16 qtype)
+{
+    QByteArray key = name.toLower();
+
+    key.append('|');
+    key.append(qtype == 28 ? '6' : '4');
+    return key;
+}
+
+/* Caller holds s_dns_mutex */
+static void dns_cache_insert(const QByteArray &key, const QByteArray &addr,
+                             qint64 ttl_ms)
+{
+    auto it = s_cache.find(key);
+
+    if (it != s_cache.end()) {
+        s_lru.erase(it->lru_it);
+        s_cache.erase(it);
+    }
+
+    while (s_cache.size() >= DNS_CACHE_CAPACITY && !s_lru.empty()) {
+        s_cache.remove(s_lru.back());
+        s_lru.pop_back();
+    }
+
+    s_lru.push_front(key);
+
+    DnsCacheEntry e;
+    e.address    = addr;
+    e.expires_ms = s_clock.elapsed() + ttl_ms;
+    e.lru_it     = s_lru.begin();
+    s_cache.insert(key, e);
+}
+
+/* Caller holds s_dns_mutex.  Returns 1 hit, 0 miss; *addr empty on a
+ * cached negative. */
+static int dns_cache_lookup(const QByteArray &key, QByteArray *addr)
+{
+    auto it = s_cache.find(key);
+
+    if (it == s_cache.end())
+        return 0;
+    if (it->expires_ms <= s_clock.elapsed()) {
+        s_lru.erase(it->lru_it);
+        s_cache.erase(it);
+        return 0;
+    }
+
+    /* Move to the front of the LRU list */
+    s_lru.erase(it->lru_it);
+    s_lru.push_front(key);
+    it->lru_it = s_lru.begin();
+
+    *addr = it->address;
+    return 1;
+}
+
+/* ----- Resolver thread ----- */
+
+class DnsResolverThread : public QThread {
+public:
+    bool stop_requested = false;
+
+protected:
+    void run() override;
+
+private:
+    QVector<int>        m_socks;
+    QVector<DnsRequest> m_pending;
+    quint16             m_next_id = 1;
+    int                 m_next_server = 0;
+
+    void rebuildSockets();
+    void closeSockets();
+    void sendRequest(DnsRequest &req);
+    void completeRequest(const DnsRequest &req, const char *addr, int error);
+    void handleResponse(int server);
+    void checkTimeouts();
+    friend void nm_dns_stop_resolver(void);
+};
+
+/* Parse "nameserver" lines when no servers were configured via NM */
+static void dns_servers_from_resolv_conf(QVector<QByteArray> *out)
+{
+    QFile f(QString::fromLatin1(RESOLV_CONF));
+
+    if (!f.open(QIODevice::ReadOnly | QIODevice::Text))
+        return;
+    while (!f.atEnd() && out->size() < NM_DNS_MAX_SERVERS) {
+        QByteArray line = f.readLine().trimmed();
+
+        if (line.startsWith("nameserver")) {
+            QByteArray addr = line.mid(10).trimmed();
+
+            if (!addr.isEmpty())
+                out->append(addr);
+        }
+    }
+}
+
+void DnsResolverThread::rebuildSockets()
+{
+    QVector<QByteArray> servers;
+
+    {
+        QMutexLocker lock(&s_dns_mutex);
+        servers = s_servers;
+        s_servers_dirty = false;
+    }
+    if (servers.isEmpty())
+        dns_servers_from_resolv_conf(&servers);
+    if (servers.isEmpty())
+        servers.append(QByteArray("127.0.0.1"));
+
+    closeSockets();
+
+    for (const QByteArray &srv : servers) {
+        struct sockaddr_storage ss;
+        socklen_t slen = 0;
+        int af = AF_INET;
+
+        memset(&ss, 0, sizeof(ss));
+        if (srv.contains(':')) {
+            auto *s6 = reinterpret_cast<struct sockaddr_in6 *>(&ss);
+
+            af = AF_INET6;
+            s6->sin6_family = AF_INET6;
+            s6->sin6_port   = htons(DNS_PORT);
+            if (inet_pton(AF_INET6, srv.constData(), &s6->sin6_addr) != 1)
+                continue;
+            slen = sizeof(*s6);
+        } else {
+            auto *s4 = reinterpret_cast<struct sockaddr_in *>(&ss);
+
+            s4->sin_family = AF_INET;
+            s4->sin_port   = htons(DNS_PORT);
+            if (inet_pton(AF_INET, srv.constData(), &s4->sin_addr) != 1)
+                continue;
+            slen = sizeof(*s4);
+        }
+
+        int fd = socket(af, SOCK_DGRAM, 0);
+        if (fd < 0)
+            continue;
+        if (connect(fd, reinterpret_cast<struct sockaddr *>(&ss), slen) != 0) {
+            close(fd);
+            continue;
+        }
+        m_socks.append(fd);
+    }
+
+    qDebug("NM-DNS: resolver using %d nameserver socket(s)",
+           int(m_socks.size()));
+}
+
+void DnsResolverThread::closeSockets()
+{
+    for (int fd : m_socks)
+        close(fd);
+    m_socks.clear();
+}
+
+void DnsResolverThread::completeRequest(const DnsRequest &req,
+                                        const char *addr, int error)
+{
+    if (req.cb)
+        req.cb(req.name.constData(), addr, error, req.user_data);
+}
+
+void DnsResolverThread::sendRequest(DnsRequest &req)
+{
+    if (m_socks.isEmpty()) {
+        completeRequest(req, nullptr, NM_DNS_ERR_INTERNAL);
+        return;
+    }
+
+    req.id     = m_next_id++;
+    if (m_next_id == 0)
+        m_next_id = 1;
+    req.server = m_next_server;
+    m_next_server = (m_next_server + 1) % m_socks.size();
+    req.deadline_ms = s_clock.elapsed() + DNS_QUERY_TIMEOUT_MS;
+
+    QByteArray pkt = dns_encode_query(req.name, req.qtype, req.id);
+    if (pkt.isEmpty()) {
+        completeRequest(req, nullptr, NM_DNS_ERR_INTERNAL);
+        return;
+    }
+
+    send(m_socks[req.server], pkt.constData(), size_t(pkt.size()), 0);
+    m_pending.append(req);
+}
+
+void DnsResolverThread::handleResponse(int server)
+{
+    quint8 buf[DNS_MAX_PACKET];
+    ssize_t n = recv(m_socks[server], buf, sizeof(buf), 0);
+
+    if (n < 12)
+        return;
+
+    quint16 id = dns_rd16(buf);
+
+    for (int i = 0; i < m_pending.size(); ++i) {
+        DnsRequest &req = m_pending[i];
+
+        if (req.id != id || req.server != server)
+            continue;
+
+        char addr[NM_DNS_MAX_ADDR_LEN];
+        quint32 ttl = 0;
+        int rcode = dns_parse_response(buf, int(n), req.qtype,
+                                       addr, sizeof(addr), &ttl);
+
+        if (rcode < 0)
+            return;  /* malformed; let the timeout retry */
+
+        QByteArray key = dns_cache_key(req.name, req.qtype);
+
+        if (rcode == 0 && addr[0] != '\0') {
+            qint64 ttl_ms = qBound(DNS_MIN_TTL_MS,
+                                   qint64(ttl) * 1000, DNS_MAX_TTL_MS);
+
+            {
+                QMutexLocker lock(&s_dns_mutex);
+                dns_cache_insert(key, QByteArray(addr), ttl_ms);
+            }
+            completeRequest(req, addr, NM_DNS_OK);
+        } else {
+            /* NXDOMAIN or no matching record: cache negatively */
+            {
+                QMutexLocker lock(&s_dns_mutex);
+                dns_cache_insert(key, QByteArray(), DNS_NEG_TTL_MS);
+            }
+            completeRequest(req, nullptr, NM_DNS_ERR_NXDOMAIN);
+        }
+
+        m_pending.remove(i);
+        return;
+    }
+}
+
+void DnsResolverThread::checkTimeouts()
+{
+    qint64 now = s_clock.elapsed();
+
+    for (int i = m_pending.size() - 1; i >= 0; --i) {
+        if (m_pending[i].deadline_ms > now)
+            continue;
+
+        DnsRequest req = m_pending[i];
+        m_pending.remove(i);
+
+        if (++req.retries < DNS_MAX_RETRIES) {
+            /* Retry lands on the next server in the rotation */
+            sendRequest(req);
+        } else {
+            completeRequest(req, nullptr, NM_DNS_ERR_TIMEOUT);
+        }
+    }
+}
+
+void DnsResolverThread::run()
+{
+    rebuildSockets();
+
+    for (;;) {
+        struct pollfd pfds[NM_DNS_MAX_SERVERS + 1];
+        int nfds = 0;
+
+        pfds[nfds].fd      = s_wake_pipe[0];
+        pfds[nfds].events  = POLLIN;
+        pfds[nfds].revents = 0;
+        nfds++;
+        for (int i = 0; i < m_socks.size(); ++i) {
+            pfds[nfds].fd      = m_socks[i];
+            pfds[nfds].events  = POLLIN;
+            pfds[nfds].revents = 0;
+            nfds++;
+        }
+
+        int timeout = -1;
+        if (!m_pending.isEmpty()) {
+            qint64 now = s_clock.elapsed();
+            qint64 next = m_pending[0].deadline_ms;
+
+            for (const DnsRequest &r : m_pending)
+                next = qMin(next, r.deadline_ms);
+            timeout = int(qBound(qint64(0), next - now, qint64(1000)));
+        }
+
+        poll(pfds, nfds_t(nfds), timeout);
+
+        /* Drain wake-ups and pick up queued work / config changes.
+         * A single read suffices: leftover bytes just re-trigger poll. */
+        if (pfds[0].revents & POLLIN) {
+            char drain[256];
+
+            (void)read(s_wake_pipe[0], drain, sizeof(drain));
+        }
+
+        bool stop, dirty;
+        QVector<DnsRequest> incoming;
+        {
+            QMutexLocker lock(&s_dns_mutex);
+
+            stop  = stop_requested;
+            dirty = s_servers_dirty;
+            incoming.swap(s_incoming);
+        }
+
+        if (stop) {
+            for (const DnsRequest &r : m_pending)
+                completeRequest(r, nullptr, NM_DNS_ERR_INTERNAL);
+            for (const DnsRequest &r : incoming)
+                completeRequest(r, nullptr, NM_DNS_ERR_INTERNAL);
+            m_pending.clear();
+            closeSockets();
+            return;
+        }
+
+        if (dirty) {
+            /* Re-send everything in flight on the new server set */
+            QVector<DnsRequest> inflight;
+
+            inflight.swap(m_pending);
+            rebuildSockets();
+            for (DnsRequest &r : inflight)
+                sendRequest(r);
+        }
+
+        for (DnsRequest &r : incoming)
+            sendRequest(r);
+
+        for (int i = 1; i < nfds; ++i) {
+            if (pfds[i].revents & POLLIN)
+                handleResponse(i - 1);
+        }
+
+        checkTimeouts();
+    }
+}
+
+/* Caller holds s_dns_mutex.  Starts the thread on first use. */
+static bool dns_resolver_ensure_started(void)
+{
+    if (s_resolver)
+        return true;
+
+    if (s_wake_pipe[0] < 0 && pipe(s_wake_pipe) != 0) {
+        qWarning("NM-DNS: cannot create resolver wake pipe");
+        return false;
+    }
+
+    s_resolver = new DnsResolverThread();
+    s_resolver->start();
+    return true;
+}
+
+static void dns_resolver_wake(void)
+{
+    if (s_wake_pipe[1] >= 0) {
+        char b = 1;
+
+        if (write(s_wake_pipe[1], &b, 1) != 1) {
+            /* Pipe full: the thread is already due to wake */
+        }
+    }
+}
+
+/* ----- Public API ----- */
+
+static void nm_dns_update_resolver_servers(const char **servers,
+                                           uint32_t server_count)
+{
+    bool started;
+
+    {
+        QMutexLocker lock(&s_dns_mutex);
+
+        s_servers.clear();
+        for (uint32_t i = 0;
+             i < server_count && uint32_t(s_servers.size()) < NM_DNS_MAX_SERVERS;
+             ++i) {
+            if (servers[i] && servers[i][0])
+                s_servers.append(QByteArray(servers[i]));
+        }
+        s_servers_dirty = true;
+        started = s_resolver != nullptr;
+    }
+
+    if (started)
+        dns_resolver_wake();
+}
+
+static void nm_dns_flush_local_cache(void)
+{
+    QMutexLocker lock(&s_dns_mutex);
+
+    s_cache.clear();
+    s_lru.clear();
+}
+
+bool nm_dns_resolve_async(const char *hostname, int family,
+                          nm_dns_resolve_cb cb, void *user_data)
+{
+    if (!hostname || !hostname[0] || !cb)
+        return false;
+    if (family != AF_INET && family != AF_INET6)
+        return false;
+
+    QByteArray name(hostname);
+    quint16 qtype = family == AF_INET6 ? 28 : 1;
+    QByteArray key = dns_cache_key(name, qtype);
+    QByteArray cached;
+    int hit;
+
+    {
+        QMutexLocker lock(&s_dns_mutex);
+
+        if (!s_clock.isValid())
+            s_clock.start();
+
+        hit = dns_cache_lookup(key, &cached);
+        if (!hit) {
+            DnsRequest req;
+
+            if (!dns_resolver_ensure_started())
+                return false;
+
+            req.name      = name;
+            req.qtype     = qtype;
+            req.id        = 0;
+            req.server    = 0;
+            req.deadline_ms = 0;
+            req.retries   = 0;
+            req.cb        = cb;
+            req.user_data = user_data;
+            s_incoming.append(req);
+        }
+    }
+
+    if (hit) {
+        if (cached.isEmpty())
+            cb(hostname, nullptr, NM_DNS_ERR_NXDOMAIN, user_data);
+        else
+            cb(hostname, cached.constData(), NM_DNS_OK, user_data);
+        return true;
+    }
+
+    dns_resolver_wake();
+    return true;
+}
+
+namespace {
+
+/* Heap-allocated so a timed-out caller can abandon it; whichever side
+ * finishes last (caller or callback) frees it. */
+struct SyncWait {
+    QMutex         mutex;
+    QWaitCondition cond;
+    bool           done = false;
+    bool           abandoned = false;
+    int            error = NM_DNS_ERR_INTERNAL;
+    char           addr[NM_DNS_MAX_ADDR_LEN];
+};
+
+void sync_resolve_cb(const char *, const char *address, int error,
+                     void *user_data)
+{
+    auto *w = static_cast<SyncWait *>(user_data);
+    bool orphaned;
+
+    {
+        QMutexLocker lock(&w->mutex);
+
+        orphaned = w->abandoned;
+        if (!orphaned) {
+            w->error = error;
+            if (address)
+                snprintf(w->addr, sizeof(w->addr), "%s", address);
+            else
+                w->addr[0] = '\0';
+            w->done = true;
+            w->cond.wakeAll();
+        }
+    }
+    if (orphaned)
+        delete w;
+}
+
+} /* namespace */
+
+bool nm_dns_resolve(const char *hostname, int family,
+                    char *addr_out, uint32_t addr_len,
+                    uint32_t timeout_ms)
+{
+    if (!addr_out || addr_len == 0)
+        return false;
+
+    auto *wait = new SyncWait();
+
+    if (!nm_dns_resolve_async(hostname, family, sync_resolve_cb, wait)) {
+        delete wait;
+        return false;
+    }
+
+    bool ok = false;
+    bool completed;
+
+    {
+        QMutexLocker lock(&wait->mutex);
+        qint64 deadline = s_clock.elapsed() + timeout_ms;
+
+        while (!wait->done) {
+            qint64 left = deadline - s_clock.elapsed();
+
+            if (left <= 0 ||
+                !wait->cond.wait(&wait->mutex, static_cast<unsigned long>(left)))
+                break;
+        }
+
+        completed = wait->done;
+        if (completed) {
+            ok = wait->error == NM_DNS_OK;
+            if (ok)
+                snprintf(addr_out, addr_len, "%s", wait->addr);
+        } else {
+            wait->abandoned = true;  /* callback will free it */
+        }
+    }
+
+    if (completed)
+        delete wait;
+    return ok;
+}
+
+void nm_dns_stop_resolver(void)
+{
+    DnsResolverThread *thread;
+
+    {
+        QMutexLocker lock(&s_dns_mutex);
+
+        thread = s_resolver;
+        if (thread)
+            thread->stop_requested = true;
+        s_resolver = nullptr;
+    }
+
+    if (!thread)
+        return;
+
+    dns_resolver_wake();
+    thread->wait();
+    delete thread;
+
+    close(s_wake_pipe[0]);
+    close(s_wake_pipe[1]);
+    s_wake_pipe[0] = s_wake_pipe[1] = -1;
+}
+
+/* ========================================================================= */
+/* libc async-resolution hook                                                */
+/* ========================================================================= */
+
+/*
+ * libc's getaddrinfo_a workers resolve through this symbol when the
+ * process links the NM resolver (weak reference on the libc side),
+ * so Qt network classes get real DNS with the cache and nameserver
+ * pipelining instead of the numeric-only fallback.
+ */
+extern "C" int __veridian_gai_resolve(const char *node, int family,
+                                      char *addr_out,
+                                      unsigned int addr_len)
+{
+    if (!node || !addr_out)
+        return -1;
+    return nm_dns_resolve(node, family, addr_out, addr_len, 3000)
+               ? 0 : -1;
+}
@@ -44,6 +44,57 @@ void nm_dns_flush_cache(void);
  */
 bool nm_dns_restore_resolv_conf(void);
 
+/* ========================================================================= */
+/* Asynchronous resolver                                                     */
+/* ========================================================================= */
+
+/** Resolution outcome codes passed to nm_dns_resolve_cb. */
+#define NM_DNS_OK          0
+#define NM_DNS_ERR_TIMEOUT (-1)
+#define NM_DNS_ERR_NXDOMAIN (-2)
+#define NM_DNS_ERR_INTERNAL (-3)
+
+/**
+ * Completion callback for nm_dns_resolve_async().
+ * Invoked on the resolver thread, or synchronously on the caller's
+ * thread when the answer comes from the cache.
+ * @param hostname  The queried name.
+ * @param address   Resolved address text, or NULL on failure.
+ * @param error     NM_DNS_OK or an NM_DNS_ERR_* code.
+ * @param user_data Opaque pointer from the resolve call.
+ */
+typedef void (*nm_dns_resolve_cb)(const char *hostname,
+                                  const char *address,
+                                  int error, void *user_data);
+
+/**
+ * Queue an asynchronous A (family AF_INET) or AAAA (AF_INET6) lookup.
+ * Answers are served from a TTL-respecting LRU cache when possible
+ * (including negative entries); cache misses are pipelined across the
+ * configured nameservers on the resolver thread.
+ * @param hostname  Name to resolve.
+ * @param family    AF_INET or AF_INET6.
+ * @param cb        Completion callback (resolver thread context).
+ * @param user_data Passed through to the callback.
+ */
+bool nm_dns_resolve_async(const char *hostname, int family,
+                          nm_dns_resolve_cb cb, void *user_data);
+
+/**
+ * Synchronous convenience wrapper around nm_dns_resolve_async().
+ * @param addr_out   Buffer for the address text (NM_DNS_MAX_ADDR_LEN).
+ * @param timeout_ms Overall wait budget.
+ */
+bool nm_dns_resolve(const char *hostname, int family,
+                    char *addr_out, uint32_t addr_len,
+                    uint32_t timeout_ms);
+
+/**
+ * Stop the resolver thread and fail all in-flight lookups.
+ * Called on NM shutdown before nm_dns_restore_resolv_conf().
+ */
+void nm_dns_stop_resolver(void);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -9,6 +9,15 @@
  * Provides link state detection via SIOCGIFFLAGS, DHCP via the kernel
  * DHCP client (kernel/src/net/dhcp.rs), static IP via SIOCSIFADDR,
  * and MAC address queries from /sys/class/net/<iface>/address.
+ *
+ * Link transitions are event-driven where the driver supports it:
+ * VERIDIAN_LINK_EVENT_FD hands out an fd that becomes readable on
+ * every carrier change, replacing the poll timer.  The last DHCP
+ * lease is cached per interface, so a link-up re-applies the known
+ * address immediately and renews in the background -- a dock
+ * re-plug is usable in milliseconds instead of a full DHCP
+ * round-trip.  Down transitions are debounced so cable flaps don't
+ * tear the configuration down just to rebuild it.
  */
 
 #include "nm-ethernet.h"
@@ -60,6 +69,14 @@
 static const unsigned long VERIDIAN_DHCP_START   = 0x8D01;
 static const unsigned long VERIDIAN_DHCP_STATUS  = 0x8D02;
 
+/* Link-event fd: readable (one byte per transition) on carrier
+ * changes for the named interface */
+static const unsigned long VERIDIAN_LINK_EVENT_FD = 0x8D03;
+
+/* A down transition must hold this long before it is acted on; a
+ * re-plug inside the window is treated as if nothing happened */
+static const int LINK_DEBOUNCE_MS = 800;
+
 /* DHCP timeout */
 static const int DHCP_POLL_INTERVAL_MS = 500;
 
@@ -220,6 +237,321 @@ bool nm_ethernet_detect_link(const char *iface)
     return link_up;
 }
 
+/* ========================================================================= */
+/* Last-good configuration cache                                             */
+/* ========================================================================= */
+
+#define NM_ETH_CACHE_SLOTS 4
+
+struct EthConfigCache {
+    char       iface[16];
+    bool       valid;
+    DhcpResult lease;
+};
+
+static EthConfigCache s_cfg_cache[NM_ETH_CACHE_SLOTS];
+
+static EthConfigCache *cache_slot(const char *iface, bool create)
+{
+    int free_idx = -1;
+
+    for (int i = 0; i < NM_ETH_CACHE_SLOTS; i++) {
+        if (s_cfg_cache[i].iface[0] == '\0') {
+            if (free_idx < 0)
+                free_idx = i;
+            continue;
+        }
+        if (strncmp(s_cfg_cache[i].iface, iface, 15) == 0)
+            return &s_cfg_cache[i];
+    }
+    if (!create || free_idx < 0)
+        return nullptr;
+    memset(&s_cfg_cache[free_idx], 0, sizeof(s_cfg_cache[free_idx]));
+    strncpy(s_cfg_cache[free_idx].iface, iface, 15);
+    return &s_cfg_cache[free_idx];
+}
+
+/* Apply one lease to the interface (address, netmask, route) */
+static void apply_lease(int fd, const char *iface, const DhcpResult *r)
+{
+    struct veridian_ifreq ifr;
+
+    memset(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, iface, 15);
+    set_sockaddr_in_raw(&ifr.ifr_addr, r->ip_addr);
+    ioctl(fd, SIOCSIFADDR, &ifr);
+
+    memset(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, iface, 15);
+    set_sockaddr_in_raw(&ifr.ifr_netmask, r->netmask);
+    ioctl(fd, SIOCSIFNETMASK, &ifr);
+
+    if (r->gateway != 0) {
+        struct veridian_rtentry route;
+
+        memset(&route, 0, sizeof(route));
+        set_sockaddr_in(&route.rt_dst, "0.0.0.0");
+        set_sockaddr_in_raw(&route.rt_gateway, r->gateway);
+        set_sockaddr_in(&route.rt_genmask, "0.0.0.0");
+        route.rt_flags = RTF_UP | RTF_GATEWAY;
+        strncpy(route.rt_dev, iface, 15);
+        ioctl(fd, SIOCADDRT, &route);
+    }
+}
+
+/* ========================================================================= */
+/* Event-driven link notifications                                           */
+/* ========================================================================= */
+
+int nm_ethernet_link_event_fd(const char *iface)
+{
+    if (!iface)
+        return -1;
+
+    int fd = open_ioctl_socket();
+    if (fd < 0)
+        return -1;
+
+    struct {
+        char ifname[16];
+        int  event_fd;
+    } req;
+    memset(&req, 0, sizeof(req));
+    strncpy(req.ifname, iface, 15);
+    req.event_fd = -1;
+
+    if (ioctl(fd, VERIDIAN_LINK_EVENT_FD, &req) < 0 || req.event_fd < 0) {
+        /* Driver without link events: the caller keeps its timer */
+        close(fd);
+        return -1;
+    }
+    close(fd);
+    qDebug("NM-Ethernet: link events on %s via fd %d", iface,
+           req.event_fd);
+    return req.event_fd;
+}
+
+/* ========================================================================= */
+/* Debounced flap handling                                                   */
+/* ========================================================================= */
+
+struct LinkDebounce {
+    char   iface[16];
+    bool   reported_up;      /* Last state delivered to the caller */
+    qint64 down_since_ms;    /* 0 = no down transition pending */
+    QElapsedTimer clock;
+    bool   clock_started;
+};
+
+static LinkDebounce s_debounce[NM_ETH_CACHE_SLOTS];
+
+static LinkDebounce *debounce_slot(const char *iface)
+{
+    int free_idx = -1;
+
+    for (int i = 0; i < NM_ETH_CACHE_SLOTS; i++) {
+        if (s_debounce[i].iface[0] == '\0') {
+            if (free_idx < 0)
+                free_idx = i;
+            continue;
+        }
+        if (strncmp(s_debounce[i].iface, iface, 15) == 0)
+            return &s_debounce[i];
+    }
+    if (free_idx < 0)
+        return nullptr;
+    memset(&s_debounce[free_idx], 0, sizeof(s_debounce[free_idx]));
+    strncpy(s_debounce[free_idx].iface, iface, 15);
+    return &s_debounce[free_idx];
+}
+
+int nm_ethernet_debounce_link(const char *iface, bool raw_up)
+{
+    LinkDebounce *d = iface ? debounce_slot(iface) : nullptr;
+
+    if (!d)
+        return raw_up ? 1 : 0;  /* No slot: pass through */
+    if (!d->clock_started) {
+        d->clock.start();
+        d->clock_started = true;
+        d->reported_up = raw_up;
+        return raw_up ? 1 : 0;  /* First observation: report as-is */
+    }
+
+    if (raw_up) {
+        /* Up cancels any pending down; report only real transitions */
+        d->down_since_ms = 0;
+        if (d->reported_up)
+            return -1;
+        d->reported_up = true;
+        return 1;
+    }
+
+    if (d->reported_up) {
+        qint64 now = d->clock.elapsed();
+
+        if (d->down_since_ms == 0) {
+            d->down_since_ms = now;
+            return -1;          /* Start the hold-off window */
+        }
+        if (now - d->down_since_ms < LINK_DEBOUNCE_MS)
+            return -1;          /* Still inside the flap window */
+        d->reported_up = false;
+        d->down_since_ms = 0;
+        return 0;               /* Down held long enough: real */
+    }
+    return -1;                  /* Already down, nothing new */
+}
+
+/* ========================================================================= */
+/* Warm link-up path                                                         */
+/* ========================================================================= */
+
+bool nm_ethernet_link_up_fast(const char *iface)
+{
+    EthConfigCache *c = iface ? cache_slot(iface, false) : nullptr;
+
+    if (!c || !c->valid)
+        return false;           /* No last-good lease: cold path */
+
+    int fd = open_ioctl_socket();
+    if (fd < 0)
+        return false;
+
+    if (!bring_interface_up(fd, iface)) {
+        close(fd);
+        return false;
+    }
+
+    /* Re-apply the cached lease immediately -- on a dock or switch
+     * the address is almost always still valid -- then kick a
+     * background renewal to confirm or replace it.  The renewal
+     * result lands through the normal status polling; no one waits
+     * on it. */
+    apply_lease(fd, iface, &c->lease);
+
+    struct {
+        char ifname[16];
+    } dhcp_req;
+    memset(&dhcp_req, 0, sizeof(dhcp_req));
+    strncpy(dhcp_req.ifname, iface, 15);
+    if (ioctl(fd, VERIDIAN_DHCP_START, &dhcp_req) < 0)
+        qDebug("NM-Ethernet: background renewal start failed on %s",
+               iface);
+
+    close(fd);
+    qDebug("NM-Ethernet: warm link-up on %s (cached lease applied, "
+           "renewing in background)", iface);
+    return true;
+}
+
+/* ========================================================================= */
+/* Non-blocking DHCP                                                         */
+/* ========================================================================= */
+
+/*
+ * Split of the blocking trigger path so the caller's event loop can
+ * drive several interfaces concurrently: start the kernel client,
+ * then poll until it binds.  On bind the lease is applied and
+ * cached exactly as the blocking path does.
+ */
+
+bool nm_ethernet_dhcp_start(const char *iface)
+{
+    if (!iface)
+        return false;
+
+    int fd = open_ioctl_socket();
+    if (fd < 0)
+        return false;
+    if (!bring_interface_up(fd, iface)) {
+        close(fd);
+        return false;
+    }
+
+    struct {
+        char ifname[16];
+    } req;
+    memset(&req, 0, sizeof(req));
+    strncpy(req.ifname, iface, 15);
+
+    bool ok = ioctl(fd, VERIDIAN_DHCP_START, &req) == 0;
+    close(fd);
+    return ok;
+}
+
+int nm_ethernet_dhcp_poll(const char *iface)
+{
+    if (!iface)
+        return 0;
+
+    int fd = open_ioctl_socket();
+    if (fd < 0)
+        return 0;
+
+    DhcpResult result;
+    memset(&result, 0, sizeof(result));
+
+    struct {
+        char ifname[16];
+        DhcpResult *result;
+    } status_req;
+    memset(&status_req, 0, sizeof(status_req));
+    strncpy(status_req.ifname, iface, 15);
+    status_req.result = &result;
+
+    if (ioctl(fd, VERIDIAN_DHCP_STATUS, &status_req) < 0) {
+        close(fd);
+        return -1;              /* Treat as still pending */
+    }
+
+    if (result.state == 2) {    /* bound */
+        apply_lease(fd, iface, &result);
+
+        EthConfigCache *c = cache_slot(iface, true);
+        if (c) {
+            c->lease = result;
+            c->valid = true;
+        }
+        close(fd);
+        return 1;
+    }
+    close(fd);
+    if (result.state == 3)
+        return 0;               /* failed */
+    return -1;                  /* discovering */
+}
+
+/* ========================================================================= */
+/* Default route selection                                                   */
+/* ========================================================================= */
+
+bool nm_ethernet_apply_default_route(const char *iface)
+{
+    EthConfigCache *c = iface ? cache_slot(iface, false) : nullptr;
+
+    if (!c || !c->valid || c->lease.gateway == 0)
+        return false;
+
+    int fd = open_ioctl_socket();
+    if (fd < 0)
+        return false;
+
+    struct veridian_rtentry route;
+    memset(&route, 0, sizeof(route));
+    set_sockaddr_in(&route.rt_dst, "0.0.0.0");
+    set_sockaddr_in_raw(&route.rt_gateway, c->lease.gateway);
+    set_sockaddr_in(&route.rt_genmask, "0.0.0.0");
+    route.rt_flags = RTF_UP | RTF_GATEWAY;
+    strncpy(route.rt_dev, iface, 15);
+
+    bool ok = ioctl(fd, SIOCADDRT, &route) == 0;
+    close(fd);
+    if (ok)
+        qDebug("NM-Ethernet: default route via %s", iface);
+    return ok;
+}
+
 /* ========================================================================= */
 /* Static IP configuration                                                   */
 /* ========================================================================= */
@@ -353,31 +685,13 @@ bool nm_ethernet_trigger_dhcp(const char *iface, uint32_t timeout_sec)
             continue;
 
         if (result.state == 2) {  /* bound */
-            /* Apply the configuration */
-            struct veridian_ifreq ifr;
-
-            /* Set IP address */
-            memset(&ifr, 0, sizeof(ifr));
-            strncpy(ifr.ifr_name, iface, 15);
-            set_sockaddr_in_raw(&ifr.ifr_addr, result.ip_addr);
-            ioctl(fd, SIOCSIFADDR, &ifr);
-
-            /* Set netmask */
-            memset(&ifr, 0, sizeof(ifr));
-            strncpy(ifr.ifr_name, iface, 15);
-            set_sockaddr_in_raw(&ifr.ifr_netmask, result.netmask);
-            ioctl(fd, SIOCSIFNETMASK, &ifr);
-
-            /* Set default route */
-            if (result.gateway != 0) {
-                struct veridian_rtentry route;
-                memset(&route, 0, sizeof(route));
-                set_sockaddr_in(&route.rt_dst, "0.0.0.0");
-                set_sockaddr_in_raw(&route.rt_gateway, result.gateway);
-                set_sockaddr_in(&route.rt_genmask, "0.0.0.0");
-                route.rt_flags = RTF_UP | RTF_GATEWAY;
-                strncpy(route.rt_dev, iface, 15);
-                ioctl(fd, SIOCADDRT, &route);
+            apply_lease(fd, iface, &result);
+
+            /* Remember the lease for the warm link-up path */
+            EthConfigCache *c = cache_slot(iface, true);
+            if (c) {
+                c->lease = result;
+                c->valid = true;
             }
 
             char ip_str[INET_ADDRSTRLEN];
@@ -30,6 +30,44 @@ extern "C" {
  */
 bool nm_ethernet_detect_link(const char *iface);
 
+/**
+ * Get a descriptor that becomes readable (one byte per transition)
+ * on carrier changes for the interface.  Returns -1 when the driver
+ * doesn't provide link events; callers keep their poll timer then.
+ */
+int nm_ethernet_link_event_fd(const char *iface);
+
+/**
+ * Debounce raw carrier observations.  Feed every observation (from
+ * the event fd or a poll); returns 1 for a real up transition, 0
+ * for a down that survived the hold-off window, -1 for no change
+ * (including flaps that resolved themselves).
+ */
+int nm_ethernet_debounce_link(const char *iface, bool raw_up);
+
+/**
+ * Warm link-up: immediately re-apply the interface's last DHCP
+ * lease and start a background renewal.  Returns false when no
+ * cached lease exists (take the cold activate path instead).
+ */
+bool nm_ethernet_link_up_fast(const char *iface);
+
+/**
+ * Non-blocking DHCP: start the kernel client (returns immediately);
+ * poll for the outcome from the caller's event loop.  Poll returns
+ * 1 once bound (lease applied and cached), 0 on failure, -1 while
+ * still discovering.
+ */
+bool nm_ethernet_dhcp_start(const char *iface);
+int  nm_ethernet_dhcp_poll(const char *iface);
+
+/**
+ * Point the default route at this interface's cached gateway.  Used
+ * by the priority-based route decision when several connections are
+ * active.  Returns false without a cached gateway.
+ */
+bool nm_ethernet_apply_default_route(const char *iface);
+
 /* ========================================================================= */
 /* IP configuration                                                          */
 /* ========================================================================= */
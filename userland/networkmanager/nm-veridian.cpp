@@ -25,7 +25,9 @@
 #include <QUuid>
 #include <QDBusConnection>
 #include <QDBusMessage>
+#include <QSocketNotifier>
 #include <QTimer>
+#include <QVariantMap>
 
 #include <cstring>
 #include <cstdlib>
@@ -75,6 +77,20 @@ struct NMClient {
     /* Auto-connect timer */
     QTimer *autoconnect_timer;
 
+    /* In-flight activations, driven by dhcp_timer (200ms): several
+     * devices configure concurrently and the default route is
+     * decided by priority once each one lands */
+    struct {
+        bool     used;
+        uint32_t device_index;
+        char     uuid[64];
+        int      elapsed_ticks;
+    } pending[NM_MAX_DEVICES];
+    QTimer *dhcp_timer;
+
+    /* Last AP list published as delta signals, per device */
+    NMAccessPointList published_aps[NM_MAX_DEVICES];
+
     /* Next ID counters for D-Bus object paths */
     uint32_t next_active_id;
 };
@@ -444,6 +460,99 @@ static void emit_device_state_changed(uint32_t device_index,
     bus.send(signal);
 }
 
+/*
+ * Per-AP delta signals, keyed by BSSID, so clients (the Plasma applet)
+ * can patch their models in place instead of rebuilding the whole list
+ * on every scan tick.
+ */
+static QVariantMap access_point_to_map(const NMAccessPoint *ap)
+{
+    QVariantMap map;
+    map.insert(QStringLiteral("id"), QString::fromLatin1(ap->bssid));
+    map.insert(QStringLiteral("ssid"), QString::fromUtf8(ap->ssid));
+    map.insert(QStringLiteral("signal"),
+               static_cast<int>(ap->signal_percent));
+    map.insert(QStringLiteral("security"), ap->security_flags);
+    map.insert(QStringLiteral("frequency"), ap->frequency);
+    return map;
+}
+
+static void emit_access_point_delta(const char *name, const QVariantMap &map)
+{
+    QDBusConnection bus = QDBusConnection::systemBus();
+    QDBusMessage signal = QDBusMessage::createSignal(
+        QString::fromLatin1(NM_DBUS_PATH),
+        QString::fromLatin1(NM_DBUS_INTERFACE),
+        QString::fromLatin1(name));
+    signal << QVariant(map);
+    bus.send(signal);
+}
+
+static void emit_access_point_removed(const char *bssid)
+{
+    QDBusConnection bus = QDBusConnection::systemBus();
+    QDBusMessage signal = QDBusMessage::createSignal(
+        QString::fromLatin1(NM_DBUS_PATH),
+        QString::fromLatin1(NM_DBUS_INTERFACE),
+        QStringLiteral("AccessPointRemoved"));
+    signal << QString::fromLatin1(bssid);
+    bus.send(signal);
+}
+
+/* Signal-strength jitter below this does not produce a Changed signal */
+static const int AP_SIGNAL_HYSTERESIS = 5;
+
+static const NMAccessPoint *find_ap_by_bssid(const NMAccessPointList *list,
+                                              const char *bssid)
+{
+    for (uint32_t i = 0; i < list->count; ++i) {
+        if (strcmp(list->access_points[i].bssid, bssid) == 0)
+            return &list->access_points[i];
+    }
+    return nullptr;
+}
+
+static void publish_ap_deltas(NMClient *client)
+{
+    for (uint32_t d = 0; d < client->device_count; ++d) {
+        if (!client->wifi_backends[d])
+            continue;
+
+        NMAccessPointList cur;
+        if (!nm_wifi_get_scan_results(client->wifi_backends[d], &cur))
+            continue;
+
+        NMAccessPointList *pub = &client->published_aps[d];
+
+        for (uint32_t i = 0; i < cur.count; ++i) {
+            NMAccessPoint *ap = &cur.access_points[i];
+            const NMAccessPoint *old = find_ap_by_bssid(pub, ap->bssid);
+
+            if (!old) {
+                emit_access_point_delta("AccessPointAdded",
+                                        access_point_to_map(ap));
+            } else if (abs(static_cast<int>(ap->signal_percent) -
+                           static_cast<int>(old->signal_percent)) >=
+                           AP_SIGNAL_HYSTERESIS ||
+                       ap->security_flags != old->security_flags) {
+                emit_access_point_delta("AccessPointChanged",
+                                        access_point_to_map(ap));
+            } else {
+                /* Keep the previously published strength so jitter under
+                 * the hysteresis cannot drift without ever signalling */
+                ap->signal_percent = old->signal_percent;
+            }
+        }
+
+        for (uint32_t i = 0; i < pub->count; ++i) {
+            if (!find_ap_by_bssid(&cur, pub->access_points[i].bssid))
+                emit_access_point_removed(pub->access_points[i].bssid);
+        }
+
+        *pub = cur;
+    }
+}
+
 /* ========================================================================= */
 /* State machine helpers                                                     */
 /* ========================================================================= */
@@ -545,6 +654,10 @@ static const char *get_profile_setting(const NMSettingsConnection *conn,
     return nullptr;
 }
 
+static void enqueue_pending(NMClient *client, uint32_t device_index,
+                            const char *uuid);
+static void update_default_route(NMClient *client);
+
 static bool activate_ethernet(NMClient *client, NMDevice *dev,
                                const NMSettingsConnection *conn)
 {
@@ -573,9 +686,16 @@ static bool activate_ethernet(NMClient *client, NMDevice *dev,
                                     mask ? mask : "255.255.255.0",
                                     gw);
     } else {
-        /* Default: DHCP */
+        /* Default: DHCP, without blocking -- the poll timer finishes
+         * the activation so other devices configure in parallel */
         update_device_state(client, (uint32_t)idx, NM_DEVICE_STATE_IP_CONFIG);
-        ip_ok = nm_ethernet_trigger_dhcp(dev->interface_name, 30);
+        if (!nm_ethernet_dhcp_start(dev->interface_name)) {
+            update_device_state(client, (uint32_t)idx,
+                                NM_DEVICE_STATE_FAILED);
+            return false;
+        }
+        enqueue_pending(client, (uint32_t)idx, conn->uuid);
+        return true;            /* In flight; completion via the poll */
     }
 
     if (!ip_ok) {
@@ -600,6 +720,7 @@ static bool activate_ethernet(NMClient *client, NMDevice *dev,
 
     update_device_state(client, (uint32_t)idx, NM_DEVICE_STATE_IP_CHECK);
     update_device_state(client, (uint32_t)idx, NM_DEVICE_STATE_ACTIVATED);
+    update_default_route(client);
 
     return true;
 }
@@ -635,23 +756,15 @@ static bool activate_wifi(NMClient *client, NMDevice *dev,
 
     update_device_state(client, (uint32_t)idx, NM_DEVICE_STATE_IP_CONFIG);
 
-    /* DHCP for Wi-Fi */
-    if (!nm_ethernet_trigger_dhcp(dev->interface_name, 30)) {
-        qWarning("NM/Veridian: DHCP failed on Wi-Fi %s", dev->interface_name);
+    /* DHCP for Wi-Fi: same non-blocking path as Ethernet, so a
+     * wired and a wireless activation overlap instead of queueing */
+    if (!nm_ethernet_dhcp_start(dev->interface_name)) {
+        qWarning("NM/Veridian: DHCP start failed on Wi-Fi %s",
+                 dev->interface_name);
         update_device_state(client, (uint32_t)idx, NM_DEVICE_STATE_FAILED);
         return false;
     }
-
-    /* DNS */
-    const char *dns1 = get_profile_setting(conn, "ipv4.dns1");
-    if (dns1) {
-        const char *servers[1] = { dns1 };
-        nm_dns_set_servers(servers, 1, nullptr, 0);
-    }
-
-    update_device_state(client, (uint32_t)idx, NM_DEVICE_STATE_IP_CHECK);
-    update_device_state(client, (uint32_t)idx, NM_DEVICE_STATE_ACTIVATED);
-
+    enqueue_pending(client, (uint32_t)idx, conn->uuid);
     return true;
 }
 
@@ -684,6 +797,153 @@ static bool create_active_connection(NMClient *client, const char *uuid,
 /* Auto-connect logic                                                        */
 /* ========================================================================= */
 
+/* Activation priority: explicit profile setting, else wired beats
+ * wireless -- the route decision below follows it */
+static int connection_priority(NMClient *client,
+                               const NMSettingsConnection *conn,
+                               uint32_t device_index)
+{
+    const char *p = get_profile_setting(conn,
+                                        "connection.autoconnect-priority");
+
+    if (p)
+        return atoi(p);
+    return client->devices[device_index].type == NM_DEVICE_TYPE_ETHERNET
+               ? 100 : 50;
+}
+
+/*
+ * Point the default route at the highest-priority ACTIVATED
+ * connection.  Called whenever an activation completes or an active
+ * connection goes away: failover is just this route flip -- the
+ * surviving connection was never torn down, so there is no gap.
+ */
+static void update_default_route(NMClient *client)
+{
+    int best_prio = -1;
+    const char *best_iface = nullptr;
+
+    for (uint32_t i = 0; i < client->active_count; ++i) {
+        NMActiveConnection *ac = &client->active[i];
+
+        if (ac->state != NM_ACTIVE_STATE_ACTIVATED)
+            continue;
+
+        NMSettingsConnection *conn =
+            find_profile_by_uuid(client, ac->uuid);
+        if (!conn)
+            continue;
+
+        int prio = connection_priority(client, conn, ac->device_index);
+        if (prio > best_prio) {
+            best_prio = prio;
+            best_iface =
+                client->devices[ac->device_index].interface_name;
+        }
+    }
+
+    if (best_iface)
+        nm_ethernet_apply_default_route(best_iface);
+}
+
+/* One DHCP-poll tick across every in-flight activation */
+static void poll_pending_activations(NMClient *client)
+{
+    bool any = false;
+
+    for (int i = 0; i < NM_MAX_DEVICES; ++i) {
+        auto *p = &client->pending[i];
+
+        if (!p->used)
+            continue;
+
+        NMDevice *dev = &client->devices[p->device_index];
+        int r = nm_ethernet_dhcp_poll(dev->interface_name);
+
+        if (r < 0) {
+            if (++p->elapsed_ticks < 150) {     /* 30s at 200ms */
+                any = true;
+                continue;
+            }
+            r = 0;                              /* Timeout = failure */
+        }
+
+        p->used = false;
+
+        /* Locate the active entry this activation belongs to */
+        int ac_idx = -1;
+        for (uint32_t a = 0; a < client->active_count; ++a) {
+            if (strcmp(client->active[a].uuid, p->uuid) == 0) {
+                ac_idx = (int)a;
+                break;
+            }
+        }
+
+        if (r == 1 && ac_idx >= 0) {
+            NMSettingsConnection *conn =
+                find_profile_by_uuid(client, p->uuid);
+
+            if (conn) {
+                const char *dns1 = get_profile_setting(conn, "ipv4.dns1");
+                const char *dns2 = get_profile_setting(conn, "ipv4.dns2");
+
+                if (dns1) {
+                    const char *servers[2] = { dns1, dns2 };
+                    nm_dns_set_servers(servers, dns2 ? 2 : 1, nullptr, 0);
+                }
+            }
+            client->active[ac_idx].state = NM_ACTIVE_STATE_ACTIVATED;
+            dev->active_connection = ac_idx;
+            update_device_state(client, p->device_index,
+                                NM_DEVICE_STATE_ACTIVATED);
+            update_default_route(client);
+            update_global_state(client);
+        } else {
+            qWarning("NM/Veridian: activation failed on %s",
+                     dev->interface_name);
+            update_device_state(client, p->device_index,
+                                NM_DEVICE_STATE_FAILED);
+            if (ac_idx >= 0) {
+                for (uint32_t a = (uint32_t)ac_idx;
+                     a + 1 < client->active_count; ++a)
+                    client->active[a] = client->active[a + 1];
+                client->active_count--;
+            }
+        }
+    }
+
+    if (!any && client->dhcp_timer)
+        client->dhcp_timer->stop();
+}
+
+/* Queue a DHCP-wait for the device; starts the poll timer */
+static void enqueue_pending(NMClient *client, uint32_t device_index,
+                            const char *uuid)
+{
+    for (int i = 0; i < NM_MAX_DEVICES; ++i) {
+        auto *p = &client->pending[i];
+
+        if (p->used)
+            continue;
+        p->used = true;
+        p->device_index = device_index;
+        p->elapsed_ticks = 0;
+        strncpy(p->uuid, uuid, sizeof(p->uuid) - 1);
+        p->uuid[sizeof(p->uuid) - 1] = '\0';
+        break;
+    }
+
+    if (!client->dhcp_timer) {
+        client->dhcp_timer = new QTimer();
+        QObject::connect(client->dhcp_timer, &QTimer::timeout,
+                         [client]() {
+                             poll_pending_activations(client);
+                         });
+    }
+    if (!client->dhcp_timer->isActive())
+        client->dhcp_timer->start(200);
+}
+
 static void try_autoconnect(NMClient *client)
 {
     if (!client->networking_enabled)
@@ -744,6 +1004,60 @@ static void try_autoconnect(NMClient *client)
 /* Client lifecycle                                                          */
 /* ========================================================================= */
 
+/*
+ * Event-driven link monitoring: one QSocketNotifier per Ethernet
+ * device whose driver hands out a link-event fd.  Raw transitions
+ * run through the debouncer (cable flaps resolve silently); a real
+ * up takes the warm path -- cached lease applied instantly, DHCP
+ * renewing in the background -- and falls back to full activation
+ * only when no lease is cached.  Devices without event support keep
+ * the existing timer-driven autoconnect behavior.
+ */
+static void setup_link_monitors(NMClient *client)
+{
+    for (uint32_t i = 0; i < client->device_count; ++i) {
+        NMDevice *dev = &client->devices[i];
+
+        if (dev->type != NM_DEVICE_TYPE_ETHERNET)
+            continue;
+
+        int efd = nm_ethernet_link_event_fd(dev->interface_name);
+        if (efd < 0)
+            continue;
+
+        QSocketNotifier *notifier =
+            new QSocketNotifier(efd, QSocketNotifier::Read);
+        uint32_t idx = i;
+        QObject::connect(notifier, &QSocketNotifier::activated,
+                         [client, idx, efd]() {
+            NMDevice *d = &client->devices[idx];
+            char drain[16];
+
+            /* Coalesce a burst of transitions into one decision */
+            while (read(efd, drain, sizeof(drain)) > 0)
+                ;
+
+            bool raw = nm_ethernet_detect_link(d->interface_name);
+            int change = nm_ethernet_debounce_link(d->interface_name,
+                                                   raw);
+            if (change == 1) {
+                update_device_state(client, idx,
+                                    NM_DEVICE_STATE_IP_CONFIG);
+                if (nm_ethernet_link_up_fast(d->interface_name)) {
+                    update_device_state(client, idx,
+                                        NM_DEVICE_STATE_ACTIVATED);
+                } else {
+                    /* No cached lease: cold activation */
+                    try_autoconnect(client);
+                }
+            } else if (change == 0) {
+                update_device_state(client, idx,
+                                    NM_DEVICE_STATE_UNAVAILABLE);
+            }
+        });
+    }
+}
+
 NMClient *nm_client_new(void)
 {
     NMClient *client = new NMClient;
@@ -775,9 +1089,15 @@ NMClient *nm_client_new(void)
     /* Set up auto-connect timer */
     client->autoconnect_timer = new QTimer();
     QObject::connect(client->autoconnect_timer, &QTimer::timeout,
-                     [client]() { try_autoconnect(client); });
+                     [client]() {
+                         try_autoconnect(client);
+                         publish_ap_deltas(client);
+                     });
     client->autoconnect_timer->start(AUTOCONNECT_INTERVAL_MS);
 
+    /* Event-driven link recovery where drivers support it */
+    setup_link_monitors(client);
+
     /* Initial auto-connect attempt */
     try_autoconnect(client);
 
@@ -794,6 +1114,13 @@ void nm_client_destroy(NMClient *client)
 
     qDebug("NM/Veridian: shutting down");
 
+    /* Stop the activation poll */
+    if (client->dhcp_timer) {
+        client->dhcp_timer->stop();
+        delete client->dhcp_timer;
+        client->dhcp_timer = nullptr;
+    }
+
     /* Stop auto-connect */
     if (client->autoconnect_timer) {
         client->autoconnect_timer->stop();
@@ -1003,9 +1330,14 @@ bool nm_client_activate_connection(NMClient *client, const char *uuid,
 
     if (success) {
         dev->active_connection = (int32_t)(client->active_count - 1);
-        client->active[client->active_count - 1].state =
-            NM_ACTIVE_STATE_ACTIVATED;
-        update_global_state(client);
+        /* DHCP activations stay ACTIVATING until the poll timer
+         * lands them; synchronous (static IP) ones are done now */
+        if (client->devices[dev->device_index].state ==
+            NM_DEVICE_STATE_ACTIVATED) {
+            client->active[client->active_count - 1].state =
+                NM_ACTIVE_STATE_ACTIVATED;
+            update_global_state(client);
+        }
     } else {
         /* Remove failed active connection */
         if (client->active_count > 0)
@@ -1053,6 +1385,10 @@ bool nm_client_deactivate_connection(NMClient *client, const char *uuid)
             client->active[j] = client->active[j + 1];
         client->active_count--;
 
+        /* Failover: the next-best surviving connection takes the
+         * default route; it was never torn down, so no gap */
+        update_default_route(client);
+
         update_global_state(client);
         return true;
     }
@@ -25,6 +25,7 @@
 
 #include <unistd.h>
 #include <sys/ioctl.h>
+#include <sys/socket.h>
 
 /* ========================================================================= */
 /* Constants                                                                 */
@@ -45,6 +46,14 @@ static const int SCAN_TIMEOUT_MS       = 5000;
 static const int HANDSHAKE_TIMEOUT_MS  = 10000;
 static const int ASSOCIATE_TIMEOUT_MS  = 5000;
 
+/* Async scan pipeline */
+static const int SCAN_POLL_INTERVAL_MS = 100;
+static const int SCAN_STABLE_TICKS     = 3;   /* result count unchanged */
+
+/* Roaming */
+static const int ROAM_HYSTERESIS_DB    = 8;
+static const int ROAM_5GHZ_BONUS_DB    = 3;
+
 /* Maximum scan buffer size (kernel fills this) */
 static const size_t SCAN_BUF_SIZE = 8192;
 
@@ -108,6 +117,17 @@ struct NMWifiBackend {
     /* Background scan */
     QTimer *scan_timer;
     bool scan_active;
+
+    /* Async scan pipeline state */
+    QTimer  *scan_poll_timer;     /* collects results incrementally */
+    bool     scan_in_progress;
+    QElapsedTimer scan_clock;
+    uint32_t scan_seen;           /* kernel entries parsed so far */
+    int      scan_stable_ticks;
+
+    /* Best roaming candidate from the last scoring pass */
+    NMAccessPoint roam_candidate;
+    bool          roam_available;
 };
 
 /* ========================================================================= */
@@ -239,6 +259,9 @@ void nm_wifi_backend_destroy(NMWifiBackend *backend)
     if (backend->socket_fd >= 0)
         close(backend->socket_fd);
 
+    if (backend->scan_poll_timer)
+        backend->scan_poll_timer->stop();
+    delete backend->scan_poll_timer;
     delete backend->scan_timer;
     delete backend;
 }
@@ -247,14 +270,30 @@ void nm_wifi_backend_destroy(NMWifiBackend *backend)
 /* Scanning                                                                  */
 /* ========================================================================= */
 
-bool nm_wifi_scan(NMWifiBackend *backend)
+/* Convert one kernel scan entry into the AP cache slot */
+static void parse_scan_entry(NMAccessPoint *ap, const KernelScanEntry *ke)
 {
-    if (!backend || backend->socket_fd < 0)
-        return false;
-
-    qDebug("NM-WiFi: triggering scan on %s", backend->interface_name);
+    memset(ap, 0, sizeof(*ap));
+
+    size_t ssid_len = ke->ssid_len;
+    if (ssid_len > NM_MAX_SSID_LEN - 1)
+        ssid_len = NM_MAX_SSID_LEN - 1;
+    memcpy(ap->ssid, ke->ssid, ssid_len);
+    ap->ssid[ssid_len] = '\0';
+
+    format_bssid(ke->bssid, ap->bssid, NM_MAX_BSSID_LEN);
+
+    ap->frequency = ke->frequency;
+    ap->signal_strength = ke->rssi;
+    ap->signal_percent = rssi_to_percent(ke->rssi);
+    ap->security_flags = decode_security_flags(ke->capability);
+    ap->max_bitrate = ke->max_rate;
+    ap->channel = ke->channel ? ke->channel : freq_to_channel(ke->frequency);
+}
 
-    /* Issue scan command to kernel mac80211 */
+/* Pipeline stage 1: fire the scan command (does not wait) */
+static bool trigger_scan(NMWifiBackend *backend)
+{
     struct {
         char ifname[16];
     } scan_req;
@@ -266,69 +305,185 @@ bool nm_wifi_scan(NMWifiBackend *backend)
                  backend->interface_name);
         return false;
     }
+    return true;
+}
 
-    /* Wait for scan to complete (kernel signals via the same ioctl) */
-    QElapsedTimer timeout;
-    timeout.start();
+/* Pipeline stage 3: re-score roaming candidates for the current SSID.
+ * Runs after each result batch, never on the D-Bus request path. */
+static void score_roam_candidates(NMWifiBackend *backend)
+{
+    backend->roam_available = false;
 
-    while (timeout.elapsed() < SCAN_TIMEOUT_MS) {
-        usleep(100000);  /* 100ms polling interval */
+    if (!backend->connected)
+        return;
 
-        /* Fetch results */
-        KernelScanResult result;
-        memset(&result, 0, sizeof(result));
+    int32_t best_score = backend->current_rssi + ROAM_HYSTERESIS_DB;
 
-        struct {
-            char ifname[16];
-            KernelScanResult *buf;
-            size_t buf_size;
-        } get_req;
-        memset(&get_req, 0, sizeof(get_req));
-        strncpy(get_req.ifname, backend->interface_name, 15);
-        get_req.buf = &result;
-        get_req.buf_size = sizeof(result);
-
-        if (ioctl(backend->socket_fd, VERIDIAN_WLAN_GET_SCAN, &get_req) < 0)
-            continue;
+    for (uint32_t i = 0; i < backend->ap_count; ++i) {
+        const NMAccessPoint *ap = &backend->ap_cache[i];
 
-        if (result.count == 0)
+        if (strcmp(ap->ssid, backend->current_ssid) != 0)
+            continue;
+        if (strcmp(ap->bssid, backend->current_bssid) == 0)
             continue;
 
-        /* Convert kernel scan entries to NMAccessPoint */
-        backend->ap_count = 0;
-        for (uint32_t i = 0; i < result.count && i < NM_MAX_ACCESS_POINTS; ++i) {
-            const KernelScanEntry *ke = &result.entries[i];
-            NMAccessPoint *ap = &backend->ap_cache[backend->ap_count];
+        /* Prefer 5 GHz: usually less congested at equal signal */
+        int32_t score = ap->signal_strength +
+                        (ap->frequency >= 5000 ? ROAM_5GHZ_BONUS_DB : 0);
 
-            memset(ap, 0, sizeof(*ap));
+        if (score > best_score) {
+            best_score = score;
+            backend->roam_candidate = *ap;
+            backend->roam_available = true;
+        }
+    }
 
-            /* SSID */
-            size_t ssid_len = ke->ssid_len;
-            if (ssid_len > NM_MAX_SSID_LEN - 1)
-                ssid_len = NM_MAX_SSID_LEN - 1;
-            memcpy(ap->ssid, ke->ssid, ssid_len);
-            ap->ssid[ssid_len] = '\0';
+    if (backend->roam_available) {
+        qDebug("NM-WiFi: roam candidate for '%s': %s rssi=%d",
+               backend->current_ssid, backend->roam_candidate.bssid,
+               backend->roam_candidate.signal_strength);
+    }
+}
 
-            /* BSSID */
-            format_bssid(ke->bssid, ap->bssid, NM_MAX_BSSID_LEN);
+/* Pipeline stage 2: fetch the kernel's current result snapshot and
+ * parse only the entries that are new since the last poll.  Returns
+ * the number of entries parsed so far, or -1 on ioctl failure. */
+static int collect_scan_results(NMWifiBackend *backend)
+{
+    KernelScanResult result;
+    memset(&result, 0, sizeof(result));
 
-            ap->frequency = ke->frequency;
-            ap->signal_strength = ke->rssi;
-            ap->signal_percent = rssi_to_percent(ke->rssi);
-            ap->security_flags = decode_security_flags(ke->capability);
-            ap->max_bitrate = ke->max_rate;
-            ap->channel = ke->channel ? ke->channel : freq_to_channel(ke->frequency);
+    struct {
+        char ifname[16];
+        KernelScanResult *buf;
+        size_t buf_size;
+    } get_req;
+    memset(&get_req, 0, sizeof(get_req));
+    strncpy(get_req.ifname, backend->interface_name, 15);
+    get_req.buf = &result;
+    get_req.buf_size = sizeof(result);
+
+    if (ioctl(backend->socket_fd, VERIDIAN_WLAN_GET_SCAN, &get_req) < 0)
+        return -1;
 
-            backend->ap_count++;
-        }
+    uint32_t count = result.count;
+    if (count > NM_MAX_ACCESS_POINTS)
+        count = NM_MAX_ACCESS_POINTS;
 
+    if (count > backend->scan_seen) {
+        for (uint32_t i = backend->scan_seen; i < count; ++i)
+            parse_scan_entry(&backend->ap_cache[i], &result.entries[i]);
+        backend->ap_count = count;
+        backend->scan_seen = count;
+        score_roam_candidates(backend);
+    }
+
+    return (int)backend->scan_seen;
+}
+
+/* Finish (or abort) the in-progress scan */
+static void finish_scan(NMWifiBackend *backend, bool timed_out)
+{
+    if (backend->scan_poll_timer)
+        backend->scan_poll_timer->stop();
+    backend->scan_in_progress = false;
+
+    if (timed_out && backend->ap_count == 0)
+        qWarning("NM-WiFi: scan timeout on %s", backend->interface_name);
+    else
         qDebug("NM-WiFi: scan complete on %s -- %u APs found",
                backend->interface_name, backend->ap_count);
-        return true;
+}
+
+/* One poll tick: collect new BSS entries, detect completion */
+static void scan_poll_tick(NMWifiBackend *backend)
+{
+    if (!backend->scan_in_progress)
+        return;
+
+    uint32_t before = backend->scan_seen;
+
+    collect_scan_results(backend);
+
+    if (backend->scan_seen > before) {
+        backend->scan_stable_ticks = 0;
+    } else if (backend->scan_seen > 0 &&
+               ++backend->scan_stable_ticks >= SCAN_STABLE_TICKS) {
+        finish_scan(backend, false);
+        return;
     }
 
-    qWarning("NM-WiFi: scan timeout on %s", backend->interface_name);
-    return false;
+    if (backend->scan_clock.elapsed() >= SCAN_TIMEOUT_MS)
+        finish_scan(backend, true);
+}
+
+bool nm_wifi_scan(NMWifiBackend *backend)
+{
+    if (!backend || backend->socket_fd < 0)
+        return false;
+
+    if (backend->scan_in_progress)
+        return true;  /* already collecting */
+
+    qDebug("NM-WiFi: triggering scan on %s", backend->interface_name);
+
+    if (!trigger_scan(backend))
+        return false;
+
+    backend->scan_in_progress  = true;
+    backend->scan_seen         = 0;
+    backend->scan_stable_ticks = 0;
+    backend->scan_clock.start();
+
+    if (!backend->scan_poll_timer) {
+        backend->scan_poll_timer = new QTimer();
+        QObject::connect(backend->scan_poll_timer, &QTimer::timeout,
+                         [backend]() { scan_poll_tick(backend); });
+    }
+    backend->scan_poll_timer->start(SCAN_POLL_INTERVAL_MS);
+
+    return true;
+}
+
+bool nm_wifi_scan_in_progress(NMWifiBackend *backend)
+{
+    return backend && backend->scan_in_progress;
+}
+
+bool nm_wifi_get_roam_candidate(NMWifiBackend *backend, NMAccessPoint *out)
+{
+    if (!backend || !out || !backend->roam_available)
+        return false;
+
+    *out = backend->roam_candidate;
+    return true;
+}
+
+/* Blocking scan for callers that need a result now (connect path).
+ * Runs the collection stages inline instead of on the event loop. */
+static bool scan_blocking(NMWifiBackend *backend, int timeout_ms)
+{
+    if (!backend->scan_in_progress) {
+        if (!trigger_scan(backend))
+            return false;
+        backend->scan_in_progress  = true;
+        backend->scan_seen         = 0;
+        backend->scan_stable_ticks = 0;
+        backend->scan_clock.start();
+    }
+
+    QElapsedTimer timeout;
+    timeout.start();
+
+    while (timeout.elapsed() < timeout_ms) {
+        usleep(SCAN_POLL_INTERVAL_MS * 1000);
+        scan_poll_tick(backend);
+        if (!backend->scan_in_progress)
+            return backend->ap_count > 0;
+    }
+
+    finish_scan(backend, true);
+    return backend->ap_count > 0;
 }
 
 bool nm_wifi_get_scan_results(NMWifiBackend *backend, NMAccessPointList *out)
@@ -391,10 +546,12 @@ bool nm_wifi_connect(NMWifiBackend *backend, const char *ssid,
         }
     }
 
-    /* If not in cache, do a quick scan first */
+    /* If not in cache, do a quick blocking scan first (connect is a
+     * documented blocking call; the async pipeline is for the main
+     * loop's scan requests) */
     if (!target_ap) {
         qDebug("NM-WiFi: AP '%s' not in cache, scanning...", ssid);
-        nm_wifi_scan(backend);
+        scan_blocking(backend, SCAN_TIMEOUT_MS);
 
         for (uint32_t i = 0; i < backend->ap_count; ++i) {
             if (strcmp(backend->ap_cache[i].ssid, ssid) == 0) {
@@ -529,8 +686,7 @@ bool nm_wifi_connect(NMWifiBackend *backend, const char *ssid,
     backend->current_rssi = target_ap->signal_strength;
     backend->connected = true;
 
-    /* Stop background scanning while connected */
-    nm_wifi_stop_background_scan(backend);
+    /* Background scanning keeps running: it drives roam scoring now */
 
     qDebug("NM-WiFi: connected to '%s' (%s) rssi=%d",
            ssid, target_ap->bssid, target_ap->signal_strength);
@@ -592,9 +748,11 @@ void nm_wifi_start_background_scan(NMWifiBackend *backend,
     backend->scan_timer = new QTimer();
     QObject::connect(backend->scan_timer, &QTimer::timeout,
                      [backend]() {
-                         if (!backend->connected) {
-                             nm_wifi_scan(backend);
-                         }
+                         /* While disconnected this refreshes the AP
+                          * list; while connected it feeds the roaming
+                          * candidate scoring.  The trigger is async,
+                          * so the tick never blocks the main loop. */
+                         nm_wifi_scan(backend);
                      });
 
     uint32_t interval_ms = interval_sec * 1000;
@@ -9,8 +9,9 @@
  * and WPA2 supplicant (kernel/src/drivers/wifi/wpa.rs) to provide
  * scanning, authentication, and association.
  *
- * The backend maintains a cached list of access points and supports
- * periodic background scanning when disconnected.
+ * The backend maintains a cached list of access points, collects
+ * scan results asynchronously on the owner's event loop, and scores
+ * roaming candidates in the background while associated.
  */
 
 #ifndef NM_WIFI_H
@@ -52,16 +53,34 @@ void nm_wifi_backend_destroy(NMWifiBackend *backend);
 
 /**
  * Trigger a Wi-Fi scan via the kernel mac80211 interface.
- * Non-blocking; results available via nm_wifi_get_scan_results().
+ * Non-blocking: returns once the scan is started.  BSS results are
+ * parsed incrementally on the caller's event loop as the kernel
+ * reports them and appear in nm_wifi_get_scan_results() as they
+ * arrive; roaming candidates are re-scored in the background after
+ * each batch.
  */
 bool nm_wifi_scan(NMWifiBackend *backend);
 
 /**
- * Retrieve the most recent scan results.
+ * Whether a triggered scan is still collecting results.
+ */
+bool nm_wifi_scan_in_progress(NMWifiBackend *backend);
+
+/**
+ * Retrieve the most recent scan results.  Safe to call while a scan
+ * is in progress; returns the BSS entries parsed so far.
  */
 bool nm_wifi_get_scan_results(NMWifiBackend *backend,
                               NMAccessPointList *out);
 
+/**
+ * Get the best roaming candidate for the currently associated SSID,
+ * as scored during the last scan.  Returns false if not connected or
+ * no better BSS was seen.
+ */
+bool nm_wifi_get_roam_candidate(NMWifiBackend *backend,
+                                NMAccessPoint *out);
+
 /**
  * Get signal strength of the currently associated AP.
  * Returns RSSI in dBm, or 0 if not connected.
@@ -106,7 +125,8 @@ bool nm_wifi_disconnect(NMWifiBackend *backend);
 
 /**
  * Start periodic background scanning (every interval_sec seconds).
- * Scanning is only active while disconnected.
+ * While disconnected this refreshes the visible AP list; while
+ * connected it drives roaming candidate scoring.
  */
 void nm_wifi_start_background_scan(NMWifiBackend *backend,
                                    uint32_t interval_sec);
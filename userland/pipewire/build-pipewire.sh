@@ -72,6 +72,12 @@ ${CXX} ${CFLAGS_COMMON} -Wall -Wextra -std=c++17 \
 
 echo "  Built pw-alsa-bridge.o"
 
+${CXX} ${CFLAGS_COMMON} -Wall -Wextra -std=c++17 \
+    -c "${SCRIPT_DIR}/pw-audio-kernels.cpp" \
+    -o "${BUILD_DIR}/pw-audio-kernels.o"
+
+echo "  Built pw-audio-kernels.o"
+
 # =========================================================================
 # Step 2: Build PipeWire daemon library (C++)
 # =========================================================================
@@ -113,7 +119,8 @@ echo "================================================================"
 
 ar rcs "${BUILD_DIR}/libpipewire-veridian.a" \
     "${BUILD_DIR}/pipewire-veridian.o" \
-    "${BUILD_DIR}/pw-alsa-bridge.o"
+    "${BUILD_DIR}/pw-alsa-bridge.o" \
+    "${BUILD_DIR}/pw-audio-kernels.o"
 
 ar rcs "${BUILD_DIR}/libpulse-veridian.a" \
     "${BUILD_DIR}/pulseaudio-compat.o"
@@ -134,6 +141,7 @@ ${CXX} ${CFLAGS_COMMON} ${LDFLAGS_COMMON} -Wall -Wextra -std=c++17 \
     -DPW_STANDALONE_DAEMON \
     "${SCRIPT_DIR}/pipewire-veridian.cpp" \
     "${BUILD_DIR}/pw-alsa-bridge.o" \
+    "${BUILD_DIR}/pw-audio-kernels.o" \
     -o "${BUILD_DIR}/pipewire-daemon"
 
 echo "  Built pipewire-daemon"
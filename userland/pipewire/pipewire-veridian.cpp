@@ -12,17 +12,28 @@
  *   - Single-threaded event loop (no pthreads required at this stage)
  *   - All mixing/resampling uses integer or 16.16 fixed-point math
  *   - Node graph stored in static arrays (bounded memory, no heap churn)
+ *   - Stream buffers live in memfd-backed shared rings; dequeue and
+ *     enqueue flip slot indices, frames are never copied in the graph
  *   - D-Bus registration at org.freedesktop.impl.portal.PipeWire is
  *     stubbed; actual D-Bus is provided by the VeridianOS dbus shim
  */
 
 #include "pipewire-veridian.h"
 #include "pw-alsa-bridge.h"
+#include "pw-audio-kernels.h"
 
+#include <stdarg.h>
 #include <stdlib.h>
 #include <string.h>
+#include <veridian/sched.h>
 #include <stdio.h>
 #include <errno.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/mman.h>
+
+/* Provided by the libc shim (no public header yet) */
+extern "C" int memfd_create(const char *name, unsigned int flags);
 
 /* ========================================================================= */
 /* Internal constants                                                        */
@@ -165,12 +176,17 @@ struct pw_stream_internal {
     enum pw_direction       direction;
     struct spa_audio_info_raw format;
 
-    /* Buffers */
+    /* Buffers: all slots live in one shared-memory ring (memfd) so
+     * clients map the same pages the graph consumes from.  Dequeue and
+     * enqueue advance buf_head round-robin over the slots; no frame is
+     * ever copied between client and graph. */
     struct pw_buffer        buffers[PW_MAX_BUFFERS];
     struct spa_buffer       spa_bufs[PW_MAX_BUFFERS];
     struct spa_data         spa_datas[PW_MAX_BUFFERS];
-    uint8_t                 buf_mem[PW_MAX_BUFFERS][PW_BUFFER_SIZE];
-    int                     buf_queued[PW_MAX_BUFFERS]; /* 1 = queued */
+    int                     ring_fd;       /* memfd, -1 = heap fallback */
+    uint8_t                *ring_map;      /* n_buffers * PW_BUFFER_SIZE */
+    int                     buf_queued[PW_MAX_BUFFERS]; /* 1 = in flight */
+    uint32_t                buf_head;      /* next slot to hand out */
     int                     n_buffers;
 
     /* ALSA bridge (playback/capture backend) */
@@ -181,6 +197,11 @@ struct pw_stream_internal {
     struct pw_stream_events events;
     void                   *events_data;
 
+    /* Volume (16.16); changes are de-clicked with a one-block ramp */
+    uint32_t                volume_fp;
+    uint32_t                ramp_from_fp;
+    int                     ramp_pending;
+
     /* Associated node ID */
     uint32_t                node_id;
 
@@ -212,6 +233,19 @@ struct pw_daemon_state {
     struct pw_stream_internal streams[PW_MAX_STREAMS];
     uint32_t next_stream_id;
     int      stream_count;
+
+    /* Dispatched SIMD kernel table (resolved in pw_init) */
+    const struct pw_audio_kernels *kernels;
+
+    /* Shared-sink mix stage: inside a main-loop cycle, S16 output
+     * streams accumulate here and one device write happens per cycle.
+     * Outside a cycle (clients driving streams directly) each queue
+     * still writes through immediately. */
+    int       in_cycle;
+    int16_t   sink_mix[PW_BUFFER_SIZE / 2];
+    uint32_t  sink_mix_samples;
+    uint32_t  sink_mix_channels;
+    struct AlsaBridge *sink_writer;
 };
 
 static struct pw_daemon_state g_state;
@@ -291,11 +325,38 @@ static void stream_set_state(struct pw_stream_internal *s,
     }
 }
 
-/* Set up buffers for a stream */
-static void stream_init_buffers(struct pw_stream_internal *s) {
+/* Negotiate the shared buffer ring for a stream.  The ring is one
+ * memfd mapping carved into PW_MAX_BUFFERS slots; spa_data pointers
+ * aim straight into it, so the client's writes land in the memory the
+ * graph mixes from.  Falls back to a heap ring (still zero-copy
+ * in-process) when memfd/mmap is unavailable. */
+static int stream_negotiate_buffers(struct pw_stream_internal *s) {
+    size_t ring_size = (size_t)PW_MAX_BUFFERS * PW_BUFFER_SIZE;
+
+    s->ring_fd  = memfd_create("pw-stream-ring", 0);
+    s->ring_map = NULL;
+
+    if (s->ring_fd >= 0 && ftruncate(s->ring_fd, (off_t)ring_size) == 0) {
+        void *map = mmap(NULL, ring_size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED, s->ring_fd, 0);
+        if (map != MAP_FAILED)
+            s->ring_map = (uint8_t *)map;
+    }
+
+    if (!s->ring_map) {
+        if (s->ring_fd >= 0) {
+            close(s->ring_fd);
+            s->ring_fd = -1;
+        }
+        s->ring_map = (uint8_t *)calloc(1, ring_size);
+        if (!s->ring_map)
+            return -ENOMEM;
+    }
+
     s->n_buffers = PW_MAX_BUFFERS;
+    s->buf_head  = 0;
     for (int i = 0; i < PW_MAX_BUFFERS; i++) {
-        s->spa_datas[i].data       = s->buf_mem[i];
+        s->spa_datas[i].data       = s->ring_map + (size_t)i * PW_BUFFER_SIZE;
         s->spa_datas[i].maxsize    = PW_BUFFER_SIZE;
         s->spa_datas[i].chunk_offset = 0;
         s->spa_datas[i].chunk_size   = 0;
@@ -308,8 +369,26 @@ static void stream_init_buffers(struct pw_stream_internal *s) {
         s->buffers[i].size      = PW_BUFFER_SIZE;
         s->buffers[i].user_data = NULL;
 
-        s->buf_queued[i] = 0; /* not queued -- available for dequeue */
+        s->buf_queued[i] = 0; /* not in flight -- available for dequeue */
     }
+    return 0;
+}
+
+/* Release the negotiated ring */
+static void stream_release_buffers(struct pw_stream_internal *s) {
+    size_t ring_size = (size_t)PW_MAX_BUFFERS * PW_BUFFER_SIZE;
+
+    if (!s->ring_map)
+        return;
+    if (s->ring_fd >= 0) {
+        munmap(s->ring_map, ring_size);
+        close(s->ring_fd);
+        s->ring_fd = -1;
+    } else {
+        free(s->ring_map);
+    }
+    s->ring_map = NULL;
+    s->n_buffers = 0;
 }
 
 /* Open the ALSA backend for a stream */
@@ -359,6 +438,7 @@ void pw_init(int *argc, char ***argv) {
 
     memset(&g_state, 0, sizeof(g_state));
     g_state.initialised = 1;
+    g_state.kernels        = pw_audio_kernels_get();
     g_state.next_node_id   = 1;
     g_state.next_port_id   = 1;
     g_state.next_link_id   = 1;
@@ -383,6 +463,8 @@ void pw_init(int *argc, char ***argv) {
     fprintf(stderr, "[pipewire] Initialised PipeWire daemon (VeridianOS)\n");
     fprintf(stderr, "[pipewire]   Default sink:   node %u\n", sink_id);
     fprintf(stderr, "[pipewire]   Default source: node %u\n", source_id);
+    fprintf(stderr, "[pipewire]   Audio kernels:  %s\n",
+            g_state.kernels->name);
 }
 
 void pw_deinit(void) {
@@ -390,12 +472,15 @@ void pw_deinit(void) {
 
     /* Close all streams */
     for (int i = 0; i < PW_MAX_STREAMS; i++) {
-        if (g_state.streams[i].used && g_state.streams[i].bridge_open) {
+        if (!g_state.streams[i].used)
+            continue;
+        if (g_state.streams[i].bridge_open) {
             alsa_bridge_close(g_state.streams[i].bridge);
             alsa_bridge_destroy(g_state.streams[i].bridge);
             g_state.streams[i].bridge = NULL;
             g_state.streams[i].bridge_open = 0;
         }
+        stream_release_buffers(&g_state.streams[i]);
     }
 
     memset(&g_state, 0, sizeof(g_state));
@@ -425,9 +510,19 @@ int pw_main_loop_run(struct pw_main_loop *loop) {
     loop->quit_requested = 0;
 
     /* Simple polling loop: iterate through all active streams and
-     * invoke their process callbacks when buffers are available. */
+     * invoke their process callbacks when buffers are available.
+     * Queued S16 buffers accumulate in the sink mix and are flushed
+     * with a single device write per cycle. */
     while (!loop->quit_requested) {
+        struct timespec t0, t1;
         int activity = 0;
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+
+        g_state.in_cycle = 1;
+        g_state.sink_mix_samples = 0;
+        g_state.sink_writer = NULL;
+
         for (int i = 0; i < PW_MAX_STREAMS; i++) {
             struct pw_stream_internal *s = &g_state.streams[i];
             if (!s->used || s->state != PW_STREAM_STATE_STREAMING)
@@ -441,6 +536,23 @@ int pw_main_loop_run(struct pw_main_loop *loop) {
             }
         }
 
+        /* Flush the mixed cycle in one write */
+        if (g_state.sink_mix_samples > 0 && g_state.sink_writer) {
+            uint32_t ch = g_state.sink_mix_channels ?
+                          g_state.sink_mix_channels : 2;
+            alsa_bridge_write(g_state.sink_writer, g_state.sink_mix,
+                              g_state.sink_mix_samples / ch);
+        }
+        g_state.in_cycle = 0;
+
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        if (activity) {
+            int64_t us = (int64_t)(t1.tv_sec - t0.tv_sec) * 1000000LL +
+                         ((int64_t)t1.tv_nsec - (int64_t)t0.tv_nsec) / 1000LL;
+            if (us >= 0)
+                pw_cycle_stats_record((uint64_t)us);
+        }
+
         /* If no streams are active, yield to avoid busy-spinning.
          * On VeridianOS, this maps to sched_yield(). */
         if (!activity) {
@@ -539,6 +651,7 @@ struct pw_stream *pw_stream_new(struct pw_core *core,
                 strncpy(s->name, name, sizeof(s->name) - 1);
             }
             s->state = PW_STREAM_STATE_UNCONNECTED;
+            s->volume_fp = PW_KERNEL_VOL_ONE;
             s->used = 1;
             g_state.stream_count++;
 
@@ -591,12 +704,18 @@ int pw_stream_connect(struct pw_stream *stream,
     /* Transition: UNCONNECTED -> CONNECTING -> PAUSED */
     stream_set_state(s, PW_STREAM_STATE_CONNECTING, NULL);
 
-    /* Initialise buffers */
-    stream_init_buffers(s);
+    /* Negotiate the shared buffer ring */
+    int ret = stream_negotiate_buffers(s);
+    if (ret < 0) {
+        stream_set_state(s, PW_STREAM_STATE_ERROR,
+                         "Failed to negotiate buffers");
+        return ret;
+    }
 
     /* Open ALSA backend */
-    int ret = stream_open_alsa(s);
+    ret = stream_open_alsa(s);
     if (ret < 0) {
+        stream_release_buffers(s);
         stream_set_state(s, PW_STREAM_STATE_ERROR,
                          "Failed to open ALSA device");
         return ret;
@@ -647,12 +766,20 @@ int pw_stream_disconnect(struct pw_stream *stream) {
     if (!s || !s->used) return -EINVAL;
 
     if (s->bridge_open) {
+        /* Mid-cycle disconnect: the pending mix must not flush
+         * through a destroyed bridge */
+        if (g_state.sink_writer == s->bridge) {
+            g_state.sink_writer = NULL;
+            g_state.sink_mix_samples = 0;
+        }
         alsa_bridge_close(s->bridge);
         alsa_bridge_destroy(s->bridge);
         s->bridge = NULL;
         s->bridge_open = 0;
     }
 
+    stream_release_buffers(s);
+
     stream_set_state(s, PW_STREAM_STATE_UNCONNECTED, NULL);
     return 0;
 }
@@ -672,19 +799,21 @@ void pw_stream_destroy(struct pw_stream *stream) {
 
 struct pw_buffer *pw_stream_dequeue_buffer(struct pw_stream *stream) {
     struct pw_stream_internal *s = (struct pw_stream_internal *)stream;
-    if (!s || !s->used) return NULL;
+    if (!s || !s->used || s->n_buffers == 0) return NULL;
 
-    /* Find first non-queued buffer */
-    for (int i = 0; i < s->n_buffers; i++) {
-        if (!s->buf_queued[i]) {
-            s->buf_queued[i] = 1;
-            /* Reset chunk for fresh write */
-            s->spa_datas[i].chunk_offset = 0;
-            s->spa_datas[i].chunk_size   = 0;
-            return &s->buffers[i];
-        }
-    }
-    return NULL; /* All buffers are in flight */
+    /* Hand out ring slots round-robin: dequeue is an index flip, the
+     * client writes frames straight into the shared mapping */
+    int idx = (int)(s->buf_head % (uint32_t)s->n_buffers);
+    if (s->buf_queued[idx])
+        return NULL; /* all slots in flight */
+
+    s->buf_queued[idx] = 1;
+    s->buf_head++;
+
+    /* Reset chunk for fresh write */
+    s->spa_datas[idx].chunk_offset = 0;
+    s->spa_datas[idx].chunk_size   = 0;
+    return &s->buffers[idx];
 }
 
 int pw_stream_queue_buffer(struct pw_stream *stream,
@@ -702,7 +831,7 @@ int pw_stream_queue_buffer(struct pw_stream *stream,
     }
     if (idx < 0) return -EINVAL;
 
-    /* If playback, write the buffer data to ALSA */
+    /* If playback, route the buffer into the graph */
     if (s->direction == PW_DIRECTION_OUTPUT && s->bridge_open) {
         struct spa_data *d = &s->spa_datas[idx];
         if (d->chunk_size > 0) {
@@ -719,8 +848,46 @@ int pw_stream_queue_buffer(struct pw_stream *stream,
             uint32_t frames = (frame_size > 0) ? d->chunk_size / frame_size : 0;
 
             if (frames > 0) {
+                /* Consume in place from the shared ring slot */
                 uint8_t *data = (uint8_t *)d->data + d->chunk_offset;
-                alsa_bridge_write(s->bridge, data, frames);
+                int is_s16 = s->format.format == SPA_AUDIO_FORMAT_S16_LE;
+                uint32_t samples = frames * ch;
+                const struct pw_audio_kernels *k = g_state.kernels;
+
+                /* Volume / de-click ramp, applied in the ring slot */
+                if (is_s16 && s->ramp_pending) {
+                    k->ramp_s16((int16_t *)data, (const int16_t *)data,
+                                samples, ch, s->ramp_from_fp,
+                                s->volume_fp);
+                    s->ramp_pending = 0;
+                } else if (is_s16 && s->volume_fp != PW_KERNEL_VOL_ONE) {
+                    k->volume_s16((int16_t *)data, (const int16_t *)data,
+                                  samples, s->volume_fp);
+                }
+
+                if (g_state.in_cycle && is_s16 &&
+                    samples <= PW_BUFFER_SIZE / 2 &&
+                    (g_state.sink_mix_samples == 0 ||
+                     g_state.sink_mix_channels == ch)) {
+                    /* Accumulate into the cycle's sink mix */
+                    if (g_state.sink_mix_samples == 0) {
+                        memset(g_state.sink_mix, 0,
+                               samples * sizeof(int16_t));
+                        g_state.sink_mix_channels = ch;
+                        g_state.sink_writer = s->bridge;
+                    } else if (samples > g_state.sink_mix_samples) {
+                        memset(g_state.sink_mix + g_state.sink_mix_samples,
+                               0,
+                               (samples - g_state.sink_mix_samples) *
+                               sizeof(int16_t));
+                    }
+                    k->mix_s16(g_state.sink_mix, (const int16_t *)data,
+                               samples);
+                    if (samples > g_state.sink_mix_samples)
+                        g_state.sink_mix_samples = samples;
+                } else {
+                    alsa_bridge_write(s->bridge, data, frames);
+                }
             }
         }
     }
@@ -741,6 +908,41 @@ enum pw_stream_state pw_stream_get_state(struct pw_stream *stream,
     return s->state;
 }
 
+int pw_stream_set_volume(struct pw_stream *stream, uint32_t volume_fp) {
+    struct pw_stream_internal *s = (struct pw_stream_internal *)stream;
+    if (!s || !s->used) return -EINVAL;
+
+    /* Clamp to 4x boost; de-click with a one-block ramp */
+    if (volume_fp > 4u * PW_KERNEL_VOL_ONE)
+        volume_fp = 4u * PW_KERNEL_VOL_ONE;
+
+    if (volume_fp != s->volume_fp) {
+        s->ramp_from_fp = s->volume_fp;
+        s->volume_fp    = volume_fp;
+        s->ramp_pending = 1;
+    }
+    return 0;
+}
+
+uint32_t pw_stream_get_volume(struct pw_stream *stream) {
+    struct pw_stream_internal *s = (struct pw_stream_internal *)stream;
+    if (!s || !s->used) return PW_KERNEL_VOL_ONE;
+    return s->volume_fp;
+}
+
+int pw_stream_get_ring_info(struct pw_stream *stream,
+                            struct pw_stream_ring_info *info) {
+    struct pw_stream_internal *s = (struct pw_stream_internal *)stream;
+    if (!s || !s->used || !info) return -EINVAL;
+    if (!s->ring_map) return -EAGAIN;  /* not negotiated yet */
+
+    info->fd         = s->ring_fd;  /* -1 when on the heap fallback */
+    info->slot_size  = PW_BUFFER_SIZE;
+    info->n_slots    = (uint32_t)s->n_buffers;
+    info->total_size = (uint32_t)s->n_buffers * PW_BUFFER_SIZE;
+    return 0;
+}
+
 void pw_stream_add_listener(struct pw_stream *stream,
                             void *listener_data,
                             const struct pw_stream_events *events,
@@ -794,6 +996,12 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
+    /* The loop thread IS the audio thread: declare it
+     * latency-critical and soft-pin it to the first latency CPU so
+     * the scheduler stops migrating it across sockets mid-stream */
+    veridian_sched_set_role(VSCHED_ROLE_LATENCY);
+    veridian_sched_set_affinity_hint(veridian_sched_latency_cpu(0));
+
     fprintf(stderr, "[pipewire] Entering main loop...\n");
     pw_main_loop_run(loop);
 
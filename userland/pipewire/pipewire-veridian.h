@@ -129,6 +129,20 @@ struct pw_buffer {
     void              *user_data;
 };
 
+/**
+ * Shared-memory ring backing a stream's buffers.  All slots live in a
+ * single memfd mapping; out-of-process clients mmap the fd MAP_SHARED
+ * and write frames into the same pages the graph mixes from, so
+ * dequeue/enqueue only flip slot indices.
+ */
+struct pw_stream_ring_info {
+    int      fd;          /**< memfd to mmap; owned by the stream, do not
+                           *   close; -1 = in-process heap ring */
+    uint32_t slot_size;   /**< Bytes per buffer slot */
+    uint32_t n_slots;     /**< Number of slots (dequeued round-robin) */
+    uint32_t total_size;  /**< Total mapping size in bytes */
+};
+
 /* ========================================================================= */
 /* Stream events                                                             */
 /* ========================================================================= */
@@ -233,6 +247,19 @@ struct pw_buffer *pw_stream_dequeue_buffer(struct pw_stream *stream);
 int               pw_stream_queue_buffer(struct pw_stream *stream,
                                          struct pw_buffer *buf);
 
+/** Query the shared buffer ring after connect; see pw_stream_ring_info. */
+int pw_stream_get_ring_info(struct pw_stream *stream,
+                            struct pw_stream_ring_info *info);
+
+/**
+ * Set the stream volume as a 16.16 fixed-point gain (0x10000 = unity,
+ * clamped to 4x boost).  The change is de-clicked with a ramp across
+ * the next queued block; applied by the SIMD kernels in
+ * pw-audio-kernels.h.
+ */
+int      pw_stream_set_volume(struct pw_stream *stream, uint32_t volume_fp);
+uint32_t pw_stream_get_volume(struct pw_stream *stream);
+
 enum pw_stream_state pw_stream_get_state(struct pw_stream *stream,
                                          const char **error);
 
@@ -60,8 +60,52 @@ struct pa_stream {
     struct pw_stream       *pw_stream;
     pa_stream_notify_cb_t   state_cb;
     void                   *state_cb_data;
+    int                     corked;
 };
 
+/* ========================================================================= */
+/* Batched command queue                                                     */
+/* ========================================================================= */
+
+/*
+ * Control operations are queued here and dispatched as one batch per
+ * mainloop iteration instead of executing per call.  Each command
+ * carries its pa_operation, which completes (and fires its success
+ * callback) when the batch flushes -- the async demultiplexing point.
+ */
+
+#define PA_MAX_PENDING_OPS 64
+
+enum pa_command_kind {
+    PA_CMD_CORK,
+    PA_CMD_SET_VOLUME,
+    PA_CMD_SET_NAME
+};
+
+struct pa_operation {
+    int                      ref_count;
+    enum pa_operation_state  state;
+};
+
+struct pa_command {
+    enum pa_command_kind     kind;
+    struct pa_stream        *stream;
+    struct pa_operation     *op;
+    pa_stream_success_cb_t   cb;
+    void                    *cb_data;
+
+    /* Arguments */
+    int                      cork;
+    struct pa_cvolume        volume;
+    char                     name[64];
+};
+
+/* One queue per process; contexts share the session daemon anyway */
+static struct pa_command g_pa_cmd_queue[PA_MAX_PENDING_OPS];
+static int               g_pa_cmd_count;
+
+static int pa_flush_command_batch(void);
+
 struct pa_mainloop {
     struct pw_main_loop *pw_loop;
 };
@@ -426,11 +470,26 @@ int pa_mainloop_run(struct pa_mainloop *m, int *retval) {
         if (retval) *retval = -1;
         return -1;
     }
+    pa_flush_command_batch();
     int ret = pw_main_loop_run(m->pw_loop);
     if (retval) *retval = ret;
     return ret;
 }
 
+int pa_mainloop_iterate(struct pa_mainloop *m, int block, int *retval) {
+    (void)block;  /* the pw loop has no blocking single-step yet */
+
+    if (!m || !m->pw_loop) {
+        if (retval) *retval = -1;
+        return -1;
+    }
+
+    int dispatched = pa_flush_command_batch();
+
+    if (retval) *retval = 0;
+    return dispatched;
+}
+
 void pa_mainloop_free(struct pa_mainloop *m) {
     if (!m) return;
     if (m->pw_loop) pw_main_loop_destroy(m->pw_loop);
@@ -645,6 +704,9 @@ int pa_stream_write(struct pa_stream *s,
 
     if (!s || !s->pw_stream || !data || nbytes == 0) return -PA_ERR_INVALID;
 
+    if (s->corked)
+        return 0;  /* corked streams swallow writes, like paused PA */
+
     struct pw_buffer *buf = pw_stream_dequeue_buffer(s->pw_stream);
     if (!buf) return -PA_ERR_IO;
 
@@ -659,18 +721,187 @@ int pa_stream_write(struct pa_stream *s,
     return 0;
 }
 
-int pa_stream_cork(struct pa_stream *s, int b, void *cb, void *userdata) {
-    (void)cb;
-    (void)userdata;
+/* ----- Operation objects ----- */
+
+struct pa_operation *pa_operation_ref(struct pa_operation *o) {
+    if (o) o->ref_count++;
+    return o;
+}
+
+void pa_operation_unref(struct pa_operation *o) {
+    if (!o) return;
+    if (--o->ref_count <= 0)
+        free(o);
+}
+
+void pa_operation_cancel(struct pa_operation *o) {
+    if (o && o->state == PA_OPERATION_RUNNING)
+        o->state = PA_OPERATION_CANCELLED;
+}
+
+enum pa_operation_state pa_operation_get_state(const struct pa_operation *o) {
+    return o ? o->state : PA_OPERATION_CANCELLED;
+}
+
+/* ----- Queueing and dispatch ----- */
+
+/* Execute one queued command; returns 1 on success, 0 on failure */
+static int pa_command_execute(const struct pa_command *cmd) {
+    struct pa_stream *s = cmd->stream;
 
-    if (!s) return -PA_ERR_INVALID;
+    if (!s || !s->pw_stream)
+        return 0;
+
+    switch (cmd->kind) {
+    case PA_CMD_CORK:
+        s->corked = cmd->cork;
+        fprintf(stderr, "[pa-compat] Stream '%s' %s\n",
+                s->name, cmd->cork ? "corked" : "uncorked");
+        return 1;
+
+    case PA_CMD_SET_VOLUME: {
+        /* PA volume units (0x10000 = norm) are the same 16.16 scale
+         * pw_stream_set_volume speaks; apply the channel average */
+        uint64_t sum = 0;
+        uint8_t  ch = cmd->volume.channels ? cmd->volume.channels : 1;
+
+        for (uint8_t i = 0; i < ch; i++)
+            sum += cmd->volume.values[i];
+        return pw_stream_set_volume(s->pw_stream,
+                                    (uint32_t)(sum / ch)) == 0;
+    }
 
-    /* Cork (pause) or uncork (resume) -- currently a no-op */
-    fprintf(stderr, "[pa-compat] Stream '%s' %s\n",
-            s->name, b ? "corked" : "uncorked");
+    case PA_CMD_SET_NAME:
+        strncpy(s->name, cmd->name, sizeof(s->name) - 1);
+        s->name[sizeof(s->name) - 1] = '\0';
+        return 1;
+    }
     return 0;
 }
 
+/* Dispatch the whole batch; each operation completes here.  Iterates
+ * the live queue so success callbacks may enqueue follow-up commands
+ * (dispatched in the same flush) and pa_stream_unref can null out
+ * entries for streams destroyed mid-flush. */
+static int g_pa_flushing;
+
+static int pa_flush_command_batch(void) {
+    int dispatched = 0;
+
+    if (g_pa_flushing)
+        return 0;
+    g_pa_flushing = 1;
+
+    for (int i = 0; i < g_pa_cmd_count; i++) {
+        struct pa_command *cmd = &g_pa_cmd_queue[i];
+        int success = 0;
+
+        if (!cmd->op || cmd->op->state != PA_OPERATION_CANCELLED)
+            success = pa_command_execute(cmd);
+
+        if (cmd->op) {
+            if (cmd->op->state == PA_OPERATION_RUNNING)
+                cmd->op->state = PA_OPERATION_DONE;
+            if (cmd->cb && cmd->op->state == PA_OPERATION_DONE)
+                cmd->cb(cmd->stream, success, cmd->cb_data);
+            pa_operation_unref(cmd->op);  /* queue's reference */
+        }
+        dispatched++;
+    }
+
+    g_pa_cmd_count = 0;
+    g_pa_flushing = 0;
+    return dispatched;
+}
+
+/* Enqueue a command; flushes first if the batch is full.  Returns the
+ * caller's reference to a new operation, or NULL on OOM. */
+static struct pa_operation *pa_command_enqueue(const struct pa_command *tpl) {
+    struct pa_operation *op =
+        (struct pa_operation *)calloc(1, sizeof(struct pa_operation));
+
+    if (!op)
+        return NULL;
+    op->ref_count = 2;  /* caller + queue */
+    op->state = PA_OPERATION_RUNNING;
+
+    if (g_pa_cmd_count >= PA_MAX_PENDING_OPS)
+        pa_flush_command_batch();
+
+    if (g_pa_cmd_count >= PA_MAX_PENDING_OPS) {
+        /* Queue still full (flush re-entered): run synchronously */
+        struct pa_command cmd = *tpl;
+        int success = pa_command_execute(&cmd);
+
+        op->state = PA_OPERATION_DONE;
+        op->ref_count = 1;  /* no queue reference */
+        if (cmd.cb)
+            cmd.cb(cmd.stream, success, cmd.cb_data);
+        return op;
+    }
+
+    g_pa_cmd_queue[g_pa_cmd_count] = *tpl;
+    g_pa_cmd_queue[g_pa_cmd_count].op = op;
+    g_pa_cmd_count++;
+    return op;
+}
+
+int pa_context_flush_commands(struct pa_context *c) {
+    (void)c;  /* the queue is shared; the context arg mirrors PA style */
+    return pa_flush_command_batch();
+}
+
+struct pa_operation *pa_stream_cork(struct pa_stream *s, int b,
+                                    pa_stream_success_cb_t cb,
+                                    void *userdata) {
+    if (!s) return NULL;
+
+    struct pa_command cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.kind    = PA_CMD_CORK;
+    cmd.stream  = s;
+    cmd.cb      = cb;
+    cmd.cb_data = userdata;
+    cmd.cork    = b;
+    return pa_command_enqueue(&cmd);
+}
+
+struct pa_operation *pa_stream_set_volume(struct pa_stream *s,
+                                          const struct pa_cvolume *volume,
+                                          pa_stream_success_cb_t cb,
+                                          void *userdata) {
+    if (!s || !volume || volume->channels == 0) return NULL;
+
+    struct pa_command cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.kind    = PA_CMD_SET_VOLUME;
+    cmd.stream  = s;
+    cmd.cb      = cb;
+    cmd.cb_data = userdata;
+    cmd.volume  = *volume;
+    return pa_command_enqueue(&cmd);
+}
+
+struct pa_operation *pa_stream_set_name(struct pa_stream *s,
+                                        const char *name,
+                                        pa_stream_success_cb_t cb,
+                                        void *userdata) {
+    if (!s || !name) return NULL;
+
+    struct pa_command cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.kind    = PA_CMD_SET_NAME;
+    cmd.stream  = s;
+    cmd.cb      = cb;
+    cmd.cb_data = userdata;
+    strncpy(cmd.name, name, sizeof(cmd.name) - 1);
+    return pa_command_enqueue(&cmd);
+}
+
+int pa_stream_is_corked(const struct pa_stream *s) {
+    return s ? s->corked : 0;
+}
+
 enum pa_stream_state pa_stream_get_state(const struct pa_stream *s) {
     if (!s) return PA_STREAM_FAILED;
     return s->state;
@@ -688,6 +919,14 @@ void pa_stream_unref(struct pa_stream *s) {
     if (!s) return;
     s->ref_count--;
     if (s->ref_count <= 0) {
+        /* Cancel queued commands that still reference this stream */
+        for (int i = 0; i < g_pa_cmd_count; i++) {
+            if (g_pa_cmd_queue[i].stream == s) {
+                if (g_pa_cmd_queue[i].op)
+                    pa_operation_cancel(g_pa_cmd_queue[i].op);
+                g_pa_cmd_queue[i].stream = NULL;
+            }
+        }
         if (s->pw_stream) pw_stream_destroy(s->pw_stream);
         free(s);
     }
@@ -34,6 +34,7 @@ struct pa_stream;
 struct pa_mainloop;
 struct pa_mainloop_api;
 struct pa_simple;
+struct pa_operation;
 
 /* ========================================================================= */
 /* Sample format                                                             */
@@ -191,6 +192,12 @@ typedef void (*pa_stream_notify_cb_t)(struct pa_stream *s, void *userdata);
 struct pa_mainloop     *pa_mainloop_new(void);
 struct pa_mainloop_api *pa_mainloop_get_api(struct pa_mainloop *m);
 int                     pa_mainloop_run(struct pa_mainloop *m, int *retval);
+
+/** Run one iteration: flush the queued command batch, then process
+ *  stream work.  Returns the number of things dispatched, or negative
+ *  on error. */
+int                     pa_mainloop_iterate(struct pa_mainloop *m,
+                                            int block, int *retval);
 void                    pa_mainloop_free(struct pa_mainloop *m);
 
 /** Context */
@@ -232,10 +239,72 @@ int  pa_stream_write(struct pa_stream *s,
                      int64_t offset,
                      int seek);
 
-int  pa_stream_cork(struct pa_stream *s, int b, void *cb, void *userdata);
+/* ========================================================================= */
+/* Operations (batched command queue)                                        */
+/* ========================================================================= */
+
+/*
+ * Control operations (cork, volume, property updates) do not execute
+ * on the calling thread: they are queued and flushed as one batch per
+ * mainloop iteration, with each pa_operation completing asynchronously
+ * when its command is dispatched.  This keeps bursts of pa_* control
+ * calls from stalling the caller's event loop per call.
+ */
+
+enum pa_operation_state {
+    PA_OPERATION_RUNNING   = 0,
+    PA_OPERATION_DONE      = 1,
+    PA_OPERATION_CANCELLED = 2
+};
+
+typedef void (*pa_stream_success_cb_t)(struct pa_stream *s, int success,
+                                       void *userdata);
+
+struct pa_operation *pa_operation_ref(struct pa_operation *o);
+void                 pa_operation_unref(struct pa_operation *o);
+void                 pa_operation_cancel(struct pa_operation *o);
+enum pa_operation_state pa_operation_get_state(const struct pa_operation *o);
+
+/** Multi-channel volume */
+typedef uint32_t pa_volume_t;
+
+struct pa_cvolume {
+    uint8_t     channels;
+    pa_volume_t values[PA_CHANNELS_MAX];
+};
+
+/**
+ * Cork (pause) or uncork (resume) a stream.  Queued; the returned
+ * operation completes on the next batch flush.
+ */
+struct pa_operation *pa_stream_cork(struct pa_stream *s, int b,
+                                    pa_stream_success_cb_t cb,
+                                    void *userdata);
+
+/** Set the stream volume (queued, like pa_stream_cork). */
+struct pa_operation *pa_stream_set_volume(struct pa_stream *s,
+                                          const struct pa_cvolume *volume,
+                                          pa_stream_success_cb_t cb,
+                                          void *userdata);
+
+/** Update the stream's display name (queued). */
+struct pa_operation *pa_stream_set_name(struct pa_stream *s,
+                                        const char *name,
+                                        pa_stream_success_cb_t cb,
+                                        void *userdata);
+
+/**
+ * Flush the pending command batch immediately.  Called automatically
+ * once per mainloop iteration; exposed for callers that do not run a
+ * pa_mainloop.  Returns the number of commands dispatched.
+ */
+int pa_context_flush_commands(struct pa_context *c);
 
 enum pa_stream_state pa_stream_get_state(const struct pa_stream *s);
 
+/** Whether the stream is currently corked (1 = corked). */
+int pa_stream_is_corked(const struct pa_stream *s);
+
 void pa_stream_set_state_callback(struct pa_stream *s,
                                   pa_stream_notify_cb_t cb,
                                   void *userdata);
@@ -6,13 +6,21 @@
  *
  * Bridge between PipeWire buffer semantics and the VeridianOS kernel
  * ALSA subsystem.  Opens kernel PCM devices at /dev/snd/pcmC{n}D{n}{p|c},
- * translates PipeWire buffers to ALSA frames, and provides integer-only
- * 16.16 fixed-point resampling for rate conversion.
+ * translates PipeWire buffers to ALSA frames, and adapts client rates
+ * to the device rate.
  *
- * All arithmetic is integer or fixed-point -- no floating point is used.
+ * Rate conversion runs a windowed-sinc polyphase resampler with
+ * precomputed Q15 filter banks and a SIMD inner product (the shared
+ * pw-audio-kernels dot kernel); a quality knob trades taps/phases for
+ * CPU, with quality 0 falling back to the old 16.16 linear
+ * interpolation.
+ *
+ * All arithmetic is integer or fixed-point -- no floating point is
+ * used, including the filter bank generation (Bhaskara sine).
  */
 
 #include "pw-alsa-bridge.h"
+#include "pw-audio-kernels.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -162,6 +170,130 @@ static uint32_t resample_s32_fixed(const int32_t *src, uint32_t src_frames,
     return out_frames;
 }
 
+/* ========================================================================= */
+/* Polyphase windowed-sinc resampler (integer-only)                          */
+/* ========================================================================= */
+
+/* Quality levels: taps x phases per bank.  Level 0 keeps the legacy
+ * linear interpolation. */
+static const struct {
+    uint32_t taps;
+    uint32_t phases;
+} rs_quality_tab[] = {
+    { 0,  0 },     /* 0: linear */
+    { 16, 64 },    /* 1: default -- transparent for 44.1k <-> 48k */
+    { 32, 128 },   /* 2: high */
+};
+
+#define RS_MAX_QUALITY  2
+#define RS_PI_Q15       102944   /* pi in Q15 */
+
+/*
+ * sin(pi * y) for y in Q15 half-turns (periodic in y with period 2).
+ * Quarter-wave reduction plus a 7th-order Taylor/Horner evaluation in
+ * Q15; absolute error ~1e-4, an order below the Q15 coefficient
+ * quantization of the filter banks.
+ */
+static int32_t sin_halfturn_q15(int32_t y_q15)
+{
+    /* Reduce to [0, 2) half-turns, track sign of the second half */
+    int32_t y = y_q15 & 0xFFFF;
+    int neg = 0;
+
+    if (y >= 32768) {
+        y -= 32768;
+        neg = 1;
+    }
+    /* Quarter-wave symmetry: sin(pi*y) = sin(pi*(1-y)) */
+    if (y > 16384)
+        y = 32768 - y;
+
+    int64_t theta = ((int64_t)y * RS_PI_Q15) >> 15;   /* Q15 radians */
+    int64_t t2 = (theta * theta) >> 15;               /* Q15 theta^2 */
+
+    /* sin t = t(1 - t^2/6(1 - t^2/20(1 - t^2/42))) */
+    int64_t a = 32768 - t2 / 42;
+    int64_t b = 32768 - ((t2 * a) / 20 >> 15);
+    int64_t c = 32768 - ((t2 * b) / 6 >> 15);
+    int32_t s = (int32_t)((theta * c) >> 15);
+
+    if (s > 32768)
+        s = 32768;
+    return neg ? -s : s;
+}
+
+/* sinc(x) = sin(pi*x)/(pi*x), x in Q15 samples */
+static int32_t sinc_q15(int32_t x_q15)
+{
+    if (x_q15 == 0)
+        return 32768;
+    int32_t ax = x_q15 < 0 ? -x_q15 : x_q15;
+    int64_t pix = ((int64_t)ax * RS_PI_Q15) >> 15;
+
+    if (pix == 0)
+        return 32768;
+    return (int32_t)(((int64_t)sin_halfturn_q15(ax) << 15) / pix);
+}
+
+/*
+ * Build one filter bank: phases x taps Q15 coefficients,
+ * Hann-windowed sinc at the given cutoff (Q15 of Nyquist), each
+ * phase normalized to unity DC gain.  Returns NULL on OOM.
+ */
+static int16_t *rs_build_bank(uint32_t taps, uint32_t phases,
+                              uint32_t cutoff_q15)
+{
+    int16_t *bank = (int16_t *)malloc((size_t)taps * phases *
+                                      sizeof(int16_t));
+    int64_t *raw = (int64_t *)malloc((size_t)taps * sizeof(int64_t));
+
+    if (!bank || !raw) {
+        free(bank);
+        free(raw);
+        return NULL;
+    }
+
+    for (uint32_t p = 0; p < phases; p++) {
+        int32_t f_q15 = (int32_t)(((int64_t)p << 15) / phases);
+        int64_t sum = 0;
+
+        for (uint32_t k = 0; k < taps; k++) {
+            /* Tap position relative to the output sample, Q15 */
+            int32_t x = (int32_t)((k + 1) << 15) -
+                        (int32_t)((taps / 2) << 15) - f_q15;
+
+            /* Cutoff-scaled sinc */
+            int32_t xc = (int32_t)(((int64_t)x * cutoff_q15) >> 15);
+            int64_t h = sinc_q15(xc);
+
+            /* Hann window over the tap span: 0.5(1 - cos(2*pi*pos/T)),
+             * cos(t) = sin(t + quarter turn) */
+            int32_t pos_q15 = (int32_t)((k + 1) << 15) - f_q15;
+            int32_t y2 = (int32_t)(((int64_t)pos_q15 * 2) / taps);
+            int32_t cosv = sin_halfturn_q15(y2 + 16384);
+            int32_t w = (32768 - cosv) / 2;
+
+            /* Keep full Q30 precision until normalization */
+            raw[k] = h * w;
+            sum += raw[k];
+        }
+
+        /* Normalize the phase to unity gain */
+        if (sum == 0)
+            sum = 1;
+        for (uint32_t k = 0; k < taps; k++) {
+            int64_t c = (raw[k] << 15) / sum;
+
+            if (c > 32767) c = 32767;
+            if (c < -32768) c = -32768;
+            bank[p * taps + k] = (int16_t)c;
+        }
+    }
+
+    free(raw);
+    return bank;
+}
+
 /* ========================================================================= */
 /* Bridge implementation                                                     */
 /* ========================================================================= */
@@ -189,6 +321,19 @@ struct AlsaBridge {
     uint32_t                 device_rate;
     uint8_t                 *resample_buf;
     uint32_t                 resample_buf_size;
+
+    /* Polyphase resampler state (S16 only; quality 0 = linear) */
+    int                      rs_quality;
+    int16_t                 *rs_bank;       /* phases * taps, Q15 */
+    uint32_t                 rs_taps;
+    uint32_t                 rs_phases;
+    int16_t                 *rs_planes;     /* per-channel scratch */
+    uint32_t                 rs_planes_len; /* frames per plane */
+    int16_t                 *rs_hist;       /* taps-1 frames per channel */
+    int64_t                  rs_pos_fp;     /* 32.32 source position --
+                                             * 16.16 drifts audibly over
+                                             * a one-second window */
+    const struct pw_audio_kernels *kernels;
 };
 
 struct AlsaBridge *alsa_bridge_new(void) {
@@ -198,9 +343,135 @@ struct AlsaBridge *alsa_bridge_new(void) {
     b->fd = -1;
     b->period_frames = 1024;
     b->buffer_frames = 4096;
+    b->rs_quality = 1;
+    b->kernels = pw_audio_kernels_get();
     return b;
 }
 
+/* Free all polyphase state (bank, planes, history) */
+static void rs_release(struct AlsaBridge *b) {
+    free(b->rs_bank);
+    free(b->rs_planes);
+    free(b->rs_hist);
+    b->rs_bank = NULL;
+    b->rs_planes = NULL;
+    b->rs_hist = NULL;
+    b->rs_planes_len = 0;
+    b->rs_taps = 0;
+    b->rs_phases = 0;
+    b->rs_pos_fp = 0;
+}
+
+/* Lazily build the filter bank and history for the current rates.
+ * Returns 0 when the polyphase path is ready, negative to fall back. */
+static int rs_ensure(struct AlsaBridge *b) {
+    uint32_t taps   = rs_quality_tab[b->rs_quality].taps;
+    uint32_t phases = rs_quality_tab[b->rs_quality].phases;
+
+    if (b->rs_quality == 0 || b->format != ALSA_BRIDGE_FORMAT_S16_LE)
+        return -1;
+    if (b->rs_bank && b->rs_taps == taps && b->rs_phases == phases)
+        return 0;
+
+    rs_release(b);
+
+    /* Cutoff at 90% of the narrower Nyquist */
+    uint32_t cutoff = 29491;  /* 0.9 in Q15 */
+    if (b->device_rate < b->rate)
+        cutoff = (uint32_t)(((uint64_t)29491 * b->device_rate) / b->rate);
+
+    b->rs_bank = rs_build_bank(taps, phases, cutoff);
+    if (!b->rs_bank)
+        return -1;
+
+    b->rs_hist = (int16_t *)calloc((size_t)(taps - 1) * b->channels,
+                                   sizeof(int16_t));
+    if (!b->rs_hist) {
+        rs_release(b);
+        return -1;
+    }
+
+    b->rs_taps   = taps;
+    b->rs_phases = phases;
+    b->rs_pos_fp = 0;
+    return 0;
+}
+
+/*
+ * Polyphase S16 resample: deinterleave into per-channel planes with
+ * taps-1 frames of history in front, run the FIR per output frame via
+ * the SIMD dot kernel, reinterleave into dst.  Returns output frames.
+ */
+static uint32_t rs_process(struct AlsaBridge *b,
+                           const int16_t *src, uint32_t src_frames,
+                           int16_t *dst, uint32_t dst_max_frames) {
+    uint32_t ch    = b->channels;
+    uint32_t hist  = b->rs_taps - 1;
+    uint32_t plane_len = hist + src_frames;
+    int64_t ratio_fp32 = (int64_t)(((uint64_t)b->rate << 32) /
+                                   b->device_rate);
+
+    if (b->rs_planes_len < plane_len) {
+        free(b->rs_planes);
+        b->rs_planes = (int16_t *)malloc((size_t)plane_len * ch *
+                                         sizeof(int16_t));
+        if (!b->rs_planes) {
+            b->rs_planes_len = 0;
+            return 0;
+        }
+        b->rs_planes_len = plane_len;
+    }
+
+    /* History + deinterleaved input, one contiguous plane per channel */
+    for (uint32_t c = 0; c < ch; c++) {
+        int16_t *plane = b->rs_planes + (size_t)c * plane_len;
+
+        memcpy(plane, b->rs_hist + (size_t)c * hist,
+               hist * sizeof(int16_t));
+        for (uint32_t f = 0; f < src_frames; f++)
+            plane[hist + f] = src[f * ch + c];
+    }
+
+    uint32_t out = 0;
+    int64_t pos = b->rs_pos_fp;
+
+    while (out < dst_max_frames) {
+        uint32_t idx = (uint32_t)(pos >> 32);
+
+        if (idx >= src_frames)
+            break;
+
+        uint64_t frac  = (uint64_t)pos & 0xFFFFFFFFULL;
+        uint32_t phase = (uint32_t)((frac * b->rs_phases) >> 32);
+        const int16_t *coef = b->rs_bank + (size_t)phase * b->rs_taps;
+
+        for (uint32_t c = 0; c < ch; c++) {
+            const int16_t *win = b->rs_planes + (size_t)c * plane_len + idx;
+            int32_t acc = b->kernels->dot_s16(win, coef, b->rs_taps) >> 15;
+
+            if (acc > 32767) acc = 32767;
+            if (acc < -32768) acc = -32768;
+            dst[out * ch + c] = (int16_t)acc;
+        }
+
+        out++;
+        pos += ratio_fp32;
+    }
+
+    /* Keep the last taps-1 frames as history for the next call */
+    for (uint32_t c = 0; c < ch; c++) {
+        const int16_t *plane = b->rs_planes + (size_t)c * plane_len;
+
+        memcpy(b->rs_hist + (size_t)c * hist,
+               plane + src_frames, hist * sizeof(int16_t));
+    }
+    b->rs_pos_fp = pos - ((int64_t)src_frames << 32);
+    if (b->rs_pos_fp < 0)
+        b->rs_pos_fp = 0;   /* only if the caller undersized dst */
+
+    return out;
+}
+
 int alsa_bridge_open(struct AlsaBridge *bridge,
                      const char *device,
                      enum alsa_bridge_format format,
@@ -303,12 +574,13 @@ void alsa_bridge_close(struct AlsaBridge *bridge) {
     bridge->fd = -1;
     bridge->is_open = 0;
 
-    /* Free resampling buffer */
+    /* Free resampling buffers and filter banks */
     if (bridge->resample_buf) {
         free(bridge->resample_buf);
         bridge->resample_buf = NULL;
         bridge->resample_buf_size = 0;
     }
+    rs_release(bridge);
 
     fprintf(stderr, "[alsa-bridge] Closed device\n");
 }
@@ -350,11 +622,19 @@ int32_t alsa_bridge_write(struct AlsaBridge *bridge,
 
         uint32_t out_frames;
         if (bridge->format == ALSA_BRIDGE_FORMAT_S16_LE) {
-            out_frames = resample_s16_fixed(
-                (const int16_t *)data, frames,
-                (int16_t *)bridge->resample_buf, out_max,
-                bridge->rate, bridge->device_rate,
-                bridge->channels);
+            /* Polyphase when enabled; linear as quality 0 / fallback */
+            if (rs_ensure(bridge) == 0) {
+                out_frames = rs_process(bridge,
+                                        (const int16_t *)data, frames,
+                                        (int16_t *)bridge->resample_buf,
+                                        out_max);
+            } else {
+                out_frames = resample_s16_fixed(
+                    (const int16_t *)data, frames,
+                    (int16_t *)bridge->resample_buf, out_max,
+                    bridge->rate, bridge->device_rate,
+                    bridge->channels);
+            }
         } else if (bridge->format == ALSA_BRIDGE_FORMAT_S32_LE) {
             out_frames = resample_s32_fixed(
                 (const int32_t *)data, frames,
@@ -416,6 +696,24 @@ uint32_t alsa_bridge_get_latency(const struct AlsaBridge *bridge) {
     return bridge->latency_us;
 }
 
+int alsa_bridge_set_resample_quality(struct AlsaBridge *bridge,
+                                     int quality) {
+    if (!bridge) return -EINVAL;
+    if (quality < 0 || quality > RS_MAX_QUALITY) return -EINVAL;
+
+    if (quality != bridge->rs_quality) {
+        bridge->rs_quality = quality;
+        /* Bank is rebuilt lazily on the next resampled write */
+        rs_release(bridge);
+    }
+    return 0;
+}
+
+int alsa_bridge_get_resample_quality(const struct AlsaBridge *bridge) {
+    if (!bridge) return -EINVAL;
+    return bridge->rs_quality;
+}
+
 int alsa_bridge_set_buffer_size(struct AlsaBridge *bridge,
                                 uint32_t period_frames,
                                 uint32_t buffer_frames) {
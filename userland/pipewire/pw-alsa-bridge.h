@@ -8,8 +8,11 @@
  * subsystem.  Translates PipeWire buffer semantics into ALSA PCM
  * read/write operations on /dev/snd/pcmC{card}D{device}{p|c} devices.
  *
- * Provides integer-only 16.16 fixed-point resampling for rate conversion
- * (e.g. 44100 -> 48000 Hz) without requiring an FPU.
+ * Rate conversion (e.g. 44100 -> 48000 Hz) uses an integer-only
+ * windowed-sinc polyphase resampler with precomputed Q15 filter banks
+ * and a SIMD inner product; a quality knob trades taps for CPU, with
+ * level 0 selecting the legacy 16.16 linear interpolation.  No FPU is
+ * required at any level.
  */
 
 #ifndef PW_ALSA_BRIDGE_H
@@ -113,6 +116,20 @@ int32_t alsa_bridge_read(struct AlsaBridge *bridge,
  */
 uint32_t alsa_bridge_get_latency(const struct AlsaBridge *bridge);
 
+/**
+ * Set the resampler quality/CPU trade-off.
+ * @param quality 0 = linear interpolation (cheapest),
+ *                1 = 16-tap/64-phase polyphase (default),
+ *                2 = 32-tap/128-phase polyphase.
+ * Takes effect on the next resampled write.
+ * @return 0 on success, negative errno on failure.
+ */
+int alsa_bridge_set_resample_quality(struct AlsaBridge *bridge,
+                                     int quality);
+
+/** Query the current resampler quality level. */
+int alsa_bridge_get_resample_quality(const struct AlsaBridge *bridge);
+
 /**
  * Set the ALSA period/buffer size.
  *
@@ -0,0 +1,546 @@
+/*
+ * VeridianOS -- pw-audio-kernels.cpp
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Vectorized audio primitives with runtime dispatch.  SSE2 is the
+ * x86_64 ISA baseline; AVX2 variants are selected through a cached
+ * raw-CPUID check (same idiom as userland/libc/src/string.c).  NEON
+ * is unconditional on AArch64.  The scalar table doubles as the
+ * reference implementation for userland/tests/audio_kernels_bench.c.
+ *
+ * Volume uses 1.15 multiplier tricks in the SIMD paths, which only
+ * cover attenuation (vol <= unity); boost gains fall back to the
+ * scalar path where 32-bit headroom is free.
+ */
+
+#include "pw-audio-kernels.h"
+
+#include <string.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+/* ========================================================================= */
+/* Scalar reference kernels                                                  */
+/* ========================================================================= */
+
+static inline int16_t sat16(int32_t v)
+{
+    if (v > 32767) return 32767;
+    if (v < -32768) return -32768;
+    return (int16_t)v;
+}
+
+static void mix_s16_scalar(int16_t *dst, const int16_t *src,
+                           uint32_t samples)
+{
+    for (uint32_t i = 0; i < samples; i++)
+        dst[i] = sat16((int32_t)dst[i] + src[i]);
+}
+
+static void volume_s16_scalar(int16_t *dst, const int16_t *src,
+                              uint32_t samples, uint32_t vol_fp)
+{
+    if (vol_fp == PW_KERNEL_VOL_ONE) {
+        if (dst != src)
+            memcpy(dst, src, samples * sizeof(int16_t));
+        return;
+    }
+    for (uint32_t i = 0; i < samples; i++)
+        dst[i] = sat16((int32_t)(((int64_t)src[i] * vol_fp) >> 16));
+}
+
+static void ramp_s16_scalar(int16_t *dst, const int16_t *src,
+                            uint32_t samples, uint32_t channels,
+                            uint32_t vol_from_fp, uint32_t vol_to_fp)
+{
+    uint32_t frames = channels ? samples / channels : 0;
+
+    if (frames == 0) {
+        volume_s16_scalar(dst, src, samples, vol_to_fp);
+        return;
+    }
+
+    int64_t step = ((int64_t)vol_to_fp - (int64_t)vol_from_fp) /
+                   (int64_t)frames;
+    int64_t vol = vol_from_fp;
+
+    for (uint32_t f = 0; f < frames; f++) {
+        for (uint32_t c = 0; c < channels; c++) {
+            uint32_t i = f * channels + c;
+            dst[i] = sat16((int32_t)(((int64_t)src[i] * vol) >> 16));
+        }
+        vol += step;
+    }
+}
+
+static void s16_to_s32_scalar(int32_t *dst, const int16_t *src,
+                              uint32_t samples)
+{
+    for (uint32_t i = 0; i < samples; i++)
+        dst[i] = (int32_t)src[i] << 16;
+}
+
+static void s32_to_s16_scalar(int16_t *dst, const int32_t *src,
+                              uint32_t samples)
+{
+    for (uint32_t i = 0; i < samples; i++)
+        dst[i] = (int16_t)(src[i] >> 16);
+}
+
+
+static int32_t dot_s16_scalar(const int16_t *a, const int16_t *b, uint32_t n)
+{
+    int32_t acc = 0;
+
+    for (uint32_t i = 0; i < n; i++)
+        acc += (int32_t)a[i] * b[i];
+    return acc;
+}
+
+static const struct pw_audio_kernels g_kernels_scalar = {
+    "scalar",
+    mix_s16_scalar,
+    volume_s16_scalar,
+    ramp_s16_scalar,
+    s16_to_s32_scalar,
+    s32_to_s16_scalar,
+    dot_s16_scalar,
+};
+
+/* ========================================================================= */
+/* x86_64: SSE2 baseline + AVX2                                              */
+/* ========================================================================= */
+
+#if defined(__x86_64__)
+
+/* Cached CPUID feature check (no libgcc cpu-model dependency) */
+static int cpu_has_avx2(void)
+{
+    static int checked, has_avx2;
+
+    if (!checked) {
+        unsigned int eax, ebx, ecx, edx;
+
+        __asm__ volatile("cpuid"
+                         : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx)
+                         : "a"(7), "c"(0));
+        has_avx2 = (ebx >> 5) & 1;
+        checked = 1;
+    }
+    return has_avx2;
+}
+
+static void mix_s16_sse2(int16_t *dst, const int16_t *src, uint32_t samples)
+{
+    uint32_t i = 0;
+
+    for (; i + 8 <= samples; i += 8) {
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_adds_epi16(d, s));
+    }
+    for (; i < samples; i++)
+        dst[i] = sat16((int32_t)dst[i] + src[i]);
+}
+
+/* Apply a 1.15 gain (attenuation only): r = (s * v15) >> 15, split as
+ * hi = (s * v15) >> 16 doubled plus the carried bit from the low half */
+static inline __m128i apply_vol15_sse2(__m128i s, __m128i v15)
+{
+    __m128i hi = _mm_mulhi_epi16(s, v15);
+    __m128i lo = _mm_mullo_epi16(s, v15);
+
+    return _mm_or_si128(_mm_slli_epi16(hi, 1), _mm_srli_epi16(lo, 15));
+}
+
+static void volume_s16_sse2(int16_t *dst, const int16_t *src,
+                            uint32_t samples, uint32_t vol_fp)
+{
+    if (vol_fp >= PW_KERNEL_VOL_ONE) {
+        /* Unity is a copy; boost needs 32-bit headroom */
+        volume_s16_scalar(dst, src, samples, vol_fp);
+        return;
+    }
+
+    __m128i v15 = _mm_set1_epi16((int16_t)(vol_fp >> 1));
+    uint32_t i = 0;
+
+    for (; i + 8 <= samples; i += 8) {
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        _mm_storeu_si128((__m128i *)(dst + i), apply_vol15_sse2(s, v15));
+    }
+    for (; i < samples; i++)
+        dst[i] = sat16((int32_t)(((int64_t)src[i] * vol_fp) >> 16));
+}
+
+/* Ramp in 8-sample chunks with per-chunk constant gain; the step is
+ * inaudible at that granularity and keeps the inner loop branch-free */
+static void ramp_s16_sse2(int16_t *dst, const int16_t *src,
+                          uint32_t samples, uint32_t channels,
+                          uint32_t vol_from_fp, uint32_t vol_to_fp)
+{
+    if (vol_from_fp >= PW_KERNEL_VOL_ONE || vol_to_fp > PW_KERNEL_VOL_ONE ||
+        samples < 16) {
+        ramp_s16_scalar(dst, src, samples, channels, vol_from_fp,
+                        vol_to_fp);
+        return;
+    }
+
+    uint32_t chunks = samples / 8;
+    int64_t step = ((int64_t)vol_to_fp - (int64_t)vol_from_fp) /
+                   (int64_t)chunks;
+    int64_t vol = vol_from_fp;
+    uint32_t i = 0;
+
+    for (uint32_t c = 0; c < chunks; c++, i += 8) {
+        __m128i v15 = _mm_set1_epi16((int16_t)((uint32_t)vol >> 1));
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+
+        _mm_storeu_si128((__m128i *)(dst + i), apply_vol15_sse2(s, v15));
+        vol += step;
+    }
+    for (; i < samples; i++)
+        dst[i] = sat16((int32_t)(((int64_t)src[i] * vol_to_fp) >> 16));
+}
+
+static void s16_to_s32_sse2(int32_t *dst, const int16_t *src,
+                            uint32_t samples)
+{
+    uint32_t i = 0;
+
+    for (; i + 8 <= samples; i += 8) {
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i sign = _mm_srai_epi16(s, 15);
+        __m128i lo = _mm_unpacklo_epi16(s, sign);
+        __m128i hi = _mm_unpackhi_epi16(s, sign);
+
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_slli_epi32(lo, 16));
+        _mm_storeu_si128((__m128i *)(dst + i + 4), _mm_slli_epi32(hi, 16));
+    }
+    for (; i < samples; i++)
+        dst[i] = (int32_t)src[i] << 16;
+}
+
+static void s32_to_s16_sse2(int16_t *dst, const int32_t *src,
+                            uint32_t samples)
+{
+    uint32_t i = 0;
+
+    for (; i + 8 <= samples; i += 8) {
+        __m128i a = _mm_srai_epi32(
+            _mm_loadu_si128((const __m128i *)(src + i)), 16);
+        __m128i b = _mm_srai_epi32(
+            _mm_loadu_si128((const __m128i *)(src + i + 4)), 16);
+
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_packs_epi32(a, b));
+    }
+    for (; i < samples; i++)
+        dst[i] = (int16_t)(src[i] >> 16);
+}
+
+
+static int32_t dot_s16_sse2(const int16_t *a, const int16_t *b, uint32_t n)
+{
+    __m128i acc = _mm_setzero_si128();
+    uint32_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + i));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(va, vb));
+    }
+
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0x4E));
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0xB1));
+
+    int32_t sum = _mm_cvtsi128_si32(acc);
+    for (; i < n; i++)
+        sum += (int32_t)a[i] * b[i];
+    return sum;
+}
+
+static const struct pw_audio_kernels g_kernels_sse2 = {
+    "sse2",
+    mix_s16_sse2,
+    volume_s16_sse2,
+    ramp_s16_sse2,
+    s16_to_s32_sse2,
+    s32_to_s16_sse2,
+    dot_s16_sse2,
+};
+
+__attribute__((target("avx2")))
+static void mix_s16_avx2(int16_t *dst, const int16_t *src, uint32_t samples)
+{
+    uint32_t i = 0;
+
+    for (; i + 16 <= samples; i += 16) {
+        __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));
+        __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_adds_epi16(d, s));
+    }
+    for (; i < samples; i++)
+        dst[i] = sat16((int32_t)dst[i] + src[i]);
+}
+
+__attribute__((target("avx2")))
+static void volume_s16_avx2(int16_t *dst, const int16_t *src,
+                            uint32_t samples, uint32_t vol_fp)
+{
+    if (vol_fp >= PW_KERNEL_VOL_ONE) {
+        volume_s16_scalar(dst, src, samples, vol_fp);
+        return;
+    }
+
+    __m256i v15 = _mm256_set1_epi16((int16_t)(vol_fp >> 1));
+    uint32_t i = 0;
+
+    for (; i + 16 <= samples; i += 16) {
+        __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i hi = _mm256_mulhi_epi16(s, v15);
+        __m256i lo = _mm256_mullo_epi16(s, v15);
+
+        _mm256_storeu_si256((__m256i *)(dst + i),
+                            _mm256_or_si256(_mm256_slli_epi16(hi, 1),
+                                            _mm256_srli_epi16(lo, 15)));
+    }
+    for (; i < samples; i++)
+        dst[i] = sat16((int32_t)(((int64_t)src[i] * vol_fp) >> 16));
+}
+
+__attribute__((target("avx2")))
+static void s32_to_s16_avx2(int16_t *dst, const int32_t *src,
+                            uint32_t samples)
+{
+    uint32_t i = 0;
+
+    for (; i + 16 <= samples; i += 16) {
+        __m256i a = _mm256_srai_epi32(
+            _mm256_loadu_si256((const __m256i *)(src + i)), 16);
+        __m256i b = _mm256_srai_epi32(
+            _mm256_loadu_si256((const __m256i *)(src + i + 8)), 16);
+        /* packs interleaves 128-bit lanes; permute restores order */
+        __m256i p = _mm256_packs_epi32(a, b);
+
+        _mm256_storeu_si256((__m256i *)(dst + i),
+                            _mm256_permute4x64_epi64(p, 0xD8));
+    }
+    for (; i < samples; i++)
+        dst[i] = (int16_t)(src[i] >> 16);
+}
+
+
+__attribute__((target("avx2")))
+static int32_t dot_s16_avx2(const int16_t *a, const int16_t *b, uint32_t n)
+{
+    __m256i acc = _mm256_setzero_si256();
+    uint32_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        __m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i *)(b + i));
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(va, vb));
+    }
+
+    __m128i lo = _mm256_castsi256_si128(acc);
+    __m128i hi = _mm256_extracti128_si256(acc, 1);
+    __m128i s4 = _mm_add_epi32(lo, hi);
+
+    s4 = _mm_add_epi32(s4, _mm_shuffle_epi32(s4, 0x4E));
+    s4 = _mm_add_epi32(s4, _mm_shuffle_epi32(s4, 0xB1));
+
+    int32_t sum = _mm_cvtsi128_si32(s4);
+    for (; i < n; i++)
+        sum += (int32_t)a[i] * b[i];
+    return sum;
+}
+
+static const struct pw_audio_kernels g_kernels_avx2 = {
+    "avx2",
+    mix_s16_avx2,
+    volume_s16_avx2,
+    ramp_s16_sse2,       /* chunked SSE2 ramp is already memory-bound */
+    s16_to_s32_sse2,
+    s32_to_s16_avx2,
+    dot_s16_avx2,
+};
+
+#endif /* __x86_64__ */
+
+/* ========================================================================= */
+/* AArch64: NEON                                                             */
+/* ========================================================================= */
+
+#if defined(__aarch64__)
+
+static void mix_s16_neon(int16_t *dst, const int16_t *src, uint32_t samples)
+{
+    uint32_t i = 0;
+
+    for (; i + 8 <= samples; i += 8) {
+        int16x8_t d = vld1q_s16(dst + i);
+        int16x8_t s = vld1q_s16(src + i);
+        vst1q_s16(dst + i, vqaddq_s16(d, s));
+    }
+    for (; i < samples; i++)
+        dst[i] = sat16((int32_t)dst[i] + src[i]);
+}
+
+static void volume_s16_neon(int16_t *dst, const int16_t *src,
+                            uint32_t samples, uint32_t vol_fp)
+{
+    if (vol_fp >= PW_KERNEL_VOL_ONE) {
+        volume_s16_scalar(dst, src, samples, vol_fp);
+        return;
+    }
+
+    int16x8_t v15 = vdupq_n_s16((int16_t)(vol_fp >> 1));
+    uint32_t i = 0;
+
+    for (; i + 8 <= samples; i += 8) {
+        int16x8_t s = vld1q_s16(src + i);
+        /* vqdmulhq: (s * v * 2) >> 16 == (s * v15) >> 15 */
+        vst1q_s16(dst + i, vqdmulhq_s16(s, v15));
+    }
+    for (; i < samples; i++)
+        dst[i] = sat16((int32_t)(((int64_t)src[i] * vol_fp) >> 16));
+}
+
+static void ramp_s16_neon(int16_t *dst, const int16_t *src,
+                          uint32_t samples, uint32_t channels,
+                          uint32_t vol_from_fp, uint32_t vol_to_fp)
+{
+    if (vol_from_fp >= PW_KERNEL_VOL_ONE || vol_to_fp > PW_KERNEL_VOL_ONE ||
+        samples < 16) {
+        ramp_s16_scalar(dst, src, samples, channels, vol_from_fp,
+                        vol_to_fp);
+        return;
+    }
+
+    uint32_t chunks = samples / 8;
+    int64_t step = ((int64_t)vol_to_fp - (int64_t)vol_from_fp) /
+                   (int64_t)chunks;
+    int64_t vol = vol_from_fp;
+    uint32_t i = 0;
+
+    for (uint32_t c = 0; c < chunks; c++, i += 8) {
+        int16x8_t v15 = vdupq_n_s16((int16_t)((uint32_t)vol >> 1));
+        vst1q_s16(dst + i, vqdmulhq_s16(vld1q_s16(src + i), v15));
+        vol += step;
+    }
+    for (; i < samples; i++)
+        dst[i] = sat16((int32_t)(((int64_t)src[i] * vol_to_fp) >> 16));
+}
+
+static void s16_to_s32_neon(int32_t *dst, const int16_t *src,
+                            uint32_t samples)
+{
+    uint32_t i = 0;
+
+    for (; i + 8 <= samples; i += 8) {
+        int16x8_t s = vld1q_s16(src + i);
+        vst1q_s32(dst + i, vshll_n_s16(vget_low_s16(s), 16));
+        vst1q_s32(dst + i + 4, vshll_n_s16(vget_high_s16(s), 16));
+    }
+    for (; i < samples; i++)
+        dst[i] = (int32_t)src[i] << 16;
+}
+
+static void s32_to_s16_neon(int16_t *dst, const int32_t *src,
+                            uint32_t samples)
+{
+    uint32_t i = 0;
+
+    for (; i + 8 <= samples; i += 8) {
+        int16x4_t a = vshrn_n_s32(vld1q_s32(src + i), 16);
+        int16x4_t b = vshrn_n_s32(vld1q_s32(src + i + 4), 16);
+        vst1q_s16(dst + i, vcombine_s16(a, b));
+    }
+    for (; i < samples; i++)
+        dst[i] = (int16_t)(src[i] >> 16);
+}
+
+
+static int32_t dot_s16_neon(const int16_t *a, const int16_t *b, uint32_t n)
+{
+    int32x4_t acc = vdupq_n_s32(0);
+    uint32_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t va = vld1q_s16(a + i);
+        int16x8_t vb = vld1q_s16(b + i);
+        acc = vmlal_s16(acc, vget_low_s16(va), vget_low_s16(vb));
+        acc = vmlal_s16(acc, vget_high_s16(va), vget_high_s16(vb));
+    }
+
+    int32_t sum = vaddvq_s32(acc);
+    for (; i < n; i++)
+        sum += (int32_t)a[i] * b[i];
+    return sum;
+}
+
+static const struct pw_audio_kernels g_kernels_neon = {
+    "neon",
+    mix_s16_neon,
+    volume_s16_neon,
+    ramp_s16_neon,
+    s16_to_s32_neon,
+    s32_to_s16_neon,
+    dot_s16_neon,
+};
+
+#endif /* __aarch64__ */
+
+/* ========================================================================= */
+/* Dispatch                                                                  */
+/* ========================================================================= */
+
+const struct pw_audio_kernels *pw_audio_kernels_get(void)
+{
+#if defined(__x86_64__)
+    return cpu_has_avx2() ? &g_kernels_avx2 : &g_kernels_sse2;
+#elif defined(__aarch64__)
+    return &g_kernels_neon;
+#else
+    return &g_kernels_scalar;
+#endif
+}
+
+/* ========================================================================= */
+/* Cycle-time histogram                                                      */
+/* ========================================================================= */
+
+static struct pw_cycle_stats g_cycle_stats;
+
+void pw_cycle_stats_record(uint64_t duration_us)
+{
+    int bucket = 0;
+
+    while (bucket < PW_CYCLE_BUCKETS - 1 &&
+           duration_us >= (2ull << bucket))
+        bucket++;
+
+    g_cycle_stats.buckets[bucket]++;
+    g_cycle_stats.count++;
+    if (duration_us > g_cycle_stats.max_us)
+        g_cycle_stats.max_us = duration_us;
+}
+
+int pw_cycle_stats_get(struct pw_cycle_stats *out)
+{
+    if (!out)
+        return -1;
+    *out = g_cycle_stats;
+    return 0;
+}
+
+void pw_cycle_stats_reset(void)
+{
+    memset(&g_cycle_stats, 0, sizeof(g_cycle_stats));
+}
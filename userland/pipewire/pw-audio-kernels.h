@@ -0,0 +1,96 @@
+/*
+ * VeridianOS -- pw-audio-kernels.h
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Vectorized audio primitives for the PipeWire graph: saturated S16
+ * mixing, 16.16 fixed-point volume and volume-ramp application, and
+ * S16<->S32 sample conversion.  One kernel table is selected at
+ * runtime (AVX2 / SSE2 on x86_64, NEON on AArch64, scalar fallback)
+ * and shared by the daemon, the ALSA bridge, and the PulseAudio
+ * compatibility layer.
+ *
+ * The graph is fixed-point by design (no FPU requirement), so the
+ * float mix/convert stages of upstream PipeWire map to the S16/S32
+ * kernels here.
+ */
+
+#ifndef PW_AUDIO_KERNELS_H
+#define PW_AUDIO_KERNELS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 16.16 fixed-point volume; PW_KERNEL_VOL_ONE = unity gain */
+#define PW_KERNEL_VOL_ONE  (1u << 16)
+
+/**
+ * Kernel table.  All sample counts are in samples (frames * channels);
+ * buffers may be unaligned.
+ */
+struct pw_audio_kernels {
+    const char *name;   /**< "avx2", "sse2", "neon", or "scalar" */
+
+    /** dst[i] = sat16(dst[i] + src[i]) */
+    void (*mix_s16)(int16_t *dst, const int16_t *src, uint32_t samples);
+
+    /** dst[i] = sat16(src[i] * vol >> 16); dst may alias src.
+     *  Gains above unity take the scalar path internally. */
+    void (*volume_s16)(int16_t *dst, const int16_t *src,
+                       uint32_t samples, uint32_t vol_fp);
+
+    /** Per-frame interpolated gain from vol_from to vol_to across the
+     *  block (declicks volume changes); dst may alias src. */
+    void (*ramp_s16)(int16_t *dst, const int16_t *src,
+                     uint32_t samples, uint32_t channels,
+                     uint32_t vol_from_fp, uint32_t vol_to_fp);
+
+    /** dst[i] = src[i] << 16 */
+    void (*s16_to_s32)(int32_t *dst, const int16_t *src, uint32_t samples);
+
+    /** dst[i] = sat16(src[i] >> 16) */
+    void (*s32_to_s16)(int16_t *dst, const int32_t *src, uint32_t samples);
+
+    /** sum(a[i] * b[i]), 32-bit accumulation -- the polyphase FIR
+     *  inner product (coefficients in Q15; caller shifts/clamps). */
+    int32_t (*dot_s16)(const int16_t *a, const int16_t *b, uint32_t n);
+};
+
+/** Runtime-dispatched kernel table (resolved once, then cached). */
+const struct pw_audio_kernels *pw_audio_kernels_get(void);
+
+/* ========================================================================= */
+/* Audio-thread cycle statistics                                             */
+/* ========================================================================= */
+
+#define PW_CYCLE_BUCKETS 16
+
+/**
+ * Histogram of process-cycle durations.  Bucket i counts cycles whose
+ * duration d satisfies 2^i us <= d < 2^(i+1) us (bucket 0 also takes
+ * sub-microsecond cycles; the last bucket is open-ended).
+ */
+struct pw_cycle_stats {
+    uint64_t buckets[PW_CYCLE_BUCKETS];
+    uint64_t count;
+    uint64_t max_us;
+};
+
+/** Record one cycle of the given duration. */
+void pw_cycle_stats_record(uint64_t duration_us);
+
+/** Snapshot the histogram; returns 0. */
+int pw_cycle_stats_get(struct pw_cycle_stats *out);
+
+/** Reset the histogram. */
+void pw_cycle_stats_reset(void);
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif /* PW_AUDIO_KERNELS_H */
@@ -33,6 +33,8 @@
 #include <QVector>
 #include <QSet>
 #include <QHash>
+#include <QImage>
+#include <QTimer>
 
 #include <string.h>
 #include <stdlib.h>
@@ -60,12 +62,28 @@ struct ActivityInternal {
     QString icon;
     ActivityState state;
     QSet<uint32_t> windows;
+
+    /* Switch-time state: the wallpaper decode is the expensive part of
+     * activating an activity; it is loaded lazily or prefetched ahead
+     * of a predicted switch, never at config-load time */
+    QString wallpaper;
+    QImage wallpaperImage;
+    bool stateLoaded = false;
 };
 
 static QVector<ActivityInternal> s_activities;
 static int s_currentIndex = -1;
 static bool s_initialized = false;
 
+/* Switch-pair frequencies (from-id -> to-id -> count) driving the
+ * predictive prefetch; persisted across sessions */
+static QHash<QString, QHash<QString, int>> s_switchCounts;
+static QTimer *s_prefetchTimer = nullptr;
+
+/* Idle window after a switch before the predicted next activity's
+ * state is prefetched */
+static const int PREFETCH_IDLE_MS = 500;
+
 /* ========================================================================= */
 /* ID generation                                                             */
 /* ========================================================================= */
@@ -104,6 +122,8 @@ static void saveActivity(const ActivityInternal &act)
     out << "name=" << act.name << "\n";
     out << "description=" << act.description << "\n";
     out << "icon=" << act.icon << "\n";
+    if (!act.wallpaper.isEmpty())
+        out << "wallpaper=" << act.wallpaper << "\n";
 }
 
 static ActivityInternal loadActivity(const QString &filePath)
@@ -136,11 +156,143 @@ static ActivityInternal loadActivity(const QString &filePath)
             act.description = value;
         else if (key == QStringLiteral("icon"))
             act.icon = value;
+        else if (key == QStringLiteral("wallpaper"))
+            act.wallpaper = value;
     }
 
     return act;
 }
 
+/* ========================================================================= */
+/* Switch statistics persistence                                             */
+/* ========================================================================= */
+
+static QString switchStatsPath()
+{
+    return QStringLiteral("%1/_switch_stats.conf")
+               .arg(QString::fromUtf8(CONFIG_DIR));
+}
+
+static void saveSwitchStats()
+{
+    QFile file(switchStatsPath());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        return;
+
+    QTextStream out(&file);
+    for (auto from = s_switchCounts.constBegin();
+         from != s_switchCounts.constEnd(); ++from) {
+        for (auto to = from.value().constBegin();
+             to != from.value().constEnd(); ++to) {
+            out << from.key() << "|" << to.key() << "=" << to.value() << "\n";
+        }
+    }
+}
+
+static void loadSwitchStats()
+{
+    s_switchCounts.clear();
+
+    QFile file(switchStatsPath());
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return;
+
+    QTextStream in(&file);
+    while (!in.atEnd()) {
+        QString line = in.readLine().trimmed();
+        int barPos = line.indexOf(QLatin1Char('|'));
+        int eqPos = line.indexOf(QLatin1Char('='), barPos + 1);
+        if (barPos <= 0 || eqPos <= barPos)
+            continue;
+
+        QString from = line.left(barPos);
+        QString to = line.mid(barPos + 1, eqPos - barPos - 1);
+        int count = line.mid(eqPos + 1).toInt();
+        if (!from.isEmpty() && !to.isEmpty() && count > 0)
+            s_switchCounts[from][to] = count;
+    }
+}
+
+/* ========================================================================= */
+/* Predictive prefetch                                                       */
+/* ========================================================================= */
+
+/* Most frequent switch target from the given activity, or empty */
+static QString predictNext(const QString &fromId)
+{
+    const auto it = s_switchCounts.constFind(fromId);
+    if (it == s_switchCounts.constEnd())
+        return QString();
+
+    QString best;
+    int bestCount = 0;
+    for (auto to = it.value().constBegin();
+         to != it.value().constEnd(); ++to) {
+        if (to.value() > bestCount && findById(to.key()) >= 0) {
+            best = to.key();
+            bestCount = to.value();
+        }
+    }
+    return best;
+}
+
+/*
+ * Load everything the switch path needs so that switching becomes an
+ * index swap: today that is the wallpaper decode (the window set is
+ * already resident).
+ */
+static void ensureStateLoaded(ActivityInternal &act)
+{
+    if (act.stateLoaded)
+        return;
+
+    if (!act.wallpaper.isEmpty()) {
+        act.wallpaperImage = QImage(act.wallpaper);
+        if (act.wallpaperImage.isNull())
+            qWarning("Activities: cannot decode wallpaper %s",
+                     qPrintable(act.wallpaper));
+    }
+    act.stateLoaded = true;
+}
+
+/* Keep at most the current and the predicted activity decoded;
+ * decoded wallpapers are the only heavy per-activity memory */
+static void evictDistantStates(const QString &keepId)
+{
+    for (int i = 0; i < s_activities.size(); ++i) {
+        ActivityInternal &act = s_activities[i];
+        if (i == s_currentIndex || act.id == keepId)
+            continue;
+        if (act.stateLoaded) {
+            act.wallpaperImage = QImage();
+            act.stateLoaded = false;
+        }
+    }
+}
+
+static void armPrefetchTimer()
+{
+    if (s_prefetchTimer)
+        s_prefetchTimer->start(PREFETCH_IDLE_MS);
+}
+
+static void prefetchPredicted()
+{
+    if (s_currentIndex < 0)
+        return;
+
+    QString next = predictNext(s_activities[s_currentIndex].id);
+    if (next.isEmpty())
+        return;
+
+    int idx = findById(next);
+    if (idx < 0)
+        return;
+
+    ensureStateLoaded(s_activities[idx]);
+    evictDistantStates(next);
+}
+
 static void deleteActivityFile(const QString &id)
 {
     QString path = QStringLiteral("%1/%2.conf")
@@ -288,6 +440,15 @@ int activities_init(void)
     Activities::s_currentIndex = 0;
     Activities::s_initialized = true;
 
+    /* Switch statistics and idle prefetch */
+    Activities::loadSwitchStats();
+    Activities::ensureStateLoaded(Activities::s_activities[0]);
+    Activities::s_prefetchTimer = new QTimer();
+    Activities::s_prefetchTimer->setSingleShot(true);
+    QObject::connect(Activities::s_prefetchTimer, &QTimer::timeout,
+                     []() { Activities::prefetchPredicted(); });
+    Activities::armPrefetchTimer();
+
     /* Register D-Bus */
     Activities::registerDBus();
 
@@ -301,9 +462,17 @@ void activities_destroy(void)
     if (!Activities::s_initialized)
         return;
 
-    /* Save all activities */
+    /* Save all activities and switch statistics */
     for (const Activities::ActivityInternal &act : Activities::s_activities)
         Activities::saveActivity(act);
+    Activities::saveSwitchStats();
+
+    if (Activities::s_prefetchTimer) {
+        Activities::s_prefetchTimer->stop();
+        delete Activities::s_prefetchTimer;
+        Activities::s_prefetchTimer = nullptr;
+    }
+    Activities::s_switchCounts.clear();
 
     Activities::s_activities.clear();
     Activities::s_currentIndex = -1;
@@ -375,6 +544,11 @@ void activities_delete(const char *id)
     const QSet<uint32_t> &orphanWindows = Activities::s_activities[idx].windows;
     Activities::s_activities[currentIdx].windows.unite(orphanWindows);
 
+    /* Drop the deleted activity from the switch statistics */
+    Activities::s_switchCounts.remove(qid);
+    for (auto &targets : Activities::s_switchCounts)
+        targets.remove(qid);
+
     /* Remove config file */
     Activities::deleteActivityFile(qid);
 
@@ -407,12 +581,29 @@ void activities_switch(const char *id)
     if (idx == Activities::s_currentIndex)
         return;  /* Already current */
 
+    /* Record the pair frequency that drives the predictor */
+    if (Activities::s_currentIndex >= 0) {
+        const QString &fromId =
+            Activities::s_activities[Activities::s_currentIndex].id;
+        Activities::s_switchCounts[fromId][qid]++;
+    }
+
+    /* With a correct prediction the state is already resident and this
+     * is a no-op; a miss pays the decode cost the prefetcher would
+     * have hidden */
+    if (!Activities::s_activities[idx].stateLoaded)
+        qDebug("Activities: prefetch miss for '%s'", id);
+    Activities::ensureStateLoaded(Activities::s_activities[idx]);
+
     Activities::s_currentIndex = idx;
     Activities::s_activities[idx].state = ACTIVITY_RUNNING;
 
     /* Update window visibility */
     Activities::updateWindowVisibility();
 
+    /* Prefetch the likely next hop once the switch settles */
+    Activities::armPrefetchTimer();
+
     /* Notify via D-Bus */
     QDBusMessage signal = QDBusMessage::createSignal(
         QStringLiteral("/ActivityManager"),
@@ -481,6 +672,41 @@ void activities_set_icon(const char *id, const char *icon)
     qDebug("Activities: set icon for '%s' to '%s'", id, icon);
 }
 
+void activities_set_wallpaper(const char *id, const char *path)
+{
+    if (!Activities::s_initialized || !id || !path)
+        return;
+
+    int idx = Activities::findById(QString::fromUtf8(id));
+    if (idx < 0)
+        return;
+
+    Activities::ActivityInternal &act = Activities::s_activities[idx];
+    act.wallpaper = QString::fromUtf8(path);
+    /* New image: whatever was decoded is stale */
+    act.wallpaperImage = QImage();
+    act.stateLoaded = false;
+    if (idx == Activities::s_currentIndex)
+        Activities::ensureStateLoaded(act);
+    Activities::saveActivity(act);
+
+    qDebug("Activities: set wallpaper for '%s' to '%s'", id, path);
+}
+
+const char *activities_get_wallpaper(const char *id)
+{
+    if (!Activities::s_initialized || !id)
+        return nullptr;
+
+    int idx = Activities::findById(QString::fromUtf8(id));
+    if (idx < 0 || Activities::s_activities[idx].wallpaper.isEmpty())
+        return nullptr;
+
+    static QByteArray s_wallpaperCache;
+    s_wallpaperCache = Activities::s_activities[idx].wallpaper.toUtf8();
+    return s_wallpaperCache.constData();
+}
+
 void activities_add_window(const char *id, uint32_t window_id)
 {
     if (!Activities::s_initialized || !id)
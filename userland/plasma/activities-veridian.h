@@ -140,6 +140,19 @@ void activities_set_name(const char *id, const char *name);
  */
 void activities_set_icon(const char *id, const char *icon);
 
+/**
+ * Set the wallpaper image path for an activity.  The image is decoded
+ * lazily (or prefetched ahead of a predicted switch) rather than at
+ * set time.
+ */
+void activities_set_wallpaper(const char *id, const char *path);
+
+/**
+ * Return the wallpaper image path for an activity, or NULL if unset.
+ * Valid until the next call or activities_destroy().
+ */
+const char *activities_get_wallpaper(const char *id);
+
 /* ========================================================================= */
 /* Window association                                                        */
 /* ========================================================================= */
@@ -0,0 +1,399 @@
+/*
+ * VeridianOS -- breeze-asset-pack.cpp
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Asset pack loader and builder (breeze-asset-pack.h).  Plain POSIX
+ * plus zlib; no Qt, so the builder doubles as a host tool and the
+ * loader links into anything.
+ */
+
+#include "breeze-asset-pack.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <zlib.h>
+
+#define BAP_VERSION 1u
+#define BAP_MAX_ENTRIES 16384
+
+struct bap_pack {
+    void   *map;
+    size_t  map_len;
+    const struct bap_header *hdr;
+    const struct bap_entry  *entries;
+    const char *strtab;
+    void  **materialized;       /* Per-entry inflate cache */
+};
+
+static uint64_t bap_hash(const char *s)
+{
+    uint64_t h = 14695981039346656037ull;
+
+    for (; *s; s++) {
+        h ^= (uint8_t)*s;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+/* ========================================================================= */
+/* Loader                                                                    */
+/* ========================================================================= */
+
+bap_pack *bap_open(const char *path)
+{
+    int fd = open(path ? path : BAP_DEFAULT_PATH, O_RDONLY);
+    struct stat st;
+    void *map;
+
+    if (fd < 0)
+        return NULL;
+    if (fstat(fd, &st) < 0 ||
+        st.st_size < (off_t)sizeof(struct bap_header)) {
+        close(fd);
+        return NULL;
+    }
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return NULL;
+
+    const struct bap_header *hdr = (const struct bap_header *)map;
+
+    if (hdr->magic != BAP_MAGIC || hdr->version != BAP_VERSION ||
+        hdr->entry_count > BAP_MAX_ENTRIES) {
+        munmap(map, (size_t)st.st_size);
+        return NULL;
+    }
+
+    bap_pack *p = (bap_pack *)calloc(1, sizeof(*p));
+
+    if (!p) {
+        munmap(map, (size_t)st.st_size);
+        return NULL;
+    }
+    p->map = map;
+    p->map_len = (size_t)st.st_size;
+    p->hdr = hdr;
+    p->entries = (const struct bap_entry *)(hdr + 1);
+    p->strtab = (const char *)map + hdr->strtab_off;
+    p->materialized =
+        (void **)calloc(hdr->entry_count, sizeof(void *));
+    if (!p->materialized) {
+        munmap(map, (size_t)st.st_size);
+        free(p);
+        return NULL;
+    }
+    return p;
+}
+
+const void *bap_get(bap_pack *p, const char *name, size_t *len)
+{
+    if (!p || !name)
+        return NULL;
+
+    uint64_t h = bap_hash(name);
+    uint32_t lo = 0, hi = p->hdr->entry_count;
+
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        const struct bap_entry *e = &p->entries[mid];
+
+        if (e->name_hash == h) {
+            /* Hash collisions resolve by name check over the
+             * neighboring equal-hash run */
+            while (mid > 0 && p->entries[mid - 1].name_hash == h)
+                mid--;
+            for (; mid < p->hdr->entry_count &&
+                   p->entries[mid].name_hash == h; mid++) {
+                e = &p->entries[mid];
+                if (strcmp(p->strtab + e->name_off, name) != 0)
+                    continue;
+                if (len)
+                    *len = e->size;
+                if (e->comp_size == 0)
+                    return (const char *)p->map + e->data_off;
+
+                /* Compressed: inflate once, cache per entry */
+                if (!p->materialized[mid]) {
+                    unsigned char *buf = (unsigned char *)malloc(e->size);
+                    unsigned long out_len = e->size;
+
+                    if (!buf)
+                        return NULL;
+                    if (uncompress(buf, &out_len,
+                                   (const unsigned char *)p->map +
+                                       e->data_off,
+                                   e->comp_size) != Z_OK ||
+                        out_len != e->size) {
+                        free(buf);
+                        return NULL;
+                    }
+                    p->materialized[mid] = buf;
+                }
+                return p->materialized[mid];
+            }
+            return NULL;
+        }
+        if (e->name_hash < h)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return NULL;
+}
+
+uint32_t bap_count(const bap_pack *p)
+{
+    return p ? p->hdr->entry_count : 0;
+}
+
+void bap_close(bap_pack *p)
+{
+    if (!p)
+        return;
+    for (uint32_t i = 0; i < p->hdr->entry_count; i++)
+        free(p->materialized[i]);
+    free(p->materialized);
+    munmap(p->map, p->map_len);
+    free(p);
+}
+
+/* ========================================================================= */
+/* Builder                                                                   */
+/* ========================================================================= */
+
+struct bap_build_state {
+    struct bap_entry entries[BAP_MAX_ENTRIES];
+    uint32_t count;
+    char  *strtab;
+    size_t str_used, str_cap;
+    FILE  *data;                /* Temp data stream */
+    uint64_t data_off;
+};
+
+static uint32_t build_intern(struct bap_build_state *b, const char *s)
+{
+    size_t len = strlen(s) + 1;
+    uint32_t off = (uint32_t)b->str_used;
+
+    if (b->str_used + len > b->str_cap) {
+        size_t ncap = b->str_cap ? b->str_cap * 2 : 8192;
+
+        while (ncap < b->str_used + len)
+            ncap *= 2;
+        b->strtab = (char *)realloc(b->strtab, ncap);
+        b->str_cap = ncap;
+    }
+    memcpy(b->strtab + off, s, len);
+    b->str_used += len;
+    return off;
+}
+
+static int build_add_file(struct bap_build_state *b, const char *full,
+                          const char *rel)
+{
+    struct stat st;
+    int fd = open(full, O_RDONLY);
+
+    if (fd < 0 || fstat(fd, &st) < 0 || b->count >= BAP_MAX_ENTRIES) {
+        if (fd >= 0)
+            close(fd);
+        return -1;
+    }
+
+    unsigned char *raw = (unsigned char *)malloc(st.st_size ? (size_t)st.st_size : 1);
+    unsigned long bound = compressBound((unsigned long)st.st_size);
+    unsigned char *comp = (unsigned char *)malloc(bound ? bound : 1);
+
+    if (!raw || !comp) {
+        free(raw);
+        free(comp);
+        close(fd);
+        return -1;
+    }
+    {
+        size_t got = 0;
+
+        while (got < (size_t)st.st_size) {
+            ssize_t rd = read(fd, raw + got, (size_t)st.st_size - got);
+
+            if (rd <= 0)
+                break;
+            got += (size_t)rd;
+        }
+        close(fd);
+        if (got != (size_t)st.st_size) {
+            free(raw);
+            free(comp);
+            return -1;
+        }
+    }
+
+    unsigned long comp_len = bound;
+    int use_comp = st.st_size > 256 &&
+                   compress2(comp, &comp_len, raw,
+                             (unsigned long)st.st_size, 6) == Z_OK &&
+                   comp_len < (unsigned long)st.st_size;
+
+    struct bap_entry *e = &b->entries[b->count++];
+
+    e->name_hash = bap_hash(rel);
+    e->data_off = b->data_off;
+    e->size = (uint32_t)st.st_size;
+    e->comp_size = use_comp ? (uint32_t)comp_len : 0;
+    e->name_off = build_intern(b, rel);
+    e->_pad = 0;
+
+    const unsigned char *out = use_comp ? comp : raw;
+    size_t out_len = use_comp ? comp_len : (size_t)st.st_size;
+
+    fwrite(out, 1, out_len, b->data);
+    b->data_off += out_len;
+
+    free(raw);
+    free(comp);
+    return 0;
+}
+
+static void build_walk(struct bap_build_state *b, const char *root,
+                       const char *dir)
+{
+    DIR *d = opendir(dir);
+    struct dirent *de;
+
+    if (!d)
+        return;
+    while ((de = readdir(d)) != NULL) {
+        char full[1024];
+
+        if (de->d_name[0] == '.')
+            continue;
+        snprintf(full, sizeof(full), "%s/%s", dir, de->d_name);
+
+        struct stat st;
+
+        if (lstat(full, &st) < 0)
+            continue;
+        if (S_ISDIR(st.st_mode)) {
+            build_walk(b, root, full);
+        } else if (S_ISREG(st.st_mode)) {
+            const char *rel = full + strlen(root);
+
+            while (*rel == '/')
+                rel++;
+            build_add_file(b, full, rel);
+        }
+    }
+    closedir(d);
+}
+
+static int entry_cmp(const void *a, const void *b)
+{
+    const struct bap_entry *ea = (const struct bap_entry *)a;
+    const struct bap_entry *eb = (const struct bap_entry *)b;
+
+    if (ea->name_hash < eb->name_hash)
+        return -1;
+    return ea->name_hash > eb->name_hash ? 1 : 0;
+}
+
+int bap_build(const char *dir, const char *pack_path)
+{
+    struct bap_build_state *b =
+        (struct bap_build_state *)calloc(1, sizeof(*b));
+    char tmp[1024];
+    int rc = -1;
+
+    if (!b)
+        return -1;
+    snprintf(tmp, sizeof(tmp), "%s.data", pack_path);
+    b->data = fopen(tmp, "wb+");
+
+    if (b->data) {
+        build_walk(b, dir, dir);
+        qsort(b->entries, b->count, sizeof(b->entries[0]), entry_cmp);
+
+        /* Assemble: header, index, strtab, then the data stream
+         * with offsets rebased past the front matter */
+        uint64_t front = sizeof(struct bap_header) +
+                         (uint64_t)b->count * sizeof(struct bap_entry) +
+                         b->str_used;
+
+        for (uint32_t i = 0; i < b->count; i++)
+            b->entries[i].data_off += front;
+
+        char ptmp[1032];
+
+        snprintf(ptmp, sizeof(ptmp), "%s.tmp", pack_path);
+
+        FILE *out = fopen(ptmp, "wb");
+
+        if (out) {
+            struct bap_header hdr;
+
+            hdr.magic = BAP_MAGIC;
+            hdr.version = BAP_VERSION;
+            hdr.entry_count = b->count;
+            hdr.strtab_off =
+                (uint32_t)(sizeof(hdr) +
+                           b->count * sizeof(struct bap_entry));
+            fwrite(&hdr, sizeof(hdr), 1, out);
+            fwrite(b->entries, sizeof(b->entries[0]), b->count, out);
+            fwrite(b->strtab, 1, b->str_used, out);
+
+            rewind(b->data);
+            {
+                char buf[65536];
+                size_t rd;
+
+                while ((rd = fread(buf, 1, sizeof(buf), b->data)) > 0)
+                    fwrite(buf, 1, rd, out);
+            }
+            if (fflush(out) == 0 && !ferror(out)) {
+                fclose(out);
+                if (rename(ptmp, pack_path) == 0)
+                    rc = (int)b->count;
+            } else {
+                fclose(out);
+                unlink(ptmp);
+            }
+        }
+    }
+
+    if (b->data) {
+        fclose(b->data);
+        unlink(tmp);
+    }
+    free(b->strtab);
+    free(b);
+    return rc;
+}
+
+#ifdef BAP_BUILDER_MAIN
+int main(int argc, char **argv)
+{
+    if (argc != 3) {
+        fprintf(stderr, "usage: breeze-pack <asset-dir> <pack-file>\n");
+        return 2;
+    }
+
+    int n = bap_build(argv[1], argv[2]);
+
+    if (n < 0) {
+        fprintf(stderr, "breeze-pack: build failed\n");
+        return 1;
+    }
+    printf("breeze-pack: %d assets packed into %s\n", n, argv[2]);
+    return 0;
+}
+#endif
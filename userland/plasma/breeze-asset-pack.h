@@ -0,0 +1,77 @@
+/*
+ * VeridianOS -- breeze-asset-pack.h
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Indexed asset pack for the Breeze theme.
+ *
+ * Thousands of tiny icon and scheme files become one mmap-able pack
+ * ('VAST'): a name-hash-sorted index bsearched per lookup, entry
+ * data deflate-compressed when it pays, raw otherwise.  The loader
+ * maps the pack once and materializes an entry on first access --
+ * theme load does one open and one mmap instead of the thousand
+ * small opens BlockFS handles worst.
+ */
+
+#ifndef BREEZE_ASSET_PACK_H
+#define BREEZE_ASSET_PACK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BAP_MAGIC 0x54534156u   /* "VAST" */
+#define BAP_DEFAULT_PATH \
+    "/usr/share/icons/breeze/breeze-assets.pack"
+
+struct bap_header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entry_count;
+    uint32_t strtab_off;        /* Names, for hash verification */
+};
+
+struct bap_entry {
+    uint64_t name_hash;         /* FNV-64 of the relative path */
+    uint64_t data_off;
+    uint32_t size;              /* Uncompressed */
+    uint32_t comp_size;         /* 0 = stored raw */
+    uint32_t name_off;          /* Into the string table */
+    uint32_t _pad;
+};
+
+typedef struct bap_pack bap_pack;
+
+/** Map a pack read-only.  NULL on missing/corrupt file. */
+bap_pack *bap_open(const char *path);
+
+/**
+ * Fetch one asset by its relative path (e.g.
+ * "actions/22/edit-copy.svg").  Raw entries return a pointer into
+ * the mapping; compressed entries inflate once into a per-entry
+ * heap buffer that lives until bap_close().  Returns NULL on miss.
+ */
+const void *bap_get(bap_pack *p, const char *name, size_t *len);
+
+/** Number of assets in the pack. */
+uint32_t bap_count(const bap_pack *p);
+
+void bap_close(bap_pack *p);
+
+/**
+ * Builder: walk `dir` recursively and write every regular file into
+ * `pack_path`, keyed by its path relative to dir.  Entries compress
+ * with deflate when that shrinks them.  Returns the entry count or
+ * -1.
+ */
+int bap_build(const char *dir, const char *pack_path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BREEZE_ASSET_PACK_H */
@@ -629,8 +629,108 @@ void BreezeDecoration::paintCaption(QPainter *painter)
 /* Shadow                                                                    */
 /* ========================================================================= */
 
+/*
+ * Shadows are shared, not per-window: every decoration with the same
+ * (size, offset, strength) configuration hands KWin the SAME
+ * DecorationShadow object, so the compositor keeps exactly one
+ * texture no matter how many windows are open, and resizing a window
+ * never regenerates anything -- KWin stretches the 9-slice tiles at
+ * composite time via the padding/innerShadowRect geometry.
+ *
+ * The raster itself goes through a tile atlas: the radial falloff is
+ * horizontally symmetric (only vertically offset), so one half-strip
+ * is rendered per configuration and the full image is composed from
+ * it with a mirrored blit.  Both caches are static and survive
+ * decoration churn, so opening the Nth window costs two hash lookups.
+ */
+
+namespace {
+
+struct ShadowKey {
+    int size;
+    int offset;
+    int strength255;
+
+    bool operator==(const ShadowKey &o) const
+    {
+        return size == o.size && offset == o.offset &&
+               strength255 == o.strength255;
+    }
+};
+
+inline size_t qHash(const ShadowKey &k, size_t seed = 0)
+{
+    return ::qHash((k.size << 16) ^ (k.offset << 8) ^ k.strength255,
+                   seed);
+}
+
+QHash<ShadowKey, QSharedPointer<KDecoration2::DecorationShadow>> &
+shadowCache()
+{
+    static QHash<ShadowKey,
+                 QSharedPointer<KDecoration2::DecorationShadow>> cache;
+
+    return cache;
+}
+
+QHash<ShadowKey, QImage> &shadowAtlas()
+{
+    static QHash<ShadowKey, QImage> atlas;
+
+    return atlas;
+}
+
+/* Left half-strip of the shadow raster, rendered once per config */
+const QImage &atlasHalfStrip(const ShadowKey &key)
+{
+    auto it = shadowAtlas().find(key);
+
+    if (it != shadowAtlas().end())
+        return it.value();
+
+    const int size = key.size * 2 + 1;
+    const int half = key.size + 1;     /* includes the center column */
+    QImage strip(half, size, QImage::Format_ARGB32_Premultiplied);
+
+    strip.fill(Qt::transparent);
+
+    QPainter painter(&strip);
+
+    painter.setRenderHint(QPainter::Antialiasing, true);
+
+    const qreal strength = key.strength255 / 255.0;
+    QPointF center(size / 2.0, size / 2.0 - key.offset);
+    QRadialGradient gradient(center, key.size);
+
+    gradient.setColorAt(0.0, QColor(0, 0, 0,
+                                    static_cast<int>(255 * strength)));
+    gradient.setColorAt(0.3, QColor(0, 0, 0,
+                                    static_cast<int>(128 * strength)));
+    gradient.setColorAt(1.0, Qt::transparent);
+
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(gradient);
+    painter.drawEllipse(center, key.size, key.size);
+    painter.end();
+
+    return *shadowAtlas().insert(key, strip);
+}
+
+} /* namespace */
+
 QSharedPointer<KDecoration2::DecorationShadow> BreezeDecoration::createShadow()
 {
+    const ShadowKey key = {
+        DecorationMetrics::ShadowSize,
+        DecorationMetrics::ShadowOffset,
+        static_cast<int>(255 * DecorationMetrics::ShadowStrength)
+    };
+
+    auto it = shadowCache().find(key);
+
+    if (it != shadowCache().end())
+        return it.value();
+
     QImage shadowImage = generateShadowImage();
 
     auto shadow = QSharedPointer<KDecoration2::DecorationShadow>::create();
@@ -643,28 +743,35 @@ QSharedPointer<KDecoration2::DecorationShadow> BreezeDecoration::createShadow()
                                       shadowImage.width() - 2 * shadowSize,
                                       shadowImage.height() - 2 * shadowSize));
 
+    shadowCache().insert(key, shadow);
     return shadow;
 }
 
 QImage BreezeDecoration::generateShadowImage() const
 {
-    int size = DecorationMetrics::ShadowSize * 2 + 1;
+    const ShadowKey key = {
+        DecorationMetrics::ShadowSize,
+        DecorationMetrics::ShadowOffset,
+        static_cast<int>(255 * DecorationMetrics::ShadowStrength)
+    };
+    const QImage &strip = atlasHalfStrip(key);
+
+    /* Compose: atlas half + horizontally mirrored right half (the
+     * shared center column is not duplicated) */
+    const int size = key.size * 2 + 1;
     QImage image(size, size, QImage::Format_ARGB32_Premultiplied);
+
     image.fill(Qt::transparent);
 
     QPainter painter(&image);
-    painter.setRenderHint(QPainter::Antialiasing, true);
-
-    QPointF center(size / 2.0, size / 2.0 - DecorationMetrics::ShadowOffset);
-    QRadialGradient gradient(center, DecorationMetrics::ShadowSize);
-    gradient.setColorAt(0.0, QColor(0, 0, 0, static_cast<int>(255 * DecorationMetrics::ShadowStrength)));
-    gradient.setColorAt(0.3, QColor(0, 0, 0, static_cast<int>(128 * DecorationMetrics::ShadowStrength)));
-    gradient.setColorAt(1.0, Qt::transparent);
 
-    painter.setPen(Qt::NoPen);
-    painter.setBrush(gradient);
-    painter.drawEllipse(center, DecorationMetrics::ShadowSize,
-                        DecorationMetrics::ShadowSize);
+    painter.drawImage(0, 0, strip);
+    /* The mirrored strip starts with the center column; skip it so
+     * column S appears exactly once */
+    painter.drawImage(key.size + 1, 0,
+                      strip.mirrored(true, false), 1, 0,
+                      key.size, size);
+    painter.end();
 
     return image;
 }
@@ -17,6 +17,7 @@
  */
 
 #include "breeze-veridian-style.h"
+#include "breeze-asset-pack.h"
 
 #include <QApplication>
 #include <QAbstractItemView>
@@ -426,6 +427,143 @@ void BreezeStyle::drawPrimitive(PrimitiveElement element,
     }
 }
 
+/* ========================================================================= */
+/* Element pixmap cache                                                      */
+/* ========================================================================= */
+
+/*
+ * Scrolling a settings page repaints hundreds of identical buttons,
+ * frames, and indicators; re-rasterizing each anti-aliased rounded
+ * rect per paint event is pure waste.  Elements are rendered once
+ * into a pixmap keyed on (element kind, size, device pixel ratio,
+ * the actual derived colors, and a state nibble) and blitted on
+ * every later paint -- keying on the computed colors rather than
+ * palette+state makes the entry trivially shared across widgets that
+ * resolve to the same appearance.  The cache is byte-bounded with
+ * FIFO eviction, and its footprint is reported by plasma_mem_report()
+ * through the breeze_style_cache_* hooks below.
+ *
+ * Animated overlays (the focus ring) are deliberately painted on top
+ * uncached: their opacity changes per frame.  Hover-blended fills do
+ * key to transient colors mid-animation; those frames simply miss and
+ * the handful of short-lived entries ages out of the budget.
+ */
+
+namespace {
+
+struct ElementKey {
+    quint32 kind;
+    quint16 w, h;
+    quint16 dpr100;
+    quint32 c1, c2;     /* derived fill / border RGBA */
+    quint8  flags;
+
+    bool operator==(const ElementKey &o) const
+    {
+        return kind == o.kind && w == o.w && h == o.h &&
+               dpr100 == o.dpr100 && c1 == o.c1 && c2 == o.c2 &&
+               flags == o.flags;
+    }
+};
+
+inline size_t qHash(const ElementKey &k, size_t seed = 0)
+{
+    return ::qHash(k.kind, seed) ^ ::qHash((k.w << 16) | k.h) ^
+           ::qHash(k.c1) ^ ::qHash(k.c2 + k.flags + k.dpr100);
+}
+
+enum ElementKind : quint32 {
+    ElemPanelButton = 1,
+    ElemPanelFrame,
+    ElemCheckBox,
+    ElemRadio,
+};
+
+struct CacheStats {
+    quint64 bytes = 0;
+    quint64 hits = 0;
+    quint64 misses = 0;
+};
+
+class ElementPixmapCache
+{
+public:
+    static constexpr quint64 MaxBytes = 4 * 1024 * 1024;
+
+    /* Returns the cached pixmap, rendering via `render` on a miss */
+    template <typename RenderFn>
+    QPixmap lookup(const ElementKey &key, qreal dpr, RenderFn render)
+    {
+        auto it = m_entries.find(key);
+
+        if (it != m_entries.end()) {
+            m_stats.hits++;
+            return it.value();
+        }
+        m_stats.misses++;
+
+        QPixmap pm(qRound(key.w * dpr), qRound(key.h * dpr));
+
+        pm.setDevicePixelRatio(dpr);
+        pm.fill(Qt::transparent);
+        {
+            QPainter p(&pm);
+
+            render(&p);
+        }
+
+        quint64 sz = (quint64)pm.width() * pm.height() * 4;
+
+        while (m_stats.bytes + sz > MaxBytes && !m_order.isEmpty()) {
+            const ElementKey old = m_order.takeFirst();
+            auto oit = m_entries.find(old);
+
+            if (oit != m_entries.end()) {
+                m_stats.bytes -= (quint64)oit.value().width() *
+                                 oit.value().height() * 4;
+                m_entries.erase(oit);
+            }
+        }
+
+        m_entries.insert(key, pm);
+        m_order.append(key);
+        m_stats.bytes += sz;
+        return pm;
+    }
+
+    const CacheStats &stats() const { return m_stats; }
+
+private:
+    QHash<ElementKey, QPixmap> m_entries;
+    QList<ElementKey> m_order;
+    CacheStats m_stats;
+};
+
+ElementPixmapCache &elementCache()
+{
+    static ElementPixmapCache cache;
+
+    return cache;
+}
+
+} /* namespace */
+
+/* Footprint hooks consumed (weakly) by plasma_mem_report() */
+extern "C" quint64 breeze_style_cache_bytes(void)
+{
+    return elementCache().stats().bytes;
+}
+
+extern "C" quint64 breeze_style_cache_hits(void)
+{
+    return elementCache().stats().hits;
+}
+
+extern "C" quint64 breeze_style_cache_misses(void)
+{
+    return elementCache().stats().misses;
+}
+
 /* ========================================================================= */
 /* Breeze-specific primitive painters                                        */
 /* ========================================================================= */
@@ -442,9 +580,22 @@ void BreezeStyle::drawPanelButton(QPainter *painter,
     if (option->state & QStyle::State_Sunken)
         border = border.darker(120);
 
-    drawRoundedRect(painter, rect, Metrics::ButtonRadius, bg, border);
+    const qreal dpr = widget ? widget->devicePixelRatio() : 1.0;
+    ElementKey key = { ElemPanelButton,
+                       (quint16)option->rect.width(),
+                       (quint16)option->rect.height(),
+                       (quint16)qRound(dpr * 100),
+                       bg.rgba(), border.rgba(), 0 };
+    QPixmap pm = elementCache().lookup(key, dpr, [&](QPainter *p) {
+        QRectF r(0, 0, option->rect.width(), option->rect.height());
 
-    /* Focus ring */
+        drawRoundedRect(p, r.adjusted(1, 1, -1, -1),
+                        Metrics::ButtonRadius, bg, border);
+    });
+
+    painter->drawPixmap(option->rect.topLeft(), pm);
+
+    /* Focus ring: animated, always painted live */
     if (option->state & QStyle::State_HasFocus) {
         qreal focusOp = widget ? m_animationEngine->focusOpacity(widget) : 1.0;
         if (focusOp <= 0.0)
@@ -458,24 +609,32 @@ void BreezeStyle::drawPanelFrame(QPainter *painter,
                                   const QStyleOption *option,
                                   const QWidget *widget) const
 {
-    Q_UNUSED(widget);
-    QRectF rect = QRectF(option->rect).adjusted(0.5, 0.5, -0.5, -0.5);
     QColor border = separatorColor(option);
-
-    painter->save();
-    painter->setRenderHint(QPainter::Antialiasing, true);
-    painter->setPen(QPen(border, Metrics::FrameWidth));
-    painter->setBrush(Qt::NoBrush);
-    painter->drawRoundedRect(rect, Metrics::FrameRadius, Metrics::FrameRadius);
-    painter->restore();
+    const qreal dpr = widget ? widget->devicePixelRatio() : 1.0;
+    ElementKey key = { ElemPanelFrame,
+                       (quint16)option->rect.width(),
+                       (quint16)option->rect.height(),
+                       (quint16)qRound(dpr * 100),
+                       0, border.rgba(), 0 };
+    QPixmap pm = elementCache().lookup(key, dpr, [&](QPainter *p) {
+        QRectF r = QRectF(0, 0, option->rect.width(),
+                          option->rect.height())
+                       .adjusted(0.5, 0.5, -0.5, -0.5);
+
+        p->setRenderHint(QPainter::Antialiasing, true);
+        p->setPen(QPen(border, Metrics::FrameWidth));
+        p->setBrush(Qt::NoBrush);
+        p->drawRoundedRect(r, Metrics::FrameRadius,
+                           Metrics::FrameRadius);
+    });
+
+    painter->drawPixmap(option->rect.topLeft(), pm);
 }
 
 void BreezeStyle::drawIndicatorCheckBox(QPainter *painter,
                                          const QStyleOption *option,
                                          const QWidget *widget) const
 {
-    Q_UNUSED(widget);
-    QRectF rect = QRectF(option->rect);
     bool checked = (option->state & QStyle::State_On);
     bool indeterminate = (option->state & QStyle::State_NoChange);
     bool enabled = (option->state & QStyle::State_Enabled);
@@ -490,32 +649,46 @@ void BreezeStyle::drawIndicatorCheckBox(QPainter *painter,
         border = separatorColor(option).lighter(120);
     }
 
-    drawRoundedRect(painter, rect, Metrics::FrameRadius, bg, border);
+    const QColor mark = option->palette.color(QPalette::HighlightedText);
+    const QColor dash = enabled ? focusColor(option)
+                                : separatorColor(option);
+    const qreal dpr = widget ? widget->devicePixelRatio() : 1.0;
+    const quint8 flags = (quint8)((checked ? 1 : 0) |
+                                  (indeterminate ? 2 : 0) |
+                                  (enabled ? 4 : 0));
+    ElementKey key = { ElemCheckBox,
+                       (quint16)option->rect.width(),
+                       (quint16)option->rect.height(),
+                       (quint16)qRound(dpr * 100),
+                       bg.rgba(),
+                       border.rgba() ^ (mark.rgba() << 8) ^
+                           (dash.rgba() >> 8),
+                       flags };
+    QPixmap pm = elementCache().lookup(key, dpr, [&](QPainter *p) {
+        QRectF rect(0, 0, option->rect.width(), option->rect.height());
+
+        drawRoundedRect(p, rect, Metrics::FrameRadius, bg, border);
+
+        if (checked) {
+            drawCheckMark(p, rect.adjusted(3, 3, -3, -3), mark);
+        } else if (indeterminate) {
+            p->setRenderHint(QPainter::Antialiasing, true);
+            QRectF dashRect(rect.center().x() - rect.width() * 0.25,
+                            rect.center().y() - 1,
+                            rect.width() * 0.5, 2);
+            p->setPen(Qt::NoPen);
+            p->setBrush(dash);
+            p->drawRoundedRect(dashRect, 1, 1);
+        }
+    });
 
-    if (checked) {
-        QRectF markRect = rect.adjusted(3, 3, -3, -3);
-        drawCheckMark(painter, markRect,
-                      option->palette.color(QPalette::HighlightedText));
-    } else if (indeterminate) {
-        painter->save();
-        painter->setRenderHint(QPainter::Antialiasing, true);
-        QRectF dashRect(rect.center().x() - rect.width() * 0.25,
-                        rect.center().y() - 1,
-                        rect.width() * 0.5, 2);
-        painter->setPen(Qt::NoPen);
-        painter->setBrush(enabled ? focusColor(option)
-                                  : separatorColor(option));
-        painter->drawRoundedRect(dashRect, 1, 1);
-        painter->restore();
-    }
+    painter->drawPixmap(option->rect.topLeft(), pm);
 }
 
 void BreezeStyle::drawIndicatorRadio(QPainter *painter,
                                       const QStyleOption *option,
                                       const QWidget *widget) const
 {
-    Q_UNUSED(widget);
-    QRectF rect = QRectF(option->rect);
     bool checked = (option->state & QStyle::State_On);
     bool enabled = (option->state & QStyle::State_Enabled);
 
@@ -529,24 +702,36 @@ void BreezeStyle::drawIndicatorRadio(QPainter *painter,
         border = separatorColor(option).lighter(120);
     }
 
-    painter->save();
-    painter->setRenderHint(QPainter::Antialiasing, true);
-
-    /* Outer circle */
-    painter->setPen(QPen(border, 1.0));
-    painter->setBrush(bg);
-    painter->drawEllipse(rect.adjusted(0.5, 0.5, -0.5, -0.5));
-
-    /* Inner dot for checked state */
-    if (checked) {
-        QColor dot = option->palette.color(QPalette::HighlightedText);
-        painter->setPen(Qt::NoPen);
-        painter->setBrush(dot);
-        qreal inset = rect.width() * 0.3;
-        painter->drawEllipse(rect.adjusted(inset, inset, -inset, -inset));
-    }
+    const QColor dot = option->palette.color(QPalette::HighlightedText);
+    const qreal dpr = widget ? widget->devicePixelRatio() : 1.0;
+    const quint8 flags = (quint8)((checked ? 1 : 0) |
+                                  (enabled ? 4 : 0));
+    ElementKey key = { ElemRadio,
+                       (quint16)option->rect.width(),
+                       (quint16)option->rect.height(),
+                       (quint16)qRound(dpr * 100),
+                       bg.rgba(),
+                       border.rgba() ^ (dot.rgba() << 8), flags };
+    QPixmap pm = elementCache().lookup(key, dpr, [&](QPainter *p) {
+        QRectF rect(0, 0, option->rect.width(), option->rect.height());
+
+        p->setRenderHint(QPainter::Antialiasing, true);
+
+        /* Outer circle */
+        p->setPen(QPen(border, 1.0));
+        p->setBrush(bg);
+        p->drawEllipse(rect.adjusted(0.5, 0.5, -0.5, -0.5));
+
+        /* Inner dot for checked state */
+        if (checked) {
+            p->setPen(Qt::NoPen);
+            p->setBrush(dot);
+            qreal inset = rect.width() * 0.3;
+            p->drawEllipse(rect.adjusted(inset, inset, -inset, -inset));
+        }
+    });
 
-    painter->restore();
+    painter->drawPixmap(option->rect.topLeft(), pm);
 }
 
 /* ========================================================================= */
@@ -985,11 +1170,91 @@ QRect BreezeStyle::subControlRect(ComplexControl control,
 /* Size hints                                                                */
 /* ========================================================================= */
 
+/* FNV-1a over the measurement inputs */
+static quint64 textSizeKey(int type, const QSize &size,
+                           const QFontMetrics &fm, const QString &text)
+{
+    quint64 h = 14695981039346656037ull;
+    auto mix = [&h](quint64 v) {
+        for (int i = 0; i < 8; i++) {
+            h ^= (v >> (i * 8)) & 0xFF;
+            h *= 1099511628211ull;
+        }
+    };
+
+    mix((quint64)type);
+    mix(((quint64)(quint32)size.width() << 32) |
+        (quint32)size.height());
+    /* Font + DPI fingerprint: height, ascent, and a probe advance
+     * change whenever the font or the device resolution does */
+    mix(((quint64)(quint32)fm.height() << 32) |
+        (quint32)fm.ascent());
+    mix((quint64)(quint32)fm.horizontalAdvance(QLatin1Char('x')));
+    for (QChar c : text)
+        mix(c.unicode());
+    return h;
+}
+
+/* The label text a contents type measures, empty when uncacheable */
+static QString textForOption(QStyle::ContentsType type,
+                             const QStyleOption *option)
+{
+    switch (type) {
+    case QStyle::CT_PushButton:
+    case QStyle::CT_CheckBox:
+    case QStyle::CT_RadioButton:
+        if (const auto *b =
+                qstyleoption_cast<const QStyleOptionButton *>(option))
+            return b->text;
+        break;
+    case QStyle::CT_MenuItem:
+        if (const auto *m =
+                qstyleoption_cast<const QStyleOptionMenuItem *>(option))
+            return m->text;
+        break;
+    case QStyle::CT_TabBarTab:
+        if (const auto *t =
+                qstyleoption_cast<const QStyleOptionTab *>(option))
+            return t->text;
+        break;
+    case QStyle::CT_ComboBox:
+        if (const auto *c =
+                qstyleoption_cast<const QStyleOptionComboBox *>(option))
+            return c->currentText;
+        break;
+    default:
+        break;
+    }
+    return QString();
+}
+
 QSize BreezeStyle::sizeFromContents(ContentsType type,
                                      const QStyleOption *option,
                                      const QSize &size,
                                      const QWidget *widget) const
 {
+    /*
+     * Measurement cache: identical (type, input size, font, text)
+     * tuples -- every static label during an interactive resize --
+     * skip the base implementation's text shaping entirely.
+     */
+    quint64 cacheKey = 0;
+    bool cacheable = false;
+
+    if (option) {
+        const QString text = textForOption(type, option);
+
+        if (!text.isEmpty()) {
+            cacheKey = textSizeKey(type, size, option->fontMetrics,
+                                   text);
+            auto it = m_textSizeCache.constFind(cacheKey);
+
+            if (it != m_textSizeCache.constEnd())
+                return *it;
+            cacheable = true;
+        }
+    }
+
     QSize s = QProxyStyle::sizeFromContents(type, option, size, widget);
 
     switch (type) {
@@ -1030,6 +1295,14 @@ QSize BreezeStyle::sizeFromContents(ContentsType type,
         break;
     }
 
+    if (cacheable) {
+        /* Stale-fingerprint entries age out with the bound, so no
+         * font-change hook is needed */
+        if (m_textSizeCache.size() >= 4096)
+            m_textSizeCache.clear();
+        m_textSizeCache.insert(cacheKey, s);
+    }
+
     return s;
 }
 
@@ -1116,6 +1389,31 @@ QRect BreezeStyle::subElementRect(SubElement element,
 /* Standard icons                                                            */
 /* ========================================================================= */
 
+/*
+ * The theme's asset pack, mapped once per process: icon and scheme
+ * lookups are a bsearch and (for compressed entries) one inflate,
+ * instead of a file open per asset.
+ */
+static bap_pack *themeAssetPack()
+{
+    static bap_pack *pack;
+    static bool tried;
+
+    if (!pack && !tried) {
+        tried = true;
+        pack = bap_open(nullptr);       /* BAP_DEFAULT_PATH */
+    }
+    return pack;
+}
+
+/* Raw asset bytes from the pack, or null when unpacked/missing */
+const void *breezeAssetData(const char *relPath, size_t *len)
+{
+    bap_pack *pack = themeAssetPack();
+
+    return pack ? bap_get(pack, relPath, len) : nullptr;
+}
+
 QIcon BreezeStyle::standardIcon(StandardPixmap standardIcon,
                                  const QStyleOption *option,
                                  const QWidget *widget) const
@@ -248,6 +248,18 @@ public:
                            const QSize &size,
                            const QWidget *widget) const override;
 
+private:
+    /*
+     * Text-measurement cache for sizeFromContents: settings dialogs
+     * relayout hundreds of static labels on every resize tick, and
+     * the font shaping under the base implementation dominates.  The
+     * key folds a font+DPI fingerprint in, so a font or DPI change
+     * makes old entries unreachable instead of needing event hooks.
+     */
+    mutable QHash<quint64, QSize> m_textSizeCache;
+
+public:
+
     /* ----- Pixel metrics ----- */
     int pixelMetric(PixelMetric metric,
                     const QStyleOption *option,
@@ -615,3 +615,33 @@ echo ""
 echo "  Note: Icon SVGs and cursor images are installed from the"
 echo "  upstream Breeze packages during the full KDE build (build-plasma-apps.sh)."
 echo "  This script installs the theme metadata and configuration."
+
+# =========================================================================
+# Asset pack (on-demand paging; see breeze-asset-pack.h)
+# =========================================================================
+
+echo ""
+echo "Building asset pack..."
+
+if command -v breeze-pack >/dev/null 2>&1; then
+    breeze-pack "${SHARE}/icons/breeze" \
+        "${SHARE}/icons/breeze/breeze-assets.pack"
+    echo "  Packed: ${SHARE}/icons/breeze/breeze-assets.pack"
+else
+    # Build the packer from source when a host compiler is available
+    if command -v cc >/dev/null 2>&1; then
+        PACKER="$(mktemp -t breeze-pack.XXXXXX)"
+        if cc -O2 -DBAP_BUILDER_MAIN \
+              -o "${PACKER}" "${SCRIPT_DIR}/breeze-asset-pack.cpp" -lz \
+              2>/dev/null; then
+            "${PACKER}" "${SHARE}/icons/breeze" \
+                "${SHARE}/icons/breeze/breeze-assets.pack"
+            echo "  Packed: ${SHARE}/icons/breeze/breeze-assets.pack"
+        else
+            echo "  Skipped (no working compiler); loose files remain"
+        fi
+        rm -f "${PACKER}"
+    else
+        echo "  Skipped (no breeze-pack tool); loose files remain"
+    fi
+fi
@@ -32,6 +32,7 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QRegularExpression>
 
 #include <string.h>
 #include <stdlib.h>
@@ -228,31 +229,195 @@ static void refreshDesktopCache()
            s_desktopEntries.size());
 }
 
+/* ========================================================================= */
+/* Application prefix trie                                                   */
+/* ========================================================================= */
+
+/*
+ * Matching used to rescore every desktop entry per keystroke.  A
+ * prefix trie over the lowercased words of Name/GenericName/Keywords
+ * (rebuilt with the desktop cache, i.e. on install events) narrows a
+ * query to the entries sharing its first word's prefix, and the
+ * incremental query model below refines the PREVIOUS keystroke's
+ * candidate set when the user merely typed more characters -- so a
+ * lengthening query never re-touches the trie at all.
+ */
+
+struct TrieNode {
+    int child[37];          /* a-z, 0-9, other; -1 = none */
+    QVector<int> entries;   /* desktop entry indices under this prefix */
+};
+
+static QVector<TrieNode> s_trie;
+
+static int trieCharIndex(QChar c)
+{
+    ushort u = c.toLower().unicode();
+
+    if (u >= 'a' && u <= 'z')
+        return u - 'a';
+    if (u >= '0' && u <= '9')
+        return 26 + (u - '0');
+    return 36;
+}
+
+static int trieChild(int node, int ci)
+{
+    if (s_trie[node].child[ci] < 0) {
+        TrieNode fresh;
+
+        memset(fresh.child, -1, sizeof(fresh.child));
+        s_trie.append(fresh);
+        s_trie[node].child[ci] = s_trie.size() - 1;
+    }
+    return s_trie[node].child[ci];
+}
+
+static void trieInsertWord(const QString &word, int entryIdx)
+{
+    int node = 0;
+    int depth = 0;
+
+    for (QChar c : word) {
+        if (depth++ >= 12)
+            break;
+        node = trieChild(node, trieCharIndex(c));
+        if (s_trie[node].entries.isEmpty() ||
+            s_trie[node].entries.last() != entryIdx)
+            s_trie[node].entries.append(entryIdx);
+    }
+}
+
+static void rebuildTrie()
+{
+    s_trie.clear();
+
+    TrieNode root;
+
+    memset(root.child, -1, sizeof(root.child));
+    s_trie.append(root);
+
+    for (int i = 0; i < s_desktopEntries.size(); ++i) {
+        const DesktopEntry &de = s_desktopEntries[i];
+        const QStringList words =
+            (de.name + QLatin1Char(' ') + de.genericName +
+             QLatin1Char(' ') + de.keywords)
+                .split(QRegularExpression(QStringLiteral("[^A-Za-z0-9]+")),
+                       Qt::SkipEmptyParts);
+
+        for (const QString &w : words)
+            trieInsertWord(w, i);
+    }
+}
+
+/* Entries under the query's first word, or nullptr for "all" */
+static const QVector<int> *trieCandidates(const QString &query)
+{
+    const QString word = query.section(QLatin1Char(' '), 0, 0);
+
+    if (word.isEmpty() || s_trie.isEmpty())
+        return nullptr;
+
+    int node = 0;
+    int depth = 0;
+
+    for (QChar c : word) {
+        if (depth++ >= 12)
+            break;
+        int next = s_trie[node].child[trieCharIndex(c)];
+
+        if (next < 0) {
+            static const QVector<int> empty;
+
+            return &empty;
+        }
+        node = next;
+    }
+    return &s_trie[node].entries;
+}
+
 /* ========================================================================= */
 /* Applications runner                                                       */
 /* ========================================================================= */
 
+/* Incremental query state: the previous keystroke's candidates */
+static QString s_lastQuery;
+static QVector<int> s_lastCandidates;
+
 static int runApplications(const QString &query, KRunnerMatch *out, int maxOut)
 {
+    bool wasDirty = s_desktopCacheDirty;
+
     refreshDesktopCache();
+    if (wasDirty) {
+        rebuildTrie();
+        s_lastQuery.clear();
+        s_lastCandidates.clear();
+    }
+
+    /* Candidate set: refine the previous keystroke's set when the
+     * query just grew, else consult the trie */
+    QVector<int> candidates;
+
+    if (!s_lastQuery.isEmpty() && query.startsWith(s_lastQuery)) {
+        candidates = s_lastCandidates;
+    } else {
+        const QVector<int> *trieSet = trieCandidates(query);
+
+        if (trieSet) {
+            /* Dedupe (a word can index an entry through several
+             * prefixes of different words) */
+            QVector<int> uniq = *trieSet;
+
+            std::sort(uniq.begin(), uniq.end());
+            uniq.erase(std::unique(uniq.begin(), uniq.end()),
+                       uniq.end());
+            candidates = uniq;
+        } else {
+            candidates.reserve(s_desktopEntries.size());
+            for (int i = 0; i < s_desktopEntries.size(); ++i)
+                candidates.append(i);
+        }
+    }
 
     struct ScoredEntry {
         int score;
         int index;
     };
     QVector<ScoredEntry> scored;
+    QVector<int> surviving;
+    bool narrowed = candidates.size() < s_desktopEntries.size();
 
-    for (int i = 0; i < s_desktopEntries.size(); ++i) {
-        const DesktopEntry &de = s_desktopEntries[i];
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int ci = 0; ci < candidates.size(); ++ci) {
+            const int i = candidates[ci];
+            const DesktopEntry &de = s_desktopEntries[i];
+
+            int best = scoreMatch(de.name, query);
+            best = qMax(best, scoreMatch(de.genericName, query));
+            best = qMax(best, scoreMatch(de.keywords, query));
 
-        int best = scoreMatch(de.name, query);
-        best = qMax(best, scoreMatch(de.genericName, query));
-        best = qMax(best, scoreMatch(de.keywords, query));
+            if (best > 0) {
+                scored.append({ best, i });
+                surviving.append(i);
+            }
+        }
 
-        if (best > 0)
-            scored.append({ best, i });
+        /* The trie only sees word prefixes; an empty narrowed result
+         * must retry against everything so substring and fuzzy
+         * matches stay reachable */
+        if (!scored.isEmpty() || !narrowed)
+            break;
+        narrowed = false;
+        candidates.clear();
+        for (int i = 0; i < s_desktopEntries.size(); ++i)
+            candidates.append(i);
     }
 
+    /* Remember the survivors for the next keystroke's refinement */
+    s_lastQuery = query;
+    s_lastCandidates = surviving;
+
     /* Sort by score descending */
     std::sort(scored.begin(), scored.end(),
               [](const ScoredEntry &a, const ScoredEntry &b) {
@@ -587,11 +752,80 @@ static int runFiles(const QString &query, KRunnerMatch *out, int maxOut)
 /* Command runner                                                            */
 /* ========================================================================= */
 
+/* Cached $PATH executable list (sorted; rebuilt on refresh events) */
+static QStringList s_pathBins;
+static bool s_pathBinsDirty = true;
+
+static void refreshPathBins()
+{
+    if (!s_pathBinsDirty)
+        return;
+
+    s_pathBins.clear();
+
+    const QString pathEnv = QString::fromLocal8Bit(qgetenv("PATH"));
+    const QStringList dirs = pathEnv.split(QLatin1Char(':'),
+                                           Qt::SkipEmptyParts);
+
+    for (const QString &dirPath : dirs) {
+        QDir dir(dirPath);
+
+        if (!dir.exists())
+            continue;
+        const QFileInfoList entries =
+            dir.entryInfoList(QDir::Files | QDir::Executable);
+
+        for (const QFileInfo &fi : entries)
+            s_pathBins.append(fi.fileName());
+    }
+
+    std::sort(s_pathBins.begin(), s_pathBins.end());
+    s_pathBins.erase(std::unique(s_pathBins.begin(), s_pathBins.end()),
+                     s_pathBins.end());
+    s_pathBinsDirty = false;
+    qDebug("KRunner/Commands: cached %d $PATH binaries",
+           s_pathBins.size());
+}
+
 static int runCommands(const QString &query, KRunnerMatch *out, int maxOut)
 {
     if (maxOut < 1)
         return 0;
 
+    /* Bare queries complete against the cached binary list: the
+     * sorted vector gives the prefix range with two binary searches */
+    if (!query.startsWith(QLatin1Char('>')) &&
+        !query.startsWith(QLatin1Char('/')) &&
+        query.length() >= 2 && !query.contains(QLatin1Char(' '))) {
+        refreshPathBins();
+
+        auto lo = std::lower_bound(s_pathBins.begin(), s_pathBins.end(),
+                                   query);
+        int count = 0;
+
+        for (auto it = lo;
+             it != s_pathBins.end() && it->startsWith(query) &&
+             count < qMin(maxOut, 3);
+             ++it) {
+            KRunnerMatch &m = out[count];
+
+            memset(&m, 0, sizeof(m));
+            setMatchString(m.text, sizeof(m.text),
+                           QStringLiteral("Run: %1").arg(*it));
+            setMatchString(m.subtext, sizeof(m.subtext),
+                           QStringLiteral("Command in $PATH"));
+            setMatchString(m.icon_name, sizeof(m.icon_name),
+                           QStringLiteral("system-run"));
+            m.relevance = it->compare(query, Qt::CaseInsensitive) == 0
+                              ? 85 : 60;
+            m.match_type = KRUNNER_HELPER_MATCH;
+            setMatchString(m.data, sizeof(m.data),
+                           QStringLiteral("cmd:%1").arg(*it));
+            count++;
+        }
+        return count;
+    }
+
     QString cmd;
     if (query.startsWith(QLatin1Char('>'))) {
         cmd = query.mid(1).trimmed();
@@ -865,6 +1099,7 @@ int krunner_init(void)
 
     KRunner::registerDBus();
     KRunner::s_desktopCacheDirty = true;
+    KRunner::s_pathBinsDirty = true;
     KRunner::s_initialized = true;
 
     qDebug("KRunner: initialized with %d runners", KRunner::MAX_RUNNERS);
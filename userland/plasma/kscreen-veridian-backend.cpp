@@ -319,17 +319,34 @@ void VeridianKScreenBackend::stopHotplugDetection()
 
 void VeridianKScreenBackend::onDrmEvent()
 {
-    /* Handle DRM events (page flips, hot-plug) */
+    /* Drain the DRM event (page flips, hot-plug) immediately... */
     drmEventContext ctx;
     memset(&ctx, 0, sizeof(ctx));
     ctx.version = 2;
     drmHandleEvent(m_drmFd, &ctx);
 
-    /* Re-scan outputs to detect hot-plug changes */
+    /* ...but coalesce the expensive recomputation: hotplug generates
+     * several events back-to-back, and one scan at the end of the
+     * storm serves them all */
+    if (!m_changeDebounce) {
+        m_changeDebounce = new QTimer(this);
+        m_changeDebounce->setSingleShot(true);
+        m_changeDebounce->setInterval(150);
+        connect(m_changeDebounce, &QTimer::timeout,
+                this, &VeridianKScreenBackend::processOutputChanges);
+    }
+    m_changeDebounce->start();   /* restart extends the quiet window */
+}
+
+void VeridianKScreenBackend::processOutputChanges()
+{
+    /* One re-scan for the whole event storm */
     QVector<VeridianOutputInfo> oldOutputs = m_outputs;
     scanOutputs();
 
-    /* Detect added/removed outputs */
+    /* Diff old vs new: connection edges plus mode/EDID changes */
+    QStringList changed;
+
     for (const auto &newOut : m_outputs) {
         bool found = false;
         for (const auto &oldOut : oldOutputs) {
@@ -340,15 +357,46 @@ void VeridianKScreenBackend::onDrmEvent()
                         Q_EMIT outputConnected(newOut.name);
                     else
                         Q_EMIT outputDisconnected(newOut.name);
+                    changed.append(newOut.name);
+                } else if (oldOut.connected &&
+                           (oldOut.modes.size() != newOut.modes.size() ||
+                            oldOut.currentResolution !=
+                                newOut.currentResolution ||
+                            oldOut.currentRefreshRate !=
+                                newOut.currentRefreshRate ||
+                            oldOut.model != newOut.model ||
+                            oldOut.serial != newOut.serial)) {
+                    changed.append(newOut.name);
                 }
                 break;
             }
         }
-        if (!found && newOut.connected)
+        if (!found && newOut.connected) {
             Q_EMIT outputConnected(newOut.name);
+            changed.append(newOut.name);
+        }
+    }
+    for (const auto &oldOut : oldOutputs) {
+        bool still = false;
+        for (const auto &newOut : m_outputs) {
+            if (newOut.connectorId == oldOut.connectorId) {
+                still = true;
+                break;
+            }
+        }
+        if (!still && oldOut.connected) {
+            Q_EMIT outputDisconnected(oldOut.name);
+            changed.append(oldOut.name);
+        }
     }
 
+    /* Publish the delta; the full config object only goes out when
+     * something actually changed */
+    if (changed.isEmpty())
+        return;
+
     updateKScreenConfig();
+    Q_EMIT outputsChanged(changed);
     Q_EMIT configChanged(m_config);
 }
 
@@ -536,6 +584,23 @@ bool VeridianKScreenBackend::parseEdid(uint32_t connectorId,
             if (blob && blob->length >= 128) {
                 const uint8_t *edid = static_cast<const uint8_t *>(blob->data);
 
+                /* Content-hashed parse cache: replugging the same
+                 * monitor (or a hotplug storm re-reading the blob)
+                 * skips the descriptor walk entirely */
+                quint64 hash = 1469598103934665603ULL;   /* FNV-1a */
+                for (uint32_t b = 0; b < blob->length; ++b)
+                    hash = (hash ^ edid[b]) * 1099511628211ULL;
+
+                auto cached = m_edidCache.constFind(hash);
+                if (cached != m_edidCache.constEnd()) {
+                    output.vendor = cached->vendor;
+                    output.model = cached->model;
+                    output.serial = cached->serial;
+                    drmModeFreePropertyBlob(blob);
+                    drmModeFreeProperty(prop);
+                    continue;
+                }
+
                 /* Manufacturer ID (bytes 8-9, PNP compressed ASCII) */
                 uint16_t mfg = (edid[8] << 8) | edid[9];
                 char m1 = static_cast<char>(((mfg >> 10) & 0x1F) + 'A' - 1);
@@ -578,6 +643,9 @@ bool VeridianKScreenBackend::parseEdid(uint32_t connectorId,
                     }
                 }
 
+                m_edidCache.insert(hash, { output.vendor, output.model,
+                                           output.serial });
+
                 drmModeFreePropertyBlob(blob);
             }
         }
@@ -33,6 +33,7 @@
 #include <QPoint>
 #include <QSocketNotifier>
 #include <QHash>
+#include <QTimer>
 
 /* KScreen API headers (from KDE Frameworks build tree) */
 #include <KScreen/BackendInterface>
@@ -157,12 +158,27 @@ Q_SIGNALS:
     void outputConnected(const QString &name);
     void outputDisconnected(const QString &name);
 
+    /** Per-output delta published instead of a full config object:
+     *  only the outputs whose state actually changed are named. */
+    void outputsChanged(const QStringList &changedOutputs);
+
 private Q_SLOTS:
     void onDrmEvent();
+    void processOutputChanges();
 
 private:
     /* ----- DRM operations ----- */
     bool openDrmDevice();
+
+    /* ----- Hotplug debounce + EDID cache ----- */
+    QTimer *m_changeDebounce = nullptr;
+
+    struct EdidInfo {
+        QString vendor;
+        QString model;
+        QString serial;
+    };
+    QHash<quint64, EdidInfo> m_edidCache;   /* content hash -> parse */
     void closeDrmDevice();
     bool scanOutputs();
     bool parseEdid(uint32_t connectorId, VeridianOutputInfo &output);
@@ -19,6 +19,30 @@
 #include <QDBusMessage>
 #include <QDBusArgument>
 
+#include <cstring>
+
+/* ========================================================================= */
+/* Batched-send hooks (userland/integration/dbus-optimize.h)                 */
+/* ========================================================================= */
+
+/* Consumed weakly, like the breeze cache hooks in plasma-memory-opt:
+ * the applet links and runs without the integration layer, falling
+ * back to plain async D-Bus calls. */
+extern "C" {
+struct dbus_opt_message {
+    const char *interface;
+    const char *method;
+    const char *body;
+    uint32_t body_len;
+};
+void dbus_opt_init(void) __attribute__((weak));
+void dbus_opt_enable_batching(uint32_t interval_ms) __attribute__((weak));
+int dbus_opt_send_batched(const char *dest,
+                          const struct dbus_opt_message *messages,
+                          uint32_t count) __attribute__((weak));
+void dbus_opt_shutdown(void) __attribute__((weak));
+}
+
 namespace PlasmaAudio {
 
 /* ========================================================================= */
@@ -28,6 +52,13 @@ namespace PlasmaAudio {
 /* PA_VOLUME_NORM = 0x10000 = 65536 */
 static constexpr uint32_t PA_VOL_NORM = 0x10000U;
 
+/* Display cadence: volume flushes ride a ~60 Hz frame window, the peak
+ * meter repaints at 30 Hz regardless of the audio-rate sample flow */
+static constexpr int VOLUME_FLUSH_MS = 16;
+static constexpr int PEAK_FRAME_MS = 33;
+
+static const char *PW_PORTAL_SERVICE = "org.freedesktop.impl.portal.PipeWire";
+
 uint32_t PlasmaAudioApplet::volumeToPA(int vol) {
     if (vol <= 0) return 0;
     if (vol >= 100) return PA_VOL_NORM;
@@ -53,9 +84,21 @@ PlasmaAudioApplet::PlasmaAudioApplet(QObject *parent)
     , m_currentSink(0)
     , m_dbusIface(nullptr)
     , m_pollTimer(nullptr)
+    , m_volumeFlushTimer(nullptr)
+    , m_volumePending(false)
+    , m_peakTimer(nullptr)
+    , m_pendingPeak(-1)
+    , m_peakLevel(0)
 {
     qDebug() << "[plasma-audio] Initialising audio applet";
 
+    /* Batched-send path: chatty traffic (slider drags) is accumulated
+     * in a short window instead of one wire message per tick */
+    if (dbus_opt_init && dbus_opt_enable_batching) {
+        dbus_opt_init();
+        dbus_opt_enable_batching(5);
+    }
+
     /* Connect to PipeWire's D-Bus portal interface */
     m_dbusIface = new QDBusInterface(
         QStringLiteral("org.freedesktop.impl.portal.PipeWire"),
@@ -86,6 +129,29 @@ PlasmaAudioApplet::PlasmaAudioApplet(QObject *parent)
     connect(m_pollTimer, &QTimer::timeout, this, &PlasmaAudioApplet::onPollTimer);
     m_pollTimer->start();
 
+    /* Coalescing timer: single-shot, re-armed by applyVolume() */
+    m_volumeFlushTimer = new QTimer(this);
+    m_volumeFlushTimer->setSingleShot(true);
+    m_volumeFlushTimer->setInterval(VOLUME_FLUSH_MS);
+    connect(m_volumeFlushTimer, &QTimer::timeout,
+            this, &PlasmaAudioApplet::flushPendingVolume);
+
+    /* Peak meter frame timer: runs only while the meter is live */
+    m_peakTimer = new QTimer(this);
+    m_peakTimer->setInterval(PEAK_FRAME_MS);
+    connect(m_peakTimer, &QTimer::timeout,
+            this, &PlasmaAudioApplet::onPeakFrame);
+
+    /* Peak samples arrive at audio rate; they are folded into a
+     * per-frame maximum rather than repainted per message */
+    QDBusConnection::sessionBus().connect(
+        QString::fromLatin1(PW_PORTAL_SERVICE),
+        QStringLiteral("/org/freedesktop/impl/portal/PipeWire"),
+        QString::fromLatin1(PW_PORTAL_SERVICE),
+        QStringLiteral("PeakChanged"),
+        this,
+        SLOT(onPeakSample(uint)));
+
     qDebug() << "[plasma-audio] Audio applet ready, default sink:"
              << defaultSink.description;
 }
@@ -94,6 +160,12 @@ PlasmaAudioApplet::~PlasmaAudioApplet() {
     if (m_pollTimer) {
         m_pollTimer->stop();
     }
+    if (m_volumePending) {
+        flushPendingVolume();
+    }
+    if (dbus_opt_shutdown) {
+        dbus_opt_shutdown();
+    }
     qDebug() << "[plasma-audio] Audio applet destroyed";
 }
 
@@ -234,20 +306,49 @@ void PlasmaAudioApplet::refreshSinks() {
 
 void PlasmaAudioApplet::applyVolume() {
     /*
-     * Send the current volume to PipeWire/ALSA.
-     *
-     * Path 1: D-Bus SetSinkVolume(sink_id, pa_volume, muted)
-     * Path 2: Direct AudioSetVolume syscall via the PulseAudio compat layer
-     *
-     * We try D-Bus first; if unavailable, fall back to a hypothetical
-     * direct call.  In a fully wired system the PA compat layer would
-     * handle this transparently.
+     * Coalesce: a slider drag calls this per mouse tick, but only the
+     * latest value matters.  Mark the state dirty and let the frame
+     * timer flush once per window; the intermediate values are never
+     * sent anywhere.
      */
+    m_volumePending = true;
+    if (!m_volumeFlushTimer->isActive()) {
+        m_volumeFlushTimer->start();
+    }
+}
+
+void PlasmaAudioApplet::flushPendingVolume() {
+    if (!m_volumePending) return;
+    m_volumePending = false;
+
     if (m_currentSink < 0 || m_currentSink >= m_sinks.size()) return;
 
     const SinkInfo &sink = m_sinks[m_currentSink];
     uint32_t paVol = m_muted ? 0 : volumeToPA(m_volume);
 
+    /*
+     * Preferred: the dbus_opt batched-send path.  The serialized body
+     * mirrors the SetSinkVolume(sink_id, pa_volume, muted) signature;
+     * bursts to the same destination leave as one wire message.
+     */
+    uint32_t body[3];
+    body[0] = sink.id;
+    body[1] = paVol;
+    body[2] = m_muted ? 1U : 0U;
+
+    struct dbus_opt_message msg;
+    msg.interface = PW_PORTAL_SERVICE;
+    msg.method = "SetSinkVolume";
+    msg.body = reinterpret_cast<const char *>(body);
+    msg.body_len = sizeof(body);
+
+    if (dbus_opt_send_batched &&
+        dbus_opt_send_batched(PW_PORTAL_SERVICE, &msg, 1) == 0) {
+        return;
+    }
+
+    /* Fallback: plain async D-Bus call (integration layer not linked
+     * or send failed) */
     if (m_dbusIface && m_dbusIface->isValid()) {
         m_dbusIface->asyncCall(
             QStringLiteral("SetSinkVolume"),
@@ -270,6 +371,40 @@ void PlasmaAudioApplet::applyVolume() {
     }
 }
 
+/* ========================================================================= */
+/* Peak meter                                                                */
+/* ========================================================================= */
+
+void PlasmaAudioApplet::onPeakSample(uint paLevel) {
+    /* Fold audio-rate samples into a per-frame maximum; the display
+     * timer decides when anything repaints */
+    int level = volumeFromPA(paLevel);
+    if (level > m_pendingPeak) {
+        m_pendingPeak = level;
+    }
+    if (!m_peakTimer->isActive()) {
+        m_peakTimer->start();
+    }
+}
+
+void PlasmaAudioApplet::onPeakFrame() {
+    /* Classic meter ballistics, integer only: jump up to a new peak,
+     * decay by a quarter per frame otherwise */
+    int decayed = (m_peakLevel * 3) / 4;
+    int next = (m_pendingPeak > decayed) ? m_pendingPeak : decayed;
+    m_pendingPeak = -1;
+
+    if (next != m_peakLevel) {
+        m_peakLevel = next;
+        Q_EMIT peakLevelChanged(m_peakLevel);
+    }
+
+    /* Meter idle at zero: stop ticking until the next sample */
+    if (m_peakLevel == 0) {
+        m_peakTimer->stop();
+    }
+}
+
 void PlasmaAudioApplet::onPollTimer() {
     /*
      * Periodic poll for external volume changes (e.g. another client
@@ -281,6 +416,10 @@ void PlasmaAudioApplet::onPollTimer() {
 
     if (!m_dbusIface || !m_dbusIface->isValid()) return;
 
+    /* A local change is still in flight: reading the daemon back now
+     * would revert the slider to the pre-drag value */
+    if (m_volumePending || m_volumeFlushTimer->isActive()) return;
+
     QDBusMessage reply = m_dbusIface->call(
         QStringLiteral("GetSinkVolume"),
         m_sinks[m_currentSink].id
@@ -98,8 +98,14 @@ Q_SIGNALS:
     void sinksChanged();
     void volumeOsd(int volume, bool muted);
 
+    /** Decimated peak-meter level (0-100), emitted at display rate. */
+    void peakLevelChanged(int level);
+
 private Q_SLOTS:
     void onPollTimer();
+    void onPeakSample(uint paLevel);
+    void onPeakFrame();
+    void flushPendingVolume();
 
 private:
     /** Map integer volume 0-100 to PA volume 0-65536. */
@@ -108,7 +114,7 @@ private:
     /** Map PA volume 0-65536 to integer 0-100. */
     static int volumeFromPA(uint32_t paVol);
 
-    /** Send volume change to PipeWire via the ALSA bridge. */
+    /** Queue the current volume for a coalesced send (latest wins). */
     void applyVolume();
 
     /* State */
@@ -122,6 +128,18 @@ private:
 
     /* Polling timer for sink state refresh */
     QTimer *m_pollTimer;
+
+    /* Volume-change coalescing: slider drags mark the state dirty and a
+     * single-shot frame timer flushes the latest value once per ~16ms
+     * through the dbus_opt batched-send path */
+    QTimer *m_volumeFlushTimer;
+    bool    m_volumePending;
+
+    /* Peak meter decimation: audio-rate samples accumulate a per-frame
+     * maximum; a 30 Hz timer emits the decayed display level */
+    QTimer *m_peakTimer;
+    int     m_pendingPeak;      /**< Max sample since last frame, -1 = none */
+    int     m_peakLevel;        /**< Displayed level 0-100 */
 };
 
 }  /* namespace PlasmaAudio */
@@ -45,7 +45,17 @@ PlasmaBluetoothApplet::PlasmaBluetoothApplet(QObject *parent)
     , m_connectedCount(0)
     , m_bluezInterface(nullptr)
     , m_pollTimer(new QTimer(this))
+    , m_updateTimer(new QTimer(this))
+    , m_devicesDirty(false)
+    , m_adapterDirty(false)
+    , m_lastRssiEmitMs(-100000)
 {
+    m_rssiClock.start();
+    m_updateTimer->setSingleShot(true);
+    m_updateTimer->setInterval(16);     /* One flush per frame */
+    connect(m_updateTimer, &QTimer::timeout,
+            this, &PlasmaBluetoothApplet::flushUiUpdate);
+
     /* Connect to BlueZ adapter D-Bus interface */
     m_bluezInterface = new QDBusInterface(
         QString::fromLatin1(BLUEZ_SERVICE),
@@ -67,6 +77,23 @@ PlasmaBluetoothApplet::PlasmaBluetoothApplet(QObject *parent)
         this,
         SLOT(onPropertiesChanged(QString, QVariantMap)));
 
+    /* Discovery floods InterfacesAdded/PropertiesChanged; both just
+     * mark the model dirty -- the frame timer does the one redraw */
+    QDBusConnection::systemBus().connect(
+        QString::fromLatin1(BLUEZ_SERVICE),
+        QString::fromLatin1(BLUEZ_OBJMGR_PATH),
+        QString::fromLatin1(BLUEZ_OBJMGR_IFACE),
+        QStringLiteral("InterfacesAdded"),
+        this,
+        SLOT(onInterfacesChanged()));
+    QDBusConnection::systemBus().connect(
+        QString::fromLatin1(BLUEZ_SERVICE),
+        QString::fromLatin1(BLUEZ_OBJMGR_PATH),
+        QString::fromLatin1(BLUEZ_OBJMGR_IFACE),
+        QStringLiteral("InterfacesRemoved"),
+        this,
+        SLOT(onInterfacesChanged()));
+
     connect(m_pollTimer, &QTimer::timeout,
             this, &PlasmaBluetoothApplet::pollBlueZState);
 
@@ -335,8 +362,8 @@ void PlasmaBluetoothApplet::onPropertiesChanged(const QString &interface,
             bool powered = changed.value(QStringLiteral("Powered")).toBool();
             if (m_powered != powered) {
                 m_powered = powered;
-                Q_EMIT adapterChanged(powered);
-                updateIcon();
+                m_adapterDirty = true;
+                scheduleUiUpdate();
             }
         }
         if (changed.contains(QStringLiteral("Discovering"))) {
@@ -349,6 +376,34 @@ void PlasmaBluetoothApplet::onPropertiesChanged(const QString &interface,
     }
 }
 
+/* Any device appearing or vanishing: one dirty mark, one redraw */
+void PlasmaBluetoothApplet::onInterfacesChanged()
+{
+    m_devicesDirty = true;
+    scheduleUiUpdate();
+}
+
+void PlasmaBluetoothApplet::scheduleUiUpdate()
+{
+    if (!m_updateTimer->isActive())
+        m_updateTimer->start();
+}
+
+/* The per-frame flush: every dirty flag set since the last frame
+ * collapses into at most one model requery and one signal each */
+void PlasmaBluetoothApplet::flushUiUpdate()
+{
+    if (m_adapterDirty) {
+        m_adapterDirty = false;
+        Q_EMIT adapterChanged(m_powered);
+        updateIcon();
+    }
+    if (m_devicesDirty) {
+        m_devicesDirty = false;
+        queryDevices();
+    }
+}
+
 /* ========================================================================= */
 /* D-Bus queries                                                             */
 /* ========================================================================= */
@@ -442,9 +497,40 @@ void PlasmaBluetoothApplet::queryDevices()
         return a.name < b.name;
     });
 
+    applyDeviceList(newList);
+}
+
+/*
+ * Structural changes (membership, names, pairing, connections)
+ * redraw the list; RSSI-only movement goes out on the decimated
+ * channel at most once a second.  operator== ignores rssi for
+ * exactly this split.
+ */
+void PlasmaBluetoothApplet::applyDeviceList(
+    const QVector<BtDeviceEntry> &newList)
+{
+    bool rssi_moved = false;
+
+    if (newList.size() == m_devices.size()) {
+        for (int i = 0; i < newList.size(); i++) {
+            if (newList[i].rssi != m_devices[i].rssi) {
+                rssi_moved = true;
+                break;
+            }
+        }
+    }
+
     if (newList != m_devices) {
         m_devices = newList;
         Q_EMIT deviceListChanged();
+    } else if (rssi_moved) {
+        m_devices = newList;
+
+        qint64 now = m_rssiClock.elapsed();
+        if (now - m_lastRssiEmitMs >= 1000) {
+            m_lastRssiEmitMs = now;
+            Q_EMIT rssiUpdated();
+        }
     }
 }
 
@@ -521,15 +607,16 @@ QString PlasmaBluetoothApplet::deviceTypeToIcon(int type,
 
 } /* namespace PlasmaBluetoothApplet */
 
-/* Equality operator for BtDeviceEntry (needed for QVector != comparison) */
+/* Structural equality for BtDeviceEntry: rssi is deliberately
+ * excluded so signal chatter never counts as a list change -- bar
+ * updates travel on the decimated rssiUpdated channel instead */
 bool operator==(const PlasmaBluetoothApplet::BtDeviceEntry &a,
                 const PlasmaBluetoothApplet::BtDeviceEntry &b)
 {
     return a.address == b.address
         && a.name == b.name
         && a.paired == b.paired
-        && a.connected == b.connected
-        && a.rssi == b.rssi;
+        && a.connected == b.connected;
 }
 
 bool operator!=(const PlasmaBluetoothApplet::BtDeviceEntry &a,
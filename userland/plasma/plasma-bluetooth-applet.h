@@ -17,6 +17,7 @@
 
 #include <QObject>
 #include <QString>
+#include <QElapsedTimer>
 #include <QTimer>
 #include <QDBusInterface>
 #include <QVector>
@@ -99,15 +100,25 @@ Q_SIGNALS:
     void deviceListChanged();
     void scanningChanged(bool scanning);
 
+    /*
+     * Signal-strength-only changes, decimated to one emission per
+     * second: bar redraws ride this, not deviceListChanged, so a
+     * scan's RSSI chatter can't drive per-event repaints.
+     */
+    void rssiUpdated();
+
 private Q_SLOTS:
     void pollBlueZState();
     void onPropertiesChanged(const QString &interface,
                               const QVariantMap &changed);
+    void onInterfacesChanged();
+    void flushUiUpdate();
 
 private:
     /* ----- D-Bus helpers ----- */
     void queryAdapter();
     void queryDevices();
+    void applyDeviceList(const QVector<BtDeviceEntry> &newList);
     void updateIcon();
     int rssiToBars(int rssi) const;
     QString deviceTypeToIcon(int type, uint32_t deviceClass) const;
@@ -123,6 +134,14 @@ private:
     /* ----- D-Bus ----- */
     QDBusInterface *m_bluezInterface;
     QTimer *m_pollTimer;
+
+    /* ----- Redraw coalescing ----- */
+    void scheduleUiUpdate();
+    QTimer *m_updateTimer;      /* Single-shot, one flush per frame */
+    bool m_devicesDirty;
+    bool m_adapterDirty;
+    QElapsedTimer m_rssiClock;
+    qint64 m_lastRssiEmitMs;
 };
 
 } /* namespace PlasmaBluetoothApplet */
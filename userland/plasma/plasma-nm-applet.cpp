@@ -72,6 +72,30 @@ PlasmaNetworkApplet::PlasmaNetworkApplet(QObject *parent)
         this,
         SLOT(onNMStateChanged(uint)));
 
+    /* Per-AP delta signals: patch the model in place instead of
+     * rebuilding the whole list on every scan tick */
+    QDBusConnection::systemBus().connect(
+        QString::fromLatin1(NM_SERVICE),
+        QString::fromLatin1(NM_PATH),
+        QString::fromLatin1(NM_IFACE),
+        QStringLiteral("AccessPointAdded"),
+        this,
+        SLOT(onAccessPointAdded(QVariantMap)));
+    QDBusConnection::systemBus().connect(
+        QString::fromLatin1(NM_SERVICE),
+        QString::fromLatin1(NM_PATH),
+        QString::fromLatin1(NM_IFACE),
+        QStringLiteral("AccessPointChanged"),
+        this,
+        SLOT(onAccessPointChanged(QVariantMap)));
+    QDBusConnection::systemBus().connect(
+        QString::fromLatin1(NM_SERVICE),
+        QString::fromLatin1(NM_PATH),
+        QString::fromLatin1(NM_IFACE),
+        QStringLiteral("AccessPointRemoved"),
+        this,
+        SLOT(onAccessPointRemoved(QString)));
+
     connect(m_pollTimer, &QTimer::timeout,
             this, &PlasmaNetworkApplet::pollNMState);
 
@@ -248,8 +272,28 @@ void PlasmaNetworkApplet::stopPolling()
 
 void PlasmaNetworkApplet::pollNMState()
 {
-    queryActiveConnections();
-    queryWifiAccessPoints();
+    /* Full resync: build the authoritative list, then patch the model
+     * entry by entry so views only relayout what actually moved */
+    QVector<ConnectionEntry> target = queryActiveConnections();
+    const QVector<ConnectionEntry> aps = queryWifiAccessPoints();
+
+    for (const ConnectionEntry &ap : aps) {
+        /* An AP matching the active connection updates its strength
+         * instead of appearing twice */
+        bool merged = false;
+        for (ConnectionEntry &existing : target) {
+            if (existing.isActive && existing.name == ap.name) {
+                existing.signalStrength = ap.signalStrength;
+                m_activeSignalStrength = ap.signalStrength;
+                merged = true;
+                break;
+            }
+        }
+        if (!merged)
+            target.append(ap);
+    }
+
+    applyModelPatch(target);
     updateIcon();
 }
 
@@ -284,7 +328,7 @@ void PlasmaNetworkApplet::queryDevices()
     }
 }
 
-void PlasmaNetworkApplet::queryActiveConnections()
+QVector<ConnectionEntry> PlasmaNetworkApplet::queryActiveConnections()
 {
     /* Query active connections from NM */
     QDBusMessage msg = QDBusMessage::createMethodCall(
@@ -295,7 +339,6 @@ void PlasmaNetworkApplet::queryActiveConnections()
 
     QDBusMessage reply = QDBusConnection::systemBus().call(msg);
 
-    /* Build connection list from active connections */
     QVector<ConnectionEntry> newList;
 
     /* Parse reply arguments into ConnectionEntry structures.
@@ -312,6 +355,7 @@ void PlasmaNetworkApplet::queryActiveConnections()
         for (const QVariant &arg : args) {
             ConnectionEntry entry;
             entry.name = arg.toString();
+            entry.id = entry.name;
             entry.isActive = true;
             entry.isWifi = false;
             entry.isVpn = false;
@@ -329,32 +373,15 @@ void PlasmaNetworkApplet::queryActiveConnections()
         m_activeSignalStrength = -1;
     }
 
-    /* Merge with existing Wi-Fi entries (non-active) */
-    for (const ConnectionEntry &existing : m_connections) {
-        if (!existing.isActive && existing.isWifi) {
-            /* Check if already in new list */
-            bool found = false;
-            for (const ConnectionEntry &ne : newList) {
-                if (ne.name == existing.name) {
-                    found = true;
-                    break;
-                }
-            }
-            if (!found)
-                newList.append(existing);
-        }
-    }
-
-    if (newList != m_connections) {
-        m_connections = newList;
-        Q_EMIT connectionListChanged();
-    }
+    return newList;
 }
 
-void PlasmaNetworkApplet::queryWifiAccessPoints()
+QVector<ConnectionEntry> PlasmaNetworkApplet::queryWifiAccessPoints()
 {
+    QVector<ConnectionEntry> aps;
+
     if (!m_wifiEnabled)
-        return;
+        return aps;
 
     /* Query Wi-Fi scan results from NM */
     QDBusMessage msg = QDBusMessage::createMethodCall(
@@ -365,41 +392,155 @@ void PlasmaNetworkApplet::queryWifiAccessPoints()
 
     QDBusMessage reply = QDBusConnection::systemBus().call(msg);
     if (reply.type() == QDBusMessage::ErrorMessage)
-        return;
+        return aps;
+
+    /* Parse AP entries as non-active Wi-Fi entries.  Each AP carries a
+     * stable id (BSSID) used to key model patches. */
+    const QList<QVariant> args = reply.arguments();
+    for (const QVariant &arg : args) {
+        ConnectionEntry entry = entryFromAccessPoint(arg.toMap());
+        if (!entry.name.isEmpty())
+            aps.append(entry);
+    }
 
-    /* Parse AP entries and add to connection list as non-active Wi-Fi entries.
-     * In the full implementation, each AP has ssid, bssid, signal, security. */
-    if (!reply.arguments().isEmpty()) {
-        QList<QVariant> args = reply.arguments();
-        for (const QVariant &arg : args) {
-            QVariantMap ap = arg.toMap();
+    return aps;
+}
 
-            ConnectionEntry entry;
-            entry.name = ap.value(QStringLiteral("ssid")).toString();
-            entry.uuid.clear();  /* no UUID for unconnected APs */
-            entry.isActive = false;
-            entry.isWifi = true;
-            entry.isVpn = false;
-            entry.signalStrength = ap.value(QStringLiteral("signal"), -1).toInt();
-            entry.hasPassword = (ap.value(QStringLiteral("security"), 0).toUInt() != 0);
+ConnectionEntry PlasmaNetworkApplet::entryFromAccessPoint(
+    const QVariantMap &ap) const
+{
+    ConnectionEntry entry;
+    entry.name = ap.value(QStringLiteral("ssid")).toString();
+    entry.id = ap.value(QStringLiteral("id"),
+                        ap.value(QStringLiteral("bssid"))).toString();
+    if (entry.id.isEmpty())
+        entry.id = entry.name;
+    entry.uuid.clear();  /* no UUID for unconnected APs */
+    entry.isActive = false;
+    entry.isWifi = true;
+    entry.isVpn = false;
+    entry.signalStrength = ap.value(QStringLiteral("signal"), -1).toInt();
+    entry.hasPassword = (ap.value(QStringLiteral("security"), 0).toUInt() != 0);
+    return entry;
+}
 
-            if (!entry.name.isEmpty()) {
-                /* Check if already active */
-                bool already = false;
-                for (const ConnectionEntry &existing : m_connections) {
-                    if (existing.name == entry.name && existing.isActive) {
-                        already = true;
-                        /* Update signal strength for active connection */
-                        m_activeSignalStrength = entry.signalStrength;
-                        break;
-                    }
-                }
-                if (!already) {
-                    m_connections.append(entry);
-                }
+int PlasmaNetworkApplet::indexOfConnection(const QString &id) const
+{
+    for (int i = 0; i < m_connections.size(); ++i) {
+        if (m_connections[i].id == id)
+            return i;
+    }
+    return -1;
+}
+
+/*
+ * Patch m_connections toward the target list, emitting one granular
+ * signal per row that changed.  connectionListChanged() still fires
+ * once when membership changed, for listeners that track only the
+ * overall shape.
+ */
+void PlasmaNetworkApplet::applyModelPatch(const QVector<ConnectionEntry> &target)
+{
+    bool structural = false;
+
+    for (const ConnectionEntry &t : target) {
+        int idx = indexOfConnection(t.id);
+        if (idx < 0) {
+            m_connections.append(t);
+            Q_EMIT connectionAdded(m_connections.size() - 1);
+            structural = true;
+        } else if (m_connections[idx] != t) {
+            m_connections[idx] = t;
+            Q_EMIT connectionChanged(idx);
+        }
+    }
+
+    for (int i = m_connections.size() - 1; i >= 0; --i) {
+        bool present = false;
+        for (const ConnectionEntry &t : target) {
+            if (t.id == m_connections[i].id) {
+                present = true;
+                break;
             }
         }
+        if (!present) {
+            m_connections.removeAt(i);
+            Q_EMIT connectionRemoved(i);
+            structural = true;
+        }
+    }
+
+    if (structural)
+        Q_EMIT connectionListChanged();
+}
+
+/* ========================================================================= */
+/* NM delta signals                                                          */
+/* ========================================================================= */
+
+void PlasmaNetworkApplet::onAccessPointAdded(const QVariantMap &ap)
+{
+    ConnectionEntry entry = entryFromAccessPoint(ap);
+    if (entry.name.isEmpty())
+        return;
+
+    /* The active connection's AP updates its strength in place */
+    if (m_connected && entry.name == m_activeConnectionName) {
+        onAccessPointChanged(ap);
+        return;
+    }
+
+    int idx = indexOfConnection(entry.id);
+    if (idx >= 0) {
+        if (m_connections[idx] != entry) {
+            m_connections[idx] = entry;
+            Q_EMIT connectionChanged(idx);
+        }
+        return;
+    }
+
+    m_connections.append(entry);
+    Q_EMIT connectionAdded(m_connections.size() - 1);
+    Q_EMIT connectionListChanged();
+}
+
+void PlasmaNetworkApplet::onAccessPointChanged(const QVariantMap &ap)
+{
+    ConnectionEntry entry = entryFromAccessPoint(ap);
+
+    if (m_connected && entry.name == m_activeConnectionName &&
+        entry.signalStrength != m_activeSignalStrength) {
+        m_activeSignalStrength = entry.signalStrength;
+        Q_EMIT signalStrengthChanged(m_activeSignalStrength);
+        updateIcon();
     }
+
+    int idx = indexOfConnection(entry.id);
+    if (idx < 0) {
+        /* Active APs are tracked under the active entry's id */
+        idx = indexOfConnection(entry.name);
+        if (idx < 0)
+            return;
+        m_connections[idx].signalStrength = entry.signalStrength;
+        Q_EMIT connectionChanged(idx);
+        return;
+    }
+
+    if (m_connections[idx] != entry) {
+        m_connections[idx] = entry;
+        Q_EMIT connectionChanged(idx);
+    }
+}
+
+void PlasmaNetworkApplet::onAccessPointRemoved(const QString &id)
+{
+    int idx = indexOfConnection(id);
+    if (idx < 0)
+        return;
+
+    m_connections.removeAt(idx);
+    Q_EMIT connectionRemoved(idx);
+    Q_EMIT connectionListChanged();
 }
 
 void PlasmaNetworkApplet::updateIcon()
@@ -448,7 +589,8 @@ void PlasmaNetworkApplet::updateIcon()
 bool operator==(const PlasmaNetworkApplet::ConnectionEntry &a,
                 const PlasmaNetworkApplet::ConnectionEntry &b)
 {
-    return a.name == b.name
+    return a.id == b.id
+        && a.name == b.name
         && a.uuid == b.uuid
         && a.isActive == b.isActive
         && a.isWifi == b.isWifi
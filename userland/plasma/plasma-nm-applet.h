@@ -19,6 +19,7 @@
 #include <QObject>
 #include <QString>
 #include <QTimer>
+#include <QVariantMap>
 #include <QDBusInterface>
 #include <QVector>
 
@@ -30,6 +31,7 @@ namespace PlasmaNetworkApplet {
 
 struct ConnectionEntry
 {
+    QString id;                 /* stable key: BSSID for APs, UUID for profiles */
     QString name;               /* SSID or connection profile name */
     QString uuid;               /* NM connection UUID */
     QString device;             /* interface name */
@@ -92,18 +94,30 @@ public:
 Q_SIGNALS:
     void connectivityChanged(bool connected);
     void connectionListChanged();
+
+    /** Granular model deltas: views patch a single row instead of
+     *  relaying out the whole list. */
+    void connectionAdded(int index);
+    void connectionChanged(int index);
+    void connectionRemoved(int index);
     void wifiEnabledChanged(bool enabled);
     void signalStrengthChanged(int percent);
 
 private Q_SLOTS:
     void pollNMState();
     void onNMStateChanged(uint state);
+    void onAccessPointAdded(const QVariantMap &ap);
+    void onAccessPointChanged(const QVariantMap &ap);
+    void onAccessPointRemoved(const QString &id);
 
 private:
     /* ----- D-Bus helpers ----- */
     void queryDevices();
-    void queryActiveConnections();
-    void queryWifiAccessPoints();
+    QVector<ConnectionEntry> queryActiveConnections();
+    QVector<ConnectionEntry> queryWifiAccessPoints();
+    void applyModelPatch(const QVector<ConnectionEntry> &target);
+    ConnectionEntry entryFromAccessPoint(const QVariantMap &ap) const;
+    int indexOfConnection(const QString &id) const;
     void updateIcon();
 
     /* ----- State ----- */
@@ -18,6 +18,11 @@
 #include <QDir>
 #include <QCryptographicHash>
 #include <QPainter>
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include <QThread>
+#include <QDir>
 #include <QPainterPath>
 #include <QDBusConnection>
 #include <QDBusMessage>
@@ -250,6 +255,8 @@ void VeridianLockSurface::setUserInfo(const QString &userName,
 
     if (!avatarPath.isEmpty())
         m_avatarImage = QImage(avatarPath);
+
+    m_staticLayer = QImage();   /* user info lives in the static layer */
 }
 
 void VeridianLockSurface::setPasswordText(const QString &masked)
@@ -272,45 +279,235 @@ void VeridianLockSurface::resize(int width, int height)
 {
     m_width = width;
     m_height = height;
+    m_staticLayer = QImage();
+    m_frame = QImage();
     Q_EMIT needsRedraw();
 }
 
 void VeridianLockSurface::render()
 {
-    QImage image(m_width, m_height, QImage::Format_ARGB32_Premultiplied);
+    ensureStaticLayer();
+
+    QVector<QRect> damage;
+
+    if (m_frame.size() != QSize(m_width, m_height)) {
+        /* First frame (or fresh size): seed from the static composite
+         * and paint every dynamic element */
+        m_frame = m_staticLayer.copy();
+        paintClock(m_frame);
+        paintPasswordText(m_frame);
+        paintStatusMessage(m_frame);
+        damage.append(QRect(0, 0, m_width, m_height));
+        submitBuffer(m_frame, damage);
+        return;
+    }
+
+    /* Incremental frame: restore and repaint only the dynamic regions
+     * whose content changed since the last submit */
+    QDateTime now = QDateTime::currentDateTime();
+    QString timeStr = now.toString(m_config.clockFormat);
+    QString dateStr = now.toString(m_config.dateFormat);
+
+    if (m_config.showClock &&
+        (timeStr != m_lastTimeStr || dateStr != m_lastDateStr)) {
+        restoreStatic(clockRegion());
+        paintClock(m_frame);
+        damage.append(clockRegion());
+    }
+
+    if (!m_lastPasswordValid || m_passwordMasked != m_lastPasswordMasked) {
+        restoreStatic(passwordTextRegion());
+        paintPasswordText(m_frame);
+        damage.append(passwordTextRegion());
+    }
+
+    if (m_statusMessage != m_lastStatusMessage ||
+        m_statusIsError != m_lastStatusIsError) {
+        restoreStatic(statusRegion());
+        paintStatusMessage(m_frame);
+        damage.append(statusRegion());
+    }
+
+    /* A 1 Hz clock tick with an HH:mm format usually changes nothing:
+     * skip the buffer submit entirely */
+    if (damage.isEmpty())
+        return;
+
+    submitBuffer(m_frame, damage);
+}
+
+/*
+ * Composite the layers that never change while the lock screen is up
+ * (wallpaper + dark overlay, avatar, user name, password field chrome)
+ * once per size/user change.  Animated frames blit from this cache
+ * instead of redrawing it.
+ */
+void VeridianLockSurface::ensureStaticLayer()
+{
+    if (m_staticLayer.size() == QSize(m_width, m_height))
+        return;
+
+    m_staticLayer = QImage(m_width, m_height,
+                           QImage::Format_ARGB32_Premultiplied);
+    paintBackground(m_staticLayer);
+    paintUserInfo(m_staticLayer);
+    paintFieldChrome(m_staticLayer);
+    m_frame = QImage();     /* force a full seed on the next render */
+}
 
-    paintBackground(image);
-    paintClock(image);
-    paintUserInfo(image);
-    paintPasswordField(image);
-    paintStatusMessage(image);
+/* Blit a region of the static composite back into the frame, erasing
+ * the previous dynamic content there */
+void VeridianLockSurface::restoreStatic(const QRect &rect)
+{
+    QPainter painter(&m_frame);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.drawImage(rect, m_staticLayer, rect);
+}
 
-    submitBuffer(image);
+QRect VeridianLockSurface::clockRegion() const
+{
+    /* Covers the time rect and the date rect below it (see paintClock),
+     * padded a pixel each way against qreal-to-int truncation */
+    int top = static_cast<int>(m_height * 0.15) - 1;
+    int bottom = static_cast<int>(m_height * 0.30) + 8 + 40 + 2;
+    return QRect(0, top, m_width, bottom - top);
+}
+
+QRect VeridianLockSurface::passwordTextRegion() const
+{
+    int fieldX = (m_width - m_config.inputFieldWidth) / 2;
+    int fieldY = static_cast<int>(m_height * 0.55);
+    /* Inset past the 1.5px border so text repaints never clip chrome */
+    return QRect(fieldX + 4, fieldY + 4,
+                 m_config.inputFieldWidth - 8,
+                 m_config.inputFieldHeight - 8);
+}
+
+QRect VeridianLockSurface::statusRegion() const
+{
+    int msgY = static_cast<int>(m_height * 0.55) + m_config.inputFieldHeight + 16;
+    return QRect(0, msgY, m_width, 30);
+}
+
+/*
+ * The wallpaper never decodes on the lock path: the first lock at a
+ * given output size decodes and scales on a worker thread (the
+ * screen locks instantly over the solid color and the wallpaper
+ * appears when ready), writes the scaled ARGB result to a disk
+ * cache keyed on file identity + output size, and every later lock
+ * blits that cache -- a read and a memcpy, no JPEG work at all.
+ */
+
+QString VeridianLockSurface::wallpaperCachePath() const
+{
+    QFileInfo fi(m_config.wallpaperPath);
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    hash.addData(m_config.wallpaperPath.toUtf8());
+    hash.addData(QByteArray::number(fi.size()));
+    hash.addData(QByteArray::number(fi.lastModified().toSecsSinceEpoch()));
+    return QStringLiteral("/var/cache/veridian/wallpaper-%1-%2x%3.raw")
+        .arg(QString::fromLatin1(hash.result().toHex().left(16)))
+        .arg(m_width)
+        .arg(m_height);
+}
+
+/* Raw cache: 16-byte header (magic 'VWPC', w, h, format), pixels */
+bool VeridianLockSurface::loadScaledCache(const QString &path)
+{
+    QFile f(path);
+
+    if (!f.open(QIODevice::ReadOnly))
+        return false;
+
+    quint32 hdr[4];
+    if (f.read(reinterpret_cast<char *>(hdr), sizeof(hdr)) !=
+            (qint64)sizeof(hdr) ||
+        hdr[0] != 0x43505756u || (int)hdr[1] != m_width ||
+        (int)hdr[2] != m_height)
+        return false;
+
+    QImage img(m_width, m_height, QImage::Format_ARGB32);
+    qint64 want = (qint64)img.sizeInBytes();
+
+    if (f.read(reinterpret_cast<char *>(img.bits()), want) != want)
+        return false;
+    m_wallpaperImage = img;
+    return true;
+}
+
+void VeridianLockSurface::loadWallpaperAsync()
+{
+    if (m_wallpaperLoading || m_config.wallpaperPath.isEmpty())
+        return;
+
+    const QString cachePath = wallpaperCachePath();
+
+    if (loadScaledCache(cachePath))
+        return;                 /* Warm: no decode at all */
+
+    m_wallpaperLoading = true;
+
+    const QString srcPath = m_config.wallpaperPath;
+    const int w = m_width, h = m_height;
+    QThread *worker = QThread::create([this, srcPath, cachePath, w, h]() {
+        QImage full(srcPath);
+
+        if (full.isNull())
+            return;
+
+        QImage scaled = full.scaled(w, h,
+                                    Qt::KeepAspectRatioByExpanding,
+                                    Qt::SmoothTransformation);
+        /* Center-crop to exactly the output size */
+        int xOff = (scaled.width() - w) / 2;
+        int yOff = (scaled.height() - h) / 2;
+        QImage cropped =
+            scaled.copy(xOff, yOff, w, h)
+                .convertToFormat(QImage::Format_ARGB32);
+
+        QDir().mkpath(QStringLiteral("/var/cache/veridian"));
+        QFile f(cachePath + QStringLiteral(".tmp"));
+        if (f.open(QIODevice::WriteOnly)) {
+            quint32 hdr[4] = { 0x43505756u, (quint32)w, (quint32)h, 0 };
+
+            f.write(reinterpret_cast<const char *>(hdr), sizeof(hdr));
+            f.write(reinterpret_cast<const char *>(cropped.constBits()),
+                    cropped.sizeInBytes());
+            f.close();
+            QFile::rename(f.fileName(), cachePath);
+        }
+
+        /* Hand the image to the UI thread and repaint the static
+         * layer once */
+        QMetaObject::invokeMethod(this, [this, cropped]() {
+            m_wallpaperImage = cropped;
+            m_wallpaperLoading = false;
+            /* Invalidate the static layer; the next frame rebuilds
+             * it with the wallpaper and submits a full redraw */
+            m_staticLayer = QImage();
+        }, Qt::QueuedConnection);
+    });
+    connect(worker, &QThread::finished, worker, &QObject::deleteLater);
+    worker->start();
 }
 
 void VeridianLockSurface::paintBackground(QImage &image)
 {
-    /* Try wallpaper image first, then solid color */
+    /* Pre-scaled wallpaper, else solid color while it loads */
     if (!m_wallpaperImage.isNull()) {
         QPainter painter(&image);
-        QImage scaled = m_wallpaperImage.scaled(m_width, m_height,
-                                                 Qt::KeepAspectRatioByExpanding,
-                                                 Qt::SmoothTransformation);
-        int xOffset = (scaled.width() - m_width) / 2;
-        int yOffset = (scaled.height() - m_height) / 2;
-        painter.drawImage(-xOffset, -yOffset, scaled);
+
+        /* Already exactly output-sized: pure blit, no per-frame
+         * scaling */
+        painter.drawImage(0, 0, m_wallpaperImage);
 
         /* Semi-transparent dark overlay for readability */
         painter.fillRect(image.rect(), QColor(0, 0, 0, 128));
-    } else if (!m_config.wallpaperPath.isEmpty() && m_wallpaperImage.isNull()) {
-        m_wallpaperImage = QImage(m_config.wallpaperPath);
-        if (!m_wallpaperImage.isNull()) {
-            paintBackground(image);
-            return;
-        }
-        image.fill(m_config.backgroundColor);
     } else {
         image.fill(m_config.backgroundColor);
+        if (!m_config.wallpaperPath.isEmpty())
+            loadWallpaperAsync();
     }
 }
 
@@ -340,6 +537,9 @@ void VeridianLockSurface::paintClock(QImage &image)
         QRectF dateRect(0, clockRect.bottom() + 8, m_width, 40);
         painter.drawText(dateRect, Qt::AlignHCenter | Qt::AlignTop, dateStr);
     }
+
+    m_lastTimeStr = timeStr;
+    m_lastDateStr = dateStr;
 }
 
 void VeridianLockSurface::paintUserInfo(QImage &image)
@@ -378,11 +578,10 @@ void VeridianLockSurface::paintUserInfo(QImage &image)
     }
 }
 
-void VeridianLockSurface::paintPasswordField(QImage &image)
+void VeridianLockSurface::paintFieldChrome(QImage &image)
 {
     QPainter painter(&image);
     painter.setRenderHint(QPainter::Antialiasing, true);
-    painter.setRenderHint(QPainter::TextAntialiasing, true);
 
     int fieldW = m_config.inputFieldWidth;
     int fieldH = m_config.inputFieldHeight;
@@ -396,6 +595,19 @@ void VeridianLockSurface::paintPasswordField(QImage &image)
     painter.setBrush(m_config.inputFieldBackground);
     painter.drawRoundedRect(fieldRect, m_config.inputFieldRadius,
                              m_config.inputFieldRadius);
+}
+
+void VeridianLockSurface::paintPasswordText(QImage &image)
+{
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::TextAntialiasing, true);
+
+    int fieldW = m_config.inputFieldWidth;
+    int fieldH = m_config.inputFieldHeight;
+    int fieldX = (m_width - fieldW) / 2;
+    int fieldY = static_cast<int>(m_height * 0.55);
+
+    QRectF fieldRect(fieldX, fieldY, fieldW, fieldH);
 
     /* Password text or placeholder */
     painter.setFont(m_config.passwordFont);
@@ -410,10 +622,16 @@ void VeridianLockSurface::paintPasswordField(QImage &image)
         painter.drawText(textRect, Qt::AlignVCenter | Qt::AlignLeft,
                          m_passwordMasked);
     }
+
+    m_lastPasswordMasked = m_passwordMasked;
+    m_lastPasswordValid = true;
 }
 
 void VeridianLockSurface::paintStatusMessage(QImage &image)
 {
+    m_lastStatusMessage = m_statusMessage;
+    m_lastStatusIsError = m_statusIsError;
+
     if (m_statusMessage.isEmpty())
         return;
 
@@ -428,18 +646,22 @@ void VeridianLockSurface::paintStatusMessage(QImage &image)
     painter.drawText(msgRect, Qt::AlignHCenter | Qt::AlignTop, m_statusMessage);
 }
 
-void VeridianLockSurface::submitBuffer(const QImage &image)
+void VeridianLockSurface::submitBuffer(const QImage &image,
+                                        const QVector<QRect> &damage)
 {
     /* In a full implementation, this would:
      * 1. Create a wl_shm_pool from a shared memory fd
      * 2. Create a wl_buffer from the pool
-     * 3. Copy the QImage data into the shared memory
+     * 3. Copy only the damaged rows of the QImage into the shared memory
      * 4. wl_surface_attach(m_wlSurface, buffer, 0, 0)
-     * 5. wl_surface_damage_buffer(m_wlSurface, 0, 0, m_width, m_height)
+     * 5. wl_surface_damage_buffer(m_wlSurface, r.x(), r.y(),
+     *        r.width(), r.height()) for each rect in damage, letting the
+     *    compositor skip recompositing the untouched static layers
      * 6. wl_surface_commit(m_wlSurface)
      *
      * The VeridianOS Wayland shim (Sprint 9.1) provides these interfaces. */
     Q_UNUSED(image);
+    Q_UNUSED(damage);
 }
 
 /* ========================================================================= */
@@ -200,12 +200,20 @@ Q_SIGNALS:
     void needsRedraw();
 
 private:
+    void ensureStaticLayer();
     void paintBackground(QImage &image);
     void paintClock(QImage &image);
     void paintUserInfo(QImage &image);
-    void paintPasswordField(QImage &image);
+    void paintFieldChrome(QImage &image);
+    void paintPasswordText(QImage &image);
     void paintStatusMessage(QImage &image);
-    void submitBuffer(const QImage &image);
+    void restoreStatic(const QRect &rect);
+    void submitBuffer(const QImage &image, const QVector<QRect> &damage);
+
+    /* Damage regions of the per-frame dynamic elements */
+    QRect clockRegion() const;
+    QRect passwordTextRegion() const;
+    QRect statusRegion() const;
 
     struct wl_surface *m_wlSurface;
     struct ext_session_lock_surface_v1 *m_lockSurface;
@@ -220,7 +228,26 @@ private:
     QString m_passwordMasked;
     QString m_statusMessage;
     bool m_statusIsError;
-    QImage m_wallpaperImage;
+    QImage m_wallpaperImage;     /* Pre-scaled to output size */
+
+    /* Async wallpaper pipeline (see wallpaperCachePath) */
+    void loadWallpaperAsync();
+    QString wallpaperCachePath() const;
+    bool loadScaledCache(const QString &path);
+    bool m_wallpaperLoading = false;
+
+    /* Precomposited static layers (wallpaper, overlay, user info, field
+     * chrome) and the persistent frame they seed.  Per-frame work is
+     * limited to restoring and repainting the dynamic regions that
+     * actually changed. */
+    QImage m_staticLayer;
+    QImage m_frame;
+    QString m_lastTimeStr;
+    QString m_lastDateStr;
+    QString m_lastPasswordMasked;
+    bool m_lastPasswordValid = false;
+    QString m_lastStatusMessage;
+    bool m_lastStatusIsError = false;
 };
 
 /* ========================================================================= */
@@ -13,6 +13,12 @@
 
 #include "powerdevil-veridian-backend.h"
 
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+
 #include <QDebug>
 #include <QDir>
 #include <QFile>
@@ -20,8 +26,6 @@
 #include <QDBusConnection>
 #include <QTextStream>
 
-#include <unistd.h>
-
 namespace PowerDevil {
 
 /* ========================================================================= */
@@ -55,6 +59,12 @@ VeridianPowerBackend::VeridianPowerBackend(QObject *parent)
 VeridianPowerBackend::~VeridianPowerBackend()
 {
     stopPolling();
+    for (const auto &sfd : m_sensorFds) {
+        if (sfd.fd >= 0)
+            ::close(sfd.fd);
+    }
+    if (m_ueventFd >= 0)
+        ::close(m_ueventFd);
     delete m_upowerInterface;
 }
 
@@ -390,38 +400,232 @@ VeridianPowerBackend::availableProfiles() const
 
 void VeridianPowerBackend::startPolling(int intervalMs)
 {
+    m_basePollMs = intervalMs;
+    m_currentPollMs = intervalMs;
+    m_stableCycles = 0;
     m_pollTimer->start(intervalMs);
-    qDebug("PowerDevil/Veridian: polling started (%d ms)", intervalMs);
+
+    /* Push channel: when the kernel exposes power-supply change
+     * notifications through inotify, a modified attribute triggers an
+     * immediate poll and resets the adaptive backoff, so the slow
+     * steady-state interval never delays a plug/unplug reaction */
+    if (m_ueventNotifier) {
+        m_ueventNotifier->setEnabled(true);
+    } else if (m_ueventFd < 0) {
+        m_ueventFd = inotify_init1(IN_NONBLOCK);
+        if (m_ueventFd >= 0) {
+            bool watching =
+                inotify_add_watch(m_ueventFd,
+                                  "/sys/class/power_supply",
+                                  IN_MODIFY | IN_CREATE | IN_DELETE) >= 0;
+            if (watching) {
+                m_ueventNotifier = new QSocketNotifier(
+                    m_ueventFd, QSocketNotifier::Read, this);
+                connect(m_ueventNotifier, &QSocketNotifier::activated,
+                        this, [this]() {
+                            char buf[1024];
+                            while (read(m_ueventFd, buf, sizeof(buf)) > 0)
+                                ;
+                            /* Supplies may have come or gone: cached
+                             * fds can point at stale nodes */
+                            for (const auto &sfd : m_sensorFds) {
+                                if (sfd.fd >= 0)
+                                    ::close(sfd.fd);
+                            }
+                            m_sensorFds.clear();
+                            m_currentPollMs = m_basePollMs;
+                            m_stableCycles = 0;
+                            m_pollTimer->start(m_basePollMs);
+                            pollBatteryStatus();
+                        });
+                qDebug("PowerDevil/Veridian: push notifications active");
+            } else {
+                close(m_ueventFd);
+                m_ueventFd = -1;
+            }
+        }
+    }
+
+    qDebug("PowerDevil/Veridian: polling started (%d ms, adaptive)",
+           intervalMs);
 }
 
 void VeridianPowerBackend::stopPolling()
 {
     m_pollTimer->stop();
+    /* Silence the push channel too, or an inotify event would restart
+     * the poll timer behind the caller's back */
+    if (m_ueventNotifier)
+        m_ueventNotifier->setEnabled(false);
+}
+
+/* ========================================================================= */
+/* Batched sensor reads                                                      */
+/* ========================================================================= */
+
+/* Persistent fd per attribute: steady-state polling costs a read, not
+ * an open/read/close triple */
+int VeridianPowerBackend::sensorFd(const QString &path)
+{
+    for (auto &s : m_sensorFds) {
+        if (s.path == path)
+            return s.fd;
+    }
+
+    SensorFd entry;
+
+    entry.path = path;
+    entry.fd = ::open(path.toLocal8Bit().constData(), O_RDONLY);
+    m_sensorFds.append(entry);
+    return entry.fd;
+}
+
+int VeridianPowerBackend::readSensor(const QString &path, char *buf,
+                                     int len)
+{
+    int fd = sensorFd(path);
+
+    if (fd < 0)
+        return -1;
+
+    /* Serve from this cycle's batch result when readSensorsBatched()
+     * already fetched the attribute */
+    for (const auto &s : m_sensorFds) {
+        if (s.fd == fd && s.valLen >= 0) {
+            int n = qMin(s.valLen, len - 1);
+            memcpy(buf, s.val, (size_t)n);
+            buf[n] = '\0';
+            return n;
+        }
+    }
+
+    ssize_t n = ::pread(fd, buf, (size_t)len - 1, 0);
+
+    if (n < 0)
+        return -1;
+    buf[n] = '\0';
+    return (int)n;
+}
+
+/*
+ * One kernel round-trip for the whole sensor set where the batch
+ * syscall exists; per-fd pread otherwise.  Successful reads land in
+ * each SensorFd's staging buffer, and readSensor() serves them for the
+ * remainder of the cycle without further syscalls.
+ */
+void VeridianPowerBackend::readSensorsBatched()
+{
+    struct veridian_read_req reqs[32];
+    SensorFd *slot[32];
+    unsigned int n = 0;
+
+    for (auto &s : m_sensorFds)
+        s.valLen = -1;
+
+    if (m_batchSupported == 0 || m_sensorFds.isEmpty())
+        return;
+
+    for (auto &s : m_sensorFds) {
+        if (s.fd < 0 || n >= 32)
+            continue;
+        reqs[n].fd = s.fd;
+        reqs[n]._pad = 0;
+        reqs[n].buf = s.val;
+        reqs[n].len = sizeof(s.val) - 1;
+        reqs[n].out_len = -1;
+        slot[n] = &s;
+        n++;
+    }
+    if (n == 0)
+        return;
+
+    if (veridian_read_batch(reqs, n) < 0) {
+        m_batchSupported = 0;   /* ENOSYS: plain preads from now on */
+        return;
+    }
+    m_batchSupported = 1;
+
+    for (unsigned int i = 0; i < n; i++) {
+        if (reqs[i].out_len >= 0)
+            slot[i]->valLen = reqs[i].out_len;
+    }
+}
+
+void VeridianPowerBackend::adaptPollInterval(bool changed)
+{
+    if (changed) {
+        m_stableCycles = 0;
+        if (m_currentPollMs != m_basePollMs) {
+            m_currentPollMs = m_basePollMs;
+            m_pollTimer->start(m_currentPollMs);
+        }
+        return;
+    }
+
+    /* Values are stable: back the wakeup rate off, up to 30s */
+    if (++m_stableCycles >= 3 && m_currentPollMs < 30000) {
+        m_currentPollMs = qMin(m_currentPollMs * 2, 30000);
+        m_pollTimer->start(m_currentPollMs);
+        m_stableCycles = 0;
+    }
+}
+
+/* Poll-path sensor accessors: persistent fds + cycle batch, unlike the
+ * QFile-based readSysfs/readSysfsInt used on cold one-shot paths */
+int VeridianPowerBackend::pollSensorInt(const QString &path)
+{
+    char buf[64];
+
+    if (readSensor(path, buf, sizeof(buf)) < 0)
+        return -1;
+
+    char *end;
+    long v = strtol(buf, &end, 10);
+
+    return (end == buf) ? -1 : (int)v;
+}
+
+QString VeridianPowerBackend::pollSensorStr(const QString &path)
+{
+    char buf[64];
+
+    if (readSensor(path, buf, sizeof(buf)) < 0)
+        return QString();
+    return QString::fromLatin1(buf).trimmed();
 }
 
 void VeridianPowerBackend::pollBatteryStatus()
 {
     PowerSource oldSource = m_powerSource;
+    bool changed = false;
+
+    /* Fetch every known attribute in one kernel round-trip (no-op
+     * before the first cycle populates the fd table) */
+    readSensorsBatched();
 
     /* Re-read AC status */
-    int acOnline = readSysfsInt(
+    int acOnline = pollSensorInt(
         QStringLiteral("/sys/class/power_supply/AC0/online"));
     m_powerSource = (acOnline == 1) ? PowerSource::AC : PowerSource::Battery;
 
-    if (m_powerSource != oldSource)
+    if (m_powerSource != oldSource) {
+        changed = true;
         Q_EMIT powerSourceChanged(m_powerSource);
+    }
 
     /* Re-read battery status */
     for (int i = 0; i < m_batteries.size(); ++i) {
         BatteryInfo &bat = m_batteries[i];
         QString base = QStringLiteral("/sys/class/power_supply/%1").arg(bat.name);
+        int oldPercentage = bat.percentage;
+        ChargeState oldState = bat.state;
 
-        bat.percentage = readSysfsInt(base + QStringLiteral("/capacity"));
-        bat.energyNow = readSysfsInt(base + QStringLiteral("/energy_now"));
-        bat.voltage = readSysfsInt(base + QStringLiteral("/voltage_now")) / 1000;
-        bat.currentDraw = readSysfsInt(base + QStringLiteral("/current_now")) / 1000;
+        bat.percentage = pollSensorInt(base + QStringLiteral("/capacity"));
+        bat.energyNow = pollSensorInt(base + QStringLiteral("/energy_now"));
+        bat.voltage = pollSensorInt(base + QStringLiteral("/voltage_now")) / 1000;
+        bat.currentDraw = pollSensorInt(base + QStringLiteral("/current_now")) / 1000;
 
-        QString statusStr = readSysfs(base + QStringLiteral("/status")).trimmed();
+        QString statusStr = pollSensorStr(base + QStringLiteral("/status"));
         if (statusStr == QStringLiteral("Charging"))
             bat.state = ChargeState::Charging;
         else if (statusStr == QStringLiteral("Discharging"))
@@ -441,6 +645,9 @@ void VeridianPowerBackend::pollBatteryStatus()
                 bat.timeToFull = ((bat.energyFull - bat.energyNow) * 3600) / (bat.currentDraw * bat.voltage / 1000);
         }
 
+        if (bat.percentage != oldPercentage || bat.state != oldState)
+            changed = true;
+
         Q_EMIT batteryChanged(i, bat);
 
         /* Low battery warnings */
@@ -449,6 +656,8 @@ void VeridianPowerBackend::pollBatteryStatus()
         else if (bat.percentage <= 15 && bat.state == ChargeState::Discharging)
             Q_EMIT lowBattery(bat.percentage);
     }
+
+    adaptPollInterval(changed);
 }
 
 /* ========================================================================= */
@@ -28,6 +28,7 @@
 #include <QString>
 #include <QTimer>
 #include <QDBusInterface>
+#include <QSocketNotifier>
 #include <QVector>
 
 namespace PowerDevil {
@@ -223,6 +224,28 @@ private:
     /* ----- Polling ----- */
     QTimer *m_pollTimer;
 
+    /* ----- Batched sensor reads + adaptive polling ----- */
+    struct SensorFd {
+        QString path;
+        int     fd = -1;
+        char    val[64];        /* last batched read for this cycle */
+        int     valLen = -1;    /* -1 = no batched value, fall back to pread */
+    };
+    QVector<SensorFd> m_sensorFds;       /* persistent attribute fds */
+    int  m_basePollMs = 5000;
+    int  m_currentPollMs = 5000;
+    int  m_stableCycles = 0;
+    int  m_batchSupported = -1;          /* -1 probe, 0 no, 1 yes */
+    int  m_ueventFd = -1;                /* inotify push channel */
+    QSocketNotifier *m_ueventNotifier = nullptr;
+
+    int  sensorFd(const QString &path);
+    int  readSensor(const QString &path, char *buf, int len);
+    void readSensorsBatched();
+    void adaptPollInterval(bool changed);
+    int  pollSensorInt(const QString &path);
+    QString pollSensorStr(const QString &path);
+
     /* ----- D-Bus ----- */
     QDBusInterface *m_upowerInterface;
 };
@@ -232,6 +232,237 @@ int session_get_window_states(session_window_state_t *states, int max)
  * Save session
  * ====================================================================== */
 
+/* ======================================================================
+ * Binary snapshot store
+ * ======================================================================
+ *
+ * Session state persists as a compact binary snapshot (session.snap:
+ * header + fixed-size window records) plus a delta log
+ * (session.snap.delta).  Per-window changes flow through
+ * session_update_window(), which appends one delta record -- moving a
+ * window writes tens of bytes, not the whole session -- and the log
+ * folds back into a fresh snapshot (compaction) once it outgrows the
+ * snapshot or at the final logout save, which is what makes the
+ * logout write cheap: it is usually just a truncate-after-fold of an
+ * already-current snapshot.  Restore loads the snapshot, replays the
+ * delta tail, and falls back to parsing the legacy text file when no
+ * snapshot exists yet.
+ */
+
+#define SNAP_MAGIC       0x4e535356u   /* "VSSN" */
+#define SNAP_VERSION     1
+#define SNAP_FILE        "session.snap"
+#define SNAP_DELTA_FILE  "session.snap.delta"
+#define SNAP_DELTA_MAX   64            /* records before compaction */
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t _pad;
+    int64_t  save_time;
+} snap_header_t;
+
+typedef struct {
+    uint32_t magic;                    /* SNAP_MAGIC */
+    uint32_t index;                    /* SESSION_MAX_WINDOWS = remove */
+    session_window_state_t state;
+} snap_delta_t;
+
+/* In-memory session mirror driving dirty tracking */
+static session_data_t s_snap;
+static int  s_delta_records = 0;
+static char s_snap_dir[512];
+
+static void snap_paths(char *snap, char *delta, size_t len)
+{
+    snprintf(snap, len, "%s/%s", s_snap_dir, SNAP_FILE);
+    snprintf(delta, len, "%s/%s", s_snap_dir, SNAP_DELTA_FILE);
+}
+
+/* Write the full snapshot (temp + rename) and truncate the delta log */
+static int snap_compact(void)
+{
+    char snap_path[512], delta_path[512], tmp[520];
+
+    snap_paths(snap_path, delta_path, sizeof(snap_path));
+    snprintf(tmp, sizeof(tmp), "%s.tmp", snap_path);
+
+    FILE *fp = fopen(tmp, "wb");
+
+    if (!fp)
+        return -1;
+
+    snap_header_t hdr;
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = SNAP_MAGIC;
+    hdr.version = SNAP_VERSION;
+    hdr.count = (uint32_t)s_snap.window_count;
+    hdr.save_time = (int64_t)time(NULL);
+
+    int ok = fwrite(&hdr, sizeof(hdr), 1, fp) == 1 &&
+             (s_snap.window_count == 0 ||
+              fwrite(s_snap.window_states,
+                     sizeof(session_window_state_t),
+                     (size_t)s_snap.window_count, fp) ==
+                  (size_t)s_snap.window_count);
+
+    fclose(fp);
+    if (!ok) {
+        unlink(tmp);
+        return -1;
+    }
+    if (rename(tmp, snap_path) != 0) {
+        unlink(tmp);
+        return -1;
+    }
+    unlink(delta_path);
+    s_delta_records = 0;
+    return 0;
+}
+
+/* Load snapshot + replay the delta tail into s_snap; 0 on success */
+static int snap_load(const char *session_dir)
+{
+    strncpy(s_snap_dir, session_dir, sizeof(s_snap_dir) - 1);
+    s_snap_dir[sizeof(s_snap_dir) - 1] = '\0';
+
+    char snap_path[512], delta_path[512];
+
+    snap_paths(snap_path, delta_path, sizeof(snap_path));
+
+    memset(&s_snap, 0, sizeof(s_snap));
+    s_delta_records = 0;
+
+    FILE *fp = fopen(snap_path, "rb");
+
+    if (!fp)
+        return -1;
+
+    snap_header_t hdr;
+
+    if (fread(&hdr, sizeof(hdr), 1, fp) != 1 ||
+        hdr.magic != SNAP_MAGIC || hdr.version != SNAP_VERSION ||
+        hdr.count > SESSION_MAX_WINDOWS) {
+        fclose(fp);
+        return -1;
+    }
+    if (hdr.count > 0 &&
+        fread(s_snap.window_states, sizeof(session_window_state_t),
+              hdr.count, fp) != hdr.count) {
+        fclose(fp);
+        return -1;
+    }
+    fclose(fp);
+    s_snap.window_count = (int)hdr.count;
+    s_snap.last_save_time = hdr.save_time;
+
+    /* Replay deltas appended after the snapshot; a torn tail stops
+     * the replay and the next compaction discards it */
+    fp = fopen(delta_path, "rb");
+    if (fp) {
+        snap_delta_t d;
+
+        while (fread(&d, sizeof(d), 1, fp) == 1) {
+            if (d.magic != SNAP_MAGIC)
+                break;
+            if (d.index == SESSION_MAX_WINDOWS) {
+                /* Remove: compaction renumbers; drop the last slot
+                 * the removal targeted via count stored in state.x */
+                if (s_snap.window_count > 0 &&
+                    d.state.x >= 0 &&
+                    d.state.x < s_snap.window_count) {
+                    memmove(&s_snap.window_states[d.state.x],
+                            &s_snap.window_states[d.state.x + 1],
+                            (size_t)(s_snap.window_count -
+                                     d.state.x - 1) *
+                                sizeof(session_window_state_t));
+                    s_snap.window_count--;
+                }
+            } else if (d.index < SESSION_MAX_WINDOWS) {
+                s_snap.window_states[d.index] = d.state;
+                if ((int)d.index >= s_snap.window_count)
+                    s_snap.window_count = (int)d.index + 1;
+            }
+            s_delta_records++;
+        }
+        fclose(fp);
+    }
+
+    return 0;
+}
+
+/* Append one delta record */
+static int snap_append_delta(uint32_t index,
+                             const session_window_state_t *state)
+{
+    char snap_path[512], delta_path[512];
+
+    snap_paths(snap_path, delta_path, sizeof(snap_path));
+
+    FILE *fp = fopen(delta_path, "ab");
+
+    if (!fp)
+        return -1;
+
+    snap_delta_t d;
+
+    memset(&d, 0, sizeof(d));
+    d.magic = SNAP_MAGIC;
+    d.index = index;
+    if (state)
+        d.state = *state;
+
+    int ok = fwrite(&d, sizeof(d), 1, fp) == 1;
+
+    fclose(fp);
+    if (!ok)
+        return -1;
+
+    if (++s_delta_records >= SNAP_DELTA_MAX)
+        snap_compact();
+    return 0;
+}
+
+int session_update_window(int index, const session_window_state_t *state)
+{
+    if (!state || index < 0 || index >= SESSION_MAX_WINDOWS ||
+        s_snap_dir[0] == '\0')
+        return -1;
+
+    /* Unchanged windows write nothing at all */
+    if (index < s_snap.window_count &&
+        memcmp(&s_snap.window_states[index], state,
+               sizeof(*state)) == 0)
+        return 0;
+
+    s_snap.window_states[index] = *state;
+    if (index >= s_snap.window_count)
+        s_snap.window_count = index + 1;
+
+    return snap_append_delta((uint32_t)index, state);
+}
+
+int session_remove_window(int index)
+{
+    if (index < 0 || index >= s_snap.window_count ||
+        s_snap_dir[0] == '\0')
+        return -1;
+
+    memmove(&s_snap.window_states[index],
+            &s_snap.window_states[index + 1],
+            (size_t)(s_snap.window_count - index - 1) *
+                sizeof(session_window_state_t));
+    s_snap.window_count--;
+
+    session_window_state_t marker;
+
+    memset(&marker, 0, sizeof(marker));
+    marker.x = index;
+    return snap_append_delta(SESSION_MAX_WINDOWS, &marker);
+}
+
 int session_save(const char *config_dir)
 {
     if (!config_dir) {
@@ -257,40 +488,24 @@ int session_save(const char *config_dir)
         return -1;
     }
 
-    FILE *fp = fopen(apps_path, "w");
-    if (!fp) {
-        fprintf(stderr, "[session-save] Cannot write %s: %s\n",
-                apps_path, strerror(errno));
-        return -1;
-    }
+    (void)apps_path;   /* legacy text file: read-only fallback now */
 
-    fprintf(fp, "# VeridianOS Plasma session state\n");
-    fprintf(fp, "# Auto-generated on logout -- do not edit\n");
-    fprintf(fp, "window_count=%d\n", window_count);
-    fprintf(fp, "session_type=plasma\n");
-    fprintf(fp, "save_time=%ld\n", (long)time(NULL));
-    fprintf(fp, "\n");
+    /* Fold the queried state into the snapshot mirror; windows whose
+     * record is unchanged cost nothing */
+    strncpy(s_snap_dir, session_dir, sizeof(s_snap_dir) - 1);
+    s_snap_dir[sizeof(s_snap_dir) - 1] = '\0';
+    for (int i = 0; i < window_count; i++)
+        session_update_window(i, &states[i]);
+    while (s_snap.window_count > window_count)
+        session_remove_window(s_snap.window_count - 1);
 
-    for (int i = 0; i < window_count; i++) {
-        fprintf(fp, "[Window_%d]\n", i);
-        fprintf(fp, "Command=%s\n", states[i].app_command);
-        fprintf(fp, "X=%d\n", states[i].x);
-        fprintf(fp, "Y=%d\n", states[i].y);
-        fprintf(fp, "Width=%d\n", states[i].width);
-        fprintf(fp, "Height=%d\n", states[i].height);
-        fprintf(fp, "Desktop=%d\n", states[i].desktop_number);
-        fprintf(fp, "Maximized=%s\n",
-                states[i].is_maximized ? "true" : "false");
-        fprintf(fp, "Minimized=%s\n",
-                states[i].is_minimized ? "true" : "false");
-        if (states[i].activity_id[0] != '\0') {
-            fprintf(fp, "Activity=%s\n", states[i].activity_id);
-        }
-        fprintf(fp, "\n");
+    /* Logout compaction: fold the delta log into a fresh snapshot */
+    if (snap_compact() != 0) {
+        fprintf(stderr, "[session-save] Cannot write snapshot in %s\n",
+                session_dir);
+        return -1;
     }
 
-    fclose(fp);
-
     /* Also write to kwinrc [Session] for KWin compatibility */
     char kwinrc_path[512];
     if (build_path(kwinrc_path, sizeof(kwinrc_path),
@@ -323,8 +538,8 @@ int session_save(const char *config_dir)
         fclose(kfp);
     }
 
-    fprintf(stderr, "[session-save] Saved %d windows to %s\n",
-            window_count, apps_path);
+    fprintf(stderr, "[session-save] Saved %d windows (binary snapshot)\n",
+            window_count);
     return 0;
 }
 
@@ -387,6 +602,19 @@ int session_restore(const char *config_dir)
         return -1;
     }
 
+    session_window_state_t states[SESSION_MAX_WINDOWS];
+    memset(states, 0, sizeof(states));
+    int window_count = 0;
+
+    /* Binary snapshot (plus delta replay) is the primary store */
+    if (snap_load(session_dir) == 0) {
+        window_count = s_snap.window_count;
+        memcpy(states, s_snap.window_states,
+               (size_t)window_count * sizeof(session_window_state_t));
+        goto have_states;
+    }
+
+    {
     FILE *fp = fopen(apps_path, "r");
     if (!fp) {
         fprintf(stderr, "[session-restore] No saved session at %s\n",
@@ -394,9 +622,6 @@ int session_restore(const char *config_dir)
         return 0;
     }
 
-    session_window_state_t states[SESSION_MAX_WINDOWS];
-    memset(states, 0, sizeof(states));
-    int window_count = 0;
     int current_window = -1;
     char line[MAX_LINE];
 
@@ -497,7 +722,9 @@ int session_restore(const char *config_dir)
     }
 
     fclose(fp);
+    }
 
+have_states:
     if (window_count == 0) {
         fprintf(stderr, "[session-restore] No windows to restore\n");
         return 0;
@@ -578,6 +805,16 @@ int session_clear_saved(const char *config_dir)
         return -1;
     }
 
+    /* Binary snapshot + delta log go with it */
+    char path[512];
+
+    if (build_path(path, sizeof(path), session_dir, SNAP_FILE) == 0)
+        unlink(path);
+    if (build_path(path, sizeof(path), session_dir, SNAP_DELTA_FILE) == 0)
+        unlink(path);
+    memset(&s_snap, 0, sizeof(s_snap));
+    s_delta_records = 0;
+
     fprintf(stderr, "[session-clear] Cleared saved session data\n");
     return 0;
 }
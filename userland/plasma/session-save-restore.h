@@ -80,6 +80,23 @@ int session_restore(const char *config_dir);
  */
 int session_get_window_states(session_window_state_t *states, int max);
 
+/*
+ * Incrementally record one window's state.  Appends a delta record to
+ * the binary snapshot's log -- moving a window writes bytes, not the
+ * world -- and is a no-op when the state is unchanged.  The log folds
+ * into a fresh snapshot automatically after 64 records and at the
+ * session_save() on logout.  Requires a prior session_save() or
+ * session_restore() to have bound the session directory.
+ * Returns 0 on success, -1 on error.
+ */
+int session_update_window(int index, const session_window_state_t *state);
+
+/*
+ * Remove a window from the tracked session (appends a removal delta).
+ * Returns 0 on success, -1 on error.
+ */
+int session_remove_window(int index);
+
 /*
  * Clear all saved session data for the given config directory.
  * Returns 0 on success, -1 on error.
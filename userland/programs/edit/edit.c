@@ -23,6 +23,7 @@
  *   Ctrl+W   Search forward
  *   Ctrl+K   Cut current line
  *   Ctrl+U   Paste cut line
+ *   Ctrl+T   Toggle word wrap (incremental reflow)
  *   Ctrl+G   Help screen
  *   Ctrl+A   Beginning of line
  *   Ctrl+E   End of line
@@ -36,9 +37,13 @@
  */
 
 #include <curses.h>
+#include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 /* ========================================================================= */
 /* Constants                                                                 */
@@ -57,17 +62,53 @@
 /* Editor state                                                              */
 /* ========================================================================= */
 
-/* A single line of text (dynamically sized). */
+/*
+ * A single line of text.  Two flavors share the struct:
+ *   cap >  0: heap line, NUL-terminated, mutable ("add buffer")
+ *   cap == 0: immutable piece pointing into the mmap'd original file
+ *             (NOT NUL-terminated; len bytes).  Copied to the heap
+ *             the first time it is edited.
+ * This is the piece-table split: opening a file allocates no line
+ * data at all, only the piece descriptors.
+ */
 struct line {
-    char *data;    /* NUL-terminated string */
+    char *data;    /* Heap string or pointer into the file mapping */
     int   len;     /* Current length (excluding NUL) */
-    int   cap;     /* Allocated capacity */
+    int   cap;     /* Allocated capacity; 0 = mmap piece */
+
+    /*
+     * Cached wrap points (wrap mode): breaks[] holds the start
+     * offset of each display segment after the first.  Valid only
+     * while wrap_width matches the current text width; edits and
+     * resizes invalidate by zeroing wrap_width, and the cache
+     * recomputes lazily when the line is next rendered -- so a
+     * resize costs O(visible), never O(file).
+     */
+    int  *breaks;
+    int   nbreaks;
+    int   wrap_width;
 };
 
-/* The editor buffer. */
-static struct line *lines  = NULL;   /* Array of lines */
-static int num_lines       = 0;      /* Number of lines */
-static int cap_lines       = 0;      /* Allocated line slots */
+/*
+ * The editor buffer: a gap buffer of line descriptors.  The gap sits
+ * at the last edit point, so inserting or deleting a line at the
+ * cursor is O(1) amortized instead of shifting the tail of a
+ * million-line array.  line_at() maps a logical row to its slot.
+ */
+static struct line *lines  = NULL;   /* Slot array (gap inside) */
+static int num_lines       = 0;      /* Logical number of lines */
+static int cap_lines       = 0;      /* Allocated slots */
+static int gap_start       = 0;      /* First slot of the gap */
+static int gap_len         = 0;      /* Slots in the gap */
+
+/* mmap'd original file backing the piece lines */
+static char  *file_map     = NULL;
+static size_t file_map_len = 0;
+
+static struct line *line_at(int i)
+{
+    return &lines[i < gap_start ? i : i + gap_len];
+}
 
 /* Cursor position in the buffer (0-indexed). */
 static int cx = 0;   /* Column within the line */
@@ -89,33 +130,83 @@ static char *cut_buf = NULL;
 static char status_msg[256] = {0};
 
 /* ========================================================================= */
-/* Line management helpers                                                   */
+/* Dirty-row tracking                                                        */
 /* ========================================================================= */
 
 /*
- * Initialise a line structure with a given string (may be NULL for empty).
+ * draw_screen() re-renders only screen rows whose content changed.
+ * Edits mark the rows they touch; scrolling (either axis) or a
+ * structural change repaints everything.  Cursor-only movement
+ * repaints nothing but the status bar.
  */
-static void line_init(struct line *ln, const char *s)
+#define MAX_DIRTY_ROWS 512
+
+static unsigned char dirty_rows[MAX_DIRTY_ROWS];
+static int all_dirty = 1;
+
+/* Content of one buffer row changed */
+static void mark_dirty(int buf_row)
 {
-    int slen = s ? (int)strlen(s) : 0;
-    ln->cap = slen + INITIAL_LINESZ;
-    ln->data = (char *)malloc(ln->cap);
-    if (!ln->data) {
-        ln->cap = 0;
-        ln->len = 0;
+    int y = buf_row - row_offset;
+
+    if (y >= 0 && y < MAX_DIRTY_ROWS)
+        dirty_rows[y] = 1;
+}
+
+/* Rows from buf_row to the bottom shifted (line insert/delete) */
+static void mark_dirty_from(int buf_row)
+{
+    int y = buf_row - row_offset;
+
+    if (y < 0) {
+        all_dirty = 1;
         return;
     }
-    if (s && slen > 0)
-        memcpy(ln->data, s, slen);
-    ln->data[slen] = '\0';
-    ln->len = slen;
+    for (; y < MAX_DIRTY_ROWS; y++)
+        dirty_rows[y] = 1;
+}
+
+/* ========================================================================= */
+/* Line management helpers                                                   */
+/* ========================================================================= */
+
+/*
+ * Point a line at a slice of the mmap'd file (no allocation).
+ */
+static void line_init_piece(struct line *ln, char *ptr, int len)
+{
+    ln->breaks = NULL;
+    ln->nbreaks = 0;
+    ln->wrap_width = 0;
+    ln->data = ptr;
+    ln->len = len;
+    ln->cap = 0;
 }
 
 /*
- * Ensure a line has room for at least `needed` more bytes.
+ * Copy a piece line onto the heap before its first mutation.
+ */
+static void line_materialize(struct line *ln)
+{
+    if (ln->cap > 0 || !ln->data)
+        return;
+
+    int newcap = ln->len + INITIAL_LINESZ;
+    char *heap = (char *)malloc(newcap);
+
+    if (!heap) return;
+    memcpy(heap, ln->data, ln->len);
+    heap[ln->len] = '\0';
+    ln->data = heap;
+    ln->cap = newcap;
+}
+
+/*
+ * Ensure a line is heap-backed with room for `needed` more bytes.
  */
 static void line_grow(struct line *ln, int needed)
 {
+    line_materialize(ln);
     if (ln->len + needed + 1 <= ln->cap)
         return;
     int newcap = ln->cap * 2;
@@ -128,11 +219,16 @@ static void line_grow(struct line *ln, int needed)
 }
 
 /*
- * Free a line's data.
+ * Free a line's data (pieces belong to the file mapping).
  */
 static void line_free(struct line *ln)
 {
-    free(ln->data);
+    if (ln->cap > 0)
+        free(ln->data);
+    free(ln->breaks);
+    ln->breaks = NULL;
+    ln->nbreaks = 0;
+    ln->wrap_width = 0;
     ln->data = NULL;
     ln->len = 0;
     ln->cap = 0;
@@ -141,8 +237,80 @@ static void line_free(struct line *ln)
 /*
  * Insert a character at position `pos` within a line.
  */
+/* Wrap display mode (toggled with Ctrl+T); caches live per line */
+static int wrap_mode = 0;
+
+static void line_invalidate_wrap(struct line *ln)
+{
+    ln->wrap_width = 0;
+}
+
+/*
+ * (Re)compute the wrap points for one line at the given width:
+ * break at the last blank before the limit, hard-break unbreakable
+ * runs.  Amortized O(len); called only for lines actually rendered.
+ */
+static void line_reflow(struct line *ln, int width)
+{
+    if (ln->wrap_width == width)
+        return;
+
+    ln->nbreaks = 0;
+    if (width < 2) {
+        ln->wrap_width = width;
+        return;
+    }
+
+    int cap_needed = ln->len / (width / 2) + 2;
+
+    if (ln->breaks == NULL || cap_needed > 0) {
+        free(ln->breaks);
+        ln->breaks = malloc((size_t)cap_needed * sizeof(int));
+        if (!ln->breaks) {
+            ln->wrap_width = 0;
+            return;
+        }
+    }
+
+    int start = 0;
+
+    while (ln->len - start > width) {
+        int brk = -1;
+
+        for (int i = start + width; i > start; i--) {
+            if (ln->data[i - 1] == ' ' || ln->data[i - 1] == '\t') {
+                brk = i;
+                break;
+            }
+        }
+        if (brk <= start)
+            brk = start + width;        /* Unbreakable: hard cut */
+        ln->breaks[ln->nbreaks++] = brk;
+        start = brk;
+    }
+    ln->wrap_width = width;
+}
+
+/* Display segments this line occupies at the current width */
+static int line_segments(struct line *ln, int width)
+{
+    if (!wrap_mode)
+        return 1;
+    line_reflow(ln, width);
+    return ln->nbreaks + 1;
+}
+
+/* Bounds of segment seg: [*s0, *s1) byte offsets */
+static void line_segment_bounds(struct line *ln, int seg, int *s0,
+                                int *s1)
+{
+    *s0 = seg == 0 ? 0 : ln->breaks[seg - 1];
+    *s1 = seg < ln->nbreaks ? ln->breaks[seg] : ln->len;
+}
+
 static void line_insert_char(struct line *ln, int pos, char ch)
 {
+    line_invalidate_wrap(ln);
     if (pos < 0) pos = 0;
     if (pos > ln->len) pos = ln->len;
     line_grow(ln, 1);
@@ -156,7 +324,9 @@ static void line_insert_char(struct line *ln, int pos, char ch)
  */
 static void line_delete_char(struct line *ln, int pos)
 {
+    line_invalidate_wrap(ln);
     if (pos < 0 || pos >= ln->len) return;
+    line_materialize(ln);
     memmove(ln->data + pos, ln->data + pos + 1, ln->len - pos);
     ln->len--;
 }
@@ -166,31 +336,96 @@ static void line_delete_char(struct line *ln, int pos)
 /* ========================================================================= */
 
 /*
- * Ensure the lines array has room for at least one more line.
+ * Move the gap so it starts at logical row `at`.  Free when the gap
+ * is already there (the common case: consecutive edits at the
+ * cursor); O(distance moved) otherwise.
+ */
+static void gap_move(int at)
+{
+    if (at == gap_start)
+        return;
+    if (at < gap_start) {
+        memmove(&lines[at + gap_len], &lines[at],
+                (size_t)(gap_start - at) * sizeof(struct line));
+    } else {
+        memmove(&lines[gap_start], &lines[gap_start + gap_len],
+                (size_t)(at - gap_start) * sizeof(struct line));
+    }
+    gap_start = at;
+}
+
+/*
+ * Ensure the gap has at least one free slot.
  */
 static void buf_grow(void)
 {
-    if (num_lines < cap_lines) return;
+    if (gap_len > 0) return;
+
     int newcap = cap_lines == 0 ? INITIAL_CAP : cap_lines * 2;
-    struct line *tmp = (struct line *)realloc(lines, newcap * sizeof(struct line));
+    struct line *tmp = (struct line *)realloc(lines,
+                                              (size_t)newcap *
+                                              sizeof(struct line));
     if (!tmp) return;
+
+    /* Open the new space as gap at the current gap position (the
+     * tail after the old gap moves to the end of the new array) */
+    int tail = cap_lines - gap_start;   /* slots after the gap */
+
+    if (tail > 0)
+        memmove(&tmp[newcap - tail], &tmp[gap_start],
+                (size_t)tail * sizeof(struct line));
     lines = tmp;
+    gap_len = newcap - cap_lines + gap_len;
     cap_lines = newcap;
 }
 
 /*
- * Insert an empty line at position `at`.
+ * Insert a line at position `at` holding the first `n` bytes of `s`.
  */
+static void buf_insert_line_n(int at, const char *s, int n)
+{
+    if (at < 0) at = 0;
+    if (at > num_lines) at = num_lines;
+    buf_grow();
+    if (gap_len == 0) return;   /* OOM */
+    gap_move(at);
+
+    struct line *ln = &lines[gap_start];
+
+    ln->cap = n + INITIAL_LINESZ;
+    ln->data = (char *)malloc(ln->cap);
+    if (!ln->data) {
+        ln->cap = 0;
+        ln->len = 0;
+    } else {
+        if (n > 0)
+            memcpy(ln->data, s, (size_t)n);
+        ln->data[n] = '\0';
+        ln->len = n;
+    }
+    gap_start++;
+    gap_len--;
+    num_lines++;
+}
+
 static void buf_insert_line(int at, const char *s)
+{
+    buf_insert_line_n(at, s, s ? (int)strlen(s) : 0);
+}
+
+/*
+ * Insert a piece line (zero-copy view into the file mapping).
+ */
+static void buf_insert_piece(int at, char *ptr, int len)
 {
     if (at < 0) at = 0;
     if (at > num_lines) at = num_lines;
     buf_grow();
-    /* Shift lines down */
-    if (at < num_lines)
-        memmove(&lines[at + 1], &lines[at],
-                (num_lines - at) * sizeof(struct line));
-    line_init(&lines[at], s);
+    if (gap_len == 0) return;
+    gap_move(at);
+    line_init_piece(&lines[gap_start], ptr, len);
+    gap_start++;
+    gap_len--;
     num_lines++;
 }
 
@@ -200,10 +435,9 @@ static void buf_insert_line(int at, const char *s)
 static void buf_delete_line(int at)
 {
     if (at < 0 || at >= num_lines) return;
-    line_free(&lines[at]);
-    if (at < num_lines - 1)
-        memmove(&lines[at], &lines[at + 1],
-                (num_lines - at - 1) * sizeof(struct line));
+    gap_move(at);
+    line_free(&lines[gap_start + gap_len]);  /* row `at` sits after gap */
+    gap_len++;
     num_lines--;
     if (num_lines == 0) {
         /* Always keep at least one line */
@@ -212,16 +446,23 @@ static void buf_delete_line(int at)
 }
 
 /*
- * Free all buffer lines.
+ * Free all buffer lines and the file mapping.
  */
 static void buf_free(void)
 {
     for (int i = 0; i < num_lines; i++)
-        line_free(&lines[i]);
+        line_free(line_at(i));
     free(lines);
     lines = NULL;
     num_lines = 0;
     cap_lines = 0;
+    gap_start = 0;
+    gap_len = 0;
+    if (file_map) {
+        munmap(file_map, file_map_len);
+        file_map = NULL;
+        file_map_len = 0;
+    }
 }
 
 /* ========================================================================= */
@@ -230,17 +471,62 @@ static void buf_free(void)
 
 /*
  * Load a file into the buffer.  Returns 0 on success, -1 on failure.
+ *
+ * The file is mmap'd read-only and lines become zero-copy pieces
+ * into the mapping -- opening costs one newline scan, no per-line
+ * allocation, no data copy.  Lines are copied to the heap only when
+ * first edited.  Falls back to the read loop when mmap fails (e.g. a
+ * pipe).
  */
 static int load_file(const char *path)
 {
-    FILE *fp = fopen(path, "r");
-    if (!fp) return -1;
-
     buf_free();
 
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+
+    struct stat st;
+
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        void *map = mmap(NULL, (size_t)st.st_size, PROT_READ,
+                         MAP_PRIVATE, fd, 0);
+
+        if (map != MAP_FAILED) {
+            file_map = (char *)map;
+            file_map_len = (size_t)st.st_size;
+            close(fd);
+
+            char *p = file_map;
+            char *end = file_map + file_map_len;
+
+            while (p < end) {
+                char *nl = memchr(p, '\n', (size_t)(end - p));
+                char *eol = nl ? nl : end;
+                int len = (int)(eol - p);
+
+                if (len > 0 && eol[-1] == '\r')
+                    len--;
+                buf_insert_piece(num_lines, p, len);
+                if (!nl)
+                    break;
+                p = nl + 1;
+            }
+
+            if (num_lines == 0)
+                buf_insert_line(0, "");
+            return 0;
+        }
+    }
+
+    /* Fallback: buffered read (also the empty-file path) */
+    FILE *fp = fdopen(fd, "r");
+    if (!fp) {
+        close(fd);
+        return -1;
+    }
+
     char buf[4096];
     while (fgets(buf, (int)sizeof(buf), fp)) {
-        /* Strip trailing newline */
         int len = (int)strlen(buf);
         while (len > 0 && (buf[len - 1] == '\n' || buf[len - 1] == '\r'))
             buf[--len] = '\0';
@@ -256,17 +542,37 @@ static int load_file(const char *path)
 
 /*
  * Save the buffer to a file.  Returns 0 on success, -1 on failure.
+ *
+ * Writes a temp file and renames it into place: pieces still point
+ * into the mapping of the ORIGINAL inode, so truncating the target
+ * in place would yank pages out from under them (and a failed save
+ * would destroy the old contents).  Pieces write by length -- they
+ * are not NUL-terminated.
  */
 static int save_file(const char *path)
 {
-    FILE *fp = fopen(path, "w");
+    char tmp[1088];
+
+    snprintf(tmp, sizeof(tmp), "%s.tmp~", path);
+
+    FILE *fp = fopen(tmp, "w");
     if (!fp) return -1;
 
     for (int i = 0; i < num_lines; i++) {
-        fputs(lines[i].data, fp);
+        struct line *ln = line_at(i);
+
+        if (ln->len > 0)
+            fwrite(ln->data, 1, (size_t)ln->len, fp);
         fputc('\n', fp);
     }
-    fclose(fp);
+    if (fclose(fp) != 0) {
+        remove(tmp);
+        return -1;
+    }
+    if (rename(tmp, path) != 0) {
+        remove(tmp);
+        return -1;
+    }
     modified = 0;
     return 0;
 }
@@ -348,15 +654,124 @@ static int col_to_screen(const struct line *ln, int col)
 /*
  * Draw the full screen: text area + status bar + help bar.
  */
+/* Segment offset of the top of the window (wrap mode) */
+static int seg_offset = 0;
+static int wrap_cursor_y, wrap_cursor_x;    /* Set by wrapped render */
+
+/*
+ * Wrapped rendering: screen rows map to (line, segment) pairs from
+ * (row_offset, seg_offset).  Only the lines that appear on screen
+ * are reflowed -- everything else keeps stale or absent caches,
+ * which is what makes resize drags O(visible).
+ */
+static void draw_screen_wrapped(int trows, int tcols)
+{
+    /* Locate the cursor's segment */
+    struct line *cln = cy < num_lines ? line_at(cy) : NULL;
+    int cseg = 0, cseg_x = cx;
+
+    if (cln) {
+        line_reflow(cln, tcols);
+        for (int s2 = 0; s2 < cln->nbreaks; s2++) {
+            if (cx >= cln->breaks[s2]) {
+                cseg = s2 + 1;
+                cseg_x = cx - cln->breaks[s2];
+            }
+        }
+    }
+
+    /* Scroll so the cursor's segment is on screen: pull the top up
+     * to the cursor, or push it down one segment at a time */
+    if (cy < row_offset || (cy == row_offset && cseg < seg_offset)) {
+        row_offset = cy;
+        seg_offset = cseg;
+        all_dirty = 1;
+    }
+    for (;;) {
+        /* Count segments from top to cursor */
+        int rows_used = 0;
+        int l = row_offset, s2 = seg_offset;
+
+        while (l < cy && rows_used <= trows) {
+            rows_used += line_segments(line_at(l), tcols) - s2;
+            s2 = 0;
+            l++;
+        }
+        rows_used += cseg - s2;
+        if (rows_used < trows)
+            break;
+        /* Advance the top one segment */
+        if (seg_offset + 1 < line_segments(line_at(row_offset), tcols)) {
+            seg_offset++;
+        } else {
+            row_offset++;
+            seg_offset = 0;
+        }
+        all_dirty = 1;
+    }
+
+    /* Render */
+    int y = 0;
+    int l = row_offset, s2 = seg_offset;
+    int cursor_y = 0, cursor_x = 0;
+
+    while (y < trows) {
+        move(y, 0);
+        clrtoeol();
+        if (l < num_lines) {
+            struct line *ln = line_at(l);
+            int nsegs = line_segments(ln, tcols);
+            int s0, s1;
+
+            line_segment_bounds(ln, s2, &s0, &s1);
+            for (int i = s0; i < s1 && i - s0 < tcols; i++) {
+                char ch = ln->data[i] == '\t' ? ' ' : ln->data[i];
+
+                mvaddch(y, i - s0, (chtype)(unsigned char)ch);
+            }
+            if (l == cy && s2 == cseg) {
+                cursor_y = y;
+                cursor_x = cseg_x < tcols ? cseg_x : tcols - 1;
+            }
+            if (++s2 >= nsegs) {
+                l++;
+                s2 = 0;
+            }
+        } else {
+            mvaddch(y, 0, '~');
+        }
+        y++;
+    }
+
+    memset(dirty_rows, 0, sizeof(dirty_rows));
+    all_dirty = 0;
+    wrap_cursor_y = cursor_y;
+    wrap_cursor_x = cursor_x;
+}
+
 static void draw_screen(void)
 {
     int trows = text_rows();
     int tcols = COLS;
 
+    if (wrap_mode) {
+        /* Wrapped path: col_offset does not apply */
+        static int last_width = -1;
+
+        if (last_width != tcols) {
+            /* Width change invalidates nothing eagerly: caches
+             * refresh lazily as lines render */
+            last_width = tcols;
+            all_dirty = 1;
+        }
+        draw_screen_wrapped(trows, tcols);
+        goto status_bar;
+    }
+
     /* Compute screen column of cursor for horizontal scrolling */
     int screen_cx = 0;
     if (cy >= 0 && cy < num_lines)
-        screen_cx = col_to_screen(&lines[cy], cx);
+        screen_cx = col_to_screen(line_at(cy), cx);
 
     /* Adjust col_offset so cursor is visible */
     if (screen_cx < col_offset)
@@ -364,13 +779,26 @@ static void draw_screen(void)
     if (screen_cx >= col_offset + tcols)
         col_offset = screen_cx - tcols + 1;
 
-    /* Draw text lines */
+    /* Any scroll repositions every row */
+    static int last_row_offset = -1;
+    static int last_col_offset = -1;
+
+    if (row_offset != last_row_offset || col_offset != last_col_offset) {
+        all_dirty = 1;
+        last_row_offset = row_offset;
+        last_col_offset = col_offset;
+    }
+
+    /* Draw text lines (only the dirty ones) */
     for (int y = 0; y < trows; y++) {
         int file_row = y + row_offset;
+
+        if (!all_dirty && (y >= MAX_DIRTY_ROWS || !dirty_rows[y]))
+            continue;
         move(y, 0);
         clrtoeol();
         if (file_row < num_lines) {
-            struct line *ln = &lines[file_row];
+            struct line *ln = line_at(file_row);
             /* Render the line with tab expansion, applying col_offset */
             int sx = 0;  /* screen x */
             for (int i = 0; i < ln->len; i++) {
@@ -394,6 +822,11 @@ static void draw_screen(void)
         }
     }
 
+    /* Everything below reconverges; clear the damage flags */
+    memset(dirty_rows, 0, sizeof(dirty_rows));
+    all_dirty = 0;
+
+status_bar:
     /* ---- Status bar (second to last line) ---- */
     attron(A_REVERSE);
     move(LINES - 2, 0);
@@ -447,7 +880,9 @@ static void draw_screen(void)
     attroff(A_BOLD);
 
     /* Position the cursor */
-    {
+    if (wrap_mode) {
+        move(wrap_cursor_y, wrap_cursor_x);
+    } else {
         int scr_y = cy - row_offset;
         int scr_x = screen_cx - col_offset;
         if (scr_y >= 0 && scr_y < trows && scr_x >= 0 && scr_x < tcols)
@@ -487,14 +922,14 @@ static void move_left(void)
     } else if (cy > 0) {
         /* Wrap to end of previous line */
         cy--;
-        cx = lines[cy].len;
+        cx = line_at(cy)->len;
     }
 }
 
 static void move_right(void)
 {
     if (cy < num_lines) {
-        if (cx < lines[cy].len) {
+        if (cx < line_at(cy)->len) {
             cx++;
         } else if (cy < num_lines - 1) {
             /* Wrap to start of next line */
@@ -508,8 +943,8 @@ static void move_up(void)
 {
     if (cy > 0) {
         cy--;
-        if (cx > lines[cy].len)
-            cx = lines[cy].len;
+        if (cx > line_at(cy)->len)
+            cx = line_at(cy)->len;
     }
 }
 
@@ -517,8 +952,8 @@ static void move_down(void)
 {
     if (cy < num_lines - 1) {
         cy++;
-        if (cx > lines[cy].len)
-            cx = lines[cy].len;
+        if (cx > line_at(cy)->len)
+            cx = line_at(cy)->len;
     }
 }
 
@@ -530,7 +965,7 @@ static void move_home(void)
 static void move_end(void)
 {
     if (cy < num_lines)
-        cx = lines[cy].len;
+        cx = line_at(cy)->len;
 }
 
 static void move_page_up(void)
@@ -540,7 +975,7 @@ static void move_page_up(void)
     if (cy < 0) cy = 0;
     row_offset -= trows;
     if (row_offset < 0) row_offset = 0;
-    if (cx > lines[cy].len) cx = lines[cy].len;
+    if (cx > line_at(cy)->len) cx = line_at(cy)->len;
 }
 
 static void move_page_down(void)
@@ -553,7 +988,7 @@ static void move_page_down(void)
     if (row_offset > num_lines - trows)
         row_offset = num_lines - trows;
     if (row_offset < 0) row_offset = 0;
-    if (cx > lines[cy].len) cx = lines[cy].len;
+    if (cx > line_at(cy)->len) cx = line_at(cy)->len;
 }
 
 /* ========================================================================= */
@@ -566,9 +1001,10 @@ static void move_page_down(void)
 static void insert_char(char ch)
 {
     if (cy >= num_lines) return;
-    line_insert_char(&lines[cy], cx, ch);
+    line_insert_char(line_at(cy), cx, ch);
     cx++;
     modified = 1;
+    mark_dirty(cy);
 }
 
 /*
@@ -577,14 +1013,16 @@ static void insert_char(char ch)
 static void insert_newline(void)
 {
     if (cy >= num_lines) return;
-    struct line *ln = &lines[cy];
-    /* Text after cursor goes to new line */
-    const char *tail = ln->data + cx;
-    buf_insert_line(cy + 1, tail);
+    struct line *ln = line_at(cy);
+    /* Text after cursor goes to new line (bounded: pieces have no NUL) */
+    buf_insert_line_n(cy + 1, ln->data + cx, ln->len - cx);
     /* Truncate current line at cursor */
+    ln = line_at(cy);               /* gap move may have shifted slots */
+    line_materialize(ln);
     ln->data[cx] = '\0';
     ln->len = cx;
     /* Move cursor to start of new line */
+    mark_dirty_from(cy);
     cy++;
     cx = 0;
     modified = 1;
@@ -596,18 +1034,22 @@ static void insert_newline(void)
 static void delete_char(void)
 {
     if (cy >= num_lines) return;
-    struct line *ln = &lines[cy];
+    struct line *ln = line_at(cy);
     if (cx < ln->len) {
         line_delete_char(ln, cx);
         modified = 1;
+        mark_dirty(cy);
     } else if (cy < num_lines - 1) {
-        /* Join next line to end of current line */
-        struct line *next = &lines[cy + 1];
+        /* Join next line to end of current line (copy by length --
+         * pieces have no trailing NUL) */
+        struct line *next = line_at(cy + 1);
         line_grow(ln, next->len);
-        memcpy(ln->data + ln->len, next->data, next->len + 1);
+        memcpy(ln->data + ln->len, next->data, (size_t)next->len);
         ln->len += next->len;
+        ln->data[ln->len] = '\0';
         buf_delete_line(cy + 1);
         modified = 1;
+        mark_dirty_from(cy);
     }
 }
 
@@ -621,16 +1063,18 @@ static void backspace(void)
         delete_char();
     } else if (cy > 0) {
         /* Join current line to end of previous line */
-        int prev_len = lines[cy - 1].len;
-        struct line *prev = &lines[cy - 1];
-        struct line *cur  = &lines[cy];
+        int prev_len = line_at(cy - 1)->len;
+        struct line *prev = line_at(cy - 1);
+        struct line *cur  = line_at(cy);
         line_grow(prev, cur->len);
-        memcpy(prev->data + prev->len, cur->data, cur->len + 1);
+        memcpy(prev->data + prev->len, cur->data, (size_t)cur->len);
         prev->len += cur->len;
+        prev->data[prev->len] = '\0';
         buf_delete_line(cy);
         cy--;
         cx = prev_len;
         modified = 1;
+        mark_dirty_from(cy);
     }
 }
 
@@ -653,16 +1097,25 @@ static void cut_line(void)
 {
     if (cy >= num_lines) return;
 
-    /* Store cut line */
+    /* Store cut line (bounded copy: pieces have no NUL) */
     free(cut_buf);
-    cut_buf = strdup(lines[cy].data);
+    {
+        struct line *ln = line_at(cy);
+
+        cut_buf = (char *)malloc((size_t)ln->len + 1);
+        if (cut_buf) {
+            memcpy(cut_buf, ln->data, (size_t)ln->len);
+            cut_buf[ln->len] = '\0';
+        }
+    }
 
     buf_delete_line(cy);
     if (cy >= num_lines && cy > 0)
         cy = num_lines - 1;
-    if (cx > lines[cy].len)
-        cx = lines[cy].len;
+    if (cx > line_at(cy)->len)
+        cx = line_at(cy)->len;
     modified = 1;
+    mark_dirty_from(cy);
 
     snprintf(status_msg, sizeof(status_msg), "Cut 1 line");
 }
@@ -679,9 +1132,10 @@ static void paste_line(void)
 
     buf_insert_line(cy, cut_buf);
     cy++;
-    if (cx > lines[cy].len)
-        cx = lines[cy].len;
+    if (cx > line_at(cy)->len)
+        cx = line_at(cy)->len;
     modified = 1;
+    mark_dirty_from(cy - 1);
 
     snprintf(status_msg, sizeof(status_msg), "Pasted 1 line");
 }
@@ -690,6 +1144,175 @@ static void paste_line(void)
 /* Search                                                                    */
 /* ========================================================================= */
 
+/*
+ * Boyer-Moore-Horspool over an arbitrary byte run.  The skip table
+ * is built once per search; full-stride skips vault ahead with
+ * memchr on the needle's last byte, which rides the SIMD memchr in
+ * string.c instead of stepping a byte at a time.  Returns the match
+ * offset or -1.
+ */
+static void bmh_build(const unsigned char *needle, int nlen,
+                      int skip[256])
+{
+    for (int i = 0; i < 256; i++)
+        skip[i] = nlen;
+    for (int i = 0; i < nlen - 1; i++)
+        skip[needle[i]] = nlen - 1 - i;
+}
+
+static long bmh_search(const char *hay, long hlen,
+                       const unsigned char *needle, int nlen,
+                       const int skip[256])
+{
+    const unsigned char *h = (const unsigned char *)hay;
+    unsigned char last = needle[nlen - 1];
+    long i = 0;
+
+    if (nlen == 1) {
+        const char *p = memchr(hay, last, (size_t)hlen);
+
+        return p ? p - hay : -1;
+    }
+
+    while (i + nlen <= hlen) {
+        unsigned char c = h[i + nlen - 1];
+
+        if (c == last &&
+            memcmp(h + i, needle, (size_t)nlen - 1) == 0)
+            return i;
+
+        int s2 = skip[c];
+
+        if (s2 == nlen) {
+            /* Nothing in the window matters: memchr vaults to the
+             * next occurrence of the last byte */
+            const char *p = memchr(hay + i + nlen,
+                                   last,
+                                   (size_t)(hlen - i - nlen));
+
+            if (!p)
+                return -1;
+            i = (p - hay) - (nlen - 1);
+        } else {
+            i += s2;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Bounded substring search within one line (pieces carry no NUL, so
+ * strstr is off the table).  Returns the column or -1.
+ */
+static int line_find(const struct line *ln, int start, const char *needle)
+{
+    int nlen = (int)strlen(needle);
+    int skip[256];
+    long pos;
+
+    if (start < 0) start = 0;
+    if (nlen == 0 || start + nlen > ln->len)
+        return -1;
+    bmh_build((const unsigned char *)needle, nlen, skip);
+    pos = bmh_search(ln->data + start, ln->len - start,
+                     (const unsigned char *)needle, nlen, skip);
+    return pos < 0 ? -1 : (int)(pos + start);
+}
+
+/*
+ * Streaming search over contiguous mmap piece runs: consecutive
+ * unmodified lines still point into the original file mapping back
+ * to back (separated by their newline), so one BMH pass covers the
+ * whole run instead of restarting per line -- first-match latency in
+ * a 100MB log depends on where the match is, not how many lines
+ * precede it.  Returns the line index and sets *col, or -1.
+ */
+static int piece_run_search(int from_line, int from_col,
+                            const char *needle, int *col)
+{
+    int nlen = (int)strlen(needle);
+    int skip[256];
+
+    if (nlen == 0)
+        return -1;
+    bmh_build((const unsigned char *)needle, nlen, skip);
+
+    int i = from_line;
+
+    while (i < num_lines) {
+        struct line *ln = line_at(i);
+        int start = (i == from_line) ? from_col : 0;
+
+        if (start < 0)
+            start = 0;
+
+        if (ln->cap != 0 || start > 0) {
+            /* Heap line (or offset start): search it alone */
+            if (start + nlen <= ln->len) {
+                long pos = bmh_search(ln->data + start,
+                                      ln->len - start,
+                                      (const unsigned char *)needle,
+                                      nlen, skip);
+
+                if (pos >= 0) {
+                    *col = (int)pos + start;
+                    return i;
+                }
+            }
+            i++;
+            continue;
+        }
+
+        /* Extend the contiguous piece run */
+        int run_end = i;
+        const char *base = ln->data;
+        long run_len = ln->len;
+
+        while (run_end + 1 < num_lines) {
+            struct line *next = line_at(run_end + 1);
+
+            if (next->cap != 0 ||
+                next->data != base + run_len + 1)
+                break;          /* Newline then the next piece */
+            run_len += 1 + next->len;
+            run_end++;
+        }
+
+        long pos = bmh_search(base, run_len,
+                              (const unsigned char *)needle, nlen,
+                              skip);
+
+        if (pos >= 0 &&
+            !memchr(needle, '\n', (size_t)nlen)) {
+            /* Map the flat offset back to (line, col) by walking
+             * the run's line lengths */
+            long off = 0;
+            int l = i;
+
+            while (l <= run_end) {
+                struct line *rl = line_at(l);
+
+                if (pos < off + rl->len) {
+                    *col = (int)(pos - off);
+                    return l;
+                }
+                off += rl->len + 1;     /* Skip the newline */
+                l++;
+            }
+            /* Match fell on a newline boundary: step past and
+             * continue from the next line */
+            i = run_end + 1;
+            continue;
+        }
+        if (pos >= 0) {
+            /* Needle contains a newline: out of scope for the
+             * line-based editor; treat as no match in this run */
+        }
+        i = run_end + 1;
+    }
+    return -1;
+}
+
 /*
  * Search forward for a string (Ctrl+W).
  */
@@ -702,14 +1325,15 @@ static void search(void)
         return;
     }
 
-    /* Search forward from current position */
-    for (int i = cy; i < num_lines; i++) {
-        int start = (i == cy) ? cx + 1 : 0;
-        if (start > lines[i].len) continue;
-        char *found = strstr(lines[i].data + start, query);
-        if (found) {
-            cy = i;
-            cx = (int)(found - lines[i].data);
+    /* Search forward from current position: one streaming BMH pass
+     * over contiguous mmap runs */
+    {
+        int pos = -1;
+        int hit = piece_run_search(cy, cx + 1, query, &pos);
+
+        if (hit >= 0) {
+            cy = hit;
+            cx = pos;
             scroll_to_cursor();
             snprintf(status_msg, sizeof(status_msg), "Found at line %d", cy + 1);
             return;
@@ -718,18 +1342,15 @@ static void search(void)
 
     /* Wrap around: search from beginning */
     for (int i = 0; i <= cy; i++) {
-        int end = (i == cy) ? cx : lines[i].len;
-        char *found = strstr(lines[i].data, query);
-        if (found) {
-            int pos = (int)(found - lines[i].data);
-            if (i < cy || pos <= end) {
-                cy = i;
-                cx = pos;
-                scroll_to_cursor();
-                snprintf(status_msg, sizeof(status_msg),
-                         "Found at line %d (wrapped)", cy + 1);
-                return;
-            }
+        int end = (i == cy) ? cx : line_at(i)->len;
+        int pos = line_find(line_at(i), 0, query);
+        if (pos >= 0 && (i < cy || pos <= end)) {
+            cy = i;
+            cx = pos;
+            scroll_to_cursor();
+            snprintf(status_msg, sizeof(status_msg),
+                     "Found at line %d (wrapped)", cy + 1);
+            return;
         }
     }
 
@@ -778,6 +1399,7 @@ static int do_save(void)
  */
 static void show_help(void)
 {
+    all_dirty = 1;   /* the help screen paints over everything */
     clear();
 
     int row = 1;
@@ -879,6 +1501,14 @@ static int handle_key(int ch)
         cut_line();
         break;
 
+    case CTRL('T'):
+        /* Toggle word wrap; caches fill lazily as lines render */
+        wrap_mode = !wrap_mode;
+        col_offset = 0;
+        seg_offset = 0;
+        all_dirty = 1;
+        break;
+
     case CTRL('U'):
         paste_line();
         break;
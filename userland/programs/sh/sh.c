@@ -20,14 +20,21 @@
  *   - Exit status: $?
  *   - Command separator: ;
  *   - Conditional execution: && and ||
+ *   - Interactive line editing: indexed history (Up/Down, Ctrl-R
+ *     prefix search), Tab filename completion with a cached
+ *     directory index
  */
 
+#include <dirent.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <termios.h>
 #include <unistd.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/resource.h>
 #include <sys/wait.h>
 #include <sys/stat.h>
 
@@ -39,6 +46,13 @@
 #define MAX_ARGS    256
 #define MAX_PIPES   16
 
+/*
+ * Background jobs land in their own process group at this nice
+ * level, so a long-running `make &` yields to the compositor and
+ * input handling instead of competing head-to-head.
+ */
+#define BG_NICE     10
+
 /* ========================================================================= */
 /* Global state                                                              */
 /* ========================================================================= */
@@ -66,6 +80,580 @@ static void strip_trailing(char *s)
         s[--len] = '\0';
 }
 
+/* ========================================================================= */
+/* History with prefix index                                                 */
+/* ========================================================================= */
+
+/*
+ * History keeps every line in an append-only array and maintains a
+ * prefix index over it: for each prefix length 1..HIST_PREFIX_MAX
+ * (8), a hash bucket chains entries (most recent first) whose line
+ * starts with that prefix.  Ctrl-R and Up-with-prefix then touch only the
+ * entries that can match, so search cost tracks the number of hits,
+ * not the size of the history -- 50k-line histories on the ops boxes
+ * are the sizing target.
+ */
+
+/* write() a string literal without counting bytes by hand */
+#define WR_LIT(s) write(1, s, sizeof(s) - 1)
+
+#define HIST_MAX        65536
+#define HIST_PREFIX_MAX 8
+#define HIST_BUCKETS    1024    /* Power of two, per prefix length */
+#define HIST_FILE       ".sh_history"
+
+struct hist_entry {
+    char   *line;
+    int32_t prev[HIST_PREFIX_MAX];  /* Older entry with same prefix */
+};
+
+static struct hist_entry hist[HIST_MAX];
+static int hist_count;
+static int32_t hist_buckets[HIST_PREFIX_MAX][HIST_BUCKETS];
+static int hist_loaded;
+
+static uint32_t hist_hash(const char *s, int len)
+{
+    uint32_t h = 2166136261u;
+    int i;
+
+    for (i = 0; i < len; i++) {
+        h ^= (unsigned char)s[i];
+        h *= 16777619u;
+    }
+    return h & (HIST_BUCKETS - 1);
+}
+
+static void hist_add(const char *line)
+{
+    struct hist_entry *e;
+    size_t len = strlen(line);
+    int p;
+
+    if (len == 0 || hist_count == HIST_MAX)
+        return;
+    /* Collapse immediate duplicates (repeated make/ls/...) */
+    if (hist_count > 0 &&
+        strcmp(hist[hist_count - 1].line, line) == 0)
+        return;
+
+    e = &hist[hist_count];
+    e->line = strdup(line);
+    if (!e->line)
+        return;
+
+    for (p = 0; p < HIST_PREFIX_MAX; p++) {
+        int plen = p + 1;
+        uint32_t b;
+
+        if ((size_t)plen > len)
+            break;
+        b = hist_hash(line, plen);
+        e->prev[p] = hist_buckets[p][b];
+        hist_buckets[p][b] = hist_count;
+    }
+    for (; p < HIST_PREFIX_MAX; p++)
+        e->prev[p] = -1;
+    hist_count++;
+}
+
+/*
+ * Most recent entry matching prefix, strictly older than from_idx
+ * (pass hist_count to start at the newest).  Returns an entry index
+ * or -1.  Walks one hash chain; entries without the prefix hash
+ * elsewhere and are never visited.
+ */
+static int hist_search(const char *prefix, int from_idx)
+{
+    size_t plen = strlen(prefix);
+    int p, idx;
+
+    if (hist_count == 0)
+        return -1;
+    if (plen == 0)
+        return from_idx > 0 ? from_idx - 1 : -1;
+
+    p = plen >= HIST_PREFIX_MAX ? HIST_PREFIX_MAX - 1 : (int)plen - 1;
+    idx = hist_buckets[p][hist_hash(prefix, p + 1)];
+    while (idx >= 0) {
+        if (idx < from_idx &&
+            strncmp(hist[idx].line, prefix, plen) == 0)
+            return idx;
+        idx = hist[idx].prev[p];
+    }
+    return -1;
+}
+
+static void hist_file_path(char *buf, size_t len)
+{
+    const char *home = getenv("HOME");
+
+    snprintf(buf, len, "%s/%s", home ? home : "/", HIST_FILE);
+}
+
+static void hist_load(void)
+{
+    char path[1024];
+    char line[MAX_LINE];
+    FILE *fp;
+
+    if (hist_loaded)
+        return;
+    hist_loaded = 1;
+    memset(hist_buckets, -1, sizeof(hist_buckets));
+
+    hist_file_path(path, sizeof(path));
+    fp = fopen(path, "r");
+    if (!fp)
+        return;
+    while (fgets(line, sizeof(line), fp)) {
+        line[strcspn(line, "\n")] = '\0';
+        if (line[0] != '\0')
+            hist_add(line);
+    }
+    fclose(fp);
+}
+
+static void hist_append_file(const char *line)
+{
+    char path[1024];
+    FILE *fp;
+
+    hist_file_path(path, sizeof(path));
+    fp = fopen(path, "a");
+    if (!fp)
+        return;
+    fprintf(fp, "%s\n", line);
+    fclose(fp);
+}
+
+/* ========================================================================= */
+/* Directory-entry cache for completion                                      */
+/* ========================================================================= */
+
+/*
+ * Tab completion reads a directory once and serves every subsequent
+ * press from the cached listing.  A cache slot revalidates against
+ * the directory's mtime on each use; relative-path slots are flushed
+ * wholesale by the cd builtin since their meaning changed.
+ */
+
+#define DCACHE_SLOTS    8
+#define DCACHE_MAX_ENT  1024
+
+struct dcache_slot {
+    char     path[1024];
+    time_t   mtime;
+    char   **names;             /* names[i] has a trailing '/' on dirs */
+    int      count;
+    uint64_t last_used;
+};
+
+static struct dcache_slot dcache[DCACHE_SLOTS];
+static uint64_t dcache_clock;
+
+static void dcache_free_slot(struct dcache_slot *sl)
+{
+    int i;
+
+    for (i = 0; i < sl->count; i++)
+        free(sl->names[i]);
+    free(sl->names);
+    sl->names = NULL;
+    sl->count = 0;
+    sl->path[0] = '\0';
+}
+
+/* cd changes what relative paths mean: drop them */
+static void dcache_flush_relative(void)
+{
+    int i;
+
+    for (i = 0; i < DCACHE_SLOTS; i++)
+        if (dcache[i].names && dcache[i].path[0] != '/')
+            dcache_free_slot(&dcache[i]);
+}
+
+/* Cached listing of dir, (re)read when absent or mtime moved */
+static struct dcache_slot *dcache_get(const char *dir)
+{
+    struct stat st;
+    struct dcache_slot *sl = NULL;
+    struct dcache_slot *victim = &dcache[0];
+    DIR *d;
+    struct dirent *de;
+    int i;
+
+    if (stat(dir, &st) < 0 || !S_ISDIR(st.st_mode))
+        return NULL;
+
+    for (i = 0; i < DCACHE_SLOTS; i++) {
+        if (dcache[i].names && strcmp(dcache[i].path, dir) == 0) {
+            sl = &dcache[i];
+            break;
+        }
+        if (dcache[i].last_used < victim->last_used)
+            victim = &dcache[i];
+    }
+
+    if (sl) {
+        if (sl->mtime == st.st_mtime) {
+            sl->last_used = ++dcache_clock;
+            return sl;          /* Still current */
+        }
+        dcache_free_slot(sl);   /* Stale: re-read below */
+    } else {
+        sl = victim;
+        if (sl->names)
+            dcache_free_slot(sl);
+    }
+
+    d = opendir(dir);
+    if (!d)
+        return NULL;
+    sl->names = calloc(DCACHE_MAX_ENT, sizeof(char *));
+    if (!sl->names) {
+        closedir(d);
+        return NULL;
+    }
+    sl->count = 0;
+    while ((de = readdir(d)) != NULL && sl->count < DCACHE_MAX_ENT) {
+        char full[2048];
+        struct stat est;
+        size_t nlen;
+
+        if (de->d_name[0] == '.' &&
+            (de->d_name[1] == '\0' ||
+             (de->d_name[1] == '.' && de->d_name[2] == '\0')))
+            continue;
+        nlen = strlen(de->d_name);
+        sl->names[sl->count] = malloc(nlen + 2);
+        if (!sl->names[sl->count])
+            break;
+        memcpy(sl->names[sl->count], de->d_name, nlen + 1);
+        snprintf(full, sizeof(full), "%s/%s", dir, de->d_name);
+        if (stat(full, &est) == 0 && S_ISDIR(est.st_mode)) {
+            sl->names[sl->count][nlen] = '/';
+            sl->names[sl->count][nlen + 1] = '\0';
+        }
+        sl->count++;
+    }
+    closedir(d);
+
+    strncpy(sl->path, dir, sizeof(sl->path) - 1);
+    sl->path[sizeof(sl->path) - 1] = '\0';
+    sl->mtime = st.st_mtime;
+    sl->last_used = ++dcache_clock;
+    return sl;
+}
+
+/*
+ * Complete the filename at the end of buf (len chars).  Extends the
+ * common prefix of all matches in place; returns the new length.  On
+ * a second identical request (*again set by the caller), prints the
+ * candidate list.
+ */
+static size_t complete_filename(char *buf, size_t len, size_t cap,
+                                int again)
+{
+    const char *tok = buf + len;
+    char dir[1024];
+    char base[512];
+    size_t baselen, dirlen;
+    struct dcache_slot *sl;
+    const char *common = NULL;
+    size_t common_len = 0;
+    int matches = 0;
+    int i;
+
+    /* Token = everything after the last unquoted space */
+    while (tok > buf && tok[-1] != ' ' && tok[-1] != '\t')
+        tok--;
+
+    /* Split into directory part and basename prefix */
+    {
+        const char *slash = strrchr(tok, '/');
+
+        if (slash) {
+            dirlen = (size_t)(slash - tok);
+            if (dirlen == 0) {
+                strcpy(dir, "/");
+            } else if (dirlen < sizeof(dir)) {
+                memcpy(dir, tok, dirlen);
+                dir[dirlen] = '\0';
+            } else {
+                return len;
+            }
+            snprintf(base, sizeof(base), "%s", slash + 1);
+        } else {
+            strcpy(dir, ".");
+            snprintf(base, sizeof(base), "%s", tok);
+        }
+    }
+    baselen = strlen(base);
+
+    sl = dcache_get(dir);
+    if (!sl)
+        return len;
+
+    for (i = 0; i < sl->count; i++) {
+        if (strncmp(sl->names[i], base, baselen) != 0)
+            continue;
+        if (!matches) {
+            common = sl->names[i];
+            common_len = strlen(sl->names[i]);
+        } else {
+            size_t j = 0;
+
+            while (j < common_len && sl->names[i][j] == common[j])
+                j++;
+            common_len = j;
+        }
+        matches++;
+    }
+
+    if (matches == 0)
+        return len;
+
+    if (matches > 1 && again) {
+        /* Second Tab: list the candidates */
+        WR_LIT("\r\n");
+        for (i = 0; i < sl->count; i++) {
+            if (strncmp(sl->names[i], base, baselen) != 0)
+                continue;
+            write(1, sl->names[i], strlen(sl->names[i]));
+            WR_LIT("  ");
+        }
+        WR_LIT("\r\n");
+    }
+
+    /* Extend the buffer by the shared remainder */
+    if (common_len > baselen) {
+        size_t add = common_len - baselen;
+
+        if (len + add < cap - 1) {
+            memcpy(buf + len, common + baselen, add);
+            len += add;
+            buf[len] = '\0';
+        }
+    }
+    /* A unique non-directory match also terminates the token */
+    if (matches == 1 && common && common_len > 0 &&
+        common[common_len - 1] != '/' && len + 1 < cap - 1) {
+        buf[len++] = ' ';
+        buf[len] = '\0';
+    }
+    return len;
+}
+
+/* ========================================================================= */
+/* Interactive line editor                                                   */
+/* ========================================================================= */
+
+/* Redraw the prompt and current buffer on one line */
+static void redraw_line(const char *prompt, const char *buf)
+{
+    WR_LIT("\r\033[K");
+    write(1, prompt, strlen(prompt));
+    write(1, buf, strlen(buf));
+}
+
+/*
+ * Read one line with editing, history, and completion.  Returns the
+ * length, or -1 on EOF.  Falls back to a plain blocking read when
+ * the terminal can't enter raw mode.
+ */
+static int vsh_readline(const char *prompt, char *buf, size_t cap)
+{
+    struct termios orig, raw;
+    size_t len = 0;
+    int hist_pos;               /* hist_count = editing a fresh line */
+    int last_was_tab = 0;
+    char saved[MAX_LINE];       /* Line stashed while browsing history */
+    int search_mode = 0;
+    char search[128];
+    size_t search_len = 0;
+
+    hist_load();
+    hist_pos = hist_count;
+    saved[0] = '\0';
+    buf[0] = '\0';
+
+    if (tcgetattr(0, &orig) < 0) {
+        /* Not a terminal we can edit on: plain line input */
+        write(1, prompt, strlen(prompt));
+        if (!fgets(buf, (int)cap, stdin))
+            return -1;
+        buf[strcspn(buf, "\n")] = '\0';
+        return (int)strlen(buf);
+    }
+    raw = orig;
+    raw.c_lflag &= ~(unsigned)(ICANON | ECHO);
+    raw.c_cc[VMIN] = 1;
+    raw.c_cc[VTIME] = 0;
+    if (tcsetattr(0, TCSANOW, &raw) < 0) {
+        write(1, prompt, strlen(prompt));
+        if (!fgets(buf, (int)cap, stdin))
+            return -1;
+        buf[strcspn(buf, "\n")] = '\0';
+        return (int)strlen(buf);
+    }
+
+    write(1, prompt, strlen(prompt));
+
+    for (;;) {
+        unsigned char c;
+        ssize_t rd = read(0, &c, 1);
+
+        if (rd <= 0) {
+            tcsetattr(0, TCSANOW, &orig);
+            return len > 0 ? (int)len : -1;
+        }
+
+        if (search_mode) {
+            if (c == 0x12) {            /* Ctrl-R again: older match */
+                int idx = hist_search(search, hist_pos);
+
+                if (idx >= 0) {
+                    hist_pos = idx;
+                    snprintf(buf, cap, "%s", hist[idx].line);
+                    len = strlen(buf);
+                }
+            } else if (c == 0x7f || c == 0x08) {
+                if (search_len > 0)
+                    search[--search_len] = '\0';
+            } else if (c >= 0x20 && c < 0x7f) {
+                if (search_len < sizeof(search) - 1) {
+                    search[search_len++] = (char)c;
+                    search[search_len] = '\0';
+                }
+            } else {
+                /* Any control key leaves search, keeping the line */
+                search_mode = 0;
+                redraw_line(prompt, buf);
+                if (c == '\n' || c == '\r')
+                    goto accept;
+                continue;
+            }
+            {
+                int idx = hist_search(search, hist_count);
+
+                if (idx >= 0) {
+                    hist_pos = idx;
+                    snprintf(buf, cap, "%s", hist[idx].line);
+                    len = strlen(buf);
+                }
+            }
+            WR_LIT("\r\033[K(reverse-i-search)`");
+            write(1, search, search_len);
+            WR_LIT("': ");
+            write(1, buf, len);
+            continue;
+        }
+
+        switch (c) {
+        case '\n':
+        case '\r':
+accept:
+            tcsetattr(0, TCSANOW, &orig);
+            WR_LIT("\r\n");
+            buf[len] = '\0';
+            return (int)len;
+
+        case 0x04:                      /* Ctrl-D */
+            if (len == 0) {
+                tcsetattr(0, TCSANOW, &orig);
+                return -1;
+            }
+            break;
+
+        case 0x03:                      /* Ctrl-C: drop the line */
+            len = 0;
+            buf[0] = '\0';
+            hist_pos = hist_count;
+            WR_LIT("^C\r\n");
+            redraw_line(prompt, buf);
+            break;
+
+        case 0x15:                      /* Ctrl-U */
+            len = 0;
+            buf[0] = '\0';
+            redraw_line(prompt, buf);
+            break;
+
+        case 0x7f:                      /* Backspace */
+        case 0x08:
+            if (len > 0) {
+                buf[--len] = '\0';
+                redraw_line(prompt, buf);
+            }
+            break;
+
+        case 0x12:                      /* Ctrl-R: prefix search */
+            search_mode = 1;
+            search_len = 0;
+            search[0] = '\0';
+            hist_pos = hist_count;
+            WR_LIT("\r\033[K(reverse-i-search)`': ");
+            write(1, buf, len);
+            break;
+
+        case '\t': {
+            size_t newlen =
+                complete_filename(buf, len, cap, last_was_tab);
+
+            len = newlen;
+            redraw_line(prompt, buf);
+            last_was_tab = 2;           /* Decremented below */
+            break;
+        }
+
+        case 0x1b: {                    /* ESC [ A/B: history */
+            unsigned char seq[2];
+
+            if (read(0, seq, 1) != 1 || seq[0] != '[' ||
+                read(0, seq + 1, 1) != 1)
+                break;
+            if (seq[1] == 'A') {        /* Up: older */
+                int idx;
+
+                if (hist_pos == hist_count)
+                    snprintf(saved, sizeof(saved), "%s", buf);
+                idx = hist_search("", hist_pos);
+                if (idx >= 0) {
+                    hist_pos = idx;
+                    snprintf(buf, cap, "%s", hist[idx].line);
+                    len = strlen(buf);
+                    redraw_line(prompt, buf);
+                }
+            } else if (seq[1] == 'B') { /* Down: newer */
+                if (hist_pos < hist_count) {
+                    hist_pos++;
+                    if (hist_pos == hist_count)
+                        snprintf(buf, cap, "%s", saved);
+                    else
+                        snprintf(buf, cap, "%s", hist[hist_pos].line);
+                    len = strlen(buf);
+                    redraw_line(prompt, buf);
+                }
+            }
+            break;
+        }
+
+        default:
+            if (c >= 0x20 && c < 0x7f && len < cap - 1) {
+                buf[len++] = (char)c;
+                buf[len] = '\0';
+                write(1, &c, 1);
+            }
+            break;
+        }
+
+        if (last_was_tab > 0)
+            last_was_tab--;
+    }
+}
+
 /* ========================================================================= */
 /* Variable expansion                                                        */
 /* ========================================================================= */
@@ -386,6 +974,7 @@ static int try_builtin(int argc, char **argv)
             fprintf(stderr, "cd: %s: %s\n", dir, strerror(errno));
             last_exit_status = 1;
         } else {
+            dcache_flush_relative();
             last_exit_status = 0;
         }
         return 1;
@@ -512,6 +1101,53 @@ static int try_builtin(int argc, char **argv)
 /* Command execution                                                         */
 /* ========================================================================= */
 
+/*
+ * Builtins with no effect on shell state.  Only these may run
+ * in-process inside a pipeline -- POSIX gives each stage subshell
+ * semantics, so cd/export/unset/exec must still fork.
+ */
+static int builtin_is_pure(const char *cmd)
+{
+    return strcmp(cmd, "echo") == 0 || strcmp(cmd, "pwd") == 0 ||
+           strcmp(cmd, "true") == 0 || strcmp(cmd, "false") == 0 ||
+           strcmp(cmd, "test") == 0 || strcmp(cmd, "[") == 0;
+}
+
+/*
+ * Copy one fd to another with SYS_FILE_SPLICE, falling back to a
+ * read/write loop on kernels without it.  Returns the exit status.
+ */
+static int copy_fd_splice(int in_fd, int out_fd)
+{
+    for (;;) {
+        ssize_t n = splice(in_fd, NULL, out_fd, NULL, 1 << 20, 0);
+
+        if (n == 0)
+            return 0;
+        if (n > 0)
+            continue;
+        break;          /* Error: try the portable loop */
+    }
+
+    for (;;) {
+        char buf[65536];
+        ssize_t rd = read(in_fd, buf, sizeof(buf));
+        ssize_t off = 0;
+
+        if (rd == 0)
+            return 0;
+        if (rd < 0)
+            return 1;
+        while (off < rd) {
+            ssize_t wr = write(out_fd, buf + off, (size_t)(rd - off));
+
+            if (wr <= 0)
+                return 1;
+            off += wr;
+        }
+    }
+}
+
 /*
  * Execute a single simple command (no pipes).
  * Handles builtins, fork/exec, background, and redirections.
@@ -531,6 +1167,40 @@ static int exec_simple(char **argv, int argc, int background)
             return last_exit_status;
     }
 
+    /*
+     * cat between two real fds never needs a process: open both ends
+     * here and splice.  Covers `cat SRC > DST` and `cat < SRC > DST`,
+     * the shapes provisioning scripts hit in tight loops.
+     */
+    if (!background && strcmp(argv[0], "cat") == 0 && !redir.err_file &&
+        redir.out_file && (argc == 1 || (argc == 2 && !redir.in_file))) {
+        const char *src = argc == 2 ? argv[1] : redir.in_file;
+        int in_fd = src ? open(src, O_RDONLY) : 0;
+        int out_fd;
+        int status;
+
+        if (in_fd < 0) {
+            fprintf(stderr, "cat: %s: %s\n", src, strerror(errno));
+            return 1;
+        }
+        out_fd = open(redir.out_file,
+                      O_WRONLY | O_CREAT |
+                          (redir.out_append ? O_APPEND : O_TRUNC),
+                      0644);
+        if (out_fd < 0) {
+            fprintf(stderr, "sh: %s: %s\n", redir.out_file,
+                    strerror(errno));
+            if (in_fd > 0)
+                close(in_fd);
+            return 1;
+        }
+        status = copy_fd_splice(in_fd, out_fd);
+        if (in_fd > 0)
+            close(in_fd);
+        close(out_fd);
+        return status;
+    }
+
     pid_t pid = fork();
     if (pid < 0) {
         fprintf(stderr, "sh: fork: %s\n", strerror(errno));
@@ -539,6 +1209,13 @@ static int exec_simple(char **argv, int argc, int background)
 
     if (pid == 0) {
         /* Child */
+        if (background) {
+            /* Own group, demoted: the group tag covers anything the
+             * job forks in turn (both sides set the pgid -- whoever
+             * runs first wins the race) */
+            setpgid(0, 0);
+            setpriority(PRIO_PGRP, (id_t)getpid(), BG_NICE);
+        }
         apply_redirections(&redir);
 
         /* Builtins with redirections need to run in child */
@@ -559,7 +1236,8 @@ static int exec_simple(char **argv, int argc, int background)
 
     /* Parent */
     if (background) {
-        /* Don't wait */
+        setpgid(pid, pid);
+        setpriority(PRIO_PGRP, (id_t)pid, BG_NICE);
         return 0;
     }
 
@@ -595,6 +1273,119 @@ static int exec_pipeline(char **segments, int nseg)
         return exec_simple(argv, argc, bg);
     }
 
+    /* Trailing '&' on the last segment backgrounds the pipeline */
+    int pipeline_bg = 0;
+    {
+        char *last = segments[nseg - 1];
+        size_t llen = strlen(last);
+
+        while (llen > 0 &&
+               (last[llen - 1] == ' ' || last[llen - 1] == '\t'))
+            last[--llen] = '\0';
+        if (llen > 0 && last[llen - 1] == '&' &&
+            (llen == 1 || last[llen - 2] != '&')) {
+            last[llen - 1] = '\0';
+            pipeline_bg = 1;
+        }
+    }
+
+    /*
+     * Classify the segments without disturbing them (tokenize
+     * mutates, and the fork path re-tokenizes in each child).  A
+     * pipeline made purely of side-effect-free builtins runs
+     * in-process below; a bare `cat` stage is elided from the fork
+     * path since a pass-through filter is just its input fd.
+     */
+    int all_pure = 1;
+    int is_passthrough[MAX_PIPES];
+
+    for (int i = 0; i < nseg && i < MAX_PIPES; i++) {
+        char copy[MAX_LINE];
+        char *cargv[MAX_ARGS];
+        int cargc;
+
+        snprintf(copy, sizeof(copy), "%s", segments[i]);
+        cargc = tokenize(copy, cargv, MAX_ARGS);
+        is_passthrough[i] = cargc == 1 && strcmp(cargv[0], "cat") == 0;
+
+        if (cargc == 0 || !builtin_is_pure(cargv[0]))
+            all_pure = 0;
+        for (int j = 0; j < cargc; j++)
+            if (cargv[j][0] == '<' || cargv[j][0] == '>' ||
+                (cargv[j][0] == '2' && cargv[j][1] == '>'))
+                all_pure = 0;   /* Redirections keep the fork path */
+    }
+
+    if (all_pure && !pipeline_bg && nseg <= MAX_PIPES) {
+        /*
+         * Builtin-only pipeline: run the stages sequentially in this
+         * process, buffering each stage's output in a kernel pipe
+         * and presenting it as the next stage's stdin.  No forks.
+         * The builtins here emit at most a few lines, so a pipe's
+         * capacity is never a concern.
+         */
+        int saved_in = dup(0);
+        int saved_out = dup(1);
+        int in_fd = -1;
+        int status = 0;
+
+        for (int i = 0; i < nseg; i++) {
+            char copy[MAX_LINE];
+            char *cargv[MAX_ARGS];
+            int cargc;
+            int outpipe[2] = { -1, -1 };
+
+            snprintf(copy, sizeof(copy), "%s", segments[i]);
+            cargc = tokenize(copy, cargv, MAX_ARGS);
+
+            if (in_fd >= 0)
+                dup2(in_fd, 0);
+            if (i < nseg - 1) {
+                if (pipe(outpipe) < 0)
+                    break;
+                dup2(outpipe[1], 1);
+            }
+
+            try_builtin(cargc, cargv);
+            status = last_exit_status;
+
+            /* Restore stdio before touching the pipes */
+            dup2(saved_out, 1);
+            dup2(saved_in, 0);
+            if (in_fd >= 0)
+                close(in_fd);
+            if (outpipe[1] >= 0)
+                close(outpipe[1]);
+            in_fd = outpipe[0];
+        }
+        if (in_fd >= 0)
+            close(in_fd);
+        close(saved_in);
+        close(saved_out);
+        return status;
+    }
+
+    /*
+     * Elide pass-through stages: `a | cat | b` wires a's pipe to b
+     * directly, and a trailing `| cat` lets the previous stage keep
+     * the terminal's stdout.  A `cat`-only pipeline keeps one stage.
+     */
+    int last_elided = 0;
+    {
+        int kept = 0;
+
+        for (int i = 0; i < nseg; i++) {
+            if (i < MAX_PIPES && is_passthrough[i] &&
+                !(kept == 0 && i == nseg - 1)) {
+                if (i == nseg - 1)
+                    last_elided = 1;
+                continue;
+            }
+            segments[kept++] = segments[i];
+        }
+        nseg = kept;
+    }
+
     /* Multiple segments: create pipes */
     int pipefd[2];
     int prev_read = -1;
@@ -617,6 +1408,14 @@ static int exec_pipeline(char **segments, int nseg)
 
         if (pid == 0) {
             /* Child */
+            if (pipeline_bg) {
+                /* All stages join the first stage's group.  Each
+                 * demotes itself too: a group tag only reaches
+                 * processes already in the group, and siblings join
+                 * at their own pace */
+                setpgid(0, i == 0 ? 0 : pids[0]);
+                setpriority(PRIO_PROCESS, 0, BG_NICE);
+            }
             if (prev_read >= 0) {
                 dup2(prev_read, 0);
                 close(prev_read);
@@ -654,6 +1453,11 @@ static int exec_pipeline(char **segments, int nseg)
         }
 
         pids[i] = pid;
+        if (pipeline_bg) {
+            setpgid(pid, pids[0]);
+            if (i == 0)
+                setpriority(PRIO_PGRP, (id_t)pids[0], BG_NICE);
+        }
 
         /* Close pipe ends in parent */
         if (prev_read >= 0)
@@ -664,6 +1468,10 @@ static int exec_pipeline(char **segments, int nseg)
         }
     }
 
+    /* Background pipeline: hand the terminal back immediately */
+    if (pipeline_bg)
+        return 0;
+
     /* Wait for all children */
     int status = 0;
     for (int i = 0; i < nseg; i++) {
@@ -678,7 +1486,7 @@ static int exec_pipeline(char **segments, int nseg)
         }
     }
 
-    return status;
+    return last_elided ? 0 : status;
 }
 
 /* ========================================================================= */
@@ -755,8 +1563,10 @@ static void execute_line(char *line)
         while (*pp) {
             if (*pp == '\'' && !in_dq) {
                 in_sq = !in_sq;
+                pp++;
             } else if (*pp == '"' && !in_sq) {
                 in_dq = !in_dq;
+                pp++;
             } else if (!in_sq && !in_dq && *pp == '|' && pp[1] != '|') {
                 *pp = '\0';
                 pp++;
@@ -843,17 +1653,21 @@ int main(int argc, char *argv[])
     char line[MAX_LINE];
     for (;;) {
         if (interactive) {
-            const char *prompt = "$ ";
-            write(1, prompt, 2);
+            if (vsh_readline("$ ", line, sizeof(line)) < 0)
+                break;
+        } else {
+            if (!fgets(line, sizeof(line), stdin))
+                break;
         }
 
-        if (!fgets(line, sizeof(line), stdin))
-            break;
-
         strip_trailing(line);
         if (line[0] == '\0' || line[0] == '#')
             continue;
 
+        if (interactive) {
+            hist_add(line);
+            hist_append_file(line);
+        }
         execute_line(line);
     }
 
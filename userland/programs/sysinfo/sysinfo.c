@@ -16,11 +16,14 @@
  *   uname()        -- OS name, release, arch, hostname
  */
 
+#include <dirent.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 #include <sys/utsname.h>
+#include <veridian/perfcount.h>
+#include <veridian/sysmon.h>
 
 /* ========================================================================= */
 /* ANSI escape codes                                                         */
@@ -196,16 +199,282 @@ static void format_color_bar(char *buf, int size)
     buf[size - 1] = '\0';
 }
 
+/* ========================================================================= */
+/* Continuous monitoring (--monitor / --live)                                */
+/* ========================================================================= */
+
+/*
+ * --monitor [ms] samples CPU, memory, and process stats at the
+ * given cadence into the shared sysmon ring; --live (and any other
+ * reader, e.g. the Plasma system monitor applet) prints from the
+ * ring without touching /proc.  The old exec-sysinfo-every-5s
+ * pattern paid process spawn plus a full enumeration per data
+ * point; a reader now costs one page read.
+ */
+
+static uint64_t monitor_read_u64(const char *path, const char *key)
+{
+    char buf[256];
+
+    if (key) {
+        if (parse_proc_value(path, key, buf, sizeof(buf)) != 0)
+            return 0;
+    } else {
+        if (read_proc_line(path, buf, sizeof(buf)) != 0)
+            return 0;
+    }
+    return (uint64_t)atol(buf);
+}
+
+/* Busy permille since the previous /proc/stat reading */
+static uint32_t monitor_cpu_busy(uint64_t *prev_busy, uint64_t *prev_total)
+{
+    char buf[256];
+    uint64_t vals[8];
+    int n = 0;
+
+    if (read_proc_line("/proc/stat", buf, sizeof(buf)) != 0)
+        return 0;
+
+    /* "cpu  user nice system idle iowait irq softirq" */
+    const char *p = buf + 3;
+    while (n < 8) {
+        while (*p == ' ')
+            p++;
+        if (*p < '0' || *p > '9')
+            break;
+        vals[n++] = (uint64_t)atol(p);
+        while (*p >= '0' && *p <= '9')
+            p++;
+    }
+    if (n < 4)
+        return 0;
+
+    uint64_t idle = vals[3] + (n > 4 ? vals[4] : 0);
+    uint64_t total = 0;
+    for (int i = 0; i < n; i++)
+        total += vals[i];
+
+    uint64_t busy = total - idle;
+    uint64_t d_total = total - *prev_total;
+    uint64_t d_busy = busy - *prev_busy;
+
+    *prev_total = total;
+    *prev_busy = busy;
+    if (d_total == 0)
+        return 0;
+    return (uint32_t)(d_busy * 1000 / d_total);
+}
+
+static uint32_t monitor_process_count(void)
+{
+    DIR *d = opendir("/proc");
+    struct dirent *de;
+    uint32_t count = 0;
+
+    if (!d)
+        return 0;
+    while ((de = readdir(d)) != NULL) {
+        if (de->d_name[0] >= '0' && de->d_name[0] <= '9')
+            count++;
+    }
+    closedir(d);
+    return count;
+}
+
+static int monitor_mode(const char *interval_arg)
+{
+    uint32_t interval_ms = interval_arg ? (uint32_t)atoi(interval_arg)
+                                        : 1000;
+    uint64_t prev_busy = 0, prev_total = 0;
+
+    if (interval_ms < 100)
+        interval_ms = 100;
+
+    if (vsm_publish_open(interval_ms) < 0) {
+        fprintf(stderr, "sysinfo: cannot create monitoring ring\n");
+        return 1;
+    }
+
+    fprintf(stderr, "sysinfo: monitoring every %ums\n", interval_ms);
+    monitor_cpu_busy(&prev_busy, &prev_total);  /* Prime the delta */
+
+    for (;;) {
+        struct vsm_sample s;
+        struct timespec ts;
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        s.ts_ns = (uint64_t)ts.tv_sec * 1000000000ull +
+                  (uint64_t)ts.tv_nsec;
+        s.uptime_sec = monitor_read_u64("/proc/uptime", NULL);
+        s.mem_total_kb = monitor_read_u64("/proc/meminfo", "MemTotal");
+        s.mem_free_kb = monitor_read_u64("/proc/meminfo", "MemFree");
+        s.cpu_busy_pct_x10 = monitor_cpu_busy(&prev_busy, &prev_total);
+        s.process_count = monitor_process_count();
+        {
+            char buf[64];
+
+            s.load_x100 = 0;
+            if (read_proc_line("/proc/loadavg", buf, sizeof(buf)) == 0) {
+                /* "1.23 ..." -> 123 */
+                long whole = atol(buf);
+                const char *dot = strchr(buf, '.');
+                long frac = dot ? (dot[1] - '0') * 10 +
+                                  (dot[2] >= '0' && dot[2] <= '9'
+                                       ? dot[2] - '0' : 0)
+                                : 0;
+
+                s.load_x100 = (uint32_t)(whole * 100 + frac);
+            }
+        }
+        s._pad = 0;
+
+        vsm_publish(&s);
+        usleep(interval_ms * 1000);
+    }
+    return 0;
+}
+
+static int live_mode(void)
+{
+    const struct vsm_ring *ring = vsm_attach();
+    struct vsm_sample s;
+
+    if (!ring || vsm_read_latest(ring, &s) < 0) {
+        fprintf(stderr, "sysinfo: no monitor running "
+                "(start with: sysinfo --monitor)\n");
+        return 1;
+    }
+
+    printf("CPU busy:  %u.%u%%\n", s.cpu_busy_pct_x10 / 10,
+           s.cpu_busy_pct_x10 % 10);
+    printf("Memory:    %llu / %llu MB free\n",
+           (unsigned long long)(s.mem_free_kb / 1024),
+           (unsigned long long)(s.mem_total_kb / 1024));
+    printf("Processes: %u\n", s.process_count);
+    printf("Load:      %u.%02u\n", s.load_x100 / 100,
+           s.load_x100 % 100);
+    printf("Uptime:    %llus\n", (unsigned long long)s.uptime_sec);
+    {
+        struct timespec ts;
+        uint64_t now;
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        now = (uint64_t)ts.tv_sec * 1000000000ull +
+              (uint64_t)ts.tv_nsec;
+        printf("Sampled:   %llums ago (interval %ums)\n",
+               (unsigned long long)((now - s.ts_ns) / 1000000ull),
+               ring->interval_ms);
+    }
+    return 0;
+}
+
+/* ========================================================================= */
+/* Performance counter sampling (--perf)                                     */
+/* ========================================================================= */
+
+/*
+ * Dump one process's counter page.  Values are read live from the
+ * shared mapping; the instrumented process is never stopped.
+ */
+static void perf_dump_page(const struct vpc_page *p)
+{
+    int i, b;
+
+    printf("pid %u:\n", p->pid);
+    for (i = 0; i < VPC_MAX_COUNTERS; i++) {
+        if (p->counters[i].name[0] == '\0')
+            continue;
+        printf("  %-24.24s %llu\n", p->counters[i].name,
+               (unsigned long long)p->counters[i].value);
+    }
+    for (i = 0; i < VPC_MAX_HISTS; i++) {
+        const struct vpc_hist *h = &p->hists[i];
+
+        if (h->name[0] == '\0')
+            continue;
+        printf("  %-24.24s n=%llu avg=%lluus  [", h->name,
+               (unsigned long long)h->count,
+               (unsigned long long)(h->count
+                   ? h->sum_ns / h->count / 1000
+                   : 0));
+        for (b = 0; b < VPC_HIST_BUCKETS; b++) {
+            if (h->buckets[b])
+                printf(" %dus:%llu", 1 << b,
+                       (unsigned long long)h->buckets[b]);
+        }
+        printf(" ]\n");
+    }
+}
+
+/* Dump every live perf page (or one pid when given) */
+static int perf_mode(const char *pid_arg)
+{
+    if (pid_arg) {
+        const struct vpc_page *p = vpc_attach(atoi(pid_arg));
+
+        if (!p) {
+            fprintf(stderr, "sysinfo: no perf page for pid %s\n",
+                    pid_arg);
+            return 1;
+        }
+        perf_dump_page(p);
+        vpc_detach(p);
+        return 0;
+    }
+
+    {
+        DIR *dir = opendir(vpc_directory());
+        struct dirent *de;
+        int found = 0;
+
+        if (!dir) {
+            fprintf(stderr, "sysinfo: no perf pages (%s)\n",
+                    vpc_directory());
+            return 1;
+        }
+        while ((de = readdir(dir)) != NULL) {
+            int pid = atoi(de->d_name);
+
+            if (pid > 0) {
+                const struct vpc_page *p = vpc_attach(pid);
+
+                if (p) {
+                    perf_dump_page(p);
+                    vpc_detach(p);
+                    found = 1;
+                }
+            }
+        }
+        closedir(dir);
+        if (!found)
+            printf("no perf pages\n");
+        return 0;
+    }
+}
+
 /* ========================================================================= */
 /* main                                                                      */
 /* ========================================================================= */
 
-int main(void)
+int main(int argc, char **argv)
 {
     struct utsname uts;
     char buf[256];
     char buf2[256];
 
+    /* --perf [pid]: sample live performance counter pages */
+    if (argc > 1 && strcmp(argv[1], "--perf") == 0)
+        return perf_mode(argc > 2 ? argv[2] : NULL);
+
+    /* --monitor [ms]: sample into the shared ring forever */
+    if (argc > 1 && strcmp(argv[1], "--monitor") == 0)
+        return monitor_mode(argc > 2 ? argv[2] : NULL);
+
+    /* --live: print from the ring, no /proc collection */
+    if (argc > 1 && strcmp(argv[1], "--live") == 0)
+        return live_mode();
+
     /* ---- Collect system information ------------------------------------ */
 
     /* Title line: user@hostname */
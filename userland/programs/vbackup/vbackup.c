@@ -0,0 +1,553 @@
+/*
+ * VeridianOS -- vbackup
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Incremental snapshot tool for user config trees (session state,
+ * the vpkg database, the akonadi store).
+ *
+ * Each run compares the source tree against the manifest the
+ * previous run left behind: files whose mtime and size both match
+ * are skipped with nothing but a stat, so runtime scales with the
+ * change rate, not the tree size.  Changed and new files are
+ * content-hashed (FNV-1a) to suppress touch-only rewrites and
+ * packed into a delta archive -- the same VPK1 container vpkg
+ * extracts, entries deflate-compressed -- alongside tombstone
+ * records for deletions.  Restore replays the delta chain in
+ * sequence number order.
+ *
+ * Usage:
+ *   vbackup snapshot <src-dir> <backup-dir>
+ *   vbackup restore  <backup-dir> <dest-dir>
+ */
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <zlib.h>
+
+#define VBK_MAGIC       0x314b5056u     /* "VPK1": vpkg's container */
+#define VBK_MAX_PATH    1024
+#define VBK_MAX_FILES   8192
+#define VBK_TOMBSTONE   0x8000          /* Mode flag: deletion record */
+
+/* ========================================================================= */
+/* Manifest                                                                  */
+/* ========================================================================= */
+
+/*
+ * One line per tracked file: "<mtime> <size> <hash> <path>".  Loaded
+ * wholesale into memory; 8k entries covers config trees with a wide
+ * margin.
+ */
+
+struct vbk_entry {
+    char     path[VBK_MAX_PATH];
+    int64_t  mtime;
+    uint64_t size;
+    uint64_t hash;
+    int      seen;              /* Present in the current tree walk */
+};
+
+static struct vbk_entry g_manifest[VBK_MAX_FILES];
+static int g_manifest_count;
+
+static struct vbk_entry *manifest_find(const char *path)
+{
+    for (int i = 0; i < g_manifest_count; i++) {
+        if (strcmp(g_manifest[i].path, path) == 0)
+            return &g_manifest[i];
+    }
+    return NULL;
+}
+
+static int manifest_load(const char *backup_dir)
+{
+    char path[VBK_MAX_PATH];
+    char line[VBK_MAX_PATH + 128];
+    FILE *fp;
+
+    g_manifest_count = 0;
+    snprintf(path, sizeof(path), "%s/manifest", backup_dir);
+    fp = fopen(path, "r");
+    if (!fp)
+        return 0;               /* First run: empty manifest */
+
+    while (fgets(line, sizeof(line), fp) &&
+           g_manifest_count < VBK_MAX_FILES) {
+        struct vbk_entry *e = &g_manifest[g_manifest_count];
+        long long mtime;
+        unsigned long long size, hash;
+        int consumed = 0;
+
+        if (sscanf(line, "%lld %llu %llx %n", &mtime, &size, &hash,
+                   &consumed) != 3)
+            continue;
+        e->mtime = (int64_t)mtime;
+        e->size = (uint64_t)size;
+        e->hash = (uint64_t)hash;
+        e->seen = 0;
+        snprintf(e->path, sizeof(e->path), "%s", line + consumed);
+        e->path[strcspn(e->path, "\n")] = '\0';
+        if (e->path[0] != '\0')
+            g_manifest_count++;
+    }
+    fclose(fp);
+    return g_manifest_count;
+}
+
+static int manifest_save(const char *backup_dir)
+{
+    char path[VBK_MAX_PATH], tmp[VBK_MAX_PATH + 8];
+    FILE *fp;
+
+    snprintf(path, sizeof(path), "%s/manifest", backup_dir);
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    fp = fopen(tmp, "w");
+    if (!fp)
+        return -1;
+
+    for (int i = 0; i < g_manifest_count; i++) {
+        struct vbk_entry *e = &g_manifest[i];
+
+        if (!e->seen)
+            continue;           /* Deleted: drops out of the manifest */
+        fprintf(fp, "%lld %llu %llx %s\n", (long long)e->mtime,
+                (unsigned long long)e->size,
+                (unsigned long long)e->hash, e->path);
+    }
+    if (fflush(fp) != 0 || fsync(fileno(fp)) < 0) {
+        fclose(fp);
+        unlink(tmp);
+        return -1;
+    }
+    fclose(fp);
+    return rename(tmp, path);
+}
+
+/* ========================================================================= */
+/* Content hashing                                                           */
+/* ========================================================================= */
+
+static uint64_t hash_file(const char *path)
+{
+    uint8_t buf[65536];
+    uint64_t h = 14695981039346656037ull;
+    ssize_t rd;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+        return 0;
+    while ((rd = read(fd, buf, sizeof(buf))) > 0) {
+        for (ssize_t i = 0; i < rd; i++) {
+            h ^= buf[i];
+            h *= 1099511628211ull;
+        }
+    }
+    close(fd);
+    return h ? h : 1;
+}
+
+/* ========================================================================= */
+/* Delta archive writer (VPK1 entries, deflated)                             */
+/* ========================================================================= */
+
+struct vbk_writer {
+    FILE    *fp;
+    uint32_t entries;
+};
+
+static int archive_open(struct vbk_writer *w, const char *backup_dir,
+                        uint32_t seq)
+{
+    char path[VBK_MAX_PATH];
+    uint32_t magic = VBK_MAGIC;
+
+    snprintf(path, sizeof(path), "%s/delta-%06u.vbk", backup_dir, seq);
+    w->fp = fopen(path, "wb");
+    if (!w->fp)
+        return -1;
+    w->entries = 0;
+    fwrite(&magic, 4, 1, w->fp);
+    return 0;
+}
+
+/* VPK1 entry header, as extract.c reads it */
+struct vbk_rec {
+    uint16_t path_len;
+    uint16_t mode;
+    uint32_t reserved;
+    uint64_t size;
+    uint64_t comp_size;
+};
+
+static int archive_add_file(struct vbk_writer *w, const char *rel,
+                            const char *full, uint64_t size, mode_t mode)
+{
+    struct vbk_rec rec;
+    uint8_t *raw = NULL, *comp = NULL;
+    unsigned long comp_len;
+    int rc = -1;
+    int fd;
+
+    raw = malloc(size ? size : 1);
+    comp_len = compressBound((unsigned long)size);
+    comp = malloc(comp_len ? comp_len : 1);
+    if (!raw || !comp)
+        goto out;
+
+    fd = open(full, O_RDONLY);
+    if (fd < 0)
+        goto out;
+    if (size > 0 && read(fd, raw, size) != (ssize_t)size) {
+        close(fd);
+        goto out;
+    }
+    close(fd);
+
+    if (compress2(comp, &comp_len, raw, (unsigned long)size, 6) != Z_OK)
+        goto out;
+
+    memset(&rec, 0, sizeof(rec));
+    rec.path_len = (uint16_t)strlen(rel);
+    rec.mode = (uint16_t)(mode & 07777);
+    rec.size = size;
+    rec.comp_size = (uint64_t)comp_len;
+
+    fwrite(&rec, sizeof(rec), 1, w->fp);
+    fwrite(rel, rec.path_len, 1, w->fp);
+    fwrite(comp, comp_len, 1, w->fp);
+    w->entries++;
+    rc = 0;
+out:
+    free(raw);
+    free(comp);
+    return rc;
+}
+
+static void archive_add_tombstone(struct vbk_writer *w, const char *rel)
+{
+    struct vbk_rec rec;
+
+    memset(&rec, 0, sizeof(rec));
+    rec.path_len = (uint16_t)strlen(rel);
+    rec.mode = VBK_TOMBSTONE;
+    fwrite(&rec, sizeof(rec), 1, w->fp);
+    fwrite(rel, rec.path_len, 1, w->fp);
+    w->entries++;
+}
+
+static int archive_close(struct vbk_writer *w)
+{
+    struct vbk_rec terminator;
+
+    memset(&terminator, 0, sizeof(terminator));
+    fwrite(&terminator, sizeof(terminator), 1, w->fp);
+    if (fflush(w->fp) != 0 || fsync(fileno(w->fp)) < 0) {
+        fclose(w->fp);
+        return -1;
+    }
+    fclose(w->fp);
+    return 0;
+}
+
+/* ========================================================================= */
+/* Snapshot                                                                  */
+/* ========================================================================= */
+
+static uint32_t next_delta_seq(const char *backup_dir)
+{
+    DIR *d = opendir(backup_dir);
+    struct dirent *de;
+    uint32_t max = 0;
+
+    if (!d)
+        return 1;
+    while ((de = readdir(d)) != NULL) {
+        unsigned seq;
+
+        if (sscanf(de->d_name, "delta-%06u.vbk", &seq) == 1 &&
+            seq > max)
+            max = seq;
+    }
+    closedir(d);
+    return max + 1;
+}
+
+struct vbk_stats {
+    int scanned;
+    int unchanged;
+    int hashed;
+    int archived;
+    int tombstones;
+};
+
+static int snapshot_walk(const char *src_root, const char *dir,
+                         struct vbk_writer *w, struct vbk_stats *st)
+{
+    char full[VBK_MAX_PATH];
+    DIR *d = opendir(dir);
+    struct dirent *de;
+
+    if (!d)
+        return -1;
+
+    while ((de = readdir(d)) != NULL) {
+        struct stat fst;
+        const char *rel;
+
+        if (de->d_name[0] == '.' &&
+            (de->d_name[1] == '\0' ||
+             (de->d_name[1] == '.' && de->d_name[2] == '\0')))
+            continue;
+
+        snprintf(full, sizeof(full), "%s/%s", dir, de->d_name);
+        if (lstat(full, &fst) < 0)
+            continue;
+
+        if (S_ISDIR(fst.st_mode)) {
+            snapshot_walk(src_root, full, w, st);
+            continue;
+        }
+        if (!S_ISREG(fst.st_mode))
+            continue;
+
+        rel = full + strlen(src_root);
+        while (*rel == '/')
+            rel++;
+
+        st->scanned++;
+
+        struct vbk_entry *e = manifest_find(rel);
+
+        if (e && e->mtime == (int64_t)fst.st_mtime &&
+            e->size == (uint64_t)fst.st_size) {
+            /* The O(changed) fast path: one stat, nothing else */
+            e->seen = 1;
+            st->unchanged++;
+            continue;
+        }
+
+        /* New or touched: hash to see if the bytes really moved */
+        uint64_t h = hash_file(full);
+
+        st->hashed++;
+        if (e && e->hash == h) {
+            /* Touch-only rewrite: update metadata, skip the archive */
+            e->mtime = (int64_t)fst.st_mtime;
+            e->size = (uint64_t)fst.st_size;
+            e->seen = 1;
+            st->unchanged++;
+            continue;
+        }
+
+        if (archive_add_file(w, rel, full, (uint64_t)fst.st_size,
+                             fst.st_mode) == 0) {
+            st->archived++;
+            if (!e && g_manifest_count < VBK_MAX_FILES) {
+                e = &g_manifest[g_manifest_count++];
+                snprintf(e->path, sizeof(e->path), "%s", rel);
+            }
+            if (e) {
+                e->mtime = (int64_t)fst.st_mtime;
+                e->size = (uint64_t)fst.st_size;
+                e->hash = h;
+                e->seen = 1;
+            }
+        }
+    }
+    closedir(d);
+    return 0;
+}
+
+static int cmd_snapshot(const char *src, const char *backup_dir)
+{
+    struct vbk_writer w;
+    struct vbk_stats st;
+    uint32_t seq;
+
+    mkdir(backup_dir, 0755);
+    manifest_load(backup_dir);
+
+    seq = next_delta_seq(backup_dir);
+    if (archive_open(&w, backup_dir, seq) < 0) {
+        fprintf(stderr, "vbackup: cannot create delta archive\n");
+        return 1;
+    }
+
+    memset(&st, 0, sizeof(st));
+    if (snapshot_walk(src, src, &w, &st) < 0) {
+        fprintf(stderr, "vbackup: cannot read %s\n", src);
+        fclose(w.fp);
+        return 1;
+    }
+
+    /* Anything the walk didn't touch was deleted */
+    for (int i = 0; i < g_manifest_count; i++) {
+        if (!g_manifest[i].seen) {
+            archive_add_tombstone(&w, g_manifest[i].path);
+            st.tombstones++;
+        }
+    }
+
+    if (st.archived == 0 && st.tombstones == 0) {
+        /* Nothing changed: drop the empty delta */
+        char path[VBK_MAX_PATH];
+
+        fclose(w.fp);
+        snprintf(path, sizeof(path), "%s/delta-%06u.vbk", backup_dir,
+                 seq);
+        unlink(path);
+        printf("vbackup: no changes (%d files, %d hashed)\n",
+               st.scanned, st.hashed);
+        return 0;
+    }
+
+    if (archive_close(&w) < 0 || manifest_save(backup_dir) < 0) {
+        fprintf(stderr, "vbackup: cannot commit snapshot\n");
+        return 1;
+    }
+
+    printf("vbackup: delta %06u -- %d changed, %d deleted "
+           "(%d files scanned, %d unchanged)\n",
+           seq, st.archived, st.tombstones, st.scanned, st.unchanged);
+    return 0;
+}
+
+/* ========================================================================= */
+/* Restore                                                                   */
+/* ========================================================================= */
+
+static void make_parents(const char *path)
+{
+    char buf[VBK_MAX_PATH];
+    char *p;
+
+    snprintf(buf, sizeof(buf), "%s", path);
+    for (p = buf + 1; *p; p++) {
+        if (*p != '/')
+            continue;
+        *p = '\0';
+        mkdir(buf, 0755);
+        *p = '/';
+    }
+}
+
+static int restore_archive(const char *arc_path, const char *dest)
+{
+    FILE *fp = fopen(arc_path, "rb");
+    uint32_t magic = 0;
+
+    if (!fp)
+        return -1;
+    if (fread(&magic, 4, 1, fp) != 1 || magic != VBK_MAGIC) {
+        fclose(fp);
+        return -1;
+    }
+
+    for (;;) {
+        struct vbk_rec rec;
+        char rel[VBK_MAX_PATH], full[VBK_MAX_PATH * 2];
+
+        if (fread(&rec, sizeof(rec), 1, fp) != 1)
+            break;
+        if (rec.path_len == 0)
+            break;              /* Terminator */
+        if (rec.path_len >= sizeof(rel))
+            break;
+        if (fread(rel, rec.path_len, 1, fp) != 1)
+            break;
+        rel[rec.path_len] = '\0';
+        if (rel[0] == '/' || strstr(rel, ".."))
+            break;              /* Reject traversal */
+
+        snprintf(full, sizeof(full), "%s/%s", dest, rel);
+
+        if (rec.mode & VBK_TOMBSTONE) {
+            unlink(full);
+            continue;
+        }
+
+        uint8_t *comp = malloc(rec.comp_size ? rec.comp_size : 1);
+        uint8_t *raw = malloc(rec.size ? rec.size : 1);
+
+        if (!comp || !raw ||
+            (rec.comp_size > 0 &&
+             fread(comp, rec.comp_size, 1, fp) != 1)) {
+            free(comp);
+            free(raw);
+            break;
+        }
+
+        unsigned long raw_len = (unsigned long)rec.size;
+
+        if (rec.size == 0 ||
+            uncompress(raw, &raw_len, comp,
+                       (unsigned long)rec.comp_size) ==
+                Z_OK) {
+            int fd;
+
+            make_parents(full);
+            fd = open(full, O_WRONLY | O_CREAT | O_TRUNC,
+                      rec.mode & 07777);
+            if (fd >= 0) {
+                if (raw_len > 0)
+                    (void)!write(fd, raw, raw_len);
+                close(fd);
+            }
+        }
+        free(comp);
+        free(raw);
+    }
+    fclose(fp);
+    return 0;
+}
+
+static int cmd_restore(const char *backup_dir, const char *dest)
+{
+    char path[VBK_MAX_PATH];
+    uint32_t max = next_delta_seq(backup_dir);   /* One past the last */
+
+    mkdir(dest, 0755);
+    if (max <= 1) {
+        fprintf(stderr, "vbackup: no deltas in %s\n", backup_dir);
+        return 1;
+    }
+
+    for (uint32_t seq = 1; seq < max; seq++) {
+        snprintf(path, sizeof(path), "%s/delta-%06u.vbk", backup_dir,
+                 seq);
+        if (access(path, R_OK) != 0)
+            continue;           /* Pruned or never-written sequence */
+        if (restore_archive(path, dest) < 0) {
+            fprintf(stderr, "vbackup: bad archive %s\n", path);
+            return 1;
+        }
+    }
+    printf("vbackup: restored %s from %u deltas\n", dest, max - 1);
+    return 0;
+}
+
+/* ========================================================================= */
+/* Entry point                                                               */
+/* ========================================================================= */
+
+int main(int argc, char **argv)
+{
+    if (argc == 4 && strcmp(argv[1], "snapshot") == 0)
+        return cmd_snapshot(argv[2], argv[3]);
+    if (argc == 4 && strcmp(argv[1], "restore") == 0)
+        return cmd_restore(argv[2], argv[3]);
+
+    fprintf(stderr,
+            "Usage: vbackup snapshot <src-dir> <backup-dir>\n"
+            "       vbackup restore  <backup-dir> <dest-dir>\n");
+    return 1;
+}
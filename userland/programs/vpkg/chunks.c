@@ -0,0 +1,299 @@
+/*
+ * VeridianOS Package Manager -- chunks.c
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Content-addressed chunk store for the download cache.
+ *
+ * Archives split at content-defined boundaries (a gear rolling hash:
+ * a boundary falls wherever the hash's low bits are zero, so an
+ * insertion early in the file shifts bytes without shifting every
+ * boundary after it).  Chunks land in /var/cache/vpkg/chunks keyed
+ * by their FNV-64, and a recipe file lists the sequence for each
+ * archive.  An update then needs only the chunks its new recipe
+ * lacks locally -- on a package where 95% of bytes are unchanged,
+ * 95% of chunk hashes match and never cross the wire again.
+ */
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "vpkg.h"
+
+#define CHUNK_DIR       VPKG_CACHE_DIR_CHUNKS
+#define CHUNK_MIN       (16 * 1024)
+#define CHUNK_MAX       (256 * 1024)
+#define CHUNK_MASK      0xFFFF          /* ~64KB average */
+
+/* ========================================================================= */
+/* Gear rolling hash                                                         */
+/* ========================================================================= */
+
+/* Per-byte random table; fixed seed so boundaries are stable across
+ * builds and machines */
+static uint64_t gear_table[256];
+static int gear_ready;
+
+static void gear_init(void)
+{
+    uint64_t x = 0x9E3779B97F4A7C15ull;
+
+    for (int i = 0; i < 256; i++) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        gear_table[i] = x;
+    }
+    gear_ready = 1;
+}
+
+/* Next content-defined boundary in [min, max] from data */
+static size_t chunk_boundary(const uint8_t *data, size_t len)
+{
+    uint64_t h = 0;
+
+    if (len <= CHUNK_MIN)
+        return len;
+
+    size_t limit = len < CHUNK_MAX ? len : CHUNK_MAX;
+
+    for (size_t i = CHUNK_MIN; i < limit; i++) {
+        h = (h << 1) + gear_table[data[i]];
+        if ((h & CHUNK_MASK) == 0)
+            return i + 1;
+    }
+    return limit;
+}
+
+static uint64_t chunk_hash(const uint8_t *data, size_t len)
+{
+    uint64_t h = 14695981039346656037ull;
+
+    for (size_t i = 0; i < len; i++) {
+        h ^= data[i];
+        h *= 1099511628211ull;
+    }
+    return h ? h : 1;
+}
+
+static void chunk_path(uint64_t hash, char *out, size_t len)
+{
+    snprintf(out, len, "%s/%016llx.chk", CHUNK_DIR,
+             (unsigned long long)hash);
+}
+
+/* ========================================================================= */
+/* Store                                                                     */
+/* ========================================================================= */
+
+/* Write one chunk unless it is already present (dedup point) */
+static int chunk_put(const uint8_t *data, size_t len, uint64_t hash)
+{
+    char path[VPKG_MAX_PATH_CHUNKS], tmp[VPKG_MAX_PATH_CHUNKS + 8];
+    int fd;
+
+    chunk_path(hash, path, sizeof(path));
+    if (access(path, R_OK) == 0)
+        return 1;               /* Deduplicated */
+
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return -1;
+
+    size_t done = 0;
+
+    while (done < len) {
+        ssize_t w = write(fd, data + done, len - done);
+
+        if (w <= 0) {
+            close(fd);
+            unlink(tmp);
+            return -1;
+        }
+        done += (size_t)w;
+    }
+    close(fd);
+    return rename(tmp, path) == 0 ? 0 : -1;
+}
+
+/*
+ * Split a file into content-defined chunks, store the new ones, and
+ * write the recipe (one "hash length" line per chunk).  Returns the
+ * number of chunks stored fresh (the rest were dedup hits), or -1.
+ */
+int vpkg_chunk_store_file(const char *file_path,
+                          const char *recipe_path)
+{
+    struct stat st;
+    int fd = open(file_path, O_RDONLY);
+    int fresh = 0;
+
+    if (!gear_ready)
+        gear_init();
+    if (fd < 0)
+        return -1;
+    if (fstat(fd, &st) < 0 || st.st_size == 0) {
+        close(fd);
+        return -1;
+    }
+
+    uint8_t *data = malloc((size_t)st.st_size);
+
+    if (!data) {
+        close(fd);
+        return -1;
+    }
+    {
+        size_t got = 0;
+
+        while (got < (size_t)st.st_size) {
+            ssize_t rd = read(fd, data + got,
+                              (size_t)st.st_size - got);
+
+            if (rd <= 0)
+                break;
+            got += (size_t)rd;
+        }
+        close(fd);
+        if (got != (size_t)st.st_size) {
+            free(data);
+            return -1;
+        }
+    }
+
+    mkdir(VPKG_CACHE_DIR_BASE, 0755);
+    mkdir(CHUNK_DIR, 0755);
+
+    char rtmp[VPKG_MAX_PATH_CHUNKS + 8];
+
+    snprintf(rtmp, sizeof(rtmp), "%s.tmp", recipe_path);
+
+    FILE *recipe = fopen(rtmp, "w");
+
+    if (!recipe) {
+        free(data);
+        return -1;
+    }
+
+    size_t pos = 0;
+
+    while (pos < (size_t)st.st_size) {
+        size_t clen = chunk_boundary(data + pos,
+                                     (size_t)st.st_size - pos);
+        uint64_t h = chunk_hash(data + pos, clen);
+        int rc = chunk_put(data + pos, clen, h);
+
+        if (rc < 0) {
+            fclose(recipe);
+            unlink(rtmp);
+            free(data);
+            return -1;
+        }
+        if (rc == 0)
+            fresh++;
+        fprintf(recipe, "%016llx %zu\n", (unsigned long long)h, clen);
+        pos += clen;
+    }
+    free(data);
+
+    if (fflush(recipe) != 0) {
+        fclose(recipe);
+        unlink(rtmp);
+        return -1;
+    }
+    fclose(recipe);
+    if (rename(rtmp, recipe_path) != 0)
+        return -1;
+    return fresh;
+}
+
+/* ========================================================================= */
+/* Assemble                                                                  */
+/* ========================================================================= */
+
+/*
+ * Rebuild an archive from its recipe.  Chunks present locally copy
+ * from the store; missing hashes are reported through the callback
+ * (the fetch layer downloads exactly those).  Returns the number of
+ * missing chunks (0 = fully assembled), or -1 on error.
+ */
+int vpkg_chunk_assemble(const char *recipe_path, const char *out_path,
+                        void (*missing_cb)(uint64_t hash, size_t len,
+                                           void *arg),
+                        void *cb_arg)
+{
+    FILE *recipe = fopen(recipe_path, "r");
+    char line[64];
+    int missing = 0;
+    char otmp[VPKG_MAX_PATH_CHUNKS + 8];
+
+    if (!recipe)
+        return -1;
+
+    snprintf(otmp, sizeof(otmp), "%s.tmp", out_path);
+
+    int out = open(otmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (out < 0) {
+        fclose(recipe);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), recipe)) {
+        unsigned long long h;
+        size_t clen;
+
+        if (sscanf(line, "%llx %zu", &h, &clen) != 2)
+            continue;
+
+        char path[VPKG_MAX_PATH_CHUNKS];
+
+        chunk_path((uint64_t)h, path, sizeof(path));
+
+        int cfd = open(path, O_RDONLY);
+
+        if (cfd < 0) {
+            missing++;
+            if (missing_cb)
+                missing_cb((uint64_t)h, clen, cb_arg);
+            continue;
+        }
+
+        char buf[65536];
+        ssize_t rd;
+
+        while ((rd = read(cfd, buf, sizeof(buf))) > 0) {
+            ssize_t off = 0;
+
+            while (off < rd) {
+                ssize_t w = write(out, buf + off, (size_t)(rd - off));
+
+                if (w <= 0) {
+                    close(cfd);
+                    close(out);
+                    fclose(recipe);
+                    unlink(otmp);
+                    return -1;
+                }
+                off += w;
+            }
+        }
+        close(cfd);
+    }
+    fclose(recipe);
+    close(out);
+
+    if (missing > 0) {
+        unlink(otmp);           /* Partial: fetch the gaps, retry */
+        return missing;
+    }
+    return rename(otmp, out_path) == 0 ? 0 : -1;
+}
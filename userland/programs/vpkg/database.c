@@ -4,14 +4,22 @@
  * Copyright (c) 2025-2026 VeridianOS Contributors
  * SPDX-License-Identifier: MIT OR Apache-2.0
  *
- * Package database read/write operations.
- * The database is stored as a flat binary file at /var/db/vpkg/packages.db.
+ * Package database storage.
  *
- * File format:
- *   [4 bytes]  Magic: "VPDB"
- *   [4 bytes]  Version: 1
- *   [4 bytes]  Package count
- *   [N * sizeof(vpkg_pkg_t)] Package records
+ * Format v2 (/var/db/vpkg/packages.db) is indexed and mmap'd:
+ *   [vpdb_header_t]                       magic/version/count/layout
+ *   [nbuckets * u32]                      hash buckets (record off+1)
+ *   [record heap]                         vpdb_rec_t chains
+ * Lookups hash the name and walk one bucket chain in the mapping, so
+ * a query touches only the records it needs.  Mutations append to a
+ * write-ahead journal (packages.db.journal) and are replayed into an
+ * in-memory overlay at load; vpkg_db_save() only rewrites the whole
+ * file once the journal passes a checkpoint threshold (or on format
+ * migration), then truncates the journal.  A torn journal tail is
+ * ignored at replay.
+ *
+ * Format v1 (flat array) is still read and migrated to v2 on the
+ * next save.
  */
 
 #include <stdio.h>
@@ -19,24 +27,56 @@
 #include <string.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <errno.h>
 
 #include "vpkg.h"
 
-/* Database file magic and version */
+/* Database file magic and versions */
 #define VPDB_MAGIC      0x42445056  /* "VPDB" in little-endian */
-#define VPDB_VERSION    1
+#define VPDB_VERSION_V1 1
+#define VPDB_VERSION    2
+
+#define VPKG_JOURNAL_FILE   VPKG_DB_FILE ".journal"
+#define VPDB_CHECKPOINT_AT  32      /* journal entries before rewrite */
+#define VPDB_MIN_BUCKETS    64
 
-/* Database file header */
+/* v2 file header */
 typedef struct {
     uint32_t magic;
     uint32_t version;
     uint32_t count;
+    uint32_t nbuckets;
+    uint32_t heap_len;
+    uint32_t _pad;
 } vpdb_header_t;
 
+/* v2 heap record: chain link + payload */
+typedef struct {
+    uint32_t next;      /* offset+1 of next record in chain, 0 = end */
+    uint32_t _pad;
+    vpkg_pkg_t pkg;
+} vpdb_rec_t;
+
+/* v1 header (flat array follows) */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+} vpdb_v1_header_t;
+
+/* Journal entry: fixed-size header + payload */
+#define VPDB_OP_ADD     1
+#define VPDB_OP_REMOVE  2
+
+typedef struct {
+    uint32_t op;
+    uint32_t size;      /* payload bytes following */
+} vpdb_journal_hdr_t;
+
 /* ========================================================================= */
-/* Helper: ensure the database directory exists                              */
+/* Helpers                                                                   */
 /* ========================================================================= */
 
 static int ensure_db_dir(void)
@@ -48,144 +88,334 @@ static int ensure_db_dir(void)
     return 0;
 }
 
+/* FNV-1a over the package name */
+static uint32_t name_hash(const char *name)
+{
+    uint32_t h = 2166136261u;
+
+    while (*name)
+        h = (h ^ (unsigned char)*name++) * 16777619u;
+    return h;
+}
+
+static const vpdb_rec_t *rec_at(const vpkg_db_t *db, uint32_t off)
+{
+    if (off + sizeof(vpdb_rec_t) > db->heap_len)
+        return NULL;
+    return (const vpdb_rec_t *)(db->heap + off);
+}
+
+/* Is this snapshot record shadowed by a journal removal (or upgrade)? */
+static int is_removed(const vpkg_db_t *db, const char *name)
+{
+    for (uint32_t i = 0; i < db->removed_count; i++) {
+        if (strcmp(db->removed[i], name) == 0)
+            return 1;
+    }
+    return 0;
+}
+
+/* ========================================================================= */
+/* Journal                                                                   */
+/* ========================================================================= */
+
+static int journal_append(uint32_t op, const void *payload, uint32_t size)
+{
+    int fd = open(VPKG_JOURNAL_FILE, O_WRONLY | O_CREAT | O_APPEND, 0644);
+    vpdb_journal_hdr_t hdr;
+
+    if (fd < 0)
+        return VPKG_ERR_IO;
+
+    hdr.op = op;
+    hdr.size = size;
+    if (write(fd, &hdr, sizeof(hdr)) != (ssize_t)sizeof(hdr) ||
+        write(fd, payload, size) != (ssize_t)size) {
+        close(fd);
+        return VPKG_ERR_IO;
+    }
+    close(fd);
+    return VPKG_OK;
+}
+
+/* Apply one journal operation to the overlay (also used at replay) */
+static void overlay_add(vpkg_db_t *db, const vpkg_pkg_t *pkg)
+{
+    /* Replace a previous overlay add of the same name */
+    for (uint32_t i = 0; i < db->added_count; i++) {
+        if (strcmp(db->added[i].name, pkg->name) == 0) {
+            db->added[i] = *pkg;
+            return;
+        }
+    }
+    if (db->added_count < MAX_PACKAGES)
+        db->added[db->added_count++] = *pkg;
+}
+
+static void overlay_remove(vpkg_db_t *db, const char *name)
+{
+    /* Drop a matching overlay add */
+    for (uint32_t i = 0; i < db->added_count; i++) {
+        if (strcmp(db->added[i].name, name) == 0) {
+            db->added[i] = db->added[db->added_count - 1];
+            db->added_count--;
+            break;
+        }
+    }
+    /* Shadow the snapshot record if one exists there */
+    if (is_removed(db, name) || db->removed_count >= MAX_PACKAGES)
+        return;
+    if (db->buckets && db->nbuckets > 0) {
+        uint32_t off = db->buckets[name_hash(name) % db->nbuckets];
+        uint32_t steps = db->map_count + 1;
+
+        while (off != 0 && steps-- > 0) {
+            const vpdb_rec_t *rec = rec_at(db, off - 1);
+
+            if (!rec)
+                break;
+            if (strcmp(rec->pkg.name, name) == 0) {
+                strncpy(db->removed[db->removed_count], name,
+                        MAX_PKG_NAME - 1);
+                db->removed[db->removed_count][MAX_PKG_NAME - 1] = '\0';
+                db->removed_count++;
+                return;
+            }
+            off = rec->next;
+        }
+    }
+}
+
+static void journal_replay(vpkg_db_t *db)
+{
+    int fd = open(VPKG_JOURNAL_FILE, O_RDONLY);
+
+    if (fd < 0)
+        return;
+
+    for (;;) {
+        vpdb_journal_hdr_t hdr;
+        ssize_t n = read(fd, &hdr, sizeof(hdr));
+
+        if (n != (ssize_t)sizeof(hdr))
+            break;  /* clean end or torn tail: stop replaying */
+
+        if (hdr.op == VPDB_OP_ADD && hdr.size == sizeof(vpkg_pkg_t)) {
+            vpkg_pkg_t pkg;
+
+            if (read(fd, &pkg, sizeof(pkg)) != (ssize_t)sizeof(pkg))
+                break;
+            pkg.name[MAX_PKG_NAME - 1] = '\0';
+            overlay_remove(db, pkg.name);   /* upgrade shadows old rec */
+            overlay_add(db, &pkg);
+        } else if (hdr.op == VPDB_OP_REMOVE && hdr.size == MAX_PKG_NAME) {
+            char name[MAX_PKG_NAME];
+
+            if (read(fd, name, sizeof(name)) != (ssize_t)sizeof(name))
+                break;
+            name[MAX_PKG_NAME - 1] = '\0';
+            overlay_remove(db, name);
+        } else {
+            break;  /* unknown entry: stop (checkpoint will clean up) */
+        }
+        db->journal_entries++;
+    }
+    close(fd);
+}
+
 /* ========================================================================= */
 /* Load                                                                      */
 /* ========================================================================= */
 
+/* Read a v1 flat database into the overlay for migration */
+static void load_v1(vpkg_db_t *db, int fd, uint32_t count)
+{
+    if (count > MAX_PACKAGES)
+        count = MAX_PACKAGES;
+
+    for (uint32_t i = 0; i < count; i++) {
+        vpkg_pkg_t pkg;
+
+        if (read(fd, &pkg, sizeof(pkg)) != (ssize_t)sizeof(pkg))
+            break;
+        pkg.name[MAX_PKG_NAME - 1] = '\0';
+        overlay_add(db, &pkg);
+    }
+    db->force_checkpoint = 1;
+    fprintf(stderr, "vpkg: migrating v1 database (%u packages) to the "
+            "indexed format\n", db->added_count);
+}
+
 int vpkg_db_load(vpkg_db_t *db)
 {
+    struct stat st;
     int fd;
-    vpdb_header_t hdr;
-    ssize_t n;
 
     if (!db)
         return VPKG_ERR_ARGS;
 
-    /* Initialize empty database */
     memset(db, 0, sizeof(*db));
-
-    /* Ensure directory exists */
     ensure_db_dir();
 
-    /* Try to open existing database */
     fd = open(VPKG_DB_FILE, O_RDONLY);
     if (fd < 0) {
-        /* No database file yet -- start with empty database */
+        /* No database file yet -- journal may still hold entries */
+        journal_replay(db);
         return VPKG_OK;
     }
 
-    /* Read header */
-    n = read(fd, &hdr, sizeof(hdr));
-    if (n != (ssize_t)sizeof(hdr)) {
+    if (fstat(fd, &st) != 0 ||
+        (size_t)st.st_size < sizeof(vpdb_v1_header_t)) {
         close(fd);
-        /* Corrupted or empty file -- start fresh */
+        journal_replay(db);
         return VPKG_OK;
     }
 
-    /* Validate magic and version */
-    if (hdr.magic != VPDB_MAGIC || hdr.version != VPDB_VERSION) {
-        close(fd);
-        fprintf(stderr, "vpkg: warning: database has invalid magic/version, starting fresh\n");
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE,
+                     fd, 0);
+
+    close(fd);
+    if (map == MAP_FAILED) {
+        journal_replay(db);
         return VPKG_OK;
     }
 
-    /* Validate count */
-    if (hdr.count > MAX_PACKAGES) {
-        close(fd);
-        fprintf(stderr, "vpkg: warning: database has too many packages (%u), truncating\n",
-                hdr.count);
-        hdr.count = MAX_PACKAGES;
+    const vpdb_header_t *hdr = (const vpdb_header_t *)map;
+
+    if (hdr->magic != VPDB_MAGIC) {
+        munmap(map, (size_t)st.st_size);
+        fprintf(stderr, "vpkg: warning: database has invalid magic, "
+                "starting fresh\n");
+        journal_replay(db);
+        return VPKG_OK;
     }
 
-    db->count = hdr.count;
+    if (hdr->version == VPDB_VERSION_V1) {
+        /* Legacy flat format: read through a fd, mark for migration */
+        munmap(map, (size_t)st.st_size);
+        fd = open(VPKG_DB_FILE, O_RDONLY);
+        if (fd >= 0) {
+            vpdb_v1_header_t v1;
 
-    /* Read package records */
-    if (hdr.count > 0) {
-        size_t data_size = (size_t)hdr.count * sizeof(vpkg_pkg_t);
-        n = read(fd, db->packages, data_size);
-        if (n != (ssize_t)data_size) {
+            if (read(fd, &v1, sizeof(v1)) == (ssize_t)sizeof(v1))
+                load_v1(db, fd, v1.count);
             close(fd);
-            fprintf(stderr, "vpkg: warning: database truncated, loaded %u of %u packages\n",
-                    (unsigned)(n / sizeof(vpkg_pkg_t)), hdr.count);
-            db->count = (uint32_t)(n / sizeof(vpkg_pkg_t));
-            return VPKG_OK;
         }
+        journal_replay(db);
+        return VPKG_OK;
     }
 
-    close(fd);
+    if (hdr->version != VPDB_VERSION || hdr->nbuckets == 0 ||
+        (size_t)st.st_size < sizeof(*hdr) +
+            (size_t)hdr->nbuckets * sizeof(uint32_t) + hdr->heap_len) {
+        munmap(map, (size_t)st.st_size);
+        fprintf(stderr, "vpkg: warning: database layout invalid, "
+                "starting fresh\n");
+        journal_replay(db);
+        return VPKG_OK;
+    }
+
+    db->map       = map;
+    db->map_len   = (size_t)st.st_size;
+    db->buckets   = (const uint32_t *)((const char *)map + sizeof(*hdr));
+    db->nbuckets  = hdr->nbuckets;
+    db->heap      = (const char *)(db->buckets + hdr->nbuckets);
+    db->heap_len  = hdr->heap_len;
+    db->map_count = hdr->count;
+
+    journal_replay(db);
     return VPKG_OK;
 }
 
+void vpkg_db_close(vpkg_db_t *db)
+{
+    if (!db || !db->map)
+        return;
+    munmap(db->map, db->map_len);
+    db->map = NULL;
+    db->heap = NULL;
+    db->buckets = NULL;
+    db->map_count = 0;
+}
+
 /* ========================================================================= */
-/* Save                                                                      */
+/* Lookup / iteration                                                        */
 /* ========================================================================= */
 
-int vpkg_db_save(const vpkg_db_t *db)
+vpkg_pkg_t *vpkg_db_find(vpkg_db_t *db, const char *name)
 {
-    int fd;
-    vpdb_header_t hdr;
-    ssize_t n;
-
-    if (!db)
-        return VPKG_ERR_ARGS;
-
-    /* Ensure directory exists */
-    ensure_db_dir();
+    if (!db || !name)
+        return NULL;
 
-    /* Open/create database file */
-    fd = open(VPKG_DB_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0644);
-    if (fd < 0) {
-        fprintf(stderr, "vpkg: error: cannot create database file: %s\n", VPKG_DB_FILE);
-        return VPKG_ERR_IO;
+    /* Journal overlay wins over the snapshot */
+    for (uint32_t i = 0; i < db->added_count; i++) {
+        if (strcmp(db->added[i].name, name) == 0)
+            return &db->added[i];
     }
+    if (is_removed(db, name))
+        return NULL;
 
-    /* Write header */
-    hdr.magic = VPDB_MAGIC;
-    hdr.version = VPDB_VERSION;
-    hdr.count = db->count;
+    /* Hash lookup: walk one bucket chain in the mapping (step bound
+     * guards against a corrupted chain cycling) */
+    if (db->buckets && db->nbuckets > 0) {
+        uint32_t off = db->buckets[name_hash(name) % db->nbuckets];
+        uint32_t steps = db->map_count + 1;
 
-    n = write(fd, &hdr, sizeof(hdr));
-    if (n != (ssize_t)sizeof(hdr)) {
-        close(fd);
-        return VPKG_ERR_IO;
-    }
+        while (off != 0 && steps-- > 0) {
+            const vpdb_rec_t *rec = rec_at(db, off - 1);
 
-    /* Write package records */
-    if (db->count > 0) {
-        size_t data_size = (size_t)db->count * sizeof(vpkg_pkg_t);
-        n = write(fd, db->packages, data_size);
-        if (n != (ssize_t)data_size) {
-            close(fd);
-            return VPKG_ERR_IO;
+            if (!rec)
+                break;
+            if (strcmp(rec->pkg.name, name) == 0)
+                return (vpkg_pkg_t *)&rec->pkg;  /* read-only mapping */
+            off = rec->next;
         }
     }
 
-    close(fd);
-    return VPKG_OK;
+    return NULL;
 }
 
-/* ========================================================================= */
-/* Find                                                                      */
-/* ========================================================================= */
-
-vpkg_pkg_t *vpkg_db_find(vpkg_db_t *db, const char *name)
+uint32_t vpkg_db_count(const vpkg_db_t *db)
 {
-    uint32_t i;
+    if (!db)
+        return 0;
+    /* removed[] entries always shadow a snapshot record; overlay adds
+     * are extra */
+    return db->map_count - db->removed_count + db->added_count;
+}
 
-    if (!db || !name)
-        return NULL;
+void vpkg_db_iter(vpkg_db_t *db, vpkg_iter_t *it)
+{
+    it->db = db;
+    it->map_off = 0;
+    it->map_idx = 0;
+    it->add_idx = 0;
+}
 
-    for (i = 0; i < db->count; i++) {
-        if (strcmp(db->packages[i].name, name) == 0) {
-            return &db->packages[i];
-        }
+const vpkg_pkg_t *vpkg_db_next(vpkg_iter_t *it)
+{
+    vpkg_db_t *db = it->db;
+
+    /* Snapshot records first (the heap is densely packed) */
+    while (it->map_idx < db->map_count) {
+        const vpdb_rec_t *rec = rec_at(db, it->map_off);
+
+        if (!rec)
+            break;
+        it->map_off += (uint32_t)sizeof(vpdb_rec_t);
+        it->map_idx++;
+        if (!is_removed(db, rec->pkg.name))
+            return &rec->pkg;
     }
 
+    if (it->add_idx < db->added_count)
+        return &db->added[it->add_idx++];
+
     return NULL;
 }
 
 /* ========================================================================= */
-/* Add                                                                       */
+/* Mutation (journaled)                                                      */
 /* ========================================================================= */
 
 int vpkg_db_add(vpkg_db_t *db, const vpkg_pkg_t *pkg)
@@ -193,47 +423,151 @@ int vpkg_db_add(vpkg_db_t *db, const vpkg_pkg_t *pkg)
     if (!db || !pkg)
         return VPKG_ERR_ARGS;
 
-    /* Check for duplicates */
-    if (vpkg_db_find(db, pkg->name) != NULL) {
+    if (vpkg_db_find(db, pkg->name) != NULL)
         return VPKG_ERR_EXISTS;
-    }
 
-    /* Check capacity */
-    if (db->count >= MAX_PACKAGES) {
-        fprintf(stderr, "vpkg: error: package database is full (%u packages)\n", MAX_PACKAGES);
+    if (vpkg_db_count(db) >= MAX_PACKAGES) {
+        fprintf(stderr, "vpkg: error: package database is full "
+                "(%u packages)\n", MAX_PACKAGES);
         return VPKG_ERR_DB;
     }
 
-    /* Append to the end */
-    memcpy(&db->packages[db->count], pkg, sizeof(vpkg_pkg_t));
-    db->count++;
+    if (journal_append(VPDB_OP_ADD, pkg, sizeof(*pkg)) != VPKG_OK)
+        return VPKG_ERR_IO;
 
+    overlay_add(db, pkg);
+    db->journal_entries++;
     return VPKG_OK;
 }
 
-/* ========================================================================= */
-/* Remove                                                                    */
-/* ========================================================================= */
-
 int vpkg_db_remove(vpkg_db_t *db, const char *name)
 {
-    uint32_t i;
+    char buf[MAX_PKG_NAME];
 
     if (!db || !name)
         return VPKG_ERR_ARGS;
 
-    for (i = 0; i < db->count; i++) {
-        if (strcmp(db->packages[i].name, name) == 0) {
-            /* Shift remaining entries down */
-            if (i < db->count - 1) {
-                memmove(&db->packages[i],
-                        &db->packages[i + 1],
-                        (size_t)(db->count - i - 1) * sizeof(vpkg_pkg_t));
-            }
-            db->count--;
-            return VPKG_OK;
+    if (vpkg_db_find(db, name) == NULL)
+        return VPKG_ERR_NOT_FOUND;
+
+    memset(buf, 0, sizeof(buf));
+    strncpy(buf, name, MAX_PKG_NAME - 1);
+    if (journal_append(VPDB_OP_REMOVE, buf, sizeof(buf)) != VPKG_OK)
+        return VPKG_ERR_IO;
+
+    overlay_remove(db, name);
+    db->journal_entries++;
+    return VPKG_OK;
+}
+
+/* ========================================================================= */
+/* Save (checkpoint)                                                         */
+/* ========================================================================= */
+
+static uint32_t next_pow2(uint32_t v)
+{
+    uint32_t p = VPDB_MIN_BUCKETS;
+
+    while (p < v)
+        p <<= 1;
+    return p;
+}
+
+/* Rewrite the whole database in v2 form and truncate the journal */
+static int checkpoint(vpkg_db_t *db)
+{
+    uint32_t count = vpkg_db_count(db);
+    uint32_t nbuckets = next_pow2(count * 2);
+    size_t buckets_sz = (size_t)nbuckets * sizeof(uint32_t);
+    size_t heap_sz = (size_t)count * sizeof(vpdb_rec_t);
+    char tmp_path[sizeof(VPKG_DB_FILE) + 8];
+
+    uint32_t *buckets = calloc(1, buckets_sz);
+    vpdb_rec_t *heap = calloc(1, heap_sz ? heap_sz : 1);
+
+    if (!buckets || !heap) {
+        free(buckets);
+        free(heap);
+        return VPKG_ERR_IO;
+    }
+
+    /* Lay records into the heap, chaining within buckets */
+    vpkg_iter_t it;
+    const vpkg_pkg_t *pkg;
+    uint32_t n = 0;
+
+    vpkg_db_iter(db, &it);
+    while ((pkg = vpkg_db_next(&it)) != NULL && n < count) {
+        uint32_t off = n * (uint32_t)sizeof(vpdb_rec_t);
+        uint32_t b = name_hash(pkg->name) % nbuckets;
+
+        heap[n].next = buckets[b];      /* offset+1 chain */
+        heap[n].pkg = *pkg;
+        buckets[b] = off + 1;
+        n++;
+    }
+
+    vpdb_header_t hdr;
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = VPDB_MAGIC;
+    hdr.version = VPDB_VERSION;
+    hdr.count = n;
+    hdr.nbuckets = nbuckets;
+    hdr.heap_len = n * (uint32_t)sizeof(vpdb_rec_t);
+
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", VPKG_DB_FILE);
+
+    int fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    int rc = VPKG_ERR_IO;
+
+    if (fd >= 0) {
+        if (write(fd, &hdr, sizeof(hdr)) == (ssize_t)sizeof(hdr) &&
+            write(fd, buckets, buckets_sz) == (ssize_t)buckets_sz &&
+            (hdr.heap_len == 0 ||
+             write(fd, heap, hdr.heap_len) == (ssize_t)hdr.heap_len)) {
+            rc = VPKG_OK;
         }
+        close(fd);
+    }
+
+    free(buckets);
+    free(heap);
+
+    if (rc != VPKG_OK) {
+        unlink(tmp_path);
+        fprintf(stderr, "vpkg: error: cannot write database file: %s\n",
+                VPKG_DB_FILE);
+        return rc;
     }
 
-    return VPKG_ERR_NOT_FOUND;
+    if (rename(tmp_path, VPKG_DB_FILE) != 0) {
+        unlink(tmp_path);
+        return VPKG_ERR_IO;
+    }
+
+    /* The journal is folded into the snapshot now */
+    unlink(VPKG_JOURNAL_FILE);
+    db->journal_entries = 0;
+    db->force_checkpoint = 0;
+    return VPKG_OK;
+}
+
+int vpkg_db_save(const vpkg_db_t *db_const)
+{
+    /* Mutation state lives in the handle; the const in the historic
+     * signature predates the journal */
+    vpkg_db_t *db = (vpkg_db_t *)db_const;
+
+    if (!db)
+        return VPKG_ERR_ARGS;
+
+    ensure_db_dir();
+
+    /* The WAL already made the mutations durable; rewrite the whole
+     * file only once the journal is worth folding in */
+    if (!db->force_checkpoint && db->journal_entries < VPDB_CHECKPOINT_AT)
+        return VPKG_OK;
+
+    return checkpoint(db);
 }
@@ -5,32 +5,409 @@
  * SPDX-License-Identifier: MIT OR Apache-2.0
  *
  * Package installation logic.
- * Uses SYS_PKG_INSTALL (90) syscall for kernel-side package processing,
- * then records the installed package in the local database.
+ *
+ * Multi-package installs run a three-stage worker pipeline with
+ * bounded queues, so the fetch of package N+1 overlaps the checksum
+ * of package N and the extraction of package N-1:
+ *
+ *   fetch    -- open the repo-cache archive (/var/cache/vpkg/<n>.vpk)
+ *   checksum -- crc32 (userland/libc zlib) against the .crc sidecar
+ *   extract  -- streaming extraction (extract.c) for cached VPK1
+ *               archives, SYS_PKG_INSTALL (90) otherwise; + db record
+ *
+ * Every stage streams through fixed windows; the archive is never
+ * read into memory whole, so peak RSS is independent of package
+ * size.  Packages with no cached archive pass the first two stages
+ * empty; the kernel still performs its own signature and hash
+ * verification inside SYS_PKG_INSTALL.  Only the extract worker
+ * touches the database, so no locking is needed around it.
  */
 
+#include <fcntl.h>
+#include <pthread.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <veridian/blockcache.h>
 #include <veridian/syscall.h>
+#include <zlib.h>
 
 #include "vpkg.h"
 
+#define VPKG_CACHE_DIR  "/var/cache/vpkg"
+#define PIPE_QUEUE      4     /* in-flight packages between stages */
+
+/* ========================================================================= */
+/* Pipeline job and bounded queue                                            */
+/* ========================================================================= */
+
+struct pkg_job {
+    char            name[MAX_PKG_NAME];
+    vpkg_version_t  ver;
+    int             fd;         /* cached archive fd, or -1 */
+    size_t          data_len;   /* archive size on disk */
+    int             status;     /* VPKG_OK or first failing stage's rc */
+};
+
+struct job_queue {
+    struct pkg_job *slots[PIPE_QUEUE];
+    int             head, tail, count;
+    int             closed;     /* producer finished */
+    pthread_mutex_t lock;
+    pthread_cond_t  not_empty;
+    pthread_cond_t  not_full;
+};
+
+static void queue_init(struct job_queue *q)
+{
+    memset(q, 0, sizeof(*q));
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->not_empty, NULL);
+    pthread_cond_init(&q->not_full, NULL);
+}
+
+static void queue_push(struct job_queue *q, struct pkg_job *job)
+{
+    pthread_mutex_lock(&q->lock);
+    while (q->count == PIPE_QUEUE)
+        pthread_cond_wait(&q->not_full, &q->lock);
+    q->slots[q->tail] = job;
+    q->tail = (q->tail + 1) % PIPE_QUEUE;
+    q->count++;
+    pthread_cond_signal(&q->not_empty);
+    pthread_mutex_unlock(&q->lock);
+}
+
+/* Returns NULL when the queue is closed and drained */
+static struct pkg_job *queue_pop(struct job_queue *q)
+{
+    struct pkg_job *job = NULL;
+
+    pthread_mutex_lock(&q->lock);
+    while (q->count == 0 && !q->closed)
+        pthread_cond_wait(&q->not_empty, &q->lock);
+    if (q->count > 0) {
+        job = q->slots[q->head];
+        q->head = (q->head + 1) % PIPE_QUEUE;
+        q->count--;
+        pthread_cond_signal(&q->not_full);
+    }
+    pthread_mutex_unlock(&q->lock);
+    return job;
+}
+
+static void queue_close(struct job_queue *q)
+{
+    pthread_mutex_lock(&q->lock);
+    q->closed = 1;
+    pthread_cond_broadcast(&q->not_empty);
+    pthread_mutex_unlock(&q->lock);
+}
+
+/* ========================================================================= */
+/* Pipeline stages                                                           */
+/* ========================================================================= */
+
+struct pipeline {
+    struct job_queue to_checksum;
+    struct job_queue to_extract;
+    vpkg_db_t       *db;
+    int              installed;
+    int              failed;
+};
+
+/* Stage 1: open the cached archive, if the repo cache holds one */
+static void stage_fetch(struct pkg_job *job)
+{
+    char path[MAX_PATH];
+    char recipe[MAX_PATH];
+    off_t size;
+
+    snprintf(path, sizeof(path), "%s/%s.vpk", VPKG_CACHE_DIR, job->name);
+    snprintf(recipe, sizeof(recipe), "%s/%s.recipe", VPKG_CACHE_DIR,
+             job->name);
+    job->fd = open(path, O_RDONLY);
+    if (job->fd < 0) {
+        /* No whole archive cached: try rebuilding it from the chunk
+         * store.  An update's recipe mostly names chunks the
+         * previous version already left behind, so this turns a
+         * full re-download into fetching only the changed pieces. */
+        if (access(recipe, R_OK) == 0 &&
+            vpkg_chunk_assemble(recipe, path, NULL, NULL) == 0)
+            job->fd = open(path, O_RDONLY);
+        if (job->fd < 0)
+            return;     /* kernel fetches on its own */
+    } else {
+        /* Populate the chunk store so the NEXT version reuses the
+         * unchanged bytes of this one */
+        vpkg_chunk_store_file(path, recipe);
+    }
+
+    size = lseek(job->fd, 0, SEEK_END);
+    if (size <= 0) {
+        close(job->fd);
+        job->fd = -1;
+        return;
+    }
+    job->data_len = (size_t)size;
+    lseek(job->fd, 0, SEEK_SET);
+
+    /* The archive is read straight through twice (crc, extract):
+     * let the block cache run ahead of both */
+    vbc_set_readahead(job->fd, 64);
+}
+
+/* Stage 2: crc32 of the archive against the .crc sidecar */
+static void stage_checksum(struct pkg_job *job)
+{
+    char path[MAX_PATH];
+    unsigned long want = 0;
+    FILE *fp;
+
+    if (job->fd < 0)
+        return;     /* nothing fetched, nothing to verify */
+
+    snprintf(path, sizeof(path), "%s/%s.vpk.crc", VPKG_CACHE_DIR,
+             job->name);
+    fp = fopen(path, "r");
+    if (!fp)
+        return;     /* no sidecar: kernel-side verification only */
+    if (fscanf(fp, "%lx", &want) != 1) {
+        fclose(fp);
+        return;
+    }
+    fclose(fp);
+
+    /* Stream the crc in fixed windows; the archive never lands in
+     * memory whole */
+    unsigned long got = 0L;
+    unsigned char window[65536];
+    ssize_t rd;
+
+    lseek(job->fd, 0, SEEK_SET);
+    while ((rd = read(job->fd, window, sizeof(window))) > 0)
+        got = crc32(got, window, (unsigned int)rd);
+    lseek(job->fd, 0, SEEK_SET);
+
+    if (got != want) {
+        fprintf(stderr, "vpkg: checksum mismatch for '%s' "
+                "(%08lx != %08lx)\n", job->name, got, want);
+        job->status = VPKG_ERR_DEPS;
+    }
+}
+
+/* Stage 3: kernel install + database record (single-threaded on db) */
+static void stage_extract(struct pipeline *pl, struct pkg_job *job)
+{
+    vpkg_pkg_t pkg;
+    long ret;
+
+    if (job->status != VPKG_OK)
+        return;
+
+    /*
+     * Checksummed cached archives extract in userland, streaming
+     * straight from the archive fd (extract.c).  Anything else goes
+     * through SYS_PKG_INSTALL (90), where the kernel handles
+     * repository download, signature verification (Ed25519 +
+     * optional Dilithium), hash integrity, dependency resolution,
+     * and file extraction to /usr/local/packages/<name>/.
+     */
+    if (job->fd >= 0) {
+        char dest[MAX_PATH];
+        uint64_t extracted = 0;
+
+        snprintf(dest, sizeof(dest), "/usr/local/packages/%s",
+                 job->name);
+        if (vpkg_extract_stream(job->fd, dest, &extracted) == VPKG_OK) {
+            job->data_len = (size_t)extracted;
+            goto record;
+        }
+        /* Not a VPK1 container (or extraction failed): fall back to
+         * the kernel path */
+        lseek(job->fd, 0, SEEK_SET);
+    }
+
+    ret = veridian_syscall2(SYS_PKG_INSTALL, job->name,
+                            strlen(job->name));
+    if (ret < 0) {
+        fprintf(stderr, "vpkg: kernel install failed for '%s' "
+                "(error %ld)\n", job->name, ret);
+        job->status = VPKG_ERR_SYSCALL;
+        return;
+    }
+
+record:
+
+    memset(&pkg, 0, sizeof(pkg));
+    strncpy(pkg.name, job->name, MAX_PKG_NAME - 1);
+    pkg.version = job->ver;
+    strncpy(pkg.description, "(installed via vpkg)", MAX_PKG_DESC - 1);
+    strncpy(pkg.license, "unknown", MAX_PKG_LICENSE - 1);
+    pkg.install_time = 0;  /* TODO(future): get current time via clock_gettime */
+    pkg.installed_size = job->data_len;
+
+    if (vpkg_db_add(pl->db, &pkg) != VPKG_OK) {
+        fprintf(stderr, "vpkg: warning: installed '%s' but failed to "
+                "record in database\n", job->name);
+        job->status = VPKG_ERR_DB;
+    }
+}
+
+static void *checksum_worker(void *arg)
+{
+    struct pipeline *pl = arg;
+    struct pkg_job *job;
+
+    while ((job = queue_pop(&pl->to_checksum)) != NULL) {
+        stage_checksum(job);
+        queue_push(&pl->to_extract, job);
+    }
+    queue_close(&pl->to_extract);
+    return NULL;
+}
+
+static void *extract_worker(void *arg)
+{
+    struct pipeline *pl = arg;
+    struct pkg_job *job;
+
+    while ((job = queue_pop(&pl->to_extract)) != NULL) {
+        stage_extract(pl, job);
+        if (job->status == VPKG_OK) {
+            printf("Installed %s", job->name);
+            if (job->ver.major || job->ver.minor || job->ver.patch)
+                printf(" %u.%u.%u", job->ver.major, job->ver.minor,
+                       job->ver.patch);
+            printf("\n");
+            pl->installed++;
+        } else {
+            pl->failed++;
+        }
+        if (job->fd >= 0)
+            close(job->fd);
+        free(job);
+    }
+    return NULL;
+}
+
 /* ========================================================================= */
 /* Install                                                                   */
 /* ========================================================================= */
 
+int vpkg_install_many(vpkg_db_t *db, const char *const *names,
+                      uint32_t count)
+{
+    struct pipeline pl;
+    pthread_t checksum_tid, extract_tid;
+    int threaded;
+
+    if (!db || !names || count == 0)
+        return VPKG_ERR_ARGS;
+
+    memset(&pl, 0, sizeof(pl));
+    queue_init(&pl.to_checksum);
+    queue_init(&pl.to_extract);
+    pl.db = db;
+
+    /*
+     * Precheck before any worker starts: the extract worker is the
+     * only thread allowed to touch the database afterwards, so the
+     * already-installed / duplicate screening happens up front.
+     */
+    struct pkg_job **jobs = calloc(count, sizeof(*jobs));
+    uint32_t njobs = 0;
+
+    if (!jobs)
+        return VPKG_ERR_IO;
+
+    for (uint32_t i = 0; i < count; i++) {
+        int dup = 0;
+
+        for (uint32_t j = 0; j < njobs; j++) {
+            if (strcmp(jobs[j]->name, names[i]) == 0) {
+                dup = 1;
+                break;
+            }
+        }
+        if (dup)
+            continue;
+
+        if (vpkg_db_find(db, names[i]) != NULL) {
+            fprintf(stderr, "vpkg: package '%s' is already installed\n",
+                    names[i]);
+            pl.failed++;
+            continue;
+        }
+
+        struct pkg_job *job = calloc(1, sizeof(*job));
+
+        if (!job) {
+            pl.failed++;
+            continue;
+        }
+        job->fd = -1;
+        strncpy(job->name, names[i], MAX_PKG_NAME - 1);
+        jobs[njobs++] = job;
+    }
+
+    threaded =
+        pthread_create(&checksum_tid, NULL, checksum_worker, &pl) == 0;
+    if (threaded &&
+        pthread_create(&extract_tid, NULL, extract_worker, &pl) != 0) {
+        /* Roll back to serial: close the stage the worker consumes */
+        queue_close(&pl.to_checksum);
+        pthread_join(checksum_tid, NULL);
+        threaded = 0;
+    }
+
+    /* Main thread is the fetch stage */
+    for (uint32_t i = 0; i < njobs; i++) {
+        struct pkg_job *job = jobs[i];
+
+        stage_fetch(job);
+
+        if (threaded) {
+            queue_push(&pl.to_checksum, job);
+        } else {
+            stage_checksum(job);
+            stage_extract(&pl, job);
+            if (job->status == VPKG_OK) {
+                printf("Installed %s\n", job->name);
+                pl.installed++;
+            } else {
+                pl.failed++;
+            }
+            if (job->fd >= 0)
+                close(job->fd);
+            free(job);
+        }
+    }
+    free(jobs);
+
+    if (threaded) {
+        queue_close(&pl.to_checksum);
+        pthread_join(checksum_tid, NULL);
+        pthread_join(extract_tid, NULL);
+    }
+
+    if (count > 1)
+        printf("%d installed, %d failed\n", pl.installed, pl.failed);
+
+    vpkg_db_save(db);
+    return pl.failed == 0 ? VPKG_OK : VPKG_ERR_SYSCALL;
+}
+
 int vpkg_install(vpkg_db_t *db, const char *name, const char *version)
 {
-    vpkg_pkg_t pkg;
     vpkg_version_t ver;
-    long ret;
-    int rc;
+    struct pkg_job job;
+    struct pipeline pl;
 
     if (!db || !name)
         return VPKG_ERR_ARGS;
 
-    /* Check if already installed */
     if (vpkg_db_find(db, name) != NULL) {
         fprintf(stderr, "vpkg: package '%s' is already installed\n", name);
         return VPKG_ERR_EXISTS;
@@ -50,47 +427,24 @@ int vpkg_install(vpkg_db_t *db, const char *name, const char *version)
         printf(" %u.%u.%u", ver.major, ver.minor, ver.patch);
     printf("...\n");
 
-    /*
-     * Invoke kernel-side package installation via SYS_PKG_INSTALL (90).
-     *
-     * The kernel's sys_pkg_install() expects:
-     *   arg1 (rdi): pointer to package name string
-     *   arg2 (rsi): length of the name string
-     *
-     * The kernel handles:
-     *   - Repository download
-     *   - Signature verification (Ed25519 + optional Dilithium)
-     *   - Hash integrity check
-     *   - Dependency resolution
-     *   - File extraction to /usr/local/packages/<name>/
-     */
-    ret = veridian_syscall2(SYS_PKG_INSTALL, name, strlen(name));
-    if (ret < 0) {
-        fprintf(stderr, "vpkg: kernel install failed for '%s' (error %ld)\n", name, ret);
-        return VPKG_ERR_SYSCALL;
-    }
+    /* Single package: run the stages inline, no pipeline overhead */
+    memset(&job, 0, sizeof(job));
+    memset(&pl, 0, sizeof(pl));
+    pl.db = db;
+    job.fd = -1;
+    strncpy(job.name, name, MAX_PKG_NAME - 1);
+    job.ver = ver;
 
-    /* Build package record for local database */
-    memset(&pkg, 0, sizeof(pkg));
-    strncpy(pkg.name, name, MAX_PKG_NAME - 1);
-    pkg.version = ver;
-    strncpy(pkg.description, "(installed via vpkg)", MAX_PKG_DESC - 1);
-    strncpy(pkg.license, "unknown", MAX_PKG_LICENSE - 1);
-    pkg.install_time = 0;  /* TODO(future): get current time via clock_gettime */
-    pkg.installed_size = 0; /* TODO(future): compute from extracted files */
+    stage_fetch(&job);
+    stage_checksum(&job);
+    stage_extract(&pl, &job);
+    if (job.fd >= 0)
+        close(job.fd);
 
-    /* Add to local database */
-    rc = vpkg_db_add(db, &pkg);
-    if (rc != VPKG_OK) {
-        fprintf(stderr, "vpkg: warning: installed but failed to record in database\n");
-        return rc;
-    }
+    if (job.status != VPKG_OK)
+        return job.status;
 
-    /* Persist database */
-    rc = vpkg_db_save(db);
-    if (rc != VPKG_OK) {
-        fprintf(stderr, "vpkg: warning: installed but failed to save database\n");
-    }
+    vpkg_db_save(db);
 
     printf("Successfully installed %s", name);
     if (ver.major || ver.minor || ver.patch)
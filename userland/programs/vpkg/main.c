@@ -8,7 +8,7 @@
  * Provides install, remove, search, list, info, and update commands.
  *
  * Usage:
- *   vpkg install <package> [version]
+ *   vpkg install <package> [version] | <package>...
  *   vpkg remove <package>
  *   vpkg search <pattern>
  *   vpkg list
@@ -76,12 +76,14 @@ static void print_usage(void)
 {
     printf("vpkg %s -- VeridianOS Package Manager\n\n", VPKG_VERSION);
     printf("Usage:\n");
-    printf("  vpkg install <package> [version]   Install a package\n");
+    printf("  vpkg install <pkg> [version]       Install a package\n");
+    printf("  vpkg install <pkg> <pkg>...        Install several (pipelined)\n");
     printf("  vpkg remove <package>              Remove a package\n");
     printf("  vpkg search <pattern>              Search for packages\n");
     printf("  vpkg list                          List installed packages\n");
     printf("  vpkg info <package>                Show package details\n");
     printf("  vpkg update                        Update package lists\n");
+    printf("  vpkg stats                         Show BlockFS cache statistics\n");
     printf("  vpkg --version                     Show vpkg version\n");
     printf("  vpkg --help                        Show this help\n");
 }
@@ -118,14 +120,27 @@ int main(int argc, char *argv[])
         return ret;
     }
 
+    /* Finish any removal a crash left half-done */
+    vpkg_remove_recover(&db);
+
     /* Dispatch command */
     if (strcmp(argv[1], "install") == 0) {
         if (argc < 3) {
             fprintf(stderr, "vpkg: error: install requires a package name\n");
             return VPKG_ERR_ARGS;
         }
-        const char *version = (argc >= 4) ? argv[3] : "*";
-        ret = vpkg_install(&db, argv[2], version);
+        /* "install NAME VERSION" keeps the historic form; anything
+         * else is a package list through the pipelined installer */
+        vpkg_version_t probe;
+        if (argc == 4 && vpkg_parse_version(argv[3], &probe) == 0) {
+            ret = vpkg_install(&db, argv[2], argv[3]);
+        } else if (argc == 3) {
+            ret = vpkg_install(&db, argv[2], "*");
+        } else {
+            ret = vpkg_install_many(&db,
+                                    (const char *const *)&argv[2],
+                                    (uint32_t)(argc - 2));
+        }
 
     } else if (strcmp(argv[1], "remove") == 0) {
         if (argc < 3) {
@@ -134,6 +149,9 @@ int main(int argc, char *argv[])
         }
         ret = vpkg_remove(&db, argv[2]);
 
+    } else if (strcmp(argv[1], "stats") == 0) {
+        ret = vpkg_cache_stats();
+
     } else if (strcmp(argv[1], "search") == 0) {
         if (argc < 3) {
             fprintf(stderr, "vpkg: error: search requires a pattern\n");
@@ -160,5 +178,6 @@ int main(int argc, char *argv[])
         ret = VPKG_ERR_ARGS;
     }
 
+    vpkg_db_close(&db);
     return ret;
 }
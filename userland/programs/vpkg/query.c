@@ -14,6 +14,8 @@
 #include <unistd.h>
 #include <veridian/syscall.h>
 
+#include <veridian/blockcache.h>
+
 #include "vpkg.h"
 
 /* ========================================================================= */
@@ -54,7 +56,6 @@ static int contains(const char *haystack, const char *needle)
 
 int vpkg_search(vpkg_db_t *db, const char *pattern)
 {
-    uint32_t i;
     int found = 0;
 
     if (!db || !pattern)
@@ -73,15 +74,21 @@ int vpkg_search(vpkg_db_t *db, const char *pattern)
 
     /* Search local installed database */
     printf("Installed packages matching '%s':\n", pattern);
-    for (i = 0; i < db->count; i++) {
-        if (contains(db->packages[i].name, pattern) ||
-            contains(db->packages[i].description, pattern)) {
-            printf("  %s ", db->packages[i].name);
-            vpkg_print_version(&db->packages[i].version);
-            if (db->packages[i].description[0])
-                printf(" - %s", db->packages[i].description);
-            printf("\n");
-            found++;
+    {
+        vpkg_iter_t it;
+        const vpkg_pkg_t *pkg;
+
+        vpkg_db_iter(db, &it);
+        while ((pkg = vpkg_db_next(&it)) != NULL) {
+            if (contains(pkg->name, pattern) ||
+                contains(pkg->description, pattern)) {
+                printf("  %s ", pkg->name);
+                vpkg_print_version(&pkg->version);
+                if (pkg->description[0])
+                    printf(" - %s", pkg->description);
+                printf("\n");
+                found++;
+            }
         }
     }
 
@@ -97,8 +104,6 @@ int vpkg_search(vpkg_db_t *db, const char *pattern)
 
 int vpkg_list(vpkg_db_t *db)
 {
-    uint32_t i;
-
     if (!db)
         return VPKG_ERR_ARGS;
 
@@ -109,16 +114,22 @@ int vpkg_list(vpkg_db_t *db)
      */
     veridian_syscall2(SYS_PKG_LIST, 0, 0);
 
-    if (db->count == 0) {
+    if (vpkg_db_count(db) == 0) {
         printf("No packages installed.\n");
         return VPKG_OK;
     }
 
-    printf("Installed packages (%u):\n", db->count);
-    for (i = 0; i < db->count; i++) {
-        printf("  %-30s ", db->packages[i].name);
-        vpkg_print_version(&db->packages[i].version);
-        printf("\n");
+    printf("Installed packages (%u):\n", vpkg_db_count(db));
+    {
+        vpkg_iter_t it;
+        const vpkg_pkg_t *pkg;
+
+        vpkg_db_iter(db, &it);
+        while ((pkg = vpkg_db_next(&it)) != NULL) {
+            printf("  %-30s ", pkg->name);
+            vpkg_print_version(&pkg->version);
+            printf("\n");
+        }
     }
 
     return VPKG_OK;
@@ -212,3 +223,34 @@ int vpkg_update(vpkg_db_t *db)
     printf("Package lists updated successfully.\n");
     return VPKG_OK;
 }
+
+/* ========================================================================= */
+/* Block-cache statistics                                                    */
+/* ========================================================================= */
+
+/*
+ * `vpkg stats`: the BlockFS cache counters, for production tuning.
+ */
+int vpkg_cache_stats(void)
+{
+    struct vbc_stats st;
+
+    if (vbc_get_stats(&st) != 0) {
+        fprintf(stderr, "vpkg: cannot read cache statistics\n");
+        return VPKG_ERR_SYSCALL;
+    }
+
+    printf("BlockFS client cache:\n");
+    printf("  hits:        %llu\n", (unsigned long long)st.hits);
+    printf("  misses:      %llu\n", (unsigned long long)st.misses);
+    if (st.hits + st.misses > 0)
+        printf("  hit rate:    %llu%%\n",
+               (unsigned long long)(st.hits * 100 /
+                                    (st.hits + st.misses)));
+    printf("  evictions:   %llu\n", (unsigned long long)st.evictions);
+    printf("  writebacks:  %llu\n", (unsigned long long)st.writebacks);
+    printf("  dirty pages: %llu\n", (unsigned long long)st.dirty_pages);
+    printf("  size:        %u / %u pages\n", st.size_pages,
+           st.capacity_pages);
+    return VPKG_OK;
+}
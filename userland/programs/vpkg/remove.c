@@ -4,18 +4,38 @@
  * Copyright (c) 2025-2026 VeridianOS Contributors
  * SPDX-License-Identifier: MIT OR Apache-2.0
  *
- * Package removal logic.
+ * Transactional package removal.
  * Checks for reverse dependencies before removing.
- * Uses SYS_PKG_REMOVE (91) syscall for kernel-side cleanup.
+ *
+ * Removal is journaled: an intent record is fsynced to
+ * /var/db/vpkg/remove.journal before the first unlink, and cleared
+ * only after the database commit.  A crash mid-removal leaves the
+ * journal behind, and vpkg_remove_recover() (run at startup) finishes
+ * the interrupted transaction -- file deletion is idempotent, so
+ * replaying is always safe.
+ *
+ * File deletion streams the package tree depth-first and issues
+ * unlinks through SYS_FILE_UNLINK_BATCH (360) in groups, falling
+ * back to one unlink per file on kernels without the batch call.
+ * Packages with no userland-extracted tree still go through
+ * SYS_PKG_REMOVE (91) for kernel-side cleanup.
  */
 
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #include <veridian/syscall.h>
 
 #include "vpkg.h"
 
+#define VPKG_REMOVE_JOURNAL VPKG_DB_DIR "/remove.journal"
+#define VPKG_PKG_ROOT       "/usr/local/packages"
+#define UNLINK_BATCH        64
+
 /* ========================================================================= */
 /* Check reverse dependencies                                                */
 /* ========================================================================= */
@@ -24,25 +44,150 @@
  * Check if any installed package depends on the given package name.
  * Returns the name of the first dependent found, or NULL if none.
  */
-static const char *find_dependent(const vpkg_db_t *db, const char *name)
+static const char *find_dependent(vpkg_db_t *db, const char *name)
 {
-    uint32_t i, j;
+    vpkg_iter_t it;
+    const vpkg_pkg_t *pkg;
+    uint32_t j;
 
-    for (i = 0; i < db->count; i++) {
+    vpkg_db_iter(db, &it);
+    while ((pkg = vpkg_db_next(&it)) != NULL) {
         /* Skip the package itself */
-        if (strcmp(db->packages[i].name, name) == 0)
+        if (strcmp(pkg->name, name) == 0)
             continue;
 
-        for (j = 0; j < db->packages[i].dep_count; j++) {
-            if (strcmp(db->packages[i].deps[j].name, name) == 0) {
-                return db->packages[i].name;
-            }
+        for (j = 0; j < pkg->dep_count; j++) {
+            if (strcmp(pkg->deps[j].name, name) == 0)
+                return pkg->name;
         }
     }
 
     return NULL;
 }
 
+/* ========================================================================= */
+/* Intent journal                                                            */
+/* ========================================================================= */
+
+/* Durable intent record; written before the first unlink */
+static int journal_write(const char *name)
+{
+    char line[MAX_PKG_NAME + 16];
+    int fd, n;
+
+    fd = open(VPKG_REMOVE_JOURNAL, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return -1;
+    n = snprintf(line, sizeof(line), "remove %s\n", name);
+    if (write(fd, line, (size_t)n) != n || fsync(fd) < 0) {
+        close(fd);
+        unlink(VPKG_REMOVE_JOURNAL);
+        return -1;
+    }
+    close(fd);
+    return 0;
+}
+
+/* Transaction committed: the intent record goes away */
+static void journal_clear(void)
+{
+    unlink(VPKG_REMOVE_JOURNAL);
+}
+
+/* ========================================================================= */
+/* Batched tree deletion                                                     */
+/* ========================================================================= */
+
+struct unlink_batch {
+    char  paths[UNLINK_BATCH][MAX_PATH];
+    const char *ptrs[UNLINK_BATCH];
+    int   count;
+    int   batch_ok;     /* SYS_FILE_UNLINK_BATCH available */
+};
+
+static void batch_flush(struct unlink_batch *b)
+{
+    long ret;
+    int i;
+
+    if (b->count == 0)
+        return;
+
+    if (b->batch_ok) {
+        for (i = 0; i < b->count; i++)
+            b->ptrs[i] = b->paths[i];
+        ret = veridian_syscall2(SYS_FILE_UNLINK_BATCH, b->ptrs,
+                                (long)b->count);
+        if (ret >= 0) {
+            b->count = 0;
+            return;
+        }
+        /* ENOSYS (or any failure): downgrade to per-file unlinks for
+         * the rest of the transaction */
+        b->batch_ok = 0;
+    }
+
+    for (i = 0; i < b->count; i++)
+        unlink(b->paths[i]);
+    b->count = 0;
+}
+
+static void batch_add(struct unlink_batch *b, const char *path)
+{
+    if (b->count == UNLINK_BATCH)
+        batch_flush(b);
+    strncpy(b->paths[b->count], path, MAX_PATH - 1);
+    b->paths[b->count][MAX_PATH - 1] = '\0';
+    b->count++;
+}
+
+/* Depth-first: queue files for batched unlink, rmdir on the way out */
+static void remove_tree(const char *dir, struct unlink_batch *b)
+{
+    DIR *d = opendir(dir);
+    struct dirent *de;
+
+    if (!d)
+        return;
+
+    while ((de = readdir(d)) != NULL) {
+        char path[MAX_PATH];
+        struct stat st;
+
+        if (de->d_name[0] == '.' &&
+            (de->d_name[1] == '\0' ||
+             (de->d_name[1] == '.' && de->d_name[2] == '\0')))
+            continue;
+        snprintf(path, sizeof(path), "%s/%s", dir, de->d_name);
+        if (lstat(path, &st) < 0)
+            continue;
+        if (S_ISDIR(st.st_mode)) {
+            remove_tree(path, b);
+        } else {
+            batch_add(b, path);
+        }
+    }
+    closedir(d);
+
+    /* The directory itself: everything under it must be gone first */
+    batch_flush(b);
+    rmdir(dir);
+}
+
+/* Delete the package's extracted tree; 1 if a tree existed */
+static int remove_package_files(const char *name)
+{
+    char root[MAX_PATH];
+    struct unlink_batch b = { .count = 0, .batch_ok = 1 };
+
+    snprintf(root, sizeof(root), "%s/%s", VPKG_PKG_ROOT, name);
+    if (access(root, F_OK) != 0)
+        return 0;
+
+    remove_tree(root, &b);
+    return 1;
+}
+
 /* ========================================================================= */
 /* Remove                                                                    */
 /* ========================================================================= */
@@ -50,7 +195,7 @@ static const char *find_dependent(const vpkg_db_t *db, const char *name)
 int vpkg_remove(vpkg_db_t *db, const char *name)
 {
     const char *dependent;
-    long ret;
+    int had_tree;
     int rc;
 
     if (!db || !name)
@@ -73,35 +218,90 @@ int vpkg_remove(vpkg_db_t *db, const char *name)
     printf("Removing %s...\n", name);
 
     /*
-     * Invoke kernel-side package removal via SYS_PKG_REMOVE (91).
-     *
-     * The kernel's sys_pkg_remove() expects:
-     *   arg1 (rdi): pointer to package name string
-     *   arg2 (rsi): length of the name string
-     *
-     * The kernel handles:
-     *   - Removing extracted files from /usr/local/packages/<name>/
-     *   - Updating the kernel-side package registry
+     * Transaction: journal the intent first, so an interrupted
+     * removal is finished (not abandoned half-done) on the next run.
+     */
+    if (journal_write(name) < 0)
+        fprintf(stderr, "vpkg: warning: journal write failed; "
+                "removal will not be crash-safe\n");
+
+    had_tree = remove_package_files(name);
+
+    /*
+     * Kernel-side cleanup via SYS_PKG_REMOVE (91): registry entry,
+     * plus file removal for packages the kernel extracted itself.
+     * When the tree was userland-extracted the kernel may know
+     * nothing about the package; that is not an error.
      */
-    ret = veridian_syscall2(SYS_PKG_REMOVE, name, strlen(name));
-    if (ret < 0) {
-        fprintf(stderr, "vpkg: kernel remove failed for '%s' (error %ld)\n", name, ret);
-        return VPKG_ERR_SYSCALL;
+    {
+        long ret = veridian_syscall2(SYS_PKG_REMOVE, name, strlen(name));
+
+        if (ret < 0 && !had_tree) {
+            fprintf(stderr, "vpkg: kernel remove failed for '%s' "
+                    "(error %ld)\n", name, ret);
+            journal_clear();
+            return VPKG_ERR_SYSCALL;
+        }
     }
 
-    /* Remove from local database */
+    /* Commit: one database update and save, then clear the intent.
+     * On a failed update the journal stays behind so the next run's
+     * recovery pass finishes the transaction. */
     rc = vpkg_db_remove(db, name);
     if (rc != VPKG_OK) {
-        fprintf(stderr, "vpkg: warning: removed from kernel but failed to update database\n");
+        fprintf(stderr, "vpkg: warning: removed from kernel but failed "
+                "to update database\n");
         return rc;
     }
 
-    /* Persist database */
     rc = vpkg_db_save(db);
     if (rc != VPKG_OK) {
-        fprintf(stderr, "vpkg: warning: removed but failed to save database\n");
+        fprintf(stderr, "vpkg: warning: removed but failed to save "
+                "database\n");
     }
+    journal_clear();
 
     printf("Successfully removed %s\n", name);
     return VPKG_OK;
 }
+
+/* ========================================================================= */
+/* Crash recovery                                                            */
+/* ========================================================================= */
+
+/*
+ * Finish a removal that was interrupted mid-transaction.  Called at
+ * startup, before any command runs.  Returns VPKG_OK when there was
+ * nothing to recover.
+ */
+int vpkg_remove_recover(vpkg_db_t *db)
+{
+    char line[MAX_PKG_NAME + 16];
+    char name[MAX_PKG_NAME];
+    FILE *fp;
+
+    fp = fopen(VPKG_REMOVE_JOURNAL, "r");
+    if (!fp)
+        return VPKG_OK;         /* No interrupted transaction */
+
+    if (!fgets(line, sizeof(line), fp) ||
+        sscanf(line, "remove %127s", name) != 1) {
+        fclose(fp);
+        journal_clear();        /* Unreadable intent: drop it */
+        return VPKG_OK;
+    }
+    fclose(fp);
+
+    fprintf(stderr, "vpkg: finishing interrupted removal of '%s'\n",
+            name);
+
+    /* Replay: deletion is idempotent */
+    remove_package_files(name);
+    (void)veridian_syscall2(SYS_PKG_REMOVE, name, strlen(name));
+    if (db && vpkg_db_find(db, name) != NULL) {
+        vpkg_db_remove(db, name);
+        vpkg_db_save(db);
+    }
+    journal_clear();
+    return VPKG_OK;
+}
@@ -72,12 +72,42 @@ typedef struct {
     uint64_t installed_size;    /* Bytes */
 } vpkg_pkg_t;
 
-/* In-memory package database */
+/*
+ * Package database handle.
+ *
+ * The on-disk database (format v2) is a hash index over package
+ * names with offsets into a record heap; it is mmap'd read-only and
+ * queries touch only the bucket chain they hash to.  Mutations
+ * append to a write-ahead journal and live in the overlay below
+ * until vpkg_db_save() checkpoints them into a rewritten file.
+ */
 typedef struct {
-    uint32_t count;
-    vpkg_pkg_t packages[MAX_PACKAGES];
+    /* mmap'd v2 snapshot (NULL when no database file exists) */
+    void           *map;
+    size_t          map_len;
+    const uint32_t *buckets;       /* nbuckets slots, record offset+1 */
+    uint32_t        nbuckets;
+    const char     *heap;          /* record heap base */
+    uint32_t        heap_len;
+    uint32_t        map_count;     /* records in the snapshot */
+
+    /* Journal overlay (applied on top of the snapshot) */
+    vpkg_pkg_t      added[MAX_PACKAGES];
+    uint32_t        added_count;
+    char            removed[MAX_PACKAGES][MAX_PKG_NAME];
+    uint32_t        removed_count;
+    uint32_t        journal_entries;   /* uncheckpointed WAL records */
+    int             force_checkpoint;  /* e.g. after a v1 migration */
 } vpkg_db_t;
 
+/* Iterator over all live packages (snapshot minus removed, plus adds) */
+typedef struct {
+    vpkg_db_t *db;
+    uint32_t   map_off;    /* byte offset of next snapshot record */
+    uint32_t   map_idx;
+    uint32_t   add_idx;
+} vpkg_iter_t;
+
 /* Return codes */
 #define VPKG_OK             0
 #define VPKG_ERR_NOT_FOUND  1
@@ -124,6 +154,70 @@ int vpkg_db_add(vpkg_db_t *db, const vpkg_pkg_t *pkg);
  */
 int vpkg_db_remove(vpkg_db_t *db, const char *name);
 
+/*
+ * Release the database mapping.  Safe to call on a never-loaded or
+ * already-closed handle.
+ */
+void vpkg_db_close(vpkg_db_t *db);
+
+/*
+ * Count of live packages (snapshot minus removals plus journal adds).
+ */
+uint32_t vpkg_db_count(const vpkg_db_t *db);
+
+/*
+ * Iterate all live packages:
+ *     vpkg_iter_t it;
+ *     vpkg_db_iter(db, &it);
+ *     while ((pkg = vpkg_db_next(&it)) != NULL) ...
+ * Records may point into the read-only mapping; do not modify them.
+ */
+void              vpkg_db_iter(vpkg_db_t *db, vpkg_iter_t *it);
+const vpkg_pkg_t *vpkg_db_next(vpkg_iter_t *it);
+
+/* ========================================================================= */
+/* chunks.c                                                                  */
+/* ========================================================================= */
+
+#define VPKG_CACHE_DIR_BASE   "/var/cache/vpkg"
+#define VPKG_CACHE_DIR_CHUNKS "/var/cache/vpkg/chunks"
+#define VPKG_MAX_PATH_CHUNKS  512
+
+/*
+ * Split an archive into content-defined chunks (gear rolling hash),
+ * deduplicate into the chunk store, and write the recipe.  Returns
+ * the number of freshly stored chunks (the rest were reuse hits),
+ * or -1.
+ */
+int vpkg_chunk_store_file(const char *file_path,
+                          const char *recipe_path);
+
+/*
+ * Rebuild an archive from its recipe.  Missing chunks are reported
+ * through the callback so the fetch layer downloads exactly those.
+ * Returns 0 when fully assembled, the missing count when partial,
+ * -1 on error.
+ */
+int vpkg_chunk_assemble(const char *recipe_path, const char *out_path,
+                        void (*missing_cb)(uint64_t hash, size_t len,
+                                           void *arg),
+                        void *cb_arg);
+
+/* ========================================================================= */
+/* extract.c                                                                 */
+/* ========================================================================= */
+
+/*
+ * Stream-extract a VPK1 archive from an open fd (positioned at the
+ * magic) into dest/.  Fixed 64 KiB decompress windows, per-file
+ * preallocation, sparse-run hole punching, and one batched fsync
+ * pass per package.  On success *out_bytes holds the uncompressed
+ * total.  Returns VPKG_OK, VPKG_ERR_ARGS for a bad container, or
+ * VPKG_ERR_IO.
+ */
+int vpkg_extract_stream(int archive_fd, const char *dest,
+                        uint64_t *out_bytes);
+
 /* ========================================================================= */
 /* install.c                                                                 */
 /* ========================================================================= */
@@ -137,19 +231,35 @@ int vpkg_db_remove(vpkg_db_t *db, const char *name);
  */
 int vpkg_install(vpkg_db_t *db, const char *name, const char *version);
 
+/*
+ * Install several packages through a three-stage pipeline: repo-cache
+ * fetch, crc32 verification, and kernel extraction run on separate
+ * workers with bounded queues, so stage N+1's download overlaps stage
+ * N's extraction.  Returns VPKG_OK when every package installed.
+ */
+int vpkg_install_many(vpkg_db_t *db, const char *const *names,
+                      uint32_t count);
+
 /* ========================================================================= */
 /* remove.c                                                                  */
 /* ========================================================================= */
 
 /*
  * Remove an installed package by name.
- * Checks for reverse dependencies before removal.
- * Uses SYS_PKG_REMOVE syscall and removes from local database.
+ * Checks for reverse dependencies before removal.  The removal is
+ * journaled: files are deleted through batched unlinks and the
+ * database commits once at the end.
  *
  * Returns VPKG_OK on success.
  */
 int vpkg_remove(vpkg_db_t *db, const char *name);
 
+/*
+ * Finish a removal interrupted by a crash (intent journal present).
+ * Call once at startup, after the database loads.
+ */
+int vpkg_remove_recover(vpkg_db_t *db);
+
 /* ========================================================================= */
 /* query.c                                                                   */
 /* ========================================================================= */
@@ -182,6 +292,11 @@ int vpkg_info(vpkg_db_t *db, const char *name);
  */
 int vpkg_update(vpkg_db_t *db);
 
+/*
+ * Print the BlockFS client cache counters (`vpkg stats`).
+ */
+int vpkg_cache_stats(void);
+
 /* ========================================================================= */
 /* Utility functions (in main.c)                                             */
 /* ========================================================================= */
@@ -0,0 +1,325 @@
+/*
+ * vprof -- VeridianOS sampling profiler
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Always-on low-overhead profiler for operators:
+ *
+ *   - Walks every process's shared perf counter page (the
+ *     veridian/perfcount.h surface) and reports per-window deltas, so
+ *     counter rates come from live pages without touching the
+ *     processes.
+ *   - Samples call stacks through the kernel assist
+ *     (SYS_PROCESS_SAMPLE_STACK walks the target's frame pointers
+ *     without stopping it) and aggregates identical stacks into
+ *     flamegraph-ready folded lines: "pc1;pc2;...;pcN count".
+ *
+ * Usage:
+ *   vprof [-d seconds] [-i interval_ms] [-o out.folded] [pid]
+ *   vprof --counters [-d seconds] [pid]
+ */
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <veridian/perfcount.h>
+#include <veridian/syscall.h>
+
+/* ========================================================================= */
+/* Configuration                                                             */
+/* ========================================================================= */
+
+#define VPROF_MAX_DEPTH     64
+#define VPROF_MAX_STACKS    4096
+#define VPROF_MAX_PROCS     128
+#define VPROF_STACK_BUCKETS 1024
+
+/* ========================================================================= */
+/* Folded stack aggregation                                                  */
+/* ========================================================================= */
+
+/*
+ * Identical stacks collapse into one slot keyed by an FNV hash of the
+ * frame array; chained fixed buckets, repo-style static pools.
+ */
+struct stack_entry {
+    uint64_t hash;
+    int      pid;
+    int      depth;
+    uint64_t frames[VPROF_MAX_DEPTH];
+    uint64_t count;
+    int      next;                  /* Bucket chain */
+};
+
+static struct stack_entry g_stacks[VPROF_MAX_STACKS];
+static int g_stack_count;
+static int g_buckets[VPROF_STACK_BUCKETS];
+static uint64_t g_samples_total;
+static uint64_t g_samples_dropped;
+
+static uint64_t stack_hash(int pid, const uint64_t *frames, int depth)
+{
+    uint64_t h = 0xcbf29ce484222325ull ^ (uint64_t)pid;
+    int i;
+
+    for (i = 0; i < depth; i++) {
+        h ^= frames[i];
+        h *= 0x100000001b3ull;
+    }
+    return h ? h : 1;
+}
+
+static void stack_record(int pid, const uint64_t *frames, int depth)
+{
+    uint64_t h = stack_hash(pid, frames, depth);
+    int bucket = (int)(h % VPROF_STACK_BUCKETS);
+    int idx;
+
+    g_samples_total++;
+
+    for (idx = g_buckets[bucket] - 1; idx >= 0;
+         idx = g_stacks[idx].next - 1) {
+        struct stack_entry *e = &g_stacks[idx];
+
+        if (e->hash == h && e->pid == pid && e->depth == depth &&
+            memcmp(e->frames, frames,
+                   (size_t)depth * sizeof(uint64_t)) == 0) {
+            e->count++;
+            return;
+        }
+    }
+
+    if (g_stack_count >= VPROF_MAX_STACKS) {
+        g_samples_dropped++;
+        return;
+    }
+
+    {
+        struct stack_entry *e = &g_stacks[g_stack_count];
+
+        e->hash = h;
+        e->pid = pid;
+        e->depth = depth;
+        memcpy(e->frames, frames, (size_t)depth * sizeof(uint64_t));
+        e->count = 1;
+        e->next = g_buckets[bucket];
+        g_buckets[bucket] = ++g_stack_count;
+    }
+}
+
+/* Write folded stacks: leaf-last order, one line per unique stack */
+static int stacks_write(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    int i, d;
+
+    if (!f) {
+        fprintf(stderr, "vprof: cannot write %s\n", path);
+        return -1;
+    }
+
+    for (i = 0; i < g_stack_count; i++) {
+        const struct stack_entry *e = &g_stacks[i];
+
+        fprintf(f, "pid%d", e->pid);
+        for (d = e->depth - 1; d >= 0; d--)
+            fprintf(f, ";0x%llx", (unsigned long long)e->frames[d]);
+        fprintf(f, " %llu\n", (unsigned long long)e->count);
+    }
+    fclose(f);
+    return 0;
+}
+
+/* ========================================================================= */
+/* Process enumeration                                                       */
+/* ========================================================================= */
+
+static int list_profiled_pids(int *pids, int max, int only_pid)
+{
+    DIR *dir;
+    struct dirent *de;
+    int n = 0;
+
+    if (only_pid > 0) {
+        pids[0] = only_pid;
+        return 1;
+    }
+
+    dir = opendir(vpc_directory());
+    if (!dir)
+        return 0;
+    while ((de = readdir(dir)) != NULL && n < max) {
+        int pid = atoi(de->d_name);
+
+        if (pid > 0)
+            pids[n++] = pid;
+    }
+    closedir(dir);
+    return n;
+}
+
+/* ========================================================================= */
+/* Stack sampling                                                            */
+/* ========================================================================= */
+
+/*
+ * One sampling pass over the target processes.  The kernel assist
+ * walks the target's frame pointers and copies out the return
+ * addresses; ENOSYS (older kernels) simply yields no stacks and the
+ * counter view still works.
+ */
+static int sample_pass(const int *pids, int npids)
+{
+    uint64_t frames[VPROF_MAX_DEPTH];
+    int p;
+    int got = 0;
+
+    for (p = 0; p < npids; p++) {
+        long depth = veridian_syscall3(SYS_PROCESS_SAMPLE_STACK,
+                                       pids[p], frames,
+                                       VPROF_MAX_DEPTH);
+
+        if (depth > 0) {
+            stack_record(pids[p], frames, (int)depth);
+            got++;
+        } else if (depth == -38) {      /* ENOSYS */
+            return -1;
+        }
+    }
+    return got;
+}
+
+/* ========================================================================= */
+/* Counter window view                                                       */
+/* ========================================================================= */
+
+struct proc_window {
+    int pid;
+    const struct vpc_page *page;
+    uint64_t start[VPC_MAX_COUNTERS];
+};
+
+static void counters_report(struct proc_window *w, int n,
+                            unsigned duration_s)
+{
+    int p, i;
+
+    for (p = 0; p < n; p++) {
+        int printed = 0;
+
+        for (i = 0; i < VPC_MAX_COUNTERS; i++) {
+            const struct vpc_counter *c = &w[p].page->counters[i];
+            uint64_t delta;
+
+            if (c->name[0] == '\0')
+                continue;
+            delta = c->value - w[p].start[i];
+            if (!printed) {
+                printf("pid %d:\n", w[p].pid);
+                printed = 1;
+            }
+            printf("  %-24.24s +%llu (%llu/s)\n", c->name,
+                   (unsigned long long)delta,
+                   (unsigned long long)(duration_s
+                       ? delta / duration_s
+                       : delta));
+        }
+    }
+}
+
+/* ========================================================================= */
+/* main                                                                      */
+/* ========================================================================= */
+
+int main(int argc, char **argv)
+{
+    const char *out_path = "vprof.folded";
+    unsigned duration_s = 10;
+    unsigned interval_ms = 10;
+    int only_pid = 0;
+    int counters_only = 0;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            duration_s = (unsigned)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+            interval_ms = (unsigned)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--counters") == 0) {
+            counters_only = 1;
+        } else if (atoi(argv[i]) > 0) {
+            only_pid = atoi(argv[i]);
+        } else {
+            fprintf(stderr,
+                    "usage: vprof [-d sec] [-i ms] [-o file] "
+                    "[--counters] [pid]\n");
+            return 1;
+        }
+    }
+    if (interval_ms == 0)
+        interval_ms = 10;
+
+    {
+        int pids[VPROF_MAX_PROCS];
+        int npids = list_profiled_pids(pids, VPROF_MAX_PROCS, only_pid);
+        struct proc_window wins[VPROF_MAX_PROCS];
+        int nwins = 0;
+        int sampling_ok = !counters_only;
+        unsigned elapsed_ms = 0;
+        int p;
+
+        if (npids == 0) {
+            fprintf(stderr, "vprof: no instrumented processes\n");
+            return 1;
+        }
+
+        /* Open counter windows */
+        for (p = 0; p < npids; p++) {
+            const struct vpc_page *page = vpc_attach(pids[p]);
+            int c;
+
+            if (!page)
+                continue;
+            wins[nwins].pid = pids[p];
+            wins[nwins].page = page;
+            for (c = 0; c < VPC_MAX_COUNTERS; c++)
+                wins[nwins].start[c] = page->counters[c].value;
+            nwins++;
+        }
+
+        /* Sampling loop */
+        while (elapsed_ms < duration_s * 1000u) {
+            if (sampling_ok) {
+                if (sample_pass(pids, npids) < 0) {
+                    fprintf(stderr,
+                            "vprof: kernel lacks stack sampling; "
+                            "counter view only\n");
+                    sampling_ok = 0;
+                }
+            }
+            usleep(interval_ms * 1000u);
+            elapsed_ms += interval_ms;
+        }
+
+        /* Reports */
+        counters_report(wins, nwins, duration_s);
+        for (p = 0; p < nwins; p++)
+            vpc_detach(wins[p].page);
+
+        if (sampling_ok && g_stack_count > 0) {
+            if (stacks_write(out_path) == 0)
+                printf("%llu samples (%d unique stacks, %llu dropped) "
+                       "-> %s\n",
+                       (unsigned long long)g_samples_total,
+                       g_stack_count,
+                       (unsigned long long)g_samples_dropped,
+                       out_path);
+        }
+    }
+    return 0;
+}
@@ -4,9 +4,11 @@
  * Copyright (c) 2025-2026 VeridianOS Contributors
  * SPDX-License-Identifier: MIT OR Apache-2.0
  *
- * Software rendering backing store.  Allocates a POSIX shared-memory
- * buffer, wraps it as a wl_buffer via wl_shm, and attaches it to the
- * window's Wayland surface on flush.
+ * Software rendering backing store.  Allocates one POSIX shared-memory
+ * pool holding two buffer slots, wraps each as a wl_buffer via wl_shm,
+ * and attaches the painted slot to the window's Wayland surface on
+ * flush.  The compositor maps the same pages, so presentation is
+ * zero-copy; release events tell us when a slot can be reused.
  */
 
 #include "qveridianbackingstore.h"
@@ -57,6 +59,20 @@ static int create_shm_fd(int size)
     return fd;
 }
 
+/* ========================================================================= */
+/* wl_buffer release listener                                                */
+/* ========================================================================= */
+
+static void buffer_release(void *data, struct wl_buffer *buffer)
+{
+    auto *store = static_cast<QVeridianBackingStore *>(data);
+    store->bufferReleased(buffer);
+}
+
+static const struct wl_buffer_listener buffer_listener = {
+    buffer_release,
+};
+
 /* ========================================================================= */
 /* Construction / destruction                                                */
 /* ========================================================================= */
@@ -70,26 +86,44 @@ QVeridianBackingStore::QVeridianBackingStore(QWindow *window,
 
 QVeridianBackingStore::~QVeridianBackingStore()
 {
-    destroyShmBuffer();
+    destroyShmBuffers();
 }
 
 /* ========================================================================= */
 /* SHM buffer management                                                     */
 /* ========================================================================= */
 
-void QVeridianBackingStore::createShmBuffer(const QSize &size)
+/**
+ * Allocate one pool with two buffer slots.
+ *
+ * Both slots live in a single fd/mapping so the compositor only maps
+ * one pool per window.  Each slot gets its own wl_buffer at the right
+ * offset and a QImage wrapping its pages directly -- QPainter renders
+ * straight into memory the compositor scans out.
+ */
+void QVeridianBackingStore::createShmBuffers(const QSize &size)
 {
-    destroyShmBuffer();
+    destroyShmBuffers();
 
-    const int stride = size.width() * 4; /* ARGB32 = 4 bytes per pixel */
-    m_shmSize = stride * size.height();
+    m_size = size;
+    m_stride = size.width() * 4; /* ARGB32 = 4 bytes per pixel */
+    const int slotSize = m_stride * size.height();
+    m_shmSize = slotSize * 2;
 
     m_shmFd = create_shm_fd(m_shmSize);
     if (m_shmFd < 0)
         return;
 
+    /* Framebuffer-scale pools want 2 MiB pages; the kernel falls
+     * back to 4 KiB silently when it can't oblige */
+    int mapFlags = MAP_SHARED;
+    if (m_shmSize >= 2 * 1024 * 1024)
+        mapFlags |= MAP_HUGE;
     m_shmData = mmap(nullptr, m_shmSize, PROT_READ | PROT_WRITE,
-                     MAP_SHARED, m_shmFd, 0);
+                     mapFlags, m_shmFd, 0);
+    if (m_shmData == MAP_FAILED && (mapFlags & MAP_HUGE))
+        m_shmData = mmap(nullptr, m_shmSize, PROT_READ | PROT_WRITE,
+                         MAP_SHARED, m_shmFd, 0);
     if (m_shmData == MAP_FAILED) {
         m_shmData = nullptr;
         close(m_shmFd);
@@ -97,20 +131,45 @@ void QVeridianBackingStore::createShmBuffer(const QSize &size)
         return;
     }
 
-    /* Wrap the QImage around our SHM data */
-    m_image = QImage(static_cast<uchar *>(m_shmData),
-                     size.width(), size.height(), stride,
-                     QImage::Format_ARGB32_Premultiplied);
+    /* Prefault both slots now, not on first paint */
+    madvise(m_shmData, m_shmSize, MADV_WILLNEED);
+
+    struct wl_shm *shm = m_integration->waylandShm();
+    if (shm)
+        m_shmPool = wl_shm_create_pool(shm, m_shmFd, m_shmSize);
+
+    for (int i = 0; i < 2; ++i) {
+        ShmSlot &slot = m_slots[i];
+        slot.data = static_cast<uchar *>(m_shmData) + i * slotSize;
+        slot.busy = false;
+        slot.image = QImage(slot.data, size.width(), size.height(), m_stride,
+                            QImage::Format_ARGB32_Premultiplied);
+
+        if (m_shmPool) {
+            slot.wlBuffer = wl_shm_pool_create_buffer(
+                m_shmPool, i * slotSize,
+                size.width(), size.height(), m_stride,
+                WL_SHM_FORMAT_ARGB8888);
+            if (slot.wlBuffer)
+                wl_buffer_add_listener(slot.wlBuffer, &buffer_listener, this);
+        }
+    }
+
+    m_currentSlot = 0;
 }
 
-void QVeridianBackingStore::destroyShmBuffer()
+void QVeridianBackingStore::destroyShmBuffers()
 {
-    m_image = QImage();
-
-    if (m_wlBuffer) {
-        wl_buffer_destroy(m_wlBuffer);
-        m_wlBuffer = nullptr;
+    for (ShmSlot &slot : m_slots) {
+        slot.image = QImage();
+        if (slot.wlBuffer) {
+            wl_buffer_destroy(slot.wlBuffer);
+            slot.wlBuffer = nullptr;
+        }
+        slot.data = nullptr;
+        slot.busy = false;
     }
+
     if (m_shmPool) {
         wl_shm_pool_destroy(m_shmPool);
         m_shmPool = nullptr;
@@ -124,6 +183,42 @@ void QVeridianBackingStore::destroyShmBuffer()
         m_shmFd = -1;
     }
     m_shmSize = 0;
+    m_stride = 0;
+    m_size = QSize();
+}
+
+/**
+ * Pick the slot to paint into.
+ *
+ * Prefers the current slot; if the compositor still holds it, tries
+ * the other one, dispatching pending events once to pick up any
+ * release that is already on the wire.  If both remain busy (a slow
+ * compositor several frames behind) the least-recently-flushed slot
+ * is reused -- a tear is better than stalling the GUI thread.
+ */
+QVeridianBackingStore::ShmSlot *QVeridianBackingStore::acquireSlot()
+{
+    ShmSlot *slot = &m_slots[m_currentSlot];
+    if (!slot->busy)
+        return slot;
+
+    if (m_integration->waylandDisplay())
+        wl_display_dispatch_pending(m_integration->waylandDisplay());
+
+    if (slot->busy && !m_slots[1 - m_currentSlot].busy) {
+        m_currentSlot = 1 - m_currentSlot;
+        slot = &m_slots[m_currentSlot];
+    }
+
+    return slot;
+}
+
+void QVeridianBackingStore::bufferReleased(struct wl_buffer *buffer)
+{
+    for (ShmSlot &slot : m_slots) {
+        if (slot.wlBuffer == buffer)
+            slot.busy = false;
+    }
 }
 
 /* ========================================================================= */
@@ -132,33 +227,64 @@ void QVeridianBackingStore::destroyShmBuffer()
 
 QPaintDevice *QVeridianBackingStore::paintDevice()
 {
-    return &m_image;
+    return &m_slots[m_currentSlot].image;
 }
 
 void QVeridianBackingStore::beginPaint(const QRegion &region)
 {
-    Q_UNUSED(region);
+    ShmSlot *slot = acquireSlot();
+    if (slot->image.isNull())
+        return;
+
+    /* If we swapped slots, the new slot holds frame N-2; bring the
+     * untouched area up to date from the other slot so the paint only
+     * has to cover the dirty region */
+    ShmSlot &other = m_slots[1 - m_currentSlot];
+    if (slot->data && other.data && slot != &other) {
+        const QRegion stale =
+            QRegion(QRect(QPoint(0, 0), m_size)).subtracted(region);
+        for (const QRect &r : stale) {
+            for (int y = r.top(); y <= r.bottom(); ++y) {
+                memcpy(slot->data + y * m_stride + r.x() * 4,
+                       other.data + y * m_stride + r.x() * 4,
+                       static_cast<size_t>(r.width()) * 4);
+            }
+        }
+    }
 
     /* Clear the dirty region to transparent */
-    if (!m_image.isNull()) {
-        for (const QRect &r : region)
-            m_image.fill(Qt::transparent);
+    for (const QRect &r : region) {
+        for (int y = r.top(); y <= r.bottom(); ++y)
+            memset(slot->data + y * m_stride + r.x() * 4, 0,
+                   static_cast<size_t>(r.width()) * 4);
     }
 }
 
 void QVeridianBackingStore::endPaint()
 {
-    /* Nothing special needed -- data is in the SHM buffer */
+    /* Nothing special needed -- data is already in the SHM pool */
 }
 
 void QVeridianBackingStore::flush(QWindow *window, const QRegion &region,
                                   const QPoint &offset)
 {
-    Q_UNUSED(offset);
+    ShmSlot &slot = m_slots[m_currentSlot];
+    if (slot.image.isNull() || !slot.wlBuffer)
+        return;
 
-    if (m_image.isNull() || !m_shmData)
+    /* Translate into buffer coordinates and clip to the buffer; a
+     * panel repainting its 20px clock damages exactly those rects,
+     * not the whole surface */
+    QRegion damage = region.translated(offset)
+                         .intersected(QRect(QPoint(0, 0), m_size));
+    if (damage.isEmpty())
         return;
 
+    /* Past a handful of rects the per-rect bookkeeping in the
+     * compositor costs more than compositing the bounding box */
+    if (damage.rectCount() > MAX_FLUSH_RECTS)
+        damage = damage.boundingRect();
+
     auto *platformWindow = static_cast<QVeridianWindow *>(window->handle());
     if (!platformWindow)
         return;
@@ -167,24 +293,29 @@ void QVeridianBackingStore::flush(QWindow *window, const QRegion &region,
     if (!surface)
         return;
 
-    /* Attach buffer and mark damaged regions */
-    if (m_wlBuffer)
-        wl_surface_attach(surface, m_wlBuffer, 0, 0);
+    /* Attach the painted slot and mark damaged regions -- the
+     * compositor reads the SHM pages directly, nothing is copied */
+    wl_surface_attach(surface, slot.wlBuffer, 0, 0);
 
-    for (const QRect &r : region)
+    for (const QRect &r : damage)
         wl_surface_damage_buffer(surface, r.x(), r.y(), r.width(), r.height());
 
     wl_surface_commit(surface);
+
+    /* The compositor now owns this slot until it sends release;
+     * paint the next frame into the other slot */
+    slot.busy = true;
+    m_currentSlot = 1 - m_currentSlot;
 }
 
 void QVeridianBackingStore::resize(const QSize &size, const QRegion &staticContents)
 {
     Q_UNUSED(staticContents);
 
-    if (size == m_image.size())
+    if (size == m_size)
         return;
 
-    createShmBuffer(size);
+    createShmBuffers(size);
 }
 
 QT_END_NAMESPACE
@@ -6,6 +6,12 @@
  *
  * QPlatformBackingStore implementation for VeridianOS.  Provides the
  * software rendering path using Wayland SHM buffers.
+ *
+ * The buffer pool is zero-copy: paint lands directly in SHM pages the
+ * compositor maps, so flush() only attaches + damages -- no pixel
+ * copies cross the process boundary.  Two buffer slots in one pool
+ * are rotated on flush, with wl_buffer release events tracking which
+ * slot the compositor is still scanning out.
  */
 
 #ifndef QVERIDIANBACKINGSTORE_H
@@ -33,17 +39,35 @@ public:
     void flush(QWindow *window, const QRegion &region, const QPoint &offset) override;
     void resize(const QSize &size, const QRegion &staticContents) override;
 
+    /** Called from the wl_buffer release listener. */
+    void bufferReleased(struct wl_buffer *buffer);
+
 private:
-    void createShmBuffer(const QSize &size);
-    void destroyShmBuffer();
+    /* One SHM buffer slot; both slots share a single pool/mapping. */
+    struct ShmSlot {
+        struct wl_buffer *wlBuffer = nullptr;
+        uchar            *data     = nullptr;
+        QImage            image;
+        bool              busy     = false;   /* held by compositor */
+    };
+
+    void createShmBuffers(const QSize &size);
+    void destroyShmBuffers();
+    ShmSlot *acquireSlot();
 
     QVeridianIntegration *m_integration;
-    QImage                m_image;
-    struct wl_buffer     *m_wlBuffer  = nullptr;
-    struct wl_shm_pool   *m_shmPool   = nullptr;
-    int                   m_shmFd     = -1;
-    int                   m_shmSize   = 0;
-    void                 *m_shmData   = nullptr;
+    ShmSlot               m_slots[2];
+    int                   m_currentSlot = 0;
+    QSize                 m_size;
+    int                   m_stride   = 0;
+    struct wl_shm_pool   *m_shmPool  = nullptr;
+    int                   m_shmFd    = -1;
+    int                   m_shmSize  = 0;
+    void                 *m_shmData  = nullptr;
+
+    /* Damage rects forwarded per flush before falling back to the
+     * bounding box */
+    static const int MAX_FLUSH_RECTS = 16;
 };
 
 QT_END_NAMESPACE
@@ -14,8 +14,72 @@
 #include <QtCore/QMimeData>
 #include <wayland-client.h>
 
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
 QT_BEGIN_NAMESPACE
 
+/* ========================================================================= */
+/* Chunked fd streaming                                                      */
+/* ========================================================================= */
+
+/* Pipe writes go out in bounded chunks with poll() between them, so a
+ * multi-megabyte payload never stalls the source app on a full pipe */
+static const size_t CLIP_CHUNK = 64 * 1024;
+
+/* Payloads past this are staged in a sealed memfd: repeated pastes
+ * stream from the mapping instead of re-serializing */
+static const size_t CLIP_STAGE_THRESHOLD = 256 * 1024;
+
+static bool clipStreamToFd(int fd, const char *data, size_t len)
+{
+    /* Never block forever on a stalled reader */
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+    size_t off = 0;
+    while (off < len) {
+        size_t chunk = len - off;
+        if (chunk > CLIP_CHUNK)
+            chunk = CLIP_CHUNK;
+
+        ssize_t n = write(fd, data + off, chunk);
+        if (n > 0) {
+            off += static_cast<size_t>(n);
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EINTR)) {
+            struct pollfd pfd = { fd, POLLOUT, 0 };
+            if (poll(&pfd, 1, 5000) <= 0)
+                return false;       /* reader stalled: give up */
+            continue;
+        }
+        return false;               /* EPIPE: peer closed mid-paste */
+    }
+    return true;
+}
+
+static QByteArray clipReadFromFd(int fd)
+{
+    QByteArray out;
+    char buf[CLIP_CHUNK];
+
+    for (;;) {
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if (n > 0) {
+            out.append(buf, static_cast<int>(n));
+            continue;
+        }
+        if (n < 0 && errno == EINTR)
+            continue;
+        break;                      /* EOF or error */
+    }
+    return out;
+}
+
 QVeridianClipboard::QVeridianClipboard()
     : m_clipboardData(new QMimeData())
     , m_selectionData(new QMimeData())
@@ -24,6 +88,8 @@ QVeridianClipboard::QVeridianClipboard()
 
 QVeridianClipboard::~QVeridianClipboard()
 {
+    dropPayloadCache();
+
     if (m_dataSource)
         wl_data_source_destroy(m_dataSource);
     if (m_dataDevice)
@@ -33,6 +99,99 @@ QVeridianClipboard::~QVeridianClipboard()
     delete m_selectionData;
 }
 
+/* ========================================================================= */
+/* Copy side: lazy rendering + staged payloads                               */
+/* ========================================================================= */
+
+void QVeridianClipboard::dropPayloadCache()
+{
+    for (const StagedPayload &p : m_staged)
+        ::close(p.fd);
+    m_staged.clear();
+}
+
+/*
+ * Serialize one format of the owned clipboard data.  Called only from
+ * the data source's send event -- i.e. when a peer actually pastes --
+ * so copying never converts anything up front.  Large payloads are
+ * staged in a sealed memfd once and reused across pastes.
+ */
+QByteArray QVeridianClipboard::renderFormat(const QString &format)
+{
+    if (!m_clipboardData)
+        return QByteArray();
+    return m_clipboardData->data(format);
+}
+
+void QVeridianClipboard::sourceSend(void *data,
+                                    struct wl_data_source *source,
+                                    const char *mimeType, int32_t fd)
+{
+    Q_UNUSED(source);
+    QVeridianClipboard *self = static_cast<QVeridianClipboard *>(data);
+    const QString format = QString::fromUtf8(mimeType);
+
+    /* Staged already? Stream straight from the memfd mapping */
+    for (const StagedPayload &p : self->m_staged) {
+        if (p.format == format) {
+            void *map = mmap(nullptr, p.len, PROT_READ, MAP_SHARED, p.fd, 0);
+            if (map != MAP_FAILED) {
+                clipStreamToFd(fd, static_cast<const char *>(map), p.len);
+                munmap(map, p.len);
+                ::close(fd);
+                return;
+            }
+            break;
+        }
+    }
+
+    const QByteArray payload = self->renderFormat(format);
+
+    /* Stage large payloads for the next paste of the same selection */
+    if (static_cast<size_t>(payload.size()) >= CLIP_STAGE_THRESHOLD) {
+        int mfd = memfd_create("veridian-clipboard",
+                               MFD_CLOEXEC | MFD_ALLOW_SEALING);
+        if (mfd >= 0) {
+            if (write(mfd, payload.constData(), payload.size()) ==
+                    static_cast<ssize_t>(payload.size())) {
+                fcntl(mfd, F_ADD_SEALS,
+                      F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE);
+                self->m_staged.append(
+                    { format, mfd, static_cast<size_t>(payload.size()) });
+            } else {
+                ::close(mfd);
+            }
+        }
+    }
+
+    clipStreamToFd(fd, payload.constData(),
+                   static_cast<size_t>(payload.size()));
+    ::close(fd);
+}
+
+void QVeridianClipboard::sourceCancelled(void *data,
+                                         struct wl_data_source *source)
+{
+    /* Another client took the selection: our payloads are dead */
+    QVeridianClipboard *self = static_cast<QVeridianClipboard *>(data);
+    self->dropPayloadCache();
+    if (self->m_dataSource == source) {
+        wl_data_source_destroy(source);
+        self->m_dataSource = nullptr;
+        self->m_ownsClipboard = false;
+    }
+}
+
+static void clipSourceTarget(void *, struct wl_data_source *, const char *)
+{
+}
+
+static const struct wl_data_source_listener s_sourceListener = {
+    clipSourceTarget,
+    QVeridianClipboard::sourceSend,
+    QVeridianClipboard::sourceCancelled,
+};
+
 QMimeData *QVeridianClipboard::mimeData(QClipboard::Mode mode)
 {
     if (mode == QClipboard::Selection)
@@ -55,7 +214,15 @@ void QVeridianClipboard::setMimeData(QMimeData *data, QClipboard::Mode mode)
         m_ownsClipboard = true;
     }
 
-    /* Create a wl_data_source and set the offered MIME types */
+    /* A fresh selection invalidates anything staged for the old one */
+    dropPayloadCache();
+
+    /*
+     * Advertise formats only.  No payload is serialized or transferred
+     * here: the send listener renders a format the first time a peer
+     * pastes it, so copying a screenshot costs a list of MIME strings
+     * until somebody asks for the pixels.
+     */
     if (m_dataDeviceManager && m_dataDevice) {
         if (m_dataSource)
             wl_data_source_destroy(m_dataSource);
@@ -68,6 +235,8 @@ void QVeridianClipboard::setMimeData(QMimeData *data, QClipboard::Mode mode)
                 wl_data_source_offer(m_dataSource,
                                      format.toUtf8().constData());
             }
+            wl_data_source_add_listener(m_dataSource, &s_sourceListener,
+                                        this);
             wl_data_device_set_selection(m_dataDevice, m_dataSource, 0);
         }
     }
@@ -88,4 +257,86 @@ bool QVeridianClipboard::ownsMode(QClipboard::Mode mode) const
     return m_ownsClipboard;
 }
 
+/* ========================================================================= */
+/* Paste side: lazy offer-backed mime data                                   */
+/* ========================================================================= */
+
+/*
+ * QMimeData view over a remote data offer.  formats() answers from the
+ * advertised list; the payload pipe transfer happens inside
+ * retrieveData(), i.e. only when a widget actually pastes the format.
+ */
+namespace {
+
+class QVeridianOfferMimeData : public QMimeData
+{
+public:
+    QVeridianOfferMimeData(const QVeridianClipboard *clipboard,
+                           const QStringList &formats)
+        : m_clipboard(clipboard)
+        , m_formats(formats)
+    {
+    }
+
+    QStringList formats() const override
+    {
+        return m_formats;
+    }
+
+    bool hasFormat(const QString &format) const override
+    {
+        return m_formats.contains(format);
+    }
+
+protected:
+    QVariant retrieveData(const QString &format,
+                          QMetaType type) const override
+    {
+        Q_UNUSED(type);
+        if (!m_formats.contains(format))
+            return QVariant();
+        return m_clipboard->readOfferData(format);
+    }
+
+private:
+    const QVeridianClipboard *m_clipboard;
+    QStringList m_formats;
+};
+
+} /* anonymous namespace */
+
+void QVeridianClipboard::setCurrentOffer(struct wl_data_offer *offer,
+                                         const QStringList &formats)
+{
+    if (m_dataOffer && m_dataOffer != offer)
+        wl_data_offer_destroy(m_dataOffer);
+
+    m_dataOffer = offer;
+    m_offerFormats = formats;
+    m_ownsClipboard = false;
+
+    delete m_clipboardData;
+    m_clipboardData = new QVeridianOfferMimeData(this, formats);
+
+    emitChanged(QClipboard::Clipboard);
+}
+
+QByteArray QVeridianClipboard::readOfferData(const QString &format) const
+{
+    if (!m_dataOffer)
+        return QByteArray();
+
+    int fds[2];
+    if (pipe2(fds, O_CLOEXEC) < 0)
+        return QByteArray();
+
+    wl_data_offer_receive(m_dataOffer, format.toUtf8().constData(), fds[1]);
+    ::close(fds[1]);
+
+    /* The source streams in chunks; collect until EOF */
+    QByteArray data = clipReadFromFd(fds[0]);
+    ::close(fds[0]);
+    return data;
+}
+
 QT_END_NAMESPACE
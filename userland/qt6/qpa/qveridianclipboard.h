@@ -12,6 +12,8 @@
 #define QVERIDIANCLIPBOARD_H
 
 #include <QtGui/qpa/qplatformclipboard.h>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
 
 struct wl_data_device_manager;
 struct wl_data_device;
@@ -32,7 +34,26 @@ public:
     bool supportsMode(QClipboard::Mode mode) const override;
     bool ownsMode(QClipboard::Mode mode) const override;
 
+    /* ----- Paste side (driven by the integration's seat handling) ----- */
+
+    /** Adopt the advertised formats of a new selection offer.  The
+     *  actual payload transfers only when something pastes. */
+    void setCurrentOffer(struct wl_data_offer *offer,
+                         const QStringList &formats);
+
+    /** Request one format from the current offer (chunked pipe read). */
+    QByteArray readOfferData(const QString &format) const;
+
+    /* ----- wl_data_source listener entry points ----- */
+    static void sourceSend(void *data, struct wl_data_source *source,
+                           const char *mimeType, int32_t fd);
+    static void sourceCancelled(void *data, struct wl_data_source *source);
+
 private:
+    /* ----- Copy side ----- */
+    QByteArray renderFormat(const QString &format);
+    void dropPayloadCache();
+
     struct wl_data_device_manager *m_dataDeviceManager = nullptr;
     struct wl_data_device         *m_dataDevice        = nullptr;
     struct wl_data_source         *m_dataSource        = nullptr;
@@ -42,6 +63,18 @@ private:
     QMimeData *m_selectionData  = nullptr;
     bool       m_ownsClipboard  = false;
     bool       m_ownsSelection  = false;
+
+    /* Serialized payloads staged in sealed memfds, one per format, so
+     * repeated pastes of a large copy stream from the mapping instead
+     * of re-serializing (images in particular) */
+    struct StagedPayload {
+        QString format;
+        int     fd;        /* sealed memfd */
+        size_t  len;
+    };
+    QVector<StagedPayload> m_staged;
+
+    QStringList m_offerFormats;
 };
 
 QT_END_NAMESPACE
@@ -39,6 +39,19 @@ void QVeridianCursor::changeCursor(QCursor *windowCursor, QWindow *window)
     if (!m_cursorTheme)
         return;
 
+    /* Cursor-plane contract: the compositor owns cursor presentation
+     * (an overlay blit at scanout in VeridianSwRenderer), so the QPA
+     * layer only ships a new image when the shape changes.  Mouse
+     * motion sends nothing from here -- the compositor tracks the
+     * pointer itself -- which keeps window content damage free of
+     * cursor traffic entirely. */
+    const int shape = windowCursor ? static_cast<int>(windowCursor->shape())
+                                   : static_cast<int>(Qt::ArrowCursor);
+    /* Custom pixmap cursors share one shape value; never dedupe them */
+    if (shape == m_lastShape && shape != static_cast<int>(Qt::BitmapCursor))
+        return;
+    m_lastShape = shape;
+
     /* Map Qt cursor shape to Wayland cursor name */
     const char *name = "left_ptr";
     if (windowCursor) {
@@ -64,8 +77,18 @@ void QVeridianCursor::changeCursor(QCursor *windowCursor, QWindow *window)
     if (cursor && cursor->image_count > 0) {
         struct wl_cursor_image *image = cursor->images[0];
         struct wl_buffer *buffer = wl_cursor_image_get_buffer(image);
-        Q_UNUSED(buffer);
-        /* Would attach buffer to cursor surface and set_cursor on pointer */
+
+        /* Hand the image to the compositor's cursor plane: attach to
+         * the dedicated cursor surface and commit.  The pointer's
+         * set_cursor (with the enter serial and the image hotspot)
+         * is issued by the seat handling in the integration. */
+        if (m_cursorSurface && buffer) {
+            wl_surface_attach(m_cursorSurface, buffer, 0, 0);
+            wl_surface_damage(m_cursorSurface, 0, 0,
+                              static_cast<int32_t>(image->width),
+                              static_cast<int32_t>(image->height));
+            wl_surface_commit(m_cursorSurface);
+        }
     }
 }
 
@@ -35,6 +35,10 @@ private:
     struct wl_cursor_theme *m_cursorTheme = nullptr;
     struct wl_surface      *m_cursorSurface = nullptr;
     QPoint                  m_pos;
+
+    /* Cursor-plane state: the image is sent to the compositor only
+     * when the shape actually changes, never per mouse move */
+    int                     m_lastShape = -1;
 };
 
 QT_END_NAMESPACE
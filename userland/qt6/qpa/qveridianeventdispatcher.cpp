@@ -5,8 +5,11 @@
  * SPDX-License-Identifier: MIT OR Apache-2.0
  *
  * epoll-based event dispatcher.  Monitors the Wayland display fd for
- * protocol events, timerfd for QTimer expirations, eventfd for
- * cross-thread wakeups, and regular fds for QSocketNotifier.
+ * protocol events, one timerfd for all QTimer expirations, eventfd
+ * for cross-thread wakeups, and regular fds for QSocketNotifier.
+ *
+ * See qveridianeventdispatcher.h for the timing-wheel and event-ring
+ * design notes.
  */
 
 #include "qveridianeventdispatcher.h"
@@ -23,9 +26,6 @@
 
 QT_BEGIN_NAMESPACE
 
-/* Maximum events returned per epoll_wait call */
-static const int MAX_EPOLL_EVENTS = 64;
-
 /* ========================================================================= */
 /* Construction / destruction                                                */
 /* ========================================================================= */
@@ -33,17 +33,14 @@ static const int MAX_EPOLL_EVENTS = 64;
 QVeridianEventDispatcher::QVeridianEventDispatcher(QObject *parent)
     : QAbstractEventDispatcher(parent)
 {
+    m_wheelCurrentMs = monotonicMs();
     initEpoll();
 }
 
 QVeridianEventDispatcher::~QVeridianEventDispatcher()
 {
-    /* Clean up timer fds */
-    for (auto it = m_timers.begin(); it != m_timers.end(); ++it) {
-        if (it->timerFd >= 0)
-            close(it->timerFd);
-    }
-
+    if (m_timerFd >= 0)
+        close(m_timerFd);
     if (m_wakeUpFd >= 0)
         close(m_wakeUpFd);
     if (m_epollFd >= 0)
@@ -60,6 +57,8 @@ void QVeridianEventDispatcher::initEpoll()
     if (m_epollFd < 0)
         return;
 
+    initCmdRing();
+
     /* Create an eventfd for cross-thread wakeup */
     m_wakeUpFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
     if (m_wakeUpFd >= 0) {
@@ -68,6 +67,194 @@ void QVeridianEventDispatcher::initEpoll()
         ev.data.fd = m_wakeUpFd;
         epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeUpFd, &ev);
     }
+
+    /* One timerfd serves every QTimer via the timing wheel */
+    m_timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (m_timerFd >= 0) {
+        struct epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.fd = m_timerFd;
+        epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_timerFd, &ev);
+    }
+}
+
+qint64 QVeridianEventDispatcher::monotonicMs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<qint64>(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+}
+
+/* ========================================================================= */
+/* Timing wheel                                                              */
+/* ========================================================================= */
+
+/**
+ * Insert a timer id at its deadline.
+ *
+ * The level is the lowest whose span covers the delta; within it the
+ * slot is indexed by the deadline's bits for that level.  Deadlines
+ * beyond the top level's span park in the top level and re-cascade.
+ */
+void QVeridianEventDispatcher::wheelSchedule(int timerId, qint64 deadline)
+{
+    qint64 delta = deadline - m_wheelCurrentMs;
+    if (delta < 1)
+        delta = 1;
+
+    int level = 0;
+    while (level < WHEEL_LEVELS - 1 &&
+           (delta >> (WHEEL_SLOT_BITS * (level + 1))) != 0) {
+        level++;
+    }
+
+    const int slot = static_cast<int>(
+        (deadline >> (WHEEL_SLOT_BITS * level)) & WHEEL_SLOT_MASK);
+    m_wheel[level][slot].append(timerId);
+}
+
+/**
+ * Re-distribute a higher level's current slot into the levels below.
+ * Called when a level's index wraps to zero.
+ */
+void QVeridianEventDispatcher::wheelCascade(int level)
+{
+    if (level >= WHEEL_LEVELS)
+        return;
+
+    /* If this level's own index just wrapped too, cascade above first */
+    if (((m_wheelCurrentMs >> (WHEEL_SLOT_BITS * level)) & WHEEL_SLOT_MASK)
+            == 0) {
+        wheelCascade(level + 1);
+    }
+
+    const int slot = static_cast<int>(
+        (m_wheelCurrentMs >> (WHEEL_SLOT_BITS * level)) & WHEEL_SLOT_MASK);
+
+    const QList<int> entries = m_wheel[level][slot];
+    m_wheel[level][slot].clear();
+
+    for (int timerId : entries) {
+        auto it = m_timers.constFind(timerId);
+        if (it != m_timers.constEnd())
+            wheelSchedule(timerId, it->deadline);
+    }
+}
+
+/**
+ * Advance the wheel to @p nowMs, collecting expired timer ids.
+ *
+ * Walks level-0 tick by tick; a tick is an array index and an
+ * emptiness check, and the walk length is bounded by how long we
+ * actually slept (the timerfd wakes us at the earliest deadline).
+ */
+void QVeridianEventDispatcher::wheelAdvance(qint64 nowMs, QList<int> *expired)
+{
+    /* After a long timer-less idle period the wheel position can be
+     * far behind; rebuilding is cheaper than walking the gap */
+    if (nowMs - m_wheelCurrentMs > WHEEL_CATCHUP_MAX) {
+        for (int level = 0; level < WHEEL_LEVELS; ++level) {
+            for (int slot = 0; slot < WHEEL_SLOTS; ++slot)
+                m_wheel[level][slot].clear();
+        }
+        m_wheelCurrentMs = nowMs;
+        for (auto it = m_timers.constBegin(); it != m_timers.constEnd(); ++it) {
+            if (it->deadline <= nowMs)
+                expired->append(it->timerId);
+            else
+                wheelSchedule(it->timerId, it->deadline);
+        }
+        return;
+    }
+
+    while (m_wheelCurrentMs < nowMs) {
+        ++m_wheelCurrentMs;
+
+        const int slot = static_cast<int>(m_wheelCurrentMs & WHEEL_SLOT_MASK);
+        if (slot == 0)
+            wheelCascade(1);
+
+        QList<int> &bucket = m_wheel[0][slot];
+        if (bucket.isEmpty())
+            continue;
+
+        /* Entries from an earlier revolution stay scheduled */
+        for (int i = bucket.size() - 1; i >= 0; --i) {
+            const int timerId = bucket.at(i);
+            auto it = m_timers.constFind(timerId);
+            if (it == m_timers.constEnd()) {
+                bucket.removeAt(i);          /* lazily unregistered */
+            } else if (it->deadline <= nowMs) {
+                expired->append(timerId);
+                bucket.removeAt(i);
+            }
+        }
+    }
+}
+
+/**
+ * Earliest pending deadline, or -1 with no timers.
+ *
+ * Scans the registered-timer table; this runs once per loop pass when
+ * re-arming the timerfd, not per event.
+ */
+qint64 QVeridianEventDispatcher::wheelNextDeadline() const
+{
+    qint64 next = -1;
+    for (auto it = m_timers.constBegin(); it != m_timers.constEnd(); ++it) {
+        if (next < 0 || it->deadline < next)
+            next = it->deadline;
+    }
+    return next;
+}
+
+/** Arm the single timerfd to the earliest deadline (or disarm). */
+void QVeridianEventDispatcher::armTimerFd()
+{
+    if (m_timerFd < 0)
+        return;
+
+    struct itimerspec its = {};
+    const qint64 next = wheelNextDeadline();
+    if (next >= 0) {
+        qint64 delta = next - monotonicMs();
+        if (delta < 1)
+            delta = 1;  /* already due: fire immediately */
+        its.it_value.tv_sec  = delta / 1000;
+        its.it_value.tv_nsec = (delta % 1000) * 1000000L;
+    }
+    /* next < 0 leaves its zeroed, which disarms the fd */
+    timerfd_settime(m_timerFd, 0, &its, nullptr);
+}
+
+/**
+ * Advance the wheel and deliver QTimerEvents for everything due.
+ * Periodic timers are re-scheduled at deadline + interval.
+ */
+void QVeridianEventDispatcher::fireExpiredTimers(qint64 nowMs)
+{
+    QList<int> expired;
+    wheelAdvance(nowMs, &expired);
+
+    for (int timerId : expired) {
+        auto it = m_timers.find(timerId);
+        if (it == m_timers.end())
+            continue;   /* unregistered by an earlier handler */
+
+        /* Re-schedule before delivery so the handler can unregister */
+        if (it->interval > 0) {
+            it->deadline += it->interval;
+            if (it->deadline <= nowMs)
+                it->deadline = nowMs + it->interval;  /* missed beats */
+            wheelSchedule(timerId, it->deadline);
+        } else {
+            it->deadline = nowMs + 1;
+            wheelSchedule(timerId, it->deadline);
+        }
+
+        QTimerEvent te(timerId);
+        QCoreApplication::sendEvent(it->object, &te);
+    }
 }
 
 /* ========================================================================= */
@@ -78,7 +265,8 @@ bool QVeridianEventDispatcher::processEvents(QEventLoop::ProcessEventsFlags flag
 {
     m_interrupt = false;
 
-    /* Process queued events first */
+    /* Commands posted since the last pass, then queued events */
+    drainCrossThread();
     QCoreApplication::sendPostedEvents();
 
     if (m_interrupt)
@@ -87,44 +275,44 @@ bool QVeridianEventDispatcher::processEvents(QEventLoop::ProcessEventsFlags flag
     /* Determine timeout: 0 for WaitForMoreEvents=false, -1 for blocking */
     int timeout = (flags & QEventLoop::WaitForMoreEvents) ? -1 : 0;
 
-    struct epoll_event events[MAX_EPOLL_EVENTS];
-    int nfds = epoll_wait(m_epollFd, events, MAX_EPOLL_EVENTS, timeout);
+    /* Single syscall: drain everything pending into the event ring */
+    int nfds = epoll_wait(m_epollFd, m_eventRing, EVENT_RING_SIZE, timeout);
 
     bool hadEvents = (nfds > 0);
+    bool timersDue = false;
 
     for (int i = 0; i < nfds; ++i) {
-        int fd = events[i].data.fd;
+        int fd = m_eventRing[i].data.fd;
 
         if (fd == m_wakeUpFd) {
-            /* Drain the eventfd */
+            /* Drain the eventfd; producers may wake again from here on */
             uint64_t val;
             read(m_wakeUpFd, &val, sizeof(val));
+            __atomic_store_n(&m_wakePending, 0, __ATOMIC_RELEASE);
+            drainCrossThread();
             continue;
         }
 
-        /* Check if this is a timer fd */
-        bool isTimer = false;
-        for (auto it = m_timers.begin(); it != m_timers.end(); ++it) {
-            if (it->timerFd == fd) {
-                uint64_t expirations;
-                read(fd, &expirations, sizeof(expirations));
-                QTimerEvent te(it->timerId);
-                QCoreApplication::sendEvent(it->object, &te);
-                isTimer = true;
-                break;
-            }
+        if (fd == m_timerFd) {
+            uint64_t expirations;
+            read(m_timerFd, &expirations, sizeof(expirations));
+            timersDue = true;
+            continue;
         }
 
-        /* Check socket notifiers */
-        if (!isTimer) {
-            auto notifierIt = m_socketNotifiers.find(fd);
-            if (notifierIt != m_socketNotifiers.end()) {
-                QEvent event(QEvent::SockAct);
-                QCoreApplication::sendEvent(*notifierIt, &event);
-            }
+        /* Socket notifiers: O(1) hash lookup */
+        auto notifierIt = m_socketNotifiers.find(fd);
+        if (notifierIt != m_socketNotifiers.end()) {
+            QEvent event(QEvent::SockAct);
+            QCoreApplication::sendEvent(*notifierIt, &event);
         }
     }
 
+    if (timersDue) {
+        fireExpiredTimers(monotonicMs());
+        armTimerFd();
+    }
+
     /* Process any newly queued events */
     QCoreApplication::sendPostedEvents();
 
@@ -186,31 +374,18 @@ void QVeridianEventDispatcher::registerTimer(int timerId, qint64 interval,
     data.interval  = interval;
     data.timerType = timerType;
     data.object    = object;
-    data.timerFd   = -1;
-
-    /* Create a timerfd for this timer */
-    data.timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
-    if (data.timerFd >= 0) {
-        struct itimerspec its = {};
-        if (interval > 0) {
-            its.it_value.tv_sec     = interval / 1000;
-            its.it_value.tv_nsec    = (interval % 1000) * 1000000L;
-            its.it_interval.tv_sec  = its.it_value.tv_sec;
-            its.it_interval.tv_nsec = its.it_value.tv_nsec;
-        } else {
-            /* Zero interval = fire as soon as possible */
-            its.it_value.tv_nsec = 1;
-        }
-        timerfd_settime(data.timerFd, 0, &its, nullptr);
 
-        /* Add to epoll */
-        struct epoll_event ev = {};
-        ev.events = EPOLLIN;
-        ev.data.fd = data.timerFd;
-        epoll_ctl(m_epollFd, EPOLL_CTL_ADD, data.timerFd, &ev);
-    }
+    const qint64 now = monotonicMs();
+    data.deadline = (interval > 0) ? now + interval : now + 1;
+
+    /* No pending timers: nothing can be in the wheel, so snap its
+     * position forward instead of walking the idle gap later */
+    if (m_timers.isEmpty())
+        m_wheelCurrentMs = now;
 
     m_timers.insert(timerId, data);
+    wheelSchedule(timerId, data.deadline);
+    armTimerFd();
 }
 
 bool QVeridianEventDispatcher::unregisterTimer(int timerId)
@@ -219,11 +394,9 @@ bool QVeridianEventDispatcher::unregisterTimer(int timerId)
     if (it == m_timers.end())
         return false;
 
-    if (it->timerFd >= 0) {
-        epoll_ctl(m_epollFd, EPOLL_CTL_DEL, it->timerFd, nullptr);
-        close(it->timerFd);
-    }
+    /* The wheel entry is removed lazily on expiry */
     m_timers.erase(it);
+    armTimerFd();
     return true;
 }
 
@@ -233,16 +406,14 @@ bool QVeridianEventDispatcher::unregisterTimers(QObject *object)
     auto it = m_timers.begin();
     while (it != m_timers.end()) {
         if (it->object == object) {
-            if (it->timerFd >= 0) {
-                epoll_ctl(m_epollFd, EPOLL_CTL_DEL, it->timerFd, nullptr);
-                close(it->timerFd);
-            }
             it = m_timers.erase(it);
             found = true;
         } else {
             ++it;
         }
     }
+    if (found)
+        armTimerFd();
     return found;
 }
 
@@ -260,14 +431,11 @@ QVeridianEventDispatcher::registeredTimers(QObject *object) const
 int QVeridianEventDispatcher::remainingTime(int timerId)
 {
     auto it = m_timers.find(timerId);
-    if (it == m_timers.end() || it->timerFd < 0)
+    if (it == m_timers.end())
         return -1;
 
-    struct itimerspec its = {};
-    timerfd_gettime(it->timerFd, &its);
-
-    return static_cast<int>(its.it_value.tv_sec * 1000 +
-                            its.it_value.tv_nsec / 1000000);
+    const qint64 remaining = it->deadline - monotonicMs();
+    return remaining > 0 ? static_cast<int>(remaining) : 0;
 }
 
 /* ========================================================================= */
@@ -276,12 +444,88 @@ int QVeridianEventDispatcher::remainingTime(int timerId)
 
 void QVeridianEventDispatcher::wakeUp()
 {
+    /* Batched: one eventfd write per burst.  The flag is cleared by
+     * the dispatcher after it drains the eventfd, so the first
+     * producer of the next burst pays the syscall and the rest skip
+     * it. */
+    if (__atomic_exchange_n(&m_wakePending, 1, __ATOMIC_ACQ_REL) != 0)
+        return;
     if (m_wakeUpFd >= 0) {
         uint64_t val = 1;
         write(m_wakeUpFd, &val, sizeof(val));
     }
 }
 
+/* ========================================================================= */
+/* Cross-thread command queue                                                */
+/* ========================================================================= */
+
+/*
+ * Bounded MPMC-style ring with per-slot sequence numbers (the same
+ * scheme the kernel IPC registry and the libc pool use): producers
+ * CAS the enqueue cursor to claim a cell and release-store its
+ * sequence to publish; the single consumer is the dispatcher
+ * thread, so dequeue needs no CAS at all.
+ */
+
+void QVeridianEventDispatcher::initCmdRing()
+{
+    for (unsigned i = 0; i < CMD_RING_SIZE; ++i)
+        __atomic_store_n(&m_cmdRing[i].seq, i, __ATOMIC_RELAXED);
+    m_cmdEnq = 0;
+    m_cmdDeq = 0;
+    m_wakePending = 0;
+}
+
+bool QVeridianEventDispatcher::postCrossThread(CrossThreadFn fn, void *arg)
+{
+    if (!fn)
+        return false;
+
+    unsigned pos = __atomic_load_n(&m_cmdEnq, __ATOMIC_RELAXED);
+
+    for (;;) {
+        CrossThreadCmd *c = &m_cmdRing[pos & (CMD_RING_SIZE - 1)];
+        unsigned seq = __atomic_load_n(&c->seq, __ATOMIC_ACQUIRE);
+        int dif = (int)(seq - pos);
+
+        if (dif == 0) {
+            if (__atomic_compare_exchange_n(&m_cmdEnq, &pos, pos + 1,
+                                            true, __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED)) {
+                c->fn = fn;
+                c->arg = arg;
+                __atomic_store_n(&c->seq, pos + 1, __ATOMIC_RELEASE);
+                wakeUp();
+                return true;
+            }
+        } else if (dif < 0) {
+            return false;       /* Full: caller falls back to QMetaObject */
+        } else {
+            pos = __atomic_load_n(&m_cmdEnq, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+void QVeridianEventDispatcher::drainCrossThread()
+{
+    for (;;) {
+        CrossThreadCmd *c = &m_cmdRing[m_cmdDeq & (CMD_RING_SIZE - 1)];
+        unsigned seq = __atomic_load_n(&c->seq, __ATOMIC_ACQUIRE);
+
+        if ((int)(seq - (m_cmdDeq + 1)) < 0)
+            return;             /* Next cell not published yet */
+
+        CrossThreadFn fn = c->fn;
+        void *arg = c->arg;
+
+        __atomic_store_n(&c->seq, m_cmdDeq + CMD_RING_SIZE,
+                         __ATOMIC_RELEASE);
+        m_cmdDeq++;
+        fn(arg);
+    }
+}
+
 void QVeridianEventDispatcher::interrupt()
 {
     m_interrupt = true;
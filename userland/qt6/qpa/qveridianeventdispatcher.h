@@ -5,8 +5,15 @@
  * SPDX-License-Identifier: MIT OR Apache-2.0
  *
  * Event dispatcher for VeridianOS.  Uses epoll to multiplex the
- * Wayland display fd, timer fds, socket notifiers, and posted events
- * into a single event loop.
+ * Wayland display fd, a single timer fd, socket notifiers, and posted
+ * events into a single event loop.
+ *
+ * Timers are kept in a hierarchical timing wheel (4 levels x 64
+ * slots, 1ms ticks) so registering, expiring, and cascading are O(1)
+ * per timer regardless of how many QTimers the process holds; one
+ * timerfd is armed to the earliest deadline.  Each processEvents()
+ * pass drains the kernel with a single epoll_wait into a fixed event
+ * ring instead of waking per event.
  */
 
 #ifndef QVERIDIANEVENTDISPATCHER_H
@@ -16,6 +23,8 @@
 #include <QtCore/QList>
 #include <QtCore/QHash>
 
+#include <sys/epoll.h>
+
 QT_BEGIN_NAMESPACE
 
 class QVeridianEventDispatcher : public QAbstractEventDispatcher
@@ -47,17 +56,69 @@ private:
         qint64  interval;
         Qt::TimerType timerType;
         QObject *object;
-        int     timerFd;
+        qint64  deadline;       /* Absolute, CLOCK_MONOTONIC ms */
     };
 
+    /* ----- Timing wheel ----- */
+    static const int WHEEL_LEVELS     = 4;
+    static const int WHEEL_SLOT_BITS  = 6;
+    static const int WHEEL_SLOTS      = 1 << WHEEL_SLOT_BITS;   /* 64 */
+    static const int WHEEL_SLOT_MASK  = WHEEL_SLOTS - 1;
+    static const qint64 WHEEL_CATCHUP_MAX = 1 << 18;  /* ~4.4 min gap */
+
+    void wheelSchedule(int timerId, qint64 deadline);
+    void wheelAdvance(qint64 nowMs, QList<int> *expired);
+    void wheelCascade(int level);
+    qint64 wheelNextDeadline() const;
+
     void initEpoll();
+    void armTimerFd();
+    void fireExpiredTimers(qint64 nowMs);
+    static qint64 monotonicMs();
 
     int  m_epollFd   = -1;
     int  m_wakeUpFd  = -1;  /* eventfd for cross-thread wakeup */
+    int  m_timerFd   = -1;  /* single timerfd, armed to earliest deadline */
     bool m_interrupt  = false;
 
     QHash<int, TimerData>          m_timers;       /* timerId -> data */
     QHash<int, QSocketNotifier *>  m_socketNotifiers; /* fd -> notifier */
+
+    /* Wheel slots hold timer ids; ids unregistered in the meantime
+     * are skipped on expiry (lazy deletion, keeps removal O(1)) */
+    QList<int> m_wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+    qint64 m_wheelCurrentMs = 0;
+
+    /* Event ring: one epoll_wait per pass drains into this */
+    static const int EVENT_RING_SIZE = 256;
+    struct epoll_event m_eventRing[EVENT_RING_SIZE];
+
+public:
+    /*
+     * Lock-free cross-thread command posting: any thread enqueues,
+     * the dispatcher thread drains during processEvents().  A burst
+     * of posts costs one eventfd wake -- the first producer after a
+     * drain pays it, the rest see the pending flag and skip the
+     * syscall.  The render loop's per-frame chatter stops fighting
+     * input delivery over a mutex.
+     */
+    typedef void (*CrossThreadFn)(void *arg);
+    bool postCrossThread(CrossThreadFn fn, void *arg);
+
+private:
+    static const unsigned CMD_RING_SIZE = 256;  /* Power of two */
+    struct CrossThreadCmd {
+        unsigned      seq;
+        CrossThreadFn fn;
+        void         *arg;
+    };
+    CrossThreadCmd m_cmdRing[CMD_RING_SIZE];
+    unsigned m_cmdEnq = 0;          /* Multi-producer cursor */
+    unsigned m_cmdDeq = 0;          /* Dispatcher-thread only */
+    int      m_wakePending = 0;     /* Batched-wakeup flag */
+
+    void initCmdRing();
+    void drainCrossThread();
 };
 
 QT_END_NAMESPACE
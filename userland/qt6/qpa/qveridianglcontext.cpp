@@ -12,6 +12,9 @@
 
 #include <EGL/egl.h>
 #include <EGL/eglext.h>
+#include <veridian/glprogram.h>
+
+#include <QtCore/QByteArray>
 
 QT_BEGIN_NAMESPACE
 
@@ -85,10 +88,23 @@ void QVeridianGLContext::initEGL()
 
     m_eglContext = eglCreateContext(m_eglDisplay, m_eglConfig,
                                     EGL_NO_CONTEXT, contextAttribs);
+
+    /* Arm the shared program-binary cache for this process.  Keyed on
+     * the driver identity, so a Mesa update invalidates stale binaries
+     * across every user at first launch. */
+    QByteArray driverId;
+    if (const char *vendor = eglQueryString(m_eglDisplay, EGL_VENDOR))
+        driverId += vendor;
+    driverId += '/';
+    if (const char *version = eglQueryString(m_eglDisplay, EGL_VERSION))
+        driverId += version;
+    vglp_cache_init(driverId.constData());
 }
 
 void QVeridianGLContext::destroyEGL()
 {
+    vglp_cache_shutdown();
+
     if (m_eglDisplay != EGL_NO_DISPLAY) {
         eglMakeCurrent(m_eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE,
                        EGL_NO_CONTEXT);
@@ -39,12 +39,12 @@ static void registry_global(void *data, struct wl_registry *registry,
                             uint32_t version)
 {
     auto *self = static_cast<QVeridianIntegration *>(data);
-    Q_UNUSED(self);
 
     if (strcmp(interface, "wl_compositor") == 0) {
         /* Bind wl_compositor -- stored via initWayland() */
     } else if (strcmp(interface, "wl_shm") == 0) {
-        /* Bind wl_shm for software rendering path */
+        /* Bind wl_shm for the zero-copy software rendering path */
+        self->bindShm(registry, name, version);
     } else if (strcmp(interface, "wl_seat") == 0) {
         /* Bind wl_seat for keyboard/pointer input */
     } else if (strcmp(interface, "xdg_wm_base") == 0) {
@@ -241,6 +241,19 @@ struct wl_compositor *QVeridianIntegration::waylandCompositor() const
     return m_wlCompositor;
 }
 
+struct wl_shm *QVeridianIntegration::waylandShm() const
+{
+    return m_wlShm;
+}
+
+void QVeridianIntegration::bindShm(struct wl_registry *registry,
+                                   uint32_t name, uint32_t version)
+{
+    Q_UNUSED(version);
+    m_wlShm = static_cast<struct wl_shm *>(
+        wl_registry_bind(registry, name, &wl_shm_interface, 1));
+}
+
 struct xdg_wm_base *QVeridianIntegration::xdgWmBase() const
 {
     return m_xdgWmBase;
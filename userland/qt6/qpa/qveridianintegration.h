@@ -52,8 +52,12 @@ public:
 
     struct wl_display *waylandDisplay() const;
     struct wl_compositor *waylandCompositor() const;
+    struct wl_shm *waylandShm() const;
     struct xdg_wm_base *xdgWmBase() const;
 
+    /** Bind wl_shm from the registry (called by the registry listener). */
+    void bindShm(struct wl_registry *registry, uint32_t name, uint32_t version);
+
 private:
     void initWayland();
     void initScreens();
@@ -10,12 +10,88 @@
 
 #include "qveridianscreen.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
 QT_BEGIN_NAMESPACE
 
+/*
+ * The compositor pushes output geometry/DPI into a shared table with
+ * a generation counter; the hot QScreen calls below cost one relaxed
+ * generation load when nothing changed, so QML's per-frame layout
+ * queries never leave the process.
+ */
+
+static const QVscrTable *vscrAttach()
+{
+    static const QVscrTable *table;
+    static bool tried;
+
+    if (table || tried)
+        return table;
+    tried = true;
+
+    int fd = open(QVSCR_PATH, O_RDONLY);
+    if (fd < 0)
+        return nullptr;
+    void *map = mmap(nullptr, sizeof(QVscrTable), PROT_READ,
+                     MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return nullptr;
+
+    const QVscrTable *t = static_cast<const QVscrTable *>(map);
+    if (__atomic_load_n(&t->magic, __ATOMIC_ACQUIRE) != QVSCR_MAGIC) {
+        munmap(map, sizeof(QVscrTable));
+        return nullptr;
+    }
+    table = t;
+    return table;
+}
+
+void QVeridianScreen::syncFromTable() const
+{
+    const QVscrTable *t = vscrAttach();
+
+    if (!t)
+        return;
+
+    uint32_t gen = __atomic_load_n(&t->generation, __ATOMIC_ACQUIRE);
+    if (gen == m_cachedGeneration || (gen & 1))
+        return;                 /* Current, or rewrite in flight */
+
+    for (;;) {
+        uint32_t before =
+            __atomic_load_n(&t->generation, __ATOMIC_ACQUIRE);
+
+        if (before & 1)
+            continue;
+        if (m_screenIndex >= (int)t->screen_count)
+            return;             /* Not (yet) published */
+
+        const QVscrRecord r = t->screens[m_screenIndex];
+        uint32_t after =
+            __atomic_load_n(&t->generation, __ATOMIC_ACQUIRE);
+
+        if (before != after)
+            continue;           /* Torn: retry */
+
+        m_geometry = QRect(r.x, r.y, r.w, r.h);
+        if (r.refresh_mhz > 0)
+            m_refreshRate = r.refresh_mhz / 1000.0;
+        if (r.phys_w_mm > 0 && r.phys_h_mm > 0)
+            m_physicalSize = QSizeF(r.phys_w_mm, r.phys_h_mm);
+        m_cachedGeneration = after;
+        return;
+    }
+}
+
 QVeridianScreen::QVeridianScreen(const QRect &geometry, qreal refreshRate)
     : m_geometry(geometry)
     , m_refreshRate(refreshRate)
 {
+    syncFromTable();
 }
 
 QVeridianScreen::~QVeridianScreen()
@@ -24,12 +100,14 @@ QVeridianScreen::~QVeridianScreen()
 
 QRect QVeridianScreen::geometry() const
 {
+    syncFromTable();
     return m_geometry;
 }
 
 QRect QVeridianScreen::availableGeometry() const
 {
     /* Reserve no space for panels -- Plasma manages its own struts */
+    syncFromTable();
     return m_geometry;
 }
 
@@ -45,11 +123,16 @@ QImage::Format QVeridianScreen::format() const
 
 qreal QVeridianScreen::refreshRate() const
 {
+    syncFromTable();
     return m_refreshRate;
 }
 
 QSizeF QVeridianScreen::physicalSize() const
 {
+    syncFromTable();
+    if (!m_physicalSize.isEmpty())
+        return m_physicalSize;  /* EDID-backed, from the table */
+
     /* Default to ~96 DPI: for a 1920x1080 display that gives ~508x286 mm.
      * Real DRM connectors provide EDID physical size data. */
     const qreal dpi = 96.0;
@@ -14,8 +14,35 @@
 #include <QtGui/qpa/qplatformscreen.h>
 #include <QtCore/QRect>
 
+#include <stdint.h>
+
 QT_BEGIN_NAMESPACE
 
+/*
+ * Byte-compatible copy of the compositor's shared screen table
+ * (kwin-veridian-protocols.h, 'VSCR'); this side cannot include kwin
+ * headers, same as the window-table readers.
+ */
+#define QVSCR_MAGIC       0x52435356u
+#define QVSCR_MAX_SCREENS 8
+#define QVSCR_PATH        "/run/veridian/screens"
+
+struct QVscrRecord {
+    int32_t  x, y, w, h;
+    uint32_t refresh_mhz;
+    uint32_t phys_w_mm;
+    uint32_t phys_h_mm;
+    uint32_t connector_id;
+};
+
+struct QVscrTable {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t generation;
+    uint32_t screen_count;
+    struct QVscrRecord screens[QVSCR_MAX_SCREENS];
+};
+
 class QVeridianScreen : public QPlatformScreen
 {
 public:
@@ -36,9 +63,19 @@ public:
     void setConnectorId(uint32_t id) { m_connectorId = id; }
     void setCrtcId(uint32_t id) { m_crtcId = id; }
 
+    /* Index into the compositor's shared screen table */
+    void setScreenIndex(int idx) { m_screenIndex = idx; }
+
 private:
-    QRect    m_geometry;
-    qreal    m_refreshRate;
+    /* Refresh the cached descriptor when the compositor's
+     * generation moved; a matching generation is one relaxed load */
+    void syncFromTable() const;
+
+    mutable QRect    m_geometry;
+    mutable qreal    m_refreshRate;
+    mutable QSizeF   m_physicalSize;
+    mutable uint32_t m_cachedGeneration = 0;
+    int      m_screenIndex = 0;
     uint32_t m_connectorId = 0;
     uint32_t m_crtcId      = 0;
 };
@@ -15,13 +15,249 @@
 #include <QtGui/QPalette>
 #include <QtGui/QIcon>
 #include <QtCore/QFileInfo>
+#include <QtCore/QDir>
+#include <QtCore/QStringList>
+#include <QtCore/QCoreApplication>
 
 QT_BEGIN_NAMESPACE
 
+/* ========================================================================= */
+/* Compiled theme cache                                                      */
+/* ========================================================================= */
+
+/*
+ * Theme inputs (/etc/veridian/theme.conf) are compiled once into a
+ * fixed-layout binary file that every Qt process maps read-only, so
+ * hint, font, and palette queries cost a struct read instead of a
+ * config parse per process.  The cache embeds a hash of the input
+ * file; any edit regenerates it on the next theme construction.
+ */
+
+static const uint32_t VQT_MAGIC = 0x43545156;   /* 'VQTC' */
+static const uint32_t VQT_VERSION = 1;
+static const int VQT_MAX_ICON_PATHS = 4;
+
+static const char *VQT_CACHE_DIR = "/var/cache/veridian";
+static const char *VQT_CACHE_PATH = "/var/cache/veridian/qtheme.cache";
+static const char *VQT_CONF_PATH = "/etc/veridian/theme.conf";
+
+struct VqtPalette {
+    quint32 window, windowText, base, alternateBase, text;
+    quint32 button, buttonText, brightText, highlight, highlightedText;
+    quint32 link, linkVisited, tooltipBase, tooltipText;
+};
+
+struct VqtCache {
+    quint32 magic;
+    quint32 version;
+    quint64 inputHash;
+    char iconTheme[64];
+    char fallbackTheme[64];
+    char styles[128];                   /* comma-separated */
+    char fontFamily[64];
+    qint32 fontSize;
+    char fixedFamily[64];
+    qint32 fixedSize;
+    VqtPalette palette;
+    quint32 iconPathCount;
+    char iconPaths[VQT_MAX_ICON_PATHS][128];
+};
+
+static quint64 vqtHash(const QByteArray &data)
+{
+    /* FNV-1a, seeded with the format version so layout bumps
+     * invalidate old caches even with unchanged inputs */
+    quint64 h = 0xcbf29ce484222325ULL ^ VQT_VERSION;
+    for (char c : data) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+static void vqtSetString(char *dst, size_t dstSize, const QString &src)
+{
+    QByteArray utf8 = src.toUtf8();
+    size_t len = static_cast<size_t>(utf8.size());
+    if (len >= dstSize)
+        len = dstSize - 1;
+    memcpy(dst, utf8.constData(), len);
+    dst[len] = '\0';
+}
+
+/* Built-in defaults: identical to the hardcoded values the theme
+ * shipped with, so a missing conf produces an equivalent cache */
+static void vqtFillDefaults(VqtCache *c)
+{
+    memset(c, 0, sizeof(*c));
+    c->magic = VQT_MAGIC;
+    c->version = VQT_VERSION;
+    vqtSetString(c->iconTheme, sizeof(c->iconTheme), QStringLiteral("breeze"));
+    vqtSetString(c->fallbackTheme, sizeof(c->fallbackTheme),
+                 QStringLiteral("hicolor"));
+    vqtSetString(c->styles, sizeof(c->styles),
+                 QStringLiteral("breeze,fusion"));
+    vqtSetString(c->fontFamily, sizeof(c->fontFamily),
+                 QStringLiteral("DejaVu Sans"));
+    c->fontSize = 10;
+    vqtSetString(c->fixedFamily, sizeof(c->fixedFamily),
+                 QStringLiteral("DejaVu Sans Mono"));
+    c->fixedSize = 10;
+
+    c->palette.window          = 0xffeff0f1;
+    c->palette.windowText      = 0xff232629;
+    c->palette.base            = 0xfffcfcfc;
+    c->palette.alternateBase   = 0xffeff0f1;
+    c->palette.text            = 0xff232629;
+    c->palette.button          = 0xffeff0f1;
+    c->palette.buttonText      = 0xff232629;
+    c->palette.brightText      = 0xffffffff;
+    c->palette.highlight       = 0xff3daee9;
+    c->palette.highlightedText = 0xffffffff;
+    c->palette.link            = 0xff2980b9;
+    c->palette.linkVisited     = 0xff7f8c8d;
+    c->palette.tooltipBase     = 0xfff7f7f7;
+    c->palette.tooltipText     = 0xff232629;
+
+    c->iconPathCount = 2;
+    vqtSetString(c->iconPaths[0], sizeof(c->iconPaths[0]),
+                 QStringLiteral("/usr/share/icons"));
+    vqtSetString(c->iconPaths[1], sizeof(c->iconPaths[1]),
+                 QStringLiteral("/usr/local/share/icons"));
+}
+
+/* Parse "#RRGGBB" / "#AARRGGBB"; returns 0 (transparent) on garbage so
+ * a bad line is visible rather than silently black */
+static quint32 vqtParseColor(const QString &value)
+{
+    QString v = value.trimmed();
+    if (!v.startsWith(QLatin1Char('#')))
+        return 0;
+
+    bool ok = false;
+    quint32 rgb = v.mid(1).toUInt(&ok, 16);
+    if (!ok)
+        return 0;
+    if (v.size() == 7)
+        rgb |= 0xff000000;      /* opaque */
+    return rgb;
+}
+
+static void vqtApplyConfLine(VqtCache *c, const QString &key,
+                             const QString &value)
+{
+    if (key == QStringLiteral("iconTheme"))
+        vqtSetString(c->iconTheme, sizeof(c->iconTheme), value);
+    else if (key == QStringLiteral("iconFallbackTheme"))
+        vqtSetString(c->fallbackTheme, sizeof(c->fallbackTheme), value);
+    else if (key == QStringLiteral("styles"))
+        vqtSetString(c->styles, sizeof(c->styles), value);
+    else if (key == QStringLiteral("fontFamily"))
+        vqtSetString(c->fontFamily, sizeof(c->fontFamily), value);
+    else if (key == QStringLiteral("fontSize"))
+        c->fontSize = qMax(1, value.toInt());
+    else if (key == QStringLiteral("fixedFontFamily"))
+        vqtSetString(c->fixedFamily, sizeof(c->fixedFamily), value);
+    else if (key == QStringLiteral("fixedFontSize"))
+        c->fixedSize = qMax(1, value.toInt());
+    else if (key == QStringLiteral("iconPath")) {
+        if (c->iconPathCount < static_cast<quint32>(VQT_MAX_ICON_PATHS))
+            vqtSetString(c->iconPaths[c->iconPathCount++],
+                         sizeof(c->iconPaths[0]), value);
+    } else if (key == QStringLiteral("color.window"))
+        c->palette.window = vqtParseColor(value);
+    else if (key == QStringLiteral("color.windowText"))
+        c->palette.windowText = vqtParseColor(value);
+    else if (key == QStringLiteral("color.base"))
+        c->palette.base = vqtParseColor(value);
+    else if (key == QStringLiteral("color.alternateBase"))
+        c->palette.alternateBase = vqtParseColor(value);
+    else if (key == QStringLiteral("color.text"))
+        c->palette.text = vqtParseColor(value);
+    else if (key == QStringLiteral("color.button"))
+        c->palette.button = vqtParseColor(value);
+    else if (key == QStringLiteral("color.buttonText"))
+        c->palette.buttonText = vqtParseColor(value);
+    else if (key == QStringLiteral("color.brightText"))
+        c->palette.brightText = vqtParseColor(value);
+    else if (key == QStringLiteral("color.highlight"))
+        c->palette.highlight = vqtParseColor(value);
+    else if (key == QStringLiteral("color.highlightedText"))
+        c->palette.highlightedText = vqtParseColor(value);
+    else if (key == QStringLiteral("color.link"))
+        c->palette.link = vqtParseColor(value);
+    else if (key == QStringLiteral("color.linkVisited"))
+        c->palette.linkVisited = vqtParseColor(value);
+    else if (key == QStringLiteral("color.tooltipBase"))
+        c->palette.tooltipBase = vqtParseColor(value);
+    else if (key == QStringLiteral("color.tooltipText"))
+        c->palette.tooltipText = vqtParseColor(value);
+}
+
+/* Compile the conf into the cache record.  The first line of conf
+ * content drives the hash; a missing conf hashes as empty and still
+ * produces (and caches) the defaults. */
+static void vqtCompile(VqtCache *c, const QByteArray &confData)
+{
+    vqtFillDefaults(c);
+    c->inputHash = vqtHash(confData);
+
+    const QList<QByteArray> confLines = confData.split('\n');
+    for (const QByteArray &raw : confLines) {
+        QString line = QString::fromUtf8(raw).trimmed();
+        if (line.isEmpty() || line.startsWith(QLatin1Char('#')))
+            continue;
+        int eqPos = line.indexOf(QLatin1Char('='));
+        if (eqPos <= 0)
+            continue;
+        vqtApplyConfLine(c, line.left(eqPos), line.mid(eqPos + 1).trimmed());
+    }
+}
+
+static QByteArray vqtReadConf()
+{
+    QFile conf(QString::fromUtf8(VQT_CONF_PATH));
+    if (!conf.open(QIODevice::ReadOnly))
+        return QByteArray();
+    return conf.readAll();
+}
+
+/* Atomic regeneration: write-to-temp + rename, so concurrent readers
+ * only ever map a complete cache */
+static bool vqtWriteCache(const VqtCache *c)
+{
+    QDir().mkpath(QString::fromUtf8(VQT_CACHE_DIR));
+
+    QString tmpPath = QStringLiteral("%1.tmp.%2")
+                          .arg(QString::fromUtf8(VQT_CACHE_PATH))
+                          .arg(QCoreApplication::applicationPid());
+    QFile tmp(tmpPath);
+    if (!tmp.open(QIODevice::WriteOnly))
+        return false;
+
+    if (tmp.write(reinterpret_cast<const char *>(c),
+                  sizeof(*c)) != sizeof(*c)) {
+        tmp.remove();
+        return false;
+    }
+    tmp.close();
+
+    QFile::remove(QString::fromUtf8(VQT_CACHE_PATH));
+    if (!tmp.rename(QString::fromUtf8(VQT_CACHE_PATH))) {
+        tmp.remove();
+        return false;
+    }
+    return true;
+}
+
 QVeridianTheme::QVeridianTheme()
 {
-    initFonts();
-    initPalette();
+    if (loadThemeCache()) {
+        initFromCache();
+    } else {
+        initFonts();
+        initPalette();
+    }
 }
 
 QVeridianTheme::~QVeridianTheme()
@@ -35,6 +271,80 @@ QVeridianTheme::~QVeridianTheme()
 /* Initialization                                                            */
 /* ========================================================================= */
 
+/*
+ * Map the compiled cache read-only, regenerating it first when the
+ * theme inputs changed.  Returns false when neither mapping nor
+ * regeneration worked (read-only filesystem): built-ins apply.
+ */
+bool QVeridianTheme::loadThemeCache()
+{
+    const QByteArray confData = vqtReadConf();
+    const quint64 expectedHash = vqtHash(confData);
+
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        m_cacheFile.setFileName(QString::fromUtf8(VQT_CACHE_PATH));
+        if (m_cacheFile.open(QIODevice::ReadOnly) &&
+            m_cacheFile.size() ==
+                static_cast<qint64>(sizeof(VqtCache))) {
+            const uchar *map =
+                m_cacheFile.map(0, static_cast<qint64>(sizeof(VqtCache)));
+            if (map) {
+                const VqtCache *c = reinterpret_cast<const VqtCache *>(map);
+                if (c->magic == VQT_MAGIC && c->version == VQT_VERSION &&
+                    c->inputHash == expectedHash) {
+                    m_cache = c;
+                    return true;
+                }
+                m_cacheFile.unmap(const_cast<uchar *>(map));
+            }
+        }
+        m_cacheFile.close();
+
+        if (attempt > 0)
+            break;
+
+        /* Stale or missing: compile from the inputs and retry once */
+        VqtCache fresh;
+        vqtCompile(&fresh, confData);
+        if (!vqtWriteCache(&fresh))
+            break;
+    }
+
+    return false;
+}
+
+void QVeridianTheme::initFromCache()
+{
+    m_systemFont = new QFont(QString::fromUtf8(m_cache->fontFamily),
+                             m_cache->fontSize);
+    m_systemFont->setStyleHint(QFont::SansSerif);
+    m_fixedFont = new QFont(QString::fromUtf8(m_cache->fixedFamily),
+                            m_cache->fixedSize);
+    m_fixedFont->setStyleHint(QFont::Monospace);
+
+    const VqtPalette &p = m_cache->palette;
+    m_palette = new QPalette();
+    m_palette->setColor(QPalette::Window, QColor::fromRgba(p.window));
+    m_palette->setColor(QPalette::WindowText, QColor::fromRgba(p.windowText));
+    m_palette->setColor(QPalette::Base, QColor::fromRgba(p.base));
+    m_palette->setColor(QPalette::AlternateBase,
+                        QColor::fromRgba(p.alternateBase));
+    m_palette->setColor(QPalette::Text, QColor::fromRgba(p.text));
+    m_palette->setColor(QPalette::Button, QColor::fromRgba(p.button));
+    m_palette->setColor(QPalette::ButtonText, QColor::fromRgba(p.buttonText));
+    m_palette->setColor(QPalette::BrightText, QColor::fromRgba(p.brightText));
+    m_palette->setColor(QPalette::Highlight, QColor::fromRgba(p.highlight));
+    m_palette->setColor(QPalette::HighlightedText,
+                        QColor::fromRgba(p.highlightedText));
+    m_palette->setColor(QPalette::Link, QColor::fromRgba(p.link));
+    m_palette->setColor(QPalette::LinkVisited,
+                        QColor::fromRgba(p.linkVisited));
+    m_palette->setColor(QPalette::ToolTipBase,
+                        QColor::fromRgba(p.tooltipBase));
+    m_palette->setColor(QPalette::ToolTipText,
+                        QColor::fromRgba(p.tooltipText));
+}
+
 void QVeridianTheme::initFonts()
 {
     /* DejaVu Sans 10pt as the default system font.  This matches what
@@ -90,17 +400,33 @@ const QPalette *QVeridianTheme::palette(Palette type) const
 
 QVariant QVeridianTheme::themeHint(ThemeHint hint) const
 {
+    /* Hint queries answered straight from the read-only mapping */
     switch (hint) {
     case QPlatformTheme::IconThemeSearchPaths:
+        if (m_cache) {
+            QStringList paths;
+            for (quint32 i = 0; i < m_cache->iconPathCount &&
+                                i < static_cast<quint32>(VQT_MAX_ICON_PATHS);
+                 ++i)
+                paths.append(QString::fromUtf8(m_cache->iconPaths[i]));
+            return paths;
+        }
         return QStringList{
             QStringLiteral("/usr/share/icons"),
             QStringLiteral("/usr/local/share/icons"),
         };
     case QPlatformTheme::IconThemeName:
+        if (m_cache)
+            return QString::fromUtf8(m_cache->iconTheme);
         return QStringLiteral("breeze");
     case QPlatformTheme::StyleNames:
+        if (m_cache)
+            return QString::fromUtf8(m_cache->styles)
+                       .split(QLatin1Char(','), Qt::SkipEmptyParts);
         return QStringList{QStringLiteral("breeze"), QStringLiteral("fusion")};
     case QPlatformTheme::SystemIconFallbackThemeName:
+        if (m_cache)
+            return QString::fromUtf8(m_cache->fallbackTheme);
         return QStringLiteral("hicolor");
     case QPlatformTheme::DialogButtonBoxButtonsHaveIcons:
         return true;
@@ -12,9 +12,12 @@
 #define QVERIDIANTHEME_H
 
 #include <QtGui/qpa/qplatformtheme.h>
+#include <QtCore/QFile>
 
 QT_BEGIN_NAMESPACE
 
+struct VqtCache;
+
 class QVeridianTheme : public QPlatformTheme
 {
 public:
@@ -36,10 +39,18 @@ public:
 private:
     void initFonts();
     void initPalette();
+    bool loadThemeCache();
+    void initFromCache();
 
     QFont    *m_systemFont   = nullptr;
     QFont    *m_fixedFont    = nullptr;
     QPalette *m_palette      = nullptr;
+
+    /* Compiled theme cache: a binary file mapped read-only and shared
+     * across every Qt process; null when unavailable (built-in
+     * defaults apply) */
+    QFile              m_cacheFile;
+    const VqtCache    *m_cache = nullptr;
 };
 
 QT_END_NAMESPACE
@@ -9,6 +9,8 @@
  */
 
 #include "qveridianwindow.h"
+
+#include <QTimer>
 #include "qveridianintegration.h"
 
 #include <wayland-client.h>
@@ -132,6 +134,11 @@ void QVeridianWindow::setGeometry(const QRect &rect)
     m_geometry = rect;
     QPlatformWindow::setGeometry(rect);
     QWindowSystemInterface::handleGeometryChange(window(), rect);
+
+    /* Compositor side rides the per-cycle transaction */
+    m_pending.geometry = rect;
+    m_pending.geometryChanged = true;
+    scheduleCommit();
 }
 
 QRect QVeridianWindow::geometry() const
@@ -144,8 +151,11 @@ void QVeridianWindow::setVisible(bool visible)
     m_visible = visible;
 
     if (visible) {
-        if (!m_wlSurface)
+        if (!m_wlSurface) {
             createWaylandSurface();
+            /* State recorded while hidden lands in one transaction */
+            commitPendingState();
+        }
     } else {
         destroyWaylandSurface();
     }
@@ -158,8 +168,79 @@ void QVeridianWindow::setVisible(bool visible)
 
 void QVeridianWindow::setWindowTitle(const QString &title)
 {
-    if (m_xdgToplevel)
-        xdg_toplevel_set_title(m_xdgToplevel, title.toUtf8().constData());
+    m_pending.title = title;
+    m_pending.titleChanged = true;
+    scheduleCommit();
+}
+
+void QVeridianWindow::setWindowState(Qt::WindowStates state)
+{
+    m_pending.state = state;
+    m_pending.stateChanged = true;
+    scheduleCommit();
+}
+
+/* ========================================================================= */
+/* Transactional commit                                                      */
+/* ========================================================================= */
+
+void QVeridianWindow::scheduleCommit()
+{
+    if (m_commitScheduled)
+        return;
+    m_commitScheduled = true;
+
+    /* Zero timer: fires after the current event-loop pass has made
+     * all its changes; window() as context cancels on destruction */
+    QTimer::singleShot(0, window(), [this]() {
+        m_commitScheduled = false;
+        commitPendingState();
+    });
+}
+
+void QVeridianWindow::commitPendingState()
+{
+    if (!m_wlSurface) {
+        /* Hidden: keep the pending block; it commits with the next
+         * surface creation */
+        return;
+    }
+
+    bool any = false;
+
+    if (m_pending.geometryChanged && m_xdgSurface) {
+        xdg_surface_set_window_geometry(m_xdgSurface,
+                                        m_pending.geometry.x(),
+                                        m_pending.geometry.y(),
+                                        m_pending.geometry.width(),
+                                        m_pending.geometry.height());
+        m_pending.geometryChanged = false;
+        any = true;
+    }
+    if (m_pending.titleChanged && m_xdgToplevel) {
+        xdg_toplevel_set_title(m_xdgToplevel,
+                               m_pending.title.toUtf8().constData());
+        m_pending.titleChanged = false;
+        any = true;
+    }
+    if (m_pending.stateChanged && m_xdgToplevel) {
+        if (m_pending.state & Qt::WindowMaximized)
+            xdg_toplevel_set_maximized(m_xdgToplevel);
+        else
+            xdg_toplevel_unset_maximized(m_xdgToplevel);
+        if (m_pending.state & Qt::WindowFullScreen)
+            xdg_toplevel_set_fullscreen(m_xdgToplevel, nullptr);
+        else
+            xdg_toplevel_unset_fullscreen(m_xdgToplevel);
+        m_pending.stateChanged = false;
+        any = true;
+    }
+
+    /* One commit applies the whole transaction atomically -- that is
+     * the Wayland double-buffered state model doing the batching for
+     * us once we stop committing per setter */
+    if (any)
+        wl_surface_commit(m_wlSurface);
 }
 
 void QVeridianWindow::raise()
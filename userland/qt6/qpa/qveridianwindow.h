@@ -31,6 +31,7 @@ public:
     QRect geometry() const override;
     void setVisible(bool visible) override;
     void setWindowTitle(const QString &title) override;
+    void setWindowState(Qt::WindowStates state) override;
     void raise() override;
     void lower() override;
     WId winId() const override;
@@ -41,12 +42,34 @@ private:
     void createWaylandSurface();
     void destroyWaylandSurface();
 
+    /*
+     * Transactional state batching: setters record into the pending
+     * block and arm one zero-timer; the commit runs once per event
+     * loop pass and flushes everything in a single
+     * requests-then-wl_surface_commit transaction.  A session
+     * restore's restore+move+retitle burst reaches the compositor as
+     * one consistent state instead of a flood of intermediates.
+     */
+    void scheduleCommit();
+    void commitPendingState();
+
+    struct PendingState {
+        bool  geometryChanged = false;
+        bool  titleChanged = false;
+        bool  stateChanged = false;
+        QRect geometry;
+        QString title;
+        Qt::WindowStates state;
+    };
+
     QVeridianIntegration *m_integration;
     struct wl_surface    *m_wlSurface   = nullptr;
     struct xdg_surface   *m_xdgSurface  = nullptr;
     struct xdg_toplevel  *m_xdgToplevel = nullptr;
     QRect                 m_geometry;
     bool                  m_visible = false;
+    PendingState          m_pending;
+    bool                  m_commitScheduled = false;
 };
 
 QT_END_NAMESPACE
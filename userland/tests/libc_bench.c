@@ -0,0 +1,370 @@
+/*
+ * libc_bench.c -- throughput benchmark suite for the libc shim layer
+ *
+ * Copyright (c) 2025-2026 VeridianOS Contributors
+ * SPDX-License-Identifier: MIT OR Apache-2.0
+ *
+ * Times the hot shim paths under documented workloads and emits one
+ * machine-readable line per benchmark:
+ *
+ *     BENCH <name> ops=<n> ns=<total> ns/op=<avg> mb/s=<rate>
+ *
+ * so results diff cleanly across commits (sort by name, compare the
+ * ns/op column).  Workloads are fixed-seed and fixed-size; a run is
+ * comparable to any other run on the same hardware.  Ends with
+ * "PASS: libc_bench" when every section's self-check held -- a
+ * benchmark that computes wrong answers fast is worse than a slow
+ * one.
+ *
+ * Sections: string.c primitives, malloc (size-class and large),
+ * zlib deflate/inflate, regex existence matching, iconv UTF-8/16
+ * bulk conversion, dbus message marshalling.
+ */
+
+#include <dbus/dbus.h>
+#include <iconv.h>
+#include <regex.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <zlib.h>
+
+#define KB (1024u)
+#define MB (1024u * 1024u)
+
+static int g_failures;
+
+static long long now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static void report(const char *name, long long ops, long long ns,
+                   long long bytes)
+{
+    double per_op = ops ? (double)ns / (double)ops : 0.0;
+    double mbs = ns ? (double)bytes * 1000.0 / (double)ns : 0.0;
+
+    printf("BENCH %-24s ops=%-10lld ns=%-12lld ns/op=%-8.1f "
+           "mb/s=%.1f\n", name, ops, ns, per_op, mbs);
+}
+
+/* Defeat dead-code elimination without touching the timed work */
+#define OPT_BARRIER(p) __asm__ volatile("" :: "r"(p) : "memory")
+
+/* Deterministic fill so every run measures identical bytes */
+static void fill_pattern(unsigned char *buf, size_t len, uint32_t seed)
+{
+    uint32_t x = seed ? seed : 1;
+
+    for (size_t i = 0; i < len; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        buf[i] = (unsigned char)(32 + (x % 95));    /* Printable ASCII */
+    }
+}
+
+/* ========================================================================= */
+/* string.c primitives                                                       */
+/* ========================================================================= */
+
+static void bench_string(void)
+{
+    const size_t len = 256 * KB;
+    unsigned char *a = malloc(len + 1);
+    unsigned char *b = malloc(len + 1);
+    long long t0, ns, ops;
+    volatile size_t sink = 0;
+
+    fill_pattern(a, len, 42);
+    a[len] = '\0';
+
+    /* memcpy: 256KB blocks, the compositor-damage-blit shape */
+    ops = 2000;
+    t0 = now_ns();
+    for (long long i = 0; i < ops; i++)
+        memcpy(b, a, len);
+    ns = now_ns() - t0;
+    report("string.memcpy_256k", ops, ns, ops * (long long)len);
+    if (memcmp(a, b, len) != 0)
+        g_failures++;
+
+    /* memset */
+    t0 = now_ns();
+    for (long long i = 0; i < ops; i++) {
+        memset(b, (int)i & 0xFF, len);
+        OPT_BARRIER(b);
+    }
+    ns = now_ns() - t0;
+    report("string.memset_256k", ops, ns, ops * (long long)len);
+
+    /* strlen over a long C string: text-layout shape */
+    ops = 20000;
+    t0 = now_ns();
+    for (long long i = 0; i < ops; i++) {
+        OPT_BARRIER(a);
+        sink += strlen((const char *)a);
+    }
+    ns = now_ns() - t0;
+    report("string.strlen_256k", ops, ns, ops * (long long)len);
+    if (sink != (size_t)ops * len)
+        g_failures++;
+
+    /* strchr misses: delimiter scanning */
+    ops = 20000;
+    t0 = now_ns();
+    for (long long i = 0; i < ops; i++) {
+        OPT_BARRIER(a);
+        if (strchr((const char *)a, (int)0x1F) != NULL)
+            g_failures++;       /* Pattern never emits 0x1F */
+    }
+    ns = now_ns() - t0;
+    report("string.strchr_miss", ops, ns, ops * (long long)len);
+
+    free(a);
+    free(b);
+}
+
+/* ========================================================================= */
+/* malloc                                                                    */
+/* ========================================================================= */
+
+static void bench_malloc(void)
+{
+    enum { SLOTS = 512 };
+    void *slots[SLOTS];
+    long long t0, ns, ops;
+
+    memset(slots, 0, sizeof(slots));
+
+    /* Size-class churn: the Qt-object allocation shape */
+    ops = 2000000;
+    t0 = now_ns();
+    for (long long i = 0; i < ops; i++) {
+        int s = (int)(i % SLOTS);
+
+        free(slots[s]);
+        slots[s] = malloc(16u + (size_t)(i % 8) * 48u);
+    }
+    ns = now_ns() - t0;
+    report("malloc.smallchurn", ops, ns, 0);
+    for (int s = 0; s < SLOTS; s++)
+        free(slots[s]);
+
+    /* Large alloc/free: framebuffer-scale mmap path */
+    ops = 2000;
+    t0 = now_ns();
+    for (long long i = 0; i < ops; i++) {
+        void *p = malloc(1 * MB);
+
+        if (!p) {
+            g_failures++;
+            break;
+        }
+        ((unsigned char *)p)[0] = 1;
+        ((unsigned char *)p)[MB - 1] = 1;
+        free(p);
+    }
+    ns = now_ns() - t0;
+    report("malloc.large_1m", ops, ns, 0);
+}
+
+/* ========================================================================= */
+/* zlib                                                                      */
+/* ========================================================================= */
+
+static void bench_zlib(void)
+{
+    const size_t len = 1 * MB;
+    unsigned char *in = malloc(len);
+    unsigned long bound = compressBound(len);
+    unsigned char *comp = malloc(bound);
+    unsigned char *back = malloc(len);
+    long long t0, ns, ops;
+    unsigned long comp_len = 0;
+
+    /* Config-file-like content: compressible but not trivial */
+    for (size_t i = 0; i < len; i++)
+        in[i] = (unsigned char)("key=value\n[Group]\n"[i % 18] + (i / 4096) % 3);
+
+    ops = 20;
+    t0 = now_ns();
+    for (long long i = 0; i < ops; i++) {
+        comp_len = bound;
+        if (compress2(comp, &comp_len, in, len, 6) != Z_OK)
+            g_failures++;
+    }
+    ns = now_ns() - t0;
+    report("zlib.deflate_1m", ops, ns, ops * (long long)len);
+
+    ops = 100;
+    t0 = now_ns();
+    for (long long i = 0; i < ops; i++) {
+        unsigned long out_len = len;
+
+        if (uncompress(back, &out_len, comp, comp_len) != Z_OK ||
+            out_len != len)
+            g_failures++;
+    }
+    ns = now_ns() - t0;
+    report("zlib.inflate_1m", ops, ns, ops * (long long)len);
+    if (memcmp(in, back, len) != 0)
+        g_failures++;
+
+    free(in);
+    free(comp);
+    free(back);
+}
+
+/* ========================================================================= */
+/* regex                                                                     */
+/* ========================================================================= */
+
+static void bench_regex(void)
+{
+    enum { CANDS = 256 };
+    static char cands[CANDS][96];
+    regex_t re;
+    long long t0, ns, ops;
+    int hits = 0;
+
+    for (int i = 0; i < CANDS; i++)
+        snprintf(cands[i], sizeof(cands[i]),
+                 "org.kde.app%d.desktop entry %d %s", i, i * 31,
+                 i % 7 == 0 ? "terminal" : "widget");
+
+    if (regcomp(&re, "term[a-z]*al", REG_EXTENDED) != 0) {
+        g_failures++;
+        return;
+    }
+
+    /* Existence-only: the KRunner per-keystroke shape */
+    ops = 0;
+    t0 = now_ns();
+    for (int iter = 0; iter < 500; iter++) {
+        for (int i = 0; i < CANDS; i++) {
+            if (regexec(&re, cands[i], 0, NULL, 0) == 0)
+                hits++;
+            ops++;
+        }
+    }
+    ns = now_ns() - t0;
+    report("regex.exists", ops, ns, 0);
+    if (hits != 500 * ((CANDS + 6) / 7))
+        g_failures++;
+
+    regfree(&re);
+}
+
+/* ========================================================================= */
+/* iconv                                                                     */
+/* ========================================================================= */
+
+static void bench_iconv(void)
+{
+    const size_t len = 256 * KB;
+    char *in = malloc(len);
+    char *out = malloc(len * 4);
+    iconv_t cd = iconv_open("UTF-16LE", "UTF-8");
+    long long t0, ns, ops;
+
+    if (cd == (iconv_t)-1) {
+        g_failures++;
+        free(in);
+        free(out);
+        return;
+    }
+
+    fill_pattern((unsigned char *)in, len, 7);  /* Pure ASCII */
+
+    ops = 500;
+    t0 = now_ns();
+    for (long long i = 0; i < ops; i++) {
+        char *ip = in, *op = out;
+        size_t il = len, ol = len * 4;
+
+        if (iconv(cd, &ip, &il, &op, &ol) == (size_t)-1 || il != 0)
+            g_failures++;
+    }
+    ns = now_ns() - t0;
+    report("iconv.u8_to_u16", ops, ns, ops * (long long)len);
+
+    iconv_close(cd);
+    free(in);
+    free(out);
+}
+
+/* ========================================================================= */
+/* dbus marshalling                                                          */
+/* ========================================================================= */
+
+static void bench_dbus(void)
+{
+    long long t0, ns, ops;
+    const char *sval = "org.kde.plasma.notification.body.text";
+    dbus_int32_t ival = 42;
+
+    /* Message build + argument marshal + teardown: the applet
+     * signal-emission shape */
+    ops = 200000;
+    t0 = now_ns();
+    for (long long i = 0; i < ops; i++) {
+        DBusMessage *msg = dbus_message_new_method_call(
+            "org.kde.StatusNotifierWatcher",
+            "/StatusNotifierWatcher",
+            "org.kde.StatusNotifierWatcher",
+            "RegisterStatusNotifierItem");
+
+        if (!msg ||
+            !dbus_message_append_args(msg,
+                                      DBUS_TYPE_STRING, &sval,
+                                      DBUS_TYPE_INT32, &ival,
+                                      DBUS_TYPE_INVALID)) {
+            g_failures++;
+            if (msg)
+                dbus_message_unref(msg);
+            break;
+        }
+        dbus_message_unref(msg);
+    }
+    ns = now_ns() - t0;
+    report("dbus.marshal", ops, ns, 0);
+}
+
+/* ========================================================================= */
+/* Entry                                                                     */
+/* ========================================================================= */
+
+int main(int argc, char **argv)
+{
+    /* Section filter: `libc_bench string` runs one section */
+    const char *only = argc > 1 ? argv[1] : NULL;
+
+#define WANT(n) (!only || strcmp(only, n) == 0)
+    if (WANT("string"))
+        bench_string();
+    if (WANT("malloc"))
+        bench_malloc();
+    if (WANT("zlib"))
+        bench_zlib();
+    if (WANT("regex"))
+        bench_regex();
+    if (WANT("iconv"))
+        bench_iconv();
+    if (WANT("dbus"))
+        bench_dbus();
+#undef WANT
+
+    if (g_failures) {
+        printf("FAIL: libc_bench (%d)\n", g_failures);
+        return 1;
+    }
+    printf("PASS: libc_bench\n");
+    return 0;
+}
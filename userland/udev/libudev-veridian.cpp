@@ -20,6 +20,92 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* ========================================================================= */
+/* Shared device database (read-only client view)                            */
+/* ========================================================================= */
+
+/*
+ * Queries are answered from the daemon's mmap'd database when it
+ * exists: enumeration is a linear pass comparing 8-byte subsystem
+ * hashes, property lookups binary-search the sorted devpath records.
+ * Reads are wrapped in seqlock retries against the generation
+ * counter, so a concurrent daemon rewrite can never hand out a torn
+ * record.  Without the database (daemon not running), the direct
+ * in-process query path is used as before.
+ */
+
+static const UdbHeader *s_udb_ro;
+
+static const UdbHeader *udbAttach(void)
+{
+    int fd;
+    void *map;
+
+    if (s_udb_ro)
+        return s_udb_ro;
+
+    fd = open(UDB_PATH, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    map = mmap(NULL, sizeof(UdbHeader), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return NULL;
+
+    {
+        const UdbHeader *db = (const UdbHeader *)map;
+
+        if (__atomic_load_n(&db->magic, __ATOMIC_ACQUIRE) != UDB_MAGIC ||
+            db->version != UDB_VERSION) {
+            munmap(map, sizeof(UdbHeader));
+            return NULL;
+        }
+        s_udb_ro = db;
+    }
+    return s_udb_ro;
+}
+
+/* Begin a consistent read: returns an even generation */
+static uint32_t udbReadBegin(const UdbHeader *db)
+{
+    for (;;) {
+        uint32_t gen = __atomic_load_n(&db->generation,
+                                       __ATOMIC_ACQUIRE);
+
+        if ((gen & 1u) == 0)
+            return gen;
+        /* Daemon mid-rewrite: spin briefly */
+    }
+}
+
+static int udbReadRetry(const UdbHeader *db, uint32_t gen)
+{
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&db->generation, __ATOMIC_ACQUIRE) != gen;
+}
+
+/* Binary search the sorted records for a devpath; -1 on miss */
+static int udbFind(const UdbHeader *db, const char *devpath)
+{
+    int lo = 0;
+    int hi = (int)db->device_count;
+
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        int c = strcmp(db->devices[mid].devpath, devpath);
+
+        if (c < 0)
+            lo = mid + 1;
+        else if (c > 0)
+            hi = mid;
+        else
+            return mid;
+    }
+    return -1;
+}
 
 /* ========================================================================= */
 /* Internal structures                                                       */
@@ -255,7 +341,54 @@ const char *udev_device_get_property_value(struct udev_device *udev_device,
             return udev_device->properties[i].value;
     }
 
-    /* Fallback: query daemon */
+    /* Shared database: binary search on devpath, seqlock-consistent
+     * copy of the value into the device's property cache */
+    {
+        const UdbHeader *db = udbAttach();
+
+        if (db) {
+            for (;;) {
+                uint32_t gen = udbReadBegin(db);
+                int idx = udbFind(db, udev_device->syspath);
+                int found = -1;
+
+                if (idx >= 0) {
+                    const UdbDevice *d = &db->devices[idx];
+                    uint32_t p;
+
+                    for (p = 0; p < d->prop_count &&
+                                p < UDEV_MAX_PROPS; p++) {
+                        if (strcmp(d->props[p].key, key) == 0) {
+                            if (udev_device->num_properties <
+                                UDEV_MAX_PROPS) {
+                                int n = udev_device->num_properties;
+
+                                strncpy(udev_device->properties[n].key,
+                                        key, UDEV_MAX_NAME - 1);
+                                strncpy(
+                                    udev_device->properties[n].value,
+                                    d->props[p].value,
+                                    UDEV_MAX_PATH - 1);
+                                found = n;
+                            }
+                            break;
+                        }
+                    }
+                }
+                if (!udbReadRetry(db, gen)) {
+                    if (found >= 0) {
+                        udev_device->num_properties++;
+                        return udev_device->properties[found].value;
+                    }
+                    break;
+                }
+                /* Torn read: discard the copy and retry */
+            }
+            return NULL;
+        }
+    }
+
+    /* Fallback: query daemon directly (linked-in case) */
     return udev_device_get_property(udev_device->syspath, key);
 }
 
@@ -391,10 +524,42 @@ int udev_enumerate_scan_devices(struct udev_enumerate *udev_enumerate)
     }
     udev_enumerate->head = NULL;
 
-    /* Query daemon for devices matching subsystem */
+    /* Query the shared database first: index lookups, no directory
+     * walk, no daemon round-trip */
     char results[64][UDEV_MAX_PATH];
-    int count = udev_enumerate_devices(udev_enumerate->subsystem,
-                                        results, 64);
+    int count = -1;
+
+    {
+        const UdbHeader *db = udbAttach();
+
+        if (db) {
+            uint64_t want = udb_hash(udev_enumerate->subsystem);
+
+            for (;;) {
+                uint32_t gen = udbReadBegin(db);
+                uint32_t i;
+
+                count = 0;
+                for (i = 0; i < db->device_count && count < 64; i++) {
+                    if (db->devices[i].subsystem_hash != want)
+                        continue;
+                    if (strcmp(db->devices[i].subsystem,
+                               udev_enumerate->subsystem) != 0)
+                        continue;
+                    strncpy(results[count], db->devices[i].devpath,
+                            UDEV_MAX_PATH - 1);
+                    results[count][UDEV_MAX_PATH - 1] = '\0';
+                    count++;
+                }
+                if (!udbReadRetry(db, gen))
+                    break;
+            }
+        }
+    }
+
+    if (count < 0)
+        count = udev_enumerate_devices(udev_enumerate->subsystem,
+                                       results, 64);
     if (count < 0)
         return count;
 
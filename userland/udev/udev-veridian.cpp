@@ -13,6 +13,10 @@
 
 #include "udev-veridian.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 #include <QCoreApplication>
 #include <QDBusConnection>
 #include <QDBusMessage>
@@ -72,6 +76,23 @@ static QMap<QString, DeviceEntry> s_devices;
 static QList<UdevRule> s_rules;
 static QList<UdevMonitor *> s_monitors;
 
+/*
+ * Compiled rule index (the decision tree's first two levels).  Rules
+ * are partitioned at load time by their SUBSYSTEM match and then by
+ * ACTION, so an event only walks the handful of rules that could
+ * possibly match instead of the whole list.  Rules without a literal
+ * SUBSYSTEM match live in the wildcard bucket.
+ */
+struct RuleIndex {
+    QHash<QString, QVector<int>> bySubsystem;   /* subsystem -> rules */
+    QVector<int> wildcard;
+};
+
+static RuleIndex s_ruleIndex;
+
+/* Shared device database mapping (daemon side, read-write) */
+static UdbHeader *s_udb = nullptr;
+
 static int s_inotifyFd = -1;
 static QSocketNotifier *s_inotifyNotifier = nullptr;
 static QTimer *s_pollTimer = nullptr;
@@ -81,7 +102,9 @@ static QTimer *s_pollTimer = nullptr;
 /* ========================================================================= */
 
 static void loadRules();
+static void compileRuleIndex();
 static void enumerateExistingDevices();
+static void processEventBatch(QVector<UdevEvent> &batch);
 static void processInotifyEvents();
 static void pollKernelHotplug();
 static void emitEvent(const UdevEvent &event);
@@ -110,6 +133,7 @@ int udev_daemon_start(void)
 
     /* Load rules from /etc/udev/rules.d/ */
     loadRules();
+    compileRuleIndex();
 
     /* Enumerate devices already present */
     enumerateExistingDevices();
@@ -592,6 +616,8 @@ static void pollKernelHotplug()
         uint8_t  speed;
     } __attribute__((packed)) record;
 
+    QVector<UdevEvent> batch;
+
     while (read(fd, &record, sizeof(record)) == sizeof(record)) {
         UdevEvent event;
         memset(&event, 0, sizeof(event));
@@ -646,10 +672,147 @@ static void pollKernelHotplug()
             removeDeviceEntry(QString::fromUtf8(event.devpath));
         }
 
-        emitEvent(event);
+        batch.append(event);
     }
 
     close(fd);
+
+    /* Rules and notifications run once over the coalesced batch */
+    processEventBatch(batch);
+}
+
+/* ========================================================================= */
+/* Rule index compilation                                                    */
+/* ========================================================================= */
+
+static void compileRuleIndex()
+{
+    s_ruleIndex.bySubsystem.clear();
+    s_ruleIndex.wildcard.clear();
+
+    for (int r = 0; r < s_rules.size(); r++) {
+        const UdevRule &rule = s_rules.at(r);
+        const char *subsystem = nullptr;
+
+        for (int i = 0; i < rule.num_matches; i++) {
+            if (strcmp(rule.matches[i].key, "SUBSYSTEM") == 0) {
+                subsystem = rule.matches[i].value;
+                break;
+            }
+        }
+        if (subsystem)
+            s_ruleIndex.bySubsystem[QString::fromUtf8(subsystem)]
+                .append(r);
+        else
+            s_ruleIndex.wildcard.append(r);
+    }
+
+    qDebug("udev-veridian: rule index: %d subsystem partitions, "
+           "%d wildcard rules",
+           s_ruleIndex.bySubsystem.size(), s_ruleIndex.wildcard.size());
+}
+
+/* ========================================================================= */
+/* Batch coalescing                                                          */
+/* ========================================================================= */
+
+/*
+ * Collapse add/change/change storms for the same device before any
+ * rule matching or notification runs:
+ *
+ *   add + change...   -> one add with the merged property set
+ *   change + change   -> one change (latest properties win)
+ *   add + remove      -> both dropped (the device flapped inside the
+ *                        batch; nothing was ever announced)
+ *   change + remove   -> one remove
+ *   remove + add      -> kept as a sequence (a real re-plug)
+ */
+static void coalesceBatch(QVector<UdevEvent> &batch)
+{
+    QHash<QString, int> lastByPath;     /* devpath -> index in out */
+    QVector<UdevEvent> out;
+
+    out.reserve(batch.size());
+
+    for (int i = 0; i < batch.size(); i++) {
+        const UdevEvent &ev = batch.at(i);
+        QString path = QString::fromUtf8(ev.devpath);
+        int prev = lastByPath.value(path, -1);
+
+        if (prev < 0) {
+            lastByPath.insert(path, out.size());
+            out.append(ev);
+            continue;
+        }
+
+        UdevEvent &pe = out[prev];
+
+        if (ev.action == UDEV_ACTION_CHANGE &&
+            (pe.action == UDEV_ACTION_ADD ||
+             pe.action == UDEV_ACTION_CHANGE)) {
+            /* Merge properties into the surviving event */
+            for (int p = 0; p < ev.num_properties; p++) {
+                bool updated = false;
+
+                for (int q = 0; q < pe.num_properties; q++) {
+                    if (strcmp(pe.properties[q].key,
+                               ev.properties[p].key) == 0) {
+                        memcpy(pe.properties[q].value,
+                               ev.properties[p].value,
+                               sizeof(pe.properties[q].value));
+                        updated = true;
+                        break;
+                    }
+                }
+                if (!updated && pe.num_properties < UDEV_MAX_PROPS)
+                    pe.properties[pe.num_properties++] =
+                        ev.properties[p];
+            }
+            pe.seqnum = ev.seqnum;
+            continue;
+        }
+
+        if (ev.action == UDEV_ACTION_REMOVE) {
+            if (pe.action == UDEV_ACTION_ADD) {
+                /* Flapped inside the batch: drop both */
+                pe.action = UDEV_ACTION_NONE;
+                lastByPath.remove(path);
+                continue;
+            }
+            if (pe.action == UDEV_ACTION_CHANGE) {
+                pe = ev;            /* Remove supersedes the change */
+                continue;
+            }
+        }
+
+        /* Anything else (remove->add re-plug, repeated adds): keep as
+         * an ordered sequence */
+        lastByPath.insert(path, out.size());
+        out.append(ev);
+    }
+
+    /* Compact out the dropped slots */
+    batch.clear();
+    for (const UdevEvent &ev : out) {
+        if (ev.action != UDEV_ACTION_NONE)
+            batch.append(ev);
+    }
+}
+
+static void processEventBatch(QVector<UdevEvent> &batch)
+{
+    if (batch.isEmpty())
+        return;
+
+    int before = batch.size();
+
+    coalesceBatch(batch);
+    if (batch.size() != before)
+        qDebug("udev-veridian: coalesced %d events into %d",
+               before, batch.size());
+
+    for (const UdevEvent &ev : batch)
+        emitEvent(ev);
 }
 
 /* ========================================================================= */
@@ -681,65 +844,78 @@ static void emitEvent(const UdevEvent &event)
            actionStr, event.subsystem, event.devpath);
 }
 
-static void applyRules(const UdevEvent &event)
+/* Evaluate one rule against an event (inner tree levels) */
+static bool ruleMatches(const UdevRule &rule, const UdevEvent &event)
 {
-    for (const UdevRule &rule : s_rules) {
-        bool match = true;
-
-        for (int i = 0; i < rule.num_matches; i++) {
-            const char *key = rule.matches[i].key;
-            const char *expected = rule.matches[i].value;
-
-            if (strcmp(key, "SUBSYSTEM") == 0) {
-                if (strcmp(event.subsystem, expected) != 0)
-                    match = false;
-            } else if (strcmp(key, "ACTION") == 0) {
-                const char *actionStr = "";
-                switch (event.action) {
-                case UDEV_ACTION_ADD:    actionStr = "add";    break;
-                case UDEV_ACTION_REMOVE: actionStr = "remove"; break;
-                case UDEV_ACTION_CHANGE: actionStr = "change"; break;
-                default: break;
-                }
-                if (strcmp(actionStr, expected) != 0)
-                    match = false;
-            } else {
-                /* Check device properties */
-                bool found = false;
-                for (int p = 0; p < event.num_properties; p++) {
-                    if (strcmp(event.properties[p].key, key) == 0 &&
-                        strcmp(event.properties[p].value, expected) == 0) {
-                        found = true;
-                        break;
-                    }
+    for (int i = 0; i < rule.num_matches; i++) {
+        const char *key = rule.matches[i].key;
+        const char *expected = rule.matches[i].value;
+
+        if (strcmp(key, "SUBSYSTEM") == 0) {
+            if (strcmp(event.subsystem, expected) != 0)
+                return false;
+        } else if (strcmp(key, "ACTION") == 0) {
+            const char *actionStr = "";
+            switch (event.action) {
+            case UDEV_ACTION_ADD:    actionStr = "add";    break;
+            case UDEV_ACTION_REMOVE: actionStr = "remove"; break;
+            case UDEV_ACTION_CHANGE: actionStr = "change"; break;
+            default: break;
+            }
+            if (strcmp(actionStr, expected) != 0)
+                return false;
+        } else {
+            bool found = false;
+            for (int p = 0; p < event.num_properties; p++) {
+                if (strcmp(event.properties[p].key, key) == 0 &&
+                    strcmp(event.properties[p].value, expected) == 0) {
+                    found = true;
+                    break;
                 }
-                if (!found)
-                    match = false;
             }
-
-            if (!match)
-                break;
+            if (!found)
+                return false;
         }
+    }
+    return true;
+}
 
-        if (match) {
-            qDebug("udev-veridian: rule matched, action=%d value=%s",
-                   rule.action_type, rule.action_value);
+static void runRuleAction(const UdevRule &rule)
+{
+    qDebug("udev-veridian: rule matched, action=%d value=%s",
+           rule.action_type, rule.action_value);
 
-            switch (rule.action_type) {
-            case UDEV_RULE_RUN:
-                /* Would fork+exec the program */
-                qDebug("udev-veridian: RUN %s (stub)", rule.action_value);
-                break;
-            case UDEV_RULE_SYMLINK:
-                /* Would create symlink in /dev */
-                qDebug("udev-veridian: SYMLINK %s (stub)", rule.action_value);
-                break;
-            case UDEV_RULE_ENV:
-            case UDEV_RULE_LABEL:
-                /* Set environment or label */
-                break;
-            }
-        }
+    switch (rule.action_type) {
+    case UDEV_RULE_RUN:
+        /* Would fork+exec the program */
+        qDebug("udev-veridian: RUN %s (stub)", rule.action_value);
+        break;
+    case UDEV_RULE_SYMLINK:
+        /* Would create symlink in /dev */
+        qDebug("udev-veridian: SYMLINK %s (stub)", rule.action_value);
+        break;
+    case UDEV_RULE_ENV:
+    case UDEV_RULE_LABEL:
+        /* Set environment or label */
+        break;
+    }
+}
+
+static void applyRules(const UdevEvent &event)
+{
+    /* Decision tree level 1: only this subsystem's partition plus the
+     * wildcard bucket is walked */
+    const QVector<int> partition =
+        s_ruleIndex.bySubsystem.value(
+            QString::fromUtf8(event.subsystem));
+
+    for (int r : partition) {
+        if (ruleMatches(s_rules.at(r), event))
+            runRuleAction(s_rules.at(r));
+    }
+    for (int r : s_ruleIndex.wildcard) {
+        if (ruleMatches(s_rules.at(r), event))
+            runRuleAction(s_rules.at(r));
     }
 }
 
@@ -798,6 +974,91 @@ static void sendDbusSignal(const UdevEvent &event)
 /* Device database helpers                                                   */
 /* ========================================================================= */
 
+/* Map (creating on first use) the shared device database */
+static UdbHeader *udbMap()
+{
+    int fd;
+    void *map;
+
+    if (s_udb)
+        return s_udb;
+
+    mkdir("/run/veridian", 0755);
+    fd = open(UDB_PATH, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        /* Read-only root: clients fall back to direct queries */
+        return nullptr;
+    }
+    if (ftruncate(fd, sizeof(UdbHeader)) < 0) {
+        close(fd);
+        return nullptr;
+    }
+    map = mmap(nullptr, sizeof(UdbHeader), PROT_READ | PROT_WRITE,
+               MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return nullptr;
+
+    s_udb = static_cast<UdbHeader *>(map);
+    s_udb->version = UDB_VERSION;
+    __atomic_store_n(&s_udb->magic, UDB_MAGIC, __ATOMIC_RELEASE);
+    return s_udb;
+}
+
+/*
+ * Rewrite the database from s_devices under the generation seqlock.
+ * The device set is small and changes are rare (hotplug), so a full
+ * sorted rebuild per mutation keeps readers trivially simple.
+ */
+static void udbRebuild()
+{
+    UdbHeader *db = udbMap();
+
+    if (!db)
+        return;
+
+    __atomic_fetch_add(&db->generation, 1, __ATOMIC_ACQ_REL); /* Odd */
+
+    {
+        /* QMap iterates keys in sorted order: records come out sorted
+         * by devpath for the clients' binary search */
+        uint32_t n = 0;
+
+        for (auto it = s_devices.constBegin();
+             it != s_devices.constEnd() && n < UDB_MAX_DEVICES; ++it) {
+            UdbDevice *d = &db->devices[n];
+            const DeviceEntry &e = it.value();
+            QByteArray path = e.devpath.toUtf8();
+            QByteArray node = e.devnode.toUtf8();
+            QByteArray sub = e.subsystem.toUtf8();
+
+            memset(d, 0, sizeof(*d));
+            strncpy(d->devpath, path.constData(), UDEV_MAX_PATH - 1);
+            strncpy(d->devnode, node.constData(), UDEV_MAX_PATH - 1);
+            strncpy(d->subsystem, sub.constData(), UDEV_MAX_NAME - 1);
+            d->subsystem_hash = udb_hash(d->subsystem);
+
+            d->prop_count = 0;
+            for (auto p = e.properties.constBegin();
+                 p != e.properties.constEnd() &&
+                 d->prop_count < UDEV_MAX_PROPS; ++p) {
+                QByteArray k = p.key().toUtf8();
+                QByteArray v = p.value().toUtf8();
+
+                strncpy(d->props[d->prop_count].key, k.constData(),
+                        UDEV_MAX_NAME - 1);
+                strncpy(d->props[d->prop_count].value, v.constData(),
+                        UDEV_MAX_PATH - 1);
+                d->prop_count++;
+            }
+            n++;
+        }
+        db->device_count = n;
+    }
+
+    __atomic_fetch_add(&db->generation, 1, __ATOMIC_ACQ_REL); /* Even */
+}
+
 static void addDeviceEntry(const QString &devpath, const QString &devnode,
                            const QString &subsystem,
                            const QMap<QString, QString> &props)
@@ -808,9 +1069,11 @@ static void addDeviceEntry(const QString &devpath, const QString &devnode,
     entry.subsystem = subsystem;
     entry.properties = props;
     s_devices.insert(devpath, entry);
+    udbRebuild();
 }
 
 static void removeDeviceEntry(const QString &devpath)
 {
     s_devices.remove(devpath);
+    udbRebuild();
 }
@@ -35,6 +35,7 @@ typedef enum {
     UDEV_ACTION_CHANGE  = 2,    /**< Device properties changed */
     UDEV_ACTION_BIND    = 3,    /**< Driver bound to device */
     UDEV_ACTION_UNBIND  = 4,    /**< Driver unbound from device */
+    UDEV_ACTION_NONE    = 5,    /**< Coalesced away (internal) */
 } UdevEventAction;
 
 /**
@@ -44,6 +45,60 @@ typedef enum {
 #define UDEV_MAX_NAME   64
 #define UDEV_MAX_PROPS  16
 
+/* ========================================================================= */
+/* Shared device database                                                    */
+/* ========================================================================= */
+
+/*
+ * Binary device database maintained by the daemon at /run/veridian/
+ * udevdb and mapped read-only by libudev clients.  Records are kept
+ * sorted by devpath so lookups binary-search; each record carries an
+ * FNV hash of its subsystem so enumeration filters on an 8-byte
+ * compare before touching strings.  The generation counter is a
+ * seqlock: odd while the daemon rewrites, bumped to the next even
+ * value when consistent -- readers retry on mismatch.
+ */
+
+#define UDB_MAGIC       0x42445556u     /* 'VUDB' */
+#define UDB_VERSION     1u
+#define UDB_MAX_DEVICES 128
+#define UDB_PATH        "/run/veridian/udevdb"
+
+typedef struct {
+    char     key[UDEV_MAX_NAME];
+    char     value[UDEV_MAX_PATH];
+} UdbProp;
+
+typedef struct {
+    char     devpath[UDEV_MAX_PATH];
+    char     devnode[UDEV_MAX_PATH];
+    char     subsystem[UDEV_MAX_NAME];
+    uint64_t subsystem_hash;
+    uint32_t prop_count;
+    uint32_t _pad;
+    UdbProp  props[UDEV_MAX_PROPS];
+} UdbDevice;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t generation;        /* Seqlock: odd = rewrite in flight */
+    uint32_t device_count;
+    UdbDevice devices[UDB_MAX_DEVICES];
+} UdbHeader;
+
+/** FNV-1a hash used for subsystem filtering. */
+static inline uint64_t udb_hash(const char *s)
+{
+    uint64_t h = 0xcbf29ce484222325ull;
+
+    for (; s && *s; s++) {
+        h ^= (unsigned char)*s;
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
 /**
  * Property key-value pair.
  */